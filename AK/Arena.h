@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Error.h>
+#include <AK/Noncopyable.h>
+#include <AK/Span.h>
+#include <AK/StdLibExtras.h>
+#include <AK/StringView.h>
+#include <AK/Types.h>
+#include <AK/kmalloc.h>
+
+namespace AK {
+
+// A region allocator: objects are carved out of large chunks one after the other, and are all freed
+// together, either by resetting the arena or by rolling it back to a previously taken Mark.
+// Nothing can be freed individually, which is what makes both allocating and freeing so cheap.
+//
+// Objects with non-trivial destructors have them run (in reverse order of creation) when the part of
+// the arena they live in is reset. Chunks that are no longer in use are kept around for the next
+// allocations, so an arena that is reset after every parse reaches a steady state without touching
+// the heap at all.
+//
+// Like BumpAllocator, an arena is not thread-safe.
+class Arena {
+    AK_MAKE_NONCOPYABLE(Arena);
+    AK_MAKE_NONMOVABLE(Arena);
+
+public:
+    static constexpr size_t default_chunk_size = 64 * KiB;
+    // Enough for any fundamental type, same as what malloc() hands out.
+    static constexpr size_t default_alignment = 16;
+
+    explicit Arena(size_t chunk_size = default_chunk_size)
+        : m_chunk_size(kmalloc_good_size(chunk_size))
+    {
+        VERIFY(m_chunk_size >= 4 * sizeof(ChunkHeader));
+    }
+
+    ~Arena()
+    {
+        reset();
+        for (auto* chunk = m_first_chunk; chunk;) {
+            auto* next = chunk->next;
+            kfree_sized(chunk, m_chunk_size);
+            chunk = next;
+        }
+    }
+
+    ErrorOr<void*> try_allocate(size_t size, size_t alignment = default_alignment)
+    {
+        VERIFY(alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+        // Anything that would use up a good part of a chunk gets its own allocation, so that chunks stay uniform
+        // (and thus recyclable) and we don't waste the rest of the current one.
+        if (size > m_chunk_size / 4 || alignment > m_chunk_size / 4 - size) [[unlikely]]
+            return allocate_large(size, alignment);
+
+        for (;;) {
+            if (m_current_chunk) {
+                auto const base = reinterpret_cast<FlatPtr>(m_current_chunk);
+                auto const aligned = align_up_to(base + m_offset_into_current_chunk, alignment);
+                if (aligned + size <= base + m_chunk_size) {
+                    m_offset_into_current_chunk = aligned + size - base;
+                    return reinterpret_cast<void*>(aligned);
+                }
+            }
+            TRY(advance_to_next_chunk());
+        }
+    }
+
+    void* allocate(size_t size, size_t alignment = default_alignment)
+    {
+        return MUST(try_allocate(size, alignment));
+    }
+
+    template<typename T, typename... Args>
+    ErrorOr<T*> try_create(Args&&... args)
+    {
+        if constexpr (IsTriviallyDestructible<T>) {
+            auto* memory = TRY(try_allocate(sizeof(T), alignof(T)));
+            return new (memory) T(forward<Args>(args)...);
+        } else {
+            auto* record = static_cast<DestructorRecord*>(TRY(try_allocate(sizeof(DestructorRecord), alignof(DestructorRecord))));
+            auto* memory = TRY(try_allocate(sizeof(T), alignof(T)));
+            auto* object = new (memory) T(forward<Args>(args)...);
+            *record = {
+                .previous = m_destructors,
+                .destroy = [](void* object) { static_cast<T*>(object)->~T(); },
+                .object = object,
+            };
+            m_destructors = record;
+            return object;
+        }
+    }
+
+    template<typename T, typename... Args>
+    T* create(Args&&... args)
+    {
+        return MUST(try_create<T>(forward<Args>(args)...));
+    }
+
+    // Returns storage for `count' default-initialized Ts. Their destructors are never run, so only trivially
+    // destructible types are allowed.
+    template<typename T>
+    requires(IsTriviallyDestructible<T>)
+    ErrorOr<Span<T>> try_allocate_array(size_t count)
+    {
+        if (count == 0)
+            return Span<T> {};
+        Checked<size_t> byte_count = sizeof(T);
+        byte_count *= count;
+        if (byte_count.has_overflow())
+            return Error::from_errno(ENOMEM);
+        auto* elements = static_cast<T*>(TRY(try_allocate(byte_count.value(), alignof(T))));
+        for (size_t i = 0; i < count; ++i)
+            new (&elements[i]) T;
+        return Span<T> { elements, count };
+    }
+
+    template<typename T>
+    requires(IsTriviallyCopyable<T>)
+    ErrorOr<Span<T>> try_copy(ReadonlySpan<T> values)
+    {
+        auto copy = TRY(try_allocate_array<T>(values.size()));
+        if (!values.is_empty())
+            __builtin_memcpy(copy.data(), values.data(), values.size() * sizeof(T));
+        return copy;
+    }
+
+    ErrorOr<StringView> try_copy(StringView string)
+    {
+        // There's nothing to point at, but an empty string should stay distinct from a null one.
+        if (string.is_empty())
+            return string;
+        auto copy = TRY(try_copy(string.bytes()));
+        return StringView { copy };
+    }
+
+    // A position in the arena that it can later be rolled back to, which frees everything allocated since.
+    struct Mark {
+        void* chunk { nullptr };
+        size_t offset_into_chunk { 0 };
+        void* large_allocations { nullptr };
+        void* destructors { nullptr };
+    };
+
+    Mark mark() const
+    {
+        return { m_current_chunk, m_offset_into_current_chunk, m_large_allocations, m_destructors };
+    }
+
+    void reset_to(Mark const& mark)
+    {
+        while (m_destructors != mark.destructors) {
+            VERIFY(m_destructors);
+            auto* record = m_destructors;
+            m_destructors = record->previous;
+            record->destroy(record->object);
+        }
+
+        while (m_large_allocations != mark.large_allocations) {
+            VERIFY(m_large_allocations);
+            auto* allocation = m_large_allocations;
+            m_large_allocations = allocation->previous;
+            kfree_sized(allocation, allocation->size);
+        }
+
+        if (mark.chunk) {
+            m_current_chunk = static_cast<ChunkHeader*>(mark.chunk);
+            m_offset_into_current_chunk = mark.offset_into_chunk;
+        } else {
+            m_current_chunk = m_first_chunk;
+            m_offset_into_current_chunk = sizeof(ChunkHeader);
+        }
+    }
+
+    // Frees everything, but keeps the chunks around for reuse.
+    void reset() { reset_to({}); }
+
+    // Returns the chunks that aren't currently in use to the heap.
+    void release_unused_chunks()
+    {
+        auto** link = m_current_chunk ? &m_current_chunk->next : &m_first_chunk;
+        for (auto* chunk = *link; chunk;) {
+            auto* next = chunk->next;
+            kfree_sized(chunk, m_chunk_size);
+            chunk = next;
+        }
+        *link = nullptr;
+        if (!m_first_chunk)
+            m_current_chunk = nullptr;
+    }
+
+    size_t chunk_size() const { return m_chunk_size; }
+
+    size_t chunk_count() const
+    {
+        size_t count = 0;
+        for (auto* chunk = m_first_chunk; chunk; chunk = chunk->next)
+            ++count;
+        return count;
+    }
+
+private:
+    struct alignas(default_alignment) ChunkHeader {
+        ChunkHeader* next { nullptr };
+    };
+
+    struct LargeAllocationHeader {
+        LargeAllocationHeader* previous { nullptr };
+        size_t size { 0 };
+    };
+
+    struct DestructorRecord {
+        DestructorRecord* previous { nullptr };
+        void (*destroy)(void*) { nullptr };
+        void* object { nullptr };
+    };
+
+    ErrorOr<void> advance_to_next_chunk()
+    {
+        if (m_current_chunk && m_current_chunk->next) {
+            m_current_chunk = m_current_chunk->next;
+            m_offset_into_current_chunk = sizeof(ChunkHeader);
+            return {};
+        }
+
+        auto* memory = kmalloc(m_chunk_size);
+        if (!memory)
+            return Error::from_errno(ENOMEM);
+        auto* chunk = new (memory) ChunkHeader;
+
+        if (m_current_chunk)
+            m_current_chunk->next = chunk;
+        else
+            m_first_chunk = chunk;
+        m_current_chunk = chunk;
+        m_offset_into_current_chunk = sizeof(ChunkHeader);
+        return {};
+    }
+
+    ErrorOr<void*> allocate_large(size_t size, size_t alignment)
+    {
+        Checked<size_t> total_size = sizeof(LargeAllocationHeader);
+        total_size += size;
+        total_size += alignment;
+        if (total_size.has_overflow())
+            return Error::from_errno(ENOMEM);
+
+        auto* memory = kmalloc(total_size.value());
+        if (!memory)
+            return Error::from_errno(ENOMEM);
+
+        auto* header = new (memory) LargeAllocationHeader { m_large_allocations, total_size.value() };
+        m_large_allocations = header;
+        return reinterpret_cast<void*>(align_up_to(reinterpret_cast<FlatPtr>(header + 1), alignment));
+    }
+
+    size_t m_chunk_size { 0 };
+    ChunkHeader* m_first_chunk { nullptr };
+    ChunkHeader* m_current_chunk { nullptr };
+    size_t m_offset_into_current_chunk { 0 };
+    LargeAllocationHeader* m_large_allocations { nullptr };
+    DestructorRecord* m_destructors { nullptr };
+};
+
+// Rolls the arena back to where it was when the scope was entered.
+class ArenaScope {
+    AK_MAKE_NONCOPYABLE(ArenaScope);
+    AK_MAKE_NONMOVABLE(ArenaScope);
+
+public:
+    explicit ArenaScope(Arena& arena)
+        : m_arena(arena)
+        , m_mark(arena.mark())
+    {
+    }
+
+    ~ArenaScope() { m_arena.reset_to(m_mark); }
+
+private:
+    Arena& m_arena;
+    Arena::Mark m_mark;
+};
+
+}
+
+#if USING_AK_GLOBALLY
+using AK::Arena;
+using AK::ArenaScope;
+#endif
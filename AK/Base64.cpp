@@ -9,6 +9,7 @@
 #include <AK/Base64.h>
 #include <AK/CharacterTypes.h>
 #include <AK/Error.h>
+#include <AK/SIMD.h>
 #include <AK/StringBuilder.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
@@ -25,6 +26,61 @@ size_t calculate_base64_encoded_length(ReadonlyBytes input)
     return ((4 * input.size() / 3) + 3) & ~3;
 }
 
+// Whole blocks of 12 bytes and 16 characters are converted at once where we can. Every range of the alphabet is
+// contiguous, so a character and its 6-bit value only differ by an offset that depends on the range.
+#if defined(__SSE2__)
+static ALWAYS_INLINE SIMD::u8x16 load_chunk(u8 const* data)
+{
+    SIMD::u8x16 chunk;
+    __builtin_memcpy(&chunk, data, sizeof(chunk));
+    return chunk;
+}
+
+template<typename VectorType>
+static ALWAYS_INLINE u32 to_mask(VectorType vector)
+{
+    return static_cast<u32>(__builtin_ia32_pmovmskb128((SIMD::c8x16)vector));
+}
+
+static ALWAYS_INLINE u32 load_u32(u8 const* data)
+{
+    u32 word;
+    __builtin_memcpy(&word, data, sizeof(word));
+    return word;
+}
+
+static ALWAYS_INLINE SIMD::u8x16 encode_sextets(SIMD::u8x16 sextets)
+{
+    // Sextets are below 64, so comparing them as signed bytes is fine, and cheaper.
+    auto values = (SIMD::i8x16)sextets;
+    SIMD::u8x16 offsets = SIMD::u8x16 {} + 'A';
+    offsets += (SIMD::u8x16)(values >= 26) & static_cast<u8>(('a' - 26) - 'A');
+    offsets += (SIMD::u8x16)(values >= 52) & static_cast<u8>(('0' - 52) - ('a' - 26));
+    offsets += (SIMD::u8x16)(values >= 62) & static_cast<u8>(('+' - 62) - ('0' - 52));
+    offsets += (SIMD::u8x16)(values >= 63) & static_cast<u8>(('/' - 63) - ('+' - 62));
+    return sextets + offsets;
+}
+
+// Returns false if any of the characters is not in the alphabet.
+static ALWAYS_INLINE bool decode_characters(SIMD::u8x16 characters, SIMD::u8x16& sextets)
+{
+    auto is_upper = (SIMD::u8x16)((SIMD::u8x16)(characters - 'A') < 26);
+    auto is_lower = (SIMD::u8x16)((SIMD::u8x16)(characters - 'a') < 26);
+    auto is_digit = (SIMD::u8x16)((SIMD::u8x16)(characters - '0') < 10);
+    auto is_plus = (SIMD::u8x16)(characters == '+');
+    auto is_slash = (SIMD::u8x16)(characters == '/');
+    if (to_mask(is_upper | is_lower | is_digit | is_plus | is_slash) != 0xffff)
+        return false;
+
+    sextets = (is_upper & (characters - 'A'))
+        | (is_lower & (characters - static_cast<u8>('a' - 26)))
+        | (is_digit & (characters + static_cast<u8>(52 - '0')))
+        | (is_plus & 62)
+        | (is_slash & 63);
+    return true;
+}
+#endif
+
 ErrorOr<ByteBuffer> decode_base64(StringView input)
 {
     auto alphabet_lookup_table = base64_lookup_table();
@@ -52,8 +108,50 @@ ErrorOr<ByteBuffer> decode_base64(StringView input)
     Vector<u8> output;
     output.ensure_capacity(calculate_base64_decoded_length(input));
 
+    auto const* input_bytes = reinterpret_cast<u8 const*>(input.characters_without_null_termination());
+
     size_t offset = 0;
     while (offset < input.length()) {
+#if defined(__SSE2__)
+        if (SIMD::u8x16 sextets; offset + 16 <= input.length() && decode_characters(load_chunk(input_bytes + offset), sextets)) {
+            // Every 32-bit lane holds the four sextets of one quantum, first one in the lowest byte. They become the
+            // three bytes of the quantum in the lowest three bytes of the lane.
+            auto lanes = (SIMD::u32x4)sextets;
+            auto bytes = ((lanes & 0x3f) << 2) | ((lanes >> 12) & 0x3)
+                | ((lanes << 4) & 0xf000) | ((lanes >> 10) & 0xf00)
+                | ((lanes << 6) & 0xc00000) | ((lanes >> 8) & 0x3f0000);
+
+            // Each lane is stored whole, and the next one overwrites its fourth byte.
+            u8 decoded[16];
+            for (size_t i = 0; i < 4; ++i) {
+                u32 word = bytes[i];
+                __builtin_memcpy(decoded + i * 3, &word, sizeof(word));
+            }
+            TRY(output.try_append(decoded, 12));
+            offset += 16;
+            continue;
+        }
+#endif
+
+        // Most of the input is made up of quanta without any whitespace or padding in them, which don't need to go
+        // through get() one character at a time.
+        if (offset + 4 <= input.length()) {
+            i16 const in0 = alphabet_lookup_table[input_bytes[offset]];
+            i16 const in1 = alphabet_lookup_table[input_bytes[offset + 1]];
+            i16 const in2 = alphabet_lookup_table[input_bytes[offset + 2]];
+            i16 const in3 = alphabet_lookup_table[input_bytes[offset + 3]];
+
+            if ((in0 | in1 | in2 | in3) >= 0) {
+                u32 const quantum = (in0 << 18) | (in1 << 12) | (in2 << 6) | in3;
+                TRY(output.try_ensure_capacity(output.size() + 3));
+                output.unchecked_append(quantum >> 16);
+                output.unchecked_append((quantum >> 8) & 0xff);
+                output.unchecked_append(quantum & 0xff);
+                offset += 4;
+                continue;
+            }
+        }
+
         bool in2_is_padding = false;
         bool in3_is_padding = false;
 
@@ -83,42 +181,45 @@ ErrorOr<ByteBuffer> decode_base64(StringView input)
 
 ErrorOr<String> encode_base64(ReadonlyBytes input)
 {
-    StringBuilder output(calculate_base64_encoded_length(input));
-
-    auto get = [&](const size_t offset, bool* need_padding = nullptr) -> u8 {
-        if (offset >= input.size()) {
-            if (need_padding)
-                *need_padding = true;
-            return 0;
-        }
-        return input[offset];
-    };
-
-    for (size_t i = 0; i < input.size(); i += 3) {
-        bool is_8bit = false;
-        bool is_16bit = false;
-
-        const u8 in0 = get(i);
-        const u8 in1 = get(i + 1, &is_16bit);
-        const u8 in2 = get(i + 2, &is_8bit);
-
-        const u8 index0 = (in0 >> 2) & 0x3f;
-        const u8 index1 = ((in0 << 4) | (in1 >> 4)) & 0x3f;
-        const u8 index2 = ((in1 << 2) | (in2 >> 6)) & 0x3f;
-        const u8 index3 = in2 & 0x3f;
+    auto output = TRY(ByteBuffer::create_uninitialized(calculate_base64_encoded_length(input)));
+    auto* out = output.data();
+
+    size_t i = 0;
+#if defined(__SSE2__)
+    for (; i + 16 <= input.size(); i += 12) {
+        // Every 32-bit lane gets the three bytes of one quantum, and the byte after them, which is ignored. Their
+        // four sextets are then put into the lane in output order, first one in the lowest byte.
+        SIMD::u32x4 words { load_u32(input.data() + i), load_u32(input.data() + i + 3), load_u32(input.data() + i + 6), load_u32(input.data() + i + 9) };
+        auto sextets = ((words >> 2) & 0x3f)
+            | ((words << 12) & 0x3000) | ((words >> 4) & 0xf00)
+            | ((words << 10) & 0x3c0000) | ((words >> 6) & 0x30000)
+            | ((words << 8) & 0x3f000000);
+        auto characters = encode_sextets((SIMD::u8x16)sextets);
+        __builtin_memcpy(out, &characters, sizeof(characters));
+        out += sizeof(characters);
+    }
+#endif
+    for (; i + 3 <= input.size(); i += 3) {
+        u32 const quantum = (input[i] << 16) | (input[i + 1] << 8) | input[i + 2];
+
+        *out++ = base64_alphabet[(quantum >> 18) & 0x3f];
+        *out++ = base64_alphabet[(quantum >> 12) & 0x3f];
+        *out++ = base64_alphabet[(quantum >> 6) & 0x3f];
+        *out++ = base64_alphabet[quantum & 0x3f];
+    }
 
-        char const out0 = base64_alphabet[index0];
-        char const out1 = base64_alphabet[index1];
-        char const out2 = is_16bit ? '=' : base64_alphabet[index2];
-        char const out3 = is_8bit ? '=' : base64_alphabet[index3];
+    // The last quantum is padded if there are only one or two bytes left for it.
+    if (i < input.size()) {
+        bool const is_8bit = i + 1 == input.size();
+        u32 const quantum = (input[i] << 16) | (is_8bit ? 0 : input[i + 1] << 8);
 
-        TRY(output.try_append(out0));
-        TRY(output.try_append(out1));
-        TRY(output.try_append(out2));
-        TRY(output.try_append(out3));
+        *out++ = base64_alphabet[(quantum >> 18) & 0x3f];
+        *out++ = base64_alphabet[(quantum >> 12) & 0x3f];
+        *out++ = is_8bit ? '=' : base64_alphabet[(quantum >> 6) & 0x3f];
+        *out++ = '=';
     }
 
-    return output.to_string();
+    return String::from_utf8(StringView { output.bytes() });
 }
 
 }
@@ -6,8 +6,10 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/ByteBuffer.h>
 #include <AK/MaybeOwned.h>
+#include <AK/NumericLimits.h>
 #include <AK/OwnPtr.h>
 #include <AK/Stream.h>
 
@@ -119,6 +121,10 @@ private:
 
 /// A stream wrapper class that allows you to read arbitrary amounts of bits
 /// in little-endian order from another stream.
+/// Bits are buffered in a 64-bit word that is refilled with as many whole bytes as fit, so peeking
+/// at and consuming a few bits at a time (as Huffman decoders do) rarely touches the underlying stream.
+/// Note that this reads ahead of the current position in the underlying stream; byte-aligned data that
+/// follows the bits should be read through this stream as well.
 class LittleEndianInputBitStream : public Stream {
 public:
     explicit LittleEndianInputBitStream(MaybeOwned<Stream> stream)
@@ -129,16 +135,23 @@ public:
     // ^Stream
     virtual ErrorOr<Bytes> read(Bytes bytes) override
     {
-        if (m_current_byte.has_value() && is_aligned_to_byte_boundary()) {
-            bytes[0] = m_current_byte.release_value();
-            return m_stream->read(bytes.slice(1));
-        }
         align_to_byte_boundary();
-        return m_stream->read(bytes);
+
+        size_t nread = 0;
+        while (nread < bytes.size() && m_bit_count > 0) {
+            bytes[nread++] = static_cast<u8>(m_bit_buffer);
+            discard_buffered_bits(8);
+        }
+
+        if (nread == bytes.size())
+            return bytes;
+
+        auto read_bytes = TRY(m_stream->read(bytes.slice(nread)));
+        return bytes.trim(nread + read_bytes.size());
     }
     virtual ErrorOr<size_t> write(ReadonlyBytes bytes) override { return m_stream->write(bytes); }
     virtual ErrorOr<void> write_entire_buffer(ReadonlyBytes bytes) override { return m_stream->write_entire_buffer(bytes); }
-    virtual bool is_eof() const override { return m_stream->is_eof() && !m_current_byte.has_value(); }
+    virtual bool is_eof() const override { return m_stream->is_eof() && m_bit_count == 0; }
     virtual bool is_open() const override { return m_stream->is_open(); }
     virtual void close() override
     {
@@ -159,65 +172,91 @@ public:
         if constexpr (IsSame<bool, T>) {
             VERIFY(count == 1);
         }
-        T result = 0;
+        VERIFY(count <= 64);
+
+        u64 result = 0;
 
         size_t nread = 0;
         while (nread < count) {
-            if (m_current_byte.has_value()) {
-                if constexpr (!IsSame<bool, T> && !IsSame<u8, T>) {
-                    // read as many bytes as possible directly
-                    if (((count - nread) >= 8) && is_aligned_to_byte_boundary()) {
-                        // shift existing data over
-                        result |= (m_current_byte.value() << nread);
-                        nread += 8;
-                        m_current_byte.clear();
-                    } else {
-                        auto const bit = (m_current_byte.value() >> m_bit_offset) & 1;
-                        result |= (bit << nread);
-                        ++nread;
-                        if (m_bit_offset++ == 7)
-                            m_current_byte.clear();
-                    }
-                } else {
-                    // Always take this branch for booleans or u8: there's no purpose in reading more than a single bit
-                    auto const bit = (m_current_byte.value() >> m_bit_offset) & 1;
-                    if constexpr (IsSame<bool, T>)
-                        result = bit;
-                    else
-                        result |= (bit << nread);
-                    ++nread;
-                    if (m_bit_offset++ == 7)
-                        m_current_byte.clear();
-                }
-            } else {
-                auto temp_buffer = TRY(ByteBuffer::create_uninitialized(1));
-                auto read_bytes = TRY(m_stream->read(temp_buffer.bytes()));
-                if (read_bytes.is_empty())
-                    return Error::from_string_literal("eof");
-                m_current_byte = temp_buffer[0];
-                m_bit_offset = 0;
-            }
+            auto const chunk_size = min(count - nread, max_peek_bit_count);
+            TRY(refill_buffer_from_stream(chunk_size));
+            if (m_bit_count < chunk_size)
+                return Error::from_string_literal("eof");
+
+            result |= (m_bit_buffer & lsb_mask(chunk_size)) << nread;
+            discard_buffered_bits(chunk_size);
+            nread += chunk_size;
         }
 
-        return result;
+        return static_cast<T>(result);
+    }
+
+    /// Returns the next `count` bits without consuming them. Bits past the end of the stream read as zero, so
+    /// callers can look ahead further than they end up needing; discard_previously_peeked_bits() reports the error
+    /// if they actually consume more bits than the stream had.
+    template<Unsigned T = u64>
+    ErrorOr<T> peek_bits(size_t count)
+    {
+        VERIFY(count <= max_peek_bit_count);
+        TRY(refill_buffer_from_stream(count));
+        return static_cast<T>(m_bit_buffer & lsb_mask(count));
+    }
+
+    ErrorOr<void> discard_previously_peeked_bits(size_t count)
+    {
+        if (count > m_bit_count)
+            return Error::from_string_literal("eof");
+        discard_buffered_bits(count);
+        return {};
     }
 
     /// Discards any sub-byte stream positioning the input stream may be keeping track of.
     /// Non-bitwise reads will implicitly call this.
     u8 align_to_byte_boundary()
     {
-        u8 remaining_bits = m_current_byte.value_or(0) >> m_bit_offset;
-        m_current_byte.clear();
-        m_bit_offset = 0;
+        auto const remaining_bit_count = m_bit_count % 8;
+        u8 remaining_bits = m_bit_buffer & lsb_mask(remaining_bit_count);
+        discard_buffered_bits(remaining_bit_count);
         return remaining_bits;
     }
 
     /// Whether we are (accidentally or intentionally) at a byte boundary right now.
-    ALWAYS_INLINE bool is_aligned_to_byte_boundary() const { return m_bit_offset == 0; }
+    ALWAYS_INLINE bool is_aligned_to_byte_boundary() const { return m_bit_count % 8 == 0; }
 
 private:
-    Optional<u8> m_current_byte;
-    size_t m_bit_offset { 0 };
+    // The buffer is refilled a byte at a time, so it is only guaranteed to have room for this many more bits.
+    static constexpr size_t max_peek_bit_count = 64 - 7;
+
+    static constexpr u64 lsb_mask(size_t bit_count)
+    {
+        return bit_count >= 64 ? NumericLimits<u64>::max() : (static_cast<u64>(1) << bit_count) - 1;
+    }
+
+    ALWAYS_INLINE void discard_buffered_bits(size_t count)
+    {
+        m_bit_buffer = count >= 64 ? 0 : m_bit_buffer >> count;
+        m_bit_count -= count;
+    }
+
+    ErrorOr<void> refill_buffer_from_stream(size_t requested_bit_count)
+    {
+        while (m_bit_count < requested_bit_count) {
+            Array<u8, sizeof(m_bit_buffer)> bytes;
+            auto const bytes_to_read = (64 - m_bit_count) / 8;
+            auto read_bytes = TRY(m_stream->read(bytes.span().trim(bytes_to_read)));
+            if (read_bytes.is_empty())
+                break;
+
+            for (auto byte : read_bytes) {
+                m_bit_buffer |= static_cast<u64>(byte) << m_bit_count;
+                m_bit_count += 8;
+            }
+        }
+        return {};
+    }
+
+    u64 m_bit_buffer { 0 };
+    size_t m_bit_count { 0 };
     MaybeOwned<Stream> m_stream;
 };
 
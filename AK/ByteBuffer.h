@@ -8,6 +8,7 @@
 #pragma once
 
 #include <AK/Assertions.h>
+#include <AK/ContainerAllocationProfile.h>
 #include <AK/Error.h>
 #include <AK/Span.h>
 #include <AK/Types.h>
@@ -300,6 +301,10 @@ private:
         if (!new_buffer)
             return Error::from_errno(ENOMEM);
 
+#if AK_CONTAINER_ALLOCATION_PROFILING
+        record_container_allocation(__PRETTY_FUNCTION__, __builtin_return_address(0), m_size, new_capacity);
+#endif
+
         if (m_inline) {
             __builtin_memcpy(new_buffer, data(), m_size);
         } else if (m_outline_buffer) {
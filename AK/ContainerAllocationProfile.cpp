@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ContainerAllocationProfile.h>
+
+#if AK_CONTAINER_ALLOCATION_PROFILING
+
+#    include <AK/Atomic.h>
+#    include <AK/Format.h>
+#    include <AK/HashFunctions.h>
+
+namespace AK::Detail {
+
+static constexpr size_t max_call_sites = 4096;
+static constexpr size_t call_sites_to_report = 32;
+
+// Allocations made while a container held at most this many elements are the ones that a bit of
+// inline capacity would likely have avoided.
+static constexpr size_t small_allocation_element_count = 4;
+
+// This has to work from any thread and before anything else is initialized, and it must not
+// allocate itself. So we use a fixed-size table of atomics, indexed by the call site's address.
+struct CallSite {
+    Atomic<FlatPtr, AK::memory_order_relaxed> address;
+    Atomic<FlatPtr, AK::memory_order_relaxed> container;
+    Atomic<u64, AK::memory_order_relaxed> allocation_count;
+    Atomic<u64, AK::memory_order_relaxed> small_allocation_count;
+    Atomic<u64, AK::memory_order_relaxed> byte_count;
+};
+
+static CallSite s_call_sites[max_call_sites];
+static Atomic<u64, AK::memory_order_relaxed> s_unrecorded_allocation_count;
+
+void record_container_allocation(char const* container, void const* call_site_address, size_t size_before_allocation, size_t byte_count)
+{
+    auto address = FlatPtr(call_site_address);
+    auto start_index = ptr_hash(address) % max_call_sites;
+    for (size_t i = 0; i < max_call_sites; ++i) {
+        auto& call_site = s_call_sites[(start_index + i) % max_call_sites];
+        auto current_address = call_site.address.load();
+        if (current_address == 0) {
+            FlatPtr expected = 0;
+            current_address = call_site.address.compare_exchange_strong(expected, address) ? address : expected;
+        }
+        if (current_address != address)
+            continue;
+
+        call_site.container.store(FlatPtr(container));
+        call_site.allocation_count.fetch_add(1);
+        if (size_before_allocation <= small_allocation_element_count)
+            call_site.small_allocation_count.fetch_add(1);
+        call_site.byte_count.fetch_add(byte_count);
+        return;
+    }
+    s_unrecorded_allocation_count.fetch_add(1);
+}
+
+void dump_container_allocations()
+{
+    // Pick out the busiest call sites without allocating anything.
+    size_t busiest[call_sites_to_report];
+    size_t busiest_count = 0;
+    for (size_t i = 0; i < max_call_sites; ++i) {
+        auto count = s_call_sites[i].allocation_count.load();
+        if (count == 0)
+            continue;
+        size_t position = busiest_count;
+        while (position > 0 && s_call_sites[busiest[position - 1]].allocation_count.load() < count)
+            --position;
+        if (position == call_sites_to_report)
+            continue;
+        if (busiest_count < call_sites_to_report)
+            ++busiest_count;
+        for (size_t j = busiest_count - 1; j > position; --j)
+            busiest[j] = busiest[j - 1];
+        busiest[position] = i;
+    }
+
+    dbgln("Container allocations by call site:");
+    for (size_t i = 0; i < busiest_count; ++i) {
+        auto& call_site = s_call_sites[busiest[i]];
+        dbgln("  {:p}: {} allocations ({} while holding at most {} elements), {} bytes in {}",
+            call_site.address.load(),
+            call_site.allocation_count.load(),
+            call_site.small_allocation_count.load(),
+            small_allocation_element_count,
+            call_site.byte_count.load(),
+            reinterpret_cast<char const*>(call_site.container.load()));
+    }
+    if (auto unrecorded = s_unrecorded_allocation_count.load(); unrecorded > 0)
+        dbgln("  ...and {} allocations from call sites that didn't fit in the table", unrecorded);
+}
+
+struct ContainerAllocationReporter {
+    ~ContainerAllocationReporter() { dump_container_allocations(); }
+};
+
+static ContainerAllocationReporter s_reporter;
+
+}
+
+#endif
@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+
+// With ENABLE_CONTAINER_ALLOCATION_PROFILING, Vector and ByteBuffer count their heap allocations
+// per call site, and the busiest call sites are printed when the process exits. Call sites that
+// mostly allocate room for just a handful of elements are good candidates for inline capacity.
+//
+// Call sites are recorded as the return address of the allocating function, which is usually in
+// the function that appended to the container. They can be symbolized with addr2line.
+#if defined(ENABLE_CONTAINER_ALLOCATION_PROFILING) && !defined(KERNEL) && !defined(_DYNAMIC_LOADER)
+#    define AK_CONTAINER_ALLOCATION_PROFILING 1
+#else
+#    define AK_CONTAINER_ALLOCATION_PROFILING 0
+#endif
+
+#if AK_CONTAINER_ALLOCATION_PROFILING
+namespace AK::Detail {
+
+void record_container_allocation(char const* container, void const* call_site, size_t size_before_allocation, size_t byte_count);
+void dump_container_allocations();
+
+}
+#endif
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/NumericLimits.h>
+#include <AK/Types.h>
+
+namespace AK {
+
+// A Bloom filter over hashes of values, which answers "definitely not present" or "maybe present".
+// Every slot holds a small counter instead of a single bit, so that values can be removed again, which makes it
+// a good fit for tracking the contents of a stack. Each hash is spread over two slots, taken from its low and
+// high bits, so the hashes should already be well distributed.
+//
+// A counter that overflows sticks at its maximum and never goes down again, which can only ever lead to more
+// false positives, never to false negatives.
+template<size_t KeyBits = 12>
+class CountingBloomFilter {
+    static_assert(KeyBits > 0 && KeyBits <= 16);
+
+public:
+    static constexpr size_t slot_count = 1u << KeyBits;
+
+    void add(u32 hash)
+    {
+        increment(first_slot(hash));
+        increment(second_slot(hash));
+    }
+
+    // The hash must have been added before.
+    void remove(u32 hash)
+    {
+        decrement(first_slot(hash));
+        decrement(second_slot(hash));
+    }
+
+    bool may_contain(u32 hash) const
+    {
+        return m_counters[first_slot(hash)] != 0 && m_counters[second_slot(hash)] != 0;
+    }
+
+    bool is_empty() const
+    {
+        for (auto counter : m_counters) {
+            if (counter != 0)
+                return false;
+        }
+        return true;
+    }
+
+    void clear() { m_counters.fill(0); }
+
+private:
+    static constexpr u32 key_mask = slot_count - 1;
+
+    static size_t first_slot(u32 hash) { return hash & key_mask; }
+    static size_t second_slot(u32 hash) { return (hash >> 16) & key_mask; }
+
+    void increment(size_t slot)
+    {
+        if (m_counters[slot] != NumericLimits<u8>::max())
+            ++m_counters[slot];
+    }
+
+    void decrement(size_t slot)
+    {
+        VERIFY(m_counters[slot] != 0);
+        if (m_counters[slot] != NumericLimits<u8>::max())
+            --m_counters[slot];
+    }
+
+    Array<u8, slot_count> m_counters {};
+};
+
+}
+
+#if USING_AK_GLOBALLY
+using AK::CountingBloomFilter;
+#endif
@@ -0,0 +1,507 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/BuiltinWrappers.h>
+#include <AK/Concepts.h>
+#include <AK/Error.h>
+#include <AK/HashTable.h>
+#include <AK/SIMD.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Traits.h>
+#include <AK/Types.h>
+#include <AK/kmalloc.h>
+
+namespace AK {
+
+namespace Detail {
+
+enum class FlatHashTableControl : u8 {
+    Empty = 0x80,
+    Deleted = 0xfe,
+    // Full buckets store the low 7 bits of their hash, so the high bit is always clear.
+};
+
+class FlatHashTableGroup {
+public:
+    static constexpr size_t size = 16;
+    using Mask = u32;
+
+    explicit FlatHashTableGroup(u8 const* control)
+    {
+        __builtin_memcpy(&m_control, control, size);
+    }
+
+    // Returns a bitmask of the buckets in this group that are full and whose hash bits match.
+    ALWAYS_INLINE Mask match(u8 hash_bits) const
+    {
+#if defined(__SSE2__)
+        SIMD::u8x16 needle;
+        for (size_t i = 0; i < size; ++i)
+            needle[i] = hash_bits;
+        return to_mask(m_control == needle);
+#else
+        Mask mask = 0;
+        for (size_t i = 0; i < size; ++i) {
+            if (m_control[i] == hash_bits)
+                mask |= 1u << i;
+        }
+        return mask;
+#endif
+    }
+
+    ALWAYS_INLINE Mask match_empty() const { return match(to_underlying(FlatHashTableControl::Empty)); }
+
+    // Empty and Deleted are the only control bytes with the high bit set.
+    ALWAYS_INLINE Mask match_empty_or_deleted() const
+    {
+#if defined(__SSE2__)
+        return to_mask(m_control);
+#else
+        Mask mask = 0;
+        for (size_t i = 0; i < size; ++i) {
+            if (m_control[i] & 0x80)
+                mask |= 1u << i;
+        }
+        return mask;
+#endif
+    }
+
+private:
+#if defined(__SSE2__)
+    template<typename VectorType>
+    static ALWAYS_INLINE Mask to_mask(VectorType vector)
+    {
+        return static_cast<Mask>(__builtin_ia32_pmovmskb128((SIMD::c8x16)vector));
+    }
+#endif
+
+    SIMD::u8x16 m_control;
+};
+
+}
+
+template<typename TableType, typename T>
+class FlatHashTableIterator {
+    friend TableType;
+
+public:
+    bool operator==(FlatHashTableIterator const& other) const { return m_index == other.m_index; }
+    bool operator!=(FlatHashTableIterator const& other) const { return m_index != other.m_index; }
+    T& operator*() { return m_slots[m_index]; }
+    T* operator->() { return &m_slots[m_index]; }
+    void operator++() { skip_to_next(); }
+
+private:
+    void skip_to_next()
+    {
+        do {
+            ++m_index;
+        } while (m_index < m_capacity && (m_control[m_index] & 0x80));
+    }
+
+    FlatHashTableIterator(u8 const* control, T* slots, size_t index, size_t capacity)
+        : m_control(control)
+        , m_slots(slots)
+        , m_index(index)
+        , m_capacity(capacity)
+    {
+    }
+
+    u8 const* m_control { nullptr };
+    T* m_slots { nullptr };
+    size_t m_index { 0 };
+    size_t m_capacity { 0 };
+};
+
+// FlatHashTable is an open addressing hash table in the style of Abseil's "Swiss tables".
+//
+// Unlike HashTable, the per-bucket state lives in a separate array of control bytes, which is
+// split into groups of 16. A full bucket's control byte holds 7 bits of the value's hash, so a
+// lookup can compare a whole group against the hash in one go (using SSE2 where available) and only
+// looks at the values whose hash bits match. Most unsuccessful probes thus never touch the values.
+//
+// The trade-off is that removal leaves tombstones behind, and that there is no ordered variant.
+template<typename T, typename TraitsForT>
+class FlatHashTable {
+    using Control = Detail::FlatHashTableControl;
+    using Group = Detail::FlatHashTableGroup;
+
+    static constexpr size_t minimum_capacity = Group::size;
+
+    // Tombstones count towards the load, as far as probing is concerned they are full buckets.
+    static constexpr size_t max_load_factor_numerator = 7;
+    static constexpr size_t max_load_factor_denominator = 8;
+
+public:
+    FlatHashTable() = default;
+    explicit FlatHashTable(size_t capacity) { ensure_capacity(capacity); }
+
+    ~FlatHashTable()
+    {
+        if (!m_control)
+            return;
+
+        if constexpr (!IsTriviallyDestructible<T>) {
+            for (size_t i = 0; i < m_capacity; ++i) {
+                if (is_full(m_control[i]))
+                    m_slots[i].~T();
+            }
+        }
+
+        kfree_sized(m_control, size_in_bytes(m_capacity));
+    }
+
+    FlatHashTable(FlatHashTable const& other)
+    {
+        ensure_capacity(other.size());
+        for (auto& it : other)
+            set(it);
+    }
+
+    FlatHashTable& operator=(FlatHashTable const& other)
+    {
+        FlatHashTable temporary(other);
+        swap(*this, temporary);
+        return *this;
+    }
+
+    FlatHashTable(FlatHashTable&& other) noexcept
+        : m_control(exchange(other.m_control, nullptr))
+        , m_slots(exchange(other.m_slots, nullptr))
+        , m_size(exchange(other.m_size, 0))
+        , m_deleted_count(exchange(other.m_deleted_count, 0))
+        , m_capacity(exchange(other.m_capacity, 0))
+    {
+    }
+
+    FlatHashTable& operator=(FlatHashTable&& other) noexcept
+    {
+        FlatHashTable temporary { move(other) };
+        swap(*this, temporary);
+        return *this;
+    }
+
+    friend void swap(FlatHashTable& a, FlatHashTable& b) noexcept
+    {
+        swap(a.m_control, b.m_control);
+        swap(a.m_slots, b.m_slots);
+        swap(a.m_size, b.m_size);
+        swap(a.m_deleted_count, b.m_deleted_count);
+        swap(a.m_capacity, b.m_capacity);
+    }
+
+    [[nodiscard]] bool is_empty() const { return m_size == 0; }
+    [[nodiscard]] size_t size() const { return m_size; }
+    [[nodiscard]] size_t capacity() const { return m_capacity; }
+
+    ErrorOr<void> try_ensure_capacity(size_t capacity)
+    {
+        size_t required_capacity = minimum_capacity;
+        while (max_load(required_capacity) < capacity)
+            required_capacity *= 2;
+        if (required_capacity <= m_capacity)
+            return {};
+        return try_rehash(required_capacity);
+    }
+
+    void ensure_capacity(size_t capacity)
+    {
+        MUST(try_ensure_capacity(capacity));
+    }
+
+    [[nodiscard]] bool contains(T const& value) const
+    {
+        return find(value) != end();
+    }
+
+    template<Concepts::HashCompatible<T> K>
+    requires(IsSame<TraitsForT, Traits<T>>) [[nodiscard]] bool contains(K const& value) const
+    {
+        return find(value) != end();
+    }
+
+    using Iterator = FlatHashTableIterator<FlatHashTable, T>;
+    using ConstIterator = FlatHashTableIterator<const FlatHashTable, const T>;
+
+    [[nodiscard]] Iterator begin()
+    {
+        auto it = Iterator(m_control, m_slots, 0, m_capacity);
+        if (m_capacity > 0 && !is_full(m_control[0]))
+            it.skip_to_next();
+        return it;
+    }
+
+    [[nodiscard]] Iterator end()
+    {
+        return Iterator(m_control, m_slots, m_capacity, m_capacity);
+    }
+
+    [[nodiscard]] ConstIterator begin() const
+    {
+        auto it = ConstIterator(m_control, m_slots, 0, m_capacity);
+        if (m_capacity > 0 && !is_full(m_control[0]))
+            it.skip_to_next();
+        return it;
+    }
+
+    [[nodiscard]] ConstIterator end() const
+    {
+        return ConstIterator(m_control, m_slots, m_capacity, m_capacity);
+    }
+
+    void clear()
+    {
+        *this = FlatHashTable();
+    }
+
+    void clear_with_capacity()
+    {
+        if (m_capacity == 0)
+            return;
+        if constexpr (!IsTriviallyDestructible<T>) {
+            for (auto& value : *this)
+                value.~T();
+        }
+        __builtin_memset(m_control, to_underlying(Control::Empty), m_capacity);
+        m_size = 0;
+        m_deleted_count = 0;
+    }
+
+    template<typename U = T>
+    ErrorOr<HashSetResult> try_set(U&& value, HashSetExistingEntryBehavior existing_entry_behavior = HashSetExistingEntryBehavior::Replace)
+    {
+        auto hash = TraitsForT::hash(value);
+        auto index = lookup_with_hash(hash, [&](auto& other) { return TraitsForT::equals(other, static_cast<T const&>(value)); });
+        if (index != m_capacity) {
+            if (existing_entry_behavior == HashSetExistingEntryBehavior::Keep)
+                return HashSetResult::KeptExistingEntry;
+            m_slots[index] = forward<U>(value);
+            return HashSetResult::ReplacedExistingEntry;
+        }
+
+        if (should_grow()) {
+            // If a good chunk of the load is tombstones, reclaim them instead of growing.
+            auto new_capacity = m_size + 1 > max_load(m_capacity) / 2 ? m_capacity * 2 : m_capacity;
+            TRY(try_rehash(max(new_capacity, minimum_capacity)));
+        }
+
+        insert_new_value(hash, forward<U>(value));
+        return HashSetResult::InsertedNewEntry;
+    }
+
+    template<typename U = T>
+    HashSetResult set(U&& value, HashSetExistingEntryBehavior existing_entry_behaviour = HashSetExistingEntryBehavior::Replace)
+    {
+        return MUST(try_set(forward<U>(value), existing_entry_behaviour));
+    }
+
+    template<typename TUnaryPredicate>
+    [[nodiscard]] Iterator find(unsigned hash, TUnaryPredicate predicate)
+    {
+        return Iterator(m_control, m_slots, lookup_with_hash(hash, move(predicate)), m_capacity);
+    }
+
+    [[nodiscard]] Iterator find(T const& value)
+    {
+        return find(TraitsForT::hash(value), [&](auto& other) { return TraitsForT::equals(value, other); });
+    }
+
+    template<typename TUnaryPredicate>
+    [[nodiscard]] ConstIterator find(unsigned hash, TUnaryPredicate predicate) const
+    {
+        return ConstIterator(m_control, m_slots, lookup_with_hash(hash, move(predicate)), m_capacity);
+    }
+
+    [[nodiscard]] ConstIterator find(T const& value) const
+    {
+        return find(TraitsForT::hash(value), [&](auto& other) { return TraitsForT::equals(value, other); });
+    }
+
+    template<Concepts::HashCompatible<T> K>
+    requires(IsSame<TraitsForT, Traits<T>>) [[nodiscard]] Iterator find(K const& value)
+    {
+        return find(Traits<K>::hash(value), [&](auto& other) { return Traits<T>::equals(other, value); });
+    }
+
+    template<Concepts::HashCompatible<T> K>
+    requires(IsSame<TraitsForT, Traits<T>>) [[nodiscard]] ConstIterator find(K const& value) const
+    {
+        return find(Traits<K>::hash(value), [&](auto& other) { return Traits<T>::equals(other, value); });
+    }
+
+    bool remove(T const& value)
+    {
+        auto it = find(value);
+        if (it != end()) {
+            remove(it);
+            return true;
+        }
+        return false;
+    }
+
+    template<Concepts::HashCompatible<T> K>
+    requires(IsSame<TraitsForT, Traits<T>>) bool remove(K const& value)
+    {
+        auto it = find(value);
+        if (it != end()) {
+            remove(it);
+            return true;
+        }
+        return false;
+    }
+
+    // This invalidates the iterator
+    void remove(Iterator& iterator)
+    {
+        VERIFY(iterator.m_index < m_capacity);
+        delete_slot(iterator.m_index);
+        iterator.m_index = m_capacity;
+    }
+
+    template<typename TUnaryPredicate>
+    bool remove_all_matching(TUnaryPredicate const& predicate)
+    {
+        // Removing never moves other values around, so we can simply walk the table once.
+        bool has_removed_anything = false;
+        for (size_t i = 0; i < m_capacity; ++i) {
+            if (!is_full(m_control[i]) || !predicate(m_slots[i]))
+                continue;
+            delete_slot(i);
+            has_removed_anything = true;
+        }
+        return has_removed_anything;
+    }
+
+private:
+    static constexpr bool is_full(u8 control) { return (control & 0x80) == 0; }
+    static constexpr size_t max_load(size_t capacity) { return capacity * max_load_factor_numerator / max_load_factor_denominator; }
+
+    // The low 7 bits of the hash go into the control byte, the rest picks the first group to probe.
+    static constexpr u8 hash_bits(unsigned hash) { return hash & 0x7f; }
+    static constexpr size_t first_group(unsigned hash) { return hash >> 7; }
+
+    static constexpr size_t slots_offset(size_t capacity) { return round_up_to_power_of_two(capacity, alignof(T)); }
+    static constexpr size_t size_in_bytes(size_t capacity) { return slots_offset(capacity) + sizeof(T) * capacity; }
+
+    size_t group_count() const { return m_capacity / Group::size; }
+    bool should_grow() const { return m_size + m_deleted_count + 1 > max_load(m_capacity); }
+
+    // Probing visits the groups in triangular order: i, i+1, i+3, i+6, ... Since the number of groups
+    // is a power of two, this reaches every group exactly once within group_count() steps.
+    template<typename TUnaryPredicate>
+    [[nodiscard]] size_t lookup_with_hash(unsigned hash, TUnaryPredicate predicate) const
+    {
+        if (is_empty())
+            return m_capacity;
+
+        auto mask = group_count() - 1;
+        auto group_index = first_group(hash) & mask;
+        for (size_t step = 1; step <= group_count(); ++step) {
+            auto group_start = group_index * Group::size;
+            Group group(&m_control[group_start]);
+            for (auto matches = group.match(hash_bits(hash)); matches != 0; matches &= matches - 1) {
+                auto index = group_start + count_trailing_zeroes(matches);
+                if (predicate(m_slots[index]))
+                    return index;
+            }
+            // Values only ever get placed past a group that was full, so an empty bucket ends the probe.
+            if (group.match_empty() != 0)
+                break;
+            group_index = (group_index + step) & mask;
+        }
+        return m_capacity;
+    }
+
+    size_t find_slot_for_insertion(unsigned hash) const
+    {
+        auto mask = group_count() - 1;
+        auto group_index = first_group(hash) & mask;
+        for (size_t step = 1; step <= group_count(); ++step) {
+            auto group_start = group_index * Group::size;
+            if (auto matches = Group(&m_control[group_start]).match_empty_or_deleted(); matches != 0)
+                return group_start + count_trailing_zeroes(matches);
+            group_index = (group_index + step) & mask;
+        }
+        // We never let the table fill up completely, so there is always a bucket to be found.
+        VERIFY_NOT_REACHED();
+    }
+
+    template<typename U>
+    void insert_new_value(unsigned hash, U&& value)
+    {
+        auto index = find_slot_for_insertion(hash);
+        if (m_control[index] == to_underlying(Control::Deleted))
+            --m_deleted_count;
+        new (&m_slots[index]) T(forward<U>(value));
+        m_control[index] = hash_bits(hash);
+        ++m_size;
+    }
+
+    void delete_slot(size_t index)
+    {
+        VERIFY(is_full(m_control[index]));
+        m_slots[index].~T();
+        --m_size;
+
+        // If this bucket's group still has an empty bucket, no probe ever went past it and we don't
+        // need to leave a tombstone behind.
+        auto group_start = index & ~(Group::size - 1);
+        if (Group(&m_control[group_start]).match_empty() != 0) {
+            m_control[index] = to_underlying(Control::Empty);
+        } else {
+            m_control[index] = to_underlying(Control::Deleted);
+            ++m_deleted_count;
+        }
+    }
+
+    ErrorOr<void> try_rehash(size_t new_capacity)
+    {
+        VERIFY(new_capacity >= minimum_capacity && is_power_of_two(new_capacity));
+        VERIFY(max_load(new_capacity) >= m_size);
+
+        auto* new_storage = static_cast<u8*>(kmalloc(size_in_bytes(new_capacity)));
+        if (!new_storage)
+            return Error::from_errno(ENOMEM);
+        __builtin_memset(new_storage, to_underlying(Control::Empty), new_capacity);
+
+        auto* old_control = m_control;
+        auto* old_slots = m_slots;
+        auto old_capacity = m_capacity;
+
+        m_control = new_storage;
+        m_slots = reinterpret_cast<T*>(new_storage + slots_offset(new_capacity));
+        m_capacity = new_capacity;
+        m_size = 0;
+        m_deleted_count = 0;
+
+        if (!old_control)
+            return {};
+
+        for (size_t i = 0; i < old_capacity; ++i) {
+            if (!is_full(old_control[i]))
+                continue;
+            insert_new_value(TraitsForT::hash(old_slots[i]), move(old_slots[i]));
+            old_slots[i].~T();
+        }
+
+        kfree_sized(old_control, size_in_bytes(old_capacity));
+        return {};
+    }
+
+    u8* m_control { nullptr };
+    T* m_slots { nullptr };
+    size_t m_size { 0 };
+    size_t m_deleted_count { 0 };
+    size_t m_capacity { 0 };
+};
+
+}
+
+#if USING_AK_GLOBALLY
+using AK::FlatHashTable;
+#endif
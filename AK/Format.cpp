@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BuiltinWrappers.h>
 #include <AK/CharacterTypes.h>
 #include <AK/Format.h>
 #include <AK/GenericLexer.h>
@@ -20,6 +21,7 @@
 #    include <Kernel/Thread.h>
 #    include <Kernel/Time/TimeManagement.h>
 #else
+#    include <AK/StringFloatingPointConversions.h>
 #    include <math.h>
 #    include <stdio.h>
 #    include <string.h>
@@ -46,6 +48,23 @@ namespace {
 
 static constexpr size_t use_next_index = NumericLimits<size_t>::max();
 
+static constexpr auto two_digit_lookup = [] {
+    Array<char, 200> table {};
+    for (size_t i = 0; i < 100; ++i) {
+        table[2 * i] = static_cast<char>('0' + i / 10);
+        table[2 * i + 1] = static_cast<char>('0' + i % 10);
+    }
+    return table;
+}();
+
+static constexpr size_t count_decimal_digits(u64 value)
+{
+    size_t digits = 1;
+    for (u64 threshold = 10; digits < 20 && value >= threshold; threshold *= 10)
+        ++digits;
+    return digits;
+}
+
 // The worst case is that we have the largest 64-bit value formatted as binary number, this would take
 // 65 bytes. Choosing a larger power of two won't hurt and is a bit of mitigation against out-of-bounds accesses.
 static constexpr size_t convert_unsigned_to_string(u64 value, Array<u8, 128>& buffer, u8 base, bool upper_case)
@@ -54,19 +73,42 @@ static constexpr size_t convert_unsigned_to_string(u64 value, Array<u8, 128>& bu
 
     constexpr char const* lowercase_lookup = "0123456789abcdef";
     constexpr char const* uppercase_lookup = "0123456789ABCDEF";
+    auto const* lookup = upper_case ? uppercase_lookup : lowercase_lookup;
 
     if (value == 0) {
         buffer[0] = '0';
         return 1;
     }
 
+    // Work out how many digits there are up front, so that they can be written back to front in place.
+    if (base == 10) {
+        auto const used = count_decimal_digits(value);
+        auto position = used;
+        for (; value >= 100; value /= 100) {
+            auto const pair = (value % 100) * 2;
+            buffer[--position] = two_digit_lookup[pair + 1];
+            buffer[--position] = two_digit_lookup[pair];
+        }
+        if (value >= 10) {
+            buffer[--position] = two_digit_lookup[value * 2 + 1];
+            buffer[--position] = two_digit_lookup[value * 2];
+        } else {
+            buffer[--position] = static_cast<u8>('0' + value);
+        }
+        return used;
+    }
+
+    if ((base & (base - 1)) == 0) {
+        auto const bits_per_digit = count_trailing_zeroes(base);
+        auto const used = ceil_div<size_t, size_t>(64 - count_leading_zeroes(value), bits_per_digit);
+        for (auto position = used; position > 0; value >>= bits_per_digit)
+            buffer[--position] = lookup[value & (base - 1)];
+        return used;
+    }
+
     size_t used = 0;
     while (value > 0) {
-        if (upper_case)
-            buffer[used++] = uppercase_lookup[value % base];
-        else
-            buffer[used++] = lowercase_lookup[value % base];
-
+        buffer[used++] = lookup[value % base];
         value /= base;
     }
 
@@ -78,25 +120,68 @@ static constexpr size_t convert_unsigned_to_string(u64 value, Array<u8, 128>& bu
 
 ErrorOr<void> vformat_impl(TypeErasedFormatParams& params, FormatBuilder& builder, FormatParser& parser)
 {
-    auto const literal = parser.consume_literal();
-    TRY(builder.put_literal(literal));
+    for (;;) {
+        auto const literal = parser.consume_literal();
+        TRY(builder.put_literal(literal));
+
+        FormatParser::FormatSpecifier specifier;
+        if (!parser.consume_specifier(specifier)) {
+            VERIFY(parser.is_eof());
+            return {};
+        }
 
-    FormatParser::FormatSpecifier specifier;
-    if (!parser.consume_specifier(specifier)) {
-        VERIFY(parser.is_eof());
-        return {};
+        if (specifier.index == use_next_index)
+            specifier.index = params.take_next_index();
+
+        auto& parameter = params.parameters().at(specifier.index);
+
+        FormatParser argparser { specifier.flags };
+        TRY(parameter.formatter(params, builder, argparser, parameter.value));
+    }
+}
+
+#ifndef KERNEL
+// Appends `value', which has to be finite and not negative, with at most `precision' digits after the decimal point.
+// The digits are those of the shortest decimal that round-trips to `value', cut off (not rounded) at the precision.
+ErrorOr<void> append_decimal_digits(StringBuilder& builder, double value, size_t precision, bool pad_fraction)
+{
+    auto const decimal = convert_floating_point_to_decimal_exponential_form(value);
+
+    Array<u8, 128> buffer;
+    auto const digit_count = convert_unsigned_to_string(decimal.fraction, buffer, 10, false);
+    StringView const digits { buffer.span().trim(digit_count) };
+
+    auto const integer_digit_count = static_cast<i64>(digit_count) + decimal.exponent;
+    if (integer_digit_count <= 0) {
+        TRY(builder.try_append('0'));
+    } else if (decimal.exponent >= 0) {
+        TRY(builder.try_append(digits));
+        TRY(builder.try_append_repeated('0', decimal.exponent));
+    } else {
+        TRY(builder.try_append(digits.substring_view(0, integer_digit_count)));
     }
 
-    if (specifier.index == use_next_index)
-        specifier.index = params.take_next_index();
+    if (precision == 0)
+        return {};
+
+    size_t leading_zeroes = integer_digit_count < 0 ? min<size_t>(-integer_digit_count, precision) : 0;
+    auto fraction_digits = decimal.exponent < 0 ? digits.substring_view(max<i64>(integer_digit_count, 0)) : StringView {};
+    fraction_digits = fraction_digits.substring_view(0, min(fraction_digits.length(), precision - leading_zeroes));
+    fraction_digits = fraction_digits.trim("0"sv, TrimMode::Right);
+    if (fraction_digits.is_empty())
+        leading_zeroes = 0;
 
-    auto& parameter = params.parameters().at(specifier.index);
+    if (!pad_fraction && fraction_digits.is_empty())
+        return {};
 
-    FormatParser argparser { specifier.flags };
-    TRY(parameter.formatter(params, builder, argparser, parameter.value));
-    TRY(vformat_impl(params, builder, parser));
+    TRY(builder.try_append('.'));
+    TRY(builder.try_append_repeated('0', leading_zeroes));
+    TRY(builder.try_append(fraction_digits));
+    if (pad_fraction)
+        TRY(builder.try_append_repeated('0', precision - leading_zeroes - fraction_digits.length()));
     return {};
 }
+#endif
 
 } // namespace AK::{anonymous}
 
@@ -192,16 +277,18 @@ bool FormatParser::consume_replacement_field(size_t& index)
 
 ErrorOr<void> FormatBuilder::put_padding(char fill, size_t amount)
 {
-    for (size_t i = 0; i < amount; ++i)
-        TRY(m_builder.try_append(fill));
-    return {};
+    return m_builder.try_append_repeated(fill, amount);
 }
 ErrorOr<void> FormatBuilder::put_literal(StringView value)
 {
-    for (size_t i = 0; i < value.length(); ++i) {
-        TRY(m_builder.try_append(value[i]));
-        if (value[i] == '{' || value[i] == '}')
-            ++i;
+    // Braces only appear doubled up in literals, so everything up to and including the first one can be copied as is.
+    while (!value.is_empty()) {
+        auto const brace = value.find_any_of("{}"sv);
+        if (!brace.has_value())
+            return m_builder.try_append(value);
+
+        TRY(m_builder.try_append(value.substring_view(0, *brace + 1)));
+        value = value.substring_view(min(*brace + 2, value.length()));
     }
     return {};
 }
@@ -254,6 +341,11 @@ ErrorOr<void> FormatBuilder::put_u64(
     Array<u8, 128> buffer;
 
     auto const used_by_digits = convert_unsigned_to_string(value, buffer, base, upper_case);
+    StringView const digits { buffer.span().trim(used_by_digits) };
+
+    // This is what a plain "{}" ends up as, so don't bother working out the layout.
+    if (min_width == 0 && !prefix && !is_negative && sign_mode == SignMode::OnlyIfNeeded)
+        return m_builder.try_append(digits);
 
     size_t used_by_prefix = 0;
     if (align == Align::Right && zero_pad) {
@@ -304,9 +396,7 @@ ErrorOr<void> FormatBuilder::put_u64(
     };
 
     auto const put_digits = [&]() -> ErrorOr<void> {
-        for (size_t i = 0; i < used_by_digits; ++i)
-            TRY(m_builder.try_append(buffer[i]));
-        return {};
+        return m_builder.try_append(digits);
     };
 
     if (align == Align::Left) {
@@ -468,6 +558,19 @@ ErrorOr<void> FormatBuilder::put_f64(
     if (is_negative)
         value = -value;
 
+    if (base == 10) {
+        if (is_negative)
+            TRY(string_builder.try_append('-'));
+        else if (sign_mode == SignMode::Always)
+            TRY(string_builder.try_append('+'));
+        else if (sign_mode == SignMode::Reserved)
+            TRY(string_builder.try_append(' '));
+
+        TRY(append_decimal_digits(string_builder, value, precision, zero_pad || display_mode == RealNumberDisplayMode::FixedPoint));
+        TRY(put_string(string_builder.string_view(), align, min_width, NumericLimits<size_t>::max(), fill));
+        return {};
+    }
+
     TRY(format_builder.put_u64(static_cast<u64>(value), base, false, upper_case, false, Align::Right, 0, ' ', sign_mode, is_negative));
 
     if (precision > 0) {
@@ -606,6 +709,10 @@ ErrorOr<void> vformat(StringBuilder& builder, StringView fmtstr, TypeErasedForma
 
 void StandardFormatter::parse(TypeErasedFormatParams& params, FormatParser& parser)
 {
+    // Most replacement fields are just "{}", which leaves everything at its default.
+    if (parser.is_eof())
+        return;
+
     if ("<^>"sv.contains(parser.peek(1))) {
         VERIFY(!parser.next_is(is_any_of("{}"sv)));
         m_fill = parser.consume();
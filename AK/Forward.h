@@ -91,6 +91,12 @@ class HashMap;
 template<typename K, typename V, typename KeyTraits = Traits<K>, typename ValueTraits = Traits<V>>
 using OrderedHashMap = HashMap<K, V, KeyTraits, ValueTraits, true>;
 
+template<typename T, typename TraitsForT = Traits<T>>
+class FlatHashTable;
+
+template<typename K, typename V, typename KeyTraits = Traits<K>, typename ValueTraits = Traits<V>>
+class FlatHashMap;
+
 template<typename T>
 class Badge;
 
@@ -171,6 +177,8 @@ using AK::Error;
 using AK::ErrorOr;
 using AK::FixedArray;
 using AK::FixedPoint;
+using AK::FlatHashMap;
+using AK::FlatHashTable;
 using AK::Function;
 using AK::GenericLexer;
 using AK::HashMap;
@@ -59,8 +59,7 @@ StringView GenericLexer::consume_line()
 StringView GenericLexer::consume_until(char stop)
 {
     size_t start = m_index;
-    while (!is_eof() && peek() != stop)
-        m_index++;
+    m_index = m_input.find(stop, m_index).value_or(m_input.length());
     size_t length = m_index - start;
 
     if (length == 0)
@@ -71,22 +70,14 @@ StringView GenericLexer::consume_until(char stop)
 // Consume and return characters until the string `stop` is found
 StringView GenericLexer::consume_until(char const* stop)
 {
-    size_t start = m_index;
-    while (!is_eof() && !next_is(stop))
-        m_index++;
-    size_t length = m_index - start;
-
-    if (length == 0)
-        return {};
-    return m_input.substring_view(start, length);
+    return consume_until(StringView { stop, __builtin_strlen(stop) });
 }
 
 // Consume and return characters until the string `stop` is found
 StringView GenericLexer::consume_until(StringView stop)
 {
     size_t start = m_index;
-    while (!is_eof() && !next_is(stop))
-        m_index++;
+    m_index = m_input.find(stop, m_index).value_or(m_input.length());
     size_t length = m_index - start;
 
     if (length == 0)
@@ -6,31 +6,29 @@
 
 #pragma once
 
-#include <AK/GenericLexer.h>
+#include <AK/JsonStreamParser.h>
 #include <AK/JsonValue.h>
 
 namespace AK {
 
-class JsonParser : private GenericLexer {
+// Parses a whole JSON document into a JsonValue. Use JsonStreamParser directly to look at large
+// documents without keeping all of them in memory.
+class JsonParser {
 public:
     explicit JsonParser(StringView input)
-        : GenericLexer(input)
+        : m_parser(input)
+    {
+    }
+
+    explicit JsonParser(Stream& input)
+        : m_parser(input)
     {
     }
 
     ErrorOr<JsonValue> parse();
 
 private:
-    ErrorOr<JsonValue> parse_helper();
-
-    ErrorOr<DeprecatedString> consume_and_unescape_string();
-    ErrorOr<JsonValue> parse_array();
-    ErrorOr<JsonValue> parse_object();
-    ErrorOr<JsonValue> parse_number();
-    ErrorOr<JsonValue> parse_string();
-    ErrorOr<JsonValue> parse_false();
-    ErrorOr<JsonValue> parse_true();
-    ErrorOr<JsonValue> parse_null();
+    JsonStreamParser m_parser;
 };
 
 }
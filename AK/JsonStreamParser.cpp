@@ -0,0 +1,428 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BuiltinWrappers.h>
+#include <AK/CharacterTypes.h>
+#include <AK/FloatingPointStringConversions.h>
+#include <AK/JsonStreamParser.h>
+#include <AK/SIMD.h>
+#include <AK/Stream.h>
+#include <AK/StringUtils.h>
+
+#ifdef KERNEL
+#    error JsonStreamParser is currently not available for the Kernel because it disallows floating point.
+#endif
+
+namespace AK {
+
+static constexpr size_t initial_stream_buffer_size = 64 * KiB;
+
+static constexpr bool is_space(u8 ch)
+{
+    return ch == '\t' || ch == '\n' || ch == '\r' || ch == ' ';
+}
+
+static constexpr bool is_number_character(u8 ch)
+{
+    return is_ascii_digit(ch) || ch == '-' || ch == '+' || ch == '.' || ch == 'e' || ch == 'E';
+}
+
+// Most of the time is spent looking for the end of a string or a run of whitespace, so we look at
+// 16 bytes at a time where we can.
+#if defined(__SSE2__)
+static ALWAYS_INLINE SIMD::u8x16 load_chunk(u8 const* data)
+{
+    SIMD::u8x16 chunk;
+    __builtin_memcpy(&chunk, data, sizeof(chunk));
+    return chunk;
+}
+
+template<typename VectorType>
+static ALWAYS_INLINE u32 to_mask(VectorType vector)
+{
+    return static_cast<u32>(__builtin_ia32_pmovmskb128((SIMD::c8x16)vector));
+}
+#endif
+
+// Returns the offset of the first '"', '\' or control character, or bytes.size() if there is none.
+static size_t find_string_special_character(ReadonlyBytes bytes)
+{
+    size_t offset = 0;
+#if defined(__SSE2__)
+    for (; offset + 16 <= bytes.size(); offset += 16) {
+        auto chunk = load_chunk(bytes.data() + offset);
+        if (auto mask = to_mask((chunk == '"') | (chunk == '\\') | (chunk < 0x20)); mask != 0)
+            return offset + count_trailing_zeroes(mask);
+    }
+#endif
+    for (; offset < bytes.size(); ++offset) {
+        auto ch = bytes[offset];
+        if (ch == '"' || ch == '\\' || is_ascii_c0_control(ch))
+            return offset;
+    }
+    return offset;
+}
+
+// Returns the offset of the first byte that isn't whitespace, or bytes.size() if there is none.
+static size_t find_non_whitespace(ReadonlyBytes bytes)
+{
+    size_t offset = 0;
+    // Short runs between tokens are the common case, so check the first byte before going wide.
+    if (offset < bytes.size() && !is_space(bytes[offset]))
+        return offset;
+#if defined(__SSE2__)
+    for (; offset + 16 <= bytes.size(); offset += 16) {
+        auto chunk = load_chunk(bytes.data() + offset);
+        auto whitespace = to_mask((chunk == ' ') | (chunk == '\n') | (chunk == '\r') | (chunk == '\t'));
+        if (whitespace != 0xffff)
+            return offset + count_trailing_zeroes(~whitespace);
+    }
+#endif
+    for (; offset < bytes.size(); ++offset) {
+        if (!is_space(bytes[offset]))
+            return offset;
+    }
+    return offset;
+}
+
+JsonStreamParser::JsonStreamParser(StringView input)
+    : m_input(input.bytes())
+{
+}
+
+JsonStreamParser::JsonStreamParser(Stream& input)
+    : m_stream(&input)
+{
+}
+
+ErrorOr<bool> JsonStreamParser::read_more()
+{
+    if (!m_stream)
+        return false;
+
+    if (m_buffer.is_empty())
+        TRY(m_buffer.try_resize(initial_stream_buffer_size));
+
+    // Move whatever we haven't consumed yet to the front, and make room if a single token
+    // is larger than the buffer.
+    auto unconsumed = remaining().size();
+    if (m_position > 0 && unconsumed > 0)
+        __builtin_memmove(m_buffer.data(), m_input.data() + m_position, unconsumed);
+    m_position = 0;
+    if (unconsumed == m_buffer.size())
+        TRY(m_buffer.try_resize(m_buffer.size() * 2));
+
+    for (;;) {
+        auto read_bytes = TRY(m_stream->read(m_buffer.bytes().slice(unconsumed)));
+        m_input = m_buffer.bytes().trim(unconsumed + read_bytes.size());
+        if (!read_bytes.is_empty())
+            return true;
+        if (m_stream->is_eof())
+            return false;
+    }
+}
+
+ErrorOr<bool> JsonStreamParser::ensure_available(size_t count)
+{
+    while (remaining().size() < count) {
+        if (!TRY(read_more()))
+            return false;
+    }
+    return true;
+}
+
+ErrorOr<Optional<char>> JsonStreamParser::peek()
+{
+    if (!TRY(ensure_available(1)))
+        return Optional<char> {};
+    return Optional<char> { static_cast<char>(m_input[m_position]) };
+}
+
+ErrorOr<void> JsonStreamParser::skip_whitespace()
+{
+    for (;;) {
+        auto bytes = remaining();
+        auto offset = find_non_whitespace(bytes);
+        m_position += offset;
+        if (offset < bytes.size() || !TRY(read_more()))
+            return {};
+    }
+}
+
+ErrorOr<StringView> JsonStreamParser::parse_string()
+{
+    if (TRY(peek()) != '"')
+        return Error::from_string_literal("JsonParser: Expected '\"'");
+    ++m_position;
+
+    // If the string has no escapes and is entirely in the buffer, we can hand it out as is.
+    {
+        auto bytes = remaining();
+        auto offset = find_string_special_character(bytes);
+        if (offset < bytes.size() && bytes[offset] == '"') {
+            m_position += offset + 1;
+            return StringView { bytes.trim(offset) };
+        }
+    }
+
+    m_string_builder.clear();
+    for (;;) {
+        auto bytes = remaining();
+        auto offset = find_string_special_character(bytes);
+        TRY(m_string_builder.try_append(StringView { bytes.trim(offset) }));
+        m_position += offset;
+
+        if (offset == bytes.size()) {
+            if (!TRY(read_more()))
+                return Error::from_string_literal("JsonParser: Expected '\"'");
+            continue;
+        }
+
+        auto ch = m_input[m_position++];
+        if (ch == '"')
+            return m_string_builder.string_view();
+        if (ch != '\\')
+            return Error::from_string_literal("JsonParser: Error while parsing string");
+
+        auto escape = TRY(peek());
+        if (!escape.has_value())
+            return Error::from_string_literal("JsonParser: Error while parsing string");
+        ++m_position;
+
+        switch (*escape) {
+        case '"':
+        case '\\':
+        case '/':
+            TRY(m_string_builder.try_append(*escape));
+            break;
+        case 'n':
+            TRY(m_string_builder.try_append('\n'));
+            break;
+        case 'r':
+            TRY(m_string_builder.try_append('\r'));
+            break;
+        case 't':
+            TRY(m_string_builder.try_append('\t'));
+            break;
+        case 'b':
+            TRY(m_string_builder.try_append('\b'));
+            break;
+        case 'f':
+            TRY(m_string_builder.try_append('\f'));
+            break;
+        case 'u': {
+            if (!TRY(ensure_available(4)))
+                return Error::from_string_literal("JsonParser: EOF while parsing Unicode escape");
+            auto code_point = AK::StringUtils::convert_to_uint_from_hex(StringView { remaining().trim(4) });
+            if (!code_point.has_value())
+                return Error::from_string_literal("JsonParser: Error while parsing Unicode escape");
+            m_position += 4;
+            TRY(m_string_builder.try_append_code_point(code_point.value()));
+            break;
+        }
+        default:
+            return Error::from_string_literal("JsonParser: Error while parsing string");
+        }
+    }
+}
+
+ErrorOr<JsonValue> JsonStreamParser::parse_number()
+{
+    // Make sure that the whole number is in the buffer, so that we can look at it in one piece.
+    size_t length = 0;
+    for (;;) {
+        auto bytes = remaining();
+        while (length < bytes.size() && is_number_character(bytes[length]))
+            ++length;
+        if (length < bytes.size() || !TRY(read_more()))
+            break;
+    }
+    auto number = StringView { remaining().trim(length) };
+
+    size_t index = 0;
+    auto peek_at = [&](size_t offset) -> char {
+        return index + offset < number.length() ? number[index + offset] : '\0';
+    };
+
+    bool negative = false;
+    if (peek_at(0) == '-') {
+        ++index;
+        negative = true;
+
+        if (!is_ascii_digit(peek_at(0)))
+            return Error::from_string_literal("JsonParser: Unexpected '-' without further digits");
+    }
+
+    auto fallback_to_double_parse = [&]() -> ErrorOr<JsonValue> {
+        char const* start = number.characters_without_null_termination();
+        auto parse_result = parse_first_floating_point(start, start + number.length());
+        if (!parse_result.parsed_value())
+            return Error::from_string_literal("JsonParser: Invalid floating point");
+        m_position += parse_result.end_ptr - start;
+        return JsonValue(parse_result.value);
+    };
+
+    if (peek_at(0) == '0' && is_ascii_digit(peek_at(1))) {
+        // Leading zeros are not allowed, however we can have a '.' or 'e' with valid digits after just a zero.
+        return Error::from_string_literal("JsonParser: Cannot have leading zeros");
+    }
+
+    bool all_zero = true;
+    for (;;) {
+        char ch = peek_at(0);
+        if (ch == '.') {
+            if (!is_ascii_digit(peek_at(1)))
+                return Error::from_string_literal("JsonParser: Must have digits after decimal point");
+
+            return fallback_to_double_parse();
+        }
+        if (ch == 'e' || ch == 'E') {
+            char next = peek_at(1);
+            if (!is_ascii_digit(next) && ((next != '+' && next != '-') || !is_ascii_digit(peek_at(2))))
+                return Error::from_string_literal("JsonParser: Must have digits after exponent with an optional sign inbetween");
+
+            return fallback_to_double_parse();
+        }
+
+        if (is_ascii_digit(ch)) {
+            if (ch != '0')
+                all_zero = false;
+            ++index;
+            continue;
+        }
+
+        break;
+    }
+
+    // Negative zero is always a double
+    if (negative && all_zero) {
+        m_position += index;
+        return JsonValue(-0.0);
+    }
+
+    auto number_string = number.substring_view(0, index);
+
+    if (auto unsigned_number = number_string.to_uint<u64>(); unsigned_number.has_value()) {
+        m_position += index;
+        if (*unsigned_number <= NumericLimits<u32>::max())
+            return JsonValue((u32)*unsigned_number);
+        return JsonValue(*unsigned_number);
+    }
+    if (auto signed_number = number_string.to_int<i64>(); signed_number.has_value()) {
+        m_position += index;
+        if (*signed_number <= NumericLimits<i32>::max())
+            return JsonValue((i32)*signed_number);
+        return JsonValue(*signed_number);
+    }
+
+    // It's possible the unsigned value is bigger than u64 max
+    return fallback_to_double_parse();
+}
+
+ErrorOr<void> JsonStreamParser::parse_literal(StringView literal)
+{
+    if (!TRY(ensure_available(literal.length())) || StringView { remaining().trim(literal.length()) } != literal) {
+        if (literal == "true"sv)
+            return Error::from_string_literal("JsonParser: Expected 'true'");
+        if (literal == "false"sv)
+            return Error::from_string_literal("JsonParser: Expected 'false'");
+        return Error::from_string_literal("JsonParser: Expected 'null'");
+    }
+    m_position += literal.length();
+    return {};
+}
+
+ErrorOr<void> JsonStreamParser::parse_value(JsonStreamVisitor& visitor)
+{
+    TRY(skip_whitespace());
+    auto type_hint = TRY(peek()).value_or('\0');
+    switch (type_hint) {
+    case '{':
+        ++m_position;
+        TRY(m_nesting.try_append({ ContainerType::Object }));
+        return visitor.on_object_start();
+    case '[':
+        ++m_position;
+        TRY(m_nesting.try_append({ ContainerType::Array }));
+        return visitor.on_array_start();
+    case '"':
+        return visitor.on_string(TRY(parse_string()));
+    case '-':
+    case '0':
+    case '1':
+    case '2':
+    case '3':
+    case '4':
+    case '5':
+    case '6':
+    case '7':
+    case '8':
+    case '9':
+        return visitor.on_number(TRY(parse_number()));
+    case 'f':
+        TRY(parse_literal("false"sv));
+        return visitor.on_boolean(false);
+    case 't':
+        TRY(parse_literal("true"sv));
+        return visitor.on_boolean(true);
+    case 'n':
+        TRY(parse_literal("null"sv));
+        return visitor.on_null();
+    }
+
+    return Error::from_string_literal("JsonParser: Unexpected character");
+}
+
+ErrorOr<void> JsonStreamParser::parse(JsonStreamVisitor& visitor)
+{
+    TRY(parse_value(visitor));
+
+    while (!m_nesting.is_empty()) {
+        TRY(skip_whitespace());
+        auto& container = m_nesting.last();
+        bool is_object = container.type == ContainerType::Object;
+        char closing_character = is_object ? '}' : ']';
+
+        auto next = TRY(peek());
+        if (next == closing_character) {
+            ++m_position;
+            m_nesting.take_last();
+            TRY(is_object ? visitor.on_object_end() : visitor.on_array_end());
+            continue;
+        }
+
+        if (container.has_elements) {
+            if (next != ',')
+                return Error::from_string_literal("JsonParser: Expected ','");
+            ++m_position;
+            TRY(skip_whitespace());
+            if (TRY(peek()) == closing_character) {
+                if (is_object)
+                    return Error::from_string_literal("JsonParser: Unexpected '}'");
+                return Error::from_string_literal("JsonParser: Unexpected ']'");
+            }
+        }
+        container.has_elements = true;
+
+        if (is_object) {
+            TRY(visitor.on_object_key(TRY(parse_string())));
+            TRY(skip_whitespace());
+            if (TRY(peek()) != ':')
+                return Error::from_string_literal("JsonParser: Expected ':'");
+            ++m_position;
+        }
+
+        // Note that this may add to m_nesting, so `container` must not be used past this point.
+        TRY(parse_value(visitor));
+    }
+
+    TRY(skip_whitespace());
+    if (TRY(peek()).has_value())
+        return Error::from_string_literal("JsonParser: Didn't consume all input");
+    return {};
+}
+
+}
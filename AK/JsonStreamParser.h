@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/Error.h>
+#include <AK/Forward.h>
+#include <AK/JsonValue.h>
+#include <AK/StringBuilder.h>
+#include <AK/StringView.h>
+#include <AK/Vector.h>
+
+namespace AK {
+
+// Receives the contents of a JSON document from JsonStreamParser, in document order.
+// Returning an error from any of these stops the parse and makes it fail with that error.
+//
+// StringViews passed to these are only valid until the callback returns.
+class JsonStreamVisitor {
+public:
+    virtual ~JsonStreamVisitor() = default;
+
+    virtual ErrorOr<void> on_object_start() { return {}; }
+    virtual ErrorOr<void> on_object_key(StringView) { return {}; }
+    virtual ErrorOr<void> on_object_end() { return {}; }
+    virtual ErrorOr<void> on_array_start() { return {}; }
+    virtual ErrorOr<void> on_array_end() { return {}; }
+    virtual ErrorOr<void> on_string(StringView) { return {}; }
+    // Numbers are handed over the same way JsonParser stores them: as i32, u32, i64, u64 or double.
+    virtual ErrorOr<void> on_number(JsonValue) { return {}; }
+    virtual ErrorOr<void> on_boolean(bool) { return {}; }
+    virtual ErrorOr<void> on_null() { return {}; }
+};
+
+// An event based JSON parser. Instead of building a JsonValue tree, it tells a JsonStreamVisitor
+// about every value as it comes across it. Nesting is tracked with an explicit stack rather than by
+// recursion, so it only needs memory proportional to the nesting depth of the document (plus the
+// longest string in it), and can read the document from a Stream in chunks.
+class JsonStreamParser {
+    AK_MAKE_NONCOPYABLE(JsonStreamParser);
+    AK_MAKE_NONMOVABLE(JsonStreamParser);
+
+public:
+    explicit JsonStreamParser(StringView input);
+    explicit JsonStreamParser(Stream& input);
+
+    ErrorOr<void> parse(JsonStreamVisitor&);
+
+private:
+    enum class ContainerType : u8 {
+        Object,
+        Array,
+    };
+
+    struct Container {
+        ContainerType type;
+        bool has_elements { false };
+    };
+
+    ErrorOr<void> parse_value(JsonStreamVisitor&);
+    ErrorOr<StringView> parse_string();
+    ErrorOr<JsonValue> parse_number();
+    ErrorOr<void> parse_literal(StringView literal);
+
+    ErrorOr<void> skip_whitespace();
+    ErrorOr<bool> ensure_available(size_t count);
+    ErrorOr<bool> read_more();
+    ErrorOr<Optional<char>> peek();
+
+    ReadonlyBytes remaining() const { return m_input.slice(m_position); }
+
+    Stream* m_stream { nullptr };
+    ByteBuffer m_buffer;
+    ReadonlyBytes m_input;
+    size_t m_position { 0 };
+
+    Vector<Container, 16> m_nesting;
+    StringBuilder m_string_builder;
+};
+
+}
+
+#if USING_AK_GLOBALLY
+using AK::JsonStreamParser;
+using AK::JsonStreamVisitor;
+#endif
@@ -8,6 +8,8 @@
 
 #include <AK/Array.h>
 #include <AK/Assertions.h>
+#include <AK/BuiltinWrappers.h>
+#include <AK/SIMD.h>
 #include <AK/Span.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
@@ -15,6 +17,28 @@
 namespace AK {
 
 namespace Detail {
+
+#if defined(__SSE2__)
+ALWAYS_INLINE SIMD::u8x16 load_unaligned_u8x16(u8 const* data)
+{
+    SIMD::u8x16 chunk;
+    __builtin_memcpy(&chunk, data, sizeof(chunk));
+    return chunk;
+}
+
+template<typename VectorType>
+ALWAYS_INLINE u32 byte_mask(VectorType comparison)
+{
+    return static_cast<u32>(__builtin_ia32_pmovmskb128((SIMD::c8x16)comparison));
+}
+#else
+// Sets the top bit of every byte of `word' that is zero (and possibly of some bytes above a zero byte).
+ALWAYS_INLINE constexpr u64 zero_bytes_in(u64 word)
+{
+    return (word - 0x0101010101010101ull) & ~word & 0x8080808080808080ull;
+}
+#endif
+
 constexpr void const* bitap_bitwise(void const* haystack, size_t haystack_length, void const* needle, size_t needle_length)
 {
     VERIFY(needle_length < 32);
@@ -101,6 +125,126 @@ requires(requires { (*haystack_begin).data(); (*haystack_begin).size(); })
     return {};
 }
 
+// Returns the offset of the first `needle' byte in the haystack, like memchr().
+inline Optional<size_t> memchr_optional(void const* haystack, size_t haystack_length, u8 needle)
+{
+    auto const* bytes = static_cast<u8 const*>(haystack);
+    size_t offset = 0;
+
+#if defined(__SSE2__)
+    for (; offset + 32 <= haystack_length; offset += 32) {
+        auto first = Detail::load_unaligned_u8x16(bytes + offset) == needle;
+        auto second = Detail::load_unaligned_u8x16(bytes + offset + 16) == needle;
+        if (auto mask = Detail::byte_mask(first) | (Detail::byte_mask(second) << 16); mask != 0)
+            return offset + count_trailing_zeroes(mask);
+    }
+#else
+    u64 const repeated_needle = 0x0101010101010101ull * needle;
+    for (; offset + sizeof(u64) <= haystack_length; offset += sizeof(u64)) {
+        u64 word;
+        __builtin_memcpy(&word, bytes + offset, sizeof(word));
+        if (Detail::zero_bytes_in(word ^ repeated_needle) != 0)
+            break;
+    }
+#endif
+
+    for (; offset < haystack_length; ++offset) {
+        if (bytes[offset] == needle)
+            return offset;
+    }
+    return {};
+}
+
+// Returns the offset of the first byte in the haystack that is any of the `needles'.
+inline Optional<size_t> memchr_any_optional(void const* haystack, size_t haystack_length, ReadonlyBytes needles)
+{
+    if (needles.is_empty())
+        return {};
+    if (needles.size() == 1)
+        return memchr_optional(haystack, haystack_length, needles[0]);
+
+    auto const* bytes = static_cast<u8 const*>(haystack);
+    size_t offset = 0;
+
+    // A handful of needles is the common case (think delimiters), which we can just test for one after the other.
+    if (needles.size() <= 4) {
+#if defined(__SSE2__)
+        for (; offset + 16 <= haystack_length; offset += 16) {
+            auto chunk = Detail::load_unaligned_u8x16(bytes + offset);
+            auto matches = chunk == needles[0];
+            for (size_t i = 1; i < needles.size(); ++i)
+                matches |= chunk == needles[i];
+            if (auto mask = Detail::byte_mask(matches); mask != 0)
+                return offset + count_trailing_zeroes(mask);
+        }
+#endif
+        for (; offset < haystack_length; ++offset) {
+            for (auto needle : needles) {
+                if (bytes[offset] == needle)
+                    return offset;
+            }
+        }
+        return {};
+    }
+
+    Array<bool, 256> is_needle {};
+    for (auto needle : needles)
+        is_needle[needle] = true;
+    for (; offset < haystack_length; ++offset) {
+        if (is_needle[bytes[offset]])
+            return offset;
+    }
+    return {};
+}
+
+#if defined(__SSE2__)
+namespace Detail {
+
+// Looks for the first and last byte of the needle at the same time, 16 candidate positions at once, and only compares
+// the whole needle where both match. See http://0x80.pl/articles/simd-strfind.html for the idea.
+// That's quadratic for needles and haystacks that are made to fool the filter, so once comparing takes up more time
+// than scanning, we give up and hand the rest over to KMP.
+inline Optional<size_t> simd_filtered_memmem(u8 const* haystack, size_t haystack_length, u8 const* needle, size_t needle_length)
+{
+    VERIFY(needle_length >= 2 && needle_length <= haystack_length);
+
+    auto const first = needle[0];
+    auto const last = needle[needle_length - 1];
+    auto const candidate_count = haystack_length - needle_length + 1;
+    size_t compared_bytes = 0;
+
+    size_t offset = 0;
+    for (; offset + 16 <= candidate_count; offset += 16) {
+        auto first_matches = load_unaligned_u8x16(haystack + offset) == first;
+        auto last_matches = load_unaligned_u8x16(haystack + offset + needle_length - 1) == last;
+        for (auto mask = byte_mask(first_matches & last_matches); mask != 0; mask &= mask - 1) {
+            auto candidate = offset + count_trailing_zeroes(mask);
+            if (__builtin_memcmp(haystack + candidate + 1, needle + 1, needle_length - 2) == 0)
+                return candidate;
+            compared_bytes += needle_length;
+        }
+
+        if (compared_bytes > 2 * offset + 4 * KiB) [[unlikely]] {
+            offset += 16;
+            Array<ReadonlyBytes, 1> spans { ReadonlyBytes { haystack + offset, haystack_length - offset } };
+            auto result = memmem(spans.begin(), spans.end(), { needle, needle_length });
+            if (result.has_value())
+                return *result + offset;
+            return {};
+        }
+    }
+
+    for (; offset < candidate_count; ++offset) {
+        if (haystack[offset] == first && haystack[offset + needle_length - 1] == last
+            && __builtin_memcmp(haystack + offset + 1, needle + 1, needle_length - 2) == 0)
+            return offset;
+    }
+    return {};
+}
+
+}
+#endif
+
 inline Optional<size_t> memmem_optional(void const* haystack, size_t haystack_length, void const* needle, size_t needle_length)
 {
     if (needle_length == 0)
@@ -115,6 +259,12 @@ inline Optional<size_t> memmem_optional(void const* haystack, size_t haystack_le
         return {};
     }
 
+    if (needle_length == 1)
+        return memchr_optional(haystack, haystack_length, *static_cast<u8 const*>(needle));
+
+#if defined(__SSE2__)
+    return Detail::simd_filtered_memmem(static_cast<u8 const*>(haystack), haystack_length, static_cast<u8 const*>(needle), needle_length);
+#else
     if (needle_length < 32) {
         auto const* ptr = Detail::bitap_bitwise(haystack, haystack_length, needle, needle_length);
         if (ptr)
@@ -125,6 +275,7 @@ inline Optional<size_t> memmem_optional(void const* haystack, size_t haystack_le
     // Fallback to KMP.
     Array<ReadonlyBytes, 1> spans { ReadonlyBytes { (u8 const*)haystack, haystack_length } };
     return memmem(spans.begin(), spans.end(), { (u8 const*)needle, needle_length });
+#endif
 }
 
 inline void const* memmem(void const* haystack, size_t haystack_length, void const* needle, size_t needle_length)
@@ -7,15 +7,16 @@
 
 #pragma once
 
+#include <AK/BuiltinWrappers.h>
 #include <AK/InsertionSort.h>
 #include <AK/StdLibExtras.h>
 
 namespace AK {
 
 // This is a dual pivot quick sort. It is quite a bit faster than the single
-// pivot quick_sort below. The other quick_sort below should only be used when
-// you are stuck with simple iterators to a container and you don't have access
-// to the container itself.
+// pivot quick sort below, but like it has no protection against inputs that
+// make it quadratic. quick_sort() uses pattern_defeating_quick_sort() further
+// down, which should be preferred over both of them.
 //
 // We use a cutoff to insertion sort for partitions of size 7 or smaller.
 // The idea is to avoid recursion for small partitions.
@@ -139,28 +140,355 @@ void single_pivot_quick_sort(Iterator start, Iterator end, LessThan less_than)
     }
 }
 
+namespace Detail {
+
+// Pattern-defeating quicksort, after Orson Peters' pdqsort: https://github.com/orlp/pdqsort
+//
+// It starts out as a regular quicksort with a median of three (or for larger ranges, a pseudomedian
+// of nine) pivot. On top of that it:
+// - hands small ranges to insertion sort,
+// - notices ranges that were already partitioned and tries finishing them with a bounded insertion
+//   sort, which makes sorted and nearly sorted input linear,
+// - groups elements equal to an earlier pivot together, which makes input with many duplicates fast,
+// - shuffles a few elements around after an unbalanced partition to break up adversarial patterns,
+//   and falls back to heap sort if that keeps happening, so the worst case is O(n log n).
+//
+// Elements are only ever accessed through `col[index]`, swap() and less_than(), so this works for
+// things like LibC's qsort that can't move elements into temporaries.
+
+static constexpr ssize_t PDQ_INSERTION_SORT_CUTOFF = 24;
+static constexpr ssize_t PDQ_NINTHER_CUTOFF = 128;
+static constexpr ssize_t PDQ_PARTIAL_INSERTION_SORT_LIMIT = 8;
+static constexpr ssize_t PDQ_BLOCK_SIZE = 64;
+
+template<typename Collection>
+static constexpr bool pdq_use_branchless_partition = IsArithmetic<RemoveCVReference<decltype(declval<Collection&>()[0])>> || IsPointer<RemoveCVReference<decltype(declval<Collection&>()[0])>>;
+
+// Sorts the elements at a, b and c.
+template<typename Collection, typename LessThan>
+ALWAYS_INLINE void pdq_sort3(Collection& col, ssize_t a, ssize_t b, ssize_t c, LessThan& less_than)
+{
+    if (less_than(col[b], col[a]))
+        swap(col[a], col[b]);
+    if (less_than(col[c], col[b]))
+        swap(col[b], col[c]);
+    if (less_than(col[b], col[a]))
+        swap(col[a], col[b]);
+}
+
+// Insertion sort of [start, end] that gives up after moving a few elements. Returns whether it finished.
+template<typename Collection, typename LessThan>
+bool pdq_partial_insertion_sort(Collection& col, ssize_t start, ssize_t end, LessThan& less_than)
+{
+    ssize_t moves = 0;
+    for (ssize_t i = start + 1; i <= end; ++i) {
+        for (ssize_t j = i; j > start && less_than(col[j], col[j - 1]); --j) {
+            swap(col[j], col[j - 1]);
+            ++moves;
+        }
+        if (moves > PDQ_PARTIAL_INSERTION_SORT_LIMIT)
+            return i == end;
+    }
+    return true;
+}
+
+template<typename Collection, typename LessThan>
+void pdq_sift_down(Collection& col, ssize_t start, ssize_t size, ssize_t node, LessThan& less_than)
+{
+    for (;;) {
+        auto child = 2 * node + 1;
+        if (child >= size)
+            return;
+        if (child + 1 < size && less_than(col[start + child], col[start + child + 1]))
+            ++child;
+        if (!less_than(col[start + node], col[start + child]))
+            return;
+        swap(col[start + node], col[start + child]);
+        node = child;
+    }
+}
+
+template<typename Collection, typename LessThan>
+void pdq_heap_sort(Collection& col, ssize_t start, ssize_t end, LessThan& less_than)
+{
+    auto size = end - start + 1;
+    for (auto node = size / 2 - 1; node >= 0; --node)
+        pdq_sift_down(col, start, size, node, less_than);
+    for (auto last = size - 1; last > 0; --last) {
+        swap(col[start], col[start + last]);
+        pdq_sift_down(col, start, last, 0, less_than);
+    }
+}
+
+struct PdqPartitionResult {
+    ssize_t pivot_position;
+    bool was_already_partitioned;
+};
+
+// Partitions [start, end] around the pivot at `start`, putting elements equal to it on the right.
+// This relies on there being an element that is not less than the pivot somewhere after it, which
+// choosing the pivot as a median guarantees.
+template<typename Collection, typename LessThan>
+PdqPartitionResult pdq_partition_right(Collection& col, ssize_t start, ssize_t end, LessThan& less_than)
+{
+    ssize_t first = start;
+    ssize_t last = end + 1;
+
+    while (less_than(col[++first], col[start]))
+        ;
+    // If the first element after the pivot is out of place, there is no element less than the pivot
+    // to stop the scan from the right, so we have to check the bounds.
+    if (first - 1 == start) {
+        while (first < last && !less_than(col[--last], col[start]))
+            ;
+    } else {
+        while (!less_than(col[--last], col[start]))
+            ;
+    }
+
+    bool was_already_partitioned = first >= last;
+
+    if constexpr (pdq_use_branchless_partition<Collection>) {
+        // BlockQuicksort style partitioning: Find the out of place elements of a block on each side
+        // without branching on the comparisons, then swap them pairwise.
+        if (!was_already_partitioned) {
+            swap(col[first], col[last]);
+            ++first;
+
+            u8 left_offsets[PDQ_BLOCK_SIZE];
+            u8 right_offsets[PDQ_BLOCK_SIZE];
+            ssize_t left_base = first;
+            ssize_t right_base = last;
+            ssize_t left_count = 0;
+            ssize_t right_count = 0;
+            ssize_t left_start = 0;
+            ssize_t right_start = 0;
+
+            while (first < last) {
+                auto unknown_count = last - first;
+                auto left_split = left_count == 0 ? (right_count == 0 ? unknown_count / 2 : unknown_count) : 0;
+                auto right_split = right_count == 0 ? (unknown_count - left_split) : 0;
+
+                auto left_block_size = min(left_split, PDQ_BLOCK_SIZE);
+                for (ssize_t i = 0; i < left_block_size; ++i) {
+                    left_offsets[left_count] = i;
+                    left_count += !less_than(col[first], col[start]);
+                    ++first;
+                }
+                auto right_block_size = min(right_split, PDQ_BLOCK_SIZE);
+                for (ssize_t i = 0; i < right_block_size; ++i) {
+                    right_offsets[right_count] = i + 1;
+                    right_count += less_than(col[--last], col[start]);
+                }
+
+                auto swap_count = min(left_count, right_count);
+                for (ssize_t i = 0; i < swap_count; ++i)
+                    swap(col[left_base + left_offsets[left_start + i]], col[right_base - right_offsets[right_start + i]]);
+                left_count -= swap_count;
+                right_count -= swap_count;
+                left_start += swap_count;
+                right_start += swap_count;
+
+                if (left_count == 0) {
+                    left_start = 0;
+                    left_base = first;
+                }
+                if (right_count == 0) {
+                    right_start = 0;
+                    right_base = last;
+                }
+            }
+
+            // Move whatever is left over from the last blocks to the partition boundary.
+            if (left_count > 0) {
+                while (left_count--)
+                    swap(col[left_base + left_offsets[left_start + left_count]], col[--last]);
+                first = last;
+            }
+            if (right_count > 0) {
+                while (right_count--)
+                    swap(col[right_base - right_offsets[right_start + right_count]], col[first++]);
+                last = first;
+            }
+        }
+    } else {
+        while (first < last) {
+            swap(col[first], col[last]);
+            while (less_than(col[++first], col[start]))
+                ;
+            while (!less_than(col[--last], col[start]))
+                ;
+        }
+    }
+
+    auto pivot_position = first - 1;
+    swap(col[start], col[pivot_position]);
+    return { pivot_position, was_already_partitioned };
+}
+
+// Partitions [start, end] around the pivot at `start`, putting elements equal to it on the left.
+// This is used when the pivot is equal to the element just before this range, so everything that
+// ends up on the left is equal to the pivot and already in its final place.
+template<typename Collection, typename LessThan>
+ssize_t pdq_partition_left(Collection& col, ssize_t start, ssize_t end, LessThan& less_than)
+{
+    ssize_t first = start;
+    ssize_t last = end + 1;
+
+    while (less_than(col[start], col[--last]))
+        ;
+    if (last == end) {
+        while (first < last && !less_than(col[start], col[++first]))
+            ;
+    } else {
+        while (!less_than(col[start], col[++first]))
+            ;
+    }
+
+    while (first < last) {
+        swap(col[first], col[last]);
+        while (less_than(col[start], col[--last]))
+            ;
+        while (!less_than(col[start], col[++first]))
+            ;
+    }
+
+    swap(col[start], col[last]);
+    return last;
+}
+
+template<typename Collection, typename LessThan>
+void pdq_sort_loop(Collection& col, ssize_t start, ssize_t end, LessThan& less_than, int bad_partitions_allowed, bool leftmost)
+{
+    for (;;) {
+        auto size = end - start + 1;
+        if (size <= PDQ_INSERTION_SORT_CUTOFF) {
+            AK::insertion_sort(col, start, end, less_than);
+            return;
+        }
+
+        // Move the pivot to `start`.
+        auto half = size / 2;
+        if (size > PDQ_NINTHER_CUTOFF) {
+            pdq_sort3(col, start, start + half, end, less_than);
+            pdq_sort3(col, start + 1, start + half - 1, end - 1, less_than);
+            pdq_sort3(col, start + 2, start + half + 1, end - 2, less_than);
+            pdq_sort3(col, start + half - 1, start + half, start + half + 1, less_than);
+            swap(col[start], col[start + half]);
+        } else {
+            pdq_sort3(col, start + half, start, end, less_than);
+        }
+
+        // If the element before this range (which isn't larger than anything in it) is equal to the
+        // pivot, put everything equal to the pivot on the left and skip over it.
+        if (!leftmost && !less_than(col[start - 1], col[start])) {
+            start = pdq_partition_left(col, start, end, less_than) + 1;
+            continue;
+        }
+
+        auto [pivot_position, was_already_partitioned] = pdq_partition_right(col, start, end, less_than);
+
+        auto left_size = pivot_position - start;
+        auto right_size = end - pivot_position;
+
+        if (left_size < size / 8 || right_size < size / 8) {
+            // After too many unbalanced partitions, give up and make sure we stay at O(n log n).
+            if (--bad_partitions_allowed == 0) {
+                pdq_heap_sort(col, start, end, less_than);
+                return;
+            }
+
+            // Otherwise, shuffle some elements around to break up whatever pattern caused this.
+            if (left_size >= PDQ_INSERTION_SORT_CUTOFF) {
+                swap(col[start], col[start + left_size / 4]);
+                swap(col[pivot_position - 1], col[pivot_position - left_size / 4]);
+                if (left_size > PDQ_NINTHER_CUTOFF) {
+                    swap(col[start + 1], col[start + left_size / 4 + 1]);
+                    swap(col[start + 2], col[start + left_size / 4 + 2]);
+                    swap(col[pivot_position - 2], col[pivot_position - left_size / 4 - 1]);
+                    swap(col[pivot_position - 3], col[pivot_position - left_size / 4 - 2]);
+                }
+            }
+            if (right_size >= PDQ_INSERTION_SORT_CUTOFF) {
+                swap(col[pivot_position + 1], col[pivot_position + right_size / 4 + 1]);
+                swap(col[end], col[end - right_size / 4 + 1]);
+                if (right_size > PDQ_NINTHER_CUTOFF) {
+                    swap(col[pivot_position + 2], col[pivot_position + right_size / 4 + 2]);
+                    swap(col[pivot_position + 3], col[pivot_position + right_size / 4 + 3]);
+                    swap(col[end - 1], col[end - right_size / 4]);
+                    swap(col[end - 2], col[end - right_size / 4 - 1]);
+                }
+            }
+        } else if (was_already_partitioned
+            && pdq_partial_insertion_sort(col, start, pivot_position - 1, less_than)
+            && pdq_partial_insertion_sort(col, pivot_position + 1, end, less_than)) {
+            // The range was already partitioned and both sides turned out to be nearly sorted.
+            return;
+        }
+
+        // Recurse into the smaller side to keep the stack shallow, then continue with the larger one.
+        if (left_size < right_size) {
+            pdq_sort_loop(col, start, pivot_position - 1, less_than, bad_partitions_allowed, leftmost);
+            start = pivot_position + 1;
+            leftmost = false;
+        } else {
+            pdq_sort_loop(col, pivot_position + 1, end, less_than, bad_partitions_allowed, false);
+            end = pivot_position - 1;
+        }
+    }
+}
+
+// Lets the index based sorts work on a pair of random access iterators.
+template<typename Iterator>
+class IteratorAsCollection {
+public:
+    explicit IteratorAsCollection(Iterator start)
+        : m_start(start)
+    {
+    }
+
+    decltype(auto) operator[](ssize_t index) const { return *(m_start + index); }
+
+private:
+    Iterator m_start;
+};
+
+}
+
+// Sorts [start, end], with `end` inclusive!
+template<typename Collection, typename LessThan>
+void pattern_defeating_quick_sort(Collection& col, ssize_t start, ssize_t end, LessThan less_than)
+{
+    if (end <= start)
+        return;
+    auto size = static_cast<size_t>(end - start + 1);
+    int bad_partitions_allowed = sizeof(size_t) * 8 - count_leading_zeroes(size);
+    Detail::pdq_sort_loop(col, start, end, less_than, bad_partitions_allowed, true);
+}
+
 template<typename Iterator>
 void quick_sort(Iterator start, Iterator end)
 {
-    single_pivot_quick_sort(start, end, [](auto& a, auto& b) { return a < b; });
+    quick_sort(start, end, [](auto& a, auto& b) { return a < b; });
 }
 
 template<typename Iterator, typename LessThan>
 void quick_sort(Iterator start, Iterator end, LessThan less_than)
 {
-    single_pivot_quick_sort(start, end, move(less_than));
+    Detail::IteratorAsCollection collection { start };
+    pattern_defeating_quick_sort(collection, 0, (end - start) - 1, move(less_than));
 }
 
 template<typename Collection, typename LessThan>
 void quick_sort(Collection& collection, LessThan less_than)
 {
-    dual_pivot_quick_sort(collection, 0, collection.size() - 1, move(less_than));
+    pattern_defeating_quick_sort(collection, 0, static_cast<ssize_t>(collection.size()) - 1, move(less_than));
 }
 
 template<typename Collection>
 void quick_sort(Collection& collection)
 {
-    dual_pivot_quick_sort(collection, 0, collection.size() - 1,
+    pattern_defeating_quick_sort(collection, 0, static_cast<ssize_t>(collection.size()) - 1,
         [](auto& a, auto& b) { return a < b; });
 }
 
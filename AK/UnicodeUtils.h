@@ -9,9 +9,59 @@
 #include <AK/Concepts.h>
 #include <AK/Error.h>
 #include <AK/Forward.h>
+#include <AK/SIMD.h>
+#include <AK/Span.h>
 
 namespace AK::UnicodeUtils {
 
+// Most text is entirely or almost entirely ASCII, so validating and transcoding it goes a lot faster if runs of
+// ASCII are skipped over in bulk. These return the number of leading elements that are below 0x80.
+inline size_t count_leading_ascii_bytes(ReadonlyBytes bytes)
+{
+    size_t offset = 0;
+#if defined(__SSE2__)
+    for (; offset + 32 <= bytes.size(); offset += 32) {
+        SIMD::u8x16 first, second;
+        __builtin_memcpy(&first, bytes.data() + offset, sizeof(first));
+        __builtin_memcpy(&second, bytes.data() + offset + 16, sizeof(second));
+        if (__builtin_ia32_pmovmskb128((SIMD::c8x16)(first | second)) != 0)
+            break;
+    }
+#endif
+    for (; offset + sizeof(u64) <= bytes.size(); offset += sizeof(u64)) {
+        u64 word;
+        __builtin_memcpy(&word, bytes.data() + offset, sizeof(word));
+        if ((word & 0x8080808080808080ull) != 0)
+            break;
+    }
+    while (offset < bytes.size() && bytes[offset] < 0x80)
+        ++offset;
+    return offset;
+}
+
+inline size_t count_leading_ascii_code_units(ReadonlySpan<u16> code_units)
+{
+    size_t offset = 0;
+#if defined(__SSE2__)
+    for (; offset + 16 <= code_units.size(); offset += 16) {
+        SIMD::u16x8 first, second;
+        __builtin_memcpy(&first, code_units.data() + offset, sizeof(first));
+        __builtin_memcpy(&second, code_units.data() + offset + 8, sizeof(second));
+        if (__builtin_ia32_pmovmskb128((SIMD::c8x16)(((first | second) & 0xff80) != 0)) != 0)
+            break;
+    }
+#endif
+    for (; offset + 4 <= code_units.size(); offset += 4) {
+        u64 word;
+        __builtin_memcpy(&word, code_units.data() + offset, sizeof(word));
+        if ((word & 0xff80ff80ff80ff80ull) != 0)
+            break;
+    }
+    while (offset < code_units.size() && code_units[offset] < 0x80)
+        ++offset;
+    return offset;
+}
+
 template<typename Callback>
 [[nodiscard]] constexpr int code_point_to_utf8(u32 code_point, Callback callback)
 {
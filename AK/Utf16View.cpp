@@ -4,10 +4,12 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
 #include <AK/CharacterTypes.h>
 #include <AK/Concepts.h>
 #include <AK/StringBuilder.h>
 #include <AK/StringView.h>
+#include <AK/UnicodeUtils.h>
 #include <AK/Utf16View.h>
 #include <AK/Utf32View.h>
 #include <AK/Utf8View.h>
@@ -21,6 +23,19 @@ static constexpr u16 low_surrogate_max = 0xdfff;
 static constexpr u32 replacement_code_point = 0xfffd;
 static constexpr u32 first_supplementary_plane_code_point = 0x10000;
 
+static ErrorOr<void> append_ascii_code_units(StringBuilder& builder, ReadonlySpan<u16> code_units)
+{
+    Array<char, 64> chunk;
+    while (!code_units.is_empty()) {
+        auto chunk_length = min(code_units.size(), chunk.size());
+        for (size_t i = 0; i < chunk_length; ++i)
+            chunk[i] = static_cast<char>(code_units[i]);
+        TRY(builder.try_append(StringView { chunk.data(), chunk_length }));
+        code_units = code_units.slice(chunk_length);
+    }
+    return {};
+}
+
 template<OneOf<Utf8View, Utf32View> UtfViewType>
 static ErrorOr<Utf16Data> to_utf16_impl(UtfViewType const& view)
 {
@@ -35,12 +50,31 @@ static ErrorOr<Utf16Data> to_utf16_impl(UtfViewType const& view)
 
 ErrorOr<Utf16Data> utf8_to_utf16(StringView utf8_view)
 {
-    return to_utf16_impl(Utf8View { utf8_view });
+    return utf8_to_utf16(Utf8View { utf8_view });
 }
 
 ErrorOr<Utf16Data> utf8_to_utf16(Utf8View const& utf8_view)
 {
-    return to_utf16_impl(utf8_view);
+    Utf16Data utf16_data;
+    TRY(utf16_data.try_ensure_capacity(utf8_view.length()));
+
+    ReadonlyBytes bytes { utf8_view.bytes(), utf8_view.byte_length() };
+    for (size_t offset = 0; offset < bytes.size();) {
+        auto ascii_length = UnicodeUtils::count_leading_ascii_bytes(bytes.slice(offset));
+        // Surrogate pairs may already have taken up some of the capacity we reserved up front.
+        TRY(utf16_data.try_ensure_capacity(utf16_data.size() + ascii_length));
+        for (auto ascii : bytes.slice(offset, ascii_length))
+            utf16_data.unchecked_append(ascii);
+        offset += ascii_length;
+        if (offset == bytes.size())
+            break;
+
+        auto iterator = utf8_view.iterator_at_byte_offset_without_validation(offset);
+        TRY(code_point_to_utf16(utf16_data, *iterator));
+        offset += iterator.underlying_code_point_length_in_bytes();
+    }
+
+    return utf16_data;
 }
 
 ErrorOr<Utf16Data> utf32_to_utf16(Utf32View const& utf32_view)
@@ -106,8 +140,17 @@ ErrorOr<String> Utf16View::to_utf8(AllowInvalidCodeUnits allow_invalid_code_unit
             TRY(builder.try_append_code_point(static_cast<u32>(*ptr)));
         }
     } else {
-        for (auto code_point : *this)
-            TRY(builder.try_append_code_point(code_point));
+        for (auto const* ptr = begin_ptr(); ptr < end_ptr();) {
+            auto ascii_length = UnicodeUtils::count_leading_ascii_code_units({ ptr, static_cast<size_t>(end_ptr() - ptr) });
+            TRY(append_ascii_code_units(builder, { ptr, ascii_length }));
+            ptr += ascii_length;
+            if (ptr == end_ptr())
+                break;
+
+            auto iterator = Utf16View { { ptr, static_cast<size_t>(end_ptr() - ptr) } }.begin();
+            TRY(builder.try_append_code_point(*iterator));
+            ptr += iterator.length_in_code_units();
+        }
     }
 
     return builder.to_string();
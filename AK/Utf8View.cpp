@@ -73,8 +73,14 @@ Utf8View Utf8View::unicode_substring_view(size_t code_point_offset, size_t code_
 size_t Utf8View::calculate_length() const
 {
     size_t length = 0;
-    for ([[maybe_unused]] auto code_point : *this) {
-        ++length;
+    for (auto iterator = begin(); !iterator.done(); ++length) {
+        if (auto ascii_length = UnicodeUtils::count_leading_ascii_bytes({ iterator.m_ptr, iterator.m_length }); ascii_length > 0) {
+            iterator.m_ptr += ascii_length;
+            iterator.m_length -= ascii_length;
+            length += ascii_length - 1;
+            continue;
+        }
+        ++iterator;
     }
     return length;
 }
@@ -10,6 +10,7 @@
 #include <AK/Format.h>
 #include <AK/StringView.h>
 #include <AK/Types.h>
+#include <AK/UnicodeUtils.h>
 
 #ifndef KERNEL
 #    include <AK/DeprecatedString.h>
@@ -129,16 +130,23 @@ public:
     {
         valid_bytes = 0;
 
-        for (auto it = m_string.begin(); it != m_string.end(); ++it) {
-            auto [byte_length, code_point, is_valid] = decode_leading_byte(static_cast<u8>(*it));
-            if (!is_valid)
+        for (size_t offset = 0; offset < m_string.length();) {
+            auto leading_byte = static_cast<u8>(m_string[offset]);
+            if (leading_byte < 0x80) {
+                size_t ascii_length = 1;
+                if (!is_constant_evaluated())
+                    ascii_length = UnicodeUtils::count_leading_ascii_bytes(m_string.bytes().slice(offset));
+                offset += ascii_length;
+                valid_bytes += ascii_length;
+                continue;
+            }
+
+            auto [byte_length, code_point, is_valid] = decode_leading_byte(leading_byte);
+            if (!is_valid || byte_length > m_string.length() - offset)
                 return false;
 
             for (size_t i = 1; i < byte_length; ++i) {
-                if (++it == m_string.end())
-                    return false;
-
-                auto [code_point_bits, is_valid] = decode_continuation_byte(static_cast<u8>(*it));
+                auto [code_point_bits, is_valid] = decode_continuation_byte(static_cast<u8>(m_string[offset + i]));
                 if (!is_valid)
                     return false;
 
@@ -149,6 +157,7 @@ public:
             if (!is_valid_code_point(code_point, byte_length))
                 return false;
 
+            offset += byte_length;
             valid_bytes += byte_length;
         }
 
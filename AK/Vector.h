@@ -8,6 +8,7 @@
 #pragma once
 
 #include <AK/Assertions.h>
+#include <AK/ContainerAllocationProfile.h>
 #include <AK/Error.h>
 #include <AK/Find.h>
 #include <AK/Forward.h>
@@ -650,6 +651,10 @@ public:
         if (new_buffer == nullptr)
             return Error::from_errno(ENOMEM);
 
+#if AK_CONTAINER_ALLOCATION_PROFILING
+        Detail::record_container_allocation(__PRETTY_FUNCTION__, __builtin_return_address(0), m_size, new_capacity * sizeof(StorageType));
+#endif
+
         if constexpr (Traits<StorageType>::is_trivial()) {
             TypedTransfer<StorageType>::copy(new_buffer, data(), m_size);
         } else {
@@ -857,8 +862,26 @@ private:
 template<class... Args>
 Vector(Args... args) -> Vector<CommonType<Args...>>;
 
+namespace Detail {
+
+// Enough inline elements to fill a cache line, but always at least one and never a huge number of tiny ones.
+template<typename T>
+constexpr size_t small_vector_inline_capacity()
+{
+    constexpr size_t element_size = sizeof(Conditional<IsLvalueReference<T>, RemoveReference<T>*, T>);
+    return clamp(64 / element_size, 1, 16);
+}
+
+}
+
+// A Vector that keeps its first few elements inline, for the many places that usually hold only a
+// handful of elements and would otherwise pay for a heap allocation every time.
+template<typename T, size_t inline_capacity = Detail::small_vector_inline_capacity<T>()>
+using SmallVector = Vector<T, inline_capacity>;
+
 }
 
 #if USING_AK_GLOBALLY
+using AK::SmallVector;
 using AK::Vector;
 #endif
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/EnumBits.h>
+#include <AK/Types.h>
+
+// An I/O ring is a region of memory shared between a process and the kernel.
+// The process queues submissions and advances the submission tail, then asks
+// the kernel to consume them with io_ring_enter(). The kernel posts one
+// completion per consumed submission and advances the completion tail, which
+// the process can reap without making any syscall.
+//
+// The mapping starts with an IORingHeader, followed by the submission entries
+// and then the completion entries, at the offsets stored in the header.
+
+enum class IORingFlags : u32 {
+    None = 0,
+    CloseOnExec = 1 << 0,
+};
+
+AK_ENUM_BITWISE_OPERATORS(IORingFlags);
+
+enum class IORingOpcode : u32 {
+    Nop,
+    Read,
+    Write,
+    Accept,
+    Fsync,
+};
+
+struct IORingSubmission {
+    IORingOpcode opcode;
+    i32 fd;
+    u64 user_data;
+    // Read/Write: the userspace buffer and its length.
+    // Accept: an optional sockaddr buffer and its length.
+    u64 buffer;
+    u64 length;
+    // Read/Write: the file offset to use, or -1 for the current file offset.
+    i64 offset;
+    // Accept: SOCK_NONBLOCK and/or SOCK_CLOEXEC.
+    u32 flags;
+    u32 reserved;
+};
+
+struct IORingCompletion {
+    u64 user_data;
+    // What the equivalent syscall would have returned, or a negated errno.
+    i64 result;
+};
+
+struct IORingQueue {
+    u32 head;
+    u32 tail;
+    u32 mask;
+    u32 entries_offset;
+};
+
+struct IORingHeader {
+    // Consumed by the kernel, produced by userspace.
+    IORingQueue submissions;
+    // Consumed by userspace, produced by the kernel.
+    IORingQueue completions;
+};
+
+static constexpr u32 io_ring_max_entries = 4096;
+
+// There are twice as many completion entries as submission entries, so that a
+// full submission queue can be flushed while the previous batch is being reaped.
+constexpr u32 io_ring_completion_entry_count(u32 submission_entry_count)
+{
+    return submission_entry_count * 2;
+}
+
+constexpr size_t io_ring_submissions_offset()
+{
+    return sizeof(IORingHeader);
+}
+
+constexpr size_t io_ring_completions_offset(u32 submission_entry_count)
+{
+    return io_ring_submissions_offset() + submission_entry_count * sizeof(IORingSubmission);
+}
+
+constexpr size_t io_ring_size(u32 submission_entry_count)
+{
+    return io_ring_completions_offset(submission_entry_count) + io_ring_completion_entry_count(submission_entry_count) * sizeof(IORingCompletion);
+}
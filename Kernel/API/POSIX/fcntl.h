@@ -22,6 +22,8 @@ extern "C" {
 #define F_SETLK 7
 #define F_SETLKW 8
 #define F_DUPFD_CLOEXEC 9
+#define F_GETPIPE_SZ 10
+#define F_SETPIPE_SZ 11
 
 #define FD_CLOEXEC 1
 
@@ -14,6 +14,7 @@ extern "C" {
 
 #define PURGE_ALL_VOLATILE 0x1
 #define PURGE_ALL_CLEAN_INODE 0x2
+#define PURGE_ALL_FILESYSTEM_CACHES 0x4
 
 enum {
     PERF_EVENT_SAMPLE = 1,
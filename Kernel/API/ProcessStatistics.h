@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+
+namespace Kernel {
+
+// The binary layout of /sys/kernel/processes_binary, which carries the same information as
+// /sys/kernel/processes but doesn't have to be formatted and parsed as JSON.
+//
+// The file starts with a ProcessStatisticsHeader, followed by process_count process records.
+// Each process record is followed by its strings (name, executable, tty, pledge and veil, in
+// that order and without terminators) and then by thread_count thread records. Each thread
+// record is followed by its name and state strings.
+//
+// New fields are only ever appended to the records. Readers must use the record sizes from the
+// header to step over records, so that they keep working with newer kernels.
+
+static constexpr u32 process_statistics_magic = 0x53545350; // "PSTS"
+static constexpr u32 process_statistics_version = 1;
+
+struct [[gnu::packed]] ProcessStatisticsHeader {
+    u32 magic;
+    u32 version;
+    u32 header_size;
+    u32 process_record_size;
+    u32 thread_record_size;
+    u32 process_count;
+    u64 total_time;
+    u64 total_time_kernel;
+};
+
+struct [[gnu::packed]] ProcessStatisticsRecord {
+    i32 pid;
+    i32 pgid;
+    i32 pgp;
+    i32 sid;
+    u32 uid;
+    u32 gid;
+    i32 ppid;
+    u32 nfds;
+    u64 amount_virtual;
+    u64 amount_resident;
+    u64 amount_dirty_private;
+    u64 amount_clean_inode;
+    u64 amount_shared;
+    u64 amount_purgeable_volatile;
+    u64 amount_purgeable_nonvolatile;
+    u8 kernel;
+    u8 dumpable;
+    u16 name_length;
+    u16 executable_length;
+    u16 tty_length;
+    u16 pledge_length;
+    u16 veil_length;
+    u32 thread_count;
+};
+
+struct [[gnu::packed]] ThreadStatisticsRecord {
+    i32 tid;
+    u32 times_scheduled;
+    u64 time_user;
+    u64 time_kernel;
+    u32 cpu;
+    u32 priority;
+    u32 syscall_count;
+    u32 inode_faults;
+    u32 zero_faults;
+    u32 cow_faults;
+    u32 file_read_bytes;
+    u32 file_write_bytes;
+    u32 unix_socket_read_bytes;
+    u32 unix_socket_write_bytes;
+    u32 ipv4_socket_read_bytes;
+    u32 ipv4_socket_write_bytes;
+    u16 name_length;
+    u16 state_length;
+};
+
+}
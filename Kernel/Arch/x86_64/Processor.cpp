@@ -619,6 +619,7 @@ UNMAP_AFTER_INIT void Processor::early_initialize(u32 cpu)
     m_info = nullptr;
 
     m_halt_requested = false;
+    m_active_cr3 = 0;
     if (cpu == 0) {
         s_smp_enabled = false;
         g_total_processors.store(1u, AK::MemoryOrder::memory_order_release);
@@ -1251,6 +1252,39 @@ void Processor::smp_broadcast_message(ProcessorMessage& msg)
         APIC::the().broadcast_ipi();
 }
 
+void Processor::smp_multicast_message(u64 cpu_mask, ProcessorMessage& msg)
+{
+    auto& current_processor = Processor::current();
+    cpu_mask &= ~(1ull << current_processor.id());
+
+    dbgln_if(SMP_DEBUG, "SMP[{}]: Multicast message {} to cpu mask: {:#x}", current_processor.id(), VirtualAddress(&msg), cpu_mask);
+
+    // NOTE: If there are no targets at all, smp_broadcast_wait_sync() will return right away.
+    msg.refs.store(popcount(cpu_mask), AK::MemoryOrder::memory_order_release);
+    for_each(
+        [&](Processor& proc) {
+            if (!(cpu_mask & (1ull << proc.id())))
+                return;
+            if (proc.smp_enqueue_message(msg))
+                APIC::the().send_ipi(proc.id());
+        });
+}
+
+u64 Processor::processors_that_may_use_page_directory(Memory::PageDirectory const& page_directory)
+{
+    // Make sure our page table changes are visible before we look at what the other processors have loaded.
+    AK::atomic_thread_fence(AK::MemoryOrder::memory_order_seq_cst);
+
+    u64 cpu_mask = 0;
+    for_each(
+        [&](Processor& proc) {
+            auto active_cr3 = proc.m_active_cr3.load(AK::MemoryOrder::memory_order_relaxed);
+            if (active_cr3 == 0 || active_cr3 == page_directory.cr3())
+                cpu_mask |= 1ull << proc.id();
+        });
+    return cpu_mask;
+}
+
 void Processor::smp_broadcast_wait_sync(ProcessorMessage& msg)
 {
     auto& cur_proc = Processor::current();
@@ -1317,7 +1351,13 @@ void Processor::smp_broadcast_flush_tlb(Memory::PageDirectory const* page_direct
     msg.flush_tlb.page_directory = page_directory;
     msg.flush_tlb.ptr = vaddr.as_ptr();
     msg.flush_tlb.page_count = page_count;
-    smp_broadcast_message(msg);
+    if (Memory::is_user_address(vaddr)) {
+        // Only processors that may currently have this address space loaded need to flush anything.
+        VERIFY(page_directory);
+        smp_multicast_message(processors_that_may_use_page_directory(*page_directory), msg);
+    } else {
+        smp_broadcast_message(msg);
+    }
     // While the other processors handle this request, we'll flush ours
     flush_tlb_local(vaddr, page_count);
     // Now wait until everybody is done as well
@@ -1546,7 +1586,7 @@ extern "C" void enter_thread_context(Thread* from_thread, Thread* to_thread)
     Processor::set_thread_specific_data(to_thread->thread_specific_data());
 
     if (from_regs.cr3 != to_regs.cr3)
-        write_cr3(to_regs.cr3);
+        Processor::load_page_directory(to_regs.cr3);
 
     to_thread->set_cpu(processor.id());
 
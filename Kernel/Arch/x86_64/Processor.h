@@ -101,6 +101,9 @@ class Processor {
     bool m_in_scheduler;
     Atomic<bool> m_halt_requested;
 
+    // The page directory this processor has loaded, or 0 if we don't know.
+    Atomic<FlatPtr> m_active_cr3;
+
     DeferredCallEntry* m_pending_deferred_calls; // in reverse order
     DeferredCallEntry* m_free_deferred_call_pool_entry;
     DeferredCallEntry m_deferred_call_pool[5];
@@ -118,6 +121,8 @@ class Processor {
     bool smp_enqueue_message(ProcessorMessage&);
     static void smp_unicast_message(u32 cpu, ProcessorMessage& msg, bool async);
     static void smp_broadcast_message(ProcessorMessage& msg);
+    static void smp_multicast_message(u64 cpu_mask, ProcessorMessage& msg);
+    static u64 processors_that_may_use_page_directory(Memory::PageDirectory const&);
     static void smp_broadcast_wait_sync(ProcessorMessage& msg);
     static void smp_broadcast_halt();
 
@@ -187,6 +192,16 @@ public:
         write_cr3(read_cr3());
     }
 
+    // NOTE: Since loading cr3 flushes all non-global TLB entries, a processor that doesn't have a page directory
+    //       loaded can't have any of its user mappings cached. Keeping track of that lets TLB shootdowns skip it.
+    //       We publish the new value before writing cr3 (which is serializing), so anyone changing the page tables
+    //       after we started using them will also send us the shootdown.
+    ALWAYS_INLINE static void load_page_directory(FlatPtr cr3)
+    {
+        current().m_active_cr3.store(cr3, AK::MemoryOrder::memory_order_seq_cst);
+        write_cr3(cr3);
+    }
+
     static void flush_tlb_local(VirtualAddress vaddr, size_t page_count);
     static void flush_tlb(Memory::PageDirectory const*, VirtualAddress, size_t);
 
@@ -24,6 +24,9 @@
 
 #define INCLUDE_USERSPACE_HEAP_MEMORY_IN_COREDUMPS 0
 
+// How much of a region we copy out of the process at a time before handing it to the compressor.
+static constexpr size_t region_copy_chunk_size = 16 * PAGE_SIZE;
+
 static Singleton<SpinlockProtected<OwnPtr<KString>, LockRank::None>> s_coredump_directory_path;
 
 namespace Kernel {
@@ -71,12 +74,14 @@ ErrorOr<NonnullOwnPtr<Coredump>> Coredump::try_create(NonnullLockRefPtr<Process>
     }));
 
     auto description = TRY(try_create_target_file(process, output_path));
-    return adopt_nonnull_own_or_enomem(new (nothrow) Coredump(move(process), move(description), move(regions)));
+    auto writer = TRY(GzipWriter::try_create(*description));
+    return adopt_nonnull_own_or_enomem(new (nothrow) Coredump(move(process), move(description), move(writer), move(regions)));
 }
 
-Coredump::Coredump(NonnullLockRefPtr<Process> process, NonnullLockRefPtr<OpenFileDescription> description, Vector<FlatRegionData> regions)
+Coredump::Coredump(NonnullLockRefPtr<Process> process, NonnullLockRefPtr<OpenFileDescription> description, NonnullOwnPtr<GzipWriter> writer, Vector<FlatRegionData> regions)
     : m_process(move(process))
     , m_description(move(description))
+    , m_writer(move(writer))
     , m_regions(move(regions))
 {
     m_num_program_headers = 0;
@@ -155,7 +160,7 @@ ErrorOr<void> Coredump::write_elf_header()
     elf_file_header.e_shnum = 0;
     elf_file_header.e_shstrndx = SHN_UNDEF;
 
-    TRY(m_description->write(UserOrKernelBuffer::for_kernel_buffer(reinterpret_cast<uint8_t*>(&elf_file_header)), sizeof(ElfW(Ehdr))));
+    TRY(write_bytes({ &elf_file_header, sizeof(elf_file_header) }));
 
     return {};
 }
@@ -179,7 +184,8 @@ ErrorOr<void> Coredump::write_program_headers(size_t notes_size)
         phdr.p_vaddr = region.vaddr().get();
         phdr.p_paddr = 0;
 
-        phdr.p_filesz = region.page_count() * PAGE_SIZE;
+        // Clean file-backed memory can be reconstructed from the file it was mapped from, so we only record its extent.
+        phdr.p_filesz = region.is_clean_file_backed() ? 0 : region.page_count() * PAGE_SIZE;
         phdr.p_memsz = region.page_count() * PAGE_SIZE;
         phdr.p_align = 0;
 
@@ -191,7 +197,7 @@ ErrorOr<void> Coredump::write_program_headers(size_t notes_size)
 
         offset += phdr.p_filesz;
 
-        [[maybe_unused]] auto rc = m_description->write(UserOrKernelBuffer::for_kernel_buffer(reinterpret_cast<uint8_t*>(&phdr)), sizeof(ElfW(Phdr)));
+        TRY(write_bytes({ &phdr, sizeof(phdr) }));
     }
 
     ElfW(Phdr) notes_pheader {};
@@ -204,14 +210,14 @@ ErrorOr<void> Coredump::write_program_headers(size_t notes_size)
     notes_pheader.p_align = 0;
     notes_pheader.p_flags = 0;
 
-    TRY(m_description->write(UserOrKernelBuffer::for_kernel_buffer(reinterpret_cast<uint8_t*>(&notes_pheader)), sizeof(ElfW(Phdr))));
+    TRY(write_bytes({ &notes_pheader, sizeof(notes_pheader) }));
 
     return {};
 }
 
 ErrorOr<void> Coredump::write_regions()
 {
-    u8 zero_buffer[PAGE_SIZE] = {};
+    auto buffer = TRY(KBuffer::try_create_with_size("Coredump Region Copy Buffer"sv, region_copy_chunk_size));
 
     for (auto& region : m_regions) {
         VERIFY(!region.is_kernel());
@@ -224,43 +230,57 @@ ErrorOr<void> Coredump::write_regions()
         if (region.access() == Memory::Region::Access::None)
             continue;
 
-        auto buffer = TRY(KBuffer::try_create_with_size("Coredump Region Copy Buffer"sv, region.page_count() * PAGE_SIZE));
-
-        TRY(m_process->address_space().with([&](auto& space) -> ErrorOr<void> {
-            auto* real_region = space->region_tree().regions().find(region.vaddr().get());
-
-            if (!real_region) {
-                dmesgln("Coredump::write_regions: Failed to find matching region in the process");
-                return Error::from_errno(EFAULT);
-            }
-
-            if (!region.is_consistent_with_region(*real_region)) {
-                dmesgln("Coredump::write_regions: Found region does not match stored metadata");
-                return Error::from_errno(EINVAL);
-            }
-
-            // If we crashed in the middle of mapping in Regions, they do not have a page directory yet, and will crash on a remap() call
-            if (!real_region->is_mapped())
-                return {};
-
-            real_region->set_readable(true);
-            real_region->remap();
+        if (region.is_clean_file_backed())
+            continue;
 
-            for (size_t i = 0; i < region.page_count(); i++) {
-                auto page = real_region->physical_page(i);
-                auto src_buffer = [&]() -> ErrorOr<UserOrKernelBuffer> {
-                    if (page)
-                        return UserOrKernelBuffer::for_user_buffer(reinterpret_cast<uint8_t*>((region.vaddr().as_ptr() + (i * PAGE_SIZE))), PAGE_SIZE);
+        // Copy the region out one chunk at a time, so we never need a buffer as large as the region itself.
+        // The address space lock can't be held while writing to the file, so we have to look the region up again for every chunk.
+        for (size_t first_page = 0; first_page < region.page_count(); first_page += region_copy_chunk_size / PAGE_SIZE) {
+            size_t page_count = min(region.page_count() - first_page, region_copy_chunk_size / PAGE_SIZE);
+            auto chunk = buffer->bytes().trim(page_count * PAGE_SIZE);
+
+            TRY(m_process->address_space().with([&](auto& space) -> ErrorOr<void> {
+                auto* real_region = space->region_tree().regions().find(region.vaddr().get());
+
+                if (!real_region) {
+                    dmesgln("Coredump::write_regions: Failed to find matching region in the process");
+                    return Error::from_errno(EFAULT);
+                }
+
+                if (!region.is_consistent_with_region(*real_region)) {
+                    dmesgln("Coredump::write_regions: Found region does not match stored metadata");
+                    return Error::from_errno(EINVAL);
+                }
+
+                // If we crashed in the middle of mapping in Regions, they do not have a page directory yet, and will crash on a remap() call
+                if (!real_region->is_mapped()) {
+                    chunk.fill(0);
+                    return {};
+                }
+
+                if (first_page == 0) {
+                    real_region->set_readable(true);
+                    real_region->remap();
+                    region.update_access(*real_region);
+                }
+
+                for (size_t i = 0; i < page_count; i++) {
+                    auto page_index = first_page + i;
+                    auto destination = chunk.slice(i * PAGE_SIZE, PAGE_SIZE);
                     // If the current page is not backed by a physical page, we zero it in the coredump file.
-                    return UserOrKernelBuffer::for_kernel_buffer(zero_buffer);
-                }();
-                TRY(src_buffer.value().read(buffer->bytes().slice(i * PAGE_SIZE, PAGE_SIZE)));
-            }
+                    if (!real_region->physical_page(page_index)) {
+                        destination.fill(0);
+                        continue;
+                    }
+                    auto source = TRY(UserOrKernelBuffer::for_user_buffer(region.vaddr().offset(page_index * PAGE_SIZE).as_ptr(), PAGE_SIZE));
+                    TRY(source.read(destination));
+                }
 
-            return {};
-        }));
+                return {};
+            }));
 
-        TRY(m_description->write(UserOrKernelBuffer::for_kernel_buffer(buffer->data()), buffer->size()));
+            TRY(write_bytes(chunk));
+        }
     }
 
     return {};
@@ -268,8 +288,12 @@ ErrorOr<void> Coredump::write_regions()
 
 ErrorOr<void> Coredump::write_notes_segment(ReadonlyBytes notes_segment)
 {
-    TRY(m_description->write(UserOrKernelBuffer::for_kernel_buffer(const_cast<u8*>(notes_segment.data())), notes_segment.size()));
-    return {};
+    return write_bytes(notes_segment);
+}
+
+ErrorOr<void> Coredump::write_bytes(ReadonlyBytes bytes)
+{
+    return m_writer->write(bytes);
 }
 
 ErrorOr<void> Coredump::create_notes_process_data(auto& builder) const
@@ -394,6 +418,7 @@ ErrorOr<void> Coredump::write()
     TRY(write_program_headers(builder.bytes().size()));
     TRY(write_regions());
     TRY(write_notes_segment(builder.bytes()));
+    TRY(m_writer->finish());
 
     return m_description->chmod(Process::current().credentials(), 0600); // Make coredump file read/writable
 }
@@ -10,6 +10,7 @@
 #include <AK/OwnPtr.h>
 #include <AK/Vector.h>
 #include <Kernel/Forward.h>
+#include <Kernel/GzipWriter.h>
 #include <Kernel/Library/NonnullLockRefPtr.h>
 #include <Kernel/Locking/SpinlockProtected.h>
 #include <Kernel/Memory/Region.h>
@@ -33,6 +34,7 @@ private:
             , m_is_kernel(region.is_kernel())
             , m_is_readable(region.is_readable())
             , m_is_writable(region.is_writable())
+            , m_is_clean_file_backed(region.vmobject().is_inode() && !region.has_been_writable())
             , m_name(move(name))
             , m_page_count(region.page_count())
             , m_size(region.size())
@@ -46,12 +48,14 @@ private:
         auto is_kernel() const { return m_is_kernel; }
         auto is_readable() const { return m_is_readable; }
         auto is_writable() const { return m_is_writable; }
+        auto is_clean_file_backed() const { return m_is_clean_file_backed; }
         auto page_count() const { return m_page_count; }
         auto size() const { return m_size; }
         auto vaddr() const { return m_vaddr; }
 
         bool looks_like_userspace_heap_region() const;
         bool is_consistent_with_region(Memory::Region const& region) const;
+        void update_access(Memory::Region const& region) { m_access = region.access(); }
 
     private:
         Memory::Region::Access m_access;
@@ -59,19 +63,21 @@ private:
         bool m_is_kernel;
         bool m_is_readable;
         bool m_is_writable;
+        bool m_is_clean_file_backed;
         NonnullOwnPtr<KString> m_name;
         size_t m_page_count;
         size_t m_size;
         VirtualAddress m_vaddr;
     };
 
-    Coredump(NonnullLockRefPtr<Process>, NonnullLockRefPtr<OpenFileDescription>, Vector<FlatRegionData>);
+    Coredump(NonnullLockRefPtr<Process>, NonnullLockRefPtr<OpenFileDescription>, NonnullOwnPtr<GzipWriter>, Vector<FlatRegionData>);
     static ErrorOr<NonnullLockRefPtr<OpenFileDescription>> try_create_target_file(Process const&, StringView output_path);
 
     ErrorOr<void> write_elf_header();
     ErrorOr<void> write_program_headers(size_t notes_size);
     ErrorOr<void> write_regions();
     ErrorOr<void> write_notes_segment(ReadonlyBytes);
+    ErrorOr<void> write_bytes(ReadonlyBytes);
 
     ErrorOr<void> create_notes_segment_data(auto&) const;
     ErrorOr<void> create_notes_process_data(auto&) const;
@@ -81,6 +87,7 @@ private:
 
     NonnullLockRefPtr<Process> m_process;
     NonnullLockRefPtr<OpenFileDescription> m_description;
+    NonnullOwnPtr<GzipWriter> m_writer;
     size_t m_num_program_headers { 0 };
     Vector<FlatRegionData> m_regions;
 };
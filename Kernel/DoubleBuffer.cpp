@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Format.h>
 #include <AK/StringView.h>
 #include <Kernel/DoubleBuffer.h>
 #include <Kernel/InterruptDisabler.h>
@@ -17,17 +18,19 @@ inline void DoubleBuffer::compute_lockfree_metadata()
     m_space_for_writing = m_capacity - m_write_buffer->size;
 }
 
-ErrorOr<NonnullOwnPtr<DoubleBuffer>> DoubleBuffer::try_create(StringView name, size_t capacity)
+ErrorOr<NonnullOwnPtr<DoubleBuffer>> DoubleBuffer::try_create(StringView name, size_t capacity, size_t maximum_capacity)
 {
     auto storage = TRY(KBuffer::try_create_with_size(name, capacity * 2, Memory::Region::Access::ReadWrite));
-    return adopt_nonnull_own_or_enomem(new (nothrow) DoubleBuffer(capacity, move(storage)));
+    return adopt_nonnull_own_or_enomem(new (nothrow) DoubleBuffer(name, capacity, max(capacity, maximum_capacity), move(storage)));
 }
 
-DoubleBuffer::DoubleBuffer(size_t capacity, NonnullOwnPtr<KBuffer> storage)
+DoubleBuffer::DoubleBuffer(StringView name, size_t capacity, size_t maximum_capacity, NonnullOwnPtr<KBuffer> storage)
     : m_write_buffer(&m_buffer1)
     , m_read_buffer(&m_buffer2)
     , m_storage(move(storage))
+    , m_name(name)
     , m_capacity(capacity)
+    , m_maximum_capacity(maximum_capacity)
 {
     m_buffer1.data = m_storage->data();
     m_buffer1.size = 0;
@@ -36,6 +39,38 @@ DoubleBuffer::DoubleBuffer(size_t capacity, NonnullOwnPtr<KBuffer> storage)
     m_space_for_writing = capacity;
 }
 
+ErrorOr<void> DoubleBuffer::try_resize(size_t capacity, MutexLocker&)
+{
+    size_t unread_size = m_read_buffer->size - m_read_buffer_index;
+    capacity = max(capacity, max(unread_size, m_write_buffer->size));
+    if (capacity == m_capacity)
+        return {};
+
+    auto storage = TRY(KBuffer::try_create_with_size(m_name, capacity * 2, Memory::Region::Access::ReadWrite));
+    InnerBuffer read_buffer { storage->data(), unread_size };
+    InnerBuffer write_buffer { storage->data() + capacity, m_write_buffer->size };
+    memcpy(read_buffer.data, m_read_buffer->data + m_read_buffer_index, read_buffer.size);
+    memcpy(write_buffer.data, m_write_buffer->data, write_buffer.size);
+
+    m_buffer1 = read_buffer;
+    m_buffer2 = write_buffer;
+    m_read_buffer = &m_buffer1;
+    m_write_buffer = &m_buffer2;
+    m_read_buffer_index = 0;
+    m_storage = move(storage);
+    m_capacity = capacity;
+    compute_lockfree_metadata();
+    return {};
+}
+
+ErrorOr<void> DoubleBuffer::try_set_capacity(size_t capacity)
+{
+    MutexLocker locker(m_lock);
+    TRY(try_resize(capacity, locker));
+    m_maximum_capacity = m_capacity;
+    return {};
+}
+
 void DoubleBuffer::flip()
 {
     VERIFY(m_read_buffer_index == m_read_buffer->size);
@@ -50,6 +85,15 @@ ErrorOr<size_t> DoubleBuffer::write(UserOrKernelBuffer const& data, size_t size)
     if (!size)
         return 0;
     MutexLocker locker(m_lock);
+    if (size > m_space_for_writing && m_capacity < m_maximum_capacity) {
+        // Growing is only an optimization, so we can just make do with the space we have if it fails.
+        auto new_capacity = m_capacity;
+        while (new_capacity - m_write_buffer->size < size && new_capacity < m_maximum_capacity)
+            new_capacity *= 2;
+        new_capacity = min(new_capacity, m_maximum_capacity);
+        if (auto result = try_resize(new_capacity, locker); result.is_error())
+            dbgln("DoubleBuffer({}): Failed to grow to {} bytes: {}", m_name, new_capacity, result.error());
+    }
     size_t bytes_to_write = min(size, m_space_for_writing);
     u8* write_ptr = m_write_buffer->data + m_write_buffer->size;
     TRY(data.read(write_ptr, bytes_to_write));
@@ -16,7 +16,8 @@ namespace Kernel {
 
 class DoubleBuffer {
 public:
-    static ErrorOr<NonnullOwnPtr<DoubleBuffer>> try_create(StringView name, size_t capacity = 65536);
+    // If maximum_capacity is larger than capacity, the buffer grows on demand when a write doesn't fit.
+    static ErrorOr<NonnullOwnPtr<DoubleBuffer>> try_create(StringView name, size_t capacity = 65536, size_t maximum_capacity = 0);
     ErrorOr<size_t> write(UserOrKernelBuffer const&, size_t);
     ErrorOr<size_t> write(u8 const* data, size_t size)
     {
@@ -37,6 +38,12 @@ public:
 
     bool is_empty() const { return m_empty; }
 
+    size_t capacity() const { return m_capacity; }
+
+    // Sets a fixed capacity, which also stops the buffer from growing on demand.
+    // The capacity won't drop below what it currently holds.
+    ErrorOr<void> try_set_capacity(size_t);
+
     size_t space_for_writing() const { return m_space_for_writing; }
     size_t immediately_readable() const
     {
@@ -50,8 +57,9 @@ public:
     }
 
 private:
-    explicit DoubleBuffer(size_t capacity, NonnullOwnPtr<KBuffer> storage);
+    explicit DoubleBuffer(StringView name, size_t capacity, size_t maximum_capacity, NonnullOwnPtr<KBuffer> storage);
     void flip();
+    ErrorOr<void> try_resize(size_t capacity, MutexLocker&);
     void compute_lockfree_metadata();
 
     ErrorOr<size_t> read_impl(UserOrKernelBuffer&, size_t, MutexLocker&, bool advance_buffer_index);
@@ -68,7 +76,9 @@ private:
 
     NonnullOwnPtr<KBuffer> m_storage;
     Function<void()> m_unblock_callback;
+    StringView m_name;
     size_t m_capacity { 0 };
+    size_t m_maximum_capacity { 0 };
     size_t m_read_buffer_index { 0 };
     size_t m_space_for_writing { 0 };
     bool m_empty { true };
@@ -5,6 +5,7 @@
  */
 
 #include <AK/IntrusiveList.h>
+#include <AK/QuickSort.h>
 #include <Kernel/Debug.h>
 #include <Kernel/FileSystem/BlockBasedFileSystem.h>
 #include <Kernel/Process.h>
@@ -20,16 +21,25 @@ struct CacheEntry {
 
 class DiskCache {
 public:
-    static constexpr size_t EntryCount = 10000;
-    explicit DiskCache(BlockBasedFileSystem& fs, NonnullOwnPtr<KBuffer> cached_block_data, NonnullOwnPtr<KBuffer> entries_buffer)
-        : m_fs(fs)
-        , m_cached_block_data(move(cached_block_data))
-        , m_entries(move(entries_buffer))
+    // The cache grows on demand in chunks of this many entries, so small or rarely used
+    // file systems don't pin down memory they never use.
+    static constexpr size_t EntriesPerChunk = 512;
+    static constexpr size_t MinimumEntryCount = 1024;
+
+    // Each cache may grow to use at most 1/MemoryFraction of physical memory.
+    static constexpr size_t MemoryFraction = 32;
+
+    // Readahead and write-back both move runs of adjacent blocks through this buffer,
+    // so it also bounds how many blocks are merged into a single device request.
+    static constexpr size_t TransferBufferSize = 128 * KiB;
+
+    static ErrorOr<NonnullOwnPtr<DiskCache>> try_create(BlockBasedFileSystem& fs)
     {
-        for (size_t i = 0; i < EntryCount; ++i) {
-            entries()[i].data = m_cached_block_data->data() + i * m_fs->block_size();
-            m_clean_list.append(entries()[i]);
-        }
+        auto memory_info = MM.get_system_memory_info();
+        auto maximum_entry_count = max(MinimumEntryCount, (memory_info.physical_pages * PAGE_SIZE / MemoryFraction) / fs.block_size());
+        auto cache = TRY(adopt_nonnull_own_or_enomem(new (nothrow) DiskCache(fs, round_up_to_power_of_two(maximum_entry_count, EntriesPerChunk))));
+        TRY(cache->try_grow());
+        return cache;
     }
 
     ~DiskCache() = default;
@@ -65,8 +75,24 @@ public:
 
     ErrorOr<CacheEntry*> ensure(BlockBasedFileSystem::BlockIndex block_index) const
     {
-        if (auto* entry = get(block_index))
+        if (auto* entry = get(block_index)) {
+            ++m_statistics.hits;
+            // Move the entry to the front of its list, so the least recently used
+            // entries are the ones at the back of the clean list.
+            if (entry_is_dirty(*entry))
+                m_dirty_list.prepend(*entry);
+            else
+                m_clean_list.prepend(*entry);
             return entry;
+        }
+
+        ++m_statistics.misses;
+
+        if (m_statistics.entry_count < m_statistics.maximum_entry_count && (m_clean_list.is_empty() || m_clean_list.last()->has_data)) {
+            // Every entry is in use, but we're still allowed to grow. If that fails we'll
+            // just fall back to evicting something.
+            (void)try_grow();
+        }
 
         if (m_clean_list.is_empty()) {
             // Not a single clean entry! Flush writes and try again.
@@ -80,7 +106,9 @@ public:
         auto& new_entry = *m_clean_list.last();
         m_clean_list.prepend(new_entry);
 
-        m_hash.remove(new_entry.block_index);
+        if (new_entry.has_data)
+            ++m_statistics.evictions;
+        forget(new_entry);
         TRY(m_hash.try_set(block_index, &new_entry));
 
         new_entry.block_index = block_index;
@@ -89,8 +117,37 @@ public:
         return &new_entry;
     }
 
-    CacheEntry const* entries() const { return (CacheEntry const*)m_entries->data(); }
-    CacheEntry* entries() { return (CacheEntry*)m_entries->data(); }
+    // Gives back as many chunks of clean entries as possible, keeping only the first one.
+    // Returns the number of bytes released.
+    size_t release_clean_chunks() const
+    {
+        size_t released_bytes = 0;
+        while (m_chunks.size() > 1) {
+            auto& chunk = m_chunks.last();
+            auto* entries = chunk.entries();
+            for (size_t i = 0; i < EntriesPerChunk; ++i) {
+                if (entry_is_dirty(entries[i]))
+                    return released_bytes;
+            }
+            for (size_t i = 0; i < EntriesPerChunk; ++i) {
+                forget(entries[i]);
+                m_clean_list.remove(entries[i]);
+            }
+            released_bytes += chunk.block_data->capacity() + chunk.entries_data->capacity();
+            m_statistics.entry_count -= EntriesPerChunk;
+            m_chunks.take_last();
+        }
+        return released_bytes;
+    }
+
+    ErrorOr<KBuffer*> transfer_buffer() const
+    {
+        if (!m_transfer_buffer)
+            m_transfer_buffer = TRY(KBuffer::try_create_with_size("BlockBasedFS: Transfer"sv, max(TransferBufferSize, m_fs->block_size())));
+        return m_transfer_buffer.ptr();
+    }
+
+    BlockBasedFileSystem::DiskCacheStatistics const& statistics() const { return m_statistics; }
 
     template<typename Callback>
     void for_each_dirty_entry(Callback callback)
@@ -100,12 +157,51 @@ public:
     }
 
 private:
+    struct Chunk {
+        NonnullOwnPtr<KBuffer> block_data;
+        NonnullOwnPtr<KBuffer> entries_data;
+
+        CacheEntry* entries() { return (CacheEntry*)entries_data->data(); }
+    };
+
+    DiskCache(BlockBasedFileSystem& fs, size_t maximum_entry_count)
+        : m_fs(fs)
+    {
+        m_statistics.maximum_entry_count = maximum_entry_count;
+    }
+
+    ErrorOr<void> try_grow() const
+    {
+        VERIFY(m_statistics.entry_count + EntriesPerChunk <= m_statistics.maximum_entry_count);
+        auto block_data = TRY(KBuffer::try_create_with_size("BlockBasedFS: Cache blocks"sv, EntriesPerChunk * m_fs->block_size()));
+        auto entries_data = TRY(KBuffer::try_create_with_size("BlockBasedFS: Cache entries"sv, EntriesPerChunk * sizeof(CacheEntry)));
+        TRY(m_chunks.try_append(Chunk { move(block_data), move(entries_data) }));
+
+        auto& chunk = m_chunks.last();
+        auto* entries = chunk.entries();
+        for (size_t i = 0; i < EntriesPerChunk; ++i) {
+            entries[i].data = chunk.block_data->data() + i * m_fs->block_size();
+            // Unused entries go to the back of the clean list, so they're picked before we evict anything.
+            m_clean_list.append(entries[i]);
+        }
+        m_statistics.entry_count += EntriesPerChunk;
+        return {};
+    }
+
+    void forget(CacheEntry& entry) const
+    {
+        auto it = m_hash.find(entry.block_index);
+        if (it != m_hash.end() && it->value == &entry)
+            m_hash.remove(it);
+    }
+
     mutable NonnullRefPtr<BlockBasedFileSystem> m_fs;
     mutable IntrusiveList<&CacheEntry::list_node> m_dirty_list;
     mutable IntrusiveList<&CacheEntry::list_node> m_clean_list;
     mutable HashMap<BlockBasedFileSystem::BlockIndex, CacheEntry*> m_hash;
-    NonnullOwnPtr<KBuffer> m_cached_block_data;
-    NonnullOwnPtr<KBuffer> m_entries;
+    mutable Vector<Chunk> m_chunks;
+    mutable OwnPtr<KBuffer> m_transfer_buffer;
+    mutable BlockBasedFileSystem::DiskCacheStatistics m_statistics;
 };
 
 BlockBasedFileSystem::BlockBasedFileSystem(OpenFileDescription& file_description)
@@ -129,9 +225,7 @@ ErrorOr<void> BlockBasedFileSystem::initialize_while_locked()
     VERIFY(m_lock.is_locked());
     VERIFY(!is_initialized_while_locked());
     VERIFY(block_size() != 0);
-    auto cached_block_data = TRY(KBuffer::try_create_with_size("BlockBasedFS: Cache blocks"sv, DiskCache::EntryCount * block_size()));
-    auto entries_data = TRY(KBuffer::try_create_with_size("BlockBasedFS: Cache entries"sv, DiskCache::EntryCount * sizeof(CacheEntry)));
-    auto disk_cache = TRY(adopt_nonnull_own_or_enomem(new (nothrow) DiskCache(*this, move(cached_block_data), move(entries_data))));
+    auto disk_cache = TRY(DiskCache::try_create(*this));
 
     m_cache.with_exclusive([&](auto& cache) {
         cache = move(disk_cache);
@@ -192,10 +286,18 @@ ErrorOr<void> BlockBasedFileSystem::raw_write(BlockIndex index, UserOrKernelBuff
 
 ErrorOr<void> BlockBasedFileSystem::raw_read_blocks(BlockIndex index, size_t count, UserOrKernelBuffer& buffer)
 {
+    // Ask for the whole range at once and let the device split it into as few requests as it can,
+    // instead of waiting for one request per block.
+    u64 offset = index.value() * m_logical_block_size;
+    size_t remaining = count * m_logical_block_size;
     auto current = buffer;
-    for (auto block = index.value(); block < (index.value() + count); block++) {
-        TRY(raw_read(BlockIndex { block }, current));
-        current = current.offset(logical_block_size());
+    while (remaining > 0) {
+        auto nread = TRY(file_description().read(current, offset, remaining));
+        if (nread == 0)
+            return EIO;
+        current = current.offset(nread);
+        offset += nread;
+        remaining -= nread;
     }
     return {};
 }
@@ -265,6 +367,42 @@ ErrorOr<void> BlockBasedFileSystem::read_blocks(BlockIndex index, unsigned count
     return {};
 }
 
+ErrorOr<void> BlockBasedFileSystem::read_ahead_blocks(BlockIndex index, size_t count) const
+{
+    VERIFY(m_logical_block_size);
+    dbgln_if(BBFS_DEBUG, "BlockBasedFileSystem::read_ahead_blocks {}, count={}", index, count);
+
+    return m_cache.with_exclusive([&](auto& cache) -> ErrorOr<void> {
+        // Skip over blocks we already have at either end of the run.
+        while (count > 0 && cache->get(index)) {
+            index = index.value() + 1;
+            --count;
+        }
+        while (count > 0 && cache->get(index.value() + count - 1))
+            --count;
+        if (count == 0)
+            return {};
+
+        auto* readahead_buffer = TRY(cache->transfer_buffer());
+        count = min(count, readahead_buffer->size() / block_size());
+
+        auto base_offset = index.value() * block_size();
+        auto buffer = UserOrKernelBuffer::for_kernel_buffer(readahead_buffer->data());
+        auto nread = TRY(file_description().read(buffer, base_offset, count * block_size()));
+        count = nread / block_size();
+
+        for (size_t i = 0; i < count; ++i) {
+            auto* entry = TRY(cache->ensure(index.value() + i));
+            // Never clobber a block someone else has read (or written) in the meantime.
+            if (entry->has_data)
+                continue;
+            memcpy(entry->data, readahead_buffer->data() + i * block_size(), block_size());
+            entry->has_data = true;
+        }
+        return {};
+    });
+}
+
 void BlockBasedFileSystem::flush_specific_block_if_needed(BlockIndex index)
 {
     m_cache.with_exclusive([&](auto& cache) {
@@ -275,26 +413,82 @@ void BlockBasedFileSystem::flush_specific_block_if_needed(BlockIndex index)
             return;
         if (!cache->entry_is_dirty(*entry))
             return;
-        size_t base_offset = entry->block_index.value() * block_size();
         auto entry_data_buffer = UserOrKernelBuffer::for_kernel_buffer(entry->data);
-        (void)file_description().write(base_offset, entry_data_buffer, block_size());
+        (void)write_run_to_disk(entry->block_index, entry_data_buffer, 1);
     });
 }
 
+ErrorOr<void> BlockBasedFileSystem::write_run_to_disk(BlockIndex index, UserOrKernelBuffer const& data, size_t count)
+{
+    // NOTE: The underlying device may split a large transfer, so keep going until the whole run is on disk.
+    size_t bytes_to_write = count * block_size();
+    size_t nwritten = 0;
+    while (nwritten < bytes_to_write) {
+        auto offset = index.value() * block_size() + nwritten;
+        auto written = TRY(file_description().write(offset, data.offset(nwritten), bytes_to_write - nwritten));
+        if (written == 0)
+            return EIO;
+        nwritten += written;
+    }
+    return {};
+}
+
 void BlockBasedFileSystem::flush_writes_impl()
 {
-    size_t count = 0;
+    size_t block_count = 0;
+    size_t request_count = 0;
     m_cache.with_exclusive([&](auto& cache) {
         if (!cache->is_dirty())
             return;
+
+        // Plug the dirty set and sort it by block index, so adjacent blocks are merged into
+        // one large request and the device sees the writes in ascending order.
+        Vector<CacheEntry*> dirty_entries;
+        bool can_merge = true;
         cache->for_each_dirty_entry([&](CacheEntry& entry) {
-            auto base_offset = entry.block_index.value() * block_size();
-            auto entry_data_buffer = UserOrKernelBuffer::for_kernel_buffer(entry.data);
-            [[maybe_unused]] auto rc = file_description().write(base_offset, entry_data_buffer, block_size());
-            ++count;
+            if (can_merge && dirty_entries.try_append(&entry).is_error())
+                can_merge = false;
         });
+        auto transfer_buffer_or_error = cache->transfer_buffer();
+
+        if (!can_merge || transfer_buffer_or_error.is_error()) {
+            // We're low on memory, so fall back to writing each block on its own.
+            cache->for_each_dirty_entry([&](CacheEntry& entry) {
+                auto entry_data_buffer = UserOrKernelBuffer::for_kernel_buffer(entry.data);
+                [[maybe_unused]] auto result = write_run_to_disk(entry.block_index, entry_data_buffer, 1);
+                ++block_count;
+                ++request_count;
+            });
+        } else {
+            auto* transfer_buffer = transfer_buffer_or_error.value();
+            size_t const max_blocks_per_run = transfer_buffer->size() / block_size();
+            quick_sort(dirty_entries, [](CacheEntry* a, CacheEntry* b) { return a->block_index < b->block_index; });
+
+            for (size_t run_start = 0; run_start < dirty_entries.size();) {
+                auto first_index = dirty_entries[run_start]->block_index;
+                size_t run_length = 1;
+                while (run_start + run_length < dirty_entries.size()
+                    && run_length < max_blocks_per_run
+                    && dirty_entries[run_start + run_length]->block_index.value() == first_index.value() + run_length)
+                    ++run_length;
+
+                if (run_length == 1) {
+                    auto entry_data_buffer = UserOrKernelBuffer::for_kernel_buffer(dirty_entries[run_start]->data);
+                    [[maybe_unused]] auto result = write_run_to_disk(first_index, entry_data_buffer, 1);
+                } else {
+                    for (size_t i = 0; i < run_length; ++i)
+                        memcpy(transfer_buffer->data() + i * block_size(), dirty_entries[run_start + i]->data, block_size());
+                    auto run_buffer = UserOrKernelBuffer::for_kernel_buffer(transfer_buffer->data());
+                    [[maybe_unused]] auto result = write_run_to_disk(first_index, run_buffer, run_length);
+                }
+
+                block_count += run_length;
+                ++request_count;
+                run_start += run_length;
+            }
+        }
         cache->mark_all_clean();
-        dbgln("{}: Flushed {} blocks to disk", class_name(), count);
+        dbgln("{}: Flushed {} blocks to disk in {} requests", class_name(), block_count, request_count);
     });
 }
 
@@ -303,4 +497,27 @@ void BlockBasedFileSystem::flush_writes()
     flush_writes_impl();
 }
 
+size_t BlockBasedFileSystem::purge_clean_caches()
+{
+    // Write back everything first, so that all chunks of the cache can be released.
+    flush_writes_impl();
+    return m_cache.with_exclusive([&](auto& cache) -> size_t {
+        if (!cache)
+            return 0;
+        auto released_bytes = cache->release_clean_chunks();
+        if (released_bytes)
+            dbgln("{}: Released {} bytes of disk cache", class_name(), released_bytes);
+        return released_bytes;
+    });
+}
+
+Optional<BlockBasedFileSystem::DiskCacheStatistics> BlockBasedFileSystem::disk_cache_statistics() const
+{
+    return m_cache.with_shared([&](auto const& cache) -> Optional<DiskCacheStatistics> {
+        if (!cache)
+            return {};
+        return cache->statistics();
+    });
+}
+
 }
@@ -17,11 +17,23 @@ public:
 
     virtual ~BlockBasedFileSystem() override;
 
+    struct DiskCacheStatistics {
+        u64 hits { 0 };
+        u64 misses { 0 };
+        u64 evictions { 0 };
+        size_t entry_count { 0 };
+        size_t maximum_entry_count { 0 };
+    };
+
     u64 logical_block_size() const { return m_logical_block_size; };
 
     virtual void flush_writes() override;
     void flush_writes_impl();
 
+    virtual size_t purge_clean_caches() override;
+    virtual bool is_block_based() const override { return true; }
+    Optional<DiskCacheStatistics> disk_cache_statistics() const;
+
 protected:
     explicit BlockBasedFileSystem(OpenFileDescription&);
 
@@ -30,6 +42,9 @@ protected:
     ErrorOr<void> read_block(BlockIndex, UserOrKernelBuffer*, size_t count, u64 offset = 0, bool allow_cache = true) const;
     ErrorOr<void> read_blocks(BlockIndex, unsigned count, UserOrKernelBuffer&, bool allow_cache = true) const;
 
+    // Fills the cache with a run of contiguous blocks, using a single read from the underlying device.
+    ErrorOr<void> read_ahead_blocks(BlockIndex, size_t count) const;
+
     ErrorOr<void> raw_read(BlockIndex, UserOrKernelBuffer&);
     ErrorOr<void> raw_write(BlockIndex, UserOrKernelBuffer const&);
 
@@ -45,6 +60,7 @@ protected:
 
 private:
     void flush_specific_block_if_needed(BlockIndex index);
+    ErrorOr<void> write_run_to_disk(BlockIndex, UserOrKernelBuffer const&, size_t count);
 
     mutable MutexProtected<OwnPtr<DiskCache>> m_cache;
 };
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/FileSystem/EPoll.h>
+
+namespace Kernel {
+
+ErrorOr<NonnullLockRefPtr<EPoll>> EPoll::try_create()
+{
+    return adopt_nonnull_lock_ref_or_enomem(new (nothrow) EPoll);
+}
+
+ErrorOr<void> EPoll::close()
+{
+    MutexLocker locker(m_lock);
+    m_interests.clear();
+    return {};
+}
+
+ErrorOr<NonnullOwnPtr<KString>> EPoll::pseudo_path(OpenFileDescription const&) const
+{
+    MutexLocker locker(m_lock);
+    return KString::formatted("EPoll:({})", m_interests.size());
+}
+
+ErrorOr<void> EPoll::add_interest(Interest const& interest)
+{
+    MutexLocker locker(m_lock);
+    if (m_interests.contains(interest.fd))
+        return EEXIST;
+    TRY(m_interests.try_set(interest.fd, interest));
+    return {};
+}
+
+ErrorOr<void> EPoll::modify_interest(Interest const& interest)
+{
+    MutexLocker locker(m_lock);
+    auto it = m_interests.find(interest.fd);
+    if (it == m_interests.end())
+        return ENOENT;
+    it->value = interest;
+    return {};
+}
+
+ErrorOr<void> EPoll::remove_interest(int fd)
+{
+    MutexLocker locker(m_lock);
+    if (!m_interests.remove(fd))
+        return ENOENT;
+    return {};
+}
+
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <Kernel/FileSystem/File.h>
+#include <Kernel/Locking/Mutex.h>
+
+namespace Kernel {
+
+// An EPoll holds a persistent set of file descriptors a process is interested
+// in, so that waiting on them does not require handing the whole set to the
+// kernel again on every call (as select() and poll() do).
+class EPoll final : public File {
+public:
+    struct Interest {
+        int fd { -1 };
+        u32 events { 0 };
+        u64 data { 0 };
+    };
+
+    static ErrorOr<NonnullLockRefPtr<EPoll>> try_create();
+    virtual ~EPoll() override = default;
+
+    // An EPoll can't be read from or written to, only waited on with epoll_wait().
+    virtual bool can_read(OpenFileDescription const&, u64) const override { return false; }
+    virtual bool can_write(OpenFileDescription const&, u64) const override { return false; }
+    virtual ErrorOr<size_t> read(OpenFileDescription&, u64, UserOrKernelBuffer&, size_t) override { return EINVAL; }
+    virtual ErrorOr<size_t> write(OpenFileDescription&, u64, UserOrKernelBuffer const&, size_t) override { return EINVAL; }
+    virtual ErrorOr<void> close() override;
+
+    virtual ErrorOr<NonnullOwnPtr<KString>> pseudo_path(OpenFileDescription const&) const override;
+    virtual StringView class_name() const override { return "EPoll"sv; }
+    virtual bool is_epoll() const override { return true; }
+
+    ErrorOr<void> add_interest(Interest const&);
+    ErrorOr<void> modify_interest(Interest const&);
+    ErrorOr<void> remove_interest(int fd);
+
+    template<typename Callback>
+    ErrorOr<void> for_each_interest(Callback callback) const
+    {
+        MutexLocker locker(m_lock);
+        for (auto& it : m_interests)
+            TRY(callback(it.value));
+        return {};
+    }
+
+private:
+    EPoll() = default;
+
+    mutable Mutex m_lock;
+    HashMap<int, Interest> m_interests;
+};
+
+}
@@ -95,7 +95,9 @@ ErrorOr<void> Ext2FS::initialize_while_locked()
     BlockIndex first_block_of_bgdt = block_size() == 1024 ? 2 : 1;
     m_cached_group_descriptor_table = TRY(KBuffer::try_create_with_size("Ext2FS: Block group descriptors"sv, block_size() * blocks_to_read, Memory::Region::Access::ReadWrite));
     auto buffer = UserOrKernelBuffer::for_kernel_buffer(m_cached_group_descriptor_table->data());
-    TRY(read_blocks(first_block_of_bgdt, blocks_to_read, buffer));
+    // Nothing is cached yet, and we keep our own copy of the table anyway, so read it in one go instead of block by block.
+    auto logical_blocks_per_block = block_size() / logical_block_size();
+    TRY(raw_read_blocks(first_block_of_bgdt.value() * logical_blocks_per_block, blocks_to_read * logical_blocks_per_block, buffer));
 
     if constexpr (EXT2_DEBUG) {
         for (unsigned i = 1; i <= m_block_group_count; ++i) {
@@ -223,9 +225,9 @@ ErrorOr<void> Ext2FS::write_ext2_inode(InodeIndex inode, ext2_inode const& e2ino
     return write_block(block_index, buffer, inode_size(), offset);
 }
 
-auto Ext2FS::allocate_blocks(GroupIndex preferred_group_index, size_t count) -> ErrorOr<Vector<BlockIndex>>
+auto Ext2FS::allocate_blocks(GroupIndex preferred_group_index, size_t count, BlockIndex goal) -> ErrorOr<Vector<BlockIndex>>
 {
-    dbgln_if(EXT2_DEBUG, "Ext2FS: allocate_blocks(preferred group: {}, count {})", preferred_group_index, count);
+    dbgln_if(EXT2_DEBUG, "Ext2FS: allocate_blocks(preferred group: {}, count {}, goal: {})", preferred_group_index, count, goal);
     if (count == 0)
         return Vector<BlockIndex> {};
 
@@ -233,6 +235,46 @@ auto Ext2FS::allocate_blocks(GroupIndex preferred_group_index, size_t count) ->
     TRY(blocks.try_ensure_capacity(count));
 
     MutexLocker locker(m_lock);
+
+    int blocks_in_group = min(blocks_per_group(), super_block().s_blocks_count);
+    auto first_block_in_group = [&](GroupIndex group_index) {
+        return BlockIndex { (group_index.value() - 1) * blocks_per_group() + first_block_index().value() };
+    };
+
+    // Marks a run of free blocks in one group as used, with a single update to the bitmap and the free block counters.
+    auto take_free_run = [&](GroupIndex group_index, CachedBitmap& cached_bitmap, size_t first_bit, size_t run_length) {
+        auto& bgd = const_cast<ext2_group_desc&>(group_descriptor(group_index));
+        cached_bitmap.bitmap(blocks_in_group).set_range_and_verify_that_all_bits_flip(first_bit, run_length, true);
+        cached_bitmap.dirty = true;
+        m_super_block.s_free_blocks_count -= run_length;
+        bgd.bg_free_blocks_count -= run_length;
+        m_super_block_dirty = true;
+        m_block_group_descriptors_dirty = true;
+
+        auto first_block = first_block_in_group(group_index).value() + first_bit;
+        for (size_t i = 0; i < run_length; ++i) {
+            blocks.unchecked_append(first_block + i);
+            dbgln_if(EXT2_DEBUG, "  allocated > {}", first_block + i);
+        }
+    };
+
+    // Try to continue right where the caller left off, so that files end up contiguous on disk.
+    if (goal.value() && goal.value() < super_block().s_blocks_count) {
+        auto group_index = group_index_from_block_index(goal);
+        if (group_descriptor(group_index).bg_free_blocks_count) {
+            auto* cached_bitmap = TRY(get_bitmap_block(group_descriptor(group_index).bg_block_bitmap));
+            auto block_bitmap = cached_bitmap->bitmap(blocks_in_group);
+            size_t first_bit = goal.value() - first_block_in_group(group_index).value();
+            size_t run_length = 0;
+            while (run_length < count && first_bit + run_length < block_bitmap.size() && !block_bitmap.get(first_bit + run_length))
+                ++run_length;
+            if (run_length) {
+                dbgln_if(EXT2_DEBUG, "Ext2FS: allocating {} blocks at goal {} [{}]", run_length, goal, group_index);
+                take_free_run(group_index, *cached_bitmap, first_bit, run_length);
+            }
+        }
+    }
+
     auto group_index = preferred_group_index;
 
     if (!group_descriptor(preferred_group_index).bg_free_blocks_count) {
@@ -258,27 +300,70 @@ auto Ext2FS::allocate_blocks(GroupIndex preferred_group_index, size_t count) ->
         auto const& bgd = group_descriptor(group_index);
 
         auto* cached_bitmap = TRY(get_bitmap_block(bgd.bg_block_bitmap));
-
-        int blocks_in_group = min(blocks_per_group(), super_block().s_blocks_count);
         auto block_bitmap = cached_bitmap->bitmap(blocks_in_group);
 
-        BlockIndex first_block_in_group = (group_index.value() - 1) * blocks_per_group() + first_block_index().value();
         size_t free_region_size = 0;
         auto first_unset_bit_index = block_bitmap.find_longest_range_of_unset_bits(count - blocks.size(), free_region_size);
         VERIFY(first_unset_bit_index.has_value());
         dbgln_if(EXT2_DEBUG, "Ext2FS: allocating free region of size: {} [{}]", free_region_size, group_index);
-        for (size_t i = 0; i < free_region_size; ++i) {
-            BlockIndex block_index = (first_unset_bit_index.value() + i) + first_block_in_group.value();
-            TRY(set_block_allocation_state(block_index, true));
-            blocks.unchecked_append(block_index);
-            dbgln_if(EXT2_DEBUG, "  allocated > {}", block_index);
-        }
+        take_free_run(group_index, *cached_bitmap, first_unset_bit_index.value(), free_region_size);
     }
 
     VERIFY(blocks.size() == count);
     return blocks;
 }
 
+auto Ext2FS::allocate_blocks_for_inode(Ext2FSInode& inode, size_t count) -> ErrorOr<Vector<BlockIndex>>
+{
+    // How many blocks we set aside for a growing file, so that files written concurrently don't end up interleaved.
+    static constexpr size_t preallocation_window_size = 16;
+
+    if (count == 0)
+        return Vector<BlockIndex> {};
+
+    Vector<BlockIndex> blocks;
+    TRY(blocks.try_ensure_capacity(count));
+
+    MutexLocker locker(m_lock);
+
+    // Hand out the blocks we set aside the last time this inode grew first.
+    while (blocks.size() < count && !inode.m_preallocated_blocks.is_empty())
+        blocks.unchecked_append(inode.m_preallocated_blocks.take_first());
+    if (blocks.size() == count)
+        return blocks;
+
+    BlockIndex goal = 0;
+    if (!blocks.is_empty())
+        goal = blocks.last().value() + 1;
+    else if (!inode.m_block_list.is_empty() && inode.m_block_list.last().value())
+        goal = inode.m_block_list.last().value() + 1;
+
+    auto remaining_count = count - blocks.size();
+    size_t preallocation_count = 0;
+    // Only regular files grow much, and we never want preallocation to be the reason for running out of space.
+    if (Kernel::is_regular_file(inode.m_raw_inode.i_mode) && super_block().s_free_blocks_count >= remaining_count + 2 * preallocation_window_size)
+        preallocation_count = preallocation_window_size;
+    TRY(inode.m_preallocated_blocks.try_ensure_capacity(preallocation_count));
+
+    auto new_blocks = TRY(allocate_blocks(group_index_from_inode(inode.index()), remaining_count + preallocation_count, goal));
+    for (size_t i = 0; i < remaining_count; ++i)
+        blocks.unchecked_append(new_blocks[i]);
+    for (size_t i = remaining_count; i < new_blocks.size(); ++i)
+        inode.m_preallocated_blocks.unchecked_append(new_blocks[i]);
+
+    return blocks;
+}
+
+ErrorOr<void> Ext2FS::discard_preallocated_blocks(Ext2FSInode& inode)
+{
+    MutexLocker locker(m_lock);
+    while (!inode.m_preallocated_blocks.is_empty()) {
+        auto block_index = inode.m_preallocated_blocks.take_last();
+        TRY(set_block_allocation_state(block_index, false));
+    }
+    return {};
+}
+
 ErrorOr<InodeIndex> Ext2FS::allocate_inode(GroupIndex preferred_group)
 {
     dbgln_if(EXT2_DEBUG, "Ext2FS: allocate_inode(preferred_group: {})", preferred_group);
@@ -343,7 +428,7 @@ Ext2FS::GroupIndex Ext2FS::group_index_from_block_index(BlockIndex block_index)
 {
     if (!block_index)
         return 0;
-    return (block_index.value() - 1) / blocks_per_group() + 1;
+    return (block_index.value() - first_block_index().value()) / blocks_per_group() + 1;
 }
 
 auto Ext2FS::group_index_from_inode(InodeIndex inode) const -> GroupIndex
@@ -540,6 +625,11 @@ ErrorOr<void> Ext2FS::prepare_to_clear_last_mount()
             return EBUSY;
     }
 
+    for (auto& it : m_inode_cache) {
+        if (it.value)
+            TRY(discard_preallocated_blocks(*it.value));
+    }
+
     BlockBasedFileSystem::remove_disk_cache_before_last_unmount();
     m_inode_cache.clear();
     m_root_inode = nullptr;
@@ -554,6 +644,7 @@ ErrorOr<void> Ext2FS::free_inode(Ext2FSInode& inode)
 
     // Mark all blocks used by this inode as free.
     {
+        TRY(discard_preallocated_blocks(inode));
         auto blocks = TRY(inode.compute_block_list_with_meta_blocks());
         for (auto block_index : blocks) {
             VERIFY(block_index <= super_block().s_blocks_count);
@@ -595,6 +686,16 @@ void Ext2FS::flush_writes()
 {
     {
         MutexLocker locker(m_lock);
+
+        // Inodes that nobody holds on to anymore aren't going to grow, so give their preallocated blocks back.
+        // This has to happen before the bitmaps are written out below.
+        for (auto& it : m_inode_cache) {
+            if (!it.value || it.value->ref_count() != 1 || it.value->m_preallocated_blocks.is_empty())
+                continue;
+            if (auto result = discard_preallocated_blocks(*it.value); result.is_error())
+                dbgln("Ext2FS[{}]::flush_writes(): Failed to discard preallocated blocks of inode {}: {}", fsid(), it.key, result.error());
+        }
+
         if (m_super_block_dirty) {
             auto result = flush_super_block();
             if (result.is_error()) {
@@ -218,7 +218,7 @@ ErrorOr<void> Ext2FSInode::flush_block_list()
 
     Vector<Ext2FS::BlockIndex> new_meta_blocks;
     if (new_shape.meta_blocks > old_shape.meta_blocks) {
-        new_meta_blocks = TRY(fs().allocate_blocks(fs().group_index_from_inode(index()), new_shape.meta_blocks - old_shape.meta_blocks));
+        new_meta_blocks = TRY(fs().allocate_blocks(fs().group_index_from_inode(index()), new_shape.meta_blocks - old_shape.meta_blocks, m_block_list.last()));
     }
 
     m_raw_inode.i_blocks = (m_block_list.size() + new_shape.meta_blocks) * (fs().block_size() / 512);
@@ -496,13 +496,8 @@ ErrorOr<void> Ext2FSInode::flush_metadata()
     MutexLocker locker(m_inode_lock);
     dbgln_if(EXT2_DEBUG, "Ext2FSInode[{}]::flush_metadata(): Flushing inode", identifier());
     TRY(fs().write_ext2_inode(index(), m_raw_inode));
-    if (is_directory()) {
-        // Unless we're about to go away permanently, invalidate the lookup cache.
-        if (m_raw_inode.i_links_count != 0) {
-            // FIXME: This invalidation is way too hardcore. It's sad to throw away the whole cache.
-            m_lookup_cache.clear();
-        }
-    }
+    // NOTE: The lookup cache is kept in sync by add_child(), remove_child() and replace_child(),
+    //       so there is no need to throw it away here.
     set_metadata_dirty(false);
     return {};
 }
@@ -585,9 +580,37 @@ ErrorOr<size_t> Ext2FSInode::read_bytes_locked(off_t offset, size_t count, UserO
         nread += num_bytes_to_copy;
     }
 
+    if (allow_cache && description && nread > 0 && Kernel::is_regular_file(m_raw_inode.i_mode)) {
+        if (auto readahead_bytes = description->update_readahead_window(offset, nread))
+            read_ahead((offset + nread - 1) / block_size + 1, ceil_div(readahead_bytes, static_cast<size_t>(block_size)));
+    }
+
     return nread;
 }
 
+void Ext2FSInode::read_ahead(size_t first_block_logical_index, size_t count) const
+{
+    auto end = min(first_block_logical_index + count, m_block_list.size());
+    for (auto bi = first_block_logical_index; bi < end;) {
+        auto first_block_index = m_block_list[bi];
+        if (first_block_index.value() == 0) {
+            // Holes don't need to be read.
+            ++bi;
+            continue;
+        }
+
+        // Coalesce physically contiguous blocks, so that each run is a single device read.
+        size_t run_length = 1;
+        while (bi + run_length < end && m_block_list[bi + run_length].value() == first_block_index.value() + run_length)
+            ++run_length;
+
+        // Readahead is only an optimization, so just give up on errors and let the actual read report them.
+        if (fs().read_ahead_blocks(first_block_index, run_length).is_error())
+            return;
+        bi += run_length;
+    }
+}
+
 ErrorOr<void> Ext2FSInode::resize(u64 new_size)
 {
     auto old_size = size();
@@ -616,9 +639,10 @@ ErrorOr<void> Ext2FSInode::resize(u64 new_size)
         m_block_list = TRY(compute_block_list());
 
     if (blocks_needed_after > blocks_needed_before) {
-        auto blocks = TRY(fs().allocate_blocks(fs().group_index_from_inode(index()), blocks_needed_after - blocks_needed_before));
+        auto blocks = TRY(fs().allocate_blocks_for_inode(*this, blocks_needed_after - blocks_needed_before));
         TRY(m_block_list.try_extend(move(blocks)));
     } else if (blocks_needed_after < blocks_needed_before) {
+        TRY(fs().discard_preallocated_blocks(*this));
         if constexpr (EXT2_VERY_DEBUG) {
             dbgln("Ext2FSInode[{}]::resize(): Shrinking inode, old block list is {} entries:", identifier(), m_block_list.size());
             for (auto block_index : m_block_list) {
@@ -815,6 +839,109 @@ ErrorOr<void> Ext2FSInode::write_directory(Vector<Ext2FSDirectoryEntry>& entries
     return {};
 }
 
+ErrorOr<void> Ext2FSInode::append_directory_entry(InodeIndex inode_index, StringView name, u8 file_type)
+{
+    VERIFY(m_inode_lock.is_exclusively_locked_by_current_thread());
+
+    u8 buffer[max_block_size];
+    auto buf = UserOrKernelBuffer::for_kernel_buffer(buffer);
+
+    auto block_size = fs().block_size();
+    auto directory_size = ceil_div(size(), static_cast<u64>(block_size)) * block_size;
+    u16 needed_record_length = EXT2_DIR_REC_LEN(name.length());
+
+    auto write_entry = [&](size_t offset_in_block, u16 record_length) {
+        auto* entry = reinterpret_cast<ext2_dir_entry_2*>(buffer + offset_in_block);
+        entry->inode = inode_index.value();
+        entry->rec_len = record_length;
+        entry->name_len = name.length();
+        entry->file_type = file_type;
+        memcpy(entry->name, name.characters_without_null_termination(), name.length());
+    };
+
+    auto write_block_at = [&](u64 block_offset) -> ErrorOr<void> {
+        auto nwritten = TRY(write_bytes(block_offset, block_size, buf, nullptr));
+        set_metadata_dirty(true);
+        if (nwritten != block_size)
+            return EIO;
+        return {};
+    };
+
+    // The last entry of the last block owns all the slack space in that block, so try to carve the new entry out of it.
+    if (directory_size > 0) {
+        auto block_offset = directory_size - block_size;
+        TRY(read_bytes(block_offset, block_size, buf, nullptr));
+
+        size_t offset_in_block = 0;
+        for (;;) {
+            auto const* entry = reinterpret_cast<ext2_dir_entry_2 const*>(buffer + offset_in_block);
+            if (entry->rec_len < EXT2_DIR_REC_LEN(0) || offset_in_block + entry->rec_len > block_size) {
+                dbgln("Ext2FSInode[{}]::append_directory_entry(): Invalid record length {} at offset {}", identifier(), entry->rec_len, block_offset + offset_in_block);
+                return EIO;
+            }
+            if (offset_in_block + entry->rec_len == block_size)
+                break;
+            offset_in_block += entry->rec_len;
+        }
+
+        auto* last_entry = reinterpret_cast<ext2_dir_entry_2*>(buffer + offset_in_block);
+        u16 used_record_length = last_entry->inode ? EXT2_DIR_REC_LEN(last_entry->name_len) : 0;
+        if (last_entry->rec_len - used_record_length >= needed_record_length) {
+            dbgln_if(EXT2_DEBUG, "Ext2FSInode[{}]::append_directory_entry(): Adding '{}' to the block at offset {}", identifier(), name, block_offset);
+            u16 new_record_length = last_entry->rec_len - used_record_length;
+            if (used_record_length)
+                last_entry->rec_len = used_record_length;
+            write_entry(offset_in_block + used_record_length, new_record_length);
+            return write_block_at(block_offset);
+        }
+    }
+
+    // No room left, so the new entry starts a block of its own.
+    dbgln_if(EXT2_DEBUG, "Ext2FSInode[{}]::append_directory_entry(): Adding '{}' in a new block at offset {}", identifier(), name, directory_size);
+    memset(buffer, 0, block_size);
+    write_entry(0, block_size);
+    return write_block_at(directory_size);
+}
+
+ErrorOr<void> Ext2FSInode::update_directory_entry(StringView name, Function<void(ext2_dir_entry_2& entry, ext2_dir_entry_2* previous_entry)> callback)
+{
+    VERIFY(m_inode_lock.is_exclusively_locked_by_current_thread());
+
+    u8 buffer[max_block_size];
+    auto buf = UserOrKernelBuffer::for_kernel_buffer(buffer);
+
+    auto block_size = fs().block_size();
+    auto file_size = size();
+
+    for (u64 block_offset = 0; block_offset < file_size; block_offset += block_size) {
+        TRY(read_bytes(block_offset, block_size, buf, nullptr));
+
+        ext2_dir_entry_2* previous_entry = nullptr;
+        size_t offset_in_block = 0;
+        while (offset_in_block < block_size) {
+            auto* entry = reinterpret_cast<ext2_dir_entry_2*>(buffer + offset_in_block);
+            if (entry->rec_len < EXT2_DIR_REC_LEN(0) || offset_in_block + entry->rec_len > block_size) {
+                dbgln("Ext2FSInode[{}]::update_directory_entry(): Invalid record length {} at offset {}", identifier(), entry->rec_len, block_offset + offset_in_block);
+                return EIO;
+            }
+
+            if (entry->inode != 0 && name == StringView(entry->name, entry->name_len)) {
+                callback(*entry, previous_entry);
+                auto nwritten = TRY(write_bytes(block_offset, block_size, buf, nullptr));
+                set_metadata_dirty(true);
+                if (nwritten != block_size)
+                    return EIO;
+                return {};
+            }
+
+            previous_entry = entry;
+            offset_in_block += entry->rec_len;
+        }
+    }
+
+    return ENOENT;
+}
+
 ErrorOr<NonnullLockRefPtr<Inode>> Ext2FSInode::create_child(StringView name, mode_t mode, dev_t dev, UserID uid, GroupID gid)
 {
     if (Kernel::is_directory(mode))
@@ -832,22 +959,12 @@ ErrorOr<void> Ext2FSInode::add_child(Inode& child, StringView name, mode_t mode)
 
     dbgln_if(EXT2_DEBUG, "Ext2FSInode[{}]::add_child(): Adding inode {} with name '{}' and mode {:o} to directory {}", identifier(), child.index(), name, mode, index());
 
-    Vector<Ext2FSDirectoryEntry> entries;
-    TRY(traverse_as_directory([&](auto& entry) -> ErrorOr<void> {
-        if (name == entry.name)
-            return EEXIST;
-        auto entry_name = TRY(KString::try_create(entry.name));
-        TRY(entries.try_append({ move(entry_name), entry.inode.index(), entry.file_type }));
-        return {};
-    }));
+    TRY(populate_lookup_cache());
+    if (m_lookup_cache.find(name) != m_lookup_cache.end())
+        return EEXIST;
 
     TRY(child.increment_link_count());
-
-    auto entry_name = TRY(KString::try_create(name));
-    TRY(entries.try_empend(move(entry_name), child.index(), to_ext2_file_type(mode)));
-
-    TRY(write_directory(entries));
-    TRY(populate_lookup_cache());
+    TRY(append_directory_entry(child.index(), name, to_ext2_file_type(mode)));
 
     auto cache_entry_name = TRY(KString::try_create(name));
     TRY(m_lookup_cache.try_set(move(cache_entry_name), child.index()));
@@ -870,17 +987,14 @@ ErrorOr<void> Ext2FSInode::remove_child(StringView name)
 
     InodeIdentifier child_id { fsid(), child_inode_index };
 
-    Vector<Ext2FSDirectoryEntry> entries;
-    TRY(traverse_as_directory([&](auto& entry) -> ErrorOr<void> {
-        if (name != entry.name) {
-            auto entry_name = TRY(KString::try_create(entry.name));
-            TRY(entries.try_append({ move(entry_name), entry.inode.index(), entry.file_type }));
-        }
-        return {};
+    // Removing an entry means handing its space to the entry before it, or marking it unused if it's the first one in its block.
+    TRY(update_directory_entry(name, [](auto& entry, auto* previous_entry) {
+        if (previous_entry)
+            previous_entry->rec_len += entry.rec_len;
+        else
+            entry.inode = 0;
     }));
 
-    TRY(write_directory(entries));
-
     m_lookup_cache.remove(it);
 
     auto child_inode = TRY(fs().get_inode(child_id));
@@ -901,28 +1015,13 @@ ErrorOr<void> Ext2FSInode::replace_child(StringView name, Inode& child)
     if (name.length() > EXT2_NAME_LEN)
         return ENAMETOOLONG;
 
-    Vector<Ext2FSDirectoryEntry> entries;
-
-    Optional<InodeIndex> old_child_index;
-    TRY(traverse_as_directory([&](auto& entry) -> ErrorOr<void> {
-        auto is_replacing_this_inode = name == entry.name;
-        auto inode_index = is_replacing_this_inode ? child.index() : entry.inode.index();
-
-        auto entry_name = TRY(KString::try_create(entry.name));
-        TRY(entries.try_empend(move(entry_name), inode_index, to_ext2_file_type(child.mode())));
-        if (is_replacing_this_inode)
-            old_child_index = entry.inode.index();
-
-        return {};
-    }));
-
-    if (!old_child_index.has_value())
+    auto old_index_it = m_lookup_cache.find(name);
+    if (old_index_it == m_lookup_cache.end())
         return ENOENT;
+    auto old_child_index = old_index_it->value;
 
-    auto old_child = TRY(fs().get_inode({ fsid(), *old_child_index }));
+    auto old_child = TRY(fs().get_inode({ fsid(), old_child_index }));
 
-    auto old_index_it = m_lookup_cache.find(name);
-    VERIFY(old_index_it != m_lookup_cache.end());
     old_index_it->value = child.index();
 
     // NOTE: Between this line and the write_directory line, all operations must
@@ -931,18 +1030,22 @@ ErrorOr<void> Ext2FSInode::replace_child(StringView name, Inode& child)
 
     auto maybe_decrement_error = old_child->decrement_link_count();
     if (maybe_decrement_error.is_error()) {
-        old_index_it->value = *old_child_index;
+        old_index_it->value = old_child_index;
         MUST(child.decrement_link_count());
         return maybe_decrement_error;
     }
 
     // FIXME: The filesystem is left in an inconsistent state if this fails.
-    //        Revert the changes made above if we can't write_directory.
+    //        Revert the changes made above if we can't update the directory entry.
     //        Ideally, decrement should be the last operation, but we currently
-    //        can't "un-write" a directory entry list.
-    TRY(write_directory(entries));
+    //        can't "un-write" a directory entry.
+    auto file_type = to_ext2_file_type(child.mode());
+    TRY(update_directory_entry(name, [&](auto& entry, auto*) {
+        entry.inode = child.index().value();
+        entry.file_type = file_type;
+    }));
 
-    // TODO: Emit a did_replace_child event.
+    did_replace_child(child.identifier(), name);
 
     return {};
 }
@@ -45,7 +45,10 @@ private:
     virtual ErrorOr<void> truncate(u64) override;
     virtual ErrorOr<int> get_block_address(int) override;
 
+    void read_ahead(size_t first_block_logical_index, size_t count) const;
     ErrorOr<void> write_directory(Vector<Ext2FSDirectoryEntry>&);
+    ErrorOr<void> append_directory_entry(InodeIndex, StringView name, u8 file_type);
+    ErrorOr<void> update_directory_entry(StringView name, Function<void(ext2_dir_entry_2& entry, ext2_dir_entry_2* previous_entry)>);
     ErrorOr<void> populate_lookup_cache();
     ErrorOr<void> resize(u64);
     ErrorOr<void> write_indirect_block(BlockBasedFileSystem::BlockIndex, Span<BlockBasedFileSystem::BlockIndex>);
@@ -66,10 +69,13 @@ private:
     Ext2FSInode(Ext2FS&, InodeIndex);
 
     Vector<BlockBasedFileSystem::BlockIndex> m_block_list;
+    // Blocks that are already marked as used for this inode, but aren't part of its block list yet.
+    // They are handed out first the next time the inode grows, and are guarded by the file system lock.
+    Vector<BlockBasedFileSystem::BlockIndex> m_preallocated_blocks;
     HashMap<NonnullOwnPtr<KString>, InodeIndex> m_lookup_cache;
     ext2_inode m_raw_inode {};
 
-    Mutex m_block_list_lock { "BlockList"sv };
+    Mutex m_block_list_lock { "BlockList"sv, Mutex::MutexBehavior::Regular, LockRank::FileSystem };
 };
 
 inline Ext2FS& Ext2FSInode::fs()
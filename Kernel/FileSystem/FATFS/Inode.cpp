@@ -7,7 +7,6 @@
 #include <AK/Time.h>
 #include <Kernel/Debug.h>
 #include <Kernel/FileSystem/FATFS/Inode.h>
-#include <Kernel/KBufferBuilder.h>
 
 namespace Kernel {
 
@@ -42,64 +41,84 @@ FATInode::FATInode(FATFS& fs, FATEntry entry, NonnullOwnPtr<KString> filename)
     };
 }
 
-ErrorOr<Vector<BlockBasedFileSystem::BlockIndex>> FATInode::compute_block_list()
+ErrorOr<void> FATInode::ensure_extents()
 {
     VERIFY(m_inode_lock.is_locked());
 
-    dbgln_if(FAT_DEBUG, "FATFS: computing block list for inode {}", index());
-
-    u32 cluster = first_cluster();
+    if (!m_extents.is_empty())
+        return {};
 
-    Vector<BlockBasedFileSystem::BlockIndex> block_list;
+    dbgln_if(FAT_DEBUG, "FATFS: computing block list for inode {}", index());
 
-    auto fat_sector = TRY(KBuffer::try_create_with_size("FATFS: FAT read buffer"sv, fs().m_logical_block_size));
-    auto fat_sector_buffer = UserOrKernelBuffer::for_kernel_buffer(fat_sector->data());
+    size_t blocks_per_cluster = fs().boot_record()->sectors_per_cluster;
+    size_t block_count = 0;
+    Vector<Extent> extents;
 
-    while (cluster < no_more_clusters) {
+    u32 cluster = first_cluster();
+    while (cluster >= FATFS::first_data_cluster && cluster < no_more_clusters) {
         dbgln_if(FAT_DEBUG, "FATFS: Appending cluster {} to inode {}'s cluster chain", cluster, index());
 
-        BlockBasedFileSystem::BlockIndex first_block = fs().first_block_of_cluster(cluster);
-        for (u8 i = 0; i < fs().boot_record()->sectors_per_cluster; i++)
-            block_list.append(BlockBasedFileSystem::BlockIndex { first_block.value() + i });
+        // A cluster chain that is longer than the volume must be looping back onto itself.
+        if (block_count >= fs().boot_record()->sector_count)
+            return EIO;
+
+        auto first_block = fs().first_block_of_cluster(cluster);
+        if (!extents.is_empty() && extents.last().first_block.value() + extents.last().block_count == first_block.value())
+            extents.last().block_count += blocks_per_cluster;
+        else
+            TRY(extents.try_append({ first_block, block_count, blocks_per_cluster }));
+        block_count += blocks_per_cluster;
 
         u32 fat_offset = cluster * sizeof(u32);
-        u32 fat_sector_index = fs().boot_record()->reserved_sector_count + (fat_offset / fs().m_logical_block_size);
+        BlockBasedFileSystem::BlockIndex fat_sector_index = fs().boot_record()->reserved_sector_count + (fat_offset / fs().m_logical_block_size);
         u32 entry_offset = fat_offset % fs().m_logical_block_size;
 
-        TRY(fs().raw_read(fat_sector_index, fat_sector_buffer));
-
-        cluster = *reinterpret_cast<u32*>(&fat_sector->data()[entry_offset]);
-        cluster &= cluster_number_mask;
+        // NOTE: This goes through the block cache, so following a chain doesn't read the same FAT sector over and over.
+        u32 next_cluster = 0;
+        auto next_cluster_buffer = UserOrKernelBuffer::for_kernel_buffer(reinterpret_cast<u8*>(&next_cluster));
+        TRY(fs().read_block(fat_sector_index, &next_cluster_buffer, sizeof(next_cluster), entry_offset));
+        cluster = next_cluster & cluster_number_mask;
     }
 
-    return block_list;
+    m_extents = move(extents);
+    m_block_count = block_count;
+    return {};
+}
+
+FATInode::Extent const* FATInode::find_extent(size_t file_block) const
+{
+    size_t low = 0;
+    size_t high = m_extents.size();
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        auto const& extent = m_extents[middle];
+        if (file_block < extent.first_file_block)
+            high = middle;
+        else if (file_block >= extent.first_file_block + extent.block_count)
+            low = middle + 1;
+        else
+            return &extent;
+    }
+    return nullptr;
 }
 
 ErrorOr<NonnullOwnPtr<KBuffer>> FATInode::read_block_list()
 {
     VERIFY(m_inode_lock.is_locked());
 
-    dbgln_if(FAT_DEBUG, "FATFS: reading block list for inode {} ({} blocks)", index(), m_block_list.size());
-
-    if (m_block_list.is_empty())
-        m_block_list = TRY(compute_block_list());
+    TRY(ensure_extents());
 
-    auto builder = TRY(KBufferBuilder::try_create());
+    dbgln_if(FAT_DEBUG, "FATFS: reading block list for inode {} ({} blocks)", index(), m_block_count);
 
-    u8 buffer[512];
-    VERIFY(fs().m_logical_block_size <= sizeof(buffer));
-    auto buf = UserOrKernelBuffer::for_kernel_buffer(buffer);
+    if (m_block_count == 0)
+        return EIO;
 
-    for (BlockBasedFileSystem::BlockIndex block : m_block_list) {
-        dbgln_if(FAT_DEBUG, "FATFS: reading block: {}", block);
-        TRY(fs().raw_read(block, buf));
-        TRY(builder.append((char const*)buffer, fs().m_logical_block_size));
+    auto blocks = TRY(KBuffer::try_create_with_size("FATFS: Block list"sv, m_block_count * fs().m_logical_block_size));
+    for (auto const& extent : m_extents) {
+        auto buffer = UserOrKernelBuffer::for_kernel_buffer(blocks->data() + extent.first_file_block * fs().m_logical_block_size);
+        TRY(fs().raw_read_blocks(extent.first_block, extent.block_count, buffer));
     }
-
-    auto blocks = builder.build();
-    if (!blocks)
-        return ENOMEM;
-    return blocks.release_nonnull();
+    return blocks;
 }
 
 ErrorOr<void> FATInode::replace_child(StringView, Inode&)
@@ -205,11 +224,37 @@ ErrorOr<size_t> FATInode::read_bytes_locked(off_t offset, size_t size, UserOrKer
     if (offset >= m_metadata.size)
         return 0;
 
-    // FIXME: Read only the needed blocks instead of the whole file
-    auto blocks = TRY(const_cast<FATInode&>(*this).read_block_list());
-    TRY(buffer.write(blocks->data() + offset, min(size, m_block_list.size() * fs().m_logical_block_size - offset)));
+    auto& self = const_cast<FATInode&>(*this);
+    TRY(self.ensure_extents());
+
+    size_t block_size = fs().m_logical_block_size;
+    size = min(size, static_cast<size_t>(m_metadata.size - offset));
+
+    size_t nread = 0;
+    while (nread < size) {
+        u64 position = offset + nread;
+        auto const* extent = find_extent(position / block_size);
+        if (!extent)
+            break;
+        size_t block_in_extent = position / block_size - extent->first_file_block;
+        BlockBasedFileSystem::BlockIndex block = extent->first_block.value() + block_in_extent;
+        size_t offset_in_block = position % block_size;
+        auto destination = buffer.offset(nread);
+
+        if (offset_in_block != 0 || size - nread < block_size) {
+            size_t count = min(block_size - offset_in_block, size - nread);
+            TRY(fs().read_block(block, &destination, count, offset_in_block));
+            nread += count;
+            continue;
+        }
+
+        // Read as much of the extent as we can with a single request, straight into the caller's buffer.
+        size_t block_count = min(extent->block_count - block_in_extent, (size - nread) / block_size);
+        TRY(self.fs().raw_read_blocks(block, block_count, destination));
+        nread += block_count * block_size;
+    }
 
-    return min(size, m_block_list.size() * fs().m_logical_block_size - offset);
+    return nread;
 }
 
 InodeMetadata FATInode::metadata() const
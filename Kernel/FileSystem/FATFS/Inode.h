@@ -45,7 +45,15 @@ private:
     static ErrorOr<NonnullOwnPtr<KString>> compute_filename(FATEntry&, Vector<FATLongFileNameEntry> const& = {});
     static StringView byte_terminated_string(StringView, u8);
 
-    ErrorOr<Vector<BlockBasedFileSystem::BlockIndex>> compute_block_list();
+    // A run of blocks that are contiguous both on disk and in the file.
+    struct Extent {
+        BlockBasedFileSystem::BlockIndex first_block;
+        size_t first_file_block { 0 };
+        size_t block_count { 0 };
+    };
+
+    ErrorOr<void> ensure_extents();
+    Extent const* find_extent(size_t file_block) const;
     ErrorOr<NonnullOwnPtr<KBuffer>> read_block_list();
     ErrorOr<LockRefPtr<FATInode>> traverse(Function<ErrorOr<bool>(LockRefPtr<FATInode>)> callback);
     u32 first_cluster() const;
@@ -65,7 +73,8 @@ private:
     virtual ErrorOr<void> chown(UserID, GroupID) override;
     virtual ErrorOr<void> flush_metadata() override;
 
-    Vector<BlockBasedFileSystem::BlockIndex> m_block_list;
+    Vector<Extent> m_extents;
+    size_t m_block_count { 0 };
     FATEntry m_entry;
     NonnullOwnPtr<KString> m_filename;
     InodeMetadata m_metadata;
@@ -18,7 +18,7 @@ static Atomic<int> s_next_fifo_id = 1;
 
 ErrorOr<NonnullLockRefPtr<FIFO>> FIFO::try_create(UserID uid)
 {
-    auto buffer = TRY(DoubleBuffer::try_create("FIFO: Buffer"sv));
+    auto buffer = TRY(DoubleBuffer::try_create("FIFO: Buffer"sv, initial_buffer_size, maximum_buffer_size));
     return adopt_nonnull_lock_ref_or_enomem(new (nothrow) FIFO(uid, move(buffer)));
 }
 
@@ -128,6 +128,14 @@ ErrorOr<size_t> FIFO::write(OpenFileDescription& fd, u64, UserOrKernelBuffer con
     return m_buffer->write(buffer, size);
 }
 
+ErrorOr<size_t> FIFO::set_buffer_capacity(size_t capacity)
+{
+    TRY(m_buffer->try_set_capacity(clamp<size_t>(capacity, PAGE_SIZE, maximum_buffer_size)));
+    // There may be room for writers now.
+    evaluate_block_conditions();
+    return m_buffer->capacity();
+}
+
 ErrorOr<NonnullOwnPtr<KString>> FIFO::pseudo_path(OpenFileDescription const&) const
 {
     return KString::formatted("fifo:{}", m_fifo_id);
@@ -29,6 +29,12 @@ public:
 
     UserID uid() const { return m_uid; }
 
+    static constexpr size_t initial_buffer_size = 64 * KiB;
+    static constexpr size_t maximum_buffer_size = 1 * MiB;
+
+    size_t buffer_capacity() const { return m_buffer->capacity(); }
+    ErrorOr<size_t> set_buffer_capacity(size_t);
+
     ErrorOr<NonnullLockRefPtr<OpenFileDescription>> open_direction(Direction);
     ErrorOr<NonnullLockRefPtr<OpenFileDescription>> open_direction_blocking(Direction);
 
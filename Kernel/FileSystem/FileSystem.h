@@ -53,10 +53,14 @@ public:
 
     virtual void flush_writes() { }
 
+    // Releases memory held by caches that can be rebuilt from disk. Returns the number of bytes released.
+    virtual size_t purge_clean_caches() { return 0; }
+
     u64 block_size() const { return m_block_size; }
     size_t fragment_size() const { return m_fragment_size; }
 
     virtual bool is_file_backed() const { return false; }
+    virtual bool is_block_based() const { return false; }
 
     // Converts file types that are used internally by the filesystem to DT_* types
     virtual u8 internal_file_type_to_directory_entry_type(DirectoryEntryView const& entry) const { return entry.file_type; }
@@ -71,7 +75,7 @@ protected:
 
     virtual ErrorOr<void> prepare_to_clear_last_mount() { return {}; }
 
-    mutable Mutex m_lock { "FS"sv };
+    mutable Mutex m_lock { "FS"sv, Mutex::MutexBehavior::Regular, LockRank::FileSystem };
 
 private:
     FileSystemID m_fsid;
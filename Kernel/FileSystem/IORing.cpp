@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <Kernel/FileSystem/IORing.h>
+#include <Kernel/Memory/MemoryManager.h>
+
+namespace Kernel {
+
+ErrorOr<NonnullLockRefPtr<IORing>> IORing::try_create(u32 submission_entry_count)
+{
+    if (submission_entry_count == 0 || submission_entry_count > io_ring_max_entries || !is_power_of_two(submission_entry_count))
+        return EINVAL;
+
+    auto size = TRY(Memory::page_round_up(io_ring_size(submission_entry_count)));
+    auto vmobject = TRY(Memory::AnonymousVMObject::try_create_with_size(size, AllocationStrategy::AllocateNow));
+    auto region = TRY(MM.allocate_kernel_region_with_vmobject(*vmobject, size, "IORing"sv, Memory::Region::Access::ReadWrite));
+    return adopt_nonnull_lock_ref_or_enomem(new (nothrow) IORing(submission_entry_count, move(vmobject), move(region)));
+}
+
+IORing::IORing(u32 submission_entry_count, NonnullLockRefPtr<Memory::AnonymousVMObject> vmobject, NonnullOwnPtr<Memory::Region> region)
+    : m_submission_entry_count(submission_entry_count)
+    , m_completion_entry_count(io_ring_completion_entry_count(submission_entry_count))
+    , m_vmobject(move(vmobject))
+    , m_region(move(region))
+{
+    auto& ring = header();
+    ring.submissions = { 0, 0, m_submission_entry_count - 1, static_cast<u32>(io_ring_submissions_offset()) };
+    ring.completions = { 0, 0, m_completion_entry_count - 1, static_cast<u32>(io_ring_completions_offset(m_submission_entry_count)) };
+}
+
+ErrorOr<NonnullLockRefPtr<Memory::VMObject>> IORing::vmobject_for_mmap(Process&, Memory::VirtualRange const&, u64& offset, bool shared)
+{
+    // The whole point of the ring is to share it with the kernel.
+    if (offset != 0 || !shared)
+        return EINVAL;
+
+    return m_vmobject;
+}
+
+ErrorOr<NonnullOwnPtr<KString>> IORing::pseudo_path(OpenFileDescription const&) const
+{
+    return KString::formatted("IORing:({})", m_submission_entry_count);
+}
+
+IORingSubmission const& IORing::submission_at(u32 index) const
+{
+    auto* entries = reinterpret_cast<IORingSubmission const*>(m_region->vaddr().offset(io_ring_submissions_offset()).as_ptr());
+    return entries[index & (m_submission_entry_count - 1)];
+}
+
+IORingCompletion& IORing::completion_at(u32 index)
+{
+    auto* entries = reinterpret_cast<IORingCompletion*>(m_region->vaddr().offset(io_ring_completions_offset(m_submission_entry_count)).as_ptr());
+    return entries[index & (m_completion_entry_count - 1)];
+}
+
+ErrorOr<size_t> IORing::consume_submissions(u32 max_count, Function<ErrorOr<FlatPtr>(IORingSubmission const&)> execute)
+{
+    MutexLocker locker(m_lock);
+    auto& ring = header();
+
+    auto submission_tail = AK::atomic_load(&ring.submissions.tail, AK::memory_order_acquire);
+    auto completion_head = AK::atomic_load(&ring.completions.head, AK::memory_order_acquire);
+
+    u32 queued_submissions = submission_tail - m_submission_head;
+    u32 queued_completions = m_completion_tail - completion_head;
+    if (queued_submissions > m_submission_entry_count || queued_completions > m_completion_entry_count)
+        return EINVAL;
+
+    auto count = min(max_count, min(queued_submissions, m_completion_entry_count - queued_completions));
+
+    size_t consumed = 0;
+    for (; consumed < count; ++consumed) {
+        // NOTE: Userspace may still be writing to the shared memory, so work on a copy.
+        IORingSubmission submission;
+        memcpy(&submission, &submission_at(m_submission_head), sizeof(submission));
+
+        auto result = execute(submission);
+        // Promise violations have to crash the process, so they can't just be reported in a completion.
+        if (result.is_error() && result.error().code() == EPROMISEVIOLATION)
+            return result.release_error();
+
+        auto& completion = completion_at(m_completion_tail);
+        completion.user_data = submission.user_data;
+        completion.result = result.is_error() ? -static_cast<i64>(result.error().code()) : static_cast<i64>(result.value());
+
+        ++m_submission_head;
+        ++m_completion_tail;
+        AK::atomic_store(&ring.submissions.head, m_submission_head, AK::memory_order_release);
+        AK::atomic_store(&ring.completions.tail, m_completion_tail, AK::memory_order_release);
+    }
+
+    return consumed;
+}
+
+}
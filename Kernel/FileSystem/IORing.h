@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <Kernel/API/IORing.h>
+#include <Kernel/FileSystem/File.h>
+#include <Kernel/Locking/Mutex.h>
+#include <Kernel/Memory/AnonymousVMObject.h>
+#include <Kernel/Memory/Region.h>
+
+namespace Kernel {
+
+// The kernel side of an I/O ring (see Kernel/API/IORing.h). The ring lives in an
+// AnonymousVMObject that is mapped both into the kernel and, via mmap(), into
+// the owning process.
+class IORing final : public File {
+public:
+    static ErrorOr<NonnullLockRefPtr<IORing>> try_create(u32 submission_entry_count);
+    virtual ~IORing() override = default;
+
+    virtual ErrorOr<NonnullLockRefPtr<Memory::VMObject>> vmobject_for_mmap(Process&, Memory::VirtualRange const&, u64& offset, bool shared) override;
+
+    virtual bool can_read(OpenFileDescription const&, u64) const override { return false; }
+    virtual bool can_write(OpenFileDescription const&, u64) const override { return false; }
+    virtual ErrorOr<size_t> read(OpenFileDescription&, u64, UserOrKernelBuffer&, size_t) override { return EINVAL; }
+    virtual ErrorOr<size_t> write(OpenFileDescription&, u64, UserOrKernelBuffer const&, size_t) override { return EINVAL; }
+
+    virtual ErrorOr<NonnullOwnPtr<KString>> pseudo_path(OpenFileDescription const&) const override;
+    virtual StringView class_name() const override { return "IORing"sv; }
+    virtual bool is_io_ring() const override { return true; }
+
+    // Consumes up to max_count queued submissions, as long as there is room for their completions,
+    // and returns how many were consumed.
+    ErrorOr<size_t> consume_submissions(u32 max_count, Function<ErrorOr<FlatPtr>(IORingSubmission const&)> execute);
+
+private:
+    IORing(u32 submission_entry_count, NonnullLockRefPtr<Memory::AnonymousVMObject>, NonnullOwnPtr<Memory::Region>);
+
+    IORingHeader& header() { return *reinterpret_cast<IORingHeader*>(m_region->vaddr().as_ptr()); }
+    IORingSubmission const& submission_at(u32 index) const;
+    IORingCompletion& completion_at(u32 index);
+
+    Mutex m_lock;
+
+    u32 const m_submission_entry_count { 0 };
+    u32 const m_completion_entry_count { 0 };
+
+    // NOTE: We never trust the indices in the shared header that are owned by the kernel,
+    //       as userspace could scribble over them at any time.
+    u32 m_submission_head { 0 };
+    u32 m_completion_tail { 0 };
+
+    NonnullLockRefPtr<Memory::AnonymousVMObject> m_vmobject;
+    NonnullOwnPtr<Memory::Region> m_region;
+};
+
+}
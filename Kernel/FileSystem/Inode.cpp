@@ -217,6 +217,8 @@ void Inode::set_metadata_dirty(bool metadata_dirty)
 
 void Inode::did_add_child(InodeIdentifier, StringView name)
 {
+    VirtualFileSystem::the().invalidate_cached_lookups(*this, name);
+
     m_watchers.for_each([&](auto& watcher) {
         watcher->notify_inode_event({}, identifier(), InodeWatcherEvent::Type::ChildCreated, name);
     });
@@ -224,6 +226,8 @@ void Inode::did_add_child(InodeIdentifier, StringView name)
 
 void Inode::did_remove_child(InodeIdentifier, StringView name)
 {
+    VirtualFileSystem::the().invalidate_cached_lookups(*this, name);
+
     if (name == "." || name == "..") {
         // These are just aliases and are not interesting to userspace.
         return;
@@ -234,6 +238,13 @@ void Inode::did_remove_child(InodeIdentifier, StringView name)
     });
 }
 
+void Inode::did_replace_child(InodeIdentifier, StringView name)
+{
+    VirtualFileSystem::the().invalidate_cached_lookups(*this, name);
+
+    // FIXME: Tell the watchers about this, once InodeWatcherEvent has a way to express it.
+}
+
 void Inode::did_modify_contents()
 {
     // FIXME: What happens if this fails?
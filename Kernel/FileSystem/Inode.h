@@ -77,6 +77,11 @@ public:
 
     virtual ErrorOr<int> get_block_address(int) { return ENOTSUP; }
 
+    // Makes a range of this file share the blocks of a range of another file on the same file system, instead of
+    // copying the data. Returns how many bytes are now shared, which may be fewer than were asked for.
+    // File systems that can't do this return ENOTSUP, and copy_file_range() copies the data instead.
+    virtual ErrorOr<size_t> share_blocks_from(Inode const&, off_t, off_t, size_t) { return ENOTSUP; }
+
     LockRefPtr<LocalSocket> bound_socket() const;
     bool bind_socket(LocalSocket&);
     bool unbind_socket();
@@ -117,10 +122,11 @@ protected:
 
     void did_add_child(InodeIdentifier child_id, StringView);
     void did_remove_child(InodeIdentifier child_id, StringView);
+    void did_replace_child(InodeIdentifier child_id, StringView);
     void did_modify_contents();
     void did_delete_self();
 
-    mutable Mutex m_inode_lock { "Inode"sv };
+    mutable Mutex m_inode_lock { "Inode"sv, Mutex::MutexBehavior::Regular, LockRank::FileSystem };
 
     virtual ErrorOr<size_t> write_bytes_locked(off_t, size_t, UserOrKernelBuffer const& data, OpenFileDescription*) = 0;
     virtual ErrorOr<size_t> read_bytes_locked(off_t, size_t, UserOrKernelBuffer& buffer, OpenFileDescription*) const = 0;
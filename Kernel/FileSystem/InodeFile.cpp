@@ -29,7 +29,11 @@ ErrorOr<size_t> InodeFile::read(OpenFileDescription& description, u64 offset, Us
     if (Checked<off_t>::addition_would_overflow(offset, count))
         return EOVERFLOW;
 
-    auto nread = TRY(m_inode->read_bytes(offset, count, buffer, &description));
+    size_t nread = 0;
+    if (auto shared_vmobject = m_inode->shared_vmobject())
+        nread = TRY(shared_vmobject->read_bytes(offset, count, buffer, &description));
+    else
+        nread = TRY(m_inode->read_bytes(offset, count, buffer, &description));
     if (nread > 0) {
         Thread::current()->did_file_read(nread);
         evaluate_block_conditions();
@@ -44,6 +48,8 @@ ErrorOr<size_t> InodeFile::write(OpenFileDescription& description, u64 offset, U
 
     size_t nwritten = TRY(m_inode->write_bytes(offset, count, data, &description));
     if (nwritten > 0) {
+        if (auto shared_vmobject = m_inode->shared_vmobject())
+            TRY(shared_vmobject->update_resident_pages(offset, nwritten, data));
         auto mtime_result = m_inode->update_timestamps({}, {}, kgettimeofday());
         Thread::current()->did_file_write(nwritten);
         evaluate_block_conditions();
@@ -9,7 +9,9 @@
 #include <Kernel/API/POSIX/errno.h>
 #include <Kernel/Devices/BlockDevice.h>
 #include <Kernel/FileSystem/Custody.h>
+#include <Kernel/FileSystem/EPoll.h>
 #include <Kernel/FileSystem/FIFO.h>
+#include <Kernel/FileSystem/IORing.h>
 #include <Kernel/FileSystem/InodeFile.h>
 #include <Kernel/FileSystem/InodeWatcher.h>
 #include <Kernel/FileSystem/OpenFileDescription.h>
@@ -23,6 +25,9 @@
 
 namespace Kernel {
 
+static constexpr size_t minimum_readahead_window = 16 * KiB;
+static constexpr size_t maximum_readahead_window = 128 * KiB;
+
 ErrorOr<NonnullLockRefPtr<OpenFileDescription>> OpenFileDescription::try_create(Custody& custody)
 {
     auto inode_file = TRY(InodeFile::create(custody.inode()));
@@ -323,6 +328,37 @@ InodeWatcher* OpenFileDescription::inode_watcher()
     return static_cast<InodeWatcher*>(m_file.ptr());
 }
 
+bool OpenFileDescription::is_epoll() const
+{
+    return m_file->is_epoll();
+}
+
+EPoll const* OpenFileDescription::epoll() const
+{
+    if (!is_epoll())
+        return nullptr;
+    return static_cast<EPoll const*>(m_file.ptr());
+}
+
+EPoll* OpenFileDescription::epoll()
+{
+    if (!is_epoll())
+        return nullptr;
+    return static_cast<EPoll*>(m_file.ptr());
+}
+
+bool OpenFileDescription::is_io_ring() const
+{
+    return m_file->is_io_ring();
+}
+
+IORing* OpenFileDescription::io_ring()
+{
+    if (!is_io_ring())
+        return nullptr;
+    return static_cast<IORing*>(m_file.ptr());
+}
+
 bool OpenFileDescription::is_master_pty() const
 {
     return m_file->is_master_pty();
@@ -489,6 +525,22 @@ bool OpenFileDescription::is_direct() const
     return m_state.with([](auto& state) { return state.direct; });
 }
 
+size_t OpenFileDescription::update_readahead_window(u64 offset, size_t count)
+{
+    return m_state.with([&](auto& state) -> size_t {
+        if (offset != state.readahead_next_offset) {
+            // This isn't a sequential read, so reading ahead would most likely be a waste.
+            state.readahead_window = 0;
+        } else if (state.readahead_window == 0) {
+            state.readahead_window = clamp(count, minimum_readahead_window, maximum_readahead_window);
+        } else {
+            state.readahead_window = min(state.readahead_window * 2, maximum_readahead_window);
+        }
+        state.readahead_next_offset = offset + count;
+        return state.readahead_window;
+    });
+}
+
 bool OpenFileDescription::is_directory() const
 {
     return m_state.with([](auto& state) { return state.is_directory; });
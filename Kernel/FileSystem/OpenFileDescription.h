@@ -65,6 +65,10 @@ public:
 
     bool is_direct() const;
 
+    // Records a read of count bytes at offset, and returns how many bytes past the end of it
+    // the file system should read ahead. The window grows while reads stay sequential.
+    size_t update_readahead_window(u64 offset, size_t count);
+
     bool is_directory() const;
 
     File& file() { return *m_file; }
@@ -82,6 +86,13 @@ public:
     InodeWatcher const* inode_watcher() const;
     InodeWatcher* inode_watcher();
 
+    bool is_epoll() const;
+    EPoll const* epoll() const;
+    EPoll* epoll();
+
+    bool is_io_ring() const;
+    IORing* io_ring();
+
     bool is_master_pty() const;
     MasterPTY const* master_pty() const;
     MasterPTY* master_pty();
@@ -147,6 +158,8 @@ private:
         OwnPtr<OpenFileDescriptionData> data;
         RefPtr<Custody> custody;
         off_t current_offset { 0 };
+        u64 readahead_next_offset { 0 };
+        size_t readahead_window { 0 };
         u32 file_flags { 0 };
         bool readable : 1 { false };
         bool writable : 1 { false };
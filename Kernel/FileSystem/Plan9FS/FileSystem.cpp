@@ -279,10 +279,39 @@ ErrorOr<void> Plan9FS::post_message_and_explicitly_ignore_reply(Plan9FSMessage&
 
 ErrorOr<void> Plan9FS::post_message_and_wait_for_a_reply(Plan9FSMessage& message)
 {
-    auto request_type = message.type();
-    auto tag = message.tag();
-    auto completion = adopt_lock_ref(*new ReceiveCompletion(tag));
+    auto completion = TRY(adopt_nonnull_lock_ref_or_enomem(new (nothrow) ReceiveCompletion(message.tag())));
     TRY(post_message(message, completion));
+    return wait_for_a_reply(message, move(completion));
+}
+
+ErrorOr<size_t> Plan9FS::post_messages_and_wait_for_replies(Span<NonnullOwnPtr<Plan9FSMessage>> messages)
+{
+    Vector<NonnullLockRefPtr<ReceiveCompletion>, 8> completions;
+    TRY(completions.try_ensure_capacity(messages.size()));
+    for (auto& message : messages) {
+        auto completion = TRY(adopt_nonnull_lock_ref_or_enomem(new (nothrow) ReceiveCompletion(message->tag())));
+        if (auto result = post_message(*message, completion); result.is_error()) {
+            if (completions.is_empty())
+                return result.release_error();
+            break;
+        }
+        completions.unchecked_append(move(completion));
+    }
+
+    // NOTE: If we stop early, the replies to the remaining messages are simply dropped as they arrive.
+    for (size_t i = 0; i < completions.size(); ++i) {
+        if (auto result = wait_for_a_reply(*messages[i], completions[i]); result.is_error()) {
+            if (i == 0)
+                return result.release_error();
+            return i;
+        }
+    }
+    return completions.size();
+}
+
+ErrorOr<void> Plan9FS::wait_for_a_reply(Plan9FSMessage& message, NonnullLockRefPtr<ReceiveCompletion> completion)
+{
+    auto request_type = message.type();
     if (Thread::current()->block<Plan9FS::Blocker>({}, *this, message, completion).was_interrupted())
         return EINTR;
 
@@ -116,7 +116,11 @@ private:
     ErrorOr<void> post_message(Plan9FSMessage&, LockRefPtr<ReceiveCompletion>);
     ErrorOr<void> do_read(u8* buffer, size_t);
     ErrorOr<void> read_and_dispatch_one_message();
+    ErrorOr<void> wait_for_a_reply(Plan9FSMessage&, NonnullLockRefPtr<ReceiveCompletion>);
     ErrorOr<void> post_message_and_wait_for_a_reply(Plan9FSMessage&);
+    // Sends all of the messages before waiting for any reply, so that the remote can work on them at the same time.
+    // Returns how many of the messages, counting from the first one, got a successful reply.
+    ErrorOr<size_t> post_messages_and_wait_for_replies(Span<NonnullOwnPtr<Plan9FSMessage>>);
     ErrorOr<void> post_message_and_explicitly_ignore_reply(Plan9FSMessage&);
 
     ProtocolVersion parse_protocol_version(StringView) const;
@@ -130,7 +134,9 @@ private:
     Atomic<u32> m_next_fid { 1 };
 
     ProtocolVersion m_remote_protocol_version { ProtocolVersion::v9P2000 };
-    size_t m_max_message_size { 4 * KiB };
+    // What we ask for when negotiating the message size; the remote may pick something smaller.
+    static constexpr size_t preferred_max_message_size = 128 * KiB;
+    size_t m_max_message_size { preferred_max_message_size };
 
     Mutex m_send_lock { "Plan9FS send"sv };
     Plan9FSBlockerSet m_completion_blocker;
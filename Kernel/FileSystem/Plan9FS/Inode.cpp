@@ -68,32 +68,53 @@ ErrorOr<size_t> Plan9FSInode::read_bytes_locked(off_t offset, size_t size, UserO
 {
     TRY(const_cast<Plan9FSInode&>(*this).ensure_open_for_mode(O_RDONLY));
 
-    size = fs().adjust_buffer_size(size);
-
-    Plan9FSMessage message { fs(), Plan9FSMessage::Type::Treadlink };
-    StringView data;
-
     // Try readlink first.
-    bool readlink_succeeded = false;
     if (fs().m_remote_protocol_version >= Plan9FS::ProtocolVersion::v9P2000L && offset == 0) {
+        Plan9FSMessage message { fs(), Plan9FSMessage::Type::Treadlink };
         message << fid();
         if (auto result = fs().post_message_and_wait_for_a_reply(message); !result.is_error()) {
-            readlink_succeeded = true;
+            StringView data;
             message >> data;
+            size_t nread = min(data.length(), fs().adjust_buffer_size(size));
+            TRY(buffer.write(data.characters_without_null_termination(), nread));
+            return nread;
         }
     }
 
-    if (!readlink_succeeded) {
-        message = Plan9FSMessage { fs(), Plan9FSMessage::Type::Tread };
-        message << fid() << (u64)offset << (u32)size;
-        TRY(fs().post_message_and_wait_for_a_reply(message));
-        data = message.read_data();
-    }
+    // A read that doesn't fit into a single message is split up, and the pieces are requested all at once,
+    // instead of waiting for a full round trip to the remote for each of them.
+    size_t chunk_size = fs().adjust_buffer_size(size);
+    size_t total_nread = 0;
+    while (total_nread < size) {
+        Vector<NonnullOwnPtr<Plan9FSMessage>, max_reads_in_flight> messages;
+        for (size_t requested = total_nread; requested < size && messages.size() < max_reads_in_flight; requested += chunk_size) {
+            auto message = TRY(adopt_nonnull_own_or_enomem(new (nothrow) Plan9FSMessage { fs(), Plan9FSMessage::Type::Tread }));
+            *message << fid() << (u64)(offset + requested) << (u32)min(chunk_size, size - requested);
+            messages.unchecked_append(move(message));
+        }
 
-    // Guard against the server returning more data than requested.
-    size_t nread = min(data.length(), size);
-    TRY(buffer.write(data.characters_without_null_termination(), nread));
-    return nread;
+        auto replies_or_error = fs().post_messages_and_wait_for_replies(messages.span());
+        if (replies_or_error.is_error()) {
+            if (total_nread > 0)
+                break;
+            return replies_or_error.release_error();
+        }
+
+        for (size_t i = 0; i < replies_or_error.value(); ++i) {
+            size_t requested = min(chunk_size, size - total_nread);
+            auto data = messages[i]->read_data();
+            // Guard against the server returning more data than requested.
+            size_t nread = min(data.length(), requested);
+            TRY(buffer.write(data.characters_without_null_termination(), total_nread, nread));
+            total_nread += nread;
+            // A short read means we've reached the end of the file, so there's no point in looking at the rest.
+            if (nread < requested)
+                return total_nread;
+        }
+        if (replies_or_error.value() < messages.size())
+            break;
+    }
+    return total_nread;
 }
 
 ErrorOr<void> Plan9FSInode::replace_child(StringView, Inode&)
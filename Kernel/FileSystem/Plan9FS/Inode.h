@@ -76,6 +76,9 @@ private:
         MTimeSet = 0x100
     };
 
+    // How many Tread messages a single read may have outstanding at once.
+    static constexpr size_t max_reads_in_flight = 8;
+
     // Mode in which the file is already open, using SerenityOS constants.
     int m_open_mode { 0 };
     ErrorOr<void> ensure_open_for_mode(int mode);
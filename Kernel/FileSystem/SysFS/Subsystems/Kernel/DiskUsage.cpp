@@ -5,6 +5,7 @@
  */
 
 #include <AK/JsonObjectSerializer.h>
+#include <Kernel/FileSystem/BlockBasedFileSystem.h>
 #include <Kernel/FileSystem/FileBackedFileSystem.h>
 #include <Kernel/FileSystem/SysFS/Subsystems/Kernel/DiskUsage.h>
 #include <Kernel/FileSystem/VirtualFileSystem.h>
@@ -46,6 +47,16 @@ ErrorOr<void> SysFSDiskUsage::try_generate(KBufferBuilder& builder)
             TRY(fs_object.add("source"sv, "none"));
         }
 
+        if (fs.is_block_based()) {
+            if (auto statistics = static_cast<BlockBasedFileSystem const&>(fs).disk_cache_statistics(); statistics.has_value()) {
+                TRY(fs_object.add("cache_hits"sv, statistics->hits));
+                TRY(fs_object.add("cache_misses"sv, statistics->misses));
+                TRY(fs_object.add("cache_evictions"sv, statistics->evictions));
+                TRY(fs_object.add("cache_entry_count"sv, statistics->entry_count));
+                TRY(fs_object.add("cache_maximum_entry_count"sv, statistics->maximum_entry_count));
+            }
+        }
+
         TRY(fs_object.finish());
         return {};
     }));
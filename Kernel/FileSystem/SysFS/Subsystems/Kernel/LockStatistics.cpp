@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonObjectSerializer.h>
+#include <Kernel/FileSystem/SysFS/Subsystems/Kernel/LockStatistics.h>
+#include <Kernel/Locking/LockStatistics.h>
+#include <Kernel/Sections.h>
+
+namespace Kernel {
+
+UNMAP_AFTER_INIT SysFSLockStatistics::SysFSLockStatistics(SysFSDirectory const& parent_directory)
+    : SysFSGlobalInformation(parent_directory)
+{
+}
+
+UNMAP_AFTER_INIT NonnullLockRefPtr<SysFSLockStatistics> SysFSLockStatistics::must_create(SysFSDirectory const& parent_directory)
+{
+    return adopt_lock_ref_if_nonnull(new (nothrow) SysFSLockStatistics(parent_directory)).release_nonnull();
+}
+
+ErrorOr<void> SysFSLockStatistics::try_generate(KBufferBuilder& builder)
+{
+    auto array = TRY(JsonArraySerializer<>::try_create(builder));
+    TRY(for_each_lock_statistics([&](LockStatistics const& statistics) -> ErrorOr<void> {
+        auto obj = TRY(array.add_object());
+        TRY(obj.add("name"sv, statistics.name));
+        TRY(obj.add("acquisitions"sv, statistics.acquisitions));
+        TRY(obj.add("contended_acquisitions"sv, statistics.contended_acquisitions));
+        TRY(obj.add("total_wait_ns"sv, statistics.total_wait_ns));
+        TRY(obj.add("max_wait_ns"sv, statistics.max_wait_ns));
+        TRY(obj.add("total_hold_ns"sv, statistics.total_hold_ns));
+        TRY(obj.add("max_hold_ns"sv, statistics.max_hold_ns));
+        TRY(obj.finish());
+        return {};
+    }));
+    TRY(array.finish());
+    return {};
+}
+
+}
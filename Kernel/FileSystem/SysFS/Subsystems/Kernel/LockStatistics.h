@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+#include <Kernel/FileSystem/SysFS/Subsystems/Kernel/GlobalInformation.h>
+#include <Kernel/KBufferBuilder.h>
+#include <Kernel/Library/LockRefPtr.h>
+#include <Kernel/UserOrKernelBuffer.h>
+
+namespace Kernel {
+
+class SysFSLockStatistics final : public SysFSGlobalInformation {
+public:
+    virtual StringView name() const override { return "lock_statistics"sv; }
+    static NonnullLockRefPtr<SysFSLockStatistics> must_create(SysFSDirectory const& parent_directory);
+
+private:
+    explicit SysFSLockStatistics(SysFSDirectory const& parent_directory);
+    virtual ErrorOr<void> try_generate(KBufferBuilder& builder) override;
+};
+
+}
@@ -37,6 +37,10 @@ ErrorOr<void> SysFSMemoryStatus::try_generate(KBufferBuilder& builder)
     TRY(json.add("physical_uncommitted"sv, system_memory.physical_pages_uncommitted));
     TRY(json.add("kmalloc_call_count"sv, stats.kmalloc_call_count));
     TRY(json.add("kfree_call_count"sv, stats.kfree_call_count));
+    TRY(json.add("kmalloc_magazine_hit_count"sv, stats.magazine_hit_count));
+    TRY(json.add("kmalloc_magazine_refill_count"sv, stats.magazine_refill_count));
+    TRY(json.add("kmalloc_magazine_flush_count"sv, stats.magazine_flush_count));
+    TRY(json.add("kmalloc_magazine_bytes"sv, stats.bytes_in_magazines));
     TRY(json.finish());
     return {};
 }
@@ -6,6 +6,7 @@
 
 #include <AK/JsonObjectSerializer.h>
 #include <AK/Try.h>
+#include <Kernel/API/ProcessStatistics.h>
 #include <Kernel/FileSystem/SysFS/Subsystems/Kernel/Processes.h>
 #include <Kernel/Process.h>
 #include <Kernel/Scheduler.h>
@@ -14,6 +15,63 @@
 
 namespace Kernel {
 
+struct ProcessMemoryUsage {
+    size_t amount_virtual { 0 };
+    size_t amount_resident { 0 };
+    size_t amount_dirty_private { 0 };
+    size_t amount_clean_inode { 0 };
+    size_t amount_shared { 0 };
+    size_t amount_purgeable_volatile { 0 };
+    size_t amount_purgeable_nonvolatile { 0 };
+};
+
+static ErrorOr<ProcessMemoryUsage> memory_usage_of(Process const& process)
+{
+    return process.address_space().with([&](auto& space) -> ErrorOr<ProcessMemoryUsage> {
+        ProcessMemoryUsage usage;
+        usage.amount_virtual = space->amount_virtual();
+        usage.amount_resident = space->amount_resident();
+        usage.amount_dirty_private = space->amount_dirty_private();
+        usage.amount_clean_inode = TRY(space->amount_clean_inode());
+        usage.amount_shared = space->amount_shared();
+        usage.amount_purgeable_volatile = space->amount_purgeable_volatile();
+        usage.amount_purgeable_nonvolatile = space->amount_purgeable_nonvolatile();
+        return usage;
+    });
+}
+
+static ErrorOr<void> build_pledge_string(StringBuilder& builder, Process const& process)
+{
+    if (!process.is_user_process())
+        return {};
+
+#define __ENUMERATE_PLEDGE_PROMISE(promise)    \
+    if (process.has_promised(Pledge::promise)) \
+        TRY(builder.try_append(#promise " "sv));
+    ENUMERATE_PLEDGE_PROMISES
+#undef __ENUMERATE_PLEDGE_PROMISE
+    return {};
+}
+
+static StringView veil_string(Process const& process)
+{
+    if (!process.is_user_process())
+        return ""sv;
+
+    switch (process.veil_state()) {
+    case VeilState::None:
+        return "None"sv;
+    case VeilState::Dropped:
+        return "Dropped"sv;
+    case VeilState::Locked:
+    case VeilState::LockedInherited:
+        // Note: We don't reveal if the locked state is either by our choice
+        // or someone else applied it.
+        return "Locked"sv;
+    }
+    VERIFY_NOT_REACHED();
+}
+
 UNMAP_AFTER_INIT SysFSOverallProcesses::SysFSOverallProcesses(SysFSDirectory const& parent_directory)
     : SysFSGlobalInformation(parent_directory)
 {
@@ -28,41 +86,14 @@ ErrorOr<void> SysFSOverallProcesses::try_generate(KBufferBuilder& builder)
 {
     auto json = TRY(JsonObjectSerializer<>::try_create(builder));
 
-    // Keep this in sync with CProcessStatistics.
+    // Keep this in sync with CProcessStatistics and SysFSOverallProcessesBinary.
     auto build_process = [&](JsonArraySerializer<KBufferBuilder>& array, Process const& process) -> ErrorOr<void> {
         auto process_object = TRY(array.add_object());
 
-        if (process.is_user_process()) {
-            StringBuilder pledge_builder;
-
-#define __ENUMERATE_PLEDGE_PROMISE(promise)    \
-    if (process.has_promised(Pledge::promise)) \
-        TRY(pledge_builder.try_append(#promise " "sv));
-            ENUMERATE_PLEDGE_PROMISES
-#undef __ENUMERATE_PLEDGE_PROMISE
-
-            TRY(process_object.add("pledge"sv, pledge_builder.string_view()));
-
-            switch (process.veil_state()) {
-            case VeilState::None:
-                TRY(process_object.add("veil"sv, "None"));
-                break;
-            case VeilState::Dropped:
-                TRY(process_object.add("veil"sv, "Dropped"));
-                break;
-            case VeilState::Locked:
-                TRY(process_object.add("veil"sv, "Locked"));
-                break;
-            case VeilState::LockedInherited:
-                // Note: We don't reveal if the locked state is either by our choice
-                // or someone else applied it.
-                TRY(process_object.add("veil"sv, "Locked"));
-                break;
-            }
-        } else {
-            TRY(process_object.add("pledge"sv, ""sv));
-            TRY(process_object.add("veil"sv, ""sv));
-        }
+        StringBuilder pledge_builder;
+        TRY(build_pledge_string(pledge_builder, process));
+        TRY(process_object.add("pledge"sv, pledge_builder.string_view()));
+        TRY(process_object.add("veil"sv, veil_string(process)));
 
         TRY(process_object.add("pid"sv, process.pid().value()));
         TRY(process_object.add("pgid"sv, process.tty() ? process.tty()->pgid().value() : 0));
@@ -82,32 +113,14 @@ ErrorOr<void> SysFSOverallProcesses::try_generate(KBufferBuilder& builder)
         TRY(process.name().with([&](auto& process_name) { return process_object.add("name"sv, process_name->view()); }));
         TRY(process_object.add("executable"sv, process.executable() ? TRY(process.executable()->try_serialize_absolute_path())->view() : ""sv));
 
-        size_t amount_virtual = 0;
-        size_t amount_resident = 0;
-        size_t amount_dirty_private = 0;
-        size_t amount_clean_inode = 0;
-        size_t amount_shared = 0;
-        size_t amount_purgeable_volatile = 0;
-        size_t amount_purgeable_nonvolatile = 0;
-
-        TRY(process.address_space().with([&](auto& space) -> ErrorOr<void> {
-            amount_virtual = space->amount_virtual();
-            amount_resident = space->amount_resident();
-            amount_dirty_private = space->amount_dirty_private();
-            amount_clean_inode = TRY(space->amount_clean_inode());
-            amount_shared = space->amount_shared();
-            amount_purgeable_volatile = space->amount_purgeable_volatile();
-            amount_purgeable_nonvolatile = space->amount_purgeable_nonvolatile();
-            return {};
-        }));
-
-        TRY(process_object.add("amount_virtual"sv, amount_virtual));
-        TRY(process_object.add("amount_resident"sv, amount_resident));
-        TRY(process_object.add("amount_dirty_private"sv, amount_dirty_private));
-        TRY(process_object.add("amount_clean_inode"sv, amount_clean_inode));
-        TRY(process_object.add("amount_shared"sv, amount_shared));
-        TRY(process_object.add("amount_purgeable_volatile"sv, amount_purgeable_volatile));
-        TRY(process_object.add("amount_purgeable_nonvolatile"sv, amount_purgeable_nonvolatile));
+        auto memory_usage = TRY(memory_usage_of(process));
+        TRY(process_object.add("amount_virtual"sv, memory_usage.amount_virtual));
+        TRY(process_object.add("amount_resident"sv, memory_usage.amount_resident));
+        TRY(process_object.add("amount_dirty_private"sv, memory_usage.amount_dirty_private));
+        TRY(process_object.add("amount_clean_inode"sv, memory_usage.amount_clean_inode));
+        TRY(process_object.add("amount_shared"sv, memory_usage.amount_shared));
+        TRY(process_object.add("amount_purgeable_volatile"sv, memory_usage.amount_purgeable_volatile));
+        TRY(process_object.add("amount_purgeable_nonvolatile"sv, memory_usage.amount_purgeable_nonvolatile));
         TRY(process_object.add("dumpable"sv, process.is_dumpable()));
         TRY(process_object.add("kernel"sv, process.is_kernel_process()));
         auto thread_array = TRY(process_object.add_array("threads"sv));
@@ -162,4 +175,144 @@ ErrorOr<void> SysFSOverallProcesses::try_generate(KBufferBuilder& builder)
     return {};
 }
 
+UNMAP_AFTER_INIT SysFSOverallProcessesBinary::SysFSOverallProcessesBinary(SysFSDirectory const& parent_directory)
+    : SysFSGlobalInformation(parent_directory)
+{
+}
+
+UNMAP_AFTER_INIT NonnullLockRefPtr<SysFSOverallProcessesBinary> SysFSOverallProcessesBinary::must_create(SysFSDirectory const& parent_directory)
+{
+    return adopt_lock_ref_if_nonnull(new (nothrow) SysFSOverallProcessesBinary(parent_directory)).release_nonnull();
+}
+
+template<typename T>
+static ErrorOr<void> append_record(KBufferBuilder& builder, T const& record)
+{
+    return builder.append_bytes({ &record, sizeof(record) });
+}
+
+static u16 clamped_string_length(StringView string)
+{
+    return min(string.length(), static_cast<size_t>(NumericLimits<u16>::max()));
+}
+
+static ErrorOr<void> append_string(KBufferBuilder& builder, StringView string)
+{
+    return builder.append_bytes(string.bytes().trim(clamped_string_length(string)));
+}
+
+ErrorOr<void> SysFSOverallProcessesBinary::try_generate(KBufferBuilder& builder)
+{
+    auto build_process = [&](Process const& process) -> ErrorOr<void> {
+        StringBuilder pledge_builder;
+        TRY(build_pledge_string(pledge_builder, process));
+        auto veil = veil_string(process);
+        OwnPtr<KString> tty_name;
+        if (process.tty())
+            tty_name = TRY(process.tty()->pseudo_name());
+        auto tty = tty_name ? tty_name->view() : ""sv;
+        OwnPtr<KString> executable_path;
+        if (process.executable())
+            executable_path = TRY(process.executable()->try_serialize_absolute_path());
+        auto executable = executable_path ? executable_path->view() : ""sv;
+        auto name = TRY(process.name().with([](auto& process_name) { return process_name->try_clone(); }));
+        auto memory_usage = TRY(memory_usage_of(process));
+        auto credentials = process.credentials();
+
+        // Threads can come and go while we're building the records, so the thread count is filled in afterwards.
+        ProcessStatisticsRecord record {};
+        record.pid = process.pid().value();
+        record.pgid = process.tty() ? process.tty()->pgid().value() : 0;
+        record.pgp = process.pgid().value();
+        record.sid = process.sid().value();
+        record.uid = credentials->uid().value();
+        record.gid = credentials->gid().value();
+        record.ppid = process.ppid().value();
+        record.nfds = process.fds().with_shared([](auto& fds) { return fds.open_count(); });
+        record.amount_virtual = memory_usage.amount_virtual;
+        record.amount_resident = memory_usage.amount_resident;
+        record.amount_dirty_private = memory_usage.amount_dirty_private;
+        record.amount_clean_inode = memory_usage.amount_clean_inode;
+        record.amount_shared = memory_usage.amount_shared;
+        record.amount_purgeable_volatile = memory_usage.amount_purgeable_volatile;
+        record.amount_purgeable_nonvolatile = memory_usage.amount_purgeable_nonvolatile;
+        record.kernel = process.is_kernel_process();
+        record.dumpable = process.is_dumpable();
+        record.name_length = clamped_string_length(name->view());
+        record.executable_length = clamped_string_length(executable);
+        record.tty_length = clamped_string_length(tty);
+        record.pledge_length = clamped_string_length(pledge_builder.string_view());
+        record.veil_length = clamped_string_length(veil);
+
+        auto record_offset = builder.length();
+        TRY(append_record(builder, record));
+        TRY(append_string(builder, name->view()));
+        TRY(append_string(builder, executable));
+        TRY(append_string(builder, tty));
+        TRY(append_string(builder, pledge_builder.string_view()));
+        TRY(append_string(builder, veil));
+
+        u32 thread_count = 0;
+        TRY(process.try_for_each_thread([&](Thread const& thread) -> ErrorOr<void> {
+            SpinlockLocker locker(thread.get_lock());
+            auto thread_name = TRY(thread.name().with([](auto& thread_name) { return thread_name->try_clone(); }));
+            auto state = thread.state_string();
+
+            ThreadStatisticsRecord thread_record {};
+            thread_record.tid = thread.tid().value();
+            thread_record.times_scheduled = thread.times_scheduled();
+            thread_record.time_user = thread.time_in_user();
+            thread_record.time_kernel = thread.time_in_kernel();
+            thread_record.cpu = thread.cpu();
+            thread_record.priority = thread.priority();
+            thread_record.syscall_count = thread.syscall_count();
+            thread_record.inode_faults = thread.inode_faults();
+            thread_record.zero_faults = thread.zero_faults();
+            thread_record.cow_faults = thread.cow_faults();
+            thread_record.file_read_bytes = thread.file_read_bytes();
+            thread_record.file_write_bytes = thread.file_write_bytes();
+            thread_record.unix_socket_read_bytes = thread.unix_socket_read_bytes();
+            thread_record.unix_socket_write_bytes = thread.unix_socket_write_bytes();
+            thread_record.ipv4_socket_read_bytes = thread.ipv4_socket_read_bytes();
+            thread_record.ipv4_socket_write_bytes = thread.ipv4_socket_write_bytes();
+            thread_record.name_length = clamped_string_length(thread_name->view());
+            thread_record.state_length = clamped_string_length(state);
+
+            TRY(append_record(builder, thread_record));
+            TRY(append_string(builder, thread_name->view()));
+            TRY(append_string(builder, state));
+            ++thread_count;
+            return {};
+        }));
+
+        record.thread_count = thread_count;
+        builder.overwrite_bytes(record_offset, { &record, sizeof(record) });
+        return {};
+    };
+
+    auto header_offset = builder.length();
+    ProcessStatisticsHeader header {};
+    header.magic = process_statistics_magic;
+    header.version = process_statistics_version;
+    header.header_size = sizeof(ProcessStatisticsHeader);
+    header.process_record_size = sizeof(ProcessStatisticsRecord);
+    header.thread_record_size = sizeof(ThreadStatisticsRecord);
+    TRY(append_record(builder, header));
+
+    // FIXME: Do we actually want to expose the colonel process in a Jail environment?
+    TRY(build_process(*Scheduler::colonel()));
+    ++header.process_count;
+    TRY(Process::for_each_in_same_jail([&](Process& process) -> ErrorOr<void> {
+        TRY(build_process(process));
+        ++header.process_count;
+        return {};
+    }));
+
+    auto total_time_scheduled = Scheduler::get_total_time_scheduled();
+    header.total_time = total_time_scheduled.total;
+    header.total_time_kernel = total_time_scheduled.total_kernel;
+    builder.overwrite_bytes(header_offset, { &header, sizeof(header) });
+    return {};
+}
+
 }
@@ -27,4 +27,17 @@ private:
     virtual bool is_readable_by_jailed_processes() const override { return true; }
 };
 
+class SysFSOverallProcessesBinary final : public SysFSGlobalInformation {
+public:
+    virtual StringView name() const override { return "processes_binary"sv; }
+
+    static NonnullLockRefPtr<SysFSOverallProcessesBinary> must_create(SysFSDirectory const& parent_directory);
+
+private:
+    explicit SysFSOverallProcessesBinary(SysFSDirectory const& parent_directory);
+    virtual ErrorOr<void> try_generate(KBufferBuilder& builder) override;
+
+    virtual bool is_readable_by_jailed_processes() const override { return true; }
+};
+
 }
@@ -6,6 +6,7 @@
 
 #include <Kernel/FileSystem/SysFS/Subsystems/Kernel/Profile.h>
 #include <Kernel/PerformanceEventBuffer.h>
+#include <Kernel/PerformanceEventRing.h>
 #include <Kernel/Sections.h>
 
 namespace Kernel {
@@ -24,6 +25,7 @@ ErrorOr<void> SysFSProfile::try_generate(KBufferBuilder& builder)
 {
     if (!g_global_perf_events)
         return ENOENT;
+    PerformanceEventRings::drain_into_global_buffer_unless_streaming();
     TRY(g_global_perf_events->to_json(builder));
     return {};
 }
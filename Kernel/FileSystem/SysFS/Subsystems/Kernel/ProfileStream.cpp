@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/FileSystem/SysFS/Subsystems/Kernel/ProfileStream.h>
+#include <Kernel/PerformanceEventRing.h>
+#include <Kernel/Process.h>
+#include <Kernel/Sections.h>
+
+namespace Kernel {
+
+UNMAP_AFTER_INIT SysFSProfileStream::SysFSProfileStream(SysFSDirectory const& parent_directory)
+    : SysFSComponent(parent_directory)
+{
+}
+
+UNMAP_AFTER_INIT NonnullLockRefPtr<SysFSProfileStream> SysFSProfileStream::must_create(SysFSDirectory const& parent_directory)
+{
+    return adopt_lock_ref_if_nonnull(new (nothrow) SysFSProfileStream(parent_directory)).release_nonnull();
+}
+
+ErrorOr<size_t> SysFSProfileStream::read_bytes(off_t, size_t count, UserOrKernelBuffer& buffer, OpenFileDescription*) const
+{
+    bool show_kernel_addresses = Process::current().credentials()->is_superuser();
+    for (;;) {
+        auto nread = TRY(PerformanceEventRings::stream_into(buffer, count, show_kernel_addresses));
+        if (nread > 0)
+            return nread;
+        if (!g_profiling_all_threads)
+            return 0;
+        if (Thread::current()->sleep(Time::from_milliseconds(50)).was_interrupted())
+            return EINTR;
+    }
+}
+
+mode_t SysFSProfileStream::permissions() const
+{
+    return S_IRUSR;
+}
+
+}
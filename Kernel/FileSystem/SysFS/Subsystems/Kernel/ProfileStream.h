@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+#include <Kernel/FileSystem/SysFS/Component.h>
+#include <Kernel/Library/LockRefPtr.h>
+#include <Kernel/UserOrKernelBuffer.h>
+
+namespace Kernel {
+
+// Streams the CPU samples of a system-wide profile as they are collected, one
+// JSON event per line. Reads block until samples are available, and return 0
+// once profiling has been disabled and everything has been read.
+class SysFSProfileStream final : public SysFSComponent {
+public:
+    virtual StringView name() const override { return "profile_stream"sv; }
+    static NonnullLockRefPtr<SysFSProfileStream> must_create(SysFSDirectory const&);
+
+    virtual ErrorOr<size_t> read_bytes(off_t, size_t, UserOrKernelBuffer&, OpenFileDescription*) const override;
+    virtual mode_t permissions() const override;
+
+private:
+    explicit SysFSProfileStream(SysFSDirectory const&);
+};
+
+}
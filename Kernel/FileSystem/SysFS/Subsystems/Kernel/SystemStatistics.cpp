@@ -6,6 +6,7 @@
 
 #include <AK/JsonObjectSerializer.h>
 #include <Kernel/FileSystem/SysFS/Subsystems/Kernel/SystemStatistics.h>
+#include <Kernel/Locking/Mutex.h>
 #include <Kernel/Scheduler.h>
 #include <Kernel/Sections.h>
 #include <Kernel/Time/TimeManagement.h>
@@ -34,6 +35,18 @@ ErrorOr<void> SysFSSystemStatistics::try_generate(KBufferBuilder& builder)
         idle_time += processor.time_spent_idle();
     });
     TRY(json.add("idle_time"sv, idle_time));
+    {
+        auto mutex_contention = TRY(json.add_array("mutex_contention"sv));
+        for (auto const& statistics : Mutex::contention_statistics()) {
+            auto entry = TRY(mutex_contention.add_object());
+            TRY(entry.add("rank"sv, Mutex::rank_to_string(statistics.rank)));
+            TRY(entry.add("contended"sv, statistics.contended_count));
+            TRY(entry.add("acquired_after_spinning"sv, statistics.acquired_after_spinning_count));
+            TRY(entry.add("blocked"sv, statistics.blocked_count));
+            TRY(entry.finish());
+        }
+        TRY(mutex_contention.finish());
+    }
     TRY(json.finish());
     return {};
 }
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/FileSystem/SysFS/Subsystems/Kernel/Variables/LockStatistics.h>
+#include <Kernel/Locking/LockStatistics.h>
+#include <Kernel/Sections.h>
+
+namespace Kernel {
+
+UNMAP_AFTER_INIT SysFSCollectLockStatistics::SysFSCollectLockStatistics(SysFSDirectory const& parent_directory)
+    : SysFSSystemBooleanVariable(parent_directory)
+{
+}
+
+UNMAP_AFTER_INIT NonnullLockRefPtr<SysFSCollectLockStatistics> SysFSCollectLockStatistics::must_create(SysFSDirectory const& parent_directory)
+{
+    return adopt_lock_ref_if_nonnull(new (nothrow) SysFSCollectLockStatistics(parent_directory)).release_nonnull();
+}
+
+bool SysFSCollectLockStatistics::value() const
+{
+    return g_collect_lock_statistics.load();
+}
+
+void SysFSCollectLockStatistics::set_value(bool new_value)
+{
+    g_collect_lock_statistics.store(new_value);
+}
+
+}
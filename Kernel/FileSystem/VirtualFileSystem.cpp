@@ -27,6 +27,7 @@ namespace Kernel {
 
 static Singleton<VirtualFileSystem> s_the;
 static constexpr int root_mount_flags = 0;
+static constexpr size_t lookup_cache_max_entries = 4096;
 
 UNMAP_AFTER_INIT void VirtualFileSystem::initialize()
 {
@@ -62,7 +63,7 @@ bool VirtualFileSystem::mount_point_exists_at_inode(InodeIdentifier inode_identi
 ErrorOr<void> VirtualFileSystem::mount(FileSystem& fs, Custody& mount_point, int flags)
 {
     auto new_mount = TRY(adopt_nonnull_own_or_enomem(new (nothrow) Mount(fs, &mount_point, flags)));
-    return m_mounts.with([&](auto& mounts) -> ErrorOr<void> {
+    TRY(m_mounts.with([&](auto& mounts) -> ErrorOr<void> {
         auto& inode = mount_point.inode();
         dbgln("VirtualFileSystem: FileSystemID {}, Mounting {} at inode {} with flags {}",
             fs.fsid(),
@@ -99,13 +100,15 @@ ErrorOr<void> VirtualFileSystem::mount(FileSystem& fs, Custody& mount_point, int
         // deleted after being added.
         mounts.append(*new_mount.leak_ptr());
         return {};
-    });
+    }));
+    clear_lookup_cache();
+    return {};
 }
 
 ErrorOr<void> VirtualFileSystem::bind_mount(Custody& source, Custody& mount_point, int flags)
 {
     auto new_mount = TRY(adopt_nonnull_own_or_enomem(new (nothrow) Mount(source.inode(), mount_point, flags)));
-    return m_mounts.with([&](auto& mounts) -> ErrorOr<void> {
+    TRY(m_mounts.with([&](auto& mounts) -> ErrorOr<void> {
         auto& inode = mount_point.inode();
         dbgln("VirtualFileSystem: Bind-mounting inode {} at inode {}", source.inode().identifier(), inode.identifier());
         if (mount_point_exists_at_inode(inode.identifier())) {
@@ -118,7 +121,9 @@ ErrorOr<void> VirtualFileSystem::bind_mount(Custody& source, Custody& mount_poin
         // deleted after being added.
         mounts.append(*new_mount.leak_ptr());
         return {};
-    });
+    }));
+    clear_lookup_cache();
+    return {};
 }
 
 ErrorOr<void> VirtualFileSystem::remount(Custody& mount_point, int new_flags)
@@ -130,6 +135,8 @@ ErrorOr<void> VirtualFileSystem::remount(Custody& mount_point, int new_flags)
         return ENODEV;
 
     mount->set_flags(new_flags);
+    // Cached custodies carry the mount flags they were created with.
+    clear_lookup_cache();
     return {};
 }
 
@@ -145,6 +152,23 @@ void VirtualFileSystem::sync_filesystems()
         fs.flush_writes();
 }
 
+size_t VirtualFileSystem::purge_filesystem_caches()
+{
+    NonnullLockRefPtrVector<FileSystem, 32> file_systems;
+    m_file_systems_list.with([&](auto const& list) {
+        for (auto& fs : list)
+            file_systems.append(fs);
+    });
+
+    // Cached lookups keep their inodes alive, which would stop the file systems from purging them.
+    clear_lookup_cache();
+
+    size_t released_bytes = 0;
+    for (auto& fs : file_systems)
+        released_bytes += fs.purge_clean_caches();
+    return released_bytes;
+}
+
 void VirtualFileSystem::lock_all_filesystems()
 {
     NonnullLockRefPtrVector<FileSystem, 32> file_systems;
@@ -163,7 +187,10 @@ ErrorOr<void> VirtualFileSystem::unmount(Custody& mountpoint_custody)
     auto custody_path = TRY(mountpoint_custody.try_serialize_absolute_path());
     dbgln("VirtualFileSystem: unmount called with inode {} on mountpoint {}", guest_inode.identifier(), custody_path->view());
 
-    return m_mounts.with([&](auto& mounts) -> ErrorOr<void> {
+    // Cached lookups keep inodes of the file system alive, which would make it look busy.
+    clear_lookup_cache();
+
+    TRY(m_mounts.with([&](auto& mounts) -> ErrorOr<void> {
         for (auto& mount : mounts) {
             if (&mount.guest() != &guest_inode)
                 continue;
@@ -198,7 +225,9 @@ ErrorOr<void> VirtualFileSystem::unmount(Custody& mountpoint_custody)
         }
         dbgln("VirtualFileSystem: Nothing mounted on inode {}", guest_inode.identifier());
         return ENODEV;
-    });
+    }));
+    clear_lookup_cache();
+    return {};
 }
 
 ErrorOr<void> VirtualFileSystem::mount_root(FileSystem& fs)
@@ -1093,7 +1122,7 @@ ErrorOr<NonnullRefPtr<Custody>> VirtualFileSystem::resolve_path_without_veil(Cre
         }
 
         // Okay, let's look up this part.
-        auto child_or_error = parent.inode().lookup(part);
+        auto child_or_error = lookup_child_custody(parent, part);
         if (child_or_error.is_error()) {
             if (out_parent) {
                 // ENOENT with a non-null parent custody signals to caller that
@@ -1103,20 +1132,10 @@ ErrorOr<NonnullRefPtr<Custody>> VirtualFileSystem::resolve_path_without_veil(Cre
             }
             return child_or_error.release_error();
         }
-        auto child_inode = child_or_error.release_value();
-
-        int mount_flags_for_child = parent.mount_flags();
-
-        // See if there's something mounted on the child; in that case
-        // we would need to return the guest inode, not the host inode.
-        if (auto mount = find_mount_for_host(child_inode->identifier())) {
-            child_inode = mount->guest();
-            mount_flags_for_child = mount->flags();
-        }
+        custody = child_or_error.release_value();
+        auto& child_inode = custody->inode();
 
-        custody = TRY(Custody::try_create(&parent, part, *child_inode, mount_flags_for_child));
-
-        if (child_inode->metadata().is_symlink()) {
+        if (child_inode.metadata().is_symlink()) {
             if (!have_more_parts) {
                 if (options & O_NOFOLLOW)
                     return ELOOP;
@@ -1124,12 +1143,12 @@ ErrorOr<NonnullRefPtr<Custody>> VirtualFileSystem::resolve_path_without_veil(Cre
                     break;
             }
 
-            if (!safe_to_follow_symlink(credentials, *child_inode, parent_metadata))
+            if (!safe_to_follow_symlink(credentials, child_inode, parent_metadata))
                 return EACCES;
 
             TRY(validate_path_against_process_veil(*custody, options));
 
-            auto symlink_target = TRY(child_inode->resolve_as_link(credentials, parent, out_parent, options, symlink_recursion_level + 1));
+            auto symlink_target = TRY(child_inode.resolve_as_link(credentials, parent, out_parent, options, symlink_recursion_level + 1));
             if (!have_more_parts)
                 return symlink_target;
 
@@ -1148,4 +1167,99 @@ ErrorOr<NonnullRefPtr<Custody>> VirtualFileSystem::resolve_path_without_veil(Cre
         *out_parent = custody->parent();
     return custody;
 }
+
+ErrorOr<NonnullRefPtr<Custody>> VirtualFileSystem::lookup_child_custody(Custody& parent, StringView name)
+{
+    // We can only trust cached results for file systems that tell us when their directories change.
+    bool cacheable = parent.inode().fs().supports_watchers();
+
+    u64 generation = 0;
+    if (cacheable) {
+        auto cached_child = m_lookup_cache.with_exclusive([&](auto& cache) -> Optional<RefPtr<Custody>> {
+            generation = cache.generation;
+            auto it = cache.entries.find({ &parent, name });
+            if (it == cache.entries.end())
+                return {};
+            auto& entry = *it->value;
+            cache.lru_list.remove(entry);
+            cache.lru_list.append(entry);
+            return entry.child;
+        });
+        if (cached_child.has_value()) {
+            if (!cached_child.value())
+                return ENOENT;
+            return cached_child.release_value().release_nonnull();
+        }
+    }
+
+    auto add_to_cache = [&](RefPtr<Custody> child) {
+        auto name_string = KString::try_create(name);
+        if (name_string.is_error())
+            return;
+        auto new_entry = adopt_own_if_nonnull(new (nothrow) LookupCacheEntry { parent, name_string.release_value(), move(child), {} });
+        if (!new_entry)
+            return;
+        m_lookup_cache.with_exclusive([&](auto& cache) {
+            // Something about this directory changed while we were looking, so our result may be stale already.
+            if (cache.generation != generation)
+                return;
+            auto key = new_entry->key();
+            if (cache.entries.contains(key))
+                return;
+            if (cache.entries.size() >= lookup_cache_max_entries) {
+                auto& oldest_entry = *cache.lru_list.first();
+                cache.lru_list.remove(oldest_entry);
+                cache.entries.remove(oldest_entry.key());
+            }
+            auto& entry = *new_entry;
+            if (cache.entries.try_set(key, new_entry.release_nonnull()).is_error())
+                return;
+            cache.lru_list.append(entry);
+        });
+    };
+
+    auto child_or_error = parent.inode().lookup(name);
+    if (child_or_error.is_error()) {
+        if (cacheable && child_or_error.error().code() == ENOENT)
+            add_to_cache(nullptr);
+        return child_or_error.release_error();
+    }
+    auto child_inode = child_or_error.release_value();
+
+    int mount_flags_for_child = parent.mount_flags();
+
+    // See if there's something mounted on the child; in that case
+    // we would need to return the guest inode, not the host inode.
+    if (auto mount = find_mount_for_host(child_inode->identifier())) {
+        child_inode = mount->guest();
+        mount_flags_for_child = mount->flags();
+    }
+
+    auto custody = TRY(Custody::try_create(&parent, name, *child_inode, mount_flags_for_child));
+    if (cacheable)
+        add_to_cache(custody);
+    return custody;
+}
+
+void VirtualFileSystem::invalidate_cached_lookups(Inode const& directory, StringView name)
+{
+    m_lookup_cache.with_exclusive([&](auto& cache) {
+        ++cache.generation;
+        cache.entries.remove_all_matching([&](auto const& key, auto const& entry) {
+            if (key.name != name || &entry->parent->inode() != &directory)
+                return false;
+            cache.lru_list.remove(*entry);
+            return true;
+        });
+    });
+}
+
+void VirtualFileSystem::clear_lookup_cache()
+{
+    m_lookup_cache.with_exclusive([](auto& cache) {
+        ++cache.generation;
+        cache.lru_list.clear();
+        cache.entries.clear();
+    });
+}
 }
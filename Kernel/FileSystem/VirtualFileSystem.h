@@ -10,6 +10,7 @@
 #include <AK/Error.h>
 #include <AK/Function.h>
 #include <AK/HashMap.h>
+#include <AK/IntrusiveList.h>
 #include <AK/NonnullOwnPtrVector.h>
 #include <AK/OwnPtr.h>
 #include <AK/RefPtr.h>
@@ -20,7 +21,9 @@
 #include <Kernel/FileSystem/Mount.h>
 #include <Kernel/FileSystem/UnveilNode.h>
 #include <Kernel/Forward.h>
+#include <Kernel/KString.h>
 #include <Kernel/Library/LockRefPtr.h>
+#include <Kernel/Locking/MutexProtected.h>
 #include <Kernel/Locking/SpinlockProtected.h>
 
 namespace Kernel {
@@ -86,6 +89,7 @@ public:
     InodeIdentifier root_inode_id() const;
 
     void sync_filesystems();
+    size_t purge_filesystem_caches();
     void lock_all_filesystems();
 
     static void sync();
@@ -94,6 +98,9 @@ public:
     ErrorOr<NonnullRefPtr<Custody>> resolve_path(Credentials const&, StringView path, NonnullRefPtr<Custody> base, RefPtr<Custody>* out_parent = nullptr, int options = 0, int symlink_recursion_level = 0);
     ErrorOr<NonnullRefPtr<Custody>> resolve_path_without_veil(Credentials const&, StringView path, NonnullRefPtr<Custody> base, RefPtr<Custody>* out_parent = nullptr, int options = 0, int symlink_recursion_level = 0);
 
+    // Called whenever the entry called `name` in `directory` is added, removed or replaced.
+    void invalidate_cached_lookups(Inode const& directory, StringView name);
+
 private:
     friend class OpenFileDescription;
 
@@ -111,6 +118,43 @@ private:
     Mount* find_mount_for_host(InodeIdentifier);
     Mount* find_mount_for_guest(InodeIdentifier);
 
+    ErrorOr<NonnullRefPtr<Custody>> lookup_child_custody(Custody& parent, StringView name);
+    void clear_lookup_cache();
+
+    // Remembers the outcome of looking up a name in a directory, so that we don't have to ask the
+    // file system (and search the list of mounts, and build a new Custody) every time the same
+    // path is resolved. A null child means the name didn't exist.
+    struct LookupCacheKey {
+        Custody const* parent;
+        StringView name;
+
+        bool operator==(LookupCacheKey const&) const = default;
+    };
+
+    struct LookupCacheKeyTraits : public GenericTraits<LookupCacheKey> {
+        static unsigned hash(LookupCacheKey const& key) { return pair_int_hash(ptr_hash(key.parent), key.name.hash()); }
+        static bool equals(LookupCacheKey const& a, LookupCacheKey const& b) { return a == b; }
+    };
+
+    struct LookupCacheEntry {
+        NonnullRefPtr<Custody> parent;
+        NonnullOwnPtr<KString> name;
+        RefPtr<Custody> child;
+        IntrusiveListNode<LookupCacheEntry> lru_list_node;
+
+        LookupCacheKey key() const { return { parent.ptr(), name->view() }; }
+    };
+
+    struct LookupCache {
+        HashMap<LookupCacheKey, NonnullOwnPtr<LookupCacheEntry>, LookupCacheKeyTraits> entries;
+        IntrusiveList<&LookupCacheEntry::lru_list_node> lru_list;
+        // Bumped on every invalidation, so that a lookup racing with a directory change doesn't
+        // put a stale result into the cache.
+        u64 generation { 0 };
+    };
+
+    MutexProtected<LookupCache> m_lookup_cache;
+
     LockRefPtr<Inode> m_root_inode;
 
     SpinlockProtected<RefPtr<Custody>, LockRank::None> m_root_custody {};
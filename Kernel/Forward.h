@@ -25,12 +25,14 @@ class File;
 class FATInode;
 class OpenFileDescription;
 class DisplayConnector;
+class EPoll;
 class FileSystem;
 class FutexQueue;
 class IPv4Socket;
 class Inode;
 class InodeIdentifier;
 class InodeWatcher;
+class IORing;
 class Jail;
 class KBuffer;
 class KString;
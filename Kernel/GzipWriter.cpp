@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/GzipWriter.h>
+
+namespace Kernel {
+
+static constexpr size_t output_buffer_size = 64 * KiB;
+
+// Longest match deflate can express, and the smallest one worth emitting instead of literals.
+static constexpr size_t max_run_length = 258;
+static constexpr size_t min_run_length = 3;
+
+static constexpr u16 end_of_block_symbol = 256;
+static constexpr u16 first_length_symbol = 257;
+
+static constexpr Array<u16, 29> length_bases {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+
+static constexpr Array<u8, 29> length_extra_bits {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+
+ErrorOr<NonnullOwnPtr<GzipWriter>> GzipWriter::try_create(OpenFileDescription& description)
+{
+    auto output = TRY(KBuffer::try_create_with_size("GzipWriter: Output"sv, output_buffer_size));
+    auto writer = TRY(adopt_nonnull_own_or_enomem(new (nothrow) GzipWriter(description, move(output))));
+    TRY(writer->write_header());
+    return writer;
+}
+
+GzipWriter::GzipWriter(OpenFileDescription& description, NonnullOwnPtr<KBuffer> output)
+    : m_description(description)
+    , m_output(move(output))
+{
+}
+
+ErrorOr<void> GzipWriter::write_header()
+{
+    // ID1, ID2, CM (deflate), FLG, MTIME (4 bytes), XFL, OS (unknown)
+    static constexpr Array<u8, 10> header { 0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 255 };
+    for (auto byte : header)
+        TRY(append_byte(byte));
+
+    // BFINAL = 1, BTYPE = 01 (fixed Huffman codes)
+    TRY(write_bits(1, 1));
+    TRY(write_bits(1, 2));
+    return {};
+}
+
+ErrorOr<void> GzipWriter::write(ReadonlyBytes bytes)
+{
+    VERIFY(!m_finished);
+    m_crc32.update(bytes);
+    m_input_size += bytes.size();
+
+    for (auto byte : bytes) {
+        if (m_has_previous_byte && byte == m_previous_byte) {
+            if (++m_pending_run_length == max_run_length)
+                TRY(flush_pending_run());
+            continue;
+        }
+        TRY(flush_pending_run());
+        TRY(write_symbol(byte));
+        m_previous_byte = byte;
+        m_has_previous_byte = true;
+    }
+    return {};
+}
+
+ErrorOr<void> GzipWriter::finish()
+{
+    VERIFY(!m_finished);
+    TRY(flush_pending_run());
+    TRY(write_symbol(end_of_block_symbol));
+
+    // Pad the deflate stream to a byte boundary before the trailer.
+    if (m_bit_count > 0)
+        TRY(write_bits(0, 8 - m_bit_count));
+
+    u32 crc32 = m_crc32.digest();
+    for (size_t i = 0; i < 4; ++i)
+        TRY(append_byte(crc32 >> (i * 8)));
+    for (size_t i = 0; i < 4; ++i)
+        TRY(append_byte(m_input_size >> (i * 8)));
+
+    m_finished = true;
+    return flush_output();
+}
+
+ErrorOr<void> GzipWriter::flush_pending_run()
+{
+    if (m_pending_run_length >= min_run_length) {
+        TRY(write_run(m_pending_run_length));
+    } else {
+        for (size_t i = 0; i < m_pending_run_length; ++i)
+            TRY(write_symbol(m_previous_byte));
+    }
+    m_pending_run_length = 0;
+    return {};
+}
+
+ErrorOr<void> GzipWriter::write_run(size_t length)
+{
+    VERIFY(length >= min_run_length && length <= max_run_length);
+
+    size_t index = length_bases.size() - 1;
+    while (length_bases[index] > length)
+        --index;
+
+    TRY(write_symbol(first_length_symbol + index));
+    TRY(write_bits(length - length_bases[index], length_extra_bits[index]));
+
+    // Distance code 0 means "distance 1", i.e. repeat the previous byte. Fixed distance codes are 5 bits wide.
+    return write_huffman_code(0, 5);
+}
+
+ErrorOr<void> GzipWriter::write_symbol(u16 symbol)
+{
+    // The fixed literal/length code from RFC 1951, section 3.2.6.
+    if (symbol < 144)
+        return write_huffman_code(0x30 + symbol, 8);
+    if (symbol < 256)
+        return write_huffman_code(0x190 + (symbol - 144), 9);
+    if (symbol < 280)
+        return write_huffman_code(symbol - 256, 7);
+    return write_huffman_code(0xc0 + (symbol - 280), 8);
+}
+
+ErrorOr<void> GzipWriter::write_huffman_code(u16 code, u8 length)
+{
+    // Huffman codes are packed starting with their most significant bit, everything else starts with the least significant one.
+    u32 reversed = 0;
+    for (u8 i = 0; i < length; ++i)
+        reversed = (reversed << 1) | ((code >> i) & 1);
+    return write_bits(reversed, length);
+}
+
+ErrorOr<void> GzipWriter::write_bits(u32 bits, u8 count)
+{
+    VERIFY(count <= 16);
+    m_bit_buffer |= bits << m_bit_count;
+    m_bit_count += count;
+    while (m_bit_count >= 8) {
+        TRY(append_byte(m_bit_buffer & 0xff));
+        m_bit_buffer >>= 8;
+        m_bit_count -= 8;
+    }
+    return {};
+}
+
+ErrorOr<void> GzipWriter::append_byte(u8 byte)
+{
+    if (m_output_size == m_output->size())
+        TRY(flush_output());
+    m_output->data()[m_output_size++] = byte;
+    return {};
+}
+
+ErrorOr<void> GzipWriter::flush_output()
+{
+    if (m_output_size == 0)
+        return {};
+    TRY(m_description.write(UserOrKernelBuffer::for_kernel_buffer(m_output->data()), m_output_size));
+    m_output_size = 0;
+    return {};
+}
+
+}
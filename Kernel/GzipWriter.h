@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Error.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Span.h>
+#include <Kernel/Forward.h>
+#include <Kernel/KBuffer.h>
+#include <LibCrypto/Checksum/CRC32.h>
+
+namespace Kernel {
+
+// Writes a gzip stream to a file as data is handed to it, buffering only a small amount of
+// compressed output. This is not a general purpose compressor: it emits a single deflate block
+// using the fixed Huffman codes and only ever encodes runs of a repeated byte as matches.
+// That keeps the state tiny, and still squeezes out the zero-filled and pattern-filled pages
+// that make up most of a typical coredump.
+class GzipWriter {
+    AK_MAKE_NONCOPYABLE(GzipWriter);
+    AK_MAKE_NONMOVABLE(GzipWriter);
+
+public:
+    static ErrorOr<NonnullOwnPtr<GzipWriter>> try_create(OpenFileDescription&);
+
+    ErrorOr<void> write(ReadonlyBytes);
+    ErrorOr<void> finish();
+
+private:
+    GzipWriter(OpenFileDescription&, NonnullOwnPtr<KBuffer>);
+
+    ErrorOr<void> write_header();
+    ErrorOr<void> flush_pending_run();
+    ErrorOr<void> write_run(size_t length);
+    ErrorOr<void> write_symbol(u16);
+    ErrorOr<void> write_huffman_code(u16 code, u8 length);
+    ErrorOr<void> write_bits(u32 bits, u8 count);
+    ErrorOr<void> append_byte(u8);
+    ErrorOr<void> flush_output();
+
+    OpenFileDescription& m_description;
+    NonnullOwnPtr<KBuffer> m_output;
+    size_t m_output_size { 0 };
+
+    u32 m_bit_buffer { 0 };
+    u8 m_bit_count { 0 };
+
+    u8 m_previous_byte { 0 };
+    bool m_has_previous_byte { false };
+    size_t m_pending_run_length { 0 };
+
+    Crypto::Checksum::CRC32 m_crc32;
+    u32 m_input_size { 0 };
+    bool m_finished { false };
+};
+
+}
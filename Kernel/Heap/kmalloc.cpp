@@ -10,6 +10,7 @@
 #include <Kernel/Debug.h>
 #include <Kernel/Heap/Heap.h>
 #include <Kernel/Heap/kmalloc.h>
+#include <Kernel/InterruptDisabler.h>
 #include <Kernel/KSyms.h>
 #include <Kernel/Locking/Spinlock.h>
 #include <Kernel/Memory/MemoryManager.h>
@@ -123,6 +124,22 @@ public:
     size_t slab_size() const { return m_slab_size; }
 
     void* allocate(CallerWillInitializeMemory caller_will_initialize_memory)
+    {
+        auto* ptr = allocate_slab();
+        if (ptr && caller_will_initialize_memory == CallerWillInitializeMemory::No) {
+            memset(ptr, KMALLOC_SCRUB_BYTE, m_slab_size);
+        }
+        return ptr;
+    }
+
+    void deallocate(void* ptr)
+    {
+        memset(ptr, KFREE_SCRUB_BYTE, m_slab_size);
+        deallocate_slab(ptr);
+    }
+
+    // NOTE: These don't scrub the slab, as the per-processor magazines do that themselves.
+    void* allocate_slab()
     {
         if (m_usable_blocks.is_empty()) {
             // FIXME: This allocation wastes `block_size` bytes due to the implementation of kmalloc_aligned().
@@ -139,17 +156,11 @@ public:
         auto* ptr = block->allocate();
         if (block->is_full())
             m_full_blocks.append(*block);
-
-        if (caller_will_initialize_memory == CallerWillInitializeMemory::No) {
-            memset(ptr, KMALLOC_SCRUB_BYTE, m_slab_size);
-        }
         return ptr;
     }
 
-    void deallocate(void* ptr)
+    void deallocate_slab(void* ptr)
     {
-        memset(ptr, KFREE_SCRUB_BYTE, m_slab_size);
-
         auto* block = (KmallocSlabBlock*)((FlatPtr)ptr & KmallocSlabBlock::block_mask);
         bool block_was_full = block->is_full();
         block->deallocate(ptr);
@@ -205,6 +216,45 @@ private:
     KmallocSlabBlock::List m_full_blocks;
 };
 
+// Each processor keeps a small stack of free slabs for every slab size in front of the slabheaps.
+// They are refilled and drained in batches, so most small allocations and frees never take s_lock.
+struct KmallocMagazine {
+    static constexpr size_t capacity = 32;
+    static constexpr size_t batch_size = capacity / 2;
+
+    bool is_empty() const { return count == 0; }
+    bool is_full() const { return count == capacity; }
+
+    void push(void* ptr)
+    {
+        VERIFY(!is_full());
+        slots[count++] = ptr;
+    }
+
+    void* pop()
+    {
+        VERIFY(!is_empty());
+        return slots[--count];
+    }
+
+    size_t count { 0 };
+    void* slots[capacity];
+};
+
+static constexpr size_t slabheap_count = 6;
+
+// NOTE: This may only be accessed by its own processor, with interrupts disabled.
+struct KmallocPerProcessorData {
+    KmallocMagazine magazines[slabheap_count];
+
+    size_t kmalloc_call_count { 0 };
+    size_t kfree_call_count { 0 };
+    size_t nested_kfree_calls { 0 };
+    size_t magazine_hit_count { 0 };
+    size_t magazine_refill_count { 0 };
+    size_t magazine_flush_count { 0 };
+};
+
 struct KmallocGlobalData {
     static constexpr size_t minimum_subheap_size = 1 * MiB;
 
@@ -394,7 +444,7 @@ struct KmallocGlobalData {
 
     KmallocSubheap::List subheaps;
 
-    KmallocSlabheap slabheaps[6] = { 16, 32, 64, 128, 256, 512 };
+    KmallocSlabheap slabheaps[slabheap_count] = { 16, 32, 64, 128, 256, 512 };
 
     bool expansion_in_progress { false };
 };
@@ -402,11 +452,71 @@ struct KmallocGlobalData {
 READONLY_AFTER_INIT static KmallocGlobalData* g_kmalloc_global;
 alignas(KmallocGlobalData) static u8 g_kmalloc_global_heap[sizeof(KmallocGlobalData)];
 
-static size_t g_kmalloc_call_count;
-static size_t g_kfree_call_count;
-static size_t g_nested_kfree_calls;
+static KmallocPerProcessorData s_per_processor_data[Kernel::MAX_CPU_COUNT];
 bool g_dump_kmalloc_stacks;
 
+static KmallocPerProcessorData& current_processor_data()
+{
+    VERIFY(!Processor::are_interrupts_enabled());
+    return s_per_processor_data[Processor::current_id()];
+}
+
+static Optional<size_t> slabheap_index_for(size_t size, size_t alignment)
+{
+    for (size_t i = 0; i < slabheap_count; ++i) {
+        auto slab_size = g_kmalloc_global->slabheaps[i].slab_size();
+        if (size <= slab_size && alignment <= slab_size)
+            return i;
+    }
+    return {};
+}
+
+static void* allocate_from_magazine(KmallocPerProcessorData& data, size_t index, CallerWillInitializeMemory caller_will_initialize_memory)
+{
+    auto& magazine = data.magazines[index];
+    auto& slabheap = g_kmalloc_global->slabheaps[index];
+
+    if (magazine.is_empty()) {
+        SpinlockLocker lock(s_lock);
+        VERIFY(!g_kmalloc_global->expansion_in_progress);
+        ++data.magazine_refill_count;
+        while (magazine.count < KmallocMagazine::batch_size) {
+            auto* ptr = slabheap.allocate_slab();
+            if (!ptr)
+                break;
+            magazine.push(ptr);
+        }
+        // If we couldn't get a single slab, let the regular path try to purge or expand the heap.
+        if (magazine.is_empty())
+            return g_kmalloc_global->allocate(slabheap.slab_size(), KMALLOC_DEFAULT_ALIGNMENT, caller_will_initialize_memory);
+    } else {
+        ++data.magazine_hit_count;
+    }
+
+    auto* ptr = magazine.pop();
+    if (caller_will_initialize_memory == CallerWillInitializeMemory::No)
+        memset(ptr, KMALLOC_SCRUB_BYTE, slabheap.slab_size());
+    return ptr;
+}
+
+static void deallocate_to_magazine(KmallocPerProcessorData& data, size_t index, void* ptr)
+{
+    VERIFY(g_kmalloc_global->is_valid_kmalloc_address(VirtualAddress { ptr }));
+
+    auto& magazine = data.magazines[index];
+    auto& slabheap = g_kmalloc_global->slabheaps[index];
+
+    memset(ptr, KFREE_SCRUB_BYTE, slabheap.slab_size());
+
+    if (magazine.is_full()) {
+        SpinlockLocker lock(s_lock);
+        ++data.magazine_flush_count;
+        while (magazine.count > KmallocMagazine::batch_size)
+            slabheap.deallocate_slab(magazine.pop());
+    }
+    magazine.push(ptr);
+}
+
 void kmalloc_enable_expand()
 {
     g_kmalloc_global->enable_expansion();
@@ -431,15 +541,24 @@ static void* kmalloc_impl(size_t size, size_t alignment, CallerWillInitializeMem
     // Alignment must be a power of two.
     VERIFY(is_power_of_two(alignment));
 
-    SpinlockLocker lock(s_lock);
-    ++g_kmalloc_call_count;
+    InterruptDisabler disabler;
+    auto& data = current_processor_data();
+    ++data.kmalloc_call_count;
 
-    if (g_dump_kmalloc_stacks && Kernel::g_kernel_symbols_available) {
-        dbgln("kmalloc({})", size);
-        Kernel::dump_backtrace();
-    }
+    void* ptr = nullptr;
+    auto slabheap_index = slabheap_index_for(size, alignment);
+    if (slabheap_index.has_value() && !g_dump_kmalloc_stacks) {
+        ptr = allocate_from_magazine(data, slabheap_index.value(), caller_will_initialize_memory);
+    } else {
+        SpinlockLocker lock(s_lock);
 
-    void* ptr = g_kmalloc_global->allocate(size, alignment, caller_will_initialize_memory);
+        if (g_dump_kmalloc_stacks && Kernel::g_kernel_symbols_available) {
+            dbgln("kmalloc({})", size);
+            Kernel::dump_backtrace();
+        }
+
+        ptr = g_kmalloc_global->allocate(size, alignment, caller_will_initialize_memory);
+    }
 
     Thread* current_thread = Thread::current();
     if (!current_thread)
@@ -482,11 +601,12 @@ void kfree_sized(void* ptr, size_t size)
         Processor::verify_no_spinlocks_held();
     }
 
-    SpinlockLocker lock(s_lock);
-    ++g_kfree_call_count;
-    ++g_nested_kfree_calls;
+    InterruptDisabler disabler;
+    auto& data = current_processor_data();
+    ++data.kfree_call_count;
+    ++data.nested_kfree_calls;
 
-    if (g_nested_kfree_calls == 1) {
+    if (data.nested_kfree_calls == 1) {
         Thread* current_thread = Thread::current();
         if (!current_thread)
             current_thread = Processor::idle_thread();
@@ -496,8 +616,14 @@ void kfree_sized(void* ptr, size_t size)
         }
     }
 
-    g_kmalloc_global->deallocate(ptr, size);
-    --g_nested_kfree_calls;
+    // NOTE: Slabs are looked up by size alone here, mirroring KmallocGlobalData::deallocate().
+    if (auto slabheap_index = slabheap_index_for(size, 1); slabheap_index.has_value()) {
+        deallocate_to_magazine(data, slabheap_index.value(), ptr);
+    } else {
+        SpinlockLocker lock(s_lock);
+        g_kmalloc_global->deallocate(ptr, size);
+    }
+    --data.nested_kfree_calls;
 }
 
 size_t kmalloc_good_size(size_t size)
@@ -584,6 +710,26 @@ void get_kmalloc_stats(kmalloc_stats& stats)
     SpinlockLocker lock(s_lock);
     stats.bytes_allocated = g_kmalloc_global->allocated_bytes();
     stats.bytes_free = g_kmalloc_global->free_bytes();
-    stats.kmalloc_call_count = g_kmalloc_call_count;
-    stats.kfree_call_count = g_kfree_call_count;
+    stats.kmalloc_call_count = 0;
+    stats.kfree_call_count = 0;
+    stats.magazine_hit_count = 0;
+    stats.magazine_refill_count = 0;
+    stats.magazine_flush_count = 0;
+    stats.bytes_in_magazines = 0;
+
+    // NOTE: The other processors' data may change under us, but these are only statistics.
+    for (size_t cpu = 0; cpu < Processor::count(); ++cpu) {
+        auto const& data = s_per_processor_data[cpu];
+        stats.kmalloc_call_count += data.kmalloc_call_count;
+        stats.kfree_call_count += data.kfree_call_count;
+        stats.magazine_hit_count += data.magazine_hit_count;
+        stats.magazine_refill_count += data.magazine_refill_count;
+        stats.magazine_flush_count += data.magazine_flush_count;
+        for (size_t i = 0; i < slabheap_count; ++i)
+            stats.bytes_in_magazines += data.magazines[i].count * g_kmalloc_global->slabheaps[i].slab_size();
+    }
+
+    // Slabs sitting in a magazine are free as far as the rest of the kernel is concerned.
+    stats.bytes_allocated -= min(stats.bytes_allocated, stats.bytes_in_magazines);
+    stats.bytes_free += stats.bytes_in_magazines;
 }
@@ -52,6 +52,10 @@ struct kmalloc_stats {
     size_t bytes_free;
     size_t kmalloc_call_count;
     size_t kfree_call_count;
+    size_t magazine_hit_count;
+    size_t magazine_refill_count;
+    size_t magazine_flush_count;
+    size_t bytes_in_magazines;
 };
 void get_kmalloc_stats(kmalloc_stats&);
 
@@ -69,6 +69,12 @@ ErrorOr<void> KBufferBuilder::append_bytes(ReadonlyBytes bytes)
     return {};
 }
 
+void KBufferBuilder::overwrite_bytes(size_t offset, ReadonlyBytes bytes)
+{
+    VERIFY(offset + bytes.size() <= m_size);
+    memcpy(m_buffer->data() + offset, bytes.data(), bytes.size());
+}
+
 ErrorOr<void> KBufferBuilder::append(StringView str)
 {
     if (str.is_empty())
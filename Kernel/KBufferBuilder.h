@@ -30,6 +30,8 @@ public:
 
     ErrorOr<void> append_escaped_for_json(StringView);
     ErrorOr<void> append_bytes(ReadonlyBytes);
+    // Replaces bytes that were already appended, e.g. to fill in a count once it is known.
+    void overwrite_bytes(size_t offset, ReadonlyBytes);
 
     template<typename... Parameters>
     ErrorOr<void> appendff(CheckedFormatString<Parameters...>&& fmtstr, Parameters const&... parameters)
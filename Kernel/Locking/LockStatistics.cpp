@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/StringHash.h>
+#include <Kernel/Locking/LockStatistics.h>
+#include <Kernel/Locking/Spinlock.h>
+#include <Kernel/StdLib.h>
+#include <Kernel/Time/TimeManagement.h>
+
+namespace Kernel {
+
+Atomic<bool, AK::MemoryOrder::memory_order_relaxed> g_collect_lock_statistics { false };
+
+// Statistics are kept in a fixed-size open addressing table so that recording
+// never has to allocate: Mutexes are taken all over the kernel, including on
+// paths that kmalloc() itself depends on. Slots are claimed once under
+// s_lock_statistics_lock and never released; after that all updates are
+// lock-free. Names that don't fit are truncated, names that don't find a free
+// slot are accounted to the overflow entry.
+static constexpr size_t lock_statistics_slot_count = 256;
+static constexpr size_t lock_statistics_max_name_length = 47;
+
+struct LockStatisticsSlot {
+    Atomic<bool> in_use { false };
+    size_t name_length { 0 };
+    char name[lock_statistics_max_name_length] {};
+
+    Atomic<u64, AK::MemoryOrder::memory_order_relaxed> acquisitions { 0 };
+    Atomic<u64, AK::MemoryOrder::memory_order_relaxed> contended_acquisitions { 0 };
+    Atomic<u64, AK::MemoryOrder::memory_order_relaxed> total_wait_ns { 0 };
+    Atomic<u64, AK::MemoryOrder::memory_order_relaxed> max_wait_ns { 0 };
+    Atomic<u64, AK::MemoryOrder::memory_order_relaxed> total_hold_ns { 0 };
+    Atomic<u64, AK::MemoryOrder::memory_order_relaxed> max_hold_ns { 0 };
+
+    StringView name_view() const { return { name, name_length }; }
+};
+
+static Array<LockStatisticsSlot, lock_statistics_slot_count> s_lock_statistics_slots;
+static LockStatisticsSlot s_lock_statistics_overflow_slot;
+static Spinlock<LockRank::None> s_lock_statistics_lock {};
+
+static StringView normalized_lock_name(StringView name)
+{
+    if (name.is_empty())
+        return "(unnamed)"sv;
+    return name.substring_view(0, min(name.length(), lock_statistics_max_name_length));
+}
+
+static LockStatisticsSlot& slot_for_lock_name(StringView name)
+{
+    name = normalized_lock_name(name);
+    auto start = string_hash(name.characters_without_null_termination(), name.length()) % lock_statistics_slot_count;
+    for (size_t i = 0; i < lock_statistics_slot_count; ++i) {
+        auto& slot = s_lock_statistics_slots[(start + i) % lock_statistics_slot_count];
+        if (!slot.in_use.load(AK::MemoryOrder::memory_order_acquire)) {
+            SpinlockLocker locker(s_lock_statistics_lock);
+            if (!slot.in_use.load(AK::MemoryOrder::memory_order_relaxed)) {
+                memcpy(slot.name, name.characters_without_null_termination(), name.length());
+                slot.name_length = name.length();
+                slot.in_use.store(true, AK::MemoryOrder::memory_order_release);
+                return slot;
+            }
+        }
+        if (slot.name_view() == name)
+            return slot;
+    }
+    return s_lock_statistics_overflow_slot;
+}
+
+static void update_maximum(Atomic<u64, AK::MemoryOrder::memory_order_relaxed>& maximum, u64 value)
+{
+    auto current = maximum.load();
+    while (value > current) {
+        if (maximum.compare_exchange_strong(current, value))
+            break;
+    }
+}
+
+u64 lock_statistics_timestamp()
+{
+    if (!TimeManagement::is_initialized())
+        return 0;
+    return static_cast<u64>(TimeManagement::the().monotonic_time(TimePrecision::Precise).to_nanoseconds());
+}
+
+void record_lock_acquisition(StringView name, bool contended, u64 wait_ns)
+{
+    auto& slot = slot_for_lock_name(name);
+    slot.acquisitions++;
+    if (!contended)
+        return;
+    slot.contended_acquisitions++;
+    slot.total_wait_ns += wait_ns;
+    update_maximum(slot.max_wait_ns, wait_ns);
+}
+
+void record_lock_hold(StringView name, u64 hold_ns)
+{
+    auto& slot = slot_for_lock_name(name);
+    slot.total_hold_ns += hold_ns;
+    update_maximum(slot.max_hold_ns, hold_ns);
+}
+
+ErrorOr<void> for_each_lock_statistics(Function<ErrorOr<void>(LockStatistics const&)> callback)
+{
+    auto snapshot = [](LockStatisticsSlot const& slot, StringView name) {
+        return LockStatistics {
+            .name = name,
+            .acquisitions = slot.acquisitions.load(),
+            .contended_acquisitions = slot.contended_acquisitions.load(),
+            .total_wait_ns = slot.total_wait_ns.load(),
+            .max_wait_ns = slot.max_wait_ns.load(),
+            .total_hold_ns = slot.total_hold_ns.load(),
+            .max_hold_ns = slot.max_hold_ns.load(),
+        };
+    };
+    for (auto const& slot : s_lock_statistics_slots) {
+        if (!slot.in_use.load(AK::MemoryOrder::memory_order_acquire))
+            continue;
+        TRY(callback(snapshot(slot, slot.name_view())));
+    }
+    if (s_lock_statistics_overflow_slot.acquisitions.load() != 0)
+        TRY(callback(snapshot(s_lock_statistics_overflow_slot, "(overflow)"sv)));
+    return {};
+}
+
+}
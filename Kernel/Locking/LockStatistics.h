@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Function.h>
+#include <AK/StringView.h>
+#include <AK/Types.h>
+
+namespace Kernel {
+
+// Aggregate statistics for all Mutexes sharing a name. Collection is disabled
+// by default and can be toggled at runtime via /sys/kernel/variables/lock_statistics.
+extern Atomic<bool, AK::MemoryOrder::memory_order_relaxed> g_collect_lock_statistics;
+
+struct LockStatistics {
+    StringView name;
+    u64 acquisitions { 0 };
+    u64 contended_acquisitions { 0 };
+    u64 total_wait_ns { 0 };
+    u64 max_wait_ns { 0 };
+    u64 total_hold_ns { 0 };
+    u64 max_hold_ns { 0 };
+};
+
+u64 lock_statistics_timestamp();
+void record_lock_acquisition(StringView name, bool contended, u64 wait_ns);
+void record_lock_hold(StringView name, u64 hold_ns);
+ErrorOr<void> for_each_lock_statistics(Function<ErrorOr<void>(LockStatistics const&)>);
+
+}
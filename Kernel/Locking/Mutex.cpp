@@ -5,9 +5,12 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BuiltinWrappers.h>
+#include <AK/ScopeGuard.h>
 #include <Kernel/Debug.h>
 #include <Kernel/KSyms.h>
 #include <Kernel/Locking/LockLocation.h>
+#include <Kernel/Locking/LockStatistics.h>
 #include <Kernel/Locking/Mutex.h>
 #include <Kernel/Locking/Spinlock.h>
 #include <Kernel/Thread.h>
@@ -16,6 +19,102 @@ extern bool g_in_early_boot;
 
 namespace Kernel {
 
+// When a Mutex is held exclusively by a thread that is currently running on
+// another processor, it will usually be released soon, so we spin for a
+// while before paying for a full block and wakeup. We spin in rounds,
+// checking lock-free whether the holder is still running and only taking
+// m_lock between rounds to see if the mutex has been released.
+static constexpr size_t mutex_spin_round_count = 16;
+static constexpr size_t mutex_pauses_per_spin_round = 64;
+
+struct MutexContentionCounters {
+    Atomic<u64, AK::MemoryOrder::memory_order_relaxed> contended_count { 0 };
+    Atomic<u64, AK::MemoryOrder::memory_order_relaxed> acquired_after_spinning_count { 0 };
+    Atomic<u64, AK::MemoryOrder::memory_order_relaxed> blocked_count { 0 };
+};
+static Array<MutexContentionCounters, Mutex::tracked_rank_count> s_contention_counters;
+
+static size_t contention_counters_index(LockRank rank)
+{
+    if (rank == LockRank::None)
+        return 0;
+    auto index = static_cast<size_t>(count_trailing_zeroes(static_cast<unsigned>(to_underlying(rank)))) + 1;
+    VERIFY(index < Mutex::tracked_rank_count);
+    return index;
+}
+
+static MutexContentionCounters& contention_counters_for(LockRank rank)
+{
+    return s_contention_counters[contention_counters_index(rank)];
+}
+
+Array<Mutex::ContentionStatistics, Mutex::tracked_rank_count> Mutex::contention_statistics()
+{
+    Array<ContentionStatistics, tracked_rank_count> statistics;
+    for (size_t i = 0; i < tracked_rank_count; ++i) {
+        auto& counters = s_contention_counters[i];
+        statistics[i] = {
+            .rank = i == 0 ? LockRank::None : static_cast<LockRank>(1 << (i - 1)),
+            .contended_count = counters.contended_count.load(),
+            .acquired_after_spinning_count = counters.acquired_after_spinning_count.load(),
+            .blocked_count = counters.blocked_count.load(),
+        };
+    }
+    return statistics;
+}
+
+bool Mutex::spin_while_holder_is_running(Thread& current_thread, SpinlockLocker<Spinlock<LockRank::None>>& lock)
+{
+    VERIFY(m_mode == Mode::Exclusive);
+    VERIFY(m_holder != &current_thread);
+
+    // The big lock is held across entire syscalls, spinning on it is pointless.
+    if (m_behavior == MutexBehavior::BigLock || Processor::count() == 1)
+        return false;
+
+    // Keep the holder alive while we look at it without holding m_lock.
+    LockRefPtr<Thread> holder = m_holder;
+    bool did_spin = false;
+    for (size_t round = 0; round < mutex_spin_round_count; ++round) {
+        // If there are threads blocked on this Mutex, it will be handed to them
+        // directly once it's released, so there's no point in waiting for that.
+        bool has_blocked_threads = m_blocked_thread_lists.with([](auto& lists) {
+            return !lists.exclusive.is_empty() || !lists.shared.is_empty() || !lists.exclusive_big_lock.is_empty();
+        });
+        if (has_blocked_threads || !holder->is_active())
+            break;
+
+        did_spin = true;
+        lock.unlock();
+        for (size_t i = 0; i < mutex_pauses_per_spin_round && holder->is_active(); ++i)
+            Processor::wait_check();
+        lock.lock();
+
+        if (m_mode != Mode::Exclusive || m_holder != holder)
+            break;
+    }
+    return did_spin;
+}
+
+void Mutex::record_acquisition_statistics(Thread* current_thread, bool contended, u64 wait_start_ns)
+{
+    auto now_ns = lock_statistics_timestamp();
+    u64 wait_ns = (wait_start_ns != 0 && now_ns >= wait_start_ns) ? now_ns - wait_start_ns : 0;
+    record_lock_acquisition(m_name, contended, wait_ns);
+    if (m_mode == Mode::Exclusive && m_holder == current_thread && m_exclusive_hold_start_ns == 0)
+        m_exclusive_hold_start_ns = now_ns;
+}
+
+void Mutex::finish_exclusive_hold()
+{
+    if (m_exclusive_hold_start_ns == 0)
+        return;
+    auto now_ns = lock_statistics_timestamp();
+    if (now_ns >= m_exclusive_hold_start_ns)
+        record_lock_hold(m_name, now_ns - m_exclusive_hold_start_ns);
+    m_exclusive_hold_start_ns = 0;
+}
+
 void Mutex::lock(Mode mode, [[maybe_unused]] LockLocation const& location)
 {
     // NOTE: This may be called from an interrupt handler (not an IRQ handler)
@@ -29,7 +128,24 @@ void Mutex::lock(Mode mode, [[maybe_unused]] LockLocation const& location)
     VERIFY(mode != Mode::Unlocked);
     auto* current_thread = Thread::current();
 
+    bool collect_statistics = g_collect_lock_statistics.load();
+    u64 wait_start_ns = collect_statistics ? lock_statistics_timestamp() : 0;
+
     SpinlockLocker lock(m_lock);
+    bool was_contended = (m_mode == Mode::Exclusive && m_holder != current_thread) || (m_mode == Mode::Shared && mode == Mode::Exclusive);
+    // NOTE: This runs before the SpinlockLocker above is destroyed, so m_lock is still held.
+    ScopeGuard record_statistics = [&] {
+        if (collect_statistics)
+            record_acquisition_statistics(current_thread, was_contended, wait_start_ns);
+    };
+
+    if (m_mode == Mode::Exclusive && m_holder != current_thread) {
+        auto& counters = contention_counters_for(m_rank);
+        counters.contended_count++;
+        if (spin_while_holder_is_running(*current_thread, lock) && m_mode == Mode::Unlocked)
+            counters.acquired_after_spinning_count++;
+    }
+
     bool did_block = false;
     Mode current_mode = m_mode;
     switch (current_mode) {
@@ -205,6 +321,8 @@ void Mutex::unlock()
 
     if (m_times_locked == 0) {
         VERIFY(current_mode == Mode::Exclusive ? !m_holder : m_shared_holders == 0);
+        if (current_mode == Mode::Exclusive)
+            finish_exclusive_hold();
 
         m_mode = Mode::Unlocked;
         unblock_waiters(current_mode);
@@ -218,6 +336,8 @@ void Mutex::block(Thread& current_thread, Mode mode, SpinlockLocker<Spinlock<Loc
         if (!g_in_early_boot)
             VERIFY_INTERRUPTS_ENABLED();
     }
+    contention_counters_for(m_rank).blocked_count++;
+
     m_blocked_thread_lists.with([&](auto& lists) {
         auto append_to_list = [&]<typename L>(L& list) {
             VERIFY(!list.contains(current_thread));
@@ -313,6 +433,7 @@ auto Mutex::force_unlock_exclusive_if_locked(u32& lock_count_to_restore) -> Mode
         m_holder->holding_lock(*this, -(int)m_times_locked, {});
 #endif
         m_holder = nullptr;
+        finish_exclusive_hold();
         VERIFY(m_times_locked > 0);
         lock_count_to_restore = m_times_locked;
         m_times_locked = 0;
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/Assertions.h>
 #include <AK/Atomic.h>
 #include <AK/HashMap.h>
@@ -14,6 +15,7 @@
 #include <Kernel/Forward.h>
 #include <Kernel/Locking/LockLocation.h>
 #include <Kernel/Locking/LockMode.h>
+#include <Kernel/Locking/LockRank.h>
 #include <Kernel/WaitQueue.h>
 
 namespace Kernel {
@@ -33,9 +35,10 @@ public:
         BigLock,
     };
 
-    Mutex(StringView name = {}, MutexBehavior behavior = MutexBehavior::Regular)
+    Mutex(StringView name = {}, MutexBehavior behavior = MutexBehavior::Regular, LockRank rank = LockRank::None)
         : m_name(name)
         , m_behavior(behavior)
+        , m_rank(rank)
     {
     }
     ~Mutex() = default;
@@ -61,6 +64,7 @@ public:
     }
 
     [[nodiscard]] StringView name() const { return m_name; }
+    [[nodiscard]] LockRank rank() const { return m_rank; }
 
     static StringView mode_to_string(Mode mode)
     {
@@ -76,6 +80,39 @@ public:
         }
     }
 
+    static StringView rank_to_string(LockRank rank)
+    {
+        switch (rank) {
+        case LockRank::None:
+            return "none"sv;
+        case LockRank::MemoryManager:
+            return "memory-manager"sv;
+        case LockRank::Interrupts:
+            return "interrupts"sv;
+        case LockRank::FileSystem:
+            return "file-system"sv;
+        case LockRank::Thread:
+            return "thread"sv;
+        case LockRank::Process:
+            return "process"sv;
+        default:
+            return "invalid"sv;
+        }
+    }
+
+    struct ContentionStatistics {
+        LockRank rank { LockRank::None };
+        // Number of lock() calls that found the mutex held exclusively by another thread.
+        u64 contended_count { 0 };
+        // Number of contended lock() calls that found the mutex released after spinning.
+        u64 acquired_after_spinning_count { 0 };
+        // Number of lock() calls that had to block.
+        u64 blocked_count { 0 };
+    };
+    // LockRank::None plus one entry per annotated rank.
+    static constexpr size_t tracked_rank_count = 6;
+    static Array<ContentionStatistics, tracked_rank_count> contention_statistics();
+
 private:
     using BlockedThreadList = IntrusiveList<&Thread::m_blocked_threads_list_node>;
 
@@ -85,6 +122,9 @@ private:
     // FIXME: Allow any lock rank.
     void block(Thread&, Mode, SpinlockLocker<Spinlock<LockRank::None>>&, u32);
     void unblock_waiters(Mode);
+    bool spin_while_holder_is_running(Thread&, SpinlockLocker<Spinlock<LockRank::None>>&);
+    void record_acquisition_statistics(Thread*, bool contended, u64 wait_start_ns);
+    void finish_exclusive_hold();
 
     StringView m_name;
     Mode m_mode { Mode::Unlocked };
@@ -92,6 +132,9 @@ private:
     // FIXME: remove this after annihilating Process::m_big_lock
     MutexBehavior m_behavior;
 
+    // Only used to group the contention statistics, Mutexes don't take part in lock rank enforcement.
+    LockRank m_rank { LockRank::None };
+
     // When locked exclusively, only the thread already holding the lock can
     // lock it again. When locked in shared mode, any thread can do that.
     u32 m_times_locked { 0 };
@@ -104,6 +147,10 @@ private:
     LockRefPtr<Thread> m_holder;
     size_t m_shared_holders { 0 };
 
+    // Timestamp of when the current exclusive holder acquired this lock, or 0
+    // if lock statistics weren't being collected at the time.
+    u64 m_exclusive_hold_start_ns { 0 };
+
     struct BlockedThreadLists {
         BlockedThreadList exclusive;
         BlockedThreadList shared;
@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ScopeGuard.h>
 #include <Kernel/API/MemoryLayout.h>
 #include <Kernel/Arch/CPU.h>
 #include <Kernel/Locking/Spinlock.h>
@@ -82,10 +83,11 @@ ErrorOr<void> AddressSpace::unmap_mmap_range(VirtualAddress addr, size_t size)
         auto new_regions = TRY(try_split_region_around_range(*region, range_to_unmap));
 
         // And finally we map the new region(s) using our page directory (they were just allocated and don't have one).
+        // NOTE: Not-present entries are never cached in the TLB, and we've just flushed it, so there is no need to flush again.
         for (auto* new_region : new_regions) {
             // TODO: Ideally we should do this in a way that can be rolled back on failure, as failing here
             // leaves the caller in an undefined state.
-            TRY(new_region->map(page_directory()));
+            TRY(new_region->map(page_directory(), ShouldFlushTLB::No));
         }
 
         PerformanceManager::add_unmap_perf_event(Process::current(), range_to_unmap);
@@ -109,28 +111,39 @@ ErrorOr<void> AddressSpace::unmap_mmap_range(VirtualAddress addr, size_t size)
 
     Vector<Region*, 2> new_regions;
 
-    for (auto* old_region : regions) {
-        // If it's a full match we can remove the entire old region.
-        if (old_region->range().intersect(range_to_unmap).size() == old_region->size()) {
-            deallocate_region(*old_region);
-            continue;
-        }
+    // We unmap all the old regions without flushing the TLB and then do a single shootdown for all of them.
+    // The old regions (and with them their physical pages) must stay alive until that flush has happened.
+    Vector<NonnullOwnPtr<Region>> unmapped_regions;
+    TRY(unmapped_regions.try_ensure_capacity(regions.size()));
+    auto range_to_flush = VirtualRange { regions.first()->vaddr(), regions.last()->range().end().get() - regions.first()->vaddr().get() };
+    ScopeGuard flush_tlb_guard = [&] {
+        MemoryManager::flush_tlb(m_page_directory, range_to_flush.base(), range_to_flush.size() / PAGE_SIZE);
+    };
 
+    for (auto* old_region : regions) {
         // Remove the old region from our regions tree, since were going to add another region
         // with the exact same start address.
         auto region = take_region(*old_region);
-        region->unmap();
+        region->unmap(ShouldFlushTLB::No);
+
+        // If it's a full match we can remove the entire old region.
+        if (region->range().intersect(range_to_unmap).size() == region->size()) {
+            unmapped_regions.unchecked_append(move(region));
+            continue;
+        }
 
         // Otherwise, split the regions and collect them for future mapping.
         auto split_regions = TRY(try_split_region_around_range(*region, range_to_unmap));
+        unmapped_regions.unchecked_append(move(region));
         TRY(new_regions.try_extend(split_regions));
     }
 
     // And finally map the new region(s) into our page directory.
+    // NOTE: These map the same pages that the old regions did, so the flush when we return covers them as well.
     for (auto* new_region : new_regions) {
         // TODO: Ideally we should do this in a way that can be rolled back on failure, as failing here
         // leaves the caller in an undefined state.
-        TRY(new_region->map(page_directory()));
+        TRY(new_region->map(page_directory(), ShouldFlushTLB::No));
     }
 
     PerformanceManager::add_unmap_perf_event(Process::current(), range_to_unmap);
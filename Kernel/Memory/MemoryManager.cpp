@@ -26,6 +26,7 @@
 #include <Kernel/Process.h>
 #include <Kernel/Sections.h>
 #include <Kernel/StdLib.h>
+#include <Kernel/Tasks/PageZeroingTask.h>
 
 extern u8 start_of_kernel_image[];
 extern u8 end_of_kernel_image[];
@@ -844,17 +845,22 @@ ErrorOr<NonnullOwnPtr<Region>> MemoryManager::allocate_kernel_region_with_vmobje
 ErrorOr<CommittedPhysicalPageSet> MemoryManager::commit_physical_pages(size_t page_count)
 {
     VERIFY(page_count > 0);
-    auto result = m_global_data.with([&](auto& global_data) -> ErrorOr<CommittedPhysicalPageSet> {
-        if (global_data.system_memory_info.physical_pages_uncommitted < page_count) {
-            dbgln("MM: Unable to commit {} pages, have only {}", page_count, global_data.system_memory_info.physical_pages_uncommitted);
-            return ENOMEM;
-        }
-
-        global_data.system_memory_info.physical_pages_uncommitted -= page_count;
-        global_data.system_memory_info.physical_pages_committed += page_count;
-        return CommittedPhysicalPageSet { {}, page_count };
-    });
+    auto try_commit = [&] {
+        return m_global_data.with([&](auto& global_data) -> ErrorOr<CommittedPhysicalPageSet> {
+            if (global_data.system_memory_info.physical_pages_uncommitted < page_count)
+                return ENOMEM;
+
+            global_data.system_memory_info.physical_pages_uncommitted -= page_count;
+            global_data.system_memory_info.physical_pages_committed += page_count;
+            return CommittedPhysicalPageSet { {}, page_count };
+        });
+    };
+    auto result = try_commit();
+    // The pages sitting in the zeroed page pool are fair game when we're running out.
+    if (result.is_error() && release_zeroed_pages() > 0)
+        result = try_commit();
     if (result.is_error()) {
+        dbgln("MM: Unable to commit {} pages, have only {}", page_count, get_system_memory_info().physical_pages_uncommitted);
         Process::for_each_ignoring_jails([&](Process const& process) {
             size_t amount_resident = 0;
             size_t amount_shared = 0;
@@ -940,8 +946,97 @@ RefPtr<PhysicalPage> MemoryManager::find_free_physical_page(bool committed)
     return page;
 }
 
+static void zero_page_non_temporally(u8* page)
+{
+#if ARCH(X86_64)
+    // Non-temporal stores bypass the cache, so the pre-zeroed pages don't evict anything useful.
+    auto* qwords = reinterpret_cast<u64*>(page);
+    for (size_t i = 0; i < PAGE_SIZE / sizeof(u64); ++i)
+        asm volatile("movnti %1, %0"
+                     : "=m"(qwords[i])
+                     : "r"(0ull));
+    asm volatile("sfence" ::
+                     : "memory");
+#else
+    memset(page, 0, PAGE_SIZE);
+#endif
+}
+
+bool MemoryManager::refill_zeroed_page_pool()
+{
+    // Don't hog memory for the pool when there isn't much to go around, it's only an optimization.
+    static constexpr size_t minimum_uncommitted_pages = 8 * zeroed_page_pool_capacity;
+
+    for (;;) {
+        if (m_zeroed_page_pool.with([](auto& pool) { return pool.count == zeroed_page_pool_capacity; }))
+            return true;
+
+        if (get_system_memory_info().physical_pages_uncommitted < minimum_uncommitted_pages)
+            return false;
+
+        auto page = find_free_physical_page(false);
+        if (!page)
+            return false;
+
+        {
+            InterruptDisabler disabler;
+            zero_page_non_temporally(quickmap_page(*page));
+            unquickmap_page();
+        }
+
+        // If the pool filled up in the meantime, the page is simply freed again once we drop it.
+        m_zeroed_page_pool.with([&](auto& pool) {
+            if (pool.count < zeroed_page_pool_capacity)
+                pool.pages[pool.count++] = move(page);
+        });
+    }
+}
+
+RefPtr<PhysicalPage> MemoryManager::take_zeroed_page()
+{
+    RefPtr<PhysicalPage> page;
+    bool should_refill = false;
+    m_zeroed_page_pool.with([&](auto& pool) {
+        if (pool.count == 0)
+            return;
+        page = move(pool.pages[--pool.count]);
+        should_refill = pool.count == zeroed_page_pool_capacity / 2;
+    });
+    if (should_refill)
+        PageZeroingTask::wake();
+    return page;
+}
+
+size_t MemoryManager::release_zeroed_pages()
+{
+    size_t count = 0;
+    for (;;) {
+        // NOTE: The page has to be dropped outside of the pool lock, as freeing it takes the global lock.
+        auto page = m_zeroed_page_pool.with([](auto& pool) -> RefPtr<PhysicalPage> {
+            if (pool.count == 0)
+                return nullptr;
+            return move(pool.pages[--pool.count]);
+        });
+        if (!page)
+            return count;
+        ++count;
+    }
+}
+
 NonnullRefPtr<PhysicalPage> MemoryManager::allocate_committed_physical_page(Badge<CommittedPhysicalPageSet>, ShouldZeroFill should_zero_fill)
 {
+    if (should_zero_fill == ShouldZeroFill::Yes) {
+        if (auto page = take_zeroed_page()) {
+            // The pooled page already counts as uncommitted, so give the committed page we're not using back.
+            m_global_data.with([&](auto& global_data) {
+                VERIFY(global_data.system_memory_info.physical_pages_committed > 0);
+                global_data.system_memory_info.physical_pages_committed--;
+                global_data.system_memory_info.physical_pages_uncommitted++;
+            });
+            return page.release_nonnull();
+        }
+    }
+
     auto page = find_free_physical_page(true);
     VERIFY(page);
     if (should_zero_fill == ShouldZeroFill::Yes) {
@@ -955,10 +1050,22 @@ NonnullRefPtr<PhysicalPage> MemoryManager::allocate_committed_physical_page(Badg
 
 ErrorOr<NonnullRefPtr<PhysicalPage>> MemoryManager::allocate_physical_page(ShouldZeroFill should_zero_fill, bool* did_purge)
 {
+    if (should_zero_fill == ShouldZeroFill::Yes) {
+        if (auto page = take_zeroed_page()) {
+            if (did_purge)
+                *did_purge = false;
+            return page.release_nonnull();
+        }
+    }
+
     return m_global_data.with([&](auto&) -> ErrorOr<NonnullRefPtr<PhysicalPage>> {
         auto page = find_free_physical_page(false);
         bool purged_pages = false;
 
+        if (!page) {
+            // Before throwing anything away, use up the pages we zeroed ahead of time.
+            page = take_zeroed_page();
+        }
         if (!page) {
             // We didn't have a single free physical page. Let's try to free something up!
             // First, we look for a purgeable VMObject in the volatile state.
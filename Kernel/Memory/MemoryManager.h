@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/Badge.h>
 #include <AK/Concepts.h>
 #include <AK/HashTable.h>
@@ -124,10 +125,12 @@ private:
 };
 
 class MemoryManager {
+    friend class AddressSpace;
     friend class PageDirectory;
     friend class AnonymousVMObject;
     friend class Region;
     friend class RegionTree;
+    friend class SharedInodeVMObject;
     friend class VMObject;
     friend struct ::KmallocGlobalData;
 
@@ -169,6 +172,10 @@ public:
     ErrorOr<NonnullRefPtrVector<PhysicalPage>> allocate_contiguous_physical_pages(size_t size);
     void deallocate_physical_page(PhysicalAddress);
 
+    // Zeroes free pages ahead of time, so that zero-filled allocations don't have to do it on the spot.
+    // Returns true when the pool is full, and false if it had to stop because memory is running low.
+    bool refill_zeroed_page_pool();
+
     ErrorOr<NonnullOwnPtr<Region>> allocate_contiguous_kernel_region(size_t, StringView name, Region::Access access, Region::Cacheable = Region::Cacheable::Yes);
     ErrorOr<NonnullOwnPtr<Memory::Region>> allocate_dma_buffer_page(StringView name, Memory::Region::Access access, RefPtr<Memory::PhysicalPage>& dma_buffer_page);
     ErrorOr<NonnullOwnPtr<Memory::Region>> allocate_dma_buffer_page(StringView name, Memory::Region::Access access);
@@ -256,6 +263,8 @@ private:
     static Region* find_region_from_vaddr(VirtualAddress);
 
     RefPtr<PhysicalPage> find_free_physical_page(bool);
+    RefPtr<PhysicalPage> take_zeroed_page();
+    size_t release_zeroed_pages();
 
     ALWAYS_INLINE u8* quickmap_page(PhysicalPage& page)
     {
@@ -303,6 +312,14 @@ private:
     };
 
     SpinlockProtected<GlobalData, LockRank::None> m_global_data;
+
+    // Pages in the pool are accounted for as used and uncommitted pages, just like any other allocated page.
+    static constexpr size_t zeroed_page_pool_capacity = 256;
+    struct ZeroedPagePool {
+        Array<RefPtr<PhysicalPage>, zeroed_page_pool_capacity> pages;
+        size_t count { 0 };
+    };
+    SpinlockProtected<ZeroedPagePool, LockRank::None> m_zeroed_page_pool {};
 };
 
 inline bool is_user_address(VirtualAddress vaddr)
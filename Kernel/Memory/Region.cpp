@@ -107,6 +107,7 @@ ErrorOr<NonnullOwnPtr<Region>> Region::try_clone()
         region->set_mmap(m_mmap, m_mmapped_from_readable, m_mmapped_from_writable);
         region->set_shared(m_shared);
         region->set_syscall_region(is_syscall_region());
+        region->set_access_pattern(m_access_pattern);
         return region;
     }
 
@@ -117,7 +118,7 @@ ErrorOr<NonnullOwnPtr<Region>> Region::try_clone()
 
     // Set up a COW region. The parent (this) region becomes COW as well!
     if (is_writable())
-        remap();
+        remap_for_copy_on_write();
 
     OwnPtr<KString> clone_region_name;
     if (m_name)
@@ -132,6 +133,7 @@ ErrorOr<NonnullOwnPtr<Region>> Region::try_clone()
     }
     clone_region->set_syscall_region(is_syscall_region());
     clone_region->set_mmap(m_mmap, m_mmapped_from_readable, m_mmapped_from_writable);
+    clone_region->set_access_pattern(m_access_pattern);
     return clone_region;
 }
 
@@ -288,6 +290,14 @@ void Region::set_page_directory(PageDirectory& page_directory)
     m_page_directory = page_directory;
 }
 
+void Region::map_lazily(PageDirectory& page_directory)
+{
+    VERIFY(is_user());
+    SpinlockLocker page_lock(page_directory.get_lock());
+    set_page_directory(page_directory);
+    m_lazily_mapped = true;
+}
+
 ErrorOr<void> Region::map(PageDirectory& page_directory, ShouldFlushTLB should_flush_tlb)
 {
     SpinlockLocker page_lock(page_directory.get_lock());
@@ -313,6 +323,25 @@ ErrorOr<void> Region::map(PageDirectory& page_directory, ShouldFlushTLB should_f
     return ENOMEM;
 }
 
+void Region::remap_for_copy_on_write()
+{
+    VERIFY(m_page_directory);
+    if (!vmobject().is_anonymous()) {
+        remap();
+        return;
+    }
+
+    // Only the permissions of entries that are already writable change, so there is no need
+    // to rebuild every entry (and allocate page tables for the holes) like map() does.
+    SpinlockLocker page_lock(m_page_directory->get_lock());
+    for (size_t page_index = 0; page_index < page_count(); ++page_index) {
+        auto* pte = MM.pte(*m_page_directory, vaddr_from_page_index(page_index));
+        if (pte && pte->is_present() && pte->is_writable() && should_cow(page_index))
+            pte->set_writable(false);
+    }
+    MemoryManager::flush_tlb(m_page_directory, vaddr(), page_count());
+}
+
 void Region::remap()
 {
     VERIFY(m_page_directory);
@@ -373,6 +402,15 @@ PageFaultResponse Region::handle_fault(PageFault const& fault)
                 return PageFaultResponse::OutOfMemory;
             return PageFaultResponse::Continue;
         }
+        if (page_slot && m_lazily_mapped) {
+            // The page is there, we just haven't mapped it yet. Map its neighbors while we're at it.
+            // If this was a write to a COW page, we'll come right back with a protection violation.
+            dbgln_if(PAGE_FAULT_DEBUG, "NP(lazy) fault in Region({})[{}] at {}", this, page_index_in_region, fault.vaddr());
+            if (!remap_vmobject_page(translate_to_vmobject_page(page_index_in_region), *page_slot))
+                return PageFaultResponse::OutOfMemory;
+            map_cached_pages_around(page_index_in_region);
+            return PageFaultResponse::Continue;
+        }
         dbgln("BUG! Unexpected NP fault at {}", fault.vaddr());
         dbgln("     - Physical page slot pointer: {:p}", page_slot.ptr());
         if (page_slot) {
@@ -441,9 +479,49 @@ PageFaultResponse Region::handle_zero_fault(size_t page_index_in_region, Physica
         dmesgln("MM: handle_zero_fault was unable to allocate a page table to map {}", new_physical_page);
         return PageFaultResponse::OutOfMemory;
     }
+
+    if (page_in_slot_at_time_of_fault.is_lazy_committed_page())
+        fault_around_lazy_committed_pages(page_index_in_region);
+
     return PageFaultResponse::Continue;
 }
 
+void Region::fault_around_lazy_committed_pages(size_t page_index_in_region)
+{
+    // Big anonymous regions are typically written front to back, and the memory behind their lazily
+    // committed pages is already reserved for us. So instead of taking one zero fault per page,
+    // populate the whole aligned window around the faulting page at once.
+    static constexpr size_t fault_around_page_count = 16;
+    static constexpr size_t fault_around_minimum_region_size = 2 * MiB;
+    static_assert(is_power_of_two(fault_around_page_count));
+
+    if (size() < fault_around_minimum_region_size || !is_writable())
+        return;
+
+    auto& anonymous_vmobject = static_cast<AnonymousVMObject&>(vmobject());
+    auto window_start = page_index_in_region & ~(fault_around_page_count - 1);
+    auto window_end = min(window_start + fault_around_page_count, page_count());
+
+    for (auto page_index = window_start; page_index < window_end; ++page_index) {
+        if (page_index == page_index_in_region)
+            continue;
+
+        RefPtr<PhysicalPage> new_physical_page;
+        {
+            SpinlockLocker locker(vmobject().m_lock);
+            auto& page_slot = physical_page_slot(page_index);
+            if (page_slot.is_null() || !page_slot->is_lazy_committed_page())
+                continue;
+            new_physical_page = anonymous_vmobject.allocate_committed_page({});
+            page_slot = new_physical_page;
+        }
+
+        // NOTE: The page is already installed in the VMObject, so a later fault will map it if this fails.
+        if (!remap_vmobject_page(translate_to_vmobject_page(page_index), *new_physical_page))
+            return;
+    }
+}
+
 PageFaultResponse Region::handle_cow_fault(size_t page_index_in_region)
 {
     auto current_thread = Thread::current();
@@ -460,6 +538,29 @@ PageFaultResponse Region::handle_cow_fault(size_t page_index_in_region)
     return response;
 }
 
+// Inode faults populate (and map) an aligned window of this many pages around the faulting page.
+// Regions that are read sequentially get a bigger window, and randomly accessed ones only read the faulting page.
+static constexpr size_t inode_fault_around_page_count = 16;
+static constexpr size_t sequential_inode_fault_around_page_count = 64;
+static_assert(is_power_of_two(inode_fault_around_page_count));
+static_assert(is_power_of_two(sequential_inode_fault_around_page_count));
+
+static size_t inode_fault_around_page_count_for(Region::AccessPattern access_pattern)
+{
+    switch (access_pattern) {
+    case Region::AccessPattern::Normal:
+        return inode_fault_around_page_count;
+    case Region::AccessPattern::Sequential:
+        return sequential_inode_fault_around_page_count;
+    case Region::AccessPattern::Random:
+        return 1;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+// MAP_POPULATE reads the file in chunks of this many pages.
+static constexpr size_t populate_read_page_count = 32;
+
 PageFaultResponse Region::handle_inode_fault(size_t page_index_in_region)
 {
     VERIFY(vmobject().is_inode());
@@ -470,79 +571,155 @@ PageFaultResponse Region::handle_inode_fault(size_t page_index_in_region)
     auto page_index_in_vmobject = translate_to_vmobject_page(page_index_in_region);
     auto& vmobject_physical_page_slot = inode_vmobject.physical_pages()[page_index_in_vmobject];
 
+    bool page_is_cached = false;
     {
         // NOTE: The VMObject lock is required when manipulating the VMObject's physical page slot.
         SpinlockLocker locker(inode_vmobject.m_lock);
-        if (!vmobject_physical_page_slot.is_null()) {
-            dbgln_if(PAGE_FAULT_DEBUG, "handle_inode_fault: Page faulted in by someone else before reading, remapping.");
-            if (!remap_vmobject_page(page_index_in_vmobject, *vmobject_physical_page_slot))
+        page_is_cached = !vmobject_physical_page_slot.is_null();
+    }
+
+    if (page_is_cached) {
+        dbgln_if(PAGE_FAULT_DEBUG, "handle_inode_fault: Page faulted in by someone else before reading, remapping.");
+    } else {
+        dbgln_if(PAGE_FAULT_DEBUG, "Inode fault in {} page index: {}", name(), page_index_in_region);
+
+        auto current_thread = Thread::current();
+        if (current_thread)
+            current_thread->did_inode_fault();
+
+        // Read the faulting page together with any missing pages after it in the fault-around window.
+        auto window_end = round_up_to_power_of_two(page_index_in_region + 1, inode_fault_around_page_count_for(m_access_pattern));
+        auto result = read_missing_inode_pages(page_index_in_region, window_end - page_index_in_region);
+        if (result.is_error()) {
+            if (result.error().code() == ENOMEM) {
+                dmesgln("MM: handle_inode_fault was unable to allocate a physical page");
                 return PageFaultResponse::OutOfMemory;
-            return PageFaultResponse::Continue;
+            }
+            dmesgln("handle_inode_fault: Error ({}) while reading from inode", result.error());
+            return PageFaultResponse::ShouldCrash;
         }
     }
 
-    dbgln_if(PAGE_FAULT_DEBUG, "Inode fault in {} page index: {}", name(), page_index_in_region);
-
-    auto current_thread = Thread::current();
-    if (current_thread)
-        current_thread->did_inode_fault();
-
-    u8 page_buffer[PAGE_SIZE];
-    auto& inode = inode_vmobject.inode();
-
-    auto buffer = UserOrKernelBuffer::for_kernel_buffer(page_buffer);
-    auto result = inode.read_bytes(page_index_in_vmobject * PAGE_SIZE, PAGE_SIZE, buffer, nullptr);
-
-    if (result.is_error()) {
-        dmesgln("handle_inode_fault: Error ({}) while reading from inode", result.error());
-        return PageFaultResponse::ShouldCrash;
+    RefPtr<PhysicalPage> physical_page;
+    {
+        SpinlockLocker locker(inode_vmobject.m_lock);
+        physical_page = vmobject_physical_page_slot;
     }
 
-    auto nread = result.value();
-    // Note: If we received 0, it means we are at the end of file or after it,
+    // Note: If there's still no page, we are at the end of file or after it,
     // which means we should return bus error.
-    if (nread == 0)
+    if (!physical_page)
         return PageFaultResponse::BusError;
 
-    if (nread < PAGE_SIZE) {
-        // If we read less than a page, zero out the rest to avoid leaking uninitialized data.
-        memset(page_buffer + nread, 0, PAGE_SIZE - nread);
-    }
-
-    // Allocate a new physical page, and copy the read inode contents into it.
-    auto new_physical_page_or_error = MM.allocate_physical_page(MemoryManager::ShouldZeroFill::No);
-    if (new_physical_page_or_error.is_error()) {
-        dmesgln("MM: handle_inode_fault was unable to allocate a physical page");
+    if (!remap_vmobject_page(page_index_in_vmobject, *physical_page))
         return PageFaultResponse::OutOfMemory;
-    }
-    auto new_physical_page = new_physical_page_or_error.release_value();
-    {
-        InterruptDisabler disabler;
-        u8* dest_ptr = MM.quickmap_page(*new_physical_page);
-        memcpy(dest_ptr, page_buffer, PAGE_SIZE);
-        MM.unquickmap_page();
-    }
 
+    map_cached_pages_around(page_index_in_region);
+    return PageFaultResponse::Continue;
+}
+
+ErrorOr<size_t> Region::read_missing_inode_pages(size_t page_index_in_region, size_t max_page_count)
+{
+    VERIFY(vmobject().is_inode());
+    auto& inode_vmobject = static_cast<InodeVMObject&>(vmobject());
+    auto first_page_index_in_vmobject = translate_to_vmobject_page(page_index_in_region);
+    max_page_count = min(max_page_count, page_count() - page_index_in_region);
+
+    // Only read as long as the pages are missing, so we don't replace anything that is already cached.
+    size_t page_count_to_read = 0;
     {
-        // NOTE: The VMObject lock is required when manipulating the VMObject's physical page slot.
         SpinlockLocker locker(inode_vmobject.m_lock);
+        auto pages = inode_vmobject.physical_pages();
+        while (page_count_to_read < max_page_count && pages[first_page_index_in_vmobject + page_count_to_read].is_null())
+            ++page_count_to_read;
+    }
+    if (page_count_to_read == 0)
+        return 0;
 
-        if (!vmobject_physical_page_slot.is_null()) {
-            // Someone else faulted in this page while we were reading from the inode.
-            // No harm done (other than some duplicate work), remap the page here and return.
-            dbgln_if(PAGE_FAULT_DEBUG, "handle_inode_fault: Page faulted in by someone else, remapping.");
-            if (!remap_vmobject_page(page_index_in_vmobject, *vmobject_physical_page_slot))
-                return PageFaultResponse::OutOfMemory;
-            return PageFaultResponse::Continue;
+    auto data = TRY(ByteBuffer::create_uninitialized(page_count_to_read * PAGE_SIZE));
+    auto buffer = UserOrKernelBuffer::for_kernel_buffer(data.data());
+    auto nread = TRY(inode_vmobject.inode().read_bytes(first_page_index_in_vmobject * PAGE_SIZE, data.size(), buffer, nullptr));
+
+    // If we read less than a page, zero out the rest to avoid leaking uninitialized data.
+    auto page_count_read = ceil_div(nread, static_cast<size_t>(PAGE_SIZE));
+    memset(data.data() + nread, 0, page_count_read * PAGE_SIZE - nread);
+
+    for (size_t i = 0; i < page_count_read; ++i) {
+        // Allocate a new physical page, and copy the read inode contents into it.
+        auto new_physical_page = TRY(MM.allocate_physical_page(MemoryManager::ShouldZeroFill::No));
+        {
+            InterruptDisabler disabler;
+            u8* dest_ptr = MM.quickmap_page(*new_physical_page);
+            memcpy(dest_ptr, data.data() + i * PAGE_SIZE, PAGE_SIZE);
+            MM.unquickmap_page();
         }
 
-        vmobject_physical_page_slot = new_physical_page;
+        SpinlockLocker locker(inode_vmobject.m_lock);
+        auto& page_slot = inode_vmobject.physical_pages()[first_page_index_in_vmobject + i];
+        // Someone else may have faulted in this page while we were reading from the inode.
+        // No harm done (other than some duplicate work), we'll just use their page.
+        if (page_slot.is_null())
+            page_slot = move(new_physical_page);
     }
+    return page_count_read;
+}
 
-    if (!remap_vmobject_page(page_index_in_vmobject, *vmobject_physical_page_slot))
-        return PageFaultResponse::OutOfMemory;
+void Region::map_cached_pages_around(size_t page_index_in_region)
+{
+    auto window_start = page_index_in_region & ~(inode_fault_around_page_count - 1);
+    auto window_end = min(window_start + inode_fault_around_page_count, page_count());
 
-    return PageFaultResponse::Continue;
+    SpinlockLocker page_lock(m_page_directory->get_lock());
+    for (auto page_index = window_start; page_index < window_end; ++page_index) {
+        if (page_index == page_index_in_region)
+            continue;
+        auto page = physical_page(page_index);
+        if (!page)
+            continue;
+        // NOTE: We only fill in entries that aren't present. Those are never cached in the TLB, so we don't have to flush it.
+        auto* pte = MM.pte(*m_page_directory, vaddr_from_page_index(page_index));
+        if (pte && pte->is_present())
+            continue;
+        if (!map_individual_page_impl(page_index, move(page)))
+            return;
+    }
+}
+
+ErrorOr<void> Region::populate()
+{
+    return populate(0, page_count());
+}
+
+ErrorOr<void> Region::populate(size_t first_page_index, size_t page_count_to_populate)
+{
+    VERIFY(first_page_index + page_count_to_populate <= page_count());
+    auto end_page_index = first_page_index + page_count_to_populate;
+
+    if (vmobject().is_inode()) {
+        size_t page_index = first_page_index;
+        while (page_index < end_page_index) {
+            if (physical_page(page_index)) {
+                ++page_index;
+                continue;
+            }
+            auto page_count_read = TRY(read_missing_inode_pages(page_index, min(populate_read_page_count, end_page_index - page_index)));
+            // We've reached the end of the file.
+            if (page_count_read == 0)
+                break;
+            page_index += page_count_read;
+        }
+    } else if (vmobject().is_anonymous()) {
+        auto& anonymous_vmobject = static_cast<AnonymousVMObject&>(vmobject());
+        SpinlockLocker locker(vmobject().m_lock);
+        for (size_t page_index = first_page_index; page_index < end_page_index; ++page_index) {
+            auto& page_slot = physical_page_slot(page_index);
+            if (!page_slot.is_null() && page_slot->is_lazy_committed_page())
+                page_slot = anonymous_vmobject.allocate_committed_page({});
+        }
+    }
+
+    remap();
+    return {};
 }
 
 RefPtr<PhysicalPage> Region::physical_page(size_t index) const
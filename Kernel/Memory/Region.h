@@ -192,10 +192,28 @@ public:
 
     void set_page_directory(PageDirectory&);
     ErrorOr<void> map(PageDirectory&, ShouldFlushTLB = ShouldFlushTLB::Yes);
+    // Associates the region with the page directory without creating any page table entries.
+    // Present pages are mapped when they are first faulted on instead.
+    void map_lazily(PageDirectory&);
     void unmap(ShouldFlushTLB = ShouldFlushTLB::Yes);
     void unmap_with_locks_held(ShouldFlushTLB, SpinlockLocker<RecursiveSpinlock<LockRank::None>>& pd_locker);
 
     void remap();
+    void remap_for_copy_on_write();
+
+    // Reads in (or allocates) all pages of this region up front and maps them.
+    ErrorOr<void> populate();
+    ErrorOr<void> populate(size_t first_page_index, size_t page_count);
+
+    // How userspace expects to access the region, as told to us by madvise().
+    // This decides how much of a file is read in around an inode fault.
+    enum class AccessPattern : u8 {
+        Normal,
+        Sequential,
+        Random,
+    };
+    [[nodiscard]] AccessPattern access_pattern() const { return m_access_pattern; }
+    void set_access_pattern(AccessPattern access_pattern) { m_access_pattern = access_pattern; }
 
     [[nodiscard]] bool is_mapped() const { return m_page_directory != nullptr; }
 
@@ -225,6 +243,9 @@ private:
     [[nodiscard]] PageFaultResponse handle_cow_fault(size_t page_index);
     [[nodiscard]] PageFaultResponse handle_inode_fault(size_t page_index);
     [[nodiscard]] PageFaultResponse handle_zero_fault(size_t page_index, PhysicalPage& page_in_slot_at_time_of_fault);
+    void fault_around_lazy_committed_pages(size_t page_index);
+    ErrorOr<size_t> read_missing_inode_pages(size_t page_index, size_t max_page_count);
+    void map_cached_pages_around(size_t page_index);
 
     [[nodiscard]] bool map_individual_page_impl(size_t page_index);
     [[nodiscard]] bool map_individual_page_impl(size_t page_index, RefPtr<PhysicalPage>);
@@ -235,6 +256,7 @@ private:
     LockRefPtr<VMObject> m_vmobject;
     OwnPtr<KString> m_name;
     u8 m_access { Region::None };
+    AccessPattern m_access_pattern { AccessPattern::Normal };
     bool m_shared : 1 { false };
     bool m_cacheable : 1 { false };
     bool m_stack : 1 { false };
@@ -244,6 +266,7 @@ private:
     bool m_write_combine : 1 { false };
     bool m_mmapped_from_readable : 1 { false };
     bool m_mmapped_from_writable : 1 { false };
+    bool m_lazily_mapped : 1 { false };
 
     IntrusiveRedBlackTreeNode<FlatPtr, Region, RawPtr<Region>> m_tree_node;
     IntrusiveListNode<Region> m_vmobject_list_node;
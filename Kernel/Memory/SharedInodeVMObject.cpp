@@ -5,6 +5,7 @@
  */
 
 #include <Kernel/FileSystem/Inode.h>
+#include <Kernel/InterruptDisabler.h>
 #include <Kernel/Locking/Spinlock.h>
 #include <Kernel/Memory/SharedInodeVMObject.h>
 
@@ -69,4 +70,82 @@ ErrorOr<void> SharedInodeVMObject::sync(off_t offset_in_pages, size_t pages)
     return {};
 }
 
+ErrorOr<size_t> SharedInodeVMObject::read_bytes(u64 offset, size_t count, UserOrKernelBuffer& buffer, OpenFileDescription* description) const
+{
+    auto inode_size = static_cast<u64>(m_inode->size());
+    if (offset >= inode_size)
+        return 0;
+    count = min<u64>(count, inode_size - offset);
+
+    size_t nread = 0;
+    while (nread < count) {
+        auto position = offset + nread;
+        auto page_index = position / PAGE_SIZE;
+
+        RefPtr<PhysicalPage> physical_page;
+        size_t first_missing_page_after_run = page_index;
+        {
+            SpinlockLocker locker(m_lock);
+            if (page_index < page_count())
+                physical_page = m_physical_pages[page_index];
+            if (!physical_page) {
+                while (first_missing_page_after_run < page_count() && !m_physical_pages[first_missing_page_after_run])
+                    ++first_missing_page_after_run;
+            }
+        }
+
+        if (physical_page) {
+            auto offset_in_page = position % PAGE_SIZE;
+            auto chunk_size = min(PAGE_SIZE - offset_in_page, count - nread);
+            u8 page_buffer[PAGE_SIZE];
+            MM.copy_physical_page(*physical_page, page_buffer);
+            TRY(buffer.write(page_buffer + offset_in_page, nread, chunk_size));
+            nread += chunk_size;
+            continue;
+        }
+
+        // Read the whole run of non-resident pages from the inode in one go.
+        auto run_size = count - nread;
+        if (first_missing_page_after_run < page_count())
+            run_size = min<u64>(run_size, first_missing_page_after_run * PAGE_SIZE - position);
+        auto run_buffer = buffer.offset(nread);
+        auto nread_from_inode = TRY(m_inode->read_bytes(position, run_size, run_buffer, description));
+        nread += nread_from_inode;
+        if (nread_from_inode < run_size)
+            break;
+    }
+    return nread;
+}
+
+ErrorOr<void> SharedInodeVMObject::update_resident_pages(u64 offset, size_t count, UserOrKernelBuffer const& data)
+{
+    size_t nupdated = 0;
+    while (nupdated < count) {
+        auto position = offset + nupdated;
+        auto page_index = position / PAGE_SIZE;
+        auto offset_in_page = position % PAGE_SIZE;
+        auto chunk_size = min(PAGE_SIZE - offset_in_page, count - nupdated);
+        if (page_index >= page_count())
+            break;
+
+        RefPtr<PhysicalPage> physical_page;
+        {
+            SpinlockLocker locker(m_lock);
+            physical_page = m_physical_pages[page_index];
+        }
+
+        if (physical_page) {
+            // NOTE: Reading from the buffer may fault, so we copy into a local buffer before quickmapping the page.
+            u8 page_buffer[PAGE_SIZE];
+            TRY(data.read(page_buffer, nupdated, chunk_size));
+            InterruptDisabler disabler;
+            u8* page_ptr = MM.quickmap_page(*physical_page);
+            memcpy(page_ptr + offset_in_page, page_buffer, chunk_size);
+            MM.unquickmap_page();
+        }
+        nupdated += chunk_size;
+    }
+    return {};
+}
+
 }
@@ -21,6 +21,11 @@ public:
 
     ErrorOr<void> sync(off_t offset_in_pages = 0, size_t pages = -1);
 
+    // These let read() and write() share the pages of this VMObject, so they stay coherent with shared mappings.
+    // Pages that aren't resident are read from the inode directly.
+    ErrorOr<size_t> read_bytes(u64 offset, size_t count, UserOrKernelBuffer& buffer, OpenFileDescription*) const;
+    ErrorOr<void> update_resident_pages(u64 offset, size_t count, UserOrKernelBuffer const& data);
+
 private:
     virtual bool is_shared_inode() const override { return true; }
 
@@ -6,28 +6,68 @@
 
 #include <Kernel/StdLib.h>
 
+#if ARCH(X86_64)
+// Copies 2 * sizeof(T) bytes and below as the first and the last sizeof(T) bytes, which might overlap.
+// Both are loaded before anything is stored, so this also works for overlapping buffers.
+template<typename T>
+ALWAYS_INLINE static void copy_first_and_last(u8* dest, u8 const* src, size_t n)
+{
+    T first;
+    T last;
+    __builtin_memcpy(&first, src, sizeof(T));
+    __builtin_memcpy(&last, src + n - sizeof(T), sizeof(T));
+    __builtin_memcpy(dest, &first, sizeof(T));
+    __builtin_memcpy(dest + n - sizeof(T), &last, sizeof(T));
+}
+
+template<typename T>
+ALWAYS_INLINE static void fill_first_and_last(u8* dest, u64 value, size_t n)
+{
+    auto truncated_value = static_cast<T>(value);
+    __builtin_memcpy(dest, &truncated_value, sizeof(T));
+    __builtin_memcpy(dest + n - sizeof(T), &truncated_value, sizeof(T));
+}
+#endif
+
 extern "C" {
 
+// NOTE: memmove() relies on this copying front to back.
 void* memcpy(void* dest_ptr, void const* src_ptr, size_t n)
 {
 #if ARCH(X86_64)
-    size_t dest = (size_t)dest_ptr;
-    size_t src = (size_t)src_ptr;
-    // FIXME: Support starting at an unaligned address.
-    if (!(dest & 0x3) && !(src & 0x3) && n >= 12) {
-        size_t size_ts = n / sizeof(size_t);
-        asm volatile(
-            "rep movsq\n"
-            : "=S"(src), "=D"(dest)
-            : "S"(src), "D"(dest), "c"(size_ts)
-            : "memory");
-        n -= size_ts * sizeof(size_t);
-        if (n == 0)
-            return dest_ptr;
+    auto* dest = static_cast<u8*>(dest_ptr);
+    auto const* src = static_cast<u8 const*>(src_ptr);
+
+    // Setting up a string instruction costs more than a few plain moves, so small sizes are handled by hand.
+    if (n <= 16) {
+        if (n >= 8)
+            copy_first_and_last<u64>(dest, src, n);
+        else if (n >= 4)
+            copy_first_and_last<u32>(dest, src, n);
+        else if (n >= 2)
+            copy_first_and_last<u16>(dest, src, n);
+        else if (n == 1)
+            *dest = *src;
+        return dest_ptr;
     }
+
+    // Copy the first and the last eight bytes by hand, so that rep movsq can start at an aligned destination
+    // and doesn't have to care about the bytes left over at the end.
+    u64 first;
+    u64 last;
+    __builtin_memcpy(&first, src, sizeof(u64));
+    __builtin_memcpy(&last, src + n - sizeof(u64), sizeof(u64));
+
+    size_t offset = sizeof(u64) - ((FlatPtr)dest & (sizeof(u64) - 1));
+    size_t qwords = (n - offset) / sizeof(u64);
+    u8* aligned_dest = dest + offset;
+    u8 const* aligned_src = src + offset;
     asm volatile(
-        "rep movsb\n" ::"S"(src), "D"(dest), "c"(n)
-        : "memory");
+        "rep movsq"
+        : "+D"(aligned_dest), "+S"(aligned_src), "+c"(qwords)::"memory");
+
+    __builtin_memcpy(dest, &first, sizeof(u64));
+    __builtin_memcpy(dest + n - sizeof(u64), &last, sizeof(u64));
 #else
     u8* pd = (u8*)dest_ptr;
     u8 const* ps = (u8 const*)src_ptr;
@@ -39,11 +79,20 @@ void* memcpy(void* dest_ptr, void const* src_ptr, size_t n)
 
 void* memmove(void* dest, void const* src, size_t n)
 {
-    if (dest < src)
+    if (((FlatPtr)dest - (FlatPtr)src) >= n)
         return memcpy(dest, src, n);
 
     u8* pd = (u8*)dest;
     u8 const* ps = (u8 const*)src;
+#if ARCH(X86_64)
+    // Copy eight bytes at a time, starting at the end.
+    while (n >= sizeof(u64)) {
+        n -= sizeof(u64);
+        u64 value;
+        __builtin_memcpy(&value, ps + n, sizeof(u64));
+        __builtin_memcpy(pd + n, &value, sizeof(u64));
+    }
+#endif
     for (pd += n, ps += n; n--;)
         *--pd = *--ps;
     return dest;
@@ -52,24 +101,30 @@ void* memmove(void* dest, void const* src, size_t n)
 void* memset(void* dest_ptr, int c, size_t n)
 {
 #if ARCH(X86_64)
-    size_t dest = (size_t)dest_ptr;
-    // FIXME: Support starting at an unaligned address.
-    if (!(dest & 0x3) && n >= 12) {
-        size_t size_ts = n / sizeof(size_t);
-        size_t expanded_c = explode_byte((u8)c);
-        asm volatile(
-            "rep stosq\n"
-            : "=D"(dest)
-            : "D"(dest), "c"(size_ts), "a"(expanded_c)
-            : "memory");
-        n -= size_ts * sizeof(size_t);
-        if (n == 0)
-            return dest_ptr;
+    auto* dest = static_cast<u8*>(dest_ptr);
+    u64 expanded_c = explode_byte((u8)c);
+
+    if (n <= 16) {
+        if (n >= 8)
+            fill_first_and_last<u64>(dest, expanded_c, n);
+        else if (n >= 4)
+            fill_first_and_last<u32>(dest, expanded_c, n);
+        else if (n >= 2)
+            fill_first_and_last<u16>(dest, expanded_c, n);
+        else if (n == 1)
+            *dest = c;
+        return dest_ptr;
     }
+
+    // Same as in memcpy(), fill the ends by hand and let rep stosq do the aligned middle part.
+    fill_first_and_last<u64>(dest, expanded_c, n);
+    size_t offset = sizeof(u64) - ((FlatPtr)dest & (sizeof(u64) - 1));
+    size_t qwords = (n - offset) / sizeof(u64);
+    u8* aligned_dest = dest + offset;
     asm volatile(
-        "rep stosb\n"
-        : "=D"(dest), "=c"(n)
-        : "0"(dest), "1"(n), "a"(c)
+        "rep stosq"
+        : "+D"(aligned_dest), "+c"(qwords)
+        : "a"(expanded_c)
         : "memory");
 #else
     u8* pd = (u8*)dest_ptr;
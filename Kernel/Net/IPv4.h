@@ -28,6 +28,8 @@ NetworkOrdered<u16> internet_checksum(void const*, size_t);
 
 class [[gnu::packed]] IPv4Packet {
 public:
+    static constexpr size_t checksum_offset = 10;
+
     u8 version() const { return (m_version_and_ihl >> 4) & 0xf; }
     void set_version(u8 version) { m_version_and_ihl = (m_version_and_ihl & 0x0f) | (version << 4); }
 
@@ -121,4 +123,19 @@ inline NetworkOrdered<u16> internet_checksum(void const* ptr, size_t count)
     return ~checksum & 0xffff;
 }
 
+// The folded but not inverted sum of the pseudo-header that TCP and UDP checksums cover.
+// This is what checksum offloading adapters expect to find in the checksum field.
+inline u16 ipv4_pseudo_header_sum(IPv4Address const& source, IPv4Address const& destination, IPv4Protocol protocol, u16 length)
+{
+    struct [[gnu::packed]] {
+        IPv4Address source;
+        IPv4Address destination;
+        u8 zero;
+        u8 protocol;
+        NetworkOrdered<u16> length;
+    } pseudo_header { source, destination, 0, static_cast<u8>(protocol), length };
+    static_assert(sizeof(pseudo_header) == 12);
+    return ~static_cast<u16>(internet_checksum(&pseudo_header, sizeof(pseudo_header))) & 0xffff;
+}
+
 }
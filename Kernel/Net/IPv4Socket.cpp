@@ -37,7 +37,7 @@ MutexProtected<IPv4Socket::List>& IPv4Socket::all_sockets()
 
 ErrorOr<NonnullOwnPtr<DoubleBuffer>> IPv4Socket::try_create_receive_buffer()
 {
-    return DoubleBuffer::try_create("IPv4Socket: Receive buffer"sv, 256 * KiB);
+    return DoubleBuffer::try_create("IPv4Socket: Receive buffer"sv, receive_buffer_size);
 }
 
 ErrorOr<NonnullLockRefPtr<Socket>> IPv4Socket::create(int type, int protocol)
@@ -312,7 +312,7 @@ ErrorOr<size_t> IPv4Socket::receive_packet_buffered(OpenFileDescription& descrip
 
             dbgln_if(IPV4_SOCKET_DEBUG, "IPv4Socket({}): recvfrom without blocking {} bytes, packets in queue: {}",
                 this,
-                packet->data->size(),
+                packet->data.size(),
                 m_receive_queue.size());
         }
     }
@@ -349,10 +349,12 @@ ErrorOr<size_t> IPv4Socket::receive_packet_buffered(OpenFileDescription& descrip
 
         dbgln_if(IPV4_SOCKET_DEBUG, "IPv4Socket({}): recvfrom with blocking {} bytes, packets in queue: {}",
             this,
-            packet->data->size(),
+            packet->data.size(),
             m_receive_queue.size());
     }
-    VERIFY(packet->data);
+    VERIFY(packet->buffer);
+    if (packet == &taken_packet && taken_packet.is_adapter_buffer)
+        --m_queued_adapter_buffers;
 
     packet_timestamp = packet->timestamp;
 
@@ -372,12 +374,12 @@ ErrorOr<size_t> IPv4Socket::receive_packet_buffered(OpenFileDescription& descrip
     }
 
     if (type() == SOCK_RAW) {
-        size_t bytes_written = min(packet->data->size(), buffer_length);
-        SOCKET_TRY(buffer.write(packet->data->data(), bytes_written));
+        size_t bytes_written = min(packet->data.size(), buffer_length);
+        SOCKET_TRY(buffer.write(packet->data.data(), bytes_written));
         return bytes_written;
     }
 
-    return protocol_receive(packet->data->bytes(), buffer, buffer_length, flags);
+    return protocol_receive(packet->data, buffer, buffer_length, flags);
 }
 
 ErrorOr<size_t> IPv4Socket::recvfrom(OpenFileDescription& description, UserOrKernelBuffer& buffer, size_t buffer_length, int flags, Userspace<sockaddr*> user_addr, Userspace<socklen_t*> user_addr_length, Time& packet_timestamp, bool blocking)
@@ -413,7 +415,7 @@ ErrorOr<size_t> IPv4Socket::recvfrom(OpenFileDescription& description, UserOrKer
     return total_nreceived;
 }
 
-bool IPv4Socket::did_receive(IPv4Address const& source_address, u16 source_port, ReadonlyBytes packet, Time const& packet_timestamp)
+bool IPv4Socket::did_receive(IPv4Address const& source_address, u16 source_port, ReadonlyBytes packet, PacketWithTimestamp& packet_buffer)
 {
     MutexLocker locker(mutex());
 
@@ -444,16 +446,32 @@ bool IPv4Socket::did_receive(IPv4Address const& source_address, u16 source_port,
             dbgln("IPv4Socket({}): did_receive refusing packet since queue is full.", this);
             return false;
         }
-        auto data_or_error = KBuffer::try_create_with_bytes("IPv4Socket: Packet buffer"sv, packet);
-        if (data_or_error.is_error()) {
-            dbgln("IPv4Socket: did_receive unable to allocate storage for incoming packet.");
-            return false;
+        ReceivedPacket received_packet { source_address, source_port, packet_buffer.timestamp, {}, {} };
+        if (m_queued_adapter_buffers < max_queued_adapter_buffers) {
+            received_packet.buffer = packet_buffer;
+            received_packet.data = packet;
+            received_packet.is_adapter_buffer = true;
+        } else {
+            auto data_or_error = KBuffer::try_create_with_bytes("IPv4Socket: Packet buffer"sv, packet);
+            if (data_or_error.is_error()) {
+                dbgln("IPv4Socket: did_receive unable to allocate storage for incoming packet.");
+                return false;
+            }
+            received_packet.buffer = adopt_lock_ref_if_nonnull(new (nothrow) PacketWithTimestamp { data_or_error.release_value(), packet_buffer.timestamp });
+            if (!received_packet.buffer) {
+                dbgln("IPv4Socket: did_receive unable to allocate storage for incoming packet.");
+                return false;
+            }
+            received_packet.data = received_packet.buffer->bytes();
         }
-        auto result = m_receive_queue.try_append({ source_address, source_port, packet_timestamp, data_or_error.release_value() });
+        bool is_adapter_buffer = received_packet.is_adapter_buffer;
+        auto result = m_receive_queue.try_append(move(received_packet));
         if (result.is_error()) {
             dbgln("IPv4Socket: Dropped incoming packet because appending to the receive queue failed.");
             return false;
         }
+        if (is_adapter_buffer)
+            ++m_queued_adapter_buffers;
         set_can_read(true);
     }
     m_bytes_received += packet_size;
@@ -504,10 +522,10 @@ ErrorOr<NonnullOwnPtr<KString>> IPv4Socket::pseudo_path(OpenFileDescription cons
     return KString::try_create(builder.string_view());
 }
 
-ErrorOr<void> IPv4Socket::setsockopt(int level, int option, Userspace<void const*> user_value, socklen_t user_value_size)
+ErrorOr<void> IPv4Socket::setsockopt(OpenFileDescription& description, int level, int option, Userspace<void const*> user_value, socklen_t user_value_size)
 {
     if (level != IPPROTO_IP)
-        return Socket::setsockopt(level, option, user_value, user_value_size);
+        return Socket::setsockopt(description, level, option, user_value, user_value_size);
 
     MutexLocker locker(mutex());
 
@@ -816,7 +834,7 @@ ErrorOr<void> IPv4Socket::ioctl(OpenFileDescription&, unsigned request, Userspac
             readable = static_cast<int>(m_receive_buffer->immediately_readable());
         } else {
             if (m_receive_queue.size() != 0u) {
-                readable = static_cast<int>(TRY(protocol_size(m_receive_queue.first().data->bytes())));
+                readable = static_cast<int>(TRY(protocol_size(m_receive_queue.first().data)));
             }
         }
 
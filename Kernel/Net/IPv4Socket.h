@@ -13,6 +13,7 @@
 #include <Kernel/Locking/MutexProtected.h>
 #include <Kernel/Net/IPv4.h>
 #include <Kernel/Net/IPv4SocketTuple.h>
+#include <Kernel/Net/NetworkAdapter.h>
 #include <Kernel/Net/Socket.h>
 
 namespace Kernel {
@@ -41,12 +42,12 @@ public:
     virtual bool can_write(OpenFileDescription const&, u64) const override;
     virtual ErrorOr<size_t> sendto(OpenFileDescription&, UserOrKernelBuffer const&, size_t, int, Userspace<sockaddr const*>, socklen_t) override;
     virtual ErrorOr<size_t> recvfrom(OpenFileDescription&, UserOrKernelBuffer&, size_t, int flags, Userspace<sockaddr*>, Userspace<socklen_t*>, Time&, bool blocking) override;
-    virtual ErrorOr<void> setsockopt(int level, int option, Userspace<void const*>, socklen_t) override;
+    virtual ErrorOr<void> setsockopt(OpenFileDescription&, int level, int option, Userspace<void const*>, socklen_t) override;
     virtual ErrorOr<void> getsockopt(OpenFileDescription&, int level, int option, Userspace<void*>, Userspace<socklen_t*>) override;
 
     virtual ErrorOr<void> ioctl(OpenFileDescription&, unsigned request, Userspace<void*> arg) override;
 
-    bool did_receive(IPv4Address const& peer_address, u16 peer_port, ReadonlyBytes, Time const&);
+    bool did_receive(IPv4Address const& peer_address, u16 peer_port, ReadonlyBytes, PacketWithTimestamp&);
 
     IPv4Address const& local_address() const { return m_local_address; }
     u16 local_port() const { return m_local_port; }
@@ -92,6 +93,7 @@ protected:
     void set_local_address(IPv4Address address) { m_local_address = address; }
     void set_peer_address(IPv4Address address) { m_peer_address = address; }
 
+    static constexpr size_t receive_buffer_size = 256 * KiB;
     static ErrorOr<NonnullOwnPtr<DoubleBuffer>> try_create_receive_buffer();
     void drop_receive_buffer();
 
@@ -113,9 +115,17 @@ private:
         IPv4Address peer_address;
         u16 peer_port;
         Time timestamp;
-        OwnPtr<KBuffer> data;
+        // Either the adapter buffer the packet arrived in, or our own copy of the packet.
+        LockRefPtr<PacketWithTimestamp> buffer;
+        ReadonlyBytes data;
+        bool is_adapter_buffer { false };
     };
 
+    // Queued packets keep their adapter buffers out of the adapter's receive pool,
+    // so past this many we copy them instead.
+    static constexpr size_t max_queued_adapter_buffers = 32;
+    size_t m_queued_adapter_buffers { 0 };
+
     SinglyLinkedList<ReceivedPacket, CountingSizeCalculationPolicy> m_receive_queue;
 
     OwnPtr<DoubleBuffer> m_receive_buffer;
@@ -81,6 +81,25 @@ namespace Kernel {
 #define CMD_VLE (1 << 6)  // VLAN Packet Enable
 #define CMD_IDE (1 << 7)  // Interrupt Delay Enable
 
+// Context and extended data descriptors
+
+#define DTYP_CONTEXT (0 << 20)
+#define DTYP_DATA (1 << 20)
+
+#define TUCMD_TCP (1 << 24)  // Packet is TCP (not UDP)
+#define TUCMD_IP (1 << 25)   // Packet is IPv4
+#define TUCMD_TSE (1 << 26)  // TCP Segmentation Enable
+#define TUCMD_DEXT (1 << 29) // Descriptor Extension
+
+#define DCMD_EOP (1 << 24)  // End of Packet
+#define DCMD_IFCS (1 << 25) // Insert FCS
+#define DCMD_TSE (1 << 26)  // TCP Segmentation Enable
+#define DCMD_RS (1 << 27)   // Report Status
+#define DCMD_DEXT (1 << 29) // Descriptor Extension
+
+#define POPTS_IXSM (1 << 0) // Insert IP Checksum
+#define POPTS_TXSM (1 << 1) // Insert TCP/UDP Checksum
+
 // TCTL Register
 
 #define TCTL_EN (1 << 1)      // Transmit Enable
@@ -238,6 +257,8 @@ UNMAP_AFTER_INIT E1000NetworkAdapter::E1000NetworkAdapter(PCI::DeviceIdentifier
     , m_rx_buffer_region(move(rx_buffer_region))
     , m_tx_buffer_region(move(tx_buffer_region))
 {
+    // A segmented packet has to fit into a single transmit buffer.
+    set_offloads(NetworkAdapterOffload::TransmitChecksum | NetworkAdapterOffload::TCPSegmentation, tx_buffer_size - layer3_payload_offset());
 }
 
 UNMAP_AFTER_INIT E1000NetworkAdapter::~E1000NetworkAdapter() = default;
@@ -345,12 +366,11 @@ UNMAP_AFTER_INIT void E1000NetworkAdapter::initialize_rx_descriptors()
 UNMAP_AFTER_INIT void E1000NetworkAdapter::initialize_tx_descriptors()
 {
     auto* tx_descriptors = (e1000_tx_desc*)m_tx_descriptors_region->vaddr().as_ptr();
-    constexpr auto tx_buffer_page_count = tx_buffer_size / PAGE_SIZE;
 
     for (size_t i = 0; i < number_of_tx_descriptors; ++i) {
         auto& descriptor = tx_descriptors[i];
         m_tx_buffers[i] = m_tx_buffer_region->vaddr().as_ptr() + tx_buffer_size * i;
-        descriptor.addr = m_tx_buffer_region->physical_page(tx_buffer_page_count * i)->paddr().get();
+        descriptor.addr = tx_buffer_physical_address(i);
         descriptor.cmd = 0;
     }
 
@@ -400,19 +420,64 @@ u32 E1000NetworkAdapter::in32(u16 address)
     return m_registers_io_window->read32(address);
 }
 
-void E1000NetworkAdapter::send_raw(ReadonlyBytes payload)
+void E1000NetworkAdapter::send_raw(ReadonlyBytes payload, TransmitOffload const& offload)
 {
     disable_irq();
     size_t tx_current = in32(REG_TXDESCTAIL) % number_of_tx_descriptors;
     dbgln_if(E1000_DEBUG, "E1000: Sending packet ({} bytes)", payload.size());
     auto* tx_descriptors = (e1000_tx_desc*)m_tx_descriptors_region->vaddr().as_ptr();
+    VERIFY(payload.size() <= tx_buffer_size);
+
+    if (offload.segment_size) {
+        // A context descriptor takes up its slot, so the data goes into the buffer of the next one.
+        VERIFY(offload.checksum && offload.protocol == IPv4Protocol::TCP);
+        auto& context = *reinterpret_cast<e1000_tx_context_desc*>(&tx_descriptors[tx_current]);
+        context.ipcss = layer3_payload_offset();
+        context.ipcso = layer3_payload_offset() + IPv4Packet::checksum_offset;
+        context.ipcse = offload.checksum_start - 1;
+        context.tucss = offload.checksum_start;
+        context.tucso = offload.checksum_offset;
+        context.tucse = 0;
+        context.paylen_dtyp_tucmd = (payload.size() - offload.header_size) | DTYP_CONTEXT | TUCMD_TCP | TUCMD_IP | TUCMD_TSE | TUCMD_DEXT;
+        context.status = 0;
+        context.hdrlen = offload.header_size;
+        context.mss = offload.segment_size;
+        dbgln_if(E1000_DEBUG, "E1000: Using tx descriptor {} for segmentation context (mss {})", tx_current, offload.segment_size);
+        tx_current = (tx_current + 1) % number_of_tx_descriptors;
+
+        auto* vptr = (u8*)m_tx_buffers[tx_current];
+        memcpy(vptr, payload.data(), payload.size());
+        // The hardware fills in the length and header checksum of each segment it generates.
+        auto& ipv4_packet = *reinterpret_cast<IPv4Packet*>(vptr + layer3_payload_offset());
+        ipv4_packet.set_length(0);
+        ipv4_packet.set_checksum(0);
+
+        auto& data = *reinterpret_cast<e1000_tx_data_desc*>(&tx_descriptors[tx_current]);
+        data.addr = tx_buffer_physical_address(tx_current);
+        data.dtalen_dtyp_dcmd = payload.size() | DTYP_DATA | DCMD_EOP | DCMD_IFCS | DCMD_TSE | DCMD_RS | DCMD_DEXT;
+        data.status = 0;
+        data.popts = POPTS_IXSM | POPTS_TXSM;
+        data.special = 0;
+    } else {
+        auto& descriptor = tx_descriptors[tx_current];
+        auto* vptr = (void*)m_tx_buffers[tx_current];
+        memcpy(vptr, payload.data(), payload.size());
+        // A context descriptor may have been written into this slot before, so restore its buffer address.
+        descriptor.addr = tx_buffer_physical_address(tx_current);
+        descriptor.length = payload.size();
+        descriptor.status = 0;
+        descriptor.cmd = CMD_EOP | CMD_IFCS | CMD_RS | (offload.checksum ? CMD_IC : 0);
+        if (offload.checksum) {
+            descriptor.cso = offload.checksum_offset;
+            descriptor.css = offload.checksum_start;
+        } else {
+            descriptor.cso = 0;
+            descriptor.css = 0;
+        }
+        descriptor.special = 0;
+    }
+
     auto& descriptor = tx_descriptors[tx_current];
-    VERIFY(payload.size() <= 8192);
-    auto* vptr = (void*)m_tx_buffers[tx_current];
-    memcpy(vptr, payload.data(), payload.size());
-    descriptor.length = payload.size();
-    descriptor.status = 0;
-    descriptor.cmd = CMD_EOP | CMD_IFCS | CMD_RS;
     dbgln_if(E1000_DEBUG, "E1000: Using tx descriptor {} (head is at {})", tx_current, in32(REG_TXDESCHEAD));
     tx_current = (tx_current + 1) % number_of_tx_descriptors;
     Processor::disable_interrupts();
@@ -26,7 +26,7 @@ public:
 
     virtual ~E1000NetworkAdapter() override;
 
-    virtual void send_raw(ReadonlyBytes) override;
+    virtual void send_raw(ReadonlyBytes, TransmitOffload const&) override;
     virtual bool link_up() override { return m_link_up; };
     virtual i32 link_speed() override;
     virtual bool link_full_duplex() override;
@@ -69,12 +69,38 @@ protected:
         volatile uint16_t special { 0 };
     };
 
+    // Occupies a transmit descriptor slot and tells the hardware how to segment and checksum
+    // the data descriptors that follow it.
+    struct [[gnu::packed]] e1000_tx_context_desc {
+        volatile uint8_t ipcss { 0 };
+        volatile uint8_t ipcso { 0 };
+        volatile uint16_t ipcse { 0 };
+        volatile uint8_t tucss { 0 };
+        volatile uint8_t tucso { 0 };
+        volatile uint16_t tucse { 0 };
+        volatile uint32_t paylen_dtyp_tucmd { 0 };
+        volatile uint8_t status { 0 };
+        volatile uint8_t hdrlen { 0 };
+        volatile uint16_t mss { 0 };
+    };
+    static_assert(sizeof(e1000_tx_context_desc) == sizeof(e1000_tx_desc));
+
+    struct [[gnu::packed]] e1000_tx_data_desc {
+        volatile uint64_t addr { 0 };
+        volatile uint32_t dtalen_dtyp_dcmd { 0 };
+        volatile uint8_t status { 0 };
+        volatile uint8_t popts { 0 };
+        volatile uint16_t special { 0 };
+    };
+    static_assert(sizeof(e1000_tx_data_desc) == sizeof(e1000_tx_desc));
+
     virtual void detect_eeprom();
     virtual u32 read_eeprom(u8 address);
     void read_mac_address();
 
     void initialize_rx_descriptors();
     void initialize_tx_descriptors();
+    u64 tx_buffer_physical_address(size_t index) const { return m_tx_buffer_region->physical_page(tx_buffer_size / PAGE_SIZE * index)->paddr().get(); }
 
     void out8(u16 address, u8);
     void out16(u16 address, u16);
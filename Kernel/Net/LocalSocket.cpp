@@ -45,8 +45,8 @@ ErrorOr<void> LocalSocket::try_for_each(Function<ErrorOr<void>(LocalSocket const
 
 ErrorOr<NonnullLockRefPtr<LocalSocket>> LocalSocket::try_create(int type)
 {
-    auto client_buffer = TRY(DoubleBuffer::try_create("LocalSocket: Client buffer"sv));
-    auto server_buffer = TRY(DoubleBuffer::try_create("LocalSocket: Server buffer"sv));
+    auto client_buffer = TRY(DoubleBuffer::try_create("LocalSocket: Client buffer"sv, initial_buffer_size, maximum_buffer_size));
+    auto server_buffer = TRY(DoubleBuffer::try_create("LocalSocket: Server buffer"sv, initial_buffer_size, maximum_buffer_size));
     return adopt_nonnull_lock_ref_or_enomem(new (nothrow) LocalSocket(type, move(client_buffer), move(server_buffer)));
 }
 
@@ -391,6 +391,31 @@ ErrorOr<NonnullOwnPtr<KString>> LocalSocket::pseudo_path(OpenFileDescription con
     return KString::try_create(builder.string_view());
 }
 
+DoubleBuffer& LocalSocket::buffer_for_option(OpenFileDescription const& description, int option)
+{
+    VERIFY(option == SO_SNDBUF || option == SO_RCVBUF);
+    // Anything but the accepted side will be (or already is) the connecting side.
+    bool is_accept_side = role(description) == Role::Accepted;
+    bool is_send_buffer = option == SO_SNDBUF;
+    return is_accept_side == is_send_buffer ? *m_for_client : *m_for_server;
+}
+
+ErrorOr<void> LocalSocket::setsockopt(OpenFileDescription& description, int level, int option, Userspace<void const*> user_value, socklen_t user_value_size)
+{
+    if (level != SOL_SOCKET || (option != SO_SNDBUF && option != SO_RCVBUF))
+        return Socket::setsockopt(description, level, option, user_value, user_value_size);
+
+    MutexLocker locker(mutex());
+
+    if (user_value_size != sizeof(int))
+        return EINVAL;
+    int value = TRY(copy_typed_from_user(static_ptr_cast<int const*>(user_value)));
+    if (value <= 0)
+        return EINVAL;
+    auto size = clamp<size_t>(value, PAGE_SIZE, maximum_buffer_size);
+    return buffer_for_option(description, option).try_set_capacity(size);
+}
+
 ErrorOr<void> LocalSocket::getsockopt(OpenFileDescription& description, int level, int option, Userspace<void*> value, Userspace<socklen_t*> value_size)
 {
     if (level != SOL_SOCKET)
@@ -403,9 +428,14 @@ ErrorOr<void> LocalSocket::getsockopt(OpenFileDescription& description, int leve
 
     switch (option) {
     case SO_SNDBUF:
-        return ENOTSUP;
-    case SO_RCVBUF:
-        return ENOTSUP;
+    case SO_RCVBUF: {
+        if (size < sizeof(int))
+            return EINVAL;
+        int capacity = buffer_for_option(description, option).capacity();
+        TRY(copy_to_user(static_ptr_cast<int*>(value), &capacity));
+        size = sizeof(int);
+        return copy_to_user(value_size, &size);
+    }
     case SO_PEERCRED: {
         if (size < sizeof(ucred))
             return EINVAL;
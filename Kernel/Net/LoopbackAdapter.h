@@ -20,7 +20,7 @@ public:
 
     virtual ErrorOr<void> initialize(Badge<NetworkingManagement>) override { VERIFY_NOT_REACHED(); }
 
-    virtual void send_raw(ReadonlyBytes) override;
+    virtual void send_raw(ReadonlyBytes, TransmitOffload const&) override;
     virtual StringView class_name() const override { return "LoopbackAdapter"sv; }
     virtual Type adapter_type() const override { return Type::Loopback; }
     virtual bool link_up() override { return true; }
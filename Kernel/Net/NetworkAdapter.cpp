@@ -5,7 +5,6 @@
  */
 
 #include <Kernel/Heap/kmalloc.h>
-#include <Kernel/InterruptDisabler.h>
 #include <Kernel/Net/EtherType.h>
 #include <Kernel/Net/NetworkAdapter.h>
 #include <Kernel/Net/NetworkingManagement.h>
@@ -21,11 +20,13 @@ NetworkAdapter::NetworkAdapter(NonnullOwnPtr<KString> interface_name)
 
 NetworkAdapter::~NetworkAdapter() = default;
 
-void NetworkAdapter::send_packet(ReadonlyBytes packet)
+void NetworkAdapter::send_packet(ReadonlyBytes packet, TransmitOffload const& offload)
 {
+    VERIFY(!offload.checksum || has_offload(NetworkAdapterOffload::TransmitChecksum));
+    VERIFY(!offload.segment_size || has_offload(NetworkAdapterOffload::TCPSegmentation));
     m_packets_out++;
     m_bytes_out += packet.size();
-    send_raw(packet);
+    send_raw(packet, offload);
 }
 
 void NetworkAdapter::send(MACAddress const& destination, ARPPacket const& packet)
@@ -47,7 +48,7 @@ void NetworkAdapter::send(MACAddress const& destination, ARPPacket const& packet
 void NetworkAdapter::fill_in_ipv4_header(PacketWithTimestamp& packet, IPv4Address const& source_ipv4, MACAddress const& destination_mac, IPv4Address const& destination_ipv4, IPv4Protocol protocol, size_t payload_size, u8 type_of_service, u8 ttl)
 {
     size_t ipv4_packet_size = sizeof(IPv4Packet) + payload_size;
-    VERIFY(ipv4_packet_size <= mtu());
+    VERIFY(ipv4_packet_size <= max<size_t>(mtu(), m_maximum_segmentation_size));
 
     size_t ethernet_frame_size = ipv4_payload_offset() + payload_size;
     VERIFY(packet.buffer->size() == ethernet_frame_size);
@@ -69,46 +70,102 @@ void NetworkAdapter::fill_in_ipv4_header(PacketWithTimestamp& packet, IPv4Addres
     ipv4.set_checksum(ipv4.compute_checksum());
 }
 
-void NetworkAdapter::did_receive(ReadonlyBytes payload)
+ErrorOr<void> NetworkAdapter::initialize_receive_buffer_pool()
 {
-    InterruptDisabler disabler;
-    m_packets_in++;
-    m_bytes_in += payload.size();
+    VERIFY(m_receive_buffer_pool.is_empty());
+    auto buffer_size = layer3_payload_offset() + mtu();
+    auto buffer_count = clamp(receive_buffer_pool_budget / buffer_size, minimum_receive_buffer_count, maximum_receive_buffer_count);
+    TRY(m_receive_buffer_pool.try_ensure_capacity(buffer_count));
+    for (size_t i = 0; i < buffer_count; ++i) {
+        auto buffer = TRY(KBuffer::try_create_with_size("NetworkAdapter: Receive buffer"sv, buffer_size, Memory::Region::Access::ReadWrite, AllocationStrategy::AllocateNow));
+        auto packet = TRY(adopt_nonnull_lock_ref_or_enomem(new (nothrow) PacketWithTimestamp { move(buffer), {} }));
+        m_receive_buffer_pool.unchecked_append(move(packet));
+    }
+    m_receive_buffer_size = buffer_size;
+    return {};
+}
 
-    if (m_packet_queue_size == max_packet_buffers) {
-        // FIXME: Keep track of the number of dropped packets
-        return;
+LockRefPtr<PacketWithTimestamp> NetworkAdapter::take_unused_receive_buffer(size_t size)
+{
+    VERIFY(m_receive_lock.is_locked());
+    if (size > m_receive_buffer_size)
+        return {};
+
+    auto pool_size = m_receive_buffer_pool.size();
+    for (size_t i = 0; i < pool_size; ++i) {
+        auto index = (m_next_receive_buffer_index + i) % pool_size;
+        auto& packet = m_receive_buffer_pool[index];
+        // Nobody can take a new reference to a buffer the pool owns exclusively,
+        // since all of them are handed out here with m_receive_lock held.
+        if (packet->ref_count() != 1)
+            continue;
+        AK::atomic_thread_fence(AK::MemoryOrder::memory_order_acquire);
+        m_next_receive_buffer_index = index + 1;
+        packet->buffer->set_size(size);
+        packet->timestamp = kgettimeofday();
+        return packet;
+    }
+    return {};
+}
+
+void NetworkAdapter::did_receive(ReadonlyBytes payload)
+{
+    LockRefPtr<PacketWithTimestamp> packet;
+    {
+        SpinlockLocker locker(m_receive_lock);
+        m_packets_in++;
+        m_bytes_in += payload.size();
+
+        if (m_packet_queue_size == max_packet_buffers) {
+            m_packets_dropped++;
+            return;
+        }
+
+        packet = take_unused_receive_buffer(payload.size());
     }
 
-    auto packet = acquire_packet_buffer(payload.size());
     if (!packet) {
-        dbgln("Discarding packet because we're out of memory");
-        return;
+        // Every buffer in the pool is still in use, so this one is only used once.
+        packet = allocate_packet_buffer(payload.size());
+        if (!packet) {
+            dbgln("Discarding packet because we're out of memory");
+            SpinlockLocker locker(m_receive_lock);
+            m_packets_dropped++;
+            return;
+        }
     }
 
     memcpy(packet->buffer->data(), payload.data(), payload.size());
 
-    m_packet_queue.append(*packet);
-    m_packet_queue_size++;
+    {
+        SpinlockLocker locker(m_receive_lock);
+        m_packet_queue.append(*packet);
+        m_packet_queue_size++;
+    }
 
     if (on_receive)
         on_receive();
 }
 
-size_t NetworkAdapter::dequeue_packet(u8* buffer, size_t buffer_size, Time& packet_timestamp)
+LockRefPtr<PacketWithTimestamp> NetworkAdapter::dequeue_packet()
 {
-    InterruptDisabler disabler;
+    SpinlockLocker locker(m_receive_lock);
     if (m_packet_queue.is_empty())
-        return 0;
-    auto packet_with_timestamp = m_packet_queue.take_first();
+        return {};
     m_packet_queue_size--;
-    packet_timestamp = packet_with_timestamp->timestamp;
-    auto& packet_buffer = packet_with_timestamp->buffer;
-    size_t packet_size = packet_buffer->size();
-    VERIFY(packet_size <= buffer_size);
-    memcpy(buffer, packet_buffer->data(), packet_size);
-    release_packet_buffer(*packet_with_timestamp);
-    return packet_size;
+    return m_packet_queue.take_first();
+}
+
+LockRefPtr<PacketWithTimestamp> NetworkAdapter::allocate_packet_buffer(size_t size)
+{
+    auto buffer_or_error = KBuffer::try_create_with_size("NetworkAdapter: Packet buffer"sv, size, Memory::Region::Access::ReadWrite, AllocationStrategy::AllocateNow);
+    if (buffer_or_error.is_error())
+        return {};
+    auto packet = adopt_lock_ref_if_nonnull(new (nothrow) PacketWithTimestamp { buffer_or_error.release_value(), kgettimeofday() });
+    if (!packet)
+        return {};
+    packet->buffer->set_size(size);
+    return packet;
 }
 
 LockRefPtr<PacketWithTimestamp> NetworkAdapter::acquire_packet_buffer(size_t size)
@@ -132,14 +189,7 @@ LockRefPtr<PacketWithTimestamp> NetworkAdapter::acquire_packet_buffer(size_t siz
         return packet;
     }
 
-    auto buffer_or_error = KBuffer::try_create_with_size("NetworkAdapter: Packet buffer"sv, size, Memory::Region::Access::ReadWrite, AllocationStrategy::AllocateNow);
-    if (buffer_or_error.is_error())
-        return {};
-    packet = adopt_lock_ref_if_nonnull(new (nothrow) PacketWithTimestamp { buffer_or_error.release_value(), kgettimeofday() });
-    if (!packet)
-        return {};
-    packet->buffer->set_size(size);
-    return packet;
+    return allocate_packet_buffer(size);
 }
 
 void NetworkAdapter::release_packet_buffer(PacketWithTimestamp& packet)
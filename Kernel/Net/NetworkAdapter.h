@@ -8,6 +8,7 @@
 
 #include <AK/AtomicRefCounted.h>
 #include <AK/ByteBuffer.h>
+#include <AK/EnumBits.h>
 #include <AK/Function.h>
 #include <AK/IntrusiveList.h>
 #include <AK/MACAddress.h>
@@ -16,6 +17,7 @@
 #include <Kernel/KBuffer.h>
 #include <Kernel/Library/LockWeakPtr.h>
 #include <Kernel/Library/LockWeakable.h>
+#include <Kernel/Locking/Spinlock.h>
 #include <Kernel/Net/ARP.h>
 #include <Kernel/Net/EthernetFrameHeader.h>
 #include <Kernel/Net/ICMP.h>
@@ -42,6 +44,30 @@ struct PacketWithTimestamp final : public AtomicRefCounted<PacketWithTimestamp>
     IntrusiveListNode<PacketWithTimestamp, LockRefPtr<PacketWithTimestamp>> packet_node;
 };
 
+enum class NetworkAdapterOffload : u8 {
+    None = 0,
+    // The adapter computes TCP and UDP checksums over IPv4.
+    TransmitChecksum = 1 << 0,
+    // The adapter splits TCP segments that are larger than the MTU.
+    TCPSegmentation = 1 << 1,
+};
+
+AK_ENUM_BITWISE_OPERATORS(NetworkAdapterOffload);
+
+// Work that the protocol left for the adapter to do on an outgoing frame. Offsets are relative
+// to the start of the frame. When offloading the checksum, the checksum field must already hold
+// the (non-inverted) pseudo-header sum, like Linux's CHECKSUM_PARTIAL. For segmentation that sum
+// leaves out the length, since the adapter fills it in per segment.
+struct TransmitOffload {
+    bool checksum { false };
+    IPv4Protocol protocol { IPv4Protocol::TCP };
+    u16 checksum_start { 0 };
+    u16 checksum_offset { 0 };
+    // If non-zero, the TCP payload after the first header_size bytes is sent as segments of at most this size.
+    u16 segment_size { 0 };
+    u16 header_size { 0 };
+};
+
 class NetworkingManagement;
 class NetworkAdapter
     : public AtomicRefCounted<NetworkAdapter>
@@ -73,15 +99,28 @@ public:
     }
     virtual bool link_full_duplex() { return false; }
 
+    NetworkAdapterOffload offloads() const { return m_offloads; }
+    bool has_offload(NetworkAdapterOffload offload) const { return has_flag(m_offloads, offload); }
+    // The largest IPv4 packet that may be handed down for TCP segmentation.
+    size_t maximum_segmentation_size() const { return m_maximum_segmentation_size; }
+
     void set_ipv4_address(IPv4Address const&);
     void set_ipv4_netmask(IPv4Address const&);
 
     void send(MACAddress const&, ARPPacket const&);
     void fill_in_ipv4_header(PacketWithTimestamp&, IPv4Address const&, MACAddress const&, IPv4Address const&, IPv4Protocol, size_t, u8 type_of_service, u8 ttl);
 
-    size_t dequeue_packet(u8* buffer, size_t buffer_size, Time& packet_timestamp);
+    ErrorOr<void> initialize_receive_buffer_pool();
 
-    bool has_queued_packets() const { return !m_packet_queue.is_empty(); }
+    // The returned packet is processed in place. Dropping the last reference to it gives
+    // the buffer back to the receive buffer pool.
+    LockRefPtr<PacketWithTimestamp> dequeue_packet();
+
+    bool has_queued_packets() const
+    {
+        SpinlockLocker locker(m_receive_lock);
+        return !m_packet_queue.is_empty();
+    }
 
     u32 mtu() const { return m_mtu; }
     void set_mtu(u32 mtu) { m_mtu = mtu; }
@@ -90,6 +129,7 @@ public:
     u32 bytes_in() const { return m_bytes_in; }
     u32 packets_out() const { return m_packets_out; }
     u32 bytes_out() const { return m_bytes_out; }
+    u32 packets_dropped() const { return m_packets_dropped; }
 
     LockRefPtr<PacketWithTimestamp> acquire_packet_buffer(size_t);
     void release_packet_buffer(PacketWithTimestamp&);
@@ -99,24 +139,44 @@ public:
 
     Function<void()> on_receive;
 
-    void send_packet(ReadonlyBytes);
+    void send_packet(ReadonlyBytes, TransmitOffload const& = {});
 
 protected:
     NetworkAdapter(NonnullOwnPtr<KString>);
     void set_mac_address(MACAddress const& mac_address) { m_mac_address = mac_address; }
     void did_receive(ReadonlyBytes);
-    virtual void send_raw(ReadonlyBytes) = 0;
+    virtual void send_raw(ReadonlyBytes, TransmitOffload const&) = 0;
+
+    void set_offloads(NetworkAdapterOffload offloads, size_t maximum_segmentation_size = 0)
+    {
+        m_offloads = offloads;
+        m_maximum_segmentation_size = maximum_segmentation_size;
+    }
 
 private:
     MACAddress m_mac_address;
     IPv4Address m_ipv4_address;
     IPv4Address m_ipv4_netmask;
 
+    static LockRefPtr<PacketWithTimestamp> allocate_packet_buffer(size_t);
+    LockRefPtr<PacketWithTimestamp> take_unused_receive_buffer(size_t);
+
     // FIXME: Make this configurable
     static constexpr size_t max_packet_buffers = 1024;
 
+    // Received frames are copied straight into one of these preallocated buffers, which
+    // are then shared with the network task and with the sockets that queue the packet.
+    // A pooled buffer is free again once the pool holds the only reference to it.
+    static constexpr size_t receive_buffer_pool_budget = 1 * MiB;
+    static constexpr size_t minimum_receive_buffer_count = 16;
+    static constexpr size_t maximum_receive_buffer_count = 256;
+    Vector<NonnullLockRefPtr<PacketWithTimestamp>> m_receive_buffer_pool;
+    size_t m_receive_buffer_size { 0 };
+    size_t m_next_receive_buffer_index { 0 };
+
     using PacketList = IntrusiveList<&PacketWithTimestamp::packet_node>;
 
+    mutable Spinlock<LockRank::None> m_receive_lock {};
     PacketList m_packet_queue;
     size_t m_packet_queue_size { 0 };
     SpinlockProtected<PacketList, LockRank::None> m_unused_packets {};
@@ -125,7 +185,10 @@ private:
     u32 m_bytes_in { 0 };
     u32 m_packets_out { 0 };
     u32 m_bytes_out { 0 };
+    u32 m_packets_dropped { 0 };
     u32 m_mtu { 1500 };
+    NetworkAdapterOffload m_offloads { NetworkAdapterOffload::None };
+    size_t m_maximum_segmentation_size { 0 };
 };
 
 }
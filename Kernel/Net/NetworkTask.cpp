@@ -26,19 +26,29 @@
 namespace Kernel {
 
 static void handle_arp(EthernetFrameHeader const&, size_t frame_size);
-static void handle_ipv4(EthernetFrameHeader const&, size_t frame_size, Time const& packet_timestamp);
-static void handle_icmp(EthernetFrameHeader const&, IPv4Packet const&, Time const& packet_timestamp);
-static void handle_udp(IPv4Packet const&, Time const& packet_timestamp);
-static void handle_tcp(IPv4Packet const&, Time const& packet_timestamp);
+static void handle_ipv4(EthernetFrameHeader const&, size_t frame_size, PacketWithTimestamp& packet_buffer);
+static void handle_icmp(EthernetFrameHeader const&, IPv4Packet const&, PacketWithTimestamp& packet_buffer);
+static void handle_udp(IPv4Packet const&, PacketWithTimestamp& packet_buffer);
+static void handle_tcp(IPv4Packet const&, PacketWithTimestamp& packet_buffer);
 static void send_delayed_tcp_ack(LockRefPtr<TCPSocket> socket);
 static void send_tcp_rst(IPv4Packet const& ipv4_packet, TCPPacket const& tcp_packet, LockRefPtr<NetworkAdapter> adapter);
 static void flush_delayed_tcp_acks();
 static void retransmit_tcp_packets();
 
-static Thread* network_task = nullptr;
-static HashTable<LockRefPtr<TCPSocket>>* delayed_ack_sockets;
+static Process* network_task_process = nullptr;
+static MutexProtected<HashTable<LockRefPtr<TCPSocket>>>* delayed_ack_sockets;
+
+// Every adapter gets its own receive thread (all of them part of the Network Task
+// process), so packets from different adapters are processed in parallel. Sockets
+// and the global socket tables have their own locks, and each adapter is only ever
+// drained by its own thread, so packets from one adapter are still handled in order.
+struct AdapterReceiveContext {
+    NonnullLockRefPtr<NetworkAdapter> adapter;
+    WaitQueue packet_wait_queue;
+};
 
 [[noreturn]] static void NetworkTask_main(void*);
+[[noreturn]] static void NetworkTask_receive_main(void*);
 
 void NetworkTask::spawn()
 {
@@ -46,21 +56,22 @@ void NetworkTask::spawn()
     auto name = KString::try_create("Network Task"sv);
     if (name.is_error())
         TODO();
-    (void)Process::create_kernel_process(thread, name.release_value(), NetworkTask_main, nullptr);
-    network_task = thread;
+    auto process = Process::create_kernel_process(thread, name.release_value(), NetworkTask_main, nullptr);
+    network_task_process = process.ptr();
 }
 
 bool NetworkTask::is_current()
 {
-    return Thread::current() == network_task;
+    auto* current_thread = Thread::current();
+    return current_thread && &current_thread->process() == network_task_process;
 }
 
 void NetworkTask_main(void*)
 {
-    delayed_ack_sockets = new HashTable<LockRefPtr<TCPSocket>>;
+    delayed_ack_sockets = new MutexProtected<HashTable<LockRefPtr<TCPSocket>>>;
 
-    WaitQueue packet_wait_queue;
-    int pending_packets = 0;
+    size_t adapter_index = 0;
+    auto processor_count = min(Processor::count(), static_cast<u32>(sizeof(u32) * 8));
     NetworkingManagement::the().for_each([&](auto& adapter) {
         dmesgln("NetworkTask: {} network adapter found: hw={}", adapter.class_name(), adapter.mac_address().to_string());
 
@@ -69,49 +80,53 @@ void NetworkTask_main(void*)
             adapter.set_ipv4_netmask({ 255, 0, 0, 0 });
         }
 
-        adapter.on_receive = [&]() {
-            pending_packets++;
-            packet_wait_queue.wake_all();
+        auto* context = new (nothrow) AdapterReceiveContext { adapter, {} };
+        if (!context)
+            TODO();
+        adapter.on_receive = [context]() {
+            context->packet_wait_queue.wake_all();
         };
-    });
-
-    auto dequeue_packet = [&pending_packets](u8* buffer, size_t buffer_size, Time& packet_timestamp) -> size_t {
-        if (pending_packets == 0)
-            return 0;
-        size_t packet_size = 0;
-        NetworkingManagement::the().for_each([&](auto& adapter) {
-            if (packet_size || !adapter.has_queued_packets())
-                return;
-            packet_size = adapter.dequeue_packet(buffer, buffer_size, packet_timestamp);
-            pending_packets--;
-            dbgln_if(NETWORK_TASK_DEBUG, "NetworkTask: Dequeued packet from {} ({} bytes)", adapter.name(), packet_size);
-        });
-        return packet_size;
-    };
 
-    size_t buffer_size = 64 * KiB;
-    auto region_or_error = MM.allocate_kernel_region(buffer_size, "Kernel Packet Buffer"sv, Memory::Region::Access::ReadWrite);
-    if (region_or_error.is_error())
-        TODO();
-    auto buffer_region = region_or_error.release_value();
-    auto buffer = (u8*)buffer_region->vaddr().get();
-    Time packet_timestamp;
+        auto thread_name = KString::formatted("Network Task ({})", adapter.name());
+        if (thread_name.is_error())
+            TODO();
+        // Spread the receive threads over the processors.
+        u32 affinity = 1u << (adapter_index++ % processor_count);
+        auto thread = Process::current().create_kernel_thread(NetworkTask_receive_main, context, THREAD_PRIORITY_NORMAL, thread_name.release_value(), affinity, false);
+        if (!thread)
+            TODO();
+    });
 
     for (;;) {
         flush_delayed_tcp_acks();
         retransmit_tcp_packets();
-        size_t packet_size = dequeue_packet(buffer, buffer_size, packet_timestamp);
-        if (!packet_size) {
+        (void)Thread::current()->sleep(Time::from_milliseconds(500));
+    }
+}
+
+void NetworkTask_receive_main(void* context_ptr)
+{
+    auto& context = *static_cast<AdapterReceiveContext*>(context_ptr);
+    auto& adapter = *context.adapter;
+
+    for (;;) {
+        auto packet = adapter.dequeue_packet();
+        if (!packet) {
+            // We've caught up with this adapter, send out the ACKs we delayed while handling the batch.
+            flush_delayed_tcp_acks();
             auto timeout_time = Time::from_milliseconds(500);
             auto timeout = Thread::BlockTimeout { false, &timeout_time };
-            [[maybe_unused]] auto result = packet_wait_queue.wait_on(timeout, "NetworkTask"sv);
+            [[maybe_unused]] auto result = context.packet_wait_queue.wait_on(timeout, "NetworkTask"sv);
             continue;
         }
+        // Packets are handled right in the buffer the adapter received them into.
+        size_t packet_size = packet->buffer->size();
+        dbgln_if(NETWORK_TASK_DEBUG, "NetworkTask: Dequeued packet from {} ({} bytes)", adapter.name(), packet_size);
         if (packet_size < sizeof(EthernetFrameHeader)) {
             dbgln("NetworkTask: Packet is too small to be an Ethernet packet! ({})", packet_size);
             continue;
         }
-        auto& eth = *(EthernetFrameHeader const*)buffer;
+        auto& eth = *(EthernetFrameHeader const*)packet->buffer->data();
         dbgln_if(ETHERNET_DEBUG, "NetworkTask: From {} to {}, ether_type={:#04x}, packet_size={}", eth.source().to_string(), eth.destination().to_string(), eth.ether_type(), packet_size);
 
         switch (eth.ether_type()) {
@@ -119,7 +134,7 @@ void NetworkTask_main(void*)
             handle_arp(eth, packet_size);
             break;
         case EtherType::IPv4:
-            handle_ipv4(eth, packet_size, packet_timestamp);
+            handle_ipv4(eth, packet_size, *packet);
             break;
         case EtherType::IPv6:
             // ignore
@@ -178,7 +193,7 @@ void handle_arp(EthernetFrameHeader const& eth, size_t frame_size)
     }
 }
 
-void handle_ipv4(EthernetFrameHeader const& eth, size_t frame_size, Time const& packet_timestamp)
+void handle_ipv4(EthernetFrameHeader const& eth, size_t frame_size, PacketWithTimestamp& packet_buffer)
 {
     constexpr size_t minimum_ipv4_frame_size = sizeof(EthernetFrameHeader) + sizeof(IPv4Packet);
     if (frame_size < minimum_ipv4_frame_size) {
@@ -212,18 +227,18 @@ void handle_ipv4(EthernetFrameHeader const& eth, size_t frame_size, Time const&
 
     switch ((IPv4Protocol)packet.protocol()) {
     case IPv4Protocol::ICMP:
-        return handle_icmp(eth, packet, packet_timestamp);
+        return handle_icmp(eth, packet, packet_buffer);
     case IPv4Protocol::UDP:
-        return handle_udp(packet, packet_timestamp);
+        return handle_udp(packet, packet_buffer);
     case IPv4Protocol::TCP:
-        return handle_tcp(packet, packet_timestamp);
+        return handle_tcp(packet, packet_buffer);
     default:
         dbgln_if(IPV4_DEBUG, "handle_ipv4: Unhandled protocol {:#02x}", packet.protocol());
         break;
     }
 }
 
-void handle_icmp(EthernetFrameHeader const& eth, IPv4Packet const& ipv4_packet, Time const& packet_timestamp)
+void handle_icmp(EthernetFrameHeader const& eth, IPv4Packet const& ipv4_packet, PacketWithTimestamp& packet_buffer)
 {
     auto& icmp_header = *static_cast<ICMPHeader const*>(ipv4_packet.payload());
     dbgln_if(ICMP_DEBUG, "handle_icmp: source={}, destination={}, type={:#02x}, code={:#02x}", ipv4_packet.source().to_string(), ipv4_packet.destination().to_string(), icmp_header.type(), icmp_header.code());
@@ -237,7 +252,7 @@ void handle_icmp(EthernetFrameHeader const& eth, IPv4Packet const& ipv4_packet,
             }
         });
         for (auto& socket : icmp_sockets)
-            socket.did_receive(ipv4_packet.source(), 0, { &ipv4_packet, sizeof(IPv4Packet) + ipv4_packet.payload_size() }, packet_timestamp);
+            socket.did_receive(ipv4_packet.source(), 0, { &ipv4_packet, sizeof(IPv4Packet) + ipv4_packet.payload_size() }, packet_buffer);
     }
 
     auto adapter = NetworkingManagement::the().from_ipv4_address(ipv4_packet.destination());
@@ -274,7 +289,7 @@ void handle_icmp(EthernetFrameHeader const& eth, IPv4Packet const& ipv4_packet,
     }
 }
 
-void handle_udp(IPv4Packet const& ipv4_packet, Time const& packet_timestamp)
+void handle_udp(IPv4Packet const& ipv4_packet, PacketWithTimestamp& packet_buffer)
 {
     if (ipv4_packet.payload_size() < sizeof(UDPPacket)) {
         dbgln("handle_udp: Packet too small ({}, need {})", ipv4_packet.payload_size(), sizeof(UDPPacket));
@@ -299,7 +314,7 @@ void handle_udp(IPv4Packet const& ipv4_packet, Time const& packet_timestamp)
     auto& destination = ipv4_packet.destination();
 
     if (destination == IPv4Address(255, 255, 255, 255) || NetworkingManagement::the().from_ipv4_address(destination) || socket->multicast_memberships().contains_slow(destination))
-        socket->did_receive(ipv4_packet.source(), udp_packet.source_port(), { &ipv4_packet, sizeof(IPv4Packet) + ipv4_packet.payload_size() }, packet_timestamp);
+        socket->did_receive(ipv4_packet.source(), udp_packet.source_port(), { &ipv4_packet, sizeof(IPv4Packet) + ipv4_packet.payload_size() }, packet_buffer);
 }
 
 void send_delayed_tcp_ack(LockRefPtr<TCPSocket> socket)
@@ -310,13 +325,23 @@ void send_delayed_tcp_ack(LockRefPtr<TCPSocket> socket)
         return;
     }
 
-    delayed_ack_sockets->set(move(socket));
+    delayed_ack_sockets->with_exclusive([&](auto& sockets) {
+        sockets.set(move(socket));
+    });
 }
 
 void flush_delayed_tcp_acks()
 {
+    // NOTE: Socket mutexes are taken before the delayed ACK table's in send_delayed_tcp_ack(),
+    //       so we take the pending sockets out of the table before locking any of them.
+    auto sockets = delayed_ack_sockets->with_exclusive([](auto& sockets) {
+        return move(sockets);
+    });
+    if (sockets.is_empty())
+        return;
+
     Vector<LockRefPtr<TCPSocket>, 32> remaining_sockets;
-    for (auto& socket : *delayed_ack_sockets) {
+    for (auto& socket : sockets) {
         MutexLocker locker(socket->mutex());
         if (socket->should_delay_next_ack()) {
             MUST(remaining_sockets.try_append(socket));
@@ -325,12 +350,13 @@ void flush_delayed_tcp_acks()
         [[maybe_unused]] auto result = socket->send_ack();
     }
 
-    if (remaining_sockets.size() != delayed_ack_sockets->size()) {
-        delayed_ack_sockets->clear();
-        if (remaining_sockets.size() > 0)
+    if (remaining_sockets.size() > 0) {
+        if (remaining_sockets.size() != sockets.size())
             dbgln("flush_delayed_tcp_acks: {} sockets remaining", remaining_sockets.size());
-        for (auto&& socket : remaining_sockets)
-            delayed_ack_sockets->set(move(socket));
+        delayed_ack_sockets->with_exclusive([&](auto& sockets) {
+            for (auto&& socket : remaining_sockets)
+                sockets.set(move(socket));
+        });
     }
 }
 
@@ -368,7 +394,7 @@ void send_tcp_rst(IPv4Packet const& ipv4_packet, TCPPacket const& tcp_packet, Lo
     routing_decision.adapter->release_packet_buffer(*packet);
 }
 
-void handle_tcp(IPv4Packet const& ipv4_packet, Time const& packet_timestamp)
+void handle_tcp(IPv4Packet const& ipv4_packet, PacketWithTimestamp& packet_buffer)
 {
     if (ipv4_packet.payload_size() < sizeof(TCPPacket)) {
         dbgln("handle_tcp: IPv4 payload is too small to be a TCP packet ({}, need {})", ipv4_packet.payload_size(), sizeof(TCPPacket));
@@ -381,6 +407,7 @@ void handle_tcp(IPv4Packet const& ipv4_packet, Time const& packet_timestamp)
     size_t maximum_tcp_header_size = 15 * sizeof(u32);
     if (tcp_packet.header_size() < minimum_tcp_header_size || tcp_packet.header_size() > maximum_tcp_header_size) {
         dbgln("handle_tcp: TCP packet header has invalid size {}", tcp_packet.header_size());
+        return;
     }
 
     if (ipv4_packet.payload_size() < tcp_packet.header_size()) {
@@ -459,6 +486,7 @@ void handle_tcp(IPv4Packet const& ipv4_packet, Time const& packet_timestamp)
             dbgln_if(TCP_DEBUG, "handle_tcp: created new client socket with tuple {}", client->tuple().to_string());
             client->set_sequence_number(1000);
             client->set_ack_number(tcp_packet.sequence_number() + payload_size + 1);
+            client->process_syn_options(tcp_packet);
             [[maybe_unused]] auto rc2 = client->send_tcp_packet(TCPFlags::SYN | TCPFlags::ACK);
             client->set_state(TCPSocket::State::SynReceived);
             return;
@@ -633,7 +661,7 @@ void handle_tcp(IPv4Packet const& ipv4_packet, Time const& packet_timestamp)
 
         if (tcp_packet.has_fin()) {
             if (payload_size != 0)
-                socket->did_receive(ipv4_packet.source(), tcp_packet.source_port(), { &ipv4_packet, sizeof(IPv4Packet) + ipv4_packet.payload_size() }, packet_timestamp);
+                socket->did_receive(ipv4_packet.source(), tcp_packet.source_port(), { &ipv4_packet, sizeof(IPv4Packet) + ipv4_packet.payload_size() }, packet_buffer);
 
             socket->set_ack_number(tcp_packet.sequence_number() + payload_size + 1);
             send_delayed_tcp_ack(socket);
@@ -643,7 +671,7 @@ void handle_tcp(IPv4Packet const& ipv4_packet, Time const& packet_timestamp)
         }
 
         if (payload_size) {
-            if (socket->did_receive(ipv4_packet.source(), tcp_packet.source_port(), { &ipv4_packet, sizeof(IPv4Packet) + ipv4_packet.payload_size() }, packet_timestamp)) {
+            if (socket->did_receive(ipv4_packet.source(), tcp_packet.source_port(), { &ipv4_packet, sizeof(IPv4Packet) + ipv4_packet.payload_size() }, packet_buffer)) {
                 socket->set_ack_number(tcp_packet.sequence_number() + payload_size);
                 dbgln_if(TCP_DEBUG, "Got packet with ack_no={}, seq_no={}, payload_size={}, acking it with new ack_no={}, seq_no={}",
                     tcp_packet.ack_number(), tcp_packet.sequence_number(), payload_size, socket->ack_number(), socket->sequence_number());
@@ -114,6 +114,7 @@ UNMAP_AFTER_INIT ErrorOr<NonnullLockRefPtr<NetworkAdapter>> NetworkingManagement
         if (initializer_probe_found_driver_match) {
             auto adapter = TRY(initializer.create(device_identifier));
             TRY(adapter->initialize({}));
+            TRY(adapter->initialize_receive_buffer_pool());
             return adapter;
         }
     }
@@ -138,6 +139,7 @@ bool NetworkingManagement::initialize()
     }
     auto loopback = LoopbackAdapter::try_create();
     VERIFY(loopback);
+    MUST(loopback->initialize_receive_buffer_pool());
     m_adapters.with([&](auto& adapters) { adapters.append(*loopback); });
     m_loopback_adapter = loopback;
     return true;
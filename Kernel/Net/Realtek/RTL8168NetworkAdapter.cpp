@@ -278,6 +278,10 @@ UNMAP_AFTER_INIT ErrorOr<void> RTL8168NetworkAdapter::initialize(Badge<Networkin
     }
     out32(REG_RXCFG, rx_config);
 
+    // FIXME: The 8168B versions might want the checksum flags in the first descriptor word instead, so leave them alone for now.
+    if (m_version > ChipVersion::Version3)
+        set_offloads(NetworkAdapterOffload::TransmitChecksum);
+
     // disable interrupts
     out16(REG_IMR, 0);
 
@@ -1192,7 +1196,7 @@ UNMAP_AFTER_INIT void RTL8168NetworkAdapter::read_mac_address()
     set_mac_address(mac);
 }
 
-void RTL8168NetworkAdapter::send_raw(ReadonlyBytes payload)
+void RTL8168NetworkAdapter::send_raw(ReadonlyBytes payload, TransmitOffload const& offload)
 {
     dbgln_if(RTL8168_DEBUG, "RTL8168: send_raw length={}", payload.size());
 
@@ -1207,17 +1211,33 @@ void RTL8168NetworkAdapter::send_raw(ReadonlyBytes payload)
     if ((free_descriptor.flags & TXDescriptor::Ownership) != 0) {
         dbgln_if(RTL8168_DEBUG, "RTL8168: No free TX buffers, sleeping until one is available");
         m_wait_queue.wait_forever("RTL8168NetworkAdapter"sv);
-        return send_raw(payload);
+        return send_raw(payload, offload);
         // if we woke up a TX descriptor is guaranteed to be available, so this should never recurse more than once
         // but this can probably be done more cleanly
     }
 
     dbgln_if(RTL8168_DEBUG, "RTL8168: Chose descriptor {}", m_tx_free_index);
-    memcpy(m_tx_buffers_regions[m_tx_free_index].vaddr().as_ptr(), payload.data(), payload.size());
+    auto* buffer = m_tx_buffers_regions[m_tx_free_index].vaddr().as_ptr();
+    memcpy(buffer, payload.data(), payload.size());
+    auto frame_length = payload.size();
+
+    // FIXME: Large send offload is also supported by the hardware, but the descriptor layout for it differs between chip versions.
+    VERIFY(!offload.segment_size);
+    u16 checksum_flags = 0;
+    if (offload.checksum) {
+        checksum_flags = TXDescriptor::IPv4Checksum | (offload.protocol == IPv4Protocol::TCP ? TXDescriptor::TCPChecksum : TXDescriptor::UDPChecksum);
+        // Some versions compute bad checksums for frames that the hardware has to pad itself.
+        constexpr size_t minimum_frame_length = 60;
+        if (frame_length < minimum_frame_length) {
+            memset(buffer + frame_length, 0, minimum_frame_length - frame_length);
+            frame_length = minimum_frame_length;
+        }
+    }
 
     m_tx_free_index = (m_tx_free_index + 1) % number_of_tx_descriptors;
 
-    free_descriptor.frame_length = payload.size() & 0x3FFF;
+    free_descriptor.vlan_flags = checksum_flags;
+    free_descriptor.frame_length = frame_length & 0x3FFF;
     free_descriptor.flags = free_descriptor.flags | TXDescriptor::Ownership;
 
     out8(REG_TXSTART, TXSTART_START); // FIXME: this shouldn't be done so often, we should look into doing this using the watchdog timer
@@ -28,7 +28,7 @@ public:
 
     virtual ~RTL8168NetworkAdapter() override;
 
-    virtual void send_raw(ReadonlyBytes) override;
+    virtual void send_raw(ReadonlyBytes, TransmitOffload const&) override;
     virtual bool link_up() override { return m_link_up; }
     virtual bool link_full_duplex() override;
     virtual i32 link_speed() override;
@@ -63,6 +63,11 @@ private:
         static constexpr u16 FirstSegment = 0x2000u;
         static constexpr u16 LastSegment = 0x1000u;
         static constexpr u16 LargeSend = 0x800u;
+
+        // vlan_flags bit field
+        static constexpr u16 IPv4Checksum = 0x2000u;
+        static constexpr u16 TCPChecksum = 0x4000u;
+        static constexpr u16 UDPChecksum = 0x8000u;
     };
 
     static_assert(AssertSize<TXDescriptor, 16u>());
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/Net/TCPCongestionControl.h>
+
+namespace Kernel {
+
+ErrorOr<NonnullOwnPtr<TCPCongestionControl>> TCPCongestionControl::try_create(Algorithm algorithm, size_t maximum_segment_size)
+{
+    switch (algorithm) {
+    case Algorithm::NewReno:
+        return adopt_nonnull_own_or_enomem(new (nothrow) TCPNewRenoCongestionControl(maximum_segment_size));
+    }
+    VERIFY_NOT_REACHED();
+}
+
+TCPCongestionControl::TCPCongestionControl(size_t maximum_segment_size)
+    : m_maximum_segment_size(maximum_segment_size)
+    , m_congestion_window(initial_window(maximum_segment_size))
+{
+}
+
+size_t TCPCongestionControl::initial_window(size_t maximum_segment_size)
+{
+    if (maximum_segment_size > 2190)
+        return 2 * maximum_segment_size;
+    if (maximum_segment_size > 1095)
+        return 3 * maximum_segment_size;
+    return 4 * maximum_segment_size;
+}
+
+void TCPCongestionControl::set_maximum_segment_size(size_t maximum_segment_size)
+{
+    // This only happens while the connection is being set up, so nothing has been sent
+    // with the old segment size yet and we can simply start over.
+    m_maximum_segment_size = maximum_segment_size;
+    m_congestion_window = initial_window(maximum_segment_size);
+}
+
+void TCPNewRenoCongestionControl::reduce_slow_start_threshold(size_t bytes_in_flight)
+{
+    m_slow_start_threshold = max(bytes_in_flight / 2, 2 * m_maximum_segment_size);
+}
+
+void TCPNewRenoCongestionControl::on_ack(size_t acknowledged_bytes)
+{
+    if (m_congestion_window < m_slow_start_threshold) {
+        // Slow start: grow by at most one segment per ACK.
+        m_congestion_window += min(acknowledged_bytes, m_maximum_segment_size);
+        return;
+    }
+
+    // Congestion avoidance: grow by about one segment per round trip.
+    m_congestion_window += max<size_t>(1, m_maximum_segment_size * m_maximum_segment_size / m_congestion_window);
+}
+
+void TCPNewRenoCongestionControl::on_enter_fast_recovery(size_t bytes_in_flight)
+{
+    reduce_slow_start_threshold(bytes_in_flight);
+    // The three duplicate ACKs tell us that three segments have left the network.
+    m_congestion_window = m_slow_start_threshold + 3 * m_maximum_segment_size;
+}
+
+void TCPNewRenoCongestionControl::on_duplicate_ack_in_fast_recovery()
+{
+    m_congestion_window += m_maximum_segment_size;
+}
+
+void TCPNewRenoCongestionControl::on_partial_ack(size_t acknowledged_bytes)
+{
+    // RFC 6582, 3.2. Specification, step 3: deflate the window by the amount of newly
+    // acknowledged data, then add back one segment for the retransmission.
+    m_congestion_window -= min(acknowledged_bytes, m_congestion_window);
+    m_congestion_window += m_maximum_segment_size;
+}
+
+void TCPNewRenoCongestionControl::on_exit_fast_recovery(size_t bytes_in_flight)
+{
+    m_congestion_window = min(m_slow_start_threshold, max(bytes_in_flight, m_maximum_segment_size) + m_maximum_segment_size);
+}
+
+void TCPNewRenoCongestionControl::on_retransmit_timeout(size_t bytes_in_flight)
+{
+    reduce_slow_start_threshold(bytes_in_flight);
+    m_congestion_window = m_maximum_segment_size;
+}
+
+}
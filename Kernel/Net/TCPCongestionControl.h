@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Error.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/NumericLimits.h>
+#include <AK/StringView.h>
+#include <AK/Types.h>
+
+namespace Kernel {
+
+// The congestion controller decides how many bytes a TCPSocket may have in flight.
+// TCPSocket takes care of detecting losses and retransmitting, and only tells the
+// controller about ACKs and the recovery phases it enters and leaves.
+class TCPCongestionControl {
+public:
+    enum class Algorithm {
+        NewReno,
+    };
+
+    static ErrorOr<NonnullOwnPtr<TCPCongestionControl>> try_create(Algorithm, size_t maximum_segment_size);
+
+    virtual ~TCPCongestionControl() = default;
+
+    virtual StringView name() const = 0;
+
+    size_t congestion_window() const { return m_congestion_window; }
+    size_t slow_start_threshold() const { return m_slow_start_threshold; }
+
+    size_t maximum_segment_size() const { return m_maximum_segment_size; }
+    void set_maximum_segment_size(size_t);
+
+    // New data was acknowledged while not in fast recovery.
+    virtual void on_ack(size_t acknowledged_bytes) = 0;
+
+    // The third duplicate ACK arrived, the first unacknowledged segment is being retransmitted.
+    virtual void on_enter_fast_recovery(size_t bytes_in_flight) = 0;
+    virtual void on_duplicate_ack_in_fast_recovery() = 0;
+    virtual void on_partial_ack(size_t acknowledged_bytes) = 0;
+    virtual void on_exit_fast_recovery(size_t bytes_in_flight) = 0;
+
+    virtual void on_retransmit_timeout(size_t bytes_in_flight) = 0;
+
+protected:
+    explicit TCPCongestionControl(size_t maximum_segment_size);
+
+    // RFC 5681, 3.1. Slow Start and Congestion Avoidance
+    static size_t initial_window(size_t maximum_segment_size);
+
+    size_t m_maximum_segment_size { 0 };
+    size_t m_congestion_window { 0 };
+    size_t m_slow_start_threshold { NumericLimits<size_t>::max() };
+};
+
+// RFC 5681 and RFC 6582
+class TCPNewRenoCongestionControl final : public TCPCongestionControl {
+public:
+    explicit TCPNewRenoCongestionControl(size_t maximum_segment_size)
+        : TCPCongestionControl(maximum_segment_size)
+    {
+    }
+
+    virtual StringView name() const override { return "newreno"sv; }
+
+    virtual void on_ack(size_t acknowledged_bytes) override;
+    virtual void on_enter_fast_recovery(size_t bytes_in_flight) override;
+    virtual void on_duplicate_ack_in_fast_recovery() override;
+    virtual void on_partial_ack(size_t acknowledged_bytes) override;
+    virtual void on_exit_fast_recovery(size_t bytes_in_flight) override;
+    virtual void on_retransmit_timeout(size_t bytes_in_flight) override;
+
+private:
+    void reduce_slow_start_threshold(size_t bytes_in_flight);
+};
+
+}
@@ -162,10 +162,15 @@ void TCPSocket::release_for_accept(NonnullLockRefPtr<TCPSocket> socket)
     [[maybe_unused]] auto rc = queue_connection_from(move(socket));
 }
 
-TCPSocket::TCPSocket(int protocol, NonnullOwnPtr<DoubleBuffer> receive_buffer, NonnullOwnPtr<KBuffer> scratch_buffer)
+TCPSocket::TCPSocket(int protocol, NonnullOwnPtr<DoubleBuffer> receive_buffer, NonnullOwnPtr<KBuffer> scratch_buffer, NonnullOwnPtr<TCPCongestionControl> congestion_control)
     : IPv4Socket(SOCK_STREAM, protocol, move(receive_buffer), move(scratch_buffer))
+    , m_congestion_control(move(congestion_control))
 {
-    m_last_retransmit_time = kgettimeofday();
+    m_retransmit_timer_start = kgettimeofday();
+
+    // Pick the smallest shift that still lets us advertise the whole receive buffer.
+    while (m_receive_window_scale < 14 && (static_cast<size_t>(NumericLimits<u16>::max()) << m_receive_window_scale) < receive_buffer_size)
+        ++m_receive_window_scale;
 }
 
 TCPSocket::~TCPSocket()
@@ -179,7 +184,8 @@ ErrorOr<NonnullLockRefPtr<TCPSocket>> TCPSocket::try_create(int protocol, Nonnul
 {
     // Note: Scratch buffer is only used for SOCK_STREAM sockets.
     auto scratch_buffer = TRY(KBuffer::try_create_with_size("TCPSocket: Scratch buffer"sv, 65536));
-    return adopt_nonnull_lock_ref_or_enomem(new (nothrow) TCPSocket(protocol, move(receive_buffer), move(scratch_buffer)));
+    auto congestion_control = TRY(TCPCongestionControl::try_create(TCPCongestionControl::Algorithm::NewReno, default_maximum_segment_size));
+    return adopt_nonnull_lock_ref_or_enomem(new (nothrow) TCPSocket(protocol, move(receive_buffer), move(scratch_buffer), move(congestion_control)));
 }
 
 ErrorOr<size_t> TCPSocket::protocol_size(ReadonlyBytes raw_ipv4_packet)
@@ -200,13 +206,29 @@ ErrorOr<size_t> TCPSocket::protocol_receive(ReadonlyBytes raw_ipv4_packet, UserO
     return payload_size;
 }
 
+size_t TCPSocket::maximum_segment_size_for(NetworkAdapter const& adapter) const
+{
+    return min<size_t>(adapter.mtu() - sizeof(IPv4Packet) - sizeof(TCPPacket), m_send_maximum_segment_size);
+}
+
 ErrorOr<size_t> TCPSocket::protocol_send(UserOrKernelBuffer const& data, size_t data_length)
 {
     RoutingDecision routing_decision = route_to(peer_address(), local_address(), bound_interface());
     if (routing_decision.is_zero())
         return set_so_error(EHOSTUNREACH);
-    size_t mss = routing_decision.adapter->mtu() - sizeof(IPv4Packet) - sizeof(TCPPacket);
-    data_length = min(data_length, mss);
+    auto& adapter = *routing_decision.adapter;
+    size_t mss = maximum_segment_size_for(adapter);
+    size_t segment_limit = mss;
+    if (adapter.has_offload(NetworkAdapterOffload::TCPSegmentation)) {
+        // Let the adapter split up as many full segments as it and the send window can take.
+        size_t segmentation_limit = adapter.maximum_segmentation_size() - sizeof(IPv4Packet) - sizeof(TCPPacket);
+        size_t window = min<size_t>(m_send_window_size, m_congestion_control->congestion_window());
+        size_t available_window = m_unacked_packets.with_shared([&](auto& unacked_packets) {
+            return window > unacked_packets.size ? window - unacked_packets.size : 0;
+        });
+        segment_limit = max(mss, min(segmentation_limit, available_window) / mss * mss);
+    }
+    data_length = min(data_length, segment_limit);
     TRY(send_tcp_packet(TCPFlags::PSH | TCPFlags::ACK, &data, data_length, &routing_decision));
     return data_length;
 }
@@ -226,8 +248,19 @@ ErrorOr<void> TCPSocket::send_tcp_packet(u16 flags, UserOrKernelBuffer const* pa
 
     auto ipv4_payload_offset = routing_decision.adapter->ipv4_payload_offset();
 
-    bool const has_mss_option = flags == TCPFlags::SYN;
-    const size_t options_size = has_mss_option ? sizeof(TCPOptionMSS) : 0;
+    // Options are only ever sent on SYNs. A SYN|ACK only carries the options the peer offered in its SYN.
+    bool const is_syn = flags & TCPFlags::SYN;
+    bool const has_mss_option = is_syn;
+    bool const has_window_scale_option = is_syn && m_window_scaling_enabled;
+    bool const has_sack_permitted_option = is_syn && m_sack_enabled;
+    size_t options_size = 0;
+    if (has_mss_option)
+        options_size += sizeof(TCPOptionMSS);
+    if (has_window_scale_option)
+        options_size += 1 + sizeof(TCPOptionWindowScale);
+    if (has_sack_permitted_option)
+        options_size += 2 + sizeof(TCPOptionSACKPermitted);
+    VERIFY(options_size % sizeof(u32) == 0);
     const size_t tcp_header_size = sizeof(TCPPacket) + options_size;
     const size_t buffer_size = ipv4_payload_offset + tcp_header_size + payload_size;
     auto packet = routing_decision.adapter->acquire_packet_buffer(buffer_size);
@@ -241,7 +274,7 @@ ErrorOr<void> TCPSocket::send_tcp_packet(u16 flags, UserOrKernelBuffer const* pa
     VERIFY(local_port());
     tcp_packet.set_source_port(local_port());
     tcp_packet.set_destination_port(peer_port());
-    tcp_packet.set_window_size(NumericLimits<u16>::max());
+    tcp_packet.set_window_size(advertised_window_size(flags));
     tcp_packet.set_sequence_number(m_sequence_number);
     tcp_packet.set_data_offset(tcp_header_size / sizeof(u32));
     tcp_packet.set_flags(flags);
@@ -265,20 +298,60 @@ ErrorOr<void> TCPSocket::send_tcp_packet(u16 flags, UserOrKernelBuffer const* pa
         m_sequence_number += payload_size;
     }
 
-    if (has_mss_option) {
-        u16 mss = routing_decision.adapter->mtu() - sizeof(IPv4Packet) - sizeof(TCPPacket);
-        TCPOptionMSS mss_option { mss };
-        VERIFY(packet->buffer->size() >= ipv4_payload_offset + sizeof(TCPPacket) + sizeof(mss_option));
-        memcpy(packet->buffer->data() + ipv4_payload_offset + sizeof(TCPPacket), &mss_option, sizeof(mss_option));
+    if (options_size > 0) {
+        VERIFY(packet->buffer->size() >= ipv4_payload_offset + tcp_header_size);
+        auto* option = packet->buffer->data() + ipv4_payload_offset + sizeof(TCPPacket);
+        auto append_option = [&](auto const& value) {
+            memcpy(option, &value, sizeof(value));
+            option += sizeof(value);
+        };
+        auto append_nops = [&](size_t count) {
+            memset(option, to_underlying(TCPOptionKind::NOP), count);
+            option += count;
+        };
+        if (has_mss_option) {
+            u16 mss = routing_decision.adapter->mtu() - sizeof(IPv4Packet) - sizeof(TCPPacket);
+            append_option(TCPOptionMSS { mss });
+        }
+        if (has_window_scale_option) {
+            append_nops(1);
+            append_option(TCPOptionWindowScale { m_receive_window_scale });
+        }
+        if (has_sack_permitted_option) {
+            append_nops(2);
+            append_option(TCPOptionSACKPermitted {});
+        }
     }
 
-    tcp_packet.set_checksum(compute_tcp_checksum(local_address(), peer_address(), tcp_packet, payload_size));
+    // Anything larger than the MSS is left to the adapter to split up, see protocol_send().
+    size_t const mss = maximum_segment_size_for(*routing_decision.adapter);
+    TransmitOffload offload;
+    if (routing_decision.adapter->has_offload(NetworkAdapterOffload::TransmitChecksum)) {
+        offload.checksum = true;
+        offload.protocol = IPv4Protocol::TCP;
+        offload.checksum_start = ipv4_payload_offset;
+        offload.checksum_offset = ipv4_payload_offset + TCPPacket::checksum_offset;
+        u16 length = tcp_header_size + payload_size;
+        if (payload_size > mss) {
+            VERIFY(options_size == 0);
+            offload.segment_size = mss;
+            offload.header_size = ipv4_payload_offset + tcp_header_size;
+            length = 0;
+        }
+        tcp_packet.set_checksum(ipv4_pseudo_header_sum(local_address(), peer_address(), IPv4Protocol::TCP, length));
+    } else {
+        VERIFY(payload_size <= mss);
+        tcp_packet.set_checksum(compute_tcp_checksum(local_address(), peer_address(), tcp_packet, payload_size));
+    }
 
     bool expect_ack { tcp_packet.has_syn() || payload_size > 0 };
     if (expect_ack) {
         bool append_failed { false };
         m_unacked_packets.with_exclusive([&](auto& unacked_packets) {
-            auto result = unacked_packets.packets.try_append({ m_sequence_number, packet, ipv4_payload_offset, *routing_decision.adapter });
+            // RFC 6298, 5.1: Start the retransmission timer if it isn't running yet.
+            if (unacked_packets.packets.is_empty())
+                m_retransmit_timer_start = kgettimeofday();
+            auto result = unacked_packets.packets.try_append({ m_sequence_number, packet, ipv4_payload_offset, *routing_decision.adapter, 0, kgettimeofday(), payload_size, false, false, offload });
             if (result.is_error()) {
                 dbgln("TCPSocket: Dropped outbound packet because try_append() failed");
                 append_failed = true;
@@ -293,59 +366,265 @@ ErrorOr<void> TCPSocket::send_tcp_packet(u16 flags, UserOrKernelBuffer const* pa
 
     m_packets_out++;
     m_bytes_out += buffer_size;
-    routing_decision.adapter->send_packet(packet->bytes());
+    routing_decision.adapter->send_packet(packet->bytes(), offload);
     if (!expect_ack)
         routing_decision.adapter->release_packet_buffer(*packet);
 
     return {};
 }
 
+template<typename Callback>
+static void for_each_tcp_option(TCPPacket const& packet, Callback callback)
+{
+    auto options = packet.options();
+    size_t offset = 0;
+    while (offset < options.size()) {
+        auto kind = static_cast<TCPOptionKind>(options[offset]);
+        if (kind == TCPOptionKind::End)
+            return;
+        if (kind == TCPOptionKind::NOP) {
+            ++offset;
+            continue;
+        }
+        if (offset + 1 >= options.size())
+            return;
+        size_t length = options[offset + 1];
+        if (length < 2 || offset + length > options.size()) {
+            dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: Ignoring malformed option of kind {} with length {}", to_underlying(kind), length);
+            return;
+        }
+        callback(kind, options.slice(offset + 2, length - 2));
+        offset += length;
+    }
+}
+
+static u32 read_network_ordered_u32(ReadonlyBytes bytes)
+{
+    return (static_cast<u32>(bytes[0]) << 24) | (static_cast<u32>(bytes[1]) << 16) | (static_cast<u32>(bytes[2]) << 8) | bytes[3];
+}
+
+void TCPSocket::process_syn_options(TCPPacket const& packet)
+{
+    VERIFY(packet.has_syn());
+
+    u16 peer_maximum_segment_size = default_maximum_segment_size;
+    bool peer_offered_window_scale = false;
+    bool peer_offered_sack = false;
+    for_each_tcp_option(packet, [&](TCPOptionKind kind, ReadonlyBytes data) {
+        switch (kind) {
+        case TCPOptionKind::MSS:
+            if (data.size() == 2 && (data[0] || data[1]))
+                peer_maximum_segment_size = (data[0] << 8) | data[1];
+            break;
+        case TCPOptionKind::WindowScale:
+            if (data.size() == 1) {
+                peer_offered_window_scale = true;
+                // RFC 7323, 2.3: Shift counts larger than 14 must be treated as 14.
+                m_send_window_scale = min<u8>(data[0], 14);
+            }
+            break;
+        case TCPOptionKind::SACKPermitted:
+            if (data.is_empty())
+                peer_offered_sack = true;
+            break;
+        default:
+            break;
+        }
+    });
+
+    m_window_scaling_enabled = m_window_scaling_enabled && peer_offered_window_scale;
+    if (!m_window_scaling_enabled) {
+        m_send_window_scale = 0;
+        m_receive_window_scale = 0;
+    }
+    m_sack_enabled = m_sack_enabled && peer_offered_sack;
+
+    // RFC 7323, 2.2: The window field in a SYN segment is never scaled.
+    m_send_window_size = packet.window_size();
+    m_send_maximum_segment_size = peer_maximum_segment_size;
+    m_congestion_control->set_maximum_segment_size(peer_maximum_segment_size);
+
+    dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket({}): peer MSS {}, window scaling {} (send shift {}, receive shift {}), SACK {}",
+        this, m_send_maximum_segment_size,
+        m_window_scaling_enabled ? "on" : "off", m_send_window_scale, m_receive_window_scale,
+        m_sack_enabled ? "on" : "off");
+}
+
+u16 TCPSocket::advertised_window_size(u16 flags) const
+{
+    // RFC 7323, 2.2: The window field in a SYN segment is never scaled.
+    u8 shift = (flags & TCPFlags::SYN) ? 0 : m_receive_window_scale;
+    return min(receive_buffer_size >> shift, static_cast<size_t>(NumericLimits<u16>::max()));
+}
+
 void TCPSocket::receive_tcp_packet(TCPPacket const& packet, u16 size)
 {
-    if (packet.has_ack()) {
-        u32 ack_number = packet.ack_number();
+    // Passive opens are set up by handle_tcp(), which hands the SYN to the new client socket.
+    if (packet.has_syn() && m_state == State::SynSent)
+        process_syn_options(packet);
 
-        dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: receive_tcp_packet: {}", ack_number);
+    if (packet.has_ack())
+        process_acknowledgement(packet, size - packet.header_size());
 
-        int removed = 0;
-        m_unacked_packets.with_exclusive([&](auto& unacked_packets) {
-            while (!unacked_packets.packets.is_empty()) {
-                auto& packet = unacked_packets.packets.first();
-
-                dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: iterate: {}", packet.ack_number);
-
-                if (packet.ack_number <= ack_number) {
-                    auto old_adapter = packet.adapter.strong_ref();
-                    if (old_adapter)
-                        old_adapter->release_packet_buffer(*packet.buffer);
-                    TCPPacket& tcp_packet = *(TCPPacket*)(packet.buffer->buffer->data() + packet.ipv4_payload_offset);
-                    auto payload_size = packet.buffer->buffer->data() + packet.buffer->buffer->size() - (u8*)tcp_packet.payload();
-                    unacked_packets.size -= payload_size;
-                    evaluate_block_conditions();
-                    unacked_packets.packets.take_first();
-                    removed++;
+    m_packets_in++;
+    m_bytes_in += packet.header_size() + size;
+}
+
+void TCPSocket::process_sack_blocks(TCPPacket const& packet, UnackedPackets& unacked_packets)
+{
+    for_each_tcp_option(packet, [&](TCPOptionKind kind, ReadonlyBytes data) {
+        if (kind != TCPOptionKind::SACK || data.size() % sizeof(TCPSACKBlock) != 0)
+            return;
+        for (size_t offset = 0; offset < data.size(); offset += sizeof(TCPSACKBlock)) {
+            u32 left_edge = read_network_ordered_u32(data.slice(offset, sizeof(u32)));
+            u32 right_edge = read_network_ordered_u32(data.slice(offset + sizeof(u32), sizeof(u32)));
+            for (auto& unacked_packet : unacked_packets.packets) {
+                if (unacked_packet.tcp_packet().sequence_number() >= left_edge && unacked_packet.ack_number <= right_edge)
+                    unacked_packet.sacked = true;
+            }
+        }
+    });
+}
+
+size_t TCPSocket::bytes_in_flight(UnackedPackets const& unacked_packets)
+{
+    size_t bytes = 0;
+    for (auto const& unacked_packet : unacked_packets.packets) {
+        if (!unacked_packet.sacked)
+            bytes += unacked_packet.payload_size;
+    }
+    return bytes;
+}
+
+void TCPSocket::update_round_trip_time(Time sample)
+{
+    // RFC 6298, 2. The Basic Algorithm
+    i64 sample_us = sample.to_microseconds();
+    if (!m_has_round_trip_time_sample) {
+        m_smoothed_round_trip_time = sample;
+        m_round_trip_time_variance = Time::from_microseconds(sample_us / 2);
+        m_has_round_trip_time_sample = true;
+    } else {
+        i64 smoothed_us = m_smoothed_round_trip_time.to_microseconds();
+        i64 variance_us = m_round_trip_time_variance.to_microseconds();
+        i64 error_us = smoothed_us > sample_us ? smoothed_us - sample_us : sample_us - smoothed_us;
+        m_round_trip_time_variance = Time::from_microseconds((3 * variance_us + error_us) / 4);
+        m_smoothed_round_trip_time = Time::from_microseconds((7 * smoothed_us + sample_us) / 8);
+    }
+
+    // The clock granularity is how often the network task looks for packets to retransmit.
+    auto clock_granularity = Time::from_milliseconds(500);
+    auto variance_term = Time::from_microseconds(4 * m_round_trip_time_variance.to_microseconds());
+    auto retransmit_timeout = m_smoothed_round_trip_time + max(clock_granularity, variance_term);
+    m_retransmit_timeout = clamp(retransmit_timeout, minimum_retransmit_timeout, maximum_retransmit_timeout);
+
+    dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket({}): RTT sample {}us, SRTT {}us, RTO {}ms",
+        this, sample_us, m_smoothed_round_trip_time.to_microseconds(), m_retransmit_timeout.to_milliseconds());
+}
+
+void TCPSocket::process_acknowledgement(TCPPacket const& packet, size_t payload_size)
+{
+    u32 ack_number = packet.ack_number();
+
+    dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: receive_tcp_packet: {}", ack_number);
+
+    // RFC 7323, 2.2: The window field in a SYN segment is never scaled.
+    u8 window_shift = packet.has_syn() ? 0 : m_send_window_scale;
+    m_send_window_size = static_cast<u32>(packet.window_size()) << window_shift;
+
+    auto now = kgettimeofday();
+    int removed = 0;
+    m_unacked_packets.with_exclusive([&](auto& unacked_packets) {
+        // RFC 5681, 2. Definitions: DUPLICATE ACKNOWLEDGMENT
+        bool is_duplicate_ack = !unacked_packets.packets.is_empty()
+            && ack_number == m_last_ack_number_received
+            && payload_size == 0
+            && !packet.has_syn() && !packet.has_fin()
+            && packet.window_size() == m_last_window_size_received;
+        m_last_window_size_received = packet.window_size();
+
+        if (m_sack_enabled)
+            process_sack_blocks(packet, unacked_packets);
+
+        size_t acknowledged_bytes = 0;
+        Optional<Time> round_trip_time_sample;
+        while (!unacked_packets.packets.is_empty()) {
+            auto& unacked_packet = unacked_packets.packets.first();
+
+            dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: iterate: {}", unacked_packet.ack_number);
+
+            if (unacked_packet.ack_number > ack_number)
+                break;
+
+            // Karn's algorithm: Retransmitted segments don't give us usable samples.
+            if (unacked_packet.tx_counter == 0)
+                round_trip_time_sample = now - unacked_packet.sent_time;
+
+            auto old_adapter = unacked_packet.adapter.strong_ref();
+            if (old_adapter)
+                old_adapter->release_packet_buffer(*unacked_packet.buffer);
+            unacked_packets.size -= unacked_packet.payload_size;
+            acknowledged_bytes += unacked_packet.payload_size;
+            unacked_packets.packets.take_first();
+            removed++;
+        }
+
+        if (round_trip_time_sample.has_value())
+            update_round_trip_time(round_trip_time_sample.value());
+
+        if (removed > 0) {
+            m_last_ack_number_received = ack_number;
+            m_duplicate_acks_received = 0;
+            // RFC 6298, 5.3: Restart the timer when new data is acknowledged.
+            m_retransmit_timer_start = now;
+            m_retransmit_attempts = 0;
+
+            if (m_in_fast_recovery) {
+                if (ack_number >= m_recovery_point) {
+                    m_in_fast_recovery = false;
+                    m_congestion_control->on_exit_fast_recovery(bytes_in_flight(unacked_packets));
                 } else {
-                    break;
+                    // RFC 6582, 3.2, step 3: A partial ACK means the next segment was lost as well.
+                    retransmit_first_unacked_packet(unacked_packets);
+                    m_congestion_control->on_partial_ack(acknowledged_bytes);
+                }
+            } else {
+                m_congestion_control->on_ack(acknowledged_bytes);
+                if (m_in_timeout_recovery) {
+                    if (ack_number >= m_recovery_point)
+                        m_in_timeout_recovery = false;
+                    else
+                        retransmit_lost_packets(unacked_packets);
                 }
             }
-
-            if (unacked_packets.packets.is_empty()) {
-                m_retransmit_attempts = 0;
-                dequeue_for_retransmit();
+            evaluate_block_conditions();
+        } else if (is_duplicate_ack) {
+            ++m_duplicate_acks_received;
+            if (m_in_fast_recovery) {
+                m_congestion_control->on_duplicate_ack_in_fast_recovery();
+                evaluate_block_conditions();
+            } else if (m_duplicate_acks_received == duplicate_acks_before_fast_retransmit && !m_in_timeout_recovery && ack_number > m_recovery_point) {
+                dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket({}): {} duplicate ACKs for {}, entering fast recovery", this, m_duplicate_acks_received, ack_number);
+                m_in_fast_recovery = true;
+                m_recovery_point = m_sequence_number;
+                m_congestion_control->on_enter_fast_recovery(bytes_in_flight(unacked_packets));
+                retransmit_first_unacked_packet(unacked_packets);
             }
+        }
 
-            dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: receive_tcp_packet acknowledged {} packets", removed);
-        });
-    }
+        if (unacked_packets.packets.is_empty()) {
+            m_retransmit_attempts = 0;
+            dequeue_for_retransmit();
+        }
 
-    m_packets_in++;
-    m_bytes_in += packet.header_size() + size;
+        dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: receive_tcp_packet acknowledged {} packets", removed);
+    });
 }
 
 bool TCPSocket::should_delay_next_ack() const
 {
-    // FIXME: We don't know the MSS here so make a reasonable guess.
-    const size_t mss = 1500;
+    // FIXME: We don't know the MSS we announced here, so use the peer's as a reasonable guess.
+    const size_t mss = m_send_maximum_segment_size;
 
     // RFC 1122 says we should send an ACK for every two full-sized segments.
     if (m_ack_number >= m_last_ack_number_sent + 2 * mss)
@@ -577,18 +856,19 @@ void TCPSocket::retransmit_packets()
 {
     auto now = kgettimeofday();
 
-    // RFC6298 says we should have at least one second between retransmits. According to
-    // RFC1122 we must do exponential backoff - even for SYN packets.
-    i64 retransmit_interval = 1;
-    for (decltype(m_retransmit_attempts) i = 0; i < m_retransmit_attempts; i++)
-        retransmit_interval *= 2;
+    // RFC 6298, 5.5: Back off the timer every time it expires. According to RFC1122 we must
+    // do exponential backoff - even for SYN packets.
+    auto retransmit_timeout = m_retransmit_timeout;
+    for (decltype(m_retransmit_attempts) i = 0; i < m_retransmit_attempts && retransmit_timeout < maximum_retransmit_timeout; i++)
+        retransmit_timeout += retransmit_timeout;
+    retransmit_timeout = min(retransmit_timeout, maximum_retransmit_timeout);
 
-    if (m_last_retransmit_time > now - Time::from_seconds(retransmit_interval))
+    if (now < m_retransmit_timer_start + retransmit_timeout)
         return;
 
     dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket({}) handling retransmit", this);
 
-    m_last_retransmit_time = now;
+    m_retransmit_timer_start = now;
     ++m_retransmit_attempts;
 
     if (m_retransmit_attempts > maximum_retransmits) {
@@ -598,46 +878,166 @@ void TCPSocket::retransmit_packets()
         return;
     }
 
+    m_unacked_packets.with_exclusive([&](auto& unacked_packets) {
+        if (unacked_packets.packets.is_empty())
+            return;
+
+        // RFC 5681, 3.1: Only the first timeout for a segment shrinks the slow start threshold.
+        if (m_retransmit_attempts == 1)
+            m_congestion_control->on_retransmit_timeout(bytes_in_flight(unacked_packets));
+
+        // RFC 2018, 8: The peer may have discarded the data it told us about in SACK blocks,
+        // so start over and consider everything that is still in flight lost.
+        for (auto& unacked_packet : unacked_packets.packets) {
+            unacked_packet.sacked = false;
+            unacked_packet.lost = true;
+        }
+
+        m_in_fast_recovery = false;
+        m_in_timeout_recovery = true;
+        m_recovery_point = m_sequence_number;
+        m_duplicate_acks_received = 0;
+
+        retransmit_lost_packets(unacked_packets);
+    });
+}
+
+void TCPSocket::retransmit_first_unacked_packet(UnackedPackets& unacked_packets)
+{
     auto routing_decision = route_to(peer_address(), local_address(), bound_interface());
     if (routing_decision.is_zero())
         return;
 
-    m_unacked_packets.with_exclusive([&](auto& unacked_packets) {
-        for (auto& packet : unacked_packets.packets) {
-            packet.tx_counter++;
-
-            if constexpr (TCP_SOCKET_DEBUG) {
-                auto& tcp_packet = *(const TCPPacket*)(packet.buffer->buffer->data() + packet.ipv4_payload_offset);
-                dbgln("Sending TCP packet from {}:{} to {}:{} with ({}{}{}{}) seq_no={}, ack_no={}, tx_counter={}",
-                    local_address(), local_port(),
-                    peer_address(), peer_port(),
-                    (tcp_packet.has_syn() ? "SYN " : ""),
-                    (tcp_packet.has_ack() ? "ACK " : ""),
-                    (tcp_packet.has_fin() ? "FIN " : ""),
-                    (tcp_packet.has_rst() ? "RST " : ""),
-                    tcp_packet.sequence_number(),
-                    tcp_packet.ack_number(),
-                    packet.tx_counter);
-            }
+    for (auto& unacked_packet : unacked_packets.packets) {
+        // The peer already has the segments it told us about in SACK blocks.
+        if (unacked_packet.sacked)
+            continue;
+        retransmit_packet(unacked_packet, routing_decision);
+        return;
+    }
+}
 
-            size_t ipv4_payload_offset = routing_decision.adapter->ipv4_payload_offset();
-            if (ipv4_payload_offset != packet.ipv4_payload_offset) {
-                // FIXME: Add support for this. This can happen if after a route change
-                // we ended up on another adapter which doesn't have the same layer 2 type
-                // like the previous adapter.
-                VERIFY_NOT_REACHED();
-            }
+void TCPSocket::retransmit_lost_packets(UnackedPackets& unacked_packets)
+{
+    auto routing_decision = route_to(peer_address(), local_address(), bound_interface());
+    if (routing_decision.is_zero())
+        return;
+
+    // Everything from the first unacknowledged segment counts against the congestion window,
+    // so this resends one segment right after the timeout and a growing number of them with
+    // every ACK after that (RFC 5681, 3.1).
+    size_t window = max(m_congestion_control->congestion_window(), m_congestion_control->maximum_segment_size());
+    size_t bytes_in_window = 0;
+    for (auto& unacked_packet : unacked_packets.packets) {
+        if (bytes_in_window > 0 && bytes_in_window + unacked_packet.payload_size > window)
+            break;
+        bytes_in_window += unacked_packet.payload_size;
+        if (!unacked_packet.lost || unacked_packet.sacked)
+            continue;
+        unacked_packet.lost = false;
+        retransmit_packet(unacked_packet, routing_decision);
+    }
+}
+
+void TCPSocket::retransmit_packet(OutgoingPacket& packet, RoutingDecision& routing_decision)
+{
+    packet.tx_counter++;
+
+    if constexpr (TCP_SOCKET_DEBUG) {
+        auto& tcp_packet = packet.tcp_packet();
+        dbgln("Sending TCP packet from {}:{} to {}:{} with ({}{}{}{}) seq_no={}, ack_no={}, tx_counter={}",
+            local_address(), local_port(),
+            peer_address(), peer_port(),
+            (tcp_packet.has_syn() ? "SYN " : ""),
+            (tcp_packet.has_ack() ? "ACK " : ""),
+            (tcp_packet.has_fin() ? "FIN " : ""),
+            (tcp_packet.has_rst() ? "RST " : ""),
+            tcp_packet.sequence_number(),
+            tcp_packet.ack_number(),
+            packet.tx_counter);
+    }
 
-            auto packet_buffer = packet.buffer->bytes();
+    size_t ipv4_payload_offset = routing_decision.adapter->ipv4_payload_offset();
+    if (ipv4_payload_offset != packet.ipv4_payload_offset) {
+        // FIXME: Add support for this. This can happen if after a route change
+        // we ended up on another adapter which doesn't have the same layer 2 type
+        // like the previous adapter.
+        VERIFY_NOT_REACHED();
+    }
+
+    auto packet_buffer = packet.buffer->bytes();
+
+    if (packet.offload.segment_size && !routing_decision.adapter->has_offload(NetworkAdapterOffload::TCPSegmentation)) {
+        // The route changed to an adapter that can't split the packet up for us, so do it ourselves.
+        retransmit_packet_in_segments(packet, routing_decision);
+        return;
+    }
+    if (packet.offload.checksum && !routing_decision.adapter->has_offload(NetworkAdapterOffload::TransmitChecksum)) {
+        auto& tcp_packet = packet.tcp_packet();
+        tcp_packet.set_checksum(0);
+        tcp_packet.set_checksum(compute_tcp_checksum(local_address(), peer_address(), tcp_packet, packet.payload_size));
+        packet.offload = {};
+    }
 
-            routing_decision.adapter->fill_in_ipv4_header(*packet.buffer,
-                local_address(), routing_decision.next_hop, peer_address(),
-                IPv4Protocol::TCP, packet_buffer.size() - ipv4_payload_offset, type_of_service(), ttl());
-            routing_decision.adapter->send_packet(packet_buffer);
-            m_packets_out++;
-            m_bytes_out += packet_buffer.size();
+    routing_decision.adapter->fill_in_ipv4_header(*packet.buffer,
+        local_address(), routing_decision.next_hop, peer_address(),
+        IPv4Protocol::TCP, packet_buffer.size() - ipv4_payload_offset, type_of_service(), ttl());
+    routing_decision.adapter->send_packet(packet_buffer, packet.offload);
+    m_packets_out++;
+    m_bytes_out += packet_buffer.size();
+}
+
+void TCPSocket::retransmit_packet_in_segments(OutgoingPacket const& packet, RoutingDecision& routing_decision)
+{
+    auto& adapter = *routing_decision.adapter;
+    auto const& original_tcp_packet = packet.tcp_packet();
+    size_t const ipv4_payload_offset = packet.ipv4_payload_offset;
+    size_t const tcp_header_size = original_tcp_packet.header_size();
+    size_t const mss = maximum_segment_size_for(adapter);
+    auto const* payload = static_cast<u8 const*>(original_tcp_packet.payload());
+
+    dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket({}): Retransmitting {} bytes as segments of {} through {}", this, packet.payload_size, mss, adapter.name());
+
+    for (size_t offset = 0; offset < packet.payload_size; offset += mss) {
+        size_t const segment_payload_size = min(mss, packet.payload_size - offset);
+        bool const is_last_segment = offset + segment_payload_size == packet.payload_size;
+        size_t const buffer_size = ipv4_payload_offset + tcp_header_size + segment_payload_size;
+
+        auto segment = adapter.acquire_packet_buffer(buffer_size);
+        if (!segment) {
+            // The retransmit timer will try again.
+            dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket({}): Out of packet buffers while retransmitting in segments", this);
+            return;
         }
-    });
+
+        auto& tcp_packet = *(TCPPacket*)(segment->buffer->data() + ipv4_payload_offset);
+        memcpy(&tcp_packet, &original_tcp_packet, tcp_header_size);
+        memcpy(tcp_packet.payload(), payload + offset, segment_payload_size);
+        tcp_packet.set_sequence_number(original_tcp_packet.sequence_number() + offset);
+        // Like the adapter would, only let the last segment push or finish.
+        if (!is_last_segment)
+            tcp_packet.set_flags(tcp_packet.flags() & ~(TCPFlags::PSH | TCPFlags::FIN));
+
+        TransmitOffload offload;
+        if (adapter.has_offload(NetworkAdapterOffload::TransmitChecksum)) {
+            offload.checksum = true;
+            offload.protocol = IPv4Protocol::TCP;
+            offload.checksum_start = ipv4_payload_offset;
+            offload.checksum_offset = ipv4_payload_offset + TCPPacket::checksum_offset;
+            tcp_packet.set_checksum(ipv4_pseudo_header_sum(local_address(), peer_address(), IPv4Protocol::TCP, tcp_header_size + segment_payload_size));
+        } else {
+            tcp_packet.set_checksum(0);
+            tcp_packet.set_checksum(compute_tcp_checksum(local_address(), peer_address(), tcp_packet, segment_payload_size));
+        }
+
+        adapter.fill_in_ipv4_header(*segment,
+            local_address(), routing_decision.next_hop, peer_address(),
+            IPv4Protocol::TCP, buffer_size - ipv4_payload_offset, type_of_service(), ttl());
+        adapter.send_packet(segment->bytes(), offload);
+        adapter.release_packet_buffer(*segment);
+        m_packets_out++;
+        m_bytes_out += buffer_size;
+    }
 }
 
 bool TCPSocket::can_write(OpenFileDescription const& file_description, u64 size) const
@@ -651,8 +1051,10 @@ bool TCPSocket::can_write(OpenFileDescription const& file_description, u64 size)
     if (!file_description.is_blocking())
         return true;
 
+    // We may have as much in flight as both the peer and the network can take.
+    size_t window = min<size_t>(m_send_window_size, m_congestion_control->congestion_window());
     return m_unacked_packets.with_shared([&](auto& unacked_packets) {
-        return unacked_packets.size + size <= m_send_window_size;
+        return unacked_packets.size + size <= window;
     });
 }
 }
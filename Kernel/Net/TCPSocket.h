@@ -13,6 +13,8 @@
 #include <Kernel/Library/LockWeakPtr.h>
 #include <Kernel/Locking/MutexProtected.h>
 #include <Kernel/Net/IPv4Socket.h>
+#include <Kernel/Net/TCP.h>
+#include <Kernel/Net/TCPCongestionControl.h>
 
 namespace Kernel {
 
@@ -134,6 +136,14 @@ public:
     u32 packets_out() const { return m_packets_out; }
     u32 bytes_out() const { return m_bytes_out; }
 
+    u32 send_window_size() const { return m_send_window_size; }
+    u16 send_maximum_segment_size() const { return m_send_maximum_segment_size; }
+    bool is_window_scaling_enabled() const { return m_window_scaling_enabled; }
+    bool is_sack_enabled() const { return m_sack_enabled; }
+    TCPCongestionControl const& congestion_control() const { return *m_congestion_control; }
+    Time smoothed_round_trip_time() const { return m_smoothed_round_trip_time; }
+    Time retransmit_timeout() const { return m_retransmit_timeout; }
+
     // FIXME: Make this configurable?
     static constexpr u32 maximum_duplicate_acks = 5;
     void set_duplicate_acks(u32 acks) { m_duplicate_acks = acks; }
@@ -142,6 +152,7 @@ public:
     ErrorOr<void> send_ack(bool allow_duplicate = false);
     ErrorOr<void> send_tcp_packet(u16 flags, UserOrKernelBuffer const* = nullptr, size_t = 0, RoutingDecision* = nullptr);
     void receive_tcp_packet(TCPPacket const&, u16 size);
+    void process_syn_options(TCPPacket const&);
 
     bool should_delay_next_ack() const;
 
@@ -168,7 +179,7 @@ protected:
     void set_direction(Direction direction) { m_direction = direction; }
 
 private:
-    explicit TCPSocket(int protocol, NonnullOwnPtr<DoubleBuffer> receive_buffer, NonnullOwnPtr<KBuffer> scratch_buffer);
+    explicit TCPSocket(int protocol, NonnullOwnPtr<DoubleBuffer> receive_buffer, NonnullOwnPtr<KBuffer> scratch_buffer, NonnullOwnPtr<TCPCongestionControl>);
     virtual StringView class_name() const override { return "TCPSocket"sv; }
 
     virtual void shut_down_for_writing() override;
@@ -185,6 +196,20 @@ private:
     void enqueue_for_retransmit();
     void dequeue_for_retransmit();
 
+    struct OutgoingPacket;
+    struct UnackedPackets;
+
+    u16 advertised_window_size(u16 flags) const;
+    size_t maximum_segment_size_for(NetworkAdapter const&) const;
+    void process_acknowledgement(TCPPacket const&, size_t payload_size);
+    void process_sack_blocks(TCPPacket const&, UnackedPackets&);
+    void update_round_trip_time(Time sample);
+    void retransmit_first_unacked_packet(UnackedPackets&);
+    void retransmit_lost_packets(UnackedPackets&);
+    void retransmit_packet(OutgoingPacket&, RoutingDecision&);
+    void retransmit_packet_in_segments(OutgoingPacket const&, RoutingDecision&);
+    static size_t bytes_in_flight(UnackedPackets const&);
+
     LockWeakPtr<TCPSocket> m_originator;
     HashMap<IPv4SocketTuple, NonnullLockRefPtr<TCPSocket>> m_pending_release_for_accept;
     Direction m_direction { Direction::Unspecified };
@@ -204,6 +229,14 @@ private:
         size_t ipv4_payload_offset;
         LockWeakPtr<NetworkAdapter> adapter;
         int tx_counter { 0 };
+        Time sent_time {};
+        size_t payload_size { 0 };
+        bool sacked { false };
+        bool lost { false };
+        TransmitOffload offload {};
+
+        TCPPacket& tcp_packet() { return *(TCPPacket*)(buffer->buffer->data() + ipv4_payload_offset); }
+        TCPPacket const& tcp_packet() const { return *(TCPPacket const*)(buffer->buffer->data() + ipv4_payload_offset); }
     };
 
     struct UnackedPackets {
@@ -215,15 +248,45 @@ private:
 
     u32 m_duplicate_acks { 0 };
 
+    // The peer's side of the duplicate ACK dance: three of them trigger a fast retransmit.
+    static constexpr u32 duplicate_acks_before_fast_retransmit = 3;
+    u32 m_duplicate_acks_received { 0 };
+    u32 m_last_ack_number_received { 0 };
+    u16 m_last_window_size_received { 0 };
+
+    NonnullOwnPtr<TCPCongestionControl> m_congestion_control;
+    // Set while we are retransmitting the segments that were in flight when loss was detected,
+    // until everything up to m_recovery_point has been acknowledged.
+    bool m_in_fast_recovery { false };
+    bool m_in_timeout_recovery { false };
+    u32 m_recovery_point { 0 };
+
     u32 m_last_ack_number_sent { 0 };
     Time m_last_ack_sent_time;
 
     // FIXME: Make this configurable (sysctl)
     static constexpr u32 maximum_retransmits = 5;
-    Time m_last_retransmit_time;
+    Time m_retransmit_timer_start;
     u32 m_retransmit_attempts { 0 };
 
-    // FIXME: Parse window size TCP option from the peer
+    // RFC 6298, 2. The Basic Algorithm
+    bool m_has_round_trip_time_sample { false };
+    Time m_smoothed_round_trip_time;
+    Time m_round_trip_time_variance;
+    static constexpr Time minimum_retransmit_timeout = Time::from_seconds(1);
+    static constexpr Time maximum_retransmit_timeout = Time::from_seconds(60);
+    Time m_retransmit_timeout { minimum_retransmit_timeout };
+
+    // RFC 9293, 3.7.1. Maximum Segment Size Option: without the option, assume 536 bytes.
+    static constexpr u16 default_maximum_segment_size = 536;
+    u16 m_send_maximum_segment_size { default_maximum_segment_size };
+
+    // Window scaling (RFC 7323) and SACK (RFC 2018) are offered in our SYN, and stay
+    // enabled only if the peer offers them too.
+    bool m_window_scaling_enabled { true };
+    bool m_sack_enabled { true };
+    u8 m_send_window_scale { 0 };
+    u8 m_receive_window_scale { 0 };
     u32 m_send_window_size { 64 * KiB };
 
     IntrusiveListNode<TCPSocket> m_retransmit_list_node;
@@ -12,6 +12,8 @@ namespace Kernel {
 
 class [[gnu::packed]] UDPPacket {
 public:
+    static constexpr size_t checksum_offset = 6;
+
     UDPPacket() = default;
     ~UDPPacket() = default;
 
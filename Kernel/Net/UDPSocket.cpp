@@ -101,7 +101,18 @@ ErrorOr<size_t> UDPSocket::protocol_send(UserOrKernelBuffer const& data, size_t
     SOCKET_TRY(data.read(udp_packet.payload(), data_length));
     routing_decision.adapter->fill_in_ipv4_header(*packet, local_address(), routing_decision.next_hop,
         peer_address(), IPv4Protocol::UDP, udp_buffer_size, type_of_service(), ttl());
-    routing_decision.adapter->send_packet(packet->bytes());
+
+    // We don't compute UDP checksums ourselves (they are optional over IPv4), but we can
+    // have the adapter fill them in for free.
+    TransmitOffload offload;
+    if (routing_decision.adapter->has_offload(NetworkAdapterOffload::TransmitChecksum)) {
+        udp_packet.set_checksum(ipv4_pseudo_header_sum(local_address(), peer_address(), IPv4Protocol::UDP, udp_buffer_size));
+        offload.checksum = true;
+        offload.protocol = IPv4Protocol::UDP;
+        offload.checksum_start = ipv4_payload_offset;
+        offload.checksum_offset = ipv4_payload_offset + UDPPacket::checksum_offset;
+    }
+    routing_decision.adapter->send_packet(packet->bytes(), offload);
     return data_length;
 }
 
@@ -78,6 +78,23 @@ ErrorOr<void> PerformanceEventBuffer::append_with_ip_and_bp(ProcessID pid, Threa
     if (count() >= capacity())
         return ENOBUFS;
 
+    PerformanceEvent event;
+    TRY(fill_event(event, pid, tid, ip, bp, type, lost_samples, arg1, arg2, arg3, arg4, arg5, arg6));
+    at(m_count++) = event;
+    return {};
+}
+
+ErrorOr<void> PerformanceEventBuffer::append_event(PerformanceEvent const& event)
+{
+    if (count() >= capacity())
+        return ENOBUFS;
+    at(m_count++) = event;
+    return {};
+}
+
+ErrorOr<void> PerformanceEventBuffer::fill_event(PerformanceEvent& event, ProcessID pid, ThreadID tid,
+    FlatPtr ip, FlatPtr bp, int type, u32 lost_samples, FlatPtr arg1, FlatPtr arg2, StringView arg3, FlatPtr arg4, u64 arg5, ErrorOr<FlatPtr> const& arg6)
+{
     if ((g_profiling_event_mask & type) == 0)
         return EINVAL;
 
@@ -92,7 +109,6 @@ ErrorOr<void> PerformanceEventBuffer::append_with_ip_and_bp(ProcessID pid, Threa
     if (enter_count > 0)
         return EINVAL;
 
-    PerformanceEvent event;
     event.type = type;
     event.lost_samples = lost_samples;
 
@@ -177,7 +193,6 @@ ErrorOr<void> PerformanceEventBuffer::append_with_ip_and_bp(ProcessID pid, Threa
     event.pid = pid.value();
     event.tid = tid.value();
     event.timestamp = TimeManagement::the().uptime_ms();
-    at(m_count++) = event;
     return {};
 }
 
@@ -188,6 +203,108 @@ PerformanceEvent& PerformanceEventBuffer::at(size_t index)
     return events[index];
 }
 
+template<typename Serializer>
+ErrorOr<void> PerformanceEventBuffer::add_event_to_json(Serializer& event_object, PerformanceEvent const& event, bool show_kernel_addresses, u32 lost_samples)
+{
+    switch (event.type) {
+    case PERF_EVENT_SAMPLE:
+        TRY(event_object.add("type"sv, "sample"));
+        break;
+    case PERF_EVENT_MALLOC:
+        TRY(event_object.add("type"sv, "malloc"));
+        TRY(event_object.add("ptr"sv, static_cast<u64>(event.data.malloc.ptr)));
+        TRY(event_object.add("size"sv, static_cast<u64>(event.data.malloc.size)));
+        break;
+    case PERF_EVENT_FREE:
+        TRY(event_object.add("type"sv, "free"));
+        TRY(event_object.add("ptr"sv, static_cast<u64>(event.data.free.ptr)));
+        break;
+    case PERF_EVENT_MMAP:
+        TRY(event_object.add("type"sv, "mmap"));
+        TRY(event_object.add("ptr"sv, static_cast<u64>(event.data.mmap.ptr)));
+        TRY(event_object.add("size"sv, static_cast<u64>(event.data.mmap.size)));
+        TRY(event_object.add("name"sv, event.data.mmap.name));
+        break;
+    case PERF_EVENT_MUNMAP:
+        TRY(event_object.add("type"sv, "munmap"));
+        TRY(event_object.add("ptr"sv, static_cast<u64>(event.data.munmap.ptr)));
+        TRY(event_object.add("size"sv, static_cast<u64>(event.data.munmap.size)));
+        break;
+    case PERF_EVENT_PROCESS_CREATE:
+        TRY(event_object.add("type"sv, "process_create"));
+        TRY(event_object.add("parent_pid"sv, static_cast<u64>(event.data.process_create.parent_pid)));
+        TRY(event_object.add("executable"sv, event.data.process_create.executable));
+        break;
+    case PERF_EVENT_PROCESS_EXEC:
+        TRY(event_object.add("type"sv, "process_exec"));
+        TRY(event_object.add("executable"sv, event.data.process_exec.executable));
+        break;
+    case PERF_EVENT_PROCESS_EXIT:
+        TRY(event_object.add("type"sv, "process_exit"));
+        break;
+    case PERF_EVENT_THREAD_CREATE:
+        TRY(event_object.add("type"sv, "thread_create"));
+        TRY(event_object.add("parent_tid"sv, static_cast<u64>(event.data.thread_create.parent_tid)));
+        break;
+    case PERF_EVENT_THREAD_EXIT:
+        TRY(event_object.add("type"sv, "thread_exit"));
+        break;
+    case PERF_EVENT_CONTEXT_SWITCH:
+        TRY(event_object.add("type"sv, "context_switch"));
+        TRY(event_object.add("next_pid"sv, static_cast<u64>(event.data.context_switch.next_pid)));
+        TRY(event_object.add("next_tid"sv, static_cast<u64>(event.data.context_switch.next_tid)));
+        break;
+    case PERF_EVENT_KMALLOC:
+        TRY(event_object.add("type"sv, "kmalloc"));
+        TRY(event_object.add("ptr"sv, static_cast<u64>(event.data.kmalloc.ptr)));
+        TRY(event_object.add("size"sv, static_cast<u64>(event.data.kmalloc.size)));
+        break;
+    case PERF_EVENT_KFREE:
+        TRY(event_object.add("type"sv, "kfree"));
+        TRY(event_object.add("ptr"sv, static_cast<u64>(event.data.kfree.ptr)));
+        TRY(event_object.add("size"sv, static_cast<u64>(event.data.kfree.size)));
+        break;
+    case PERF_EVENT_PAGE_FAULT:
+        TRY(event_object.add("type"sv, "page_fault"));
+        break;
+    case PERF_EVENT_SYSCALL:
+        TRY(event_object.add("type"sv, "syscall"));
+        break;
+    case PERF_EVENT_SIGNPOST:
+        TRY(event_object.add("type"sv, "signpost"sv));
+        TRY(event_object.add("arg1"sv, event.data.signpost.arg1));
+        TRY(event_object.add("arg2"sv, event.data.signpost.arg2));
+        break;
+    case PERF_EVENT_READ:
+        TRY(event_object.add("type"sv, "read"));
+        TRY(event_object.add("fd"sv, event.data.read.fd));
+        TRY(event_object.add("size"sv, event.data.read.size));
+        TRY(event_object.add("filename_index"sv, event.data.read.filename_index));
+        TRY(event_object.add("start_timestamp"sv, event.data.read.start_timestamp));
+        TRY(event_object.add("success"sv, event.data.read.success));
+        break;
+    }
+    TRY(event_object.add("pid"sv, event.pid));
+    TRY(event_object.add("tid"sv, event.tid));
+    TRY(event_object.add("timestamp"sv, event.timestamp));
+    TRY(event_object.add("lost_samples"sv, lost_samples));
+    auto stack_array = TRY(event_object.add_array("stack"sv));
+    for (size_t j = 0; j < event.stack_size; ++j) {
+        auto address = event.stack[j];
+        if (!show_kernel_addresses && !Memory::is_user_address(VirtualAddress { address }))
+            address = 0xdeadc0de;
+        TRY(stack_array.add(address));
+    }
+    TRY(stack_array.finish());
+    return event_object.finish();
+}
+
+ErrorOr<void> PerformanceEventBuffer::event_to_json(KBufferBuilder& builder, PerformanceEvent const& event, bool show_kernel_addresses)
+{
+    auto event_object = TRY(JsonObjectSerializer<>::try_create(builder));
+    return add_event_to_json(event_object, event, show_kernel_addresses, event.lost_samples);
+}
+
 template<typename Serializer>
 ErrorOr<void> PerformanceEventBuffer::to_json_impl(Serializer& object) const
 {
@@ -220,99 +337,9 @@ ErrorOr<void> PerformanceEventBuffer::to_json_impl(Serializer& object) const
         }
 
         auto event_object = TRY(array.add_object());
-        switch (event.type) {
-        case PERF_EVENT_SAMPLE:
-            TRY(event_object.add("type"sv, "sample"));
-            break;
-        case PERF_EVENT_MALLOC:
-            TRY(event_object.add("type"sv, "malloc"));
-            TRY(event_object.add("ptr"sv, static_cast<u64>(event.data.malloc.ptr)));
-            TRY(event_object.add("size"sv, static_cast<u64>(event.data.malloc.size)));
-            break;
-        case PERF_EVENT_FREE:
-            TRY(event_object.add("type"sv, "free"));
-            TRY(event_object.add("ptr"sv, static_cast<u64>(event.data.free.ptr)));
-            break;
-        case PERF_EVENT_MMAP:
-            TRY(event_object.add("type"sv, "mmap"));
-            TRY(event_object.add("ptr"sv, static_cast<u64>(event.data.mmap.ptr)));
-            TRY(event_object.add("size"sv, static_cast<u64>(event.data.mmap.size)));
-            TRY(event_object.add("name"sv, event.data.mmap.name));
-            break;
-        case PERF_EVENT_MUNMAP:
-            TRY(event_object.add("type"sv, "munmap"));
-            TRY(event_object.add("ptr"sv, static_cast<u64>(event.data.munmap.ptr)));
-            TRY(event_object.add("size"sv, static_cast<u64>(event.data.munmap.size)));
-            break;
-        case PERF_EVENT_PROCESS_CREATE:
-            TRY(event_object.add("type"sv, "process_create"));
-            TRY(event_object.add("parent_pid"sv, static_cast<u64>(event.data.process_create.parent_pid)));
-            TRY(event_object.add("executable"sv, event.data.process_create.executable));
-            break;
-        case PERF_EVENT_PROCESS_EXEC:
-            TRY(event_object.add("type"sv, "process_exec"));
-            TRY(event_object.add("executable"sv, event.data.process_exec.executable));
-            break;
-        case PERF_EVENT_PROCESS_EXIT:
-            TRY(event_object.add("type"sv, "process_exit"));
-            break;
-        case PERF_EVENT_THREAD_CREATE:
-            TRY(event_object.add("type"sv, "thread_create"));
-            TRY(event_object.add("parent_tid"sv, static_cast<u64>(event.data.thread_create.parent_tid)));
-            break;
-        case PERF_EVENT_THREAD_EXIT:
-            TRY(event_object.add("type"sv, "thread_exit"));
-            break;
-        case PERF_EVENT_CONTEXT_SWITCH:
-            TRY(event_object.add("type"sv, "context_switch"));
-            TRY(event_object.add("next_pid"sv, static_cast<u64>(event.data.context_switch.next_pid)));
-            TRY(event_object.add("next_tid"sv, static_cast<u64>(event.data.context_switch.next_tid)));
-            break;
-        case PERF_EVENT_KMALLOC:
-            TRY(event_object.add("type"sv, "kmalloc"));
-            TRY(event_object.add("ptr"sv, static_cast<u64>(event.data.kmalloc.ptr)));
-            TRY(event_object.add("size"sv, static_cast<u64>(event.data.kmalloc.size)));
-            break;
-        case PERF_EVENT_KFREE:
-            TRY(event_object.add("type"sv, "kfree"));
-            TRY(event_object.add("ptr"sv, static_cast<u64>(event.data.kfree.ptr)));
-            TRY(event_object.add("size"sv, static_cast<u64>(event.data.kfree.size)));
-            break;
-        case PERF_EVENT_PAGE_FAULT:
-            TRY(event_object.add("type"sv, "page_fault"));
-            break;
-        case PERF_EVENT_SYSCALL:
-            TRY(event_object.add("type"sv, "syscall"));
-            break;
-        case PERF_EVENT_SIGNPOST:
-            TRY(event_object.add("type"sv, "signpost"sv));
-            TRY(event_object.add("arg1"sv, event.data.signpost.arg1));
-            TRY(event_object.add("arg2"sv, event.data.signpost.arg2));
-            break;
-        case PERF_EVENT_READ:
-            TRY(event_object.add("type"sv, "read"));
-            TRY(event_object.add("fd"sv, event.data.read.fd));
-            TRY(event_object.add("size"sv, event.data.read.size));
-            TRY(event_object.add("filename_index"sv, event.data.read.filename_index));
-            TRY(event_object.add("start_timestamp"sv, event.data.read.start_timestamp));
-            TRY(event_object.add("success"sv, event.data.read.success));
-            break;
-        }
-        TRY(event_object.add("pid"sv, event.pid));
-        TRY(event_object.add("tid"sv, event.tid));
-        TRY(event_object.add("timestamp"sv, event.timestamp));
-        TRY(event_object.add("lost_samples"sv, seen_first_sample ? event.lost_samples : 0));
+        TRY(add_event_to_json(event_object, event, show_kernel_addresses, seen_first_sample ? event.lost_samples : 0));
         if (event.type == PERF_EVENT_SAMPLE)
             seen_first_sample = true;
-        auto stack_array = TRY(event_object.add_array("stack"sv));
-        for (size_t j = 0; j < event.stack_size; ++j) {
-            auto address = event.stack[j];
-            if (!show_kernel_addresses && !Memory::is_user_address(VirtualAddress { address }))
-                address = 0xdeadc0de;
-            TRY(stack_array.add(address));
-        }
-        TRY(stack_array.finish());
-        TRY(event_object.finish());
     }
     TRY(array.finish());
     TRY(object.finish());
@@ -115,6 +115,12 @@ public:
         int type, u32 lost_samples, FlatPtr arg1, FlatPtr arg2, StringView arg3, FlatPtr arg4 = 0, u64 arg5 = {}, ErrorOr<FlatPtr> const& arg6 = 0);
     ErrorOr<void> append_with_ip_and_bp(ProcessID pid, ThreadID tid, RegisterState const& regs,
         int type, u32 lost_samples, FlatPtr arg1, FlatPtr arg2, StringView arg3, FlatPtr arg4 = 0, u64 arg5 = {}, ErrorOr<FlatPtr> const& arg6 = 0);
+    ErrorOr<void> append_event(PerformanceEvent const&);
+
+    // Fills in an event (including its backtrace) without storing it anywhere.
+    static ErrorOr<void> fill_event(PerformanceEvent&, ProcessID pid, ThreadID tid, FlatPtr eip, FlatPtr ebp,
+        int type, u32 lost_samples, FlatPtr arg1, FlatPtr arg2, StringView arg3, FlatPtr arg4 = 0, u64 arg5 = {}, ErrorOr<FlatPtr> const& arg6 = 0);
+    static ErrorOr<void> event_to_json(KBufferBuilder&, PerformanceEvent const&, bool show_kernel_addresses);
 
     void clear()
     {
@@ -139,6 +145,8 @@ private:
 
     template<typename Serializer>
     ErrorOr<void> to_json_impl(Serializer&) const;
+    template<typename Serializer>
+    static ErrorOr<void> add_event_to_json(Serializer&, PerformanceEvent const&, bool show_kernel_addresses, u32 lost_samples);
 
     PerformanceEvent& at(size_t index);
 
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <Kernel/Arch/Processor.h>
+#include <Kernel/KBufferBuilder.h>
+#include <Kernel/Locking/Mutex.h>
+#include <Kernel/PerformanceEventRing.h>
+#include <Kernel/Process.h>
+#include <Kernel/Time/TimeManagement.h>
+
+namespace Kernel {
+
+ErrorOr<NonnullOwnPtr<PerformanceEventRing>> PerformanceEventRing::try_create(size_t capacity)
+{
+    VERIFY(capacity > 0);
+    auto buffer = TRY(KBuffer::try_create_with_size("Performance event ring"sv, capacity * sizeof(PerformanceEvent), Memory::Region::Access::ReadWrite, AllocationStrategy::AllocateNow));
+    return adopt_nonnull_own_or_enomem(new (nothrow) PerformanceEventRing(move(buffer), capacity));
+}
+
+PerformanceEventRing::PerformanceEventRing(NonnullOwnPtr<KBuffer> buffer, size_t capacity)
+    : m_buffer(move(buffer))
+    , m_capacity(capacity)
+{
+}
+
+PerformanceEvent* PerformanceEventRing::slot_for_push()
+{
+    auto head = m_head.load(AK::MemoryOrder::memory_order_relaxed);
+    auto tail = m_tail.load(AK::MemoryOrder::memory_order_acquire);
+    if (head - tail >= m_capacity)
+        return nullptr;
+    return &at(head);
+}
+
+void PerformanceEventRing::commit_push(PerformanceEvent& event)
+{
+    event.lost_samples += m_dropped_since_last_push;
+    m_dropped_since_last_push = 0;
+    m_head.store(m_head.load(AK::MemoryOrder::memory_order_relaxed) + 1, AK::MemoryOrder::memory_order_release);
+}
+
+PerformanceEvent const* PerformanceEventRing::peek()
+{
+    auto tail = m_tail.load(AK::MemoryOrder::memory_order_relaxed);
+    if (m_head.load(AK::MemoryOrder::memory_order_acquire) == tail)
+        return nullptr;
+    return &at(tail);
+}
+
+void PerformanceEventRing::pop()
+{
+    VERIFY(!is_empty());
+    m_tail.store(m_tail.load(AK::MemoryOrder::memory_order_relaxed) + 1, AK::MemoryOrder::memory_order_release);
+}
+
+void PerformanceEventRing::clear()
+{
+    // Only called while there is no producer.
+    m_tail.store(m_head.load(AK::MemoryOrder::memory_order_relaxed), AK::MemoryOrder::memory_order_release);
+    m_dropped_since_last_push = 0;
+}
+
+static Array<OwnPtr<PerformanceEventRing>, MAX_CPU_COUNT> s_rings;
+static Atomic<bool> s_rings_active { false };
+static size_t s_ring_count { 0 };
+
+// Serializes the consumers (the drain task, /sys/kernel/profile and /sys/kernel/profile_stream)
+// against each other and against creating or destroying the rings.
+static Mutex s_consumer_lock { "PerformanceEventRings"sv };
+
+// Uptime (in ms) of the last read from /sys/kernel/profile_stream.
+static Atomic<u64> s_last_stream_read_ms { 0 };
+static constexpr u64 stream_reader_timeout_ms = 1000;
+
+static Atomic<bool> s_drain_task_spawned { false };
+
+ErrorOr<void> PerformanceEventRings::create_if_needed(size_t total_size)
+{
+    MutexLocker locker(s_consumer_lock);
+    if (s_ring_count != 0) {
+        for (size_t i = 0; i < s_ring_count; ++i)
+            s_rings[i]->clear();
+        s_rings_active.store(true);
+        return {};
+    }
+
+    auto processor_count = Processor::count();
+    auto capacity = max(total_size / processor_count / sizeof(PerformanceEvent), static_cast<size_t>(256));
+    for (size_t i = 0; i < processor_count; ++i) {
+        auto ring_or_error = PerformanceEventRing::try_create(capacity);
+        if (ring_or_error.is_error()) {
+            for (size_t j = 0; j < i; ++j)
+                s_rings[j] = nullptr;
+            return ring_or_error.release_error();
+        }
+        s_rings[i] = ring_or_error.release_value();
+    }
+    s_ring_count = processor_count;
+    s_rings_active.store(true);
+    return {};
+}
+
+void PerformanceEventRings::destroy()
+{
+    MutexLocker locker(s_consumer_lock);
+    s_rings_active.store(false);
+    for (size_t i = 0; i < s_ring_count; ++i)
+        s_rings[i] = nullptr;
+    s_ring_count = 0;
+}
+
+PerformanceEventRing* PerformanceEventRings::for_current_processor()
+{
+    if (!s_rings_active.load(AK::MemoryOrder::memory_order_relaxed))
+        return nullptr;
+    auto id = Processor::current_id();
+    if (id >= s_ring_count)
+        return nullptr;
+    return s_rings[id].ptr();
+}
+
+static bool has_recent_stream_reader()
+{
+    auto last_read_ms = s_last_stream_read_ms.load(AK::MemoryOrder::memory_order_relaxed);
+    return last_read_ms != 0 && TimeManagement::the().uptime_ms() - last_read_ms < stream_reader_timeout_ms;
+}
+
+void PerformanceEventRings::drain_into_global_buffer_unless_streaming()
+{
+    MutexLocker locker(s_consumer_lock);
+    if (!g_global_perf_events || has_recent_stream_reader())
+        return;
+    for (size_t i = 0; i < s_ring_count; ++i) {
+        auto& ring = *s_rings[i];
+        while (auto const* event = ring.peek()) {
+            // NOTE: If the global buffer is full the events are dropped, just like they were before.
+            (void)g_global_perf_events->append_event(*event);
+            ring.pop();
+        }
+    }
+}
+
+ErrorOr<size_t> PerformanceEventRings::stream_into(UserOrKernelBuffer& buffer, size_t count, bool show_kernel_addresses)
+{
+    MutexLocker locker(s_consumer_lock);
+    s_last_stream_read_ms.store(max(TimeManagement::the().uptime_ms(), static_cast<u64>(1)), AK::MemoryOrder::memory_order_relaxed);
+
+    bool has_events = false;
+    for (size_t i = 0; i < s_ring_count && !has_events; ++i)
+        has_events = !s_rings[i]->is_empty();
+    if (!has_events)
+        return 0;
+
+    auto builder = TRY(KBufferBuilder::try_create());
+    size_t nwritten = 0;
+    bool buffer_is_full = false;
+    for (size_t i = 0; i < s_ring_count && !buffer_is_full; ++i) {
+        auto& ring = *s_rings[i];
+        while (auto const* event = ring.peek()) {
+            if (!show_kernel_addresses && (event->type == PERF_EVENT_KMALLOC || event->type == PERF_EVENT_KFREE)) {
+                ring.pop();
+                continue;
+            }
+            TRY(PerformanceEventBuffer::event_to_json(builder, *event, show_kernel_addresses));
+            TRY(builder.append('\n'));
+            if (builder.length() > count) {
+                buffer_is_full = true;
+                break;
+            }
+            nwritten = builder.length();
+            ring.pop();
+        }
+    }
+    if (nwritten == 0) {
+        // Either everything was filtered out, or the reader's buffer can't even fit a single event.
+        if (buffer_is_full)
+            return EINVAL;
+        return 0;
+    }
+    TRY(buffer.write(builder.bytes().data(), nwritten));
+    return nwritten;
+}
+
+void PerformanceEventRings::spawn_drain_task_if_needed()
+{
+    if (s_drain_task_spawned.exchange(true))
+        return;
+    LockRefPtr<Thread> drain_thread;
+    (void)Process::create_kernel_process(drain_thread, KString::must_create("Profiling Drain Task"sv), [] {
+        for (;;) {
+            if (g_profiling_all_threads)
+                drain_into_global_buffer_unless_streaming();
+            (void)Thread::current()->sleep(Time::from_milliseconds(100));
+        }
+    });
+}
+
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Error.h>
+#include <AK/NonnullOwnPtr.h>
+#include <Kernel/KBuffer.h>
+#include <Kernel/PerformanceEventBuffer.h>
+#include <Kernel/UserOrKernelBuffer.h>
+
+namespace Kernel {
+
+// A fixed-size ring of performance events with a single producer and a single
+// consumer. During system-wide profiling each processor gets one of these for
+// its CPU samples: the producer is the owning processor (from the profile
+// timer interrupt), so pushing never takes a lock and never contends with
+// other processors. When the ring is full, new samples are dropped and
+// accounted for in the lost_samples of the next one that fits.
+class PerformanceEventRing {
+public:
+    static ErrorOr<NonnullOwnPtr<PerformanceEventRing>> try_create(size_t capacity);
+
+    // Must only be called by the owning processor, with interrupts disabled.
+    PerformanceEvent* slot_for_push();
+    void commit_push(PerformanceEvent&);
+    void drop_push() { ++m_dropped_since_last_push; }
+
+    // Must only be called by one consumer at a time.
+    PerformanceEvent const* peek();
+    void pop();
+    bool is_empty() const { return m_head.load(AK::MemoryOrder::memory_order_acquire) == m_tail.load(AK::MemoryOrder::memory_order_relaxed); }
+
+    size_t capacity() const { return m_capacity; }
+    void clear();
+
+private:
+    PerformanceEventRing(NonnullOwnPtr<KBuffer>, size_t capacity);
+
+    PerformanceEvent& at(size_t index) { return reinterpret_cast<PerformanceEvent*>(m_buffer->data())[index % m_capacity]; }
+
+    NonnullOwnPtr<KBuffer> m_buffer;
+    size_t m_capacity { 0 };
+
+    // Free-running counters, only the producer writes m_head and only the consumer writes m_tail.
+    Atomic<size_t> m_head { 0 };
+    Atomic<size_t> m_tail { 0 };
+
+    // Only touched by the producer.
+    u32 m_dropped_since_last_push { 0 };
+};
+
+class PerformanceEventRings {
+public:
+    // Allocates one ring per processor, splitting the given memory budget between them.
+    static ErrorOr<void> create_if_needed(size_t total_size);
+    static void clear();
+    static void destroy();
+
+    // Returns the current processor's ring, if system-wide profiling is using rings.
+    static PerformanceEventRing* for_current_processor();
+
+    // Moves all buffered events into g_global_perf_events, unless someone has
+    // recently been reading /sys/kernel/profile_stream, in which case the
+    // events are left for them.
+    static void drain_into_global_buffer_unless_streaming();
+
+    // Moves as many buffered events as fit into the buffer, as one JSON object per line.
+    static ErrorOr<size_t> stream_into(UserOrKernelBuffer&, size_t count, bool show_kernel_addresses);
+
+    // Starts the kernel task that periodically drains the rings, so that a
+    // profile that isn't being streamed doesn't lose samples.
+    static void spawn_drain_task_if_needed();
+};
+
+}
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <Kernel/PerformanceEventBuffer.h>
+#include <Kernel/PerformanceEventRing.h>
 #include <Kernel/Process.h>
 #include <Kernel/Thread.h>
 #include <Kernel/Time/TimeManagement.h>
@@ -61,6 +62,19 @@ public:
     {
         if (current_thread.is_profiling_suppressed())
             return;
+        // During system-wide profiling, samples go into the current processor's ring without taking any locks.
+        if (g_profiling_all_threads) {
+            if (auto* ring = PerformanceEventRings::for_current_processor()) {
+                auto* event = ring->slot_for_push();
+                if (!event) {
+                    ring->drop_push();
+                    return;
+                }
+                if (!PerformanceEventBuffer::fill_event(*event, current_thread.pid(), current_thread.tid(), regs.ip(), regs.bp(), PERF_EVENT_SAMPLE, lost_time, 0, 0, {}).is_error())
+                    ring->commit_push(*event);
+                return;
+            }
+        }
         if (auto* event_buffer = current_thread.process().current_perf_events_buffer()) {
             [[maybe_unused]] auto rc = event_buffer->append_with_ip_and_bp(
                 current_thread.pid(), current_thread.tid(), regs, PERF_EVENT_SAMPLE, lost_time, 0, 0, {});
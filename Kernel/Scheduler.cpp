@@ -46,7 +46,36 @@ struct ThreadReadyQueues {
     Array<ThreadReadyQueue, count> queues;
 };
 
-static Singleton<SpinlockProtected<ThreadReadyQueues, LockRank::None>> g_ready_queues;
+// Every processor owns a set of ready queues, so that enqueueing and picking threads
+// normally only touches processor-local state. Processors that run out of work (or see
+// higher priority work elsewhere) steal threads from the queues of other processors.
+struct ProcessorReadyQueues {
+    Thread* find_runnable_thread(u32 affinity_mask, u32 priority_limit);
+    Thread* take_runnable_thread(u32 affinity_mask, u32 priority_limit);
+    void enqueue(Thread&, u32 priority, u32 cpu);
+    bool dequeue(Thread&);
+
+    u32 highest_priority_index() const
+    {
+        // Returns ThreadReadyQueues::count if there is no work queued
+        auto mask = this->mask.load(AK::MemoryOrder::memory_order_acquire);
+        if (mask == 0)
+            return ThreadReadyQueues::count;
+        return bit_scan_forward(mask) - 1;
+    }
+
+    SpinlockProtected<ThreadReadyQueues, LockRank::None> ready_queues;
+
+    // Mirror of ThreadReadyQueues::mask that other processors may read without taking
+    // the lock to decide whether it's worth trying to steal from this processor.
+    Atomic<u32> mask { 0 };
+
+private:
+    static Thread* find_runnable_thread_locked(ThreadReadyQueues&, u32 affinity_mask, u32 priority_limit);
+    void remove_locked(ThreadReadyQueues&, Thread&);
+};
+
+static Singleton<Array<ProcessorReadyQueues, MAX_CPU_COUNT>> g_ready_queues;
 
 static SpinlockProtected<TotalTimeScheduled, LockRank::None> g_total_time_scheduled {};
 
@@ -64,70 +93,180 @@ static inline u32 thread_priority_to_priority_index(u32 thread_priority)
     return priority_bucket;
 }
 
-Thread& Scheduler::pull_next_runnable_thread()
+static inline ProcessorReadyQueues& ready_queues_for_processor(u32 cpu)
 {
-    auto affinity_mask = 1u << Processor::current_id();
+    VERIFY(cpu < Processor::count());
+    return (*g_ready_queues)[cpu];
+}
 
-    return g_ready_queues->with([&](auto& ready_queues) -> Thread& {
-        auto priority_mask = ready_queues.mask;
-        while (priority_mask != 0) {
-            auto priority = bit_scan_forward(priority_mask);
-            VERIFY(priority > 0);
-            auto& ready_queue = ready_queues.queues[--priority];
-            for (auto& thread : ready_queue.thread_list) {
-                VERIFY(thread.m_runnable_priority == (int)priority);
-                if (thread.is_active())
-                    continue;
-                if (!(thread.affinity() & affinity_mask))
-                    continue;
-                thread.m_runnable_priority = -1;
-                ready_queue.thread_list.remove(thread);
-                if (ready_queue.thread_list.is_empty())
-                    ready_queues.mask &= ~(1u << priority);
-                // Mark it as active because we are using this thread. This is similar
-                // to comparing it with Processor::current_thread, but when there are
-                // multiple processors there's no easy way to check whether the thread
-                // is actually still needed. This prevents accidental finalization when
-                // a thread is no longer in Running state, but running on another core.
-
-                // We need to mark it active here so that this thread won't be
-                // scheduled on another core if it were to be queued before actually
-                // switching to it.
-                // FIXME: Figure out a better way maybe?
-                thread.set_active(true);
-                return thread;
-            }
-            priority_mask &= ~(1u << priority);
+// Finds the highest priority thread that may run on a processor in the given affinity mask,
+// only considering priority buckets with an index below priority_limit.
+Thread* ProcessorReadyQueues::find_runnable_thread_locked(ThreadReadyQueues& ready_queues, u32 affinity_mask, u32 priority_limit)
+{
+    auto priority_mask = ready_queues.mask;
+    if (priority_limit < ThreadReadyQueues::count)
+        priority_mask &= (1u << priority_limit) - 1;
+    while (priority_mask != 0) {
+        auto priority = bit_scan_forward(priority_mask);
+        VERIFY(priority > 0);
+        auto& ready_queue = ready_queues.queues[--priority];
+        for (auto& thread : ready_queue.thread_list) {
+            VERIFY(thread.m_runnable_priority == (int)priority);
+            if (thread.is_active())
+                continue;
+            if (!(thread.affinity() & affinity_mask))
+                continue;
+            return &thread;
         }
-        return *Processor::idle_thread();
+        priority_mask &= ~(1u << priority);
+    }
+    return nullptr;
+}
+
+void ProcessorReadyQueues::remove_locked(ThreadReadyQueues& ready_queues, Thread& thread)
+{
+    auto priority = thread.m_runnable_priority;
+    VERIFY(priority >= 0);
+    VERIFY(ready_queues.mask & (1u << priority));
+    auto& ready_queue = ready_queues.queues[priority];
+    thread.m_runnable_priority = -1;
+    ready_queue.thread_list.remove(thread);
+    if (ready_queue.thread_list.is_empty()) {
+        ready_queues.mask &= ~(1u << priority);
+        mask.store(ready_queues.mask, AK::MemoryOrder::memory_order_release);
+    }
+}
+
+Thread* ProcessorReadyQueues::find_runnable_thread(u32 affinity_mask, u32 priority_limit)
+{
+    return ready_queues.with([&](auto& ready_queues) {
+        return find_runnable_thread_locked(ready_queues, affinity_mask, priority_limit);
     });
 }
 
-Thread* Scheduler::peek_next_runnable_thread()
+Thread* ProcessorReadyQueues::take_runnable_thread(u32 affinity_mask, u32 priority_limit)
 {
-    auto affinity_mask = 1u << Processor::current_id();
+    return ready_queues.with([&](auto& ready_queues) -> Thread* {
+        auto* thread = find_runnable_thread_locked(ready_queues, affinity_mask, priority_limit);
+        if (!thread)
+            return nullptr;
+        remove_locked(ready_queues, *thread);
+        // Mark it as active because we are using this thread. This is similar
+        // to comparing it with Processor::current_thread, but when there are
+        // multiple processors there's no easy way to check whether the thread
+        // is actually still needed. This prevents accidental finalization when
+        // a thread is no longer in Running state, but running on another core.
+
+        // We need to mark it active here so that this thread won't be
+        // scheduled on another core if it were to be queued before actually
+        // switching to it.
+        // FIXME: Figure out a better way maybe?
+        thread->set_active(true);
+        return thread;
+    });
+}
+
+void ProcessorReadyQueues::enqueue(Thread& thread, u32 priority, u32 cpu)
+{
+    ready_queues.with([&](auto& ready_queues) {
+        VERIFY(thread.m_runnable_priority < 0);
+        thread.m_runnable_priority = (int)priority;
+        thread.m_runnable_processor = cpu;
+        VERIFY(!thread.m_ready_queue_node.is_in_list());
+        auto& ready_queue = ready_queues.queues[priority];
+        bool was_empty = ready_queue.thread_list.is_empty();
+        ready_queue.thread_list.append(thread);
+        if (was_empty) {
+            ready_queues.mask |= (1u << priority);
+            mask.store(ready_queues.mask, AK::MemoryOrder::memory_order_release);
+        }
+    });
+}
+
+bool ProcessorReadyQueues::dequeue(Thread& thread)
+{
+    return ready_queues.with([&](auto& ready_queues) {
+        if (thread.m_runnable_priority < 0)
+            return false;
+        remove_locked(ready_queues, thread);
+        return true;
+    });
+}
 
-    return g_ready_queues->with([&](auto& ready_queues) -> Thread* {
-        auto priority_mask = ready_queues.mask;
-        while (priority_mask != 0) {
-            auto priority = bit_scan_forward(priority_mask);
-            VERIFY(priority > 0);
-            auto& ready_queue = ready_queues.queues[--priority];
-            for (auto& thread : ready_queue.thread_list) {
-                VERIFY(thread.m_runnable_priority == (int)priority);
-                if (thread.is_active())
-                    continue;
-                if (!(thread.affinity() & affinity_mask))
-                    continue;
-                return &thread;
+// Visits the ready queues of all other processors that (according to their lock-free
+// mask) have work with a priority index below priority_limit, highest priority first.
+template<typename Callback>
+static Thread* for_each_steal_candidate(u32 current_cpu, u32 priority_limit, Callback callback)
+{
+    auto processor_count = Processor::count();
+    u32 visited_mask = 1u << current_cpu;
+    for (;;) {
+        ProcessorReadyQueues* best_queues = nullptr;
+        u32 best_cpu = 0;
+        u32 best_priority = priority_limit;
+        // Start scanning at the next processor so that we don't all pile onto processor 0
+        for (u32 i = 1; i < processor_count; i++) {
+            auto cpu = (current_cpu + i) % processor_count;
+            if (visited_mask & (1u << cpu))
+                continue;
+            auto& processor_queues = ready_queues_for_processor(cpu);
+            auto priority = processor_queues.highest_priority_index();
+            if (priority < best_priority) {
+                best_queues = &processor_queues;
+                best_cpu = cpu;
+                best_priority = priority;
             }
-            priority_mask &= ~(1u << priority);
         }
+        if (!best_queues)
+            return nullptr;
+        visited_mask |= 1u << best_cpu;
+        if (auto* thread = callback(*best_queues, priority_limit))
+            return thread;
+    }
+}
+
+template<typename Callback>
+static Thread* find_next_runnable_thread(Callback callback)
+{
+    auto current_cpu = Processor::current_id();
+    auto& local_queues = ready_queues_for_processor(current_cpu);
+    auto local_priority = local_queues.highest_priority_index();
+
+    // Prefer strictly higher priority work queued on other processors, so that
+    // distributing threads across processors doesn't break priority ordering.
+    if (local_priority > 0) {
+        if (auto* thread = for_each_steal_candidate(current_cpu, local_priority, callback))
+            return thread;
+    }
+
+    if (auto* thread = callback(local_queues, ThreadReadyQueues::count))
+        return thread;
+
+    // Nothing (eligible) on our own queues, try stealing anything from the others.
+    return for_each_steal_candidate(current_cpu, ThreadReadyQueues::count, callback);
+}
+
+Thread& Scheduler::pull_next_runnable_thread()
+{
+    auto affinity_mask = 1u << Processor::current_id();
+
+    auto* thread = find_next_runnable_thread([&](auto& processor_queues, u32 priority_limit) {
+        return processor_queues.take_runnable_thread(affinity_mask, priority_limit);
+    });
+    if (!thread)
+        return *Processor::idle_thread();
+    return *thread;
+}
+
+Thread* Scheduler::peek_next_runnable_thread()
+{
+    auto affinity_mask = 1u << Processor::current_id();
 
-        // Unlike in pull_next_runnable_thread() we don't want to fall back to
-        // the idle thread. We just want to see if we have any other thread ready
-        // to be scheduled.
-        return nullptr;
+    // Unlike in pull_next_runnable_thread() we don't want to fall back to
+    // the idle thread. We just want to see if we have any other thread ready
+    // to be scheduled.
+    return find_next_runnable_thread([&](auto& processor_queues, u32 priority_limit) {
+        return processor_queues.find_runnable_thread(affinity_mask, priority_limit);
     });
 }
 
@@ -136,24 +275,34 @@ bool Scheduler::dequeue_runnable_thread(Thread& thread, bool check_affinity)
     if (thread.is_idle_thread())
         return true;
 
-    return g_ready_queues->with([&](auto& ready_queues) {
-        auto priority = thread.m_runnable_priority;
-        if (priority < 0) {
-            VERIFY(!thread.m_ready_queue_node.is_in_list());
-            return false;
-        }
+    if (thread.m_runnable_priority < 0) {
+        VERIFY(!thread.m_ready_queue_node.is_in_list());
+        return false;
+    }
 
-        if (check_affinity && !(thread.affinity() & (1 << Processor::current_id())))
-            return false;
+    if (check_affinity && !(thread.affinity() & (1 << Processor::current_id())))
+        return false;
 
-        VERIFY(ready_queues.mask & (1u << priority));
-        auto& ready_queue = ready_queues.queues[priority];
-        thread.m_runnable_priority = -1;
-        ready_queue.thread_list.remove(thread);
-        if (ready_queue.thread_list.is_empty())
-            ready_queues.mask &= ~(1u << priority);
-        return true;
-    });
+    return ready_queues_for_processor(thread.m_runnable_processor).dequeue(thread);
+}
+
+static u32 pick_processor_for_thread(Thread const& thread)
+{
+    auto processor_count = Processor::count();
+    u32 online_mask = processor_count >= 32 ? NumericLimits<u32>::max() : (1u << processor_count) - 1;
+    auto allowed_mask = thread.affinity() & online_mask;
+    if (allowed_mask == 0)
+        return Processor::current_id();
+
+    // Keep the thread on the processor it last ran on, since its caches are probably
+    // still warm. Otherwise prefer the current processor.
+    auto last_cpu = thread.cpu();
+    if (last_cpu < processor_count && (allowed_mask & (1u << last_cpu)))
+        return last_cpu;
+    auto current_cpu = Processor::current_id();
+    if (allowed_mask & (1u << current_cpu))
+        return current_cpu;
+    return bit_scan_forward(allowed_mask) - 1;
 }
 
 void Scheduler::enqueue_runnable_thread(Thread& thread)
@@ -162,17 +311,8 @@ void Scheduler::enqueue_runnable_thread(Thread& thread)
     if (thread.is_idle_thread())
         return;
     auto priority = thread_priority_to_priority_index(thread.priority());
-
-    g_ready_queues->with([&](auto& ready_queues) {
-        VERIFY(thread.m_runnable_priority < 0);
-        thread.m_runnable_priority = (int)priority;
-        VERIFY(!thread.m_ready_queue_node.is_in_list());
-        auto& ready_queue = ready_queues.queues[priority];
-        bool was_empty = ready_queue.thread_list.is_empty();
-        ready_queue.thread_list.append(thread);
-        if (was_empty)
-            ready_queues.mask |= (1u << priority);
-    });
+    auto cpu = pick_processor_for_thread(thread);
+    ready_queues_for_processor(cpu).enqueue(thread, priority, cpu);
 }
 
 UNMAP_AFTER_INIT void Scheduler::start()
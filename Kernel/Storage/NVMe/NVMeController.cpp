@@ -34,8 +34,6 @@ UNMAP_AFTER_INIT NVMeController::NVMeController(const PCI::DeviceIdentifier& dev
 
 UNMAP_AFTER_INIT ErrorOr<void> NVMeController::initialize(bool is_queue_polled)
 {
-    // Nr of queues = one queue per core
-    auto nr_of_queues = Processor::count();
     auto irq = is_queue_polled ? Optional<u8> {} : device_identifier().interrupt_line().value();
 
     PCI::enable_memory_space(device_identifier());
@@ -58,10 +56,14 @@ UNMAP_AFTER_INIT ErrorOr<void> NVMeController::initialize(bool is_queue_polled)
     VERIFY(IO_QUEUE_SIZE < MQES(caps));
     dbgln_if(NVME_DEBUG, "NVMe: IO queue depth is: {}", IO_QUEUE_SIZE);
 
-    // Create an IO queue per core
-    for (u32 cpuid = 0; cpuid < nr_of_queues; ++cpuid) {
+    // Ideally we get one IO queue pair per core, so cores never contend on the same queue,
+    // but the controller might support fewer than that.
+    auto nr_of_queues = TRY(negotiate_io_queue_count(Processor::count()));
+    dbgln_if(NVME_DEBUG, "NVMe: Using {} IO queue(s) for {} core(s)", nr_of_queues, Processor::count());
+
+    for (u32 queue_index = 0; queue_index < nr_of_queues; ++queue_index) {
         // qid is zero is used for admin queue
-        TRY(create_io_queue(cpuid + 1, irq));
+        TRY(create_io_queue(queue_index + 1, irq));
     }
     TRY(identify_and_init_namespaces());
     return {};
@@ -294,6 +296,27 @@ UNMAP_AFTER_INIT ErrorOr<void> NVMeController::create_admin_queue(Optional<u8> i
     return {};
 }
 
+UNMAP_AFTER_INIT ErrorOr<u32> NVMeController::negotiate_io_queue_count(u32 desired_count)
+{
+    // qid is only a byte wide in our queue bookkeeping, and qid 0 is the admin queue.
+    desired_count = clamp(desired_count, 1u, static_cast<u32>(NumericLimits<u8>::max()));
+
+    NVMeSubmission sub {};
+    u32 result = 0;
+    sub.op = OP_ADMIN_SET_FEATURES;
+    sub.generic.cdw10 = AK::convert_between_host_and_little_endian(static_cast<u32>(FEATURE_NUMBER_OF_QUEUES));
+    sub.generic.cdw11 = AK::convert_between_host_and_little_endian(NUMBER_OF_QUEUES(desired_count, desired_count));
+    if (auto status = submit_admin_command(sub, true, &result); status) {
+        // Every controller has to support at least one IO queue pair.
+        dmesgln_pci(*this, "Failed to set the number of IO queues (status {:#x}), using a single queue", status);
+        return 1;
+    }
+
+    // The controller may allocate more or fewer queues than requested.
+    auto allocated_count = min(NUMBER_OF_SUBMISSION_QUEUES(result), NUMBER_OF_COMPLETION_QUEUES(result));
+    return min(desired_count, static_cast<u32>(allocated_count));
+}
+
 UNMAP_AFTER_INIT ErrorOr<void> NVMeController::create_io_queue(u8 qid, Optional<u8> irq)
 {
     OwnPtr<Memory::Region> cq_dma_region;
@@ -330,7 +353,10 @@ UNMAP_AFTER_INIT ErrorOr<void> NVMeController::create_io_queue(u8 qid, Optional<
         // For now using pin based interrupts. Clear the first 16 bits
         // to use pin-based interrupts.
         sub.create_cq.cq_flags = AK::convert_between_host_and_little_endian(flags & 0xFFFF);
-        submit_admin_command(sub, true);
+        if (auto status = submit_admin_command(sub, true); status) {
+            dmesgln_pci(*this, "Failed to create IO completion queue {} (status {:#x})", qid, status);
+            return EFAULT;
+        }
     }
     {
         NVMeSubmission sub {};
@@ -342,7 +368,10 @@ UNMAP_AFTER_INIT ErrorOr<void> NVMeController::create_io_queue(u8 qid, Optional<
         auto flags = QUEUE_PHY_CONTIGUOUS;
         sub.create_sq.cqid = qid;
         sub.create_sq.sq_flags = AK::convert_between_host_and_little_endian(flags);
-        submit_admin_command(sub, true);
+        if (auto status = submit_admin_command(sub, true); status) {
+            dmesgln_pci(*this, "Failed to create IO submission queue {} (status {:#x})", qid, status);
+            return EFAULT;
+        }
     }
 
     auto queue_doorbell_offset = REG_SQ0TDBL_START + ((2 * qid) * (4 << m_dbl_stride));
@@ -114,8 +114,25 @@ enum AdminCommandOpCode {
     OP_ADMIN_CREATE_COMPLETION_QUEUE = 0x5,
     OP_ADMIN_CREATE_SUBMISSION_QUEUE = 0x1,
     OP_ADMIN_IDENTIFY = 0x6,
+    OP_ADMIN_SET_FEATURES = 0x9,
 };
 
+// FEATURES
+static constexpr u8 FEATURE_NUMBER_OF_QUEUES = 0x7;
+// Both halves of the Number of Queues value are 0 based
+static constexpr u32 NUMBER_OF_QUEUES(u16 submission_queues, u16 completion_queues)
+{
+    return ((completion_queues - 1) << 16) | (submission_queues - 1);
+}
+static constexpr u16 NUMBER_OF_SUBMISSION_QUEUES(u32 x)
+{
+    return (x & 0xffff) + 1;
+}
+static constexpr u16 NUMBER_OF_COMPLETION_QUEUES(u32 x)
+{
+    return (x >> 16) + 1;
+}
+
 // IO opcodes
 enum IOCommandOpcode {
     OP_NVME_WRITE = 0x1,
@@ -22,11 +22,13 @@
 #include <Kernel/FileSystem/Ext2FS/FileSystem.h>
 #include <Kernel/FileSystem/VirtualFileSystem.h>
 #include <Kernel/Panic.h>
+#include <Kernel/Process.h>
 #include <Kernel/Storage/ATA/AHCI/Controller.h>
 #include <Kernel/Storage/ATA/GenericIDE/Controller.h>
 #include <Kernel/Storage/NVMe/NVMeController.h>
 #include <Kernel/Storage/Ramdisk/Controller.h>
 #include <Kernel/Storage/StorageManagement.h>
+#include <Kernel/WaitQueue.h>
 #include <LibPartition/EBRPartitionTable.h>
 #include <LibPartition/GUIDPartitionTable.h>
 #include <LibPartition/MBRPartitionTable.h>
@@ -168,20 +170,56 @@ UNMAP_AFTER_INIT ErrorOr<NonnullOwnPtr<Partition::PartitionTable>> StorageManage
     return TRY(Partition::GUIDPartitionTable::try_to_initialize(device));
 }
 
+struct StorageManagement::PartitionTableScan {
+    StorageDevice& device;
+    OwnPtr<Partition::PartitionTable> partition_table;
+    Atomic<size_t>& pending_scans;
+};
+
+static WaitQueue s_partition_table_scans_done;
+
+// NOTE: This is not UNMAP_AFTER_INIT, as the scanning thread may still be on its way out when
+//       enumerate_disk_partitions() returns.
+void StorageManagement::scan_partition_table(void* data)
+{
+    auto& scan = *static_cast<PartitionTableScan*>(data);
+    if (auto partition_table_or_error = the().try_to_initialize_partition_table(scan.device); !partition_table_or_error.is_error())
+        scan.partition_table = partition_table_or_error.release_value();
+    // NOTE: The scan may be gone as soon as the count drops, so we must not touch it afterwards.
+    --scan.pending_scans;
+    s_partition_table_scans_done.wake_one();
+}
+
 UNMAP_AFTER_INIT void StorageManagement::enumerate_disk_partitions()
 {
     VERIFY(!m_storage_devices.is_empty());
+
+    // Reading partition tables is mostly waiting for the devices, so do it for all of them at once.
+    Atomic<size_t> pending_scans = 0;
+    Vector<NonnullOwnPtr<PartitionTableScan>> scans;
     for (auto& device : m_storage_devices) {
-        auto partition_table_or_error = try_to_initialize_partition_table(device);
-        if (partition_table_or_error.is_error())
+        auto scan = MUST(adopt_nonnull_own_or_enomem(new (nothrow) PartitionTableScan { device, {}, pending_scans }));
+        ++pending_scans;
+        auto thread_name = MUST(KString::formatted("Partition Scan block{}:{}", device.major(), device.minor()));
+        auto thread = Process::current().create_kernel_thread(scan_partition_table, scan.ptr(), THREAD_PRIORITY_NORMAL, move(thread_name), THREAD_AFFINITY_DEFAULT, false);
+        if (!thread)
+            scan_partition_table(scan.ptr());
+        scans.append(move(scan));
+    }
+    while (pending_scans.load() > 0)
+        s_partition_table_scans_done.wait_forever("StorageManagement"sv);
+
+    // Partitions are created in device order, so that they keep getting the same minor numbers.
+    for (auto& scan : scans) {
+        if (!scan->partition_table)
             continue;
-        auto partition_table = partition_table_or_error.release_value();
-        for (size_t partition_index = 0; partition_index < partition_table->partitions_count(); partition_index++) {
-            auto partition_metadata = partition_table->partition(partition_index);
+        auto& partition_table = *scan->partition_table;
+        for (size_t partition_index = 0; partition_index < partition_table.partitions_count(); partition_index++) {
+            auto partition_metadata = partition_table.partition(partition_index);
             if (!partition_metadata.has_value())
                 continue;
-            auto disk_partition = DiskPartition::create(device, generate_partition_minor_number(), partition_metadata.value());
-            device.add_partition(disk_partition);
+            auto disk_partition = DiskPartition::create(scan->device, generate_partition_minor_number(), partition_metadata.value());
+            scan->device.add_partition(disk_partition);
         }
     }
 }
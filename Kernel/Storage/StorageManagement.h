@@ -63,6 +63,9 @@ private:
 
     ErrorOr<NonnullOwnPtr<Partition::PartitionTable>> try_to_initialize_partition_table(StorageDevice&) const;
 
+    struct PartitionTableScan;
+    static void scan_partition_table(void*);
+
     LockRefPtr<BlockDevice> boot_block_device() const;
 
     StringView m_boot_argument;
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/NumericLimits.h>
+#include <Kernel/Debug.h>
+#include <Kernel/FileSystem/Inode.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/KBuffer.h>
+#include <Kernel/Process.h>
+
+namespace Kernel {
+
+static constexpr size_t copy_file_range_chunk_size = 256 * KiB;
+
+static ErrorOr<Inode*> regular_file_inode(OpenFileDescription& description)
+{
+    if (description.is_directory())
+        return EISDIR;
+    auto* inode = description.inode();
+    if (!inode || !inode->metadata().is_regular_file())
+        return EINVAL;
+    return inode;
+}
+
+ErrorOr<FlatPtr> Process::sys$copy_file_range(Userspace<Syscall::SC_copy_file_range_params const*> user_params)
+{
+    VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this);
+    TRY(require_promise(Pledge::stdio));
+    auto params = TRY(copy_typed_from_user(user_params));
+    if (params.flags != 0)
+        return EINVAL;
+    dbgln_if(IO_DEBUG, "sys$copy_file_range({}, {}, {}, {}, {})", params.in_fd, params.in_offset, params.out_fd, params.out_offset, params.count);
+
+    auto in_description = TRY(open_file_description(params.in_fd));
+    if (!in_description->is_readable())
+        return EBADF;
+    auto out_description = TRY(open_file_description(params.out_fd));
+    if (!out_description->is_writable() || out_description->should_append())
+        return EBADF;
+
+    auto& in_inode = *TRY(regular_file_inode(*in_description));
+    auto& out_inode = *TRY(regular_file_inode(*out_description));
+
+    // NOTE: Offsets that are given are used and updated instead of the file offsets, like with pread() and pwrite().
+    off_t in_offset = in_description->offset();
+    if (params.in_offset)
+        TRY(copy_from_user(&in_offset, params.in_offset));
+    off_t out_offset = out_description->offset();
+    if (params.out_offset)
+        TRY(copy_from_user(&out_offset, params.out_offset));
+    if (in_offset < 0 || out_offset < 0)
+        return EINVAL;
+
+    auto count = min(params.count, static_cast<size_t>(NumericLimits<ssize_t>::max()));
+    if (Checked<off_t>::addition_would_overflow(in_offset, count) || Checked<off_t>::addition_would_overflow(out_offset, count))
+        return EOVERFLOW;
+    if (&in_inode == &out_inode && in_offset < out_offset + static_cast<off_t>(count) && out_offset < in_offset + static_cast<off_t>(count))
+        return EINVAL;
+
+    // There's no point in copying past the end of the input.
+    auto in_size = static_cast<off_t>(in_inode.size());
+    count = in_offset >= in_size ? 0 : min(count, static_cast<size_t>(in_size - in_offset));
+
+    size_t total_copied = 0;
+    if (count != 0 && &in_inode.fs() == &out_inode.fs()) {
+        auto shared_or_error = out_inode.share_blocks_from(in_inode, in_offset, out_offset, count);
+        if (shared_or_error.is_error()) {
+            if (shared_or_error.error().code() != ENOTSUP)
+                return shared_or_error.release_error();
+        } else {
+            total_copied = shared_or_error.release_value();
+        }
+    }
+
+    if (total_copied < count) {
+        // The data doesn't leave the kernel, which saves copying it to and from userspace, and a syscall for every
+        // chunk of it.
+        auto buffer = TRY(KBuffer::try_create_with_size("copy_file_range"sv, min(count - total_copied, copy_file_range_chunk_size)));
+        auto kernel_buffer = UserOrKernelBuffer::for_kernel_buffer(buffer->data());
+
+        while (total_copied < count) {
+            auto chunk_size = min(count - total_copied, buffer->size());
+            auto nread_or_error = in_description->read(kernel_buffer, in_offset + total_copied, chunk_size);
+            if (nread_or_error.is_error()) {
+                if (total_copied > 0)
+                    break;
+                return nread_or_error.release_error();
+            }
+            auto nread = nread_or_error.release_value();
+            if (nread == 0)
+                break;
+
+            auto nwritten_or_error = do_write(*out_description, kernel_buffer, nread, out_offset + total_copied);
+            if (nwritten_or_error.is_error()) {
+                if (total_copied > 0)
+                    break;
+                return nwritten_or_error.release_error();
+            }
+            auto nwritten = nwritten_or_error.release_value();
+            total_copied += nwritten;
+            if (nwritten < nread)
+                break;
+        }
+    }
+
+    off_t new_in_offset = in_offset + total_copied;
+    off_t new_out_offset = out_offset + total_copied;
+    if (params.in_offset)
+        TRY(copy_to_user(params.in_offset, &new_in_offset));
+    else
+        TRY(in_description->seek(new_in_offset, SEEK_SET));
+    if (params.out_offset)
+        TRY(copy_to_user(params.out_offset, &new_out_offset));
+    else
+        TRY(out_description->seek(new_out_offset, SEEK_SET));
+
+    return total_copied;
+}
+
+}
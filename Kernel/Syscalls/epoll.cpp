@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ScopeGuard.h>
+#include <Kernel/Debug.h>
+#include <Kernel/FileSystem/EPoll.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/Process.h>
+
+namespace Kernel {
+
+using BlockFlags = Thread::FileBlocker::BlockFlags;
+
+static BlockFlags block_flags_for_epoll_events(u32 events)
+{
+    BlockFlags block_flags = BlockFlags::WriteError | BlockFlags::WriteHangUp; // always want EPOLLERR, EPOLLHUP
+    if (events & EPOLLIN)
+        block_flags |= BlockFlags::Read;
+    if (events & EPOLLOUT)
+        block_flags |= BlockFlags::Write;
+    if (events & EPOLLPRI)
+        block_flags |= BlockFlags::ReadPriority;
+    if (events & EPOLLRDHUP)
+        block_flags |= BlockFlags::ReadHangUp;
+    return block_flags;
+}
+
+static u32 epoll_events_for_unblocked_flags(BlockFlags unblocked_flags)
+{
+    u32 events = 0;
+    if (has_flag(unblocked_flags, BlockFlags::WriteHangUp))
+        events |= EPOLLHUP;
+    if (has_flag(unblocked_flags, BlockFlags::WriteError)) {
+        events |= EPOLLERR;
+        return events;
+    }
+    if (has_flag(unblocked_flags, BlockFlags::Read))
+        events |= EPOLLIN;
+    if (has_flag(unblocked_flags, BlockFlags::ReadPriority))
+        events |= EPOLLPRI;
+    if (!has_flag(unblocked_flags, BlockFlags::WriteHangUp) && has_flag(unblocked_flags, BlockFlags::Write))
+        events |= EPOLLOUT;
+    if (has_flag(unblocked_flags, BlockFlags::ReadHangUp))
+        events |= EPOLLRDHUP;
+    return events;
+}
+
+ErrorOr<FlatPtr> Process::sys$epoll_create(u32 flags)
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    TRY(require_promise(Pledge::stdio));
+
+    if (flags & ~EPOLL_CLOEXEC)
+        return EINVAL;
+
+    auto epoll = TRY(EPoll::try_create());
+    auto description = TRY(OpenFileDescription::try_create(move(epoll)));
+
+    return m_fds.with_exclusive([&](auto& fds) -> ErrorOr<FlatPtr> {
+        auto fd_allocation = TRY(fds.allocate());
+        fds[fd_allocation.fd].set(move(description));
+
+        if (flags & EPOLL_CLOEXEC)
+            fds[fd_allocation.fd].set_flags(fds[fd_allocation.fd].flags() | FD_CLOEXEC);
+
+        return fd_allocation.fd;
+    });
+}
+
+ErrorOr<FlatPtr> Process::sys$epoll_ctl(int epfd, int op, int fd, Userspace<epoll_event const*> user_event)
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    TRY(require_promise(Pledge::stdio));
+
+    auto epoll_description = TRY(open_file_description(epfd));
+    auto* epoll = epoll_description->epoll();
+    if (!epoll)
+        return EINVAL;
+
+    // NOTE: The descriptor doesn't need to be open anymore in order to stop watching it.
+    if (op == EPOLL_CTL_DEL) {
+        TRY(epoll->remove_interest(fd));
+        return 0;
+    }
+
+    // Make sure the descriptor exists at the time it is registered; it is
+    // looked up again (and dropped if it has been closed) on every wait.
+    auto description = TRY(open_file_description(fd));
+    if (description->is_epoll())
+        return EINVAL;
+
+    auto event = TRY(copy_typed_from_user(user_event));
+    EPoll::Interest interest { fd, event.events, event.data.u64 };
+
+    switch (op) {
+    case EPOLL_CTL_ADD:
+        TRY(epoll->add_interest(interest));
+        return 0;
+    case EPOLL_CTL_MOD:
+        TRY(epoll->modify_interest(interest));
+        return 0;
+    default:
+        return EINVAL;
+    }
+}
+
+ErrorOr<FlatPtr> Process::sys$epoll_wait(Userspace<Syscall::SC_epoll_wait_params const*> user_params)
+{
+    VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this);
+    TRY(require_promise(Pledge::stdio));
+
+    auto params = TRY(copy_typed_from_user(user_params));
+
+    if (params.maxevents <= 0)
+        return EINVAL;
+
+    auto epoll_description = TRY(open_file_description(params.epfd));
+    auto* epoll = epoll_description->epoll();
+    if (!epoll)
+        return EINVAL;
+
+    Thread::BlockTimeout timeout;
+    if (params.timeout) {
+        auto timeout_time = TRY(copy_time_from_user(params.timeout));
+        timeout = Thread::BlockTimeout(false, &timeout_time);
+    }
+
+    sigset_t sigmask = {};
+    if (params.sigmask)
+        TRY(copy_from_user(&sigmask, params.sigmask));
+
+    // Unlike poll(), the interest set is already in the kernel, so we only
+    // need to resolve descriptors here instead of copying them in first.
+    Thread::SelectBlocker::FDVector fds_info;
+    Vector<EPoll::Interest, FD_SETSIZE> interests;
+    Vector<int> closed_fds;
+
+    TRY(m_fds.with_shared([&](auto& fds) -> ErrorOr<void> {
+        return epoll->for_each_interest([&](auto& interest) -> ErrorOr<void> {
+            auto description_or_error = fds.open_file_description(interest.fd);
+            if (description_or_error.is_error())
+                return closed_fds.try_append(interest.fd);
+            TRY(interests.try_append(interest));
+            TRY(fds_info.try_append({ description_or_error.release_value(), block_flags_for_epoll_events(interest.events) }));
+            return {};
+        });
+    }));
+
+    // Descriptors that were closed behind our back silently leave the interest set.
+    for (auto fd : closed_fds)
+        (void)epoll->remove_interest(fd);
+
+    auto* current_thread = Thread::current();
+
+    u32 previous_signal_mask = 0;
+    if (params.sigmask)
+        previous_signal_mask = current_thread->update_signal_mask(sigmask);
+    ScopeGuard rollback_signal_mask([&]() {
+        if (params.sigmask)
+            current_thread->update_signal_mask(previous_signal_mask);
+    });
+
+    if constexpr (IO_DEBUG || POLL_SELECT_DEBUG)
+        dbgln("epoll_wait on {} fds, timeout={}", fds_info.size(), params.timeout);
+
+    if (current_thread->block<Thread::SelectBlocker>(timeout, fds_info).was_interrupted())
+        return EINTR;
+
+    size_t ready_count = 0;
+    for (size_t i = 0; i < fds_info.size() && ready_count < static_cast<size_t>(params.maxevents); ++i) {
+        auto& fds_entry = fds_info[i];
+        if (fds_entry.unblocked_flags == BlockFlags::None)
+            continue;
+        u32 events = epoll_events_for_unblocked_flags(fds_entry.unblocked_flags);
+        if (!events)
+            continue;
+        epoll_event event {};
+        event.events = events;
+        event.data.u64 = interests[i].data;
+        TRY(copy_to_user(&params.events[ready_count], &event));
+        ++ready_count;
+    }
+
+    return ready_count;
+}
+
+}
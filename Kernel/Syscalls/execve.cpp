@@ -784,6 +784,43 @@ static ErrorOr<NonnullOwnPtrVector<KString>> find_shebang_interpreter_for_execut
     return ENOEXEC;
 }
 
+// Nearly every program uses the same interpreter (/usr/lib/Loader.so), so remember the last one that passed
+// validation instead of reading and checking its headers again on every exec. Holding on to its VMObject also
+// keeps the interpreter's pages resident while no process happens to have it mapped.
+struct ValidatedInterpreter {
+    InodeIdentifier identifier;
+    Time mtime;
+    off_t size { 0 };
+    NonnullLockRefPtr<Memory::SharedInodeVMObject> vmobject;
+};
+
+static SpinlockProtected<Optional<ValidatedInterpreter>, LockRank::None> s_validated_interpreter {};
+
+static bool is_validated_interpreter(InodeMetadata const& metadata)
+{
+    return s_validated_interpreter.with([&](auto& interpreter) {
+        return interpreter.has_value()
+            && interpreter->identifier == metadata.inode
+            && interpreter->mtime == metadata.mtime
+            && interpreter->size == metadata.size;
+    });
+}
+
+static void remember_validated_interpreter(Inode& inode, InodeMetadata const& metadata)
+{
+    // Holding on to the VMObject keeps the inode alive, which must not stop anyone from unmounting its file system.
+    if (metadata.inode.fsid() != VirtualFileSystem::the().root_inode_id().fsid())
+        return;
+    auto vmobject_or_error = Memory::SharedInodeVMObject::try_create_with_inode(inode);
+    if (vmobject_or_error.is_error())
+        return;
+    Optional<ValidatedInterpreter> interpreter = ValidatedInterpreter { metadata.inode, metadata.mtime, metadata.size, vmobject_or_error.release_value() };
+    // NOTE: The previously remembered interpreter is dropped outside the lock.
+    s_validated_interpreter.with([&](auto& validated_interpreter) {
+        swap(validated_interpreter, interpreter);
+    });
+}
+
 ErrorOr<LockRefPtr<OpenFileDescription>> Process::find_elf_interpreter_for_executable(StringView path, ElfW(Ehdr) const& main_executable_header, size_t main_executable_header_size, size_t file_size)
 {
     // Not using ErrorOr here because we'll want to do the same thing in userspace in the RTLD
@@ -801,6 +838,9 @@ ErrorOr<LockRefPtr<OpenFileDescription>> Process::find_elf_interpreter_for_execu
 
         VERIFY(interpreter_description->inode());
 
+        if (is_validated_interpreter(interp_metadata))
+            return interpreter_description;
+
         // Validate the program interpreter as a valid elf binary.
         // If your program interpreter is a #! file or something, it's time to stop playing games :)
         if (interp_metadata.size < (int)sizeof(ElfW(Ehdr)))
@@ -832,6 +872,7 @@ ErrorOr<LockRefPtr<OpenFileDescription>> Process::find_elf_interpreter_for_execu
             return ELOOP;
         }
 
+        remember_validated_interpreter(*interpreter_description->inode(), interp_metadata);
         return interpreter_description;
     }
 
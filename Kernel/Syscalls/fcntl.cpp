@@ -51,6 +51,14 @@ ErrorOr<FlatPtr> Process::sys$fcntl(int fd, int cmd, uintptr_t arg)
     case F_SETLKW:
         TRY(description->apply_flock(Process::current(), Userspace<flock const*>(arg), ShouldBlock::Yes));
         return 0;
+    case F_GETPIPE_SZ:
+        if (!description->is_fifo())
+            return EBADF;
+        return description->fifo()->buffer_capacity();
+    case F_SETPIPE_SZ:
+        if (!description->is_fifo())
+            return EBADF;
+        return TRY(description->fifo()->set_buffer_capacity(arg));
     default:
         return EINVAL;
     }
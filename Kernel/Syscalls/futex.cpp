@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
 #include <AK/Singleton.h>
 #include <Kernel/Debug.h>
 #include <Kernel/Memory/InodeVMObject.h>
@@ -13,23 +14,37 @@
 
 namespace Kernel {
 
-static Singleton<SpinlockProtected<HashMap<GlobalFutexKey, NonnullLockRefPtr<FutexQueue>>, LockRank::None>> s_global_futex_queues;
+// Futex queues are spread over a fixed number of hashed buckets, each with its
+// own lock, so that unrelated futexes don't all contend on a single global lock.
+static constexpr size_t futex_bucket_count = 256;
+static_assert(is_power_of_two(futex_bucket_count));
+
+using FutexBucket = SpinlockProtected<HashMap<GlobalFutexKey, NonnullLockRefPtr<FutexQueue>>, LockRank::None>;
+static Singleton<Array<FutexBucket, futex_bucket_count>> s_global_futex_buckets;
+
+static FutexBucket& futex_bucket_for(GlobalFutexKey const& futex_key)
+{
+    auto hash = Traits<GlobalFutexKey>::hash(futex_key);
+    return s_global_futex_buckets->at(hash & (futex_bucket_count - 1));
+}
 
 void Process::clear_futex_queues_on_exec()
 {
-    s_global_futex_queues->with([this](auto& queues) {
-        auto const* address_space = this->address_space().with([](auto& space) { return space.ptr(); });
-        queues.remove_all_matching([address_space](auto& futex_key, auto& futex_queue) {
-            if ((futex_key.raw.offset & futex_key_private_flag) == 0)
-                return false;
-            if (futex_key.private_.address_space != address_space)
-                return false;
-            bool did_wake_all;
-            futex_queue->wake_all(did_wake_all);
-            VERIFY(did_wake_all); // No one should be left behind...
-            return true;
+    auto const* address_space = this->address_space().with([](auto& space) { return space.ptr(); });
+    for (auto& bucket : *s_global_futex_buckets) {
+        bucket.with([address_space](auto& queues) {
+            queues.remove_all_matching([address_space](auto& futex_key, auto& futex_queue) {
+                if ((futex_key.raw.offset & futex_key_private_flag) == 0)
+                    return false;
+                if (futex_key.private_.address_space != address_space)
+                    return false;
+                bool did_wake_all;
+                futex_queue->wake_all(did_wake_all);
+                VERIFY(did_wake_all); // No one should be left behind...
+                return true;
+            });
         });
-    });
+    }
 }
 
 ErrorOr<GlobalFutexKey> Process::get_futex_key(FlatPtr user_address, bool shared)
@@ -126,7 +141,7 @@ ErrorOr<FlatPtr> Process::sys$futex(Userspace<Syscall::SC_futex_params const*> u
 
     auto find_futex_queue = [&](GlobalFutexKey futex_key, bool create_if_not_found, bool* did_create = nullptr) -> ErrorOr<LockRefPtr<FutexQueue>> {
         VERIFY(!create_if_not_found || did_create != nullptr);
-        return s_global_futex_queues->with([&](auto& queues) -> ErrorOr<LockRefPtr<FutexQueue>> {
+        return futex_bucket_for(futex_key).with([&](auto& queues) -> ErrorOr<LockRefPtr<FutexQueue>> {
             auto it = queues.find(futex_key);
             if (it != queues.end())
                 return it->value;
@@ -141,7 +156,7 @@ ErrorOr<FlatPtr> Process::sys$futex(Userspace<Syscall::SC_futex_params const*> u
     };
 
     auto remove_futex_queue = [&](GlobalFutexKey futex_key) {
-        return s_global_futex_queues->with([&](auto& queues) {
+        return futex_bucket_for(futex_key).with([&](auto& queues) {
             auto it = queues.find(futex_key);
             if (it == queues.end())
                 return;
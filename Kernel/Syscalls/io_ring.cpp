@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/NumericLimits.h>
+#include <Kernel/Debug.h>
+#include <Kernel/FileSystem/IORing.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/Net/Socket.h>
+#include <Kernel/Process.h>
+
+namespace Kernel {
+
+ErrorOr<FlatPtr> Process::sys$create_io_ring(u32 submission_entry_count, u32 flags)
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    TRY(require_promise(Pledge::stdio));
+
+    if (flags & ~static_cast<u32>(IORingFlags::CloseOnExec))
+        return EINVAL;
+
+    auto io_ring = TRY(IORing::try_create(submission_entry_count));
+    auto description = TRY(OpenFileDescription::try_create(move(io_ring)));
+
+    return m_fds.with_exclusive([&](auto& fds) -> ErrorOr<FlatPtr> {
+        auto fd_allocation = TRY(fds.allocate());
+        fds[fd_allocation.fd].set(move(description));
+
+        if (flags & static_cast<u32>(IORingFlags::CloseOnExec))
+            fds[fd_allocation.fd].set_flags(fds[fd_allocation.fd].flags() | FD_CLOEXEC);
+
+        return fd_allocation.fd;
+    });
+}
+
+ErrorOr<FlatPtr> Process::sys$io_ring_enter(int fd, u32 to_submit)
+{
+    VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this);
+    TRY(require_promise(Pledge::stdio));
+
+    auto description = TRY(open_file_description(fd));
+    auto* io_ring = description->io_ring();
+    if (!io_ring)
+        return EINVAL;
+
+    dbgln_if(IO_DEBUG, "sys$io_ring_enter({}, {})", fd, to_submit);
+    return TRY(io_ring->consume_submissions(to_submit, [this](auto& submission) {
+        return execute_io_ring_submission(submission);
+    }));
+}
+
+// NOTE: Submissions are executed one after another by the thread that called io_ring_enter(),
+//       so none of them may block waiting for a descriptor to become ready. Instead, they
+//       complete with EAGAIN, and the process should wait for readiness with epoll or poll().
+ErrorOr<FlatPtr> Process::execute_io_ring_submission(IORingSubmission const& submission)
+{
+    switch (submission.opcode) {
+    case IORingOpcode::Nop:
+        return 0;
+
+    case IORingOpcode::Read: {
+        TRY(require_promise(Pledge::stdio));
+        if (submission.length > NumericLimits<ssize_t>::max())
+            return EINVAL;
+        auto description = TRY(open_file_description(submission.fd));
+        if (!description->is_readable())
+            return EBADF;
+        if (description->is_directory())
+            return EISDIR;
+        if (submission.offset >= 0 && !description->file().is_seekable())
+            return EINVAL;
+        if (!description->can_read())
+            return EAGAIN;
+        auto buffer = TRY(UserOrKernelBuffer::for_user_buffer(reinterpret_cast<u8*>(submission.buffer), submission.length));
+        if (submission.offset >= 0)
+            return TRY(description->read(buffer, submission.offset, submission.length));
+        return TRY(description->read(buffer, submission.length));
+    }
+
+    case IORingOpcode::Write: {
+        TRY(require_promise(Pledge::stdio));
+        if (submission.length > NumericLimits<ssize_t>::max())
+            return EINVAL;
+        auto description = TRY(open_file_description(submission.fd));
+        if (!description->is_writable())
+            return EBADF;
+        if (submission.offset >= 0 && !description->file().is_seekable())
+            return EINVAL;
+        if (!description->can_write())
+            return EAGAIN;
+        auto buffer = TRY(UserOrKernelBuffer::for_user_buffer(reinterpret_cast<u8*>(submission.buffer), submission.length));
+        return do_write(*description, buffer, submission.length, submission.offset >= 0 ? submission.offset : Optional<off_t> {});
+    }
+
+    case IORingOpcode::Accept: {
+        TRY(require_promise(Pledge::accept));
+        if (submission.flags & ~(SOCK_NONBLOCK | SOCK_CLOEXEC))
+            return EINVAL;
+        auto accepting_socket_description = TRY(open_file_description(submission.fd));
+        if (!accepting_socket_description->is_socket())
+            return ENOTSOCK;
+        auto& socket = *accepting_socket_description->socket();
+
+        auto fd_allocation = TRY(m_fds.with_exclusive([](auto& fds) { return fds.allocate(); }));
+        auto accepted_socket = socket.accept();
+        if (!accepted_socket)
+            return EAGAIN;
+
+        if (submission.buffer) {
+            sockaddr_un address_buffer {};
+            socklen_t address_size = min(sizeof(sockaddr_un), static_cast<size_t>(submission.length));
+            accepted_socket->get_peer_address(reinterpret_cast<sockaddr*>(&address_buffer), &address_size);
+            TRY(copy_to_user(reinterpret_cast<u8*>(submission.buffer), &address_buffer, address_size));
+        }
+
+        auto accepted_socket_description = TRY(OpenFileDescription::try_create(*accepted_socket));
+        accepted_socket_description->set_readable(true);
+        accepted_socket_description->set_writable(true);
+        if (submission.flags & SOCK_NONBLOCK)
+            accepted_socket_description->set_blocking(false);
+        int fd_flags = 0;
+        if (submission.flags & SOCK_CLOEXEC)
+            fd_flags |= FD_CLOEXEC;
+
+        m_fds.with_exclusive([&](auto& fds) {
+            fds[fd_allocation.fd].set(move(accepted_socket_description), fd_flags);
+        });
+
+        // NOTE: Moving this state to Completed is what causes connect() to unblock on the client side.
+        accepted_socket->set_setup_state(Socket::SetupState::Completed);
+        return fd_allocation.fd;
+    }
+
+    case IORingOpcode::Fsync: {
+        TRY(require_promise(Pledge::stdio));
+        auto description = TRY(open_file_description(submission.fd));
+        TRY(description->sync());
+        return 0;
+    }
+    }
+
+    return EINVAL;
+}
+
+}
@@ -10,6 +10,7 @@
 #include <Kernel/Arch/PageDirectory.h>
 #include <Kernel/Arch/SafeMem.h>
 #include <Kernel/Arch/SmapDisabler.h>
+#include <Kernel/Debug.h>
 #include <Kernel/FileSystem/Custody.h>
 #include <Kernel/FileSystem/OpenFileDescription.h>
 #include <Kernel/Memory/AnonymousVMObject.h>
@@ -173,6 +174,7 @@ ErrorOr<FlatPtr> Process::sys$mmap(Userspace<Syscall::SC_mmap_params const*> use
     bool map_noreserve = flags & MAP_NORESERVE;
     bool map_randomized = flags & MAP_RANDOMIZED;
     bool map_fixed_noreplace = flags & MAP_FIXED_NOREPLACE;
+    bool map_populate = flags & MAP_POPULATE;
 
     if (map_shared && map_private)
         return EINVAL;
@@ -230,7 +232,7 @@ ErrorOr<FlatPtr> Process::sys$mmap(Userspace<Syscall::SC_mmap_params const*> use
         vmobject = TRY(description->vmobject_for_mmap(*this, requested_range, used_offset, map_shared));
     }
 
-    return address_space().with([&](auto& space) -> ErrorOr<FlatPtr> {
+    auto region_address = TRY(address_space().with([&](auto& space) -> ErrorOr<FlatPtr> {
         // If MAP_FIXED is specified, existing mappings that intersect the requested range are removed.
         if (map_fixed)
             TRY(space->unmap_mmap_range(VirtualAddress(addr), size));
@@ -264,7 +266,17 @@ ErrorOr<FlatPtr> Process::sys$mmap(Userspace<Syscall::SC_mmap_params const*> use
         PerformanceManager::add_mmap_perf_event(*this, *region);
 
         return region->vaddr().get();
-    });
+    }));
+
+    // NOTE: Populating may have to read from the inode, so we can't do it while holding the address space lock.
+    //       The region can't go away under us, as munmap() needs the big process lock as well.
+    if (map_populate) {
+        // MAP_POPULATE is only a hint, so any pages we couldn't populate will simply be faulted in on access.
+        if (auto result = region->populate(); result.is_error())
+            dbgln_if(PAGE_FAULT_DEBUG, "mmap: Unable to populate {}: {}", region->vaddr(), result.error());
+    }
+
+    return region_address;
 }
 
 ErrorOr<FlatPtr> Process::sys$mprotect(Userspace<void*> addr, size_t size, int prot)
@@ -419,6 +431,32 @@ ErrorOr<FlatPtr> Process::sys$madvise(Userspace<void*> address, size_t size, int
         return EFAULT;
 
     return address_space().with([&](auto& space) -> ErrorOr<FlatPtr> {
+        // Access hints are allowed on any part of a region, while volatility is a property of the whole region.
+        if (advice == MADV_NORMAL || advice == MADV_SEQUENTIAL || advice == MADV_RANDOM || advice == MADV_WILLNEED) {
+            auto* region = space->find_region_containing(range_to_madvise);
+            if (!region)
+                return ENOMEM;
+            if (!region->is_mmap())
+                return EPERM;
+
+            if (advice == MADV_WILLNEED) {
+                // This is only a hint, so whatever we fail to read in now will simply be faulted in later.
+                auto first_page_index = region->page_index_from_address(range_to_madvise.base());
+                if (auto result = region->populate(first_page_index, range_to_madvise.size() / PAGE_SIZE); result.is_error())
+                    dbgln_if(PAGE_FAULT_DEBUG, "madvise: Unable to populate {}: {}", range_to_madvise.base(), result.error());
+                return 0;
+            }
+
+            // NOTE: The hint applies to the whole region, since we don't split regions for it.
+            if (advice == MADV_SEQUENTIAL)
+                region->set_access_pattern(Memory::Region::AccessPattern::Sequential);
+            else if (advice == MADV_RANDOM)
+                region->set_access_pattern(Memory::Region::AccessPattern::Random);
+            else
+                region->set_access_pattern(Memory::Region::AccessPattern::Normal);
+            return 0;
+        }
+
         auto* region = space->find_region_from_range(range_to_madvise);
         if (!region)
             return EINVAL;
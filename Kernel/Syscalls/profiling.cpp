@@ -36,6 +36,10 @@ ErrorOr<FlatPtr> Process::profiling_enable(pid_t pid, u64 event_mask)
         auto credentials = this->credentials();
         if (!credentials->is_superuser())
             return EPERM;
+        // CPU samples are collected into per-processor rings, which are periodically
+        // drained into the global buffer unless someone streams them out as they come.
+        TRY(PerformanceEventRings::create_if_needed(16 * MiB));
+        PerformanceEventRings::spawn_drain_task_if_needed();
         ScopedCritical critical;
         g_profiling_event_mask = PERF_EVENT_PROCESS_CREATE | PERF_EVENT_THREAD_CREATE | PERF_EVENT_MMAP;
         if (g_global_perf_events) {
@@ -94,10 +98,13 @@ ErrorOr<FlatPtr> Process::sys$profiling_disable(pid_t pid)
         auto credentials = this->credentials();
         if (!credentials->is_superuser())
             return EPERM;
-        ScopedCritical critical;
-        if (!TimeManagement::the().disable_profile_timer())
-            return ENOTSUP;
-        g_profiling_all_threads = false;
+        {
+            ScopedCritical critical;
+            if (!TimeManagement::the().disable_profile_timer())
+                return ENOTSUP;
+            g_profiling_all_threads = false;
+        }
+        PerformanceEventRings::drain_into_global_buffer_unless_streaming();
         return 0;
     }
 
@@ -129,6 +136,7 @@ ErrorOr<FlatPtr> Process::sys$profiling_free_buffer(pid_t pid)
             return EPERM;
 
         OwnPtr<PerformanceEventBuffer> perf_events;
+        PerformanceEventRings::destroy();
 
         {
             ScopedCritical critical;
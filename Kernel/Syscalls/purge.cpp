@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <Kernel/FileSystem/VirtualFileSystem.h>
 #include <Kernel/Library/NonnullLockRefPtrVector.h>
 #include <Kernel/Memory/AnonymousVMObject.h>
 #include <Kernel/Memory/InodeVMObject.h>
@@ -66,6 +67,8 @@ ErrorOr<FlatPtr> Process::sys$purge(int mode)
             purged_page_count += vmobject.release_all_clean_pages();
         }
     }
+    if (mode & PURGE_ALL_FILESYSTEM_CACHES)
+        purged_page_count += VirtualFileSystem::the().purge_filesystem_caches() / PAGE_SIZE;
     return purged_page_count;
 }
 
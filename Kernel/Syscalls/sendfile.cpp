@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/NumericLimits.h>
+#include <Kernel/Debug.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/KBuffer.h>
+#include <Kernel/Process.h>
+
+namespace Kernel {
+
+static constexpr size_t sendfile_chunk_size = 64 * KiB;
+
+// Gives bytes that were read but not sent back to the input. This is best effort: whatever went wrong with the output
+// or however much was sent is what the caller needs to hear about, not a failure to seek back.
+static void give_back_to_input(OpenFileDescription& in_description, size_t size)
+{
+    if (auto result = in_description.seek(-static_cast<off_t>(size), SEEK_CUR); result.is_error())
+        dbgln_if(IO_DEBUG, "sys$sendfile: Failed to give back {} bytes to the input: {}", size, result.error());
+}
+
+ErrorOr<FlatPtr> Process::sys$sendfile(int out_fd, int in_fd, Userspace<off_t*> userspace_offset, size_t count)
+{
+    VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this);
+    TRY(require_promise(Pledge::stdio));
+    if (count == 0)
+        return 0;
+    if (count > NumericLimits<ssize_t>::max())
+        return EINVAL;
+    dbgln_if(IO_DEBUG, "sys$sendfile({}, {}, {}, {})", out_fd, in_fd, userspace_offset.ptr(), count);
+
+    auto in_description = TRY(open_file_description(in_fd));
+    if (!in_description->is_readable())
+        return EBADF;
+    if (in_description->is_directory())
+        return EISDIR;
+    // NOTE: Like other systems, we only support sending from something that behaves like a regular file.
+    if (!in_description->file().is_seekable())
+        return EINVAL;
+
+    auto out_description = TRY(open_file_description(out_fd));
+    if (!out_description->is_writable())
+        return EBADF;
+
+    // NOTE: If an offset is given, we read from there and leave the offset of in_fd alone.
+    Optional<off_t> offset;
+    if (userspace_offset.ptr()) {
+        offset = TRY(copy_typed_from_user(userspace_offset));
+        if (offset.value() < 0)
+            return EINVAL;
+    }
+
+    auto buffer = TRY(KBuffer::try_create_with_size("sendfile"sv, min(count, sendfile_chunk_size)));
+    auto kernel_buffer = UserOrKernelBuffer::for_kernel_buffer(buffer->data());
+
+    size_t total_nwritten = 0;
+    while (total_nwritten < count) {
+        auto chunk_size = min(count - total_nwritten, buffer->size());
+        auto nread_or_error = offset.has_value()
+            ? in_description->read(kernel_buffer, offset.value() + total_nwritten, chunk_size)
+            : in_description->read(kernel_buffer, chunk_size);
+        if (nread_or_error.is_error()) {
+            if (total_nwritten > 0)
+                break;
+            return nread_or_error.release_error();
+        }
+        auto nread = nread_or_error.release_value();
+        if (nread == 0)
+            break;
+
+        auto nwritten_or_error = do_write(*out_description, kernel_buffer, nread);
+        if (nwritten_or_error.is_error()) {
+            if (!offset.has_value())
+                give_back_to_input(*in_description, nread);
+            if (total_nwritten > 0)
+                break;
+            return nwritten_or_error.release_error();
+        }
+        auto nwritten = nwritten_or_error.release_value();
+        total_nwritten += nwritten;
+
+        if (nwritten < nread) {
+            // The output would block, so give back what we couldn't send to the input.
+            if (!offset.has_value())
+                give_back_to_input(*in_description, nread - nwritten);
+            break;
+        }
+    }
+
+    if (offset.has_value()) {
+        off_t new_offset = offset.value() + total_nwritten;
+        TRY(copy_to_user(userspace_offset, &new_offset));
+    }
+    return total_nwritten;
+}
+
+}
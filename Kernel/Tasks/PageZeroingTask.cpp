@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/Memory/MemoryManager.h>
+#include <Kernel/Process.h>
+#include <Kernel/Sections.h>
+#include <Kernel/Tasks/PageZeroingTask.h>
+#include <Kernel/WaitQueue.h>
+
+namespace Kernel {
+
+static constexpr StringView page_zeroing_task_name = "Page Zeroing Task"sv;
+
+static WaitQueue* s_page_zeroing_wait_queue;
+
+static void page_zeroing_task(void*)
+{
+    Thread::current()->set_priority(THREAD_PRIORITY_MIN);
+    for (;;) {
+        if (MM.refill_zeroed_page_pool()) {
+            s_page_zeroing_wait_queue->wait_forever(page_zeroing_task_name);
+        } else {
+            // Memory is tight right now, check back later instead of waiting to be woken up.
+            (void)Thread::current()->sleep(Time::from_seconds(1));
+        }
+    }
+}
+
+UNMAP_AFTER_INIT void PageZeroingTask::spawn()
+{
+    s_page_zeroing_wait_queue = new WaitQueue;
+
+    LockRefPtr<Thread> page_zeroing_thread;
+    auto page_zeroing_process = Process::create_kernel_process(page_zeroing_thread, KString::must_create(page_zeroing_task_name), page_zeroing_task, nullptr);
+    VERIFY(page_zeroing_process);
+}
+
+void PageZeroingTask::wake()
+{
+    if (s_page_zeroing_wait_queue)
+        s_page_zeroing_wait_queue->wake_one();
+}
+
+}
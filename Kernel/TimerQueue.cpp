@@ -45,14 +45,108 @@ Time Timer::now(bool is_firing) const
     return TimeManagement::the().current_time(clock_id);
 }
 
+TimerWheel::TimerWheel(u64 nanoseconds_per_tick, Time now)
+    : m_nanoseconds_per_tick(nanoseconds_per_tick)
+{
+    VERIFY(m_nanoseconds_per_tick > 0);
+    m_current_tick = tick_for_time(now);
+}
+
+u64 TimerWheel::tick_for_time(Time time) const
+{
+    auto nanoseconds = time.to_nanoseconds();
+    if (nanoseconds < 0)
+        return 0;
+    return static_cast<u64>(nanoseconds) / m_nanoseconds_per_tick;
+}
+
+void TimerWheel::add(Timer& timer)
+{
+    // A timer may only fire once the clock has passed its expiration time,
+    // so it goes into the slot of the tick after the one it expires in.
+    insert(timer, tick_for_time(timer.m_expires) + 1);
+}
+
+void TimerWheel::insert(Timer& timer, u64 tick)
+{
+    tick = max(tick, m_current_tick);
+    // Timers too far in the future are parked in the last reachable slot, and simply get re-added when they come due.
+    tick = min(tick, m_current_tick + span_in_ticks - 1);
+
+    auto ticks_until_due = tick - m_current_tick;
+    size_t level = 0;
+    while (ticks_until_due >= (1ull << (bits_per_level * (level + 1))))
+        ++level;
+
+    auto slot = (tick >> (bits_per_level * level)) & (slots_per_level - 1);
+    m_levels[level][slot].append(timer);
+}
+
+void TimerWheel::cascade(size_t level, size_t slot)
+{
+    auto& list = m_levels[level][slot];
+    while (auto* timer = list.first())
+        insert(*timer, tick_for_time(timer->m_expires) + 1);
+}
+
+void TimerWheel::rebuild(u64 current_tick)
+{
+    Timer::List timers;
+    for (auto& level : m_levels) {
+        for (auto& list : level) {
+            while (auto* timer = list.first())
+                timers.append(*timer);
+        }
+    }
+
+    m_current_tick = current_tick;
+    while (auto* timer = timers.first())
+        add(*timer);
+}
+
+template<typename Callback>
+void TimerWheel::advance(Time now, Callback callback)
+{
+    auto now_tick = tick_for_time(now);
+
+    // If the clock went backwards (or jumped far ahead), we sort all timers into the wheel
+    // again relative to the new time, rather than waiting for it or walking every tick in between.
+    if (now_tick + 1 < m_current_tick || (now_tick >= m_current_tick && now_tick - m_current_tick >= slots_per_level * slots_per_level))
+        rebuild(now_tick);
+
+    while (m_current_tick <= now_tick) {
+        // Whenever a level wraps around, the next slot of the level above is due to be spread out over the levels below.
+        for (size_t level = 1; level < level_count; ++level) {
+            auto lower_slot = (m_current_tick >> (bits_per_level * (level - 1))) & (slots_per_level - 1);
+            if (lower_slot != 0)
+                break;
+            cascade(level, (m_current_tick >> (bits_per_level * level)) & (slots_per_level - 1));
+        }
+
+        Timer::List due_timers;
+        auto& list = m_levels[0][m_current_tick & (slots_per_level - 1)];
+        while (auto* timer = list.first())
+            due_timers.append(*timer);
+
+        ++m_current_tick;
+
+        while (auto* timer = due_timers.first()) {
+            due_timers.remove(*timer);
+            callback(*timer);
+        }
+    }
+}
+
 TimerQueue& TimerQueue::the()
 {
     return *s_the;
 }
 
 UNMAP_AFTER_INIT TimerQueue::TimerQueue()
+    : m_ticks_per_second(TimeManagement::the().ticks_per_second())
+    , m_timer_wheel_monotonic(1'000'000'000 / m_ticks_per_second, TimeManagement::the().current_time(CLOCK_MONOTONIC_COARSE))
+    , m_timer_wheel_realtime(1'000'000'000 / m_ticks_per_second, TimeManagement::the().current_time(CLOCK_REALTIME_COARSE))
 {
-    m_ticks_per_second = TimeManagement::the().ticks_per_second();
 }
 
 bool TimerQueue::add_timer_without_id(NonnullLockRefPtr<Timer> timer, clockid_t clock_id, Time const& deadline, Function<void()>&& callback)
@@ -86,33 +180,13 @@ TimerId TimerQueue::add_timer(NonnullLockRefPtr<Timer>&& timer)
 
 void TimerQueue::add_timer_locked(NonnullLockRefPtr<Timer> timer)
 {
-    Time timer_expiration = timer->m_expires;
-
     timer->clear_cancelled();
     timer->clear_callback_finished();
     timer->set_in_use();
+    timer->m_is_executing = false;
 
-    auto& queue = queue_for_timer(*timer);
-    if (queue.list.is_empty()) {
-        queue.list.append(timer.leak_ref());
-        queue.next_timer_due = timer_expiration;
-    } else {
-        Timer* following_timer = nullptr;
-        for (auto& t : queue.list) {
-            if (t.m_expires > timer_expiration) {
-                following_timer = &t;
-                break;
-            }
-        }
-        if (following_timer) {
-            bool next_timer_needs_update = queue.list.first() == following_timer;
-            queue.list.insert_before(*following_timer, timer.leak_ref());
-            if (next_timer_needs_update)
-                queue.next_timer_due = timer_expiration;
-        } else {
-            queue.list.append(timer.leak_ref());
-        }
-    }
+    auto& wheel = wheel_for_timer(*timer);
+    wheel.add(timer.leak_ref());
 }
 
 bool TimerQueue::cancel_timer(Timer& timer, bool* was_in_use)
@@ -128,15 +202,15 @@ bool TimerQueue::cancel_timer(Timer& timer, bool* was_in_use)
     }
 
     bool did_already_run = timer.set_cancelled();
-    auto& timer_queue = queue_for_timer(timer);
     if (!did_already_run) {
         timer.clear_in_use();
 
         SpinlockLocker lock(g_timerqueue_lock);
-        if (timer_queue.list.contains(timer)) {
-            // The timer has not fired, remove it
+        if (!timer.m_is_executing) {
+            // The timer has not fired (or at least hasn't been handed off to a deferred call yet), remove it
+            VERIFY(timer.is_queued());
             VERIFY(timer.ref_count() > 1);
-            remove_timer_locked(timer_queue, timer);
+            remove_timer_locked(timer);
             return true;
         }
 
@@ -158,75 +232,64 @@ bool TimerQueue::cancel_timer(Timer& timer, bool* was_in_use)
     return false;
 }
 
-void TimerQueue::remove_timer_locked(Queue& queue, Timer& timer)
+void TimerQueue::remove_timer_locked(Timer& timer)
 {
-    bool was_next_timer = (queue.list.first() == &timer);
-    queue.list.remove(timer);
+    // NOTE: The timer is either in one of the wheels or in m_timers_expired, and unlinking its list node works for both.
+    timer.m_list_node.remove();
     auto now = timer.now(false);
     if (timer.m_expires > now)
         timer.m_remaining = timer.m_expires - now;
 
-    if (was_next_timer)
-        update_next_timer_due(queue);
     // Whenever we remove a timer that was still queued (but hasn't been
     // fired) we added a reference to it. So, when removing it from the
     // queue we need to drop that reference.
     timer.unref();
 }
 
+void TimerQueue::expire_timers_locked(TimerWheel& wheel, Time now)
+{
+    VERIFY(g_timerqueue_lock.is_locked());
+
+    wheel.advance(now, [&](Timer& timer) {
+        // The wheel only knows about ticks, so check against the timer's own clock as well.
+        if (timer.now(true) > timer.m_expires)
+            m_timers_expired.append(timer);
+        else
+            wheel.add(timer);
+    });
+}
+
 void TimerQueue::fire()
 {
     SpinlockLocker lock(g_timerqueue_lock);
 
-    auto fire_timers = [&](Queue& queue) {
-        auto* timer = queue.list.first();
-        VERIFY(timer);
-        VERIFY(queue.next_timer_due == timer->m_expires);
-
-        while (timer && timer->now(true) > timer->m_expires) {
-            queue.list.remove(*timer);
-
-            m_timers_executing.append(*timer);
-
-            update_next_timer_due(queue);
-
-            lock.unlock();
-
-            // Defer executing the timer outside of the irq handler
-            Processor::deferred_call_queue([this, timer]() {
-                // Check if we were cancelled in between being triggered
-                // by the timer irq handler and now. If so, just drop
-                // our reference and don't execute the callback.
-                if (!timer->set_cancelled()) {
-                    timer->m_callback();
-                    SpinlockLocker lock(g_timerqueue_lock);
-                    m_timers_executing.remove(*timer);
-                }
-                timer->clear_in_use();
-                timer->set_callback_finished();
-                // Drop the reference we added when queueing the timer
-                timer->unref();
-            });
-
-            lock.lock();
-            timer = queue.list.first();
-        }
-    };
+    expire_timers_locked(m_timer_wheel_monotonic, TimeManagement::the().current_time(CLOCK_MONOTONIC_COARSE));
+    expire_timers_locked(m_timer_wheel_realtime, TimeManagement::the().current_time(CLOCK_REALTIME_COARSE));
 
-    if (!m_timer_queue_monotonic.list.is_empty())
-        fire_timers(m_timer_queue_monotonic);
-    if (!m_timer_queue_realtime.list.is_empty())
-        fire_timers(m_timer_queue_realtime);
-}
+    while (auto* timer = m_timers_expired.first()) {
+        timer->m_is_executing = true;
+        m_timers_executing.append(*timer);
 
-void TimerQueue::update_next_timer_due(Queue& queue)
-{
-    VERIFY(g_timerqueue_lock.is_locked());
+        lock.unlock();
 
-    if (auto* next_timer = queue.list.first())
-        queue.next_timer_due = next_timer->m_expires;
-    else
-        queue.next_timer_due = {};
+        // Defer executing the timer outside of the irq handler
+        Processor::deferred_call_queue([this, timer]() {
+            // Check if we were cancelled in between being triggered
+            // by the timer irq handler and now. If so, just drop
+            // our reference and don't execute the callback.
+            if (!timer->set_cancelled()) {
+                timer->m_callback();
+                SpinlockLocker lock(g_timerqueue_lock);
+                m_timers_executing.remove(*timer);
+            }
+            timer->clear_in_use();
+            timer->set_callback_finished();
+            // Drop the reference we added when queueing the timer
+            timer->unref();
+        });
+
+        lock.lock();
+    }
 }
 
 }
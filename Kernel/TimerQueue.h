@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/AtomicRefCounted.h>
 #include <AK/Function.h>
 #include <AK/IntrusiveList.h>
@@ -20,6 +21,7 @@ AK_TYPEDEF_DISTINCT_ORDERED_ID(u64, TimerId);
 
 class Timer final : public AtomicRefCounted<Timer> {
     friend class TimerQueue;
+    friend class TimerWheel;
 
 public:
     void setup(clockid_t clock_id, Time expires, Function<void()>&& callback)
@@ -46,15 +48,8 @@ private:
     Atomic<bool> m_cancelled { false };
     Atomic<bool> m_callback_finished { false };
     Atomic<bool> m_in_use { false };
+    bool m_is_executing { false };
 
-    bool operator<(Timer const& rhs) const
-    {
-        return m_expires < rhs.m_expires;
-    }
-    bool operator>(Timer const& rhs) const
-    {
-        return m_expires > rhs.m_expires;
-    }
     bool operator==(Timer const& rhs) const
     {
         return m_id == rhs.m_id;
@@ -80,6 +75,37 @@ public:
     using List = IntrusiveList<&Timer::m_list_node>;
 };
 
+// A hierarchical timing wheel: Adding and removing a timer is O(1), and timers only get
+// touched again when their slot comes due or when their slot of a higher level cascades down.
+class TimerWheel {
+public:
+    static constexpr size_t bits_per_level = 6;
+    static constexpr size_t slots_per_level = 1 << bits_per_level;
+    static constexpr size_t level_count = 4;
+    static constexpr u64 span_in_ticks = 1ull << (bits_per_level * level_count);
+
+    TimerWheel(u64 nanoseconds_per_tick, Time now);
+
+    void add(Timer&);
+
+    // Calls the callback for every timer whose slot has come due by `now`.
+    template<typename Callback>
+    void advance(Time now, Callback);
+
+private:
+    u64 tick_for_time(Time) const;
+    void insert(Timer&, u64 tick);
+    void cascade(size_t level, size_t slot);
+    void rebuild(u64 current_tick);
+
+    u64 m_nanoseconds_per_tick { 0 };
+
+    // The next tick to be processed. All slots for earlier ticks have been emptied.
+    u64 m_current_tick { 0 };
+
+    Array<Array<Timer::List, slots_per_level>, level_count> m_levels;
+};
+
 class TimerQueue {
     friend class Timer;
 
@@ -93,24 +119,20 @@ public:
     void fire();
 
 private:
-    struct Queue {
-        Timer::List list;
-        Time next_timer_due {};
-    };
-    void remove_timer_locked(Queue&, Timer&);
-    void update_next_timer_due(Queue&);
+    void remove_timer_locked(Timer&);
     void add_timer_locked(NonnullLockRefPtr<Timer>);
+    void expire_timers_locked(TimerWheel&, Time now);
 
-    Queue& queue_for_timer(Timer& timer)
+    TimerWheel& wheel_for_timer(Timer& timer)
     {
         switch (timer.m_clock_id) {
         case CLOCK_MONOTONIC:
         case CLOCK_MONOTONIC_COARSE:
         case CLOCK_MONOTONIC_RAW:
-            return m_timer_queue_monotonic;
+            return m_timer_wheel_monotonic;
         case CLOCK_REALTIME:
         case CLOCK_REALTIME_COARSE:
-            return m_timer_queue_realtime;
+            return m_timer_wheel_realtime;
         default:
             VERIFY_NOT_REACHED();
         }
@@ -118,8 +140,11 @@ private:
 
     u64 m_timer_id_count { 0 };
     u64 m_ticks_per_second { 0 };
-    Queue m_timer_queue_monotonic;
-    Queue m_timer_queue_realtime;
+    TimerWheel m_timer_wheel_monotonic;
+    TimerWheel m_timer_wheel_realtime;
+
+    // Timers that have expired, but whose callback hasn't been queued as a deferred call yet.
+    Timer::List m_timers_expired;
     Timer::List m_timers_executing;
 };
 
@@ -221,6 +221,14 @@ BrowserWindow::BrowserWindow(Browser::CookieJar& cookie_jar, StringView webdrive
         debug_request("set-line-box-borders", state ? "on" : "off");
     });
 
+    auto* profile_javascript_action = new QAction("Profile JavaScript", this);
+    profile_javascript_action->setCheckable(true);
+    debug_menu->addAction(profile_javascript_action);
+    QObject::connect(profile_javascript_action, &QAction::triggered, this, [this, profile_javascript_action] {
+        bool state = profile_javascript_action->isChecked();
+        debug_request("js-profiler", state ? "on" : "off");
+    });
+
     debug_menu->addSeparator();
 
     auto* collect_garbage_action = new QAction("Collect Garbage", this);
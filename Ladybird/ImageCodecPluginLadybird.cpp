@@ -46,6 +46,9 @@ static Optional<Web::Platform::DecodedImage> decode_image_with_libgfx(ReadonlyBy
         return {};
     }
 
+    // The bitmaps are displayed as they are, i.e. as sRGB.
+    decoder->set_convert_to_sRGB(true);
+
     bool had_errors = false;
     Vector<Web::Platform::Frame> frames;
     for (size_t i = 0; i < decoder->frame_count(); ++i) {
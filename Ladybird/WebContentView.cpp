@@ -24,7 +24,9 @@
 #include <Kernel/API/KeyCode.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/EventLoop.h>
+#include <LibCore/File.h>
 #include <LibCore/IODevice.h>
+#include <LibCore/StandardPaths.h>
 #include <LibCore/System.h>
 #include <LibCore/Timer.h>
 #include <LibGfx/Bitmap.h>
@@ -1059,6 +1061,21 @@ void WebContentView::notify_server_did_get_accessibility_tree(DeprecatedString c
         m_inspector_widget->set_accessibility_json(accessibility_json);
 }
 
+void WebContentView::notify_server_did_get_js_profile(DeprecatedString const& profile)
+{
+    auto path = LexicalPath::join(Core::StandardPaths::tempfile_directory(), "WebContent-js.profile"sv);
+    auto write_profile = [&]() -> ErrorOr<void> {
+        auto file = TRY(Core::File::open(path.string(), Core::File::OpenMode::Write));
+        TRY(file->write_entire_buffer(profile.bytes()));
+        return {};
+    };
+    if (auto result = write_profile(); result.is_error()) {
+        QMessageBox::warning(this, "Ladybird", qstring_from_ak_deprecated_string(DeprecatedString::formatted("Unable to write JS profile: {}", result.error())));
+        return;
+    }
+    QMessageBox::information(this, "Ladybird", qstring_from_ak_deprecated_string(DeprecatedString::formatted("Wrote JS profile to {}", path)));
+}
+
 ErrorOr<String> WebContentView::dump_layout_tree()
 {
     return String::from_deprecated_string(client().dump_layout_tree());
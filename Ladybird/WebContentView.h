@@ -134,6 +134,7 @@ public:
     virtual void notify_server_did_get_dom_tree(DeprecatedString const& dom_tree) override;
     virtual void notify_server_did_get_dom_node_properties(i32 node_id, DeprecatedString const& specified_style, DeprecatedString const& computed_style, DeprecatedString const& custom_properties, DeprecatedString const& node_box_sizing) override;
     virtual void notify_server_did_get_accessibility_tree(DeprecatedString const& accessibility_tree) override;
+    virtual void notify_server_did_get_js_profile(DeprecatedString const& profile) override;
     virtual void notify_server_did_output_js_console_message(i32 message_index) override;
     virtual void notify_server_did_get_js_console_messages(i32 start_index, Vector<DeprecatedString> const& message_types, Vector<DeprecatedString> const& messages) override;
     virtual void notify_server_did_change_favicon(Gfx::Bitmap const& favicon) override;
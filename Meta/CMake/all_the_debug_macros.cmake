@@ -79,6 +79,7 @@ set(HIGHLIGHT_FOCUSED_FRAME_DEBUG ON)
 set(HPET_COMPARATOR_DEBUG ON)
 set(HPET_DEBUG ON)
 set(HTML_SCRIPT_DEBUG ON)
+set(HTTP2_DEBUG ON)
 set(HTTPJOB_DEBUG ON)
 set(HTTPSJOB_DEBUG ON)
 set(HUNKS_DEBUG ON)
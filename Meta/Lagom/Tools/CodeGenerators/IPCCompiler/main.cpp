@@ -525,10 +525,73 @@ void do_message_for_proxy(SourceGenerator message_generator, Endpoint const& end
     })~~~");
     };
 
+    // Sends a synchronous message without blocking, the returned promise is resolved once the response arrives.
+    auto do_implement_request_proxy = [&]() {
+        DeprecatedString return_type = "void";
+        if (message.outputs.size() == 1)
+            return_type = message.outputs[0].type;
+        else if (!message.outputs.is_empty())
+            return_type = message_name(endpoint.name, message.name, true);
+
+        message_generator.set("message.name", message.name);
+        message_generator.set("message.pascal_name", pascal_case(message.name));
+        message_generator.set("message.response_type", pascal_case(message.response_name()));
+        message_generator.set("message.result_type", DeprecatedString::formatted("IPC::IPCErrorOr<{}>", return_type));
+        message_generator.append(R"~~~(
+    NonnullRefPtr<Core::Promise<@message.result_type@>> request_@message.name@()~~~");
+
+        for (size_t i = 0; i < message.inputs.size(); ++i) {
+            auto const& parameter = message.inputs[i];
+            auto argument_generator = message_generator.fork();
+            argument_generator.set("argument.type", parameter.type);
+            argument_generator.set("argument.name", parameter.name);
+            argument_generator.append("@argument.type@ @argument.name@");
+            if (i != message.inputs.size() - 1)
+                argument_generator.append(", ");
+        }
+
+        message_generator.append(R"~~~() {
+        auto promise = Core::Promise<@message.result_type@>::construct();
+        m_connection.template send_async<Messages::@endpoint.name@::@message.pascal_name@>([promise](OwnPtr<Messages::@endpoint.name@::@message.response_type@> response) {
+            if (!response) {
+                promise->resolve(IPC::ErrorCode::PeerDisconnected);
+                return;
+            })~~~");
+
+        if (message.outputs.size() == 1) {
+            message_generator.set("output.name", message.outputs[0].name);
+            message_generator.append(R"~~~(
+            promise->resolve(response->take_@output.name@());)~~~");
+        } else if (!message.outputs.is_empty()) {
+            message_generator.append(R"~~~(
+            promise->resolve(move(*response));)~~~");
+        } else {
+            message_generator.append(R"~~~(
+            promise->resolve(@message.result_type@ {});)~~~");
+        }
+
+        message_generator.append(R"~~~(
+        })~~~");
+
+        for (auto const& parameter : message.inputs) {
+            auto argument_generator = message_generator.fork();
+            argument_generator.set("argument.name", parameter.name);
+            if (is_primitive_or_simple_type(parameter.type))
+                argument_generator.append(", @argument.name@");
+            else
+                argument_generator.append(", move(@argument.name@)");
+        }
+
+        message_generator.appendln(R"~~~();
+        return promise;
+    })~~~");
+    };
+
     do_implement_proxy(message.name, message.inputs, message.is_synchronous, false);
     if (message.is_synchronous) {
         do_implement_proxy(message.name, message.inputs, false, false);
         do_implement_proxy(message.name, message.inputs, true, true);
+        do_implement_request_proxy();
     }
 }
 
@@ -772,6 +835,7 @@ void build(StringBuilder& builder, Vector<Endpoint> const& endpoints)
 #include <AK/OwnPtr.h>
 #include <AK/Result.h>
 #include <AK/Utf8View.h>
+#include <LibCore/Promise.h>
 #include <LibIPC/Connection.h>
 #include <LibIPC/Decoder.h>
 #include <LibIPC/Dictionary.h>
@@ -1954,23 +1954,14 @@ struct DayPeriodData {
     cldr.unique_day_period_lists.generate(generator, cldr.unique_day_periods.type_that_fits(), "s_day_period_lists"sv);
     cldr.unique_hour_cycle_lists.generate(generator, cldr.unique_hour_cycle_lists.type_that_fits(), "s_hour_cycle_lists"sv);
 
-    auto append_calendars = [&](DeprecatedString name, auto const& calendars) {
-        generator.set("name", name);
-        generator.set("size", DeprecatedString::number(calendars.size()));
+    auto calendar_values = [&](auto const& calendars) {
+        Vector<size_t> values;
+        values.ensure_capacity(calendars.size());
 
-        generator.append(R"~~~(
-static constexpr Array<@calendar_index_type@, @size@> @name@ { {)~~~");
+        for (auto const& calendar_key : cldr.calendars)
+            values.unchecked_append(calendars.find(calendar_key)->value);
 
-        bool first = true;
-        for (auto const& calendar_key : cldr.calendars) {
-            auto calendar = calendars.find(calendar_key)->value;
-
-            generator.append(first ? " "sv : ", "sv);
-            generator.append(DeprecatedString::number(calendar));
-            first = false;
-        }
-
-        generator.append(" } };");
+        return values;
     };
 
     auto append_mapping = [&](auto const& keys, auto const& map, auto type, auto name, auto mapping_getter) {
@@ -1997,7 +1988,7 @@ static constexpr Array<@type@, @size@> @name@ { {)~~~");
     auto locales = cldr.locales.keys();
     quick_sort(locales);
 
-    generate_mapping(generator, cldr.locales, cldr.unique_calendars.type_that_fits(), "s_locale_calendars"sv, "s_calendars_{}"sv, format_identifier, [&](auto const& name, auto const& value) { append_calendars(name, value.calendars); });
+    generate_mapping(generator, cldr.locales, cldr.unique_calendars.type_that_fits(), "s_locale_calendars"sv, format_identifier, [&](auto const& value) { return calendar_values(value.calendars); });
     append_mapping(locales, cldr.locales, cldr.unique_time_zones.type_that_fits(), "s_locale_time_zones"sv, [](auto const& locale) { return locale.time_zones; });
     append_mapping(locales, cldr.locales, cldr.unique_time_zone_formats.type_that_fits(), "s_locale_time_zone_formats"sv, [](auto const& locale) { return locale.time_zone_formats; });
     append_mapping(locales, cldr.locales, cldr.unique_day_periods.type_that_fits(), "s_locale_day_periods"sv, [](auto const& locale) { return locale.day_periods; });
@@ -871,30 +871,23 @@ static constexpr Array<u8, @size@> s_minimum_grouping_digits { { )~~~");
     }
     generator.append(" } };\n");
 
-    auto append_map = [&](DeprecatedString name, auto type, auto const& map) {
-        generator.set("name", name);
-        generator.set("type", type);
-        generator.set("size", DeprecatedString::number(map.size()));
+    auto map_values = [&](auto const& map) {
+        Vector<size_t> values;
+        values.ensure_capacity(map.size());
 
-        generator.append(R"~~~(
-static constexpr Array<@type@, @size@> @name@ { {)~~~");
-
-        bool first = true;
         for (auto const& item : map) {
-            generator.append(first ? " "sv : ", "sv);
             if constexpr (requires { item.value; })
-                generator.append(DeprecatedString::number(item.value));
+                values.unchecked_append(item.value);
             else
-                generator.append(DeprecatedString::number(item));
-            first = false;
+                values.unchecked_append(item);
         }
 
-        generator.append(" } };");
+        return values;
     };
 
-    generate_mapping(generator, cldr.number_system_digits, "u32"sv, "s_number_systems_digits"sv, "s_number_systems_digits_{}"sv, nullptr, [&](auto const& name, auto const& value) { append_map(name, "u32"sv, value); });
-    generate_mapping(generator, cldr.locales, cldr.unique_systems.type_that_fits(), "s_locale_number_systems"sv, "s_number_systems_{}"sv, nullptr, [&](auto const& name, auto const& value) { append_map(name, cldr.unique_systems.type_that_fits(), value.number_systems); });
-    generate_mapping(generator, cldr.locales, cldr.unique_units.type_that_fits(), "s_locale_units"sv, "s_units_{}"sv, nullptr, [&](auto const& name, auto const& value) { append_map(name, cldr.unique_units.type_that_fits(), value.units); });
+    generate_mapping(generator, cldr.number_system_digits, "u32"sv, "s_number_systems_digits"sv, nullptr, [&](auto const& value) { return map_values(value); });
+    generate_mapping(generator, cldr.locales, cldr.unique_systems.type_that_fits(), "s_locale_number_systems"sv, nullptr, [&](auto const& value) { return map_values(value.number_systems); });
+    generate_mapping(generator, cldr.locales, cldr.unique_units.type_that_fits(), "s_locale_units"sv, nullptr, [&](auto const& value) { return map_values(value.units); });
 
     generator.append(R"~~~(
 static Optional<NumberSystem> keyword_to_number_system(KeywordNumbers keyword)
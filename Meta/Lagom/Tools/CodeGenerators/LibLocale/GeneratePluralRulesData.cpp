@@ -562,19 +562,15 @@ static constexpr Array<@type@, @size@> s_@form@_functions { {)~~~");
 )~~~");
     };
 
-    auto append_categories = [&](auto const& name, auto const& rules) {
-        generator.set("name", name);
-        generator.set("size", DeprecatedString::number(rules.size() + 1));
+    auto categories = [&](auto const& rules) {
+        Vector<DeprecatedString> values;
+        values.ensure_capacity(rules.size() + 1);
+        values.unchecked_append("PluralCategory::Other"sv);
 
-        generator.append(R"~~~(
-static constexpr Array<PluralCategory, @size@> @name@ { { PluralCategory::Other)~~~");
-
-        for (auto [category, condition] : rules) {
-            generator.set("category"sv, format_identifier({}, category));
-            generator.append(", PluralCategory::@category@"sv);
-        }
+        for (auto [category, condition] : rules)
+            values.unchecked_append(DeprecatedString::formatted("PluralCategory::{}", format_identifier({}, category)));
 
-        generator.append("} };");
+        return values;
     };
 
     for (auto [locale, rules] : cldr.locales) {
@@ -587,16 +583,16 @@ static constexpr Array<PluralCategory, @size@> @name@ { { PluralCategory::Other)
     append_lookup_table("PluralCategoryFunction"sv, "ordinal"sv, "default_category"sv, [](auto& rules, auto form) -> Conditions& { return rules.rules_for_form(form); });
     append_lookup_table("PluralRangeFunction"sv, "range"sv, "default_range"sv, [](auto& rules, auto) -> Ranges& { return rules.plural_ranges; });
 
-    generate_mapping(generator, locales, "PluralCategory"sv, "s_cardinal_categories"sv, "s_cardinal_categories_{}"sv, format_identifier,
-        [&](auto const& name, auto const& locale) {
+    generate_mapping(generator, locales, "PluralCategory"sv, "s_cardinal_categories"sv, format_identifier,
+        [&](auto const& locale) {
             auto& rules = cldr.locales.find(locale)->value;
-            append_categories(name, rules.rules_for_form("cardinal"sv));
+            return categories(rules.rules_for_form("cardinal"sv));
         });
 
-    generate_mapping(generator, locales, "PluralCategory"sv, "s_ordinal_categories"sv, "s_ordinal_categories_{}"sv, format_identifier,
-        [&](auto const& name, auto const& locale) {
+    generate_mapping(generator, locales, "PluralCategory"sv, "s_ordinal_categories"sv, format_identifier,
+        [&](auto const& locale) {
             auto& rules = cldr.locales.find(locale)->value;
-            append_categories(name, rules.rules_for_form("ordinal"sv));
+            return categories(rules.rules_for_form("ordinal"sv));
         });
 
     generator.append(R"~~~(
@@ -226,24 +226,7 @@ struct RelativeTimeFormatImpl {
 
     cldr.unique_formats.generate(generator, "RelativeTimeFormatImpl"sv, "s_relative_time_formats"sv, 10);
 
-    auto append_list = [&](DeprecatedString name, auto const& list) {
-        generator.set("name", name);
-        generator.set("size", DeprecatedString::number(list.size()));
-
-        generator.append(R"~~~(
-static constexpr Array<@relative_time_format_index_type@, @size@> @name@ { {)~~~");
-
-        bool first = true;
-        for (auto index : list) {
-            generator.append(first ? " "sv : ", "sv);
-            generator.append(DeprecatedString::number(index));
-            first = false;
-        }
-
-        generator.append(" } };");
-    };
-
-    generate_mapping(generator, cldr.locales, cldr.unique_formats.type_that_fits(), "s_locale_relative_time_formats"sv, "s_number_systems_digits_{}"sv, nullptr, [&](auto const& name, auto const& value) { append_list(name, value.time_units); });
+    generate_mapping(generator, cldr.locales, cldr.unique_formats.type_that_fits(), "s_locale_relative_time_formats"sv, nullptr, [&](auto const& value) { return value.time_units; });
 
     generator.append(R"~~~(
 ErrorOr<Vector<RelativeTimeFormat>> get_relative_time_format_patterns(StringView locale, TimeUnit time_unit, StringView tense_or_number, Style style)
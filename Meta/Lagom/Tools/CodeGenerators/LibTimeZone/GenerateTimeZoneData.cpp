@@ -549,52 +549,14 @@ struct DaylightSavingsOffset {
 
     time_zone_data.unique_strings.generate(generator);
 
-    auto append_offsets = [&](auto const& name, auto type, auto const& offsets) {
-        generator.set("name", name);
-        generator.set("type", type);
-        generator.set("size", DeprecatedString::number(offsets.size()));
+    generate_mapping(generator, time_zone_data.time_zone_names, "TimeZoneOffset"sv, "s_time_zone_offsets"sv, format_identifier,
+        [&](auto const& value) -> auto const& { return time_zone_data.time_zones.find(value)->value; }, 1);
 
-        generator.append(R"~~~(
-static constexpr Array<@type@, @size@> @name@ { {
-)~~~");
-
-        for (auto const& offset : offsets)
-            generator.append(DeprecatedString::formatted("    {},\n", offset));
-
-        generator.append("} };\n");
-    };
+    generate_mapping(generator, time_zone_data.dst_offset_names, "DaylightSavingsOffset"sv, "s_dst_offsets"sv, format_identifier,
+        [&](auto const& value) -> auto const& { return time_zone_data.dst_offsets.find(value)->value; }, 1);
 
-    generate_mapping(generator, time_zone_data.time_zone_names, "TimeZoneOffset"sv, "s_time_zone_offsets"sv, "s_time_zone_offsets_{}"sv, format_identifier,
-        [&](auto const& name, auto const& value) {
-            auto const& time_zone_offsets = time_zone_data.time_zones.find(value)->value;
-            append_offsets(name, "TimeZoneOffset"sv, time_zone_offsets);
-        });
-
-    generate_mapping(generator, time_zone_data.dst_offset_names, "DaylightSavingsOffset"sv, "s_dst_offsets"sv, "s_dst_offsets_{}"sv, format_identifier,
-        [&](auto const& name, auto const& value) {
-            auto const& dst_offsets = time_zone_data.dst_offsets.find(value)->value;
-            append_offsets(name, "DaylightSavingsOffset"sv, dst_offsets);
-        });
-
-    generate_mapping(generator, time_zone_data.time_zone_region_names, time_zone_data.unique_strings.type_that_fits(), "s_regional_time_zones"sv, "s_regional_time_zones_{}"sv, format_identifier,
-        [&](auto const& name, auto const& value) {
-            auto const& time_zones = time_zone_data.time_zone_regions.find(value)->value;
-
-            generator.set("name", name);
-            generator.set("size", DeprecatedString::number(time_zones.size()));
-
-            generator.append(R"~~~(
-static constexpr Array<@string_index_type@, @size@> @name@ { {)~~~");
-
-            bool first = true;
-            for (auto const& time_zone : time_zones) {
-                generator.append(first ? " "sv : ", "sv);
-                generator.append(DeprecatedString::number(time_zone));
-                first = false;
-            }
-
-            generator.append(" } };");
-        });
+    generate_mapping(generator, time_zone_data.time_zone_region_names, time_zone_data.unique_strings.type_that_fits(), "s_regional_time_zones"sv, format_identifier,
+        [&](auto const& value) -> auto const& { return time_zone_data.time_zone_regions.find(value)->value; });
 
     generator.set("size", DeprecatedString::number(time_zone_data.time_zone_names.size()));
     generator.append(R"~~~(
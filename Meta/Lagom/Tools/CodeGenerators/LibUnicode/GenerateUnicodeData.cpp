@@ -55,6 +55,13 @@ struct CodePointDecomposition {
     size_t decomposition_size { 0 };
 };
 
+// https://www.unicode.org/reports/tr15/#Primary_Composite
+struct CodePointComposition {
+    u32 first_code_point { 0 };
+    u32 second_code_point { 0 };
+    u32 composite_code_point { 0 };
+};
+
 // https://www.unicode.org/reports/tr44/#PropList.txt
 using PropList = HashMap<DeprecatedString, Vector<CodePointRange>>;
 
@@ -112,6 +119,7 @@ struct UnicodeData {
     u32 code_points_with_decomposition_mapping { 0 };
     Vector<u32> decomposition_mappings;
     Vector<DeprecatedString> compatibility_tags;
+    Vector<CodePointComposition> compositions;
 
     u32 simple_uppercase_mapping_size { 0 };
     u32 simple_lowercase_mapping_size { 0 };
@@ -162,7 +170,6 @@ struct UnicodeData {
     Vector<Alias> block_aliases;
     Vector<BlockName> block_display_names;
 
-    // FIXME: We are not yet doing anything with this data. It will be needed for String.prototype.normalize.
     NormalizationProps normalization_props;
 
     PropList grapheme_break_props;
@@ -976,6 +983,23 @@ struct CodePointAbbreviation {
     @string_index_type@ abbreviation { 0 };
 };
 
+struct CodePointComposition {
+    u32 first_code_point { 0 };
+    u32 second_code_point { 0 };
+    u32 composite_code_point { 0 };
+};
+
+struct CodePointCompositionComparator {
+    constexpr int operator()(Array<u32, 2> const& code_points, CodePointComposition const& composition)
+    {
+        if (code_points[0] != composition.first_code_point)
+            return code_points[0] < composition.first_code_point ? -1 : 1;
+        if (code_points[1] != composition.second_code_point)
+            return code_points[1] < composition.second_code_point ? -1 : 1;
+        return 0;
+    }
+};
+
 template<typename MappingType>
 struct CodePointComparator {
     constexpr int operator()(u32 code_point, MappingType const& mapping)
@@ -1091,6 +1115,33 @@ static constexpr Array<@mapping_type@, @size@> s_@name@_mappings { {
             return data.decomposition_mapping;
         });
 
+    generator.set("compositions_size", DeprecatedString::number(unicode_data.compositions.size()));
+    generator.append(R"~~~(
+static constexpr Array<CodePointComposition, @compositions_size@> s_compositions { {
+    )~~~");
+
+    constexpr size_t max_compositions_per_row = 10;
+    size_t compositions_in_current_row = 0;
+
+    for (auto const& composition : unicode_data.compositions) {
+        if (compositions_in_current_row++ > 0)
+            generator.append(" ");
+
+        generator.set("first", DeprecatedString::formatted("{:#x}", composition.first_code_point));
+        generator.set("second", DeprecatedString::formatted("{:#x}", composition.second_code_point));
+        generator.set("composite", DeprecatedString::formatted("{:#x}", composition.composite_code_point));
+        generator.append("{ @first@, @second@, @composite@ },");
+
+        if (compositions_in_current_row == max_compositions_per_row) {
+            compositions_in_current_row = 0;
+            generator.append("\n    ");
+        }
+    }
+
+    generator.append(R"~~~(
+} };
+)~~~");
+
     auto append_code_point_range_list = [&](DeprecatedString name, Vector<CodePointRange> const& ranges) {
         generator.set("name", name);
         generator.set("size", DeprecatedString::number(ranges.size()));
@@ -1290,6 +1341,14 @@ Optional<CodePointDecomposition const> code_point_decomposition_by_index(size_t
     auto const& mapping = s_decomposition_mappings[index];
     return CodePointDecomposition { mapping.code_point, mapping.tag, ReadonlySpan<u32> { s_decomposition_mappings_data.data() + mapping.decomposition_index, mapping.decomposition_count } };
 }
+
+Optional<u32> code_point_composition(u32 first_code_point, u32 second_code_point)
+{
+    auto const* composition = binary_search(s_compositions, Array { first_code_point, second_code_point }, nullptr, CodePointCompositionComparator {});
+    if (composition == nullptr)
+        return {};
+    return composition->composite_code_point;
+}
 )~~~");
 
     auto append_prop_search = [&](StringView enum_title, StringView enum_snake, StringView collection_name) {
@@ -1436,6 +1495,37 @@ static void populate_general_category_unions(PropList& general_categories)
     populate_union("C"sv, Array { "Cc"sv, "Cf"sv, "Cs"sv, "Co"sv, "Cn"sv });
 }
 
+static void populate_compositions(UnicodeData& unicode_data)
+{
+    // The primary composites are the code points with a canonical decomposition into two code points that are not
+    // excluded from composition. Sort them by the pair they're composed from, so a composite can be looked up quickly.
+    // https://www.unicode.org/reports/tr15/#Primary_Composite
+    auto const& exclusions = unicode_data.prop_list.find("Full_Composition_Exclusion"sv)->value;
+
+    for (auto const& data : unicode_data.code_point_data) {
+        if (!data.decomposition_mapping.has_value())
+            continue;
+
+        auto const& mapping = *data.decomposition_mapping;
+        if (mapping.tag != "Canonical"sv || mapping.decomposition_size != 2)
+            continue;
+        if (any_of(exclusions, [&](auto const& r) { return (r.first <= data.code_point) && (data.code_point <= r.last); }))
+            continue;
+
+        unicode_data.compositions.append({
+            unicode_data.decomposition_mappings[mapping.decomposition_index],
+            unicode_data.decomposition_mappings[mapping.decomposition_index + 1],
+            data.code_point,
+        });
+    }
+
+    quick_sort(unicode_data.compositions, [](auto const& lhs, auto const& rhs) {
+        if (lhs.first_code_point != rhs.first_code_point)
+            return lhs.first_code_point < rhs.first_code_point;
+        return lhs.second_code_point < rhs.second_code_point;
+    });
+}
+
 static void normalize_script_extensions(PropList& script_extensions, PropList const& script_list, Vector<Alias> const& script_aliases)
 {
     // The ScriptExtensions UCD file lays out its code point ranges rather uniquely compared to
@@ -1575,6 +1665,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     TRY(parse_value_alias_list(*prop_value_alias_file, "sc"sv, unicode_data.script_list.keys(), unicode_data.script_aliases, false));
     TRY(parse_value_alias_list(*prop_value_alias_file, "blk"sv, unicode_data.block_list.keys(), unicode_data.block_aliases, false, true));
     normalize_script_extensions(unicode_data.script_extensions, unicode_data.script_list, unicode_data.script_aliases);
+    populate_compositions(unicode_data);
 
     TRY(generate_unicode_data_header(*generated_header_file, unicode_data));
     TRY(generate_unicode_data_implementation(*generated_implementation_file, unicode_data));
@@ -50,6 +50,77 @@ struct AK::Traits<Vector<T>> : public GenericTraits<Vector<T>> {
     }
 };
 
+// Generates a table of lists that is accessed like an array of spans. The values of all of the lists are stored in one
+// array, next to an array of the offsets at which each list starts. Unlike an array of spans, the table doesn't hold any
+// pointers. So it doesn't have to be relocated when the library is loaded, and it stays in the read-only section of the
+// library: its pages are shared between processes, and are only paged in once a list in them is looked up.
+inline void generate_list_table(SourceGenerator& generator, StringView type, StringView name, Vector<Vector<DeprecatedString>> const& lists, size_t max_values_per_row = 20)
+{
+    size_t values_size = 0;
+    for (auto const& list : lists)
+        values_size += list.size();
+
+    generator.set("type"sv, type);
+    generator.set("name"sv, name);
+    generator.set("values_size"sv, DeprecatedString::number(values_size));
+    generator.set("offsets_size"sv, DeprecatedString::number(lists.size() + 1));
+    generator.set("offset_type"sv, values_size <= NumericLimits<u16>::max() ? "u16"sv : "u32"sv);
+
+    size_t values_in_current_row = 0;
+
+    auto append_value = [&](StringView value, size_t values_per_row) {
+        if (values_in_current_row++ > 0)
+            generator.append(" ");
+
+        generator.append(value);
+        generator.append(",");
+
+        if (values_in_current_row == values_per_row) {
+            values_in_current_row = 0;
+            generator.append("\n    ");
+        }
+    };
+
+    generator.append(R"~~~(
+static constexpr Array<@type@, @values_size@> @name@_values { {
+    )~~~");
+
+    for (auto const& list : lists) {
+        for (auto const& value : list)
+            append_value(value, max_values_per_row);
+    }
+
+    generator.append(R"~~~(
+} };
+
+static constexpr Array<@offset_type@, @offsets_size@> @name@_offsets { {
+    )~~~");
+
+    values_in_current_row = 0;
+    size_t offset = 0;
+    append_value(DeprecatedString::number(offset), 20);
+
+    for (auto const& list : lists) {
+        offset += list.size();
+        append_value(DeprecatedString::number(offset), 20);
+    }
+
+    generator.append(R"~~~(
+} };
+
+static constexpr struct {
+    constexpr ReadonlySpan<@type@> at(size_t index) const
+    {
+        size_t offset = @name@_offsets.at(index);
+        return @name@_values.span().slice(offset, @name@_offsets.at(index + 1) - offset);
+    }
+
+    constexpr ReadonlySpan<@type@> operator[](size_t index) const { return at(index); }
+    constexpr size_t size() const { return @name@_offsets.size() - 1; }
+} @name@ {};
+)~~~");
+}
+
 template<typename StorageType>
 class UniqueStorage {
 public:
@@ -132,54 +203,22 @@ static constexpr Array<@type@, @size@ + 1> @name@ { {
     void generate(SourceGenerator& generator, StringView type, StringView name)
     requires(StorageTypeIsList<StorageType>)
     {
-        generator.set("type"sv, type);
-        generator.set("name"sv, name);
-
-        for (size_t i = 0; i < m_storage.size(); ++i) {
-            auto const& list = m_storage[i];
-
-            generator.set("index"sv, DeprecatedString::number(i));
-            generator.set("size"sv, DeprecatedString::number(list.size()));
-
-            generator.append(R"~~~(
-static constexpr Array<@type@, @size@> @name@@index@ { {)~~~");
-
-            bool first = true;
-            for (auto const& value : list) {
-                generator.append(first ? " "sv : ", "sv);
-                generator.append(DeprecatedString::formatted("{}", value));
-                first = false;
-            }
-
-            generator.append(" } };");
-        }
-
-        generator.set("size"sv, DeprecatedString::number(m_storage.size()));
-
-        generator.append(R"~~~(
-
-static constexpr Array<ReadonlySpan<@type@>, @size@ + 1> @name@ { {
-    {})~~~");
-
-        constexpr size_t max_values_per_row = 10;
-        size_t values_in_current_row = 1;
+        // Index 0 is the default-initialized (empty) list.
+        Vector<Vector<DeprecatedString>> lists;
+        lists.ensure_capacity(m_storage.size() + 1);
+        lists.unchecked_append({});
 
-        for (size_t i = 0; i < m_storage.size(); ++i) {
-            if (values_in_current_row++ > 0)
-                generator.append(", ");
+        for (auto const& list : m_storage) {
+            Vector<DeprecatedString> values;
+            values.ensure_capacity(list.size());
 
-            generator.set("index"sv, DeprecatedString::number(i));
-            generator.append("@name@@index@.span()");
+            for (auto const& value : list)
+                values.unchecked_append(DeprecatedString::formatted("{}", value));
 
-            if (values_in_current_row == max_values_per_row) {
-                values_in_current_row = 0;
-                generator.append(",\n    ");
-            }
+            lists.unchecked_append(move(values));
         }
 
-        generator.append(R"~~~(
-} };
-)~~~");
+        generate_list_table(generator, type, name, lists);
     }
 
 protected:
@@ -541,9 +580,9 @@ enum class @name@ : @underlying@ {)~~~");
 }
 
 template<typename LocalesType, typename IdentifierFormatter, typename ListFormatter>
-void generate_mapping(SourceGenerator& generator, LocalesType const& locales, StringView type, StringView name, StringView format, IdentifierFormatter&& format_identifier, ListFormatter&& format_list)
+void generate_mapping(SourceGenerator& generator, LocalesType const& locales, StringView type, StringView name, IdentifierFormatter&& format_identifier, ListFormatter&& format_list, size_t max_values_per_row = 20)
 {
-    auto format_mapping_name = [&](StringView format, StringView name) {
+    auto format_mapping_name = [&](StringView name) {
         DeprecatedString mapping_name;
 
         if constexpr (IsNullPointer<IdentifierFormatter>)
@@ -551,53 +590,46 @@ void generate_mapping(SourceGenerator& generator, LocalesType const& locales, St
         else
             mapping_name = format_identifier(type, name);
 
-        return DeprecatedString::formatted(format, mapping_name.to_lowercase());
+        return mapping_name.to_lowercase();
+    };
+
+    struct Mapping {
+        DeprecatedString name;
+        Vector<DeprecatedString> values;
     };
 
-    Vector<DeprecatedString> mapping_names;
+    Vector<Mapping> mappings;
+    mappings.ensure_capacity(locales.size());
 
     for (auto const& locale : locales) {
-        DeprecatedString mapping_name;
+        Mapping mapping;
+
+        auto append_values = [&](auto const& list) {
+            for (auto const& value : list)
+                mapping.values.append(DeprecatedString::formatted("{}", value));
+        };
 
         if constexpr (requires { locale.key; }) {
-            mapping_name = format_mapping_name(format, locale.key);
-            format_list(mapping_name, locale.value);
+            mapping.name = format_mapping_name(locale.key);
+            append_values(format_list(locale.value));
         } else {
-            mapping_name = format_mapping_name(format, locale);
-            format_list(mapping_name, locale);
+            mapping.name = format_mapping_name(locale);
+            append_values(format_list(locale));
         }
 
-        mapping_names.append(move(mapping_name));
+        mappings.unchecked_append(move(mapping));
     }
 
-    quick_sort(mapping_names);
+    // The lists are ordered by name, like the enumeration they're looked up by.
+    quick_sort(mappings, [](auto const& lhs, auto const& rhs) { return lhs.name < rhs.name; });
 
-    generator.set("type", type);
-    generator.set("name", name);
-    generator.set("size", DeprecatedString::number(locales.size()));
-    generator.append(R"~~~(
-static constexpr Array<ReadonlySpan<@type@>, @size@> @name@ { {
-    )~~~");
+    Vector<Vector<DeprecatedString>> lists;
+    lists.ensure_capacity(mappings.size());
 
-    constexpr size_t max_values_per_row = 10;
-    size_t values_in_current_row = 0;
-
-    for (auto& mapping_name : mapping_names) {
-        if (values_in_current_row++ > 0)
-            generator.append(" ");
+    for (auto& mapping : mappings)
+        lists.unchecked_append(move(mapping.values));
 
-        generator.set("name", move(mapping_name));
-        generator.append("@name@.span(),");
-
-        if (values_in_current_row == max_values_per_row) {
-            values_in_current_row = 0;
-            generator.append("\n    ");
-        }
-    }
-
-    generator.append(R"~~~(
-} };
-)~~~");
+    generate_list_table(generator, type, name, lists, max_values_per_row);
 }
 
 template<typename T>
@@ -393,6 +393,8 @@ public:
         }
     }
 
+    bool is_in_initial_state() const { return m_state == State::@initial_state@; }
+
 private:
     enum class State : u8 {
         _Anywhere,
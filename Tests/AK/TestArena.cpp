@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Arena.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Vector.h>
+
+namespace {
+
+struct Node {
+    Node(int value, Node* next)
+        : value(value)
+        , next(next)
+    {
+    }
+
+    int value { 0 };
+    Node* next { nullptr };
+};
+
+struct Tracked {
+    Tracked(Vector<int>& destroyed, int id)
+        : destroyed(destroyed)
+        , id(id)
+    {
+    }
+
+    ~Tracked() { destroyed.append(id); }
+
+    Vector<int>& destroyed;
+    int id { 0 };
+};
+
+}
+
+TEST_CASE(allocations_are_aligned)
+{
+    Arena arena;
+    for (size_t alignment = 1; alignment <= 4096; alignment *= 2) {
+        for (size_t size : { 1, 3, 17, 100 }) {
+            auto* pointer = arena.allocate(size, alignment);
+            EXPECT_EQ(reinterpret_cast<FlatPtr>(pointer) % alignment, 0u);
+        }
+    }
+}
+
+TEST_CASE(create_objects)
+{
+    Arena arena;
+    Node* head = nullptr;
+    for (int i = 0; i < 100'000; ++i)
+        head = arena.create<Node>(i, head);
+
+    int expected = 99'999;
+    for (auto* node = head; node; node = node->next)
+        EXPECT_EQ(node->value, expected--);
+    EXPECT_EQ(expected, -1);
+    EXPECT(arena.chunk_count() > 1);
+}
+
+TEST_CASE(destructors_run_in_reverse_order)
+{
+    Vector<int> destroyed;
+    {
+        Arena arena;
+        arena.create<Tracked>(destroyed, 1);
+        arena.create<Tracked>(destroyed, 2);
+        arena.create<Tracked>(destroyed, 3);
+        EXPECT(destroyed.is_empty());
+    }
+    EXPECT_EQ(destroyed, (Vector<int> { 3, 2, 1 }));
+}
+
+TEST_CASE(reset_to_mark)
+{
+    Vector<int> destroyed;
+    Arena arena(4 * KiB);
+
+    arena.create<Tracked>(destroyed, 1);
+    auto* before = arena.create<Node>(1, nullptr);
+    auto mark = arena.mark();
+
+    arena.create<Tracked>(destroyed, 2);
+    for (int i = 0; i < 10'000; ++i)
+        arena.create<Node>(i, nullptr);
+    MUST(arena.try_allocate(1 * MiB));
+    auto chunks = arena.chunk_count();
+
+    arena.reset_to(mark);
+    EXPECT_EQ(destroyed, (Vector<int> { 2 }));
+    EXPECT_EQ(before->value, 1);
+
+    // Allocating the same amount again reuses the chunks from before.
+    for (int i = 0; i < 10'000; ++i)
+        arena.create<Node>(i, nullptr);
+    EXPECT_EQ(arena.chunk_count(), chunks);
+
+    arena.reset();
+    EXPECT_EQ(destroyed, (Vector<int> { 2, 1 }));
+    EXPECT_EQ(arena.chunk_count(), chunks);
+
+    arena.release_unused_chunks();
+    EXPECT_EQ(arena.chunk_count(), 1u);
+}
+
+TEST_CASE(arena_scope)
+{
+    Vector<int> destroyed;
+    Arena arena;
+    arena.create<Tracked>(destroyed, 1);
+    {
+        ArenaScope scope(arena);
+        arena.create<Tracked>(destroyed, 2);
+        arena.create<Tracked>(destroyed, 3);
+    }
+    EXPECT_EQ(destroyed, (Vector<int> { 3, 2 }));
+}
+
+TEST_CASE(arrays_and_strings)
+{
+    Arena arena;
+    auto numbers = MUST(arena.try_allocate_array<u32>(1000));
+    EXPECT_EQ(numbers.size(), 1000u);
+    for (size_t i = 0; i < numbers.size(); ++i)
+        numbers[i] = i;
+
+    u8 const bytes[] = { 1, 2, 3 };
+    auto copy = MUST(arena.try_copy(ReadonlyBytes { bytes, sizeof(bytes) }));
+    EXPECT_EQ(copy.size(), 3u);
+    EXPECT_NE(copy.data(), bytes);
+    EXPECT_EQ(copy[2], 3);
+
+    auto string = MUST(arena.try_copy("Well hello friends!"sv));
+    EXPECT_EQ(string, "Well hello friends!"sv);
+    EXPECT_EQ(MUST(arena.try_copy(""sv)), ""sv);
+
+    EXPECT(MUST(arena.try_allocate_array<u32>(0)).is_empty());
+    EXPECT_EQ(numbers[999], 999u);
+}
+
+BENCHMARK_CASE(arena_allocation)
+{
+    Arena arena;
+    for (size_t round = 0; round < 20; ++round) {
+        Node* head = nullptr;
+        for (int i = 0; i < 100'000; ++i)
+            head = arena.create<Node>(i, head);
+        EXPECT_EQ(head->value, 99'999);
+        arena.reset();
+    }
+}
+
+BENCHMARK_CASE(heap_allocation)
+{
+    for (size_t round = 0; round < 20; ++round) {
+        Vector<NonnullOwnPtr<Node>> nodes;
+        Node* head = nullptr;
+        for (int i = 0; i < 100'000; ++i) {
+            nodes.append(make<Node>(i, head));
+            head = nodes.last().ptr();
+        }
+        EXPECT_EQ(head->value, 99'999);
+    }
+}
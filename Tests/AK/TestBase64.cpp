@@ -55,3 +55,34 @@ TEST_CASE(test_encode)
     encode_equal("fooba"sv, "Zm9vYmE="sv);
     encode_equal("foobar"sv, "Zm9vYmFy"sv);
 }
+
+TEST_CASE(test_long_input)
+{
+    // Long enough to go through the paths that convert whole blocks at once, with a partial block at the end.
+    auto input = MUST(ByteBuffer::create_uninitialized(1000));
+    for (size_t i = 0; i < input.size(); ++i)
+        input[i] = static_cast<u8>(i * 7 + i / 256);
+
+    for (size_t length = 0; length <= input.size(); length += 37) {
+        auto bytes = input.bytes().trim(length);
+        auto encoded = MUST(encode_base64(bytes));
+        EXPECT_EQ(encoded.bytes().size(), calculate_base64_encoded_length(bytes));
+        auto decoded = MUST(decode_base64(encoded));
+        EXPECT_EQ(decoded.bytes(), bytes);
+    }
+
+    EXPECT_EQ(MUST(encode_base64("The quick brown fox jumps over the lazy dog"sv.bytes())), "VGhlIHF1aWNrIGJyb3duIGZveCBqdW1wcyBvdmVyIHRoZSBsYXp5IGRvZw=="sv);
+    auto decoded = MUST(decode_base64("VGhlIHF1aWNrIGJyb3duIGZveCBqdW1wcyBvdmVyIHRoZSBsYXp5IGRvZw=="sv));
+    EXPECT_EQ(decoded.bytes(), "The quick brown fox jumps over the lazy dog"sv.bytes());
+    EXPECT_EQ(MUST(encode_base64("\xfb\xff\xbf\xfb\xff\xbf\xfb\xff\xbf\xfb\xff\xbf\xfb\xff\xbf"sv.bytes())), "+/+/+/+/+/+/+/+/+/+/"sv);
+}
+
+TEST_CASE(test_long_input_with_whitespace_and_invalid_characters)
+{
+    auto decoded = MUST(decode_base64("VGhlIHF1aWNrIGJy\nb3duIGZveCBqdW1w cyBvdmVyIHRoZSBsYXp5\r\nIGRvZw=="sv));
+    EXPECT_EQ(decoded.bytes(), "The quick brown fox jumps over the lazy dog"sv.bytes());
+
+    EXPECT(decode_base64("VGhlIHF1aWNrIGJy:3duIGZveCBqdW1w"sv).is_error());
+    EXPECT(decode_base64("VGhlIHF1aWNrIGJyb3duIGZveCBqdW1\xc3"sv).is_error());
+    EXPECT(decode_base64("VGhlIHF1aWNrIGJyb3du=ZveCBqdW1w"sv).is_error());
+}
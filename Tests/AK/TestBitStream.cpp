@@ -119,3 +119,28 @@ TEST_CASE(big_endian_bit_stream_input_output_match)
         EXPECT_EQ(0b1101001000100001u, result);
     }
 }
+
+TEST_CASE(little_endian_bit_stream_peek_and_byte_reads)
+{
+    Array<u8, 5> const data { 0b1010'0101, 0xff, 0x12, 0x34, 0x56 };
+    auto memory_stream = make<FixedMemoryStream>(data.span());
+    LittleEndianInputBitStream bit_read_stream { MaybeOwned<Stream>(*memory_stream) };
+
+    // Peeking must not consume anything, even if it buffers more than it returns.
+    EXPECT_EQ(MUST(bit_read_stream.peek_bits(4)), 0b0101u);
+    EXPECT_EQ(MUST(bit_read_stream.peek_bits(12)), 0xfa5u);
+    MUST(bit_read_stream.discard_previously_peeked_bits(3));
+    EXPECT_EQ(MUST(bit_read_stream.read_bits(5)), 0b10100u);
+
+    // Byte reads have to start with the bytes that have already been buffered.
+    Array<u8, 3> bytes;
+    auto read_bytes = MUST(bit_read_stream.read(bytes));
+    EXPECT_EQ(read_bytes.size(), 3u);
+    EXPECT_EQ(bytes, (Array<u8, 3> { 0xff, 0x12, 0x34 }));
+
+    // Bits past the end can be peeked at, but not consumed.
+    EXPECT_EQ(MUST(bit_read_stream.peek_bits(16)), 0x56u);
+    EXPECT(bit_read_stream.discard_previously_peeked_bits(9).is_error());
+    EXPECT_EQ(MUST(bit_read_stream.read_bits(8)), 0x56u);
+    EXPECT(bit_read_stream.is_eof());
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/CountingBloomFilter.h>
+#include <AK/HashFunctions.h>
+
+TEST_CASE(empty)
+{
+    CountingBloomFilter filter;
+    EXPECT(filter.is_empty());
+    for (u32 i = 0; i < 1000; ++i)
+        EXPECT(!filter.may_contain(int_hash(i)));
+}
+
+TEST_CASE(added_values_are_found)
+{
+    CountingBloomFilter filter;
+    for (u32 i = 0; i < 100; ++i)
+        filter.add(int_hash(i));
+    for (u32 i = 0; i < 100; ++i)
+        EXPECT(filter.may_contain(int_hash(i)));
+}
+
+TEST_CASE(few_false_positives)
+{
+    CountingBloomFilter filter;
+    for (u32 i = 0; i < 32; ++i)
+        filter.add(int_hash(i));
+
+    size_t false_positives = 0;
+    for (u32 i = 1000; i < 2000; ++i) {
+        if (filter.may_contain(int_hash(i)))
+            ++false_positives;
+    }
+    EXPECT(false_positives < 10);
+}
+
+TEST_CASE(remove)
+{
+    CountingBloomFilter filter;
+    filter.add(int_hash(1));
+    filter.add(int_hash(2));
+    filter.add(int_hash(2));
+
+    filter.remove(int_hash(2));
+    EXPECT(filter.may_contain(int_hash(1)));
+    EXPECT(filter.may_contain(int_hash(2)));
+
+    filter.remove(int_hash(2));
+    EXPECT(filter.may_contain(int_hash(1)));
+    EXPECT(!filter.may_contain(int_hash(2)));
+
+    filter.remove(int_hash(1));
+    EXPECT(filter.is_empty());
+}
+
+TEST_CASE(saturated_counters_stay_set)
+{
+    CountingBloomFilter filter;
+    for (size_t i = 0; i < 300; ++i)
+        filter.add(int_hash(7));
+    for (size_t i = 0; i < 300; ++i)
+        filter.remove(int_hash(7));
+    EXPECT(filter.may_contain(int_hash(7)));
+}
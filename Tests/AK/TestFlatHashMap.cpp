@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/DeprecatedString.h>
+#include <AK/FlatHashMap.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+
+TEST_CASE(construct)
+{
+    using IntIntMap = FlatHashMap<int, int>;
+    EXPECT(IntIntMap().is_empty());
+    EXPECT_EQ(IntIntMap().size(), 0u);
+    EXPECT_EQ(IntIntMap().begin(), IntIntMap().end());
+}
+
+TEST_CASE(construct_from_initializer_list)
+{
+    FlatHashMap<int, DeprecatedString> number_to_string {
+        { 1, "One" },
+        { 2, "Two" },
+        { 3, "Three" },
+    };
+    EXPECT_EQ(number_to_string.is_empty(), false);
+    EXPECT_EQ(number_to_string.size(), 3u);
+    EXPECT_EQ(number_to_string.get(2).value(), "Two");
+}
+
+TEST_CASE(populate)
+{
+    FlatHashMap<int, DeprecatedString> number_to_string;
+    number_to_string.set(1, "One");
+    number_to_string.set(2, "Two");
+    number_to_string.set(3, "Three");
+
+    EXPECT_EQ(number_to_string.is_empty(), false);
+    EXPECT_EQ(number_to_string.size(), 3u);
+}
+
+TEST_CASE(range_loop)
+{
+    FlatHashMap<int, DeprecatedString> number_to_string;
+    EXPECT_EQ(number_to_string.set(1, "One"), AK::HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(number_to_string.set(2, "Two"), AK::HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(number_to_string.set(3, "Three"), AK::HashSetResult::InsertedNewEntry);
+
+    int loop_counter = 0;
+    for (auto& it : number_to_string) {
+        EXPECT_EQ(it.value.is_null(), false);
+        ++loop_counter;
+    }
+    EXPECT_EQ(loop_counter, 3);
+}
+
+TEST_CASE(map_remove)
+{
+    FlatHashMap<int, DeprecatedString> number_to_string;
+    EXPECT_EQ(number_to_string.set(1, "One"), AK::HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(number_to_string.set(2, "Two"), AK::HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(number_to_string.set(3, "Three"), AK::HashSetResult::InsertedNewEntry);
+
+    EXPECT_EQ(number_to_string.remove(1), true);
+    EXPECT_EQ(number_to_string.size(), 2u);
+    EXPECT(number_to_string.find(1) == number_to_string.end());
+
+    EXPECT_EQ(number_to_string.remove(3), true);
+    EXPECT_EQ(number_to_string.size(), 1u);
+    EXPECT(number_to_string.find(3) == number_to_string.end());
+    EXPECT(number_to_string.find(2) != number_to_string.end());
+
+    EXPECT_EQ(number_to_string.remove(3), false);
+}
+
+TEST_CASE(remove_all_matching)
+{
+    FlatHashMap<int, DeprecatedString> map;
+
+    map.set(1, "One");
+    map.set(2, "Two");
+    map.set(3, "Three");
+    map.set(4, "Four");
+
+    EXPECT_EQ(map.size(), 4u);
+
+    EXPECT_EQ(map.remove_all_matching([&](int key, DeprecatedString const& value) { return key == 1 || value == "Two"; }), true);
+    EXPECT_EQ(map.size(), 2u);
+
+    EXPECT_EQ(map.remove_all_matching([&](int, DeprecatedString const&) { return false; }), false);
+    EXPECT_EQ(map.size(), 2u);
+
+    EXPECT(map.contains(3));
+    EXPECT(map.contains(4));
+
+    EXPECT_EQ(map.remove_all_matching([&](int, DeprecatedString const&) { return true; }), true);
+    EXPECT_EQ(map.remove_all_matching([&](int, DeprecatedString const&) { return false; }), false);
+
+    EXPECT(map.is_empty());
+}
+
+TEST_CASE(case_insensitive)
+{
+    FlatHashMap<DeprecatedString, int, CaseInsensitiveStringTraits> casemap;
+    EXPECT_EQ(DeprecatedString("nickserv").to_lowercase(), DeprecatedString("NickServ").to_lowercase());
+    EXPECT_EQ(casemap.set("nickserv", 3), AK::HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(casemap.set("NickServ", 3), AK::HashSetResult::ReplacedExistingEntry);
+    EXPECT_EQ(casemap.size(), 1u);
+}
+
+TEST_CASE(hash_compatible)
+{
+    FlatHashMap<DeprecatedString, int> map;
+    map.set("Hello", 1);
+    map.set("World", 2);
+
+    EXPECT(map.contains("Hello"sv));
+    EXPECT(map.contains("World"sv));
+    EXPECT(!map.contains("Serenity"sv));
+    EXPECT_EQ(map.find("World"sv)->value, 2);
+    EXPECT(map.remove("Hello"sv));
+    EXPECT_EQ(map.size(), 1u);
+}
+
+TEST_CASE(many_entries)
+{
+    FlatHashMap<int, int> map;
+    for (int i = 0; i < 10'000; ++i)
+        EXPECT_EQ(map.set(i, i * 2), AK::HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(map.size(), 10'000u);
+
+    for (int i = 0; i < 10'000; ++i)
+        EXPECT_EQ(map.get(i).value(), i * 2);
+    EXPECT(!map.contains(10'000));
+
+    size_t seen = 0;
+    for (auto& entry : map) {
+        EXPECT_EQ(entry.value, entry.key * 2);
+        ++seen;
+    }
+    EXPECT_EQ(seen, map.size());
+}
+
+TEST_CASE(remove_and_reinsert)
+{
+    // Churn through many more values than the table ever holds at once, so that tombstones
+    // have to be reclaimed rather than accumulating forever.
+    FlatHashMap<int, int> map;
+    for (int i = 0; i < 100'000; ++i) {
+        map.set(i, i);
+        if (i >= 100)
+            EXPECT(map.remove(i - 100));
+    }
+    EXPECT_EQ(map.size(), 100u);
+    EXPECT(map.capacity() <= 512u);
+
+    for (int i = 0; i < 100'000 - 100; ++i)
+        EXPECT(!map.contains(i));
+    for (int i = 100'000 - 100; i < 100'000; ++i)
+        EXPECT_EQ(map.get(i).value(), i);
+}
+
+TEST_CASE(colliding_hashes)
+{
+    struct CollidingTraits : public Traits<int> {
+        static unsigned hash(int value) { return static_cast<unsigned>(value) % 3; }
+    };
+
+    FlatHashTable<int, CollidingTraits> table;
+    for (int i = 0; i < 200; ++i)
+        EXPECT_EQ(table.set(i), AK::HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(table.size(), 200u);
+
+    for (int i = 0; i < 200; i += 2)
+        EXPECT(table.remove(i));
+    EXPECT_EQ(table.size(), 100u);
+
+    for (int i = 0; i < 200; ++i)
+        EXPECT_EQ(table.contains(i), i % 2 == 1);
+}
+
+TEST_CASE(set_keep_existing)
+{
+    FlatHashTable<int> table;
+    EXPECT_EQ(table.set(1), AK::HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(table.set(1, AK::HashSetExistingEntryBehavior::Keep), AK::HashSetResult::KeptExistingEntry);
+    EXPECT_EQ(table.set(1), AK::HashSetResult::ReplacedExistingEntry);
+    EXPECT_EQ(table.size(), 1u);
+}
+
+TEST_CASE(copy_and_move)
+{
+    FlatHashMap<int, DeprecatedString> map;
+    for (int i = 0; i < 100; ++i)
+        map.set(i, DeprecatedString::number(i));
+
+    auto copy = map;
+    EXPECT_EQ(copy.size(), 100u);
+    EXPECT_EQ(copy.get(42).value(), "42");
+
+    auto moved = move(map);
+    EXPECT_EQ(moved.size(), 100u);
+    EXPECT_EQ(map.size(), 0u);
+    EXPECT_EQ(moved.get(99).value(), "99");
+
+    moved.clear_with_capacity();
+    EXPECT(moved.is_empty());
+    EXPECT(!moved.contains(1));
+    EXPECT_EQ(copy.size(), 100u);
+}
+
+TEST_CASE(non_trivial_values)
+{
+    FlatHashMap<int, NonnullOwnPtr<int>> map;
+    for (int i = 0; i < 100; ++i)
+        map.set(i, make<int>(i));
+    for (int i = 0; i < 100; i += 3)
+        EXPECT(map.take(i).has_value());
+    EXPECT_EQ(map.size(), 66u);
+    EXPECT_EQ(*map.get(1).value(), 1);
+}
+
+static constexpr int benchmark_entry_count = 100'000;
+static constexpr int benchmark_lookup_rounds = 20;
+
+template<typename MapType>
+static void benchmark_lookups()
+{
+    MapType map;
+    for (int i = 0; i < benchmark_entry_count; ++i)
+        map.set(i * 7, i);
+
+    size_t hits = 0;
+    for (int round = 0; round < benchmark_lookup_rounds; ++round) {
+        // Half of these lookups miss.
+        for (int i = 0; i < benchmark_entry_count * 2; ++i) {
+            if (map.contains(i * 7 / 2))
+                ++hits;
+        }
+    }
+    EXPECT(hits > 0);
+}
+
+BENCHMARK_CASE(hash_map_lookups)
+{
+    benchmark_lookups<HashMap<int, int>>();
+}
+
+BENCHMARK_CASE(flat_hash_map_lookups)
+{
+    benchmark_lookups<FlatHashMap<int, int>>();
+}
+
+template<typename MapType>
+static void benchmark_insert_and_remove()
+{
+    MapType map;
+    for (int round = 0; round < benchmark_lookup_rounds; ++round) {
+        for (int i = 0; i < benchmark_entry_count; ++i)
+            map.set(i, i);
+        for (int i = 0; i < benchmark_entry_count; ++i)
+            EXPECT(map.remove(i));
+    }
+}
+
+BENCHMARK_CASE(hash_map_insert_and_remove)
+{
+    benchmark_insert_and_remove<HashMap<int, int>>();
+}
+
+BENCHMARK_CASE(flat_hash_map_insert_and_remove)
+{
+    benchmark_insert_and_remove<FlatHashMap<int, int>>();
+}
@@ -276,6 +276,19 @@ TEST_CASE(magnitude_less_than_zero)
     EXPECT_EQ(DeprecatedString::formatted("{}", 0.654), "0.654");
 }
 
+TEST_CASE(floating_point_digits_are_exact)
+{
+    EXPECT_EQ(DeprecatedString::formatted("{:.17}", 0.1 + 0.2), "0.30000000000000004");
+    EXPECT_EQ(DeprecatedString::formatted("{:.20}", 0.1), "0.1");
+    EXPECT_EQ(DeprecatedString::formatted("{:f}", 0.1), "0.100000");
+    EXPECT_EQ(DeprecatedString::formatted("{:.3}", 0.0001), "0");
+    EXPECT_EQ(DeprecatedString::formatted("{:.4}", 0.0001), "0.0001");
+    EXPECT_EQ(DeprecatedString::formatted("{:+}", 2.5), "+2.5");
+    EXPECT_EQ(DeprecatedString::formatted("{}", 1e20), "100000000000000000000");
+    EXPECT_EQ(DeprecatedString::formatted("{}", 123456789.125), "123456789.125");
+    EXPECT_EQ(DeprecatedString::formatted("{}", -0.0), "0");
+}
+
 TEST_CASE(format_nullptr)
 {
     EXPECT_EQ(DeprecatedString::formatted("{}", nullptr), DeprecatedString::formatted("{:p}", static_cast<FlatPtr>(0)));
@@ -364,3 +377,35 @@ TEST_CASE(format_wchar)
     EXPECT_EQ(DeprecatedString::formatted("{:6d}", L'a'), "    97");
     EXPECT_EQ(DeprecatedString::formatted("{:#x}", L'\U0001F41E'), "0x1f41e");
 }
+
+TEST_CASE(integer_digits)
+{
+    EXPECT_EQ(DeprecatedString::formatted("{}", NumericLimits<u64>::max()), "18446744073709551615");
+    EXPECT_EQ(DeprecatedString::formatted("{}", NumericLimits<i64>::min()), "-9223372036854775808");
+    EXPECT_EQ(DeprecatedString::formatted("{} {} {} {}", 0, 9, 10, 100), "0 9 10 100");
+    EXPECT_EQ(DeprecatedString::formatted("{:x}", NumericLimits<u64>::max()), "ffffffffffffffff");
+    EXPECT_EQ(DeprecatedString::formatted("{:o}", 8), "10");
+    EXPECT_EQ(DeprecatedString::formatted("{:b}", 5), "101");
+    EXPECT_EQ(DeprecatedString::formatted("{:X}", 0xabcu), "ABC");
+    EXPECT_EQ(DeprecatedString::formatted("{{{}}} }}{{", 1), "{1} }{");
+}
+
+BENCHMARK_CASE(format_integers)
+{
+    StringBuilder builder;
+    for (u64 i = 0; i < 1'000'000; ++i) {
+        builder.clear();
+        builder.appendff("{} {}", i, i * 7919);
+    }
+    EXPECT(!builder.is_empty());
+}
+
+BENCHMARK_CASE(format_doubles)
+{
+    StringBuilder builder;
+    for (size_t i = 0; i < 200'000; ++i) {
+        builder.clear();
+        builder.appendff("{}", static_cast<double>(i) / 7.0);
+    }
+    EXPECT(!builder.is_empty());
+}
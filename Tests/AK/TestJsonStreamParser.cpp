@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/DeprecatedString.h>
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/JsonParser.h>
+#include <AK/JsonStreamParser.h>
+#include <AK/Stream.h>
+#include <AK/StringBuilder.h>
+
+namespace {
+
+class EventRecorder final : public JsonStreamVisitor {
+public:
+    DeprecatedString events() const { return m_builder.to_deprecated_string(); }
+
+    virtual ErrorOr<void> on_object_start() override { return record("{"sv); }
+    virtual ErrorOr<void> on_object_key(StringView key) override { return record(DeprecatedString::formatted("key:{}", key)); }
+    virtual ErrorOr<void> on_object_end() override { return record("}"sv); }
+    virtual ErrorOr<void> on_array_start() override { return record("["sv); }
+    virtual ErrorOr<void> on_array_end() override { return record("]"sv); }
+    virtual ErrorOr<void> on_string(StringView string) override { return record(DeprecatedString::formatted("string:{}", string)); }
+    virtual ErrorOr<void> on_number(JsonValue number) override { return record(DeprecatedString::formatted("number:{}", number.to_deprecated_string())); }
+    virtual ErrorOr<void> on_boolean(bool value) override { return record(value ? "true"sv : "false"sv); }
+    virtual ErrorOr<void> on_null() override { return record("null"sv); }
+
+private:
+    ErrorOr<void> record(StringView event)
+    {
+        if (!m_builder.is_empty())
+            TRY(m_builder.try_append(' '));
+        return m_builder.try_append(event);
+    }
+
+    StringBuilder m_builder;
+};
+
+// Hands out its data a few bytes at a time, so that tokens end up split across reads.
+class TrickleStream final : public Stream {
+public:
+    TrickleStream(StringView data, size_t chunk_size)
+        : m_data(data.bytes())
+        , m_chunk_size(chunk_size)
+    {
+    }
+
+    virtual ErrorOr<Bytes> read(Bytes bytes) override
+    {
+        auto count = min(min(bytes.size(), m_chunk_size), m_data.size() - m_offset);
+        m_data.slice(m_offset, count).copy_to(bytes);
+        m_offset += count;
+        return bytes.trim(count);
+    }
+
+    virtual ErrorOr<size_t> write(ReadonlyBytes) override { return Error::from_errno(EBADF); }
+    virtual bool is_eof() const override { return m_offset == m_data.size(); }
+    virtual bool is_open() const override { return true; }
+    virtual void close() override { }
+
+private:
+    ReadonlyBytes m_data;
+    size_t m_chunk_size { 0 };
+    size_t m_offset { 0 };
+};
+
+}
+
+static constexpr auto document = R"({
+    "name": "Form1",
+    "empty": "",
+    "escaped": "a\"b\\c\u00e9",
+    "numbers": [0, -1, 4294967296, 1.5, -0],
+    "flags": [true, false, null],
+    "nested": { "array": [[], {}] }
+})"sv;
+
+static constexpr auto expected_events = "{ key:name string:Form1 key:empty string: key:escaped string:a\"b\\c\xc3\xa9 "
+                                        "key:numbers [ number:0 number:-1 number:4294967296 number:1.5 number:0 ] "
+                                        "key:flags [ true false null ] "
+                                        "key:nested { key:array [ [ ] { } ] } }"sv;
+
+TEST_CASE(events_are_reported_in_document_order)
+{
+    EventRecorder recorder;
+    JsonStreamParser parser(document);
+    MUST(parser.parse(recorder));
+    EXPECT_EQ(recorder.events(), expected_events);
+}
+
+TEST_CASE(stream_input_split_across_reads)
+{
+    for (size_t chunk_size : { 1, 2, 3, 7, 64 }) {
+        TrickleStream stream(document, chunk_size);
+        EventRecorder recorder;
+        JsonStreamParser parser(stream);
+        MUST(parser.parse(recorder));
+        EXPECT_EQ(recorder.events(), expected_events);
+    }
+}
+
+TEST_CASE(json_parser_from_stream)
+{
+    TrickleStream stream(document, 5);
+    auto value = MUST(JsonParser(stream).parse());
+    EXPECT_EQ(value.to_deprecated_string(), MUST(JsonParser(document).parse()).to_deprecated_string());
+    EXPECT_EQ(value.as_object().get_deprecated_string("escaped"sv), "a\"b\\c\xc3\xa9"sv);
+}
+
+TEST_CASE(tokens_larger_than_the_stream_buffer)
+{
+    StringBuilder builder;
+    builder.append("[\""sv);
+    for (size_t i = 0; i < 100'000; ++i)
+        builder.append(static_cast<char>('a' + i % 26));
+    builder.append("\", 12345]"sv);
+    auto input = builder.to_deprecated_string();
+
+    TrickleStream stream(input, 4096);
+    auto value = MUST(JsonParser(stream).parse());
+    EXPECT_EQ(value.as_array().size(), 2u);
+    EXPECT_EQ(value.as_array().at(0).as_string().length(), 100'000u);
+    EXPECT_EQ(value.as_array().at(1).to_number<u32>(), 12345u);
+}
+
+TEST_CASE(deep_nesting_does_not_recurse)
+{
+    constexpr size_t depth = 100'000;
+    StringBuilder builder;
+    for (size_t i = 0; i < depth; ++i)
+        builder.append("[{\"a\":"sv);
+    builder.append("null"sv);
+    for (size_t i = 0; i < depth; ++i)
+        builder.append("}]"sv);
+
+    JsonStreamVisitor visitor;
+    JsonStreamParser parser(builder.string_view());
+    MUST(parser.parse(visitor));
+}
+
+TEST_CASE(visitor_errors_stop_the_parse)
+{
+    class StopAtNull final : public JsonStreamVisitor {
+    public:
+        virtual ErrorOr<void> on_null() override { return Error::from_string_literal("stop"); }
+    };
+
+    StopAtNull visitor;
+    JsonStreamParser parser("[1, null, 2]"sv);
+    auto result = parser.parse(visitor);
+    EXPECT(result.is_error());
+    EXPECT_EQ(result.error().string_literal(), "stop"sv);
+}
+
+TEST_CASE(malformed_input)
+{
+    for (auto input : { ""sv, "["sv, "[1,]"sv, "{\"a\" 1}"sv, "{\"a\":1,}"sv, "[1 2]"sv, "\"abc"sv, "tru"sv, "[] x"sv, "\"\\u12\""sv }) {
+        JsonStreamVisitor visitor;
+        JsonStreamParser parser(input);
+        EXPECT(parser.parse(visitor).is_error());
+    }
+}
+
+BENCHMARK_CASE(parse_large_document)
+{
+    StringBuilder builder;
+    builder.append('[');
+    for (size_t i = 0; i < 20'000; ++i) {
+        if (i != 0)
+            builder.append(',');
+        builder.appendff(R"({{"id": {}, "name": "item number {}", "score": {}.5, "tags": ["a", "b", "c"], "active": true}})", i, i, i);
+    }
+    builder.append(']');
+    auto input = builder.to_deprecated_string();
+
+    for (size_t i = 0; i < 10; ++i) {
+        auto value = MUST(JsonParser(input).parse());
+        EXPECT_EQ(value.as_array().size(), 20'000u);
+    }
+}
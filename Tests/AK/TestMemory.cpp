@@ -84,3 +84,96 @@ TEST_CASE(timing_safe_compare)
     DeprecatedString reversed = data_set.reverse();
     EXPECT_EQ(false, AK::timing_safe_compare(data_set.characters(), reversed.characters(), reversed.length()));
 }
+
+static Optional<size_t> naive_memmem(ReadonlyBytes haystack, ReadonlyBytes needle)
+{
+    for (size_t i = 0; i + needle.size() <= haystack.size(); ++i) {
+        if (haystack.slice(i, needle.size()) == needle)
+            return i;
+    }
+    return {};
+}
+
+TEST_CASE(memmem_matches_naive_search)
+{
+    // A tiny alphabet makes for lots of near misses, which is what the filtering has to get right.
+    u32 state = 1;
+    auto next_byte = [&] {
+        state = state * 1103515245 + 12345;
+        return static_cast<u8>('a' + (state >> 16) % 3);
+    };
+
+    Vector<u8> haystack;
+    for (size_t i = 0; i < 300; ++i)
+        haystack.append(next_byte());
+
+    for (size_t needle_length = 1; needle_length < 40; ++needle_length) {
+        for (size_t start = 0; start + needle_length <= haystack.size(); start += 7) {
+            auto needle = haystack.span().slice(start, needle_length);
+            EXPECT_EQ(AK::memmem_optional(haystack.data(), haystack.size(), needle.data(), needle.size()), naive_memmem(haystack, needle));
+        }
+
+        Vector<u8> missing_needle;
+        missing_needle.resize(needle_length);
+        missing_needle.span().fill('a');
+        missing_needle.last() = 'd';
+        EXPECT(!AK::memmem_optional(haystack.data(), haystack.size(), missing_needle.data(), missing_needle.size()).has_value());
+    }
+}
+
+TEST_CASE(memmem_pathological_input)
+{
+    Vector<u8> haystack;
+    haystack.resize(64 * KiB);
+    haystack.span().fill('a');
+    Vector<u8> needle;
+    needle.resize(1000);
+    needle.span().fill('a');
+    needle[500] = 'b';
+
+    EXPECT(!AK::memmem_optional(haystack.data(), haystack.size(), needle.data(), needle.size()).has_value());
+
+    needle.span().copy_to(haystack.span().slice(60 * KiB));
+    EXPECT_EQ(AK::memmem_optional(haystack.data(), haystack.size(), needle.data(), needle.size()), 60 * KiB);
+}
+
+TEST_CASE(memchr_at_every_position)
+{
+    Array<u8, 100> haystack {};
+    haystack.fill('x');
+    for (size_t position = 0; position < haystack.size(); ++position) {
+        haystack[position] = 'y';
+        EXPECT_EQ(AK::memchr_optional(haystack.data(), haystack.size(), 'y'), position);
+        EXPECT_EQ(AK::memchr_any_optional(haystack.data(), haystack.size(), "zy"sv.bytes()), position);
+        EXPECT_EQ(AK::memchr_any_optional(haystack.data(), haystack.size(), "abcdefy"sv.bytes()), position);
+        haystack[position] = 'x';
+    }
+    EXPECT(!AK::memchr_optional(haystack.data(), haystack.size(), 'y').has_value());
+    EXPECT(!AK::memchr_any_optional(haystack.data(), haystack.size(), "yz"sv.bytes()).has_value());
+    EXPECT(!AK::memchr_any_optional(haystack.data(), haystack.size(), ""sv.bytes()).has_value());
+    EXPECT(!AK::memchr_optional(haystack.data(), 0, 'x').has_value());
+}
+
+static Vector<u8> make_text_haystack()
+{
+    Vector<u8> haystack;
+    auto text = "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt. "sv;
+    while (haystack.size() < 4 * MiB)
+        haystack.append(text.bytes().data(), text.length());
+    return haystack;
+}
+
+BENCHMARK_CASE(memmem_text)
+{
+    auto haystack = make_text_haystack();
+    auto needle = "incididunt ut labore"sv;
+    for (size_t i = 0; i < 20; ++i)
+        EXPECT(!AK::memmem_optional(haystack.data(), haystack.size(), needle.characters_without_null_termination(), needle.length()).has_value());
+}
+
+BENCHMARK_CASE(memchr_text)
+{
+    auto haystack = make_text_haystack();
+    for (size_t i = 0; i < 20; ++i)
+        EXPECT(!AK::memchr_optional(haystack.data(), haystack.size(), '\n').has_value());
+}
@@ -8,7 +8,9 @@
 
 #include <AK/Noncopyable.h>
 #include <AK/QuickSort.h>
+#include <AK/Random.h>
 #include <AK/StdLibExtras.h>
+#include <AK/Vector.h>
 
 TEST_CASE(sorts_without_copy)
 {
@@ -41,6 +43,15 @@ TEST_CASE(sorts_without_copy)
 
     AK::single_pivot_quick_sort(array.begin(), array.end(), [](auto& a, auto& b) { return a.value < b.value; });
 
+    for (size_t i = 0; i < 63; ++i)
+        EXPECT(array[i].value <= array[i + 1].value);
+
+    // Test the pattern-defeating quick sort.
+    for (size_t i = 0; i < 64; ++i)
+        array[i].value = (64 - i) % 32 + 32;
+
+    pattern_defeating_quick_sort(array, 0, array.size() - 1, [](auto& a, auto& b) { return a.value < b.value; });
+
     for (size_t i = 0; i < 63; ++i)
         EXPECT(array[i].value <= array[i + 1].value);
 }
@@ -97,3 +108,126 @@ TEST_CASE(maximum_stack_depth)
 
     delete[] data;
 }
+
+enum class Pattern {
+    Random,
+    Sorted,
+    Reversed,
+    AllEqual,
+    FewDistinct,
+    OrganPipe,
+    Sawtooth,
+    SortedWithNoise,
+};
+
+static Vector<int> make_input(Pattern pattern, int size)
+{
+    Vector<int> data;
+    data.ensure_capacity(size);
+    for (int i = 0; i < size; ++i) {
+        switch (pattern) {
+        case Pattern::Random:
+            data.unchecked_append(static_cast<int>(get_random<u32>() % 1'000'000));
+            break;
+        case Pattern::Sorted:
+            data.unchecked_append(i);
+            break;
+        case Pattern::Reversed:
+            data.unchecked_append(size - i);
+            break;
+        case Pattern::AllEqual:
+            data.unchecked_append(42);
+            break;
+        case Pattern::FewDistinct:
+            data.unchecked_append(static_cast<int>(get_random<u32>() % 4));
+            break;
+        case Pattern::OrganPipe:
+            data.unchecked_append(i < size / 2 ? i : size - i);
+            break;
+        case Pattern::Sawtooth:
+            data.unchecked_append(i % 1000);
+            break;
+        case Pattern::SortedWithNoise:
+            data.unchecked_append(i % 100 == 0 ? static_cast<int>(get_random<u32>() % size) : i);
+            break;
+        }
+    }
+    return data;
+}
+
+static constexpr Array all_patterns {
+    Pattern::Random,
+    Pattern::Sorted,
+    Pattern::Reversed,
+    Pattern::AllEqual,
+    Pattern::FewDistinct,
+    Pattern::OrganPipe,
+    Pattern::Sawtooth,
+    Pattern::SortedWithNoise,
+};
+
+TEST_CASE(sorts_all_patterns)
+{
+    for (auto pattern : all_patterns) {
+        for (int size : { 0, 1, 2, 3, 10, 24, 25, 100, 129, 1000, 10'000 }) {
+            auto data = make_input(pattern, size);
+            quick_sort(data);
+            for (int i = 1; i < size; ++i)
+                EXPECT(data[i - 1] <= data[i]);
+
+            auto data_through_iterators = make_input(pattern, size);
+            quick_sort(data_through_iterators.begin(), data_through_iterators.end(), [](auto& a, auto& b) { return a > b; });
+            for (int i = 1; i < size; ++i)
+                EXPECT(data_through_iterators[i - 1] >= data_through_iterators[i]);
+        }
+    }
+}
+
+TEST_CASE(sorts_non_arithmetic_elements)
+{
+    struct Element {
+        int key;
+        int payload;
+    };
+
+    Vector<Element> data;
+    for (int i = 0; i < 1000; ++i)
+        data.append({ static_cast<int>(get_random<u32>() % 50), i });
+    quick_sort(data, [](auto& a, auto& b) { return a.key < b.key; });
+    for (size_t i = 1; i < data.size(); ++i)
+        EXPECT(data[i - 1].key <= data[i].key);
+}
+
+TEST_CASE(does_not_degrade_on_presorted_input)
+{
+    // Sorted and reversed input should be handled in linear time, and nothing should go quadratic.
+    int const size = 100'000;
+    for (auto pattern : all_patterns) {
+        auto data = make_input(pattern, size);
+        size_t comparisons = 0;
+        quick_sort(data, [&](auto& a, auto& b) {
+            ++comparisons;
+            return a < b;
+        });
+        // n * log2(n) is about 1.7 million here, a quadratic sort would need billions.
+        EXPECT(comparisons < 4'000'000u);
+        if (pattern == Pattern::Sorted || pattern == Pattern::AllEqual)
+            EXPECT(comparisons < 4u * size);
+    }
+}
+
+BENCHMARK_CASE(sort_random)
+{
+    for (int i = 0; i < 10; ++i) {
+        auto data = make_input(Pattern::Random, 100'000);
+        quick_sort(data);
+    }
+}
+
+BENCHMARK_CASE(sort_nearly_sorted)
+{
+    for (int i = 0; i < 10; ++i) {
+        auto data = make_input(Pattern::SortedWithNoise, 100'000);
+        quick_sort(data);
+    }
+}
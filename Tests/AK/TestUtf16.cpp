@@ -8,6 +8,7 @@
 
 #include <AK/Array.h>
 #include <AK/String.h>
+#include <AK/StringBuilder.h>
 #include <AK/StringView.h>
 #include <AK/Types.h>
 #include <AK/Utf16View.h>
@@ -280,3 +281,36 @@ TEST_CASE(substring_view)
         EXPECT_EQ(MUST(view.to_utf8(Utf16View::AllowInvalidCodeUnits::No)), "\ufffd"sv);
     }
 }
+
+TEST_CASE(transcode_long_strings)
+{
+    // Long enough to go through the bulk ASCII paths, with non-ASCII text at every offset.
+    for (size_t position = 0; position < 70; ++position) {
+        StringBuilder builder;
+        builder.append_repeated('a', position);
+        builder.append("\xc3\xa9\xf0\x9f\x98\x80"sv);
+        builder.append_repeated('b', 70 - position);
+        auto utf8 = builder.string_view();
+
+        auto utf16 = MUST(AK::utf8_to_utf16(utf8));
+        EXPECT_EQ(utf16.size(), 73u);
+        EXPECT_EQ(utf16[position], 0xe9);
+        EXPECT_EQ(utf16[position + 1], 0xd83d);
+        EXPECT_EQ(utf16[position + 2], 0xde00);
+
+        EXPECT_EQ(MUST(Utf16View { utf16 }.to_utf8()), utf8);
+    }
+}
+
+BENCHMARK_CASE(transcode_ascii)
+{
+    StringBuilder builder;
+    while (builder.length() < 1 * MiB)
+        builder.append("The quick brown fox jumps over the lazy dog. "sv);
+    auto utf8 = builder.string_view();
+
+    for (size_t i = 0; i < 20; ++i) {
+        auto utf16 = MUST(AK::utf8_to_utf16(utf8));
+        EXPECT_EQ(MUST(Utf16View { utf16 }.to_utf8()).bytes().size(), utf8.length());
+    }
+}
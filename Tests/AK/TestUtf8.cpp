@@ -7,6 +7,7 @@
 #include <LibTest/TestCase.h>
 
 #include <AK/ByteBuffer.h>
+#include <AK/StringBuilder.h>
 #include <AK/Utf8View.h>
 
 TEST_CASE(decode_ascii)
@@ -295,3 +296,51 @@ TEST_CASE(trim)
         EXPECT_EQ(view.trim(whitespace, TrimMode::Right).as_string(), "\u180E");
     }
 }
+
+TEST_CASE(validate_long_ascii_runs)
+{
+    // Put a non-ASCII byte at every position of a string long enough to go through all of the bulk ASCII checks.
+    for (size_t position = 0; position < 100; ++position) {
+        StringBuilder builder;
+        builder.append_repeated('a', position);
+        builder.append("\xc3\xa9"sv);
+        builder.append_repeated('b', 100 - position);
+        auto valid = builder.to_deprecated_string();
+        Utf8View valid_view { valid.view() };
+        EXPECT(valid_view.validate());
+        EXPECT_EQ(valid_view.length(), 101u);
+
+        builder.clear();
+        builder.append_repeated('a', position);
+        builder.append('\xc3');
+        builder.append_repeated('b', 100 - position);
+        auto invalid = builder.to_deprecated_string();
+        size_t valid_bytes = 0;
+        EXPECT(!Utf8View { invalid.view() }.validate(valid_bytes));
+        EXPECT_EQ(valid_bytes, position);
+    }
+}
+
+static DeprecatedString make_text(size_t length, StringView sprinkle)
+{
+    StringBuilder builder;
+    while (builder.length() < length) {
+        builder.append("The quick brown fox jumps over the lazy dog. "sv);
+        builder.append(sprinkle);
+    }
+    return builder.to_deprecated_string();
+}
+
+BENCHMARK_CASE(validate_ascii)
+{
+    auto text = make_text(1 * MiB, ""sv);
+    for (size_t i = 0; i < 100; ++i)
+        EXPECT(Utf8View { text.view() }.validate());
+}
+
+BENCHMARK_CASE(validate_mostly_ascii)
+{
+    auto text = make_text(1 * MiB, "\xc3\xa9\xe2\x82\xac "sv);
+    for (size_t i = 0; i < 100; ++i)
+        EXPECT(Utf8View { text.view() }.validate());
+}
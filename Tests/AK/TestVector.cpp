@@ -617,3 +617,42 @@ TEST_CASE(uses_inline_capacity_when_constructed_from_span)
     for (auto& el : v)
         EXPECT(is_inline_element(el, v));
 }
+
+TEST_CASE(small_vector_inline_capacity)
+{
+    EXPECT_EQ(SmallVector<u8>().capacity(), 16u);
+    EXPECT_EQ(SmallVector<u32>().capacity(), 16u);
+    EXPECT_EQ(SmallVector<u64>().capacity(), 8u);
+    EXPECT_EQ(SmallVector<int&>().capacity(), 64u / sizeof(int*));
+    EXPECT_EQ((SmallVector<Array<u8, 100>>().capacity()), 1u);
+    EXPECT_EQ((SmallVector<int, 3>().capacity()), 3u);
+
+    SmallVector<int> v;
+    v.append(1);
+    v.append(2);
+    v.append(3);
+    for (auto& el : v)
+        EXPECT(is_inline_element(el, v));
+}
+
+BENCHMARK_CASE(vector_append_few_elements)
+{
+    for (int i = 0; i < 1000000; ++i) {
+        Vector<int> ints;
+        ints.append(i);
+        ints.append(i + 1);
+        ints.append(i + 2);
+        EXPECT_EQ(ints.size(), 3u);
+    }
+}
+
+BENCHMARK_CASE(small_vector_append_few_elements)
+{
+    for (int i = 0; i < 1000000; ++i) {
+        SmallVector<int> ints;
+        ints.append(i);
+        ints.append(i + 1);
+        ints.append(i + 2);
+        EXPECT_EQ(ints.size(), 3u);
+    }
+}
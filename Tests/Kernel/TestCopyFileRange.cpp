@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteBuffer.h>
+#include <AK/DeprecatedString.h>
+#include <LibCore/System.h>
+#include <LibTest/TestCase.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+static int create_file_with_contents(ReadonlyBytes contents)
+{
+    char pattern[] = "/tmp/copy_file_range.XXXXXX";
+    auto fd = MUST(Core::System::mkstemp(pattern));
+    MUST(Core::System::unlink({ pattern, sizeof(pattern) - 1 }));
+    EXPECT_EQ(MUST(Core::System::write(fd, contents)), static_cast<ssize_t>(contents.size()));
+    MUST(Core::System::lseek(fd, 0, SEEK_SET));
+    return fd;
+}
+
+static DeprecatedString file_contents(int fd)
+{
+    ByteBuffer contents;
+    u8 buffer[4096];
+    off_t offset = 0;
+    while (true) {
+        auto nread = pread(fd, buffer, sizeof(buffer), offset);
+        EXPECT(nread >= 0);
+        if (nread <= 0)
+            return DeprecatedString::copy(contents);
+        contents.append(buffer, nread);
+        offset += nread;
+    }
+}
+
+TEST_CASE(copy_file_range_uses_and_updates_file_offsets)
+{
+    auto in_fd = create_file_with_contents("Hello friends!"sv.bytes());
+    auto out_fd = create_file_with_contents("Well, "sv.bytes());
+
+    MUST(Core::System::lseek(in_fd, 6, SEEK_SET));
+    MUST(Core::System::lseek(out_fd, 6, SEEK_SET));
+    EXPECT_EQ(MUST(Core::System::copy_file_range(in_fd, nullptr, out_fd, nullptr, 7)), 7u);
+    EXPECT_EQ(MUST(Core::System::lseek(in_fd, 0, SEEK_CUR)), 13);
+    EXPECT_EQ(MUST(Core::System::lseek(out_fd, 0, SEEK_CUR)), 13);
+    EXPECT_EQ(file_contents(out_fd), "Well, friends"sv);
+
+    MUST(Core::System::close(in_fd));
+    MUST(Core::System::close(out_fd));
+}
+
+TEST_CASE(copy_file_range_with_offsets_leaves_file_offsets_alone)
+{
+    auto in_fd = create_file_with_contents("Hello friends!"sv.bytes());
+    auto out_fd = create_file_with_contents("Hi "sv.bytes());
+
+    off_t in_offset = 6;
+    off_t out_offset = 3;
+    EXPECT_EQ(MUST(Core::System::copy_file_range(in_fd, &in_offset, out_fd, &out_offset, 8)), 8u);
+    EXPECT_EQ(in_offset, 14);
+    EXPECT_EQ(out_offset, 11);
+    EXPECT_EQ(MUST(Core::System::lseek(in_fd, 0, SEEK_CUR)), 0);
+    EXPECT_EQ(MUST(Core::System::lseek(out_fd, 0, SEEK_CUR)), 0);
+    EXPECT_EQ(file_contents(out_fd), "Hi friends!"sv);
+
+    MUST(Core::System::close(in_fd));
+    MUST(Core::System::close(out_fd));
+}
+
+TEST_CASE(copy_file_range_is_short_at_end_of_file)
+{
+    auto in_fd = create_file_with_contents("Hello friends!"sv.bytes());
+    auto out_fd = create_file_with_contents({});
+
+    off_t in_offset = 10;
+    EXPECT_EQ(MUST(Core::System::copy_file_range(in_fd, &in_offset, out_fd, nullptr, 100)), 4u);
+    EXPECT_EQ(in_offset, 14);
+    EXPECT_EQ(MUST(Core::System::lseek(out_fd, 0, SEEK_CUR)), 4);
+
+    // Nothing is left to copy, and nothing moves.
+    EXPECT_EQ(MUST(Core::System::copy_file_range(in_fd, &in_offset, out_fd, nullptr, 100)), 0u);
+    EXPECT_EQ(in_offset, 14);
+    in_offset = 100;
+    EXPECT_EQ(MUST(Core::System::copy_file_range(in_fd, &in_offset, out_fd, nullptr, 100)), 0u);
+    EXPECT_EQ(in_offset, 100);
+    EXPECT_EQ(MUST(Core::System::lseek(out_fd, 0, SEEK_CUR)), 4);
+    EXPECT_EQ(file_contents(out_fd), "nds!"sv);
+
+    // Copying nothing always works.
+    EXPECT_EQ(MUST(Core::System::copy_file_range(in_fd, nullptr, out_fd, nullptr, 0)), 0u);
+
+    MUST(Core::System::close(in_fd));
+    MUST(Core::System::close(out_fd));
+}
+
+TEST_CASE(copy_file_range_copies_more_than_one_chunk)
+{
+    auto contents = MUST(ByteBuffer::create_uninitialized(1 * MiB + 123));
+    for (size_t i = 0; i < contents.size(); ++i)
+        contents[i] = static_cast<u8>(i * 7);
+    auto in_fd = create_file_with_contents(contents);
+    auto out_fd = create_file_with_contents({});
+
+    size_t total_copied = 0;
+    while (total_copied < contents.size()) {
+        auto ncopied = MUST(Core::System::copy_file_range(in_fd, nullptr, out_fd, nullptr, contents.size()));
+        EXPECT(ncopied > 0);
+        total_copied += ncopied;
+    }
+    EXPECT_EQ(total_copied, contents.size());
+    EXPECT(file_contents(out_fd).bytes() == contents.bytes());
+
+    MUST(Core::System::close(in_fd));
+    MUST(Core::System::close(out_fd));
+}
+
+TEST_CASE(copy_file_range_within_one_file)
+{
+    auto fd = create_file_with_contents("abcdefgh"sv.bytes());
+
+    off_t in_offset = 0;
+    off_t out_offset = 4;
+    EXPECT_EQ(MUST(Core::System::copy_file_range(fd, &in_offset, fd, &out_offset, 4)), 4u);
+    EXPECT_EQ(file_contents(fd), "abcdabcd"sv);
+
+    // The ranges may not overlap.
+    in_offset = 0;
+    out_offset = 2;
+    auto result = Core::System::copy_file_range(fd, &in_offset, fd, &out_offset, 4);
+    EXPECT(result.is_error());
+    EXPECT_EQ(result.error().code(), EINVAL);
+
+    MUST(Core::System::close(fd));
+}
+
+TEST_CASE(copy_file_range_error_cases)
+{
+    char pattern[] = "/tmp/copy_file_range.XXXXXX";
+    auto fd = MUST(Core::System::mkstemp(pattern));
+    StringView path { pattern, sizeof(pattern) - 1 };
+    EXPECT_EQ(MUST(Core::System::write(fd, "Hello friends!"sv.bytes())), 14);
+    auto read_only_fd = MUST(Core::System::open(path, O_RDONLY));
+    auto write_only_fd = MUST(Core::System::open(path, O_WRONLY));
+    auto append_fd = MUST(Core::System::open(path, O_WRONLY | O_APPEND));
+    MUST(Core::System::unlink(path));
+
+    auto out_fd = create_file_with_contents({});
+    auto pipefds = MUST(Core::System::pipe2(0));
+    auto directory_fd = MUST(Core::System::open("/tmp"sv, O_RDONLY | O_DIRECTORY));
+
+    auto expect_error = [](int in_fd, off_t* in_offset, int out_fd, off_t* out_offset, int error) {
+        auto result = Core::System::copy_file_range(in_fd, in_offset, out_fd, out_offset, 1);
+        EXPECT(result.is_error());
+        EXPECT_EQ(result.error().code(), error);
+    };
+
+    // The input has to be readable, and the output writable without O_APPEND.
+    expect_error(write_only_fd, nullptr, out_fd, nullptr, EBADF);
+    expect_error(fd, nullptr, read_only_fd, nullptr, EBADF);
+    expect_error(fd, nullptr, append_fd, nullptr, EBADF);
+    expect_error(-1, nullptr, out_fd, nullptr, EBADF);
+    expect_error(fd, nullptr, -1, nullptr, EBADF);
+
+    // Both ends have to be regular files.
+    expect_error(pipefds[0], nullptr, out_fd, nullptr, EINVAL);
+    expect_error(fd, nullptr, pipefds[1], nullptr, EINVAL);
+    expect_error(directory_fd, nullptr, out_fd, nullptr, EISDIR);
+
+    off_t negative_offset = -1;
+    expect_error(fd, &negative_offset, out_fd, nullptr, EINVAL);
+    expect_error(fd, nullptr, out_fd, &negative_offset, EINVAL);
+
+    errno = 0;
+    EXPECT_EQ(copy_file_range(fd, nullptr, out_fd, nullptr, 1, 1), -1);
+    EXPECT_EQ(errno, EINVAL);
+
+    // Nothing was copied by any of the failed calls.
+    EXPECT_EQ(MUST(Core::System::lseek(out_fd, 0, SEEK_END)), 0);
+
+    MUST(Core::System::close(fd));
+    MUST(Core::System::close(read_only_fd));
+    MUST(Core::System::close(write_only_fd));
+    MUST(Core::System::close(append_fd));
+    MUST(Core::System::close(out_fd));
+    MUST(Core::System::close(pipefds[0]));
+    MUST(Core::System::close(pipefds[1]));
+    MUST(Core::System::close(directory_fd));
+}
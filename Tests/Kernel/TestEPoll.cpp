@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/System.h>
+#include <LibTest/TestCase.h>
+#include <errno.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+static int add_interest(int epfd, int fd, u32 events, u64 data)
+{
+    epoll_event event {};
+    event.events = events;
+    event.data.u64 = data;
+    return epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &event);
+}
+
+TEST_CASE(epoll_create_rejects_invalid_arguments)
+{
+    errno = 0;
+    EXPECT_EQ(epoll_create(0), -1);
+    EXPECT_EQ(errno, EINVAL);
+
+    errno = 0;
+    EXPECT_EQ(epoll_create1(~EPOLL_CLOEXEC), -1);
+    EXPECT_EQ(errno, EINVAL);
+
+    auto epfd = epoll_create1(EPOLL_CLOEXEC);
+    EXPECT(epfd >= 0);
+    EXPECT(MUST(Core::System::fcntl(epfd, F_GETFD)) & FD_CLOEXEC);
+    MUST(Core::System::close(epfd));
+}
+
+TEST_CASE(epoll_wait_reports_readiness_after_write)
+{
+    auto epfd = epoll_create1(0);
+    EXPECT(epfd >= 0);
+    auto pipefds = MUST(Core::System::pipe2(0));
+
+    EXPECT_EQ(add_interest(epfd, pipefds[0], EPOLLIN, 42), 0);
+
+    epoll_event events[4] {};
+    EXPECT_EQ(epoll_wait(epfd, events, 4, 0), 0);
+
+    EXPECT_EQ(MUST(Core::System::write(pipefds[1], "x"sv.bytes())), 1);
+    EXPECT_EQ(epoll_wait(epfd, events, 4, 1000), 1);
+    EXPECT(events[0].events & EPOLLIN);
+    EXPECT_EQ(events[0].data.u64, 42u);
+
+    // Readiness is level-triggered, so it is reported until the data has been read.
+    EXPECT_EQ(epoll_wait(epfd, events, 4, 0), 1);
+    char buffer;
+    EXPECT_EQ(MUST(Core::System::read(pipefds[0], { &buffer, 1 })), 1);
+    EXPECT_EQ(epoll_wait(epfd, events, 4, 0), 0);
+
+    MUST(Core::System::close(pipefds[0]));
+    MUST(Core::System::close(pipefds[1]));
+    MUST(Core::System::close(epfd));
+}
+
+TEST_CASE(epoll_wait_reports_every_ready_interest)
+{
+    auto epfd = epoll_create1(0);
+    EXPECT(epfd >= 0);
+    auto pipefds = MUST(Core::System::pipe2(0));
+
+    EXPECT_EQ(add_interest(epfd, pipefds[0], EPOLLIN, 1), 0);
+    EXPECT_EQ(add_interest(epfd, pipefds[1], EPOLLOUT, 2), 0);
+    EXPECT_EQ(MUST(Core::System::write(pipefds[1], "x"sv.bytes())), 1);
+
+    epoll_event events[4] {};
+    EXPECT_EQ(epoll_wait(epfd, events, 4, 0), 2);
+    EXPECT_EQ(events[0].data.u64 + events[1].data.u64, 3u);
+
+    // No more than maxevents are returned.
+    EXPECT_EQ(epoll_wait(epfd, events, 1, 0), 1);
+
+    MUST(Core::System::close(pipefds[0]));
+    MUST(Core::System::close(pipefds[1]));
+    MUST(Core::System::close(epfd));
+}
+
+TEST_CASE(epoll_ctl_modify_and_delete)
+{
+    auto epfd = epoll_create1(0);
+    EXPECT(epfd >= 0);
+    auto pipefds = MUST(Core::System::pipe2(0));
+
+    EXPECT_EQ(add_interest(epfd, pipefds[0], EPOLLIN, 1), 0);
+    EXPECT_EQ(MUST(Core::System::write(pipefds[1], "x"sv.bytes())), 1);
+
+    epoll_event events[4] {};
+    EXPECT_EQ(epoll_wait(epfd, events, 4, 0), 1);
+
+    // The read end of a pipe never becomes writable.
+    epoll_event event {};
+    event.events = EPOLLOUT;
+    event.data.u64 = 1;
+    EXPECT_EQ(epoll_ctl(epfd, EPOLL_CTL_MOD, pipefds[0], &event), 0);
+    EXPECT_EQ(epoll_wait(epfd, events, 4, 0), 0);
+
+    event.events = EPOLLIN;
+    event.data.u64 = 7;
+    EXPECT_EQ(epoll_ctl(epfd, EPOLL_CTL_MOD, pipefds[0], &event), 0);
+    EXPECT_EQ(epoll_wait(epfd, events, 4, 0), 1);
+    EXPECT_EQ(events[0].data.u64, 7u);
+
+    EXPECT_EQ(epoll_ctl(epfd, EPOLL_CTL_DEL, pipefds[0], nullptr), 0);
+    EXPECT_EQ(epoll_wait(epfd, events, 4, 0), 0);
+
+    MUST(Core::System::close(pipefds[0]));
+    MUST(Core::System::close(pipefds[1]));
+    MUST(Core::System::close(epfd));
+}
+
+TEST_CASE(epoll_drops_closed_descriptors)
+{
+    auto epfd = epoll_create1(0);
+    EXPECT(epfd >= 0);
+    auto pipefds = MUST(Core::System::pipe2(0));
+
+    EXPECT_EQ(add_interest(epfd, pipefds[0], EPOLLIN, 1), 0);
+    EXPECT_EQ(MUST(Core::System::write(pipefds[1], "x"sv.bytes())), 1);
+    MUST(Core::System::close(pipefds[0]));
+
+    epoll_event events[4] {};
+    EXPECT_EQ(epoll_wait(epfd, events, 4, 0), 0);
+
+    // The closed descriptor has left the interest set.
+    errno = 0;
+    EXPECT_EQ(epoll_ctl(epfd, EPOLL_CTL_DEL, pipefds[0], nullptr), -1);
+    EXPECT_EQ(errno, ENOENT);
+
+    MUST(Core::System::close(pipefds[1]));
+    MUST(Core::System::close(epfd));
+}
+
+TEST_CASE(epoll_error_cases)
+{
+    auto epfd = epoll_create1(0);
+    EXPECT(epfd >= 0);
+    auto pipefds = MUST(Core::System::pipe2(0));
+    epoll_event event {};
+    event.events = EPOLLIN;
+
+    auto expect_ctl_error = [&](int on_epfd, int op, int fd, int error) {
+        errno = 0;
+        EXPECT_EQ(epoll_ctl(on_epfd, op, fd, &event), -1);
+        EXPECT_EQ(errno, error);
+    };
+
+    EXPECT_EQ(epoll_ctl(epfd, EPOLL_CTL_ADD, pipefds[0], &event), 0);
+    expect_ctl_error(epfd, EPOLL_CTL_ADD, pipefds[0], EEXIST);
+    expect_ctl_error(epfd, EPOLL_CTL_MOD, pipefds[1], ENOENT);
+    expect_ctl_error(epfd, EPOLL_CTL_DEL, pipefds[1], ENOENT);
+    expect_ctl_error(epfd, 1234, pipefds[1], EINVAL);
+    expect_ctl_error(epfd, EPOLL_CTL_ADD, -1, EBADF);
+    // Only epoll descriptors have an interest set, and they can't be watched themselves.
+    expect_ctl_error(pipefds[0], EPOLL_CTL_ADD, pipefds[1], EINVAL);
+    expect_ctl_error(epfd, EPOLL_CTL_ADD, epfd, EINVAL);
+
+    epoll_event events[1] {};
+    errno = 0;
+    EXPECT_EQ(epoll_wait(epfd, events, 0, 0), -1);
+    EXPECT_EQ(errno, EINVAL);
+
+    errno = 0;
+    EXPECT_EQ(epoll_wait(pipefds[0], events, 1, 0), -1);
+    EXPECT_EQ(errno, EINVAL);
+
+    MUST(Core::System::close(pipefds[0]));
+    MUST(Core::System::close(pipefds[1]));
+    MUST(Core::System::close(epfd));
+}
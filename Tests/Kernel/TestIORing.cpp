@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/IORing.h>
+#include <LibCore/System.h>
+#include <LibTest/TestCase.h>
+#include <errno.h>
+#include <serenity.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+static IORingSubmission submission(IORingOpcode opcode, int fd, u64 user_data, void* buffer = nullptr, size_t length = 0, i64 offset = -1)
+{
+    IORingSubmission submission {};
+    submission.opcode = opcode;
+    submission.fd = fd;
+    submission.user_data = user_data;
+    submission.buffer = reinterpret_cast<FlatPtr>(buffer);
+    submission.length = length;
+    submission.offset = offset;
+    return submission;
+}
+
+TEST_CASE(create_io_ring_rejects_invalid_arguments)
+{
+    auto expect_einval = [](unsigned submission_entry_count, unsigned flags) {
+        errno = 0;
+        EXPECT_EQ(create_io_ring(submission_entry_count, flags), -1);
+        EXPECT_EQ(errno, EINVAL);
+    };
+    expect_einval(0, 0);
+    expect_einval(3, 0);
+    expect_einval(io_ring_max_entries * 2, 0);
+    expect_einval(4, 0x80);
+}
+
+TEST_CASE(io_ring_enter_needs_an_io_ring)
+{
+    auto pipefds = MUST(Core::System::pipe2(0));
+    errno = 0;
+    EXPECT_EQ(io_ring_enter(pipefds[0], 1), -1);
+    EXPECT_EQ(errno, EINVAL);
+    MUST(Core::System::close(pipefds[0]));
+    MUST(Core::System::close(pipefds[1]));
+
+    errno = 0;
+    EXPECT_EQ(io_ring_enter(-1, 1), -1);
+    EXPECT_EQ(errno, EBADF);
+}
+
+TEST_CASE(completions_arrive_in_submission_order)
+{
+    auto ring = MUST(Core::IORing::create(8));
+    for (u64 i = 1; i <= 3; ++i)
+        EXPECT(ring->try_queue(submission(IORingOpcode::Nop, -1, i)));
+    EXPECT_EQ(ring->queued_submission_count(), 3u);
+
+    EXPECT_EQ(MUST(ring->submit()), 3u);
+    EXPECT_EQ(ring->queued_submission_count(), 0u);
+
+    for (u64 i = 1; i <= 3; ++i) {
+        auto completion = ring->pop_completion();
+        EXPECT(completion.has_value());
+        EXPECT_EQ(completion->user_data, i);
+        EXPECT_EQ(completion->result, 0);
+    }
+    EXPECT(!ring->pop_completion().has_value());
+}
+
+TEST_CASE(write_and_read_a_file)
+{
+    char pattern[] = "/tmp/io_ring.XXXXXX";
+    auto fd = MUST(Core::System::mkstemp(pattern));
+    MUST(Core::System::unlink({ pattern, sizeof(pattern) - 1 }));
+
+    auto ring = MUST(Core::IORing::create(4));
+
+    char data[] = "Hello friends!";
+    EXPECT(ring->try_queue(submission(IORingOpcode::Write, fd, 1, data, 14, 0)));
+    EXPECT(ring->try_queue(submission(IORingOpcode::Fsync, fd, 2)));
+    EXPECT_EQ(MUST(ring->submit()), 2u);
+    EXPECT_EQ(ring->pop_completion()->result, 14);
+    EXPECT_EQ(ring->pop_completion()->result, 0);
+    // Explicit offsets leave the file offset alone.
+    EXPECT_EQ(MUST(Core::System::lseek(fd, 0, SEEK_CUR)), 0);
+
+    char buffer[16] {};
+    EXPECT(ring->try_queue(submission(IORingOpcode::Read, fd, 3, buffer, 7, 6)));
+    // Reading at the end of the file completes with 0.
+    EXPECT(ring->try_queue(submission(IORingOpcode::Read, fd, 4, buffer + 8, 8, 14)));
+    EXPECT_EQ(MUST(ring->submit()), 2u);
+    EXPECT_EQ(ring->pop_completion()->result, 7);
+    EXPECT_EQ(ring->pop_completion()->result, 0);
+    EXPECT_EQ(StringView(buffer, 7), "friends"sv);
+
+    MUST(Core::System::close(fd));
+}
+
+TEST_CASE(failed_submissions_complete_with_negated_errno)
+{
+    auto ring = MUST(Core::IORing::create(8));
+    auto pipefds = MUST(Core::System::pipe2(0));
+    char buffer[4] {};
+
+    // Nothing to read yet, and operations that would block don't wait.
+    EXPECT(ring->try_queue(submission(IORingOpcode::Read, pipefds[0], 1, buffer, sizeof(buffer))));
+    // Pipes have no file offset.
+    EXPECT(ring->try_queue(submission(IORingOpcode::Read, pipefds[0], 2, buffer, sizeof(buffer), 0)));
+    EXPECT(ring->try_queue(submission(IORingOpcode::Read, pipefds[1], 3, buffer, sizeof(buffer))));
+    EXPECT(ring->try_queue(submission(IORingOpcode::Write, pipefds[0], 4, buffer, sizeof(buffer))));
+    EXPECT(ring->try_queue(submission(IORingOpcode::Read, -1, 5, buffer, sizeof(buffer))));
+    EXPECT(ring->try_queue(submission(IORingOpcode::Accept, pipefds[0], 6)));
+    EXPECT_EQ(MUST(ring->submit()), 6u);
+
+    i64 expected_results[] = { -EAGAIN, -EINVAL, -EBADF, -EBADF, -EBADF, -ENOTSOCK };
+    for (u64 i = 0; i < array_size(expected_results); ++i) {
+        auto completion = ring->pop_completion();
+        EXPECT(completion.has_value());
+        EXPECT_EQ(completion->user_data, i + 1);
+        EXPECT_EQ(completion->result, expected_results[i]);
+    }
+
+    // A failed submission doesn't stop the ones after it.
+    EXPECT(ring->try_queue(submission(IORingOpcode::Write, pipefds[0], 7, buffer, sizeof(buffer))));
+    EXPECT(ring->try_queue(submission(IORingOpcode::Write, pipefds[1], 8, const_cast<char*>("ping"), 4)));
+    EXPECT(ring->try_queue(submission(IORingOpcode::Read, pipefds[0], 9, buffer, sizeof(buffer))));
+    EXPECT_EQ(MUST(ring->submit()), 3u);
+    EXPECT_EQ(ring->pop_completion()->result, -EBADF);
+    EXPECT_EQ(ring->pop_completion()->result, 4);
+    EXPECT_EQ(ring->pop_completion()->result, 4);
+    EXPECT_EQ(StringView(buffer, 4), "ping"sv);
+
+    MUST(Core::System::close(pipefds[0]));
+    MUST(Core::System::close(pipefds[1]));
+}
+
+TEST_CASE(submissions_wait_for_room_in_the_completion_queue)
+{
+    // Two submission entries make for four completion entries.
+    auto ring = MUST(Core::IORing::create(2));
+
+    for (u64 batch = 0; batch < 2; ++batch) {
+        EXPECT(ring->try_queue(submission(IORingOpcode::Nop, -1, batch)));
+        EXPECT(ring->try_queue(submission(IORingOpcode::Nop, -1, batch)));
+        EXPECT(!ring->try_queue(submission(IORingOpcode::Nop, -1, batch)));
+        EXPECT_EQ(MUST(ring->submit()), 2u);
+    }
+
+    EXPECT(ring->try_queue(submission(IORingOpcode::Nop, -1, 2)));
+    EXPECT_EQ(MUST(ring->submit()), 0u);
+    EXPECT_EQ(ring->queued_submission_count(), 1u);
+
+    EXPECT(ring->pop_completion().has_value());
+    EXPECT_EQ(MUST(ring->submit()), 1u);
+    EXPECT_EQ(ring->queued_submission_count(), 0u);
+}
+
+TEST_CASE(io_ring_enter_rejects_corrupted_indices)
+{
+    constexpr u32 submission_entry_count = 4;
+    auto fd = create_io_ring(submission_entry_count, 0);
+    EXPECT(fd >= 0);
+
+    auto size = io_ring_size(submission_entry_count);
+    // The ring can only be shared.
+    EXPECT(Core::System::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0).is_error());
+
+    auto* mapping = MUST(Core::System::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+    auto& header = *static_cast<IORingHeader*>(mapping);
+    EXPECT_EQ(header.submissions.mask, submission_entry_count - 1);
+    EXPECT_EQ(header.completions.mask, io_ring_completion_entry_count(submission_entry_count) - 1);
+
+    // More submissions than there are entries.
+    header.submissions.tail = header.submissions.head + submission_entry_count + 1;
+    errno = 0;
+    EXPECT_EQ(io_ring_enter(fd, 1), -1);
+    EXPECT_EQ(errno, EINVAL);
+
+    MUST(Core::System::munmap(mapping, size));
+    MUST(Core::System::close(fd));
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteBuffer.h>
+#include <LibCore/System.h>
+#include <LibTest/TestCase.h>
+#include <fcntl.h>
+#include <limits.h>
+
+static ssize_t fill_pipe(int write_fd)
+{
+    auto data = MUST(ByteBuffer::create_zeroed(2 * MiB));
+    ssize_t total = 0;
+    while (true) {
+        auto result = Core::System::write(write_fd, data);
+        if (result.is_error()) {
+            EXPECT_EQ(result.error().code(), EAGAIN);
+            return total;
+        }
+        total += result.value();
+    }
+}
+
+TEST_CASE(pipe_size_can_be_queried_from_either_end)
+{
+    auto pipefds = MUST(Core::System::pipe2(0));
+    EXPECT_EQ(MUST(Core::System::fcntl(pipefds[0], F_GETPIPE_SZ)), static_cast<int>(64 * KiB));
+    EXPECT_EQ(MUST(Core::System::fcntl(pipefds[1], F_GETPIPE_SZ)), static_cast<int>(64 * KiB));
+
+    EXPECT_EQ(MUST(Core::System::fcntl(pipefds[1], F_SETPIPE_SZ, 128 * KiB)), static_cast<int>(128 * KiB));
+    EXPECT_EQ(MUST(Core::System::fcntl(pipefds[0], F_GETPIPE_SZ)), static_cast<int>(128 * KiB));
+
+    MUST(Core::System::close(pipefds[0]));
+    MUST(Core::System::close(pipefds[1]));
+}
+
+TEST_CASE(pipe_buffer_grows_on_demand)
+{
+    auto pipefds = MUST(Core::System::pipe2(O_NONBLOCK));
+
+    auto data = MUST(ByteBuffer::create_zeroed(100 * KiB));
+    EXPECT_EQ(MUST(Core::System::write(pipefds[1], data)), static_cast<ssize_t>(data.size()));
+    EXPECT_EQ(MUST(Core::System::fcntl(pipefds[0], F_GETPIPE_SZ)), static_cast<int>(128 * KiB));
+
+    MUST(Core::System::close(pipefds[0]));
+    MUST(Core::System::close(pipefds[1]));
+}
+
+TEST_CASE(set_pipe_size_fixes_the_capacity)
+{
+    auto pipefds = MUST(Core::System::pipe2(O_NONBLOCK));
+
+    EXPECT_EQ(MUST(Core::System::fcntl(pipefds[1], F_SETPIPE_SZ, 8 * KiB)), static_cast<int>(8 * KiB));
+    // The buffer no longer grows, so a write only takes as much as fits.
+    auto data = MUST(ByteBuffer::create_zeroed(64 * KiB));
+    EXPECT_EQ(MUST(Core::System::write(pipefds[1], data)), static_cast<ssize_t>(8 * KiB));
+    EXPECT_EQ(MUST(Core::System::fcntl(pipefds[1], F_GETPIPE_SZ)), static_cast<int>(8 * KiB));
+
+    auto result = Core::System::write(pipefds[1], data);
+    EXPECT(result.is_error());
+    EXPECT_EQ(result.error().code(), EAGAIN);
+
+    MUST(Core::System::close(pipefds[0]));
+    MUST(Core::System::close(pipefds[1]));
+}
+
+TEST_CASE(set_pipe_size_clamps_to_the_supported_range)
+{
+    auto pipefds = MUST(Core::System::pipe2(O_NONBLOCK));
+
+    EXPECT_EQ(MUST(Core::System::fcntl(pipefds[1], F_SETPIPE_SZ, static_cast<size_t>(0))), PAGE_SIZE);
+    EXPECT_EQ(MUST(Core::System::fcntl(pipefds[1], F_SETPIPE_SZ, static_cast<size_t>(1))), PAGE_SIZE);
+    EXPECT_EQ(fill_pipe(pipefds[1]), PAGE_SIZE);
+
+    MUST(Core::System::close(pipefds[0]));
+    MUST(Core::System::close(pipefds[1]));
+
+    pipefds = MUST(Core::System::pipe2(O_NONBLOCK));
+    EXPECT_EQ(MUST(Core::System::fcntl(pipefds[1], F_SETPIPE_SZ, 16 * MiB)), static_cast<int>(1 * MiB));
+    EXPECT_EQ(fill_pipe(pipefds[1]), static_cast<ssize_t>(1 * MiB));
+
+    MUST(Core::System::close(pipefds[0]));
+    MUST(Core::System::close(pipefds[1]));
+}
+
+TEST_CASE(shrinking_below_buffered_data_keeps_the_data)
+{
+    auto pipefds = MUST(Core::System::pipe2(O_NONBLOCK));
+
+    auto data = MUST(ByteBuffer::create_uninitialized(10000));
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = static_cast<u8>(i);
+    EXPECT_EQ(MUST(Core::System::write(pipefds[1], data)), 10000);
+
+    // The buffer can't get smaller than what is already in it.
+    EXPECT_EQ(MUST(Core::System::fcntl(pipefds[1], F_SETPIPE_SZ, static_cast<size_t>(PAGE_SIZE))), 10000);
+    EXPECT_EQ(MUST(Core::System::fcntl(pipefds[0], F_GETPIPE_SZ)), 10000);
+
+    auto buffer = MUST(ByteBuffer::create_zeroed(data.size()));
+    EXPECT_EQ(MUST(Core::System::read(pipefds[0], buffer)), 10000);
+    EXPECT_EQ(buffer, data);
+
+    // Once drained, the buffer can shrink.
+    EXPECT_EQ(MUST(Core::System::fcntl(pipefds[1], F_SETPIPE_SZ, static_cast<size_t>(PAGE_SIZE))), PAGE_SIZE);
+    EXPECT_EQ(fill_pipe(pipefds[1]), PAGE_SIZE);
+
+    MUST(Core::System::close(pipefds[0]));
+    MUST(Core::System::close(pipefds[1]));
+}
+
+TEST_CASE(pipe_size_needs_a_pipe)
+{
+    char pattern[] = "/tmp/pipe_size.XXXXXX";
+    auto fd = MUST(Core::System::mkstemp(pattern));
+    MUST(Core::System::unlink({ pattern, sizeof(pattern) - 1 }));
+
+    auto result = Core::System::fcntl(fd, F_GETPIPE_SZ);
+    EXPECT(result.is_error());
+    EXPECT_EQ(result.error().code(), EBADF);
+
+    result = Core::System::fcntl(fd, F_SETPIPE_SZ, 8 * KiB);
+    EXPECT(result.is_error());
+    EXPECT_EQ(result.error().code(), EBADF);
+
+    MUST(Core::System::close(fd));
+
+    result = Core::System::fcntl(-1, F_GETPIPE_SZ);
+    EXPECT(result.is_error());
+    EXPECT_EQ(result.error().code(), EBADF);
+}
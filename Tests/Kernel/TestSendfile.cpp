@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteBuffer.h>
+#include <LibCore/System.h>
+#include <LibTest/TestCase.h>
+#include <signal.h>
+
+static int create_file_with_contents(ReadonlyBytes contents)
+{
+    char pattern[] = "/tmp/sendfile.XXXXXX";
+    auto fd = MUST(Core::System::mkstemp(pattern));
+    MUST(Core::System::unlink({ pattern, sizeof(pattern) - 1 }));
+    EXPECT_EQ(MUST(Core::System::write(fd, contents)), static_cast<ssize_t>(contents.size()));
+    MUST(Core::System::lseek(fd, 0, SEEK_SET));
+    return fd;
+}
+
+TEST_CASE(sendfile_copies_from_current_offset)
+{
+    auto in_fd = create_file_with_contents("Hello friends!"sv.bytes());
+    auto pipefds = MUST(Core::System::pipe2(0));
+
+    MUST(Core::System::lseek(in_fd, 6, SEEK_SET));
+    EXPECT_EQ(MUST(Core::System::sendfile(pipefds[1], in_fd, nullptr, 7)), 7u);
+    EXPECT_EQ(MUST(Core::System::lseek(in_fd, 0, SEEK_CUR)), 13);
+
+    char buffer[16] {};
+    EXPECT_EQ(MUST(Core::System::read(pipefds[0], { buffer, sizeof(buffer) })), 7);
+    EXPECT_EQ(StringView(buffer, 7), "friends"sv);
+
+    MUST(Core::System::close(in_fd));
+    MUST(Core::System::close(pipefds[0]));
+    MUST(Core::System::close(pipefds[1]));
+}
+
+TEST_CASE(sendfile_with_offset_leaves_file_offset_alone)
+{
+    auto in_fd = create_file_with_contents("Hello friends!"sv.bytes());
+    auto pipefds = MUST(Core::System::pipe2(0));
+
+    off_t offset = 6;
+    EXPECT_EQ(MUST(Core::System::sendfile(pipefds[1], in_fd, &offset, 7)), 7u);
+    EXPECT_EQ(offset, 13);
+    EXPECT_EQ(MUST(Core::System::lseek(in_fd, 0, SEEK_CUR)), 0);
+
+    char buffer[16] {};
+    EXPECT_EQ(MUST(Core::System::read(pipefds[0], { buffer, sizeof(buffer) })), 7);
+    EXPECT_EQ(StringView(buffer, 7), "friends"sv);
+
+    MUST(Core::System::close(in_fd));
+    MUST(Core::System::close(pipefds[0]));
+    MUST(Core::System::close(pipefds[1]));
+}
+
+TEST_CASE(sendfile_stops_at_end_of_file)
+{
+    auto in_fd = create_file_with_contents("Hello friends!"sv.bytes());
+    auto pipefds = MUST(Core::System::pipe2(0));
+
+    off_t offset = 10;
+    EXPECT_EQ(MUST(Core::System::sendfile(pipefds[1], in_fd, &offset, 100)), 4u);
+    EXPECT_EQ(offset, 14);
+    EXPECT_EQ(MUST(Core::System::sendfile(pipefds[1], in_fd, &offset, 100)), 0u);
+    EXPECT_EQ(offset, 14);
+
+    MUST(Core::System::close(in_fd));
+    MUST(Core::System::close(pipefds[0]));
+    MUST(Core::System::close(pipefds[1]));
+}
+
+TEST_CASE(sendfile_gives_back_what_a_full_pipe_did_not_take)
+{
+    auto contents = MUST(ByteBuffer::create_zeroed(1 * MiB));
+    auto in_fd = create_file_with_contents(contents);
+    auto pipefds = MUST(Core::System::pipe2(O_NONBLOCK));
+
+    auto nsent = MUST(Core::System::sendfile(pipefds[1], in_fd, nullptr, contents.size()));
+    EXPECT(nsent > 0);
+    EXPECT(nsent < contents.size());
+    EXPECT_EQ(MUST(Core::System::lseek(in_fd, 0, SEEK_CUR)), static_cast<off_t>(nsent));
+
+    MUST(Core::System::close(in_fd));
+    MUST(Core::System::close(pipefds[0]));
+    MUST(Core::System::close(pipefds[1]));
+}
+
+TEST_CASE(sendfile_reports_write_error_and_rewinds)
+{
+    MUST(Core::System::signal(SIGPIPE, SIG_IGN));
+
+    auto in_fd = create_file_with_contents("Hello friends!"sv.bytes());
+    auto pipefds = MUST(Core::System::pipe2(0));
+    MUST(Core::System::close(pipefds[0]));
+
+    auto result = Core::System::sendfile(pipefds[1], in_fd, nullptr, 14);
+    EXPECT(result.is_error());
+    EXPECT_EQ(result.error().code(), EPIPE);
+    // Nothing was sent, so nothing was consumed from the input either.
+    EXPECT_EQ(MUST(Core::System::lseek(in_fd, 0, SEEK_CUR)), 0);
+
+    MUST(Core::System::close(in_fd));
+    MUST(Core::System::close(pipefds[1]));
+    MUST(Core::System::signal(SIGPIPE, SIG_DFL));
+}
+
+TEST_CASE(sendfile_error_cases)
+{
+    auto in_fd = create_file_with_contents("Hello friends!"sv.bytes());
+    auto pipefds = MUST(Core::System::pipe2(0));
+
+    {
+        // The input has to be seekable.
+        auto result = Core::System::sendfile(pipefds[1], pipefds[0], nullptr, 1);
+        EXPECT(result.is_error());
+        EXPECT_EQ(result.error().code(), EINVAL);
+    }
+
+    {
+        // The input has to be readable.
+        auto result = Core::System::sendfile(pipefds[1], pipefds[1], nullptr, 1);
+        EXPECT(result.is_error());
+        EXPECT_EQ(result.error().code(), EBADF);
+    }
+
+    {
+        // The output has to be writable.
+        auto result = Core::System::sendfile(pipefds[0], in_fd, nullptr, 1);
+        EXPECT(result.is_error());
+        EXPECT_EQ(result.error().code(), EBADF);
+    }
+
+    {
+        auto directory_fd = MUST(Core::System::open("/tmp"sv, O_RDONLY | O_DIRECTORY));
+        auto result = Core::System::sendfile(pipefds[1], directory_fd, nullptr, 1);
+        EXPECT(result.is_error());
+        EXPECT_EQ(result.error().code(), EISDIR);
+        MUST(Core::System::close(directory_fd));
+    }
+
+    {
+        off_t offset = -1;
+        auto result = Core::System::sendfile(pipefds[1], in_fd, &offset, 1);
+        EXPECT(result.is_error());
+        EXPECT_EQ(result.error().code(), EINVAL);
+    }
+
+    {
+        auto result = Core::System::sendfile(pipefds[1], -1, nullptr, 1);
+        EXPECT(result.is_error());
+        EXPECT_EQ(result.error().code(), EBADF);
+    }
+
+    // Sending nothing always works.
+    EXPECT_EQ(MUST(Core::System::sendfile(pipefds[1], pipefds[0], nullptr, 0)), 0u);
+
+    MUST(Core::System::close(in_fd));
+    MUST(Core::System::close(pipefds[0]));
+    MUST(Core::System::close(pipefds[1]));
+}
@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
 #include <LibTest/TestCase.h>
 #include <errno.h>
 #include <string.h>
@@ -29,3 +30,51 @@ TEST_CASE(strtok_r_delimiters_only)
     // The string to which `saved_str` initially points to shouldn't be modified.
     EXPECT_EQ(strcmp(dummy, "a;"), 0);
 }
+
+static void fill_with_pattern(Bytes bytes)
+{
+    for (size_t i = 0; i < bytes.size(); ++i)
+        bytes[i] = static_cast<u8>(i * 7 + 3);
+}
+
+TEST_CASE(memmove_overlapping)
+{
+    // memcpy() and memmove() pick different strategies depending on the size, so make sure to cover all of them,
+    // in both directions and with all kinds of alignments.
+    Array<u8, 2048> buffer;
+    Array<u8, 2048> expected;
+    for (size_t size = 0; size <= 600; size += (size < 140 ? 1 : 13)) {
+        for (int distance = -70; distance <= 70; ++distance) {
+            for (size_t alignment = 0; alignment < 16; alignment += 5) {
+                size_t source = 700 + alignment;
+                size_t destination = source + distance;
+
+                fill_with_pattern(expected);
+                for (size_t i = 0; i < size; ++i)
+                    expected[destination + i] = static_cast<u8>((source + i) * 7 + 3);
+
+                fill_with_pattern(buffer);
+                EXPECT_EQ(memmove(&buffer[destination], &buffer[source], size), &buffer[destination]);
+                EXPECT(buffer == expected);
+            }
+        }
+    }
+}
+
+TEST_CASE(memcpy_all_sizes)
+{
+    Array<u8, 2048> source;
+    Array<u8, 2048> destination;
+    fill_with_pattern(source);
+    for (size_t size = 0; size <= 1024; ++size) {
+        for (size_t alignment = 0; alignment < 16; alignment += 3) {
+            destination.fill(0);
+            EXPECT_EQ(memcpy(&destination[alignment], &source[16 - alignment], size), &destination[alignment]);
+            EXPECT_EQ(memcmp(&destination[alignment], &source[16 - alignment], size), 0);
+            // Nothing around the copy should have been touched.
+            EXPECT_EQ(destination[alignment + size], 0);
+            if (alignment > 0)
+                EXPECT_EQ(destination[alignment - 1], 0);
+        }
+    }
+}
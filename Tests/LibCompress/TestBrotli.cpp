@@ -6,6 +6,7 @@
 
 #include <LibTest/TestCase.h>
 
+#include <AK/MemoryStream.h>
 #include <LibCompress/Brotli.h>
 #include <LibCore/File.h>
 
@@ -24,10 +25,16 @@ static void run_test(StringView const file_name)
     DeprecatedString path_compressed = DeprecatedString::formatted("{}.br", path);
 
     auto file = MUST(Core::File::open(path_compressed, Core::File::OpenMode::Read));
-    auto brotli_stream = Compress::BrotliDecompressionStream { *file };
-    auto data = MUST(brotli_stream.read_until_eof());
+    auto compressed_data = MUST(file->read_until_eof());
 
+    FixedMemoryStream compressed_stream { compressed_data.bytes() };
+    auto brotli_stream = Compress::BrotliDecompressionStream { compressed_stream };
+    auto data = MUST(brotli_stream.read_until_eof());
     EXPECT_EQ(data, cmp_data);
+
+    // Decompressing into a single buffer doesn't go through the ring buffer, so it has to be tested separately.
+    auto all_data = MUST(Compress::BrotliDecompressionStream::decompress_all(compressed_data));
+    EXPECT_EQ(all_data, cmp_data);
 }
 
 TEST_CASE(brotli_decompress_uncompressed)
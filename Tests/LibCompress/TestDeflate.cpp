@@ -148,6 +148,67 @@ TEST_CASE(deflate_round_trip_compress_large)
     EXPECT(uncompressed.value() == original);
 }
 
+// Text-like data with plenty of repetitions at varying distances, so that the levels actually end up with different results.
+static ByteBuffer generate_compressible_data(size_t size)
+{
+    constexpr Array words { "deflate"sv, "huffman"sv, "symbol"sv, "length"sv, "distance"sv, "block"sv, "window"sv, "literal"sv, " "sv, ", "sv, ".\n"sv };
+    auto data = ByteBuffer::create_uninitialized(size).release_value();
+    size_t offset = 0;
+    while (offset < size) {
+        auto word = words[get_random_uniform(words.size())].bytes();
+        offset += word.copy_trimmed_to(data.bytes().slice(offset));
+    }
+    return data;
+}
+
+TEST_CASE(deflate_round_trip_compression_levels)
+{
+    auto original = generate_compressible_data(Compress::DeflateCompressor::block_size * 3);
+
+    size_t previous_compressed_size = NumericLimits<size_t>::max();
+    for (auto level : { Compress::DeflateCompressor::CompressionLevel::FAST, Compress::DeflateCompressor::CompressionLevel::GOOD, Compress::DeflateCompressor::CompressionLevel::GREAT, Compress::DeflateCompressor::CompressionLevel::BEST }) {
+        auto compressed = Compress::DeflateCompressor::compress_all(original, level);
+        EXPECT(!compressed.is_error());
+        auto uncompressed = Compress::DeflateDecompressor::decompress_all(compressed.value());
+        EXPECT(!uncompressed.is_error());
+        EXPECT(uncompressed.value() == original);
+
+        // Higher levels should never do worse on this kind of data.
+        EXPECT(compressed.value().size() <= previous_compressed_size);
+        previous_compressed_size = compressed.value().size();
+    }
+}
+
+TEST_CASE(deflate_round_trip_concatenated_segments)
+{
+    auto size = Compress::DeflateCompressor::block_size * 3;
+    auto original = ByteBuffer::create_zeroed(size).release_value();
+    fill_with_random(original.data(), Compress::DeflateCompressor::block_size);
+
+    // Segments that are finished with segment_flush() can be concatenated with the final one into a single deflate stream.
+    auto compress_segment = [](ReadonlyBytes segment, bool is_last_segment) {
+        AllocatingMemoryStream output_stream;
+        auto deflate_stream = MUST(Compress::DeflateCompressor::construct(MaybeOwned<Stream>(output_stream), Compress::DeflateCompressor::CompressionLevel::FAST));
+        MUST(deflate_stream->write_entire_buffer(segment));
+        if (is_last_segment)
+            MUST(deflate_stream->final_flush());
+        else
+            MUST(deflate_stream->segment_flush());
+        auto buffer = MUST(ByteBuffer::create_uninitialized(output_stream.used_buffer_size()));
+        MUST(output_stream.read_entire_buffer(buffer));
+        return buffer;
+    };
+
+    ByteBuffer compressed;
+    compressed.append(compress_segment(original.bytes().slice(0, 1000), false));
+    compressed.append(compress_segment(original.bytes().slice(1000, size - 2000), false));
+    compressed.append(compress_segment(original.bytes().slice(size - 1000), true));
+
+    auto uncompressed = Compress::DeflateDecompressor::decompress_all(compressed);
+    EXPECT(!uncompressed.is_error());
+    EXPECT(uncompressed.value() == original);
+}
+
 TEST_CASE(deflate_compress_literals)
 {
     // This byte array is known to not produce any back references with our lz77 implementation even at the highest compression settings
@@ -155,3 +216,30 @@ TEST_CASE(deflate_compress_literals)
     auto compressed = Compress::DeflateCompressor::compress_all(test, Compress::DeflateCompressor::CompressionLevel::GOOD);
     EXPECT(!compressed.is_error());
 }
+
+static void benchmark_compression_level(Compress::DeflateCompressor::CompressionLevel level)
+{
+    auto original = generate_compressible_data(1 * MiB);
+    auto compressed = MUST(Compress::DeflateCompressor::compress_all(original, level));
+    EXPECT(compressed.size() < original.size());
+}
+
+BENCHMARK_CASE(deflate_compress_fast)
+{
+    benchmark_compression_level(Compress::DeflateCompressor::CompressionLevel::FAST);
+}
+
+BENCHMARK_CASE(deflate_compress_good)
+{
+    benchmark_compression_level(Compress::DeflateCompressor::CompressionLevel::GOOD);
+}
+
+BENCHMARK_CASE(deflate_compress_great)
+{
+    benchmark_compression_level(Compress::DeflateCompressor::CompressionLevel::GREAT);
+}
+
+BENCHMARK_CASE(deflate_compress_best)
+{
+    benchmark_compression_level(Compress::DeflateCompressor::CompressionLevel::BEST);
+}
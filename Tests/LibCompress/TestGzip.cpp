@@ -95,3 +95,19 @@ TEST_CASE(gzip_round_trip)
     EXPECT(!uncompressed.is_error());
     EXPECT(uncompressed.value() == original);
 }
+
+TEST_CASE(gzip_round_trip_multiple_segments)
+{
+    // Large inputs are compressed in parallel segments, which still have to end up as a single member with the right checksum.
+    auto size = 3 * MiB + 1234;
+    auto original = ByteBuffer::create_zeroed(size).release_value();
+    fill_with_random(original.data(), 1 * MiB);
+    for (size_t i = 2 * MiB; i < size; ++i)
+        original[i] = static_cast<u8>(i % 251);
+
+    auto compressed = Compress::GzipCompressor::compress_all(original);
+    EXPECT(!compressed.is_error());
+    auto uncompressed = Compress::GzipDecompressor::decompress_all(compressed.value());
+    EXPECT(!uncompressed.is_error());
+    EXPECT(uncompressed.value() == original);
+}
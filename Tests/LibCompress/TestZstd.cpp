@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/AllOf.h>
+#include <AK/MemoryStream.h>
+#include <LibCompress/Zstd.h>
+#include <LibCore/File.h>
+
+static ByteBuffer read_test_file(StringView file_name)
+{
+    // This makes sure that the tests will run both on target and in Lagom.
+#ifdef AK_OS_SERENITY
+    DeprecatedString path = DeprecatedString::formatted("/usr/Tests/LibCompress/zstd-test-files/{}", file_name);
+#else
+    DeprecatedString path = DeprecatedString::formatted("zstd-test-files/{}", file_name);
+#endif
+
+    auto file = MUST(Core::File::open(path, Core::File::OpenMode::Read));
+    return MUST(file->read_until_eof());
+}
+
+static void run_test(StringView compressed_file_name, StringView file_name)
+{
+    auto compressed = read_test_file(compressed_file_name);
+    auto expected = read_test_file(file_name);
+
+    auto decompressed = MUST(Compress::ZstdDecompressor::decompress_all(compressed));
+    EXPECT_EQ(decompressed, expected);
+}
+
+TEST_CASE(zstd_decompress_single_byte)
+{
+    run_test("single-x.txt.zst"sv, "single-x.txt"sv);
+}
+
+TEST_CASE(zstd_decompress_lorem)
+{
+    run_test("lorem.txt.zst"sv, "lorem.txt"sv);
+}
+
+TEST_CASE(zstd_decompress_without_checksum_and_content_size)
+{
+    run_test("transform.txt.zst"sv, "transform.txt"sv);
+}
+
+TEST_CASE(zstd_decompress_html)
+{
+    run_test("happy3rd.html.zst"sv, "happy3rd.html"sv);
+}
+
+TEST_CASE(zstd_decompress_small_window)
+{
+    // With a 1 KiB window, the data is split into many blocks that refer back across the window.
+    run_test("happy3rd.html.small-window.zst"sv, "happy3rd.html"sv);
+}
+
+TEST_CASE(zstd_decompress_multiple_frames)
+{
+    // Two frames with data, separated by a skippable frame and an empty frame.
+    run_test("multiple-frames.txt.zst"sv, "multiple-frames.txt"sv);
+}
+
+TEST_CASE(zstd_decompress_rle)
+{
+    auto compressed = read_test_file("zeros.bin.zst"sv);
+    auto decompressed = MUST(Compress::ZstdDecompressor::decompress_all(compressed));
+    EXPECT_EQ(decompressed.size(), 200000u);
+    EXPECT(all_of(decompressed.bytes(), [](u8 byte) { return byte == 0; }));
+}
+
+TEST_CASE(zstd_decompress_in_small_reads)
+{
+    auto compressed = read_test_file("happy3rd.html.small-window.zst"sv);
+    auto expected = read_test_file("happy3rd.html"sv);
+
+    auto zstd_stream = MUST(Compress::ZstdDecompressor::construct(MUST(try_make<FixedMemoryStream>(compressed.bytes()))));
+    ByteBuffer decompressed;
+    Array<u8, 77> buffer;
+    while (!zstd_stream->is_eof()) {
+        auto bytes = MUST(zstd_stream->read(buffer));
+        decompressed.append(bytes);
+    }
+    EXPECT_EQ(decompressed, expected);
+}
+
+TEST_CASE(zstd_checksum_mismatch)
+{
+    auto compressed = read_test_file("lorem.txt.zst"sv);
+    compressed[compressed.size() - 1] ^= 1;
+    EXPECT(Compress::ZstdDecompressor::decompress_all(compressed).is_error());
+}
+
+TEST_CASE(zstd_truncated_input)
+{
+    auto compressed = read_test_file("happy3rd.html.zst"sv);
+    for (size_t size : Array<size_t, 4> { 3, 10, compressed.size() / 2, compressed.size() - 1 })
+        EXPECT(Compress::ZstdDecompressor::decompress_all(compressed.bytes().trim(size)).is_error());
+}
+
+TEST_CASE(zstd_dictionary_not_supported)
+{
+    // A frame header that refers to dictionary 1.
+    Array<u8, 10> const compressed { 0x28, 0xB5, 0x2F, 0xFD, 0x21, 0x01, 0x01, 0x01, 0x00, 0x00 };
+    EXPECT(Compress::ZstdDecompressor::decompress_all(compressed).is_error());
+}
+
+TEST_CASE(zstd_is_likely_compressed)
+{
+    EXPECT(Compress::ZstdDecompressor::is_likely_compressed(read_test_file("lorem.txt.zst"sv)));
+    EXPECT(!Compress::ZstdDecompressor::is_likely_compressed(read_test_file("lorem.txt"sv)));
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Vector.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/Promise.h>
+#include <LibCore/Task.h>
+#include <LibTest/TestCase.h>
+#include <unistd.h>
+
+static Core::Task<int> add_later(int a, int b, int milliseconds)
+{
+    co_await Core::delay(milliseconds);
+    co_return a + b;
+}
+
+TEST_CASE(task_that_does_not_suspend)
+{
+    auto task = []() -> Core::Task<int> { co_return 42; }();
+    EXPECT(task.is_done());
+    EXPECT_EQ(task.take_result(), 42);
+}
+
+TEST_CASE(awaiting_tasks_concurrently)
+{
+    Core::EventLoop event_loop;
+    Vector<int> finished;
+
+    auto run = [&](int value, int milliseconds) -> Core::Task<> {
+        auto result = co_await add_later(value, 1, milliseconds);
+        finished.append(result);
+        if (finished.size() == 3)
+            event_loop.quit(0);
+    };
+
+    auto first = run(30, 30);
+    auto second = run(10, 10);
+    auto third = run(20, 20);
+    EXPECT(!first.is_done());
+
+    event_loop.exec();
+    EXPECT_EQ(finished, (Vector<int> { 11, 21, 31 }));
+    EXPECT(first.is_done() && second.is_done() && third.is_done());
+}
+
+TEST_CASE(destroying_a_task_cancels_it)
+{
+    Core::EventLoop event_loop;
+    bool resumed = false;
+    {
+        auto task = [&]() -> Core::Task<> {
+            co_await Core::delay(10);
+            resumed = true;
+        }();
+    }
+
+    auto quit = [&]() -> Core::Task<> {
+        co_await Core::delay(30);
+        event_loop.quit(0);
+    }();
+    event_loop.exec();
+    EXPECT(!resumed);
+}
+
+TEST_CASE(detached_task)
+{
+    Core::EventLoop event_loop;
+    [&]() -> Core::Task<> {
+        co_await Core::delay(10);
+        event_loop.quit(0);
+    }()
+                 .detach();
+    event_loop.exec();
+}
+
+TEST_CASE(await_promise_and_file_descriptor)
+{
+    Core::EventLoop event_loop;
+    int fds[2];
+    VERIFY(pipe(fds) == 0);
+
+    auto promise = Core::Promise<int>::construct();
+    auto task = [&]() -> Core::Task<ErrorOr<int>> {
+        auto value = co_await *promise;
+        co_await Core::wait_until_readable(fds[0]);
+        char byte = 0;
+        if (read(fds[0], &byte, 1) != 1)
+            co_return Error::from_errno(errno);
+        co_return value + byte;
+    }();
+
+    Core::deferred_invoke([&] {
+        promise->resolve(40);
+        char byte = 2;
+        VERIFY(write(fds[1], &byte, 1) == 1);
+    });
+
+    auto waiter = [&]() -> Core::Task<> {
+        auto result = co_await move(task);
+        EXPECT_EQ(result.value(), 42);
+        event_loop.quit(0);
+    }();
+    event_loop.exec();
+    EXPECT(waiter.is_done());
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+TEST_CASE(co_try)
+{
+    auto fails = []() -> Core::Task<ErrorOr<int>> { co_return Error::from_errno(ENOENT); };
+    auto user = [&]() -> Core::Task<ErrorOr<int>> {
+        auto result = co_await fails();
+        auto value = CO_TRY(move(result));
+        co_return value + 1;
+    }();
+    EXPECT(user.is_done());
+    auto result = user.take_result();
+    EXPECT(result.is_error());
+    EXPECT_EQ(result.error().code(), ENOENT);
+}
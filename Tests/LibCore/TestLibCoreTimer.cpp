@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Time.h>
+#include <AK/Vector.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/Timer.h>
+#include <LibTest/TestCase.h>
+
+TEST_CASE(timers_fire_in_order_of_expiration)
+{
+    Core::EventLoop event_loop;
+    Vector<int> fired;
+    Vector<NonnullRefPtr<Core::Timer>> timers;
+    for (int interval : { 50, 10, 40, 20, 30 }) {
+        timers.append(MUST(Core::Timer::create_single_shot(interval, [&fired, &event_loop, interval] {
+            fired.append(interval);
+            if (fired.size() == 5)
+                event_loop.quit(0);
+        })));
+        timers.last()->start();
+    }
+
+    event_loop.exec();
+    EXPECT_EQ(fired, (Vector<int> { 10, 20, 30, 40, 50 }));
+}
+
+TEST_CASE(stopped_timers_do_not_fire)
+{
+    Core::EventLoop event_loop;
+    Vector<NonnullRefPtr<Core::Timer>> timers;
+    for (size_t i = 0; i < 20; ++i) {
+        timers.append(MUST(Core::Timer::create_single_shot(10 + i, [] { VERIFY_NOT_REACHED(); })));
+        timers.last()->start();
+    }
+    // Stop them in an order that pulls timers out of all over the heap.
+    for (size_t i = 0; i < timers.size(); i += 3)
+        timers[i]->stop();
+    for (size_t i = 0; i < timers.size(); ++i)
+        timers[i]->stop();
+
+    auto quit_timer = MUST(Core::Timer::create_single_shot(50, [&] { event_loop.quit(0); }));
+    quit_timer->start();
+    event_loop.exec();
+}
+
+TEST_CASE(coarse_timers_do_not_fire_early)
+{
+    Core::EventLoop event_loop;
+    auto start = Time::now_monotonic_coarse();
+    size_t fire_count = 0;
+    auto timer = MUST(Core::Timer::create_repeating(64, [&] {
+        ++fire_count;
+        EXPECT((Time::now_monotonic_coarse() - start).to_milliseconds() >= static_cast<i64>(fire_count * 64));
+        if (fire_count == 3)
+            event_loop.quit(0);
+    }));
+    timer->set_precision(Core::TimerPrecision::Coarse);
+    timer->start();
+    event_loop.exec();
+}
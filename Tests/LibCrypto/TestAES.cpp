@@ -454,3 +454,29 @@ TEST_CASE(test_AES_GCM_128bit_decrypt_multiple_blocks_with_aad)
     EXPECT(memcmp(result_pt, out.data(), out.size()) == 0);
     EXPECT_EQ(consistency, Crypto::VerificationConsistency::Consistent);
 }
+
+// Long enough for the batched counter blocks of CTR and the four-block folding of GHash, with a partial block left over.
+TEST_CASE(test_AES_GCM_256bit_encrypt_and_decrypt_many_blocks_with_aad)
+{
+    Crypto::Cipher::AESCipher::GCMMode cipher("\x00\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0a\x0b\x0c\x0d\x0e\x0f\x10\x11\x12\x13\x14\x15\x16\x17\x18\x19\x1a\x1b\x1c\x1d\x1e\x1f"_b, 256, Crypto::Cipher::Intent::Encryption);
+    u8 plaintext[200];
+    for (size_t i = 0; i < sizeof(plaintext); ++i)
+        plaintext[i] = i * 7 + 3;
+    u8 aad[72];
+    for (size_t i = 0; i < sizeof(aad); ++i)
+        aad[i] = i * 13 + 5;
+    auto iv = "\xa0\xa1\xa2\xa3\xa4\xa5\xa6\xa7\xa8\xa9\xaa\xab\x00\x00\x00\x00"_b;
+    u8 result_ct[] { 0xe5, 0x12, 0x6d, 0x35, 0x5a, 0xed, 0x2f, 0x8b, 0x59, 0x27, 0xce, 0x83, 0x50, 0x24, 0xa5, 0xb2, 0x03, 0xd6, 0xd8, 0x98, 0x1d, 0x21, 0xdf, 0xc8, 0x37, 0xbc, 0x9f, 0x46, 0xb8, 0x65, 0xa0, 0xdd, 0x31, 0x9c, 0xb6, 0x07, 0x50, 0x24, 0x5e, 0x29, 0x44, 0xbe, 0x2d, 0xf8, 0x3e, 0x44, 0xc6, 0xb5, 0x14, 0x41, 0x27, 0x20, 0x0d, 0xa6, 0x67, 0xfa, 0xca, 0xcc, 0x92, 0xfe, 0x03, 0xde, 0x30, 0x0c, 0x77, 0x76, 0x54, 0xb7, 0xef, 0x43, 0x09, 0x14, 0x0f, 0xe0, 0xf6, 0x08, 0x98, 0xd0, 0xe9, 0x96, 0xfe, 0x31, 0xea, 0xec, 0x8a, 0x97, 0xc4, 0x1e, 0x85, 0x07, 0x47, 0x1a, 0x36, 0x14, 0xd8, 0x08, 0x2c, 0x2e, 0x9a, 0x13, 0xbc, 0x68, 0x42, 0x4f, 0x45, 0x39, 0xef, 0xa0, 0x72, 0x76, 0xe8, 0x24, 0x37, 0x4a, 0x40, 0x86, 0xf1, 0x03, 0xa6, 0x78, 0x64, 0x9d, 0x87, 0xc4, 0xd3, 0x3b, 0x87, 0x31, 0x46, 0x9b, 0x21, 0xe7, 0x4c, 0xe4, 0x2d, 0xa3, 0x8c, 0x9b, 0x37, 0x5b, 0xc5, 0x94, 0x74, 0x3a, 0x7b, 0x23, 0xac, 0x63, 0xb1, 0xc6, 0xe7, 0xa8, 0xd6, 0xff, 0x84, 0xb5, 0xe8, 0x89, 0x61, 0x77, 0xa5, 0x72, 0x6e, 0xc9, 0xc9, 0xec, 0xcd, 0x82, 0x19, 0xa8, 0x82, 0x92, 0xd8, 0x6c, 0x73, 0x2d, 0xa4, 0xfc, 0x1c, 0x70, 0xed, 0x90, 0x53, 0x3a, 0x89, 0x90, 0x6f, 0x19, 0x7b, 0xac, 0x2a, 0x6b, 0x77, 0x7c, 0x1d, 0x91, 0x3f, 0xb7, 0xd6, 0x99 };
+    u8 result_tag[] { 0xc9, 0xa9, 0x50, 0x33, 0xd1, 0x47, 0x94, 0x5f, 0x6e, 0x93, 0xdc, 0x3d, 0xa8, 0xe8, 0x87, 0x4f };
+
+    auto tag = ByteBuffer::create_uninitialized(16).release_value();
+    auto out = ByteBuffer::create_uninitialized(sizeof(plaintext)).release_value();
+    cipher.encrypt({ plaintext, sizeof(plaintext) }, out.bytes(), iv, { aad, sizeof(aad) }, tag);
+    EXPECT(memcmp(result_ct, out.data(), out.size()) == 0);
+    EXPECT(memcmp(result_tag, tag.data(), tag.size()) == 0);
+
+    auto decrypted = ByteBuffer::create_uninitialized(sizeof(plaintext)).release_value();
+    auto consistency = cipher.decrypt(out.bytes(), decrypted.bytes(), iv, { aad, sizeof(aad) }, tag.bytes());
+    EXPECT_EQ(consistency, Crypto::VerificationConsistency::Consistent);
+    EXPECT(memcmp(plaintext, decrypted.data(), decrypted.size()) == 0);
+}
@@ -201,6 +201,25 @@ TEST_CASE(test_unsigned_bigint_multiplication_with_big_numbers2)
     EXPECT_EQ(result.words(), expected_result);
 }
 
+TEST_CASE(test_unsigned_bigint_multiplication_with_many_words)
+{
+    // (2^n - 1)^2 = 2^2n - 2^(n + 1) + 1, for sizes that take the fixed-width, Karatsuba and unbalanced paths.
+    for (size_t bits : { 256u, 384u, 1000u, 2048u, 3000u, 4096u, 8200u }) {
+        auto one = Crypto::UnsignedBigInteger { 1 };
+        auto all_ones = one.shift_left(bits).minus(one);
+        auto expected = one.shift_left(2 * bits).minus(one.shift_left(bits + 1)).plus(one);
+        EXPECT_EQ(all_ones.multiplied_by(all_ones), expected);
+    }
+
+    // (2^n - 1)(2^m - 1) = 2^(n + m) - 2^n - 2^m + 1
+    auto one = Crypto::UnsignedBigInteger { 1 };
+    auto left = one.shift_left(3000).minus(one);
+    auto right = one.shift_left(2500).minus(one);
+    auto expected = one.shift_left(5500).minus(one.shift_left(3000)).minus(one.shift_left(2500)).plus(one);
+    EXPECT_EQ(left.multiplied_by(right), expected);
+    EXPECT_EQ(right.multiplied_by(left), expected);
+}
+
 TEST_CASE(test_unsigned_bigint_simple_division)
 {
     Crypto::UnsignedBigInteger num1(27194);
@@ -139,3 +139,37 @@ TEST_CASE(test_vector_3)
     auto expected = ReadonlyBytes { ciphertext, 127 };
     EXPECT_EQ(result, expected);
 }
+
+TEST_CASE(test_many_blocks_match_single_blocks)
+{
+    u8 key[32];
+    for (size_t i = 0; i < 32; ++i)
+        key[i] = i;
+    u8 nonce[12] { 0, 0, 0, 0x09, 0, 0, 0, 0x4a, 0, 0, 0, 0 };
+    u8 plaintext[1000];
+    for (size_t i = 0; i < 1000; ++i)
+        plaintext[i] = i * 7 + 3;
+
+    // Long enough for every batch size, followed by a partial block.
+    auto result = MUST(ByteBuffer::create_uninitialized(1000));
+    auto output = result.bytes();
+    Crypto::Cipher::ChaCha20 cipher(ReadonlyBytes { key, 32 }, ReadonlyBytes { nonce, 12 }, 1);
+    cipher.encrypt(ReadonlyBytes { plaintext, 1000 }, output);
+
+    u8 expected_start[16] { 0x13, 0xfb, 0xf6, 0xfc, 0xce, 0x1d, 0x74, 0x21, 0x6b, 0x4d, 0x94, 0x4f, 0xf4, 0x7e, 0x14, 0xa8 };
+    u8 expected_block_8[16] { 0x2f, 0x60, 0xcf, 0xf1, 0x27, 0x55, 0xc9, 0xa2, 0xd1, 0x13, 0x9f, 0x23, 0xfd, 0xbd, 0x19, 0x68 };
+    u8 expected_end[16] { 0xfc, 0x19, 0x68, 0x5f, 0x18, 0x99, 0x47, 0x82, 0x2b, 0x9e, 0x52, 0xdf, 0xd1, 0x19, 0x92, 0x86 };
+    EXPECT_EQ(result.bytes().slice(0, 16), ReadonlyBytes(expected_start, 16));
+    EXPECT_EQ(result.bytes().slice(512, 16), ReadonlyBytes(expected_block_8, 16));
+    EXPECT_EQ(result.bytes().slice(984, 16), ReadonlyBytes(expected_end, 16));
+
+    // Encrypting one block per call must produce the same key stream.
+    auto block_result = MUST(ByteBuffer::create_uninitialized(1000));
+    Crypto::Cipher::ChaCha20 block_cipher(ReadonlyBytes { key, 32 }, ReadonlyBytes { nonce, 12 }, 1);
+    for (size_t offset = 0; offset < 1000; offset += 64) {
+        auto length = min<size_t>(64, 1000 - offset);
+        auto block_output = block_result.bytes().slice(offset, length);
+        block_cipher.encrypt(ReadonlyBytes { plaintext + offset, length }, block_output);
+    }
+    EXPECT_EQ(result, block_result);
+}
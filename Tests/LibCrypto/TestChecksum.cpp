@@ -4,8 +4,10 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
 #include <LibCrypto/Checksum/Adler32.h>
 #include <LibCrypto/Checksum/CRC32.h>
+#include <LibCrypto/Checksum/XXHash64.h>
 #include <LibTest/TestCase.h>
 
 TEST_CASE(test_adler32)
@@ -33,3 +35,38 @@ TEST_CASE(test_crc32)
     do_test(DeprecatedString("The quick brown fox jumps over the lazy dog").bytes(), 0x414FA339);
     do_test(DeprecatedString("various CRC algorithms input data").bytes(), 0x9BD366AE);
 }
+
+TEST_CASE(test_crc32_combine)
+{
+    auto input = "The quick brown fox jumps over the lazy dog"sv.bytes();
+    for (size_t split : Array<size_t, 5> { 0, 1, 7, 20, 43 }) {
+        auto first = Crypto::Checksum::CRC32(input.trim(split)).digest();
+        auto second = Crypto::Checksum::CRC32(input.slice(split)).digest();
+        EXPECT_EQ(Crypto::Checksum::CRC32::combine(first, second, input.size() - split), 0x414FA339u);
+    }
+}
+
+TEST_CASE(test_xxhash64)
+{
+    auto do_test = [](ReadonlyBytes input, u64 expected_result) {
+        auto digest = Crypto::Checksum::XXHash64(input).digest();
+        EXPECT_EQ(digest, expected_result);
+    };
+
+    do_test(DeprecatedString("").bytes(), 0xEF46DB3751D8E999);
+    do_test(DeprecatedString("a").bytes(), 0xD24EC4F1A98C6E5B);
+    do_test(DeprecatedString("abc").bytes(), 0x44BC2CF5AD770999);
+    do_test(DeprecatedString("The quick brown fox jumps over the lazy dog").bytes(), 0x0B242D361FDA71BC);
+}
+
+TEST_CASE(test_xxhash64_incremental)
+{
+    auto input = "The quick brown fox jumps over the lazy dog, and then it jumps over the lazy dog again."sv.bytes();
+    auto expected = Crypto::Checksum::XXHash64(input).digest();
+    for (size_t chunk_size : Array<size_t, 5> { 1, 3, 8, 31, 33 }) {
+        Crypto::Checksum::XXHash64 xxhash;
+        for (size_t offset = 0; offset < input.size(); offset += chunk_size)
+            xxhash.update(input.slice(offset, min(chunk_size, input.size() - offset)));
+        EXPECT_EQ(xxhash.digest(), expected);
+    }
+}
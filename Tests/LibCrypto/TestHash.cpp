@@ -166,6 +166,67 @@ TEST_CASE(test_SHA256_hash_empty_string)
     EXPECT(memcmp(result, digest.data, Crypto::Hash::SHA256::digest_size()) == 0);
 }
 
+TEST_CASE(test_SHA256_hash_many_blocks)
+{
+    u8 result[] {
+        0x50, 0x97, 0xe7, 0xd5, 0x87, 0x35, 0x2f, 0x50, 0x97, 0x06, 0x2a, 0xe6, 0x79, 0xf3, 0x7b, 0xda, 0x58, 0x02, 0xd9, 0xf8, 0x75, 0xab, 0xa1, 0x4c, 0x8c, 0xb4, 0xd1, 0xa1, 0x88, 0xad, 0xa1, 0x79
+    };
+    u8 data[1000];
+    for (size_t i = 0; i < sizeof(data); ++i)
+        data[i] = i * 31 + 7;
+
+    auto digest = Crypto::Hash::SHA256::hash(data, sizeof(data));
+    EXPECT(memcmp(result, digest.data, Crypto::Hash::SHA256::digest_size()) == 0);
+
+    // Updates that straddle block boundaries.
+    Crypto::Hash::SHA256 hasher;
+    for (size_t offset = 0; offset < sizeof(data); offset += 7)
+        hasher.update(data + offset, min<size_t>(7, sizeof(data) - offset));
+    digest = hasher.digest();
+    EXPECT(memcmp(result, digest.data, Crypto::Hash::SHA256::digest_size()) == 0);
+}
+
+TEST_CASE(test_SHA256_hash_many)
+{
+    // Sizes around the boundaries between one and two padding blocks, in groups that don't fill every lane.
+    u8 data[300];
+    for (size_t i = 0; i < sizeof(data); ++i)
+        data[i] = i * 13 + 1;
+
+    Vector<ReadonlyBytes> messages;
+    for (size_t size = 0; size < sizeof(data); size += 5)
+        messages.append({ data + (size % 7), size - (size % 7) });
+    messages.append({ data, 55 });
+    messages.append({ data, 56 });
+    messages.append({ data, 64 });
+
+    Vector<Crypto::Hash::SHA256::DigestType> digests;
+    digests.resize(messages.size());
+    Crypto::Hash::SHA256::hash_many(messages, digests);
+
+    for (size_t i = 0; i < messages.size(); ++i)
+        EXPECT_EQ(digests[i], Crypto::Hash::SHA256::hash(messages[i].data(), messages[i].size()));
+}
+
+BENCHMARK_CASE(sha256_hash_large)
+{
+    auto data = ByteBuffer::create_zeroed(16 * MiB).release_value();
+    auto digest = Crypto::Hash::SHA256::hash(data);
+    EXPECT_EQ(digest.data[0], 0x08);
+}
+
+BENCHMARK_CASE(sha256_hash_many_small)
+{
+    auto data = ByteBuffer::create_zeroed(16384 * 256).release_value();
+    Vector<ReadonlyBytes> messages;
+    for (size_t i = 0; i < 16384; ++i)
+        messages.append(data.bytes().slice(i * 256, 256));
+    Vector<Crypto::Hash::SHA256::DigestType> digests;
+    digests.resize(messages.size());
+    Crypto::Hash::SHA256::hash_many(messages, digests);
+    EXPECT_EQ(digests.first(), digests.last());
+}
+
 TEST_CASE(test_SHA384_name)
 {
     Crypto::Hash::SHA384 sha;
@@ -303,3 +303,47 @@ TEST_CASE(test_vector_11)
     auto expected = ReadonlyBytes { expected_result, 16 };
     EXPECT_EQ(result, expected);
 }
+
+TEST_CASE(test_long_message_in_uneven_parts)
+{
+    u8 key[32];
+    for (size_t i = 0; i < 32; ++i)
+        key[i] = i * 13 + 5;
+    u8 message[1000];
+    for (size_t i = 0; i < 1000; ++i)
+        message[i] = i * 7 + 3;
+
+    u8 expected_result[16] {
+        0x54, 0x64, 0xb0, 0x26, 0x76, 0x53, 0x7a, 0xec, 0x53, 0xb7, 0x9d, 0x00, 0x2c, 0xa3, 0xcd, 0x64
+    };
+    auto expected = ReadonlyBytes { expected_result, 16 };
+
+    Crypto::Authentication::Poly1305 mac(ReadonlyBytes { key, 32 });
+    mac.update(ReadonlyBytes { message, 1000 });
+    EXPECT_EQ(MUST(mac.digest()), expected);
+
+    Crypto::Authentication::Poly1305 split_mac(ReadonlyBytes { key, 32 });
+    for (size_t offset = 0, length = 1; offset < 1000; offset += length, length = length * 3 % 41) {
+        length = min<size_t>(length, 1000 - offset);
+        split_mac.update(ReadonlyBytes { message + offset, length });
+    }
+    EXPECT_EQ(MUST(split_mac.digest()), expected);
+}
+
+TEST_CASE(test_all_ones)
+{
+    u8 key[32];
+    u8 message[1000];
+    memset(key, 0xff, sizeof(key));
+    memset(message, 0xff, sizeof(message));
+
+    u8 expected_result[16] {
+        0xde, 0x94, 0x06, 0xb1, 0x0e, 0x70, 0x23, 0xbc, 0xd6, 0x92, 0xff, 0x68, 0x7f, 0x4c, 0xbc, 0x7f
+    };
+
+    Crypto::Authentication::Poly1305 mac(ReadonlyBytes { key, 32 });
+    mac.update(ReadonlyBytes { message, 1000 });
+    auto result = MUST(mac.digest());
+    auto expected = ReadonlyBytes { expected_result, 16 };
+    EXPECT_EQ(result, expected);
+}
@@ -6,6 +6,7 @@
 
 #include <LibCore/MappedFile.h>
 #include <LibGfx/ICC/BinaryWriter.h>
+#include <LibGfx/ICC/ColorTransform.h>
 #include <LibGfx/ICC/Profile.h>
 #include <LibGfx/JPEGLoader.h>
 #include <LibGfx/PNGLoader.h>
@@ -75,3 +76,31 @@ TEST_CASE(serialize_icc)
     auto serialized_bytes = MUST(Gfx::ICC::encode(*icc_profile));
     EXPECT_EQ(serialized_bytes, file->bytes());
 }
+
+TEST_CASE(color_transform)
+{
+    auto file = MUST(Core::MappedFile::map(TEST_INPUT("p3-v4.icc"sv)));
+    auto p3 = MUST(Gfx::ICC::Profile::try_load_from_externally_owned_memory(file->bytes()));
+
+    auto p3_to_p3 = MUST(Gfx::ICC::ColorTransform::create(*p3, *p3));
+    EXPECT(p3_to_p3.is_identity());
+    EXPECT_EQ(p3_to_p3.map(Color(12, 34, 56)), Color(12, 34, 56));
+
+    auto p3_to_srgb = MUST(Gfx::ICC::ColorTransform::create_to_sRGB(*p3));
+    EXPECT(!p3_to_srgb.is_identity());
+
+    // Display P3 and sRGB share the tone curve and the white point, so grays don't change.
+    EXPECT_EQ(p3_to_srgb.map(Color::Black), Color::Black);
+    EXPECT_EQ(p3_to_srgb.map(Color::White), Color::White);
+    EXPECT_EQ(p3_to_srgb.map(Color(128, 128, 128)), Color(128, 128, 128));
+
+    // P3's primaries are more saturated than sRGB's, so colors get more saturated as well, and the primaries themselves
+    // end up outside of sRGB.
+    EXPECT_EQ(p3_to_srgb.map(Color(255, 0, 0)), Color(255, 0, 0));
+    EXPECT_EQ(p3_to_srgb.map(Color(200, 100, 50, 77)), Color(215, 93, 31, 77));
+
+    Array<Gfx::ARGB32, 2> pixels { Color(128, 128, 128).value(), Color(200, 100, 50, 77).value() };
+    p3_to_srgb.map(pixels.span());
+    EXPECT_EQ(Color::from_argb(pixels[0]), Color(128, 128, 128));
+    EXPECT_EQ(Color::from_argb(pixels[1]), p3_to_srgb.map(Color(200, 100, 50, 77)));
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Hex.h>
+#include <LibHTTP/HPack.h>
+#include <LibTest/TestCase.h>
+
+using HTTP::HPack::Header;
+
+static ByteBuffer from_hex(StringView hex)
+{
+    return MUST(decode_hex(hex));
+}
+
+// The requests of RFC7541 appendix C.3 and C.4, which share a connection.
+static Vector<Header> const example_requests[] = {
+    { { ":method", "GET" }, { ":scheme", "http" }, { ":path", "/" }, { ":authority", "www.example.com" } },
+    { { ":method", "GET" }, { ":scheme", "http" }, { ":path", "/" }, { ":authority", "www.example.com" }, { "cache-control", "no-cache" } },
+    { { ":method", "GET" }, { ":scheme", "https" }, { ":path", "/index.html" }, { ":authority", "www.example.com" }, { "custom-key", "custom-value" } },
+};
+
+TEST_CASE(huffman)
+{
+    auto encoded = MUST(HTTP::HPack::huffman_encode("www.example.com"sv.bytes()));
+    EXPECT_EQ(encoded, from_hex("f1e3c2e5f23a6ba0ab90f4ff"sv));
+    EXPECT_EQ(MUST(HTTP::HPack::huffman_decode(encoded)).bytes(), "www.example.com"sv.bytes());
+
+    // Every symbol, including the ones with the longest codes.
+    ByteBuffer all_bytes;
+    for (int byte = 0; byte < 256; ++byte)
+        all_bytes.append(static_cast<u8>(byte));
+    EXPECT_EQ(MUST(HTTP::HPack::huffman_decode(MUST(HTTP::HPack::huffman_encode(all_bytes)))), all_bytes);
+
+    // Padding must be the start of EOS, which is all ones, and shorter than a byte.
+    EXPECT(HTTP::HPack::huffman_decode(from_hex("f1e3c2e5f23a6ba0ab90f4fe"sv)).is_error());
+    EXPECT(HTTP::HPack::huffman_decode(from_hex("f1e3c2e5f23a6ba0ab90f4ffff"sv)).is_error());
+}
+
+TEST_CASE(decode_requests_without_huffman)
+{
+    HTTP::HPack::Decoder decoder;
+
+    EXPECT_EQ(MUST(decoder.decode(from_hex("828684410f7777772e6578616d706c652e636f6d"sv))), example_requests[0]);
+    EXPECT_EQ(decoder.table().size(), 57u);
+
+    EXPECT_EQ(MUST(decoder.decode(from_hex("828684be58086e6f2d6361636865"sv))), example_requests[1]);
+    EXPECT_EQ(decoder.table().size(), 110u);
+
+    EXPECT_EQ(MUST(decoder.decode(from_hex("828785bf400a637573746f6d2d6b65790c637573746f6d2d76616c7565"sv))), example_requests[2]);
+    EXPECT_EQ(decoder.table().size(), 164u);
+    EXPECT_EQ(decoder.table().entry_count(), 3u);
+    EXPECT_EQ(decoder.table().at(0), (Header { "custom-key", "custom-value" }));
+    EXPECT_EQ(decoder.table().at(2), (Header { ":authority", "www.example.com" }));
+}
+
+TEST_CASE(encode_and_decode_requests_with_huffman)
+{
+    StringView const expected_header_blocks[] = {
+        "828684418cf1e3c2e5f23a6ba0ab90f4ff"sv,
+        "828684be5886a8eb10649cbf"sv,
+        "828785bf408825a849e95ba97d7f8925a849e95bb8e8b4bf"sv,
+    };
+
+    HTTP::HPack::Encoder encoder;
+    HTTP::HPack::Decoder decoder;
+    for (size_t i = 0; i < array_size(example_requests); ++i) {
+        auto header_block = MUST(encoder.encode(example_requests[i]));
+        EXPECT_EQ(header_block, from_hex(expected_header_blocks[i]));
+        EXPECT_EQ(MUST(decoder.decode(header_block)), example_requests[i]);
+    }
+    EXPECT_EQ(encoder.table().size(), 164u);
+    EXPECT_EQ(decoder.table().size(), 164u);
+}
+
+TEST_CASE(table_size_update)
+{
+    HTTP::HPack::Encoder encoder;
+    HTTP::HPack::Decoder decoder;
+    EXPECT_EQ(MUST(decoder.decode(MUST(encoder.encode(example_requests[2])))).size(), 5u);
+    EXPECT_EQ(decoder.table().entry_count(), 2u);
+
+    // The entries are evicted oldest first, on both ends.
+    encoder.set_maximum_table_size(60);
+    EXPECT_EQ(MUST(decoder.decode(MUST(encoder.encode(example_requests[2])))), example_requests[2]);
+    EXPECT_EQ(decoder.table().maximum_size(), 60u);
+    EXPECT_EQ(decoder.table().entry_count(), 1u);
+    EXPECT_EQ(decoder.table().at(0), (Header { "custom-key", "custom-value" }));
+    EXPECT_EQ(encoder.table().size(), decoder.table().size());
+
+    // A size update may only start a header block, and may not exceed the size we allowed.
+    EXPECT(decoder.decode(from_hex("8220"sv)).is_error());
+    EXPECT(decoder.decode(from_hex("3fe21f"sv)).is_error());
+}
+
+TEST_CASE(never_index_credentials)
+{
+    HTTP::HPack::Encoder encoder;
+    Vector<Header> headers { { "authorization", "Basic dXNlcjpwYXNz" } };
+    auto header_block = MUST(encoder.encode(headers));
+    EXPECT_EQ(header_block[0], 0x1f);
+    EXPECT_EQ(encoder.table().entry_count(), 0u);
+
+    HTTP::HPack::Decoder decoder;
+    EXPECT_EQ(MUST(decoder.decode(header_block)), headers);
+    EXPECT_EQ(decoder.table().entry_count(), 0u);
+}
+
+TEST_CASE(malformed_header_blocks)
+{
+    HTTP::HPack::Decoder decoder;
+    // Index 0, an index past the end of the tables, a truncated string and an integer that doesn't end.
+    EXPECT(decoder.decode(from_hex("80"sv)).is_error());
+    EXPECT(decoder.decode(from_hex("be"sv)).is_error());
+    EXPECT(decoder.decode(from_hex("410f7777"sv)).is_error());
+    EXPECT(decoder.decode(from_hex("ffffffffffffff"sv)).is_error());
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/EventLoop.h>
+#include <LibCore/Socket.h>
+#include <LibCore/Timer.h>
+#include <LibIPC/ConnectionFromClient.h>
+#include <LibIPC/ConnectionToServer.h>
+#include <LibTest/TestCase.h>
+#include <TestClientEndpoint.h>
+#include <TestServerEndpoint.h>
+#include <sys/socket.h>
+
+class TestConnectionFromClient final : public IPC::ConnectionFromClient<TestClientEndpoint, TestServerEndpoint> {
+    C_OBJECT(TestConnectionFromClient);
+
+public:
+    bool did_handle_request() const { return m_did_handle_request; }
+    bool did_receive_pong() const { return m_did_receive_pong; }
+
+private:
+    explicit TestConnectionFromClient(NonnullOwnPtr<Core::LocalSocket> socket)
+        : IPC::ConnectionFromClient<TestClientEndpoint, TestServerEndpoint>(*this, move(socket), 1)
+    {
+    }
+
+    virtual void die() override { }
+
+    // Like a handler that shows a dialog, this sends a message and then waits in a nested event loop for the answer.
+    virtual void request_pong() override
+    {
+        async_pong();
+
+        bool timed_out = false;
+        auto timeout = MUST(Core::Timer::create_single_shot(1000, [&] { timed_out = true; }));
+        timeout->start();
+        Core::EventLoop::current().spin_until([&] { return m_did_receive_pong || timed_out; });
+        timeout->stop();
+
+        m_did_handle_request = true;
+    }
+
+    virtual void pong_received() override { m_did_receive_pong = true; }
+
+    bool m_did_handle_request { false };
+    bool m_did_receive_pong { false };
+};
+
+class TestConnectionToServer final : public IPC::ConnectionToServer<TestClientEndpoint, TestServerEndpoint> {
+    C_OBJECT(TestConnectionToServer);
+
+private:
+    explicit TestConnectionToServer(NonnullOwnPtr<Core::LocalSocket> socket)
+        : IPC::ConnectionToServer<TestClientEndpoint, TestServerEndpoint>(*this, move(socket))
+    {
+    }
+
+    virtual void die() override { }
+
+    virtual void pong() override { async_pong_received(); }
+};
+
+TEST_CASE(handler_can_wait_for_reply_to_message_it_sent)
+{
+    Core::EventLoop loop;
+
+    int fds[2];
+    VERIFY(socketpair(AF_LOCAL, SOCK_STREAM, 0, fds) == 0);
+    auto server = TestConnectionFromClient::construct(MUST(Core::LocalSocket::adopt_fd(fds[0])));
+    auto client = TestConnectionToServer::construct(MUST(Core::LocalSocket::adopt_fd(fds[1])));
+
+    client->async_request_pong();
+    loop.spin_until([&] { return server->did_handle_request(); });
+
+    EXPECT(server->did_receive_pong());
+}
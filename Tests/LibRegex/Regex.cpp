@@ -952,6 +952,26 @@ TEST_CASE(theoretically_infinite_loop)
     }
 }
 
+TEST_CASE(catastrophic_backtracking)
+{
+    Array tests {
+        // Pattern, Subject, Expected result
+        Tuple { "^(\\w+\\s?)*$"sv, "An input string that takes a long time or even makes this regex to hang!"sv, false },
+        Tuple { "^(a|a)*$"sv, "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa!"sv, false },
+        Tuple { "^(a|a)*$"sv, "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"sv, true },
+    };
+
+    for (auto& test : tests) {
+        Regex<ECMA262> re(test.get<0>());
+        EXPECT_EQ(re.match(test.get<1>()).success, test.get<2>());
+    }
+
+    // Backreferences make the outcome depend on the captures, so forks at the same position may still differ.
+    Regex<ECMA262> re("^(a+)\\1b$");
+    EXPECT_EQ(re.match("aaaab"sv).success, true);
+    EXPECT_EQ(re.match("aaab"sv).success, false);
+}
+
 static auto g_lots_of_a_s = DeprecatedString::repeated('a', 10'000'000);
 
 BENCHMARK_CASE(fork_performance)
@@ -1030,6 +1050,39 @@ TEST_CASE(optimizer_alternation)
     }
 }
 
+TEST_CASE(optimizer_starting_ranges)
+{
+    Array tests {
+        // Pattern, Subject, Expected match
+        Tuple { "foo"sv, "xxfooxx"sv, "foo"sv },
+        Tuple { "[b-d]x"sv, "axbxcx"sv, "bx"sv },
+        Tuple { "(a)(b)c"sv, "aababc"sv, "abc"sv },
+        Tuple { "\\d+"sv, "abc123"sv, "123"sv },
+        Tuple { "^ab"sv, "abab"sv, "ab"sv },
+        Tuple { "a?b"sv, "xxb"sv, "b"sv },
+    };
+
+    for (auto& test : tests) {
+        Regex<ECMA262> re(test.get<0>(), ECMAScriptFlags::Global);
+        auto result = re.match(test.get<1>());
+        EXPECT(result.success);
+        EXPECT_EQ(result.matches.first().view.to_deprecated_string(), test.get<2>());
+    }
+
+    {
+        Regex<ECMA262> re("^b"sv, ECMAScriptFlags::Global);
+        EXPECT_EQ(re.match("ab"sv).success, false);
+    }
+    {
+        Regex<ECMA262> re("^b"sv, ECMAScriptFlags::Global | ECMAScriptFlags::Multiline);
+        EXPECT_EQ(re.match("a\nb"sv).success, true);
+    }
+    {
+        Regex<ECMA262> re("xyz"sv, ECMAScriptFlags::Global | ECMAScriptFlags::Insensitive);
+        EXPECT_EQ(re.match("abXYZ"sv).success, true);
+    }
+}
+
 TEST_CASE(posix_basic_dollar_is_end_anchor)
 {
     // Ensure that a dollar sign at the end only matches the end of the line.
@@ -7,6 +7,7 @@
 #include <unistd.h>
 
 #include <AK/ScopeGuard.h>
+#include <LibCore/EventLoop.h>
 #include <LibSQL/BTree.h>
 #include <LibSQL/Database.h>
 #include <LibSQL/Heap.h>
@@ -134,6 +135,128 @@ TEST_CASE(create_in_non_existing_dir)
     EXPECT(should_be_error.is_error());
 }
 
+TEST_CASE(heap_buffer_pool_is_bounded)
+{
+    ScopeGuard guard([]() { unlink("/tmp/test.db"); });
+    constexpr u32 block_count = 3 * SQL::Heap::maximum_cached_blocks;
+
+    auto block_with_value = [](u32 value) {
+        auto buffer = MUST(ByteBuffer::create_zeroed(SQL::BLOCKSIZE));
+        buffer.overwrite(0, &value, sizeof(value));
+        return buffer;
+    };
+    auto value_in_block = [](ByteBuffer const& buffer) {
+        u32 value;
+        memcpy(&value, buffer.data(), sizeof(value));
+        return value;
+    };
+
+    {
+        auto heap = SQL::Heap::construct("/tmp/test.db");
+        EXPECT(!heap->open().is_error());
+        for (u32 ix = 0; ix < block_count; ix++) {
+            auto block = heap->new_record_pointer();
+            auto buffer = block_with_value(ix);
+            heap->add_to_wal(block, buffer);
+            EXPECT(heap->dirty_block_count() <= SQL::Heap::maximum_dirty_blocks);
+        }
+        EXPECT(heap->cached_block_count() <= SQL::Heap::maximum_cached_blocks);
+
+        // Blocks that were logged ahead of the commit and evicted come back from the log.
+        for (u32 ix = 0; ix < block_count; ix++)
+            EXPECT_EQ(value_in_block(MUST(heap->read_block(ix + 1))), ix);
+        EXPECT(heap->cached_block_count() <= SQL::Heap::maximum_cached_blocks);
+        EXPECT(!heap->flush().is_error());
+        EXPECT_EQ(heap->dirty_block_count(), 0u);
+    }
+    {
+        auto heap = SQL::Heap::construct("/tmp/test.db");
+        EXPECT(!heap->open().is_error());
+        EXPECT_EQ(heap->size(), block_count + 1);
+        for (u32 ix = 0; ix < block_count; ix++)
+            EXPECT_EQ(value_in_block(MUST(heap->read_block(ix + 1))), ix);
+
+        // Overwriting a cached block must not be hidden by the clean copy.
+        auto buffer = block_with_value(42);
+        heap->add_to_wal(1, buffer);
+        EXPECT_EQ(value_in_block(MUST(heap->read_block(1))), 42u);
+    }
+}
+
+TEST_CASE(heap_recovers_committed_blocks_from_log)
+{
+    ScopeGuard guard([]() {
+        unlink("/tmp/test.db");
+        unlink("/tmp/test.db-wal");
+    });
+
+    auto block_with_value = [](u32 value) {
+        auto buffer = MUST(ByteBuffer::create_zeroed(SQL::BLOCKSIZE));
+        buffer.overwrite(0, &value, sizeof(value));
+        return buffer;
+    };
+
+    {
+        auto heap = SQL::Heap::construct("/tmp/test.db");
+        EXPECT(!heap->open().is_error());
+        auto block = heap->new_record_pointer();
+        EXPECT_EQ(block, 1u);
+        auto buffer = block_with_value(1);
+        heap->add_to_wal(block, buffer);
+        EXPECT(!heap->flush().is_error());
+
+        // Enough changes that they are logged ahead of a commit that never comes.
+        for (u32 ix = 0; ix <= SQL::Heap::maximum_dirty_blocks; ix++) {
+            auto block = ix == 0 ? 1 : heap->new_record_pointer();
+            auto buffer = block_with_value(2);
+            heap->add_to_wal(block, buffer);
+        }
+        EXPECT(heap->log_block_count() > 1u);
+
+        // Crash, without the destructor checkpointing the log.
+        (void)&heap.leak_ref();
+    }
+    {
+        auto heap = SQL::Heap::construct("/tmp/test.db");
+        EXPECT(!heap->open().is_error());
+        EXPECT_EQ(heap->size(), 2u);
+        EXPECT_EQ(heap->log_block_count(), 0u);
+
+        auto buffer = MUST(heap->read_block(1));
+        u32 value;
+        memcpy(&value, buffer.data(), sizeof(value));
+        EXPECT_EQ(value, 1u);
+    }
+}
+
+TEST_CASE(heap_group_commit)
+{
+    ScopeGuard guard([]() { unlink("/tmp/test.db"); });
+    Core::EventLoop event_loop;
+
+    auto heap = SQL::Heap::construct("/tmp/test.db");
+    EXPECT(!heap->open().is_error());
+
+    size_t durable_commits = 0;
+    for (u32 ix = 0; ix < 3; ix++) {
+        auto buffer = MUST(ByteBuffer::create_zeroed(SQL::BLOCKSIZE));
+        heap->add_to_wal(heap->new_record_pointer(), buffer);
+        EXPECT(!heap->commit().is_error());
+        heap->sync([&](ErrorOr<void> result) {
+            EXPECT(!result.is_error());
+            durable_commits++;
+        });
+    }
+    EXPECT_EQ(durable_commits, 0u);
+
+    event_loop.pump(Core::EventLoop::WaitMode::PollForEvents);
+    EXPECT_EQ(durable_commits, 3u);
+
+    // Nothing left to sync, so this one is durable right away.
+    heap->sync([&](ErrorOr<void>) { durable_commits++; });
+    EXPECT_EQ(durable_commits, 4u);
+}
+
 TEST_CASE(create_database)
 {
     ScopeGuard guard([]() { unlink("/tmp/test.db"); });
@@ -216,3 +339,30 @@ TEST_CASE(insert_100_into_table)
 {
     insert_and_verify(100);
 }
+
+TEST_CASE(insert_many_rows_at_once)
+{
+    ScopeGuard guard([]() { unlink("/tmp/test.db"); });
+    {
+        auto db = SQL::Database::construct("/tmp/test.db");
+        EXPECT(!db->open().is_error());
+        (void)setup_table(db);
+        insert_into_table(db, 1);
+
+        auto table = MUST(db->get_table("TestSchema", "TestTable"));
+        Vector<SQL::Row> rows;
+        for (int ix = 1; ix < 100; ix++) {
+            SQL::Row row(*table);
+            row["TextColumn"] = DeprecatedString::formatted("Test{}", ix);
+            row["IntColumn"] = ix;
+            rows.append(move(row));
+        }
+        EXPECT(!db->insert(rows.span()).is_error());
+        commit(db);
+    }
+    {
+        auto db = SQL::Database::construct("/tmp/test.db");
+        EXPECT(!db->open().is_error());
+        verify_table_contents(db, 100);
+    }
+}
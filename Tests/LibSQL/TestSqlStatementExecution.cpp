@@ -388,6 +388,57 @@ TEST_CASE(select_inner_join)
     EXPECT_EQ(result[0].row[2].to_deprecated_string(), "Test_12");
 }
 
+TEST_CASE(select_inner_join_with_conditions_and_limit)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = SQL::Database::construct(db_name);
+    EXPECT(!database->open().is_error());
+    create_two_tables(database);
+    auto result = execute(database,
+        "INSERT INTO TestSchema.TestTable1 ( TextColumn1, IntColumn ) VALUES "
+        "( 'Test_1', 42 ), "
+        "( 'Test_2', 43 ), "
+        "( 'Test_3', 44 ), "
+        "( 'Test_4', 45 ), "
+        "( 'Test_5', 46 );");
+    EXPECT(result.size() == 5);
+    result = execute(database,
+        "INSERT INTO TestSchema.TestTable2 ( TextColumn2, IntColumn ) VALUES "
+        "( 'Test_10', 42 ), "
+        "( 'Test_11', 43 ), "
+        "( 'Test_12', 44 ), "
+        "( 'Test_13', 45 ), "
+        "( 'Test_14', 46 );");
+    EXPECT(result.size() == 5);
+
+    // The condition on TestTable1 alone is checked before the join, the other one after.
+    result = execute(database,
+        "SELECT TestTable1.IntColumn, TextColumn2 "
+        "FROM TestSchema.TestTable1, TestSchema.TestTable2 "
+        "WHERE (TestTable1.IntColumn > 43) AND (TestTable1.IntColumn = TestTable2.IntColumn) "
+        "ORDER BY TestTable1.IntColumn;");
+    EXPECT_EQ(result.size(), 3u);
+    for (size_t i = 0; i < result.size(); ++i) {
+        EXPECT_EQ(result[i].row[0].to_int<i32>(), 44 + static_cast<i32>(i));
+        EXPECT_EQ(result[i].row[1].to_deprecated_string(), DeprecatedString::formatted("Test_{}", 12 + i));
+    }
+
+    result = execute(database,
+        "SELECT TextColumn1, TextColumn2 "
+        "FROM TestSchema.TestTable1, TestSchema.TestTable2 "
+        "WHERE TextColumn1 = 'Test_2' "
+        "LIMIT 2 OFFSET 1;");
+    EXPECT_EQ(result.size(), 2u);
+    for (auto& row : result)
+        EXPECT_EQ(row.row[0].to_deprecated_string(), "Test_2");
+
+    auto error = try_execute(database,
+        "SELECT * FROM TestSchema.TestTable1, TestSchema.TestTable2 "
+        "WHERE (TestTable1.IntColumn = 42) AND (NoSuchColumn = 1);");
+    EXPECT(error.is_error());
+    EXPECT_EQ(error.error().error(), SQL::SQLErrorCode::ColumnDoesNotExist);
+}
+
 TEST_CASE(select_with_like)
 {
     ScopeGuard guard([]() { unlink(db_name); });
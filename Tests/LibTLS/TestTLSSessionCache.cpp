@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/DateTime.h>
+#include <LibTLS/SessionCache.h>
+#include <LibTest/TestCase.h>
+
+static TLS::SessionCache::Session make_session(u8 id_byte, time_t expiry_timestamp)
+{
+    TLS::SessionCache::Session session;
+    session.session_id = MUST(ByteBuffer::copy(Array<u8, 4> { id_byte, id_byte, id_byte, id_byte }));
+    session.cipher = TLS::CipherSuite::ECDHE_RSA_WITH_AES_128_GCM_SHA256;
+    session.master_key = MUST(ByteBuffer::create_zeroed(48));
+    session.expiry_timestamp = expiry_timestamp;
+    return session;
+}
+
+TEST_CASE(store_and_find_sessions)
+{
+    auto cache = TLS::SessionCache::create();
+    auto later = Core::DateTime::now().timestamp() + 60;
+
+    EXPECT_EQ(cache->find_session("example.com"sv), nullptr);
+
+    cache->store_session("example.com"sv, make_session(1, later));
+    cache->store_session("example.org"sv, make_session(2, later));
+
+    auto const* session = cache->find_session("example.com"sv);
+    EXPECT_NE(session, nullptr);
+    EXPECT_EQ(session->session_id[0], 1);
+    EXPECT_EQ(cache->find_session("example.org"sv)->session_id[0], 2);
+
+    // A new session for the same host replaces the old one.
+    cache->store_session("example.com"sv, make_session(3, later));
+    EXPECT_EQ(cache->find_session("example.com"sv)->session_id[0], 3);
+
+    cache->remove_session("example.com"sv);
+    EXPECT_EQ(cache->find_session("example.com"sv), nullptr);
+    EXPECT_NE(cache->find_session("example.org"sv), nullptr);
+}
+
+TEST_CASE(expired_sessions_are_not_resumed)
+{
+    auto cache = TLS::SessionCache::create();
+    cache->store_session("example.com"sv, make_session(1, Core::DateTime::now().timestamp() - 1));
+    EXPECT_EQ(cache->find_session("example.com"sv), nullptr);
+}
+
+TEST_CASE(verified_chains_are_per_host)
+{
+    auto cache = TLS::SessionCache::create();
+
+    TLS::Certificate certificate;
+    certificate.original_asn1 = MUST(ByteBuffer::copy("not really a certificate"sv.bytes()));
+    Vector<TLS::Certificate> chain { certificate };
+
+    EXPECT(!cache->has_verified_chain("example.com"sv, chain));
+    cache->add_verified_chain("example.com"sv, chain);
+    EXPECT(cache->has_verified_chain("example.com"sv, chain));
+    EXPECT(!cache->has_verified_chain("example.org"sv, chain));
+
+    chain[0].original_asn1 = MUST(ByteBuffer::copy("another certificate"sv.bytes()));
+    EXPECT(!cache->has_verified_chain("example.com"sv, chain));
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <AK/Vector.h>
+#include <LibTest/TestCase.h>
+#include <LibThreading/ThreadPool.h>
+
+TEST_CASE(destructor_finishes_submitted_tasks)
+{
+    Atomic<size_t> sum { 0 };
+    {
+        Threading::ThreadPool pool(4);
+        for (size_t i = 1; i <= 1000; ++i) {
+            pool.submit([&, i] {
+                sum += i;
+                // Tasks spawned by tasks have to be finished as well.
+                if (i % 10 == 0)
+                    pool.submit([&] { sum += 1; });
+            });
+        }
+    }
+    EXPECT_EQ(sum.load(), 500'500u + 100u);
+}
+
+TEST_CASE(parallel_for_visits_every_index_once)
+{
+    Threading::ThreadPool pool(4);
+    for (size_t count : { 0, 1, 2, 7, 100, 12345 }) {
+        Vector<u32> visits;
+        visits.resize(count);
+        pool.parallel_for(count, [&](size_t i) { AK::atomic_fetch_add(&visits[i], 1u); });
+        for (auto visit_count : visits)
+            EXPECT_EQ(visit_count, 1u);
+    }
+}
+
+TEST_CASE(parallel_for_each)
+{
+    Threading::ThreadPool pool(3);
+    Vector<int> values;
+    for (int i = 0; i < 1000; ++i)
+        values.append(i);
+    pool.parallel_for_each(values.span(), [](int& value) { value *= 2; });
+    for (int i = 0; i < 1000; ++i)
+        EXPECT_EQ(values[i], i * 2);
+}
+
+TEST_CASE(nested_parallel_for)
+{
+    // The outer loop keeps every worker busy, so the inner loops only finish because their callers help out.
+    Threading::ThreadPool pool(2);
+    Atomic<size_t> count { 0 };
+    pool.parallel_for(16, [&](size_t) {
+        pool.parallel_for(100, [&](size_t) { count++; });
+    });
+    EXPECT_EQ(count.load(), 1600u);
+}
@@ -43,11 +43,15 @@ TEST_CASE(normalize_nfc)
 
     EXPECT_EQ(MUST(normalize("Office"sv, NormalizationForm::NFC)), "Office"sv);
 
+    EXPECT_EQ(MUST(normalize("Amélie"sv, NormalizationForm::NFC)), "Amélie"sv);
+    EXPECT_EQ(MUST(normalize("Ame\u0301lie"sv, NormalizationForm::NFC)), "Amélie"sv);
+
     EXPECT_EQ(MUST(normalize("\u1E9B\u0323"sv, NormalizationForm::NFC)), "\u1E9B\u0323"sv);
     EXPECT_EQ(MUST(normalize("\u0044\u0307"sv, NormalizationForm::NFC)), "\u1E0A"sv);
 
     EXPECT_EQ(MUST(normalize("\u0044\u0307\u0323"sv, NormalizationForm::NFC)), "\u1E0C\u0307"sv);
     EXPECT_EQ(MUST(normalize("\u0044\u0323\u0307"sv, NormalizationForm::NFC)), "\u1E0C\u0307"sv);
+    EXPECT_EQ(MUST(normalize("\u0041\u0051\u0323\u0301"sv, NormalizationForm::NFC)), "\u0041\u0051\u0323\u0301"sv);
 
     EXPECT_EQ(MUST(normalize("\u0112\u0300"sv, NormalizationForm::NFC)), "\u1E14"sv);
     EXPECT_EQ(MUST(normalize("\u1E14\u0304"sv, NormalizationForm::NFC)), "\u1E14\u0304"sv);
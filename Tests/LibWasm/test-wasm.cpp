@@ -175,6 +175,7 @@ JS_DEFINE_NATIVE_FUNCTION(WebAssemblyModule::get_export)
                     [&](auto const& value) -> JS::Value { return JS::Value(static_cast<double>(value)); },
                     [&](i32 value) { return JS::Value(static_cast<double>(value)); },
                     [&](i64 value) -> JS::Value { return JS::BigInt::create(vm, Crypto::SignedBigInteger { value }); },
+                    [&](u128 value) -> JS::Value { return JS::BigInt::create(vm, Crypto::SignedBigInteger { Crypto::UnsignedBigInteger { value.high() }.shift_left(64).plus(Crypto::UnsignedBigInteger { value.low() }) }); },
                     [&](Wasm::Reference const& reference) -> JS::Value {
                         return reference.ref().visit(
                             [&](const Wasm::Reference::Null&) -> JS::Value { return JS::js_null(); },
@@ -227,6 +228,14 @@ JS_DEFINE_NATIVE_FUNCTION(WebAssemblyModule::wasm_invoke)
         case Wasm::ValueType::Kind::F64:
             arguments.append(Wasm::Value(static_cast<double>(double_value)));
             break;
+        case Wasm::ValueType::Kind::V128: {
+            if (!argument.is_bigint())
+                return vm.throw_completion<JS::TypeError>("Expected a BigInt for a v128 argument"sv);
+            auto& words = argument.as_bigint().big_integer().unsigned_value().words();
+            auto word = [&](size_t index) -> u64 { return index < words.size() ? words[index] : 0; };
+            arguments.append(Wasm::Value(u128 { word(0) | (word(1) << 32), word(2) | (word(3) << 32) }));
+            break;
+        }
         case Wasm::ValueType::Kind::FunctionReference:
             arguments.append(Wasm::Value(Wasm::Reference { Wasm::Reference::Func { static_cast<u64>(double_value) } }));
             break;
@@ -257,6 +266,7 @@ JS_DEFINE_NATIVE_FUNCTION(WebAssemblyModule::wasm_invoke)
             [](auto const& value) { return JS::Value(static_cast<double>(value)); },
             [](i32 value) { return JS::Value(static_cast<double>(value)); },
             [&](i64 value) { return JS::Value(JS::BigInt::create(vm, Crypto::SignedBigInteger { value })); },
+            [&](u128 value) { return JS::Value(JS::BigInt::create(vm, Crypto::SignedBigInteger { Crypto::UnsignedBigInteger { value.high() }.shift_left(64).plus(Crypto::UnsignedBigInteger { value.low() }) })); },
             [](Wasm::Reference const& reference) {
                 return reference.ref().visit(
                     [](const Wasm::Reference::Null&) { return JS::js_null(); },
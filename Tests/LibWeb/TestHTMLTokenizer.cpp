@@ -177,6 +177,54 @@ TEST_CASE(character_reference_in_attribute)
     END_ENUMERATION();
 }
 
+TEST_CASE(multibyte_characters_and_newlines_in_attributes)
+{
+    auto tokens = run_tokenizer("<p foo=\"\u00e9\u20ac\r\n\" bar='a\rb' baz=\u00fc>"sv);
+    BEGIN_ENUMERATION(tokens);
+    EXPECT_START_TAG_TOKEN(p);
+    EXPECT_TAG_TOKEN_ATTRIBUTE_COUNT(3);
+    EXPECT_TAG_TOKEN_ATTRIBUTE(foo, "\u00e9\u20ac\n");
+    EXPECT_TAG_TOKEN_ATTRIBUTE(bar, "a\nb");
+    EXPECT_TAG_TOKEN_ATTRIBUTE(baz, "\u00fc");
+    EXPECT_END_OF_FILE_TOKEN();
+    END_ENUMERATION();
+}
+
+TEST_CASE(multibyte_characters_and_newlines_in_text)
+{
+    auto tokens = run_tokenizer("<p>a\r\nb\rc\u00e9\u20ac</p>"sv);
+    BEGIN_ENUMERATION(tokens);
+    EXPECT_START_TAG_TOKEN(p);
+    EXPECT_CHARACTER_TOKEN('a');
+    EXPECT_CHARACTER_TOKEN('\n');
+    EXPECT_CHARACTER_TOKEN('b');
+    EXPECT_CHARACTER_TOKEN('\n');
+    EXPECT_CHARACTER_TOKEN('c');
+    EXPECT_CHARACTER_TOKEN(0xe9);
+    EXPECT_CHARACTER_TOKEN(0x20ac);
+    EXPECT_END_TAG_TOKEN(p);
+    EXPECT_END_OF_FILE_TOKEN();
+    END_ENUMERATION();
+}
+
+TEST_CASE(long_text)
+{
+    StringBuilder builder;
+    builder.append("<p>"sv);
+    for (size_t i = 0; i < 1000; ++i)
+        builder.append("\u00e9"sv);
+    builder.append("</p>"sv);
+    auto tokens = run_tokenizer(builder.string_view());
+    BEGIN_ENUMERATION(tokens);
+    EXPECT_START_TAG_TOKEN(p);
+    for (size_t i = 0; i < 1000; ++i) {
+        EXPECT_CHARACTER_TOKEN(0xe9);
+    }
+    EXPECT_END_TAG_TOKEN(p);
+    EXPECT_END_OF_FILE_TOKEN();
+    END_ENUMERATION();
+}
+
 TEST_CASE(comment)
 {
     auto tokens = run_tokenizer("<p><!-- This is a comment --></p>"sv);
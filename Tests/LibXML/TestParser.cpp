@@ -29,3 +29,25 @@ TEST_CASE(character_reference_integer_overflow)
         return Test::Crash::Failure::DidNotCrash;
     });
 }
+
+TEST_CASE(listener_sees_all_elements)
+{
+    struct RecordingListener : public XML::Listener {
+        virtual void element_start(XML::Name const& name, HashMap<XML::Name, DeprecatedString> const& attributes) override
+        {
+            builder.appendff("<{}", name);
+            for (auto const& attribute : attributes)
+                builder.appendff(" {}={}", attribute.key, attribute.value);
+            builder.append('>');
+        }
+        virtual void element_end(XML::Name const& name) override { builder.appendff("</{}>", name); }
+        virtual void text(StringView text) override { builder.append(text); }
+
+        StringBuilder builder;
+    };
+
+    RecordingListener listener;
+    XML::Parser parser("<svg><g><rect x=\"1\"/>text</g><circle/></svg>"sv);
+    EXPECT(!parser.parse_with_listener(listener).is_error());
+    EXPECT_EQ(listener.builder.string_view(), "<svg><g><rect x=1></rect>text</g><circle></circle></svg>"sv);
+}
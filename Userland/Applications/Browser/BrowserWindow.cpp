@@ -394,6 +394,15 @@ void BrowserWindow::build_menus()
     line_box_borders_action->set_checked(false);
     debug_menu.add_action(line_box_borders_action);
 
+    auto profile_javascript_action = GUI::Action::create_checkable(
+        "Profile &JavaScript", [this](auto& action) {
+            active_tab().view().debug_request("js-profiler", action.is_checked() ? "on" : "off");
+        },
+        this);
+    profile_javascript_action->set_status_tip("Sample the JavaScript call stacks and save a profile to the Downloads directory when stopped"sv);
+    profile_javascript_action->set_checked(false);
+    debug_menu.add_action(profile_javascript_action);
+
     debug_menu.add_separator();
     debug_menu.add_action(GUI::Action::create("Collect &Garbage", { Mod_Ctrl | Mod_Shift, Key_G }, g_icon_bag.trash_can, [this](auto&) {
         active_tab().view().debug_request("collect-garbage");
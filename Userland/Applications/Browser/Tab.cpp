@@ -17,10 +17,14 @@
 #include "History/HistoryWidget.h"
 #include "InspectorWidget.h"
 #include "StorageWidget.h"
+#include <AK/LexicalPath.h>
 #include <AK/StringBuilder.h>
 #include <AK/URL.h>
 #include <Applications/Browser/TabGML.h>
 #include <LibConfig/Client.h>
+#include <LibCore/DateTime.h>
+#include <LibCore/File.h>
+#include <LibCore/StandardPaths.h>
 #include <LibGUI/Action.h>
 #include <LibGUI/Application.h>
 #include <LibGUI/BoxLayout.h>
@@ -423,6 +427,19 @@ Tab::Tab(BrowserWindow& window)
         m_dom_inspector_widget->set_dom_node_properties_json({ node_id }, specified, computed, custom_properties, node_box_sizing);
     };
 
+    view().on_get_js_profile = [this](auto& profile) {
+        auto save_profile = [&]() -> ErrorOr<void> {
+            LexicalPath path { Core::StandardPaths::downloads_directory() };
+            path = path.append(Core::DateTime::now().to_deprecated_string("js-profile-%Y-%m-%d-%H-%M-%S.profile"sv));
+
+            auto profile_file = TRY(Core::File::open(path.string(), Core::File::OpenMode::Write));
+            TRY(profile_file->write_entire_buffer(profile.bytes()));
+            return {};
+        };
+        if (auto result = save_profile(); result.is_error())
+            GUI::MessageBox::show_error(&window(), DeprecatedString::formatted("Failed to save JS profile: {}", result.error()));
+    };
+
     view().on_get_accessibility_tree = [this](auto& accessibility_tree) {
         if (m_dom_inspector_widget)
             m_dom_inspector_widget->set_accessibility_json(accessibility_tree);
@@ -363,8 +363,10 @@ PDF::PDFErrorOr<void> PDFViewerWidget::try_open_file(StringView path, NonnullOwn
 {
     window()->set_title(DeprecatedString::formatted("{} - PDF Viewer", path));
 
-    m_buffer = TRY(file->read_until_eof());
-    auto document = TRY(PDF::Document::create(m_buffer));
+    m_mapped_file = TRY(Core::MappedFile::map_from_file(move(file), path));
+    // Objects are looked up through the cross-reference table, which sends us all over the file.
+    TRY(m_mapped_file->set_access_pattern(Core::MappedFile::AccessPattern::Random));
+    auto document = TRY(PDF::Document::create(m_mapped_file->bytes()));
 
     if (auto sh = document->security_handler(); sh && !sh->has_user_password()) {
         DeprecatedString password;
@@ -11,6 +11,7 @@
 #include "SidebarWidget.h"
 #include <AK/NonnullRefPtr.h>
 #include <AK/RefPtr.h>
+#include <LibCore/MappedFile.h>
 #include <LibGUI/Action.h>
 #include <LibGUI/ActionGroup.h>
 #include <LibGUI/CheckBox.h>
@@ -55,5 +56,5 @@ private:
     RefPtr<GUI::CheckBox> m_show_images;
 
     bool m_sidebar_open { false };
-    ByteBuffer m_buffer;
+    RefPtr<Core::MappedFile> m_mapped_file;
 };
@@ -98,6 +98,11 @@ void Cell::update_data(Badge<Sheet>)
 
     if (m_dirty) {
         m_dirty = false;
+        // The cells this one depends on are found again while evaluating it, so the ones it no longer looks at don't
+        // cause it to be evaluated again when they change.
+        if (!m_evaluated_externally)
+            forget_referenced_cells();
+
         if (m_kind == Formula) {
             if (!m_evaluated_externally) {
                 auto value_or_error = m_sheet->evaluate(m_data, this);
@@ -111,11 +116,10 @@ void Cell::update_data(Badge<Sheet>)
             }
         }
 
+        // Sheet::update() evaluates the cells that depend on this one after it, in order.
         for (auto& ref : m_referencing_cells) {
-            if (ref) {
+            if (ref && !ref->m_sheet->has_been_visited(ref.ptr()))
                 ref->m_dirty = true;
-                ref->update();
-            }
         }
     }
 
@@ -176,6 +180,16 @@ void Cell::reference_from(Cell* other)
         return;
 
     m_referencing_cells.append(other->make_weak_ptr());
+    other->m_referenced_cells.append(make_weak_ptr());
+}
+
+void Cell::forget_referenced_cells()
+{
+    for (auto& referenced_cell : m_referenced_cells) {
+        if (referenced_cell)
+            referenced_cell->m_referencing_cells.remove_all_matching([this](auto const& ptr) { return !ptr || ptr.ptr() == this; });
+    }
+    m_referenced_cells.clear();
 }
 
 void Cell::copy_from(Cell const& other)
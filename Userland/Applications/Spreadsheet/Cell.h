@@ -48,6 +48,7 @@ struct Cell : public Weakable<Cell> {
     void set_data(DeprecatedString new_data);
     void set_data(JS::Value new_data);
     bool dirty() const { return m_dirty; }
+    void mark_dirty() { m_dirty = true; }
     void clear_dirty() { m_dirty = false; }
 
     StringView name_for_javascript(Sheet const& sheet) const
@@ -114,6 +115,8 @@ struct Cell : public Weakable<Cell> {
     void copy_from(Cell const&);
 
 private:
+    void forget_referenced_cells();
+
     bool m_dirty { false };
     bool m_evaluated_externally { false };
     DeprecatedString m_data;
@@ -122,6 +125,7 @@ private:
     Kind m_kind { LiteralString };
     WeakPtr<Sheet> m_sheet;
     Vector<WeakPtr<Cell>> m_referencing_cells;
+    Vector<WeakPtr<Cell>> m_referenced_cells;
     CellType const* m_type { nullptr };
     CellTypeMetadata m_type_metadata;
     Position m_position;
@@ -128,22 +128,65 @@ void Sheet::update()
         return;
     }
     m_visited_cells_in_update.clear();
-    Vector<Cell&> cells_copy;
+    Vector<Cell&> dirty_cells;
 
     // Grab a copy as updates might insert cells into the table.
     for (auto& it : m_cells) {
         if (it.value->dirty()) {
-            cells_copy.append(*it.value);
+            dirty_cells.append(*it.value);
             m_workbook.set_dirty(true);
         }
     }
 
-    for (auto& cell : cells_copy)
+    // Only the cells that depend on the changed ones, directly or through other cells, have to be evaluated again.
+    // They're evaluated after all the cells they depend on, so that each of them is evaluated only once.
+    for (auto& cell : cells_in_dependency_order(dirty_cells)) {
+        cell.mark_dirty();
         update(cell);
+    }
 
     m_visited_cells_in_update.clear();
 }
 
+Vector<Cell&> Sheet::cells_in_dependency_order(Vector<Cell&>& changed_cells)
+{
+    // This is a depth-first search over the cells referencing the changed ones, which finishes a cell only after all
+    // the cells referencing it. Reversed, that puts every cell after the cells it references. Cycles are broken up
+    // where they are found; Sheet::update(Cell&) will ignore the rest of them.
+    struct PendingCell {
+        Cell* cell { nullptr };
+        size_t next_reference_index { 0 };
+    };
+    Vector<Cell&> finished_cells;
+    HashTable<Cell*> seen_cells;
+    Vector<PendingCell> stack;
+
+    for (auto& changed_cell : changed_cells) {
+        if (seen_cells.set(&changed_cell) != HashSetResult::InsertedNewEntry)
+            continue;
+        stack.append({ &changed_cell });
+
+        while (!stack.is_empty()) {
+            auto& pending = stack.last();
+            auto const& referencing_cells = pending.cell->referencing_cells();
+            if (pending.next_reference_index == referencing_cells.size()) {
+                finished_cells.append(*pending.cell);
+                stack.take_last();
+                continue;
+            }
+
+            auto& reference = referencing_cells[pending.next_reference_index++];
+            if (!reference || &reference->sheet() != this)
+                continue;
+            if (seen_cells.set(reference.ptr()) == HashSetResult::InsertedNewEntry)
+                stack.append({ reference.ptr() });
+        }
+    }
+
+    finished_cells.reverse();
+    return finished_cells;
+}
+
 void Sheet::update(Cell& cell)
 {
     if (m_should_ignore_updates) {
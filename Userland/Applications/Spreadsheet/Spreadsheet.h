@@ -148,6 +148,8 @@ private:
     explicit Sheet(Workbook&);
     explicit Sheet(StringView name, Workbook&);
 
+    Vector<Cell&> cells_in_dependency_order(Vector<Cell&>& changed_cells);
+
     DeprecatedString m_name;
     Vector<DeprecatedString> m_columns;
     size_t m_rows { 0 };
@@ -56,7 +56,7 @@ ErrorOr<NonnullRefPtr<CatDog>> CatDog::create()
 }
 
 CatDog::CatDog()
-    : m_proc_all(MUST(Core::File::open("/sys/kernel/processes"sv, Core::File::OpenMode::Read)))
+    : m_proc_all(MUST(Core::File::open("/sys/kernel/processes_binary"sv, Core::File::OpenMode::Read)))
 {
     m_idle_sleep_timer.start();
 }
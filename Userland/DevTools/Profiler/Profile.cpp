@@ -45,6 +45,13 @@ Profile::Profile(Vector<Process> processes, Vector<Event> events)
     m_first_timestamp = m_events.first().timestamp;
     m_last_timestamp = m_events.last().timestamp;
 
+    for (size_t i = 1; i < m_events.size(); ++i) {
+        if (m_events[i].timestamp < m_events[i - 1].timestamp) {
+            m_events_are_sorted_by_timestamp = false;
+            break;
+        }
+    }
+
     m_model = ProfileModel::create(*this);
     m_samples_model = SamplesModel::create(*this);
     m_signposts_model = SignpostsModel::create(*this);
@@ -104,7 +111,8 @@ void Profile::rebuild_tree()
     m_filtered_signpost_indices.clear();
     m_file_event_nodes->children().clear();
 
-    for (size_t event_index = 0; event_index < m_events.size(); ++event_index) {
+    auto event_indices = event_indices_in_filter_range();
+    for (size_t event_index = event_indices.start; event_index < event_indices.end; ++event_index) {
         auto& event = m_events.at(event_index);
 
         if (has_timestamp_filter_range()) {
@@ -268,6 +276,23 @@ ErrorOr<NonnullOwnPtr<Profile>> Profile::load_from_perfcore_file(StringView path
         return Error::from_string_literal("Malformed profile (events is not an array)");
     auto const& perf_events = events_value.value();
 
+    // Samples keep hitting the same addresses, so each of them only has to be symbolicated once.
+    struct CachedSymbol {
+        DeprecatedString symbol;
+        u32 offset { 0 };
+    };
+    HashMap<MappedObject const*, HashMap<FlatPtr, CachedSymbol>> symbol_cache;
+    auto symbolicate = [&](MappedObject const& object, FlatPtr address, u32& offset) {
+        auto& cached_symbols = symbol_cache.ensure(&object);
+        if (auto it = cached_symbols.find(address); it != cached_symbols.end()) {
+            offset = it->value.offset;
+            return it->value.symbol;
+        }
+        auto symbol = object.elf.symbolicate(address, &offset);
+        cached_symbols.set(address, { symbol, offset });
+        return symbol;
+    };
+
     NonnullOwnPtrVector<Process> all_processes;
     HashMap<pid_t, Process*> current_processes;
     Vector<Event> events;
@@ -407,6 +432,13 @@ ErrorOr<NonnullOwnPtr<Profile>> Profile::load_from_perfcore_file(StringView path
         auto const& stack_array = stack.value();
         for (ssize_t i = stack_array.values().size() - 1; i >= 0; --i) {
             auto const& frame = stack_array.at(i);
+
+            // NOTE: Profiles written by LibJS's SamplingProfiler contain already symbolicated frames.
+            if (frame.is_string()) {
+                event.frames.append({ "JavaScript"sv, frame.as_string(), 0, 0 });
+                continue;
+            }
+
             auto ptr = frame.to_number<u64>();
             u32 offset = 0;
             DeprecatedFlyString object_name;
@@ -414,7 +446,7 @@ ErrorOr<NonnullOwnPtr<Profile>> Profile::load_from_perfcore_file(StringView path
 
             if (maybe_kernel_base.has_value() && ptr >= maybe_kernel_base.value()) {
                 if (g_kernel_debuginfo_object.has_value()) {
-                    symbol = g_kernel_debuginfo_object->elf.symbolicate(ptr - maybe_kernel_base.value(), &offset);
+                    symbol = symbolicate(*g_kernel_debuginfo_object, ptr - maybe_kernel_base.value(), offset);
                 } else {
                     symbol = DeprecatedString::formatted("?? <{:p}>", ptr);
                 }
@@ -426,7 +458,10 @@ ErrorOr<NonnullOwnPtr<Profile>> Profile::load_from_perfcore_file(StringView path
                     library_metadata = &it->value->library_metadata;
                 if (auto const* library = library_metadata ? library_metadata->library_containing(ptr) : nullptr) {
                     object_name = library->name;
-                    symbol = library->symbolicate(ptr, &offset);
+                    if (library->object)
+                        symbol = symbolicate(*library->object, ptr - library->base, offset);
+                    else
+                        symbol = library->symbolicate(ptr, &offset);
                 } else {
                     symbol = DeprecatedString::formatted("?? <{:p}>", ptr);
                 }
@@ -461,6 +496,30 @@ ErrorOr<NonnullOwnPtr<Profile>> Profile::load_from_perfcore_file(StringView path
     return adopt_nonnull_own_or_enomem(new (nothrow) Profile(move(processes), move(events)));
 }
 
+Profile::EventIndexRange Profile::event_indices_in_filter_range() const
+{
+    if (!has_timestamp_filter_range() || !m_events_are_sorted_by_timestamp)
+        return { 0, m_events.size() };
+
+    auto first_event_index_where_not = [this](auto predicate) {
+        size_t low = 0;
+        size_t high = m_events.size();
+        while (low < high) {
+            auto middle = low + (high - low) / 2;
+            if (predicate(m_events[middle]))
+                low = middle + 1;
+            else
+                high = middle;
+        }
+        return low;
+    };
+
+    return {
+        first_event_index_where_not([this](Event const& event) { return event.timestamp < m_timestamp_filter_range_start; }),
+        first_event_index_where_not([this](Event const& event) { return event.timestamp <= m_timestamp_filter_range_end; }),
+    };
+}
+
 void ProfileNode::sort_children()
 {
     sort_profile_nodes(m_children);
@@ -72,16 +72,14 @@ public:
         VERIFY(!child.m_parent);
         child.m_parent = this;
         m_children.append(child);
+        if (!m_children_by_symbol.contains(child.symbol()))
+            m_children_by_symbol.set(child.symbol(), &child);
     }
 
     ProfileNode& find_or_create_child(DeprecatedFlyString const& object_name, DeprecatedString symbol, FlatPtr address, u32 offset, u64 timestamp, pid_t pid)
     {
-        for (size_t i = 0; i < m_children.size(); ++i) {
-            auto& child = m_children[i];
-            if (child->symbol() == symbol) {
-                return child;
-            }
-        }
+        if (auto child = m_children_by_symbol.get(symbol); child.has_value())
+            return *child.value();
         auto new_child = ProfileNode::create(m_process, object_name, move(symbol), address, offset, timestamp, pid);
         add_child(new_child);
         return new_child;
@@ -126,6 +124,8 @@ private:
     u32 m_self_count { 0 };
     u64 m_timestamp { 0 };
     Vector<NonnullRefPtr<ProfileNode>> m_children;
+    // Nodes can have thousands of children, so they aren't searched one by one while building the tree.
+    HashMap<DeprecatedString, ProfileNode*> m_children_by_symbol;
     HashMap<FlatPtr, size_t> m_events_per_address;
     Bitmap m_seen_events;
 };
@@ -266,7 +266,9 @@ public:
     template<typename Callback>
     void for_each_event_in_filter_range(Callback callback)
     {
-        for (auto& event : m_events) {
+        auto event_indices = event_indices_in_filter_range();
+        for (size_t event_index = event_indices.start; event_index < event_indices.end; ++event_index) {
+            auto& event = m_events[event_index];
             if (has_timestamp_filter_range()) {
                 auto timestamp = event.timestamp;
                 if (timestamp < m_timestamp_filter_range_start || timestamp > m_timestamp_filter_range_end)
@@ -291,6 +293,14 @@ private:
 
     void rebuild_tree();
 
+    // Events are normally recorded in timestamp order, in which case only those within the timestamp filter range
+    // have to be looked at.
+    struct EventIndexRange {
+        size_t start { 0 };
+        size_t end { 0 };
+    };
+    EventIndexRange event_indices_in_filter_range() const;
+
     RefPtr<ProfileModel> m_model;
     RefPtr<SamplesModel> m_samples_model;
     RefPtr<SignpostsModel> m_signposts_model;
@@ -308,6 +318,7 @@ private:
 
     Vector<Process> m_processes;
     Vector<Event> m_events;
+    bool m_events_are_sorted_by_timestamp { true };
     Vector<size_t> m_signpost_indices;
     Vector<size_t> m_filtered_signpost_indices;
 
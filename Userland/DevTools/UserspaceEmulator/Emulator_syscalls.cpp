@@ -800,6 +800,8 @@ u32 Emulator::virt$fcntl(int fd, int cmd, u32 arg)
     case F_GETFL:
     case F_SETFL:
     case F_ISTTY:
+    case F_GETPIPE_SZ:
+    case F_SETPIPE_SZ:
         break;
     default:
         dbgln("Invalid fcntl cmd: {}", cmd);
@@ -1005,6 +1007,7 @@ u32 Emulator::virt$mprotect(FlatPtr base, size_t size, int prot)
         }
         return IterationDecision::Continue;
     });
+    mmu().did_change_code();
     if (has_non_mmapped_region)
         return -EINVAL;
 
@@ -108,6 +108,8 @@ SoftCPU::SoftCPU(Emulator& emulator)
     , m_fpu(emulator, *this)
     , m_vpu(emulator, *this)
 {
+    m_instruction_cache.resize(instruction_cache_size);
+
     PartAddressableRegister empty_reg;
     explicit_bzero(&empty_reg, sizeof(empty_reg));
     for (auto& gpr : m_gpr)
@@ -141,11 +143,34 @@ void SoftCPU::update_code_cache()
         TODO();
     }
 
-    // FIXME: This cache needs to be invalidated if the code region is ever unmapped.
     m_cached_code_region = region;
     m_cached_code_base_ptr = region->data();
 }
 
+X86::Instruction const& SoftCPU::fetch_instruction()
+{
+    auto& mmu = m_emulator.mmu();
+    if (m_code_generation != mmu.code_generation()) {
+        // The region that was cached may have been unmapped, too.
+        m_code_generation = mmu.code_generation();
+        m_cached_code_region = nullptr;
+    }
+
+    auto& entry = m_instruction_cache[m_eip % instruction_cache_size];
+    if (entry.address == m_eip && entry.code_generation == m_code_generation && entry.instruction.has_value()) {
+        m_eip += entry.length;
+        return *entry.instruction;
+    }
+
+    auto address = m_eip;
+    entry.instruction = X86::Instruction::from_stream(*this, X86::ProcessorMode::Protected);
+    entry.address = address;
+    entry.code_generation = m_code_generation;
+    entry.length = m_eip - address;
+    mmu.did_cache_instructions_from({ cs(), address }, entry.length);
+    return *entry.instruction;
+}
+
 ValueWithShadow<u8> SoftCPU::read_memory8(X86::LogicalAddress address)
 {
     VERIFY(address.selector() == 0x1b || address.selector() == 0x23 || address.selector() == 0x2b);
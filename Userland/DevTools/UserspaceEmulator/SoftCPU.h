@@ -61,6 +61,10 @@ public:
         m_eip = eip;
     }
 
+    // Decodes the instruction at EIP and moves past it. Decoding takes longer than running most instructions, so they're
+    // only decoded again once the memory they came from has changed.
+    X86::Instruction const& fetch_instruction();
+
     struct Flags {
         enum Flag {
             CF = 0x0001, // 0b0000'0000'0000'0001
@@ -1366,6 +1370,16 @@ private:
 
     Region* m_cached_code_region { nullptr };
     u8* m_cached_code_base_ptr { nullptr };
+
+    struct CachedInstruction {
+        u32 address { 0 };
+        u32 code_generation { 0 };
+        u8 length { 0 };
+        Optional<X86::Instruction> instruction;
+    };
+    static constexpr size_t instruction_cache_size = 65536;
+    Vector<CachedInstruction> m_instruction_cache;
+    u32 m_code_generation { 0 };
 };
 
 ALWAYS_INLINE u8 SoftCPU::read8()
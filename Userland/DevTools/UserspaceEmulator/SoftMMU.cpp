@@ -31,6 +31,7 @@ void SoftMMU::add_region(NonnullOwnPtr<Region> region)
 
     m_regions.append(move(region));
     quick_sort((Vector<OwnPtr<Region>>&)m_regions, [](auto& a, auto& b) { return a->base() < b->base(); });
+    did_change_code();
 }
 
 void SoftMMU::remove_region(Region& region)
@@ -41,6 +42,7 @@ void SoftMMU::remove_region(Region& region)
     }
 
     m_regions.remove_first_matching([&](auto& entry) { return entry.ptr() == &region; });
+    did_change_code();
 }
 
 void SoftMMU::ensure_split_at(X86::LogicalAddress address)
@@ -90,6 +92,15 @@ void SoftMMU::set_tls_region(NonnullOwnPtr<Region> region)
     m_tls_region = move(region);
 }
 
+void SoftMMU::did_cache_instructions_from(X86::LogicalAddress address, size_t size)
+{
+    VERIFY(address.selector() != 0x2b);
+    size_t first_page = address.offset() / PAGE_SIZE;
+    size_t last_page = (address.offset() + size - 1) / PAGE_SIZE;
+    for (size_t page = first_page; page <= last_page; ++page)
+        m_page_has_cached_instructions[page] = true;
+}
+
 ValueWithShadow<u8> SoftMMU::read8(X86::LogicalAddress address)
 {
     auto* region = find_region(address);
@@ -212,6 +223,8 @@ void SoftMMU::write8(X86::LogicalAddress address, ValueWithShadow<u8> value)
         m_emulator.dump_backtrace();
         TODO();
     }
+
+    will_write(address, sizeof(u8));
     region->write8(address.offset() - region->base(), value);
 }
 
@@ -230,6 +243,7 @@ void SoftMMU::write16(X86::LogicalAddress address, ValueWithShadow<u16> value)
         TODO();
     }
 
+    will_write(address, sizeof(u16));
     region->write16(address.offset() - region->base(), value);
 }
 
@@ -248,6 +262,7 @@ void SoftMMU::write32(X86::LogicalAddress address, ValueWithShadow<u32> value)
         TODO();
     }
 
+    will_write(address, sizeof(u32));
     region->write32(address.offset() - region->base(), value);
 }
 
@@ -266,6 +281,7 @@ void SoftMMU::write64(X86::LogicalAddress address, ValueWithShadow<u64> value)
         TODO();
     }
 
+    will_write(address, sizeof(u64));
     region->write64(address.offset() - region->base(), value);
 }
 
@@ -284,6 +300,7 @@ void SoftMMU::write128(X86::LogicalAddress address, ValueWithShadow<u128> value)
         TODO();
     }
 
+    will_write(address, sizeof(u128));
     region->write128(address.offset() - region->base(), value);
 }
 
@@ -302,6 +319,7 @@ void SoftMMU::write256(X86::LogicalAddress address, ValueWithShadow<u256> value)
         TODO();
     }
 
+    will_write(address, sizeof(u256));
     region->write256(address.offset() - region->base(), value);
 }
 
@@ -345,6 +363,7 @@ bool SoftMMU::fast_fill_memory8(X86::LogicalAddress address, size_t size, ValueW
         }
     }
 
+    will_write(address, size);
     size_t offset_in_region = address.offset() - region->base();
     memset(region->data() + offset_in_region, value.value(), size);
     memset(region->shadow_data() + offset_in_region, value.shadow()[0], size);
@@ -370,6 +389,7 @@ bool SoftMMU::fast_fill_memory32(X86::LogicalAddress address, size_t count, Valu
         }
     }
 
+    will_write(address, count * sizeof(u32));
     size_t offset_in_region = address.offset() - region->base();
     fast_u32_fill((u32*)(region->data() + offset_in_region), value.value(), count);
     fast_u32_fill((u32*)(region->shadow_data() + offset_in_region), value.shadow_as_value(), count);
@@ -86,6 +86,13 @@ public:
 
     void set_tls_region(NonnullOwnPtr<Region>);
 
+    // The CPU keeps the instructions it has decoded around for as long as this stays the same. It changes whenever the
+    // memory they were decoded from may have changed: when regions are mapped, unmapped or protected differently, or
+    // when a page that instructions were decoded from is written to.
+    u32 code_generation() const { return m_code_generation; }
+    void did_change_code() { ++m_code_generation; }
+    void did_cache_instructions_from(X86::LogicalAddress, size_t size);
+
     bool fast_fill_memory8(X86::LogicalAddress, size_t size, ValueWithShadow<u8>);
     bool fast_fill_memory32(X86::LogicalAddress, size_t size, ValueWithShadow<u32>);
 
@@ -139,9 +146,25 @@ public:
     }
 
 private:
+    ALWAYS_INLINE void will_write(X86::LogicalAddress address, size_t size)
+    {
+        if (address.selector() == 0x2b)
+            return;
+        size_t first_page = address.offset() / PAGE_SIZE;
+        size_t last_page = (address.offset() + size - 1) / PAGE_SIZE;
+        for (size_t page = first_page; page <= last_page; ++page) {
+            if (m_page_has_cached_instructions[page]) [[unlikely]] {
+                m_page_has_cached_instructions[page] = false;
+                did_change_code();
+            }
+        }
+    }
+
     Emulator& m_emulator;
 
     Region* m_page_to_region_map[786432] = { nullptr };
+    bool m_page_has_cached_instructions[786432] = { false };
+    u32 m_code_generation { 0 };
 
     OwnPtr<Region> m_tls_region;
     NonnullOwnPtrVector<Region> m_regions;
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "cpu_features.h"
+#include <AK/Types.h>
+#include <string.h>
+
+extern "C" {
+
+extern void* memcpy_sse2(void*, void const*, size_t);
+extern void* memcpy_sse2_erms(void*, void const*, size_t);
+extern void* memmove_sse2(void*, void const*, size_t);
+extern void* memmove_sse2_erms(void*, void const*, size_t);
+
+namespace {
+[[gnu::used]] decltype(&memcpy) resolve_memcpy()
+{
+    if (has_fast_rep_string_instructions())
+        return memcpy_sse2_erms;
+
+    return memcpy_sse2;
+}
+
+[[gnu::used]] decltype(&memmove) resolve_memmove()
+{
+    if (has_fast_rep_string_instructions())
+        return memmove_sse2_erms;
+
+    return memmove_sse2;
+}
+}
+
+#if !defined(AK_COMPILER_CLANG) && !defined(_DYNAMIC_LOADER)
+[[gnu::ifunc("resolve_memcpy")]] void* memcpy(void*, void const*, size_t);
+[[gnu::ifunc("resolve_memmove")]] void* memmove(void*, void const*, size_t);
+#else
+// See memset.cpp for why we can't use IFUNCs here.
+void* memcpy(void* dest_ptr, void const* src_ptr, size_t n)
+{
+    static decltype(&memcpy) s_impl = nullptr;
+    if (s_impl == nullptr)
+        s_impl = resolve_memcpy();
+
+    return s_impl(dest_ptr, src_ptr, n);
+}
+
+void* memmove(void* dest_ptr, void const* src_ptr, size_t n)
+{
+    static decltype(&memmove) s_impl = nullptr;
+    if (s_impl == nullptr)
+        s_impl = resolve_memmove();
+
+    return s_impl(dest_ptr, src_ptr, n);
+}
+#endif
+}
@@ -115,6 +115,11 @@ struct MallocStats {
     size_t number_of_hot_keeps;
     size_t number_of_cold_keeps;
     size_t number_of_frees;
+
+    size_t number_of_thread_cache_hits;
+    size_t number_of_thread_cache_refills;
+    size_t number_of_thread_cache_keeps;
+    size_t number_of_thread_cache_flushes;
 };
 static MallocStats g_malloc_stats = {};
 
@@ -153,6 +158,45 @@ static inline BigAllocator (&big_allocators())[1]
     return reinterpret_cast<BigAllocator(&)[1]>(g_big_allocators_storage);
 }
 
+#ifndef NO_TLS
+// Every thread keeps a few free chunks of the smaller size classes for itself, so that most calls to
+// malloc() and free() don't have to take s_malloc_mutex at all. Chunks move between a thread cache and
+// their blocks in batches. As far as its block is concerned, a chunk sitting in a thread cache is still
+// in use, so a thread can put any chunk into its own cache, no matter which thread allocated it.
+constexpr size_t thread_cache_bytes_per_size_class = 16 * KiB;
+constexpr size_t thread_cache_max_chunks_per_size_class = 64;
+
+static constexpr size_t thread_cache_capacity(size_t size_class)
+{
+    return min(thread_cache_bytes_per_size_class / size_classes[size_class], thread_cache_max_chunks_per_size_class);
+}
+
+// How many chunks are moved in or out of a thread cache at once. Size classes that can't fit a
+// reasonable batch are not cached.
+static constexpr size_t thread_cache_batch_size(size_t size_class)
+{
+    auto batch_size = thread_cache_capacity(size_class) / 2;
+    return batch_size >= 2 ? batch_size : 0;
+}
+
+struct ThreadCache {
+    struct Bin {
+        FreelistEntry* chunks { nullptr };
+        size_t count { 0 };
+    };
+    Bin bins[num_size_classes];
+
+    // These are added to g_malloc_stats whenever we have to take the lock anyway.
+    size_t number_of_malloc_calls { 0 };
+    size_t number_of_free_calls { 0 };
+    size_t number_of_hits { 0 };
+    size_t number_of_keeps { 0 };
+
+    bool is_disabled { false };
+};
+static __thread ThreadCache s_thread_cache;
+#endif
+
 // --- BEGIN MATH ---
 // This stuff is only used for checking if there exists an aligned block in a
 // chunk. It has no bearing on the rest of the allocator, especially for
@@ -293,6 +337,225 @@ enum class CallerWillInitializeMemory {
 __thread bool s_allocation_enabled = true;
 #endif
 
+static ErrorOr<void*> allocate_chunk(Allocator& allocator, size_t align)
+{
+    auto good_size = allocator.size;
+
+    ChunkedBlock* block = nullptr;
+    void* ptr = nullptr;
+    for (auto& current : allocator.usable_blocks) {
+        if (current.free_chunks()) {
+            ptr = try_allocate_chunk_aligned(align, current);
+            if (ptr) {
+                block = &current;
+                break;
+            }
+        }
+    }
+
+    if (!block && s_hot_empty_block_count) {
+        g_malloc_stats.number_of_hot_empty_block_hits++;
+        block = s_hot_empty_blocks[--s_hot_empty_block_count];
+        if (block->m_size != good_size) {
+            new (block) ChunkedBlock(good_size);
+            ue_notify_chunk_size_changed(block, good_size);
+            char buffer[64];
+            snprintf(buffer, sizeof(buffer), "malloc: ChunkedBlock(%zu)", good_size);
+            set_mmap_name(block, ChunkedBlock::block_size, buffer);
+        }
+        allocator.usable_blocks.append(*block);
+    }
+
+    if (!block && s_cold_empty_block_count) {
+        g_malloc_stats.number_of_cold_empty_block_hits++;
+        block = s_cold_empty_blocks[--s_cold_empty_block_count];
+        int rc = madvise(block, ChunkedBlock::block_size, MADV_SET_NONVOLATILE);
+        bool this_block_was_purged = rc == 1;
+        if (rc < 0) {
+            perror("madvise");
+            VERIFY_NOT_REACHED();
+        }
+        rc = mprotect(block, ChunkedBlock::block_size, PROT_READ | PROT_WRITE);
+        if (rc < 0) {
+            perror("mprotect");
+            VERIFY_NOT_REACHED();
+        }
+        if (this_block_was_purged || block->m_size != good_size) {
+            if (this_block_was_purged)
+                g_malloc_stats.number_of_cold_empty_block_purge_hits++;
+            new (block) ChunkedBlock(good_size);
+            ue_notify_chunk_size_changed(block, good_size);
+        }
+        allocator.usable_blocks.append(*block);
+    }
+
+    if (!block) {
+        g_malloc_stats.number_of_block_allocs++;
+        char buffer[64];
+        snprintf(buffer, sizeof(buffer), "malloc: ChunkedBlock(%zu)", good_size);
+        block = (ChunkedBlock*)TRY(os_alloc(ChunkedBlock::block_size, buffer));
+        new (block) ChunkedBlock(good_size);
+        allocator.usable_blocks.append(*block);
+        ++allocator.block_count;
+    }
+
+    if (!ptr) {
+        ptr = try_allocate_chunk_aligned(align, *block);
+    }
+
+    VERIFY(ptr);
+    if (block->is_full()) {
+        g_malloc_stats.number_of_blocks_full++;
+        dbgln_if(MALLOC_DEBUG, "Block {:p} is now full in size class {}", block, good_size);
+        allocator.usable_blocks.remove(*block);
+        allocator.full_blocks.append(*block);
+    }
+    dbgln_if(MALLOC_DEBUG, "LibC: allocated {:p} (chunk in block {:p}, size {})", ptr, block, block->bytes_per_chunk());
+    return ptr;
+}
+
+static void free_chunk(ChunkedBlock& block, void* ptr)
+{
+    auto* entry = (FreelistEntry*)ptr;
+    entry->next = block.m_freelist;
+    block.m_freelist = entry;
+
+    if (block.is_full()) {
+        size_t good_size;
+        auto* allocator = allocator_for_size(block.m_size, good_size);
+        dbgln_if(MALLOC_DEBUG, "Block {:p} no longer full in size class {}", &block, good_size);
+        g_malloc_stats.number_of_freed_full_blocks++;
+        allocator->full_blocks.remove(block);
+        allocator->usable_blocks.prepend(block);
+    }
+
+    ++block.m_free_chunks;
+
+    if (!block.used_chunks()) {
+        size_t good_size;
+        auto* allocator = allocator_for_size(block.m_size, good_size);
+        if (s_hot_empty_block_count < number_of_hot_chunked_blocks_to_keep_around) {
+            dbgln_if(MALLOC_DEBUG, "Keeping hot block {:p} around", &block);
+            g_malloc_stats.number_of_hot_keeps++;
+            allocator->usable_blocks.remove(block);
+            s_hot_empty_blocks[s_hot_empty_block_count++] = &block;
+            return;
+        }
+        if (s_cold_empty_block_count < number_of_cold_chunked_blocks_to_keep_around) {
+            dbgln_if(MALLOC_DEBUG, "Keeping cold block {:p} around", &block);
+            g_malloc_stats.number_of_cold_keeps++;
+            allocator->usable_blocks.remove(block);
+            s_cold_empty_blocks[s_cold_empty_block_count++] = &block;
+            mprotect(&block, ChunkedBlock::block_size, PROT_NONE);
+            madvise(&block, ChunkedBlock::block_size, MADV_SET_VOLATILE);
+            return;
+        }
+        dbgln_if(MALLOC_DEBUG, "Releasing block {:p} for size class {}", &block, good_size);
+        g_malloc_stats.number_of_frees++;
+        allocator->usable_blocks.remove(block);
+        --allocator->block_count;
+        os_free(&block, ChunkedBlock::block_size);
+    }
+}
+
+#ifndef NO_TLS
+// Must be called with s_malloc_mutex held.
+static void merge_thread_cache_stats()
+{
+    g_malloc_stats.number_of_malloc_calls += exchange(s_thread_cache.number_of_malloc_calls, 0);
+    g_malloc_stats.number_of_free_calls += exchange(s_thread_cache.number_of_free_calls, 0);
+    g_malloc_stats.number_of_thread_cache_hits += exchange(s_thread_cache.number_of_hits, 0);
+    g_malloc_stats.number_of_thread_cache_keeps += exchange(s_thread_cache.number_of_keeps, 0);
+}
+
+static size_t size_class_of(Allocator const& allocator)
+{
+    return &allocator - &allocators()[0];
+}
+
+static ErrorOr<void*> thread_cache_allocate(Allocator& allocator)
+{
+    auto size_class = size_class_of(allocator);
+    auto& bin = s_thread_cache.bins[size_class];
+    if (auto* entry = bin.chunks) {
+        s_thread_cache.number_of_hits++;
+        bin.chunks = entry->next;
+        --bin.count;
+        return entry;
+    }
+
+    PthreadMutexLocker locker(s_malloc_mutex);
+    merge_thread_cache_stats();
+    g_malloc_stats.number_of_thread_cache_refills++;
+
+    auto* ptr = TRY(allocate_chunk(allocator, 16));
+    // Don't fail the allocation if we only couldn't get a full batch.
+    for (size_t i = 1; i < thread_cache_batch_size(size_class); ++i) {
+        auto chunk_or_error = allocate_chunk(allocator, 16);
+        if (chunk_or_error.is_error())
+            break;
+        auto* entry = (FreelistEntry*)chunk_or_error.value();
+        entry->next = bin.chunks;
+        bin.chunks = entry;
+        ++bin.count;
+    }
+    return ptr;
+}
+
+// Must be called with s_malloc_mutex held. Returns the chunks that were freed the longest time ago,
+// leaving only the first `chunks_to_keep` in the bin.
+static void thread_cache_flush(ThreadCache::Bin& bin, size_t chunks_to_keep)
+{
+    if (bin.count <= chunks_to_keep)
+        return;
+    g_malloc_stats.number_of_thread_cache_flushes++;
+
+    FreelistEntry** link = &bin.chunks;
+    for (size_t i = 0; i < chunks_to_keep; ++i)
+        link = &(*link)->next;
+
+    for (auto* entry = *link; entry;) {
+        auto* next = entry->next;
+        free_chunk(*(ChunkedBlock*)((FlatPtr)entry & ChunkedBlock::block_mask), entry);
+        entry = next;
+    }
+    *link = nullptr;
+    bin.count = chunks_to_keep;
+}
+
+// Returns whether the chunk could be kept in the thread cache.
+static bool thread_cache_free(ChunkedBlock& block, void* ptr)
+{
+    if (s_thread_cache.is_disabled)
+        return false;
+
+    size_t good_size;
+    auto* allocator = allocator_for_size(block.m_size, good_size);
+    auto size_class = size_class_of(*allocator);
+    if (!thread_cache_batch_size(size_class))
+        return false;
+
+    dbgln_if(MALLOC_DEBUG, "LibC: freeing {:p} into the thread cache (size={})", ptr, block.bytes_per_chunk());
+
+    if (s_scrub_free)
+        memset(ptr, FREE_SCRUB_BYTE, block.bytes_per_chunk());
+
+    auto& bin = s_thread_cache.bins[size_class];
+    auto* entry = (FreelistEntry*)ptr;
+    entry->next = bin.chunks;
+    bin.chunks = entry;
+    ++bin.count;
+    s_thread_cache.number_of_keeps++;
+
+    if (bin.count > thread_cache_capacity(size_class)) {
+        PthreadMutexLocker locker(s_malloc_mutex);
+        merge_thread_cache_stats();
+        thread_cache_flush(bin, bin.count - thread_cache_batch_size(size_class));
+    }
+    return true;
+}
+#endif
+
 static ErrorOr<void*> malloc_impl(size_t size, size_t align, CallerWillInitializeMemory caller_will_initialize_memory)
 {
 #ifndef NO_TLS
@@ -316,11 +579,25 @@ static ErrorOr<void*> malloc_impl(size_t size, size_t align, CallerWillInitializ
         size = 1;
     }
 
-    g_malloc_stats.number_of_malloc_calls++;
-
     size_t good_size;
     auto* allocator = allocator_for_size(size, good_size, align);
 
+#ifndef NO_TLS
+    s_thread_cache.number_of_malloc_calls++;
+
+    // Every chunk is 16-byte aligned already, so only stricter alignments need to go looking for a suitable chunk.
+    if (allocator && align <= 16 && !s_thread_cache.is_disabled && thread_cache_batch_size(size_class_of(*allocator))) {
+        auto* ptr = TRY(thread_cache_allocate(*allocator));
+        dbgln_if(MALLOC_DEBUG, "LibC: allocated {:p} from the thread cache (size {})", ptr, good_size);
+        if (s_scrub_malloc && caller_will_initialize_memory == CallerWillInitializeMemory::No)
+            memset(ptr, MALLOC_SCRUB_BYTE, good_size);
+        ue_notify_malloc(ptr, size);
+        return ptr;
+    }
+#else
+    g_malloc_stats.number_of_malloc_calls++;
+#endif
+
     PthreadMutexLocker locker(s_malloc_mutex);
 
     if (!allocator) {
@@ -365,79 +642,10 @@ static ErrorOr<void*> malloc_impl(size_t size, size_t align, CallerWillInitializ
         return ptr;
     }
 
-    ChunkedBlock* block = nullptr;
-    void* ptr = nullptr;
-    for (auto& current : allocator->usable_blocks) {
-        if (current.free_chunks()) {
-            ptr = try_allocate_chunk_aligned(align, current);
-            if (ptr) {
-                block = &current;
-                break;
-            }
-        }
-    }
-
-    if (!block && s_hot_empty_block_count) {
-        g_malloc_stats.number_of_hot_empty_block_hits++;
-        block = s_hot_empty_blocks[--s_hot_empty_block_count];
-        if (block->m_size != good_size) {
-            new (block) ChunkedBlock(good_size);
-            ue_notify_chunk_size_changed(block, good_size);
-            char buffer[64];
-            snprintf(buffer, sizeof(buffer), "malloc: ChunkedBlock(%zu)", good_size);
-            set_mmap_name(block, ChunkedBlock::block_size, buffer);
-        }
-        allocator->usable_blocks.append(*block);
-    }
-
-    if (!block && s_cold_empty_block_count) {
-        g_malloc_stats.number_of_cold_empty_block_hits++;
-        block = s_cold_empty_blocks[--s_cold_empty_block_count];
-        int rc = madvise(block, ChunkedBlock::block_size, MADV_SET_NONVOLATILE);
-        bool this_block_was_purged = rc == 1;
-        if (rc < 0) {
-            perror("madvise");
-            VERIFY_NOT_REACHED();
-        }
-        rc = mprotect(block, ChunkedBlock::block_size, PROT_READ | PROT_WRITE);
-        if (rc < 0) {
-            perror("mprotect");
-            VERIFY_NOT_REACHED();
-        }
-        if (this_block_was_purged || block->m_size != good_size) {
-            if (this_block_was_purged)
-                g_malloc_stats.number_of_cold_empty_block_purge_hits++;
-            new (block) ChunkedBlock(good_size);
-            ue_notify_chunk_size_changed(block, good_size);
-        }
-        allocator->usable_blocks.append(*block);
-    }
-
-    if (!block) {
-        g_malloc_stats.number_of_block_allocs++;
-        char buffer[64];
-        snprintf(buffer, sizeof(buffer), "malloc: ChunkedBlock(%zu)", good_size);
-        block = (ChunkedBlock*)TRY(os_alloc(ChunkedBlock::block_size, buffer));
-        new (block) ChunkedBlock(good_size);
-        allocator->usable_blocks.append(*block);
-        ++allocator->block_count;
-    }
-
-    if (!ptr) {
-        ptr = try_allocate_chunk_aligned(align, *block);
-    }
-
-    VERIFY(ptr);
-    if (block->is_full()) {
-        g_malloc_stats.number_of_blocks_full++;
-        dbgln_if(MALLOC_DEBUG, "Block {:p} is now full in size class {}", block, good_size);
-        allocator->usable_blocks.remove(*block);
-        allocator->full_blocks.append(*block);
-    }
-    dbgln_if(MALLOC_DEBUG, "LibC: allocated {:p} (chunk in block {:p}, size {})", ptr, block, block->bytes_per_chunk());
+    auto* ptr = TRY(allocate_chunk(*allocator, align));
 
     if (s_scrub_malloc && caller_will_initialize_memory == CallerWillInitializeMemory::No)
-        memset(ptr, MALLOC_SCRUB_BYTE, block->m_size);
+        memset(ptr, MALLOC_SCRUB_BYTE, good_size);
 
     ue_notify_malloc(ptr, size);
     return ptr;
@@ -454,11 +662,20 @@ static void free_impl(void* ptr)
     if (!ptr)
         return;
 
+#ifndef NO_TLS
+    s_thread_cache.number_of_free_calls++;
+#else
     g_malloc_stats.number_of_free_calls++;
+#endif
 
     void* block_base = (void*)((FlatPtr)ptr & ChunkedBlock::ChunkedBlock::block_mask);
     size_t magic = *(size_t*)block_base;
 
+#ifndef NO_TLS
+    if (magic == MAGIC_PAGE_HEADER && thread_cache_free(*(ChunkedBlock*)block_base, ptr))
+        return;
+#endif
+
     PthreadMutexLocker locker(s_malloc_mutex);
 
     if (magic == MAGIC_BIGALLOC_HEADER) {
@@ -494,46 +711,7 @@ static void free_impl(void* ptr)
     if (s_scrub_free)
         memset(ptr, FREE_SCRUB_BYTE, block->bytes_per_chunk());
 
-    auto* entry = (FreelistEntry*)ptr;
-    entry->next = block->m_freelist;
-    block->m_freelist = entry;
-
-    if (block->is_full()) {
-        size_t good_size;
-        auto* allocator = allocator_for_size(block->m_size, good_size);
-        dbgln_if(MALLOC_DEBUG, "Block {:p} no longer full in size class {}", block, good_size);
-        g_malloc_stats.number_of_freed_full_blocks++;
-        allocator->full_blocks.remove(*block);
-        allocator->usable_blocks.prepend(*block);
-    }
-
-    ++block->m_free_chunks;
-
-    if (!block->used_chunks()) {
-        size_t good_size;
-        auto* allocator = allocator_for_size(block->m_size, good_size);
-        if (s_hot_empty_block_count < number_of_hot_chunked_blocks_to_keep_around) {
-            dbgln_if(MALLOC_DEBUG, "Keeping hot block {:p} around", block);
-            g_malloc_stats.number_of_hot_keeps++;
-            allocator->usable_blocks.remove(*block);
-            s_hot_empty_blocks[s_hot_empty_block_count++] = block;
-            return;
-        }
-        if (s_cold_empty_block_count < number_of_cold_chunked_blocks_to_keep_around) {
-            dbgln_if(MALLOC_DEBUG, "Keeping cold block {:p} around", block);
-            g_malloc_stats.number_of_cold_keeps++;
-            allocator->usable_blocks.remove(*block);
-            s_cold_empty_blocks[s_cold_empty_block_count++] = block;
-            mprotect(block, ChunkedBlock::block_size, PROT_NONE);
-            madvise(block, ChunkedBlock::block_size, MADV_SET_VOLATILE);
-            return;
-        }
-        dbgln_if(MALLOC_DEBUG, "Releasing block {:p} for size class {}", block, good_size);
-        g_malloc_stats.number_of_frees++;
-        allocator->usable_blocks.remove(*block);
-        --allocator->block_count;
-        os_free(block, ChunkedBlock::block_size);
-    }
+    free_chunk(*block, ptr);
 }
 
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/malloc.html
@@ -682,8 +860,27 @@ void __malloc_init()
     new (&big_allocators()[0])(BigAllocator);
 }
 
+void __malloc_thread_exit()
+{
+#ifndef NO_TLS
+    // Anything freed from here on (e.g. by TLS destructors) goes straight back to its block.
+    s_thread_cache.is_disabled = true;
+
+    PthreadMutexLocker locker(s_malloc_mutex);
+    merge_thread_cache_stats();
+    for (auto& bin : s_thread_cache.bins)
+        thread_cache_flush(bin, 0);
+#endif
+}
+
 void serenity_dump_malloc_stats()
 {
+#ifndef NO_TLS
+    {
+        PthreadMutexLocker locker(s_malloc_mutex);
+        merge_thread_cache_stats();
+    }
+#endif
     dbgln("# malloc() calls: {}", g_malloc_stats.number_of_malloc_calls);
     dbgln();
     dbgln("big alloc hits: {}", g_malloc_stats.number_of_big_allocator_hits);
@@ -705,5 +902,10 @@ void serenity_dump_malloc_stats()
     dbgln("number of hot keeps: {}", g_malloc_stats.number_of_hot_keeps);
     dbgln("number of cold keeps: {}", g_malloc_stats.number_of_cold_keeps);
     dbgln("number of frees: {}", g_malloc_stats.number_of_frees);
+    dbgln();
+    dbgln("thread cache hits: {}", g_malloc_stats.number_of_thread_cache_hits);
+    dbgln("thread cache refills: {}", g_malloc_stats.number_of_thread_cache_refills);
+    dbgln("thread cache keeps: {}", g_malloc_stats.number_of_thread_cache_keeps);
+    dbgln("thread cache flushes: {}", g_malloc_stats.number_of_thread_cache_flushes);
 }
 }
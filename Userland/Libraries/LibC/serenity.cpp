@@ -101,6 +101,18 @@ int anon_create(size_t size, int options)
     __RETURN_WITH_ERRNO(rc, rc, -1);
 }
 
+int create_io_ring(unsigned submission_entry_count, unsigned flags)
+{
+    int rc = syscall(SC_create_io_ring, submission_entry_count, flags);
+    __RETURN_WITH_ERRNO(rc, rc, -1);
+}
+
+int io_ring_enter(int fd, unsigned to_submit)
+{
+    int rc = syscall(SC_io_ring_enter, fd, to_submit);
+    __RETURN_WITH_ERRNO(rc, rc, -1);
+}
+
 int serenity_readlink(char const* path, size_t path_length, char* buffer, size_t buffer_size)
 {
     Syscall::SC_readlink_params small_params {
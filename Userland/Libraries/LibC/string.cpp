@@ -128,22 +128,18 @@ int timingsafe_memcmp(void const* b1, void const* b2, size_t len)
 }
 
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/memcpy.html
-void* memcpy(void* dest_ptr, void const* src_ptr, size_t n)
-{
+// For x86-64, an optimized ASM implementation is found in ./arch/x86_64/memcpy.S
 #if ARCH(X86_64)
-    void* original_dest = dest_ptr;
-    asm volatile(
-        "rep movsb"
-        : "+D"(dest_ptr), "+S"(src_ptr), "+c"(n)::"memory");
-    return original_dest;
 #else
+void* memcpy(void* dest_ptr, void const* src_ptr, size_t n)
+{
     u8* pd = (u8*)dest_ptr;
     u8 const* ps = (u8 const*)src_ptr;
     for (; n--;)
         *pd++ = *ps++;
     return dest_ptr;
-#endif
 }
+#endif
 
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/memset.html
 // For x86-64, an optimized ASM implementation is found in ./arch/x86_64/memset.S
@@ -159,6 +155,9 @@ void* memset(void* dest_ptr, int c, size_t n)
 #endif
 
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/memmove.html
+// For x86-64, an optimized ASM implementation is found in ./arch/x86_64/memcpy.S
+#if ARCH(X86_64)
+#else
 void* memmove(void* dest, void const* src, size_t n)
 {
     if (((FlatPtr)dest - (FlatPtr)src) >= n)
@@ -170,6 +169,7 @@ void* memmove(void* dest, void const* src, size_t n)
         *--pd = *--ps;
     return dest;
 }
+#endif
 
 void const* memmem(void const* haystack, size_t haystack_length, void const* needle, size_t needle_length)
 {
@@ -239,13 +239,10 @@ char* strchrnul(char const* str, int c)
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/memchr.html
 void* memchr(void const* ptr, int c, size_t size)
 {
-    char ch = c;
-    auto* cptr = (char const*)ptr;
-    for (size_t i = 0; i < size; ++i) {
-        if (cptr[i] == ch)
-            return const_cast<char*>(cptr + i);
-    }
-    return nullptr;
+    auto index = AK::memchr_optional(ptr, size, static_cast<u8>(c));
+    if (!index.has_value())
+        return nullptr;
+    return const_cast<u8*>(static_cast<u8 const*>(ptr) + *index);
 }
 
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/strrchr.html
@@ -340,20 +337,17 @@ char* strsignal(int signum)
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/strstr.html
 char* strstr(char const* haystack, char const* needle)
 {
-    char nch;
-    char hch;
+    auto needle_length = strlen(needle);
+    if (needle_length == 0)
+        return const_cast<char*>(haystack);
 
-    if ((nch = *needle++) != 0) {
-        size_t len = strlen(needle);
-        do {
-            do {
-                if ((hch = *haystack++) == 0)
-                    return nullptr;
-            } while (hch != nch);
-        } while (strncmp(haystack, needle, len) != 0);
-        --haystack;
-    }
-    return const_cast<char*>(haystack);
+    // Only look as far as the first occurrence of the needle's first character before doing a full search,
+    // so that finding something near the start of a long string doesn't require measuring all of it.
+    haystack = strchr(haystack, *needle);
+    if (!haystack)
+        return nullptr;
+    auto const* result = AK::memmem(haystack, strlen(haystack), needle, needle_length);
+    return const_cast<char*>(static_cast<char const*>(result));
 }
 
 // https://linux.die.net/man/3/strcasestr
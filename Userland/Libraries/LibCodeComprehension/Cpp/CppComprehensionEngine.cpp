@@ -11,6 +11,7 @@
 #include <AK/ScopeGuard.h>
 #include <LibCore/DeprecatedFile.h>
 #include <LibCore/DirIterator.h>
+#include <LibCore/EventLoop.h>
 #include <LibCpp/AST.h>
 #include <LibCpp/Lexer.h>
 #include <LibCpp/Parser.h>
@@ -28,7 +29,7 @@ CppComprehensionEngine::CppComprehensionEngine(FileDB const& filedb)
 CppComprehensionEngine::DocumentData const* CppComprehensionEngine::get_or_create_document_data(DeprecatedString const& file)
 {
     auto absolute_path = filedb().to_absolute_path(file);
-    if (!m_documents.contains(absolute_path)) {
+    if (m_edited_documents.remove(absolute_path) || !m_documents.contains(absolute_path)) {
         set_document_data(absolute_path, create_document_data_for(absolute_path));
     }
     return get_document_data(absolute_path);
@@ -367,6 +368,9 @@ DeprecatedString CppComprehensionEngine::document_path_from_include_path(StringV
     static Regex<PosixExtended> library_include("<(.+)>");
     static Regex<PosixExtended> user_defined_include("\"(.+)\"");
 
+    if (auto document_path = m_document_paths_by_include_path.get(include_path); document_path.has_value())
+        return *document_path;
+
     auto document_path_for_library_include = [&](StringView include_path) -> DeprecatedString {
         RegexResult result;
         if (!library_include.search(include_path, result))
@@ -388,12 +392,28 @@ DeprecatedString CppComprehensionEngine::document_path_from_include_path(StringV
     if (result.is_null())
         result = document_path_for_user_defined_include(include_path);
 
+    m_document_paths_by_include_path.set(include_path, result);
     return result;
 }
 
 void CppComprehensionEngine::on_edit(DeprecatedString const& file)
 {
-    set_document_data(file, create_document_data_for(file));
+    m_edited_documents.set(filedb().to_absolute_path(file));
+    if (m_update_of_edited_documents_pending)
+        return;
+
+    m_update_of_edited_documents_pending = true;
+    Core::deferred_invoke([this] {
+        m_update_of_edited_documents_pending = false;
+        update_edited_documents();
+    });
+}
+
+void CppComprehensionEngine::update_edited_documents()
+{
+    auto edited_documents = move(m_edited_documents);
+    for (auto const& file : edited_documents)
+        set_document_data(file, create_document_data_for(file));
 }
 
 void CppComprehensionEngine::file_opened([[maybe_unused]] DeprecatedString const& file)
@@ -558,7 +578,7 @@ RefPtr<Cpp::Declaration const> CppComprehensionEngine::find_declaration_of(Docum
 
     Optional<Symbol> match;
 
-    for_each_available_symbol(document_data, [&](Symbol const& symbol) {
+    for_each_available_symbol_named(document_data, target_decl->name, [&](Symbol const& symbol) {
         if (symbol_matches(symbol)) {
             match = symbol;
             return IterationDecision::Break;
@@ -578,6 +598,9 @@ void CppComprehensionEngine::update_declared_symbols(DocumentData& document)
         document.m_symbols.set(symbol.name, move(symbol));
     }
 
+    for (auto const& symbol_entry : document.m_symbols)
+        document.m_symbol_names_by_name.ensure(symbol_entry.key.name).append(symbol_entry.key);
+
     Vector<CodeComprehension::Declaration> declarations;
     for (auto& symbol_entry : document.m_symbols) {
         auto& symbol = symbol_entry.value;
@@ -754,7 +777,7 @@ Optional<Vector<CodeComprehension::AutocompleteResultEntry>> CppComprehensionEng
 RefPtr<Cpp::Declaration const> CppComprehensionEngine::find_declaration_of(CppComprehensionEngine::DocumentData const& document, CppComprehensionEngine::SymbolName const& target_symbol_name) const
 {
     RefPtr<Cpp::Declaration const> target_declaration;
-    for_each_available_symbol(document, [&](Symbol const& symbol) {
+    for_each_available_symbol_named(document, target_symbol_name.name, [&](Symbol const& symbol) {
         if (symbol.name == target_symbol_name) {
             target_declaration = symbol.declaration;
             return IterationDecision::Break;
@@ -92,6 +92,9 @@ private:
         OwnPtr<Parser> m_parser;
 
         HashMap<SymbolName, Symbol> m_symbols;
+        // Finding a declaration only ever considers symbols of the same name, so they're looked up through this instead
+        // of going over all of the symbols of the document and the headers it includes.
+        HashMap<StringView, Vector<SymbolName>> m_symbol_names_by_name;
         HashTable<DeprecatedString> m_available_headers;
     };
 
@@ -119,6 +122,7 @@ private:
     void set_document_data(DeprecatedString const& file, OwnPtr<DocumentData>&& data);
 
     OwnPtr<DocumentData> create_document_data_for(DeprecatedString const& file);
+    void update_edited_documents();
     DeprecatedString document_path_from_include_path(StringView include_path) const;
     void update_declared_symbols(DocumentData&);
     void update_todo_entries(DocumentData&);
@@ -139,6 +143,9 @@ private:
     template<typename Func>
     void for_each_available_symbol(DocumentData const&, Func) const;
 
+    template<typename Func>
+    void for_each_available_symbol_named(DocumentData const&, StringView name, Func) const;
+
     template<typename Func>
     void for_each_included_document_recursive(DocumentData const&, Func) const;
 
@@ -151,6 +158,14 @@ private:
     // A document is added to this set when we start processing it (e.g because it was #included) and removed when we're done.
     // We use this to prevent circular #includes from looping indefinitely.
     HashTable<DeprecatedString> m_unfinished_documents;
+
+    // Every keystroke is an edit, so edited documents are only parsed again once the edits that have already arrived are
+    // handled (or once the document is needed before that), instead of once per edit.
+    HashTable<DeprecatedString> m_edited_documents;
+    bool m_update_of_edited_documents_pending { false };
+
+    // Resolving an include path to a document path is done for each #include every time a document is parsed.
+    mutable HashMap<DeprecatedString, DeprecatedString> m_document_paths_by_include_path;
 };
 
 template<typename Func>
@@ -172,6 +187,28 @@ void CppComprehensionEngine::for_each_available_symbol(DocumentData const& docum
     });
 }
 
+template<typename Func>
+void CppComprehensionEngine::for_each_available_symbol_named(DocumentData const& document, StringView name, Func func) const
+{
+    auto for_each_symbol_in_document = [&](DocumentData const& document) {
+        auto symbol_names = document.m_symbol_names_by_name.get(name);
+        if (!symbol_names.has_value())
+            return IterationDecision::Continue;
+
+        for (auto const& symbol_name : *symbol_names) {
+            auto decision = func(document.m_symbols.get(symbol_name).value());
+            if (decision == IterationDecision::Break)
+                return IterationDecision::Break;
+        }
+        return IterationDecision::Continue;
+    };
+
+    if (for_each_symbol_in_document(document) == IterationDecision::Break)
+        return;
+
+    for_each_included_document_recursive(document, for_each_symbol_in_document);
+}
+
 template<typename Func>
 void CppComprehensionEngine::for_each_included_document_recursive(DocumentData const& document, Func func) const
 {
@@ -181,7 +218,7 @@ void CppComprehensionEngine::for_each_included_document_recursive(DocumentData c
             continue;
         auto decision = func(*included_document);
         if (decision == IterationDecision::Break)
-            continue;
+            return;
     }
 }
 }
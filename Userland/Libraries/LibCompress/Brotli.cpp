@@ -4,28 +4,96 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
-#include <AK/BinarySearch.h>
+#include <AK/BuiltinWrappers.h>
+#include <AK/MemoryStream.h>
 #include <AK/QuickSort.h>
 #include <LibCompress/Brotli.h>
 #include <LibCompress/BrotliDictionary.h>
 
 namespace Compress {
 
-ErrorOr<size_t> BrotliDecompressionStream::CanonicalCode::read_symbol(LittleEndianInputBitStream& input_stream)
+ErrorOr<size_t> BrotliDecompressionStream::CanonicalCode::read_symbol(LittleEndianInputBitStream& input_stream) const
 {
-    size_t code_bits = 1;
+    if (m_single_symbol.has_value())
+        return m_single_symbol.value();
 
-    while (code_bits < (1 << 16)) {
-        // FIXME: This is very inefficient and could greatly be improved by implementing this
-        //        algorithm: https://www.hanshq.net/zip.html#huffdec
-        size_t index;
-        if (binary_search(m_symbol_codes.span(), code_bits, &index))
-            return m_symbol_values[index];
+    // Bits past the end of the stream are peeked as zeros, discarding them is what fails if the code is actually truncated.
+    auto const bits = TRY(input_stream.peek_bits<u16>(max_code_length));
 
-        code_bits = (code_bits << 1) | TRY(input_stream.read_bit());
+    auto entry = m_lookup_table[bits & ((1 << root_table_bits) - 1)];
+    if (entry.subtable_bits != 0)
+        entry = m_lookup_table[entry.value + ((bits >> root_table_bits) & ((1 << entry.subtable_bits) - 1))];
+
+    if (entry.code_length == 0)
+        return Error::from_string_literal("no matching code found");
+
+    TRY(input_stream.discard_previously_peeked_bits(entry.code_length));
+    return entry.value;
+}
+
+void BrotliDecompressionStream::CanonicalCode::build_lookup_table()
+{
+    constexpr size_t root_table_size = 1 << root_table_bits;
+    constexpr u16 root_mask = root_table_size - 1;
+
+    m_lookup_table.clear();
+    m_single_symbol.clear();
+    if (m_symbol_codes.size() == 1 && m_symbol_codes[0] == 1) {
+        m_single_symbol = m_symbol_values[0];
+        return;
+    }
+
+    // The codes are read msb-first, but the lookup table is indexed by bits in the order they appear in the stream.
+    struct Code {
+        u16 reversed_code;
+        u8 length;
+    };
+    Vector<Code> codes;
+    codes.ensure_capacity(m_symbol_codes.size());
+    for (auto symbol_code : m_symbol_codes) {
+        u8 const length = sizeof(symbol_code) * 8 - 1 - count_leading_zeroes(symbol_code);
+        VERIFY(length <= max_code_length);
+        u16 reversed_code = 0;
+        for (size_t i = 0; i < length; ++i)
+            reversed_code |= ((symbol_code >> i) & 1) << (length - 1 - i);
+        codes.unchecked_append({ reversed_code, length });
+    }
+
+    // Every long code that shares a root prefix ends up in the same second-level table, which has to be large enough for the longest of them.
+    Array<u8, root_table_size> subtable_bits {};
+    for (auto const& code : codes) {
+        if (code.length > root_table_bits) {
+            auto& bits = subtable_bits[code.reversed_code & root_mask];
+            bits = max(bits, static_cast<u8>(code.length - root_table_bits));
+        }
     }
 
-    return Error::from_string_literal("no matching code found");
+    size_t table_size = root_table_size;
+    m_lookup_table.resize(table_size);
+    for (size_t prefix = 0; prefix < root_table_size; ++prefix) {
+        if (subtable_bits[prefix] == 0)
+            continue;
+        m_lookup_table[prefix] = { static_cast<u16>(table_size), 0, subtable_bits[prefix] };
+        table_size += 1 << subtable_bits[prefix];
+    }
+    m_lookup_table.resize(table_size);
+
+    // A code of length n occupies every entry whose lowest n index bits match it.
+    for (size_t i = 0; i < codes.size(); ++i) {
+        auto const [reversed_code, length] = codes[i];
+        LookupEntry const entry { static_cast<u16>(m_symbol_values[i]), length, 0 };
+
+        if (length <= root_table_bits) {
+            for (size_t index = reversed_code; index < root_table_size; index += 1 << length)
+                m_lookup_table[index] = entry;
+            continue;
+        }
+
+        auto const& root_entry = m_lookup_table[reversed_code & root_mask];
+        auto const subtable_size = 1u << root_entry.subtable_bits;
+        for (size_t index = reversed_code >> root_table_bits; index < subtable_size; index += 1 << (length - root_table_bits))
+            m_lookup_table[root_entry.value + index] = entry;
+    }
 }
 
 BrotliDecompressionStream::BrotliDecompressionStream(Stream& stream)
@@ -181,6 +249,7 @@ ErrorOr<void> BrotliDecompressionStream::read_prefix_code(CanonicalCode& code, s
         TRY(read_complex_prefix_code(code, alphabet_size, hskip));
     }
 
+    code.build_lookup_table();
     return {};
 }
 
@@ -290,6 +359,8 @@ ErrorOr<void> BrotliDecompressionStream::read_complex_prefix_code(CanonicalCode&
         }
     }
 
+    temp_code.build_lookup_table();
+
     // Read the actual prefix code_value
     sum = 0;
     size_t i = 0;
@@ -581,7 +652,10 @@ ErrorOr<Bytes> BrotliDecompressionStream::read(Bytes output_buffer)
             size_t window_bits = TRY(read_window_length());
             m_window_size = (1 << window_bits) - 16;
 
-            m_lookback_buffer = TRY(LookbackBuffer::try_create(m_window_size));
+            if (m_output_as_history)
+                m_lookback_buffer = LookbackBuffer::create_over_output(*m_output_as_history);
+            else
+                m_lookback_buffer = TRY(LookbackBuffer::try_create(m_window_size));
 
             m_current_state = State::Idle;
         } else if (m_current_state == State::Idle) {
@@ -745,6 +819,7 @@ ErrorOr<Bytes> BrotliDecompressionStream::read(Bytes output_buffer)
             if (uncompressed_bytes.is_empty())
                 return Error::from_string_literal("eof");
 
+            m_lookback_buffer.value().write(uncompressed_bytes);
             m_bytes_left -= uncompressed_bytes.size();
             bytes_read += uncompressed_bytes.size();
 
@@ -786,19 +861,22 @@ ErrorOr<Bytes> BrotliDecompressionStream::read(Bytes output_buffer)
                 m_current_state = State::CompressedDistance;
             }
         } else if (m_current_state == State::CompressedLiteral) {
-            if (m_literal_block.length == 0) {
-                TRY(block_read_new_state(m_literal_block));
-            }
-            m_literal_block.length--;
+            // The literals of one command are read in one go, as far as the output buffer allows.
+            size_t literal_count = min(min(m_insert_length, m_bytes_left), output_buffer.size() - bytes_read);
+            for (size_t i = 0; i < literal_count; ++i) {
+                if (m_literal_block.length == 0) {
+                    TRY(block_read_new_state(m_literal_block));
+                }
+                m_literal_block.length--;
 
-            size_t literal_code_index = literal_code_index_from_context();
-            size_t literal_value = TRY(m_literal_codes[literal_code_index].read_symbol(m_input_stream));
+                size_t literal_code_index = literal_code_index_from_context();
+                size_t literal_value = TRY(m_literal_codes[literal_code_index].read_symbol(m_input_stream));
 
-            output_buffer[bytes_read] = literal_value;
-            m_lookback_buffer.value().write(literal_value);
-            bytes_read++;
-            m_insert_length--;
-            m_bytes_left--;
+                output_buffer[bytes_read++] = literal_value;
+                m_lookback_buffer.value().write(literal_value);
+            }
+            m_insert_length -= literal_count;
+            m_bytes_left -= literal_count;
 
             if (m_bytes_left == 0)
                 m_current_state = State::Idle;
@@ -887,6 +965,8 @@ ErrorOr<Bytes> BrotliDecompressionStream::read(Bytes output_buffer)
                 size_t offset = ((2 + (hcode & 1)) << ndistbits) - 4;
                 distance = ((offset + dextra) << m_postfix_bits) + lcode + m_direct_distances + 1;
             }
+            if (distance == 0)
+                return Error::from_string_literal("invalid distance");
             m_distance = distance;
 
             size_t total_written = m_lookback_buffer.value().total_written();
@@ -912,13 +992,11 @@ ErrorOr<Bytes> BrotliDecompressionStream::read(Bytes output_buffer)
                 m_current_state = State::CompressedCopy;
             }
         } else if (m_current_state == State::CompressedCopy) {
-            u8 copy_value = m_lookback_buffer.value().lookback(m_distance);
-
-            output_buffer[bytes_read] = copy_value;
-            m_lookback_buffer.value().write(copy_value);
-            bytes_read++;
-            m_copy_length--;
-            m_bytes_left--;
+            size_t copy_length = min(min(m_copy_length, m_bytes_left), output_buffer.size() - bytes_read);
+            m_lookback_buffer.value().copy_from_lookback(output_buffer.slice(bytes_read, copy_length), m_distance);
+            bytes_read += copy_length;
+            m_copy_length -= copy_length;
+            m_bytes_left -= copy_length;
 
             if (m_bytes_left == 0)
                 m_current_state = State::Idle;
@@ -926,13 +1004,14 @@ ErrorOr<Bytes> BrotliDecompressionStream::read(Bytes output_buffer)
                 m_current_state = State::CompressedCommand;
         } else if (m_current_state == State::CompressedDictionary) {
             size_t offset = m_dictionary_data.size() - m_copy_length;
-            u8 dictionary_value = m_dictionary_data[offset];
+            size_t copy_length = min(min(m_copy_length, m_bytes_left), output_buffer.size() - bytes_read);
+            auto dictionary_bytes = m_dictionary_data.bytes().slice(offset, copy_length);
 
-            output_buffer[bytes_read] = dictionary_value;
-            m_lookback_buffer.value().write(dictionary_value);
-            bytes_read++;
-            m_copy_length--;
-            m_bytes_left--;
+            dictionary_bytes.copy_to(output_buffer.slice(bytes_read));
+            m_lookback_buffer.value().write(dictionary_bytes);
+            bytes_read += copy_length;
+            m_copy_length -= copy_length;
+            m_bytes_left -= copy_length;
 
             if (m_bytes_left == 0)
                 m_current_state = State::Idle;
@@ -944,6 +1023,28 @@ ErrorOr<Bytes> BrotliDecompressionStream::read(Bytes output_buffer)
     return output_buffer.slice(0, bytes_read);
 }
 
+ErrorOr<ByteBuffer> BrotliDecompressionStream::decompress_all(ReadonlyBytes bytes)
+{
+    FixedMemoryStream memory_stream { bytes };
+    BrotliDecompressionStream brotli_stream { memory_stream };
+
+    // The decompressed size isn't stored anywhere, so this is just a guess for the buffer to grow from. Decompressing into
+    // one buffer means that it holds all the history that back-references can refer to, so there's no need for a ring buffer.
+    ByteBuffer output;
+    TRY(output.try_resize(max(bytes.size() * 4, 4 * KiB)));
+    brotli_stream.m_output_as_history = &output;
+
+    size_t output_size = 0;
+    while (!brotli_stream.is_eof()) {
+        if (output_size == output.size())
+            TRY(output.try_resize(output.size() * 2));
+        output_size += TRY(brotli_stream.read(output.bytes().slice(output_size))).size();
+    }
+
+    output.resize(output_size);
+    return output;
+}
+
 bool BrotliDecompressionStream::is_eof() const
 {
     return m_read_final_block && m_current_state == State::Idle;
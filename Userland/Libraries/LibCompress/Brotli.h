@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/BitStream.h>
+#include <AK/ByteBuffer.h>
 #include <AK/CircularQueue.h>
 #include <AK/FixedArray.h>
 #include <AK/Vector.h>
@@ -31,16 +32,36 @@ public:
 
     public:
         CanonicalCode() = default;
-        ErrorOr<size_t> read_symbol(LittleEndianInputBitStream&);
+        ErrorOr<size_t> read_symbol(LittleEndianInputBitStream&) const;
         void clear()
         {
             m_symbol_codes.clear();
             m_symbol_values.clear();
+            m_lookup_table.clear();
+            m_single_symbol.clear();
         }
 
     private:
+        static constexpr size_t max_code_length = 15;
+        static constexpr size_t root_table_bits = 8;
+
+        void build_lookup_table();
+
+        // The codes are collected msb-first, with a leading 1 bit that marks their length.
         Vector<size_t> m_symbol_codes;
         Vector<size_t> m_symbol_values;
+
+        // Decoding - indexed by the next bits of input (lsb-first), like the Deflate CanonicalCode. Codes longer than
+        // root_table_bits continue in a second-level table.
+        struct LookupEntry {
+            u16 value { 0 };        // The symbol, or the offset of the second-level table if subtable_bits is non-zero.
+            u8 code_length { 0 };   // Zero if no code starts with these bits.
+            u8 subtable_bits { 0 }; // The second-level table is indexed by this many bits following the root bits.
+        };
+        Vector<LookupEntry> m_lookup_table;
+
+        // A prefix code with a single symbol uses zero bits per symbol.
+        Optional<u16> m_single_symbol;
     };
 
     struct Block {
@@ -54,6 +75,8 @@ public:
         CanonicalCode length_code;
     };
 
+    // Remembers the last window_size bytes of output. When everything is decompressed into one buffer, that buffer
+    // holds the whole history already, and only has to be looked at instead of being copied into a ring buffer.
     class LookbackBuffer {
     private:
         LookbackBuffer(FixedArray<u8>& buffer)
@@ -61,6 +84,11 @@ public:
         {
         }
 
+        explicit LookbackBuffer(ByteBuffer const& output)
+            : m_output(&output)
+        {
+        }
+
     public:
         static ErrorOr<LookbackBuffer> try_create(size_t size)
         {
@@ -68,16 +96,41 @@ public:
             return LookbackBuffer { buffer };
         }
 
+        // The bytes passed to write() have to be the ones that were just appended to `output`.
+        static LookbackBuffer create_over_output(ByteBuffer const& output)
+        {
+            return LookbackBuffer { output };
+        }
+
         void write(u8 value)
         {
-            m_buffer[m_offset] = value;
-            m_offset = (m_offset + 1) % m_buffer.size();
+            if (!m_output) {
+                m_buffer[m_offset] = value;
+                m_offset = (m_offset + 1) % m_buffer.size();
+            }
             m_total_written++;
         }
 
+        void write(ReadonlyBytes bytes)
+        {
+            m_total_written += bytes.size();
+            if (m_output)
+                return;
+            if (bytes.size() >= m_buffer.size()) {
+                bytes = bytes.slice_from_end(m_buffer.size());
+                m_offset = 0;
+            }
+            auto first_part = min(bytes.size(), m_buffer.size() - m_offset);
+            bytes.trim(first_part).copy_to(m_buffer.span().slice(m_offset));
+            bytes.slice(first_part).copy_to(m_buffer.span());
+            m_offset = (m_offset + bytes.size()) % m_buffer.size();
+        }
+
         u8 lookback(size_t offset) const
         {
             VERIFY(offset <= m_total_written);
+            if (m_output)
+                return (*m_output)[m_total_written - offset];
             VERIFY(offset <= m_buffer.size());
             size_t index = (m_offset + m_buffer.size() - offset) % m_buffer.size();
             return m_buffer[index];
@@ -85,18 +138,42 @@ public:
 
         u8 lookback(size_t offset, u8 fallback) const
         {
-            if (offset > m_total_written || offset > m_buffer.size())
+            if (offset > m_total_written || (!m_output && offset > m_buffer.size()))
                 return fallback;
-            VERIFY(offset <= m_total_written);
-            VERIFY(offset <= m_buffer.size());
-            size_t index = (m_offset + m_buffer.size() - offset) % m_buffer.size();
-            return m_buffer[index];
+            return lookback(offset);
+        }
+
+        // Fills `output` with the bytes starting `distance` bytes back, which repeat if the distance is shorter than
+        // the output, and remembers them.
+        void copy_from_lookback(Bytes output, size_t distance)
+        {
+            VERIFY(distance > 0 && distance <= m_total_written);
+            size_t copied = min(distance, output.size());
+            if (m_output) {
+                m_output->bytes().slice(m_total_written - distance, copied).copy_to(output);
+            } else {
+                VERIFY(distance <= m_buffer.size());
+                size_t start = (m_offset + m_buffer.size() - distance) % m_buffer.size();
+                auto first_part = min(copied, m_buffer.size() - start);
+                m_buffer.span().slice(start, first_part).copy_to(output);
+                m_buffer.span().slice(0, copied - first_part).copy_to(output.slice(first_part));
+            }
+
+            // Everything after the first `distance` bytes is a repetition of them.
+            while (copied < output.size()) {
+                auto chunk = min(copied - copied % distance, output.size() - copied);
+                output.slice(0, chunk).copy_to(output.slice(copied));
+                copied += chunk;
+            }
+
+            write(output);
         }
 
         size_t total_written() { return m_total_written; }
 
     private:
         FixedArray<u8> m_buffer;
+        ByteBuffer const* m_output { nullptr };
         size_t m_offset { 0 };
         size_t m_total_written { 0 };
     };
@@ -104,6 +181,8 @@ public:
 public:
     BrotliDecompressionStream(Stream&);
 
+    static ErrorOr<ByteBuffer> decompress_all(ReadonlyBytes);
+
     ErrorOr<Bytes> read(Bytes output_buffer) override;
     ErrorOr<size_t> write(ReadonlyBytes bytes) override { return m_input_stream.write(bytes); }
     bool is_eof() const override;
@@ -130,6 +209,7 @@ private:
     LittleEndianInputBitStream m_input_stream;
     State m_current_state { State::WindowSize };
     Optional<LookbackBuffer> m_lookback_buffer;
+    ByteBuffer const* m_output_as_history { nullptr };
 
     size_t m_window_size { 0 };
     bool m_read_final_block { false };
@@ -8,8 +8,8 @@
 #include <AK/Array.h>
 #include <AK/Assertions.h>
 #include <AK/BinaryHeap.h>
-#include <AK/BinarySearch.h>
 #include <AK/BitStream.h>
+#include <AK/BuiltinWrappers.h>
 #include <AK/MemoryStream.h>
 #include <string.h>
 
@@ -23,29 +23,15 @@ static constexpr u8 deflate_special_code_length_long_zeros = 18;
 
 CanonicalCode const& CanonicalCode::fixed_literal_codes()
 {
-    static CanonicalCode code;
-    static bool initialized = false;
-
-    if (initialized)
-        return code;
-
-    code = CanonicalCode::from_bytes(fixed_literal_bit_lengths).value();
-    initialized = true;
-
+    // NOTE: This is initialized on first use in a thread-safe manner, as several threads may be decompressing at once.
+    static CanonicalCode const code = CanonicalCode::from_bytes(fixed_literal_bit_lengths).value();
     return code;
 }
 
 CanonicalCode const& CanonicalCode::fixed_distance_codes()
 {
-    static CanonicalCode code;
-    static bool initialized = false;
-
-    if (initialized)
-        return code;
-
-    code = CanonicalCode::from_bytes(fixed_distance_bit_lengths).value();
-    initialized = true;
-
+    // NOTE: This is initialized on first use in a thread-safe manner, as several threads may be decompressing at once.
+    static CanonicalCode const code = CanonicalCode::from_bytes(fixed_distance_bit_lengths).value();
     return code;
 }
 
@@ -64,10 +50,9 @@ Optional<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
         }
     }
     if (non_zero_symbols == 1) { // special case - only 1 symbol
-        code.m_symbol_codes.append(0b10);
-        code.m_symbol_values.append(last_non_zero);
         code.m_bit_codes[last_non_zero] = 0;
         code.m_bit_code_lengths[last_non_zero] = 1;
+        code.build_lookup_table();
         return code;
     }
 
@@ -83,8 +68,6 @@ Optional<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
             if (next_code > start_bit)
                 return {};
 
-            code.m_symbol_codes.append(start_bit | next_code);
-            code.m_symbol_values.append(symbol);
             code.m_bit_codes[symbol] = fast_reverse16(start_bit | next_code, code_length); // DEFLATE writes huffman encoded symbols as lsb-first
             code.m_bit_code_lengths[symbol] = code_length;
 
@@ -96,26 +79,73 @@ Optional<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
         return {};
     }
 
+    code.build_lookup_table();
     return code;
 }
 
-ErrorOr<u32> CanonicalCode::read_symbol(LittleEndianInputBitStream& stream) const
+void CanonicalCode::build_lookup_table()
 {
-    u32 code_bits = 1;
-
-    for (;;) {
-        code_bits = code_bits << 1 | TRY(stream.read_bits(1));
-        if (code_bits >= (1 << 16))
-            return Error::from_string_literal("Symbol exceeds maximum symbol number");
-
-        // FIXME: This is very inefficient and could greatly be improved by implementing this
-        //        algorithm: https://www.hanshq.net/zip.html#huffdec
-        size_t index;
-        if (binary_search(m_symbol_codes.span(), code_bits, &index))
-            return m_symbol_values[index];
+    constexpr size_t root_table_size = 1 << root_table_bits;
+    constexpr u16 root_mask = root_table_size - 1;
+
+    // Every long code that shares a root prefix ends up in the same second-level table, which has to be large enough for the longest of them.
+    Array<u8, root_table_size> subtable_bits {};
+    for (size_t symbol = 0; symbol < m_bit_code_lengths.size(); ++symbol) {
+        auto const length = m_bit_code_lengths[symbol];
+        if (length > root_table_bits) {
+            auto& bits = subtable_bits[m_bit_codes[symbol] & root_mask];
+            bits = max(bits, static_cast<u8>(length - root_table_bits));
+        }
+    }
+
+    size_t table_size = root_table_size;
+    m_lookup_table.resize(table_size);
+    for (size_t prefix = 0; prefix < root_table_size; ++prefix) {
+        if (subtable_bits[prefix] == 0)
+            continue;
+        m_lookup_table[prefix] = { static_cast<u16>(table_size), 0, subtable_bits[prefix] };
+        table_size += 1 << subtable_bits[prefix];
+    }
+    m_lookup_table.resize(table_size);
+
+    // Codes are read lsb-first, so a code of length n occupies every entry whose lowest n index bits match it.
+    for (size_t symbol = 0; symbol < m_bit_code_lengths.size(); ++symbol) {
+        auto const length = m_bit_code_lengths[symbol];
+        if (length == 0)
+            continue;
+
+        auto const bit_code = m_bit_codes[symbol];
+        LookupEntry const entry { static_cast<u16>(symbol), static_cast<u8>(length), 0 };
+
+        if (length <= root_table_bits) {
+            for (size_t index = bit_code; index < root_table_size; index += 1 << length)
+                m_lookup_table[index] = entry;
+            continue;
+        }
+
+        auto const& root_entry = m_lookup_table[bit_code & root_mask];
+        auto const subtable_size = 1u << root_entry.subtable_bits;
+        for (size_t index = bit_code >> root_table_bits; index < subtable_size; index += 1 << (length - root_table_bits))
+            m_lookup_table[root_entry.value + index] = entry;
     }
 }
 
+ErrorOr<u32> CanonicalCode::read_symbol(LittleEndianInputBitStream& stream) const
+{
+    // Bits past the end of the stream are peeked as zeros, discarding them is what fails if the code is actually truncated.
+    auto const bits = TRY(stream.peek_bits<u16>(max_code_length));
+
+    auto entry = m_lookup_table[bits & ((1 << root_table_bits) - 1)];
+    if (entry.subtable_bits != 0)
+        entry = m_lookup_table[entry.value + ((bits >> root_table_bits) & ((1 << entry.subtable_bits) - 1))];
+
+    if (entry.code_length == 0)
+        return Error::from_string_literal("Symbol exceeds maximum symbol number");
+
+    TRY(stream.discard_previously_peeked_bits(entry.code_length));
+    return entry.value;
+}
+
 ErrorOr<void> CanonicalCode::write_symbol(LittleEndianOutputBitStream& stream, u32 symbol) const
 {
     TRY(stream.write_bits(m_bit_codes[symbol], m_bit_code_lengths[symbol]));
@@ -134,38 +164,50 @@ ErrorOr<bool> DeflateDecompressor::CompressedBlock::try_read_more()
     if (m_eof == true)
         return false;
 
-    auto const symbol = TRY(m_literal_codes.read_symbol(*m_decompressor.m_input_stream));
+    auto& input_stream = *m_decompressor.m_input_stream;
+    auto& output_buffer = m_decompressor.m_output_buffer;
 
-    if (symbol >= 286)
-        return Error::from_string_literal("Invalid deflate literal/length symbol");
+    // Decode symbols for as long as the longest possible back-reference still fits into the output buffer, instead of
+    // returning to the caller for every single one.
+    constexpr size_t max_back_reference_length = 258;
+    do {
+        auto const symbol = TRY(m_literal_codes.read_symbol(input_stream));
+
+        if (symbol >= 286)
+            return Error::from_string_literal("Invalid deflate literal/length symbol");
+
+        if (symbol < 256) {
+            u8 byte_symbol = symbol;
+            output_buffer.write({ &byte_symbol, sizeof(byte_symbol) });
+            continue;
+        }
+
+        if (symbol == 256) {
+            m_eof = true;
+            break;
+        }
 
-    if (symbol < 256) {
-        u8 byte_symbol = symbol;
-        m_decompressor.m_output_buffer.write({ &byte_symbol, sizeof(byte_symbol) });
-        return true;
-    } else if (symbol == 256) {
-        m_eof = true;
-        return false;
-    } else {
         if (!m_distance_codes.has_value())
             return Error::from_string_literal("Distance codes have not been initialized");
 
         auto const length = TRY(m_decompressor.decode_length(symbol));
-        auto const distance_symbol = TRY(m_distance_codes.value().read_symbol(*m_decompressor.m_input_stream));
+        auto const distance_symbol = TRY(m_distance_codes.value().read_symbol(input_stream));
         if (distance_symbol >= 30)
             return Error::from_string_literal("Invalid deflate distance symbol");
 
         auto const distance = TRY(m_decompressor.decode_distance(distance_symbol));
 
-        for (size_t idx = 0; idx < length; ++idx) {
-            u8 byte = 0;
-            TRY(m_decompressor.m_output_buffer.read_with_seekback({ &byte, sizeof(byte) }, distance));
-
-            m_decompressor.m_output_buffer.write({ &byte, sizeof(byte) });
+        // A back-reference may overlap the bytes it produces, so only up to `distance` bytes can be copied at once.
+        Array<u8, max_back_reference_length> buffer;
+        size_t remaining = length;
+        while (remaining > 0) {
+            auto const copied = TRY(output_buffer.read_with_seekback(buffer.span().trim(min(remaining, distance)), distance));
+            output_buffer.write(copied);
+            remaining -= copied.size();
         }
+    } while (output_buffer.empty_space() >= max_back_reference_length);
 
-        return true;
-    }
+    return true;
 }
 
 DeflateDecompressor::UncompressedBlock::UncompressedBlock(DeflateDecompressor& decompressor, size_t length)
@@ -190,13 +232,19 @@ ErrorOr<bool> DeflateDecompressor::UncompressedBlock::try_read_more()
 }
 
 ErrorOr<NonnullOwnPtr<DeflateDecompressor>> DeflateDecompressor::construct(MaybeOwned<Stream> stream)
+{
+    auto bit_stream = TRY(try_make<LittleEndianInputBitStream>(move(stream)));
+    return construct(MaybeOwned<LittleEndianInputBitStream>(move(bit_stream)));
+}
+
+ErrorOr<NonnullOwnPtr<DeflateDecompressor>> DeflateDecompressor::construct(MaybeOwned<LittleEndianInputBitStream> stream)
 {
     auto output_buffer = TRY(CircularBuffer::create_empty(32 * KiB));
     return TRY(adopt_nonnull_own_or_enomem(new (nothrow) DeflateDecompressor(move(stream), move(output_buffer))));
 }
 
-DeflateDecompressor::DeflateDecompressor(MaybeOwned<Stream> stream, CircularBuffer output_buffer)
-    : m_input_stream(make<LittleEndianInputBitStream>(move(stream)))
+DeflateDecompressor::DeflateDecompressor(MaybeOwned<LittleEndianInputBitStream> stream, CircularBuffer output_buffer)
+    : m_input_stream(move(stream))
     , m_output_buffer(move(output_buffer))
 {
 }
@@ -510,6 +558,26 @@ u16 DeflateCompressor::hash_sequence(u8 const* bytes)
     return ((bytes[0] | bytes[1] << 8 | bytes[2] << 16 | bytes[3] << 24) * knuth_constant) >> (32 - hash_bits);
 }
 
+// Compares 8 bytes at a time, the first differing byte is then found from the lowest set bit of their difference.
+size_t DeflateCompressor::common_prefix_length(u8 const* first, u8 const* second, size_t max_length)
+{
+    size_t length = 0;
+    while (length + sizeof(u64) <= max_length) {
+        u64 first_word;
+        u64 second_word;
+        __builtin_memcpy(&first_word, first + length, sizeof(u64));
+        __builtin_memcpy(&second_word, second + length, sizeof(u64));
+        auto const difference = AK::convert_between_host_and_little_endian(first_word ^ second_word);
+        if (difference != 0)
+            return length + count_trailing_zeroes(difference) / 8;
+        length += sizeof(u64);
+    }
+
+    while (length < max_length && first[length] == second[length])
+        length++;
+    return length;
+}
+
 size_t DeflateCompressor::compare_match_candidate(size_t start, size_t candidate, size_t previous_match_length, size_t maximum_match_length)
 {
     VERIFY(previous_match_length < maximum_match_length);
@@ -522,9 +590,7 @@ size_t DeflateCompressor::compare_match_candidate(size_t start, size_t candidate
 
     // Find the actual length
     auto match_length = previous_match_length + 1;
-    while (match_length < maximum_match_length && m_rolling_window[start + match_length] == m_rolling_window[candidate + match_length]) {
-        match_length++;
-    }
+    match_length += common_prefix_length(&m_rolling_window[start + match_length], &m_rolling_window[candidate + match_length], maximum_match_length - match_length);
 
     VERIFY(match_length > previous_match_length);
     VERIFY(match_length <= maximum_match_length);
@@ -571,6 +637,36 @@ size_t DeflateCompressor::find_back_match(size_t start, u16 hash, size_t previou
     return previous_match_length; // we found matches, but they were at most previous_match_length long
 }
 
+size_t DeflateCompressor::find_all_back_matches(size_t start, u16 hash, size_t maximum_match_length, Vector<Match>& matches)
+{
+    // Candidates are visited from the closest to the furthest one, so only matches that are longer than all previous ones are worth keeping.
+    size_t longest_match_length = min_match_length - 1;
+    if (longest_match_length >= maximum_match_length)
+        return 0;
+
+    auto max_chain_length = m_compression_constants.max_chain;
+    auto candidate = m_hash_head[hash];
+    while (max_chain_length-- && candidate != empty_slot) {
+        VERIFY(candidate < start);
+        if (start - candidate > window_size)
+            break; // outside the window
+
+        if (m_rolling_window[start + longest_match_length] == m_rolling_window[candidate + longest_match_length]) {
+            auto match_length = common_prefix_length(&m_rolling_window[start], &m_rolling_window[candidate], maximum_match_length);
+            if (match_length > longest_match_length) {
+                matches.append({ static_cast<u16>(match_length), static_cast<u16>(start - candidate) });
+                longest_match_length = match_length;
+                if (match_length == maximum_match_length)
+                    break;
+            }
+        }
+
+        candidate = m_hash_prev[candidate % window_size];
+    }
+
+    return longest_match_length >= min_match_length ? longest_match_length : 0;
+}
+
 ALWAYS_INLINE u8 DeflateCompressor::distance_to_base(u16 distance)
 {
     return (distance <= 256) ? distance_to_base_lo[distance - 1] : distance_to_base_hi[(distance - 1) >> 7];
@@ -648,35 +744,88 @@ void DeflateCompressor::generate_huffman_lengths(Array<u8, Size>& lengths, Array
     }
 }
 
+ALWAYS_INLINE void DeflateCompressor::insert_hash(size_t position, u16 hash)
+{
+    auto window_position = position % window_size;
+    m_hash_prev[window_position] = m_hash_head[hash];
+    m_hash_head[hash] = window_position;
+}
+
+ALWAYS_INLINE void DeflateCompressor::emit_literal(u16 literal)
+{
+    VERIFY(m_pending_symbol_size <= block_size + 1);
+    auto index = m_pending_symbol_size++;
+    m_symbol_buffer[index].distance = 0;
+    m_symbol_buffer[index].literal = literal;
+    m_symbol_frequencies[literal]++;
+}
+
+ALWAYS_INLINE void DeflateCompressor::emit_back_reference(u16 distance, u16 length)
+{
+    VERIFY(m_pending_symbol_size <= block_size + 1);
+    auto index = m_pending_symbol_size++;
+    m_symbol_buffer[index].distance = distance;
+    m_symbol_buffer[index].length = length;
+    m_symbol_frequencies[length_to_symbol[length]]++;
+    m_distance_frequencies[distance_to_base(distance)]++;
+}
+
 void DeflateCompressor::lz77_compress_block()
 {
     for (auto& slot : m_hash_head) { // initialize chained hash table
         slot = empty_slot;
     }
 
-    auto insert_hash = [&](auto pos, auto hash) {
-        auto window_pos = pos % window_size;
-        m_hash_prev[window_pos] = m_hash_head[hash];
-        m_hash_head[hash] = window_pos;
-    };
+    switch (m_compression_level) {
+    case CompressionLevel::FAST:
+        lz77_compress_block_greedy();
+        break;
+    case CompressionLevel::BEST:
+        lz77_compress_block_optimal();
+        break;
+    default:
+        lz77_compress_block_lazy();
+        break;
+    }
+}
 
-    auto emit_literal = [&](auto literal) {
-        VERIFY(m_pending_symbol_size <= block_size + 1);
-        auto index = m_pending_symbol_size++;
-        m_symbol_buffer[index].distance = 0;
-        m_symbol_buffer[index].literal = literal;
-        m_symbol_frequencies[literal]++;
-    };
+void DeflateCompressor::lz77_compress_block_greedy()
+{
+    // Inserting every position covered by a long match is what takes the most time, and long matches tend to be followed by more of the same anyway.
+    constexpr size_t max_inserted_match_length = 16;
 
-    auto emit_back_reference = [&](auto distance, auto length) {
-        VERIFY(m_pending_symbol_size <= block_size + 1);
-        auto index = m_pending_symbol_size++;
-        m_symbol_buffer[index].distance = distance;
-        m_symbol_buffer[index].length = length;
-        m_symbol_frequencies[length_to_symbol[length]]++;
-        m_distance_frequencies[distance_to_base(distance)]++;
-    };
+    auto block_end = block_size + m_pending_block_size;
+    size_t current_position = block_size;
+    while (current_position < block_end - min_match_length + 1) {
+        auto hash = hash_sequence(&m_rolling_window[current_position]);
+        auto candidate = m_hash_head[hash];
+        insert_hash(current_position, hash);
 
+        size_t match_length = 0;
+        if (candidate != empty_slot)
+            match_length = common_prefix_length(&m_rolling_window[current_position], &m_rolling_window[candidate], min(max_match_length, block_end - current_position));
+
+        if (match_length < min_match_length) {
+            emit_literal(m_rolling_window[current_position++]);
+            continue;
+        }
+
+        emit_back_reference(current_position - candidate, match_length);
+        if (match_length <= max_inserted_match_length) {
+            for (size_t j = current_position + 1; j < min(current_position + match_length, block_end - min_match_length + 1); j++)
+                insert_hash(j, hash_sequence(&m_rolling_window[j]));
+        }
+        current_position += match_length;
+    }
+
+    // output remaining literals
+    while (current_position < block_end) {
+        emit_literal(m_rolling_window[current_position++]);
+    }
+}
+
+void DeflateCompressor::lz77_compress_block_lazy()
+{
     size_t previous_match_length = 0;
     size_t previous_match_position = 0;
 
@@ -733,6 +882,109 @@ void DeflateCompressor::lz77_compress_block()
     }
 }
 
+void DeflateCompressor::lz77_compress_block_optimal()
+{
+    auto block_end = block_size + m_pending_block_size;
+    auto const block_length = m_pending_block_size;
+
+    // Collect every match that is longer than the closer ones for each position. Positions covered by a match of the maximum length are
+    // not searched, as there's nothing better to be found there.
+    Vector<Match> matches;
+    Vector<u32> first_match_index;
+    first_match_index.resize(block_length + 1);
+
+    size_t current_position = block_size;
+    while (current_position < block_end) {
+        first_match_index[current_position - block_size] = matches.size();
+        if (current_position >= block_end - min_match_length + 1) {
+            current_position++;
+            continue;
+        }
+
+        auto hash = hash_sequence(&m_rolling_window[current_position]);
+        auto maximum_match_length = min(m_compression_constants.great_match_length, block_end - current_position);
+        auto longest_match_length = find_all_back_matches(current_position, hash, maximum_match_length, matches);
+        insert_hash(current_position, hash);
+
+        if (longest_match_length < maximum_match_length) {
+            current_position++;
+            continue;
+        }
+
+        for (size_t j = current_position + 1; j < current_position + longest_match_length; j++) {
+            first_match_index[j - block_size] = matches.size();
+            if (j < block_end - min_match_length + 1)
+                insert_hash(j, hash_sequence(&m_rolling_window[j]));
+        }
+        current_position += longest_match_length;
+    }
+    first_match_index[block_length] = matches.size();
+
+    // Find the cheapest way to encode the block, going backwards from its end. The costs of the symbols start out as those of the fixed
+    // Huffman codes, and are then refined once with the codes that the first parse would end up with.
+    Array<u8, max_huffman_literals> literal_bit_lengths = fixed_literal_bit_lengths;
+    Array<u8, max_huffman_distances> distance_bit_lengths = fixed_distance_bit_lengths;
+
+    Vector<u32> costs;
+    costs.resize(block_length + 1);
+    Vector<Match> choices;
+    choices.resize(block_length);
+
+    auto find_cheapest_parse = [&] {
+        Array<u32, max_huffman_distances> distance_costs;
+        for (size_t i = 0; i < 30; i++)
+            distance_costs[i] = distance_bit_lengths[i] + packed_distances[i].extra_bits;
+
+        costs[block_length] = 0;
+        for (size_t i = block_length; i-- > 0;) {
+            costs[i] = costs[i + 1] + literal_bit_lengths[m_rolling_window[block_size + i]];
+            choices[i] = { 1, 0 };
+
+            size_t length = min_match_length;
+            for (size_t j = first_match_index[i]; j < first_match_index[i + 1]; j++) {
+                auto const& match = matches[j];
+                auto const distance_cost = distance_costs[distance_to_base(match.distance)];
+                for (; length <= match.length; length++) {
+                    auto const symbol = length_to_symbol[length];
+                    auto const cost = costs[i + length] + literal_bit_lengths[symbol] + packed_length_symbols[symbol - 257].extra_bits + distance_cost;
+                    if (cost < costs[i]) {
+                        costs[i] = cost;
+                        choices[i] = { static_cast<u16>(length), match.distance };
+                    }
+                }
+            }
+        }
+    };
+
+    find_cheapest_parse();
+
+    Array<u16, max_huffman_literals> literal_frequencies;
+    Array<u16, max_huffman_distances> distance_frequencies;
+    // Every symbol gets a non-zero frequency, so that symbols that went unused in the first parse aren't considered free.
+    literal_frequencies.fill(1);
+    distance_frequencies.fill(1);
+    for (size_t i = 0; i < block_length; i += choices[i].length) {
+        if (choices[i].distance == 0) {
+            literal_frequencies[m_rolling_window[block_size + i]]++;
+        } else {
+            literal_frequencies[length_to_symbol[choices[i].length]]++;
+            distance_frequencies[distance_to_base(choices[i].distance)]++;
+        }
+    }
+    literal_frequencies[256]++; // end of block
+    generate_huffman_lengths(literal_bit_lengths, literal_frequencies, 15);
+    generate_huffman_lengths(distance_bit_lengths, distance_frequencies, 15);
+
+    find_cheapest_parse();
+
+    for (size_t i = 0; i < block_length; i += choices[i].length) {
+        if (choices[i].distance == 0)
+            emit_literal(m_rolling_window[block_size + i]);
+        else
+            emit_back_reference(choices[i].distance, choices[i].length);
+    }
+}
+
 size_t DeflateCompressor::huffman_block_length(Array<u8, max_huffman_literals> const& literal_bit_lengths, Array<u8, max_huffman_distances> const& distance_bit_lengths)
 {
     size_t length = 0;
@@ -1015,6 +1267,23 @@ ErrorOr<void> DeflateCompressor::final_flush()
     return {};
 }
 
+ErrorOr<void> DeflateCompressor::segment_flush()
+{
+    VERIFY(!m_finished);
+    if (m_pending_block_size != 0)
+        TRY(flush());
+    m_finished = true;
+
+    // An empty uncompressed block, which is the only way to get to a byte boundary without ending the stream.
+    TRY(m_output_stream->write_bits(0b000u, 3)); // not final, no compression
+    TRY(m_output_stream->align_to_byte_boundary());
+    LittleEndian<u16> len = 0;
+    TRY(m_output_stream->write_entire_buffer(len.bytes()));
+    LittleEndian<u16> nlen = ~0;
+    TRY(m_output_stream->write_entire_buffer(nlen.bytes()));
+    return {};
+}
+
 ErrorOr<ByteBuffer> DeflateCompressor::compress_all(ReadonlyBytes bytes, CompressionLevel compression_level)
 {
     auto output_stream = TRY(try_make<AllocatingMemoryStream>());
@@ -30,9 +30,19 @@ public:
     static Optional<CanonicalCode> from_bytes(ReadonlyBytes);
 
 private:
-    // Decompression - indexed by code
-    Vector<u16> m_symbol_codes;
-    Vector<u16> m_symbol_values;
+    static constexpr size_t max_code_length = 15;
+    static constexpr size_t root_table_bits = 9;
+
+    void build_lookup_table();
+
+    // Decompression - indexed by the next bits of input (lsb-first). The first 2^root_table_bits entries are
+    // indexed by the next root_table_bits bits, and codes longer than that continue in a second-level table.
+    struct LookupEntry {
+        u16 value { 0 };        // The symbol, or the offset of the second-level table if subtable_bits is non-zero.
+        u8 code_length { 0 };   // Zero if no code starts with these bits.
+        u8 subtable_bits { 0 }; // The second-level table is indexed by this many bits following the root bits.
+    };
+    Vector<LookupEntry> m_lookup_table;
 
     // Compression - indexed by symbol
     Array<u16, 288> m_bit_codes {}; // deflate uses a maximum of 288 symbols (maximum of 32 for distances)
@@ -77,6 +87,9 @@ public:
     friend UncompressedBlock;
 
     static ErrorOr<NonnullOwnPtr<DeflateDecompressor>> construct(MaybeOwned<Stream> stream);
+    // The bit stream reads ahead of the end of the compressed data, so containers that store more data after it have
+    // to pass in (and keep reading from) a bit stream of their own.
+    static ErrorOr<NonnullOwnPtr<DeflateDecompressor>> construct(MaybeOwned<LittleEndianInputBitStream> stream);
     ~DeflateDecompressor();
 
     virtual ErrorOr<Bytes> read(Bytes) override;
@@ -88,7 +101,7 @@ public:
     static ErrorOr<ByteBuffer> decompress_all(ReadonlyBytes);
 
 private:
-    DeflateDecompressor(MaybeOwned<Stream> stream, CircularBuffer buffer);
+    DeflateDecompressor(MaybeOwned<LittleEndianInputBitStream> stream, CircularBuffer buffer);
 
     ErrorOr<u32> decode_length(u32);
     ErrorOr<u32> decode_distance(u32);
@@ -127,18 +140,18 @@ public:
     // These constants were shamelessly "borrowed" from zlib
     static constexpr CompressionConstants compression_constants[] = {
         { 0, 0, 0, 0 },
-        { 4, 4, 8, 4 },
+        { 4, 4, 8, 1 }, // only the most recent candidate is ever looked at, matches are never deferred
         { 8, 16, 128, 128 },
         { 32, 258, 258, 4096 },
-        { max_match_length, max_match_length, max_match_length, 1 << hash_bits } // disable all limits
+        { max_match_length, max_match_length, max_match_length, 4096 } // every position is searched, so the chain is limited like GREAT's
     };
 
     enum class CompressionLevel : int {
         STORE = 0,
-        FAST,
-        GOOD,
+        FAST,  // Greedy matching with a single hash probe per position.
+        GOOD,  // Lazy matching, like zlib.
         GREAT,
-        BEST // WARNING: this one can take an unreasonable amount of time!
+        BEST   // Optimal parsing: picks the cheapest sequence of literals and matches per block. This is by far the slowest level.
     };
 
     static ErrorOr<NonnullOwnPtr<DeflateCompressor>> construct(MaybeOwned<Stream>, CompressionLevel = CompressionLevel::GOOD);
@@ -150,6 +163,10 @@ public:
     virtual bool is_open() const override;
     virtual void close() override;
     ErrorOr<void> final_flush();
+    // Like final_flush(), but doesn't mark the last block as final and pads the output to a byte boundary instead.
+    // This allows compressing independent pieces of the input separately (e.g. in parallel), as the outputs can simply be
+    // concatenated into one deflate stream, as long as the last piece is finished with final_flush().
+    ErrorOr<void> segment_flush();
 
     static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes, CompressionLevel = CompressionLevel::GOOD);
 
@@ -159,10 +176,22 @@ private:
     Bytes pending_block() { return { m_rolling_window + block_size, block_size }; }
 
     // LZ77 Compression
+    struct Match {
+        u16 length;
+        u16 distance;
+    };
     static u16 hash_sequence(u8 const* bytes);
+    static size_t common_prefix_length(u8 const* first, u8 const* second, size_t max_length);
     size_t compare_match_candidate(size_t start, size_t candidate, size_t prev_match_length, size_t max_match_length);
     size_t find_back_match(size_t start, u16 hash, size_t previous_match_length, size_t max_match_length, size_t& match_position);
+    size_t find_all_back_matches(size_t start, u16 hash, size_t max_match_length, Vector<Match>& matches);
+    void insert_hash(size_t position, u16 hash);
+    void emit_literal(u16 literal);
+    void emit_back_reference(u16 distance, u16 length);
     void lz77_compress_block();
+    void lz77_compress_block_greedy();
+    void lz77_compress_block_lazy();
+    void lz77_compress_block_optimal();
 
     // Huffman Coding
     struct code_length_symbol {
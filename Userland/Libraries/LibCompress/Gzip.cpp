@@ -10,6 +10,7 @@
 #include <AK/DeprecatedString.h>
 #include <AK/MemoryStream.h>
 #include <LibCore/DateTime.h>
+#include <LibThreading/ThreadPool.h>
 
 namespace Compress {
 
@@ -38,9 +39,9 @@ bool BlockHeader::supported_by_implementation() const
     return true;
 }
 
-ErrorOr<NonnullOwnPtr<GzipDecompressor::Member>> GzipDecompressor::Member::construct(BlockHeader header, Stream& stream)
+ErrorOr<NonnullOwnPtr<GzipDecompressor::Member>> GzipDecompressor::Member::construct(BlockHeader header, LittleEndianInputBitStream& stream)
 {
-    auto deflate_stream = TRY(DeflateDecompressor::construct(MaybeOwned<Stream>(stream)));
+    auto deflate_stream = TRY(DeflateDecompressor::construct(MaybeOwned<LittleEndianInputBitStream>(stream)));
     return TRY(adopt_nonnull_own_or_enomem(new (nothrow) Member(header, move(deflate_stream))));
 }
 
@@ -50,7 +51,7 @@ GzipDecompressor::Member::Member(BlockHeader header, NonnullOwnPtr<DeflateDecomp
 {
 }
 
-GzipDecompressor::GzipDecompressor(NonnullOwnPtr<Stream> stream)
+GzipDecompressor::GzipDecompressor(MaybeOwned<Stream> stream)
     : m_input_stream(move(stream))
 {
 }
@@ -76,8 +77,8 @@ ErrorOr<Bytes> GzipDecompressor::read(Bytes bytes)
 
             if (current_slice.size() < slice.size()) {
                 LittleEndian<u32> crc32, input_size;
-                TRY(m_input_stream->read(crc32.bytes()));
-                TRY(m_input_stream->read(input_size.bytes()));
+                TRY(m_input_stream.read(crc32.bytes()));
+                TRY(m_input_stream.read(input_size.bytes()));
 
                 if (crc32 != current_member().m_checksum.digest())
                     return Error::from_string_literal("Stored CRC32 does not match the calculated CRC32 of the current member");
@@ -95,7 +96,7 @@ ErrorOr<Bytes> GzipDecompressor::read(Bytes bytes)
             continue;
         } else {
             auto current_partial_header_slice = Bytes { m_partial_header, sizeof(BlockHeader) }.slice(m_partial_header_offset);
-            auto current_partial_header_data = TRY(m_input_stream->read(current_partial_header_slice));
+            auto current_partial_header_data = TRY(m_input_stream.read(current_partial_header_slice));
             m_partial_header_offset += current_partial_header_data.size();
 
             if (is_eof())
@@ -116,15 +117,15 @@ ErrorOr<Bytes> GzipDecompressor::read(Bytes bytes)
 
             if (header.flags & Flags::FEXTRA) {
                 LittleEndian<u16> subfield_id, length;
-                TRY(m_input_stream->read(subfield_id.bytes()));
-                TRY(m_input_stream->read(length.bytes()));
-                TRY(m_input_stream->discard(length));
+                TRY(m_input_stream.read(subfield_id.bytes()));
+                TRY(m_input_stream.read(length.bytes()));
+                TRY(m_input_stream.discard(length));
             }
 
             auto discard_string = [&]() -> ErrorOr<void> {
                 char next_char;
                 do {
-                    TRY(m_input_stream->read({ &next_char, sizeof(next_char) }));
+                    TRY(m_input_stream.read({ &next_char, sizeof(next_char) }));
                 } while (next_char);
 
                 return {};
@@ -138,11 +139,11 @@ ErrorOr<Bytes> GzipDecompressor::read(Bytes bytes)
 
             if (header.flags & Flags::FHCRC) {
                 LittleEndian<u16> crc16;
-                TRY(m_input_stream->read(crc16.bytes()));
+                TRY(m_input_stream.read(crc16.bytes()));
                 // FIXME: we should probably verify this instead of just assuming it matches
             }
 
-            m_current_member = TRY(Member::construct(header, *m_input_stream));
+            m_current_member = TRY(Member::construct(header, m_input_stream));
             continue;
         }
     }
@@ -179,7 +180,7 @@ ErrorOr<ByteBuffer> GzipDecompressor::decompress_all(ReadonlyBytes bytes)
     return output_buffer;
 }
 
-bool GzipDecompressor::is_eof() const { return m_input_stream->is_eof(); }
+bool GzipDecompressor::is_eof() const { return m_input_stream.is_eof(); }
 
 ErrorOr<size_t> GzipDecompressor::write(ReadonlyBytes)
 {
@@ -196,6 +197,32 @@ ErrorOr<Bytes> GzipCompressor::read(Bytes)
     return Error::from_errno(EBADF);
 }
 
+// Input is split into segments of this many bytes, which are compressed in parallel. DeflateCompressor never looks for matches
+// outside of the block it is currently compressing, so as long as this is a multiple of its block size, the output is
+// exactly as small as it would be when compressing all of the input at once.
+static constexpr size_t bytes_per_compressed_segment = 32 * DeflateCompressor::block_size;
+
+struct CompressedSegment {
+    ByteBuffer data;
+    u32 crc32 { 0 };
+};
+
+static ErrorOr<CompressedSegment> compress_segment(ReadonlyBytes data, bool is_last_segment)
+{
+    AllocatingMemoryStream output_stream;
+    auto deflate_stream = TRY(DeflateCompressor::construct(MaybeOwned<Stream>(output_stream)));
+
+    TRY(deflate_stream->write_entire_buffer(data));
+    if (is_last_segment)
+        TRY(deflate_stream->final_flush());
+    else
+        TRY(deflate_stream->segment_flush());
+
+    auto buffer = TRY(ByteBuffer::create_uninitialized(output_stream.used_buffer_size()));
+    TRY(output_stream.read_entire_buffer(buffer));
+    return CompressedSegment { move(buffer), Crypto::Checksum::CRC32(data).digest() };
+}
+
 ErrorOr<size_t> GzipCompressor::write(ReadonlyBytes bytes)
 {
     BlockHeader header;
@@ -207,14 +234,33 @@ ErrorOr<size_t> GzipCompressor::write(ReadonlyBytes bytes)
     header.extra_flags = 3;      // DEFLATE sets 2 for maximum compression and 4 for minimum compression
     header.operating_system = 3; // unix
     TRY(m_output_stream->write_entire_buffer({ &header, sizeof(header) }));
-    auto compressed_stream = TRY(DeflateCompressor::construct(MaybeOwned(*m_output_stream)));
-    TRY(compressed_stream->write_entire_buffer(bytes));
-    TRY(compressed_stream->final_flush());
-    Crypto::Checksum::CRC32 crc32;
-    crc32.update(bytes);
-    LittleEndian<u32> digest = crc32.digest();
+
+    // The segments end on byte boundaries (all but the last one with an empty stored block), so they simply concatenate into
+    // the deflate stream of a single member.
+    auto const segment_count = max<size_t>(ceil_div(bytes.size(), bytes_per_compressed_segment), 1);
+    Vector<ErrorOr<CompressedSegment>> compressed_segments;
+    TRY(compressed_segments.try_ensure_capacity(segment_count));
+    for (size_t i = 0; i < segment_count; ++i)
+        compressed_segments.unchecked_append(CompressedSegment {});
+
+    Threading::ThreadPool::the().parallel_for(segment_count, [&](size_t segment_index) {
+        auto segment = bytes.slice(segment_index * bytes_per_compressed_segment);
+        compressed_segments[segment_index] = compress_segment(segment.trim(bytes_per_compressed_segment), segment_index == segment_count - 1);
+    });
+
+    u32 digest = 0; // The CRC32 of no data at all.
+    for (size_t i = 0; i < segment_count; ++i) {
+        if (compressed_segments[i].is_error())
+            return compressed_segments[i].release_error();
+        auto const& segment = compressed_segments[i].value();
+        TRY(m_output_stream->write_entire_buffer(segment.data));
+        auto const segment_size = min(bytes.size() - i * bytes_per_compressed_segment, bytes_per_compressed_segment);
+        digest = Crypto::Checksum::CRC32::combine(digest, segment.crc32, segment_size);
+    }
+
+    LittleEndian<u32> crc32 = digest;
     LittleEndian<u32> size = bytes.size();
-    TRY(m_output_stream->write_entire_buffer(digest.bytes()));
+    TRY(m_output_stream->write_entire_buffer(crc32.bytes()));
     TRY(m_output_stream->write_entire_buffer(size.bytes()));
     return bytes.size();
 }
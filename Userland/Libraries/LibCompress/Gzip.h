@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <AK/BitStream.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/OwnPtr.h>
 #include <AK/Stream.h>
@@ -42,7 +43,7 @@ struct Flags {
 
 class GzipDecompressor final : public Stream {
 public:
-    GzipDecompressor(NonnullOwnPtr<Stream>);
+    GzipDecompressor(MaybeOwned<Stream>);
     ~GzipDecompressor();
 
     virtual ErrorOr<Bytes> read(Bytes) override;
@@ -58,7 +59,7 @@ public:
 private:
     class Member {
     public:
-        static ErrorOr<NonnullOwnPtr<Member>> construct(BlockHeader header, Stream&);
+        static ErrorOr<NonnullOwnPtr<Member>> construct(BlockHeader header, LittleEndianInputBitStream&);
 
         BlockHeader m_header;
         NonnullOwnPtr<DeflateDecompressor> m_stream;
@@ -72,7 +73,8 @@ private:
     Member const& current_member() const { return *m_current_member; }
     Member& current_member() { return *m_current_member; }
 
-    NonnullOwnPtr<Stream> m_input_stream;
+    // The members' deflate streams read ahead, so the data in between them has to be read through the same bit stream.
+    LittleEndianInputBitStream m_input_stream;
     u8 m_partial_header[sizeof(BlockHeader)];
     size_t m_partial_header_offset { 0 };
     OwnPtr<Member> m_current_member {};
@@ -0,0 +1,892 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BuiltinWrappers.h>
+#include <AK/Endian.h>
+#include <AK/MemoryStream.h>
+#include <LibCompress/Zstd.h>
+
+namespace Compress {
+
+static constexpr u32 zstd_magic_number = 0xFD2FB528;
+static constexpr u32 skippable_frame_magic_number = 0x184D2A50;
+static constexpr u32 skippable_frame_magic_number_mask = 0xFFFFFFF0;
+
+// Decoders may limit the window size they accept (RFC 8878, 3.1.1.1.2). This is the limit the reference decoder
+// uses by default.
+static constexpr size_t maximum_window_size = 128 * MiB;
+static constexpr size_t maximum_block_size = 128 * KiB;
+
+static constexpr size_t literal_lengths_maximum_accuracy_log = 9;
+static constexpr size_t match_lengths_maximum_accuracy_log = 9;
+static constexpr size_t offsets_maximum_accuracy_log = 8;
+static constexpr size_t huffman_weights_maximum_accuracy_log = 6;
+static constexpr size_t huffman_maximum_number_of_bits = 11;
+
+static constexpr size_t literal_lengths_symbol_count = 36;
+static constexpr size_t match_lengths_symbol_count = 53;
+static constexpr size_t offsets_symbol_count = 32;
+static constexpr size_t huffman_weights_symbol_count = huffman_maximum_number_of_bits + 1;
+
+// 3.1.1.3.2.2. Default Distributions
+static constexpr Array<i16, literal_lengths_symbol_count> literal_lengths_default_distribution {
+    4, 3, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 3, 2, 1, 1, 1, 1, 1, -1, -1, -1, -1
+};
+static constexpr size_t literal_lengths_default_accuracy_log = 6;
+
+static constexpr Array<i16, match_lengths_symbol_count> match_lengths_default_distribution {
+    1, 4, 3, 2, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, -1, -1, -1, -1, -1, -1, -1
+};
+static constexpr size_t match_lengths_default_accuracy_log = 6;
+
+static constexpr Array<i16, 29> offsets_default_distribution {
+    1, 1, 1, 1, 1, 1, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, -1, -1, -1, -1, -1
+};
+static constexpr size_t offsets_default_accuracy_log = 5;
+
+struct LengthCode {
+    u32 baseline;
+    u8 extra_bits;
+};
+
+// 3.1.1.3.2.1.1. Literals_Length_Code
+static constexpr Array<LengthCode, literal_lengths_symbol_count> literal_length_codes {
+    LengthCode { 0, 0 }, { 1, 0 }, { 2, 0 }, { 3, 0 }, { 4, 0 }, { 5, 0 }, { 6, 0 }, { 7, 0 },
+    { 8, 0 }, { 9, 0 }, { 10, 0 }, { 11, 0 }, { 12, 0 }, { 13, 0 }, { 14, 0 }, { 15, 0 },
+    { 16, 1 }, { 18, 1 }, { 20, 1 }, { 22, 1 }, { 24, 2 }, { 28, 2 }, { 32, 3 }, { 40, 3 },
+    { 48, 4 }, { 64, 6 }, { 128, 7 }, { 256, 8 }, { 512, 9 }, { 1024, 10 }, { 2048, 11 }, { 4096, 12 },
+    { 8192, 13 }, { 16384, 14 }, { 32768, 15 }, { 65536, 16 }
+};
+
+// 3.1.1.3.2.1.1. Match_Length_Code
+static constexpr Array<LengthCode, match_lengths_symbol_count> match_length_codes {
+    LengthCode { 3, 0 }, { 4, 0 }, { 5, 0 }, { 6, 0 }, { 7, 0 }, { 8, 0 }, { 9, 0 }, { 10, 0 },
+    { 11, 0 }, { 12, 0 }, { 13, 0 }, { 14, 0 }, { 15, 0 }, { 16, 0 }, { 17, 0 }, { 18, 0 },
+    { 19, 0 }, { 20, 0 }, { 21, 0 }, { 22, 0 }, { 23, 0 }, { 24, 0 }, { 25, 0 }, { 26, 0 },
+    { 27, 0 }, { 28, 0 }, { 29, 0 }, { 30, 0 }, { 31, 0 }, { 32, 0 }, { 33, 0 }, { 34, 0 },
+    { 35, 1 }, { 37, 1 }, { 39, 1 }, { 41, 1 }, { 43, 2 }, { 47, 2 }, { 51, 3 }, { 59, 3 },
+    { 67, 4 }, { 83, 4 }, { 99, 5 }, { 131, 7 }, { 259, 8 }, { 515, 9 }, { 1027, 10 }, { 2051, 11 },
+    { 4099, 12 }, { 8195, 13 }, { 16387, 14 }, { 32771, 15 }, { 65539, 16 }
+};
+
+static u64 read_little_endian(ReadonlyBytes bytes)
+{
+    VERIFY(bytes.size() <= sizeof(u64));
+    u64 value = 0;
+    for (size_t i = 0; i < bytes.size(); ++i)
+        value |= static_cast<u64>(bytes[i]) << (8 * i);
+    return value;
+}
+
+// Up to 8 bytes starting at `offset`, with zeros past the end of the data.
+static u64 load_padded(ReadonlyBytes bytes, size_t offset)
+{
+    if (offset + sizeof(u64) <= bytes.size()) {
+        u64 value;
+        __builtin_memcpy(&value, bytes.offset_pointer(offset), sizeof(value));
+        return AK::convert_between_host_and_little_endian(value);
+    }
+    if (offset >= bytes.size())
+        return 0;
+    return read_little_endian(bytes.slice(offset));
+}
+
+static constexpr u64 lower_bits_mask(size_t count)
+{
+    return count >= 64 ? NumericLimits<u64>::max() : (static_cast<u64>(1) << count) - 1;
+}
+
+// The FSE table descriptions are read from the lowest bit of the first byte onwards.
+class ForwardBitReader {
+public:
+    explicit ForwardBitReader(ReadonlyBytes data)
+        : m_data(data)
+    {
+    }
+
+    // Reads zeros past the end of the data, callers check `bytes_consumed()` once they are done.
+    u32 read_bits(size_t count)
+    {
+        VERIFY(count <= 32);
+        auto value = (load_padded(m_data, m_bit_offset / 8) >> (m_bit_offset % 8)) & lower_bits_mask(count);
+        m_bit_offset += count;
+        return static_cast<u32>(value);
+    }
+
+    void rewind_bits(size_t count) { m_bit_offset -= count; }
+    size_t bytes_consumed() const { return ceil_div(m_bit_offset, static_cast<size_t>(8)); }
+
+private:
+    ReadonlyBytes m_data;
+    size_t m_bit_offset { 0 };
+};
+
+// Huffman and FSE encoded streams are written forwards but read backwards, starting at the highest set bit of
+// the last byte. Reading past the start of the stream yields zero bits, which the decoders have to check for.
+class BackwardBitReader {
+public:
+    static ErrorOr<BackwardBitReader> create(ReadonlyBytes data)
+    {
+        if (data.is_empty() || data.last() == 0)
+            return Error::from_string_literal("Zstd: Bitstream is missing its end marker");
+        return BackwardBitReader { data, static_cast<i64>(data.size() * 8 - count_leading_zeroes(data.last()) - 1) };
+    }
+
+    u64 read_bits(size_t count)
+    {
+        VERIFY(count <= 56);
+        if (count == 0)
+            return 0;
+        m_bit_offset -= count;
+        if (m_bit_offset >= 0)
+            return (load_padded(m_data, m_bit_offset / 8) >> (m_bit_offset % 8)) & lower_bits_mask(count);
+        auto available_bits = static_cast<i64>(count) + m_bit_offset;
+        if (available_bits <= 0)
+            return 0;
+        return (load_padded(m_data, 0) & lower_bits_mask(available_bits)) << (count - available_bits);
+    }
+
+    i64 bit_offset() const { return m_bit_offset; }
+
+private:
+    BackwardBitReader(ReadonlyBytes data, i64 bit_offset)
+        : m_data(data)
+        , m_bit_offset(bit_offset)
+    {
+    }
+
+    ReadonlyBytes m_data;
+    i64 m_bit_offset { 0 };
+};
+
+static size_t highest_bit_set(u32 value)
+{
+    VERIFY(value != 0);
+    return 31 - count_leading_zeroes(value);
+}
+
+// 4.1.1. FSE Table Description
+static ErrorOr<ZstdDecompressor::FSETable> build_fse_table(ReadonlySpan<i16> distribution, size_t accuracy_log)
+{
+    size_t const table_size = 1 << accuracy_log;
+    ZstdDecompressor::FSETable table;
+    table.accuracy_log = accuracy_log;
+    TRY(table.entries.try_resize(table_size));
+
+    // Symbols with a "less than 1" probability get a single cell each at the end of the table.
+    Array<u32, match_lengths_symbol_count> next_state_counters {};
+    VERIFY(distribution.size() <= next_state_counters.size());
+    size_t high_threshold = table_size;
+    for (size_t symbol = 0; symbol < distribution.size(); ++symbol) {
+        if (distribution[symbol] == -1) {
+            table.entries[--high_threshold].symbol = symbol;
+            next_state_counters[symbol] = 1;
+        } else {
+            next_state_counters[symbol] = distribution[symbol];
+        }
+    }
+
+    size_t const step = (table_size >> 1) + (table_size >> 3) + 3;
+    size_t const mask = table_size - 1;
+    size_t position = 0;
+    for (size_t symbol = 0; symbol < distribution.size(); ++symbol) {
+        for (i16 i = 0; i < distribution[symbol]; ++i) {
+            table.entries[position].symbol = symbol;
+            do {
+                position = (position + step) & mask;
+            } while (position >= high_threshold);
+        }
+    }
+    if (position != 0)
+        return Error::from_string_literal("Zstd: Invalid FSE distribution");
+
+    for (auto& entry : table.entries) {
+        auto next_state = next_state_counters[entry.symbol]++;
+        entry.number_of_bits = accuracy_log - highest_bit_set(next_state);
+        entry.baseline = (next_state << entry.number_of_bits) - table_size;
+    }
+
+    return table;
+}
+
+static ErrorOr<ZstdDecompressor::FSETable> read_fse_table(ReadonlyBytes& data, size_t maximum_accuracy_log, size_t symbol_count)
+{
+    ForwardBitReader reader { data };
+    size_t const accuracy_log = reader.read_bits(4) + 5;
+    if (accuracy_log > maximum_accuracy_log)
+        return Error::from_string_literal("Zstd: FSE accuracy log is too large");
+
+    Array<i16, match_lengths_symbol_count> distribution {};
+    VERIFY(symbol_count <= distribution.size());
+
+    // The probabilities are written with just enough bits to represent the ones that are still possible, and the
+    // smaller half of the values saves one bit.
+    i32 remaining = 1 << accuracy_log;
+    size_t symbol = 0;
+    while (remaining > 0 && symbol < symbol_count) {
+        size_t const bits = highest_bit_set(remaining + 1) + 1;
+        auto value = reader.read_bits(bits);
+        u32 const lower_mask = (1u << (bits - 1)) - 1;
+        u32 const threshold = (1u << bits) - 1 - (remaining + 1);
+        if ((value & lower_mask) < threshold) {
+            reader.rewind_bits(1);
+            value &= lower_mask;
+        } else if (value > lower_mask) {
+            value -= threshold;
+        }
+
+        i16 const probability = static_cast<i16>(value) - 1;
+        remaining -= probability < 0 ? -probability : probability;
+        distribution[symbol++] = probability;
+
+        if (probability == 0) {
+            // A zero probability is followed by the number of additional zero probabilities, in chunks of 2 bits.
+            while (true) {
+                auto repeat = reader.read_bits(2);
+                if (symbol + repeat > symbol_count)
+                    return Error::from_string_literal("Zstd: Too many symbols in FSE table description");
+                symbol += repeat;
+                if (repeat != 3)
+                    break;
+            }
+        }
+    }
+    if (remaining != 0)
+        return Error::from_string_literal("Zstd: Invalid FSE table description");
+    if (reader.bytes_consumed() > data.size())
+        return Error::from_string_literal("Zstd: Unexpected end of FSE table description");
+
+    data = data.slice(reader.bytes_consumed());
+    return build_fse_table(ReadonlySpan<i16> { distribution.data(), symbol_count }, accuracy_log);
+}
+
+static ZstdDecompressor::FSETable rle_fse_table(u8 symbol)
+{
+    ZstdDecompressor::FSETable table;
+    table.entries.append({ .baseline = 0, .symbol = symbol, .number_of_bits = 0 });
+    return table;
+}
+
+// 4.2.1.2. Huffman Tree Description
+static ErrorOr<ZstdDecompressor::HuffmanTable> build_huffman_table(ReadonlySpan<u8> explicit_weights)
+{
+    Array<u8, 256> weights {};
+    if (explicit_weights.size() >= weights.size())
+        return Error::from_string_literal("Zstd: Too many Huffman weights");
+
+    u32 weight_sum = 0;
+    for (size_t i = 0; i < explicit_weights.size(); ++i) {
+        if (explicit_weights[i] > huffman_maximum_number_of_bits)
+            return Error::from_string_literal("Zstd: Huffman weight is too large");
+        weights[i] = explicit_weights[i];
+        if (weights[i] > 0)
+            weight_sum += 1u << (weights[i] - 1);
+    }
+    if (weight_sum == 0)
+        return Error::from_string_literal("Zstd: Huffman weights are all zero");
+
+    // The weight of the last symbol is implied by the others, as the weights have to add up to a power of two.
+    size_t const max_number_of_bits = highest_bit_set(weight_sum) + 1;
+    if (max_number_of_bits > huffman_maximum_number_of_bits)
+        return Error::from_string_literal("Zstd: Huffman codes are too long");
+    u32 const left_over = (1u << max_number_of_bits) - weight_sum;
+    if (!is_power_of_two(left_over))
+        return Error::from_string_literal("Zstd: Invalid Huffman weights");
+    size_t const symbol_count = explicit_weights.size() + 1;
+    weights[symbol_count - 1] = highest_bit_set(left_over) + 1;
+
+    Array<u8, 256> number_of_bits {};
+    Array<u32, huffman_maximum_number_of_bits + 1> rank_count {};
+    for (size_t symbol = 0; symbol < symbol_count; ++symbol) {
+        if (weights[symbol] > 0)
+            number_of_bits[symbol] = max_number_of_bits + 1 - weights[symbol];
+        rank_count[number_of_bits[symbol]]++;
+    }
+
+    // Longer codes come first, and symbols of the same length are ordered by their value.
+    Array<u32, huffman_maximum_number_of_bits + 1> rank_index {};
+    u32 next_index = 0;
+    for (size_t bits = max_number_of_bits; bits > 0; --bits) {
+        rank_index[bits] = next_index;
+        next_index += rank_count[bits] << (max_number_of_bits - bits);
+    }
+    if (next_index != (1u << max_number_of_bits))
+        return Error::from_string_literal("Zstd: Invalid Huffman weights");
+
+    ZstdDecompressor::HuffmanTable table;
+    table.max_number_of_bits = max_number_of_bits;
+    TRY(table.entries.try_resize(1 << max_number_of_bits));
+    for (size_t symbol = 0; symbol < symbol_count; ++symbol) {
+        auto bits = number_of_bits[symbol];
+        if (bits == 0)
+            continue;
+        auto const code = rank_index[bits];
+        auto const length = 1u << (max_number_of_bits - bits);
+        for (size_t i = code; i < code + length; ++i)
+            table.entries[i] = { .symbol = static_cast<u8>(symbol), .number_of_bits = bits };
+        rank_index[bits] += length;
+    }
+
+    return table;
+}
+
+static ErrorOr<ZstdDecompressor::HuffmanTable> read_huffman_table(ReadonlyBytes& data)
+{
+    if (data.is_empty())
+        return Error::from_string_literal("Zstd: Missing Huffman tree description");
+
+    auto const header = data[0];
+    data = data.slice(1);
+
+    Array<u8, 256> weights {};
+    size_t weight_count = 0;
+
+    if (header >= 128) {
+        // The weights are stored directly, as 4 bits each.
+        weight_count = header - 127;
+        auto const byte_count = ceil_div(weight_count, static_cast<size_t>(2));
+        if (data.size() < byte_count)
+            return Error::from_string_literal("Zstd: Unexpected end of Huffman weights");
+        for (size_t i = 0; i < weight_count; ++i)
+            weights[i] = i % 2 == 0 ? data[i / 2] >> 4 : data[i / 2] & 0xf;
+        data = data.slice(byte_count);
+        return build_huffman_table(ReadonlySpan<u8> { weights.data(), weight_count });
+    }
+
+    // The weights are compressed with FSE, using two interleaved states that share one bitstream.
+    if (data.size() < header)
+        return Error::from_string_literal("Zstd: Unexpected end of Huffman weights");
+    auto compressed_weights = data.trim(header);
+    data = data.slice(header);
+
+    auto table = TRY(read_fse_table(compressed_weights, huffman_weights_maximum_accuracy_log, huffman_weights_symbol_count));
+    auto reader = TRY(BackwardBitReader::create(compressed_weights));
+    Array<size_t, 2> states { reader.read_bits(table.accuracy_log), reader.read_bits(table.accuracy_log) };
+
+    while (true) {
+        for (size_t i = 0; i < states.size(); ++i) {
+            if (weight_count >= weights.size() - 1)
+                return Error::from_string_literal("Zstd: Too many Huffman weights");
+            auto const& entry = table.entries[states[i]];
+            weights[weight_count++] = entry.symbol;
+            states[i] = entry.baseline + reader.read_bits(entry.number_of_bits);
+
+            // Once the bitstream is exhausted, the other state still holds one last weight.
+            if (reader.bit_offset() < 0) {
+                weights[weight_count++] = table.entries[states[1 - i]].symbol;
+                return build_huffman_table(ReadonlySpan<u8> { weights.data(), weight_count });
+            }
+        }
+    }
+}
+
+// 4.2.2. Huffman-Coded Streams
+static ErrorOr<void> decode_huffman_stream(ZstdDecompressor::HuffmanTable const& table, ReadonlyBytes stream, Bytes output)
+{
+    auto reader = TRY(BackwardBitReader::create(stream));
+    auto const max_number_of_bits = table.max_number_of_bits;
+    auto const mask = (1u << max_number_of_bits) - 1;
+
+    u32 state = reader.read_bits(max_number_of_bits);
+    for (auto& byte : output) {
+        auto const& entry = table.entries[state];
+        byte = entry.symbol;
+        state = ((state << entry.number_of_bits) | reader.read_bits(entry.number_of_bits)) & mask;
+    }
+
+    // The last symbol has consumed exactly the bits that were left in the stream.
+    if (reader.bit_offset() != -static_cast<i64>(max_number_of_bits))
+        return Error::from_string_literal("Zstd: Huffman stream has the wrong size");
+    return {};
+}
+
+ErrorOr<NonnullOwnPtr<ZstdDecompressor>> ZstdDecompressor::construct(MaybeOwned<Stream> stream)
+{
+    return TRY(adopt_nonnull_own_or_enomem(new (nothrow) ZstdDecompressor(move(stream))));
+}
+
+ZstdDecompressor::ZstdDecompressor(MaybeOwned<Stream> stream)
+    : m_input_stream(move(stream))
+{
+}
+
+ErrorOr<Bytes> ZstdDecompressor::read(Bytes bytes)
+{
+    size_t total_read = 0;
+    while (total_read < bytes.size()) {
+        if (m_window.has_value() && m_window->used_space() > 0) {
+            total_read += m_window->read(bytes.slice(total_read)).size();
+            continue;
+        }
+
+        if (m_state == State::Finished)
+            break;
+
+        if (m_state == State::FrameHeader) {
+            // Frames can be concatenated, and running out of input is only fine in between them.
+            if (m_input_stream->is_eof()) {
+                m_state = State::Finished;
+                break;
+            }
+            TRY(read_frame_header());
+            continue;
+        }
+
+        // Blocks are only decoded once everything before them has been read, so the whole window is available.
+        TRY(read_block());
+    }
+
+    return bytes.trim(total_read);
+}
+
+ErrorOr<size_t> ZstdDecompressor::write(ReadonlyBytes)
+{
+    return Error::from_errno(EBADF);
+}
+
+bool ZstdDecompressor::is_eof() const
+{
+    return m_state == State::Finished && (!m_window.has_value() || m_window->used_space() == 0);
+}
+
+// 3.1.1. Zstandard Frames
+ErrorOr<void> ZstdDecompressor::read_frame_header()
+{
+    u32 magic_number = TRY(m_input_stream->read_value<LittleEndian<u32>>());
+
+    // 3.1.2. Skippable Frames
+    if ((magic_number & skippable_frame_magic_number_mask) == skippable_frame_magic_number) {
+        u32 frame_size = TRY(m_input_stream->read_value<LittleEndian<u32>>());
+        TRY(m_input_stream->discard(frame_size));
+        return {};
+    }
+
+    if (magic_number != zstd_magic_number)
+        return Error::from_string_literal("Zstd: Invalid magic number");
+
+    // 3.1.1.1.1. Frame_Header_Descriptor
+    u8 const descriptor = TRY(m_input_stream->read_value<u8>());
+    u8 const frame_content_size_flag = descriptor >> 6;
+    bool const single_segment = descriptor & 0x20;
+    bool const has_checksum = descriptor & 0x04;
+    u8 const dictionary_id_flag = descriptor & 0x03;
+    if (descriptor & 0x08)
+        return Error::from_string_literal("Zstd: Reserved bit in frame header is set");
+
+    // 3.1.1.1.2. Window_Descriptor
+    u64 window_size = 0;
+    if (!single_segment) {
+        u8 const window_descriptor = TRY(m_input_stream->read_value<u8>());
+        u64 const window_base = static_cast<u64>(1) << (10 + (window_descriptor >> 3));
+        window_size = window_base + (window_base / 8) * (window_descriptor & 0x07);
+    }
+
+    // 3.1.1.1.3. Dictionary_ID
+    Array<u8, 8> field {};
+    constexpr Array<size_t, 4> dictionary_id_sizes { 0, 1, 2, 4 };
+    TRY(m_input_stream->read_entire_buffer(Bytes { field }.trim(dictionary_id_sizes[dictionary_id_flag])));
+    if (read_little_endian(ReadonlyBytes { field }.trim(dictionary_id_sizes[dictionary_id_flag])) != 0)
+        return Error::from_string_literal("Zstd: Frames that use a dictionary are not supported");
+
+    // 3.1.1.1.4. Frame_Content_Size
+    constexpr Array<size_t, 4> frame_content_size_sizes { 0, 2, 4, 8 };
+    auto frame_content_size_size = frame_content_size_sizes[frame_content_size_flag];
+    if (frame_content_size_flag == 0 && single_segment)
+        frame_content_size_size = 1;
+
+    m_frame_content_size.clear();
+    if (frame_content_size_size > 0) {
+        field = {};
+        TRY(m_input_stream->read_entire_buffer(Bytes { field }.trim(frame_content_size_size)));
+        u64 frame_content_size = read_little_endian(ReadonlyBytes { field }.trim(frame_content_size_size));
+        if (frame_content_size_size == 2)
+            frame_content_size += 256;
+        m_frame_content_size = frame_content_size;
+    }
+
+    if (single_segment)
+        window_size = m_frame_content_size.value();
+    if (window_size > maximum_window_size)
+        return Error::from_string_literal("Zstd: Window size is too large");
+
+    // There's no point in remembering more history than the frame has data.
+    size_t window_capacity = window_size;
+    if (m_frame_content_size.has_value())
+        window_capacity = min(window_capacity, m_frame_content_size.value());
+    window_capacity = max(window_capacity, static_cast<size_t>(1));
+    if (!m_window.has_value() || m_window->capacity() != window_capacity)
+        m_window = TRY(CircularBuffer::create_empty(window_capacity));
+    else
+        m_window->clear();
+
+    m_window_size = window_size;
+    m_maximum_block_size = min(window_size, maximum_block_size);
+    m_frame_decoded_size = 0;
+    m_checksum.clear();
+    if (has_checksum)
+        m_checksum = Crypto::Checksum::XXHash64 {};
+
+    m_repeated_offsets = { 1, 4, 8 };
+    m_huffman_table.clear();
+    m_literal_lengths_table.clear();
+    m_offsets_table.clear();
+    m_match_lengths_table.clear();
+
+    m_state = State::Block;
+    return {};
+}
+
+ErrorOr<void> ZstdDecompressor::finish_frame()
+{
+    if (m_frame_content_size.has_value() && m_frame_decoded_size != m_frame_content_size.value())
+        return Error::from_string_literal("Zstd: Frame content size does not match the decompressed data");
+
+    // 3.1.1. Content_Checksum: The lower 32 bits of the XXH64 digest.
+    if (m_checksum.has_value()) {
+        u32 const expected_checksum = TRY(m_input_stream->read_value<LittleEndian<u32>>());
+        if (static_cast<u32>(m_checksum->digest()) != expected_checksum)
+            return Error::from_string_literal("Zstd: Content checksum mismatch");
+    }
+
+    m_state = State::FrameHeader;
+    return {};
+}
+
+// 3.1.1.2. Blocks
+ErrorOr<void> ZstdDecompressor::read_block()
+{
+    Array<u8, 3> header_bytes;
+    TRY(m_input_stream->read_entire_buffer(header_bytes));
+    u32 const header = read_little_endian(header_bytes);
+    bool const last_block = header & 1;
+    u8 const block_type = (header >> 1) & 3;
+    size_t const block_size = header >> 3;
+
+    if (block_size > m_maximum_block_size)
+        return Error::from_string_literal("Zstd: Block is too large");
+
+    switch (block_type) {
+    case 0: {
+        // Raw_Block
+        TRY(m_block_buffer.try_resize(block_size));
+        TRY(m_input_stream->read_entire_buffer(m_block_buffer));
+        TRY(append_to_window(m_block_buffer));
+        break;
+    }
+    case 1: {
+        // RLE_Block: A single byte, repeated Block_Size times.
+        u8 const byte = TRY(m_input_stream->read_value<u8>());
+        TRY(m_block_buffer.try_resize(block_size));
+        m_block_buffer.bytes().fill(byte);
+        TRY(append_to_window(m_block_buffer));
+        break;
+    }
+    case 2: {
+        // Compressed_Block
+        TRY(m_block_buffer.try_resize(block_size));
+        TRY(m_input_stream->read_entire_buffer(m_block_buffer));
+        auto literals_section_size = TRY(read_literals_section(m_block_buffer));
+        TRY(decode_sequences(m_block_buffer.bytes().slice(literals_section_size)));
+        break;
+    }
+    default:
+        return Error::from_string_literal("Zstd: Reserved block type");
+    }
+
+    if (last_block)
+        TRY(finish_frame());
+    return {};
+}
+
+// 3.1.1.3.1. Literals Section
+ErrorOr<size_t> ZstdDecompressor::read_literals_section(ReadonlyBytes data)
+{
+    if (data.is_empty())
+        return Error::from_string_literal("Zstd: Missing literals section");
+
+    u8 const literals_block_type = data[0] & 3;
+    u8 const size_format = (data[0] >> 2) & 3;
+    m_literals_offset = 0;
+
+    if (literals_block_type == 0 || literals_block_type == 1) {
+        // Raw_Literals_Block and RLE_Literals_Block
+        size_t header_size = 0;
+        size_t regenerated_size = 0;
+        if (size_format == 0 || size_format == 2) {
+            header_size = 1;
+            regenerated_size = data[0] >> 3;
+        } else if (size_format == 1) {
+            header_size = 2;
+            if (data.size() < header_size)
+                return Error::from_string_literal("Zstd: Unexpected end of literals section header");
+            regenerated_size = (data[0] >> 4) + (data[1] << 4);
+        } else {
+            header_size = 3;
+            if (data.size() < header_size)
+                return Error::from_string_literal("Zstd: Unexpected end of literals section header");
+            regenerated_size = (data[0] >> 4) + (data[1] << 4) + (data[2] << 12);
+        }
+        if (regenerated_size > m_maximum_block_size)
+            return Error::from_string_literal("Zstd: Too many literals");
+        TRY(m_literals.try_resize(regenerated_size));
+
+        if (literals_block_type == 0) {
+            if (data.size() < header_size + regenerated_size)
+                return Error::from_string_literal("Zstd: Unexpected end of raw literals");
+            data.slice(header_size, regenerated_size).copy_to(m_literals.span());
+            return header_size + regenerated_size;
+        }
+
+        if (data.size() < header_size + 1)
+            return Error::from_string_literal("Zstd: Unexpected end of RLE literals");
+        m_literals.span().fill(data[header_size]);
+        return header_size + 1;
+    }
+
+    // Compressed_Literals_Block and Treeless_Literals_Block
+    constexpr Array<size_t, 4> header_sizes { 3, 3, 4, 5 };
+    constexpr Array<size_t, 4> size_field_bits { 10, 10, 14, 18 };
+    auto const header_size = header_sizes[size_format];
+    if (data.size() < header_size)
+        return Error::from_string_literal("Zstd: Unexpected end of literals section header");
+    u64 const header = read_little_endian(data.trim(header_size));
+    size_t const regenerated_size = (header >> 4) & lower_bits_mask(size_field_bits[size_format]);
+    size_t const compressed_size = (header >> (4 + size_field_bits[size_format])) & lower_bits_mask(size_field_bits[size_format]);
+    bool const single_stream = size_format == 0;
+
+    if (regenerated_size > m_maximum_block_size)
+        return Error::from_string_literal("Zstd: Too many literals");
+    if (data.size() < header_size + compressed_size)
+        return Error::from_string_literal("Zstd: Unexpected end of compressed literals");
+    auto streams = data.slice(header_size, compressed_size);
+
+    if (literals_block_type == 2)
+        m_huffman_table = TRY(read_huffman_table(streams));
+    else if (!m_huffman_table.has_value())
+        return Error::from_string_literal("Zstd: Treeless literals block without a previous Huffman table");
+
+    TRY(m_literals.try_resize(regenerated_size));
+    if (single_stream) {
+        TRY(decode_huffman_stream(*m_huffman_table, streams, m_literals.span()));
+        return header_size + compressed_size;
+    }
+
+    // 3.1.1.3.1.6. Jump_Table: The sizes of the first three streams, the fourth one takes up the rest.
+    if (streams.size() < 6)
+        return Error::from_string_literal("Zstd: Unexpected end of literals jump table");
+    Array<size_t, 4> stream_sizes;
+    size_t total_size = 6;
+    for (size_t i = 0; i < 3; ++i) {
+        stream_sizes[i] = read_little_endian(streams.slice(i * 2, 2));
+        total_size += stream_sizes[i];
+    }
+    if (total_size > streams.size())
+        return Error::from_string_literal("Zstd: Invalid literals jump table");
+    stream_sizes[3] = streams.size() - total_size;
+    streams = streams.slice(6);
+
+    size_t const segment_size = ceil_div(regenerated_size, static_cast<size_t>(4));
+    if (segment_size * 3 > regenerated_size)
+        return Error::from_string_literal("Zstd: Too few literals for four streams");
+    Bytes output = m_literals.span();
+    for (size_t i = 0; i < 4; ++i) {
+        auto const output_size = i < 3 ? segment_size : output.size();
+        TRY(decode_huffman_stream(*m_huffman_table, streams.trim(stream_sizes[i]), output.trim(output_size)));
+        streams = streams.slice(stream_sizes[i]);
+        output = output.slice(output_size);
+    }
+
+    return header_size + compressed_size;
+}
+
+// 3.1.1.3.2. Sequences Section
+ErrorOr<void> ZstdDecompressor::decode_sequences(ReadonlyBytes data)
+{
+    if (data.is_empty())
+        return Error::from_string_literal("Zstd: Missing sequences section");
+
+    size_t sequence_count = data[0];
+    if (sequence_count == 0)
+        return append_to_window(m_literals.span());
+
+    if (sequence_count < 128) {
+        data = data.slice(1);
+    } else if (sequence_count < 255) {
+        if (data.size() < 2)
+            return Error::from_string_literal("Zstd: Unexpected end of sequences section header");
+        sequence_count = ((sequence_count - 128) << 8) + data[1];
+        data = data.slice(2);
+    } else {
+        if (data.size() < 3)
+            return Error::from_string_literal("Zstd: Unexpected end of sequences section header");
+        sequence_count = data[1] + (data[2] << 8) + 0x7F00;
+        data = data.slice(3);
+    }
+
+    if (data.is_empty())
+        return Error::from_string_literal("Zstd: Unexpected end of sequences section header");
+    u8 const compression_modes = data[0];
+    data = data.slice(1);
+    if (compression_modes & 3)
+        return Error::from_string_literal("Zstd: Reserved bits in sequences section header are set");
+
+    auto read_table = [&](Optional<FSETable>& table, u8 mode, ReadonlySpan<i16> default_distribution, size_t default_accuracy_log, size_t maximum_accuracy_log, size_t symbol_count) -> ErrorOr<void> {
+        switch (mode) {
+        case 0:
+            // Predefined_Mode
+            table = TRY(build_fse_table(default_distribution, default_accuracy_log));
+            return {};
+        case 1:
+            // RLE_Mode
+            if (data.is_empty())
+                return Error::from_string_literal("Zstd: Unexpected end of sequences section header");
+            if (data[0] >= symbol_count)
+                return Error::from_string_literal("Zstd: Invalid RLE symbol");
+            table = rle_fse_table(data[0]);
+            data = data.slice(1);
+            return {};
+        case 2:
+            // FSE_Compressed_Mode
+            table = TRY(read_fse_table(data, maximum_accuracy_log, symbol_count));
+            return {};
+        default:
+            // Repeat_Mode
+            if (!table.has_value())
+                return Error::from_string_literal("Zstd: Repeated FSE table without a previous table");
+            return {};
+        }
+    };
+
+    TRY(read_table(m_literal_lengths_table, compression_modes >> 6, literal_lengths_default_distribution, literal_lengths_default_accuracy_log, literal_lengths_maximum_accuracy_log, literal_lengths_symbol_count));
+    TRY(read_table(m_offsets_table, (compression_modes >> 4) & 3, offsets_default_distribution, offsets_default_accuracy_log, offsets_maximum_accuracy_log, offsets_symbol_count));
+    TRY(read_table(m_match_lengths_table, (compression_modes >> 2) & 3, match_lengths_default_distribution, match_lengths_default_accuracy_log, match_lengths_maximum_accuracy_log, match_lengths_symbol_count));
+
+    auto const& literal_lengths_table = *m_literal_lengths_table;
+    auto const& offsets_table = *m_offsets_table;
+    auto const& match_lengths_table = *m_match_lengths_table;
+
+    // 3.1.1.3.2.2. Sequence Execution: The states are initialized in the order literal lengths, offsets, match lengths
+    // and updated in the order literal lengths, match lengths, offsets.
+    auto reader = TRY(BackwardBitReader::create(data));
+    size_t literal_length_state = reader.read_bits(literal_lengths_table.accuracy_log);
+    size_t offset_state = reader.read_bits(offsets_table.accuracy_log);
+    size_t match_length_state = reader.read_bits(match_lengths_table.accuracy_log);
+
+    for (size_t i = 0; i < sequence_count; ++i) {
+        auto const& literal_length_entry = literal_lengths_table.entries[literal_length_state];
+        auto const& offset_entry = offsets_table.entries[offset_state];
+        auto const& match_length_entry = match_lengths_table.entries[match_length_state];
+
+        // The extra bits are read in the order offset, match length, literal length.
+        auto const offset_code = offset_entry.symbol;
+        size_t const offset_value = (static_cast<u64>(1) << offset_code) + reader.read_bits(offset_code);
+        auto const& match_length_code = match_length_codes[match_length_entry.symbol];
+        size_t const match_length = match_length_code.baseline + reader.read_bits(match_length_code.extra_bits);
+        auto const& literal_length_code = literal_length_codes[literal_length_entry.symbol];
+        size_t const literal_length = literal_length_code.baseline + reader.read_bits(literal_length_code.extra_bits);
+
+        if (i + 1 < sequence_count) {
+            literal_length_state = literal_length_entry.baseline + reader.read_bits(literal_length_entry.number_of_bits);
+            match_length_state = match_length_entry.baseline + reader.read_bits(match_length_entry.number_of_bits);
+            offset_state = offset_entry.baseline + reader.read_bits(offset_entry.number_of_bits);
+        }
+
+        TRY(execute_sequence(literal_length, offset_value, match_length));
+    }
+
+    if (reader.bit_offset() != 0)
+        return Error::from_string_literal("Zstd: Sequences bitstream has the wrong size");
+
+    // The literals that are left over after the last sequence are part of the block as well.
+    return append_to_window(m_literals.span().slice(m_literals_offset));
+}
+
+ErrorOr<void> ZstdDecompressor::execute_sequence(size_t literal_length, size_t offset_value, size_t match_length)
+{
+    if (literal_length > m_literals.size() - m_literals_offset)
+        return Error::from_string_literal("Zstd: Sequence uses more literals than there are");
+    TRY(append_to_window(m_literals.span().slice(m_literals_offset, literal_length)));
+    m_literals_offset += literal_length;
+
+    // 3.1.1.5. Repeat Offsets
+    size_t offset = 0;
+    if (offset_value > 3) {
+        offset = offset_value - 3;
+        m_repeated_offsets = { offset, m_repeated_offsets[0], m_repeated_offsets[1] };
+    } else {
+        auto const index = offset_value - 1 + (literal_length == 0 ? 1 : 0);
+        if (index == 0) {
+            offset = m_repeated_offsets[0];
+        } else if (index < 3) {
+            offset = m_repeated_offsets[index];
+            m_repeated_offsets = { offset, m_repeated_offsets[0], m_repeated_offsets[index == 1 ? 2 : 1] };
+        } else {
+            offset = m_repeated_offsets[0] - 1;
+            m_repeated_offsets = { offset, m_repeated_offsets[0], m_repeated_offsets[1] };
+        }
+    }
+
+    return copy_match(offset, match_length);
+}
+
+ErrorOr<void> ZstdDecompressor::append_to_window(ReadonlyBytes bytes)
+{
+    if (m_frame_content_size.has_value() && m_frame_decoded_size + bytes.size() > m_frame_content_size.value())
+        return Error::from_string_literal("Zstd: Frame contains more data than its content size");
+    if (m_window->write(bytes) != bytes.size())
+        return Error::from_string_literal("Zstd: Block decompresses to more data than the window can hold");
+
+    m_frame_decoded_size += bytes.size();
+    if (m_checksum.has_value())
+        m_checksum->update(bytes);
+    return {};
+}
+
+ErrorOr<void> ZstdDecompressor::copy_match(size_t offset, size_t length)
+{
+    if (offset == 0 || offset > m_frame_decoded_size || offset > m_window_size)
+        return Error::from_string_literal("Zstd: Match offset is out of range");
+
+    Array<u8, 4 * KiB> buffer;
+    if (offset >= length || offset >= buffer.size()) {
+        // Chunks of at most `offset` bytes never read anything they produce themselves.
+        while (length > 0) {
+            auto const copied = TRY(m_window->read_with_seekback(buffer.span().trim(min(length, offset)), offset));
+            TRY(append_to_window(copied));
+            length -= copied.size();
+        }
+        return {};
+    }
+
+    // The match overlaps the bytes it produces, so it just repeats the last `offset` bytes. Expanding them to (almost)
+    // fill the buffer makes short offsets as fast as long ones.
+    TRY(m_window->read_with_seekback(buffer.span().trim(offset), offset));
+    size_t pattern_size = offset;
+    while (pattern_size + offset <= buffer.size()) {
+        buffer.span().slice(pattern_size - offset, offset).copy_to(buffer.span().slice(pattern_size));
+        pattern_size += offset;
+    }
+    while (length > 0) {
+        auto const chunk_size = min(length, pattern_size);
+        TRY(append_to_window(buffer.span().trim(chunk_size)));
+        length -= chunk_size;
+    }
+    return {};
+}
+
+ErrorOr<ByteBuffer> ZstdDecompressor::decompress_all(ReadonlyBytes bytes)
+{
+    auto memory_stream = TRY(try_make<FixedMemoryStream>(bytes));
+    auto zstd_stream = TRY(ZstdDecompressor::construct(move(memory_stream)));
+    return zstd_stream->read_until_eof();
+}
+
+bool ZstdDecompressor::is_likely_compressed(ReadonlyBytes bytes)
+{
+    return bytes.size() >= 4 && read_little_endian(bytes.trim(4)) == zstd_magic_number;
+}
+
+}
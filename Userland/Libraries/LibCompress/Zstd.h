@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/ByteBuffer.h>
+#include <AK/CircularBuffer.h>
+#include <AK/MaybeOwned.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/Stream.h>
+#include <AK/Vector.h>
+#include <LibCrypto/Checksum/XXHash64.h>
+
+namespace Compress {
+
+// Zstandard, as specified by RFC 8878. Frames that depend on a dictionary are not supported.
+class ZstdDecompressor final : public Stream {
+public:
+    static ErrorOr<NonnullOwnPtr<ZstdDecompressor>> construct(MaybeOwned<Stream>);
+
+    virtual ErrorOr<Bytes> read(Bytes) override;
+    virtual ErrorOr<size_t> write(ReadonlyBytes) override;
+    virtual bool is_eof() const override;
+    virtual bool is_open() const override { return m_input_stream->is_open(); }
+    virtual void close() override { m_input_stream->close(); }
+
+    static ErrorOr<ByteBuffer> decompress_all(ReadonlyBytes);
+    static bool is_likely_compressed(ReadonlyBytes);
+
+    // 4.1. FSE
+    struct FSETableEntry {
+        u16 baseline { 0 };
+        u8 symbol { 0 };
+        u8 number_of_bits { 0 };
+    };
+    struct FSETable {
+        Vector<FSETableEntry> entries;
+        u8 accuracy_log { 0 };
+    };
+
+    // 4.2. Huffman Coding, indexed by the next `max_number_of_bits` bits of the stream.
+    struct HuffmanTableEntry {
+        u8 symbol { 0 };
+        u8 number_of_bits { 0 };
+    };
+    struct HuffmanTable {
+        Vector<HuffmanTableEntry> entries;
+        u8 max_number_of_bits { 0 };
+    };
+
+private:
+    enum class State {
+        FrameHeader,
+        Block,
+        Finished,
+    };
+
+    ZstdDecompressor(MaybeOwned<Stream>);
+
+    ErrorOr<void> read_frame_header();
+    ErrorOr<void> read_block();
+    ErrorOr<void> finish_frame();
+
+    ErrorOr<size_t> read_literals_section(ReadonlyBytes);
+    ErrorOr<void> decode_sequences(ReadonlyBytes);
+    ErrorOr<void> execute_sequence(size_t literal_length, size_t offset_value, size_t match_length);
+
+    ErrorOr<void> append_to_window(ReadonlyBytes);
+    ErrorOr<void> copy_match(size_t offset, size_t length);
+
+    MaybeOwned<Stream> m_input_stream;
+    State m_state { State::FrameHeader };
+
+    // The decompressed data that hasn't been read yet, followed by up to a window's worth of history for matches.
+    Optional<CircularBuffer> m_window;
+
+    // Per-frame state.
+    size_t m_window_size { 0 };
+    size_t m_maximum_block_size { 0 };
+    Optional<u64> m_frame_content_size;
+    u64 m_frame_decoded_size { 0 };
+    Optional<Crypto::Checksum::XXHash64> m_checksum;
+
+    // The tables of a block can be reused by the following blocks of the same frame.
+    Array<size_t, 3> m_repeated_offsets {};
+    Optional<HuffmanTable> m_huffman_table;
+    Optional<FSETable> m_literal_lengths_table;
+    Optional<FSETable> m_offsets_table;
+    Optional<FSETable> m_match_lengths_table;
+
+    ByteBuffer m_block_buffer;
+    Vector<u8> m_literals;
+    size_t m_literals_offset { 0 };
+};
+
+}
@@ -435,31 +435,29 @@ ErrorOr<void, DeprecatedFile::CopyError> DeprecatedFile::copy_file_or_directory(
     return copy_file(dst_path, src_stat, source, preserve_mode);
 }
 
-ErrorOr<void, DeprecatedFile::CopyError> DeprecatedFile::copy_file(DeprecatedString const& dst_path, struct stat const& src_stat, DeprecatedFile& source, PreserveMode preserve_mode)
+static ErrorOr<void, DeprecatedFile::CopyError> copy_file_data(int dst_fd, int src_fd)
 {
-    int dst_fd = creat(dst_path.characters(), 0666);
-    if (dst_fd < 0) {
-        if (errno != EISDIR)
-            return CopyError { errno, false };
-
-        auto dst_dir_path = DeprecatedString::formatted("{}/{}", dst_path, LexicalPath::basename(source.filename()));
-        dst_fd = creat(dst_dir_path.characters(), 0666);
-        if (dst_fd < 0)
-            return CopyError { errno, false };
-    }
-
-    ScopeGuard close_fd_guard([dst_fd]() { ::close(dst_fd); });
-
-    if (src_stat.st_size > 0) {
-        if (ftruncate(dst_fd, src_stat.st_size) < 0)
-            return CopyError { errno, false };
+    // Let the kernel move the data over, which saves copying all of it through our buffer, and lets the file system
+    // share the blocks instead if it can. Files that it can't copy that way are copied by hand.
+    for (;;) {
+        auto copied_or_error = System::copy_file_range(src_fd, nullptr, dst_fd, nullptr, 16 * MiB);
+        if (copied_or_error.is_error()) {
+            auto code = copied_or_error.error().code();
+            if (code != ENOTSUP && code != ENOSYS && code != EINVAL && code != EXDEV && code != EBADF)
+                return DeprecatedFile::CopyError { code, false };
+            break;
+        }
+        if (copied_or_error.value() == 0)
+            break;
     }
 
+    // NOTE: Some files (like the ones in /sys) claim to be empty even though they can be read from, so we always
+    //       read until the end of the file.
     for (;;) {
         char buffer[32768];
-        ssize_t nread = ::read(source.fd(), buffer, sizeof(buffer));
+        ssize_t nread = ::read(src_fd, buffer, sizeof(buffer));
         if (nread < 0) {
-            return CopyError { errno, false };
+            return DeprecatedFile::CopyError { errno, false };
         }
         if (nread == 0)
             break;
@@ -468,7 +466,7 @@ ErrorOr<void, DeprecatedFile::CopyError> DeprecatedFile::copy_file(DeprecatedStr
         while (remaining_to_write) {
             ssize_t nwritten = ::write(dst_fd, bufptr, remaining_to_write);
             if (nwritten < 0)
-                return CopyError { errno, false };
+                return DeprecatedFile::CopyError { errno, false };
 
             VERIFY(nwritten > 0);
             remaining_to_write -= nwritten;
@@ -476,21 +474,31 @@ ErrorOr<void, DeprecatedFile::CopyError> DeprecatedFile::copy_file(DeprecatedStr
         }
     }
 
-    auto my_umask = umask(0);
-    umask(my_umask);
+    return {};
+}
+
+static ErrorOr<void, DeprecatedFile::CopyError> copy_file_data_and_metadata(int dst_fd, DeprecatedString const& dst_path, int src_fd, struct stat const& src_stat, mode_t my_umask, DeprecatedFile::PreserveMode preserve_mode)
+{
+    if (src_stat.st_size > 0) {
+        if (ftruncate(dst_fd, src_stat.st_size) < 0)
+            return DeprecatedFile::CopyError { errno, false };
+    }
+
+    TRY(copy_file_data(dst_fd, src_fd));
+
     // NOTE: We don't copy the set-uid and set-gid bits unless requested.
-    if (!has_flag(preserve_mode, PreserveMode::Permissions))
+    if (!has_flag(preserve_mode, DeprecatedFile::PreserveMode::Permissions))
         my_umask |= 06000;
 
     if (fchmod(dst_fd, src_stat.st_mode & ~my_umask) < 0)
-        return CopyError { errno, false };
+        return DeprecatedFile::CopyError { errno, false };
 
-    if (has_flag(preserve_mode, PreserveMode::Ownership)) {
+    if (has_flag(preserve_mode, DeprecatedFile::PreserveMode::Ownership)) {
         if (fchown(dst_fd, src_stat.st_uid, src_stat.st_gid) < 0)
-            return CopyError { errno, false };
+            return DeprecatedFile::CopyError { errno, false };
     }
 
-    if (has_flag(preserve_mode, PreserveMode::Timestamps)) {
+    if (has_flag(preserve_mode, DeprecatedFile::PreserveMode::Timestamps)) {
         struct timespec times[2] = {
 #ifdef AK_OS_MACOS
             src_stat.st_atimespec,
@@ -501,12 +509,55 @@ ErrorOr<void, DeprecatedFile::CopyError> DeprecatedFile::copy_file(DeprecatedStr
 #endif
         };
         if (utimensat(AT_FDCWD, dst_path.characters(), times, 0) < 0)
-            return CopyError { errno, false };
+            return DeprecatedFile::CopyError { errno, false };
     }
 
     return {};
 }
 
+ErrorOr<void, DeprecatedFile::CopyError> DeprecatedFile::copy_file(DeprecatedString const& dst_path, struct stat const& src_stat, DeprecatedFile& source, PreserveMode preserve_mode)
+{
+    auto dst_file_path = dst_path;
+    int dst_fd = creat(dst_file_path.characters(), 0666);
+    if (dst_fd < 0) {
+        if (errno != EISDIR)
+            return CopyError { errno, false };
+
+        dst_file_path = DeprecatedString::formatted("{}/{}", dst_path, LexicalPath::basename(source.filename()));
+        dst_fd = creat(dst_file_path.characters(), 0666);
+        if (dst_fd < 0)
+            return CopyError { errno, false };
+    }
+
+    ScopeGuard close_fd_guard([dst_fd]() { ::close(dst_fd); });
+
+    auto my_umask = umask(0);
+    umask(my_umask);
+
+    return copy_file_data_and_metadata(dst_fd, dst_file_path, source.fd(), src_stat, my_umask, preserve_mode);
+}
+
+ErrorOr<void, DeprecatedFile::CopyError> DeprecatedFile::copy_regular_file(DeprecatedString const& dst_path, DeprecatedString const& src_path, mode_t my_umask, PreserveMode preserve_mode)
+{
+    int src_fd = ::open(src_path.characters(), O_RDONLY | O_CLOEXEC);
+    if (src_fd < 0)
+        return CopyError { errno, false };
+
+    ScopeGuard close_src_fd_guard([src_fd]() { ::close(src_fd); });
+
+    struct stat src_stat;
+    if (fstat(src_fd, &src_stat) < 0)
+        return CopyError { errno, false };
+
+    int dst_fd = ::open(dst_path.characters(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+    if (dst_fd < 0)
+        return CopyError { errno, false };
+
+    ScopeGuard close_dst_fd_guard([dst_fd]() { ::close(dst_fd); });
+
+    return copy_file_data_and_metadata(dst_fd, dst_path, src_fd, src_stat, my_umask, preserve_mode);
+}
+
 ErrorOr<void, DeprecatedFile::CopyError> DeprecatedFile::copy_directory(DeprecatedString const& dst_path, DeprecatedString const& src_path, struct stat const& src_stat, LinkMode link, PreserveMode preserve_mode)
 {
     if (mkdir(dst_path.characters(), 0755) < 0)
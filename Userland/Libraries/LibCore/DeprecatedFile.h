@@ -87,6 +87,9 @@ public:
     };
 
     static ErrorOr<void, CopyError> copy_file(DeprecatedString const& dst_path, struct stat const& src_stat, DeprecatedFile& source, PreserveMode = PreserveMode::Nothing);
+    // Unlike copy_file(), this doesn't construct any Core::Object, so it's safe to call from several threads at once.
+    // Reading the umask means changing it for a moment, so the caller reads it once up front and passes it in.
+    static ErrorOr<void, CopyError> copy_regular_file(DeprecatedString const& dst_path, DeprecatedString const& src_path, mode_t umask, PreserveMode = PreserveMode::Nothing);
     static ErrorOr<void, CopyError> copy_directory(DeprecatedString const& dst_path, DeprecatedString const& src_path, struct stat const& src_stat, LinkMode = LinkMode::Disallowed, PreserveMode = PreserveMode::Nothing);
     static ErrorOr<void, CopyError> copy_file_or_directory(DeprecatedString const& dst_path, DeprecatedString const& src_path, RecursionMode = RecursionMode::Allowed, LinkMode = LinkMode::Disallowed, AddDuplicateFileMarker = AddDuplicateFileMarker::Yes, PreserveMode = PreserveMode::Nothing);
 
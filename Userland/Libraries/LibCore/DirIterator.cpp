@@ -6,6 +6,7 @@
 
 #include <AK/Vector.h>
 #include <LibCore/DirIterator.h>
+#include <LibCore/System.h>
 #include <errno.h>
 #include <unistd.h>
 
@@ -49,40 +50,55 @@ bool DirIterator::advance_next()
         auto* de = readdir(m_dir);
         if (!de) {
             m_error = errno;
-            m_next = DeprecatedString();
+            m_next.clear();
             return false;
         }
 
-        m_next = de->d_name;
-        if (m_next.is_null())
+        m_next = DirectoryEntry::from_dirent(*de);
+        auto const& name = m_next->name;
+        if (name.is_null()) {
+            m_next.clear();
             return false;
+        }
 
-        if (m_flags & Flags::SkipDots && m_next.starts_with('.'))
+        if (m_flags & Flags::SkipDots && name.starts_with('.'))
             continue;
 
-        if (m_flags & Flags::SkipParentAndBaseDir && (m_next == "." || m_next == ".."))
+        if (m_flags & Flags::SkipParentAndBaseDir && (name == "." || name == ".."))
             continue;
 
-        return !m_next.is_empty();
+        if (name.is_empty()) {
+            m_next.clear();
+            return false;
+        }
+        return true;
     }
 }
 
 bool DirIterator::has_next()
 {
-    if (!m_next.is_null())
+    if (m_next.has_value())
         return true;
 
     return advance_next();
 }
 
-DeprecatedString DirIterator::next_path()
+Optional<DirectoryEntry> DirIterator::next()
 {
-    if (m_next.is_null())
+    if (!m_next.has_value())
         advance_next();
 
-    auto tmp = m_next;
-    m_next = DeprecatedString();
-    return tmp;
+    auto result = move(m_next);
+    m_next.clear();
+    return result;
+}
+
+DeprecatedString DirIterator::next_path()
+{
+    auto entry = next();
+    if (!entry.has_value())
+        return DeprecatedString();
+    return entry->name;
 }
 
 DeprecatedString DirIterator::next_full_path()
@@ -102,4 +118,11 @@ int DirIterator::fd() const
     return dirfd(m_dir);
 }
 
+ErrorOr<struct stat> DirIterator::stat(DirectoryEntry const& entry) const
+{
+    if (!m_dir)
+        return Error::from_errno(EBADF);
+    return System::fstatat(dirfd(m_dir), entry.name, AT_SYMLINK_NOFOLLOW);
+}
+
 }
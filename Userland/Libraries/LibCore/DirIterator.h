@@ -7,8 +7,12 @@
 #pragma once
 
 #include <AK/DeprecatedString.h>
+#include <AK/Error.h>
+#include <AK/Optional.h>
+#include <LibCore/DirectoryEntry.h>
 #include <dirent.h>
 #include <string.h>
+#include <sys/stat.h>
 
 namespace Core {
 
@@ -30,14 +34,18 @@ public:
     int error() const { return m_error; }
     char const* error_string() const { return strerror(m_error); }
     bool has_next();
+    Optional<DirectoryEntry> next();
     DeprecatedString next_path();
     DeprecatedString next_full_path();
     int fd() const;
 
+    // Stats an entry relative to the directory itself, which saves resolving its full path again.
+    ErrorOr<struct stat> stat(DirectoryEntry const&) const;
+
 private:
     DIR* m_dir = nullptr;
     int m_error = 0;
-    DeprecatedString m_next;
+    Optional<DirectoryEntry> m_next;
     DeprecatedString m_path;
     int m_flags;
 
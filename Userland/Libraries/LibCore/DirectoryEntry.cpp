@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/DirectoryEntry.h>
+#include <sys/stat.h>
+
+namespace Core {
+
+static DirectoryEntry::Type type_from_dirent_type(unsigned char d_type)
+{
+    switch (d_type) {
+    case DT_BLK:
+        return DirectoryEntry::Type::BlockDevice;
+    case DT_CHR:
+        return DirectoryEntry::Type::CharacterDevice;
+    case DT_DIR:
+        return DirectoryEntry::Type::Directory;
+    case DT_FIFO:
+        return DirectoryEntry::Type::NamedPipe;
+    case DT_LNK:
+        return DirectoryEntry::Type::SymbolicLink;
+    case DT_REG:
+        return DirectoryEntry::Type::File;
+    case DT_SOCK:
+        return DirectoryEntry::Type::Socket;
+#ifdef DT_WHT
+    case DT_WHT:
+        return DirectoryEntry::Type::Whiteout;
+#endif
+    default:
+        return DirectoryEntry::Type::Unknown;
+    }
+}
+
+DirectoryEntry DirectoryEntry::from_dirent(dirent const& de)
+{
+    return DirectoryEntry {
+        .type = type_from_dirent_type(de.d_type),
+        .name = de.d_name,
+        .inode_number = de.d_ino,
+    };
+}
+
+DirectoryEntry::Type DirectoryEntry::type_from_stat_mode(mode_t mode)
+{
+    if (S_ISBLK(mode))
+        return Type::BlockDevice;
+    if (S_ISCHR(mode))
+        return Type::CharacterDevice;
+    if (S_ISDIR(mode))
+        return Type::Directory;
+    if (S_ISFIFO(mode))
+        return Type::NamedPipe;
+    if (S_ISLNK(mode))
+        return Type::SymbolicLink;
+    if (S_ISREG(mode))
+        return Type::File;
+    if (S_ISSOCK(mode))
+        return Type::Socket;
+    return Type::Unknown;
+}
+
+}
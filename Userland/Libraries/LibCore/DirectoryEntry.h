@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/DeprecatedString.h>
+#include <dirent.h>
+#include <sys/types.h>
+
+namespace Core {
+
+// One entry of a directory, as returned by the kernel along with the directory listing.
+// Knowing the type of an entry doesn't require a stat(), which is what makes walking large trees fast.
+struct DirectoryEntry {
+    enum class Type {
+        BlockDevice,
+        CharacterDevice,
+        Directory,
+        File,
+        NamedPipe,
+        Socket,
+        SymbolicLink,
+        Unknown,
+        Whiteout,
+    };
+
+    Type type;
+    DeprecatedString name;
+    ino_t inode_number;
+
+    static DirectoryEntry from_dirent(dirent const&);
+    static Type type_from_stat_mode(mode_t);
+};
+
+}
@@ -8,6 +8,7 @@
 
 #include <AK/Assertions.h>
 #include <AK/Badge.h>
+#include <AK/BuiltinWrappers.h>
 #include <AK/Debug.h>
 #include <AK/Format.h>
 #include <AK/IDAllocator.h>
@@ -39,6 +40,7 @@
 
 #ifdef AK_OS_SERENITY
 #    include <LibCore/Account.h>
+#    include <sys/epoll.h>
 
 extern bool s_global_initializers_ran;
 #endif
@@ -50,15 +52,21 @@ class InspectorServerConnection;
 [[maybe_unused]] static bool connect_to_inspector_server();
 
 struct EventLoopTimer {
+    // Marks timers that have expired while their owner wasn't visible, and wait in s_parked_timers instead of the heap.
+    static constexpr size_t parked = NumericLimits<size_t>::max();
+
     int timer_id { 0 };
     Time interval;
     Time fire_time;
     bool should_reload { false };
     TimerShouldFireWhenNotVisible fire_when_not_visible { TimerShouldFireWhenNotVisible::No };
+    TimerPrecision precision { TimerPrecision::Precise };
     WeakPtr<Object> owner;
+    size_t heap_index { 0 };
 
     void reload(Time const& now);
     bool has_expired(Time const& now) const;
+    bool is_waiting_for_visibility() const;
 };
 
 struct EventLoop::Private {
@@ -71,7 +79,81 @@ static Threading::MutexProtected<RefPtr<InspectorServerConnection>> s_inspector_
 // Each thread has its own event loop stack, its own timers, notifiers and a wake pipe.
 static thread_local Vector<EventLoop&>* s_event_loop_stack;
 static thread_local HashMap<int, NonnullOwnPtr<EventLoopTimer>>* s_timers;
+// A min-heap of the timers in s_timers by fire time, so we can find the next one to expire without looking at all of them.
+static thread_local Vector<EventLoopTimer*>* s_timer_heap;
+static thread_local HashTable<EventLoopTimer*>* s_parked_timers;
 static thread_local HashTable<Notifier*>* s_notifiers;
+#ifdef AK_OS_SERENITY
+// On Serenity, the kernel keeps the set of file descriptors we wait on in an epoll instance,
+// so we only tell it about changes instead of handing it every notifier on each iteration.
+// Several notifiers may share a file descriptor, so we keep track of them per descriptor.
+static thread_local HashMap<int, Vector<Notifier*, 1>>* s_notifiers_by_fd;
+static thread_local int s_epoll_fd { -1 };
+static constexpr size_t max_epoll_events_per_wait = 64;
+#endif
+static bool timer_fires_before(EventLoopTimer const& a, EventLoopTimer const& b)
+{
+    return a.fire_time < b.fire_time;
+}
+
+static void timer_heap_swap(size_t a, size_t b)
+{
+    auto& heap = *s_timer_heap;
+    swap(heap[a], heap[b]);
+    heap[a]->heap_index = a;
+    heap[b]->heap_index = b;
+}
+
+static void timer_heap_sift_up(size_t index)
+{
+    while (index > 0) {
+        auto parent = (index - 1) / 2;
+        if (!timer_fires_before(*s_timer_heap->at(index), *s_timer_heap->at(parent)))
+            break;
+        timer_heap_swap(index, parent);
+        index = parent;
+    }
+}
+
+static void timer_heap_sift_down(size_t index)
+{
+    auto size = s_timer_heap->size();
+    for (;;) {
+        auto smallest = index;
+        for (auto child = 2 * index + 1; child <= 2 * index + 2 && child < size; ++child) {
+            if (timer_fires_before(*s_timer_heap->at(child), *s_timer_heap->at(smallest)))
+                smallest = child;
+        }
+        if (smallest == index)
+            break;
+        timer_heap_swap(index, smallest);
+        index = smallest;
+    }
+}
+
+static void timer_heap_insert(EventLoopTimer& timer)
+{
+    timer.heap_index = s_timer_heap->size();
+    s_timer_heap->append(&timer);
+    timer_heap_sift_up(timer.heap_index);
+}
+
+static void timer_heap_remove(EventLoopTimer& timer)
+{
+    auto index = timer.heap_index;
+    auto last_index = s_timer_heap->size() - 1;
+    if (index != last_index) {
+        timer_heap_swap(index, last_index);
+        s_timer_heap->take_last();
+        // The timer that took its place may belong further up or further down.
+        auto& moved_timer = *s_timer_heap->at(index);
+        timer_heap_sift_up(index);
+        timer_heap_sift_down(moved_timer.heap_index);
+    } else {
+        s_timer_heap->take_last();
+    }
+}
+
 // The wake pipe is both responsible for notifying us when someone calls wake(), as well as POSIX signals.
 // While wake() pushes zero into the pipe, signal numbers (by defintion nonzero, see signal_numbers.h) are pushed into the pipe verbatim.
 thread_local int EventLoop::s_wake_pipe_fds[2];
@@ -90,6 +172,17 @@ void EventLoop::initialize_wake_pipes()
 #endif
         VERIFY(rc == 0);
         s_wake_pipe_initialized = true;
+
+#ifdef AK_OS_SERENITY
+        VERIFY(s_epoll_fd < 0);
+        s_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        VERIFY(s_epoll_fd >= 0);
+        epoll_event event {};
+        event.events = EPOLLIN;
+        event.data.fd = s_wake_pipe_fds[0];
+        rc = epoll_ctl(s_epoll_fd, EPOLL_CTL_ADD, s_wake_pipe_fds[0], &event);
+        VERIFY(rc == 0);
+#endif
     }
 }
 
@@ -330,7 +423,12 @@ EventLoop::EventLoop([[maybe_unused]] MakeInspectable make_inspectable)
     if (!s_event_loop_stack) {
         s_event_loop_stack = new Vector<EventLoop&>;
         s_timers = new HashMap<int, NonnullOwnPtr<EventLoopTimer>>;
+        s_timer_heap = new Vector<EventLoopTimer*>;
+        s_parked_timers = new HashTable<EventLoopTimer*>;
         s_notifiers = new HashTable<Notifier*>;
+#ifdef AK_OS_SERENITY
+        s_notifiers_by_fd = new HashMap<int, Vector<Notifier*, 1>>;
+#endif
     }
 
     if (s_event_loop_stack->is_empty()) {
@@ -665,7 +763,17 @@ void EventLoop::notify_forked(ForkEvent event)
     case ForkEvent::Child:
         s_event_loop_stack->clear();
         s_timers->clear();
+        s_timer_heap->clear();
+        s_parked_timers->clear();
         s_notifiers->clear();
+#ifdef AK_OS_SERENITY
+        // The epoll instance is shared with our parent, so we need our own.
+        s_notifiers_by_fd->clear();
+        if (s_epoll_fd >= 0) {
+            close(s_epoll_fd);
+            s_epoll_fd = -1;
+        }
+#endif
         s_wake_pipe_initialized = false;
         initialize_wake_pipes();
         if (auto* info = signals_info<false>()) {
@@ -681,10 +789,15 @@ void EventLoop::notify_forked(ForkEvent event)
 
 void EventLoop::wait_for_event(WaitMode mode)
 {
+#ifdef AK_OS_SERENITY
+    epoll_event ready_events[max_epoll_events_per_wait];
+#else
     fd_set rfds;
     fd_set wfds;
+#endif
 retry:
 
+#ifndef AK_OS_SERENITY
     // Set up the file descriptors for select().
     // Basically, we translate high-level event information into low-level selectable file descriptors.
     FD_ZERO(&rfds);
@@ -710,6 +823,7 @@ retry:
         if (notifier->event_mask() & Notifier::Exceptional)
             VERIFY_NOT_REACHED();
     }
+#endif
 
     bool queued_events_is_empty;
     {
@@ -736,8 +850,15 @@ retry:
     }
 
 try_select_again:
+#ifdef AK_OS_SERENITY
+    // epoll_wait() for file system events, calls to wake(), POSIX signals, or timer expirations.
+    // Round the timeout up so we don't wake up just before a timer is due and spin until it is.
+    int timeout_ms = should_wait_forever ? -1 : static_cast<int>(timeout.tv_sec * 1000 + (timeout.tv_usec + 999) / 1000);
+    int marked_fd_count = epoll_wait(s_epoll_fd, ready_events, max_epoll_events_per_wait, timeout_ms);
+#else
     // select() and wait for file system events, calls to wake(), POSIX signals, or timer expirations.
     int marked_fd_count = select(max_fd + 1, &rfds, &wfds, nullptr, should_wait_forever ? nullptr : &timeout);
+#endif
     // Because POSIX, we might spuriously return from select() with EINTR; just select again.
     if (marked_fd_count < 0) {
         int saved_errno = errno;
@@ -750,9 +871,21 @@ try_select_again:
         VERIFY_NOT_REACHED();
     }
 
+#ifdef AK_OS_SERENITY
+    bool wake_pipe_is_readable = false;
+    for (int i = 0; i < marked_fd_count; ++i) {
+        if (ready_events[i].data.fd == s_wake_pipe_fds[0]) {
+            wake_pipe_is_readable = true;
+            break;
+        }
+    }
+#else
+    bool wake_pipe_is_readable = FD_ISSET(s_wake_pipe_fds[0], &rfds);
+#endif
+
     // We woke up due to a call to wake() or a POSIX signal.
     // Handle signals and see whether we need to handle events as well.
-    if (FD_ISSET(s_wake_pipe_fds[0], &rfds)) {
+    if (wake_pipe_is_readable) {
         int wake_events[8];
         ssize_t nread;
         // We might receive another signal while read()ing here. The signal will go to the handle_signal properly,
@@ -785,23 +918,40 @@ try_select_again:
         now = Time::now_monotonic_coarse();
     }
 
+    // Timers that expired while their owner was invisible fire once it becomes visible again.
+    if (!s_parked_timers->is_empty()) {
+        Vector<EventLoopTimer*> timers_to_unpark;
+        for (auto* timer : *s_parked_timers) {
+            if (!timer->is_waiting_for_visibility())
+                timers_to_unpark.append(timer);
+        }
+        for (auto* timer : timers_to_unpark) {
+            s_parked_timers->remove(timer);
+            timer_heap_insert(*timer);
+        }
+    }
+
     // Handle expired timers.
-    for (auto& it : *s_timers) {
-        auto& timer = *it.value;
+    while (!s_timer_heap->is_empty()) {
+        auto& timer = *s_timer_heap->first();
         if (!timer.has_expired(now))
-            continue;
-        auto owner = timer.owner.strong_ref();
-        if (timer.fire_when_not_visible == TimerShouldFireWhenNotVisible::No
-            && owner && !owner->is_visible_for_timer_purposes()) {
+            break;
+
+        if (timer.is_waiting_for_visibility()) {
+            timer_heap_remove(timer);
+            timer.heap_index = EventLoopTimer::parked;
+            s_parked_timers->set(&timer);
             continue;
         }
 
+        auto owner = timer.owner.strong_ref();
         dbgln_if(EVENTLOOP_DEBUG, "Core::EventLoop: Timer {} has expired, sending Core::TimerEvent to {}", timer.timer_id, *owner);
 
         if (owner)
             post_event(*owner, make<TimerEvent>(timer.timer_id));
         if (timer.should_reload) {
             timer.reload(now);
+            timer_heap_sift_down(timer.heap_index);
         } else {
             // FIXME: Support removing expired timers that don't want to reload.
             VERIFY_NOT_REACHED();
@@ -812,6 +962,23 @@ try_select_again:
         return;
 
     // Handle file system notifiers by making them normal events.
+#ifdef AK_OS_SERENITY
+    for (int i = 0; i < marked_fd_count; ++i) {
+        auto& ready_event = ready_events[i];
+        auto it = s_notifiers_by_fd->find(ready_event.data.fd);
+        if (it == s_notifiers_by_fd->end())
+            continue;
+        // Like select(), consider a descriptor that hung up or has an error both readable and writable.
+        bool is_readable = ready_event.events & (EPOLLIN | EPOLLHUP | EPOLLERR);
+        bool is_writable = ready_event.events & (EPOLLOUT | EPOLLERR);
+        for (auto* notifier : it->value) {
+            if (is_readable && (notifier->event_mask() & Notifier::Event::Read))
+                post_event(*notifier, make<NotifierReadEvent>(notifier->fd()));
+            if (is_writable && (notifier->event_mask() & Notifier::Event::Write))
+                post_event(*notifier, make<NotifierWriteEvent>(notifier->fd()));
+        }
+    }
+#else
     for (auto& notifier : *s_notifiers) {
         if (FD_ISSET(notifier->fd(), &rfds)) {
             if (notifier->event_mask() & Notifier::Event::Read)
@@ -822,6 +989,7 @@ try_select_again:
                 post_event(*notifier, make<NotifierWriteEvent>(notifier->fd()));
         }
     }
+#endif
 }
 
 bool EventLoopTimer::has_expired(Time const& now) const
@@ -832,41 +1000,54 @@ bool EventLoopTimer::has_expired(Time const& now) const
 void EventLoopTimer::reload(Time const& now)
 {
     fire_time = now + interval;
+    if (precision == TimerPrecision::Precise)
+        return;
+
+    // Let the timer fire up to 1/16th of its interval late, rounded down to a power of two milliseconds.
+    // Rounding the fire time up to a multiple of that makes timers with similar intervals expire together,
+    // so we wake up once for all of them instead of once for each.
+    auto interval_ms = interval.to_milliseconds() / 16;
+    if (interval_ms <= 0)
+        return;
+    i64 const slack_ns = min<i64>(1ll << (63 - count_leading_zeroes(static_cast<u64>(interval_ms))), 1024) * 1'000'000;
+    auto fire_time_ns = fire_time.to_nanoseconds();
+    fire_time = Time::from_nanoseconds((fire_time_ns + slack_ns - 1) / slack_ns * slack_ns);
+}
+
+bool EventLoopTimer::is_waiting_for_visibility() const
+{
+    if (fire_when_not_visible == TimerShouldFireWhenNotVisible::Yes)
+        return false;
+    auto strong_owner = owner.strong_ref();
+    return strong_owner && !strong_owner->is_visible_for_timer_purposes();
 }
 
 Optional<Time> EventLoop::get_next_timer_expiration()
 {
-    auto now = Time::now_monotonic_coarse();
-    Optional<Time> soonest {};
-    for (auto& it : *s_timers) {
-        auto& fire_time = it.value->fire_time;
-        auto owner = it.value->owner.strong_ref();
-        if (it.value->fire_when_not_visible == TimerShouldFireWhenNotVisible::No
-            && owner && !owner->is_visible_for_timer_purposes()) {
-            continue;
-        }
-        // OPTIMIZATION: If we have a timer that needs to fire right away, we can stop looking here.
-        // FIXME: This whole operation could be O(1) with a better data structure.
-        if (fire_time < now)
-            return now;
-        if (!soonest.has_value() || fire_time < soonest.value())
-            soonest = fire_time;
+    for (auto* timer : *s_parked_timers) {
+        if (!timer->is_waiting_for_visibility())
+            return Time::now_monotonic_coarse();
     }
-    return soonest;
+    if (s_timer_heap->is_empty())
+        return {};
+    // NOTE: If the next timer's owner isn't visible, we wake up for nothing once and park the timer.
+    return s_timer_heap->first()->fire_time;
 }
 
-int EventLoop::register_timer(Object& object, int milliseconds, bool should_reload, TimerShouldFireWhenNotVisible fire_when_not_visible)
+int EventLoop::register_timer(Object& object, int milliseconds, bool should_reload, TimerShouldFireWhenNotVisible fire_when_not_visible, TimerPrecision precision)
 {
     VERIFY_EVENT_LOOP_INITIALIZED();
     VERIFY(milliseconds >= 0);
     auto timer = make<EventLoopTimer>();
     timer->owner = object;
     timer->interval = Time::from_milliseconds(milliseconds);
+    timer->precision = precision;
     timer->reload(Time::now_monotonic_coarse());
     timer->should_reload = should_reload;
     timer->fire_when_not_visible = fire_when_not_visible;
     int timer_id = s_id_allocator.with_locked([](auto& allocator) { return allocator->allocate(); });
     timer->timer_id = timer_id;
+    timer_heap_insert(*timer);
     s_timers->set(timer_id, move(timer));
     return timer_id;
 }
@@ -878,20 +1059,80 @@ bool EventLoop::unregister_timer(int timer_id)
     auto it = s_timers->find(timer_id);
     if (it == s_timers->end())
         return false;
+    auto& timer = *it->value;
+    if (timer.heap_index == EventLoopTimer::parked)
+        s_parked_timers->remove(&timer);
+    else
+        timer_heap_remove(timer);
     s_timers->remove(it);
     return true;
 }
 
+#ifdef AK_OS_SERENITY
+// Tell the kernel which events we want for fd, combining the event masks of all notifiers on it.
+static void update_epoll_interest(int fd)
+{
+    auto it = s_notifiers_by_fd->find(fd);
+    if (it == s_notifiers_by_fd->end()) {
+        // The descriptor may already have been closed, in which case the kernel has forgotten about it.
+        if (epoll_ctl(s_epoll_fd, EPOLL_CTL_DEL, fd, nullptr) < 0 && errno != ENOENT && errno != EBADF)
+            dbgln("Core::EventLoop: Failed to stop watching fd {}: {}", fd, strerror(errno));
+        return;
+    }
+
+    epoll_event event {};
+    event.data.fd = fd;
+    for (auto* notifier : it->value) {
+        if (notifier->event_mask() & Notifier::Read)
+            event.events |= EPOLLIN;
+        if (notifier->event_mask() & Notifier::Write)
+            event.events |= EPOLLOUT;
+        if (notifier->event_mask() & Notifier::Exceptional)
+            VERIFY_NOT_REACHED();
+    }
+
+    int rc = epoll_ctl(s_epoll_fd, EPOLL_CTL_ADD, fd, &event);
+    if (rc < 0 && errno == EEXIST)
+        rc = epoll_ctl(s_epoll_fd, EPOLL_CTL_MOD, fd, &event);
+    if (rc < 0)
+        dbgln("Core::EventLoop: Failed to watch fd {}: {}", fd, strerror(errno));
+}
+#endif
+
 void EventLoop::register_notifier(Badge<Notifier>, Notifier& notifier)
 {
     VERIFY_EVENT_LOOP_INITIALIZED();
-    s_notifiers->set(&notifier);
+    if (s_notifiers->set(&notifier) != HashSetResult::InsertedNewEntry)
+        return;
+#ifdef AK_OS_SERENITY
+    s_notifiers_by_fd->ensure(notifier.fd()).append(&notifier);
+    update_epoll_interest(notifier.fd());
+#endif
 }
 
 void EventLoop::unregister_notifier(Badge<Notifier>, Notifier& notifier)
 {
     VERIFY_EVENT_LOOP_INITIALIZED();
-    s_notifiers->remove(&notifier);
+    if (!s_notifiers->remove(&notifier))
+        return;
+#ifdef AK_OS_SERENITY
+    auto it = s_notifiers_by_fd->find(notifier.fd());
+    VERIFY(it != s_notifiers_by_fd->end());
+    it->value.remove_first_matching([&](auto* entry) { return entry == &notifier; });
+    if (it->value.is_empty())
+        s_notifiers_by_fd->remove(it);
+    update_epoll_interest(notifier.fd());
+#endif
+}
+
+void EventLoop::update_notifier(Badge<Notifier>, Notifier& notifier)
+{
+#ifdef AK_OS_SERENITY
+    if (s_notifiers && s_notifiers->contains(&notifier))
+        update_epoll_interest(notifier.fd());
+#else
+    (void)notifier;
+#endif
 }
 
 void EventLoop::wake_current()
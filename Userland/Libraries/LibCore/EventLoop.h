@@ -97,11 +97,12 @@ public:
     bool was_exit_requested() const { return m_exit_requested; }
 
     // The registration functions act upon the current loop of the current thread.
-    static int register_timer(Object&, int milliseconds, bool should_reload, TimerShouldFireWhenNotVisible);
+    static int register_timer(Object&, int milliseconds, bool should_reload, TimerShouldFireWhenNotVisible, TimerPrecision);
     static bool unregister_timer(int timer_id);
 
     static void register_notifier(Badge<Notifier>, Notifier&);
     static void unregister_notifier(Badge<Notifier>, Notifier&);
+    static void update_notifier(Badge<Notifier>, Notifier&);
 
     static int register_signal(int signo, Function<void(int)> handler);
     static void unregister_signal(int handler_id);
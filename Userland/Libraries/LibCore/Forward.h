@@ -42,6 +42,7 @@ class TimerEvent;
 class UDPServer;
 class UDPSocket;
 
+enum class TimerPrecision;
 enum class TimerShouldFireWhenNotVisible;
 
 }
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <LibCore/IORing.h>
+#include <LibCore/System.h>
+#include <serenity.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace Core {
+
+ErrorOr<NonnullOwnPtr<IORing>> IORing::create(u32 submission_entry_count)
+{
+    int fd = create_io_ring(submission_entry_count, static_cast<u32>(IORingFlags::CloseOnExec));
+    if (fd < 0)
+        return Error::from_syscall("create_io_ring"sv, -errno);
+
+    auto size = io_ring_size(submission_entry_count);
+    auto ring_or_error = System::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0, 0, "IORing"sv);
+    if (ring_or_error.is_error()) {
+        ::close(fd);
+        return ring_or_error.release_error();
+    }
+
+    return adopt_nonnull_own_or_enomem(new (nothrow) IORing(fd, static_cast<u8*>(ring_or_error.value()), size));
+}
+
+IORing::IORing(int fd, u8* ring, size_t size)
+    : m_fd(fd)
+    , m_ring(ring)
+    , m_size(size)
+{
+}
+
+IORing::~IORing()
+{
+    if (auto result = System::munmap(m_ring, m_size); result.is_error())
+        dbgln("Failed to unmap IORing (@ {:p}): {}", m_ring, result.error());
+    ::close(m_fd);
+}
+
+u32 IORing::queued_submission_count() const
+{
+    auto& queue = header().submissions;
+    return queue.tail - AK::atomic_load(&queue.head, AK::memory_order_acquire);
+}
+
+bool IORing::try_queue(IORingSubmission const& submission)
+{
+    auto& queue = header().submissions;
+    if (queued_submission_count() > queue.mask)
+        return false;
+
+    auto* entries = reinterpret_cast<IORingSubmission*>(m_ring + queue.entries_offset);
+    entries[queue.tail & queue.mask] = submission;
+    AK::atomic_store(&queue.tail, queue.tail + 1, AK::memory_order_release);
+    return true;
+}
+
+ErrorOr<size_t> IORing::submit()
+{
+    int rc = io_ring_enter(m_fd, queued_submission_count());
+    if (rc < 0)
+        return Error::from_syscall("io_ring_enter"sv, -errno);
+    return static_cast<size_t>(rc);
+}
+
+Optional<IORingCompletion> IORing::pop_completion()
+{
+    auto& queue = header().completions;
+    if (queue.head == AK::atomic_load(&queue.tail, AK::memory_order_acquire))
+        return {};
+
+    auto* entries = reinterpret_cast<IORingCompletion const*>(m_ring + queue.entries_offset);
+    auto completion = entries[queue.head & queue.mask];
+    AK::atomic_store(&queue.head, queue.head + 1, AK::memory_order_release);
+    return completion;
+}
+
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Error.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <Kernel/API/IORing.h>
+
+namespace Core {
+
+// A submission/completion ring shared with the kernel. Queue any number of
+// operations, hand them to the kernel with a single submit(), and reap the
+// completions straight from shared memory.
+class IORing {
+    AK_MAKE_NONCOPYABLE(IORing);
+    AK_MAKE_NONMOVABLE(IORing);
+
+public:
+    static ErrorOr<NonnullOwnPtr<IORing>> create(u32 submission_entry_count);
+    ~IORing();
+
+    // Returns false if the submission queue is full.
+    bool try_queue(IORingSubmission const&);
+    u32 queued_submission_count() const;
+
+    // Returns how many of the queued submissions the kernel consumed.
+    ErrorOr<size_t> submit();
+
+    Optional<IORingCompletion> pop_completion();
+
+    int fd() const { return m_fd; }
+
+private:
+    IORing(int fd, u8* ring, size_t size);
+
+    IORingHeader& header() { return *reinterpret_cast<IORingHeader*>(m_ring); }
+    IORingHeader const& header() const { return *reinterpret_cast<IORingHeader const*>(m_ring); }
+
+    int m_fd { -1 };
+    u8* m_ring { nullptr };
+    size_t m_size { 0 };
+};
+
+}
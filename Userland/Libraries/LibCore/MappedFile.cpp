@@ -48,6 +48,38 @@ MappedFile::MappedFile(void* ptr, size_t size)
 {
 }
 
+ErrorOr<void> MappedFile::set_access_pattern(AccessPattern access_pattern)
+{
+    if (m_size == 0)
+        return {};
+
+    int advice = MADV_NORMAL;
+    switch (access_pattern) {
+    case AccessPattern::Normal:
+        advice = MADV_NORMAL;
+        break;
+    case AccessPattern::Sequential:
+        advice = MADV_SEQUENTIAL;
+        break;
+    case AccessPattern::Random:
+        advice = MADV_RANDOM;
+        break;
+    }
+    return Core::System::madvise(m_data, m_size, advice);
+}
+
+ErrorOr<void> MappedFile::prefetch(size_t offset, size_t length)
+{
+    if (offset >= m_size)
+        return {};
+    length = min(length, m_size - offset);
+
+    // madvise() wants a page-aligned address.
+    auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    auto aligned_offset = offset & ~(page_size - 1);
+    return Core::System::madvise(static_cast<u8*>(m_data) + aligned_offset, length + (offset - aligned_offset), MADV_WILLNEED);
+}
+
 MappedFile::~MappedFile()
 {
     auto res = Core::System::munmap(m_data, m_size);
@@ -31,6 +31,18 @@ public:
 
     ReadonlyBytes bytes() const { return { m_data, m_size }; }
 
+    // How the file is going to be read. This decides how much of it the kernel reads in whenever
+    // something that isn't in memory yet is touched.
+    enum class AccessPattern {
+        Normal,
+        Sequential,
+        Random,
+    };
+    ErrorOr<void> set_access_pattern(AccessPattern);
+
+    // Reads the given part of the file in right away, so accessing it later doesn't fault.
+    ErrorOr<void> prefetch(size_t offset, size_t length);
+
 private:
     explicit MappedFile(void*, size_t);
 
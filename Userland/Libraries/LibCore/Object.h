@@ -65,6 +65,13 @@ enum class TimerShouldFireWhenNotVisible {
     Yes
 };
 
+// Coarse timers may fire a little late (up to 1/16th of their interval), which lets the event loop
+// handle timers with similar deadlines in a single wakeup.
+enum class TimerPrecision {
+    Precise = 0,
+    Coarse
+};
+
 #define C_OBJECT(klass)                                                                    \
 public:                                                                                    \
     virtual StringView class_name() const override                                         \
@@ -141,7 +148,7 @@ public:
     Object* parent() { return m_parent; }
     Object const* parent() const { return m_parent; }
 
-    void start_timer(int ms, TimerShouldFireWhenNotVisible = TimerShouldFireWhenNotVisible::No);
+    void start_timer(int ms, TimerShouldFireWhenNotVisible = TimerShouldFireWhenNotVisible::No, TimerPrecision = TimerPrecision::Precise);
     void stop_timer();
     bool has_timer() const { return m_timer_id; }
 
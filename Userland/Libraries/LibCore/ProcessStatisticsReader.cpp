@@ -5,9 +5,8 @@
  */
 
 #include <AK/ByteBuffer.h>
-#include <AK/JsonArray.h>
-#include <AK/JsonObject.h>
-#include <AK/JsonValue.h>
+#include <AK/HashMap.h>
+#include <Kernel/API/ProcessStatistics.h>
 #include <LibCore/File.h>
 #include <LibCore/ProcessStatisticsReader.h>
 #include <pwd.h>
@@ -16,6 +15,42 @@ namespace Core {
 
 HashMap<uid_t, DeprecatedString> ProcessStatisticsReader::s_usernames;
 
+namespace {
+
+class BinaryReader {
+public:
+    explicit BinaryReader(ReadonlyBytes bytes)
+        : m_bytes(bytes)
+    {
+    }
+
+    // Reads a record that may be larger (newer kernel) or smaller (older kernel) than T.
+    template<typename T>
+    ErrorOr<T> read_record(size_t record_size)
+    {
+        if (m_bytes.size() < record_size)
+            return Error::from_string_literal("Truncated process statistics record");
+        T record {};
+        memcpy(&record, m_bytes.data(), min(record_size, sizeof(T)));
+        m_bytes = m_bytes.slice(record_size);
+        return record;
+    }
+
+    ErrorOr<DeprecatedString> read_string(size_t length)
+    {
+        if (m_bytes.size() < length)
+            return Error::from_string_literal("Truncated process statistics string");
+        DeprecatedString string { m_bytes.trim(length) };
+        m_bytes = m_bytes.slice(length);
+        return string;
+    }
+
+private:
+    ReadonlyBytes m_bytes;
+};
+
+}
+
 ErrorOr<AllProcessesStatistics> ProcessStatisticsReader::get_all(SeekableStream& proc_all_file, bool include_usernames)
 {
     TRY(proc_all_file.seek(0, SeekMode::SetPosition));
@@ -23,75 +58,87 @@ ErrorOr<AllProcessesStatistics> ProcessStatisticsReader::get_all(SeekableStream&
     AllProcessesStatistics all_processes_statistics;
 
     auto file_contents = TRY(proc_all_file.read_until_eof());
-    auto json_obj = TRY(JsonValue::from_string(file_contents)).as_object();
-    json_obj.get_array("processes"sv)->for_each([&](auto& value) {
-        const JsonObject& process_object = value.as_object();
+    BinaryReader reader { file_contents };
+
+    // The header size is only known after reading part of it, so read the fixed part first.
+    if (file_contents.size() < sizeof(Kernel::ProcessStatisticsHeader))
+        return Error::from_string_literal("Truncated process statistics header");
+    Kernel::ProcessStatisticsHeader header;
+    memcpy(&header, file_contents.data(), sizeof(header));
+    if (header.magic != Kernel::process_statistics_magic)
+        return Error::from_string_literal("Bad process statistics magic");
+    if (header.header_size < sizeof(header))
+        return Error::from_string_literal("Bad process statistics header size");
+    TRY(reader.read_record<Kernel::ProcessStatisticsHeader>(header.header_size));
+
+    all_processes_statistics.processes.ensure_capacity(header.process_count);
+    for (u32 i = 0; i < header.process_count; ++i) {
+        auto record = TRY(reader.read_record<Kernel::ProcessStatisticsRecord>(header.process_record_size));
         Core::ProcessStatistics process;
 
         // kernel data first
-        process.pid = process_object.get_u32("pid"sv).value_or(0);
-        process.pgid = process_object.get_u32("pgid"sv).value_or(0);
-        process.pgp = process_object.get_u32("pgp"sv).value_or(0);
-        process.sid = process_object.get_u32("sid"sv).value_or(0);
-        process.uid = process_object.get_u32("uid"sv).value_or(0);
-        process.gid = process_object.get_u32("gid"sv).value_or(0);
-        process.ppid = process_object.get_u32("ppid"sv).value_or(0);
-        process.nfds = process_object.get_u32("nfds"sv).value_or(0);
-        process.kernel = process_object.get_bool("kernel"sv).value_or(false);
-        process.name = process_object.get_deprecated_string("name"sv).value_or("");
-        process.executable = process_object.get_deprecated_string("executable"sv).value_or("");
-        process.tty = process_object.get_deprecated_string("tty"sv).value_or("");
-        process.pledge = process_object.get_deprecated_string("pledge"sv).value_or("");
-        process.veil = process_object.get_deprecated_string("veil"sv).value_or("");
-        process.amount_virtual = process_object.get_u32("amount_virtual"sv).value_or(0);
-        process.amount_resident = process_object.get_u32("amount_resident"sv).value_or(0);
-        process.amount_shared = process_object.get_u32("amount_shared"sv).value_or(0);
-        process.amount_dirty_private = process_object.get_u32("amount_dirty_private"sv).value_or(0);
-        process.amount_clean_inode = process_object.get_u32("amount_clean_inode"sv).value_or(0);
-        process.amount_purgeable_volatile = process_object.get_u32("amount_purgeable_volatile"sv).value_or(0);
-        process.amount_purgeable_nonvolatile = process_object.get_u32("amount_purgeable_nonvolatile"sv).value_or(0);
-
-        auto& thread_array = process_object.get_array("threads"sv).value();
-        process.threads.ensure_capacity(thread_array.size());
-        thread_array.for_each([&](auto& value) {
-            auto& thread_object = value.as_object();
+        process.pid = record.pid;
+        process.pgid = record.pgid;
+        process.pgp = record.pgp;
+        process.sid = record.sid;
+        process.uid = record.uid;
+        process.gid = record.gid;
+        process.ppid = record.ppid;
+        process.nfds = record.nfds;
+        process.kernel = record.kernel;
+        process.name = TRY(reader.read_string(record.name_length));
+        process.executable = TRY(reader.read_string(record.executable_length));
+        process.tty = TRY(reader.read_string(record.tty_length));
+        process.pledge = TRY(reader.read_string(record.pledge_length));
+        process.veil = TRY(reader.read_string(record.veil_length));
+        process.amount_virtual = record.amount_virtual;
+        process.amount_resident = record.amount_resident;
+        process.amount_shared = record.amount_shared;
+        process.amount_dirty_private = record.amount_dirty_private;
+        process.amount_clean_inode = record.amount_clean_inode;
+        process.amount_purgeable_volatile = record.amount_purgeable_volatile;
+        process.amount_purgeable_nonvolatile = record.amount_purgeable_nonvolatile;
+
+        process.threads.ensure_capacity(record.thread_count);
+        for (u32 j = 0; j < record.thread_count; ++j) {
+            auto thread_record = TRY(reader.read_record<Kernel::ThreadStatisticsRecord>(header.thread_record_size));
             Core::ThreadStatistics thread;
-            thread.tid = thread_object.get_u32("tid"sv).value_or(0);
-            thread.times_scheduled = thread_object.get_u32("times_scheduled"sv).value_or(0);
-            thread.name = thread_object.get_deprecated_string("name"sv).value_or("");
-            thread.state = thread_object.get_deprecated_string("state"sv).value_or("");
-            thread.time_user = thread_object.get_u64("time_user"sv).value_or(0);
-            thread.time_kernel = thread_object.get_u64("time_kernel"sv).value_or(0);
-            thread.cpu = thread_object.get_u32("cpu"sv).value_or(0);
-            thread.priority = thread_object.get_u32("priority"sv).value_or(0);
-            thread.syscall_count = thread_object.get_u32("syscall_count"sv).value_or(0);
-            thread.inode_faults = thread_object.get_u32("inode_faults"sv).value_or(0);
-            thread.zero_faults = thread_object.get_u32("zero_faults"sv).value_or(0);
-            thread.cow_faults = thread_object.get_u32("cow_faults"sv).value_or(0);
-            thread.unix_socket_read_bytes = thread_object.get_u32("unix_socket_read_bytes"sv).value_or(0);
-            thread.unix_socket_write_bytes = thread_object.get_u32("unix_socket_write_bytes"sv).value_or(0);
-            thread.ipv4_socket_read_bytes = thread_object.get_u32("ipv4_socket_read_bytes"sv).value_or(0);
-            thread.ipv4_socket_write_bytes = thread_object.get_u32("ipv4_socket_write_bytes"sv).value_or(0);
-            thread.file_read_bytes = thread_object.get_u32("file_read_bytes"sv).value_or(0);
-            thread.file_write_bytes = thread_object.get_u32("file_write_bytes"sv).value_or(0);
-            process.threads.append(move(thread));
-        });
+            thread.tid = thread_record.tid;
+            thread.times_scheduled = thread_record.times_scheduled;
+            thread.name = TRY(reader.read_string(thread_record.name_length));
+            thread.state = TRY(reader.read_string(thread_record.state_length));
+            thread.time_user = thread_record.time_user;
+            thread.time_kernel = thread_record.time_kernel;
+            thread.cpu = thread_record.cpu;
+            thread.priority = thread_record.priority;
+            thread.syscall_count = thread_record.syscall_count;
+            thread.inode_faults = thread_record.inode_faults;
+            thread.zero_faults = thread_record.zero_faults;
+            thread.cow_faults = thread_record.cow_faults;
+            thread.unix_socket_read_bytes = thread_record.unix_socket_read_bytes;
+            thread.unix_socket_write_bytes = thread_record.unix_socket_write_bytes;
+            thread.ipv4_socket_read_bytes = thread_record.ipv4_socket_read_bytes;
+            thread.ipv4_socket_write_bytes = thread_record.ipv4_socket_write_bytes;
+            thread.file_read_bytes = thread_record.file_read_bytes;
+            thread.file_write_bytes = thread_record.file_write_bytes;
+            process.threads.unchecked_append(move(thread));
+        }
 
         // and synthetic data last
         if (include_usernames) {
             process.username = username_from_uid(process.uid);
         }
-        all_processes_statistics.processes.append(move(process));
-    });
+        all_processes_statistics.processes.unchecked_append(move(process));
+    }
 
-    all_processes_statistics.total_time_scheduled = json_obj.get_u64("total_time"sv).value_or(0);
-    all_processes_statistics.total_time_scheduled_kernel = json_obj.get_u64("total_time_kernel"sv).value_or(0);
+    all_processes_statistics.total_time_scheduled = header.total_time;
+    all_processes_statistics.total_time_scheduled_kernel = header.total_time_kernel;
     return all_processes_statistics;
 }
 
 ErrorOr<AllProcessesStatistics> ProcessStatisticsReader::get_all(bool include_usernames)
 {
-    auto proc_all_file = TRY(Core::File::open("/sys/kernel/processes"sv, Core::File::OpenMode::Read));
+    auto proc_all_file = TRY(Core::File::open("/sys/kernel/processes_binary"sv, Core::File::OpenMode::Read));
     return get_all(*proc_all_file, include_usernames);
 }
 
@@ -34,7 +34,7 @@ struct ThreadStatistics {
 };
 
 struct ProcessStatistics {
-    // Keep this in sync with /sys/kernel/processes.
+    // Keep this in sync with /sys/kernel/processes_binary (see Kernel/API/ProcessStatistics.h).
     // From the kernel side:
     pid_t pid;
     pid_t pgid;
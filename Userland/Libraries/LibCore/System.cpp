@@ -30,6 +30,7 @@
 #    include <LibSystem/syscall.h>
 #    include <serenity.h>
 #    include <sys/ptrace.h>
+#    include <sys/sendfile.h>
 #endif
 
 #if defined(AK_OS_LINUX) && !defined(MFD_CLOEXEC)
@@ -216,6 +217,14 @@ ErrorOr<int> recvfd(int sockfd, int options)
     return fd;
 }
 
+ErrorOr<size_t> sendfile(int out_fd, int in_fd, off_t* offset, size_t count)
+{
+    auto rc = ::sendfile(out_fd, in_fd, offset, count);
+    if (rc < 0)
+        return Error::from_syscall("sendfile"sv, -errno);
+    return static_cast<size_t>(rc);
+}
+
 ErrorOr<void> ptrace_peekbuf(pid_t tid, void const* tracee_addr, Bytes destination_buf)
 {
     Syscall::SC_ptrace_buf_params buf_params {
@@ -387,6 +396,13 @@ ErrorOr<void> munmap(void* address, size_t size)
     return {};
 }
 
+ErrorOr<void> madvise(void* address, size_t size, int advice)
+{
+    if (::madvise(address, size, advice) < 0)
+        return Error::from_syscall("madvise"sv, -errno);
+    return {};
+}
+
 ErrorOr<int> anon_create([[maybe_unused]] size_t size, [[maybe_unused]] int options)
 {
     int fd = -1;
@@ -473,6 +489,13 @@ ErrorOr<void> ftruncate(int fd, off_t length)
     return {};
 }
 
+ErrorOr<void> fsync(int fd)
+{
+    if (::fsync(fd) < 0)
+        return Error::from_syscall("fsync"sv, -errno);
+    return {};
+}
+
 ErrorOr<struct stat> stat(StringView path)
 {
     if (!path.characters_without_null_termination())
@@ -509,6 +532,24 @@ ErrorOr<struct stat> lstat(StringView path)
 #endif
 }
 
+ErrorOr<struct stat> fstatat(int fd, StringView path, int flags)
+{
+    if (!path.characters_without_null_termination())
+        return Error::from_syscall("fstatat"sv, -EFAULT);
+
+    struct stat st = {};
+#ifdef AK_OS_SERENITY
+    Syscall::SC_stat_params params { { path.characters_without_null_termination(), path.length() }, &st, fd, !(flags & AT_SYMLINK_NOFOLLOW) };
+    int rc = syscall(SC_stat, &params);
+    HANDLE_SYSCALL_RETURN_VALUE("fstatat", rc, st);
+#else
+    DeprecatedString path_string = path;
+    if (::fstatat(fd, path_string.characters(), &st, flags) < 0)
+        return Error::from_syscall("fstatat"sv, -errno);
+    return st;
+#endif
+}
+
 ErrorOr<ssize_t> read(int fd, Bytes buffer)
 {
     ssize_t rc = ::read(fd, buffer.data(), buffer.size());
@@ -803,6 +844,23 @@ ErrorOr<off_t> lseek(int fd, off_t offset, int whence)
     return rc;
 }
 
+ErrorOr<size_t> copy_file_range(int in_fd, off_t* in_offset, int out_fd, off_t* out_offset, size_t count)
+{
+#if defined(AK_OS_SERENITY) || defined(AK_OS_LINUX)
+    auto rc = ::copy_file_range(in_fd, in_offset, out_fd, out_offset, count, 0);
+    if (rc < 0)
+        return Error::from_syscall("copy_file_range"sv, -errno);
+    return static_cast<size_t>(rc);
+#else
+    (void)in_fd;
+    (void)in_offset;
+    (void)out_fd;
+    (void)out_offset;
+    (void)count;
+    return Error::from_errno(ENOTSUP);
+#endif
+}
+
 ErrorOr<void> endgrent()
 {
     int old_errno = 0;
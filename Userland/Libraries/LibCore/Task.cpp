@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/Notifier.h>
+#include <LibCore/Task.h>
+#include <LibCore/Timer.h>
+
+namespace Core {
+
+void DelayAwaiter::await_suspend(std::coroutine_handle<> handle)
+{
+    m_timer = Timer::create_single_shot(m_milliseconds, [handle] { handle.resume(); }).release_value_but_fixme_should_propagate_errors();
+    m_timer->start();
+}
+
+void FileDescriptorAwaiter::await_suspend(std::coroutine_handle<> handle)
+{
+    m_notifier = Notifier::construct(m_fd, m_event_mask);
+    auto resume = [this, handle] {
+        // Resuming may destroy us, but the event loop keeps the notifier alive until it's done with it.
+        m_notifier->set_enabled(false);
+        handle.resume();
+    };
+    if (m_event_mask & Notifier::Event::Read)
+        m_notifier->on_ready_to_read = move(resume);
+    else
+        m_notifier->on_ready_to_write = move(resume);
+}
+
+FileDescriptorAwaiter wait_until_readable(int fd)
+{
+    return FileDescriptorAwaiter { fd, Notifier::Event::Read };
+}
+
+FileDescriptorAwaiter wait_until_writable(int fd)
+{
+    return FileDescriptorAwaiter { fd, Notifier::Event::Write };
+}
+
+}
@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Noncopyable.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Optional.h>
+#include <AK/RefPtr.h>
+#include <AK/StdLibExtras.h>
+#include <LibCore/Forward.h>
+#include <LibCore/Notifier.h>
+#include <LibCore/Promise.h>
+#include <LibCore/Timer.h>
+#include <coroutine>
+
+// Like TRY(), but for use in coroutines returning a Task<ErrorOr<T>>.
+// NOTE: GCC crashes when the expression contains a co_await, so await into a local variable first.
+#define CO_TRY(expression)                                       \
+    ({                                                           \
+        auto _temporary_result = (expression);                   \
+        if (_temporary_result.is_error()) [[unlikely]]           \
+            co_return _temporary_result.release_error();         \
+        _temporary_result.release_value();                       \
+    })
+
+namespace Core {
+
+namespace Detail {
+
+template<typename T>
+struct TaskResult {
+    void return_value(T value) { result = move(value); }
+    T take_result() { return result.release_value(); }
+
+    Optional<T> result;
+};
+
+template<>
+struct TaskResult<void> {
+    void return_void() { }
+    void take_result() { }
+};
+
+}
+
+// The result of a coroutine that runs on the event loop.
+//
+// A coroutine starts running as soon as it's called, and runs until it has to wait for something, e.g. a timer,
+// a file descriptor or another Task. Whoever awaits a Task is resumed once it has finished, and gets its result.
+// Destroying a Task that hasn't finished yet cancels it; the coroutine is never resumed, and all of its local
+// variables (including the things it's waiting for) are destroyed. Tasks that should keep running on their own
+// can be detach()ed instead.
+template<typename T = void>
+class [[nodiscard]] Task {
+    AK_MAKE_NONCOPYABLE(Task);
+
+public:
+    struct promise_type;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+        std::coroutine_handle<> await_suspend(Handle handle) noexcept
+        {
+            auto& promise = handle.promise();
+            if (promise.continuation)
+                return promise.continuation;
+            if (promise.is_detached)
+                handle.destroy();
+            return std::noop_coroutine();
+        }
+        void await_resume() const noexcept { }
+    };
+
+    struct promise_type : public Detail::TaskResult<T> {
+        Task get_return_object() { return Task { Handle::from_promise(*this) }; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        FinalAwaiter final_suspend() const noexcept { return {}; }
+        void unhandled_exception() const { VERIFY_NOT_REACHED(); }
+
+        std::coroutine_handle<> continuation;
+        bool is_detached { false };
+    };
+
+    Task(Task&& other)
+        : m_handle(exchange(other.m_handle, {}))
+    {
+    }
+
+    Task& operator=(Task&& other)
+    {
+        if (this != &other) {
+            destroy();
+            m_handle = exchange(other.m_handle, {});
+        }
+        return *this;
+    }
+
+    ~Task() { destroy(); }
+
+    bool is_done() const { return !m_handle || m_handle.done(); }
+
+    // Lets the coroutine run to completion without anyone waiting for it. Its result is dropped.
+    void detach() &&
+    {
+        VERIFY(m_handle);
+        if (m_handle.done()) {
+            destroy();
+            return;
+        }
+        m_handle.promise().is_detached = true;
+        m_handle = {};
+    }
+
+    // Only callable once the task is done.
+    T take_result()
+    {
+        VERIFY(m_handle && m_handle.done());
+        return m_handle.promise().take_result();
+    }
+
+    auto operator co_await() &&
+    {
+        struct Awaiter {
+            bool await_ready() const { return handle.done(); }
+            void await_suspend(std::coroutine_handle<> awaiting) { handle.promise().continuation = awaiting; }
+            T await_resume() { return handle.promise().take_result(); }
+
+            Handle handle;
+        };
+        VERIFY(m_handle);
+        return Awaiter { m_handle };
+    }
+
+private:
+    explicit Task(Handle handle)
+        : m_handle(handle)
+    {
+    }
+
+    void destroy()
+    {
+        if (m_handle)
+            exchange(m_handle, {}).destroy();
+    }
+
+    Handle m_handle;
+};
+
+// Suspends the coroutine until the promise is resolved, and returns the result.
+template<typename Result>
+auto operator co_await(Promise<Result>& promise)
+{
+    class Awaiter {
+        AK_MAKE_NONCOPYABLE(Awaiter);
+
+    public:
+        explicit Awaiter(Promise<Result>& promise)
+            : m_promise(promise)
+        {
+        }
+
+        ~Awaiter()
+        {
+            if (m_is_waiting)
+                m_promise->on_resolved = nullptr;
+        }
+
+        bool await_ready() { return m_promise->is_resolved(); }
+        void await_suspend(std::coroutine_handle<> handle)
+        {
+            m_is_waiting = true;
+            m_promise->on_resolved = [this, handle](auto&) {
+                m_is_waiting = false;
+                handle.resume();
+            };
+        }
+        // Won't pump the event loop, since the promise has already been resolved at this point.
+        Result await_resume() { return m_promise->await(); }
+
+    private:
+        NonnullRefPtr<Promise<Result>> m_promise;
+        bool m_is_waiting { false };
+    };
+    return Awaiter { promise };
+}
+
+// Suspends the coroutine for (at least) the given number of milliseconds.
+class DelayAwaiter {
+    AK_MAKE_NONCOPYABLE(DelayAwaiter);
+
+public:
+    explicit DelayAwaiter(int milliseconds)
+        : m_milliseconds(milliseconds)
+    {
+    }
+
+    bool await_ready() const { return false; }
+    void await_suspend(std::coroutine_handle<>);
+    void await_resume() const { }
+
+private:
+    int m_milliseconds { 0 };
+    RefPtr<Timer> m_timer;
+};
+
+inline DelayAwaiter delay(int milliseconds) { return DelayAwaiter { milliseconds }; }
+
+// Suspends the coroutine until the file descriptor becomes readable or writable.
+class FileDescriptorAwaiter {
+    AK_MAKE_NONCOPYABLE(FileDescriptorAwaiter);
+
+public:
+    FileDescriptorAwaiter(int fd, unsigned event_mask)
+        : m_fd(fd)
+        , m_event_mask(event_mask)
+    {
+    }
+
+    bool await_ready() const { return false; }
+    void await_suspend(std::coroutine_handle<>);
+    void await_resume() const { }
+
+private:
+    int m_fd { -1 };
+    unsigned m_event_mask { 0 };
+    RefPtr<Notifier> m_notifier;
+};
+
+FileDescriptorAwaiter wait_until_readable(int fd);
+FileDescriptorAwaiter wait_until_writable(int fd);
+
+}
@@ -50,6 +50,10 @@ public:
     bool is_single_shot() const { return m_single_shot; }
     void set_single_shot(bool single_shot) { m_single_shot = single_shot; }
 
+    // Takes effect the next time the timer is started.
+    TimerPrecision precision() const { return m_precision; }
+    void set_precision(TimerPrecision precision) { m_precision = precision; }
+
     Function<void()> on_timeout;
 
 private:
@@ -62,6 +66,7 @@ private:
     bool m_single_shot { false };
     bool m_interval_dirty { false };
     int m_interval_ms { 0 };
+    TimerPrecision m_precision { TimerPrecision::Precise };
 };
 
 }
@@ -139,7 +139,11 @@ Optional<FlatPtr> Reader::peek_memory(FlatPtr address) const
         return {};
 
     FlatPtr offset_in_region = address - region->region_start;
-    auto* region_data = bit_cast<u8 const*>(image().program_header(region->program_header_index).raw_data());
+    auto program_header = image().program_header(region->program_header_index);
+    // Clean file-backed regions are not stored in the coredump, only their extent is.
+    if (offset_in_region + sizeof(FlatPtr) > program_header.size_in_image())
+        return {};
+    auto* region_data = bit_cast<u8 const*>(program_header.raw_data());
     FlatPtr value { 0 };
     ByteReader::load(region_data + offset_in_region, value);
     return value;
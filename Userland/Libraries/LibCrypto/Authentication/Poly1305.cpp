@@ -10,217 +10,173 @@
 
 namespace Crypto::Authentication {
 
+static constexpr u64 mask_44_bits = (1ull << 44) - 1;
+static constexpr u64 mask_42_bits = (1ull << 42) - 1;
+
+static ALWAYS_INLINE u64 load_little_endian_u64(u8 const* data)
+{
+    return AK::convert_between_host_and_little_endian(ByteReader::load64(data));
+}
+
 Poly1305::Poly1305(ReadonlyBytes key)
 {
-    for (size_t i = 0; i < 16; i += 4) {
-        m_state.r[i / 4] = AK::convert_between_host_and_little_endian(ByteReader::load32(key.offset(i)));
-    }
+    auto r0 = load_little_endian_u64(key.offset(0));
+    auto r1 = load_little_endian_u64(key.offset(8));
 
     // r[3], r[7], r[11], and r[15] are required to have their top four bits clear (be smaller than 16)
     // r[4], r[8], and r[12] are required to have their bottom two bits clear (be divisible by 4)
-    m_state.r[0] &= 0x0FFFFFFF;
-    m_state.r[1] &= 0x0FFFFFFC;
-    m_state.r[2] &= 0x0FFFFFFC;
-    m_state.r[3] &= 0x0FFFFFFC;
+    // These masks do both, while splitting r into limbs of 44, 44 and 42 bits.
+    m_state.r[0] = r0 & 0xffc0fffffff;
+    m_state.r[1] = ((r0 >> 44) | (r1 << 20)) & 0xfffffc0ffff;
+    m_state.r[2] = (r1 >> 24) & 0x00ffffffc0f;
 
-    for (size_t i = 16; i < 32; i += 4) {
-        m_state.s[(i - 16) / 4] = AK::convert_between_host_and_little_endian(ByteReader::load32(key.offset(i)));
-    }
+    m_state.s[0] = load_little_endian_u64(key.offset(16));
+    m_state.s[1] = load_little_endian_u64(key.offset(24));
 }
 
 void Poly1305::update(ReadonlyBytes message)
 {
     size_t offset = 0;
-    while (offset < message.size()) {
-        u32 n = min(message.size() - offset, 16 - m_state.block_count);
-        memcpy(m_state.blocks + m_state.block_count, message.offset_pointer(offset), n);
+
+    // Complete the block left over from the previous update first.
+    if (m_state.block_count != 0) {
+        size_t n = min(message.size(), 16 - m_state.block_count);
+        memcpy(m_state.blocks + m_state.block_count, message.data(), n);
         m_state.block_count += n;
         offset += n;
 
-        if (m_state.block_count == 16) {
-            process_block();
-            m_state.block_count = 0;
-        }
+        if (m_state.block_count < 16)
+            return;
+
+        process_blocks(m_state.blocks, 1, 1ull << 40);
+        m_state.block_count = 0;
     }
+
+    // Whole blocks are read straight from the message.
+    auto block_count = (message.size() - offset) / 16;
+    process_blocks(message.offset_pointer(offset), block_count, 1ull << 40);
+    offset += block_count * 16;
+
+    m_state.block_count = message.size() - offset;
+    memcpy(m_state.blocks, message.offset_pointer(offset), m_state.block_count);
 }
 
-void Poly1305::process_block()
+// For each block, the accumulator becomes (accumulator + block) * r mod 2^130 - 5.
+// high_bit is the bit above the 128 bits of a block in the top limb, it is only left out for the padded last block.
+void Poly1305::process_blocks(u8 const* data, size_t block_count, u64 high_bit)
 {
-    u32 a[5];
-    u8 n = m_state.block_count;
-
-    // Add one bit beyond the number of octets.  For a 16-byte block,
-    // this is equivalent to adding 2^128 to the number.  For the shorter
-    // block, it can be 2^120, 2^112, or any power of two that is evenly
-    // divisible by 8, all the way down to 2^8.
-    m_state.blocks[n++] = 0x01;
-
-    // If the block is not 17 bytes long (the last block), pad it with zeros.
-    // This is meaningless if you are treating the blocks as numbers.
-    while (n < 17) {
-        m_state.blocks[n++] = 0x00;
+    auto r0 = m_state.r[0];
+    auto r1 = m_state.r[1];
+    auto r2 = m_state.r[2];
+
+    // 2^132 = 4 * 2^130 = 4 * 5 mod 2^130 - 5, which folds the limbs that overflow back into the lower ones.
+    auto s1 = r1 * (5 << 2);
+    auto s2 = r2 * (5 << 2);
+
+    auto h0 = m_state.h[0];
+    auto h1 = m_state.h[1];
+    auto h2 = m_state.h[2];
+
+    for (size_t i = 0; i < block_count; ++i, data += 16) {
+        // Add this block to the accumulator.
+        auto t0 = load_little_endian_u64(data);
+        auto t1 = load_little_endian_u64(data + 8);
+        h0 += t0 & mask_44_bits;
+        h1 += ((t0 >> 44) | (t1 << 20)) & mask_44_bits;
+        h2 += ((t1 >> 24) & mask_42_bits) | high_bit;
+
+        // Multiply by r.
+        auto d0 = (unsigned __int128)h0 * r0 + (unsigned __int128)h1 * s2 + (unsigned __int128)h2 * s1;
+        auto d1 = (unsigned __int128)h0 * r1 + (unsigned __int128)h1 * r0 + (unsigned __int128)h2 * s2;
+        auto d2 = (unsigned __int128)h0 * r2 + (unsigned __int128)h1 * r1 + (unsigned __int128)h2 * r0;
+
+        // Partially reduce, the limbs may stay a few bits above their width until the digest is computed.
+        u64 carry = (u64)(d0 >> 44);
+        h0 = (u64)d0 & mask_44_bits;
+        d1 += carry;
+        carry = (u64)(d1 >> 44);
+        h1 = (u64)d1 & mask_44_bits;
+        d2 += carry;
+        carry = (u64)(d2 >> 42);
+        h2 = (u64)d2 & mask_42_bits;
+        h0 += carry * 5;
+        carry = h0 >> 44;
+        h0 &= mask_44_bits;
+        h1 += carry;
     }
 
-    // Read the block as a little-endian number.
-    for (size_t i = 0; i < 16; i += 4) {
-        a[i / 4] = AK::convert_between_host_and_little_endian(ByteReader::load32(m_state.blocks + i));
-    }
-    a[4] = m_state.blocks[16];
-
-    // Add this number to the accumulator.
-    m_state.a[0] += a[0];
-    m_state.a[1] += a[1];
-    m_state.a[2] += a[2];
-    m_state.a[3] += a[3];
-    m_state.a[4] += a[4];
-
-    // Carry
-    m_state.a[1] += m_state.a[0] >> 32;
-    m_state.a[2] += m_state.a[1] >> 32;
-    m_state.a[3] += m_state.a[2] >> 32;
-    m_state.a[4] += m_state.a[3] >> 32;
-
-    // Only consider the least significant bits
-    a[0] = m_state.a[0] & 0xFFFFFFFF;
-    a[1] = m_state.a[1] & 0xFFFFFFFF;
-    a[2] = m_state.a[2] & 0xFFFFFFFF;
-    a[3] = m_state.a[3] & 0xFFFFFFFF;
-    a[4] = m_state.a[4] & 0xFFFFFFFF;
-
-    // Multiply by r
-    m_state.a[0] = (u64)a[0] * m_state.r[0];
-    m_state.a[1] = (u64)a[0] * m_state.r[1] + (u64)a[1] * m_state.r[0];
-    m_state.a[2] = (u64)a[0] * m_state.r[2] + (u64)a[1] * m_state.r[1] + (u64)a[2] * m_state.r[0];
-    m_state.a[3] = (u64)a[0] * m_state.r[3] + (u64)a[1] * m_state.r[2] + (u64)a[2] * m_state.r[1] + (u64)a[3] * m_state.r[0];
-    m_state.a[4] = (u64)a[1] * m_state.r[3] + (u64)a[2] * m_state.r[2] + (u64)a[3] * m_state.r[1] + (u64)a[4] * m_state.r[0];
-    m_state.a[5] = (u64)a[2] * m_state.r[3] + (u64)a[3] * m_state.r[2] + (u64)a[4] * m_state.r[1];
-    m_state.a[6] = (u64)a[3] * m_state.r[3] + (u64)a[4] * m_state.r[2];
-    m_state.a[7] = (u64)a[4] * m_state.r[3];
-
-    // Carry
-    m_state.a[1] += m_state.a[0] >> 32;
-    m_state.a[2] += m_state.a[1] >> 32;
-    m_state.a[3] += m_state.a[2] >> 32;
-    m_state.a[4] += m_state.a[3] >> 32;
-    m_state.a[5] += m_state.a[4] >> 32;
-    m_state.a[6] += m_state.a[5] >> 32;
-    m_state.a[7] += m_state.a[6] >> 32;
-
-    // Save the high part of the accumulator
-    a[0] = m_state.a[4] & 0xFFFFFFFC;
-    a[1] = m_state.a[5] & 0xFFFFFFFF;
-    a[2] = m_state.a[6] & 0xFFFFFFFF;
-    a[3] = m_state.a[7] & 0xFFFFFFFF;
-
-    // Only consider the least significant bits
-    m_state.a[0] &= 0xFFFFFFFF;
-    m_state.a[1] &= 0xFFFFFFFF;
-    m_state.a[2] &= 0xFFFFFFFF;
-    m_state.a[3] &= 0xFFFFFFFF;
-    m_state.a[4] &= 0x00000003;
-
-    // Fast modular reduction (first pass)
-    m_state.a[0] += a[0];
-    m_state.a[0] += (a[0] >> 2) | (a[1] << 30);
-    m_state.a[1] += a[1];
-    m_state.a[1] += (a[1] >> 2) | (a[2] << 30);
-    m_state.a[2] += a[2];
-    m_state.a[2] += (a[2] >> 2) | (a[3] << 30);
-    m_state.a[3] += a[3];
-    m_state.a[3] += (a[3] >> 2);
-
-    // Carry
-    m_state.a[1] += m_state.a[0] >> 32;
-    m_state.a[2] += m_state.a[1] >> 32;
-    m_state.a[3] += m_state.a[2] >> 32;
-    m_state.a[4] += m_state.a[3] >> 32;
-
-    // Save the high part of the accumulator
-    a[0] = m_state.a[4] & 0xFFFFFFFC;
-
-    // Only consider the least significant bits
-    m_state.a[0] &= 0xFFFFFFFF;
-    m_state.a[1] &= 0xFFFFFFFF;
-    m_state.a[2] &= 0xFFFFFFFF;
-    m_state.a[3] &= 0xFFFFFFFF;
-    m_state.a[4] &= 0x00000003;
-
-    // Fast modular reduction (second pass)
-    m_state.a[0] += a[0];
-    m_state.a[0] += a[0] >> 2;
-
-    // Carry
-    m_state.a[1] += m_state.a[0] >> 32;
-    m_state.a[2] += m_state.a[1] >> 32;
-    m_state.a[3] += m_state.a[2] >> 32;
-    m_state.a[4] += m_state.a[3] >> 32;
-
-    // Only consider the least significant bits
-    m_state.a[0] &= 0xFFFFFFFF;
-    m_state.a[1] &= 0xFFFFFFFF;
-    m_state.a[2] &= 0xFFFFFFFF;
-    m_state.a[3] &= 0xFFFFFFFF;
-    m_state.a[4] &= 0x00000003;
+    m_state.h[0] = h0;
+    m_state.h[1] = h1;
+    m_state.h[2] = h2;
 }
 
 ErrorOr<ByteBuffer> Poly1305::digest()
 {
-    if (m_state.block_count != 0)
-        process_block();
-
-    u32 b[4];
-
-    // Save the accumulator
-    b[0] = m_state.a[0] & 0xFFFFFFFF;
-    b[1] = m_state.a[1] & 0xFFFFFFFF;
-    b[2] = m_state.a[2] & 0xFFFFFFFF;
-    b[3] = m_state.a[3] & 0xFFFFFFFF;
-
-    // Compute a + 5
-    m_state.a[0] += 5;
-
-    // Carry
-    m_state.a[1] += m_state.a[0] >> 32;
-    m_state.a[2] += m_state.a[1] >> 32;
-    m_state.a[3] += m_state.a[2] >> 32;
-    m_state.a[4] += m_state.a[3] >> 32;
-
-    // Select mask based on (a + 5) >= 2^130
-    u32 mask = ((m_state.a[4] & 0x04) >> 2) - 1;
+    if (m_state.block_count != 0) {
+        // Add one bit beyond the number of octets, and pad the shorter last block with zeros.
+        m_state.blocks[m_state.block_count] = 0x01;
+        memset(m_state.blocks + m_state.block_count + 1, 0, 16 - m_state.block_count - 1);
+        process_blocks(m_state.blocks, 1, 0);
+        m_state.block_count = 0;
+    }
 
-    // Select based on mask
-    m_state.a[0] = (m_state.a[0] & ~mask) | (b[0] & mask);
-    m_state.a[1] = (m_state.a[1] & ~mask) | (b[1] & mask);
-    m_state.a[2] = (m_state.a[2] & ~mask) | (b[2] & mask);
-    m_state.a[3] = (m_state.a[3] & ~mask) | (b[3] & mask);
+    auto h0 = m_state.h[0];
+    auto h1 = m_state.h[1];
+    auto h2 = m_state.h[2];
+
+    // Fully carry the accumulator.
+    u64 carry = h1 >> 44;
+    h1 &= mask_44_bits;
+    h2 += carry;
+    carry = h2 >> 42;
+    h2 &= mask_42_bits;
+    h0 += carry * 5;
+    carry = h0 >> 44;
+    h0 &= mask_44_bits;
+    h1 += carry;
+    carry = h1 >> 44;
+    h1 &= mask_44_bits;
+    h2 += carry;
+    carry = h2 >> 42;
+    h2 &= mask_42_bits;
+    h0 += carry * 5;
+    carry = h0 >> 44;
+    h0 &= mask_44_bits;
+    h1 += carry;
+
+    // Compute h + 5 - 2^130, and select it if h >= 2^130 - 5, without branching.
+    auto g0 = h0 + 5;
+    carry = g0 >> 44;
+    g0 &= mask_44_bits;
+    auto g1 = h1 + carry;
+    carry = g1 >> 44;
+    g1 &= mask_44_bits;
+    auto g2 = h2 + carry - (1ull << 42);
+
+    u64 mask = (g2 >> 63) - 1;
+    h0 = (h0 & ~mask) | (g0 & mask);
+    h1 = (h1 & ~mask) | (g1 & mask);
+    h2 = (h2 & ~mask) | (g2 & mask);
 
     // Finally, the value of the secret key "s" is added to the accumulator,
     // and the 128 least significant bits are serialized in little-endian
     // order to form the tag.
-    m_state.a[0] += m_state.s[0];
-    m_state.a[1] += m_state.s[1];
-    m_state.a[2] += m_state.s[2];
-    m_state.a[3] += m_state.s[3];
-
-    // Carry
-    m_state.a[1] += m_state.a[0] >> 32;
-    m_state.a[2] += m_state.a[1] >> 32;
-    m_state.a[3] += m_state.a[2] >> 32;
-    m_state.a[4] += m_state.a[3] >> 32;
-
-    // Only consider the least significant bits
-    b[0] = m_state.a[0] & 0xFFFFFFFF;
-    b[1] = m_state.a[1] & 0xFFFFFFFF;
-    b[2] = m_state.a[2] & 0xFFFFFFFF;
-    b[3] = m_state.a[3] & 0xFFFFFFFF;
-
-    ByteBuffer output = TRY(ByteBuffer::create_uninitialized(16));
-
-    for (auto i = 0; i < 4; i++) {
-        ByteReader::store(output.offset_pointer(i * 4), AK::convert_between_host_and_little_endian(b[i]));
-    }
-
-    return output;
+    auto s0 = m_state.s[0];
+    auto s1 = m_state.s[1];
+    h0 += s0 & mask_44_bits;
+    carry = h0 >> 44;
+    h0 &= mask_44_bits;
+    h1 += (((s0 >> 44) | (s1 << 20)) & mask_44_bits) + carry;
+    carry = h1 >> 44;
+    h1 &= mask_44_bits;
+    h2 += (s1 >> 24) + carry;
+    h2 &= mask_42_bits;
+
+    u64 tag[2];
+    tag[0] = AK::convert_between_host_and_little_endian(h0 | (h1 << 44));
+    tag[1] = AK::convert_between_host_and_little_endian((h1 >> 20) | (h2 << 24));
+
+    return ByteBuffer::copy(tag, sizeof(tag));
 }
 
 }
@@ -10,11 +10,12 @@
 
 namespace Crypto::Authentication {
 
+// The accumulator and r are held in three limbs of 44, 44 and 42 bits, so that the products of two limbs fit in 128 bits.
 struct State {
-    u32 r[4] {};
-    u32 s[4] {};
-    u64 a[8] {};
-    u8 blocks[17] {};
+    u64 r[3] {};
+    u64 s[2] {};
+    u64 h[3] {};
+    u8 blocks[16] {};
     u8 block_count {};
 };
 
@@ -26,7 +27,7 @@ public:
     ErrorOr<ByteBuffer> digest();
 
 private:
-    void process_block();
+    void process_blocks(u8 const* data, size_t block_count, u64 high_bit);
 
     State m_state;
 };
@@ -94,17 +94,17 @@ ALWAYS_INLINE static void addition_with_carry(u32 a, u32 b, u32& z_carry, u32& z
  * Computes a montgomery "fragment" for y_i. This computes "z[i] += x[i] * y_i" for all words while rippling the carry, and returns the carry.
  * Algorithm from: Gueron, "Efficient Software Implementations of Modular Exponentiation". (https://eprint.iacr.org/2011/239.pdf)
  */
-UnsignedBigInteger::Word UnsignedBigIntegerAlgorithms::montgomery_fragment(UnsignedBigInteger& z, size_t offset_in_z, UnsignedBigInteger const& x, UnsignedBigInteger::Word y_digit, size_t num_words)
+UnsignedBigInteger::Word UnsignedBigIntegerAlgorithms::montgomery_fragment(UnsignedBigInteger::Word* z, UnsignedBigInteger::Word const* x, UnsignedBigInteger::Word y_digit, size_t num_words)
 {
     UnsignedBigInteger::Word carry { 0 };
     for (size_t i = 0; i < num_words; ++i) {
         UnsignedBigInteger::Word a_carry;
         UnsignedBigInteger::Word a;
-        linear_multiplication_with_carry(x.m_words[i], y_digit, z.m_words[offset_in_z + i], a_carry, a);
+        linear_multiplication_with_carry(x[i], y_digit, z[i], a_carry, a);
         UnsignedBigInteger::Word b_carry;
         UnsignedBigInteger::Word b;
         addition_with_carry(a, carry, b_carry, b);
-        z.m_words[offset_in_z + i] = b;
+        z[i] = b;
         carry = a_carry + b_carry;
     }
     return carry;
@@ -131,51 +131,56 @@ void UnsignedBigIntegerAlgorithms::almost_montgomery_multiplication_without_allo
     VERIFY(y.length() >= num_words);
     VERIFY(modulo.length() >= num_words);
 
-    z.set_to(0);
-    z.resize_with_leading_zeros(num_words * 2);
+    // z is the scratch space of the whole exponentiation, so it only ever allocates for the first multiplication.
+    z.m_words.resize_and_keep_capacity(num_words * 2);
+    auto* z_words = z.m_words.data();
+    __builtin_memset(z_words, 0, num_words * 2 * sizeof(UnsignedBigInteger::Word));
+    z.m_cached_trimmed_length = {};
+    z.m_cached_hash = 0;
+
+    auto const* x_words = x.m_words.data();
+    auto const* y_words = y.m_words.data();
+    auto const* modulo_words = modulo.m_words.data();
 
     UnsignedBigInteger::Word previous_double_carry { 0 };
     for (size_t i = 0; i < num_words; ++i) {
         // z[i->num_words+i] += x * y_i
-        UnsignedBigInteger::Word carry_1 = montgomery_fragment(z, i, x, y.m_words[i], num_words);
+        UnsignedBigInteger::Word carry_1 = montgomery_fragment(z_words + i, x_words, y_words[i], num_words);
         // z[i->num_words+i] += modulo * (z_i * k)
-        UnsignedBigInteger::Word t = z.m_words[i] * k;
-        UnsignedBigInteger::Word carry_2 = montgomery_fragment(z, i, modulo, t, num_words);
+        UnsignedBigInteger::Word t = z_words[i] * k;
+        UnsignedBigInteger::Word carry_2 = montgomery_fragment(z_words + i, modulo_words, t, num_words);
 
         // Compute the carry by combining all of the carries of the previous computations
         // Put it "right after" the range that we computed above
         UnsignedBigInteger::Word temp_carry = previous_double_carry + carry_1;
         UnsignedBigInteger::Word overall_carry = temp_carry + carry_2;
-        z.m_words[num_words + i] = overall_carry;
+        z_words[num_words + i] = overall_carry;
 
         // Detect if there was a "double carry" for this word by checking if our carry results are smaller than their components
         previous_double_carry = (temp_carry < carry_1 || overall_carry < carry_2) ? 1 : 0;
     }
 
+    result.set_to_0();
+    result.m_words.resize_and_keep_capacity(num_words);
+    auto* result_words = result.m_words.data();
+
     if (previous_double_carry == 0) {
         // Return the top num_words bytes of Z, which contains our result.
-        shift_right_by_n_words(z, num_words, result);
-        result.resize_with_leading_zeros(num_words);
+        __builtin_memcpy(result_words, z_words + num_words, num_words * sizeof(UnsignedBigInteger::Word));
         return;
     }
 
     // We have a carry, so we're "one bigger" than we need to be.
-    // Subtract the modulo from the result (the top half of z), and write it to the bottom half of Z since we have space.
-    // (With carry, of course.)
+    // Subtract the modulo from the result (the top half of z), and write it to the result. (With carry, of course.)
     UnsignedBigInteger::Word c { 0 };
     for (size_t i = 0; i < num_words; ++i) {
-        UnsignedBigInteger::Word z_digit = z.m_words[num_words + i];
-        UnsignedBigInteger::Word modulo_digit = modulo.m_words[i];
+        UnsignedBigInteger::Word z_digit = z_words[num_words + i];
+        UnsignedBigInteger::Word modulo_digit = modulo_words[i];
         UnsignedBigInteger::Word new_z_digit = z_digit - modulo_digit - c;
-        z.m_words[i] = new_z_digit;
+        result_words[i] = new_z_digit;
         // Detect if the subtraction underflowed - from "Hacker's Delight"
         c = ((modulo_digit & ~z_digit) | ((modulo_digit | ~z_digit) & new_z_digit)) >> (UnsignedBigInteger::BITS_IN_WORD - 1);
     }
-
-    // Return the bottom num_words bytes of Z (with the carry bit handled)
-    z.m_words.resize(num_words);
-    result.set_to(z);
-    result.resize_with_leading_zeros(num_words);
 }
 
 /**
@@ -9,38 +9,216 @@
 
 namespace Crypto {
 
+using Word = UnsignedBigInteger::Word;
+using DoubleWord = u64;
+static_assert(sizeof(DoubleWord) == 2 * sizeof(Word));
+
+// Below this many words, the bookkeeping of Karatsuba costs more than the multiplications it saves.
+static constexpr size_t karatsuba_threshold = 24;
+
 /**
- * Complexity: O(N^2) where N is the number of words in the larger number
- * Multiplication method:
- * An integer is equal to the sum of the powers of two
- * according to the indices of its 'on' bits.
- * So to multiple x*y, we go over each '1' bit in x (say the i'th bit),
- * and add y<<i to the result.
+ * Complexity: O(N*M)
+ * Computes output[0, left_length + right_length) = left * right.
+ */
+static void multiply_words(Word const* left, size_t left_length, Word const* right, size_t right_length, Word* output)
+{
+    __builtin_memset(output, 0, (left_length + right_length) * sizeof(Word));
+    for (size_t i = 0; i < left_length; ++i) {
+        DoubleWord carry = 0;
+        for (size_t j = 0; j < right_length; ++j) {
+            carry += static_cast<DoubleWord>(left[i]) * right[j] + output[i + j];
+            output[i + j] = static_cast<Word>(carry);
+            carry >>= UnsignedBigInteger::BITS_IN_WORD;
+        }
+        output[i + right_length] = static_cast<Word>(carry);
+    }
+}
+
+// The same, for operands whose size is known at compile time so the loops can be unrolled.
+template<size_t Length>
+static void multiply_fixed_width_words(Word const* left, Word const* right, Word* output)
+{
+    Word result[2 * Length] {};
+    for (size_t i = 0; i < Length; ++i) {
+        DoubleWord carry = 0;
+        for (size_t j = 0; j < Length; ++j) {
+            carry += static_cast<DoubleWord>(left[i]) * right[j] + result[i + j];
+            result[i + j] = static_cast<Word>(carry);
+            carry >>= UnsignedBigInteger::BITS_IN_WORD;
+        }
+        result[i + Length] = static_cast<Word>(carry);
+    }
+    __builtin_memcpy(output, result, sizeof(result));
+}
+
+// output[0, length) += value[0, value_length), returns the carry out of the top word.
+static Word add_words_into(Word* output, size_t length, Word const* value, size_t value_length)
+{
+    DoubleWord carry = 0;
+    size_t i = 0;
+    for (; i < value_length; ++i) {
+        carry += static_cast<DoubleWord>(output[i]) + value[i];
+        output[i] = static_cast<Word>(carry);
+        carry >>= UnsignedBigInteger::BITS_IN_WORD;
+    }
+    for (; carry != 0 && i < length; ++i) {
+        carry += output[i];
+        output[i] = static_cast<Word>(carry);
+        carry >>= UnsignedBigInteger::BITS_IN_WORD;
+    }
+    return static_cast<Word>(carry);
+}
+
+// output[0, length) -= value[0, value_length), which must not underflow.
+static void subtract_words_from(Word* output, size_t length, Word const* value, size_t value_length)
+{
+    Word borrow = 0;
+    size_t i = 0;
+    for (; i < value_length; ++i) {
+        auto difference = static_cast<DoubleWord>(output[i]) - value[i] - borrow;
+        output[i] = static_cast<Word>(difference);
+        borrow = (difference >> UnsignedBigInteger::BITS_IN_WORD) & 1;
+    }
+    for (; borrow != 0 && i < length; ++i) {
+        borrow = output[i] == 0 ? 1 : 0;
+        --output[i];
+    }
+    VERIFY(borrow == 0);
+}
+
+static constexpr size_t karatsuba_scratch_length(size_t length)
+{
+    if (length < karatsuba_threshold)
+        return 0;
+    auto half_length = length - length / 2 + 1;
+    return 4 * half_length + karatsuba_scratch_length(half_length);
+}
+
+/**
+ * Complexity: O(N^1.58)
+ * Computes output[0, 2 * length) = left * right, for two operands of the same length.
+ * With left = a1 * B + a0 and right = b1 * B + b0, the product is a1b1 * B^2 + ((a0 + a1)(b0 + b1) - a0b0 - a1b1) * B + a0b0,
+ * which takes three half-size multiplications instead of four.
+ */
+static void karatsuba_multiply_words(Word const* left, Word const* right, size_t length, Word* output, Word* scratch)
+{
+    if (length < karatsuba_threshold) {
+        multiply_words(left, length, right, length, output);
+        return;
+    }
+
+    auto low_length = length / 2;
+    auto high_length = length - low_length;
+
+    // a0b0 and a1b1 go straight to where they belong in the output.
+    karatsuba_multiply_words(left, right, low_length, output, scratch);
+    karatsuba_multiply_words(left + low_length, right + low_length, high_length, output + 2 * low_length, scratch);
+
+    auto sum_length = high_length + 1;
+    auto* left_sum = scratch;
+    auto* right_sum = left_sum + sum_length;
+    auto* middle = right_sum + sum_length;
+    auto* next_scratch = middle + 2 * sum_length;
+
+    __builtin_memcpy(left_sum, left + low_length, high_length * sizeof(Word));
+    left_sum[high_length] = add_words_into(left_sum, high_length, left, low_length);
+    __builtin_memcpy(right_sum, right + low_length, high_length * sizeof(Word));
+    right_sum[high_length] = add_words_into(right_sum, high_length, right, low_length);
+
+    karatsuba_multiply_words(left_sum, right_sum, sum_length, middle, next_scratch);
+    subtract_words_from(middle, 2 * sum_length, output, 2 * low_length);
+    subtract_words_from(middle, 2 * sum_length, output + 2 * low_length, 2 * high_length);
+
+    // The middle term is less than B^(2 * high_length + 1), so the words above that are zero.
+    auto carry = add_words_into(output + low_length, 2 * length - low_length, middle, min(2 * sum_length, 2 * length - low_length));
+    VERIFY(carry == 0);
+}
+
+/**
+ * Complexity: O(N^2), or O(N^1.58) for operands of similar and large enough sizes
+ * Multiplication method: schoolbook multiplication on whole words, Karatsuba multiplication for large operands of
+ * similar size, and unrolled loops for the operand sizes that are common in cryptography.
+ * temp_shift_result holds the scratch space of Karatsuba, so that it can be reused between calls.
  */
 FLATTEN void UnsignedBigIntegerAlgorithms::multiply_without_allocation(
     UnsignedBigInteger const& left,
     UnsignedBigInteger const& right,
     UnsignedBigInteger& temp_shift_result,
-    UnsignedBigInteger& temp_shift_plus,
-    UnsignedBigInteger& temp_shift,
+    UnsignedBigInteger&,
+    UnsignedBigInteger&,
     UnsignedBigInteger& output)
 {
-    output.set_to_0();
+    VERIFY(&output != &left && &output != &right);
 
-    // iterate all bits
-    for (size_t word_index = 0; word_index < left.length(); ++word_index) {
-        for (size_t bit_index = 0; bit_index < UnsignedBigInteger::BITS_IN_WORD; ++bit_index) {
-            // If the bit is off - skip over it
-            if (!(left.m_words[word_index] & (1 << bit_index)))
-                continue;
+    auto left_length = left.trimmed_length();
+    auto right_length = right.trimmed_length();
 
-            size_t shift_amount = word_index * UnsignedBigInteger::BITS_IN_WORD + bit_index;
+    output.set_to_0();
+    if (left_length == 0 || right_length == 0)
+        return;
+
+    output.m_words.resize_and_keep_capacity(left_length + right_length);
+    auto const* left_words = left.m_words.data();
+    auto const* right_words = right.m_words.data();
+    auto* output_words = output.m_words.data();
 
-            // output += (right << shift_amount);
-            shift_left_without_allocation(right, shift_amount, temp_shift_result, temp_shift_plus, temp_shift);
-            add_into_accumulator_without_allocation(output, temp_shift);
+    if (left_length == right_length) {
+        switch (left_length) {
+        case 256 / UnsignedBigInteger::BITS_IN_WORD:
+            multiply_fixed_width_words<256 / UnsignedBigInteger::BITS_IN_WORD>(left_words, right_words, output_words);
+            output.clamp_to_trimmed_length();
+            return;
+        case 384 / UnsignedBigInteger::BITS_IN_WORD:
+            multiply_fixed_width_words<384 / UnsignedBigInteger::BITS_IN_WORD>(left_words, right_words, output_words);
+            output.clamp_to_trimmed_length();
+            return;
+        case 2048 / UnsignedBigInteger::BITS_IN_WORD: {
+            constexpr auto length = 2048 / UnsignedBigInteger::BITS_IN_WORD;
+            Word scratch[karatsuba_scratch_length(length)];
+            karatsuba_multiply_words(left_words, right_words, length, output_words, scratch);
+            output.clamp_to_trimmed_length();
+            return;
+        }
+        case 4096 / UnsignedBigInteger::BITS_IN_WORD: {
+            constexpr auto length = 4096 / UnsignedBigInteger::BITS_IN_WORD;
+            Word scratch[karatsuba_scratch_length(length)];
+            karatsuba_multiply_words(left_words, right_words, length, output_words, scratch);
+            output.clamp_to_trimmed_length();
+            return;
         }
+        default:
+            break;
+        }
+    }
+
+    // Karatsuba needs operands of the same length, padding the shorter one is only worth it if it isn't much shorter.
+    auto length = max(left_length, right_length);
+    auto shorter_length = min(left_length, right_length);
+    if (shorter_length < karatsuba_threshold || 4 * shorter_length < 3 * length) {
+        multiply_words(left_words, left_length, right_words, right_length, output_words);
+        output.clamp_to_trimmed_length();
+        return;
+    }
+
+    // The padded operands and the scratch space of the recursion all live in temp_shift_result.
+    auto& scratch = temp_shift_result.m_words;
+    scratch.resize_and_keep_capacity(2 * length + karatsuba_scratch_length(length));
+    auto* padded_left = scratch.data();
+    auto* padded_right = padded_left + length;
+    __builtin_memset(padded_left, 0, 2 * length * sizeof(Word));
+    __builtin_memcpy(padded_left, left_words, left_length * sizeof(Word));
+    __builtin_memcpy(padded_right, right_words, right_length * sizeof(Word));
+
+    // The product of the padded operands is 2 * length words long, but only the first left_length + right_length are not zero.
+    Word* full_output = output_words;
+    if (left_length + right_length < 2 * length) {
+        output.m_words.resize_and_keep_capacity(2 * length);
+        full_output = output.m_words.data();
     }
+    karatsuba_multiply_words(padded_left, padded_right, length, full_output, padded_right + length);
+    output.m_words.resize_and_keep_capacity(left_length + right_length);
+    output.clamp_to_trimmed_length();
+    temp_shift_result.set_to_0();
 }
 
 }
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Platform.h>
+#include <AK/Types.h>
+
+// The kernel doesn't save the SIMD state of its own code, so it always uses the portable implementations.
+#if ARCH(X86_64) && !defined(KERNEL)
+#    define CRYPTO_HAS_X86_64_INTRINSICS 1
+#    include <cpuid.h>
+#else
+#    define CRYPTO_HAS_X86_64_INTRINSICS 0
+#endif
+
+namespace Crypto {
+
+#if CRYPTO_HAS_X86_64_INTRINSICS
+// Bits of ecx in cpuid[eax = 1].
+constexpr u32 cpuid_1_ecx_bit_pclmulqdq = 1 << 1;
+constexpr u32 cpuid_1_ecx_bit_ssse3 = 1 << 9;
+constexpr u32 cpuid_1_ecx_bit_sse4_1 = 1 << 19;
+constexpr u32 cpuid_1_ecx_bit_aes = 1 << 25;
+constexpr u32 cpuid_1_ecx_bit_osxsave = 1 << 27;
+constexpr u32 cpuid_1_ecx_bit_avx = 1 << 28;
+
+// Bits of ebx in cpuid[eax = 7, ecx = 0].
+constexpr u32 cpuid_7_ebx_bit_avx2 = 1 << 5;
+constexpr u32 cpuid_7_ebx_bit_sha = 1 << 29;
+
+inline bool has_cpuid_1_ecx_bits(u32 bits)
+{
+    static u32 const ecx_bits = [] {
+        u32 eax, ebx, ecx, edx;
+        if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+            return 0u;
+        return ecx;
+    }();
+    return (ecx_bits & bits) == bits;
+}
+
+inline bool has_cpuid_7_ebx_bits(u32 bits)
+{
+    static u32 const ebx_bits = [] {
+        u32 eax, ebx, ecx, edx;
+        if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+            return 0u;
+        return ebx;
+    }();
+    return (ebx_bits & bits) == bits;
+}
+
+// AES-NI, used by AESCipher.
+inline bool has_aes_instructions()
+{
+    return has_cpuid_1_ecx_bits(cpuid_1_ecx_bit_aes | cpuid_1_ecx_bit_ssse3);
+}
+
+// Carry-less multiplication, used by GHash.
+inline bool has_carry_less_multiplication()
+{
+    return has_cpuid_1_ecx_bits(cpuid_1_ecx_bit_pclmulqdq | cpuid_1_ecx_bit_ssse3);
+}
+
+// The SHA extensions, used by SHA256.
+inline bool has_sha_instructions()
+{
+    return has_cpuid_1_ecx_bits(cpuid_1_ecx_bit_ssse3 | cpuid_1_ecx_bit_sse4_1) && has_cpuid_7_ebx_bits(cpuid_7_ebx_bit_sha);
+}
+
+// AVX2, which also needs the OS to save the upper halves of the YMM registers.
+inline bool has_avx2()
+{
+    static bool const has_avx2 = [] {
+        if (!has_cpuid_1_ecx_bits(cpuid_1_ecx_bit_osxsave | cpuid_1_ecx_bit_avx) || !has_cpuid_7_ebx_bits(cpuid_7_ebx_bit_avx2))
+            return false;
+        u32 xcr0_low, xcr0_high;
+        asm volatile("xgetbv"
+                     : "=a"(xcr0_low), "=d"(xcr0_high)
+                     : "c"(0));
+        // XMM and YMM state.
+        return (xcr0_low & 0b110) == 0b110;
+    }();
+    return has_avx2;
+}
+#else
+inline bool has_aes_instructions() { return false; }
+inline bool has_carry_less_multiplication() { return false; }
+inline bool has_sha_instructions() { return false; }
+inline bool has_avx2() { return false; }
+#endif
+
+}
@@ -12,9 +12,19 @@ namespace Crypto::Checksum {
 
 void Adler32::update(ReadonlyBytes data)
 {
-    for (size_t i = 0; i < data.size(); i++) {
-        m_state_a = (m_state_a + data.at(i)) % 65521;
-        m_state_b = (m_state_b + m_state_a) % 65521;
+    // This is the largest amount of bytes after which the sums are guaranteed to still fit into 32 bits,
+    // so we only have to reduce them modulo 65521 once per chunk instead of once per byte.
+    static constexpr size_t max_chunk_size = 5552;
+
+    while (!data.is_empty()) {
+        auto chunk = data.trim(max_chunk_size);
+        for (auto byte : chunk) {
+            m_state_a += byte;
+            m_state_b += m_state_a;
+        }
+        m_state_a %= 65521;
+        m_state_b %= 65521;
+        data = data.slice(chunk.size());
     }
 };
 
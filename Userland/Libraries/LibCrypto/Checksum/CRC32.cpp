@@ -44,4 +44,42 @@ u32 CRC32::digest()
     return ~m_state;
 }
 
+// Polynomials over GF(2) are represented bit-reversed here (like the CRC state), so x^0 is the highest bit.
+static constexpr u32 multiply_modulo_polynomial(u32 a, u32 b)
+{
+    u32 product = 0;
+    for (u32 mask = 1u << 31; mask != 0; mask >>= 1) {
+        if (a & mask)
+            product ^= b;
+        b = (b & 1) ? 0xEDB88320 ^ (b >> 1) : b >> 1;
+    }
+    return product;
+}
+
+// x^(2^n) modulo the CRC polynomial.
+static constexpr auto generate_powers_of_x_table()
+{
+    Array<u32, 64> powers {};
+    u32 power = 1u << 30; // x^1
+    for (auto& entry : powers) {
+        entry = power;
+        power = multiply_modulo_polynomial(power, power);
+    }
+    return powers;
+}
+
+static constexpr auto powers_of_x_table = generate_powers_of_x_table();
+
+u32 CRC32::combine(u32 first_digest, u32 second_digest, u64 second_length)
+{
+    // Appending n bytes multiplies the first CRC by x^(8n). The parts of the second CRC that depend on the initial state and
+    // the final inversion cancel out with those that the first CRC contributes, which is what makes this a simple xor.
+    u32 shift = 1u << 31; // x^0
+    for (size_t bit = 3; second_length != 0; second_length >>= 1, bit++) {
+        if (second_length & 1)
+            shift = multiply_modulo_polynomial(powers_of_x_table[bit], shift);
+    }
+    return multiply_modulo_polynomial(shift, first_digest) ^ second_digest;
+}
+
 }
@@ -29,6 +29,10 @@ public:
     virtual void update(ReadonlyBytes data) override;
     virtual u32 digest() override;
 
+    // Returns the digest of two pieces of data one after the other, given the digests of both and the length of the second one.
+    // This allows computing the digest of separate parts of some data in parallel.
+    static u32 combine(u32 first_digest, u32 second_digest, u64 second_length);
+
 private:
     u32 m_state { ~0u };
 };
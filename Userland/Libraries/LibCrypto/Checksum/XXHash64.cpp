@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Endian.h>
+#include <LibCrypto/Checksum/XXHash64.h>
+
+namespace Crypto::Checksum {
+
+static constexpr u64 prime_1 = 0x9E3779B185EBCA87;
+static constexpr u64 prime_2 = 0xC2B2AE3D27D4EB4F;
+static constexpr u64 prime_3 = 0x165667B19E3779F9;
+static constexpr u64 prime_4 = 0x85EBCA77C2B2AE63;
+static constexpr u64 prime_5 = 0x27D4EB2F165667C5;
+
+static constexpr u64 rotate_left(u64 value, int count)
+{
+    return (value << count) | (value >> (64 - count));
+}
+
+static constexpr u64 round(u64 accumulator, u64 input)
+{
+    accumulator += input * prime_2;
+    accumulator = rotate_left(accumulator, 31);
+    return accumulator * prime_1;
+}
+
+static constexpr u64 merge_accumulator(u64 hash, u64 accumulator)
+{
+    hash ^= round(0, accumulator);
+    return hash * prime_1 + prime_4;
+}
+
+static u64 read_u64(u8 const* data)
+{
+    u64 value;
+    __builtin_memcpy(&value, data, sizeof(value));
+    return AK::convert_between_host_and_little_endian(value);
+}
+
+static u32 read_u32(u8 const* data)
+{
+    u32 value;
+    __builtin_memcpy(&value, data, sizeof(value));
+    return AK::convert_between_host_and_little_endian(value);
+}
+
+XXHash64::XXHash64(u64 seed)
+    : m_seed(seed)
+    , m_accumulators { seed + prime_1 + prime_2, seed + prime_2, seed, seed - prime_1 }
+{
+}
+
+void XXHash64::consume_stripe(u8 const* stripe)
+{
+    for (size_t i = 0; i < m_accumulators.size(); ++i)
+        m_accumulators[i] = round(m_accumulators[i], read_u64(stripe + i * sizeof(u64)));
+}
+
+void XXHash64::update(ReadonlyBytes data)
+{
+    m_total_length += data.size();
+
+    if (m_buffered_size > 0) {
+        auto copied = data.copy_trimmed_to(Bytes { m_buffer }.slice(m_buffered_size));
+        m_buffered_size += copied;
+        data = data.slice(copied);
+        if (m_buffered_size < stripe_size)
+            return;
+        consume_stripe(m_buffer.data());
+        m_buffered_size = 0;
+    }
+
+    while (data.size() >= stripe_size) {
+        consume_stripe(data.data());
+        data = data.slice(stripe_size);
+    }
+
+    m_buffered_size = data.copy_to(m_buffer);
+}
+
+u64 XXHash64::digest()
+{
+    u64 hash;
+    if (m_total_length >= stripe_size) {
+        hash = rotate_left(m_accumulators[0], 1) + rotate_left(m_accumulators[1], 7) + rotate_left(m_accumulators[2], 12) + rotate_left(m_accumulators[3], 18);
+        for (auto accumulator : m_accumulators)
+            hash = merge_accumulator(hash, accumulator);
+    } else {
+        hash = m_seed + prime_5;
+    }
+    hash += m_total_length;
+
+    auto const* remaining = m_buffer.data();
+    auto remaining_size = m_buffered_size;
+    for (; remaining_size >= sizeof(u64); remaining += sizeof(u64), remaining_size -= sizeof(u64)) {
+        hash ^= round(0, read_u64(remaining));
+        hash = rotate_left(hash, 27) * prime_1 + prime_4;
+    }
+    if (remaining_size >= sizeof(u32)) {
+        hash ^= read_u32(remaining) * prime_1;
+        hash = rotate_left(hash, 23) * prime_2 + prime_3;
+        remaining += sizeof(u32);
+        remaining_size -= sizeof(u32);
+    }
+    for (; remaining_size > 0; ++remaining, --remaining_size) {
+        hash ^= *remaining * prime_5;
+        hash = rotate_left(hash, 11) * prime_1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= prime_2;
+    hash ^= hash >> 29;
+    hash *= prime_3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+}
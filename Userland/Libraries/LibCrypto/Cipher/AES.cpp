@@ -7,6 +7,11 @@
 #include <AK/StringBuilder.h>
 #include <LibCrypto/Cipher/AES.h>
 #include <LibCrypto/Cipher/AESTables.h>
+#include <LibCrypto/CPUFeatures.h>
+
+#if CRYPTO_HAS_X86_64_INTRINSICS
+#    include <immintrin.h>
+#endif
 
 namespace Crypto {
 namespace Cipher {
@@ -24,6 +29,67 @@ constexpr void swap_keys(u32* keys, size_t i, size_t j)
     keys[j] = temp;
 }
 
+#if CRYPTO_HAS_X86_64_INTRINSICS
+// AES-NI runs a whole round in one instruction, in constant time. Blocks that don't depend on each other are
+// interleaved, as each instruction has a latency of several cycles but a throughput of one per cycle.
+namespace AESInstructions {
+
+static constexpr size_t interleaved_blocks = 8;
+
+// The round keys are stored as big-endian words, the instructions take them in byte order.
+[[gnu::target("aes,ssse3")]] static void load_round_keys(AESCipherKey const& key, __m128i (&keys)[15])
+{
+    auto const byte_swap_words = _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    for (size_t i = 0; i <= key.rounds(); ++i)
+        keys[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(key.round_keys() + i * 4)), byte_swap_words);
+}
+
+[[gnu::target("aes,ssse3")]] static void encrypt_blocks(AESCipherKey const& key, u8 const* in, u8* out, size_t block_count)
+{
+    __m128i keys[15];
+    load_round_keys(key, keys);
+    auto rounds = key.rounds();
+
+    for (; block_count >= interleaved_blocks; block_count -= interleaved_blocks) {
+        __m128i blocks[interleaved_blocks];
+        for (size_t i = 0; i < interleaved_blocks; ++i)
+            blocks[i] = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<__m128i const*>(in + i * 16)), keys[0]);
+        for (size_t round = 1; round < rounds; ++round) {
+            for (size_t i = 0; i < interleaved_blocks; ++i)
+                blocks[i] = _mm_aesenc_si128(blocks[i], keys[round]);
+        }
+        for (size_t i = 0; i < interleaved_blocks; ++i)
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 16), _mm_aesenclast_si128(blocks[i], keys[rounds]));
+        in += interleaved_blocks * 16;
+        out += interleaved_blocks * 16;
+    }
+
+    for (; block_count > 0; --block_count) {
+        auto block = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<__m128i const*>(in)), keys[0]);
+        for (size_t round = 1; round < rounds; ++round)
+            block = _mm_aesenc_si128(block, keys[round]);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_aesenclast_si128(block, keys[rounds]));
+        in += 16;
+        out += 16;
+    }
+}
+
+// The decryption key schedule is the one of the "equivalent inverse cipher" (FIPS 197, 5.3.5), which is what AESDEC expects.
+[[gnu::target("aes,ssse3")]] static void decrypt_block(AESCipherKey const& key, u8 const* in, u8* out)
+{
+    __m128i keys[15];
+    load_round_keys(key, keys);
+    auto rounds = key.rounds();
+
+    auto block = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<__m128i const*>(in)), keys[0]);
+    for (size_t round = 1; round < rounds; ++round)
+        block = _mm_aesdec_si128(block, keys[round]);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_aesdeclast_si128(block, keys[rounds]));
+}
+
+}
+#endif
+
 #ifndef KERNEL
 DeprecatedString AESCipherBlock::to_deprecated_string() const
 {
@@ -199,6 +265,13 @@ void AESCipherKey::expand_decrypt_key(ReadonlyBytes user_key, size_t bits)
 
 void AESCipher::encrypt_block(AESCipherBlock const& in, AESCipherBlock& out)
 {
+#if CRYPTO_HAS_X86_64_INTRINSICS
+    if (has_aes_instructions()) {
+        AESInstructions::encrypt_blocks(key(), in.bytes().data(), out.bytes().data(), 1);
+        return;
+    }
+#endif
+
     u32 s0, s1, s2, s3, t0, t1, t2, t3;
     size_t r { 0 };
 
@@ -286,8 +359,35 @@ void AESCipher::encrypt_block(AESCipherBlock const& in, AESCipherBlock& out)
     // clang-format on
 }
 
+void AESCipher::encrypt_blocks(ReadonlyBytes in, Bytes out)
+{
+    VERIFY(in.size() % block_size() == 0);
+    VERIFY(out.size() >= in.size());
+
+#if CRYPTO_HAS_X86_64_INTRINSICS
+    if (has_aes_instructions()) {
+        AESInstructions::encrypt_blocks(key(), in.data(), out.data(), in.size() / block_size());
+        return;
+    }
+#endif
+
+    AESCipherBlock block;
+    for (size_t offset = 0; offset < in.size(); offset += block_size()) {
+        block.overwrite(in.slice(offset, block_size()));
+        encrypt_block(block, block);
+        block.bytes().copy_to(out.slice(offset));
+    }
+}
+
 void AESCipher::decrypt_block(AESCipherBlock const& in, AESCipherBlock& out)
 {
+#if CRYPTO_HAS_X86_64_INTRINSICS
+    if (has_aes_instructions()) {
+        AESInstructions::decrypt_block(key(), in.bytes().data(), out.bytes().data());
+        return;
+    }
+#endif
+
     u32 s0, s1, s2, s3, t0, t1, t2, t3;
     size_t r { 0 };
 
@@ -120,6 +120,9 @@ public:
     virtual void encrypt_block(BlockType const& in, BlockType& out) override;
     virtual void decrypt_block(BlockType const& in, BlockType& out) override;
 
+    // Encrypts a run of independent blocks, such as the counter blocks of CTR mode, several at a time where the hardware allows it.
+    void encrypt_blocks(ReadonlyBytes in, Bytes out);
+
 #ifndef KERNEL
     virtual DeprecatedString class_name() const override
     {
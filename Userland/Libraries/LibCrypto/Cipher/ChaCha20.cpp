@@ -6,6 +6,8 @@
 
 #include <AK/ByteReader.h>
 #include <AK/Endian.h>
+#include <AK/SIMD.h>
+#include <LibCrypto/CPUFeatures.h>
 #include <LibCrypto/Cipher/ChaCha20.h>
 
 namespace Crypto::Cipher {
@@ -111,20 +113,126 @@ void ChaCha20::do_quarter_round(u32& a, u32& b, u32& c, u32& d)
     rotl(b, 7);
 }
 
+#if CRYPTO_HAS_X86_64_INTRINSICS
+// Computes several consecutive blocks at once, with word i of every block in vector i and one block per lane.
+namespace ChaCha20Vectorized {
+
+template<typename VectorType>
+ALWAYS_INLINE static void quarter_round(VectorType& a, VectorType& b, VectorType& c, VectorType& d)
+{
+    a += b;
+    d ^= a;
+    d = (d << 16) | (d >> 16);
+
+    c += d;
+    b ^= c;
+    b = (b << 12) | (b >> 20);
+
+    a += b;
+    d ^= a;
+    d = (d << 8) | (d >> 24);
+
+    c += d;
+    b ^= c;
+    b = (b << 7) | (b >> 25);
+}
+
+// XORs the key stream of Lanes blocks, starting at the counter of state, into input.
+template<typename VectorType, size_t Lanes>
+ALWAYS_INLINE static void xor_blocks(u32 const (&state)[16], u8 const* input, u8* output)
+{
+    VectorType initial[16];
+    for (size_t i = 0; i < 16; ++i)
+        initial[i] = VectorType {} + state[i];
+
+    // Each lane gets its own counter, carrying over to word 13 like generate_block() does.
+    for (size_t lane = 0; lane < Lanes; ++lane) {
+        u32 counter = state[12] + lane;
+        initial[12][lane] = counter;
+        initial[13][lane] = state[13] + (counter < state[12] ? 1 : 0);
+    }
+
+    VectorType x[16];
+    for (size_t i = 0; i < 16; ++i)
+        x[i] = initial[i];
+
+    for (size_t i = 0; i < 20; i += 2) {
+        quarter_round(x[0], x[4], x[8], x[12]);
+        quarter_round(x[1], x[5], x[9], x[13]);
+        quarter_round(x[2], x[6], x[10], x[14]);
+        quarter_round(x[3], x[7], x[11], x[15]);
+
+        quarter_round(x[0], x[5], x[10], x[15]);
+        quarter_round(x[1], x[6], x[11], x[12]);
+        quarter_round(x[2], x[7], x[8], x[13]);
+        quarter_round(x[3], x[4], x[9], x[14]);
+    }
+
+    // Put the words of every block back in order.
+    u32 key_stream[Lanes][16];
+    for (size_t i = 0; i < 16; ++i) {
+        x[i] += initial[i];
+        for (size_t lane = 0; lane < Lanes; ++lane)
+            key_stream[lane][i] = AK::convert_between_host_and_little_endian(x[i][lane]);
+    }
+
+    auto const* key_stream_bytes = reinterpret_cast<u8 const*>(key_stream);
+    for (size_t i = 0; i < Lanes * 64; i += sizeof(AK::SIMD::u8x16)) {
+        AK::SIMD::u8x16 data;
+        AK::SIMD::u8x16 key;
+        __builtin_memcpy(&data, input + i, sizeof(data));
+        __builtin_memcpy(&key, key_stream_bytes + i, sizeof(key));
+        data ^= key;
+        __builtin_memcpy(output + i, &data, sizeof(data));
+    }
+}
+
+static void xor_four_blocks(u32 const (&state)[16], u8 const* input, u8* output)
+{
+    xor_blocks<AK::SIMD::u32x4, 4>(state, input, output);
+}
+
+[[gnu::target("avx2")]] static void xor_eight_blocks(u32 const (&state)[16], u8 const* input, u8* output)
+{
+    xor_blocks<AK::SIMD::u32x8, 8>(state, input, output);
+}
+
+}
+#endif
+
+void ChaCha20::increment_counter(u32 block_count)
+{
+    // Increment the block counter, and carry over to block 13
+    m_state[12] += block_count;
+    if (m_state[12] < block_count) {
+        m_state[13]++;
+    }
+}
+
 void ChaCha20::run_cipher(ReadonlyBytes input, Bytes& output)
 {
     size_t offset = 0;
+
+#if CRYPTO_HAS_X86_64_INTRINSICS
+    // Whole batches of blocks are computed in parallel, the scalar loop below handles what is left.
+    if (has_avx2()) {
+        for (; input.size() - offset >= 8 * 64; offset += 8 * 64) {
+            ChaCha20Vectorized::xor_eight_blocks(m_state, input.offset_pointer(offset), output.offset_pointer(offset));
+            increment_counter(8);
+        }
+    }
+    for (; input.size() - offset >= 4 * 64; offset += 4 * 64) {
+        ChaCha20Vectorized::xor_four_blocks(m_state, input.offset_pointer(offset), output.offset_pointer(offset));
+        increment_counter(4);
+    }
+#endif
+
     size_t block_offset = 0;
     while (offset < input.size()) {
         if (block_offset == 0 || block_offset >= 64) {
             // Generate a new XOR block
             generate_block();
-
-            // Increment the block counter, and carry over to block 13
-            m_state[12]++;
-            if (m_state[12] == 0) {
-                m_state[13]++;
-            }
+            increment_counter(1);
 
             block_offset = 0;
         }
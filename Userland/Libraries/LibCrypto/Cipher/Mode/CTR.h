@@ -143,6 +143,7 @@ private:
 
 protected:
     constexpr static IncrementFunctionType increment {};
+    constexpr static size_t BatchBlockCount = 8;
 
     void encrypt_or_stream(ReadonlyBytes const* in, Bytes& out, ReadonlyBytes ivec, Bytes* ivec_out = nullptr)
     {
@@ -171,6 +172,33 @@ protected:
         size_t offset { 0 };
         auto block_size = cipher.block_size();
 
+        // Ciphers that can encrypt several blocks at once get the counter blocks in batches, as those don't depend on each other.
+        if constexpr (requires { cipher.encrypt_blocks(ReadonlyBytes {}, Bytes {}); }) {
+            constexpr size_t batch_size = BatchBlockCount * IVSizeInBits / 8;
+            VERIFY(block_size * BatchBlockCount == batch_size);
+
+            u8 counter_blocks[batch_size];
+            u8 key_stream_blocks[batch_size];
+            while (length >= batch_size) {
+                for (size_t i = 0; i < BatchBlockCount; ++i) {
+                    __builtin_memcpy(counter_blocks + i * block_size, iv.data(), block_size);
+                    increment(iv);
+                }
+                cipher.encrypt_blocks({ counter_blocks, batch_size }, { key_stream_blocks, batch_size });
+
+                VERIFY(offset + batch_size <= out.size());
+                if (in) {
+                    for (size_t i = 0; i < batch_size; ++i)
+                        out[offset + i] = (*in)[offset + i] ^ key_stream_blocks[i];
+                } else {
+                    __builtin_memcpy(out.offset(offset), key_stream_blocks, batch_size);
+                }
+
+                length -= batch_size;
+                offset += batch_size;
+            }
+        }
+
         while (length > 0) {
             m_cipher_block.overwrite(iv.slice(0, block_size));
 
@@ -4,9 +4,16 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Endian.h>
 #include <AK/Types.h>
+#include <AK/Vector.h>
+#include <LibCrypto/CPUFeatures.h>
 #include <LibCrypto/Hash/SHA2.h>
 
+#if CRYPTO_HAS_X86_64_INTRINSICS
+#    include <immintrin.h>
+#endif
+
 namespace Crypto::Hash {
 constexpr static auto ROTRIGHT(u32 a, size_t b) { return (a >> b) | (a << (32 - b)); }
 constexpr static auto CH(u32 x, u32 y, u32 z) { return (x & y) ^ (z & ~x); }
@@ -24,7 +31,7 @@ constexpr static auto EP1(u64 x) { return ROTRIGHT(x, 14) ^ ROTRIGHT(x, 18) ^ RO
 constexpr static auto SIGN0(u64 x) { return ROTRIGHT(x, 1) ^ ROTRIGHT(x, 8) ^ (x >> 7); }
 constexpr static auto SIGN1(u64 x) { return ROTRIGHT(x, 19) ^ ROTRIGHT(x, 61) ^ (x >> 6); }
 
-inline void SHA256::transform(u8 const* data)
+static void transform_block(u32 (&state)[8], u8 const* data)
 {
     u32 m[64];
 
@@ -33,16 +40,16 @@ inline void SHA256::transform(u8 const* data)
         m[i] = (data[j] << 24) | (data[j + 1] << 16) | (data[j + 2] << 8) | data[j + 3];
     }
 
-    for (; i < BlockSize; ++i) {
+    for (; i < 64; ++i) {
         m[i] = SIGN1(m[i - 2]) + m[i - 7] + SIGN0(m[i - 15]) + m[i - 16];
     }
 
-    auto a = m_state[0], b = m_state[1],
-         c = m_state[2], d = m_state[3],
-         e = m_state[4], f = m_state[5],
-         g = m_state[6], h = m_state[7];
+    auto a = state[0], b = state[1],
+         c = state[2], d = state[3],
+         e = state[4], f = state[5],
+         g = state[6], h = state[7];
 
-    for (size_t i = 0; i < Rounds; ++i) {
+    for (size_t i = 0; i < 64; ++i) {
         auto temp0 = h + EP1(e) + CH(e, f, g) + SHA256Constants::RoundConstants[i] + m[i];
         auto temp1 = EP0(a) + MAJ(a, b, c);
         h = g;
@@ -55,26 +62,247 @@ inline void SHA256::transform(u8 const* data)
         a = temp0 + temp1;
     }
 
-    m_state[0] += a;
-    m_state[1] += b;
-    m_state[2] += c;
-    m_state[3] += d;
-    m_state[4] += e;
-    m_state[5] += f;
-    m_state[6] += g;
-    m_state[7] += h;
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+#if CRYPTO_HAS_X86_64_INTRINSICS
+// The SHA extensions do two rounds per SHA256RNDS2, and SHA256MSG1/SHA256MSG2 extend the message schedule by four words
+// at a time. The instructions keep the state split up as ABEF and CDGH.
+[[gnu::target("sha,sse4.1,ssse3")]] static void transform_with_sha_instructions(u32 (&state)[8], u8 const* data, size_t block_count)
+{
+    auto const byte_swap_words = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    auto cdab = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const*>(&state[0])), 0xb1);
+    auto efgh = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const*>(&state[4])), 0x1b);
+    auto abef = _mm_alignr_epi8(cdab, efgh, 8);
+    auto cdgh = _mm_blend_epi16(efgh, cdab, 0xf0);
+
+    for (; block_count > 0; --block_count, data += 64) {
+        auto previous_abef = abef;
+        auto previous_cdgh = cdgh;
+
+        // The last four groups of four message words.
+        __m128i words[4];
+        for (size_t group = 0; group < 16; ++group) {
+            auto& current = words[group % 4];
+            if (group < 4) {
+                current = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(data + group * 16)), byte_swap_words);
+            } else {
+                // W[t] = SIGN1(W[t - 2]) + W[t - 7] + SIGN0(W[t - 15]) + W[t - 16]
+                auto const& minus_3 = words[(group + 1) % 4];
+                auto const& minus_2 = words[(group + 2) % 4];
+                auto const& minus_1 = words[(group + 3) % 4];
+                auto partial = _mm_add_epi32(_mm_sha256msg1_epu32(current, minus_3), _mm_alignr_epi8(minus_1, minus_2, 4));
+                current = _mm_sha256msg2_epu32(partial, minus_1);
+            }
+
+            auto input = _mm_add_epi32(current, _mm_loadu_si128(reinterpret_cast<__m128i const*>(&SHA256Constants::RoundConstants[group * 4])));
+            cdgh = _mm_sha256rnds2_epu32(cdgh, abef, input);
+            abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(input, 0x0e));
+        }
+
+        abef = _mm_add_epi32(abef, previous_abef);
+        cdgh = _mm_add_epi32(cdgh, previous_cdgh);
+    }
+
+    auto feba = _mm_shuffle_epi32(abef, 0x1b);
+    auto dchg = _mm_shuffle_epi32(cdgh, 0xb1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), _mm_blend_epi16(feba, dchg, 0xf0));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), _mm_alignr_epi8(dchg, feba, 8));
+}
+
+// A message with its padding, split into the blocks that can be read from the message itself and a copy of the rest.
+struct SHA256PaddedMessage {
+    u8 const* data { nullptr };
+    size_t full_blocks { 0 };
+    size_t block_count { 0 };
+    u8 tail[2 * SHA256::BlockSize] {};
+
+    explicit SHA256PaddedMessage(ReadonlyBytes message)
+        : data(message.data())
+        , full_blocks(message.size() / SHA256::BlockSize)
+    {
+        auto tail_size = message.size() % SHA256::BlockSize;
+        auto tail_blocks = tail_size + 9 <= SHA256::BlockSize ? 1 : 2;
+        block_count = full_blocks + tail_blocks;
+
+        message.slice(full_blocks * SHA256::BlockSize).copy_to({ tail, sizeof(tail) });
+        tail[tail_size] = 0x80;
+        u64 bit_length = message.size() * 8;
+        for (size_t i = 0; i < 8; ++i)
+            tail[tail_blocks * SHA256::BlockSize - 1 - i] = bit_length >> (i * 8);
+    }
+
+    u8 const* block(size_t index) const
+    {
+        if (index < full_blocks)
+            return data + index * SHA256::BlockSize;
+        return tail + (index - full_blocks) * SHA256::BlockSize;
+    }
+};
+
+namespace SHA256AVX2 {
+
+static constexpr size_t lanes = 8;
+
+[[gnu::target("avx2")]] static __m256i rotate_right(__m256i value, int bits)
+{
+    return _mm256_or_si256(_mm256_srli_epi32(value, bits), _mm256_slli_epi32(value, 32 - bits));
+}
+
+// Hashes up to eight messages at once, one in each 32-bit lane of the AVX2 registers.
+[[gnu::target("avx2")]] static void hash(SHA256PaddedMessage const* messages, size_t count, SHA256::DigestType* digests)
+{
+    VERIFY(count <= lanes);
+
+    __m256i state[8];
+    for (size_t i = 0; i < 8; ++i)
+        state[i] = _mm256_set1_epi32(SHA256Constants::InitializationHashes[i]);
+
+    size_t max_block_count = 0;
+    for (size_t lane = 0; lane < count; ++lane)
+        max_block_count = max(max_block_count, messages[lane].block_count);
+
+    static u8 const unused_block[SHA256::BlockSize] {};
+    for (size_t block = 0; block < max_block_count; ++block) {
+        alignas(32) u32 lane_words[16][lanes];
+        for (size_t lane = 0; lane < lanes; ++lane) {
+            auto const* data = lane < count && block < messages[lane].block_count ? messages[lane].block(block) : unused_block;
+            for (size_t i = 0; i < 16; ++i) {
+                u32 word;
+                __builtin_memcpy(&word, data + i * 4, sizeof(word));
+                lane_words[i][lane] = AK::convert_between_host_and_big_endian(word);
+            }
+        }
+
+        __m256i m[16];
+        for (size_t i = 0; i < 16; ++i)
+            m[i] = _mm256_load_si256(reinterpret_cast<__m256i const*>(lane_words[i]));
+
+        auto a = state[0], b = state[1],
+             c = state[2], d = state[3],
+             e = state[4], f = state[5],
+             g = state[6], h = state[7];
+
+        for (size_t i = 0; i < 64; ++i) {
+            if (i >= 16) {
+                auto minus_2 = m[(i - 2) % 16];
+                auto minus_15 = m[(i - 15) % 16];
+                auto sign1 = _mm256_xor_si256(_mm256_xor_si256(rotate_right(minus_2, 17), rotate_right(minus_2, 19)), _mm256_srli_epi32(minus_2, 10));
+                auto sign0 = _mm256_xor_si256(_mm256_xor_si256(rotate_right(minus_15, 7), rotate_right(minus_15, 18)), _mm256_srli_epi32(minus_15, 3));
+                m[i % 16] = _mm256_add_epi32(_mm256_add_epi32(sign1, m[(i - 7) % 16]), _mm256_add_epi32(sign0, m[i % 16]));
+            }
+
+            auto ep1 = _mm256_xor_si256(_mm256_xor_si256(rotate_right(e, 6), rotate_right(e, 11)), rotate_right(e, 25));
+            auto ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+            auto temp0 = _mm256_add_epi32(_mm256_add_epi32(h, ep1), _mm256_add_epi32(ch, _mm256_add_epi32(_mm256_set1_epi32(SHA256Constants::RoundConstants[i]), m[i % 16])));
+            auto ep0 = _mm256_xor_si256(_mm256_xor_si256(rotate_right(a, 2), rotate_right(a, 13)), rotate_right(a, 22));
+            auto maj = _mm256_xor_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_xor_si256(a, b)));
+            auto temp1 = _mm256_add_epi32(ep0, maj);
+            h = g;
+            g = f;
+            f = e;
+            e = _mm256_add_epi32(d, temp0);
+            d = c;
+            c = b;
+            b = a;
+            a = _mm256_add_epi32(temp0, temp1);
+        }
+
+        state[0] = _mm256_add_epi32(state[0], a);
+        state[1] = _mm256_add_epi32(state[1], b);
+        state[2] = _mm256_add_epi32(state[2], c);
+        state[3] = _mm256_add_epi32(state[3], d);
+        state[4] = _mm256_add_epi32(state[4], e);
+        state[5] = _mm256_add_epi32(state[5], f);
+        state[6] = _mm256_add_epi32(state[6], g);
+        state[7] = _mm256_add_epi32(state[7], h);
+
+        for (size_t lane = 0; lane < count; ++lane) {
+            if (block + 1 != messages[lane].block_count)
+                continue;
+            alignas(32) u32 words[lanes];
+            for (size_t i = 0; i < 8; ++i) {
+                _mm256_store_si256(reinterpret_cast<__m256i*>(words), state[i]);
+                auto word = AK::convert_between_host_and_big_endian(words[lane]);
+                __builtin_memcpy(digests[lane].data + i * 4, &word, sizeof(word));
+            }
+        }
+    }
+}
+
+}
+#endif
+
+void SHA256::transform(u8 const* data, size_t block_count)
+{
+#if CRYPTO_HAS_X86_64_INTRINSICS
+    if (has_sha_instructions()) {
+        transform_with_sha_instructions(m_state, data, block_count);
+        return;
+    }
+#endif
+
+    for (size_t i = 0; i < block_count; ++i)
+        transform_block(m_state, data + i * BlockSize);
 }
 
 void SHA256::update(u8 const* message, size_t length)
 {
-    for (size_t i = 0; i < length; ++i) {
-        if (m_data_length == BlockSize) {
-            transform(m_data_buffer);
-            m_bit_length += 512;
-            m_data_length = 0;
+    if (m_data_length > 0) {
+        auto size = min(length, BlockSize - m_data_length);
+        __builtin_memcpy(m_data_buffer + m_data_length, message, size);
+        m_data_length += size;
+        message += size;
+        length -= size;
+        if (m_data_length < BlockSize)
+            return;
+
+        transform(m_data_buffer);
+        m_bit_length += BlockSize * 8;
+        m_data_length = 0;
+    }
+
+    // Whole blocks don't need to go through the buffer.
+    auto block_count = length / BlockSize;
+    if (block_count > 0) {
+        transform(message, block_count);
+        m_bit_length += block_count * BlockSize * 8;
+        message += block_count * BlockSize;
+        length -= block_count * BlockSize;
+    }
+
+    __builtin_memcpy(m_data_buffer, message, length);
+    m_data_length = length;
+}
+
+void SHA256::hash_many(ReadonlySpan<ReadonlyBytes> messages, Span<DigestType> digests)
+{
+    VERIFY(digests.size() >= messages.size());
+
+#if CRYPTO_HAS_X86_64_INTRINSICS
+    // The SHA extensions are faster than eight lanes of AVX2, so those are only worth it without them.
+    if (has_avx2() && !has_sha_instructions()) {
+        for (size_t offset = 0; offset < messages.size(); offset += SHA256AVX2::lanes) {
+            auto count = min(SHA256AVX2::lanes, messages.size() - offset);
+            Vector<SHA256PaddedMessage, SHA256AVX2::lanes> padded_messages;
+            for (size_t i = 0; i < count; ++i)
+                padded_messages.unchecked_append(SHA256PaddedMessage { messages[offset + i] });
+            SHA256AVX2::hash(padded_messages.data(), count, digests.offset_pointer(offset));
         }
-        m_data_buffer[m_data_length++] = message[i];
+        return;
     }
+#endif
+
+    for (size_t i = 0; i < messages.size(); ++i)
+        digests[i] = hash(messages[i].data(), messages[i].size());
 }
 
 SHA256::DigestType SHA256::digest()
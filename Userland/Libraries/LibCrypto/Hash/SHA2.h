@@ -99,6 +99,9 @@ public:
     static DigestType hash(ByteBuffer const& buffer) { return hash(buffer.data(), buffer.size()); }
     static DigestType hash(StringView buffer) { return hash((u8 const*)buffer.characters_without_null_termination(), buffer.length()); }
 
+    // Hashes each message on its own, interleaving several of them where the hardware allows it.
+    static void hash_many(ReadonlySpan<ReadonlyBytes> messages, Span<DigestType> digests);
+
 #ifndef KERNEL
     virtual DeprecatedString class_name() const override
     {
@@ -115,7 +118,7 @@ public:
     }
 
 private:
-    inline void transform(u8 const*);
+    void transform(u8 const* data, size_t block_count = 1);
 
     u8 m_data_buffer[BlockSize] {};
     size_t m_data_length { 0 };
@@ -116,8 +116,8 @@ Optional<Packet> Packet::from_raw_packet(u8 const* raw_data, size_t raw_size)
     packet.m_query_or_response = header.is_response();
     packet.m_code = header.response_code();
 
-    // FIXME: Should we parse further in this case?
-    if (packet.code() != Code::NOERROR)
+    // NOTE: A response saying the name doesn't exist still has an authority section, which says for how long that holds.
+    if (packet.code() != Code::NOERROR && packet.code() != Code::NXDOMAIN)
         return packet;
 
     size_t offset = sizeof(PacketHeader);
@@ -137,7 +137,7 @@ Optional<Packet> Packet::from_raw_packet(u8 const* raw_data, size_t raw_size)
         dbgln_if(LOOKUPSERVER_DEBUG, "Question #{}: name=_{}_, type={}, class={}", i, question.name(), question.record_type(), question.class_code());
     }
 
-    for (u16 i = 0; i < header.answer_count(); ++i) {
+    auto parse_record = [&](StringView section, u16 index) {
         auto name = Name::parse(raw_data, offset, raw_size);
 
         auto& record = *(DNSRecordWithoutName const*)(&raw_data[offset]);
@@ -154,6 +154,8 @@ Optional<Packet> Packet::from_raw_packet(u8 const* raw_data, size_t raw_size)
         }
         case RecordType::CNAME:
             // Fall through
+        case RecordType::SOA:
+            // Fall through
         case RecordType::A:
             // Fall through
         case RecordType::TXT:
@@ -168,12 +170,17 @@ Optional<Packet> Packet::from_raw_packet(u8 const* raw_data, size_t raw_size)
             dbgln("data=(unimplemented record type {})", (u16)record.type());
         }
 
-        dbgln_if(LOOKUPSERVER_DEBUG, "Answer   #{}: name=_{}_, type={}, ttl={}, length={}, data=_{}_", i, name, record.type(), record.ttl(), record.data_length(), data);
+        dbgln_if(LOOKUPSERVER_DEBUG, "{} #{}: name=_{}_, type={}, ttl={}, length={}, data=_{}_", section, index, name, record.type(), record.ttl(), record.data_length(), data);
         u16 class_code = record.record_class() & ~MDNS_CACHE_FLUSH;
         bool mdns_cache_flush = record.record_class() & MDNS_CACHE_FLUSH;
-        packet.m_answers.empend(name, (RecordType)record.type(), (RecordClass)class_code, record.ttl(), data, mdns_cache_flush);
         offset += record.data_length();
-    }
+        return Answer { name, (RecordType)record.type(), (RecordClass)class_code, record.ttl(), data, mdns_cache_flush };
+    };
+
+    for (u16 i = 0; i < header.answer_count(); ++i)
+        packet.m_answers.append(parse_record("Answer   "sv, i));
+    for (u16 i = 0; i < header.authority_count() && offset < raw_size; ++i)
+        packet.m_authority_records.append(parse_record("Authority"sv, i));
 
     return packet;
 }
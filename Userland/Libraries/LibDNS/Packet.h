@@ -43,6 +43,8 @@ public:
 
     Vector<Question> const& questions() const { return m_questions; }
     Vector<Answer> const& answers() const { return m_answers; }
+    // Only filled in when parsing a response.
+    Vector<Answer> const& authority_records() const { return m_authority_records; }
 
     u16 question_count() const
     {
@@ -84,6 +86,7 @@ private:
     bool m_recursion_available { true };
     Vector<Question> m_questions;
     Vector<Answer> m_answers;
+    Vector<Answer> m_authority_records;
 };
 
 }
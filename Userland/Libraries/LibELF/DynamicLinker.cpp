@@ -41,6 +41,11 @@ static HashMap<DeprecatedString, NonnullRefPtr<ELF::DynamicLoader>> s_loaders;
 static DeprecatedString s_main_program_path;
 static OrderedHashMap<DeprecatedString, NonnullRefPtr<ELF::DynamicObject>> s_global_objects;
 
+// Only exists while link_main_library() is relocating a set of objects. Those relocations look up the same
+// symbols over and over again (every library wants malloc and friends), and the set of global objects can't
+// change in the meantime. The names point into the string tables of the global objects.
+static Optional<HashMap<StringView, Optional<DynamicObject::SymbolLookupResult>>> s_global_symbol_cache;
+
 using EntryPointFunction = int (*)(int, char**, char**);
 using LibCExitFunction = void (*)(int);
 using DlIteratePhdrCallbackFunction = int (*)(struct dl_phdr_info*, size_t, void*);
@@ -86,6 +91,19 @@ Optional<DynamicObject::SymbolLookupResult> DynamicLinker::lookup_global_symbol(
     return weak_result;
 }
 
+Optional<DynamicObject::SymbolLookupResult> DynamicLinker::lookup_global_symbol_for_relocation(StringView name)
+{
+    if (!s_global_symbol_cache.has_value())
+        return lookup_global_symbol(name);
+
+    if (auto it = s_global_symbol_cache->find(name); it != s_global_symbol_cache->end())
+        return it->value;
+
+    auto result = lookup_global_symbol(name);
+    s_global_symbol_cache->set(name, result);
+    return result;
+}
+
 static Result<NonnullRefPtr<DynamicLoader>, DlErrorMessage> map_library(DeprecatedString const& filepath, int fd)
 {
     VERIFY(filepath.starts_with('/'));
@@ -391,10 +409,16 @@ static Result<void, DlErrorMessage> link_main_library(DeprecatedString const& pa
             s_global_objects.set(dynamic_object->filepath(), *dynamic_object);
     }
 
-    for (auto& loader : loaders) {
-        bool success = loader.link(flags);
-        if (!success) {
-            return DlErrorMessage { DeprecatedString::formatted("Failed to link library {}", loader.filepath()) };
+    {
+        // Nothing that runs during relocation (like IFUNC resolvers) can add new global objects.
+        s_global_symbol_cache.emplace();
+        ScopeGuard drop_symbol_cache = [] { s_global_symbol_cache.clear(); };
+
+        for (auto& loader : loaders) {
+            bool success = loader.link(flags);
+            if (!success) {
+                return DlErrorMessage { DeprecatedString::formatted("Failed to link library {}", loader.filepath()) };
+            }
         }
     }
 
@@ -15,6 +15,9 @@ namespace ELF {
 class DynamicLinker {
 public:
     static Optional<DynamicObject::SymbolLookupResult> lookup_global_symbol(StringView symbol);
+    // Same as lookup_global_symbol(), but answers repeated lookups from a cache while objects are being linked.
+    // Lazy PLT binding doesn't hold the loader lock, so this must only be used by the initial relocation pass.
+    static Optional<DynamicObject::SymbolLookupResult> lookup_global_symbol_for_relocation(StringView symbol);
     [[noreturn]] static void linker_main(DeprecatedString&& main_program_path, int fd, bool is_secure, int argc, char** argv, char** envp);
 
     static Optional<DeprecatedString> resolve_library(DeprecatedString const& name, DynamicObject const& parent_object);
@@ -213,7 +213,8 @@ void DynamicLoader::do_main_relocations()
     };
 
     do_relr_relocations();
-    m_dynamic_object->relocation_section().for_each_relocation(do_single_relocation);
+    auto relative_relocation_count = do_relative_relocations();
+    m_dynamic_object->relocation_section().for_each_relocation(do_single_relocation, relative_relocation_count);
     m_dynamic_object->plt_relocation_section().for_each_relocation(do_single_relocation);
 }
 
@@ -476,6 +477,12 @@ DynamicLoader::RelocationResult DynamicLoader::do_relocation(const ELF::DynamicO
         return VirtualAddress { reinterpret_cast<DynamicObject::IfuncResolver>(address.get())() };
     };
 
+    auto lookup_symbol = [](DynamicObject::Symbol const& symbol) {
+        if (symbol.is_undefined() || symbol.bind() == STB_WEAK)
+            return DynamicLinker::lookup_global_symbol_for_relocation(symbol.name());
+        return DynamicLoader::lookup_symbol(symbol);
+    };
+
     switch (relocation.type()) {
 
     case R_X86_64_NONE:
@@ -534,9 +541,8 @@ DynamicLoader::RelocationResult DynamicLoader::do_relocation(const ELF::DynamicO
     case R_X86_64_RELATIVE: {
         if (!image().is_dynamic())
             break;
-        // FIXME: According to the spec, R_386_relative ones must be done first.
-        //     We could explicitly do them first using m_number_of_relocations from DT_RELCOUNT
-        //     However, our compiler is nice enough to put them at the front of the relocations for us :)
+        // NOTE: Usually, these have already been applied by do_relative_relocations().
+        //     We only end up here for objects that don't have DT_RELACOUNT.
         if (relocation.addend_used())
             *patch_ptr = m_dynamic_object->base_address().offset(relocation.addend()).get();
         else
@@ -615,6 +621,37 @@ void DynamicLoader::do_relr_relocations()
     });
 }
 
+// The static linker sorts all RELATIVE relocations to the front of the relocation table, and tells us how many there
+// are. They are the bulk of the relocations in most libraries, and as they don't refer to any symbol, we can apply
+// them in a tight loop instead of going through do_relocation() for each of them.
+// Returns the number of relocations that were applied.
+size_t DynamicLoader::do_relative_relocations()
+{
+    if (!image().is_dynamic())
+        return 0;
+
+    auto relocations = m_dynamic_object->relocation_section();
+    size_t count = min(m_dynamic_object->relative_relocation_count(), static_cast<size_t>(relocations.relocation_count()));
+
+    auto base_address = m_dynamic_object->base_address().get();
+    auto const* entries = relocations.address().as_ptr();
+    for (size_t i = 0; i < count; ++i) {
+        // r_offset and r_info are laid out the same way in Rel and Rela entries.
+        auto const& entry = *reinterpret_cast<ElfW(Rela) const*>(entries + i * relocations.entry_size());
+        auto type = ELF64_R_TYPE(entry.r_info);
+        // Don't trust DT_RELACOUNT blindly, let do_relocation() deal with anything unexpected.
+        if (type != R_X86_64_RELATIVE && type != R_AARCH64_RELATIVE)
+            return i;
+
+        auto* patch_ptr = reinterpret_cast<FlatPtr*>(base_address + entry.r_offset);
+        if (relocations.addend_used())
+            *patch_ptr = base_address + entry.r_addend;
+        else
+            *patch_ptr += base_address;
+    }
+    return count;
+}
+
 void DynamicLoader::copy_initial_tls_data_into(ByteBuffer& buffer) const
 {
     image().for_each_program_header([this, &buffer](ELF::Image::ProgramHeader program_header) {
@@ -135,6 +135,7 @@ private:
     };
     RelocationResult do_relocation(DynamicObject::Relocation const&, ShouldInitializeWeak should_initialize_weak);
     void do_relr_relocations();
+    size_t do_relative_relocations();
     void find_tls_size_and_alignment();
 
     DeprecatedString m_filepath;
@@ -133,13 +133,14 @@ public:
         {
         }
         unsigned relocation_count() const { return entry_count(); }
+        bool addend_used() const { return m_addend_used; }
         Relocation relocation(unsigned index) const;
         Relocation relocation_at_offset(unsigned offset) const;
 
         template<IteratorFunction<DynamicObject::Relocation&> F>
-        void for_each_relocation(F) const;
+        void for_each_relocation(F, unsigned first_index = 0) const;
         template<VoidFunction<DynamicObject::Relocation&> F>
-        void for_each_relocation(F func) const;
+        void for_each_relocation(F func, unsigned first_index = 0) const;
 
     private:
         bool const m_addend_used;
@@ -259,6 +260,8 @@ public:
     RelocationSection relocation_section() const;
     RelocationSection plt_relocation_section() const;
     Section relr_relocation_section() const;
+    // The number of RELATIVE relocations at the start of the relocation section (DT_RELACOUNT).
+    size_t relative_relocation_count() const { return m_number_of_relocations; }
 
     bool should_process_origin() const { return m_dt_flags & DF_ORIGIN; }
     bool requires_symbolic_symbol_resolution() const { return m_dt_flags & DF_SYMBOLIC; }
@@ -386,9 +389,9 @@ private:
 };
 
 template<IteratorFunction<DynamicObject::Relocation&> F>
-inline void DynamicObject::RelocationSection::for_each_relocation(F func) const
+inline void DynamicObject::RelocationSection::for_each_relocation(F func, unsigned first_index) const
 {
-    for (unsigned i = 0; i < relocation_count(); ++i) {
+    for (unsigned i = first_index; i < relocation_count(); ++i) {
         auto const reloc = relocation(i);
         if (reloc.type() == 0)
             continue;
@@ -398,12 +401,13 @@ inline void DynamicObject::RelocationSection::for_each_relocation(F func) const
 }
 
 template<VoidFunction<DynamicObject::Relocation&> F>
-inline void DynamicObject::RelocationSection::for_each_relocation(F func) const
+inline void DynamicObject::RelocationSection::for_each_relocation(F func, unsigned first_index) const
 {
     for_each_relocation([&](auto& reloc) {
         func(reloc);
         return IterationDecision::Continue;
-    });
+    },
+        first_index);
 }
 
 template<typename F>
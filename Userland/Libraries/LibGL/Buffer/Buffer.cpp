@@ -10,6 +10,7 @@ namespace GL {
 
 ErrorOr<void> Buffer::set_data(void const* data, size_t size)
 {
+    ++m_generation;
     if (!data) {
         m_data = TRY(ByteBuffer::create_uninitialized(size));
         return {};
@@ -20,6 +21,7 @@ ErrorOr<void> Buffer::set_data(void const* data, size_t size)
 
 void Buffer::replace_data(void const* data, size_t offset, size_t size)
 {
+    ++m_generation;
     m_data.overwrite(offset, data, size);
 }
 
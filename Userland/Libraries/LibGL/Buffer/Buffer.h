@@ -22,8 +22,12 @@ public:
     void* data();
     void* offset_data(size_t);
 
+    // Changes whenever the contents of the buffer do.
+    u32 generation() const { return m_generation; }
+
 private:
     ByteBuffer m_data;
+    u32 m_generation { 0 };
 };
 
 }
@@ -89,6 +89,10 @@ struct VertexAttribPointer {
     bool normalize;
     GLsizei stride { 0 };
     void const* pointer { 0 };
+    // The buffer object that `pointer` points into, if any.
+    RefPtr<Buffer> buffer;
+
+    bool operator==(VertexAttribPointer const&) const = default;
 };
 
 enum Face {
@@ -251,6 +255,10 @@ private:
 
     ErrorOr<ByteBuffer> build_extension_string();
 
+    template<typename IndexCallback>
+    void draw_vertex_arrays(GLenum mode, size_t count, size_t first_index, size_t end_index, IndexCallback);
+    Span<GPU::Vertex const> assemble_vertices_from_arrays(size_t first_index, size_t end_index);
+
     template<typename T>
     T* store_in_listing(T value)
     {
@@ -531,6 +539,22 @@ private:
     Vector<VertexAttribPointer> m_client_tex_coord_pointer;
     VertexAttribPointer m_client_normal_pointer;
 
+    // Vertices assembled from the enabled vertex arrays. When all of them live in buffer objects, these are kept until
+    // the buffers or the array configuration change, so static meshes don't have to be converted on every draw call.
+    struct AssembledVertexArrays {
+        struct Attribute {
+            VertexAttribPointer pointer;
+            u32 buffer_generation { 0 };
+
+            bool operator==(Attribute const&) const = default;
+        };
+        Vector<Attribute> attributes;
+        bool is_cacheable { false };
+        size_t first_index { 0 };
+        Vector<GPU::Vertex> vertices;
+    };
+    AssembledVertexArrays m_assembled_vertex_arrays;
+
     struct PixelParameters {
         i32 image_height { 0 };
         bool least_significant_bit_first { false };
@@ -12,50 +12,65 @@
 
 namespace GL {
 
-// General helper function to read arbitrary vertex attribute data into a float array
-static void read_from_vertex_attribute_pointer(VertexAttribPointer const& attrib, int index, float* elements)
+// General helper function to read arbitrary vertex attribute data of the vertices in [first, end) as floats. The
+// elements that the attribute does not specify are passed on as (0, 0, 0, 1).
+template<typename Callback>
+static void read_vertex_attribute_range(VertexAttribPointer const& attrib, size_t first, size_t end, Callback callback)
 {
     auto const* byte_ptr = reinterpret_cast<char const*>(attrib.pointer);
 
     auto read_values = [&]<typename T>() {
         auto const stride = (attrib.stride == 0) ? sizeof(T) * attrib.size : attrib.stride;
-        for (int i = 0; i < attrib.size; ++i) {
-            elements[i] = *(reinterpret_cast<T const*>(byte_ptr + stride * index) + i);
-            if constexpr (IsIntegral<T>) {
-                if (attrib.normalize)
-                    elements[i] /= NumericLimits<T>::max();
+        float elements[4] { 0.f, 0.f, 0.f, 1.f };
+        for (size_t index = first; index < end; ++index) {
+            auto const* values = reinterpret_cast<T const*>(byte_ptr + stride * index);
+            for (int i = 0; i < attrib.size; ++i) {
+                elements[i] = values[i];
+                if constexpr (IsIntegral<T>) {
+                    if (attrib.normalize)
+                        elements[i] /= NumericLimits<T>::max();
+                }
             }
+            callback(index, elements);
         }
     };
 
     switch (attrib.type) {
     case GL_BYTE:
-        read_values.operator()<GLbyte>();
+        read_values.template operator()<GLbyte>();
         break;
     case GL_UNSIGNED_BYTE:
-        read_values.operator()<GLubyte>();
+        read_values.template operator()<GLubyte>();
         break;
     case GL_SHORT:
-        read_values.operator()<GLshort>();
+        read_values.template operator()<GLshort>();
         break;
     case GL_UNSIGNED_SHORT:
-        read_values.operator()<GLushort>();
+        read_values.template operator()<GLushort>();
         break;
     case GL_INT:
-        read_values.operator()<GLint>();
+        read_values.template operator()<GLint>();
         break;
     case GL_UNSIGNED_INT:
-        read_values.operator()<GLuint>();
+        read_values.template operator()<GLuint>();
         break;
     case GL_FLOAT:
-        read_values.operator()<GLfloat>();
+        read_values.template operator()<GLfloat>();
         break;
     case GL_DOUBLE:
-        read_values.operator()<GLdouble>();
+        read_values.template operator()<GLdouble>();
         break;
     }
 }
 
+static void read_from_vertex_attribute_pointer(VertexAttribPointer const& attrib, int index, float* elements)
+{
+    read_vertex_attribute_range(attrib, index, index + 1, [&](size_t, float const* values) {
+        for (int i = 0; i < attrib.size; ++i)
+            elements[i] = values[i];
+    });
+}
+
 void GLContext::gl_array_element(GLint i)
 {
     // NOTE: This always dereferences data; display list support is deferred to the
@@ -116,7 +131,7 @@ void GLContext::gl_color_pointer(GLint size, GLenum type, GLsizei stride, void c
         size_t data_offset = reinterpret_cast<size_t>(pointer);
         data_pointer = m_array_buffer->offset_data(data_offset);
     }
-    m_client_color_pointer = { .size = size, .type = type, .normalize = true, .stride = stride, .pointer = data_pointer };
+    m_client_color_pointer = { .size = size, .type = type, .normalize = true, .stride = stride, .pointer = data_pointer, .buffer = m_array_buffer };
 }
 
 void GLContext::gl_draw_arrays(GLenum mode, GLint first, GLsizei count)
@@ -136,36 +151,7 @@ void GLContext::gl_draw_arrays(GLenum mode, GLint first, GLsizei count)
 
     RETURN_WITH_ERROR_IF(count < 0, GL_INVALID_VALUE);
 
-    auto last = first + count;
-    gl_begin(mode);
-    for (int i = first; i < last; i++) {
-        if (m_client_side_color_array_enabled) {
-            float color[4] { 0.f, 0.f, 0.f, 1.f };
-            read_from_vertex_attribute_pointer(m_client_color_pointer, i, color);
-            gl_color(color[0], color[1], color[2], color[3]);
-        }
-
-        for (size_t t = 0; t < m_client_tex_coord_pointer.size(); ++t) {
-            if (m_client_side_texture_coord_array_enabled[t]) {
-                float tex_coords[4] { 0.f, 0.f, 0.f, 1.f };
-                read_from_vertex_attribute_pointer(m_client_tex_coord_pointer[t], i, tex_coords);
-                gl_multi_tex_coord(GL_TEXTURE0 + t, tex_coords[0], tex_coords[1], tex_coords[2], tex_coords[3]);
-            }
-        }
-
-        if (m_client_side_normal_array_enabled) {
-            float normal[3];
-            read_from_vertex_attribute_pointer(m_client_normal_pointer, i, normal);
-            gl_normal(normal[0], normal[1], normal[2]);
-        }
-
-        if (m_client_side_vertex_array_enabled) {
-            float vertex[4] { 0.f, 0.f, 0.f, 1.f };
-            read_from_vertex_attribute_pointer(m_client_vertex_pointer, i, vertex);
-            gl_vertex(vertex[0], vertex[1], vertex[2], vertex[3]);
-        }
-    }
-    gl_end();
+    draw_vertex_arrays(mode, count, first, first + count, [first](size_t i) { return first + i; });
 }
 
 void GLContext::gl_draw_elements(GLenum mode, GLsizei count, GLenum type, void const* indices)
@@ -196,50 +182,145 @@ void GLContext::gl_draw_elements(GLenum mode, GLsizei count, GLenum type, void c
         index_data = m_element_array_buffer->offset_data(data_offset);
     }
 
-    gl_begin(mode);
-    for (int index = 0; index < count; index++) {
-        int i = 0;
+    auto index_at = [&](size_t index) -> size_t {
         switch (type) {
         case GL_UNSIGNED_BYTE:
-            i = reinterpret_cast<GLubyte const*>(index_data)[index];
-            break;
+            return reinterpret_cast<GLubyte const*>(index_data)[index];
         case GL_UNSIGNED_SHORT:
-            i = reinterpret_cast<GLushort const*>(index_data)[index];
-            break;
+            return reinterpret_cast<GLushort const*>(index_data)[index];
         case GL_UNSIGNED_INT:
-            i = reinterpret_cast<GLuint const*>(index_data)[index];
-            break;
+            return reinterpret_cast<GLuint const*>(index_data)[index];
         }
+        VERIFY_NOT_REACHED();
+    };
 
-        if (m_client_side_color_array_enabled) {
-            float color[4] { 0.f, 0.f, 0.f, 1.f };
-            read_from_vertex_attribute_pointer(m_client_color_pointer, i, color);
-            gl_color(color[0], color[1], color[2], color[3]);
-        }
+    size_t first_index = NumericLimits<size_t>::max();
+    size_t end_index = 0;
+    for (int index = 0; index < count; index++) {
+        auto i = index_at(index);
+        first_index = min(first_index, i);
+        end_index = max(end_index, i + 1);
+    }
 
-        for (size_t t = 0; t < m_client_tex_coord_pointer.size(); ++t) {
-            if (m_client_side_texture_coord_array_enabled[t]) {
-                float tex_coords[4] { 0.f, 0.f, 0.f, 1.f };
-                read_from_vertex_attribute_pointer(m_client_tex_coord_pointer[t], i, tex_coords);
-                gl_multi_tex_coord(GL_TEXTURE0 + t, tex_coords[0], tex_coords[1], tex_coords[2], tex_coords[3]);
-            }
-        }
+    draw_vertex_arrays(mode, count, min(first_index, end_index), end_index, index_at);
+}
+
+template<typename IndexCallback>
+void GLContext::draw_vertex_arrays(GLenum mode, size_t count, size_t first_index, size_t end_index, IndexCallback index_at)
+{
+    // While compiling a display list, every vertex attribute has to be recorded individually.
+    if (should_append_to_listing() || !m_client_side_vertex_array_enabled) {
+        gl_begin(mode);
+        for (size_t i = 0; i < count; ++i)
+            gl_array_element(index_at(i));
+        gl_end();
+        return;
+    }
+
+    auto vertices = assemble_vertices_from_arrays(first_index, end_index);
 
-        if (m_client_side_normal_array_enabled) {
-            float normal[3];
-            read_from_vertex_attribute_pointer(m_client_normal_pointer, i, normal);
-            gl_normal(normal[0], normal[1], normal[2]);
+    gl_begin(mode);
+    m_vertex_list.ensure_capacity(m_vertex_list.size() + count);
+    for (size_t i = 0; i < count; ++i) {
+        auto vertex = vertices[index_at(i) - first_index];
+
+        // Attributes without an enabled array take on the current values.
+        if (!m_client_side_color_array_enabled)
+            vertex.color = m_current_vertex_color;
+        for (size_t t = 0; t < m_device_info.num_texture_units; ++t) {
+            if (!m_client_side_texture_coord_array_enabled[t])
+                vertex.tex_coords[t] = m_current_vertex_tex_coord[t];
         }
+        if (!m_client_side_normal_array_enabled)
+            vertex.normal = m_current_vertex_normal;
 
-        if (m_client_side_vertex_array_enabled) {
-            float vertex[4] { 0.f, 0.f, 0.f, 1.f };
-            read_from_vertex_attribute_pointer(m_client_vertex_pointer, i, vertex);
-            gl_vertex(vertex[0], vertex[1], vertex[2], vertex[3]);
+        m_vertex_list.unchecked_append(vertex);
+    }
+
+    // The current values of the enabled arrays' attributes end up as those of the last vertex, like they would have
+    // with glArrayElement().
+    if (count > 0) {
+        auto const& last_vertex = m_vertex_list.last();
+        if (m_client_side_color_array_enabled)
+            m_current_vertex_color = last_vertex.color;
+        for (size_t t = 0; t < m_device_info.num_texture_units; ++t) {
+            if (m_client_side_texture_coord_array_enabled[t])
+                m_current_vertex_tex_coord[t] = last_vertex.tex_coords[t];
         }
+        if (m_client_side_normal_array_enabled)
+            m_current_vertex_normal = last_vertex.normal;
     }
+
     gl_end();
 }
 
+Span<GPU::Vertex const> GLContext::assemble_vertices_from_arrays(size_t first_index, size_t end_index)
+{
+    auto& assembled = m_assembled_vertex_arrays;
+
+    // Disabled arrays are recorded with a null pointer, so that enabling or disabling one invalidates the vertices.
+    Vector<AssembledVertexArrays::Attribute, 8> attributes;
+    bool is_cacheable = true;
+    auto add_attribute = [&](bool enabled, VertexAttribPointer const& pointer) {
+        if (!enabled) {
+            attributes.append({});
+            return;
+        }
+        if (!pointer.buffer)
+            is_cacheable = false;
+        attributes.append({ pointer, pointer.buffer ? pointer.buffer->generation() : 0 });
+    };
+    add_attribute(true, m_client_vertex_pointer);
+    add_attribute(m_client_side_color_array_enabled, m_client_color_pointer);
+    add_attribute(m_client_side_normal_array_enabled, m_client_normal_pointer);
+    for (size_t t = 0; t < m_client_tex_coord_pointer.size(); ++t)
+        add_attribute(m_client_side_texture_coord_array_enabled[t], m_client_tex_coord_pointer[t]);
+
+    auto const is_still_valid = is_cacheable && assembled.is_cacheable && assembled.attributes.span() == attributes.span();
+    if (is_still_valid && first_index >= assembled.first_index && end_index <= assembled.first_index + assembled.vertices.size())
+        return assembled.vertices.span().slice(first_index - assembled.first_index, end_index - first_index);
+
+    // Cached vertices are always assembled starting at the first one, so that they can be reused by any later draw call.
+    size_t convert_from = first_index;
+    if (is_still_valid) {
+        convert_from = assembled.first_index + assembled.vertices.size();
+    } else {
+        assembled.attributes.clear_with_capacity();
+        assembled.attributes.extend(attributes);
+        assembled.is_cacheable = is_cacheable;
+        assembled.first_index = is_cacheable ? 0 : first_index;
+        assembled.vertices.clear_with_capacity();
+        convert_from = assembled.first_index;
+    }
+    VERIFY(convert_from <= end_index);
+
+    assembled.vertices.resize(end_index - assembled.first_index);
+    auto vertex_at = [&](size_t index) -> GPU::Vertex& { return assembled.vertices[index - assembled.first_index]; };
+
+    read_vertex_attribute_range(m_client_vertex_pointer, convert_from, end_index, [&](size_t index, float const* values) {
+        vertex_at(index).position = { values[0], values[1], values[2], values[3] };
+    });
+    if (m_client_side_color_array_enabled) {
+        read_vertex_attribute_range(m_client_color_pointer, convert_from, end_index, [&](size_t index, float const* values) {
+            vertex_at(index).color = { values[0], values[1], values[2], values[3] };
+        });
+    }
+    if (m_client_side_normal_array_enabled) {
+        read_vertex_attribute_range(m_client_normal_pointer, convert_from, end_index, [&](size_t index, float const* values) {
+            vertex_at(index).normal = { values[0], values[1], values[2] };
+        });
+    }
+    for (size_t t = 0; t < m_client_tex_coord_pointer.size(); ++t) {
+        if (!m_client_side_texture_coord_array_enabled[t])
+            continue;
+        read_vertex_attribute_range(m_client_tex_coord_pointer[t], convert_from, end_index, [&](size_t index, float const* values) {
+            vertex_at(index).tex_coords[t] = { values[0], values[1], values[2], values[3] };
+        });
+    }
+
+    return assembled.vertices.span().slice(first_index - assembled.first_index, end_index - first_index);
+}
+
 void GLContext::gl_normal(GLfloat nx, GLfloat ny, GLfloat nz)
 {
     APPEND_TO_CALL_LIST_AND_RETURN_IF_NEEDED(gl_normal, nx, ny, nz);
@@ -263,7 +344,7 @@ void GLContext::gl_normal_pointer(GLenum type, GLsizei stride, void const* point
         size_t data_offset = reinterpret_cast<size_t>(pointer);
         data_pointer = m_array_buffer->offset_data(data_offset);
     }
-    m_client_normal_pointer = { .size = 3, .type = type, .normalize = true, .stride = stride, .pointer = data_pointer };
+    m_client_normal_pointer = { .size = 3, .type = type, .normalize = true, .stride = stride, .pointer = data_pointer, .buffer = m_array_buffer };
 }
 
 void GLContext::gl_tex_coord_pointer(GLint size, GLenum type, GLsizei stride, void const* pointer)
@@ -280,7 +361,7 @@ void GLContext::gl_tex_coord_pointer(GLint size, GLenum type, GLsizei stride, vo
         size_t data_offset = reinterpret_cast<size_t>(pointer);
         data_pointer = m_array_buffer->offset_data(data_offset);
     }
-    tex_coord_pointer = { .size = size, .type = type, .normalize = false, .stride = stride, .pointer = data_pointer };
+    tex_coord_pointer = { .size = size, .type = type, .normalize = false, .stride = stride, .pointer = data_pointer, .buffer = m_array_buffer };
 }
 
 void GLContext::gl_vertex(GLfloat x, GLfloat y, GLfloat z, GLfloat w)
@@ -310,7 +391,7 @@ void GLContext::gl_vertex_pointer(GLint size, GLenum type, GLsizei stride, void
         size_t data_offset = reinterpret_cast<size_t>(pointer);
         data_pointer = m_array_buffer->offset_data(data_offset);
     }
-    m_client_vertex_pointer = { .size = size, .type = type, .normalize = false, .stride = stride, .pointer = data_pointer };
+    m_client_vertex_pointer = { .size = size, .type = type, .normalize = false, .stride = stride, .pointer = data_pointer, .buffer = m_array_buffer };
 }
 
 }
@@ -54,6 +54,14 @@ bool TextDocument::set_text(StringView text, AllowCallback allow_callback)
         set_text({});
     });
 
+    // Big files have lots of lines, so make room for all of them at once.
+    size_t new_line_count = 1;
+    for (auto ch : text) {
+        if (ch == '\n')
+            ++new_line_count;
+    }
+    m_lines.ensure_capacity(new_line_count);
+
     size_t start_of_current_line = 0;
 
     auto add_line = [&](size_t current_position) -> bool {
@@ -193,8 +201,9 @@ bool TextDocumentLine::set_text(TextDocument& document, StringView text)
     if (!utf8_view.validate()) {
         return false;
     }
+    m_text.ensure_capacity(utf8_view.length());
     for (auto code_point : utf8_view)
-        m_text.append(code_point);
+        m_text.unchecked_append(code_point);
     document.update_views({});
     return true;
 }
@@ -2207,8 +2207,9 @@ void TextEditor::document_did_update_undo_stack()
 void TextEditor::document_did_set_text(AllowCallback allow_callback)
 {
     m_line_visual_data.clear();
+    m_line_visual_data.ensure_capacity(m_document->line_count());
     for (size_t i = 0; i < m_document->line_count(); ++i)
-        m_line_visual_data.append(make<LineVisualData>());
+        m_line_visual_data.unchecked_append(make<LineVisualData>());
     document_did_change(allow_callback);
 }
 
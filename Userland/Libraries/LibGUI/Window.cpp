@@ -24,6 +24,8 @@
 #include <LibGUI/Widget.h>
 #include <LibGUI/Window.h>
 #include <LibGfx/Bitmap.h>
+#include <LibGfx/DisjointRectSet.h>
+#include <LibGfx/Palette.h>
 #include <fcntl.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -459,9 +461,16 @@ void Window::handle_multi_paint_event(MultiPaintEvent& event)
         }
     }
 
+    // If the front store is gone, the back store can't be brought up to date anymore.
+    if (!m_back_store_stale_rects.is_empty() && !m_front_store)
+        created_new_backing_store = true;
+
     if (created_new_backing_store) {
+        m_back_store_stale_rects.clear();
         rects.clear();
         rects.append({ {}, event.window_size() });
+    } else if (m_double_buffering_enabled) {
+        update_stale_parts_of_back_store(rects);
     }
 
     for (auto& rect : rects) {
@@ -942,17 +951,39 @@ void Window::flip(Vector<Gfx::IntRect, 32> const& dirty_rects)
         m_back_store = create_backing_store(m_front_store->size()).release_value_but_fixme_should_propagate_errors();
         memcpy(m_back_store->bitmap().scanline(0), m_front_store->bitmap().scanline(0), m_front_store->bitmap().size_in_bytes());
         m_back_store->bitmap().set_volatile();
+        m_back_store_stale_rects.clear();
         return;
     }
 
-    // Copy whatever was painted from the front to the back.
-    Painter painter(m_back_store->bitmap());
-    for (auto& dirty_rect : dirty_rects)
-        painter.blit(dirty_rect.location(), m_front_store->bitmap(), dirty_rect, 1.0f, false);
+    // Whatever was painted into the front store has to be copied to the back store as well, but that is put off until
+    // right before the next paint. Windows that repaint all of their contents every time, like video players and games,
+    // then don't need any copying at all.
+    m_back_store_stale_rects = dirty_rects;
 
     m_back_store->bitmap().set_volatile();
 }
 
+void Window::update_stale_parts_of_back_store(Vector<Gfx::IntRect, 32> const& rects_to_paint)
+{
+    auto stale_rects = move(m_back_store_stale_rects);
+    if (stale_rects.is_empty())
+        return;
+
+    // If the main widget fills its background with an opaque color, anything that is about to be repainted will be
+    // completely overwritten.
+    Gfx::DisjointIntRectSet rects_to_overwrite;
+    if (m_main_widget->fill_with_background_color() && m_main_widget->palette().color(m_main_widget->background_role()).alpha() == 255) {
+        for (auto& rect : rects_to_paint)
+            rects_to_overwrite.add(rect.intersected(m_main_widget->window_relative_rect()));
+    }
+
+    Painter painter(m_back_store->bitmap());
+    for (auto& stale_rect : stale_rects) {
+        for (auto& rect : Gfx::DisjointIntRectSet(stale_rect).shatter(rects_to_overwrite).rects())
+            painter.blit(rect.location(), m_front_store->bitmap(), rect, 1.0f, false);
+    }
+}
+
 ErrorOr<NonnullOwnPtr<WindowBackingStore>> Window::create_backing_store(Gfx::IntSize size)
 {
     auto format = m_has_alpha_channel ? Gfx::BitmapFormat::BGRA8888 : Gfx::BitmapFormat::BGRx8888;
@@ -1188,6 +1219,8 @@ void Window::notify_state_changed(Badge<ConnectionToWindowServer>, bool minimize
         } else if (was_purged) {
             // The bitmap memory was purged by the kernel, but we have all-new zero-filled pages.
             // Schedule an update to regenerate the bitmap.
+            if (m_double_buffering_enabled)
+                m_back_store_stale_rects.clear();
             update();
         }
     }
@@ -268,6 +268,7 @@ private:
     Gfx::IntSize backing_store_size(Gfx::IntSize) const;
     void set_current_backing_store(WindowBackingStore&, bool flush_immediately = false) const;
     void flip(Vector<Gfx::IntRect, 32> const& dirty_rects);
+    void update_stale_parts_of_back_store(Vector<Gfx::IntRect, 32> const& rects_to_paint);
     void force_update();
 
     bool are_cursors_the_same(AK::Variant<Gfx::StandardCursor, NonnullRefPtr<Gfx::Bitmap const>> const&, AK::Variant<Gfx::StandardCursor, NonnullRefPtr<Gfx::Bitmap const>> const&) const;
@@ -276,6 +277,8 @@ private:
 
     OwnPtr<WindowBackingStore> m_front_store;
     OwnPtr<WindowBackingStore> m_back_store;
+    // Areas that were painted into the front store, but not yet copied into the back store.
+    Vector<Gfx::IntRect, 32> m_back_store_stale_rects;
 
     NonnullRefPtr<Menubar> m_menubar;
 
@@ -41,12 +41,25 @@ enum class FillPathMode {
     AllowFloatingPoints,
 };
 
-template<FillPathMode fill_path_mode, typename ColorFunction>
-void fill_path(Painter& painter, Path const& path, ColorFunction color_function, Gfx::Painter::WindingRule winding_rule, Optional<FloatPoint> offset = {})
+// ColorOrFunction is either a Color to fill the whole path with, or a function that gives the color at a point.
+template<FillPathMode fill_path_mode, typename ColorOrFunction>
+void fill_path(Painter& painter, Path const& path, ColorOrFunction color_or_function, Gfx::Painter::WindingRule winding_rule, Optional<FloatPoint> offset = {})
 {
     using GridCoordinateType = Conditional<fill_path_mode == FillPathMode::PlaceOnIntGrid, int, float>;
     using PointType = Point<GridCoordinateType>;
 
+    constexpr bool is_solid_color = IsSame<ColorOrFunction, Color>;
+    auto color_function = [&](IntPoint point) -> Color {
+        if constexpr (is_solid_color)
+            return color_or_function;
+        else
+            return color_or_function(point);
+    };
+
+    // NOTE: A run of pixels with the same color can be filled in one go, which blends many pixels at a time.
+    //       fill_rect() honors the draw op and the painter's scale, while set_pixel() doesn't, so it's only used when they don't matter.
+    bool const can_fill_spans = is_solid_color && painter.scale() == 1 && painter.draw_op() == Painter::DrawOp::Copy;
+
     auto draw_scanline = [&](int y, float x1, float x2) {
         const auto draw_offset = offset.value_or({ 0, 0 });
         const auto draw_origin = (path.bounding_box().top_left() + draw_offset).to_type<int>();
@@ -60,6 +73,15 @@ void fill_path(Painter& painter, Path const& path, ColorFunction color_function,
         auto set_pixel = [&](int x, int y, Color color) {
             painter.set_pixel(x, y, color, true);
         };
+        auto fill_span = [&](int from_x, int to_x) {
+            if (can_fill_spans) {
+                if (to_x > from_x)
+                    painter.fill_rect({ from_x, y, to_x - from_x, 1 }, color_function({}));
+                return;
+            }
+            for (int x = from_x; x < to_x; x++)
+                set_pixel(x, y, color_function(IntPoint(x, y) - draw_origin));
+        };
         if constexpr (fill_path_mode == FillPathMode::AllowFloatingPoints) {
             int int_x1 = ceilf(x1);
             int int_x2 = floorf(x2);
@@ -69,11 +91,9 @@ void fill_path(Painter& painter, Path const& path, ColorFunction color_function,
             auto right_color = color_function(IntPoint(int_x2, y) - draw_origin);
             set_pixel(int_x1 - 1, y, left_color.with_alpha(left_color.alpha() * left_subpixel));
             set_pixel(int_x2, y, right_color.with_alpha(right_color.alpha() * right_subpixel));
-            for (int x = int_x1; x < int_x2; x++)
-                set_pixel(x, y, color_function(IntPoint(x, y) - draw_origin));
+            fill_span(int_x1, int_x2);
         } else {
-            for (int x = x1; x < int(x2); x++)
-                set_pixel(x, y, color_function(IntPoint(x, y) - draw_origin));
+            fill_span(x1, x2);
         }
     };
 
@@ -192,13 +212,9 @@ void fill_path(Painter& painter, Path const& path, ColorFunction color_function,
 
         --scanline;
         // remove any edge that goes out of bound from the active list
-        for (size_t i = 0, count = active_list.size(); i < count; ++i) {
-            if (scanline <= active_list[i].minimum_y) {
-                active_list.remove(i);
-                --count;
-                --i;
-            }
-        }
+        active_list.remove_all_matching([&](auto const& segment) {
+            return scanline <= segment.minimum_y;
+        });
         for (size_t j = last_active_segment; j < segments.size(); ++j, ++last_active_segment) {
             auto& segment = segments[j];
             if (segment.maximum_y < scanline)
@@ -25,24 +25,46 @@ public:
     }
 
     virtual void apply(Bitmap& target_bitmap, IntRect const& target_rect, Bitmap const& source_bitmap, IntRect const& source_rect) override
+    {
+        ColorFilter* filter = this;
+        apply_chain(target_bitmap, target_rect, source_bitmap, source_rect, { &filter, 1 });
+    }
+
+    // Applies each of the filters in turn, but with only a single pass over the pixels.
+    static void apply_chain(Bitmap& target_bitmap, IntRect const& target_rect, Bitmap const& source_bitmap, IntRect const& source_rect, ReadonlySpan<ColorFilter*> filters)
     {
         VERIFY(source_rect.size() == target_rect.size());
         VERIFY(target_bitmap.rect().contains(target_rect));
         VERIFY(source_bitmap.rect().contains(source_rect));
 
-        for (auto y = 0; y < source_rect.height(); ++y) {
-            ssize_t source_y = y + source_rect.y();
-            ssize_t target_y = y + target_rect.y();
-            for (auto x = 0; x < source_rect.width(); ++x) {
-                ssize_t source_x = x + source_rect.x();
-                ssize_t target_x = x + target_rect.x();
-
-                auto source_pixel = source_bitmap.get_pixel(source_x, source_y);
-                auto target_color = convert_color(source_pixel);
+        Function<void(int, int)> apply_to_rows = [&](int first_row, int end_row) {
+            for (auto y = first_row; y < end_row; ++y) {
+                ssize_t source_y = y + source_rect.y();
+                ssize_t target_y = y + target_rect.y();
+                for (auto x = 0; x < source_rect.width(); ++x) {
+                    ssize_t source_x = x + source_rect.x();
+                    ssize_t target_x = x + target_rect.x();
 
-                target_bitmap.set_pixel(target_x, target_y, m_amount < 1.0f && !amount_handled_in_filter() ? source_pixel.mixed_with(target_color, m_amount) : target_color);
+                    auto color = source_bitmap.get_pixel(source_x, source_y);
+                    for (auto* filter : filters)
+                        color = filter->filter_color(color);
+                    target_bitmap.set_pixel(target_x, target_y, color);
+                }
             }
+        };
+
+        // Rows can only be handed to different threads if none of them reads pixels that another one writes.
+        if (&target_bitmap == &source_bitmap && target_rect != source_rect) {
+            apply_to_rows(0, source_rect.height());
+            return;
         }
+        for_each_line_range_in_parallel(source_rect.height(), apply_to_rows);
+    }
+
+    Color filter_color(Color color)
+    {
+        auto target_color = convert_color(color);
+        return m_amount < 1.0f && !amount_handled_in_filter() ? color.mixed_with(target_color, m_amount) : target_color;
     }
 
 protected:
@@ -11,6 +11,7 @@
 #include <AK/Function.h>
 #include <AK/Vector.h>
 #include <LibGfx/Filters/FastBoxBlurFilter.h>
+#include <LibGfx/Filters/Filter.h>
 
 namespace Gfx {
 
@@ -46,90 +47,95 @@ static void do_single_pass(int width, int height, size_t radius_x, size_t radius
     Vector<Color, 1024> intermediate;
     intermediate.resize(width * height);
 
+    // Both passes handle every row (or column) independently, so they can be spread across threads.
     // First pass: vertical
-    for (int y = 0; y < height; ++y) {
-        size_t sum_red = 0;
-        size_t sum_green = 0;
-        size_t sum_blue = 0;
-        size_t sum_alpha = 0;
-
-        // Setup sliding window
-        for (int i = -(int)radius_x; i <= (int)radius_x; ++i) {
-            auto color_at_px = get_pixel_function(clamp(i, 0, width - 1), y);
-            sum_red += red_value(color_at_px);
-            sum_green += green_value(color_at_px);
-            sum_blue += blue_value(color_at_px);
-            sum_alpha += color_at_px.alpha();
+    for_each_line_range_in_parallel(height, [&](int first_row, int end_row) {
+        for (int y = first_row; y < end_row; ++y) {
+            size_t sum_red = 0;
+            size_t sum_green = 0;
+            size_t sum_blue = 0;
+            size_t sum_alpha = 0;
+
+            // Setup sliding window
+            for (int i = -(int)radius_x; i <= (int)radius_x; ++i) {
+                auto color_at_px = get_pixel_function(clamp(i, 0, width - 1), y);
+                sum_red += red_value(color_at_px);
+                sum_green += green_value(color_at_px);
+                sum_blue += blue_value(color_at_px);
+                sum_alpha += color_at_px.alpha();
+            }
+            // Slide horizontally
+            for (int x = 0; x < width; ++x) {
+                auto const index = y * width + x;
+                auto& current_intermediate = intermediate[index];
+                current_intermediate.set_red(sum_red / div_x);
+                current_intermediate.set_green(sum_green / div_x);
+                current_intermediate.set_blue(sum_blue / div_x);
+                current_intermediate.set_alpha(sum_alpha / div_x);
+
+                auto leftmost_x_coord = max(x - (int)radius_x, 0);
+                auto rightmost_x_coord = min(x + (int)radius_x + 1, width - 1);
+
+                auto leftmost_x_color = get_pixel_function(leftmost_x_coord, y);
+                auto rightmost_x_color = get_pixel_function(rightmost_x_coord, y);
+
+                sum_red -= red_value(leftmost_x_color);
+                sum_red += red_value(rightmost_x_color);
+                sum_green -= green_value(leftmost_x_color);
+                sum_green += green_value(rightmost_x_color);
+                sum_blue -= blue_value(leftmost_x_color);
+                sum_blue += blue_value(rightmost_x_color);
+                sum_alpha -= leftmost_x_color.alpha();
+                sum_alpha += rightmost_x_color.alpha();
+            }
         }
-        // Slide horizontally
-        for (int x = 0; x < width; ++x) {
-            auto const index = y * width + x;
-            auto& current_intermediate = intermediate[index];
-            current_intermediate.set_red(sum_red / div_x);
-            current_intermediate.set_green(sum_green / div_x);
-            current_intermediate.set_blue(sum_blue / div_x);
-            current_intermediate.set_alpha(sum_alpha / div_x);
-
-            auto leftmost_x_coord = max(x - (int)radius_x, 0);
-            auto rightmost_x_coord = min(x + (int)radius_x + 1, width - 1);
-
-            auto leftmost_x_color = get_pixel_function(leftmost_x_coord, y);
-            auto rightmost_x_color = get_pixel_function(rightmost_x_coord, y);
-
-            sum_red -= red_value(leftmost_x_color);
-            sum_red += red_value(rightmost_x_color);
-            sum_green -= green_value(leftmost_x_color);
-            sum_green += green_value(rightmost_x_color);
-            sum_blue -= blue_value(leftmost_x_color);
-            sum_blue += blue_value(rightmost_x_color);
-            sum_alpha -= leftmost_x_color.alpha();
-            sum_alpha += rightmost_x_color.alpha();
-        }
-    }
+    });
 
     // Second pass: horizontal
-    for (int x = 0; x < width; ++x) {
-        size_t sum_red = 0;
-        size_t sum_green = 0;
-        size_t sum_blue = 0;
-        size_t sum_alpha = 0;
-
-        // Setup sliding window
-        for (int i = -(int)radius_y; i <= (int)radius_y; ++i) {
-            int offset = clamp(i, 0, height - 1) * width + x;
-            auto& current_intermediate = intermediate[offset];
-            sum_red += current_intermediate.red();
-            sum_green += current_intermediate.green();
-            sum_blue += current_intermediate.blue();
-            sum_alpha += current_intermediate.alpha();
+    for_each_line_range_in_parallel(width, [&](int first_column, int end_column) {
+        for (int x = first_column; x < end_column; ++x) {
+            size_t sum_red = 0;
+            size_t sum_green = 0;
+            size_t sum_blue = 0;
+            size_t sum_alpha = 0;
+
+            // Setup sliding window
+            for (int i = -(int)radius_y; i <= (int)radius_y; ++i) {
+                int offset = clamp(i, 0, height - 1) * width + x;
+                auto& current_intermediate = intermediate[offset];
+                sum_red += current_intermediate.red();
+                sum_green += current_intermediate.green();
+                sum_blue += current_intermediate.blue();
+                sum_alpha += current_intermediate.alpha();
+            }
+
+            for (int y = 0; y < height; ++y) {
+                auto color = Color(
+                    sum_red / div_y,
+                    sum_green / div_y,
+                    sum_blue / div_y,
+                    sum_alpha / div_y);
+
+                set_pixel_function(x, y, color);
+
+                auto const bottommost_y_coord = min(y + (int)radius_y + 1, height - 1);
+                auto const bottom_index = x + bottommost_y_coord * width;
+                auto& bottom_intermediate = intermediate[bottom_index];
+                sum_red += bottom_intermediate.red();
+                sum_green += bottom_intermediate.green();
+                sum_blue += bottom_intermediate.blue();
+                sum_alpha += bottom_intermediate.alpha();
+
+                auto const topmost_y_coord = max(y - (int)radius_y, 0);
+                auto const top_index = x + topmost_y_coord * width;
+                auto& top_intermediate = intermediate[top_index];
+                sum_red -= top_intermediate.red();
+                sum_green -= top_intermediate.green();
+                sum_blue -= top_intermediate.blue();
+                sum_alpha -= top_intermediate.alpha();
+            }
         }
-
-        for (int y = 0; y < height; ++y) {
-            auto color = Color(
-                sum_red / div_y,
-                sum_green / div_y,
-                sum_blue / div_y,
-                sum_alpha / div_y);
-
-            set_pixel_function(x, y, color);
-
-            auto const bottommost_y_coord = min(y + (int)radius_y + 1, height - 1);
-            auto const bottom_index = x + bottommost_y_coord * width;
-            auto& bottom_intermediate = intermediate[bottom_index];
-            sum_red += bottom_intermediate.red();
-            sum_green += bottom_intermediate.green();
-            sum_blue += bottom_intermediate.blue();
-            sum_alpha += bottom_intermediate.alpha();
-
-            auto const topmost_y_coord = max(y - (int)radius_y, 0);
-            auto const top_index = x + topmost_y_coord * width;
-            auto& top_intermediate = intermediate[top_index];
-            sum_red -= top_intermediate.red();
-            sum_green -= top_intermediate.green();
-            sum_blue -= top_intermediate.blue();
-            sum_alpha -= top_intermediate.alpha();
-        }
-    }
+    });
 }
 
 // Based on the super fast blur algorithm by Quasimondo, explored here: https://stackoverflow.com/questions/21418892/understanding-super-fast-blur-algorithm
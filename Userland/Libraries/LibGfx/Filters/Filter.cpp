@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/Filters/Filter.h>
+#include <LibThreading/ThreadPool.h>
+
+namespace Gfx {
+
+void for_each_line_range_in_parallel(int line_count, Function<void(int first_line, int end_line)> const& callback)
+{
+    // Handing a few lines to another thread costs more than just processing them here.
+    static constexpr int minimum_lines_per_task = 16;
+    // A few tasks per worker, so that the work still balances out if some lines take longer than others.
+    static constexpr size_t tasks_per_worker = 4;
+
+    auto& thread_pool = Threading::ThreadPool::the();
+    auto task_count = min(line_count / minimum_lines_per_task, static_cast<int>(thread_pool.worker_count() * tasks_per_worker));
+    if (task_count <= 1) {
+        if (line_count > 0)
+            callback(0, line_count);
+        return;
+    }
+
+    thread_pool.parallel_for(task_count, [&](size_t task) {
+        auto first_line = static_cast<int>(static_cast<i64>(line_count) * task / task_count);
+        auto end_line = static_cast<int>(static_cast<i64>(line_count) * (task + 1) / task_count);
+        callback(first_line, end_line);
+    });
+}
+
+}
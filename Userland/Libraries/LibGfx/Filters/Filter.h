@@ -6,12 +6,17 @@
 
 #pragma once
 
+#include <AK/Function.h>
 #include <AK/StringView.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/Rect.h>
 
 namespace Gfx {
 
+// Splits [0, line_count) into ranges of consecutive rows (or columns) and calls `callback(first_line, end_line)` for each
+// of them on the shared thread pool. Returns once all of the lines have been processed.
+void for_each_line_range_in_parallel(int line_count, Function<void(int first_line, int end_line)> const& callback);
+
 class Filter {
 public:
     class Parameters {
@@ -103,40 +103,43 @@ public:
 
         // FIXME: Help! I am naive!
         constexpr static ssize_t offset = N / 2;
-        for (auto i_ = 0; i_ < target_rect.width(); ++i_) {
-            ssize_t i = i_ + target_rect.x();
-            for (auto j_ = 0; j_ < target_rect.height(); ++j_) {
-                ssize_t j = j_ + target_rect.y();
-                FloatVector3 value(0, 0, 0);
-                for (auto k = 0l; k < (ssize_t)N; ++k) {
-                    auto ki = i + k - offset;
-                    if (ki < source_rect.x() || ki > source_rect.right()) {
-                        if (parameters.should_wrap())
-                            ki = (ki + source.size().width()) % source.size().width(); // TODO: fix up using source_rect
-                        else
-                            continue;
-                    }
-
-                    for (auto l = 0l; l < (ssize_t)N; ++l) {
-                        auto lj = j + l - offset;
-                        if (lj < source_rect.y() || lj > source_rect.bottom()) {
+        // Every column of the result only depends on the source, so the columns can be computed on multiple threads.
+        for_each_line_range_in_parallel(target_rect.width(), [&](int first_column, int end_column) {
+            for (auto i_ = first_column; i_ < end_column; ++i_) {
+                ssize_t i = i_ + target_rect.x();
+                for (auto j_ = 0; j_ < target_rect.height(); ++j_) {
+                    ssize_t j = j_ + target_rect.y();
+                    FloatVector3 value(0, 0, 0);
+                    for (auto k = 0l; k < (ssize_t)N; ++k) {
+                        auto ki = i + k - offset;
+                        if (ki < source_rect.x() || ki > source_rect.right()) {
                             if (parameters.should_wrap())
-                                lj = (lj + source.size().height()) % source.size().height(); // TODO: fix up using source_rect
+                                ki = (ki + source.size().width()) % source.size().width(); // TODO: fix up using source_rect
                             else
                                 continue;
                         }
 
-                        auto pixel = source.get_pixel(ki, lj);
-                        FloatVector3 pixel_value(pixel.red(), pixel.green(), pixel.blue());
+                        for (auto l = 0l; l < (ssize_t)N; ++l) {
+                            auto lj = j + l - offset;
+                            if (lj < source_rect.y() || lj > source_rect.bottom()) {
+                                if (parameters.should_wrap())
+                                    lj = (lj + source.size().height()) % source.size().height(); // TODO: fix up using source_rect
+                                else
+                                    continue;
+                            }
+
+                            auto pixel = source.get_pixel(ki, lj);
+                            FloatVector3 pixel_value(pixel.red(), pixel.green(), pixel.blue());
 
-                        value = value + pixel_value * parameters.kernel().elements()[k][l];
+                            value = value + pixel_value * parameters.kernel().elements()[k][l];
+                        }
                     }
-                }
 
-                value.clamp(0, 255);
-                render_target_bitmap->set_pixel(i, j, Color(value.x(), value.y(), value.z(), source.get_pixel(i + source_delta_x, j + source_delta_y).alpha()));
+                    value.clamp(0, 255);
+                    render_target_bitmap->set_pixel(i, j, Color(value.x(), value.y(), value.z(), source.get_pixel(i + source_delta_x, j + source_delta_y).alpha()));
+                }
             }
-        }
+        });
 
         if (render_target_bitmap != &target) {
             // FIXME: Substitute for some sort of faster "blit" method.
@@ -12,7 +12,9 @@
 #include <AK/Array.h>
 #include <AK/IntegralMath.h>
 #include <AK/Math.h>
-#include <AK/Vector.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
+#include <LibGfx/Filters/Filter.h>
 #include <LibGfx/Filters/StackBlurFilter.h>
 
 namespace Gfx {
@@ -39,61 +41,76 @@ constexpr auto mult_table = [] {
     return lut;
 }();
 
-// Note: This is named to be consistent with the algorithm, but it's actually a simple circular buffer.
-struct BlurStack {
-    BlurStack(size_t size)
-    {
-        m_data.resize(size);
-    }
-
-    struct Iterator {
-        friend BlurStack;
+using AK::SIMD::u32x4;
+using AK::SIMD::u8x4;
 
-        ALWAYS_INLINE Color& operator*()
-        {
-            return m_data.at(m_idx);
-        }
-
-        ALWAYS_INLINE Color* operator->()
-        {
-            return &m_data.at(m_idx);
-        }
+ALWAYS_INLINE static u32x4 load_pixel(ARGB32 pixel, ARGB32 fill_pixel)
+{
+    if ((pixel >> 24) == 0)
+        pixel = fill_pixel;
+    // The lanes end up in memory order, i.e. blue, green, red, alpha.
+    return AK::SIMD::to_u32x4(bit_cast<u8x4>(pixel));
+}
 
-        ALWAYS_INLINE Iterator operator++()
-        {
-            // Note: This seemed to profile slightly better than %
-            if (++m_idx >= m_data.size())
-                m_idx = 0;
-            return *this;
-        }
+// Blurs a single row or column of `length` pixels, which are `stride` pixels apart.
+// All four channels are summed up at once, one per lane.
+static void blur_line(ARGB32* pixels, size_t stride, uint length, uint radius, ARGB32 fill_pixel)
+{
+    uint const div = 2 * radius + 1;
+    uint const radius_plus_1 = radius + 1;
+    uint const sum_factor = radius_plus_1 * (radius_plus_1 + 1) / 2;
+    uint const sum_mult = mult_table[radius - 1];
+    uint const sum_shift = shift_table[radius - 1];
+
+    auto pixel_at = [&](uint i) {
+        return load_pixel(pixels[min(i, length - 1) * stride], fill_pixel);
+    };
 
-        ALWAYS_INLINE Iterator operator++(int)
-        {
-            auto prev_it = *this;
-            ++*(this);
-            return prev_it;
-        }
+    // Note: This is named to be consistent with the algorithm, but it's actually a simple circular buffer.
+    Array<u32x4, 2 * MAX_RADIUS + 1> stack;
 
-    private:
-        Iterator(size_t idx, Span<Color> data)
-            : m_idx(idx)
-            , m_data(data)
-        {
-        }
+    auto color = pixel_at(0);
+    for (uint i = 0; i < radius_plus_1; i++)
+        stack[i] = color;
 
-        size_t m_idx;
-        Span<Color> m_data;
-    };
+    // All the sums here work to approximate a gaussian.
+    // Note: Only about 17 bits are actually used in each sum.
+    u32x4 in_sum {};
+    u32x4 out_sum = color * radius_plus_1;
+    u32x4 sum = color * sum_factor;
 
-    Iterator iterator_from_position(size_t position)
-    {
-        VERIFY(position < m_data.size());
-        return Iterator(position, m_data);
+    for (uint i = 1; i <= radius; i++) {
+        auto color = pixel_at(i);
+        stack[radius + i] = color;
+        sum += color * (radius_plus_1 - i);
+        in_sum += color;
     }
 
-private:
-    Vector<Color, 512> m_data;
-};
+    uint stack_in = 0;
+    uint stack_out = radius_plus_1;
+
+    for (uint i = 0; i < length; i++) {
+        auto result = (sum * sum_mult) >> sum_shift;
+        pixels[i * stride] = result[3] != 0 ? bit_cast<ARGB32>(AK::SIMD::to_u8x4(result)) : fill_pixel;
+
+        sum -= out_sum;
+        out_sum -= stack[stack_in];
+
+        auto color = pixel_at(i + radius_plus_1);
+        stack[stack_in] = color;
+        in_sum += color;
+        sum += in_sum;
+        // Note: This seemed to profile slightly better than %
+        if (++stack_in >= div)
+            stack_in = 0;
+
+        color = stack[stack_out];
+        out_sum += color;
+        in_sum -= color;
+        if (++stack_out >= div)
+            stack_out = 0;
+    }
+}
 
 // This is an implementation of StackBlur by Mario Klingemann (https://observablehq.com/@jobleonard/mario-klingemans-stackblur)
 // (Link is to a secondary source as the original site is now down)
@@ -104,209 +121,22 @@ FLATTEN void StackBlurFilter::process_rgba(u8 radius, Color fill_color)
     if (radius == 0)
         return;
 
-    fill_color = fill_color.with_alpha(0);
-
-    uint width = m_bitmap.width();
-    uint height = m_bitmap.height();
-
-    uint div = 2 * radius + 1;
-    uint radius_plus_1 = radius + 1;
-    uint sum_factor = radius_plus_1 * (radius_plus_1 + 1) / 2;
-
-    auto get_pixel = [&](int x, int y) {
-        auto color = m_bitmap.get_pixel<StorageFormat::BGRA8888>(x, y);
-        if (color.alpha() == 0)
-            return fill_color;
-        return color;
-    };
-
-    auto set_pixel = [&](int x, int y, Color color) {
-        return m_bitmap.set_pixel<StorageFormat::BGRA8888>(x, y, color);
-    };
-
-    BlurStack blur_stack { div };
-    auto const stack_start = blur_stack.iterator_from_position(0);
-    auto const stack_end = blur_stack.iterator_from_position(radius_plus_1);
-    auto stack_iterator = stack_start;
-
-    auto const sum_mult = mult_table[radius - 1];
-    auto const sum_shift = shift_table[radius - 1];
-
-    for (uint y = 0; y < height; y++) {
-        stack_iterator = stack_start;
-
-        auto color = get_pixel(0, y);
-        for (uint i = 0; i < radius_plus_1; i++)
-            *(stack_iterator++) = color;
-
-        // All the sums here work to approximate a gaussian.
-        // Note: Only about 17 bits are actually used in each sum.
-        uint red_in_sum = 0;
-        uint green_in_sum = 0;
-        uint blue_in_sum = 0;
-        uint alpha_in_sum = 0;
-        uint red_out_sum = radius_plus_1 * color.red();
-        uint green_out_sum = radius_plus_1 * color.green();
-        uint blue_out_sum = radius_plus_1 * color.blue();
-        uint alpha_out_sum = radius_plus_1 * color.alpha();
-        uint red_sum = sum_factor * color.red();
-        uint green_sum = sum_factor * color.green();
-        uint blue_sum = sum_factor * color.blue();
-        uint alpha_sum = sum_factor * color.alpha();
-
-        for (uint i = 1; i <= radius; i++) {
-            auto color = get_pixel(min(i, width - 1), y);
-
-            auto bias = radius_plus_1 - i;
-            *stack_iterator = color;
-            red_sum += color.red() * bias;
-            green_sum += color.green() * bias;
-            blue_sum += color.blue() * bias;
-            alpha_sum += color.alpha() * bias;
-
-            red_in_sum += color.red();
-            green_in_sum += color.green();
-            blue_in_sum += color.blue();
-            alpha_in_sum += color.alpha();
-
-            ++stack_iterator;
-        }
-
-        auto stack_in_iterator = stack_start;
-        auto stack_out_iterator = stack_end;
-
-        for (uint x = 0; x < width; x++) {
-            auto alpha = (alpha_sum * sum_mult) >> sum_shift;
-            if (alpha != 0)
-                set_pixel(x, y, Color((red_sum * sum_mult) >> sum_shift, (green_sum * sum_mult) >> sum_shift, (blue_sum * sum_mult) >> sum_shift, alpha));
-            else
-                set_pixel(x, y, fill_color);
-
-            red_sum -= red_out_sum;
-            green_sum -= green_out_sum;
-            blue_sum -= blue_out_sum;
-            alpha_sum -= alpha_out_sum;
-
-            red_out_sum -= stack_in_iterator->red();
-            green_out_sum -= stack_in_iterator->green();
-            blue_out_sum -= stack_in_iterator->blue();
-            alpha_out_sum -= stack_in_iterator->alpha();
-
-            auto color = get_pixel(min(x + radius_plus_1, width - 1), y);
-            *stack_in_iterator = color;
-            red_in_sum += color.red();
-            green_in_sum += color.green();
-            blue_in_sum += color.blue();
-            alpha_in_sum += color.alpha();
-
-            red_sum += red_in_sum;
-            green_sum += green_in_sum;
-            blue_sum += blue_in_sum;
-            alpha_sum += alpha_in_sum;
-
-            ++stack_in_iterator;
-
-            color = *stack_out_iterator;
-            red_out_sum += color.red();
-            green_out_sum += color.green();
-            blue_out_sum += color.blue();
-            alpha_out_sum += color.alpha();
-
-            red_in_sum -= color.red();
-            green_in_sum -= color.green();
-            blue_in_sum -= color.blue();
-            alpha_in_sum -= color.alpha();
-
-            ++stack_out_iterator;
-        }
-    }
-
-    for (uint x = 0; x < width; x++) {
-        stack_iterator = stack_start;
-
-        auto color = get_pixel(x, 0);
-        for (uint i = 0; i < radius_plus_1; i++)
-            *(stack_iterator++) = color;
-
-        uint red_in_sum = 0;
-        uint green_in_sum = 0;
-        uint blue_in_sum = 0;
-        uint alpha_in_sum = 0;
-        uint red_out_sum = radius_plus_1 * color.red();
-        uint green_out_sum = radius_plus_1 * color.green();
-        uint blue_out_sum = radius_plus_1 * color.blue();
-        uint alpha_out_sum = radius_plus_1 * color.alpha();
-        uint red_sum = sum_factor * color.red();
-        uint green_sum = sum_factor * color.green();
-        uint blue_sum = sum_factor * color.blue();
-        uint alpha_sum = sum_factor * color.alpha();
-
-        for (uint i = 1; i <= radius; i++) {
-            auto color = get_pixel(x, min(i, height - 1));
-
-            auto bias = radius_plus_1 - i;
-            *stack_iterator = color;
-            red_sum += color.red() * bias;
-            green_sum += color.green() * bias;
-            blue_sum += color.blue() * bias;
-            alpha_sum += color.alpha() * bias;
-
-            red_in_sum += color.red();
-            green_in_sum += color.green();
-            blue_in_sum += color.blue();
-            alpha_in_sum += color.alpha();
-
-            ++stack_iterator;
-        }
-
-        auto stack_in_iterator = stack_start;
-        auto stack_out_iterator = stack_end;
-
-        for (uint y = 0; y < height; y++) {
-            auto alpha = (alpha_sum * sum_mult) >> sum_shift;
-            if (alpha != 0)
-                set_pixel(x, y, Color((red_sum * sum_mult) >> sum_shift, (green_sum * sum_mult) >> sum_shift, (blue_sum * sum_mult) >> sum_shift, alpha));
-            else
-                set_pixel(x, y, fill_color);
-
-            red_sum -= red_out_sum;
-            green_sum -= green_out_sum;
-            blue_sum -= blue_out_sum;
-            alpha_sum -= alpha_out_sum;
-
-            red_out_sum -= stack_in_iterator->red();
-            green_out_sum -= stack_in_iterator->green();
-            blue_out_sum -= stack_in_iterator->blue();
-            alpha_out_sum -= stack_in_iterator->alpha();
-
-            auto color = get_pixel(x, min(y + radius_plus_1, height - 1));
-            *stack_in_iterator = color;
-            red_in_sum += color.red();
-            green_in_sum += color.green();
-            blue_in_sum += color.blue();
-            alpha_in_sum += color.alpha();
-
-            red_sum += red_in_sum;
-            green_sum += green_in_sum;
-            blue_sum += blue_in_sum;
-            alpha_sum += alpha_in_sum;
-
-            ++stack_in_iterator;
-
-            color = *stack_out_iterator;
-            red_out_sum += color.red();
-            green_out_sum += color.green();
-            blue_out_sum += color.blue();
-            alpha_out_sum += color.alpha();
-
-            red_in_sum -= color.red();
-            green_in_sum -= color.green();
-            blue_in_sum -= color.blue();
-            alpha_in_sum -= color.alpha();
-
-            ++stack_out_iterator;
-        }
-    }
+    auto const fill_pixel = fill_color.with_alpha(0).value();
+    auto const width = static_cast<uint>(m_bitmap.width());
+    auto const height = static_cast<uint>(m_bitmap.height());
+    auto const pitch_in_pixels = m_bitmap.pitch() / sizeof(ARGB32);
+    auto* const pixels = m_bitmap.scanline(0);
+
+    // Every row (and then every column) is blurred independently, so they can be spread across threads.
+    for_each_line_range_in_parallel(height, [&](int first_row, int end_row) {
+        for (int y = first_row; y < end_row; y++)
+            blur_line(pixels + y * pitch_in_pixels, 1, width, radius, fill_pixel);
+    });
+
+    for_each_line_range_in_parallel(width, [&](int first_column, int end_column) {
+        for (int x = first_column; x < end_column; x++)
+            blur_line(pixels + x, pitch_in_pixels, height, radius, fill_pixel);
+    });
 }
 
 }
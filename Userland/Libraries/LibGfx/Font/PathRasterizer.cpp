@@ -12,9 +12,6 @@ PathRasterizer::PathRasterizer(Gfx::IntSize size)
     : m_size(size)
 {
     m_data.resize(m_size.width() * m_size.height());
-    for (int i = 0; i < m_size.width() * m_size.height(); i++) {
-        m_data[i] = 0.0f;
-    }
 }
 
 void PathRasterizer::draw_path(Gfx::Path& path)
@@ -31,9 +28,11 @@ RefPtr<Gfx::Bitmap> PathRasterizer::accumulate()
     auto bitmap = bitmap_or_error.release_value_but_fixme_should_propagate_errors();
     Color base_color = Color::from_rgb(0xffffff);
     for (int y = 0; y < m_size.height(); y++) {
+        auto* scanline = bitmap->scanline(y);
+        auto const* coverage = m_data.data() + y * m_size.width();
         float accumulator = 0.0;
         for (int x = 0; x < m_size.width(); x++) {
-            accumulator += m_data[y * m_size.width() + x];
+            accumulator += coverage[x];
             float value = accumulator;
             if (value < 0.0f) {
                 value = -value;
@@ -42,7 +41,7 @@ RefPtr<Gfx::Bitmap> PathRasterizer::accumulate()
                 value = 1.0;
             }
             u8 alpha = value * 255.0f;
-            bitmap->set_pixel(x, y, base_color.with_alpha(alpha));
+            scanline[x] = base_color.with_alpha(alpha).value();
         }
     }
     return bitmap;
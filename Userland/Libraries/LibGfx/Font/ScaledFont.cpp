@@ -66,6 +66,17 @@ ALWAYS_INLINE float ScaledFont::unicode_view_width(T const& view) const
     return longest_width;
 }
 
+ScaledGlyphMetrics ScaledFont::glyph_metrics(u32 glyph_id) const
+{
+    // NOTE: Looking up the metrics means parsing the glyph's outline header, which adds up when it's done for every glyph of every text run.
+    if (auto it = m_cached_glyph_metrics.find(glyph_id); it != m_cached_glyph_metrics.end())
+        return it->value;
+
+    auto metrics = m_font->glyph_metrics(glyph_id, m_x_scale, m_y_scale);
+    m_cached_glyph_metrics.set(glyph_id, metrics);
+    return metrics;
+}
+
 RefPtr<Gfx::Bitmap> ScaledFont::rasterize_glyph(u32 glyph_id, GlyphSubpixelOffset subpixel_offset) const
 {
     GlyphIndexWithSubpixelOffset index { glyph_id, subpixel_offset };
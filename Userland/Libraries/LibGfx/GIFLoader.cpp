@@ -82,8 +82,21 @@ struct GIFLoadingContext {
     RefPtr<Gfx::Bitmap> frame_buffer;
     size_t current_frame { 0 };
     RefPtr<Gfx::Bitmap> prev_frame_buffer;
+
+    // Copies of the decoder state after some of the frames, so that going back in a long animation doesn't mean
+    // starting over from the first frame. As these are full-size bitmaps, only a few of them are kept around.
+    struct Snapshot {
+        size_t frame_index { 0 };
+        NonnullRefPtr<Gfx::Bitmap> frame_buffer;
+        // Only needed if the frame's disposal method is RestorePrevious.
+        RefPtr<Gfx::Bitmap> prev_frame_buffer;
+    };
+    Vector<Snapshot> snapshots;
 };
 
+static constexpr size_t frames_between_snapshots = 16;
+static constexpr size_t maximum_snapshot_bytes = 16 * MiB;
+
 enum class GIFFormat {
     GIF87a,
     GIF89a,
@@ -261,6 +274,59 @@ static void clear_rect(Bitmap& bitmap, IntRect const& rect, Color color)
     }
 }
 
+// Whether a frame looks the same no matter what came before it, which makes it a good place to start decoding from.
+static bool is_key_frame(GIFLoadingContext const& context, size_t frame_index)
+{
+    if (frame_index == 0)
+        return true;
+
+    auto const& image = context.images.at(frame_index);
+    // Restoring to the previous contents later on would need the frames before this one.
+    if (image.disposal_method == GIFImageDescriptor::DisposalMethod::RestorePrevious)
+        return false;
+
+    // Nor must the previous frame be restored to what came before it.
+    auto const& previous_image = context.images.at(frame_index - 1);
+    if (previous_image.disposal_method == GIFImageDescriptor::DisposalMethod::RestorePrevious)
+        return false;
+
+    IntRect screen_rect { 0, 0, context.logical_screen.width, context.logical_screen.height };
+    if (!image.transparent && image.rect().contains(screen_rect))
+        return true;
+    return previous_image.disposal_method == GIFImageDescriptor::DisposalMethod::RestoreBackground && previous_image.rect().contains(screen_rect);
+}
+
+static void take_snapshot(GIFLoadingContext& context)
+{
+    auto const frame_index = context.current_frame;
+    if (frame_index % frames_between_snapshots != 0 || is_key_frame(context, frame_index))
+        return;
+    if (any_of(context.snapshots, [&](auto const& snapshot) { return snapshot.frame_index == frame_index; }))
+        return;
+
+    bool const needs_prev_frame_buffer = context.images.at(frame_index).disposal_method == GIFImageDescriptor::DisposalMethod::RestorePrevious;
+    auto const snapshot_bytes = context.frame_buffer->size_in_bytes() * (needs_prev_frame_buffer ? 2 : 1);
+    auto const maximum_snapshot_count = maximum_snapshot_bytes / snapshot_bytes;
+    if (maximum_snapshot_count == 0)
+        return;
+
+    // Failing to take a snapshot only makes seeking slower, so errors are ignored.
+    auto frame_buffer = context.frame_buffer->clone();
+    if (frame_buffer.is_error())
+        return;
+    RefPtr<Gfx::Bitmap> prev_frame_buffer;
+    if (needs_prev_frame_buffer) {
+        auto prev_frame_buffer_or_error = context.prev_frame_buffer->clone();
+        if (prev_frame_buffer_or_error.is_error())
+            return;
+        prev_frame_buffer = prev_frame_buffer_or_error.release_value();
+    }
+
+    while (context.snapshots.size() >= maximum_snapshot_count)
+        context.snapshots.take_first();
+    (void)context.snapshots.try_append({ frame_index, frame_buffer.release_value(), move(prev_frame_buffer) });
+}
+
 static ErrorOr<void> decode_frame(GIFLoadingContext& context, size_t frame_index)
 {
     if (frame_index >= context.images.size()) {
@@ -271,24 +337,47 @@ static ErrorOr<void> decode_frame(GIFLoadingContext& context, size_t frame_index
         return {};
     }
 
-    size_t start_frame = context.current_frame + 1;
     if (context.state < GIFLoadingContext::State::FrameComplete) {
-        start_frame = 0;
         context.frame_buffer = TRY(Bitmap::create(BitmapFormat::BGRA8888, { context.logical_screen.width, context.logical_screen.height }));
         context.prev_frame_buffer = TRY(Bitmap::create(BitmapFormat::BGRA8888, { context.logical_screen.width, context.logical_screen.height }));
+    }
 
-    } else if (frame_index < context.current_frame) {
-        start_frame = 0;
+    // Find the closest point to resume decoding from: The frame after the current one, the frame after a snapshot, or a
+    // key frame, which can be decoded from scratch.
+    size_t start_frame = frame_index;
+    while (!is_key_frame(context, start_frame))
+        --start_frame;
+    bool start_from_scratch = true;
+
+    if (context.state >= GIFLoadingContext::State::FrameComplete && context.current_frame < frame_index && context.current_frame + 1 > start_frame) {
+        start_frame = context.current_frame + 1;
+        start_from_scratch = false;
     }
 
+    GIFLoadingContext::Snapshot const* best_snapshot = nullptr;
+    for (auto const& snapshot : context.snapshots) {
+        if (snapshot.frame_index <= frame_index && snapshot.frame_index + 1 > start_frame && (!best_snapshot || snapshot.frame_index > best_snapshot->frame_index))
+            best_snapshot = &snapshot;
+    }
+    if (best_snapshot) {
+        copy_frame_buffer(*context.frame_buffer, *best_snapshot->frame_buffer);
+        if (best_snapshot->prev_frame_buffer)
+            copy_frame_buffer(*context.prev_frame_buffer, *best_snapshot->prev_frame_buffer);
+        context.current_frame = best_snapshot->frame_index;
+        context.state = GIFLoadingContext::State::FrameComplete;
+        start_frame = best_snapshot->frame_index + 1;
+        start_from_scratch = false;
+    }
+
+    if (start_from_scratch)
+        context.frame_buffer->fill(Color::Transparent);
+
     for (size_t i = start_frame; i <= frame_index; ++i) {
         auto& image = context.images.at(i);
 
         auto const previous_image_disposal_method = i > 0 ? context.images.at(i - 1).disposal_method : GIFImageDescriptor::DisposalMethod::None;
 
-        if (i == 0) {
-            context.frame_buffer->fill(Color::Transparent);
-        } else if (i > 0 && image.disposal_method == GIFImageDescriptor::DisposalMethod::RestorePrevious
+        if (i > 0 && image.disposal_method == GIFImageDescriptor::DisposalMethod::RestorePrevious
             && previous_image_disposal_method != GIFImageDescriptor::DisposalMethod::RestorePrevious) {
             // This marks the start of a run of frames that once disposed should be restored to the
             // previous underlying image contents. Therefore we make a copy of the current frame
@@ -371,6 +460,7 @@ static ErrorOr<void> decode_frame(GIFLoadingContext& context, size_t frame_index
 
         context.current_frame = i;
         context.state = GIFLoadingContext::State::FrameComplete;
+        take_snapshot(context);
     }
 
     return {};
@@ -629,6 +719,13 @@ size_t GIFImageDecoderPlugin::frame_count()
 }
 
 ErrorOr<ImageFrameDescriptor> GIFImageDecoderPlugin::frame(size_t index)
+{
+    auto frame = TRY(borrow_frame(index));
+    frame.image = TRY(frame.image->clone());
+    return frame;
+}
+
+ErrorOr<ImageFrameDescriptor> GIFImageDecoderPlugin::borrow_frame(size_t index)
 {
     if (m_context->error_state >= GIFLoadingContext::ErrorState::FailedToDecodeAnyFrame) {
         return Error::from_string_literal("GIFImageDecoderPlugin: Decoding failed");
@@ -656,7 +753,7 @@ ErrorOr<ImageFrameDescriptor> GIFImageDecoderPlugin::frame(size_t index)
     }
 
     ImageFrameDescriptor frame {};
-    frame.image = TRY(m_context->frame_buffer->clone());
+    frame.image = m_context->frame_buffer;
     frame.duration = m_context->images.at(index).duration * 10;
 
     if (frame.duration <= 10) {
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/SIMDExtras.h>
+#include <LibGfx/ICC/ColorTransform.h>
+#include <LibGfx/ICC/Tags.h>
+
+namespace Gfx::ICC {
+
+using AK::SIMD::f32x4;
+
+namespace {
+
+// The parts of a matrix/TRC profile that are needed to convert colors to and from the PCS.
+struct MatrixShaperModel {
+    // Per channel: encoded value -> linear light.
+    ColorTransform::ToneCurves tone_curves;
+    // Linear RGB -> PCSXYZ. The columns are the red, green and blue colorants.
+    DoubleMatrix3x3 to_pcs;
+};
+
+}
+
+static float evaluate_tone_curve(TagData const& curve, float x)
+{
+    if (curve.type() == CurveTagData::Type)
+        return static_cast<CurveTagData const&>(curve).evaluate(x);
+    VERIFY(curve.type() == ParametricCurveTagData::Type);
+    return static_cast<ParametricCurveTagData const&>(curve).evaluate(x);
+}
+
+static ErrorOr<MatrixShaperModel> matrix_shaper_model(Profile const& profile)
+{
+    // ICC v4, 8.3.3 / 8.4.3: "Only the PCSXYZ encoding can be used with matrix/TRC models."
+    if (profile.data_color_space() != ColorSpace::RGB || profile.connection_space() != ColorSpace::PCSXYZ)
+        return Error::from_string_literal("ICC::ColorTransform: Only RGB profiles with an XYZ connection space are supported");
+
+    auto tone_curve = [&](TagSignature tag) -> ErrorOr<NonnullRefPtr<TagData>> {
+        auto curve = profile.tag_data(tag);
+        if (!curve.has_value() || (curve.value()->type() != CurveTagData::Type && curve.value()->type() != ParametricCurveTagData::Type))
+            return Error::from_string_literal("ICC::ColorTransform: Profile has no usable tone curves");
+        return curve.release_value();
+    };
+
+    auto colorant = [&](TagSignature tag) -> ErrorOr<XYZ> {
+        auto xyz = profile.tag_data(tag);
+        if (!xyz.has_value() || xyz.value()->type() != XYZTagData::Type)
+            return Error::from_string_literal("ICC::ColorTransform: Profile has no usable colorant matrix");
+        auto const& xyzs = static_cast<XYZTagData const&>(*xyz.value()).xyzs();
+        if (xyzs.size() != 1)
+            return Error::from_string_literal("ICC::ColorTransform: Colorant tag does not contain exactly one XYZ value");
+        return xyzs[0];
+    };
+
+    auto red_curve = TRY(tone_curve(redTRCTag));
+    auto green_curve = TRY(tone_curve(greenTRCTag));
+    auto blue_curve = TRY(tone_curve(blueTRCTag));
+    auto red = TRY(colorant(redMatrixColumnTag));
+    auto green = TRY(colorant(greenMatrixColumnTag));
+    auto blue = TRY(colorant(blueMatrixColumnTag));
+
+    return MatrixShaperModel {
+        { move(red_curve), move(green_curve), move(blue_curve) },
+        DoubleMatrix3x3(
+            red.x, green.x, blue.x,
+            red.y, green.y, blue.y,
+            red.z, green.z, blue.z),
+    };
+}
+
+static ErrorOr<MatrixShaperModel> sRGB_model()
+{
+    // IEC 61966-2-1, written as a parametric curve of type 3 (g, a, b, c, d).
+    NonnullRefPtr<TagData> curve = TRY(try_make_ref_counted<ParametricCurveTagData>(0, 0, ParametricCurveTagData::FunctionType::sRGB,
+        Array<S15Fixed16, 7> { S15Fixed16(2.4), S15Fixed16(1 / 1.055), S15Fixed16(0.055 / 1.055), S15Fixed16(1 / 12.92), S15Fixed16(0.04045), S15Fixed16(0.0), S15Fixed16(0.0) }));
+
+    // The sRGB primaries, chromatically adapted to the D50 illuminant of the PCS.
+    return MatrixShaperModel {
+        { curve, curve, curve },
+        DoubleMatrix3x3(
+            0.4360747, 0.3850649, 0.1430804,
+            0.2225045, 0.7168786, 0.0606169,
+            0.0139322, 0.0971045, 0.7141733),
+    };
+}
+
+ErrorOr<ColorTransform> ColorTransform::create(Profile const& source, Profile const& destination)
+{
+    auto source_model = TRY(matrix_shaper_model(source));
+    auto destination_model = TRY(matrix_shaper_model(destination));
+    return create_from_models(source_model.tone_curves, source_model.to_pcs, destination_model.tone_curves, destination_model.to_pcs);
+}
+
+ErrorOr<ColorTransform> ColorTransform::create_to_sRGB(Profile const& source)
+{
+    auto source_model = TRY(matrix_shaper_model(source));
+    auto destination_model = TRY(sRGB_model());
+    return create_from_models(source_model.tone_curves, source_model.to_pcs, destination_model.tone_curves, destination_model.to_pcs);
+}
+
+ErrorOr<ColorTransform> ColorTransform::create_to_sRGB(ReadonlyBytes source_icc_data)
+{
+    auto source = TRY(Profile::try_load_from_externally_owned_memory(source_icc_data));
+    return create_to_sRGB(*source);
+}
+
+ErrorOr<ColorTransform> ColorTransform::create_from_models(ToneCurves const& source_curves, DoubleMatrix3x3 const& source_to_pcs, ToneCurves const& destination_curves, DoubleMatrix3x3 const& destination_to_pcs)
+{
+    if (!destination_to_pcs.is_invertible())
+        return Error::from_string_literal("ICC::ColorTransform: Destination colorant matrix is not invertible");
+
+    ColorTransform transform;
+    auto const matrix = destination_to_pcs.inverse() * source_to_pcs;
+    auto const& elements = matrix.elements();
+
+    for (size_t channel = 0; channel < 3; ++channel) {
+        for (size_t value = 0; value < 256; ++value)
+            transform.m_source_curves[channel][value] = evaluate_tone_curve(source_curves[channel], value / 255.0f);
+
+        transform.m_matrix_columns[channel] = f32x4 {
+            static_cast<float>(elements[0][channel] * (linear_steps - 1)),
+            static_cast<float>(elements[1][channel] * (linear_steps - 1)),
+            static_cast<float>(elements[2][channel] * (linear_steps - 1)),
+            0,
+        };
+
+        // Invert the destination curve by walking along its values at every possible output value. Between two of them,
+        // the curve is close enough to linear to pick the nearer one by interpolating.
+        Array<float, 256> curve_values;
+        for (size_t value = 0; value < 256; ++value)
+            curve_values[value] = evaluate_tone_curve(destination_curves[channel], value / 255.0f);
+
+        size_t value = 0;
+        for (size_t step = 0; step < linear_steps; ++step) {
+            auto linear = static_cast<float>(step) / (linear_steps - 1);
+            while (value < 255 && curve_values[value + 1] <= linear)
+                ++value;
+            auto result = value;
+            if (value < 255 && curve_values[value + 1] > curve_values[value]) {
+                auto fraction = (linear - curve_values[value]) / (curve_values[value + 1] - curve_values[value]);
+                if (fraction >= 0.5f)
+                    ++result;
+            }
+            transform.m_destination_curves[channel][step] = static_cast<u8>(result);
+        }
+    }
+
+    // Profiles that just describe sRGB in a slightly different way are very common, and there is nothing to do for them.
+    transform.m_is_identity = [&] {
+        for (size_t row = 0; row < 3; ++row) {
+            for (size_t column = 0; column < 3; ++column) {
+                if (fabs(elements[row][column] - (row == column ? 1.0 : 0.0)) > 0.001)
+                    return false;
+            }
+        }
+        for (size_t channel = 0; channel < 3; ++channel) {
+            for (size_t value = 0; value < 256; ++value) {
+                auto step = static_cast<size_t>(transform.m_source_curves[channel][value] * (linear_steps - 1) + 0.5f);
+                if (transform.m_destination_curves[channel][step] != value)
+                    return false;
+            }
+        }
+        return true;
+    }();
+
+    return transform;
+}
+
+ALWAYS_INLINE ARGB32 ColorTransform::map_pixel(ARGB32 pixel) const
+{
+    auto linear = m_matrix_columns[0] * m_source_curves[0][(pixel >> 16) & 0xff]
+        + m_matrix_columns[1] * m_source_curves[1][(pixel >> 8) & 0xff]
+        + m_matrix_columns[2] * m_source_curves[2][pixel & 0xff];
+    auto steps = AK::SIMD::to_i32x4(linear + 0.5f);
+
+    auto encode = [&](size_t channel) -> u32 {
+        return m_destination_curves[channel][clamp(steps[channel], 0, static_cast<i32>(linear_steps - 1))];
+    };
+    return (pixel & 0xff000000) | (encode(0) << 16) | (encode(1) << 8) | encode(2);
+}
+
+Color ColorTransform::map(Color color) const
+{
+    return Color::from_argb(map_pixel(color.value()));
+}
+
+void ColorTransform::map(Span<ARGB32> pixels) const
+{
+    if (m_is_identity)
+        return;
+    for (auto& pixel : pixels)
+        pixel = map_pixel(pixel);
+}
+
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/Error.h>
+#include <AK/SIMD.h>
+#include <AK/Span.h>
+#include <LibGfx/Color.h>
+#include <LibGfx/ICC/Profile.h>
+#include <LibGfx/Matrix3x3.h>
+
+namespace Gfx::ICC {
+
+// Converts colors between two RGB profiles that use the matrix/TRC model (ICC v4, 8.3.3 and 8.4.3), which covers
+// practically all profiles embedded in images. Everything that only depends on the profiles is compiled into tables up
+// front: the source tone curves become a lookup table per channel, both matrices are folded into one, and the inverted
+// destination tone curves become a table indexed by linear light. Converting a pixel then takes three lookups, one
+// vectorized 3x3 matrix multiplication and three more lookups.
+class ColorTransform {
+public:
+    static ErrorOr<ColorTransform> create(Profile const& source, Profile const& destination);
+
+    // Converts to sRGB, which is what colors without a profile are assumed to be in.
+    static ErrorOr<ColorTransform> create_to_sRGB(Profile const& source);
+    static ErrorOr<ColorTransform> create_to_sRGB(ReadonlyBytes source_icc_data);
+
+    // True if the transform doesn't change any color, in which case there's no point in applying it.
+    bool is_identity() const { return m_is_identity; }
+
+    Color map(Color) const;
+
+    // Converts pixels in place. Alpha is left untouched, so this works for both BGRx8888 and (unpremultiplied) BGRA8888.
+    void map(Span<ARGB32>) const;
+
+    // Per channel: encoded value -> linear light, as either a CurveTagData or a ParametricCurveTagData.
+    using ToneCurves = Array<NonnullRefPtr<TagData>, 3>;
+
+private:
+    // The destination tables are indexed by linear light, which needs more precision than 8 bits in the dark areas.
+    static constexpr size_t linear_steps = 8192;
+
+    ColorTransform() = default;
+
+    static ErrorOr<ColorTransform> create_from_models(ToneCurves const& source_curves, DoubleMatrix3x3 const& source_to_pcs, ToneCurves const& destination_curves, DoubleMatrix3x3 const& destination_to_pcs);
+
+    ALWAYS_INLINE ARGB32 map_pixel(ARGB32) const;
+
+    // Per source channel: encoded value -> linear light.
+    Array<Array<float, 256>, 3> m_source_curves;
+    // Per source channel: the linear destination color that full intensity of that channel maps to, scaled to the
+    // index range of the destination tables.
+    Array<AK::SIMD::f32x4, 3> m_matrix_columns;
+    // Per destination channel: linear light -> encoded value.
+    Array<Array<u8, linear_steps>, 3> m_destination_curves;
+    bool m_is_identity { false };
+};
+
+}
@@ -257,6 +257,13 @@ public:
 
     size_t tag_count() const { return m_tag_table.size(); }
 
+    Optional<NonnullRefPtr<TagData>> tag_data(TagSignature signature) const
+    {
+        if (auto it = m_tag_table.find(signature); it != m_tag_table.end())
+            return it->value;
+        return {};
+    }
+
     // Only versions 2 and 4 are in use.
     bool is_v2() const { return version().major_version() == 2; }
     bool is_v4() const { return version().major_version() == 4; }
@@ -6,6 +6,7 @@
 
 #include <AK/DeprecatedString.h>
 #include <AK/Endian.h>
+#include <AK/Math.h>
 #include <LibGfx/ICC/BinaryFormat.h>
 #include <LibGfx/ICC/TagTypes.h>
 #include <LibGfx/ICC/Tags.h>
@@ -162,6 +163,25 @@ ErrorOr<NonnullRefPtr<CurveTagData>> CurveTagData::from_bytes(ReadonlyBytes byte
     return try_make_ref_counted<CurveTagData>(offset, size, move(curve_data.values));
 }
 
+float CurveTagData::evaluate(float x) const
+{
+    x = clamp(x, 0.0f, 1.0f);
+
+    if (m_values.is_empty())
+        return x;
+
+    // "When n is equal to 1, then the curve value shall be interpreted as a gamma value, encoded as a u8Fixed8Number."
+    if (m_values.size() == 1)
+        return AK::pow(x, m_values[0] / 256.0f);
+
+    // "Function values between the entries shall be obtained through linear interpolation."
+    auto position = x * (m_values.size() - 1);
+    auto index = min(static_cast<size_t>(position), m_values.size() - 2);
+    auto fraction = position - index;
+    auto value = m_values[index] * (1 - fraction) + m_values[index + 1] * fraction;
+    return value / 65535.0f;
+}
+
 ErrorOr<NonnullRefPtr<Lut16TagData>> Lut16TagData::from_bytes(ReadonlyBytes bytes, u32 offset, u32 size)
 {
     // ICC v4, 10.10 lut16Type
@@ -843,6 +863,57 @@ ErrorOr<NonnullRefPtr<ParametricCurveTagData>> ParametricCurveTagData::from_byte
     return try_make_ref_counted<ParametricCurveTagData>(offset, size, curve_data.function_type, move(curve_data.parameters));
 }
 
+float ParametricCurveTagData::evaluate(float x) const
+{
+    x = clamp(x, 0.0f, 1.0f);
+    auto g = static_cast<float>(this->g());
+
+    // See the table in the definition of FunctionType for the formulas.
+    float y = 0;
+    switch (function_type()) {
+    case FunctionType::Type0:
+        y = AK::pow(x, g);
+        break;
+    case FunctionType::Type1: {
+        auto a = static_cast<float>(this->a());
+        auto b = static_cast<float>(this->b());
+        y = x >= -b / a ? AK::pow(a * x + b, g) : 0;
+        break;
+    }
+    case FunctionType::Type2: {
+        auto a = static_cast<float>(this->a());
+        auto b = static_cast<float>(this->b());
+        auto c = static_cast<float>(this->c());
+        y = x >= -b / a ? AK::pow(a * x + b, g) + c : c;
+        break;
+    }
+    case FunctionType::Type3: {
+        auto a = static_cast<float>(this->a());
+        auto b = static_cast<float>(this->b());
+        auto c = static_cast<float>(this->c());
+        auto d = static_cast<float>(this->d());
+        y = x >= d ? AK::pow(a * x + b, g) : c * x;
+        break;
+    }
+    case FunctionType::Type4: {
+        auto a = static_cast<float>(this->a());
+        auto b = static_cast<float>(this->b());
+        auto c = static_cast<float>(this->c());
+        auto d = static_cast<float>(this->d());
+        auto e = static_cast<float>(this->e());
+        auto f = static_cast<float>(this->f());
+        y = x >= d ? AK::pow(a * x + b, g) + e : c * x + f;
+        break;
+    }
+    }
+
+    // "Any function value outside the range shall be clipped to the range of the function."
+    // (This also takes care of NaNs from curves with undefined behavior, see NOTE 1 above.)
+    if (!(y >= 0.0f))
+        return 0.0f;
+    return min(y, 1.0f);
+}
+
 ErrorOr<NonnullRefPtr<S15Fixed16ArrayTagData>> S15Fixed16ArrayTagData::from_bytes(ReadonlyBytes bytes, u32 offset, u32 size)
 {
     // ICC v4, 10.22 s15Fixed16ArrayType
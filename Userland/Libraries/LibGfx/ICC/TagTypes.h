@@ -159,6 +159,9 @@ public:
     //      65 535). Function values between the entries shall be obtained through linear interpolation."
     Vector<u16> const& values() const { return m_values; }
 
+    // Maps x in [0, 1] to the curve's value in [0, 1].
+    float evaluate(float x) const;
+
 private:
     Vector<u16> m_values;
 };
@@ -691,6 +694,9 @@ public:
         return m_parameters[6];
     }
 
+    // Maps x in [0, 1] to the curve's value, clipped to [0, 1].
+    float evaluate(float x) const;
+
 private:
     FunctionType m_function_type;
 
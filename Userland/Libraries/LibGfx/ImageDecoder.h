@@ -42,6 +42,14 @@ public:
     virtual ErrorOr<ImageFrameDescriptor> frame(size_t index) = 0;
     virtual ErrorOr<Optional<ReadonlyBytes>> icc_data() = 0;
 
+    // Like frame(), but the decoder may hand out a bitmap that it keeps drawing the following frames into. This saves
+    // a copy of every frame for callers that are done with a frame before asking for the next one.
+    virtual ErrorOr<ImageFrameDescriptor> borrow_frame(size_t index) { return frame(index); }
+
+    // Asks the decoder to convert the colors from the embedded color profile to sRGB while decoding.
+    // Decoders that can't do that return the colors as they are stored in the image.
+    virtual void set_convert_to_sRGB(bool) { }
+
 protected:
     ImageDecoderPlugin() = default;
 };
@@ -61,6 +69,19 @@ public:
     size_t frame_count() const { return m_plugin->frame_count(); }
     ErrorOr<ImageFrameDescriptor> frame(size_t index) const { return m_plugin->frame(index); }
     ErrorOr<Optional<ReadonlyBytes>> icc_data() const { return m_plugin->icc_data(); }
+    ErrorOr<ImageFrameDescriptor> borrow_frame(size_t index) const { return m_plugin->borrow_frame(index); }
+
+    // Calls `callback` with the index and the (borrowed) contents of every frame in order, which lets decoders of
+    // animations compose each frame on top of the previous one instead of starting over.
+    template<typename Callback>
+    void for_each_frame(Callback callback) const
+    {
+        for (size_t i = 0; i < frame_count(); ++i) {
+            if (callback(i, borrow_frame(i)) == IterationDecision::Break)
+                return;
+        }
+    }
+    void set_convert_to_sRGB(bool convert) { m_plugin->set_convert_to_sRGB(convert); }
 
 private:
     explicit ImageDecoder(NonnullOwnPtr<ImageDecoderPlugin>);
@@ -11,9 +11,12 @@
 #include <AK/HashMap.h>
 #include <AK/Math.h>
 #include <AK/MemoryStream.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <AK/String.h>
 #include <AK/Try.h>
 #include <AK/Vector.h>
+#include <LibGfx/ICC/ColorTransform.h>
 #include <LibGfx/JPEGLoader.h>
 
 #define JPEG_INVALID 0X0000
@@ -241,6 +244,10 @@ struct JPEGLoadingContext {
 
     Optional<ICCMultiChunkState> icc_multi_chunk_state;
     Optional<ByteBuffer> icc_data;
+
+    bool convert_to_sRGB { false };
+    // Applied to every row of the bitmap as soon as it has been composed.
+    Optional<ICC::ColorTransform> color_transform;
 };
 
 static void generate_huffman_codes(HuffmanTableSpec& table)
@@ -966,6 +973,96 @@ static void inverse_dct(JPEGLoadingContext const& context, Vector<Macroblock>& m
     static float const s6 = AK::cos(6.0f / 16.0f * AK::Pi<float>) / 2.0f;
     static float const s7 = AK::cos(7.0f / 16.0f * AK::Pi<float>) / 2.0f;
 
+    using AK::SIMD::f32x4;
+    using AK::SIMD::i32x4;
+
+    // Transforms the 8 values in each of the 4 columns starting at `column`. The math is done for 4 columns at once,
+    // but is otherwise exactly the same as for a single column, so the results don't change.
+    auto transform_columns = [&](i32* block_component, u32 column) {
+        auto load = [&](u32 row) {
+            i32x4 values;
+            __builtin_memcpy(&values, &block_component[row * 8 + column], sizeof(values));
+            return AK::SIMD::to_f32x4(values);
+        };
+        auto store = [&](u32 row, f32x4 values) {
+            auto truncated_values = AK::SIMD::to_i32x4(values);
+            __builtin_memcpy(&block_component[row * 8 + column], &truncated_values, sizeof(truncated_values));
+        };
+
+        f32x4 const g0 = load(0) * s0;
+        f32x4 const g1 = load(4) * s4;
+        f32x4 const g2 = load(2) * s2;
+        f32x4 const g3 = load(6) * s6;
+        f32x4 const g4 = load(5) * s5;
+        f32x4 const g5 = load(1) * s1;
+        f32x4 const g6 = load(7) * s7;
+        f32x4 const g7 = load(3) * s3;
+
+        f32x4 const f0 = g0;
+        f32x4 const f1 = g1;
+        f32x4 const f2 = g2;
+        f32x4 const f3 = g3;
+        f32x4 const f4 = g4 - g7;
+        f32x4 const f5 = g5 + g6;
+        f32x4 const f6 = g5 - g6;
+        f32x4 const f7 = g4 + g7;
+
+        f32x4 const e0 = f0;
+        f32x4 const e1 = f1;
+        f32x4 const e2 = f2 - f3;
+        f32x4 const e3 = f2 + f3;
+        f32x4 const e4 = f4;
+        f32x4 const e5 = f5 - f7;
+        f32x4 const e6 = f6;
+        f32x4 const e7 = f5 + f7;
+        f32x4 const e8 = f4 + f6;
+
+        f32x4 const d0 = e0;
+        f32x4 const d1 = e1;
+        f32x4 const d2 = e2 * m1;
+        f32x4 const d3 = e3;
+        f32x4 const d4 = e4 * m2;
+        f32x4 const d5 = e5 * m3;
+        f32x4 const d6 = e6 * m4;
+        f32x4 const d7 = e7;
+        f32x4 const d8 = e8 * m5;
+
+        f32x4 const c0 = d0 + d1;
+        f32x4 const c1 = d0 - d1;
+        f32x4 const c2 = d2 - d3;
+        f32x4 const c3 = d3;
+        f32x4 const c4 = d4 + d8;
+        f32x4 const c5 = d5 + d7;
+        f32x4 const c6 = d6 - d8;
+        f32x4 const c7 = d7;
+        f32x4 const c8 = c5 - c6;
+
+        f32x4 const b0 = c0 + c3;
+        f32x4 const b1 = c1 + c2;
+        f32x4 const b2 = c1 - c2;
+        f32x4 const b3 = c0 - c3;
+        f32x4 const b4 = c4 - c8;
+        f32x4 const b5 = c8;
+        f32x4 const b6 = c6 - c7;
+        f32x4 const b7 = c7;
+
+        store(0, b0 + b7);
+        store(1, b1 + b6);
+        store(2, b2 + b5);
+        store(3, b3 + b4);
+        store(4, b3 - b4);
+        store(5, b2 - b5);
+        store(6, b1 - b6);
+        store(7, b0 - b7);
+    };
+
+    auto transpose = [](i32* block_component) {
+        for (u32 row = 0; row < 8; ++row) {
+            for (u32 column = row + 1; column < 8; ++column)
+                swap(block_component[row * 8 + column], block_component[column * 8 + row]);
+        }
+    };
+
     for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.vsample_factor) {
         for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.hsample_factor) {
             for (u32 component_i = 0; component_i < context.components.size(); component_i++) {
@@ -975,140 +1072,14 @@ static void inverse_dct(JPEGLoadingContext const& context, Vector<Macroblock>& m
                         u32 mb_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
                         Macroblock& block = macroblocks[mb_index];
                         i32* block_component = get_component(block, component_i);
-                        for (u32 k = 0; k < 8; ++k) {
-                            float const g0 = block_component[0 * 8 + k] * s0;
-                            float const g1 = block_component[4 * 8 + k] * s4;
-                            float const g2 = block_component[2 * 8 + k] * s2;
-                            float const g3 = block_component[6 * 8 + k] * s6;
-                            float const g4 = block_component[5 * 8 + k] * s5;
-                            float const g5 = block_component[1 * 8 + k] * s1;
-                            float const g6 = block_component[7 * 8 + k] * s7;
-                            float const g7 = block_component[3 * 8 + k] * s3;
-
-                            float const f0 = g0;
-                            float const f1 = g1;
-                            float const f2 = g2;
-                            float const f3 = g3;
-                            float const f4 = g4 - g7;
-                            float const f5 = g5 + g6;
-                            float const f6 = g5 - g6;
-                            float const f7 = g4 + g7;
-
-                            float const e0 = f0;
-                            float const e1 = f1;
-                            float const e2 = f2 - f3;
-                            float const e3 = f2 + f3;
-                            float const e4 = f4;
-                            float const e5 = f5 - f7;
-                            float const e6 = f6;
-                            float const e7 = f5 + f7;
-                            float const e8 = f4 + f6;
-
-                            float const d0 = e0;
-                            float const d1 = e1;
-                            float const d2 = e2 * m1;
-                            float const d3 = e3;
-                            float const d4 = e4 * m2;
-                            float const d5 = e5 * m3;
-                            float const d6 = e6 * m4;
-                            float const d7 = e7;
-                            float const d8 = e8 * m5;
-
-                            float const c0 = d0 + d1;
-                            float const c1 = d0 - d1;
-                            float const c2 = d2 - d3;
-                            float const c3 = d3;
-                            float const c4 = d4 + d8;
-                            float const c5 = d5 + d7;
-                            float const c6 = d6 - d8;
-                            float const c7 = d7;
-                            float const c8 = c5 - c6;
-
-                            float const b0 = c0 + c3;
-                            float const b1 = c1 + c2;
-                            float const b2 = c1 - c2;
-                            float const b3 = c0 - c3;
-                            float const b4 = c4 - c8;
-                            float const b5 = c8;
-                            float const b6 = c6 - c7;
-                            float const b7 = c7;
-
-                            block_component[0 * 8 + k] = b0 + b7;
-                            block_component[1 * 8 + k] = b1 + b6;
-                            block_component[2 * 8 + k] = b2 + b5;
-                            block_component[3 * 8 + k] = b3 + b4;
-                            block_component[4 * 8 + k] = b3 - b4;
-                            block_component[5 * 8 + k] = b2 - b5;
-                            block_component[6 * 8 + k] = b1 - b6;
-                            block_component[7 * 8 + k] = b0 - b7;
-                        }
-                        for (u32 l = 0; l < 8; ++l) {
-                            float const g0 = block_component[l * 8 + 0] * s0;
-                            float const g1 = block_component[l * 8 + 4] * s4;
-                            float const g2 = block_component[l * 8 + 2] * s2;
-                            float const g3 = block_component[l * 8 + 6] * s6;
-                            float const g4 = block_component[l * 8 + 5] * s5;
-                            float const g5 = block_component[l * 8 + 1] * s1;
-                            float const g6 = block_component[l * 8 + 7] * s7;
-                            float const g7 = block_component[l * 8 + 3] * s3;
-
-                            float const f0 = g0;
-                            float const f1 = g1;
-                            float const f2 = g2;
-                            float const f3 = g3;
-                            float const f4 = g4 - g7;
-                            float const f5 = g5 + g6;
-                            float const f6 = g5 - g6;
-                            float const f7 = g4 + g7;
-
-                            float const e0 = f0;
-                            float const e1 = f1;
-                            float const e2 = f2 - f3;
-                            float const e3 = f2 + f3;
-                            float const e4 = f4;
-                            float const e5 = f5 - f7;
-                            float const e6 = f6;
-                            float const e7 = f5 + f7;
-                            float const e8 = f4 + f6;
-
-                            float const d0 = e0;
-                            float const d1 = e1;
-                            float const d2 = e2 * m1;
-                            float const d3 = e3;
-                            float const d4 = e4 * m2;
-                            float const d5 = e5 * m3;
-                            float const d6 = e6 * m4;
-                            float const d7 = e7;
-                            float const d8 = e8 * m5;
-
-                            float const c0 = d0 + d1;
-                            float const c1 = d0 - d1;
-                            float const c2 = d2 - d3;
-                            float const c3 = d3;
-                            float const c4 = d4 + d8;
-                            float const c5 = d5 + d7;
-                            float const c6 = d6 - d8;
-                            float const c7 = d7;
-                            float const c8 = c5 - c6;
-
-                            float const b0 = c0 + c3;
-                            float const b1 = c1 + c2;
-                            float const b2 = c1 - c2;
-                            float const b3 = c0 - c3;
-                            float const b4 = c4 - c8;
-                            float const b5 = c8;
-                            float const b6 = c6 - c7;
-                            float const b7 = c7;
-
-                            block_component[l * 8 + 0] = b0 + b7;
-                            block_component[l * 8 + 1] = b1 + b6;
-                            block_component[l * 8 + 2] = b2 + b5;
-                            block_component[l * 8 + 3] = b3 + b4;
-                            block_component[l * 8 + 4] = b3 - b4;
-                            block_component[l * 8 + 5] = b2 - b5;
-                            block_component[l * 8 + 6] = b1 - b6;
-                            block_component[l * 8 + 7] = b0 - b7;
-                        }
+
+                        // First transform the columns, then the rows, by transforming the columns of the transposed block.
+                        transform_columns(block_component, 0);
+                        transform_columns(block_component, 4);
+                        transpose(block_component);
+                        transform_columns(block_component, 0);
+                        transform_columns(block_component, 4);
+                        transpose(block_component);
                     }
                 }
             }
@@ -1118,11 +1089,27 @@ static void inverse_dct(JPEGLoadingContext const& context, Vector<Macroblock>& m
 
 static void ycbcr_to_rgb(JPEGLoadingContext const& context, Vector<Macroblock>& macroblocks)
 {
+    using AK::SIMD::f32x4;
+    using AK::SIMD::i32x4;
+
+    auto load = [](i32 const* values) {
+        i32x4 vector;
+        __builtin_memcpy(&vector, values, sizeof(vector));
+        return AK::SIMD::to_f32x4(vector);
+    };
+    auto clamp_and_store = [](i32* values, f32x4 vector) {
+        auto integers = AK::SIMD::to_i32x4(vector);
+        integers = integers < 0 ? 0 : (integers > 255 ? 255 : integers);
+        __builtin_memcpy(values, &integers, sizeof(integers));
+    };
+
     for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.vsample_factor) {
         for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.hsample_factor) {
             const u32 chroma_block_index = vcursor * context.mblock_meta.hpadded_count + hcursor;
             Macroblock const& chroma = macroblocks[chroma_block_index];
             // Overflows are intentional.
+            // NOTE: The chroma block is converted in place as well, so the blocks and their pixels are visited backwards.
+            //       That way, the chroma values a pixel needs haven't been overwritten yet.
             for (u8 vfactor_i = context.vsample_factor - 1; vfactor_i < context.vsample_factor; --vfactor_i) {
                 for (u8 hfactor_i = context.hsample_factor - 1; hfactor_i < context.hsample_factor; --hfactor_i) {
                     u32 mb_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hcursor + hfactor_i);
@@ -1130,17 +1117,30 @@ static void ycbcr_to_rgb(JPEGLoadingContext const& context, Vector<Macroblock>&
                     i32* cb = macroblocks[mb_index].cb;
                     i32* cr = macroblocks[mb_index].cr;
                     for (u8 i = 7; i < 8; --i) {
-                        for (u8 j = 7; j < 8; --j) {
+                        const u32 chroma_pxrow = (i / context.vsample_factor) + 4 * vfactor_i;
+                        // Each group of 4 pixels is read in full before any of it is written, so this works for them too.
+                        for (u8 j = 4; j < 8; j -= 4) {
                             const u8 pixel = i * 8 + j;
-                            const u32 chroma_pxrow = (i / context.vsample_factor) + 4 * vfactor_i;
-                            const u32 chroma_pxcol = (j / context.hsample_factor) + 4 * hfactor_i;
-                            const u32 chroma_pixel = chroma_pxrow * 8 + chroma_pxcol;
-                            int r = y[pixel] + 1.402f * chroma.cr[chroma_pixel] + 128;
-                            int g = y[pixel] - 0.344f * chroma.cb[chroma_pixel] - 0.714f * chroma.cr[chroma_pixel] + 128;
-                            int b = y[pixel] + 1.772f * chroma.cb[chroma_pixel] + 128;
-                            y[pixel] = r < 0 ? 0 : (r > 255 ? 255 : r);
-                            cb[pixel] = g < 0 ? 0 : (g > 255 ? 255 : g);
-                            cr[pixel] = b < 0 ? 0 : (b > 255 ? 255 : b);
+                            f32x4 chroma_cb;
+                            f32x4 chroma_cr;
+                            if (context.hsample_factor == 1) {
+                                chroma_cb = load(&chroma.cb[chroma_pxrow * 8 + j]);
+                                chroma_cr = load(&chroma.cr[chroma_pxrow * 8 + j]);
+                            } else {
+                                for (u8 k = 0; k < 4; ++k) {
+                                    const u32 chroma_pxcol = ((j + k) / context.hsample_factor) + 4 * hfactor_i;
+                                    const u32 chroma_pixel = chroma_pxrow * 8 + chroma_pxcol;
+                                    chroma_cb[k] = chroma.cb[chroma_pixel];
+                                    chroma_cr[k] = chroma.cr[chroma_pixel];
+                                }
+                            }
+                            f32x4 const luma = load(&y[pixel]);
+                            f32x4 const r = luma + 1.402f * chroma_cr + 128;
+                            f32x4 const g = luma - 0.344f * chroma_cb - 0.714f * chroma_cr + 128;
+                            f32x4 const b = luma + 1.772f * chroma_cb + 128;
+                            clamp_and_store(&y[pixel], r);
+                            clamp_and_store(&cb[pixel], g);
+                            clamp_and_store(&cr[pixel], b);
                         }
                     }
                 }
@@ -1156,14 +1156,17 @@ static ErrorOr<void> compose_bitmap(JPEGLoadingContext& context, Vector<Macroblo
     for (u32 y = context.frame.height - 1; y < context.frame.height; y--) {
         const u32 block_row = y / 8;
         const u32 pixel_row = y % 8;
+        auto* scanline = context.bitmap->scanline(y);
         for (u32 x = 0; x < context.frame.width; x++) {
             const u32 block_column = x / 8;
             auto& block = macroblocks[block_row * context.mblock_meta.hpadded_count + block_column];
             const u32 pixel_column = x % 8;
             const u32 pixel_index = pixel_row * 8 + pixel_column;
             const Color color { (u8)block.y[pixel_index], (u8)block.cb[pixel_index], (u8)block.cr[pixel_index] };
-            context.bitmap->set_pixel(x, y, color);
+            scanline[x] = color.value();
         }
+        if (context.color_transform.has_value())
+            context.color_transform->map({ scanline, context.frame.width });
     }
 
     return {};
@@ -1439,6 +1442,14 @@ ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index)
         return Error::from_string_literal("JPEGImageDecoderPlugin: Decoding failed");
 
     if (m_context->state < JPEGLoadingContext::State::BitmapDecoded) {
+        // NOTE: Unsupported or broken profiles are ignored, the image is still shown, just with its colors unconverted.
+        if (m_context->convert_to_sRGB) {
+            if (auto icc = icc_data(); !icc.is_error() && icc.value().has_value()) {
+                if (auto transform = ICC::ColorTransform::create_to_sRGB(*icc.value()); !transform.is_error() && !transform.value().is_identity())
+                    m_context->color_transform = transform.release_value();
+            }
+        }
+
         if (auto result = decode_jpeg(*m_context); result.is_error()) {
             m_context->state = JPEGLoadingContext::State::Error;
             return result.release_error();
@@ -1449,6 +1460,11 @@ ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index)
     return ImageFrameDescriptor { m_context->bitmap, 0 };
 }
 
+void JPEGImageDecoderPlugin::set_convert_to_sRGB(bool convert)
+{
+    m_context->convert_to_sRGB = convert;
+}
+
 ErrorOr<Optional<ReadonlyBytes>> JPEGImageDecoderPlugin::icc_data()
 {
     TRY(decode_header(*m_context));
@@ -7,8 +7,10 @@
 
 #include <AK/Debug.h>
 #include <AK/Endian.h>
+#include <AK/SIMD.h>
 #include <AK/Vector.h>
 #include <LibCompress/Zlib.h>
+#include <LibGfx/ICC/ColorTransform.h>
 #include <LibGfx/PNGLoader.h>
 #include <LibGfx/PNGShared.h>
 #include <string.h>
@@ -136,6 +138,10 @@ struct PNGLoadingContext {
     Optional<ByteBuffer> decompressed_icc_profile;
     Optional<RenderingIntent> sRGB_rendering_intent;
 
+    bool convert_to_sRGB { false };
+    // Applied to every row right after it has been unpacked. Palettes are converted once up front instead.
+    Optional<ICC::ColorTransform> color_transform;
+
     Checked<int> compute_row_size_for_width(int width)
     {
         Checked<int> row_size = width;
@@ -199,22 +205,68 @@ private:
 
 static bool process_chunk(Streamer&, PNGLoadingContext& context);
 
+// NOTE: The channels are in the order they're in for the bitmap's BGRA8888 format, so pixels can be written straight into it.
 union [[gnu::packed]] Pixel {
     ARGB32 rgba { 0 };
     u8 v[4];
     struct {
-        u8 r;
-        u8 g;
         u8 b;
+        u8 g;
+        u8 r;
         u8 a;
     };
 };
 static_assert(AssertSize<Pixel, 4>());
 
+// Unfilters a scanline with the Paeth filter one pixel at a time, with all of the pixel's bytes in one vector.
+// This only works for pixels of up to 4 bytes.
+template<size_t bytes_per_complete_pixel>
+static void unfilter_scanline_with_paeth_filter(Bytes scanline_data, ReadonlyBytes previous_scanlines_data)
+{
+    static_assert(bytes_per_complete_pixel <= 4);
+    using AK::SIMD::i16x4;
+
+    auto load = [](u8 const* bytes) {
+        i16x4 values {};
+        for (size_t i = 0; i < bytes_per_complete_pixel; ++i)
+            values[i] = bytes[i];
+        return values;
+    };
+    auto absolute_value = [](i16x4 values) {
+        return values < 0 ? -values : values;
+    };
+
+    i16x4 left {};
+    i16x4 upper_left {};
+    for (size_t i = 0; i + bytes_per_complete_pixel <= scanline_data.size(); i += bytes_per_complete_pixel) {
+        i16x4 const above = load(&previous_scanlines_data[i]);
+        i16x4 const predictor = left + above - upper_left;
+        i16x4 const predictor_left = absolute_value(predictor - left);
+        i16x4 const predictor_above = absolute_value(predictor - above);
+        i16x4 const predictor_upper_left = absolute_value(predictor - upper_left);
+        i16x4 const nearest = ((predictor_left <= predictor_above) & (predictor_left <= predictor_upper_left))
+            ? left
+            : (predictor_above <= predictor_upper_left ? above : upper_left);
+        i16x4 const value = (load(&scanline_data[i]) + nearest) & 0xff;
+        for (size_t j = 0; j < bytes_per_complete_pixel; ++j)
+            scanline_data[i + j] = value[j];
+
+        left = value;
+        upper_left = above;
+    }
+}
+
 static void unfilter_scanline(PNG::FilterType filter, Bytes scanline_data, ReadonlyBytes previous_scanlines_data, u8 bytes_per_complete_pixel)
 {
     VERIFY(filter != PNG::FilterType::None);
 
+    if (filter == PNG::FilterType::Paeth) {
+        if (bytes_per_complete_pixel == 3)
+            return unfilter_scanline_with_paeth_filter<3>(scanline_data, previous_scanlines_data);
+        if (bytes_per_complete_pixel == 4)
+            return unfilter_scanline_with_paeth_filter<4>(scanline_data, previous_scanlines_data);
+    }
+
     switch (filter) {
     case PNG::FilterType::Sub:
         // This loop starts at bytes_per_complete_pixel because all bytes before that are
@@ -266,6 +318,12 @@ static void unfilter_scanline(PNG::FilterType filter, Bytes scanline_data, Reado
     }
 }
 
+ALWAYS_INLINE static void apply_color_transform_to_row(PNGLoadingContext& context, int y)
+{
+    if (context.color_transform.has_value())
+        context.color_transform->map({ context.bitmap->scanline(y), static_cast<size_t>(context.width) });
+}
+
 template<typename T>
 ALWAYS_INLINE static void unpack_grayscale_without_alpha(PNGLoadingContext& context)
 {
@@ -308,6 +366,7 @@ ALWAYS_INLINE static void unpack_triplets_without_alpha(PNGLoadingContext& conte
             pixel.b = triplets[i].b;
             pixel.a = 0xff;
         }
+        apply_color_transform_to_row(context, y);
     }
 }
 
@@ -326,6 +385,7 @@ ALWAYS_INLINE static void unpack_triplets_with_transparency_value(PNGLoadingCont
             else
                 pixel.a = 0xff;
         }
+        apply_color_transform_to_row(context, y);
     }
 }
 
@@ -431,7 +491,15 @@ NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
     case PNG::ColorType::TruecolorWithAlpha:
         if (context.bit_depth == 8) {
             for (int y = 0; y < context.height; ++y) {
-                memcpy(context.bitmap->scanline(y), context.scanlines[y].data.data(), context.scanlines[y].data.size());
+                auto* quartets = reinterpret_cast<Quartet<u8> const*>(context.scanlines[y].data.data());
+                for (int i = 0; i < context.width; ++i) {
+                    auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
+                    pixel.r = quartets[i].r;
+                    pixel.g = quartets[i].g;
+                    pixel.b = quartets[i].b;
+                    pixel.a = quartets[i].a;
+                }
+                apply_color_transform_to_row(context, y);
             }
         } else if (context.bit_depth == 16) {
             for (int y = 0; y < context.height; ++y) {
@@ -443,6 +511,7 @@ NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
                     pixel.b = quartets[i].b & 0xFF;
                     pixel.a = quartets[i].a & 0xFF;
                 }
+                apply_color_transform_to_row(context, y);
             }
         } else {
             VERIFY_NOT_REACHED();
@@ -496,15 +565,6 @@ NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
         break;
     }
 
-    // Swap r and b values:
-    for (int y = 0; y < context.height; ++y) {
-        auto* pixels = (Pixel*)context.bitmap->scanline(y);
-        for (int i = 0; i < context.bitmap->width(); ++i) {
-            auto& x = pixels[i];
-            swap(x.r, x.b);
-        }
-    }
-
     return {};
 }
 
@@ -678,6 +738,7 @@ static ErrorOr<void> decode_adam7_pass(PNGLoadingContext& context, Streamer& str
     subimage_context.palette_transparency_data = context.palette_transparency_data;
     subimage_context.bit_depth = context.bit_depth;
     subimage_context.filter_method = context.filter_method;
+    subimage_context.color_transform = context.color_transform;
 
     // For small images, some passes might be empty
     if (!subimage_context.width || !subimage_context.height)
@@ -745,6 +806,15 @@ static ErrorOr<void> decode_png_bitmap(PNGLoadingContext& context)
     if (context.color_type == PNG::ColorType::IndexedColor && context.palette_data.is_empty())
         return Error::from_string_literal("PNGImageDecoderPlugin: Didn't see a PLTE chunk for a palletized image, or it was empty.");
 
+    // Converting the (at most 256) palette entries is much cheaper than converting every pixel.
+    if (context.color_transform.has_value() && context.color_type == PNG::ColorType::IndexedColor) {
+        for (auto& entry : context.palette_data) {
+            auto color = context.color_transform->map(Color(entry.r, entry.g, entry.b));
+            entry = { color.red(), color.green(), color.blue() };
+        }
+        context.color_transform.clear();
+    }
+
     auto result = Compress::ZlibDecompressor::decompress_all(context.compressed_data.span());
     if (!result.has_value()) {
         context.state = PNGLoadingContext::State::Error;
@@ -1071,6 +1141,14 @@ ErrorOr<ImageFrameDescriptor> PNGImageDecoderPlugin::frame(size_t index)
         return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
 
     if (m_context->state < PNGLoadingContext::State::BitmapDecoded) {
+        // NOTE: Unsupported or broken profiles are ignored, the image is still shown, just with its colors unconverted.
+        if (m_context->convert_to_sRGB) {
+            if (auto icc = icc_data(); !icc.is_error() && icc.value().has_value()) {
+                if (auto transform = ICC::ColorTransform::create_to_sRGB(*icc.value()); !transform.is_error() && !transform.value().is_identity())
+                    m_context->color_transform = transform.release_value();
+            }
+        }
+
         // NOTE: This forces the chunk decoding to happen.
         TRY(decode_png_bitmap(*m_context));
     }
@@ -1079,6 +1157,11 @@ ErrorOr<ImageFrameDescriptor> PNGImageDecoderPlugin::frame(size_t index)
     return ImageFrameDescriptor { m_context->bitmap, 0 };
 }
 
+void PNGImageDecoderPlugin::set_convert_to_sRGB(bool convert)
+{
+    m_context->convert_to_sRGB = convert;
+}
+
 ErrorOr<Optional<ReadonlyBytes>> PNGImageDecoderPlugin::icc_data()
 {
     if (!decode_png_chunks(*m_context))
@@ -28,6 +28,7 @@ public:
     virtual size_t frame_count() override;
     virtual ErrorOr<ImageFrameDescriptor> frame(size_t index) override;
     virtual ErrorOr<Optional<ReadonlyBytes>> icc_data() override;
+    virtual void set_convert_to_sRGB(bool) override;
 
 private:
     PNGImageDecoderPlugin(u8 const*, size_t);
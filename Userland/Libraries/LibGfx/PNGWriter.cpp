@@ -9,11 +9,16 @@
 #include <AK/Concepts.h>
 #include <AK/DeprecatedString.h>
 #include <AK/FixedArray.h>
+#include <AK/IntegralMath.h>
+#include <AK/MemoryStream.h>
 #include <AK/SIMDExtras.h>
+#include <LibCompress/Deflate.h>
 #include <LibCompress/Zlib.h>
+#include <LibCrypto/Checksum/Adler32.h>
 #include <LibCrypto/Checksum/CRC32.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/PNGWriter.h>
+#include <LibThreading/ThreadPool.h>
 
 #pragma GCC diagnostic ignored "-Wpsabi"
 
@@ -167,116 +172,209 @@ union [[gnu::packed]] Pixel {
 };
 static_assert(AssertSize<Pixel, 4>());
 
-ErrorOr<void> PNGWriter::add_IDAT_chunk(Gfx::Bitmap const& bitmap)
+// Every this many bytes of filtered image data are compressed separately, so that they can be compressed in parallel.
+// This costs a tiny bit of compression ratio, as matches can't reach back across the boundaries between segments.
+static constexpr size_t bytes_per_compressed_segment = 1 * MiB;
+
+ALWAYS_INLINE static int sum_of_absolute_values(AK::SIMD::u8x4 bytes)
 {
-    PNGChunk png_chunk { "IDAT" };
-    TRY(png_chunk.reserve(bitmap.size_in_bytes()));
+    return abs(static_cast<i8>(bytes[0])) + abs(static_cast<i8>(bytes[1])) + abs(static_cast<i8>(bytes[2])) + abs(static_cast<i8>(bytes[3]));
+}
+
+struct Filter {
+    PNG::FilterType type;
+    Bytes buffer;
+    int sum { 0 };
+
+    ALWAYS_INLINE void store(size_t x, AK::SIMD::u8x4 bytes)
+    {
+        __builtin_memcpy(buffer.offset_pointer(x * sizeof(Pixel)), &bytes, sizeof(Pixel));
+        sum += sum_of_absolute_values(bytes);
+    }
+};
 
-    ByteBuffer uncompressed_block_data;
-    TRY(uncompressed_block_data.try_ensure_capacity(bitmap.size_in_bytes() + bitmap.height()));
+// Writes the filter type byte followed by the filtered scanline to `output`.
+// `scratch_buffer` has to be large enough for 4 filtered scanlines if `adaptive_filtering` is enabled.
+static void filter_scanline(Bytes output, Pixel const* scanline, Pixel const* scanline_minus_1, size_t width, bool adaptive_filtering, Bytes scratch_buffer)
+{
+    auto const scanline_size = width * sizeof(Pixel);
+    Filter none_filter { .type = PNG::FilterType::None, .buffer = output.slice(1, scanline_size) };
+
+    if (!adaptive_filtering) {
+        output[0] = to_underlying(none_filter.type);
+        for (size_t x = 0; x < width; ++x)
+            none_filter.store(x, Pixel::gfx_to_png(scanline[x]));
+        return;
+    }
 
-    auto dummy_scanline = TRY(FixedArray<Pixel>::create(bitmap.width()));
-    auto const* scanline_minus_1 = dummy_scanline.data();
+    Filter sub_filter { .type = PNG::FilterType::Sub, .buffer = scratch_buffer.slice(0 * scanline_size, scanline_size) };
+    Filter up_filter { .type = PNG::FilterType::Up, .buffer = scratch_buffer.slice(1 * scanline_size, scanline_size) };
+    Filter average_filter { .type = PNG::FilterType::Average, .buffer = scratch_buffer.slice(2 * scanline_size, scanline_size) };
+    Filter paeth_filter { .type = PNG::FilterType::Paeth, .buffer = scratch_buffer.slice(3 * scanline_size, scanline_size) };
 
-    for (int y = 0; y < bitmap.height(); ++y) {
-        auto* scanline = reinterpret_cast<Pixel const*>(bitmap.scanline(y));
+    auto pixel_x_minus_1 = Pixel::gfx_to_png(Pixel {});
+    auto pixel_xy_minus_1 = Pixel::gfx_to_png(Pixel {});
 
-        struct Filter {
-            PNG::FilterType type;
-            ByteBuffer buffer {};
-            int sum = 0;
+    for (size_t x = 0; x < width; ++x) {
+        auto pixel = Pixel::gfx_to_png(scanline[x]);
+        auto pixel_y_minus_1 = Pixel::gfx_to_png(scanline_minus_1[x]);
 
-            ErrorOr<void> append(u8 byte)
-            {
-                TRY(buffer.try_append(byte));
-                sum += static_cast<i8>(byte);
-                return {};
-            }
+        none_filter.store(x, pixel);
 
-            ErrorOr<void> append(AK::SIMD::u8x4 simd)
-            {
-                TRY(append(simd[0]));
-                TRY(append(simd[1]));
-                TRY(append(simd[2]));
-                TRY(append(simd[3]));
-                return {};
-            }
-        };
+        sub_filter.store(x, pixel - pixel_x_minus_1);
 
-        Filter none_filter { .type = PNG::FilterType::None };
-        TRY(none_filter.buffer.try_ensure_capacity(sizeof(Pixel) * bitmap.height()));
+        up_filter.store(x, pixel - pixel_y_minus_1);
+
+        // The sum Orig(a) + Orig(b) shall be performed without overflow (using at least nine-bit arithmetic).
+        auto sum = AK::SIMD::to_u16x4(pixel_x_minus_1) + AK::SIMD::to_u16x4(pixel_y_minus_1);
+        auto average = AK::SIMD::to_u8x4(sum / 2);
+        average_filter.store(x, pixel - average);
+
+        paeth_filter.store(x, pixel - PNG::paeth_predictor(pixel_x_minus_1, pixel_y_minus_1, pixel_xy_minus_1));
+
+        pixel_x_minus_1 = pixel;
+        pixel_xy_minus_1 = pixel_y_minus_1;
+    }
 
-        Filter sub_filter { .type = PNG::FilterType::Sub };
-        TRY(sub_filter.buffer.try_ensure_capacity(sizeof(Pixel) * bitmap.height()));
+    // 12.8 Filter selection: https://www.w3.org/TR/PNG/#12Filter-selection
+    // For best compression of truecolour and greyscale images, the recommended approach
+    // is adaptive filtering in which a filter is chosen for each scanline.
+    // The following simple heuristic has performed well in early tests:
+    // compute the output scanline using all five filters, and select the filter that gives the smallest sum of absolute values of outputs.
+    // (Consider the output bytes as signed differences for this test.)
+    Filter* best_filter = &none_filter;
+    for (auto* filter : { &sub_filter, &up_filter, &average_filter, &paeth_filter }) {
+        if (filter->sum < best_filter->sum)
+            best_filter = filter;
+    }
 
-        Filter up_filter { .type = PNG::FilterType::Up };
-        TRY(up_filter.buffer.try_ensure_capacity(sizeof(Pixel) * bitmap.height()));
+    output[0] = to_underlying(best_filter->type);
+    if (best_filter != &none_filter)
+        best_filter->buffer.copy_to(none_filter.buffer);
+}
 
-        Filter average_filter { .type = PNG::FilterType::Average };
-        TRY(average_filter.buffer.try_ensure_capacity(sizeof(ARGB32) * bitmap.height()));
+static ErrorOr<ByteBuffer> compress_segment(ReadonlyBytes data, Compress::DeflateCompressor::CompressionLevel compression_level, bool is_last_segment)
+{
+    AllocatingMemoryStream output_stream;
+    auto deflate_stream = TRY(Compress::DeflateCompressor::construct(MaybeOwned<Stream>(output_stream), compression_level));
+
+    TRY(deflate_stream->write_entire_buffer(data));
+    if (is_last_segment)
+        TRY(deflate_stream->final_flush());
+    else
+        TRY(deflate_stream->segment_flush());
+
+    auto buffer = TRY(ByteBuffer::create_uninitialized(output_stream.used_buffer_size()));
+    TRY(output_stream.read_entire_buffer(buffer));
+    return buffer;
+}
 
-        Filter paeth_filter { .type = PNG::FilterType::Paeth };
-        TRY(paeth_filter.buffer.try_ensure_capacity(sizeof(ARGB32) * bitmap.height()));
+static Compress::DeflateCompressor::CompressionLevel deflate_compression_level(PNGWriter::CompressionLevel compression_level)
+{
+    switch (compression_level) {
+    case PNGWriter::CompressionLevel::None:
+        return Compress::DeflateCompressor::CompressionLevel::STORE;
+    case PNGWriter::CompressionLevel::Fast:
+        return Compress::DeflateCompressor::CompressionLevel::FAST;
+    case PNGWriter::CompressionLevel::Default:
+        return Compress::DeflateCompressor::CompressionLevel::GOOD;
+    case PNGWriter::CompressionLevel::Best:
+        return Compress::DeflateCompressor::CompressionLevel::GREAT;
+    }
+    VERIFY_NOT_REACHED();
+}
 
-        auto pixel_x_minus_1 = Pixel::gfx_to_png(dummy_scanline[0]);
-        auto pixel_xy_minus_1 = Pixel::gfx_to_png(dummy_scanline[0]);
+static Compress::ZlibCompressionLevel zlib_compression_level(PNGWriter::CompressionLevel compression_level)
+{
+    switch (compression_level) {
+    case PNGWriter::CompressionLevel::None:
+        return Compress::ZlibCompressionLevel::Fastest;
+    case PNGWriter::CompressionLevel::Fast:
+        return Compress::ZlibCompressionLevel::Fast;
+    case PNGWriter::CompressionLevel::Default:
+        return Compress::ZlibCompressionLevel::Default;
+    case PNGWriter::CompressionLevel::Best:
+        return Compress::ZlibCompressionLevel::Best;
+    }
+    VERIFY_NOT_REACHED();
+}
 
-        for (int x = 0; x < bitmap.width(); ++x) {
-            auto pixel = Pixel::gfx_to_png(scanline[x]);
-            auto pixel_y_minus_1 = Pixel::gfx_to_png(scanline_minus_1[x]);
+ErrorOr<void> PNGWriter::add_IDAT_chunk(Gfx::Bitmap const& bitmap, CompressionLevel compression_level)
+{
+    size_t const width = bitmap.width();
+    size_t const height = bitmap.height();
+    size_t const filtered_scanline_size = 1 + width * sizeof(Pixel);
 
-            TRY(none_filter.append(pixel));
+    auto filtered_data = TRY(ByteBuffer::create_uninitialized(filtered_scanline_size * height));
+    auto dummy_scanline = TRY(FixedArray<Pixel>::create(width));
 
-            TRY(sub_filter.append(pixel - pixel_x_minus_1));
+    // Filtering doesn't help if the data isn't compressed anyway.
+    bool const adaptive_filtering = compression_level != CompressionLevel::None;
 
-            TRY(up_filter.append(pixel - pixel_y_minus_1));
+    size_t const scanlines_per_segment = max<size_t>(bytes_per_compressed_segment / filtered_scanline_size, 1);
+    size_t const segment_count = ceil_div(height, scanlines_per_segment);
 
-            // The sum Orig(a) + Orig(b) shall be performed without overflow (using at least nine-bit arithmetic).
-            auto sum = AK::SIMD::to_u16x4(pixel_x_minus_1) + AK::SIMD::to_u16x4(pixel_y_minus_1);
-            auto average = AK::SIMD::to_u8x4(sum / 2);
-            TRY(average_filter.append(pixel - average));
+    Vector<ErrorOr<ByteBuffer>> compressed_segments;
+    TRY(compressed_segments.try_ensure_capacity(segment_count));
+    for (size_t i = 0; i < segment_count; ++i)
+        compressed_segments.unchecked_append(ByteBuffer {});
 
-            TRY(paeth_filter.append(pixel - PNG::paeth_predictor(pixel_x_minus_1, pixel_y_minus_1, pixel_xy_minus_1)));
+    Threading::ThreadPool::the().parallel_for(segment_count, [&](size_t segment_index) {
+        compressed_segments[segment_index] = [&]() -> ErrorOr<ByteBuffer> {
+            auto const first_scanline = segment_index * scanlines_per_segment;
+            auto const scanline_count = min(scanlines_per_segment, height - first_scanline);
 
-            pixel_x_minus_1 = pixel;
-            pixel_xy_minus_1 = pixel_y_minus_1;
-        }
+            ByteBuffer scratch_buffer;
+            if (adaptive_filtering)
+                scratch_buffer = TRY(ByteBuffer::create_uninitialized(4 * width * sizeof(Pixel)));
 
-        scanline_minus_1 = scanline;
+            for (size_t y = first_scanline; y < first_scanline + scanline_count; ++y) {
+                auto const* scanline = reinterpret_cast<Pixel const*>(bitmap.scanline(y));
+                auto const* scanline_minus_1 = y == 0 ? dummy_scanline.data() : reinterpret_cast<Pixel const*>(bitmap.scanline(y - 1));
+                filter_scanline(filtered_data.bytes().slice(y * filtered_scanline_size, filtered_scanline_size), scanline, scanline_minus_1, width, adaptive_filtering, scratch_buffer);
+            }
 
-        // 12.8 Filter selection: https://www.w3.org/TR/PNG/#12Filter-selection
-        // For best compression of truecolour and greyscale images, the recommended approach
-        // is adaptive filtering in which a filter is chosen for each scanline.
-        // The following simple heuristic has performed well in early tests:
-        // compute the output scanline using all five filters, and select the filter that gives the smallest sum of absolute values of outputs.
-        // (Consider the output bytes as signed differences for this test.)
-        Filter& best_filter = none_filter;
-        if (abs(best_filter.sum) > abs(sub_filter.sum))
-            best_filter = sub_filter;
-        if (abs(best_filter.sum) > abs(up_filter.sum))
-            best_filter = up_filter;
-        if (abs(best_filter.sum) > abs(average_filter.sum))
-            best_filter = average_filter;
-        if (abs(best_filter.sum) > abs(paeth_filter.sum))
-            best_filter = paeth_filter;
+            auto segment = filtered_data.bytes().slice(first_scanline * filtered_scanline_size, scanline_count * filtered_scanline_size);
+            return compress_segment(segment, deflate_compression_level(compression_level), segment_index == segment_count - 1);
+        }();
+    });
 
-        TRY(uncompressed_block_data.try_append(to_underlying(best_filter.type)));
-        TRY(uncompressed_block_data.try_append(best_filter.buffer));
+    size_t compressed_size = 0;
+    for (auto& segment : compressed_segments) {
+        if (segment.is_error())
+            return segment.release_error();
+        compressed_size += segment.value().size();
     }
 
-    auto zlib_buffer = TRY(Compress::ZlibCompressor::compress_all(uncompressed_block_data, Compress::ZlibCompressionLevel::Best));
+    PNGChunk png_chunk { "IDAT" };
+    TRY(png_chunk.reserve(sizeof(Compress::ZlibHeader) + compressed_size + sizeof(u32)));
+
+    // The compressed segments together form a single deflate stream, which we wrap in a zlib stream here.
+    Compress::ZlibHeader header {
+        .compression_method = Compress::ZlibCompressionMethod::Deflate,
+        .compression_info = static_cast<u8>(AK::log2(Compress::DeflateCompressor::window_size) - 8),
+        .check_bits = 0,
+        .present_dictionary = false,
+        .compression_level = zlib_compression_level(compression_level),
+    };
+    header.check_bits = 0b11111 - header.as_u16 % 31;
+    TRY(png_chunk.add(header.as_u16.bytes().data(), sizeof(header)));
+
+    for (auto& segment : compressed_segments)
+        TRY(png_chunk.add(segment.value().data(), segment.value().size()));
+
+    TRY(png_chunk.add_as_big_endian(Crypto::Checksum::Adler32(filtered_data).digest()));
 
-    TRY(png_chunk.add(zlib_buffer.data(), zlib_buffer.size()));
     TRY(add_chunk(png_chunk));
     return {};
 }
 
-ErrorOr<ByteBuffer> PNGWriter::encode(Gfx::Bitmap const& bitmap)
+ErrorOr<ByteBuffer> PNGWriter::encode(Gfx::Bitmap const& bitmap, CompressionLevel compression_level)
 {
     PNGWriter writer;
     TRY(writer.add_png_header());
     TRY(writer.add_IHDR_chunk(bitmap.width(), bitmap.height(), 8, PNG::ColorType::TruecolorWithAlpha, 0, 0, 0));
-    TRY(writer.add_IDAT_chunk(bitmap));
+    TRY(writer.add_IDAT_chunk(bitmap, compression_level));
     TRY(writer.add_IEND_chunk());
     return ByteBuffer::copy(writer.m_data);
 }
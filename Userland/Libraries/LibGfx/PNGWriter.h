@@ -17,7 +17,15 @@ class PNGChunk;
 
 class PNGWriter {
 public:
-    static ErrorOr<ByteBuffer> encode(Gfx::Bitmap const&);
+    enum class CompressionLevel {
+        // Stores the image data as is, which is very fast, but results in large files.
+        None,
+        Fast,
+        Default,
+        Best,
+    };
+
+    static ErrorOr<ByteBuffer> encode(Gfx::Bitmap const&, CompressionLevel = CompressionLevel::Best);
 
 private:
     PNGWriter() = default;
@@ -26,7 +34,7 @@ private:
     ErrorOr<void> add_chunk(PNGChunk&);
     ErrorOr<void> add_png_header();
     ErrorOr<void> add_IHDR_chunk(u32 width, u32 height, u8 bit_depth, PNG::ColorType color_type, u8 compression_method, u8 filter_method, u8 interlace_method);
-    ErrorOr<void> add_IDAT_chunk(Gfx::Bitmap const&);
+    ErrorOr<void> add_IDAT_chunk(Gfx::Bitmap const&, CompressionLevel);
     ErrorOr<void> add_IEND_chunk();
 };
 
@@ -12,9 +12,9 @@
 
 #include "Painter.h"
 #include "Bitmap.h"
-#include "Font/Emoji.h"
 #include "Font/Font.h"
 #include "Gamma.h"
+#include <AK/Array.h>
 #include <AK/Assertions.h>
 #include <AK/Debug.h>
 #include <AK/Function.h>
@@ -22,6 +22,8 @@
 #include <AK/Memory.h>
 #include <AK/Queue.h>
 #include <AK/QuickSort.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <AK/StdLibExtras.h>
 #include <AK/StringBuilder.h>
 #include <AK/Utf32View.h>
@@ -31,10 +33,9 @@
 #include <LibGfx/Palette.h>
 #include <LibGfx/Path.h>
 #include <LibGfx/Quad.h>
+#include <LibGfx/Resampling.h>
 #include <LibGfx/TextDirection.h>
 #include <LibGfx/TextLayout.h>
-#include <LibUnicode/CharacterTypes.h>
-#include <LibUnicode/Emoji.h>
 #include <stdio.h>
 
 #if defined(AK_COMPILER_GCC)
@@ -116,6 +117,56 @@ void Painter::clear_rect(IntRect const& a_rect, Color color)
     }
 }
 
+// The blending kernels below work on 4 pixels at a time. When the destination is opaque, Color::blend() boils down to
+// (destination * (255 - alpha) + source * alpha) / 255 for each channel, which doesn't need any actual divisions.
+// They give exactly the same results as Color::blend(), and fall back to it for pixels that aren't opaque.
+static ALWAYS_INLINE AK::SIMD::u32x4 load_pixels(ARGB32 const* pixels)
+{
+    AK::SIMD::u32x4 vector;
+    __builtin_memcpy(&vector, pixels, sizeof(vector));
+    return vector;
+}
+
+static ALWAYS_INLINE void store_pixels(ARGB32* pixels, AK::SIMD::u32x4 vector)
+{
+    __builtin_memcpy(pixels, &vector, sizeof(vector));
+}
+
+static ALWAYS_INLINE bool all_pixels_are_opaque(AK::SIMD::u32x4 pixels)
+{
+    return AK::SIMD::all((pixels >> 24) == 0xff);
+}
+
+static ALWAYS_INLINE AK::SIMD::u32x4 blend_over_opaque_pixels(AK::SIMD::u32x4 destination, AK::SIMD::u32x4 source, AK::SIMD::u32x4 alpha)
+{
+    auto const inverse_alpha = 255 - alpha;
+    auto blend_channel = [&](u32 shift) {
+        auto value = ((destination >> shift) & 0xff) * inverse_alpha + ((source >> shift) & 0xff) * alpha;
+        // NOTE: This is the same as dividing by 255 for all values up to 255 * 255.
+        return ((value + 1 + (value >> 8)) >> 8) << shift;
+    };
+    return 0xff000000 | blend_channel(16) | blend_channel(8) | blend_channel(0);
+}
+
+static void blend_color_over_pixels(ARGB32* pixels, int count, Color color)
+{
+    auto const source = AK::SIMD::expand4(color.value());
+    auto const alpha = AK::SIMD::expand4(static_cast<u32>(color.alpha()));
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        auto destination = load_pixels(pixels + i);
+        if (all_pixels_are_opaque(destination)) {
+            store_pixels(pixels + i, blend_over_opaque_pixels(destination, source, alpha));
+            continue;
+        }
+        for (int j = i; j < i + 4; ++j)
+            pixels[j] = Color::from_argb(pixels[j]).blend(color).value();
+    }
+    for (; i < count; ++i)
+        pixels[i] = Color::from_argb(pixels[i]).blend(color).value();
+}
+
 void Painter::fill_physical_rect(IntRect const& physical_rect, Color color)
 {
     // Callers must do clipping.
@@ -123,8 +174,7 @@ void Painter::fill_physical_rect(IntRect const& physical_rect, Color color)
     size_t const dst_skip = m_target->pitch() / sizeof(ARGB32);
 
     for (int i = physical_rect.height() - 1; i >= 0; --i) {
-        for (int j = 0; j < physical_rect.width(); ++j)
-            dst[j] = Color::from_argb(dst[j]).blend(color).value();
+        blend_color_over_pixels(dst, physical_rect.width(), color);
         dst += dst_skip;
     }
 }
@@ -846,28 +896,62 @@ static void swap_red_and_blue_channels(Color& color)
     color = Color::from_argb(bgra);
 }
 
-// FIXME: This function is very unoptimized.
 template<BlitState::AlphaState has_alpha>
 static void do_blit_with_opacity(BlitState& state)
 {
+    // NOTE: The alpha of a source pixel only depends on its own alpha, so we work it out once for every possible value.
+    Array<u8, 256> source_alpha_with_opacity;
+    for (size_t alpha = 0; alpha < source_alpha_with_opacity.size(); ++alpha) {
+        float pixel_opacity = alpha / 255.0;
+        source_alpha_with_opacity[alpha] = 255 * (state.opacity * pixel_opacity);
+    }
+    u8 const opaque_source_alpha_with_opacity = state.opacity * 255;
+
+    auto blit_pixel = [&](int x) {
+        Color dest_color = (has_alpha & BlitState::DstAlpha) ? Color::from_argb(state.dst[x]) : Color::from_rgb(state.dst[x]);
+        Color src_color_with_alpha = Color::from_argb(state.src[x]);
+        if (state.src_format == BitmapFormat::RGBA8888)
+            swap_red_and_blue_channels(src_color_with_alpha);
+        if constexpr (has_alpha & BlitState::SrcAlpha)
+            src_color_with_alpha.set_alpha(source_alpha_with_opacity[src_color_with_alpha.alpha()]);
+        else
+            src_color_with_alpha.set_alpha(opaque_source_alpha_with_opacity);
+        state.dst[x] = dest_color.blend(src_color_with_alpha).value();
+    };
+
     for (int row = 0; row < state.row_count; ++row) {
-        for (int x = 0; x < state.column_count; ++x) {
-            Color dest_color = (has_alpha & BlitState::DstAlpha) ? Color::from_argb(state.dst[x]) : Color::from_rgb(state.dst[x]);
+        int x = 0;
+        for (; x + 4 <= state.column_count; x += 4) {
+            auto destination = load_pixels(state.dst + x);
+            if constexpr (has_alpha & BlitState::DstAlpha) {
+                if (!all_pixels_are_opaque(destination)) {
+                    for (int i = x; i < x + 4; ++i)
+                        blit_pixel(i);
+                    continue;
+                }
+            }
+
+            auto source = load_pixels(state.src + x);
+            if (state.src_format == BitmapFormat::RGBA8888)
+                source = (source & 0xff00ff00) | ((source & 0x000000ff) << 16) | ((source & 0x00ff0000) >> 16);
+
+            AK::SIMD::u32x4 alpha;
             if constexpr (has_alpha & BlitState::SrcAlpha) {
-                Color src_color_with_alpha = Color::from_argb(state.src[x]);
-                if (state.src_format == BitmapFormat::RGBA8888)
-                    swap_red_and_blue_channels(src_color_with_alpha);
-                float pixel_opacity = src_color_with_alpha.alpha() / 255.0;
-                src_color_with_alpha.set_alpha(255 * (state.opacity * pixel_opacity));
-                state.dst[x] = dest_color.blend(src_color_with_alpha).value();
+                alpha = AK::SIMD::u32x4 {
+                    source_alpha_with_opacity[source[0] >> 24],
+                    source_alpha_with_opacity[source[1] >> 24],
+                    source_alpha_with_opacity[source[2] >> 24],
+                    source_alpha_with_opacity[source[3] >> 24],
+                };
             } else {
-                Color src_color_with_alpha = Color::from_rgb(state.src[x]);
-                if (state.src_format == BitmapFormat::RGBA8888)
-                    swap_red_and_blue_channels(src_color_with_alpha);
-                src_color_with_alpha.set_alpha(state.opacity * 255);
-                state.dst[x] = dest_color.blend(src_color_with_alpha).value();
+                alpha = AK::SIMD::expand4(static_cast<u32>(opaque_source_alpha_with_opacity));
             }
+
+            store_pixels(state.dst + x, blend_over_opaque_pixels(destination, source, alpha));
         }
+        for (; x < state.column_count; ++x)
+            blit_pixel(x);
+
         state.dst += state.dst_pitch;
         state.src += state.src_pitch;
     }
@@ -1287,6 +1371,10 @@ ALWAYS_INLINE static void do_draw_scaled_bitmap(Gfx::Bitmap& target, IntRect con
         do_draw_scaled_bitmap<has_alpha_channel, Painter::ScalingMode::SmoothPixels>(target, dst_rect, clipped_rect, source, src_rect, get_pixel, opacity);
         break;
     case Painter::ScalingMode::BilinearBlend:
+    case Painter::ScalingMode::BoxSampling:
+    case Painter::ScalingMode::Bicubic:
+    case Painter::ScalingMode::Lanczos:
+        // NOTE: The filtered scaling modes only end up here if we failed to allocate memory for resampling.
         do_draw_scaled_bitmap<has_alpha_channel, Painter::ScalingMode::BilinearBlend>(target, dst_rect, clipped_rect, source, src_rect, get_pixel, opacity);
         break;
     case Painter::ScalingMode::None:
@@ -1295,6 +1383,45 @@ ALWAYS_INLINE static void do_draw_scaled_bitmap(Gfx::Bitmap& target, IntRect con
     }
 }
 
+static Optional<ResamplingFilter> resampling_filter_for_scaling_mode(Painter::ScalingMode scaling_mode, FloatSize src_size, IntSize dst_size)
+{
+    switch (scaling_mode) {
+    case Painter::ScalingMode::BoxSampling:
+        return ResamplingFilter::Box;
+    case Painter::ScalingMode::Bicubic:
+        return ResamplingFilter::Bicubic;
+    case Painter::ScalingMode::Lanczos:
+        return ResamplingFilter::Lanczos3;
+    case Painter::ScalingMode::BilinearBlend:
+        // Blending the 4 nearest pixels is fine for upscaling, but skips over most of the source pixels when downscaling.
+        if (src_size.width() > dst_size.width() || src_size.height() > dst_size.height())
+            return ResamplingFilter::Bilinear;
+        return {};
+    default:
+        return {};
+    }
+}
+
+static ErrorOr<void> draw_resampled_bitmap(Gfx::Bitmap& target, IntRect const& dst_rect, IntRect const& clipped_rect, Gfx::Bitmap const& source, FloatRect const& src_rect, float opacity, ResamplingFilter filter)
+{
+    auto resampled = TRY(resample_bitmap(source, src_rect, dst_rect.size(), clipped_rect.translated(-dst_rect.location()), filter));
+
+    for (int y = 0; y < clipped_rect.height(); ++y) {
+        auto const* src = resampled->scanline(y);
+        auto* dst = target.scanline(clipped_rect.y() + y) + clipped_rect.x();
+        for (int x = 0; x < clipped_rect.width(); ++x) {
+            auto color = Color::from_argb(src[x]);
+            if (opacity != 1.0f)
+                color.set_alpha(color.alpha() * opacity);
+            if (color.alpha() == 255)
+                dst[x] = color.value();
+            else
+                dst[x] = Color::from_argb(dst[x]).blend(color).value();
+        }
+    }
+    return {};
+}
+
 void Painter::draw_scaled_bitmap(IntRect const& a_dst_rect, Gfx::Bitmap const& source, IntRect const& a_src_rect, float opacity, ScalingMode scaling_mode)
 {
     draw_scaled_bitmap(a_dst_rect, source, FloatRect { a_src_rect }, opacity, scaling_mode);
@@ -1317,6 +1444,11 @@ void Painter::draw_scaled_bitmap(IntRect const& a_dst_rect, Gfx::Bitmap const& s
     if (clipped_rect.is_empty())
         return;
 
+    if (auto filter = resampling_filter_for_scaling_mode(scaling_mode, src_rect.size(), dst_rect.size()); filter.has_value()) {
+        if (!draw_resampled_bitmap(*m_target, dst_rect, clipped_rect, source, src_rect, opacity, *filter).is_error())
+            return;
+    }
+
     if (source.has_alpha_channel() || opacity != 1.0f) {
         switch (source.format()) {
         case BitmapFormat::BGRx8888:
@@ -1397,47 +1529,13 @@ void Painter::draw_glyph_or_emoji(FloatPoint point, u32 code_point, Font const&
 
 void Painter::draw_glyph_or_emoji(FloatPoint point, Utf8CodePointIterator& it, Font const& font, Color color)
 {
-    u32 code_point = *it;
-    auto next_code_point = it.peek(1);
-
-    ScopeGuard consume_variation_selector = [&, initial_it = it] {
-        static auto const variation_selector = Unicode::property_from_string("Variation_Selector"sv);
-        if (!variation_selector.has_value())
-            return;
-
-        // If we advanced the iterator to consume an emoji sequence, don't look for another variation selector.
-        if (initial_it != it)
-            return;
-
-        // Otherwise, discard one code point if it's a variation selector.
-        if (next_code_point.has_value() && Unicode::code_point_has_property(*next_code_point, *variation_selector))
-            ++it;
-    };
-
-    auto font_contains_glyph = font.contains_glyph(code_point);
-    auto check_for_emoji = Unicode::could_be_start_of_emoji_sequence(it, font_contains_glyph ? Unicode::SequenceType::EmojiPresentation : Unicode::SequenceType::Any);
-
-    // If the font contains the glyph, and we know it's not the start of an emoji, draw a text glyph.
-    if (font_contains_glyph && !check_for_emoji) {
-        draw_glyph(point, code_point, font, color);
-        return;
-    }
-
-    // If we didn't find a text glyph, or have an emoji variation selector or regional indicator, try to draw an emoji glyph.
-    if (auto const* emoji = Emoji::emoji_for_code_point_iterator(it)) {
-        draw_emoji(point.to_type<int>(), *emoji, font);
-        return;
-    }
-
-    // If that failed, but we have a text glyph fallback, draw that.
-    if (font_contains_glyph) {
-        draw_glyph(point, code_point, font, color);
-        return;
-    }
-
-    // No suitable glyph found, draw a replacement character.
-    dbgln_if(EMOJI_DEBUG, "Failed to find a glyph or emoji for code_point {}", code_point);
-    draw_glyph(point, 0xFFFD, font, color);
+    prepare_draw_glyph_or_emoji(point, it, font).visit(
+        [&](DrawGlyph const& glyph) {
+            draw_glyph(glyph.position, glyph.code_point, font, color);
+        },
+        [&](DrawEmoji const& emoji) {
+            draw_emoji(emoji.position.to_type<int>(), *emoji.emoji, font);
+        });
 }
 
 void Painter::draw_glyph(IntPoint point, u32 code_point, Color color)
@@ -2385,8 +2483,7 @@ void Painter::stroke_path(Path const& path, Color color, int thickness)
 void Painter::fill_path(Path const& path, Color color, WindingRule winding_rule)
 {
     VERIFY(scale() == 1); // FIXME: Add scaling support.
-    Detail::fill_path<Detail::FillPathMode::PlaceOnIntGrid>(
-        *this, path, [=](IntPoint) { return color; }, winding_rule);
+    Detail::fill_path<Detail::FillPathMode::PlaceOnIntGrid>(*this, path, color, winding_rule);
 }
 
 void Painter::fill_path(Path const& path, PaintStyle const& paint_style, Painter::WindingRule rule)
@@ -2489,32 +2586,27 @@ void Painter::draw_text_run(IntPoint baseline_start, Utf8View const& string, Fon
 
 void Painter::draw_text_run(FloatPoint baseline_start, Utf8View const& string, Font const& font, Color color)
 {
-    float space_width = font.glyph_width(' ') + font.glyph_spacing();
-
-    u32 last_code_point = 0;
-
-    auto point = baseline_start;
-    point.translate_by(0, -font.pixel_metrics().ascent);
-
-    for (auto code_point_iterator = string.begin(); code_point_iterator != string.end(); ++code_point_iterator) {
-        auto code_point = *code_point_iterator;
-        if (should_paint_as_space(code_point)) {
-            point.translate_by(space_width, 0);
-            last_code_point = code_point;
-            continue;
-        }
-
-        auto kerning = font.glyphs_horizontal_kerning(last_code_point, code_point);
-        if (kerning != 0.0f)
-            point.translate_by(kerning, 0);
-
-        auto it = code_point_iterator; // The callback function will advance the iterator, so create a copy for this lookup.
-        auto glyph_width = font.glyph_or_emoji_width(it) + font.glyph_spacing();
-
-        draw_glyph_or_emoji(point, code_point_iterator, font, color);
+    for_each_glyph_position(baseline_start, string, font, [&](DrawGlyphOrEmoji const& glyph_or_emoji) {
+        glyph_or_emoji.visit(
+            [&](DrawGlyph const& glyph) {
+                draw_glyph(glyph.position, glyph.code_point, font, color);
+            },
+            [&](DrawEmoji const& emoji) {
+                draw_emoji(emoji.position.to_type<int>(), *emoji.emoji, font);
+            });
+    });
+}
 
-        point.translate_by(glyph_width, 0);
-        last_code_point = code_point;
+void Painter::draw_glyph_run(FloatPoint baseline_start, ReadonlySpan<DrawGlyphOrEmoji> glyph_run, Font const& font, Color color)
+{
+    for (auto const& glyph_or_emoji : glyph_run) {
+        glyph_or_emoji.visit(
+            [&](DrawGlyph const& glyph) {
+                draw_glyph(baseline_start + glyph.position, glyph.code_point, font, color);
+            },
+            [&](DrawEmoji const& emoji) {
+                draw_emoji((baseline_start + emoji.position).to_type<int>(), *emoji.emoji, font);
+            });
     }
 }
 
@@ -21,6 +21,7 @@
 #include <LibGfx/TextAlignment.h>
 #include <LibGfx/TextDirection.h>
 #include <LibGfx/TextElision.h>
+#include <LibGfx/TextLayout.h>
 #include <LibGfx/TextWrapping.h>
 
 namespace Gfx {
@@ -43,6 +44,10 @@ public:
         NearestNeighbor,
         SmoothPixels,
         BilinearBlend,
+        // Averages all covered source pixels, which makes for fast and clean downscaling (e.g. for thumbnails).
+        BoxSampling,
+        Bicubic,
+        Lanczos,
         None,
     };
 
@@ -117,6 +122,9 @@ public:
     void draw_text_run(IntPoint baseline_start, Utf8View const&, Font const&, Color);
     void draw_text_run(FloatPoint baseline_start, Utf8View const&, Font const&, Color);
 
+    // Draws glyphs that were positioned by for_each_glyph_position() relative to a baseline start of (0, 0).
+    void draw_glyph_run(FloatPoint baseline_start, ReadonlySpan<DrawGlyphOrEmoji>, Font const&, Color);
+
     enum class CornerOrientation {
         TopLeft,
         TopRight,
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/FixedArray.h>
+#include <AK/Math.h>
+#include <AK/NumericLimits.h>
+#include <AK/SIMD.h>
+#include <AK/Vector.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Resampling.h>
+
+namespace Gfx {
+
+using AK::SIMD::f32x4;
+
+static float filter_radius(ResamplingFilter filter)
+{
+    switch (filter) {
+    case ResamplingFilter::Box:
+        return 0.5f;
+    case ResamplingFilter::Bilinear:
+        return 1.0f;
+    case ResamplingFilter::Bicubic:
+        return 2.0f;
+    case ResamplingFilter::Lanczos3:
+        return 3.0f;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+static float sinc(float x)
+{
+    if (x == 0.0f)
+        return 1.0f;
+    x *= AK::Pi<float>;
+    return AK::sin(x) / x;
+}
+
+static float evaluate_filter(ResamplingFilter filter, float x)
+{
+    x = fabsf(x);
+    switch (filter) {
+    case ResamplingFilter::Box:
+        return x <= 0.5f ? 1.0f : 0.0f;
+    case ResamplingFilter::Bilinear:
+        return x < 1.0f ? 1.0f - x : 0.0f;
+    case ResamplingFilter::Bicubic:
+        if (x < 1.0f)
+            return (1.5f * x - 2.5f) * x * x + 1.0f;
+        if (x < 2.0f)
+            return ((-0.5f * x + 2.5f) * x - 4.0f) * x + 2.0f;
+        return 0.0f;
+    case ResamplingFilter::Lanczos3:
+        return x < 3.0f ? sinc(x) * sinc(x / 3.0f) : 0.0f;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+// The source pixels that contribute to each destination pixel along one axis, and how much they contribute.
+struct ResamplingWeights {
+    size_t max_taps { 0 };
+    Vector<int> first_source_pixel;
+    Vector<int> source_pixel_count;
+    // `max_taps` weights for every destination pixel.
+    Vector<float> weights;
+
+    float const* weights_for(size_t index) const { return weights.data() + index * max_taps; }
+};
+
+static ErrorOr<ResamplingWeights> compute_resampling_weights(ResamplingFilter filter, float source_start, float source_length, int source_min, int source_end, int destination_length, int first_destination, int destination_count)
+{
+    auto const scale = source_length / static_cast<float>(destination_length);
+    // When downscaling, the filter is stretched so that it covers all source pixels that fall into one destination pixel.
+    auto const filter_scale = max(scale, 1.0f);
+    auto const support = filter_radius(filter) * filter_scale;
+
+    ResamplingWeights table;
+    table.max_taps = static_cast<size_t>(ceilf(support * 2.0f)) + 2;
+    TRY(table.first_source_pixel.try_resize(destination_count));
+    TRY(table.source_pixel_count.try_resize(destination_count));
+    TRY(table.weights.try_resize(destination_count * table.max_taps));
+
+    for (int i = 0; i < destination_count; ++i) {
+        // Pixel centers are at half-integer coordinates.
+        auto const center = source_start + (static_cast<float>(first_destination + i) + 0.5f) * scale;
+        auto first = max(static_cast<int>(floorf(center - support - 0.5f)), source_min);
+        auto end = min(static_cast<int>(ceilf(center + support - 0.5f)) + 1, source_end);
+        end = min(end, first + static_cast<int>(table.max_taps));
+
+        auto* weights = table.weights.data() + i * table.max_taps;
+        float total = 0.0f;
+        for (int j = first; j < end; ++j) {
+            auto weight = evaluate_filter(filter, (static_cast<float>(j) + 0.5f - center) / filter_scale);
+            weights[j - first] = weight;
+            total += weight;
+        }
+
+        if (total == 0.0f) {
+            // This only happens on the very edges of the source rect, where the nearest pixel will have to do.
+            first = clamp(static_cast<int>(floorf(center)), source_min, source_end - 1);
+            end = first + 1;
+            weights[0] = 1.0f;
+        } else {
+            for (int j = 0; j < end - first; ++j)
+                weights[j] /= total;
+        }
+
+        table.first_source_pixel[i] = first;
+        table.source_pixel_count[i] = end - first;
+    }
+
+    return table;
+}
+
+// Filtering has to happen on premultiplied colors, or transparent pixels would bleed their (invisible) color into their neighbors.
+ALWAYS_INLINE static f32x4 to_premultiplied(Color color)
+{
+    auto const alpha = static_cast<float>(color.alpha());
+    auto const factor = alpha / 255.0f;
+    return f32x4 { color.blue() * factor, color.green() * factor, color.red() * factor, alpha };
+}
+
+ALWAYS_INLINE static ARGB32 to_unpremultiplied_argb(f32x4 color)
+{
+    // Filters with negative lobes can overshoot, so everything has to be clamped.
+    auto const alpha = clamp(color[3], 0.0f, 255.0f);
+    if (alpha < 0.5f)
+        return 0;
+    auto const factor = 255.0f / alpha;
+    auto channel = [&](size_t index) -> u8 {
+        return static_cast<u8>(clamp(color[index] * factor, 0.0f, 255.0f) + 0.5f);
+    };
+    return Color(channel(2), channel(1), channel(0), static_cast<u8>(alpha + 0.5f)).value();
+}
+
+static void load_premultiplied_row(Bitmap const& source, int y, int first_x, Span<f32x4> row)
+{
+    switch (source.format()) {
+    case BitmapFormat::BGRx8888: {
+        auto const* scanline = source.scanline(y) + first_x;
+        for (size_t i = 0; i < row.size(); ++i)
+            row[i] = to_premultiplied(Color::from_rgb(scanline[i]));
+        break;
+    }
+    case BitmapFormat::BGRA8888: {
+        auto const* scanline = source.scanline(y) + first_x;
+        for (size_t i = 0; i < row.size(); ++i)
+            row[i] = to_premultiplied(Color::from_argb(scanline[i]));
+        break;
+    }
+    default:
+        for (size_t i = 0; i < row.size(); ++i)
+            row[i] = to_premultiplied(source.get_pixel(first_x + i, y));
+        break;
+    }
+}
+
+ErrorOr<NonnullRefPtr<Bitmap>> resample_bitmap(Bitmap const& source, FloatRect const& source_rect, IntSize destination_size, IntRect const& destination_subrect, ResamplingFilter filter)
+{
+    auto clipped_source_rect = enclosing_int_rect(source_rect).intersected(source.rect());
+    if (clipped_source_rect.is_empty() || destination_size.is_empty() || destination_subrect.is_empty())
+        return Error::from_string_literal("Nothing to resample");
+
+    auto horizontal_weights = TRY(compute_resampling_weights(filter, source_rect.x(), source_rect.width(), clipped_source_rect.left(), clipped_source_rect.right() + 1, destination_size.width(), destination_subrect.x(), destination_subrect.width()));
+    auto vertical_weights = TRY(compute_resampling_weights(filter, source_rect.y(), source_rect.height(), clipped_source_rect.top(), clipped_source_rect.bottom() + 1, destination_size.height(), destination_subrect.y(), destination_subrect.height()));
+
+    // Only the source pixels that actually contribute to the requested part of the result have to be looked at.
+    struct SourceRange {
+        int first;
+        int end;
+    };
+    auto contributing_source_range = [](ResamplingWeights const& weights) {
+        int first = NumericLimits<int>::max();
+        int end = NumericLimits<int>::min();
+        for (size_t i = 0; i < weights.first_source_pixel.size(); ++i) {
+            first = min(first, weights.first_source_pixel[i]);
+            end = max(end, weights.first_source_pixel[i] + weights.source_pixel_count[i]);
+        }
+        return SourceRange { first, end };
+    };
+    auto const [first_source_x, source_x_end] = contributing_source_range(horizontal_weights);
+    auto const [first_source_y, source_y_end] = contributing_source_range(vertical_weights);
+
+    auto const destination_width = static_cast<size_t>(destination_subrect.width());
+
+    // First pass: Resample every contributing source row horizontally.
+    auto source_row = TRY(FixedArray<f32x4>::create(source_x_end - first_source_x));
+    auto horizontally_resampled = TRY(FixedArray<f32x4>::create((source_y_end - first_source_y) * destination_width));
+
+    for (int y = first_source_y; y < source_y_end; ++y) {
+        load_premultiplied_row(source, y, first_source_x, source_row.span());
+        auto* output_row = horizontally_resampled.data() + (y - first_source_y) * destination_width;
+        for (size_t x = 0; x < destination_width; ++x) {
+            auto const* input = source_row.data() + (horizontal_weights.first_source_pixel[x] - first_source_x);
+            auto const* weights = horizontal_weights.weights_for(x);
+            f32x4 sum {};
+            for (int tap = 0; tap < horizontal_weights.source_pixel_count[x]; ++tap)
+                sum += input[tap] * weights[tap];
+            output_row[x] = sum;
+        }
+    }
+
+    // Second pass: Combine the horizontally resampled rows vertically.
+    auto result = TRY(Bitmap::create(BitmapFormat::BGRA8888, destination_subrect.size()));
+    auto accumulator = TRY(FixedArray<f32x4>::create(destination_width));
+
+    for (int y = 0; y < destination_subrect.height(); ++y) {
+        for (auto& sum : accumulator)
+            sum = f32x4 {};
+        auto const* weights = vertical_weights.weights_for(y);
+        for (int tap = 0; tap < vertical_weights.source_pixel_count[y]; ++tap) {
+            auto const* input_row = horizontally_resampled.data() + (vertical_weights.first_source_pixel[y] + tap - first_source_y) * destination_width;
+            auto const weight = weights[tap];
+            for (size_t x = 0; x < destination_width; ++x)
+                accumulator[x] += input_row[x] * weight;
+        }
+
+        auto* scanline = result->scanline(y);
+        for (size_t x = 0; x < destination_width; ++x)
+            scanline[x] = to_unpremultiplied_argb(accumulator[x]);
+    }
+
+    return result;
+}
+
+}
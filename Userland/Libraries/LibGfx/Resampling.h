@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Error.h>
+#include <AK/NonnullRefPtr.h>
+#include <LibGfx/Forward.h>
+#include <LibGfx/Rect.h>
+
+namespace Gfx {
+
+enum class ResamplingFilter {
+    // Averages all source pixels that are covered by a destination pixel, or picks the nearest one when upscaling.
+    Box,
+    Bilinear,
+    // Catmull-Rom spline.
+    Bicubic,
+    Lanczos3,
+};
+
+// Resamples `source_rect` of `source` to a bitmap of `destination_size`, but only computes the part of it within `destination_subrect`.
+// The filter is applied separably, with the weights for every row and column computed up front. When downscaling, the filter is
+// widened so that every source pixel contributes to the result, which avoids aliasing.
+ErrorOr<NonnullRefPtr<Bitmap>> resample_bitmap(Bitmap const& source, FloatRect const& source_rect, IntSize destination_size, IntRect const& destination_subrect, ResamplingFilter);
+
+}
@@ -6,6 +6,11 @@
  */
 
 #include "TextLayout.h"
+#include <AK/Debug.h>
+#include <AK/ScopeGuard.h>
+#include <LibGfx/Font/Emoji.h>
+#include <LibUnicode/CharacterTypes.h>
+#include <LibUnicode/Emoji.h>
 
 namespace Gfx {
 
@@ -192,4 +197,79 @@ DeprecatedString TextLayout::elide_text_from_right(Utf8View text) const
     return text.as_string();
 }
 
+DrawGlyphOrEmoji prepare_draw_glyph_or_emoji(FloatPoint point, Utf8CodePointIterator& it, Font const& font)
+{
+    u32 code_point = *it;
+    auto next_code_point = it.peek(1);
+
+    ScopeGuard consume_variation_selector = [&, initial_it = it] {
+        static auto const variation_selector = Unicode::property_from_string("Variation_Selector"sv);
+        if (!variation_selector.has_value())
+            return;
+
+        // If we advanced the iterator to consume an emoji sequence, don't look for another variation selector.
+        if (initial_it != it)
+            return;
+
+        // Otherwise, discard one code point if it's a variation selector.
+        if (next_code_point.has_value() && Unicode::code_point_has_property(*next_code_point, *variation_selector))
+            ++it;
+    };
+
+    auto font_contains_glyph = font.contains_glyph(code_point);
+    auto check_for_emoji = Unicode::could_be_start_of_emoji_sequence(it, font_contains_glyph ? Unicode::SequenceType::EmojiPresentation : Unicode::SequenceType::Any);
+
+    // If the font contains the glyph, and we know it's not the start of an emoji, draw a text glyph.
+    if (font_contains_glyph && !check_for_emoji)
+        return DrawGlyph { point, code_point };
+
+    // If we didn't find a text glyph, or have an emoji variation selector or regional indicator, try to draw an emoji glyph.
+    if (auto const* emoji = Emoji::emoji_for_code_point_iterator(it))
+        return DrawEmoji { point, emoji };
+
+    // If that failed, but we have a text glyph fallback, draw that.
+    if (font_contains_glyph)
+        return DrawGlyph { point, code_point };
+
+    // No suitable glyph found, draw a replacement character.
+    dbgln_if(EMOJI_DEBUG, "Failed to find a glyph or emoji for code_point {}", code_point);
+    return DrawGlyph { point, 0xFFFD };
+}
+
+static bool should_paint_as_space(u32 code_point)
+{
+    return is_ascii_space(code_point) || code_point == 0xa0;
+}
+
+void for_each_glyph_position(FloatPoint baseline_start, Utf8View const& string, Font const& font, Function<void(DrawGlyphOrEmoji const&)> callback)
+{
+    float space_width = font.glyph_width(' ') + font.glyph_spacing();
+
+    u32 last_code_point = 0;
+
+    auto point = baseline_start;
+    point.translate_by(0, -font.pixel_metrics().ascent);
+
+    for (auto code_point_iterator = string.begin(); code_point_iterator != string.end(); ++code_point_iterator) {
+        auto code_point = *code_point_iterator;
+        if (should_paint_as_space(code_point)) {
+            point.translate_by(space_width, 0);
+            last_code_point = code_point;
+            continue;
+        }
+
+        auto kerning = font.glyphs_horizontal_kerning(last_code_point, code_point);
+        if (kerning != 0.0f)
+            point.translate_by(kerning, 0);
+
+        auto it = code_point_iterator; // The preparation will advance the iterator, so create a copy for this lookup.
+        auto glyph_width = font.glyph_or_emoji_width(it) + font.glyph_spacing();
+
+        callback(prepare_draw_glyph_or_emoji(point, code_point_iterator, font));
+
+        point.translate_by(glyph_width, 0);
+        last_code_point = code_point;
+    }
+}
+
 }
@@ -11,6 +11,7 @@
 #include <AK/Forward.h>
 #include <AK/Utf32View.h>
 #include <AK/Utf8View.h>
+#include <AK/Variant.h>
 #include <AK/Vector.h>
 #include <LibGfx/Font/Font.h>
 #include <LibGfx/Forward.h>
@@ -64,4 +65,23 @@ private:
     FloatRect m_rect;
 };
 
+struct DrawGlyph {
+    FloatPoint position;
+    u32 code_point;
+};
+
+struct DrawEmoji {
+    FloatPoint position;
+    Gfx::Bitmap const* emoji;
+};
+
+using DrawGlyphOrEmoji = Variant<DrawGlyph, DrawEmoji>;
+
+// Decides whether the code point at the iterator is drawn as a glyph from the font or as an emoji.
+// The iterator is advanced past any code points that belong to the same emoji sequence.
+DrawGlyphOrEmoji prepare_draw_glyph_or_emoji(FloatPoint, Utf8CodePointIterator&, Font const&);
+
+// Positions the glyphs and emojis of a single line of text, the way Painter::draw_text_run() draws them.
+void for_each_glyph_position(FloatPoint baseline_start, Utf8View const&, Font const&, Function<void(DrawGlyphOrEmoji const&)>);
+
 }
@@ -0,0 +1,469 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <LibHTTP/HPack.h>
+
+namespace HTTP::HPack {
+
+struct StaticTableEntry {
+    StringView name;
+    StringView value;
+};
+
+// RFC7541 appendix A
+static constexpr Array<StaticTableEntry, 61> static_table { {
+    { ":authority"sv, ""sv },
+    { ":method"sv, "GET"sv },
+    { ":method"sv, "POST"sv },
+    { ":path"sv, "/"sv },
+    { ":path"sv, "/index.html"sv },
+    { ":scheme"sv, "http"sv },
+    { ":scheme"sv, "https"sv },
+    { ":status"sv, "200"sv },
+    { ":status"sv, "204"sv },
+    { ":status"sv, "206"sv },
+    { ":status"sv, "304"sv },
+    { ":status"sv, "400"sv },
+    { ":status"sv, "404"sv },
+    { ":status"sv, "500"sv },
+    { "accept-charset"sv, ""sv },
+    { "accept-encoding"sv, "gzip, deflate"sv },
+    { "accept-language"sv, ""sv },
+    { "accept-ranges"sv, ""sv },
+    { "accept"sv, ""sv },
+    { "access-control-allow-origin"sv, ""sv },
+    { "age"sv, ""sv },
+    { "allow"sv, ""sv },
+    { "authorization"sv, ""sv },
+    { "cache-control"sv, ""sv },
+    { "content-disposition"sv, ""sv },
+    { "content-encoding"sv, ""sv },
+    { "content-language"sv, ""sv },
+    { "content-length"sv, ""sv },
+    { "content-location"sv, ""sv },
+    { "content-range"sv, ""sv },
+    { "content-type"sv, ""sv },
+    { "cookie"sv, ""sv },
+    { "date"sv, ""sv },
+    { "etag"sv, ""sv },
+    { "expect"sv, ""sv },
+    { "expires"sv, ""sv },
+    { "from"sv, ""sv },
+    { "host"sv, ""sv },
+    { "if-match"sv, ""sv },
+    { "if-modified-since"sv, ""sv },
+    { "if-none-match"sv, ""sv },
+    { "if-range"sv, ""sv },
+    { "if-unmodified-since"sv, ""sv },
+    { "last-modified"sv, ""sv },
+    { "link"sv, ""sv },
+    { "location"sv, ""sv },
+    { "max-forwards"sv, ""sv },
+    { "proxy-authenticate"sv, ""sv },
+    { "proxy-authorization"sv, ""sv },
+    { "range"sv, ""sv },
+    { "referer"sv, ""sv },
+    { "refresh"sv, ""sv },
+    { "retry-after"sv, ""sv },
+    { "server"sv, ""sv },
+    { "set-cookie"sv, ""sv },
+    { "strict-transport-security"sv, ""sv },
+    { "transfer-encoding"sv, ""sv },
+    { "user-agent"sv, ""sv },
+    { "vary"sv, ""sv },
+    { "via"sv, ""sv },
+    { "www-authenticate"sv, ""sv },
+} };
+
+// RFC7541 appendix B, the code of each symbol (the last one being EOS) and its length in bits.
+struct HuffmanCode {
+    u32 code;
+    u8 length;
+};
+static constexpr Array<HuffmanCode, 257> huffman_codes { {
+    { 0x1ff8, 13 }, { 0x7fffd8, 23 }, { 0xfffffe2, 28 }, { 0xfffffe3, 28 },
+    { 0xfffffe4, 28 }, { 0xfffffe5, 28 }, { 0xfffffe6, 28 }, { 0xfffffe7, 28 },
+    { 0xfffffe8, 28 }, { 0xffffea, 24 }, { 0x3ffffffc, 30 }, { 0xfffffe9, 28 },
+    { 0xfffffea, 28 }, { 0x3ffffffd, 30 }, { 0xfffffeb, 28 }, { 0xfffffec, 28 },
+    { 0xfffffed, 28 }, { 0xfffffee, 28 }, { 0xfffffef, 28 }, { 0xffffff0, 28 },
+    { 0xffffff1, 28 }, { 0xffffff2, 28 }, { 0x3ffffffe, 30 }, { 0xffffff3, 28 },
+    { 0xffffff4, 28 }, { 0xffffff5, 28 }, { 0xffffff6, 28 }, { 0xffffff7, 28 },
+    { 0xffffff8, 28 }, { 0xffffff9, 28 }, { 0xffffffa, 28 }, { 0xffffffb, 28 },
+    { 0x14, 6 }, { 0x3f8, 10 }, { 0x3f9, 10 }, { 0xffa, 12 },
+    { 0x1ff9, 13 }, { 0x15, 6 }, { 0xf8, 8 }, { 0x7fa, 11 },
+    { 0x3fa, 10 }, { 0x3fb, 10 }, { 0xf9, 8 }, { 0x7fb, 11 },
+    { 0xfa, 8 }, { 0x16, 6 }, { 0x17, 6 }, { 0x18, 6 },
+    { 0x0, 5 }, { 0x1, 5 }, { 0x2, 5 }, { 0x19, 6 },
+    { 0x1a, 6 }, { 0x1b, 6 }, { 0x1c, 6 }, { 0x1d, 6 },
+    { 0x1e, 6 }, { 0x1f, 6 }, { 0x5c, 7 }, { 0xfb, 8 },
+    { 0x7ffc, 15 }, { 0x20, 6 }, { 0xffb, 12 }, { 0x3fc, 10 },
+    { 0x1ffa, 13 }, { 0x21, 6 }, { 0x5d, 7 }, { 0x5e, 7 },
+    { 0x5f, 7 }, { 0x60, 7 }, { 0x61, 7 }, { 0x62, 7 },
+    { 0x63, 7 }, { 0x64, 7 }, { 0x65, 7 }, { 0x66, 7 },
+    { 0x67, 7 }, { 0x68, 7 }, { 0x69, 7 }, { 0x6a, 7 },
+    { 0x6b, 7 }, { 0x6c, 7 }, { 0x6d, 7 }, { 0x6e, 7 },
+    { 0x6f, 7 }, { 0x70, 7 }, { 0x71, 7 }, { 0x72, 7 },
+    { 0xfc, 8 }, { 0x73, 7 }, { 0xfd, 8 }, { 0x1ffb, 13 },
+    { 0x7fff0, 19 }, { 0x1ffc, 13 }, { 0x3ffc, 14 }, { 0x22, 6 },
+    { 0x7ffd, 15 }, { 0x3, 5 }, { 0x23, 6 }, { 0x4, 5 },
+    { 0x24, 6 }, { 0x5, 5 }, { 0x25, 6 }, { 0x26, 6 },
+    { 0x27, 6 }, { 0x6, 5 }, { 0x74, 7 }, { 0x75, 7 },
+    { 0x28, 6 }, { 0x29, 6 }, { 0x2a, 6 }, { 0x7, 5 },
+    { 0x2b, 6 }, { 0x76, 7 }, { 0x2c, 6 }, { 0x8, 5 },
+    { 0x9, 5 }, { 0x2d, 6 }, { 0x77, 7 }, { 0x78, 7 },
+    { 0x79, 7 }, { 0x7a, 7 }, { 0x7b, 7 }, { 0x7ffe, 15 },
+    { 0x7fc, 11 }, { 0x3ffd, 14 }, { 0x1ffd, 13 }, { 0xffffffc, 28 },
+    { 0xfffe6, 20 }, { 0x3fffd2, 22 }, { 0xfffe7, 20 }, { 0xfffe8, 20 },
+    { 0x3fffd3, 22 }, { 0x3fffd4, 22 }, { 0x3fffd5, 22 }, { 0x7fffd9, 23 },
+    { 0x3fffd6, 22 }, { 0x7fffda, 23 }, { 0x7fffdb, 23 }, { 0x7fffdc, 23 },
+    { 0x7fffdd, 23 }, { 0x7fffde, 23 }, { 0xffffeb, 24 }, { 0x7fffdf, 23 },
+    { 0xffffec, 24 }, { 0xffffed, 24 }, { 0x3fffd7, 22 }, { 0x7fffe0, 23 },
+    { 0xffffee, 24 }, { 0x7fffe1, 23 }, { 0x7fffe2, 23 }, { 0x7fffe3, 23 },
+    { 0x7fffe4, 23 }, { 0x1fffdc, 21 }, { 0x3fffd8, 22 }, { 0x7fffe5, 23 },
+    { 0x3fffd9, 22 }, { 0x7fffe6, 23 }, { 0x7fffe7, 23 }, { 0xffffef, 24 },
+    { 0x3fffda, 22 }, { 0x1fffdd, 21 }, { 0xfffe9, 20 }, { 0x3fffdb, 22 },
+    { 0x3fffdc, 22 }, { 0x7fffe8, 23 }, { 0x7fffe9, 23 }, { 0x1fffde, 21 },
+    { 0x7fffea, 23 }, { 0x3fffdd, 22 }, { 0x3fffde, 22 }, { 0xfffff0, 24 },
+    { 0x1fffdf, 21 }, { 0x3fffdf, 22 }, { 0x7fffeb, 23 }, { 0x7fffec, 23 },
+    { 0x1fffe0, 21 }, { 0x1fffe1, 21 }, { 0x3fffe0, 22 }, { 0x1fffe2, 21 },
+    { 0x7fffed, 23 }, { 0x3fffe1, 22 }, { 0x7fffee, 23 }, { 0x7fffef, 23 },
+    { 0xfffea, 20 }, { 0x3fffe2, 22 }, { 0x3fffe3, 22 }, { 0x3fffe4, 22 },
+    { 0x7ffff0, 23 }, { 0x3fffe5, 22 }, { 0x3fffe6, 22 }, { 0x7ffff1, 23 },
+    { 0x3ffffe0, 26 }, { 0x3ffffe1, 26 }, { 0xfffeb, 20 }, { 0x7fff1, 19 },
+    { 0x3fffe7, 22 }, { 0x7ffff2, 23 }, { 0x3fffe8, 22 }, { 0x1ffffec, 25 },
+    { 0x3ffffe2, 26 }, { 0x3ffffe3, 26 }, { 0x3ffffe4, 26 }, { 0x7ffffde, 27 },
+    { 0x7ffffdf, 27 }, { 0x3ffffe5, 26 }, { 0xfffff1, 24 }, { 0x1ffffed, 25 },
+    { 0x7fff2, 19 }, { 0x1fffe3, 21 }, { 0x3ffffe6, 26 }, { 0x7ffffe0, 27 },
+    { 0x7ffffe1, 27 }, { 0x3ffffe7, 26 }, { 0x7ffffe2, 27 }, { 0xfffff2, 24 },
+    { 0x1fffe4, 21 }, { 0x1fffe5, 21 }, { 0x3ffffe8, 26 }, { 0x3ffffe9, 26 },
+    { 0xffffffd, 28 }, { 0x7ffffe3, 27 }, { 0x7ffffe4, 27 }, { 0x7ffffe5, 27 },
+    { 0xfffec, 20 }, { 0xfffff3, 24 }, { 0xfffed, 20 }, { 0x1fffe6, 21 },
+    { 0x3fffe9, 22 }, { 0x1fffe7, 21 }, { 0x1fffe8, 21 }, { 0x7ffff3, 23 },
+    { 0x3fffea, 22 }, { 0x3fffeb, 22 }, { 0x1ffffee, 25 }, { 0x1ffffef, 25 },
+    { 0xfffff4, 24 }, { 0xfffff5, 24 }, { 0x3ffffea, 26 }, { 0x7ffff4, 23 },
+    { 0x3ffffeb, 26 }, { 0x7ffffe6, 27 }, { 0x3ffffec, 26 }, { 0x3ffffed, 26 },
+    { 0x7ffffe7, 27 }, { 0x7ffffe8, 27 }, { 0x7ffffe9, 27 }, { 0x7ffffea, 27 },
+    { 0x7ffffeb, 27 }, { 0xffffffe, 28 }, { 0x7ffffec, 27 }, { 0x7ffffed, 27 },
+    { 0x7ffffee, 27 }, { 0x7ffffef, 27 }, { 0x7fffff0, 27 }, { 0x3ffffee, 26 },
+    { 0x3fffffff, 30 },
+} };
+
+// The code is canonical, so the codes of each length are consecutive and follow the codes of the shorter lengths.
+// That lets us decode a symbol without walking a tree, by checking whether the bits read so far fall in the range of
+// codes of their length.
+struct HuffmanDecodeTable {
+    Array<u16, 257> symbols {};
+    Array<u32, 31> first_code {};
+    Array<u16, 31> first_symbol {};
+    Array<u16, 31> code_count {};
+};
+
+static constexpr HuffmanDecodeTable make_huffman_decode_table()
+{
+    HuffmanDecodeTable table;
+    u16 symbol_count = 0;
+    for (u8 length = 1; length <= 30; ++length) {
+        table.first_symbol[length] = symbol_count;
+        for (u16 symbol = 0; symbol < huffman_codes.size(); ++symbol) {
+            if (huffman_codes[symbol].length != length)
+                continue;
+            if (table.code_count[length] == 0)
+                table.first_code[length] = huffman_codes[symbol].code;
+            table.symbols[symbol_count++] = symbol;
+            ++table.code_count[length];
+        }
+    }
+    return table;
+}
+
+static constexpr auto huffman_decode_table = make_huffman_decode_table();
+static constexpr u16 huffman_end_of_string = 256;
+
+ErrorOr<ByteBuffer> huffman_decode(ReadonlyBytes encoded)
+{
+    ByteBuffer decoded;
+    TRY(decoded.try_ensure_capacity(encoded.size() * 8 / 5));
+
+    u32 code = 0;
+    u8 length = 0;
+    for (auto byte : encoded) {
+        for (int bit = 7; bit >= 0; --bit) {
+            code = (code << 1) | ((byte >> bit) & 1);
+            if (++length > 30)
+                return Error::from_string_literal("HPACK: Invalid Huffman code");
+
+            auto first_code = huffman_decode_table.first_code[length];
+            if (code < first_code || code - first_code >= huffman_decode_table.code_count[length])
+                continue;
+
+            auto symbol = huffman_decode_table.symbols[huffman_decode_table.first_symbol[length] + code - first_code];
+            if (symbol == huffman_end_of_string)
+                return Error::from_string_literal("HPACK: Huffman-encoded string contains EOS");
+            decoded.append(static_cast<u8>(symbol));
+            code = 0;
+            length = 0;
+        }
+    }
+
+    // The string is padded to a whole byte with the most significant bits of EOS, which are all ones (RFC7541 section 5.2).
+    if (length > 7 || code != (1u << length) - 1)
+        return Error::from_string_literal("HPACK: Invalid Huffman padding");
+
+    return decoded;
+}
+
+static size_t huffman_encoded_length(ReadonlyBytes bytes)
+{
+    size_t bit_count = 0;
+    for (auto byte : bytes)
+        bit_count += huffman_codes[byte].length;
+    return (bit_count + 7) / 8;
+}
+
+ErrorOr<ByteBuffer> huffman_encode(ReadonlyBytes bytes)
+{
+    ByteBuffer encoded;
+    TRY(encoded.try_ensure_capacity(huffman_encoded_length(bytes)));
+
+    u64 bits = 0;
+    u8 bit_count = 0;
+    for (auto byte : bytes) {
+        auto& code = huffman_codes[byte];
+        bits = (bits << code.length) | code.code;
+        bit_count += code.length;
+        while (bit_count >= 8) {
+            bit_count -= 8;
+            encoded.append(static_cast<u8>(bits >> bit_count));
+        }
+    }
+    if (bit_count > 0)
+        encoded.append(static_cast<u8>((bits << (8 - bit_count)) | (0xff >> bit_count)));
+
+    return encoded;
+}
+
+void DynamicTable::set_maximum_size(size_t maximum_size)
+{
+    m_maximum_size = maximum_size;
+    evict_to(maximum_size);
+}
+
+static size_t entry_size(Header const& header)
+{
+    return header.name.length() + header.value.length() + 32;
+}
+
+void DynamicTable::add(Header header)
+{
+    // An entry that doesn't fit empties the table (RFC7541 section 4.4).
+    auto size = entry_size(header);
+    if (size > m_maximum_size) {
+        evict_to(0);
+        return;
+    }
+
+    evict_to(m_maximum_size - size);
+    m_entries.append(move(header));
+    m_size += size;
+}
+
+void DynamicTable::evict_to(size_t size)
+{
+    size_t evicted_count = 0;
+    while (m_size > size)
+        m_size -= entry_size(m_entries[evicted_count++]);
+    m_entries.remove(0, evicted_count);
+}
+
+// RFC7541 section 5.1
+static ErrorOr<size_t> read_integer(ReadonlyBytes bytes, size_t& offset, u8 prefix_bits)
+{
+    if (offset >= bytes.size())
+        return Error::from_string_literal("HPACK: Truncated integer");
+
+    size_t maximum_prefix = (1u << prefix_bits) - 1;
+    size_t value = bytes[offset++] & maximum_prefix;
+    if (value < maximum_prefix)
+        return value;
+
+    for (size_t shift = 0;; shift += 7) {
+        if (offset >= bytes.size())
+            return Error::from_string_literal("HPACK: Truncated integer");
+        if (shift > 28)
+            return Error::from_string_literal("HPACK: Integer is too large");
+
+        auto byte = bytes[offset++];
+        value += static_cast<size_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+            return value;
+    }
+}
+
+static ErrorOr<void> write_integer(ByteBuffer& buffer, u8 flags, u8 prefix_bits, size_t value)
+{
+    size_t maximum_prefix = (1u << prefix_bits) - 1;
+    if (value < maximum_prefix)
+        return buffer.try_append(static_cast<u8>(flags | value));
+
+    TRY(buffer.try_append(static_cast<u8>(flags | maximum_prefix)));
+    value -= maximum_prefix;
+    for (; value >= 0x80; value >>= 7)
+        TRY(buffer.try_append(static_cast<u8>((value & 0x7f) | 0x80)));
+    return buffer.try_append(static_cast<u8>(value));
+}
+
+// RFC7541 section 5.2
+static ErrorOr<DeprecatedString> read_string(ReadonlyBytes bytes, size_t& offset)
+{
+    if (offset >= bytes.size())
+        return Error::from_string_literal("HPACK: Truncated string");
+
+    bool is_huffman_encoded = bytes[offset] & 0x80;
+    auto length = TRY(read_integer(bytes, offset, 7));
+    if (length > bytes.size() - offset)
+        return Error::from_string_literal("HPACK: Truncated string");
+
+    auto string = bytes.slice(offset, length);
+    offset += length;
+    if (is_huffman_encoded)
+        return DeprecatedString::copy(TRY(huffman_decode(string)));
+    return DeprecatedString { string };
+}
+
+static ErrorOr<void> write_string(ByteBuffer& buffer, StringView string)
+{
+    auto huffman_length = huffman_encoded_length(string.bytes());
+    if (huffman_length < string.length()) {
+        TRY(write_integer(buffer, 0x80, 7, huffman_length));
+        return buffer.try_append(TRY(huffman_encode(string.bytes())));
+    }
+
+    TRY(write_integer(buffer, 0, 7, string.length()));
+    return buffer.try_append(string.bytes());
+}
+
+// Indices start at 1 with the static table, the dynamic table follows it (RFC7541 section 2.3.3).
+ErrorOr<Header> Decoder::header_at(size_t index) const
+{
+    if (index == 0)
+        return Error::from_string_literal("HPACK: Invalid index 0");
+    if (index <= static_table.size())
+        return Header { static_table[index - 1].name, static_table[index - 1].value };
+
+    index -= static_table.size() + 1;
+    if (index >= m_table.entry_count())
+        return Error::from_string_literal("HPACK: Index is out of range");
+    return m_table.at(index);
+}
+
+ErrorOr<Header> Decoder::read_literal(ReadonlyBytes bytes, size_t& offset, u8 prefix_bits) const
+{
+    Header header;
+    if (auto name_index = TRY(read_integer(bytes, offset, prefix_bits)); name_index != 0)
+        header.name = TRY(header_at(name_index)).name;
+    else
+        header.name = TRY(read_string(bytes, offset));
+    header.value = TRY(read_string(bytes, offset));
+    return header;
+}
+
+ErrorOr<Vector<Header>> Decoder::decode(ReadonlyBytes header_block)
+{
+    Vector<Header> headers;
+    size_t offset = 0;
+    while (offset < header_block.size()) {
+        auto byte = header_block[offset];
+        if (byte & 0x80) {
+            // Indexed header field
+            TRY(headers.try_append(TRY(header_at(TRY(read_integer(header_block, offset, 7))))));
+        } else if ((byte & 0xc0) == 0x40) {
+            // Literal header field with incremental indexing
+            auto header = TRY(read_literal(header_block, offset, 6));
+            m_table.add(header);
+            TRY(headers.try_append(move(header)));
+        } else if ((byte & 0xe0) == 0x20) {
+            // Dynamic table size update, which may only start a header block.
+            if (!headers.is_empty())
+                return Error::from_string_literal("HPACK: Table size update after a header");
+            auto maximum_size = TRY(read_integer(header_block, offset, 5));
+            if (maximum_size > default_maximum_table_size)
+                return Error::from_string_literal("HPACK: Table size update exceeds SETTINGS_HEADER_TABLE_SIZE");
+            m_table.set_maximum_size(maximum_size);
+        } else {
+            // Literal header field without indexing, or never indexed
+            TRY(headers.try_append(TRY(read_literal(header_block, offset, 4))));
+        }
+    }
+    return headers;
+}
+
+void Encoder::set_maximum_table_size(size_t maximum_size)
+{
+    maximum_size = min(maximum_size, default_maximum_table_size);
+    if (maximum_size != m_table.maximum_size())
+        m_pending_table_size_update = maximum_size;
+}
+
+// Credentials should not end up in a table where they can be probed for (RFC7541 section 7.1.3).
+static bool should_never_be_indexed(StringView name)
+{
+    return name == "authorization"sv || name == "proxy-authorization"sv;
+}
+
+ErrorOr<ByteBuffer> Encoder::encode(Span<Header const> headers)
+{
+    ByteBuffer header_block;
+
+    if (m_pending_table_size_update.has_value()) {
+        TRY(write_integer(header_block, 0x20, 5, *m_pending_table_size_update));
+        m_table.set_maximum_size(m_pending_table_size_update.release_value());
+    }
+
+    for (auto& header : headers) {
+        size_t index = 0;
+        size_t name_index = 0;
+        for (size_t i = 0; i < static_table.size() && index == 0; ++i) {
+            if (static_table[i].name != header.name)
+                continue;
+            if (static_table[i].value == header.value)
+                index = i + 1;
+            else if (name_index == 0)
+                name_index = i + 1;
+        }
+        for (size_t i = 0; i < m_table.entry_count() && index == 0; ++i) {
+            auto& entry = m_table.at(i);
+            if (entry.name != header.name)
+                continue;
+            if (entry.value == header.value)
+                index = static_table.size() + i + 1;
+            else if (name_index == 0)
+                name_index = static_table.size() + i + 1;
+        }
+
+        if (index != 0) {
+            // Indexed header field
+            TRY(write_integer(header_block, 0x80, 7, index));
+            continue;
+        }
+
+        bool never_index = should_never_be_indexed(header.name);
+        if (never_index)
+            TRY(write_integer(header_block, 0x10, 4, name_index));
+        else
+            TRY(write_integer(header_block, 0x40, 6, name_index));
+        if (name_index == 0)
+            TRY(write_string(header_block, header.name));
+        TRY(write_string(header_block, header.value));
+
+        if (!never_index)
+            m_table.add(header);
+    }
+
+    return header_block;
+}
+
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/DeprecatedString.h>
+#include <AK/Error.h>
+#include <AK/Optional.h>
+#include <AK/Span.h>
+#include <AK/Vector.h>
+
+// HPACK, the header compression of HTTP/2 (RFC7541).
+namespace HTTP::HPack {
+
+struct Header {
+    DeprecatedString name;
+    DeprecatedString value;
+
+    bool operator==(Header const&) const = default;
+};
+
+// The default value of SETTINGS_HEADER_TABLE_SIZE.
+static constexpr size_t default_maximum_table_size = 4096;
+
+class DynamicTable {
+public:
+    // Index 0 is the most recently added entry.
+    Header const& at(size_t index) const { return m_entries[m_entries.size() - index - 1]; }
+    size_t entry_count() const { return m_entries.size(); }
+
+    // The size of an entry is the length of its name and value plus 32 (RFC7541 section 4.1).
+    size_t size() const { return m_size; }
+    size_t maximum_size() const { return m_maximum_size; }
+    void set_maximum_size(size_t);
+
+    void add(Header);
+
+private:
+    void evict_to(size_t);
+
+    // Oldest first.
+    Vector<Header> m_entries;
+    size_t m_size { 0 };
+    size_t m_maximum_size { default_maximum_table_size };
+};
+
+class Decoder {
+public:
+    ErrorOr<Vector<Header>> decode(ReadonlyBytes header_block);
+
+    DynamicTable const& table() const { return m_table; }
+
+private:
+    ErrorOr<Header> header_at(size_t index) const;
+    ErrorOr<Header> read_literal(ReadonlyBytes, size_t& offset, u8 prefix_bits) const;
+
+    DynamicTable m_table;
+};
+
+class Encoder {
+public:
+    ErrorOr<ByteBuffer> encode(Span<Header const>);
+
+    // The decoder on the other end allows us a table this large, we'll pick up the new size with the next header block.
+    void set_maximum_table_size(size_t);
+
+    DynamicTable const& table() const { return m_table; }
+
+private:
+    DynamicTable m_table;
+    Optional<size_t> m_pending_table_size_update;
+};
+
+ErrorOr<ByteBuffer> huffman_decode(ReadonlyBytes);
+ErrorOr<ByteBuffer> huffman_encode(ReadonlyBytes);
+
+}
@@ -0,0 +1,620 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <LibHTTP/Http2Connection.h>
+
+namespace HTTP {
+
+static constexpr auto connection_preface = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n"sv;
+
+static constexpr size_t frame_header_size = 9;
+static constexpr size_t maximum_receive_frame_size = 16384;
+static constexpr i64 default_window_size = 65535;
+static constexpr i64 maximum_window_size = 0x7fffffff;
+static constexpr u32 maximum_stream_id = 0x7fffffff;
+
+static constexpr u8 flag_end_stream = 0x1;
+static constexpr u8 flag_ack = 0x1;
+static constexpr u8 flag_end_headers = 0x4;
+static constexpr u8 flag_padded = 0x8;
+static constexpr u8 flag_priority = 0x20;
+
+enum class Setting : u16 {
+    HeaderTableSize = 0x1,
+    EnablePush = 0x2,
+    MaxConcurrentStreams = 0x3,
+    InitialWindowSize = 0x4,
+    MaxFrameSize = 0x5,
+    MaxHeaderListSize = 0x6,
+};
+
+static u32 read_u32(ReadonlyBytes bytes)
+{
+    return (bytes[0] << 24) | (bytes[1] << 16) | (bytes[2] << 8) | bytes[3];
+}
+
+static void write_u32(u8* bytes, u32 value)
+{
+    bytes[0] = value >> 24;
+    bytes[1] = value >> 16;
+    bytes[2] = value >> 8;
+    bytes[3] = value;
+}
+
+// A failure to send anything means that the connection is gone.
+static ErrorOr<void, Http2Connection::ErrorCode> as_connection_error(ErrorOr<void> result)
+{
+    if (result.is_error())
+        return Http2Connection::ErrorCode::InternalError;
+    return {};
+}
+
+static ErrorOr<ReadonlyBytes, Http2Connection::ErrorCode> remove_padding(u8 flags, ReadonlyBytes payload)
+{
+    if (!(flags & flag_padded))
+        return payload;
+    if (payload.is_empty() || payload[0] >= payload.size())
+        return Http2Connection::ErrorCode::ProtocolError;
+    return payload.slice(1, payload.size() - payload[0] - 1);
+}
+
+Http2Connection::Http2Connection(Core::BufferedSocketBase& socket)
+    : m_socket(socket)
+{
+}
+
+Http2Connection::~Http2Connection()
+{
+    m_socket.on_ready_to_read = nullptr;
+}
+
+ErrorOr<void> Http2Connection::start()
+{
+    TRY(m_socket.write_entire_buffer(connection_preface.bytes()));
+
+    // Turn off server push, and let the server send a lot more at once than the default window of 64 KiB allows.
+    u8 settings[12];
+    settings[0] = 0;
+    settings[1] = to_underlying(Setting::EnablePush);
+    write_u32(settings + 2, 0);
+    settings[6] = 0;
+    settings[7] = to_underlying(Setting::InitialWindowSize);
+    write_u32(settings + 8, stream_receive_window_size);
+    TRY(send_frame(FrameType::Settings, 0, 0, { settings, sizeof(settings) }));
+    TRY(send_window_update(0, connection_receive_window_size - default_window_size));
+
+    m_socket.on_ready_to_read = [this] {
+        read_from_socket();
+    };
+    return {};
+}
+
+void Http2Connection::open_stream(Job& job)
+{
+    if (!is_usable() || m_next_stream_id > maximum_stream_id) {
+        m_is_going_away = true;
+        job.fail(Core::NetworkJob::Error::ConnectionFailed);
+        return;
+    }
+
+    if (m_streams.size() >= m_max_concurrent_streams) {
+        dbgln_if(HTTP2_DEBUG, "Http2Connection: {} streams are open, {} has to wait", m_streams.size(), job.url());
+        m_waiting_jobs.append(job);
+        return;
+    }
+
+    auto stream_id = m_next_stream_id;
+    m_next_stream_id += 2;
+    job.m_http2_stream_id = stream_id;
+    m_streams.set(stream_id, Stream { .job = job, .send_window = m_initial_send_window, .unacknowledged_received_size = 0, .pending_body = {}, .pending_body_offset = 0 });
+    dbgln_if(HTTP2_DEBUG, "Http2Connection: Opening stream {} for {}", stream_id, job.url());
+
+    if (auto result = send_request(stream_id, m_streams.find(stream_id)->value); result.is_error()) {
+        dbgln("Http2Connection: Failed to send request: {}", result.error());
+        fail(ErrorCode::InternalError);
+    }
+}
+
+void Http2Connection::close_stream(Job& job)
+{
+    if (m_waiting_jobs.remove_first_matching([&](auto& waiting_job) { return waiting_job.ptr() == &job; })) {
+        did_close_stream();
+        return;
+    }
+
+    auto stream_id = job.m_http2_stream_id;
+    auto it = m_streams.find(stream_id);
+    if (it == m_streams.end() || it->value.job.ptr() != &job)
+        return;
+
+    m_streams.remove(it);
+    reset_stream(stream_id, ErrorCode::Cancel);
+    did_close_stream();
+}
+
+void Http2Connection::resume_stream(Job& job)
+{
+    auto it = m_streams.find(job.m_http2_stream_id);
+    if (it == m_streams.end() || it->value.job.ptr() != &job)
+        return;
+
+    if (auto result = acknowledge_received_data(it->key, 0); result.is_error())
+        fail(ErrorCode::InternalError);
+}
+
+ErrorOr<void> Http2Connection::send_frame(FrameType type, u8 flags, u32 stream_id, ReadonlyBytes payload)
+{
+    VERIFY(payload.size() <= m_max_send_frame_size);
+
+    auto frame = TRY(ByteBuffer::create_uninitialized(frame_header_size + payload.size()));
+    frame[0] = payload.size() >> 16;
+    frame[1] = payload.size() >> 8;
+    frame[2] = payload.size();
+    frame[3] = to_underlying(type);
+    frame[4] = flags;
+    write_u32(frame.offset_pointer(5), stream_id);
+    payload.copy_to(frame.bytes().slice(frame_header_size));
+
+    return m_socket.write_entire_buffer(frame);
+}
+
+// RFC9113 section 8.3.1
+ErrorOr<void> Http2Connection::send_request(u32 stream_id, Stream& stream)
+{
+    auto& request = stream.job->request();
+    auto& url = request.url();
+
+    Vector<HPack::Header> headers;
+    TRY(headers.try_append({ ":method", request.method_name() }));
+    TRY(headers.try_append({ ":scheme", url.scheme() }));
+    if (url.port().has_value())
+        TRY(headers.try_append({ ":authority", DeprecatedString::formatted("{}:{}", url.host(), *url.port()) }));
+    else
+        TRY(headers.try_append({ ":authority", url.host() }));
+    TRY(headers.try_append({ ":path", request.target() }));
+
+    for (auto& header : request.headers()) {
+        // Connection-specific header fields have no meaning in HTTP/2 (RFC9113 section 8.2.2), and all names are lowercase.
+        auto name = header.name.to_lowercase();
+        if (name.is_one_of("connection"sv, "keep-alive"sv, "proxy-connection"sv, "transfer-encoding"sv, "upgrade"sv, "host"sv, "te"sv))
+            continue;
+        TRY(headers.try_append({ move(name), header.value }));
+    }
+
+    auto& body = request.body();
+    if (!body.is_empty() || request.method() == HttpRequest::Method::POST)
+        TRY(headers.try_append({ "content-length", DeprecatedString::number(body.size()) }));
+
+    // The header block goes into a HEADERS frame, and as many CONTINUATION frames as it takes to fit the rest.
+    auto header_block = TRY(m_encoder.encode(headers));
+    size_t offset = 0;
+    do {
+        auto size = min<size_t>(header_block.size() - offset, m_max_send_frame_size);
+        u8 flags = offset + size == header_block.size() ? flag_end_headers : 0;
+        if (offset == 0 && body.is_empty())
+            flags |= flag_end_stream;
+        TRY(send_frame(offset == 0 ? FrameType::Headers : FrameType::Continuation, flags, stream_id, header_block.bytes().slice(offset, size)));
+        offset += size;
+    } while (offset < header_block.size());
+
+    if (body.is_empty())
+        return {};
+
+    stream.pending_body = TRY(ByteBuffer::copy(body));
+    return send_pending_body(stream_id, stream);
+}
+
+// As much of the request body is sent as the flow control windows of the connection and the stream allow, the rest
+// goes out once the server opens them up with WINDOW_UPDATE.
+ErrorOr<void> Http2Connection::send_pending_body(u32 stream_id, Stream& stream)
+{
+    while (stream.pending_body_offset < stream.pending_body.size()) {
+        auto window = min(m_send_window, stream.send_window);
+        if (window <= 0)
+            return {};
+
+        auto size = min(min(stream.pending_body.size() - stream.pending_body_offset, static_cast<size_t>(window)), static_cast<size_t>(m_max_send_frame_size));
+        bool is_last_frame = stream.pending_body_offset + size == stream.pending_body.size();
+        TRY(send_frame(FrameType::Data, is_last_frame ? flag_end_stream : 0, stream_id, stream.pending_body.bytes().slice(stream.pending_body_offset, size)));
+
+        stream.pending_body_offset += size;
+        stream.send_window -= size;
+        m_send_window -= size;
+    }
+
+    stream.pending_body.clear();
+    stream.pending_body_offset = 0;
+    return {};
+}
+
+ErrorOr<void> Http2Connection::send_window_update(u32 stream_id, u32 increment)
+{
+    u8 payload[4];
+    write_u32(payload, increment);
+    return send_frame(FrameType::WindowUpdate, 0, stream_id, { payload, sizeof(payload) });
+}
+
+// The windows are opened up again once half of them has been used, so the server doesn't have to wait for us.
+ErrorOr<void> Http2Connection::acknowledge_received_data(u32 stream_id, size_t size)
+{
+    m_unacknowledged_received_size += size;
+    if (m_unacknowledged_received_size >= connection_receive_window_size / 2) {
+        TRY(send_window_update(0, m_unacknowledged_received_size));
+        m_unacknowledged_received_size = 0;
+    }
+
+    auto it = m_streams.find(stream_id);
+    if (it == m_streams.end())
+        return {};
+
+    // While the job waits for its client, the stream's window runs out, and the server has to wait as well.
+    auto& stream = it->value;
+    stream.unacknowledged_received_size += size;
+    if (stream.unacknowledged_received_size >= stream_receive_window_size / 2 && !stream.job->is_output_backed_up()) {
+        TRY(send_window_update(stream_id, stream.unacknowledged_received_size));
+        stream.unacknowledged_received_size = 0;
+    }
+    return {};
+}
+
+void Http2Connection::reset_stream(u32 stream_id, ErrorCode error_code)
+{
+    dbgln_if(HTTP2_DEBUG, "Http2Connection: Resetting stream {} with error {}", stream_id, to_underlying(error_code));
+
+    u8 payload[4];
+    write_u32(payload, to_underlying(error_code));
+    if (auto result = send_frame(FrameType::ResetStream, 0, stream_id, { payload, sizeof(payload) }); result.is_error())
+        dbgln_if(HTTP2_DEBUG, "Http2Connection: Failed to reset stream {}: {}", stream_id, result.error());
+}
+
+void Http2Connection::read_from_socket()
+{
+    NonnullRefPtr protector(*this);
+
+    while (true) {
+        auto can_read_without_blocking = m_socket.can_read_without_blocking();
+        if (can_read_without_blocking.is_error())
+            return fail(ErrorCode::InternalError);
+        if (!can_read_without_blocking.value())
+            break;
+
+        u8 buffer[16 * KiB];
+        auto bytes_read = m_socket.read({ buffer, sizeof(buffer) });
+        if (bytes_read.is_error()) {
+            if (bytes_read.error().is_errno() && bytes_read.error().code() == EINTR)
+                continue;
+            return fail(ErrorCode::InternalError);
+        }
+        if (bytes_read.value().is_empty())
+            break;
+        if (m_received_bytes.try_append(bytes_read.value()).is_error())
+            return fail(ErrorCode::InternalError);
+    }
+
+    size_t offset = 0;
+    while (m_received_bytes.size() - offset >= frame_header_size) {
+        auto header = m_received_bytes.bytes().slice(offset, frame_header_size);
+        size_t length = (header[0] << 16) | (header[1] << 8) | header[2];
+        if (length > maximum_receive_frame_size)
+            return fail(ErrorCode::FrameSizeError);
+        if (m_received_bytes.size() - offset - frame_header_size < length)
+            break;
+
+        auto type = static_cast<FrameType>(header[3]);
+        auto flags = header[4];
+        auto stream_id = read_u32(header.slice(5)) & maximum_stream_id;
+        auto payload = m_received_bytes.bytes().slice(offset + frame_header_size, length);
+        offset += frame_header_size + length;
+
+        dbgln_if(HTTP2_DEBUG, "Http2Connection: Received frame of type {} with flags {:#x} and {} bytes on stream {}", to_underlying(type), flags, length, stream_id);
+        if (auto result = process_frame(type, flags, stream_id, payload); result.is_error())
+            return fail(result.error());
+        if (!m_socket.is_open())
+            return;
+    }
+
+    if (offset == m_received_bytes.size()) {
+        m_received_bytes.clear();
+    } else if (offset != 0) {
+        auto remaining_bytes = ByteBuffer::copy(m_received_bytes.bytes().slice(offset));
+        if (remaining_bytes.is_error())
+            return fail(ErrorCode::InternalError);
+        m_received_bytes = remaining_bytes.release_value();
+    }
+
+    if (m_socket.is_eof()) {
+        dbgln_if(HTTP2_DEBUG, "Http2Connection: The server closed the connection");
+        fail(ErrorCode::NoError);
+    }
+}
+
+ErrorOr<void, Http2Connection::ErrorCode> Http2Connection::process_frame(FrameType type, u8 flags, u32 stream_id, ReadonlyBytes payload)
+{
+    // Nothing may come between the frames of a header block (RFC9113 section 6.10).
+    if (m_header_block_stream_id != 0 && (type != FrameType::Continuation || stream_id != m_header_block_stream_id))
+        return ErrorCode::ProtocolError;
+
+    switch (type) {
+    case FrameType::Data: {
+        if (stream_id == 0)
+            return ErrorCode::ProtocolError;
+        auto data = TRY(remove_padding(flags, payload));
+
+        if (auto it = m_streams.find(stream_id); it != m_streams.end() && !data.is_empty()) {
+            auto job = it->value.job;
+            job->did_receive_http2_data(data);
+        }
+
+        // The whole frame counts against the windows, padding and all.
+        if (flags & flag_end_stream) {
+            TRY(as_connection_error(acknowledge_received_data(0, payload.size())));
+            if (auto stream = m_streams.take(stream_id); stream.has_value()) {
+                stream->job->did_end_http2_stream();
+                did_close_stream();
+            }
+            return {};
+        }
+        return as_connection_error(acknowledge_received_data(stream_id, payload.size()));
+    }
+    case FrameType::Headers: {
+        if (stream_id == 0)
+            return ErrorCode::ProtocolError;
+        auto fragment = TRY(remove_padding(flags, payload));
+        if (flags & flag_priority) {
+            if (fragment.size() < 5)
+                return ErrorCode::FrameSizeError;
+            fragment = fragment.slice(5);
+        }
+
+        m_header_block.clear();
+        if (m_header_block.try_append(fragment).is_error())
+            return ErrorCode::InternalError;
+        m_header_block_ends_stream = flags & flag_end_stream;
+        if (flags & flag_end_headers)
+            return process_header_block(stream_id, m_header_block_ends_stream);
+        m_header_block_stream_id = stream_id;
+        return {};
+    }
+    case FrameType::Continuation:
+        if (m_header_block_stream_id == 0)
+            return ErrorCode::ProtocolError;
+        if (m_header_block.try_append(payload).is_error())
+            return ErrorCode::InternalError;
+        if (flags & flag_end_headers) {
+            m_header_block_stream_id = 0;
+            return process_header_block(stream_id, m_header_block_ends_stream);
+        }
+        return {};
+    case FrameType::ResetStream:
+        if (stream_id == 0)
+            return ErrorCode::ProtocolError;
+        if (payload.size() != 4)
+            return ErrorCode::FrameSizeError;
+        dbgln_if(HTTP2_DEBUG, "Http2Connection: The server reset stream {} with error {}", stream_id, read_u32(payload));
+        fail_stream(stream_id, static_cast<ErrorCode>(read_u32(payload)) == ErrorCode::RefusedStream ? Core::NetworkJob::Error::ConnectionFailed : Core::NetworkJob::Error::TransmissionFailed);
+        return {};
+    case FrameType::Settings:
+        return process_settings(flags, stream_id, payload);
+    case FrameType::PushPromise:
+        // We turned server push off.
+        return ErrorCode::ProtocolError;
+    case FrameType::Ping:
+        if (stream_id != 0)
+            return ErrorCode::ProtocolError;
+        if (payload.size() != 8)
+            return ErrorCode::FrameSizeError;
+        if (flags & flag_ack)
+            return {};
+        return as_connection_error(send_frame(FrameType::Ping, flag_ack, 0, payload));
+    case FrameType::GoAway:
+        if (stream_id != 0)
+            return ErrorCode::ProtocolError;
+        if (payload.size() < 8)
+            return ErrorCode::FrameSizeError;
+        process_go_away(read_u32(payload) & maximum_stream_id, static_cast<ErrorCode>(read_u32(payload.slice(4))));
+        return {};
+    case FrameType::WindowUpdate:
+        return process_window_update(stream_id, payload);
+    case FrameType::Priority:
+    default:
+        // Priorities are only a suggestion, and frames of unknown types are ignored (RFC9113 section 4.1).
+        return {};
+    }
+}
+
+ErrorOr<void, Http2Connection::ErrorCode> Http2Connection::process_header_block(u32 stream_id, bool end_stream)
+{
+    // The block has to be decoded even if we don't care about the stream any more, to keep the tables in sync.
+    auto headers = m_decoder.decode(m_header_block);
+    m_header_block.clear();
+    if (headers.is_error()) {
+        dbgln("Http2Connection: Failed to decode header block: {}", headers.error());
+        return ErrorCode::CompressionError;
+    }
+
+    auto it = m_streams.find(stream_id);
+    if (it == m_streams.end())
+        return {};
+
+    auto job = it->value.job;
+    if (end_stream)
+        m_streams.remove(it);
+
+    job->did_receive_http2_headers(headers.value());
+    if (end_stream) {
+        job->did_end_http2_stream();
+        did_close_stream();
+    }
+    return {};
+}
+
+ErrorOr<void, Http2Connection::ErrorCode> Http2Connection::process_settings(u8 flags, u32 stream_id, ReadonlyBytes payload)
+{
+    if (stream_id != 0)
+        return ErrorCode::ProtocolError;
+    if (flags & flag_ack) {
+        if (!payload.is_empty())
+            return ErrorCode::FrameSizeError;
+        return {};
+    }
+    if (payload.size() % 6 != 0)
+        return ErrorCode::FrameSizeError;
+
+    for (size_t offset = 0; offset < payload.size(); offset += 6) {
+        auto setting = static_cast<Setting>((payload[offset] << 8) | payload[offset + 1]);
+        auto value = read_u32(payload.slice(offset + 2));
+        dbgln_if(HTTP2_DEBUG, "Http2Connection: Setting {} = {}", to_underlying(setting), value);
+
+        switch (setting) {
+        case Setting::HeaderTableSize:
+            m_encoder.set_maximum_table_size(value);
+            break;
+        case Setting::EnablePush:
+            // Only clients get to enable server push.
+            if (value != 0)
+                return ErrorCode::ProtocolError;
+            break;
+        case Setting::MaxConcurrentStreams:
+            m_max_concurrent_streams = value;
+            break;
+        case Setting::InitialWindowSize: {
+            if (value > maximum_window_size)
+                return ErrorCode::FlowControlError;
+            // The change applies to the windows of the streams that are already open too (RFC9113 section 6.9.2).
+            auto delta = static_cast<i64>(value) - m_initial_send_window;
+            for (auto& it : m_streams) {
+                it.value.send_window += delta;
+                if (it.value.send_window > maximum_window_size)
+                    return ErrorCode::FlowControlError;
+            }
+            m_initial_send_window = value;
+            break;
+        }
+        case Setting::MaxFrameSize:
+            if (value < 16384 || value > 16777215)
+                return ErrorCode::ProtocolError;
+            m_max_send_frame_size = value;
+            break;
+        case Setting::MaxHeaderListSize:
+        default:
+            break;
+        }
+    }
+
+    TRY(as_connection_error(send_frame(FrameType::Settings, flag_ack, 0)));
+
+    // Larger windows or more streams may let the requests that were held back go ahead.
+    for (auto& it : m_streams)
+        TRY(as_connection_error(send_pending_body(it.key, it.value)));
+    open_waiting_streams();
+    return {};
+}
+
+ErrorOr<void, Http2Connection::ErrorCode> Http2Connection::process_window_update(u32 stream_id, ReadonlyBytes payload)
+{
+    if (payload.size() != 4)
+        return ErrorCode::FrameSizeError;
+
+    auto increment = read_u32(payload) & maximum_stream_id;
+    if (stream_id == 0) {
+        if (increment == 0)
+            return ErrorCode::ProtocolError;
+        m_send_window += increment;
+        if (m_send_window > maximum_window_size)
+            return ErrorCode::FlowControlError;
+        for (auto& it : m_streams)
+            TRY(as_connection_error(send_pending_body(it.key, it.value)));
+        return {};
+    }
+
+    auto it = m_streams.find(stream_id);
+    if (it == m_streams.end())
+        return {};
+
+    it->value.send_window += increment;
+    if (increment == 0 || it->value.send_window > maximum_window_size) {
+        reset_stream(stream_id, increment == 0 ? ErrorCode::ProtocolError : ErrorCode::FlowControlError);
+        fail_stream(stream_id, Core::NetworkJob::Error::ProtocolFailed);
+        return {};
+    }
+    return as_connection_error(send_pending_body(stream_id, it->value));
+}
+
+void Http2Connection::process_go_away(u32 last_stream_id, ErrorCode error_code)
+{
+    dbgln_if(HTTP2_DEBUG, "Http2Connection: The server is going away after stream {} with error {}", last_stream_id, to_underlying(error_code));
+    m_is_going_away = true;
+
+    // The streams after the last one were not processed by the server, and the ones that were still get to finish.
+    Vector<u32> unprocessed_stream_ids;
+    for (auto& it : m_streams) {
+        if (it.key > last_stream_id)
+            unprocessed_stream_ids.append(it.key);
+    }
+    for (auto stream_id : unprocessed_stream_ids)
+        fail_stream(stream_id, Core::NetworkJob::Error::ConnectionFailed);
+
+    auto waiting_jobs = move(m_waiting_jobs);
+    for (auto& job : waiting_jobs)
+        job->fail(Core::NetworkJob::Error::ConnectionFailed);
+
+    if (stream_count() == 0 && on_idle)
+        on_idle();
+}
+
+void Http2Connection::open_waiting_streams()
+{
+    while (!m_waiting_jobs.is_empty() && m_streams.size() < m_max_concurrent_streams && is_usable())
+        open_stream(*m_waiting_jobs.take_first());
+}
+
+void Http2Connection::fail_stream(u32 stream_id, Core::NetworkJob::Error error)
+{
+    auto stream = m_streams.take(stream_id);
+    if (!stream.has_value())
+        return;
+
+    stream->job->fail(error);
+    did_close_stream();
+}
+
+void Http2Connection::fail(ErrorCode error_code)
+{
+    if (!m_socket.is_open())
+        return;
+
+    dbgln_if(HTTP2_DEBUG, "Http2Connection: Closing the connection with error {}", to_underlying(error_code));
+    if (error_code != ErrorCode::InternalError) {
+        // We never accept streams from the server, so the last one we processed is always 0.
+        u8 payload[8];
+        write_u32(payload, 0);
+        write_u32(payload + 4, to_underlying(error_code));
+        (void)send_frame(FrameType::GoAway, 0, 0, { payload, sizeof(payload) });
+    }
+    m_socket.close();
+    m_is_going_away = true;
+
+    auto error = error_code == ErrorCode::InternalError || error_code == ErrorCode::NoError ? Core::NetworkJob::Error::TransmissionFailed : Core::NetworkJob::Error::ProtocolFailed;
+    auto streams = move(m_streams);
+    for (auto& it : streams)
+        it.value.job->fail(error);
+    auto waiting_jobs = move(m_waiting_jobs);
+    for (auto& job : waiting_jobs)
+        job->fail(error);
+
+    if (on_idle)
+        on_idle();
+}
+
+void Http2Connection::did_close_stream()
+{
+    open_waiting_streams();
+    if (stream_count() == 0 && on_idle)
+        on_idle();
+}
+
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/HashMap.h>
+#include <AK/NumericLimits.h>
+#include <AK/Vector.h>
+#include <LibCore/Object.h>
+#include <LibCore/Socket.h>
+#include <LibHTTP/HPack.h>
+#include <LibHTTP/Job.h>
+
+namespace HTTP {
+
+// An HTTP/2 connection (RFC9113) carries any number of requests to one origin at the same time, each on its own stream.
+// Only the client side is implemented, and server push is turned off.
+class Http2Connection final : public Core::Object {
+    C_OBJECT(Http2Connection);
+
+public:
+    enum class FrameType : u8 {
+        Data = 0x0,
+        Headers = 0x1,
+        Priority = 0x2,
+        ResetStream = 0x3,
+        Settings = 0x4,
+        PushPromise = 0x5,
+        Ping = 0x6,
+        GoAway = 0x7,
+        WindowUpdate = 0x8,
+        Continuation = 0x9,
+    };
+
+    enum class ErrorCode : u32 {
+        NoError = 0x0,
+        ProtocolError = 0x1,
+        InternalError = 0x2,
+        FlowControlError = 0x3,
+        SettingsTimeout = 0x4,
+        StreamClosed = 0x5,
+        FrameSizeError = 0x6,
+        RefusedStream = 0x7,
+        Cancel = 0x8,
+        CompressionError = 0x9,
+    };
+
+    virtual ~Http2Connection() override;
+
+    // Sends the connection preface, and takes over reading from the socket.
+    ErrorOr<void> start();
+
+    // Requests beyond the number of streams the server allows at once wait for another stream to close.
+    void open_stream(Job&);
+    void close_stream(Job&);
+
+    // The job's client caught up on reading the body, so the server may send more of it.
+    void resume_stream(Job&);
+
+    bool is_usable() const { return !m_is_going_away && m_socket.is_open(); }
+    size_t stream_count() const { return m_streams.size() + m_waiting_jobs.size(); }
+
+    // The last open stream was closed. If the connection is no longer usable, it can go away now.
+    Function<void()> on_idle;
+
+private:
+    explicit Http2Connection(Core::BufferedSocketBase&);
+
+    struct Stream {
+        NonnullRefPtr<Job> job;
+        i64 send_window { 0 };
+        size_t unacknowledged_received_size { 0 };
+        ByteBuffer pending_body;
+        size_t pending_body_offset { 0 };
+    };
+
+    static constexpr u32 stream_receive_window_size = 1 * MiB;
+    static constexpr u32 connection_receive_window_size = 16 * MiB;
+
+    void read_from_socket();
+    ErrorOr<void, ErrorCode> process_frame(FrameType, u8 flags, u32 stream_id, ReadonlyBytes payload);
+    ErrorOr<void, ErrorCode> process_header_block(u32 stream_id, bool end_stream);
+    ErrorOr<void, ErrorCode> process_settings(u8 flags, u32 stream_id, ReadonlyBytes payload);
+    ErrorOr<void, ErrorCode> process_window_update(u32 stream_id, ReadonlyBytes payload);
+    void process_go_away(u32 last_stream_id, ErrorCode);
+
+    ErrorOr<void> send_frame(FrameType, u8 flags, u32 stream_id, ReadonlyBytes payload = {});
+    ErrorOr<void> send_request(u32 stream_id, Stream&);
+    ErrorOr<void> send_pending_body(u32 stream_id, Stream&);
+    ErrorOr<void> send_window_update(u32 stream_id, u32 increment);
+    ErrorOr<void> acknowledge_received_data(u32 stream_id, size_t);
+    void reset_stream(u32 stream_id, ErrorCode);
+
+    void open_waiting_streams();
+    void fail_stream(u32 stream_id, Core::NetworkJob::Error);
+    void fail(ErrorCode);
+    void did_close_stream();
+
+    Core::BufferedSocketBase& m_socket;
+    ByteBuffer m_received_bytes;
+
+    HPack::Encoder m_encoder;
+    HPack::Decoder m_decoder;
+
+    HashMap<u32, Stream> m_streams;
+    Vector<NonnullRefPtr<Job>> m_waiting_jobs;
+    u32 m_next_stream_id { 1 };
+
+    // A header block may be split into a HEADERS frame and any number of CONTINUATION frames, which must follow each
+    // other without anything else in between.
+    u32 m_header_block_stream_id { 0 };
+    bool m_header_block_ends_stream { false };
+    ByteBuffer m_header_block;
+
+    // The settings the server sent us.
+    u32 m_max_concurrent_streams { NumericLimits<u32>::max() };
+    i64 m_initial_send_window { 65535 };
+    u32 m_max_send_frame_size { 16384 };
+
+    i64 m_send_window { 65535 };
+    size_t m_unacknowledged_received_size { 0 };
+
+    bool m_is_going_away { false };
+};
+
+}
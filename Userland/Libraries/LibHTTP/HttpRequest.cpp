@@ -43,11 +43,9 @@ DeprecatedString HttpRequest::method_name() const
     return to_deprecated_string(m_method);
 }
 
-ByteBuffer HttpRequest::to_raw_request() const
+DeprecatedString HttpRequest::target() const
 {
     StringBuilder builder;
-    builder.append(method_name());
-    builder.append(' ');
     // NOTE: The percent_encode is so that e.g. spaces are properly encoded.
     auto path = m_url.path();
     VERIFY(!path.is_empty());
@@ -56,6 +54,15 @@ ByteBuffer HttpRequest::to_raw_request() const
         builder.append('?');
         builder.append(m_url.query());
     }
+    return builder.to_deprecated_string();
+}
+
+ByteBuffer HttpRequest::to_raw_request() const
+{
+    StringBuilder builder;
+    builder.append(method_name());
+    builder.append(' ');
+    builder.append(target());
     builder.append(" HTTP/1.1\r\nHost: "sv);
     builder.append(m_url.host());
     if (m_url.port().has_value())
@@ -57,6 +57,8 @@ public:
     void set_body(ByteBuffer&& body) { m_body = move(body); }
 
     DeprecatedString method_name() const;
+    // The path and query of the URL, as they go into the request line.
+    DeprecatedString target() const;
     ByteBuffer to_raw_request() const;
 
     void set_headers(HashMap<DeprecatedString, DeprecatedString> const&);
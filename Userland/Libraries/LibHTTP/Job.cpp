@@ -8,12 +8,13 @@
 #include <AK/CharacterTypes.h>
 #include <AK/Debug.h>
 #include <AK/JsonObject.h>
-#include <AK/MemoryStream.h>
 #include <AK/Try.h>
 #include <LibCompress/Brotli.h>
 #include <LibCompress/Gzip.h>
 #include <LibCompress/Zlib.h>
+#include <LibCompress/Zstd.h>
 #include <LibCore/Event.h>
+#include <LibHTTP/Http2Connection.h>
 #include <LibHTTP/HttpResponse.h>
 #include <LibHTTP/Job.h>
 #include <stdio.h>
@@ -21,69 +22,15 @@
 
 namespace HTTP {
 
-static ErrorOr<ByteBuffer> handle_content_encoding(ByteBuffer const& buf, DeprecatedString const& content_encoding)
-{
-    dbgln_if(JOB_DEBUG, "Job::handle_content_encoding: buf has content_encoding={}", content_encoding);
-
-    // FIXME: Actually do the decompression of the data using streams, instead of all at once when everything has been
-    //        received. This will require that some of the decompression algorithms are implemented in a streaming way.
-    //        Gzip and Deflate are implemented using Stream, while Brotli uses the newer Core::Stream. The Gzip and
-    //        Deflate implementations will likely need to be changed to LibCore::Stream for this to work easily.
-
-    if (content_encoding == "gzip") {
-        if (!Compress::GzipDecompressor::is_likely_compressed(buf)) {
-            dbgln("Job::handle_content_encoding: buf is not gzip compressed!");
-        }
-
-        dbgln_if(JOB_DEBUG, "Job::handle_content_encoding: buf is gzip compressed!");
-
-        auto uncompressed = TRY(Compress::GzipDecompressor::decompress_all(buf));
-
-        if constexpr (JOB_DEBUG) {
-            dbgln("Job::handle_content_encoding: Gzip::decompress() successful.");
-            dbgln("  Input size: {}", buf.size());
-            dbgln("  Output size: {}", uncompressed.size());
-        }
-
-        return uncompressed;
-    } else if (content_encoding == "deflate") {
-        dbgln_if(JOB_DEBUG, "Job::handle_content_encoding: buf is deflate compressed!");
-
-        // Even though the content encoding is "deflate", it's actually deflate with the zlib wrapper.
-        // https://tools.ietf.org/html/rfc7230#section-4.2.2
-        auto uncompressed = Compress::ZlibDecompressor::decompress_all(buf);
-        if (!uncompressed.has_value()) {
-            // From the RFC:
-            // "Note: Some non-conformant implementations send the "deflate"
-            //        compressed data without the zlib wrapper."
-            dbgln_if(JOB_DEBUG, "Job::handle_content_encoding: ZlibDecompressor::decompress_all() failed. Trying DeflateDecompressor::decompress_all()");
-            uncompressed = TRY(Compress::DeflateDecompressor::decompress_all(buf));
-        }
-
-        if constexpr (JOB_DEBUG) {
-            dbgln("Job::handle_content_encoding: Deflate decompression successful.");
-            dbgln("  Input size: {}", buf.size());
-            dbgln("  Output size: {}", uncompressed.value().size());
-        }
+// The decompressors can't wait for more input in the middle of their data, so they only decode while enough of it
+// is buffered for anything they may read next: a deflate window's worth of symbols, a zstd block, and the headers around
+// them. Once everything has been received, the rest is decoded regardless.
+static constexpr size_t content_decoding_lookahead = 256 * KiB;
+static constexpr size_t content_decoding_chunk_size = 16 * KiB;
 
-        return uncompressed.release_value();
-    } else if (content_encoding == "br") {
-        dbgln_if(JOB_DEBUG, "Job::handle_content_encoding: buf is brotli compressed!");
-
-        FixedMemoryStream bufstream { buf };
-        auto brotli_stream = Compress::BrotliDecompressionStream { bufstream };
-
-        auto uncompressed = TRY(brotli_stream.read_until_eof());
-        if constexpr (JOB_DEBUG) {
-            dbgln("Job::handle_content_encoding: Brotli::decompress() successful.");
-            dbgln("  Input size: {}", buf.size());
-            dbgln("  Output size: {}", uncompressed.size());
-        }
-
-        return uncompressed;
-    }
-
-    return buf;
+static bool is_supported_content_encoding(StringView content_encoding)
+{
+    return content_encoding.is_one_of("gzip"sv, "deflate"sv, "br"sv, "zstd"sv);
 }
 
 Job::Job(HttpRequest&& request, Stream& output_stream)
@@ -103,8 +50,31 @@ void Job::start(Core::Socket& socket)
     });
 }
 
+void Job::start(Http2Connection& connection)
+{
+    VERIFY(!m_socket && !m_http2_connection);
+    m_http2_connection = connection.make_weak_ptr<Http2Connection>();
+    m_is_using_http2 = true;
+    dbgln_if(HTTPJOB_DEBUG, "Starting request for {} on an HTTP/2 connection", url());
+    deferred_invoke([this] {
+        if (is_cancelled())
+            return;
+        if (!m_http2_connection)
+            return did_fail(Core::NetworkJob::Error::ConnectionFailed);
+        m_http2_connection->open_stream(*this);
+    });
+}
+
 void Job::shutdown(ShutdownMode mode)
 {
+    if (m_http2_connection) {
+        // The connection belongs to all of its streams, so only ours is closed.
+        auto connection = m_http2_connection.strong_ref();
+        m_http2_connection = nullptr;
+        connection->close_stream(*this);
+        return;
+    }
+
     if (!m_socket)
         return;
     if (mode == ShutdownMode::CloseSocket) {
@@ -118,7 +88,7 @@ void Job::shutdown(ShutdownMode mode)
 
 void Job::flush_received_buffers()
 {
-    if (!m_can_stream_response || m_buffered_size == 0)
+    if (m_buffered_size == 0)
         return;
     dbgln_if(JOB_DEBUG, "Job: Flushing received buffers: have {} bytes in {} buffers for {}", m_buffered_size, m_received_buffers.size(), m_request.url());
     for (size_t i = 0; i < m_received_buffers.size(); ++i) {
@@ -150,6 +120,102 @@ void Job::flush_received_buffers()
     dbgln_if(JOB_DEBUG, "Job: Flushing received buffers done: have {} bytes in {} buffers for {}", m_buffered_size, m_received_buffers.size(), m_request.url());
 }
 
+ErrorOr<void> Job::create_content_decoder()
+{
+    dbgln_if(JOB_DEBUG, "Job: Decoding content with encoding {} for {}", m_content_encoding, m_request.url());
+
+    if (m_content_encoding == "gzip"sv) {
+        m_content_decoder = TRY(try_make<Compress::GzipDecompressor>(MaybeOwned<Stream>(*m_encoded_content)));
+    } else if (m_content_encoding == "deflate"sv) {
+        // Even though the content encoding is "deflate", it's actually deflate with the zlib wrapper.
+        // https://tools.ietf.org/html/rfc7230#section-4.2.2
+        Array<u8, sizeof(Compress::ZlibHeader)> header_bytes {};
+        auto read_header_bytes = TRY(m_encoded_content->read(header_bytes));
+        Compress::ZlibHeader header { .as_u16 = static_cast<u16>(header_bytes[0] << 8 | header_bytes[1]) };
+        bool has_zlib_header = read_header_bytes.size() == header_bytes.size()
+            && header.compression_method == Compress::ZlibCompressionMethod::Deflate
+            && header.compression_info <= 7
+            && !header.present_dictionary
+            && header.as_u16 % 31 == 0;
+
+        if (!has_zlib_header) {
+            // From the RFC:
+            // "Note: Some non-conformant implementations send the "deflate"
+            //        compressed data without the zlib wrapper."
+            dbgln_if(JOB_DEBUG, "Job: Deflate content has no zlib header, decoding it as raw deflate");
+            auto encoded_content = TRY(try_make<AllocatingMemoryStream>());
+            TRY(encoded_content->write_entire_buffer(read_header_bytes));
+            TRY(encoded_content->write_entire_buffer(TRY(m_encoded_content->read_until_eof())));
+            m_encoded_content = move(encoded_content);
+        }
+        // The Adler-32 checksum after the deflate data is left unread.
+        m_content_decoder = TRY(Compress::DeflateDecompressor::construct(MaybeOwned<Stream>(*m_encoded_content)));
+    } else if (m_content_encoding == "br"sv) {
+        m_content_decoder = TRY(try_make<Compress::BrotliDecompressionStream>(*m_encoded_content));
+    } else if (m_content_encoding == "zstd"sv) {
+        m_content_decoder = TRY(Compress::ZstdDecompressor::construct(MaybeOwned<Stream>(*m_encoded_content)));
+    } else {
+        VERIFY_NOT_REACHED();
+    }
+    return {};
+}
+
+ErrorOr<void> Job::decode_received_content()
+{
+    auto has_received_all_content = m_state == State::Finished;
+    while (!m_has_decoded_all_content && !is_output_backed_up()) {
+        if (!has_received_all_content && m_encoded_content->used_buffer_size() < content_decoding_lookahead)
+            break;
+
+        if (!m_content_decoder) {
+            // There may be no content at all, like in a response to a HEAD request.
+            if (m_encoded_content->is_eof()) {
+                m_has_decoded_all_content = true;
+                break;
+            }
+            TRY(create_content_decoder());
+        }
+
+        auto buffer = TRY(ByteBuffer::create_uninitialized(content_decoding_chunk_size));
+        auto decoded = TRY(m_content_decoder->read(buffer));
+        if (decoded.is_empty()) {
+            // Anything after the end of the encoded data is ignored.
+            m_has_decoded_all_content = true;
+            break;
+        }
+        buffer.resize(decoded.size());
+
+        m_buffered_size += buffer.size();
+        m_received_buffers.append(make<ReceivedBuffer>(move(buffer)));
+        flush_received_buffers();
+    }
+    return {};
+}
+
+ErrorOr<void> Job::did_receive_body_data(ByteBuffer data)
+{
+    m_received_size += data.size();
+    if (m_encoded_content) {
+        TRY(m_encoded_content->write_entire_buffer(data));
+        TRY(decode_received_content());
+    } else {
+        m_buffered_size += data.size();
+        m_received_buffers.append(make<ReceivedBuffer>(move(data)));
+    }
+    flush_received_buffers();
+    return {};
+}
+
+// Instead of buffering the rest of the body, we stop receiving it until the client has read what we have.
+void Job::wait_for_client_to_catch_up()
+{
+    dbgln_if(JOB_DEBUG, "Job: Client is {} bytes behind on {}, waiting for it to catch up", m_buffered_size, m_request.url());
+    if (m_socket && !m_is_using_http2)
+        m_socket->set_notifications_enabled(false);
+    if (!has_timer())
+        start_timer(50);
+}
+
 void Job::register_on_ready_to_read(Function<void()> callback)
 {
     m_socket->on_ready_to_read = [this, callback = move(callback)] {
@@ -160,7 +226,7 @@ void Job::register_on_ready_to_read(Function<void()> callback)
         auto can_read_without_blocking = m_socket->can_read_without_blocking();
         if (can_read_without_blocking.is_error())
             return deferred_invoke([this] { did_fail(Core::NetworkJob::Error::TransmissionFailed); });
-        if (can_read_without_blocking.value() && m_state != State::Finished && !has_error()) {
+        if (can_read_without_blocking.value() && m_state != State::Finished && !has_error() && !is_output_backed_up()) {
             deferred_invoke([this] {
                 if (m_socket && m_socket->on_ready_to_read)
                     m_socket->on_ready_to_read();
@@ -312,12 +378,7 @@ void Job::on_socket_connected()
                 if (m_state == State::Trailers) {
                     return finish_up();
                 }
-                if (on_headers_received) {
-                    if (!m_set_cookie_headers.is_empty())
-                        m_headers.set("Set-Cookie", JsonArray { m_set_cookie_headers }.to_deprecated_string());
-                    on_headers_received(m_headers, m_code > 0 ? m_code : Optional<u32> {});
-                }
-                m_state = State::InBody;
+                did_receive_all_headers();
 
                 // We've reached the end of the headers, there's a possibility that the server
                 // responds with nothing (content-length = 0 with normal encoding); if that's the case,
@@ -356,35 +417,7 @@ void Job::on_socket_connected()
                 dbgln("Job: Malformed HTTP header: '{}' ({})", line, line.length());
                 return deferred_invoke([this] { did_fail(Core::NetworkJob::Error::ProtocolFailed); });
             }
-            auto value = line.substring(name.length() + 2, line.length() - name.length() - 2);
-            if (name.equals_ignoring_case("Set-Cookie"sv)) {
-                dbgln_if(JOB_DEBUG, "Job: Received Set-Cookie header: '{}'", value);
-                m_set_cookie_headers.append(move(value));
-
-                auto can_read_without_blocking = m_socket->can_read_without_blocking();
-                if (can_read_without_blocking.is_error())
-                    return deferred_invoke([this] { did_fail(Core::NetworkJob::Error::TransmissionFailed); });
-                if (!can_read_without_blocking.value())
-                    return;
-            } else if (auto existing_value = m_headers.get(name); existing_value.has_value()) {
-                StringBuilder builder;
-                builder.append(existing_value.value());
-                builder.append(',');
-                builder.append(value);
-                m_headers.set(name, builder.to_deprecated_string());
-            } else {
-                m_headers.set(name, value);
-            }
-            if (name.equals_ignoring_case("Content-Encoding"sv)) {
-                // Assume that any content-encoding means that we can't decode it as a stream :(
-                dbgln_if(JOB_DEBUG, "Content-Encoding {} detected, cannot stream output :(", value);
-                m_can_stream_response = false;
-            } else if (name.equals_ignoring_case("Content-Length"sv)) {
-                auto length = value.to_uint();
-                if (length.has_value())
-                    m_content_length = length.value();
-            }
-            dbgln_if(JOB_DEBUG, "Job: [{}] = '{}'", name, value);
+            add_response_header(name, line.substring(name.length() + 2, line.length() - name.length() - 2));
 
             auto can_read_without_blocking = m_socket->can_read_without_blocking();
             if (can_read_without_blocking.is_error())
@@ -397,6 +430,11 @@ void Job::on_socket_connected()
         VERIFY(m_state == State::InBody);
 
         while (true) {
+            if (is_output_backed_up()) {
+                wait_for_client_to_catch_up();
+                break;
+            }
+
             auto can_read_without_blocking = m_socket->can_read_without_blocking();
             if (can_read_without_blocking.is_error())
                 return deferred_invoke([this] { did_fail(Core::NetworkJob::Error::TransmissionFailed); });
@@ -510,10 +548,11 @@ void Job::on_socket_connected()
                 }
             }
 
-            m_received_buffers.append(make<ReceivedBuffer>(payload));
-            m_buffered_size += payload.size();
-            m_received_size += payload.size();
-            flush_received_buffers();
+            auto payload_size = payload.size();
+            if (auto result = did_receive_body_data(move(payload)); result.is_error()) {
+                dbgln_if(JOB_DEBUG, "Job: Could not handle the payload: {}", result.error());
+                return deferred_invoke([this] { did_fail(Core::NetworkJob::Error::TransmissionFailed); });
+            }
 
             deferred_invoke([this] { did_progress(m_content_length, m_received_size); });
 
@@ -532,7 +571,7 @@ void Job::on_socket_connected()
             }
 
             if (m_current_chunk_remaining_size.has_value()) {
-                auto size = m_current_chunk_remaining_size.value() - payload.size();
+                auto size = m_current_chunk_remaining_size.value() - payload_size;
 
                 dbgln_if(JOB_DEBUG, "Job: We have {} bytes left over in this chunk", size);
                 if (size == 0) {
@@ -571,48 +610,152 @@ void Job::on_socket_connected()
     });
 }
 
+void Job::add_response_header(StringView name, DeprecatedString value)
+{
+    dbgln_if(JOB_DEBUG, "Job: [{}] = '{}'", name, value);
+
+    if (name.equals_ignoring_case("Set-Cookie"sv)) {
+        m_set_cookie_headers.append(move(value));
+        return;
+    }
+
+    if (name.equals_ignoring_case("Content-Length"sv)) {
+        auto length = value.to_uint();
+        if (length.has_value())
+            m_content_length = length.value();
+    }
+
+    if (auto existing_value = m_headers.get(name); existing_value.has_value()) {
+        StringBuilder builder;
+        builder.append(existing_value.value());
+        builder.append(',');
+        builder.append(value);
+        m_headers.set(name, builder.to_deprecated_string());
+    } else {
+        m_headers.set(name, move(value));
+    }
+}
+
+void Job::did_receive_all_headers()
+{
+    if (on_headers_received) {
+        if (!m_set_cookie_headers.is_empty())
+            m_headers.set("Set-Cookie", JsonArray { m_set_cookie_headers }.to_deprecated_string());
+        on_headers_received(m_headers, m_code > 0 ? m_code : Optional<u32> {});
+    }
+    m_state = State::InBody;
+
+    auto content_encoding = m_headers.get("Content-Encoding"sv);
+    if (content_encoding.has_value() && is_supported_content_encoding(content_encoding->view().trim_whitespace())) {
+        m_content_encoding = content_encoding->view().trim_whitespace();
+        m_encoded_content = make<AllocatingMemoryStream>();
+    }
+}
+
+// RFC9113 section 8.1: A response is a header block, the content in DATA frames, and maybe a header block of trailers.
+void Job::did_receive_http2_headers(Vector<HPack::Header> const& headers)
+{
+    if (m_state != State::InStatus || is_cancelled())
+        return;
+
+    auto status = headers.first_matching([](auto& header) { return header.name == ":status"sv; });
+    if (!status.has_value() || !status->value.to_uint().has_value()) {
+        dbgln("Job: Expected a :status in the response headers");
+        return did_fail(Core::NetworkJob::Error::ProtocolFailed);
+    }
+
+    // Informational responses come before the actual one.
+    auto code = status->value.to_uint().value();
+    if (code < 200)
+        return;
+
+    m_code = code;
+    for (auto& header : headers) {
+        if (!header.name.starts_with(':'))
+            add_response_header(header.name, header.value);
+    }
+    did_receive_all_headers();
+}
+
+void Job::did_receive_http2_data(ReadonlyBytes data)
+{
+    if (is_cancelled() || has_error())
+        return;
+    if (m_state != State::InBody)
+        return did_fail(Core::NetworkJob::Error::ProtocolFailed);
+
+    auto buffer = ByteBuffer::copy(data);
+    if (buffer.is_error())
+        return did_fail(Core::NetworkJob::Error::TransmissionFailed);
+    if (auto result = did_receive_body_data(buffer.release_value()); result.is_error()) {
+        dbgln_if(JOB_DEBUG, "Job: Could not handle the data: {}", result.error());
+        return did_fail(Core::NetworkJob::Error::TransmissionFailed);
+    }
+
+    // The connection stops opening up the stream's window, so the server can only send so much more.
+    if (is_output_backed_up())
+        wait_for_client_to_catch_up();
+
+    deferred_invoke([this] { did_progress(m_content_length, m_received_size); });
+}
+
+void Job::did_end_http2_stream()
+{
+    if (is_cancelled() || has_error() || m_state == State::Finished)
+        return;
+    if (m_state != State::InBody)
+        return did_fail(Core::NetworkJob::Error::ProtocolFailed);
+    finish_up();
+}
+
 void Job::timer_event(Core::TimerEvent& event)
 {
     event.accept();
-    finish_up();
-    if (m_buffered_size == 0)
-        stop_timer();
+    if (m_state == State::Finished)
+        return finish_up();
+
+    if (m_encoded_content) {
+        if (auto result = decode_received_content(); result.is_error()) {
+            dbgln_if(JOB_DEBUG, "Job: Could not decode the content: {}", result.error());
+            stop_timer();
+            return did_fail(Core::NetworkJob::Error::TransmissionFailed);
+        }
+    }
+    flush_received_buffers();
+    if (is_output_backed_up())
+        return;
+
+    dbgln_if(JOB_DEBUG, "Job: Client caught up on {}, receiving the rest of the body", m_request.url());
+    stop_timer();
+    if (m_http2_connection) {
+        m_http2_connection->resume_stream(*this);
+        return;
+    }
+    if (!m_socket)
+        return;
+    m_socket->set_notifications_enabled(true);
+    deferred_invoke([this] {
+        if (m_socket && m_socket->on_ready_to_read)
+            m_socket->on_ready_to_read();
+    });
 }
 
 void Job::finish_up()
 {
     VERIFY(!m_has_scheduled_finish);
     m_state = State::Finished;
-    if (!m_can_stream_response) {
-        auto maybe_flattened_buffer = ByteBuffer::create_uninitialized(m_buffered_size);
-        if (maybe_flattened_buffer.is_error())
-            return did_fail(Core::NetworkJob::Error::TransmissionFailed);
-        auto flattened_buffer = maybe_flattened_buffer.release_value();
 
-        u8* flat_ptr = flattened_buffer.data();
-        for (auto& received_buffer : m_received_buffers) {
-            memcpy(flat_ptr, received_buffer.pending_flush.data(), received_buffer.pending_flush.size());
-            flat_ptr += received_buffer.pending_flush.size();
-        }
-        m_received_buffers.clear();
-
-        // For the time being, we cannot stream stuff with content-encoding set to _anything_.
-        // FIXME: LibCompress exposes a streaming interface, so this can be resolved
-        auto content_encoding = m_headers.get("Content-Encoding");
-        if (content_encoding.has_value()) {
-            if (auto result = handle_content_encoding(flattened_buffer, content_encoding.value()); !result.is_error())
-                flattened_buffer = result.release_value();
-            else
-                return did_fail(Core::NetworkJob::Error::TransmissionFailed);
+    if (m_encoded_content) {
+        if (auto result = decode_received_content(); result.is_error()) {
+            dbgln_if(JOB_DEBUG, "Job: Could not decode the content: {}", result.error());
+            if (has_timer())
+                stop_timer();
+            return did_fail(Core::NetworkJob::Error::TransmissionFailed);
         }
-
-        m_buffered_size = flattened_buffer.size();
-        m_received_buffers.append(make<ReceivedBuffer>(move(flattened_buffer)));
-        m_can_stream_response = true;
     }
 
     flush_received_buffers();
-    if (m_buffered_size != 0) {
+    if (m_buffered_size != 0 || (m_encoded_content && !m_has_decoded_all_content)) {
         // We have to wait for the client to consume all the downloaded data
         // before we can actually call `did_finish`. in a normal flow, this should
         // never be hit since the client is reading as we are writing, unless there
@@ -623,6 +766,8 @@ void Job::finish_up()
         return;
     }
 
+    if (has_timer())
+        stop_timer();
     m_has_scheduled_finish = true;
     auto response = HttpResponse::create(m_code, move(m_headers), m_received_size);
     deferred_invoke([this, response = move(response)] {
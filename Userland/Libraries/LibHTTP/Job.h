@@ -7,10 +7,14 @@
 #pragma once
 
 #include <AK/HashMap.h>
+#include <AK/MemoryStream.h>
 #include <AK/NonnullOwnPtrVector.h>
 #include <AK/Optional.h>
+#include <AK/WeakPtr.h>
 #include <LibCore/NetworkJob.h>
 #include <LibCore/Socket.h>
+#include <LibHTTP/Forward.h>
+#include <LibHTTP/HPack.h>
 #include <LibHTTP/HttpRequest.h>
 #include <LibHTTP/HttpResponse.h>
 
@@ -26,15 +30,35 @@ public:
     virtual void start(Core::Socket&) override;
     virtual void shutdown(ShutdownMode) override;
 
+    // Runs the request on a stream of an HTTP/2 connection, which may be shared with other requests.
+    void start(Http2Connection&);
+    bool is_using_http2() const { return m_is_using_http2; }
+
+    // The client is this far behind in reading the body, so no more of it is received or decoded until it catches up.
+    static constexpr size_t max_buffered_size = 1 * MiB;
+    bool is_output_backed_up() const { return m_buffered_size >= max_buffered_size; }
+
     Core::Socket const* socket() const { return m_socket; }
     URL url() const { return m_request.url(); }
+    HttpRequest const& request() const { return m_request; }
 
     HttpResponse* response() { return static_cast<HttpResponse*>(Core::NetworkJob::response()); }
     HttpResponse const* response() const { return static_cast<HttpResponse const*>(Core::NetworkJob::response()); }
 
 protected:
+    friend class Http2Connection;
+
     void finish_up();
     void on_socket_connected();
+    void add_response_header(StringView name, DeprecatedString value);
+    void did_receive_all_headers();
+    ErrorOr<void> did_receive_body_data(ByteBuffer);
+    ErrorOr<void> decode_received_content();
+    ErrorOr<void> create_content_decoder();
+    void wait_for_client_to_catch_up();
+    void did_receive_http2_headers(Vector<HPack::Header> const&);
+    void did_receive_http2_data(ReadonlyBytes);
+    void did_end_http2_stream();
     void flush_received_buffers();
     void register_on_ready_to_read(Function<void()>);
     ErrorOr<DeprecatedString> read_line(size_t);
@@ -78,9 +102,18 @@ protected:
     Optional<u32> m_content_length;
     Optional<ssize_t> m_current_chunk_remaining_size;
     Optional<size_t> m_current_chunk_total_size;
-    bool m_can_stream_response { true };
     bool m_should_read_chunk_ending_line { false };
     bool m_has_scheduled_finish { false };
+
+    // The body is decoded as it comes in if it has a Content-Encoding we know.
+    DeprecatedString m_content_encoding;
+    OwnPtr<AllocatingMemoryStream> m_encoded_content;
+    OwnPtr<Stream> m_content_decoder;
+    bool m_has_decoded_all_content { false };
+
+    WeakPtr<Http2Connection> m_http2_connection;
+    u32 m_http2_stream_id { 0 };
+    bool m_is_using_http2 { false };
 };
 
 }
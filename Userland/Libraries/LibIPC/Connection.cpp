@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ScopeGuard.h>
 #include <LibCore/System.h>
 #include <LibIPC/Connection.h>
 #include <LibIPC/Stub.h>
@@ -12,6 +13,8 @@
 
 namespace IPC {
 
+static constexpr size_t max_batched_bytes = 16 * KiB;
+
 struct CoreEventLoopDeferredInvoker final : public DeferredInvoker {
     virtual ~CoreEventLoopDeferredInvoker() = default;
 
@@ -28,6 +31,8 @@ ConnectionBase::ConnectionBase(IPC::Stub& local_stub, NonnullOwnPtr<Core::LocalS
     , m_deferred_invoker(make<CoreEventLoopDeferredInvoker>())
 {
     m_responsiveness_timer = Core::Timer::create_single_shot(3000, [this] { may_have_become_unresponsive(); }).release_value_but_fixme_should_propagate_errors();
+    // This gets restarted for every message we send, and it doesn't matter if it fires a bit late.
+    m_responsiveness_timer->set_precision(Core::TimerPrecision::Coarse);
 }
 
 void ConnectionBase::set_deferred_invoker(NonnullOwnPtr<DeferredInvoker> deferred_invoker)
@@ -59,9 +64,7 @@ ErrorOr<void> ConnectionBase::post_message(MessageBuffer buffer)
     if (!m_socket->is_open())
         return Error::from_string_literal("Trying to post_message during IPC shutdown");
 
-    // Prepend the message size.
     uint32_t message_size = buffer.data.size();
-    TRY(buffer.data.try_prepend(reinterpret_cast<u8 const*>(&message_size), sizeof(message_size)));
 
     for (auto& fd : buffer.fds) {
         if (auto result = fd_passing_socket().send_fd(fd.value()); result.is_error()) {
@@ -70,7 +73,50 @@ ErrorOr<void> ConnectionBase::post_message(MessageBuffer buffer)
         }
     }
 
-    ReadonlyBytes bytes_to_write { buffer.data.span() };
+    if (m_batch_depth > 0) {
+        // Messages are framed the same way as if they had been written one by one.
+        TRY(m_batched_bytes.try_append(reinterpret_cast<u8 const*>(&message_size), sizeof(message_size)));
+        TRY(m_batched_bytes.try_extend(buffer.data));
+        if (!m_batch_flush_scheduled) {
+            m_batch_flush_scheduled = true;
+            m_deferred_invoker->schedule([strong_this = NonnullRefPtr(*this)] {
+                strong_this->m_batch_flush_scheduled = false;
+                if (auto result = strong_this->flush_batched_messages(); result.is_error())
+                    dbgln("IPC::ConnectionBase::post_message: {}", result.error());
+            });
+        }
+        // Don't let the peer wait for too long, and don't let a single write get so large that the socket buffer overflows.
+        if (m_batched_bytes.size() >= max_batched_bytes)
+            return flush_batched_messages();
+        return {};
+    }
+
+    // Prepend the message size.
+    TRY(buffer.data.try_prepend(reinterpret_cast<u8 const*>(&message_size), sizeof(message_size)));
+    return write_to_socket(buffer.data.span());
+}
+
+ErrorOr<void> ConnectionBase::end_batch()
+{
+    VERIFY(m_batch_depth > 0);
+    if (--m_batch_depth > 0)
+        return {};
+    return flush_batched_messages();
+}
+
+ErrorOr<void> ConnectionBase::flush_batched_messages()
+{
+    if (m_batched_bytes.is_empty())
+        return {};
+
+    ScopeGuard clear_batched_bytes = [&] { m_batched_bytes.clear_with_capacity(); };
+    if (!m_socket->is_open())
+        return Error::from_string_literal("Trying to flush batched messages during IPC shutdown");
+    return write_to_socket(m_batched_bytes.span());
+}
+
+ErrorOr<void> ConnectionBase::write_to_socket(ReadonlyBytes bytes_to_write)
+{
     int writes_done = 0;
     size_t initial_size = bytes_to_write.size();
     while (!bytes_to_write.is_empty()) {
@@ -112,9 +158,40 @@ ErrorOr<void> ConnectionBase::post_message(MessageBuffer buffer)
     return {};
 }
 
+void ConnectionBase::expect_response(u32 endpoint_magic, int message_id, Function<void(OwnPtr<Message>)> callback)
+{
+    if (!m_socket->is_open()) {
+        m_deferred_invoker->schedule([callback = move(callback)] { callback(nullptr); });
+        return;
+    }
+    m_pending_responses.append({ endpoint_magic, message_id, move(callback) });
+}
+
+bool ConnectionBase::resolve_pending_response(NonnullOwnPtr<Message>& message)
+{
+    for (size_t i = 0; i < m_pending_responses.size(); ++i) {
+        auto& pending = m_pending_responses[i];
+        if (pending.endpoint_magic != message->endpoint_magic() || pending.message_id != message->message_id())
+            continue;
+        auto callback = m_pending_responses.take(i).callback;
+        callback(move(message));
+        return true;
+    }
+    return false;
+}
+
 void ConnectionBase::shutdown()
 {
+    m_batched_bytes.clear();
     m_socket->close();
+
+    if (!m_pending_responses.is_empty()) {
+        m_deferred_invoker->schedule([pending_responses = move(m_pending_responses)] {
+            for (auto& pending : pending_responses)
+                pending.callback(nullptr);
+        });
+    }
+
     die();
 }
 
@@ -127,18 +204,30 @@ void ConnectionBase::shutdown_with_error(Error const& error)
 void ConnectionBase::handle_messages()
 {
     auto messages = move(m_unprocessed_messages);
-    for (auto& message : messages) {
-        if (message.endpoint_magic() == m_local_endpoint_magic) {
-            auto handler_result = m_local_stub.handle(message);
-            if (handler_result.is_error()) {
-                dbgln("IPC::ConnectionBase::handle_messages: {}", handler_result.error());
-                continue;
-            }
 
-            if (auto response = handler_result.release_value()) {
-                if (auto post_result = post_message(*response); post_result.is_error()) {
-                    dbgln("IPC::ConnectionBase::handle_messages: {}", post_result.error());
-                }
+    // Send out the responses (and whatever else the handlers post) together once we're done with this round.
+    begin_batch();
+    ScopeGuard end_batch_guard = [&] {
+        if (auto result = end_batch(); result.is_error())
+            dbgln("IPC::ConnectionBase::handle_messages: {}", result.error());
+    };
+
+    for (size_t i = 0; i < messages.size(); ++i) {
+        auto& message = messages[i];
+        if (message.endpoint_magic() != m_local_endpoint_magic) {
+            resolve_pending_response(messages.ptr_at(i));
+            continue;
+        }
+
+        auto handler_result = m_local_stub.handle(message);
+        if (handler_result.is_error()) {
+            dbgln("IPC::ConnectionBase::handle_messages: {}", handler_result.error());
+            continue;
+        }
+
+        if (auto response = handler_result.release_value()) {
+            if (auto post_result = post_message(*response); post_result.is_error()) {
+                dbgln("IPC::ConnectionBase::handle_messages: {}", post_result.error());
             }
         }
     }
@@ -241,15 +330,30 @@ ErrorOr<void> ConnectionBase::drain_messages_from_peer()
 
 OwnPtr<IPC::Message> ConnectionBase::wait_for_specific_endpoint_message_impl(u32 endpoint_magic, int message_id)
 {
+    // The peer can't answer what it hasn't received yet.
+    if (auto result = flush_batched_messages(); result.is_error()) {
+        dbgln("IPC::ConnectionBase::wait_for_specific_endpoint_message_impl: {}", result.error());
+        return {};
+    }
+
     for (;;) {
         // Double check we don't already have the event waiting for us.
         // Otherwise we might end up blocked for a while for no reason.
+        // Responses to earlier asynchronous requests of the same kind arrive first, and belong to those.
+        size_t responses_to_skip = 0;
+        for (auto& pending : m_pending_responses) {
+            if (pending.endpoint_magic == endpoint_magic && pending.message_id == message_id)
+                ++responses_to_skip;
+        }
         for (size_t i = 0; i < m_unprocessed_messages.size(); ++i) {
             auto& message = m_unprocessed_messages[i];
-            if (message.endpoint_magic() != endpoint_magic)
+            if (message.endpoint_magic() != endpoint_magic || message.message_id() != message_id)
                 continue;
-            if (message.message_id() == message_id)
-                return m_unprocessed_messages.take(i);
+            if (responses_to_skip > 0) {
+                --responses_to_skip;
+                continue;
+            }
+            return m_unprocessed_messages.take(i);
         }
 
         if (!m_socket->is_open())
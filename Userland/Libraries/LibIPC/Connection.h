@@ -46,6 +46,21 @@ public:
     bool is_open() const { return m_socket->is_open(); }
     ErrorOr<void> post_message(Message const&);
 
+    // While a batch is open, posted messages are collected and sent to the peer with a single write once the
+    // outermost batch ends, or when we are about to block waiting for the peer. As handlers may also wait by
+    // spinning a nested event loop (e.g. for a dialog to be closed), a flush is scheduled on the event loop as
+    // well, which takes effect as soon as anything pumps it before the batch ends. File descriptors attached to
+    // messages are still sent right away, which is fine since the peer only picks them up while decoding.
+    void begin_batch() { ++m_batch_depth; }
+    ErrorOr<void> end_batch();
+    ErrorOr<void> flush_batched_messages();
+
+    // Calls the callback with the next message from the given endpoint with the given ID, once the
+    // messages from the peer are handled. Callbacks waiting on the same kind of message are served in
+    // the order they were registered in, which works out since the peer answers requests in order.
+    // If the connection shuts down first, the callback gets a null message instead.
+    void expect_response(u32 endpoint_magic, int message_id, Function<void(OwnPtr<Message>)>);
+
     void shutdown();
     virtual void die() { }
 
@@ -61,11 +76,13 @@ protected:
     virtual void shutdown_with_error(Error const&);
 
     OwnPtr<IPC::Message> wait_for_specific_endpoint_message_impl(u32 endpoint_magic, int message_id);
+    bool resolve_pending_response(NonnullOwnPtr<Message>&);
     void wait_for_socket_to_become_readable();
     ErrorOr<Vector<u8>> read_as_much_as_possible_from_socket_without_blocking();
     ErrorOr<void> drain_messages_from_peer();
 
     ErrorOr<void> post_message(MessageBuffer);
+    ErrorOr<void> write_to_socket(ReadonlyBytes);
     void handle_messages();
 
     IPC::Stub& m_local_stub;
@@ -78,6 +95,17 @@ protected:
     NonnullOwnPtrVector<Message> m_unprocessed_messages;
     ByteBuffer m_unprocessed_bytes;
 
+    size_t m_batch_depth { 0 };
+    Vector<u8> m_batched_bytes;
+    bool m_batch_flush_scheduled { false };
+
+    struct PendingResponse {
+        u32 endpoint_magic { 0 };
+        int message_id { 0 };
+        Function<void(OwnPtr<Message>)> callback;
+    };
+    Vector<PendingResponse> m_pending_responses;
+
     u32 m_local_endpoint_magic { 0 };
 
     NonnullOwnPtr<DeferredInvoker> m_deferred_invoker;
@@ -120,6 +148,23 @@ public:
         return wait_for_specific_endpoint_message<typename RequestType::ResponseType, PeerEndpoint>();
     }
 
+    // Like send_sync_but_allow_failure(), but instead of blocking until the response arrives, on_response is
+    // called with it from the event loop. Any number of these can be in flight at the same time.
+    template<typename RequestType, typename... Args>
+    void send_async(Function<void(OwnPtr<typename RequestType::ResponseType>)> on_response, Args&&... args)
+    {
+        using ResponseType = typename RequestType::ResponseType;
+        expect_response(PeerEndpoint::static_magic(), ResponseType::static_message_id(), [on_response = move(on_response)](OwnPtr<Message> message) {
+            if (!message) {
+                on_response(nullptr);
+                return;
+            }
+            on_response(message.template release_nonnull<ResponseType>());
+        });
+        // If this fails, the connection has been shut down, which takes care of the callback.
+        (void)post_message(RequestType(forward<Args>(args)...));
+    }
+
 protected:
     template<typename MessageType, typename Endpoint>
     OwnPtr<MessageType> wait_for_specific_endpoint_message()
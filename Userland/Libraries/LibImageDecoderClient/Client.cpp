@@ -5,6 +5,7 @@
  */
 
 #include <LibCore/AnonymousBuffer.h>
+#include <LibCore/EventLoop.h>
 #include <LibImageDecoderClient/Client.h>
 
 namespace ImageDecoderClient {
@@ -16,24 +17,54 @@ Client::Client(NonnullOwnPtr<Core::LocalSocket> socket)
 
 void Client::die()
 {
+    // Nobody is going to decode the images we're still waiting for, so let their callers know.
+    auto pending_decodes = move(m_pending_decodes);
+    for (auto& it : pending_decodes)
+        it.value({});
+
     if (on_death)
         on_death();
 }
 
-Optional<DecodedImage> Client::decode_image(ReadonlyBytes encoded_data, Optional<DeprecatedString> mime_type)
+static Optional<Core::AnonymousBuffer> copy_to_anonymous_buffer(ReadonlyBytes encoded_data)
 {
-    if (encoded_data.is_empty())
-        return {};
-
     auto encoded_buffer_or_error = Core::AnonymousBuffer::create_with_size(encoded_data.size());
     if (encoded_buffer_or_error.is_error()) {
         dbgln("Could not allocate encoded buffer");
         return {};
     }
     auto encoded_buffer = encoded_buffer_or_error.release_value();
-
     memcpy(encoded_buffer.data<void>(), encoded_data.data(), encoded_data.size());
-    auto response_or_error = try_decode_image(move(encoded_buffer), mime_type);
+    return encoded_buffer;
+}
+
+static Optional<DecodedImage> make_decoded_image(bool is_animated, u32 loop_count, Vector<Gfx::ShareableBitmap> bitmaps, Vector<u32> const& durations)
+{
+    if (bitmaps.is_empty())
+        return {};
+
+    DecodedImage image;
+    image.is_animated = is_animated;
+    image.loop_count = loop_count;
+    image.frames.resize(bitmaps.size());
+    for (size_t i = 0; i < image.frames.size(); ++i) {
+        auto& frame = image.frames[i];
+        frame.bitmap = bitmaps[i].bitmap();
+        frame.duration = durations[i];
+    }
+    return image;
+}
+
+Optional<DecodedImage> Client::decode_image(ReadonlyBytes encoded_data, Optional<DeprecatedString> mime_type)
+{
+    if (encoded_data.is_empty())
+        return {};
+
+    auto encoded_buffer = copy_to_anonymous_buffer(encoded_data);
+    if (!encoded_buffer.has_value())
+        return {};
+
+    auto response_or_error = try_decode_image(encoded_buffer.release_value(), mime_type);
 
     if (response_or_error.is_error()) {
         dbgln("ImageDecoder died heroically");
@@ -41,21 +72,32 @@ Optional<DecodedImage> Client::decode_image(ReadonlyBytes encoded_data, Optional
     }
 
     auto& response = response_or_error.value();
+    return make_decoded_image(response.is_animated(), response.loop_count(), response.take_bitmaps(), response.durations());
+}
 
-    if (response.bitmaps().is_empty())
-        return {};
+void Client::decode_image_async(ReadonlyBytes encoded_data, Function<void(Optional<DecodedImage>)> on_complete, Optional<DeprecatedString> mime_type)
+{
+    auto encoded_buffer = encoded_data.is_empty() ? Optional<Core::AnonymousBuffer> {} : copy_to_anonymous_buffer(encoded_data);
+    if (!encoded_buffer.has_value()) {
+        Core::deferred_invoke([on_complete = move(on_complete)] {
+            on_complete({});
+        });
+        return;
+    }
 
-    DecodedImage image;
-    image.is_animated = response.is_animated();
-    image.loop_count = response.loop_count();
-    image.frames.resize(response.bitmaps().size());
-    auto bitmaps = response.take_bitmaps();
-    for (size_t i = 0; i < image.frames.size(); ++i) {
-        auto& frame = image.frames[i];
-        frame.bitmap = bitmaps[i].bitmap();
-        frame.duration = response.durations()[i];
+    auto request_id = m_next_request_id++;
+    m_pending_decodes.set(request_id, move(on_complete));
+    async_decode_image_async(request_id, encoded_buffer.release_value(), mime_type);
+}
+
+void Client::did_decode_image(i64 request_id, bool is_animated, u32 loop_count, Vector<Gfx::ShareableBitmap> const& bitmaps, Vector<u32> const& durations)
+{
+    auto on_complete = m_pending_decodes.take(request_id);
+    if (!on_complete.has_value()) {
+        dbgln("ImageDecoder sent a decoded image we didn't ask for");
+        return;
     }
-    return image;
+    on_complete.value()(make_decoded_image(is_animated, loop_count, bitmaps, durations));
 }
 
 }
@@ -32,12 +32,22 @@ class Client final
 public:
     Optional<DecodedImage> decode_image(ReadonlyBytes, Optional<DeprecatedString> mime_type = {});
 
+    // Sends the image off to be decoded without waiting for the result. on_complete is called from the event loop once the
+    // image was decoded, or failed to decode.
+    void decode_image_async(ReadonlyBytes, Function<void(Optional<DecodedImage>)> on_complete, Optional<DeprecatedString> mime_type = {});
+    size_t pending_decode_count() const { return m_pending_decodes.size(); }
+
     Function<void()> on_death;
 
 private:
     Client(NonnullOwnPtr<Core::LocalSocket>);
 
     virtual void die() override;
+
+    virtual void did_decode_image(i64 request_id, bool is_animated, u32 loop_count, Vector<Gfx::ShareableBitmap> const& bitmaps, Vector<u32> const& durations) override;
+
+    HashMap<i64, Function<void(Optional<DecodedImage>)>> m_pending_decodes;
+    i64 m_next_request_id { 0 };
 };
 
 }
@@ -33,6 +33,7 @@
 #include <LibJS/Runtime/PromiseConstructor.h>
 #include <LibJS/Runtime/Reference.h>
 #include <LibJS/Runtime/RegExpObject.h>
+#include <LibJS/Runtime/SamplingProfiler.h>
 #include <LibJS/Runtime/Shape.h>
 #include <typeinfo>
 
@@ -47,8 +48,11 @@ public:
         : m_interpreter(interpreter)
         , m_chain_node { nullptr, node }
     {
-        m_interpreter.vm().running_execution_context().current_node = &node;
+        auto& vm = m_interpreter.vm();
+        vm.running_execution_context().current_node = &node;
         m_interpreter.push_ast_node(m_chain_node);
+        if (auto* profiler = vm.sampling_profiler()) [[unlikely]]
+            profiler->sample_if_due();
     }
 
     ~InterpreterNodeScope()
@@ -73,6 +77,17 @@ SourceRange ASTNode::source_range() const
     return m_source_code->range_from_offsets(m_start_offset, m_end_offset);
 }
 
+DeprecatedString const& LazySourceText::string() const
+{
+    if (!m_string.has_value()) {
+        if (m_code)
+            m_string = DeprecatedString { m_code->code().bytes_as_string_view().substring_view(m_start_offset, m_end_offset - m_start_offset) };
+        else
+            m_string = DeprecatedString::empty();
+    }
+    return *m_string;
+}
+
 DeprecatedString ASTNode::class_name() const
 {
     // NOTE: We strip the "JS::" prefix.
@@ -1870,7 +1885,7 @@ Completion ClassExpression::execute(Interpreter& interpreter) const
     auto* value = TRY(class_definition_evaluation(interpreter, m_name, m_name.is_null() ? "" : m_name));
 
     // 3. Set value.[[SourceText]] to the source text matched by ClassExpression.
-    value->set_source_text(m_source_text);
+    value->set_source_text(source_text());
 
     // 4. Return value.
     return Value { value };
@@ -3679,7 +3694,7 @@ Completion RegExpLiteral::execute(Interpreter& interpreter) const
     auto flags = this->flags();
 
     // 3. Return ! RegExpCreate(pattern, flags).
-    Regex<ECMA262> regex(parsed_regex(), parsed_pattern(), parsed_flags());
+    auto regex = compile_regex(parsed_regex(), parsed_pattern(), parsed_flags());
     // NOTE: We bypass RegExpCreate and subsequently RegExpAlloc as an optimization to use the already parsed values.
     auto regexp_object = RegExpObject::create(realm, move(regex), move(pattern), move(flags));
     // RegExpAlloc has these two steps from the 'Legacy RegExp features' proposal.
@@ -3853,10 +3868,13 @@ ThrowCompletionOr<Value> TaggedTemplateLiteral::get_template_object(Interpreter&
     // 3. For each element e of templateRegistry, do
     //    a. If e.[[Site]] is the same Parse Node as templateLiteral, then
     //        i. Return e.[[Array]].
-    // NOTE: Instead of caching on the realm we cache on the Parse Node side as
-    //       this makes it easier to track whether it is the same parse node.
-    if (auto cached_value_or_end = m_cached_values.find(&realm); cached_value_or_end != m_cached_values.end())
-        return Value { cached_value_or_end->value.cell() };
+    // NOTE: Programs are shared between Script and Module Records parsed from the same source (see ProgramCache),
+    //       so the active one is needed to tell apart the Parse Nodes that separate parses would have produced.
+    auto* script_or_module = vm.get_active_script_or_module().visit(
+        [](Empty) -> Cell* { return nullptr; },
+        [](auto const& script_or_module) -> Cell* { return script_or_module.ptr(); });
+    if (auto* template_object = realm.template_object(*this, script_or_module))
+        return template_object;
 
     // 4. Let rawStrings be TemplateStrings of templateLiteral with argument true.
     auto& raw_strings = m_template_literal->raw_strings();
@@ -3915,7 +3933,7 @@ ThrowCompletionOr<Value> TaggedTemplateLiteral::get_template_object(Interpreter&
     MUST(template_->set_integrity_level(Object::IntegrityLevel::Frozen));
 
     // 15. Append the Record { [[Site]]: templateLiteral, [[Array]]: template } to templateRegistry.
-    m_cached_values.set(&realm, make_handle(template_));
+    realm.add_template_object(*this, script_or_module, template_);
 
     // 16. Return template.
     return template_;
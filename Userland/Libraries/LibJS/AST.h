@@ -58,6 +58,7 @@ public:
     virtual void dump(int indent) const;
 
     [[nodiscard]] SourceRange source_range() const;
+    SourceCode const& source_code() const { return *m_source_code; }
     u32 start_offset() const { return m_start_offset; }
 
     void set_end_offset(Badge<Parser>, u32 end_offset) { m_end_offset = end_offset; }
@@ -645,10 +646,32 @@ struct FunctionParameter {
     bool is_rest { false };
 };
 
+// The source text of a function or class, as returned by Function.prototype.toString().
+// NOTE: It's only copied out of the script once it's first needed, since most of the functions in a big script are
+//       never instantiated, and copying every one of them while parsing adds up to a lot for deeply nested code.
+class LazySourceText {
+public:
+    LazySourceText() = default;
+    LazySourceText(NonnullRefPtr<SourceCode const> code, u32 start_offset, u32 end_offset)
+        : m_code(move(code))
+        , m_start_offset(start_offset)
+        , m_end_offset(end_offset)
+    {
+    }
+
+    DeprecatedString const& string() const;
+
+private:
+    RefPtr<SourceCode const> m_code;
+    u32 m_start_offset { 0 };
+    u32 m_end_offset { 0 };
+    mutable Optional<DeprecatedString> m_string;
+};
+
 class FunctionNode {
 public:
     DeprecatedFlyString const& name() const { return m_name; }
-    DeprecatedString const& source_text() const { return m_source_text; }
+    DeprecatedString const& source_text() const { return m_source_text.string(); }
     Statement const& body() const { return *m_body; }
     Vector<FunctionParameter> const& parameters() const { return m_parameters; };
     i32 function_length() const { return m_function_length; }
@@ -659,7 +682,7 @@ public:
     FunctionKind kind() const { return m_kind; }
 
 protected:
-    FunctionNode(DeprecatedFlyString name, DeprecatedString source_text, NonnullRefPtr<Statement const> body, Vector<FunctionParameter> parameters, i32 function_length, FunctionKind kind, bool is_strict_mode, bool might_need_arguments_object, bool contains_direct_call_to_eval, bool is_arrow_function)
+    FunctionNode(DeprecatedFlyString name, LazySourceText source_text, NonnullRefPtr<Statement const> body, Vector<FunctionParameter> parameters, i32 function_length, FunctionKind kind, bool is_strict_mode, bool might_need_arguments_object, bool contains_direct_call_to_eval, bool is_arrow_function)
         : m_name(move(name))
         , m_source_text(move(source_text))
         , m_body(move(body))
@@ -679,7 +702,7 @@ protected:
 
 private:
     DeprecatedFlyString m_name;
-    DeprecatedString m_source_text;
+    LazySourceText m_source_text;
     NonnullRefPtr<Statement const> m_body;
     Vector<FunctionParameter> const m_parameters;
     const i32 m_function_length;
@@ -696,7 +719,7 @@ class FunctionDeclaration final
 public:
     static bool must_have_name() { return true; }
 
-    FunctionDeclaration(SourceRange source_range, DeprecatedFlyString const& name, DeprecatedString source_text, NonnullRefPtr<Statement const> body, Vector<FunctionParameter> parameters, i32 function_length, FunctionKind kind, bool is_strict_mode, bool might_need_arguments_object, bool contains_direct_call_to_eval)
+    FunctionDeclaration(SourceRange source_range, DeprecatedFlyString const& name, LazySourceText source_text, NonnullRefPtr<Statement const> body, Vector<FunctionParameter> parameters, i32 function_length, FunctionKind kind, bool is_strict_mode, bool might_need_arguments_object, bool contains_direct_call_to_eval)
         : Declaration(source_range)
         , FunctionNode(name, move(source_text), move(body), move(parameters), function_length, kind, is_strict_mode, might_need_arguments_object, contains_direct_call_to_eval, false)
     {
@@ -722,7 +745,7 @@ class FunctionExpression final
 public:
     static bool must_have_name() { return false; }
 
-    FunctionExpression(SourceRange source_range, DeprecatedFlyString const& name, DeprecatedString source_text, NonnullRefPtr<Statement const> body, Vector<FunctionParameter> parameters, i32 function_length, FunctionKind kind, bool is_strict_mode, bool might_need_arguments_object, bool contains_direct_call_to_eval, bool is_arrow_function = false)
+    FunctionExpression(SourceRange source_range, DeprecatedFlyString const& name, LazySourceText source_text, NonnullRefPtr<Statement const> body, Vector<FunctionParameter> parameters, i32 function_length, FunctionKind kind, bool is_strict_mode, bool might_need_arguments_object, bool contains_direct_call_to_eval, bool is_arrow_function = false)
         : Expression(source_range)
         , FunctionNode(name, move(source_text), move(body), move(parameters), function_length, kind, is_strict_mode, might_need_arguments_object, contains_direct_call_to_eval, is_arrow_function)
     {
@@ -1395,7 +1418,7 @@ public:
 
 class ClassExpression final : public Expression {
 public:
-    ClassExpression(SourceRange source_range, DeprecatedString name, DeprecatedString source_text, RefPtr<FunctionExpression const> constructor, RefPtr<Expression const> super_class, NonnullRefPtrVector<ClassElement const> elements)
+    ClassExpression(SourceRange source_range, DeprecatedString name, LazySourceText source_text, RefPtr<FunctionExpression const> constructor, RefPtr<Expression const> super_class, NonnullRefPtrVector<ClassElement const> elements)
         : Expression(source_range)
         , m_name(move(name))
         , m_source_text(move(source_text))
@@ -1406,7 +1429,7 @@ public:
     }
 
     StringView name() const { return m_name; }
-    DeprecatedString const& source_text() const { return m_source_text; }
+    DeprecatedString const& source_text() const { return m_source_text.string(); }
     RefPtr<FunctionExpression const> constructor() const { return m_constructor; }
 
     virtual Completion execute(Interpreter&) const override;
@@ -1421,7 +1444,7 @@ private:
     virtual bool is_class_expression() const override { return true; }
 
     DeprecatedString m_name;
-    DeprecatedString m_source_text;
+    LazySourceText m_source_text;
     RefPtr<FunctionExpression const> m_constructor;
     RefPtr<Expression const> m_super_class;
     NonnullRefPtrVector<ClassElement const> m_elements;
@@ -1864,7 +1887,6 @@ public:
 private:
     NonnullRefPtr<Expression const> const m_tag;
     NonnullRefPtr<TemplateLiteral const> const m_template_literal;
-    mutable HashMap<Realm*, Handle<Array>> m_cached_values;
 };
 
 class MemberExpression final : public Expression {
@@ -6,19 +6,83 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/DeprecatedFlyString.h>
 #include <AK/NonnullOwnPtrVector.h>
+#include <AK/WeakPtr.h>
 #include <LibJS/Bytecode/BasicBlock.h>
 #include <LibJS/Bytecode/IdentifierTable.h>
 #include <LibJS/Bytecode/StringTable.h>
+#include <LibJS/Runtime/Shape.h>
 
 namespace JS::Bytecode {
 
+// Remembers, for the last few shapes seen by a GetById or PutById, where in the object's storage the property was.
+// Objects that have the same shape keep the same property at the same offset, so a hit skips the lookup entirely.
+// Object literal sites also remember which shape adding the property leads to, see PropertyKind::DirectKeyValue.
+struct PropertyLookupCache {
+    static constexpr size_t max_entry_count = 4;
+
+    struct Entry {
+        WeakPtr<Shape> shape;
+        u32 property_offset { 0 };
+        // Set for entries describing a property addition, in which case shape is the one before the addition.
+        bool is_transition { false };
+        WeakPtr<Shape> new_shape;
+    };
+
+    Optional<u32> lookup(Shape const& shape) const
+    {
+        for (auto const& entry : entries) {
+            if (entry.shape.ptr() == &shape && !entry.is_transition)
+                return entry.property_offset;
+        }
+        return {};
+    }
+
+    Shape* lookup_transition(Shape const& shape) const
+    {
+        for (auto const& entry : entries) {
+            if (entry.shape.ptr() == &shape && entry.is_transition)
+                return entry.new_shape.ptr();
+        }
+        return nullptr;
+    }
+
+    void insert(Shape& shape, u32 property_offset)
+    {
+        insert_entry({ shape.make_weak_ptr<Shape>(), property_offset, false, {} });
+    }
+
+    void insert_transition(Shape& shape, Shape& new_shape)
+    {
+        insert_entry({ shape.make_weak_ptr<Shape>(), new_shape.property_count() - 1, true, new_shape.make_weak_ptr<Shape>() });
+    }
+
+    void insert_entry(Entry new_entry)
+    {
+        // Use up free (or dead) entries first, then replace the oldest one.
+        for (auto& entry : entries) {
+            if (!entry.shape || (entry.is_transition && !entry.new_shape)) {
+                entry = move(new_entry);
+                return;
+            }
+        }
+        entries[next_entry_to_replace] = move(new_entry);
+        next_entry_to_replace = (next_entry_to_replace + 1) % max_entry_count;
+    }
+
+    AK::Array<Entry, max_entry_count> entries;
+    size_t next_entry_to_replace { 0 };
+};
+
 struct Executable {
     DeprecatedFlyString name;
     NonnullOwnPtrVector<BasicBlock> basic_blocks;
     NonnullOwnPtr<StringTable> string_table;
     NonnullOwnPtr<IdentifierTable> identifier_table;
+    // Filled in as the code runs, which is why this is mutable.
+    mutable Vector<PropertyLookupCache> property_lookup_caches;
     size_t number_of_registers { 0 };
     bool is_strict_mode { false };
 
@@ -14,6 +14,7 @@
 #include <LibJS/Runtime/GlobalEnvironment.h>
 #include <LibJS/Runtime/GlobalObject.h>
 #include <LibJS/Runtime/Realm.h>
+#include <LibJS/Runtime/SamplingProfiler.h>
 
 namespace JS::Bytecode {
 
@@ -72,6 +73,10 @@ Interpreter::ValueAndFrame Interpreter::run_and_return_frame(Executable const& e
     registers().resize(executable.number_of_registers);
 
     for (;;) {
+        // NOTE: Checking in once per basic block means loops and calls get sampled, without slowing down straight-line code.
+        if (auto* profiler = vm().sampling_profiler()) [[unlikely]]
+            profiler->sample_if_due();
+
         Bytecode::InstructionStreamIterator pc(m_current_block->instruction_stream());
         TemporaryChange temp_change { m_pc, &pc };
 
@@ -272,6 +277,7 @@ Bytecode::PassManager& Interpreter::optimization_pipeline(Interpreter::Optimizat
         pm->add<Passes::GenerateCFG>();
         pm->add<Passes::PlaceBlocks>();
         pm->add<Passes::EliminateLoads>();
+        pm->add<Passes::Peephole>();
     } else {
         VERIFY_NOT_REACHED();
     }
@@ -25,6 +25,7 @@
 #include <LibJS/Runtime/ObjectEnvironment.h>
 #include <LibJS/Runtime/Reference.h>
 #include <LibJS/Runtime/RegExpObject.h>
+#include <LibJS/Runtime/TypedArray.h>
 #include <LibJS/Runtime/Value.h>
 
 namespace JS::Bytecode {
@@ -48,7 +49,7 @@ DeprecatedString Instruction::to_deprecated_string(Bytecode::Executable const& e
 
 namespace JS::Bytecode::Op {
 
-static ThrowCompletionOr<void> put_by_property_key(Object* object, Value value, PropertyKey name, Bytecode::Interpreter& interpreter, PropertyKind kind)
+static ThrowCompletionOr<void> put_by_property_key(Object* object, Value value, PropertyKey name, Bytecode::Interpreter& interpreter, PropertyKind kind, PropertyLookupCache* cache = nullptr)
 {
     auto& vm = interpreter.vm();
 
@@ -72,11 +73,36 @@ static ThrowCompletionOr<void> put_by_property_key(Object* object, Value value,
         break;
     }
     case PropertyKind::KeyValue: {
-        bool succeeded = TRY(object->internal_set(name, interpreter.accumulator(), object));
+        if (cache) {
+            if (auto offset = cache->lookup(object->shape()); offset.has_value()) {
+                object->put_direct(*offset, interpreter.accumulator());
+                break;
+            }
+        }
+
+        CacheablePropertyMetadata cacheable_metadata;
+        bool succeeded = TRY(object->internal_set(name, interpreter.accumulator(), object, cache ? &cacheable_metadata : nullptr));
+        if (succeeded && cacheable_metadata.type == CacheablePropertyMetadata::Type::OwnProperty)
+            cache->insert(object->shape(), cacheable_metadata.property_offset.value());
         if (!succeeded && vm.in_strict_mode())
             return vm.throw_completion<TypeError>(ErrorType::ReferenceNullishSetProperty, name, TRY_OR_THROW_OOM(vm, interpreter.accumulator().to_string_without_side_effects()));
         break;
     }
+    case PropertyKind::DirectKeyValue: {
+        if (cache) {
+            if (auto* new_shape = cache->lookup_transition(object->shape())) {
+                object->add_property_with_known_transition(*new_shape, value);
+                break;
+            }
+        }
+
+        NonnullGCPtr<Shape> old_shape = object->shape();
+        object->define_direct_property(name, value, default_attributes);
+        auto& new_shape = object->shape();
+        if (cache && !old_shape->is_unique() && !new_shape.is_unique() && new_shape.property_count() == old_shape->property_count() + 1)
+            cache->insert_transition(old_shape, new_shape);
+        break;
+    }
     case PropertyKind::Spread:
         TRY(object->copy_data_properties(vm, value, {}));
         break;
@@ -305,7 +331,9 @@ ThrowCompletionOr<void> NewObject::execute_impl(Bytecode::Interpreter& interpret
     auto& vm = interpreter.vm();
     auto& realm = *vm.current_realm();
 
-    interpreter.accumulator() = Object::create(realm, realm.intrinsics().object_prototype());
+    auto object = Object::create(realm, realm.intrinsics().object_prototype());
+    object->ensure_storage_capacity(m_expected_property_count);
+    interpreter.accumulator() = object;
     return {};
 }
 
@@ -493,7 +521,17 @@ ThrowCompletionOr<void> GetById::execute_impl(Bytecode::Interpreter& interpreter
 {
     auto& vm = interpreter.vm();
     auto* object = TRY(interpreter.accumulator().to_object(vm));
-    interpreter.accumulator() = TRY(object->get(interpreter.current_executable().get_identifier(m_property)));
+
+    auto& cache = interpreter.current_executable().property_lookup_caches[m_cache_index];
+    if (auto offset = cache.lookup(object->shape()); offset.has_value()) {
+        interpreter.accumulator() = object->get_direct(*offset);
+        return {};
+    }
+
+    CacheablePropertyMetadata cacheable_metadata;
+    interpreter.accumulator() = TRY(object->internal_get(interpreter.current_executable().get_identifier(m_property), object, &cacheable_metadata));
+    if (cacheable_metadata.type == CacheablePropertyMetadata::Type::OwnProperty)
+        cache.insert(object->shape(), cacheable_metadata.property_offset.value());
     return {};
 }
 
@@ -503,7 +541,8 @@ ThrowCompletionOr<void> PutById::execute_impl(Bytecode::Interpreter& interpreter
     auto* object = TRY(interpreter.reg(m_base).to_object(vm));
     PropertyKey name = interpreter.current_executable().get_identifier(m_property);
     auto value = interpreter.accumulator();
-    return put_by_property_key(object, value, name, interpreter, m_kind);
+    auto& cache = interpreter.current_executable().property_lookup_caches[m_cache_index];
+    return put_by_property_key(object, value, name, interpreter, m_kind, &cache);
 }
 
 ThrowCompletionOr<void> DeleteById::execute_impl(Bytecode::Interpreter& interpreter) const
@@ -851,9 +890,79 @@ void Yield::replace_references_impl(BasicBlock const& from, BasicBlock const& to
         m_continuation_label = Label { to };
 }
 
+// Returns the object if the property is an array index, i.e. an integral Number in the range [0, 2^32 - 1).
+static ALWAYS_INLINE Object* object_for_element_access(Value base, Value property, u32& index)
+{
+    if (!base.is_object() || !property.is_integral_number())
+        return nullptr;
+    auto number = property.as_double();
+    if (number < 0 || number >= NumericLimits<u32>::max())
+        return nullptr;
+    index = static_cast<u32>(number);
+    return &base.as_object();
+}
+
+// OPTIMIZATION: Arrays don't have any special behavior for their elements, so plain data elements can be accessed
+//               directly if they are stored packed. Everything else (holes, accessors, sparse arrays) takes the slow path.
+static ALWAYS_INLINE Array* array_for_element_access(Object* object)
+{
+    if (!object || !is<Array>(*object))
+        return nullptr;
+    return static_cast<Array*>(object);
+}
+
+// OPTIMIZATION: Integer-indexed exotic objects handle every integral index themselves, without looking at the prototype
+//               chain, so these can go straight to the viewed buffer instead of building a PropertyKey first.
+static ALWAYS_INLINE TypedArrayBase* typed_array_for_element_access(Object* object)
+{
+    if (!object || !object->is_typed_array())
+        return nullptr;
+    return static_cast<TypedArrayBase*>(object);
+}
+
+// 10.4.5.10 IntegerIndexedElementGet ( O, index ), https://tc39.es/ecma262/#sec-integerindexedelementget
+static ALWAYS_INLINE Value typed_array_element_get(TypedArrayBase const& typed_array, u32 index)
+{
+    // NOTE: This is IsValidIntegerIndex for an index that's already known to be a non-negative integer.
+    if (typed_array.viewed_array_buffer()->is_detached() || index >= typed_array.array_length())
+        return js_undefined();
+
+    // NOTE: The length of the typed array is limited so that its byte length fits into a u32, so this can't overflow.
+    auto byte_index = static_cast<size_t>(index) * typed_array.element_size() + typed_array.byte_offset();
+    return typed_array.get_value_from_buffer(byte_index, ArrayBuffer::Order::Unordered);
+}
+
+// 10.4.5.11 IntegerIndexedElementSet ( O, index, value ), https://tc39.es/ecma262/#sec-integerindexedelementset
+// NOTE: This only handles values that don't need to be converted (which could have side effects), and returns false otherwise.
+static ALWAYS_INLINE bool typed_array_element_set(TypedArrayBase& typed_array, u32 index, Value value)
+{
+    if (typed_array.content_type() == TypedArrayBase::ContentType::BigInt ? !value.is_bigint() : !value.is_number())
+        return false;
+
+    if (typed_array.viewed_array_buffer()->is_detached() || index >= typed_array.array_length())
+        return true;
+
+    auto byte_index = static_cast<size_t>(index) * typed_array.element_size() + typed_array.byte_offset();
+    typed_array.set_value_in_buffer(byte_index, value, ArrayBuffer::Order::Unordered);
+    return true;
+}
+
 ThrowCompletionOr<void> GetByValue::execute_impl(Bytecode::Interpreter& interpreter) const
 {
     auto& vm = interpreter.vm();
+
+    u32 index = 0;
+    auto* element_object = object_for_element_access(interpreter.reg(m_base), interpreter.accumulator(), index);
+    if (auto* array = array_for_element_access(element_object)) {
+        if (auto element = array->indexed_properties().get_packed_element(index); element.has_value()) {
+            interpreter.accumulator() = *element;
+            return {};
+        }
+    } else if (auto* typed_array = typed_array_for_element_access(element_object)) {
+        interpreter.accumulator() = typed_array_element_get(*typed_array, index);
+        return {};
+    }
+
     auto* object = TRY(interpreter.reg(m_base).to_object(vm));
 
     auto property_key = TRY(interpreter.accumulator().to_property_key(vm));
@@ -865,6 +974,20 @@ ThrowCompletionOr<void> GetByValue::execute_impl(Bytecode::Interpreter& interpre
 ThrowCompletionOr<void> PutByValue::execute_impl(Bytecode::Interpreter& interpreter) const
 {
     auto& vm = interpreter.vm();
+
+    if (m_kind == PropertyKind::KeyValue) {
+        // NOTE: Overwriting an existing writable data element can't involve setters, the prototype chain or the length.
+        u32 index = 0;
+        auto* element_object = object_for_element_access(interpreter.reg(m_base), interpreter.reg(m_property), index);
+        if (auto* array = array_for_element_access(element_object)) {
+            if (array->indexed_properties().set_packed_element(index, interpreter.accumulator()))
+                return {};
+        } else if (auto* typed_array = typed_array_for_element_access(element_object)) {
+            if (typed_array_element_set(*typed_array, index, interpreter.accumulator()))
+                return {};
+        }
+    }
+
     auto* object = TRY(interpreter.reg(m_base).to_object(vm));
 
     auto property_key = TRY(interpreter.reg(m_property).to_property_key(vm));
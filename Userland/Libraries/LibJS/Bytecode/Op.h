@@ -40,6 +40,8 @@ public:
             m_src = to;
     }
 
+    Register src() const { return m_src; }
+
 private:
     Register m_src;
 };
@@ -57,6 +59,8 @@ public:
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
     void replace_references_impl(Register, Register) { }
 
+    Value value() const { return m_value; }
+
 private:
     Value m_value;
 };
@@ -124,6 +128,8 @@ private:
                 m_lhs_reg = to;                                                        \
         }                                                                              \
                                                                                        \
+        Register lhs() const { return m_lhs_reg; }                                     \
+                                                                                       \
     private:                                                                           \
         Register m_lhs_reg;                                                            \
     };
@@ -178,8 +184,9 @@ private:
 
 class NewObject final : public Instruction {
 public:
-    NewObject()
+    explicit NewObject(u32 expected_property_count = 0)
         : Instruction(Type::NewObject)
+        , m_expected_property_count(expected_property_count)
     {
     }
 
@@ -187,6 +194,9 @@ public:
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
     void replace_references_impl(Register, Register) { }
+
+private:
+    u32 m_expected_property_count { 0 };
 };
 
 class NewRegExp final : public Instruction {
@@ -506,9 +516,10 @@ private:
 
 class GetById final : public Instruction {
 public:
-    explicit GetById(IdentifierTableIndex property)
+    GetById(IdentifierTableIndex property, u32 cache_index)
         : Instruction(Type::GetById)
         , m_property(property)
+        , m_cache_index(cache_index)
     {
     }
 
@@ -519,23 +530,28 @@ public:
 
 private:
     IdentifierTableIndex m_property;
+    u32 m_cache_index { 0 };
 };
 
 enum class PropertyKind {
     Getter,
     Setter,
     KeyValue,
+    // Object literal properties are defined (CreateDataPropertyOrThrow) rather than set, and nothing else can observe
+    // the object while it's being built. That makes the shape after adding the property only depend on the shape before.
+    DirectKeyValue,
     Spread,
     ProtoSetter,
 };
 
 class PutById final : public Instruction {
 public:
-    explicit PutById(Register base, IdentifierTableIndex property, PropertyKind kind = PropertyKind::KeyValue)
+    PutById(Register base, IdentifierTableIndex property, u32 cache_index, PropertyKind kind = PropertyKind::KeyValue)
         : Instruction(Type::PutById)
         , m_base(base)
         , m_property(property)
         , m_kind(kind)
+        , m_cache_index(cache_index)
     {
     }
 
@@ -552,6 +568,7 @@ private:
     Register m_base;
     IdentifierTableIndex m_property;
     PropertyKind m_kind;
+    u32 m_cache_index { 0 };
 };
 
 class DeleteById final : public Instruction {
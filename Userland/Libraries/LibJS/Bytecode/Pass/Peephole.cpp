@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Vector.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+namespace {
+
+// Either an instruction from the original block, or a LoadImmediate we've created by folding constants.
+struct Entry {
+    Instruction const* instruction { nullptr };
+    Optional<Value> folded_immediate {};
+
+    Instruction::Type type() const { return instruction ? instruction->type() : Instruction::Type::LoadImmediate; }
+
+    template<typename OpType>
+    OpType const& as() const
+    {
+        VERIFY(instruction);
+        return static_cast<OpType const&>(*instruction);
+    }
+
+    Optional<Value> immediate() const
+    {
+        if (!instruction)
+            return folded_immediate;
+        if (instruction->type() == Instruction::Type::LoadImmediate)
+            return as<Op::LoadImmediate>().value();
+        return {};
+    }
+};
+
+}
+
+static bool overwrites_accumulator_without_side_effects(Instruction::Type type)
+{
+    return type == Instruction::Type::Load || type == Instruction::Type::LoadImmediate;
+}
+
+static Optional<Register> lhs_of_binary_operation(Instruction const& instruction)
+{
+    switch (instruction.type()) {
+#define __ENUMERATE_BINARY_OP(OpTitleCase, op_snake_case) \
+    case Instruction::Type::OpTitleCase:                  \
+        return static_cast<Op::OpTitleCase const&>(instruction).lhs();
+        JS_ENUMERATE_COMMON_BINARY_OPS(__ENUMERATE_BINARY_OP)
+#undef __ENUMERATE_BINARY_OP
+    default:
+        return {};
+    }
+}
+
+// NOTE: On two Numbers, all of these operators boil down to the corresponding IEEE 754 operation.
+static Optional<Value> fold_binary_operation(Instruction::Type type, Value lhs, Value rhs)
+{
+    if (!lhs.is_number() || !rhs.is_number())
+        return {};
+    auto x = lhs.as_double();
+    auto y = rhs.as_double();
+
+    switch (type) {
+    case Instruction::Type::Add:
+        return Value(x + y);
+    case Instruction::Type::Sub:
+        return Value(x - y);
+    case Instruction::Type::Mul:
+        return Value(x * y);
+    case Instruction::Type::Div:
+        return Value(x / y);
+    case Instruction::Type::LessThan:
+        return Value(x < y);
+    case Instruction::Type::LessThanEquals:
+        return Value(x <= y);
+    case Instruction::Type::GreaterThan:
+        return Value(x > y);
+    case Instruction::Type::GreaterThanEquals:
+        return Value(x >= y);
+    case Instruction::Type::StrictlyEquals:
+        return Value(x == y);
+    case Instruction::Type::StrictlyInequals:
+        return Value(x != y);
+    default:
+        return {};
+    }
+}
+
+static NonnullOwnPtr<BasicBlock> optimize_block(BasicBlock const& block)
+{
+    Vector<Entry> entries;
+
+    for (InstructionStreamIterator it { block.instruction_stream() }; !it.at_end(); ++it) {
+        auto const& instruction = *it;
+        auto type = instruction.type();
+
+        // A Load or LoadImmediate whose value is replaced before anyone gets to see it does nothing.
+        if (overwrites_accumulator_without_side_effects(type) && !entries.is_empty() && overwrites_accumulator_without_side_effects(entries.last().type()))
+            entries.take_last();
+
+        if (!entries.is_empty()) {
+            auto const& last = entries.last();
+
+            // Store $x, Load $x: The accumulator already holds the value of $x.
+            if (type == Instruction::Type::Load && last.type() == Instruction::Type::Store
+                && static_cast<Op::Load const&>(instruction).src() == last.as<Op::Store>().dst())
+                continue;
+
+            // Load $x, Store $x and Store $x, Store $x: $x already holds the value of the accumulator.
+            if (type == Instruction::Type::Store) {
+                auto dst = static_cast<Op::Store const&>(instruction).dst();
+                if (last.type() == Instruction::Type::Load && last.as<Op::Load>().src() == dst)
+                    continue;
+                if (last.type() == Instruction::Type::Store && last.as<Op::Store>().dst() == dst)
+                    continue;
+            }
+        }
+
+        // LoadImmediate a, Store $x, LoadImmediate b, <BinaryOp> $x: Replace the operation with the result.
+        if (auto lhs = lhs_of_binary_operation(instruction); lhs.has_value() && entries.size() >= 3) {
+            auto const& lhs_entry = entries[entries.size() - 3];
+            auto const& store_entry = entries[entries.size() - 2];
+            auto const& rhs_entry = entries[entries.size() - 1];
+            auto lhs_value = lhs_entry.immediate();
+            auto rhs_value = rhs_entry.immediate();
+            if (lhs_value.has_value() && rhs_value.has_value()
+                && store_entry.type() == Instruction::Type::Store && store_entry.as<Op::Store>().dst() == *lhs) {
+                if (auto result = fold_binary_operation(type, *lhs_value, *rhs_value); result.has_value()) {
+                    entries.last() = Entry { nullptr, result };
+                    continue;
+                }
+            }
+        }
+
+        entries.append(Entry { &instruction });
+    }
+
+    auto new_block = BasicBlock::create(block.name(), block.size());
+    for (auto const& entry : entries) {
+        if (!entry.instruction) {
+            new (new_block->next_slot()) Op::LoadImmediate(*entry.folded_immediate);
+            new_block->grow(sizeof(Op::LoadImmediate));
+            continue;
+        }
+
+        auto const& instruction = *entry.instruction;
+        if (instruction.type() == Instruction::Type::NewBigInt) {
+            // FIXME: This is the only non trivially copyable Instruction,
+            //        so we need to do some extra work here
+            new (new_block->next_slot()) Op::NewBigInt(static_cast<Op::NewBigInt const&>(instruction));
+            new_block->grow(sizeof(Op::NewBigInt));
+            continue;
+        }
+
+        memcpy(new_block->next_slot(), &instruction, instruction.length());
+        // Because we are replacing the current block, we need to replace references to ourselves here
+        reinterpret_cast<Instruction*>(new_block->next_slot())->replace_references(block, *new_block);
+        new_block->grow(instruction.length());
+    }
+    return new_block;
+}
+
+void Peephole::perform(PassPipelineExecutable& executable)
+{
+    started();
+
+    for (auto it = executable.executable.basic_blocks.begin(); it != executable.executable.basic_blocks.end(); ++it) {
+        auto const& old_block = *it;
+        auto new_block = optimize_block(old_block);
+
+        // We will replace the old block with the new one, so all references to it need to be updated
+        for (auto& block : executable.executable.basic_blocks) {
+            InstructionStreamIterator it { block.instruction_stream() };
+            while (!it.at_end()) {
+                auto& instruction = *it;
+                ++it;
+                const_cast<Instruction&>(instruction).replace_references(old_block, *new_block);
+            }
+        }
+
+        executable.executable.basic_blocks.ptr_at(it.index()) = move(new_block);
+    }
+
+    finished();
+}
+
+}
@@ -131,6 +131,17 @@ private:
     virtual void perform(PassPipelineExecutable&) override;
 };
 
+// Cleans up redundant accumulator traffic (e.g. a Load right after a Store to the same register) and folds
+// arithmetic and comparisons between two numeric constants.
+class Peephole : public Pass {
+public:
+    Peephole() = default;
+    virtual ~Peephole() override = default;
+
+private:
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
 }
 
 }
@@ -152,6 +152,7 @@ namespace JS {
 class ASTNode;
 class Accessor;
 struct AsyncGeneratorRequest;
+struct CacheablePropertyMetadata;
 class BigInt;
 class BoundFunction;
 class Cell;
@@ -192,6 +193,7 @@ class Parser;
 struct ParserError;
 class PrimitiveString;
 class Program;
+class ProgramCache;
 class PromiseCapability;
 class PromiseReaction;
 class PropertyAttributes;
@@ -199,6 +201,7 @@ class PropertyDescriptor;
 class PropertyKey;
 class Realm;
 class Reference;
+class SamplingProfiler;
 class ScopeNode;
 class Script;
 class Shape;
@@ -208,6 +211,7 @@ class SourceCode;
 struct SourceRange;
 class SourceTextModule;
 class Symbol;
+class TaggedTemplateLiteral;
 class Token;
 class Utf16String;
 class VM;
@@ -17,19 +17,10 @@ CellAllocator::CellAllocator(size_t cell_size)
 {
 }
 
-Cell* CellAllocator::allocate_cell(Heap& heap)
+void CellAllocator::add_usable_block(Heap& heap)
 {
-    if (m_usable_blocks.is_empty()) {
-        auto block = HeapBlock::create_with_cell_size(heap, m_cell_size);
-        m_usable_blocks.append(*block.leak_ptr());
-    }
-
-    auto& block = *m_usable_blocks.last();
-    auto* cell = block.allocate();
-    VERIFY(cell);
-    if (block.is_full())
-        m_full_blocks.append(*m_usable_blocks.last());
-    return cell;
+    auto block = HeapBlock::create_with_cell_size(heap, m_cell_size);
+    m_usable_blocks.append(*block.leak_ptr());
 }
 
 void CellAllocator::block_did_become_empty(Badge<Heap>, HeapBlock& block)
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Badge.h>
 #include <AK/IntrusiveList.h>
 #include <AK/NonnullOwnPtr.h>
 #include <LibJS/Forward.h>
@@ -20,7 +21,22 @@ public:
 
     size_t cell_size() const { return m_cell_size; }
 
-    Cell* allocate_cell(Heap&);
+    ALWAYS_INLINE Cell* allocate_cell(Heap& heap)
+    {
+        if (m_usable_blocks.is_empty()) [[unlikely]]
+            add_usable_block(heap);
+
+        auto& block = *m_usable_blocks.last();
+        auto* cell = block.allocate();
+        VERIFY(cell);
+        if (block.is_full())
+            m_full_blocks.append(block);
+        ++m_allocated_cells_since_last_gc;
+        return cell;
+    }
+
+    size_t allocated_cells_since_last_gc() const { return m_allocated_cells_since_last_gc; }
+    void reset_allocation_counter(Badge<Heap>) { m_allocated_cells_since_last_gc = 0; }
 
     template<typename Callback>
     IterationDecision for_each_block(Callback callback)
@@ -40,7 +56,10 @@ public:
     void block_did_become_usable(Badge<Heap>, HeapBlock&);
 
 private:
+    void add_usable_block(Heap&);
+
     const size_t m_cell_size;
+    size_t m_allocated_cells_since_last_gc { 0 };
 
     using BlockList = IntrusiveList<&HeapBlock::m_list_node>;
     BlockList m_full_blocks;
@@ -41,18 +41,11 @@ Heap::Heap(VM& vm)
     gc_perf_string_id = perf_register_string(gc_signpost_string.characters_without_null_termination(), gc_signpost_string.length());
 #endif
 
-    if constexpr (HeapBlock::min_possible_cell_size <= 16) {
-        m_allocators.append(make<CellAllocator>(16));
-    }
     static_assert(HeapBlock::min_possible_cell_size <= 24, "Heap Cell tracking uses too much data!");
-    m_allocators.append(make<CellAllocator>(32));
-    m_allocators.append(make<CellAllocator>(64));
-    m_allocators.append(make<CellAllocator>(96));
-    m_allocators.append(make<CellAllocator>(128));
-    m_allocators.append(make<CellAllocator>(256));
-    m_allocators.append(make<CellAllocator>(512));
-    m_allocators.append(make<CellAllocator>(1024));
-    m_allocators.append(make<CellAllocator>(3072));
+    for (auto size_class : cell_size_classes) {
+        if (size_class >= HeapBlock::min_possible_cell_size)
+            m_allocators.append(make<CellAllocator>(size_class));
+    }
 }
 
 Heap::~Heap()
@@ -64,26 +57,15 @@ Heap::~Heap()
 
 ALWAYS_INLINE CellAllocator& Heap::allocator_for_size(size_t cell_size)
 {
-    for (auto& allocator : m_allocators) {
-        if (allocator->cell_size() >= cell_size)
-            return *allocator;
-    }
-    dbgln("Cannot get CellAllocator for cell size {}, largest available is {}!", cell_size, m_allocators.last()->cell_size());
-    VERIFY_NOT_REACHED();
+    return *m_allocators[allocator_index_for_size(cell_size)];
 }
 
-Cell* Heap::allocate_cell(size_t size)
+Cell* Heap::allocate_cell(CellAllocator& allocator)
 {
-    if (should_collect_on_every_allocation()) {
-        collect_garbage();
-    } else if (m_allocations_since_last_gc > m_max_allocations_between_gc) {
-        m_allocations_since_last_gc = 0;
+    if (should_collect_on_every_allocation() || m_allocated_bytes_since_last_gc > m_gc_threshold_bytes) [[unlikely]]
         collect_garbage();
-    } else {
-        ++m_allocations_since_last_gc;
-    }
 
-    auto& allocator = allocator_for_size(size);
+    m_allocated_bytes_since_last_gc += allocator.cell_size();
     return allocator.allocate_cell(*this);
 }
 
@@ -114,6 +96,15 @@ void Heap::collect_garbage(CollectionType collection_type, bool print_report)
     sweep_dead_cells(print_report, collection_measurement_timer);
 }
 
+void Heap::collect_garbage_if_idle_collection_is_worthwhile()
+{
+    if (m_collecting_garbage || m_gc_deferrals)
+        return;
+    if (m_allocated_bytes_since_last_gc < m_gc_threshold_bytes / 2)
+        return;
+    collect_garbage();
+}
+
 void Heap::gather_roots(HashTable<Cell*>& roots)
 {
     vm().gather_roots(roots);
@@ -305,6 +296,16 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
     for (auto& weak_container : m_weak_containers)
         weak_container.remove_dead_cells({});
 
+    size_t allocated_cells = 0;
+    auto allocated_cell_bytes = m_allocated_bytes_since_last_gc;
+    for (auto& allocator : m_allocators) {
+        allocated_cells += allocator->allocated_cells_since_last_gc();
+        dbgln_if(HEAP_DEBUG, " - Allocated {} cells of size {} since the last GC", allocator->allocated_cells_since_last_gc(), allocator->cell_size());
+        allocator->reset_allocation_counter({});
+    }
+    m_allocated_bytes_since_last_gc = 0;
+    m_gc_threshold_bytes = max(live_cell_bytes, minimum_gc_threshold_bytes);
+
     for (auto* block : empty_blocks) {
         dbgln_if(HEAP_DEBUG, " - HeapBlock empty @ {}: cell_size={}", block, block->cell_size());
         allocator_for_size(block->cell_size()).block_did_become_empty({}, *block);
@@ -333,10 +334,12 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
         dbgln("Garbage collection report");
         dbgln("=============================================");
         dbgln("     Time spent: {} ms", time_spent.to_milliseconds());
+        dbgln("Allocated cells: {} ({} bytes) since the last GC", allocated_cells, allocated_cell_bytes);
         dbgln("     Live cells: {} ({} bytes)", live_cells, live_cell_bytes);
         dbgln("Collected cells: {} ({} bytes)", collected_cells, collected_cell_bytes);
         dbgln("    Live blocks: {} ({} bytes)", live_block_count, live_block_count * HeapBlock::block_size);
         dbgln("   Freed blocks: {} ({} bytes)", empty_blocks.size(), empty_blocks.size() * HeapBlock::block_size);
+        dbgln("   Next GC after: {} bytes", m_gc_threshold_bytes);
         dbgln("=============================================");
     }
 }
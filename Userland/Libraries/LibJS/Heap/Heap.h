@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/Badge.h>
 #include <AK/HashTable.h>
 #include <AK/IntrusiveList.h>
@@ -35,7 +36,7 @@ public:
     template<typename T, typename... Args>
     NonnullGCPtr<T> allocate_without_realm(Args&&... args)
     {
-        auto* memory = allocate_cell(sizeof(T));
+        auto* memory = allocate_cell<sizeof(T)>();
         new (memory) T(forward<Args>(args)...);
         return *static_cast<T*>(memory);
     }
@@ -43,7 +44,7 @@ public:
     template<typename T, typename... Args>
     ThrowCompletionOr<NonnullGCPtr<T>> allocate(Realm& realm, Args&&... args)
     {
-        auto* memory = allocate_cell(sizeof(T));
+        auto* memory = allocate_cell<sizeof(T)>();
         new (memory) T(forward<Args>(args)...);
         auto* cell = static_cast<T*>(memory);
         MUST_OR_THROW_OOM(memory->initialize(realm));
@@ -57,6 +58,10 @@ public:
 
     void collect_garbage(CollectionType = CollectionType::CollectGarbage, bool print_report = false);
 
+    // Collects garbage right away if the next collection is due soon anyway. Meant to be called when the embedder
+    // has nothing else to do, so that the pause doesn't get in the way of script or rendering later on.
+    void collect_garbage_if_idle_collection_is_worthwhile();
+
     VM& vm() { return m_vm; }
 
     bool should_collect_on_every_allocation() const { return m_should_collect_on_every_allocation; }
@@ -81,7 +86,33 @@ public:
 private:
     static bool cell_must_survive_garbage_collection(Cell const&);
 
-    Cell* allocate_cell(size_t);
+    // Every cell is rounded up to the next one of these sizes, each of which has its own CellAllocator.
+    static constexpr AK::Array<size_t, 9> cell_size_classes { 16, 32, 64, 96, 128, 256, 512, 1024, 3072 };
+
+    static constexpr size_t allocator_index_for_size(size_t cell_size)
+    {
+        size_t index = 0;
+        for (auto size_class : cell_size_classes) {
+            // Size classes too small to hold a freelist entry don't get an allocator.
+            if (size_class < HeapBlock::min_possible_cell_size)
+                continue;
+            if (size_class >= cell_size)
+                return index;
+            ++index;
+        }
+        VERIFY_NOT_REACHED();
+    }
+
+    // The allocator is picked at compile time, since the size of the cell is always known there.
+    template<size_t cell_size>
+    ALWAYS_INLINE Cell* allocate_cell()
+    {
+        static_assert(cell_size <= cell_size_classes.last(), "Cell is too large for any CellAllocator!");
+        constexpr auto allocator_index = allocator_index_for_size(cell_size);
+        return allocate_cell(*m_allocators[allocator_index]);
+    }
+
+    Cell* allocate_cell(CellAllocator&);
 
     void gather_roots(HashTable<Cell*>&);
     void gather_conservative_roots(HashTable<Cell*>&);
@@ -100,8 +131,12 @@ private:
         }
     }
 
-    size_t m_max_allocations_between_gc { 100000 };
-    size_t m_allocations_since_last_gc { 0 };
+    // We collect once as many bytes have been allocated as were live after the previous collection (but never more often
+    // than every minimum_gc_threshold_bytes). This keeps the time spent collecting proportional to the amount of allocation,
+    // instead of letting big heaps get scanned over and over again while they only grow by a little.
+    static constexpr size_t minimum_gc_threshold_bytes = 8 * MiB;
+    size_t m_gc_threshold_bytes { minimum_gc_threshold_bytes };
+    size_t m_allocated_bytes_since_last_gc { 0 };
 
     bool m_should_collect_on_every_allocation { false };
 
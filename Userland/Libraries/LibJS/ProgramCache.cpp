@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Lexer.h>
+#include <LibJS/Parser.h>
+#include <LibJS/ProgramCache.h>
+
+namespace JS {
+
+Optional<size_t> ProgramCache::find(StringView source_text, u32 source_hash, StringView filename, Program::Type type, size_t line_number_offset) const
+{
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        auto const& entry = m_entries[i];
+        if (entry.source_hash != source_hash || entry.type != type || entry.line_number_offset != line_number_offset || entry.filename != filename)
+            continue;
+        if (entry.program->source_code().code().bytes_as_string_view() == source_text)
+            return i;
+    }
+    return {};
+}
+
+Result<NonnullRefPtr<Program>, Vector<ParserError>> ProgramCache::parse(StringView source_text, StringView filename, Program::Type type, size_t line_number_offset)
+{
+    auto source_hash = source_text.hash();
+    if (auto index = find(source_text, source_hash, filename, type, line_number_offset); index.has_value()) {
+        auto entry = m_entries.take(*index);
+        auto program = entry.program;
+        m_entries.append(move(entry));
+        return program;
+    }
+
+    auto parser = Parser(Lexer(source_text, filename, line_number_offset), type);
+    auto program = parser.parse_program();
+    if (parser.has_errors())
+        return parser.errors();
+
+    // Scripts that are too big to share the cache with anyone else aren't worth keeping around.
+    if (source_text.length() > capacity_in_bytes / 4)
+        return program;
+
+    while (!m_entries.is_empty() && m_size_in_bytes + source_text.length() > capacity_in_bytes)
+        m_size_in_bytes -= m_entries.take_first().program->source_code().code().bytes().size();
+
+    m_entries.append({ source_hash, type, line_number_offset, filename, program });
+    m_size_in_bytes += source_text.length();
+    return program;
+}
+
+}
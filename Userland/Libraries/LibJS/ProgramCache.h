@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/DeprecatedString.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Result.h>
+#include <AK/Vector.h>
+#include <LibJS/AST.h>
+#include <LibJS/ParserError.h>
+
+namespace JS {
+
+// Keeps the most recently parsed Programs around, so that scripts and modules which get loaded over and over again
+// (e.g. while navigating around a web application) don't have to be parsed from scratch every time.
+// Each VM owns one, so that no Program outlives the VM it was evaluated in.
+// NOTE: Several Script or SourceTextModule records may share one Program, so nothing that belongs to a particular realm
+//       or record may be stored in the AST. Per-realm state such as the template objects of tagged templates lives on
+//       the Realm instead, and what the nodes do cache (e.g. environment coordinates) is valid for any realm.
+class ProgramCache {
+public:
+    ProgramCache() = default;
+
+    Result<NonnullRefPtr<Program>, Vector<ParserError>> parse(StringView source_text, StringView filename, Program::Type, size_t line_number_offset = 1);
+
+private:
+    // NOTE: This only accounts for the source text, which the size of the AST is roughly proportional to.
+    static constexpr size_t capacity_in_bytes = 8 * MiB;
+
+    struct Entry {
+        u32 source_hash { 0 };
+        Program::Type type { Program::Type::Script };
+        size_t line_number_offset { 0 };
+        DeprecatedString filename;
+        NonnullRefPtr<Program> program;
+    };
+
+    Optional<size_t> find(StringView source_text, u32 source_hash, StringView filename, Program::Type, size_t line_number_offset) const;
+
+    // Ordered from least to most recently used.
+    Vector<Entry> m_entries;
+    size_t m_size_in_bytes { 0 };
+};
+
+}
@@ -905,6 +905,15 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::includes)
     }
     auto value_to_find = vm.argument(0);
     for (u64 i = from_index; i < length; ++i) {
+        // OPTIMIZATION: Packed array elements are plain data properties, so Get() can't have any side effects.
+        if (is<Array>(*this_object)) {
+            if (auto element = this_object->indexed_properties().get_packed_element(static_cast<u32>(i)); element.has_value()) {
+                if (same_value_zero(*element, value_to_find))
+                    return Value(true);
+                continue;
+            }
+        }
+
         auto element = TRY(this_object->get(i));
         if (same_value_zero(element, value_to_find))
             return Value(true);
@@ -959,6 +968,15 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::index_of)
 
     // 10. Repeat, while k < len,
     for (; k < length; ++k) {
+        // OPTIMIZATION: Packed array elements are plain data properties, so HasProperty() and Get() can't have any side effects.
+        if (is<Array>(*object)) {
+            if (auto element = object->indexed_properties().get_packed_element(static_cast<u32>(k)); element.has_value()) {
+                if (is_strictly_equal(search_element, *element))
+                    return Value(k);
+                continue;
+            }
+        }
+
         auto property_key = PropertyKey { k };
 
         // a. Let kPresent be ? HasProperty(O, ! ToString(𝔽(k))).
@@ -108,6 +108,8 @@ private:
 
     DeprecatedFlyString m_name;
     OwnPtr<Bytecode::Executable> m_bytecode_executable;
+    // How many properties the last object this constructed ended up with, so the next one can allocate its storage up front.
+    u32 m_expected_instance_property_count { 0 };
     Vector<OwnPtr<Bytecode::Executable>> m_default_parameter_bytecode_executables;
     i32 m_function_length { 0 };
 
@@ -15,6 +15,8 @@ namespace JS {
 struct ValueAndAttributes {
     Value value;
     PropertyAttributes attributes { default_attributes };
+    // Only set for named properties, which live in the object's storage.
+    Optional<u32> property_offset {};
 };
 
 class IndexedProperties;
@@ -60,6 +62,14 @@ public:
     virtual bool is_simple_storage() const override { return true; }
     Vector<Value> const& elements() const { return m_packed_elements; }
 
+    bool replace_existing(u32 index, Value value)
+    {
+        if (!has_index(index))
+            return false;
+        m_packed_elements[index] = value;
+        return true;
+    }
+
 private:
     friend GenericIndexedPropertyStorage;
 
@@ -124,6 +134,25 @@ public:
 
     bool has_index(u32 index) const { return m_storage ? m_storage->has_index(index) : false; }
     Optional<ValueAndAttributes> get(u32 index) const;
+
+    // OPTIMIZATION: Elements in simple storage are always plain data properties with the default attributes, so callers
+    //               that would otherwise go through the full [[Get]] or [[Set]] machinery can access them directly.
+    //               Both of these only handle elements that exist and are stored packed, and fail otherwise.
+    ALWAYS_INLINE Optional<Value> get_packed_element(u32 index) const
+    {
+        if (!m_storage || !m_storage->is_simple_storage())
+            return {};
+        auto const& storage = static_cast<SimpleIndexedPropertyStorage const&>(*m_storage);
+        if (!storage.has_index(index))
+            return {};
+        return storage.elements()[index];
+    }
+    ALWAYS_INLINE bool set_packed_element(u32 index, Value value)
+    {
+        if (!m_storage || !m_storage->is_simple_storage())
+            return false;
+        return static_cast<SimpleIndexedPropertyStorage&>(*m_storage).replace_existing(index, value);
+    }
     void put(u32 index, Value value, PropertyAttributes attributes = default_attributes);
     void remove(u32 index);
 
@@ -12,6 +12,7 @@
 #include <AK/TypeCasts.h>
 #include <AK/Utf16View.h>
 #include <AK/Utf8View.h>
+#include <LibJS/Heap/MarkedVector.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/BigIntObject.h>
@@ -22,7 +23,9 @@
 #include <LibJS/Runtime/JSONObject.h>
 #include <LibJS/Runtime/NumberObject.h>
 #include <LibJS/Runtime/Object.h>
+#include <LibJS/Runtime/Shape.h>
 #include <LibJS/Runtime/StringObject.h>
+#include <typeinfo>
 
 namespace JS {
 
@@ -106,7 +109,11 @@ ThrowCompletionOr<DeprecatedString> JSONObject::stringify_impl(VM& vm, Value val
 
     auto wrapper = Object::create(realm, realm.intrinsics().object_prototype());
     MUST(wrapper->create_data_property_or_throw(DeprecatedString::empty(), value));
-    return serialize_json_property(vm, state, DeprecatedString::empty(), wrapper);
+
+    StringBuilder builder;
+    if (!TRY(serialize_json_property(vm, state, builder, DeprecatedString::empty(), wrapper)))
+        return DeprecatedString {};
+    return builder.to_deprecated_string();
 }
 
 // 25.5.2 JSON.stringify ( value [ , replacer [ , space ] ] ), https://tc39.es/ecma262/#sec-json.stringify
@@ -127,11 +134,19 @@ JS_DEFINE_NATIVE_FUNCTION(JSONObject::stringify)
 }
 
 // 25.5.2.1 SerializeJSONProperty ( state, key, holder ), https://tc39.es/ecma262/#sec-serializejsonproperty
-ThrowCompletionOr<DeprecatedString> JSONObject::serialize_json_property(VM& vm, StringifyState& state, PropertyKey const& key, Object* holder)
+// NOTE: Instead of returning the serialized string, this appends it to the given builder, so nested values don't
+//       each allocate their own intermediate string. A return value of false means "undefined".
+ThrowCompletionOr<bool> JSONObject::serialize_json_property(VM& vm, StringifyState& state, StringBuilder& builder, PropertyKey const& key, Object* holder)
 {
     // 1. Let value be ? Get(holder, key).
     auto value = TRY(holder->get(key));
 
+    return serialize_json_property_value(vm, state, builder, key, holder, value);
+}
+
+// Steps 2-12 of SerializeJSONProperty, for when the caller already did step 1.
+ThrowCompletionOr<bool> JSONObject::serialize_json_property_value(VM& vm, StringifyState& state, StringBuilder& builder, PropertyKey const& key, Object* holder, Value value)
+{
     // 2. If Type(value) is Object or BigInt, then
     if (value.is_object() || value.is_bigint()) {
         // a. Let toJSON be ? GetV(value, "toJSON").
@@ -177,26 +192,33 @@ ThrowCompletionOr<DeprecatedString> JSONObject::serialize_json_property(VM& vm,
     }
 
     // 5. If value is null, return "null".
-    if (value.is_null())
-        return "null"sv;
+    if (value.is_null()) {
+        builder.append("null"sv);
+        return true;
+    }
 
     // 6. If value is true, return "true".
     // 7. If value is false, return "false".
-    if (value.is_boolean())
-        return value.as_bool() ? "true"sv : "false"sv;
+    if (value.is_boolean()) {
+        builder.append(value.as_bool() ? "true"sv : "false"sv);
+        return true;
+    }
 
     // 8. If Type(value) is String, return QuoteJSONString(value).
-    if (value.is_string())
-        return quote_json_string(TRY(value.as_string().deprecated_string()));
+    if (value.is_string()) {
+        quote_json_string(builder, TRY(value.as_string().deprecated_string()));
+        return true;
+    }
 
     // 9. If Type(value) is Number, then
     if (value.is_number()) {
         // a. If value is finite, return ! ToString(value).
         if (value.is_finite_number())
-            return MUST(value.to_deprecated_string(vm));
-
+            builder.append(MUST(value.to_deprecated_string(vm)));
         // b. Return "null".
-        return "null"sv;
+        else
+            builder.append("null"sv);
+        return true;
     }
 
     // 10. If Type(value) is BigInt, throw a TypeError exception.
@@ -210,18 +232,19 @@ ThrowCompletionOr<DeprecatedString> JSONObject::serialize_json_property(VM& vm,
 
         // b. If isArray is true, return ? SerializeJSONArray(state, value).
         if (is_array)
-            return serialize_json_array(vm, state, value.as_object());
-
+            TRY(serialize_json_array(vm, state, builder, value.as_object()));
         // c. Return ? SerializeJSONObject(state, value).
-        return serialize_json_object(vm, state, value.as_object());
+        else
+            TRY(serialize_json_object(vm, state, builder, value.as_object()));
+        return true;
     }
 
     // 12. Return undefined.
-    return DeprecatedString {};
+    return false;
 }
 
 // 25.5.2.4 SerializeJSONObject ( state, value ), https://tc39.es/ecma262/#sec-serializejsonobject
-ThrowCompletionOr<DeprecatedString> JSONObject::serialize_json_object(VM& vm, StringifyState& state, Object& object)
+ThrowCompletionOr<void> JSONObject::serialize_json_object(VM& vm, StringifyState& state, StringBuilder& builder, Object& object)
 {
     if (state.seen_objects.contains(&object))
         return vm.throw_completion<TypeError>(ErrorType::JsonCircular);
@@ -229,19 +252,34 @@ ThrowCompletionOr<DeprecatedString> JSONObject::serialize_json_object(VM& vm, St
     state.seen_objects.set(&object);
     DeprecatedString previous_indent = state.indent;
     state.indent = DeprecatedString::formatted("{}{}", state.indent, state.gap);
-    Vector<DeprecatedString> property_strings;
+    auto separator = state.gap.is_empty() ? DeprecatedString { ","sv } : DeprecatedString::formatted(",\n{}", state.indent);
+    bool has_properties = false;
+
+    builder.append('{');
 
-    auto process_property = [&](PropertyKey const& key) -> ThrowCompletionOr<void> {
+    auto process_property = [&](PropertyKey const& key, Optional<Value> value = {}) -> ThrowCompletionOr<void> {
         if (key.is_symbol())
             return {};
-        auto serialized_property_string = TRY(serialize_json_property(vm, state, key, &object));
-        if (!serialized_property_string.is_null()) {
-            property_strings.append(DeprecatedString::formatted(
-                "{}:{}{}",
-                quote_json_string(key.to_string()),
-                state.gap.is_empty() ? "" : " ",
-                serialized_property_string));
+
+        auto property_start = builder.length();
+        if (has_properties) {
+            builder.append(separator);
+        } else if (!state.gap.is_empty()) {
+            builder.append('\n');
+            builder.append(state.indent);
         }
+        quote_json_string(builder, key.to_string());
+        builder.append(state.gap.is_empty() ? ":"sv : ": "sv);
+
+        auto serialized = value.has_value()
+            ? TRY(serialize_json_property_value(vm, state, builder, key, &object, *value))
+            : TRY(serialize_json_property(vm, state, builder, key, &object));
+
+        // If the property serialized to undefined, it's left out entirely.
+        if (serialized)
+            has_properties = true;
+        else
+            builder.trim(builder.length() - property_start);
         return {};
     };
 
@@ -249,47 +287,42 @@ ThrowCompletionOr<DeprecatedString> JSONObject::serialize_json_object(VM& vm, St
         auto property_list = state.property_list.value();
         for (auto& property : property_list)
             TRY(process_property(property));
+    }
+    // OPTIMIZATION: Plain objects don't have exotic [[OwnPropertyKeys]] or [[GetOwnProperty]] methods, so we can take
+    //               their enumerable keys straight from the shape instead of turning each one into a PrimitiveString.
+    //               Data properties are read directly from the storage, as long as nothing has changed the shape.
+    else if (typeid(object) == typeid(Object) && object.indexed_properties().is_empty()) {
+        NonnullGCPtr<Shape> shape = object.shape();
+        for (auto& property : shape->property_table_ordered()) {
+            if (!property.key.is_string() || !property.value.attributes.is_enumerable())
+                continue;
+
+            Optional<Value> value;
+            if (&object.shape() == shape.ptr() && !shape->is_unique()) {
+                if (auto stored_value = object.get_direct(property.value.offset); !stored_value.is_accessor())
+                    value = stored_value;
+            }
+            TRY(process_property(property.key, value));
+        }
     } else {
         auto property_list = TRY(object.enumerable_own_property_names(PropertyKind::Key));
         for (auto& property : property_list)
             TRY(process_property(TRY(property.as_string().deprecated_string())));
     }
-    StringBuilder builder;
-    if (property_strings.is_empty()) {
-        builder.append("{}"sv);
-    } else {
-        bool first = true;
-        builder.append('{');
-        if (state.gap.is_empty()) {
-            for (auto& property_string : property_strings) {
-                if (!first)
-                    builder.append(',');
-                first = false;
-                builder.append(property_string);
-            }
-        } else {
-            builder.append('\n');
-            builder.append(state.indent);
-            auto separator = DeprecatedString::formatted(",\n{}", state.indent);
-            for (auto& property_string : property_strings) {
-                if (!first)
-                    builder.append(separator);
-                first = false;
-                builder.append(property_string);
-            }
-            builder.append('\n');
-            builder.append(previous_indent);
-        }
-        builder.append('}');
+
+    if (has_properties && !state.gap.is_empty()) {
+        builder.append('\n');
+        builder.append(previous_indent);
     }
+    builder.append('}');
 
     state.seen_objects.remove(&object);
     state.indent = previous_indent;
-    return builder.to_deprecated_string();
+    return {};
 }
 
 // 25.5.2.5 SerializeJSONArray ( state, value ), https://tc39.es/ecma262/#sec-serializejsonarray
-ThrowCompletionOr<DeprecatedString> JSONObject::serialize_json_array(VM& vm, StringifyState& state, Object& object)
+ThrowCompletionOr<void> JSONObject::serialize_json_array(VM& vm, StringifyState& state, StringBuilder& builder, Object& object)
 {
     if (state.seen_objects.contains(&object))
         return vm.throw_completion<TypeError>(ErrorType::JsonCircular);
@@ -297,63 +330,47 @@ ThrowCompletionOr<DeprecatedString> JSONObject::serialize_json_array(VM& vm, Str
     state.seen_objects.set(&object);
     DeprecatedString previous_indent = state.indent;
     state.indent = DeprecatedString::formatted("{}{}", state.indent, state.gap);
-    Vector<DeprecatedString> property_strings;
+    auto separator = state.gap.is_empty() ? DeprecatedString { ","sv } : DeprecatedString::formatted(",\n{}", state.indent);
 
     auto length = TRY(length_of_array_like(vm, object));
 
-    // Optimization
-    property_strings.ensure_capacity(length);
+    builder.append('[');
+    if (length > 0 && !state.gap.is_empty()) {
+        builder.append('\n');
+        builder.append(state.indent);
+    }
 
     for (size_t i = 0; i < length; ++i) {
-        auto serialized_property_string = TRY(serialize_json_property(vm, state, i, &object));
-        if (serialized_property_string.is_null()) {
-            property_strings.append("null"sv);
-        } else {
-            property_strings.append(serialized_property_string);
-        }
+        if (i > 0)
+            builder.append(separator);
+
+        bool serialized = false;
+        // OPTIMIZATION: Packed array elements are plain data properties, so Get() can't have any side effects.
+        if (auto element = is<Array>(object) ? object.indexed_properties().get_packed_element(static_cast<u32>(i)) : Optional<Value> {}; element.has_value())
+            serialized = TRY(serialize_json_property_value(vm, state, builder, i, &object, *element));
+        else
+            serialized = TRY(serialize_json_property(vm, state, builder, i, &object));
+
+        if (!serialized)
+            builder.append("null"sv);
     }
 
-    StringBuilder builder;
-    if (property_strings.is_empty()) {
-        builder.append("[]"sv);
-    } else {
-        if (state.gap.is_empty()) {
-            builder.append('[');
-            bool first = true;
-            for (auto& property_string : property_strings) {
-                if (!first)
-                    builder.append(',');
-                first = false;
-                builder.append(property_string);
-            }
-            builder.append(']');
-        } else {
-            builder.append("[\n"sv);
-            builder.append(state.indent);
-            auto separator = DeprecatedString::formatted(",\n{}", state.indent);
-            bool first = true;
-            for (auto& property_string : property_strings) {
-                if (!first)
-                    builder.append(separator);
-                first = false;
-                builder.append(property_string);
-            }
-            builder.append('\n');
-            builder.append(previous_indent);
-            builder.append(']');
-        }
+    if (length > 0 && !state.gap.is_empty()) {
+        builder.append('\n');
+        builder.append(previous_indent);
     }
+    builder.append(']');
 
     state.seen_objects.remove(&object);
     state.indent = previous_indent;
-    return builder.to_deprecated_string();
+    return {};
 }
 
 // 25.5.2.2 QuoteJSONString ( value ), https://tc39.es/ecma262/#sec-quotejsonstring
-DeprecatedString JSONObject::quote_json_string(DeprecatedString string)
+void JSONObject::quote_json_string(StringBuilder& builder, StringView string)
 {
+    // NOTE: The product is appended to the given builder directly.
     // 1. Let product be the String value consisting solely of the code unit 0x0022 (QUOTATION MARK).
-    StringBuilder builder;
     builder.append('"');
 
     // 2. For each code point C of StringToCodePoints(value), do
@@ -399,9 +416,92 @@ DeprecatedString JSONObject::quote_json_string(DeprecatedString string)
     }
     // 3. Set product to the string-concatenation of product and the code unit 0x0022 (QUOTATION MARK).
     builder.append('"');
+}
+
+namespace {
+
+// Builds the JS values for a JSON document straight from the parser's events, without an intermediate JsonValue tree.
+// NOTE: Object keys are interned right away from the parser's StringView. Keys that repeat throughout a document
+//       (e.g. in an array of records) then only cost a hash table lookup, and no string allocation or rehashing
+//       when they are turned into property keys.
+class JSONValueBuilder final : public JsonStreamVisitor {
+public:
+    explicit JSONValueBuilder(VM& vm)
+        : m_vm(vm)
+        , m_containers(vm.heap())
+    {
+    }
+
+    Value result() const { return m_result; }
+
+    virtual ErrorOr<void> on_object_start() override
+    {
+        auto& realm = *m_vm.current_realm();
+        return push_container(Object::create(realm, realm.intrinsics().object_prototype()));
+    }
+
+    virtual ErrorOr<void> on_object_key(StringView key) override
+    {
+        // An empty key in the document is still a string, not a null one.
+        TRY(m_keys.try_append(DeprecatedFlyString { key.is_empty() ? ""sv : key }));
+        return {};
+    }
+
+    virtual ErrorOr<void> on_array_start() override
+    {
+        return push_container(MUST(Array::create(*m_vm.current_realm(), 0)));
+    }
+
+    virtual ErrorOr<void> on_object_end() override { return pop_container(); }
+    virtual ErrorOr<void> on_array_end() override { return pop_container(); }
+
+    virtual ErrorOr<void> on_string(StringView string) override { return add_value(PrimitiveString::create(m_vm, DeprecatedString { string })); }
+    virtual ErrorOr<void> on_number(JsonValue number) override
+    {
+        if (number.is_i32())
+            return add_value(Value(number.as_i32()));
+        return add_value(Value(number.to_double(0)));
+    }
+    virtual ErrorOr<void> on_boolean(bool value) override { return add_value(Value(value)); }
+    virtual ErrorOr<void> on_null() override { return add_value(js_null()); }
+
+private:
+    ErrorOr<void> push_container(NonnullGCPtr<Object> container)
+    {
+        TRY(m_containers.try_append(container));
+        TRY(m_next_indices.try_append(0));
+        return {};
+    }
+
+    ErrorOr<void> pop_container()
+    {
+        auto container = m_containers.take_last();
+        m_next_indices.take_last();
+        return add_value(container);
+    }
+
+    ErrorOr<void> add_value(Value value)
+    {
+        if (m_containers.is_empty()) {
+            m_result = value;
+            return {};
+        }
+
+        auto& container = m_containers.last().as_object();
+        if (is<Array>(container))
+            container.define_direct_property(m_next_indices.last()++, value, default_attributes);
+        else
+            container.define_direct_property(m_keys.take_last(), value, default_attributes);
+        return {};
+    }
+
+    VM& m_vm;
+    MarkedVector<Value> m_containers;
+    Vector<u32, 16> m_next_indices;
+    Vector<DeprecatedFlyString, 16> m_keys;
+    Value m_result;
+};
 
-    // 4. Return product.
-    return builder.to_deprecated_string();
 }
 
 // 25.5.1 JSON.parse ( text [ , reviver ] ), https://tc39.es/ecma262/#sec-json.parse
@@ -412,10 +512,10 @@ JS_DEFINE_NATIVE_FUNCTION(JSONObject::parse)
     auto string = TRY(vm.argument(0).to_deprecated_string(vm));
     auto reviver = vm.argument(1);
 
-    auto json = JsonValue::from_string(string);
-    if (json.is_error())
+    JSONValueBuilder builder { vm };
+    if (auto result = JsonStreamParser { string }.parse(builder); result.is_error())
         return vm.throw_completion<SyntaxError>(ErrorType::JsonMalformed);
-    Value unfiltered = parse_json_value(vm, json.value());
+    Value unfiltered = builder.result();
     if (reviver.is_function()) {
         auto root = Object::create(realm, realm.intrinsics().object_prototype());
         auto root_name = DeprecatedString::empty();
@@ -35,10 +35,11 @@ private:
     };
 
     // Stringify helpers
-    static ThrowCompletionOr<DeprecatedString> serialize_json_property(VM&, StringifyState&, PropertyKey const& key, Object* holder);
-    static ThrowCompletionOr<DeprecatedString> serialize_json_object(VM&, StringifyState&, Object&);
-    static ThrowCompletionOr<DeprecatedString> serialize_json_array(VM&, StringifyState&, Object&);
-    static DeprecatedString quote_json_string(DeprecatedString);
+    static ThrowCompletionOr<bool> serialize_json_property(VM&, StringifyState&, StringBuilder&, PropertyKey const& key, Object* holder);
+    static ThrowCompletionOr<bool> serialize_json_property_value(VM&, StringifyState&, StringBuilder&, PropertyKey const& key, Object* holder, Value);
+    static ThrowCompletionOr<void> serialize_json_object(VM&, StringifyState&, StringBuilder&, Object&);
+    static ThrowCompletionOr<void> serialize_json_array(VM&, StringifyState&, StringBuilder&, Object&);
+    static void quote_json_string(StringBuilder&, StringView);
 
     // Parse helpers
     static Object* parse_json_object(VM&, JsonObject const&);
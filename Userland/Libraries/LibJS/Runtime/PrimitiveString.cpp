@@ -112,6 +112,15 @@ ThrowCompletionOr<DeprecatedString> PrimitiveString::deprecated_string() const
     return *m_deprecated_string;
 }
 
+ThrowCompletionOr<DeprecatedFlyString> PrimitiveString::deprecated_fly_string() const
+{
+    auto string = TRY(deprecated_string());
+    DeprecatedFlyString fly_string { string };
+    if (fly_string.impl() != string.impl())
+        m_deprecated_string = fly_string;
+    return fly_string;
+}
+
 ThrowCompletionOr<Utf16String> PrimitiveString::utf16_string() const
 {
     TRY(resolve_rope_if_needed());
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <AK/DeprecatedFlyString.h>
 #include <AK/DeprecatedString.h>
 #include <AK/Optional.h>
 #include <AK/String.h>
@@ -44,6 +45,10 @@ public:
     ThrowCompletionOr<DeprecatedString> deprecated_string() const;
     bool has_deprecated_string() const { return m_deprecated_string.has_value(); }
 
+    // NOTE: The interned string replaces the cached DeprecatedString, so turning the same PrimitiveString into a
+    //       PropertyKey again (e.g. for obj[key] in a loop) only has to check whether its StringImpl is already fly.
+    ThrowCompletionOr<DeprecatedFlyString> deprecated_fly_string() const;
+
     ThrowCompletionOr<Utf16String> utf16_string() const;
     ThrowCompletionOr<Utf16View> utf16_string_view() const;
     bool has_utf16_string() const { return m_utf16_string.has_value(); }
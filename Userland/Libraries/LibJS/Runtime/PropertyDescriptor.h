@@ -40,6 +40,9 @@ public:
     Optional<bool> writable {};
     Optional<bool> enumerable {};
     Optional<bool> configurable {};
+
+    // Non-standard: Where the property lives in the object's storage, if that's where it came from.
+    Optional<u32> property_offset {};
 };
 
 }
@@ -6,7 +6,9 @@
  */
 
 #include <AK/TypeCasts.h>
+#include <LibJS/AST.h>
 #include <LibJS/Heap/DeferGC.h>
+#include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/GlobalEnvironment.h>
 #include <LibJS/Runtime/GlobalObject.h>
 #include <LibJS/Runtime/Realm.h>
@@ -113,6 +115,25 @@ void Realm::set_global_object(Object* global_object, Object* this_value)
     // 7. Return unused.
 }
 
+Realm::~Realm() = default;
+
+Array* Realm::template_object(TaggedTemplateLiteral const& site, Cell const* script_or_module) const
+{
+    auto records = m_template_map.find(&site);
+    if (records == m_template_map.end())
+        return nullptr;
+    for (auto const& record : records->value) {
+        if (record.script_or_module.ptr() == script_or_module)
+            return record.array.ptr();
+    }
+    return nullptr;
+}
+
+void Realm::add_template_object(TaggedTemplateLiteral const& site, Cell* script_or_module, Array& template_object)
+{
+    m_template_map.ensure(&site).append({ site, script_or_module, template_object });
+}
+
 void Realm::visit_edges(Visitor& visitor)
 {
     Base::visit_edges(visitor);
@@ -121,6 +142,12 @@ void Realm::visit_edges(Visitor& visitor)
     visitor.visit(m_global_environment);
     if (m_host_defined)
         m_host_defined->visit_edges(visitor);
+    for (auto& it : m_template_map) {
+        for (auto& record : it.value) {
+            visitor.visit(record.script_or_module);
+            visitor.visit(record.array);
+        }
+    }
 }
 
 }
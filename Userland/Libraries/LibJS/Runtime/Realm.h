@@ -8,8 +8,11 @@
 #pragma once
 
 #include <AK/Badge.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullRefPtr.h>
 #include <AK/OwnPtr.h>
 #include <AK/StringView.h>
+#include <AK/Vector.h>
 #include <AK/Weakable.h>
 #include <LibJS/Heap/Cell.h>
 #include <LibJS/Runtime/Intrinsics.h>
@@ -29,6 +32,8 @@ public:
         virtual void visit_edges(Cell::Visitor&) { }
     };
 
+    virtual ~Realm() override;
+
     static ThrowCompletionOr<NonnullGCPtr<Realm>> create(VM&);
     static ThrowCompletionOr<NonnullOwnPtr<ExecutionContext>> initialize_host_defined_realm(VM&, Function<Object*(Realm&)> create_global_object, Function<Object*(Realm&)> create_global_this_value);
 
@@ -48,6 +53,9 @@ public:
     HostDefined* host_defined() { return m_host_defined; }
     void set_host_defined(OwnPtr<HostDefined> host_defined) { m_host_defined = move(host_defined); }
 
+    Array* template_object(TaggedTemplateLiteral const& site, Cell const* script_or_module) const;
+    void add_template_object(TaggedTemplateLiteral const& site, Cell* script_or_module, Array& template_object);
+
 private:
     Realm() = default;
 
@@ -57,6 +65,16 @@ private:
     Object* m_global_object { nullptr };                 // [[GlobalObject]]
     GlobalEnvironment* m_global_environment { nullptr }; // [[GlobalEnv]]
     OwnPtr<HostDefined> m_host_defined;                  // [[HostDefined]]
+
+    // NOTE: Several Script or Module Records may share one Program (see ProgramCache), so a Parse Node is identified by
+    //       the site together with the Script or Module Record it belongs to. The site is kept alive so that its address
+    //       can't be reused by a different Parse Node while it is in here.
+    struct TemplateRecord {
+        NonnullRefPtr<TaggedTemplateLiteral const> site;
+        GCPtr<Cell> script_or_module;
+        NonnullGCPtr<Array> array;
+    };
+    HashMap<TaggedTemplateLiteral const*, Vector<TemplateRecord, 1>> m_template_map; // [[TemplateMap]]
 };
 
 }
@@ -128,12 +128,94 @@ ThrowCompletionOr<DeprecatedString> parse_regex_pattern(VM& vm, StringView patte
     return result.release_value();
 }
 
+namespace {
+
+// Keeps the most recently compiled patterns around, so that code which creates the same RegExp over and over again
+// (e.g. a RegExp literal in a loop, or `new RegExp(...)` in a function that gets called a lot) only compiles it once.
+// NOTE: Like the rest of LibJS, this assumes that there is one JS VM per thread.
+class CompiledRegexCache {
+public:
+    static CompiledRegexCache& the()
+    {
+        static thread_local CompiledRegexCache s_the;
+        return s_the;
+    }
+
+    RefPtr<CompiledRegex> find(StringView parsed_pattern, regex::RegexOptions<ECMAScriptFlags> parsed_flags)
+    {
+        auto pattern_hash = parsed_pattern.hash();
+        for (size_t i = 0; i < m_entries.size(); ++i) {
+            auto const& entry = m_entries[i];
+            if (entry.pattern_hash != pattern_hash || entry.flags.value() != parsed_flags.value() || entry.regex->regex().pattern_value != parsed_pattern)
+                continue;
+            // Move the entry to the back, so the least recently used ones are at the front.
+            auto found = m_entries.take(i);
+            auto regex = found.regex;
+            m_entries.append(move(found));
+            return regex;
+        }
+        return {};
+    }
+
+    void add(NonnullRefPtr<CompiledRegex> regex, regex::RegexOptions<ECMAScriptFlags> parsed_flags)
+    {
+        if (m_entries.size() >= capacity)
+            m_entries.take_first();
+        auto pattern_hash = regex->regex().pattern_value.hash();
+        m_entries.append({ pattern_hash, parsed_flags, move(regex) });
+    }
+
+private:
+    static constexpr size_t capacity = 64;
+
+    struct Entry {
+        u32 pattern_hash { 0 };
+        regex::RegexOptions<ECMAScriptFlags> flags;
+        NonnullRefPtr<CompiledRegex> regex;
+    };
+
+    CompiledRegexCache() = default;
+
+    // Ordered from least to most recently used.
+    Vector<Entry> m_entries;
+};
+
+}
+
+Result<NonnullRefPtr<CompiledRegex>, DeprecatedString> compile_regex(DeprecatedString parsed_pattern, regex::RegexOptions<ECMAScriptFlags> parsed_flags)
+{
+    auto& cache = CompiledRegexCache::the();
+    if (auto regex = cache.find(parsed_pattern, parsed_flags))
+        return regex.release_nonnull();
+
+    Regex<ECMA262> regex(move(parsed_pattern), parsed_flags);
+    // NOTE: Patterns that fail to compile aren't cached, since they only ever produce a SyntaxError.
+    if (regex.parser_result.error != regex::Error::NoError)
+        return regex.error_string();
+
+    auto compiled_regex = adopt_ref(*new CompiledRegex(move(regex)));
+    cache.add(compiled_regex, parsed_flags);
+    return compiled_regex;
+}
+
+NonnullRefPtr<CompiledRegex> compile_regex(regex::Parser::Result const& parse_result, DeprecatedString parsed_pattern, regex::RegexOptions<ECMAScriptFlags> parsed_flags)
+{
+    auto& cache = CompiledRegexCache::the();
+    if (auto regex = cache.find(parsed_pattern, parsed_flags))
+        return regex.release_nonnull();
+
+    auto compiled_regex = adopt_ref(*new CompiledRegex(Regex<ECMA262>(parse_result, move(parsed_pattern), parsed_flags)));
+    VERIFY(compiled_regex->regex().parser_result.error == regex::Error::NoError);
+    cache.add(compiled_regex, parsed_flags);
+    return compiled_regex;
+}
+
 NonnullGCPtr<RegExpObject> RegExpObject::create(Realm& realm)
 {
     return realm.heap().allocate<RegExpObject>(realm, *realm.intrinsics().regexp_prototype()).release_allocated_value_but_fixme_should_propagate_errors();
 }
 
-NonnullGCPtr<RegExpObject> RegExpObject::create(Realm& realm, Regex<ECMA262> regex, DeprecatedString pattern, DeprecatedString flags)
+NonnullGCPtr<RegExpObject> RegExpObject::create(Realm& realm, NonnullRefPtr<CompiledRegex> regex, DeprecatedString pattern, DeprecatedString flags)
 {
     return realm.heap().allocate<RegExpObject>(realm, move(regex), move(pattern), move(flags), *realm.intrinsics().regexp_prototype()).release_allocated_value_but_fixme_should_propagate_errors();
 }
@@ -143,13 +225,13 @@ RegExpObject::RegExpObject(Object& prototype)
 {
 }
 
-RegExpObject::RegExpObject(Regex<ECMA262> regex, DeprecatedString pattern, DeprecatedString flags, Object& prototype)
+RegExpObject::RegExpObject(NonnullRefPtr<CompiledRegex> regex, DeprecatedString pattern, DeprecatedString flags, Object& prototype)
     : Object(ConstructWithPrototypeTag::Tag, prototype)
     , m_pattern(move(pattern))
     , m_flags(move(flags))
     , m_regex(move(regex))
 {
-    VERIFY(m_regex->parser_result.error == regex::Error::NoError);
+    VERIFY(m_regex->regex().parser_result.error == regex::Error::NoError);
 }
 
 ThrowCompletionOr<void> RegExpObject::initialize(Realm& realm)
@@ -204,12 +286,14 @@ ThrowCompletionOr<NonnullGCPtr<RegExpObject>> RegExpObject::regexp_initialize(VM
     }
 
     // 14. If parseResult is a non-empty List of SyntaxError objects, throw a SyntaxError exception.
-    Regex<ECMA262> regex(move(parsed_pattern), parsed_flags);
-    if (regex.parser_result.error != regex::Error::NoError)
-        return vm.throw_completion<SyntaxError>(ErrorType::RegExpCompileError, regex.error_string());
+    // OPTIMIZATION: Objects with the same pattern and flags share the compiled program, see CompiledRegexCache.
+    auto regex_or_error = compile_regex(move(parsed_pattern), parsed_flags);
+    if (regex_or_error.is_error())
+        return vm.throw_completion<SyntaxError>(ErrorType::RegExpCompileError, regex_or_error.release_error());
 
     // 15. Assert: parseResult is a Pattern Parse Node.
-    VERIFY(regex.parser_result.error == regex::Error::NoError);
+    auto regex = regex_or_error.release_value();
+    VERIFY(regex->regex().parser_result.error == regex::Error::NoError);
 
     // 16. Set obj.[[OriginalSource]] to P.
     m_pattern = move(pattern);
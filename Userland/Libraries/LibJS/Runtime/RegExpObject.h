@@ -6,7 +6,9 @@
 
 #pragma once
 
+#include <AK/NonnullRefPtr.h>
 #include <AK/Optional.h>
+#include <AK/RefCounted.h>
 #include <AK/Result.h>
 #include <LibJS/Runtime/Object.h>
 #include <LibRegex/Regex.h>
@@ -23,6 +25,24 @@ struct ParseRegexPatternError {
 ErrorOr<DeprecatedString, ParseRegexPatternError> parse_regex_pattern(StringView pattern, bool unicode, bool unicode_sets);
 ThrowCompletionOr<DeprecatedString> parse_regex_pattern(VM& vm, StringView pattern, bool unicode, bool unicode_sets);
 
+// A compiled pattern, shared by all RegExp objects that were created with the same (parsed) pattern and flags.
+// NOTE: Matching doesn't modify the Regex, except for its start offset, which is set right before every match.
+class CompiledRegex : public RefCounted<CompiledRegex> {
+public:
+    explicit CompiledRegex(Regex<ECMA262> regex)
+        : m_regex(move(regex))
+    {
+    }
+
+    Regex<ECMA262> const& regex() const { return m_regex; }
+
+private:
+    Regex<ECMA262> m_regex;
+};
+
+Result<NonnullRefPtr<CompiledRegex>, DeprecatedString> compile_regex(DeprecatedString parsed_pattern, regex::RegexOptions<ECMAScriptFlags> parsed_flags);
+NonnullRefPtr<CompiledRegex> compile_regex(regex::Parser::Result const& parse_result, DeprecatedString parsed_pattern, regex::RegexOptions<ECMAScriptFlags> parsed_flags);
+
 class RegExpObject : public Object {
     JS_OBJECT(RegExpObject, Object);
 
@@ -37,7 +57,7 @@ public:
     };
 
     static NonnullGCPtr<RegExpObject> create(Realm&);
-    static NonnullGCPtr<RegExpObject> create(Realm&, Regex<ECMA262> regex, DeprecatedString pattern, DeprecatedString flags);
+    static NonnullGCPtr<RegExpObject> create(Realm&, NonnullRefPtr<CompiledRegex>, DeprecatedString pattern, DeprecatedString flags);
 
     ThrowCompletionOr<NonnullGCPtr<RegExpObject>> regexp_initialize(VM&, Value pattern, Value flags);
     DeprecatedString escape_regexp_pattern() const;
@@ -47,8 +67,7 @@ public:
 
     DeprecatedString const& pattern() const { return m_pattern; }
     DeprecatedString const& flags() const { return m_flags; }
-    Regex<ECMA262> const& regex() { return *m_regex; }
-    Regex<ECMA262> const& regex() const { return *m_regex; }
+    Regex<ECMA262> const& regex() const { return m_regex->regex(); }
     Realm& realm() { return *m_realm; }
     Realm const& realm() const { return *m_realm; }
     bool legacy_features_enabled() const { return m_legacy_features_enabled; }
@@ -57,14 +76,14 @@ public:
 
 private:
     RegExpObject(Object& prototype);
-    RegExpObject(Regex<ECMA262> regex, DeprecatedString pattern, DeprecatedString flags, Object& prototype);
+    RegExpObject(NonnullRefPtr<CompiledRegex>, DeprecatedString pattern, DeprecatedString flags, Object& prototype);
 
     DeprecatedString m_pattern;
     DeprecatedString m_flags;
     bool m_legacy_features_enabled { false }; // [[LegacyFeaturesEnabled]]
     // Note: This is initialized in RegExpAlloc, but will be non-null afterwards
     GCPtr<Realm> m_realm; // [[Realm]]
-    Optional<Regex<ECMA262>> m_regex;
+    RefPtr<CompiledRegex> m_regex;
 };
 
 }
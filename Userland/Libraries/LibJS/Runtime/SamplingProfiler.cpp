@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonArraySerializer.h>
+#include <AK/JsonObjectSerializer.h>
+#include <LibJS/AST.h>
+#include <LibJS/Runtime/ECMAScriptFunctionObject.h>
+#include <LibJS/Runtime/ExecutionContext.h>
+#include <LibJS/Runtime/SamplingProfiler.h>
+#include <LibJS/Runtime/VM.h>
+#include <unistd.h>
+
+namespace JS {
+
+SamplingProfiler::SamplingProfiler(VM& vm, Time interval)
+    : m_vm(vm)
+    , m_interval(interval)
+{
+}
+
+SamplingProfiler::~SamplingProfiler()
+{
+    stop();
+}
+
+void SamplingProfiler::start()
+{
+    if (m_running)
+        return;
+    // NOTE: Only one profiler can be attached to a VM at a time.
+    VERIFY(!m_vm.sampling_profiler());
+    m_vm.set_sampling_profiler({}, this);
+    m_next_sample_time = Time::now_monotonic() + m_interval;
+    m_running = true;
+}
+
+void SamplingProfiler::stop()
+{
+    if (!m_running)
+        return;
+    m_vm.set_sampling_profiler({}, nullptr);
+    m_running = false;
+}
+
+void SamplingProfiler::take_sample(Time now)
+{
+    // If the interpreters didn't check in for a while, count the intervals we've missed as lost samples.
+    auto missed_intervals = (now - m_next_sample_time).to_microseconds() / max<i64>(m_interval.to_microseconds(), 1);
+    auto lost_samples = static_cast<u32>(min<i64>(missed_intervals, NumericLimits<u32>::max()));
+    m_next_sample_time = now + m_interval;
+
+    Sample sample { now, lost_samples, {} };
+    auto const& execution_context_stack = m_vm.execution_context_stack();
+    sample.stack.ensure_capacity(execution_context_stack.size());
+    // NOTE: Like the stacks in the kernel's perfcore files, these go from the innermost frame to the outermost one.
+    for (ssize_t i = execution_context_stack.size() - 1; i >= 0; --i)
+        sample.stack.unchecked_append(frame_index_for(*execution_context_stack[i]));
+    m_samples.append(move(sample));
+}
+
+u32 SamplingProfiler::frame_index_for_name(DeprecatedString name)
+{
+    if (auto index = m_frame_indices_by_name.get(name); index.has_value())
+        return *index;
+    u32 index = m_frame_names.size();
+    m_frame_indices_by_name.set(name, index);
+    m_frame_names.append(move(name));
+    return index;
+}
+
+u32 SamplingProfiler::frame_index_for(ExecutionContext const& context)
+{
+    auto function_name = context.function_name.is_empty() ? "<unknown>"sv : context.function_name.view();
+
+    if (!context.function || !context.function->is_ecmascript_function_object())
+        return frame_index_for_name(function_name);
+
+    auto const& code = static_cast<ECMAScriptFunctionObject const&>(*context.function).ecmascript_code();
+    if (auto index = m_frame_indices_by_code.get(&code); index.has_value())
+        return *index;
+
+    auto source_range = code.source_range();
+    auto index = frame_index_for_name(DeprecatedString::formatted("{} ({}:{}:{})", function_name, source_range.filename(), source_range.start.line, source_range.start.column));
+    m_frame_indices_by_code.set(&code, index);
+    m_seen_code.append(code);
+    return index;
+}
+
+ErrorOr<void> SamplingProfiler::write_perfcore_json(StringBuilder& builder, StringView executable) const
+{
+    auto pid = getpid();
+    auto start_timestamp = m_samples.is_empty() ? Time::now_monotonic() : m_samples.first().timestamp;
+
+    auto object = TRY(JsonObjectSerializer<>::try_create(builder));
+    auto strings = TRY(object.add_array("strings"sv));
+    TRY(strings.finish());
+
+    auto events = TRY(object.add_array("events"sv));
+    {
+        auto event = TRY(events.add_object());
+        TRY(event.add("type"sv, "process_create"sv));
+        TRY(event.add("pid"sv, pid));
+        TRY(event.add("tid"sv, pid));
+        TRY(event.add("timestamp"sv, start_timestamp.to_milliseconds()));
+        TRY(event.add("parent_pid"sv, 0));
+        TRY(event.add("executable"sv, executable));
+        TRY(event.finish());
+    }
+    for (auto const& sample : m_samples) {
+        auto event = TRY(events.add_object());
+        TRY(event.add("type"sv, "sample"sv));
+        TRY(event.add("pid"sv, pid));
+        TRY(event.add("tid"sv, pid));
+        TRY(event.add("timestamp"sv, sample.timestamp.to_milliseconds()));
+        TRY(event.add("lost_samples"sv, sample.lost_samples));
+        auto stack = TRY(event.add_array("stack"sv));
+        for (auto frame_index : sample.stack)
+            TRY(stack.add(m_frame_names[frame_index]));
+        // NOTE: The Profiler ignores samples with fewer than two frames, so we root every stack at the executable.
+        TRY(stack.add(executable));
+        TRY(stack.finish());
+        TRY(event.finish());
+    }
+    TRY(events.finish());
+
+    return object.finish();
+}
+
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/DeprecatedString.h>
+#include <AK/HashMap.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/StringBuilder.h>
+#include <AK/Time.h>
+#include <AK/Vector.h>
+#include <LibJS/Forward.h>
+
+namespace JS {
+
+// Periodically records the JavaScript call stack, so we can tell which functions the time is spent in.
+// The result is written in the perfcore format that the Profiler DevTool reads, with the stack frames given as
+// (already symbolicated) strings instead of addresses.
+// NOTE: Samples can only be taken when one of the interpreters checks in, which they do for every AST node and every
+//       bytecode basic block. Time spent in a long-running native function is attributed to the stack it was called from.
+class SamplingProfiler {
+    AK_MAKE_NONCOPYABLE(SamplingProfiler);
+    AK_MAKE_NONMOVABLE(SamplingProfiler);
+
+public:
+    explicit SamplingProfiler(VM&, Time interval = Time::from_milliseconds(1));
+    ~SamplingProfiler();
+
+    void start();
+    void stop();
+    bool is_running() const { return m_running; }
+
+    size_t sample_count() const { return m_samples.size(); }
+
+    ALWAYS_INLINE void sample_if_due()
+    {
+        auto now = Time::now_monotonic();
+        if (now >= m_next_sample_time)
+            take_sample(now);
+    }
+
+    ErrorOr<void> write_perfcore_json(StringBuilder&, StringView executable) const;
+
+private:
+    struct Sample {
+        Time timestamp;
+        u32 lost_samples { 0 };
+        Vector<u32> stack;
+    };
+
+    void take_sample(Time now);
+    u32 frame_index_for(ExecutionContext const&);
+    u32 frame_index_for_name(DeprecatedString);
+
+    VM& m_vm;
+    Time m_interval;
+    Time m_next_sample_time;
+    bool m_running { false };
+
+    Vector<Sample> m_samples;
+
+    Vector<DeprecatedString> m_frame_names;
+    HashMap<DeprecatedString, u32> m_frame_indices_by_name;
+
+    // NOTE: We hold on to the code of every function we've seen, so that its address can't be reused by another one.
+    HashMap<Statement const*, u32> m_frame_indices_by_code;
+    Vector<NonnullRefPtr<Statement const>> m_seen_code;
+};
+
+}
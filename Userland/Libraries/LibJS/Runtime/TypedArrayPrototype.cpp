@@ -330,55 +330,21 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::copy_within)
         auto from_byte_index = from_byte_index_checked.value();
         auto count_bytes = count_bytes_checked.value();
 
-        Checked<size_t> from_plus_count = from_byte_index;
-        from_plus_count += count_bytes;
-        if (from_plus_count.has_overflow()) {
-            dbgln("TypedArrayPrototype::copy_within: from_plus_count overflowed, returning as if succeeded.");
-            return typed_array;
-        }
-
-        i8 direction;
-
         // i. If fromByteIndex < toByteIndex and toByteIndex < fromByteIndex + countBytes, then
-        if (from_byte_index < to_byte_index && to_byte_index < from_plus_count.value()) {
-            // i. Let direction be -1.
-            direction = -1;
-
-            // ii. Set fromByteIndex to fromByteIndex + countBytes - 1.
-            from_byte_index = from_plus_count.value() - 1;
-
-            Checked<size_t> to_plus_count = to_byte_index;
-            to_plus_count += count_bytes;
-            if (to_plus_count.has_overflow()) {
-                dbgln("TypedArrayPrototype::copy_within: to_plus_count overflowed, returning as if succeeded.");
-                return typed_array;
-            }
-
-            // iii. Set toByteIndex to toByteIndex + countBytes - 1.
-            to_byte_index = to_plus_count.value() - 1;
-        }
+        //     i. Let direction be -1.
+        //     ii. Set fromByteIndex to fromByteIndex + countBytes - 1.
+        //     iii. Set toByteIndex to toByteIndex + countBytes - 1.
         // j. Else,
-        else {
-            // i. Let direction be 1.
-            direction = 1;
-        }
-
+        //     i. Let direction be 1.
         // k. Repeat, while countBytes > 0,
-        for (; count_bytes > 0; --count_bytes) {
-            // i. Let value be GetValueFromBuffer(buffer, fromByteIndex, Uint8, true, Unordered).
-            auto value = buffer->get_value<u8>(from_byte_index, true, ArrayBuffer::Order::Unordered);
-
-            // ii. Perform SetValueInBuffer(buffer, toByteIndex, Uint8, value, true, Unordered).
-            buffer->set_value<u8>(to_byte_index, value, true, ArrayBuffer::Order::Unordered);
-
-            // iii. Set fromByteIndex to fromByteIndex + direction.
-            from_byte_index += direction;
-
-            // iv. Set toByteIndex to toByteIndex + direction.
-            to_byte_index += direction;
-
-            // v. Set countBytes to countBytes - 1.
-        }
+        //     i. Let value be GetValueFromBuffer(buffer, fromByteIndex, Uint8, true, Unordered).
+        //     ii. Perform SetValueInBuffer(buffer, toByteIndex, Uint8, value, true, Unordered).
+        //     iii. Set fromByteIndex to fromByteIndex + direction.
+        //     iv. Set toByteIndex to toByteIndex + direction.
+        //     v. Set countBytes to countBytes - 1.
+        // OPTIMIZATION: Copying byte by byte in the direction that doesn't overwrite the source is exactly what memmove() does.
+        auto* data = buffer->buffer().data();
+        memmove(data + to_byte_index, data + from_byte_index, count_bytes);
     }
 
     // 18. Return O.
@@ -467,12 +433,23 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::fill)
         return vm.throw_completion<TypeError>(ErrorType::DetachedArrayBuffer);
 
     // 15. Repeat, while k < final,
-    for (; k < final; ++k) {
-        // a. Let Pk be ! ToString(𝔽(k)).
-        // b. Perform ! Set(O, Pk, value, true).
-        MUST(typed_array->set(k, value, Object::ShouldThrowExceptions::Yes));
-
-        // c. Set k to k + 1.
+    //     a. Let Pk be ! ToString(𝔽(k)).
+    //     b. Perform ! Set(O, Pk, value, true).
+    //     c. Set k to k + 1.
+    // OPTIMIZATION: Every element ends up with the same bit pattern, so we only encode the value once, and then keep
+    //               copying the part of the range that's already filled onto the rest of it.
+    if (k < final) {
+        auto element_size = typed_array->element_size();
+        auto byte_index = typed_array->byte_offset() + static_cast<size_t>(k) * element_size;
+        auto byte_count = static_cast<size_t>(final - k) * element_size;
+        typed_array->set_value_in_buffer(byte_index, value, ArrayBuffer::Order::Unordered);
+
+        auto* data = typed_array->viewed_array_buffer()->buffer().data() + byte_index;
+        for (size_t filled = element_size; filled < byte_count;) {
+            auto chunk_size = min(filled, byte_count - filled);
+            memcpy(data + filled, data, chunk_size);
+            filled += chunk_size;
+        }
     }
 
     // 16. Return O.
@@ -15,6 +15,7 @@
 #include <LibCore/DeprecatedFile.h>
 #include <LibJS/AST.h>
 #include <LibJS/Interpreter.h>
+#include <LibJS/ProgramCache.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/BoundFunction.h>
@@ -49,6 +50,7 @@ static constexpr auto single_ascii_character_strings = make_single_ascii_charact
 
 VM::VM(OwnPtr<CustomData> custom_data)
     : m_heap(*this)
+    , m_program_cache(make<ProgramCache>())
     , m_custom_data(move(custom_data))
 {
     m_empty_string = m_heap.allocate_without_realm<PrimitiveString>(String {});
@@ -159,6 +161,8 @@ VM::VM(OwnPtr<CustomData> custom_data)
     m_error_messages[to_underlying(ErrorMessage::OutOfMemory)] = String::from_utf8(ErrorType::OutOfMemory.message()).release_value_but_fixme_should_propagate_errors();
 }
 
+VM::~VM() = default;
+
 String const& VM::error_message(ErrorMessage type) const
 {
     VERIFY(type < ErrorMessage::__Count);
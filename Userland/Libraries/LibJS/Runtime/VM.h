@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <AK/Badge.h>
 #include <AK/DeprecatedFlyString.h>
 #include <AK/Function.h>
 #include <AK/HashMap.h>
@@ -39,11 +40,13 @@ public:
     };
 
     static NonnullRefPtr<VM> create(OwnPtr<CustomData> = {});
-    ~VM() = default;
+    ~VM();
 
     Heap& heap() { return m_heap; }
     Heap const& heap() const { return m_heap; }
 
+    ProgramCache& program_cache() { return *m_program_cache; }
+
     Interpreter& interpreter();
     Interpreter* interpreter_if_exists();
 
@@ -187,6 +190,9 @@ public:
 
     StackInfo const& stack_info() const { return m_stack_info; };
 
+    SamplingProfiler* sampling_profiler() { return m_sampling_profiler; }
+    void set_sampling_profiler(Badge<SamplingProfiler>, SamplingProfiler* profiler) { m_sampling_profiler = profiler; }
+
     HashMap<String, NonnullGCPtr<Symbol>> const& global_symbol_registry() const { return m_global_symbol_registry; }
     HashMap<String, NonnullGCPtr<Symbol>>& global_symbol_registry() { return m_global_symbol_registry; }
 
@@ -292,6 +298,8 @@ private:
 
     StackInfo m_stack_info;
 
+    SamplingProfiler* m_sampling_profiler { nullptr };
+
     // GlobalSymbolRegistry, https://tc39.es/ecma262/#table-globalsymbolregistry-record-fields
     HashMap<String, NonnullGCPtr<Symbol>> m_global_symbol_registry;
 
@@ -315,6 +323,8 @@ private:
 
     Vector<StoredModule> m_loaded_modules;
 
+    OwnPtr<ProgramCache> m_program_cache;
+
 #define __JS_ENUMERATE(SymbolName, snake_name) \
     Symbol* m_well_known_symbol_##snake_name { nullptr };
     JS_ENUMERATE_WELL_KNOWN_SYMBOLS
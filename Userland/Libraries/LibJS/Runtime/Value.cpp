@@ -600,6 +600,10 @@ ThrowCompletionOr<Object*> Value::to_object(VM& vm) const
 // 7.1.3 ToNumeric ( value ), https://tc39.es/ecma262/#sec-tonumeric
 FLATTEN ThrowCompletionOr<Value> Value::to_numeric(VM& vm) const
 {
+    // OPTIMIZATION: Both ToPrimitive() and ToNumber() return Numbers unchanged.
+    if (is_number())
+        return *this;
+
     // 1. Let primValue be ? ToPrimitive(value, number).
     auto primitive_value = TRY(to_primitive(vm, Value::PreferredType::Number));
 
@@ -896,6 +900,10 @@ ThrowCompletionOr<PropertyKey> Value::to_property_key(VM& vm) const
     if (is_int32() && as_i32() >= 0)
         return PropertyKey { as_i32() };
 
+    // OPTIMIZATION: Strings are already primitive, and can hand out their cached interned string.
+    if (is_string())
+        return PropertyKey { TRY(as_string().deprecated_fly_string()) };
+
     // 1. Let key be ? ToPrimitive(argument, string).
     auto key = TRY(to_primitive(vm, PreferredType::String));
 
@@ -1343,6 +1351,10 @@ ThrowCompletionOr<Value> bitwise_and(VM& vm, Value lhs, Value rhs)
     // 13.15.3 ApplyStringOrNumericBinaryOperator ( lval, opText, rval ), https://tc39.es/ecma262/#sec-applystringornumericbinaryoperator
     // 1-2, 6. N/A.
 
+    // OPTIMIZATION: If both values are i32, ToInt32() and ToUint32() are trivial and we can skip the type conversions below.
+    if (lhs.is_int32() && rhs.is_int32())
+        return Value(lhs.as_i32() & rhs.as_i32());
+
     // 3. Let lnum be ? ToNumeric(lval).
     auto lhs_numeric = TRY(lhs.to_numeric(vm));
 
@@ -1376,6 +1388,10 @@ ThrowCompletionOr<Value> bitwise_or(VM& vm, Value lhs, Value rhs)
     // 13.15.3 ApplyStringOrNumericBinaryOperator ( lval, opText, rval ), https://tc39.es/ecma262/#sec-applystringornumericbinaryoperator
     // 1-2, 6. N/A.
 
+    // OPTIMIZATION: If both values are i32, ToInt32() and ToUint32() are trivial and we can skip the type conversions below.
+    if (lhs.is_int32() && rhs.is_int32())
+        return Value(lhs.as_i32() | rhs.as_i32());
+
     // 3. Let lnum be ? ToNumeric(lval).
     auto lhs_numeric = TRY(lhs.to_numeric(vm));
 
@@ -1413,6 +1429,10 @@ ThrowCompletionOr<Value> bitwise_xor(VM& vm, Value lhs, Value rhs)
     // 13.15.3 ApplyStringOrNumericBinaryOperator ( lval, opText, rval ), https://tc39.es/ecma262/#sec-applystringornumericbinaryoperator
     // 1-2, 6. N/A.
 
+    // OPTIMIZATION: If both values are i32, ToInt32() and ToUint32() are trivial and we can skip the type conversions below.
+    if (lhs.is_int32() && rhs.is_int32())
+        return Value(lhs.as_i32() ^ rhs.as_i32());
+
     // 3. Let lnum be ? ToNumeric(lval).
     auto lhs_numeric = TRY(lhs.to_numeric(vm));
 
@@ -1534,6 +1554,10 @@ ThrowCompletionOr<Value> left_shift(VM& vm, Value lhs, Value rhs)
     // 13.15.3 ApplyStringOrNumericBinaryOperator ( lval, opText, rval ), https://tc39.es/ecma262/#sec-applystringornumericbinaryoperator
     // 1-2, 6. N/A.
 
+    // OPTIMIZATION: If both values are i32, ToInt32() and ToUint32() are trivial and we can skip the type conversions below.
+    if (lhs.is_int32() && rhs.is_int32())
+        return Value(static_cast<i32>(static_cast<u32>(lhs.as_i32()) << (rhs.as_i32() & 31)));
+
     // 3. Let lnum be ? ToNumeric(lval).
     auto lhs_numeric = TRY(lhs.to_numeric(vm));
 
@@ -1597,6 +1621,10 @@ ThrowCompletionOr<Value> right_shift(VM& vm, Value lhs, Value rhs)
     // 13.15.3 ApplyStringOrNumericBinaryOperator ( lval, opText, rval ), https://tc39.es/ecma262/#sec-applystringornumericbinaryoperator
     // 1-2, 6. N/A.
 
+    // OPTIMIZATION: If both values are i32, ToInt32() and ToUint32() are trivial and we can skip the type conversions below.
+    if (lhs.is_int32() && rhs.is_int32())
+        return Value(lhs.as_i32() >> (rhs.as_i32() & 31));
+
     // 3. Let lnum be ? ToNumeric(lval).
     auto lhs_numeric = TRY(lhs.to_numeric(vm));
 
@@ -1648,6 +1676,10 @@ ThrowCompletionOr<Value> unsigned_right_shift(VM& vm, Value lhs, Value rhs)
     // 13.15.3 ApplyStringOrNumericBinaryOperator ( lval, opText, rval ), https://tc39.es/ecma262/#sec-applystringornumericbinaryoperator
     // 1-2, 5-6. N/A.
 
+    // OPTIMIZATION: If both values are i32, ToInt32() and ToUint32() are trivial and we can skip the type conversions below.
+    if (lhs.is_int32() && rhs.is_int32())
+        return Value(static_cast<u32>(lhs.as_i32()) >> (rhs.as_i32() & 31));
+
     // 3. Let lnum be ? ToNumeric(lval).
     auto lhs_numeric = TRY(lhs.to_numeric(vm));
 
@@ -1767,6 +1799,11 @@ ThrowCompletionOr<Value> sub(VM& vm, Value lhs, Value rhs)
     // 13.15.3 ApplyStringOrNumericBinaryOperator ( lval, opText, rval ), https://tc39.es/ecma262/#sec-applystringornumericbinaryoperator
     // 1-2, 6. N/A.
 
+    // OPTIMIZATION: If both values are i32, we can subtract them directly without the type conversions below.
+    //               The difference of two i32s always fits in a double, and Value(double) turns it back into an i32 if possible.
+    if (lhs.is_int32() && rhs.is_int32())
+        return Value(static_cast<double>(lhs.as_i32()) - static_cast<double>(rhs.as_i32()));
+
     // 3. Let lnum be ? ToNumeric(lval).
     auto lhs_numeric = TRY(lhs.to_numeric(vm));
 
@@ -1802,6 +1839,11 @@ ThrowCompletionOr<Value> mul(VM& vm, Value lhs, Value rhs)
     // 13.15.3 ApplyStringOrNumericBinaryOperator ( lval, opText, rval ), https://tc39.es/ecma262/#sec-applystringornumericbinaryoperator
     // 1-2, 6. N/A.
 
+    // OPTIMIZATION: If both values are i32, we can multiply them directly without the type conversions below.
+    //               Multiplying as doubles gets both -0 and results that don't fit in an i32 right.
+    if (lhs.is_int32() && rhs.is_int32())
+        return Value(static_cast<double>(lhs.as_i32()) * static_cast<double>(rhs.as_i32()));
+
     // 3. Let lnum be ? ToNumeric(lval).
     auto lhs_numeric = TRY(lhs.to_numeric(vm));
 
@@ -2206,6 +2248,10 @@ bool same_value_non_number(Value lhs, Value rhs)
 // 7.2.15 IsStrictlyEqual ( x, y ), https://tc39.es/ecma262/#sec-isstrictlyequal
 bool is_strictly_equal(Value lhs, Value rhs)
 {
+    // OPTIMIZATION: Two i32s are equal exactly if their encodings are.
+    if (lhs.is_int32() && rhs.is_int32())
+        return lhs.as_i32() == rhs.as_i32();
+
     // 1. If Type(x) is different from Type(y), return false.
     if (!same_type_for_equality(lhs, rhs))
         return false;
@@ -497,6 +497,15 @@ private:
     friend ThrowCompletionOr<Value> less_than(VM&, Value lhs, Value rhs);
     friend ThrowCompletionOr<Value> less_than_equals(VM&, Value lhs, Value rhs);
     friend ThrowCompletionOr<Value> add(VM&, Value lhs, Value rhs);
+    friend ThrowCompletionOr<Value> sub(VM&, Value lhs, Value rhs);
+    friend ThrowCompletionOr<Value> mul(VM&, Value lhs, Value rhs);
+    friend ThrowCompletionOr<Value> bitwise_and(VM&, Value lhs, Value rhs);
+    friend ThrowCompletionOr<Value> bitwise_or(VM&, Value lhs, Value rhs);
+    friend ThrowCompletionOr<Value> bitwise_xor(VM&, Value lhs, Value rhs);
+    friend ThrowCompletionOr<Value> left_shift(VM&, Value lhs, Value rhs);
+    friend ThrowCompletionOr<Value> right_shift(VM&, Value lhs, Value rhs);
+    friend ThrowCompletionOr<Value> unsigned_right_shift(VM&, Value lhs, Value rhs);
+    friend bool is_strictly_equal(Value lhs, Value rhs);
     friend bool same_value_non_number(Value lhs, Value rhs);
 };
 
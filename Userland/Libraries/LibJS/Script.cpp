@@ -5,8 +5,7 @@
  */
 
 #include <LibJS/AST.h>
-#include <LibJS/Lexer.h>
-#include <LibJS/Parser.h>
+#include <LibJS/ProgramCache.h>
 #include <LibJS/Runtime/VM.h>
 #include <LibJS/Script.h>
 
@@ -16,12 +15,12 @@ namespace JS {
 Result<NonnullGCPtr<Script>, Vector<ParserError>> Script::parse(StringView source_text, Realm& realm, StringView filename, HostDefined* host_defined, size_t line_number_offset)
 {
     // 1. Let script be ParseText(sourceText, Script).
-    auto parser = Parser(Lexer(source_text, filename, line_number_offset));
-    auto script = parser.parse_program();
+    auto script_or_errors = realm.vm().program_cache().parse(source_text, filename, Program::Type::Script, line_number_offset);
 
     // 2. If script is a List of errors, return body.
-    if (parser.has_errors())
-        return parser.errors();
+    if (script_or_errors.is_error())
+        return script_or_errors.release_error();
+    auto script = script_or_errors.release_value();
 
     // 3. Return Script Record { [[Realm]]: realm, [[ECMAScriptCode]]: script, [[HostDefined]]: hostDefined }.
     return realm.heap().allocate_without_realm<Script>(realm, filename, move(script), host_defined);
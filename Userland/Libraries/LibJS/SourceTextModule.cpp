@@ -8,7 +8,7 @@
 #include <AK/Debug.h>
 #include <AK/QuickSort.h>
 #include <LibJS/Interpreter.h>
-#include <LibJS/Parser.h>
+#include <LibJS/ProgramCache.h>
 #include <LibJS/Runtime/ECMAScriptFunctionObject.h>
 #include <LibJS/Runtime/ModuleEnvironment.h>
 #include <LibJS/SourceTextModule.h>
@@ -124,12 +124,12 @@ void SourceTextModule::visit_edges(Cell::Visitor& visitor)
 Result<NonnullGCPtr<SourceTextModule>, Vector<ParserError>> SourceTextModule::parse(StringView source_text, Realm& realm, StringView filename, Script::HostDefined* host_defined)
 {
     // 1. Let body be ParseText(sourceText, Module).
-    auto parser = Parser(Lexer(source_text, filename), Program::Type::Module);
-    auto body = parser.parse_program();
+    auto body_or_errors = realm.vm().program_cache().parse(source_text, filename, Program::Type::Module);
 
     // 2. If body is a List of errors, return body.
-    if (parser.has_errors())
-        return parser.errors();
+    if (body_or_errors.is_error())
+        return body_or_errors.release_error();
+    auto body = body_or_errors.release_value();
 
     // Needed for 2.7 Static Semantics: AssertClauseToAssertions, https://tc39.es/proposal-import-assertions/#sec-assert-clause-to-assertions
     // 1. Let supportedAssertions be !HostGetSupportedImportAssertions().
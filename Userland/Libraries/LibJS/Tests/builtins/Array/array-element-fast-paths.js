@@ -0,0 +1,69 @@
+test("reading and writing packed elements", () => {
+    const array = [1, 2, 3];
+    for (let i = 0; i < array.length; ++i) array[i] = array[i] * 2;
+    expect(array).toEqual([2, 4, 6]);
+    expect(array[-1]).toBeUndefined();
+    expect(array[3]).toBeUndefined();
+    expect(array[1.5]).toBeUndefined();
+});
+
+test("holes are looked up on the prototype chain", () => {
+    const array = [1, , 3];
+    Array.prototype[1] = "from prototype";
+    try {
+        expect(array[1]).toBe("from prototype");
+        expect(array.indexOf("from prototype")).toBe(1);
+        expect(array.includes("from prototype")).toBeTrue();
+    } finally {
+        delete Array.prototype[1];
+    }
+    expect(array[1]).toBeUndefined();
+    expect(array.indexOf(undefined)).toBe(-1);
+    expect(array.includes(undefined)).toBeTrue();
+});
+
+test("accessor elements are not bypassed", () => {
+    const array = [1, 2, 3];
+    let setterValue;
+    Object.defineProperty(array, 1, {
+        get: () => "getter",
+        set: value => {
+            setterValue = value;
+        },
+    });
+    expect(array[1]).toBe("getter");
+    array[1] = 42;
+    expect(setterValue).toBe(42);
+    expect(array.indexOf("getter")).toBe(1);
+});
+
+test("frozen arrays can't be written to", () => {
+    const array = Object.freeze([1, 2, 3]);
+    array[0] = 42;
+    expect(array[0]).toBe(1);
+    expect(() => {
+        "use strict";
+        array[0] = 42;
+    }).toThrow(TypeError);
+});
+
+test("searching while a getter shrinks the array", () => {
+    const array = [1, 2, 3, 4];
+    Object.defineProperty(array, 1, {
+        get: () => {
+            array.length = 2;
+            return 2;
+        },
+        configurable: true,
+    });
+    expect(array.indexOf(4)).toBe(-1);
+    expect(array.length).toBe(2);
+});
+
+test("negative zero as an index", () => {
+    const array = ["zero"];
+    expect(array[-0]).toBe("zero");
+    array[-0] = "still zero";
+    expect(array[0]).toBe("still zero");
+    expect(array.length).toBe(1);
+});
@@ -0,0 +1,40 @@
+test("regexps with the same pattern and flags keep their own state", () => {
+    const first = /a(b)?/g;
+    const second = new RegExp("a(b)?", "g");
+    const string = "ab a ab";
+
+    expect(first.exec(string)[0]).toBe("ab");
+    expect(first.lastIndex).toBe(2);
+    expect(second.lastIndex).toBe(0);
+
+    expect(second.exec(string)[0]).toBe("ab");
+    expect(first.exec(string)[0]).toBe("a");
+    expect(second.exec(string)[0]).toBe("a");
+    expect(first.lastIndex).toBe(4);
+    expect(second.lastIndex).toBe(4);
+});
+
+test("same pattern with different flags", () => {
+    for (let i = 0; i < 3; ++i) {
+        expect(new RegExp("abc").test("ABC")).toBeFalse();
+        expect(new RegExp("abc", "i").test("ABC")).toBeTrue();
+        expect(/abc/.test("ABC")).toBeFalse();
+        expect(/abc/i.test("ABC")).toBeTrue();
+    }
+});
+
+test("invalid patterns throw every time", () => {
+    for (let i = 0; i < 3; ++i) {
+        expect(() => new RegExp("(")).toThrow(SyntaxError);
+    }
+});
+
+test("sticky regexps created in a loop", () => {
+    const matches = [];
+    for (let i = 0; i < 5; ++i) {
+        const regex = new RegExp("\\d", "y");
+        regex.lastIndex = i;
+        matches.push(regex.exec("01234")[0]);
+    }
+    expect(matches).toEqual(["0", "1", "2", "3", "4"]);
+});
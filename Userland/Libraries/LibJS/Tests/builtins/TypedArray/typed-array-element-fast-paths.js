@@ -0,0 +1,81 @@
+test("element reads and writes", () => {
+    const array = new Int16Array(4);
+    for (let i = 0; i < array.length; ++i) array[i] = i * 1000 - 1500;
+    expect(Array.from(array)).toEqual([-1500, -500, 500, 1500]);
+
+    array[0] = 40000;
+    expect(array[0]).toBe(40000 - 65536);
+
+    const floats = new Float32Array(2);
+    floats[0] = 0.1;
+    expect(floats[0]).toBe(Math.fround(0.1));
+
+    const clamped = new Uint8ClampedArray(2);
+    clamped[0] = 300;
+    clamped[1] = -5;
+    expect(clamped[0]).toBe(255);
+    expect(clamped[1]).toBe(0);
+});
+
+test("out of bounds indices", () => {
+    const array = new Uint8Array(2);
+    Object.getPrototypeOf(Uint8Array.prototype)[5] = "prototype";
+    expect(array[5]).toBeUndefined();
+    array[5] = 1;
+    expect(Object.hasOwn(array, "5")).toBeFalse();
+    expect(array.length).toBe(2);
+    delete Object.getPrototypeOf(Uint8Array.prototype)[5];
+});
+
+test("values that need to be converted", () => {
+    const array = new Int32Array(1);
+    let calls = 0;
+    array[0] = {
+        valueOf() {
+            ++calls;
+            return 42;
+        },
+    };
+    expect(calls).toBe(1);
+    expect(array[0]).toBe(42);
+
+    array[0] = "7";
+    expect(array[0]).toBe(7);
+    expect(() => {
+        array[0] = 1n;
+    }).toThrow(TypeError);
+
+    const bigints = new BigInt64Array(1);
+    bigints[0] = 5n;
+    expect(bigints[0]).toBe(5n);
+    expect(() => {
+        bigints[0] = 5;
+    }).toThrow(TypeError);
+});
+
+test("detached buffers", () => {
+    const array = new Float64Array(4);
+    array[1] = 2;
+    detachArrayBuffer(array.buffer);
+    expect(array[1]).toBeUndefined();
+    array[1] = 3;
+    expect(array[1]).toBeUndefined();
+});
+
+test("fill and copyWithin", () => {
+    const array = new Uint16Array(37);
+    array.fill(0x1234, 3, 36);
+    expect(array[2]).toBe(0);
+    for (let i = 3; i < 36; ++i) expect(array[i]).toBe(0x1234);
+    expect(array[36]).toBe(0);
+
+    const bytes = new Uint8Array([1, 2, 3, 4, 5, 6, 7, 8]);
+    bytes.copyWithin(2, 0, 5);
+    expect(Array.from(bytes)).toEqual([1, 2, 1, 2, 3, 4, 5, 8]);
+    bytes.copyWithin(0, 3);
+    expect(Array.from(bytes)).toEqual([2, 3, 4, 5, 8, 4, 5, 8]);
+
+    const view = new Int32Array(new ArrayBuffer(32), 8, 4);
+    view.fill(-1, 1);
+    expect(Array.from(new Int32Array(view.buffer))).toEqual([0, 0, 0, -1, -1, -1, 0, 0]);
+});
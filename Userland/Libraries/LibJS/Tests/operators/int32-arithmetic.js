@@ -0,0 +1,43 @@
+test("addition and subtraction overflowing an int32", () => {
+    expect(2147483647 + 1).toBe(2147483648);
+    expect(-2147483648 - 1).toBe(-2147483649);
+    expect(-2147483648 - -2147483648).toBe(0);
+    expect(1 - 1).toBe(0);
+    expect(Object.is(1 - 1, 0)).toBeTrue();
+});
+
+test("multiplication producing negative zero or overflowing an int32", () => {
+    expect(Object.is(0 * -5, -0)).toBeTrue();
+    expect(Object.is(-5 * 0, -0)).toBeTrue();
+    expect(Object.is(0 * 5, 0)).toBeTrue();
+    expect(65536 * 65536).toBe(4294967296);
+    expect(-2147483648 * -1).toBe(2147483648);
+    expect(2147483647 * 2147483647).toBe(4611686014132420609);
+});
+
+test("shifts use the low five bits of the shift count", () => {
+    expect(1 << 31).toBe(-2147483648);
+    expect(1 << 32).toBe(1);
+    expect(1 << -1).toBe(-2147483648);
+    expect(-8 >> 33).toBe(-4);
+    expect(-1 >>> 0).toBe(4294967295);
+    expect(-1 >>> 28).toBe(15);
+});
+
+test("strict equality between int32s and doubles", () => {
+    expect(1 === 1).toBeTrue();
+    expect(1 === 2).toBeFalse();
+    expect(1 === 1.5 - 0.5).toBeTrue();
+    expect(0 === -0).toBeTrue();
+});
+
+test("loop counters", () => {
+    let sum = 0;
+    for (let i = 0; i < 100; ++i) sum = (sum + i * i) | 0;
+    expect(sum).toBe(328350);
+
+    let counter = 2147483646;
+    counter++;
+    counter++;
+    expect(counter).toBe(2147483648);
+});
@@ -0,0 +1,92 @@
+test("reading the same property from objects of different shapes", () => {
+    const getX = o => o.x;
+    const objects = [{ x: 1 }, { a: 0, x: 2 }, { a: 0, b: 0, x: 3 }, { x: 4, y: 0 }, { y: 0, x: 5 }];
+    for (let i = 0; i < 3; ++i) {
+        objects.forEach((object, index) => {
+            expect(getX(object)).toBe(index + 1);
+        });
+    }
+});
+
+test("property turned into an accessor", () => {
+    const getX = o => o.x;
+    const object = { x: 1 };
+    expect(getX(object)).toBe(1);
+    expect(getX(object)).toBe(1);
+    Object.defineProperty(object, "x", { get: () => 2 });
+    expect(getX(object)).toBe(2);
+});
+
+test("property deleted and added back", () => {
+    const getX = o => o.x;
+    const object = { x: 1, y: 2 };
+    expect(getX(object)).toBe(1);
+    delete object.x;
+    expect(getX(object)).toBeUndefined();
+    object.x = 3;
+    expect(getX(object)).toBe(3);
+});
+
+test("property shadowed in the prototype chain", () => {
+    const getX = o => o.x;
+    const prototype = { x: "prototype" };
+    const object = Object.create(prototype);
+    expect(getX(object)).toBe("prototype");
+    object.x = "own";
+    expect(getX(object)).toBe("own");
+    expect(getX(prototype)).toBe("prototype");
+});
+
+test("writing the same property on objects of different shapes", () => {
+    const setX = (o, value) => {
+        o.x = value;
+    };
+    const objects = [{ x: 0 }, { a: 0, x: 0 }, { x: 0, b: 0 }];
+    for (let i = 0; i < 3; ++i) {
+        objects.forEach(object => setX(object, i));
+        objects.forEach(object => expect(object.x).toBe(i));
+    }
+});
+
+test("writing a property that became non-writable", () => {
+    const setX = (o, value) => {
+        o.x = value;
+    };
+    const object = { x: 0 };
+    setX(object, 1);
+    setX(object, 2);
+    expect(object.x).toBe(2);
+    Object.freeze(object);
+    setX(object, 3);
+    expect(object.x).toBe(2);
+});
+
+test("writing a property through a setter on the prototype", () => {
+    let setterValue;
+    const prototype = {
+        set x(value) {
+            setterValue = value;
+        },
+    };
+    const setX = (o, value) => {
+        o.x = value;
+    };
+    const plain = { x: 0 };
+    const inheriting = Object.create(prototype);
+    setX(plain, 1);
+    setX(inheriting, 2);
+    setX(plain, 3);
+    setX(inheriting, 4);
+    expect(plain.x).toBe(3);
+    expect(setterValue).toBe(4);
+    expect(Object.hasOwn(inheriting, "x")).toBeFalse();
+});
+
+test("proxies are never cached", () => {
+    const getX = o => o.x;
+    let count = 0;
+    const proxy = new Proxy({ x: 1 }, { get: () => ++count });
+    expect(getX({ x: 1 })).toBe(1);
+    expect(getX(proxy)).toBe(1);
+    expect(getX(proxy)).toBe(2);
+});
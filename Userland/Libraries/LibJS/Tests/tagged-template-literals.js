@@ -164,6 +164,14 @@ describe("tagged template literal functionality", () => {
         expect(firstResult).toBe(secondResult);
     });
 
+    test("string value is not shared between separately parsed code", () => {
+        const source = "(strings => strings)`template`";
+        const firstResult = eval(source);
+        const secondResult = eval(source);
+        expect(firstResult).not.toBe(secondResult);
+        expect(firstResult).toEqual(secondResult);
+    });
+
     test("this value of call comes from reference", () => {
         let thisValue = null;
         const obj = {
@@ -7,6 +7,7 @@
 #include <LibPDF/CommonNames.h>
 #include <LibPDF/Document.h>
 #include <LibPDF/Parser.h>
+#include <LibPDF/RenderCache.h>
 
 namespace PDF {
 
@@ -59,10 +60,13 @@ PDFErrorOr<NonnullRefPtr<Document>> Document::create(ReadonlyBytes bytes)
 
 Document::Document(NonnullRefPtr<DocumentParser> const& parser)
     : m_parser(parser)
+    , m_render_cache(make<RenderCache>())
 {
     m_parser->set_document(this);
 }
 
+Document::~Document() = default;
+
 PDFErrorOr<void> Document::initialize()
 {
     if (m_security_handler)
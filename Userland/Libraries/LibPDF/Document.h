@@ -8,6 +8,7 @@
 
 #include <AK/Format.h>
 #include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
 #include <AK/RefCounted.h>
 #include <AK/Weakable.h>
 #include <LibGfx/Color.h>
@@ -81,6 +82,7 @@ class Document final
     , public Weakable<Document> {
 public:
     static PDFErrorOr<NonnullRefPtr<Document>> create(ReadonlyBytes bytes);
+    ~Document();
 
     // If a security handler is present, it is the caller's responsibility to ensure
     // this document is unencrypted before calling this function. The user does not
@@ -124,6 +126,9 @@ public:
     /// dict is being read).
     bool can_resolve_refefences() { return m_parser->can_resolve_references(); }
 
+    // Used by Renderer to keep what it worked out about this document for the next time a page is rendered.
+    RenderCache& render_cache() { return *m_render_cache; }
+
 private:
     explicit Document(NonnullRefPtr<DocumentParser> const& parser);
 
@@ -157,6 +162,7 @@ private:
     HashMap<u32, Value> m_values;
     RefPtr<OutlineDict> m_outline;
     RefPtr<SecurityHandler> m_security_handler;
+    NonnullOwnPtr<RenderCache> m_render_cache;
 };
 
 }
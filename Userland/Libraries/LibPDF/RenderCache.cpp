@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BitCast.h>
+#include <LibGfx/Bitmap.h>
+#include <LibPDF/RenderCache.h>
+
+namespace PDF {
+
+RenderCache::~RenderCache() = default;
+
+Vector<Operator> const* RenderCache::operators(Object const& content) const
+{
+    auto it = m_operators.find(&content);
+    if (it == m_operators.end())
+        return nullptr;
+    return it->value.operators.ptr();
+}
+
+Vector<Operator> const& RenderCache::set_operators(NonnullRefPtr<Object> content, Vector<Operator> operators)
+{
+    auto const* key = content.ptr();
+    auto entry = OperatorsEntry { move(content), make<Vector<Operator>>(move(operators)) };
+    auto const& stored_operators = *entry.operators;
+    m_operators.set(key, move(entry));
+    return stored_operators;
+}
+
+RefPtr<Gfx::Bitmap> RenderCache::image(StreamObject const& stream) const
+{
+    auto it = m_images.find(&stream);
+    if (it == m_images.end())
+        return nullptr;
+    return it->value.bitmap;
+}
+
+void RenderCache::set_image(NonnullRefPtr<StreamObject> stream, NonnullRefPtr<Gfx::Bitmap> bitmap)
+{
+    auto size_in_bytes = bitmap->size_in_bytes();
+    if (size_in_bytes > max_image_size_in_bytes)
+        return;
+    if (m_image_size_in_bytes + size_in_bytes > max_image_size_in_bytes) {
+        m_images.clear();
+        m_image_size_in_bytes = 0;
+    }
+
+    auto const* key = stream.ptr();
+    if (auto it = m_images.find(key); it != m_images.end())
+        m_image_size_in_bytes -= it->value.bitmap->size_in_bytes();
+    m_images.set(key, ImageEntry { move(stream), move(bitmap) });
+    m_image_size_in_bytes += size_in_bytes;
+}
+
+RefPtr<PDFFont> RenderCache::font(DictObject const& dict, float font_size) const
+{
+    auto it = m_fonts.find(&dict);
+    if (it == m_fonts.end())
+        return nullptr;
+    return it->value.fonts_by_size.get(bit_cast<u32>(font_size)).value_or(nullptr);
+}
+
+void RenderCache::set_font(NonnullRefPtr<DictObject> dict, float font_size, NonnullRefPtr<PDFFont> font)
+{
+    auto const* key = dict.ptr();
+    auto& entry = m_fonts.ensure(key, [&] { return FontEntry { move(dict), {} }; });
+    entry.fonts_by_size.set(bit_cast<u32>(font_size), move(font));
+}
+
+}
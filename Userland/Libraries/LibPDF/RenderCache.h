@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/NonnullRefPtr.h>
+#include <LibGfx/Bitmap.h>
+#include <LibPDF/Fonts/PDFFont.h>
+#include <LibPDF/Operator.h>
+
+namespace PDF {
+
+// Whatever a Renderer works out from a document that doesn't depend on how the page is drawn: parsed content streams,
+// decoded images and loaded fonts. Rendering a page again (after zooming, or when scrolling back to it) picks these up
+// instead of parsing, decoding and loading everything all over again.
+class RenderCache {
+public:
+    RenderCache() = default;
+    ~RenderCache();
+
+    Vector<Operator> const* operators(Object const& content) const;
+    Vector<Operator> const& set_operators(NonnullRefPtr<Object> content, Vector<Operator>);
+
+    RefPtr<Gfx::Bitmap> image(StreamObject const&) const;
+    void set_image(NonnullRefPtr<StreamObject>, NonnullRefPtr<Gfx::Bitmap>);
+
+    RefPtr<PDFFont> font(DictObject const&, float font_size) const;
+    void set_font(NonnullRefPtr<DictObject>, float font_size, NonnullRefPtr<PDFFont>);
+
+private:
+    // Decoded images can be big, so they're dropped once there are too many of them.
+    static constexpr size_t max_image_size_in_bytes = 64 * MiB;
+
+    // The entries keep the objects they belong to alive, so their addresses can't be reused for something else.
+    struct OperatorsEntry {
+        NonnullRefPtr<Object> content;
+        // The operators stay where they are while more of them are added, as rendering a page may render forms, too.
+        NonnullOwnPtr<Vector<Operator>> operators;
+    };
+
+    struct ImageEntry {
+        NonnullRefPtr<StreamObject> stream;
+        NonnullRefPtr<Gfx::Bitmap> bitmap;
+    };
+
+    struct FontEntry {
+        NonnullRefPtr<DictObject> dict;
+        // Fonts are loaded for a specific size, which is keyed by the bits of the float.
+        HashMap<u32, NonnullRefPtr<PDFFont>> fonts_by_size;
+    };
+
+    HashMap<Object const*, OperatorsEntry> m_operators;
+    HashMap<StreamObject const*, ImageEntry> m_images;
+    size_t m_image_size_in_bytes { 0 };
+    HashMap<DictObject const*, FontEntry> m_fonts;
+};
+
+}
@@ -8,6 +8,7 @@
 #include <LibPDF/CommonNames.h>
 #include <LibPDF/Fonts/PDFFont.h>
 #include <LibPDF/Interpolation.h>
+#include <LibPDF/RenderCache.h>
 #include <LibPDF/Renderer.h>
 
 #define RENDERER_HANDLER(name) \
@@ -83,8 +84,11 @@ Renderer::Renderer(RefPtr<Document> document, Page const& page, RefPtr<Gfx::Bitm
     m_bitmap->fill(Gfx::Color::NamedColor::White);
 }
 
-PDFErrorsOr<void> Renderer::render()
+PDFErrorOr<Vector<Operator> const*> Renderer::parse_page_operators()
 {
+    if (auto const* operators = m_document->render_cache().operators(*m_page.contents))
+        return operators;
+
     // Use our own vector, as the /Content can be an array with multiple
     // streams which gets concatenated
     // FIXME: Text operators are supposed to only have effects on the current
@@ -104,6 +108,12 @@ PDFErrorsOr<void> Renderer::render()
     }
 
     auto operators = TRY(Parser::parse_operators(m_document, byte_buffer));
+    return &m_document->render_cache().set_operators(m_page.contents, move(operators));
+}
+
+PDFErrorsOr<void> Renderer::render()
+{
+    auto const& operators = *TRY(parse_page_operators());
 
     Errors errors;
     for (auto& op : operators) {
@@ -424,7 +434,11 @@ RENDERER_HANDLER(text_set_font)
 
     auto& text_rendering_matrix = calculate_text_rendering_matrix();
     auto font_size = text_rendering_matrix.x_scale() * text_state().font_size;
-    auto font = TRY(PDFFont::create(m_document, font_dictionary, font_size));
+    auto font = m_document->render_cache().font(*font_dictionary, font_size);
+    if (!font) {
+        font = TRY(PDFFont::create(m_document, font_dictionary, font_size));
+        m_document->render_cache().set_font(font_dictionary, font_size, *font);
+    }
     text_state().font = font;
 
     m_text_rendering_matrix_is_dirty = true;
@@ -641,8 +655,10 @@ RENDERER_HANDLER(paint_xobject)
         matrix = Vector { Value { 1 }, Value { 0 }, Value { 0 }, Value { 1 }, Value { 0 }, Value { 0 } };
     }
     MUST(handle_concatenate_matrix(matrix));
-    auto operators = TRY(Parser::parse_operators(m_document, xobject->bytes()));
-    for (auto& op : operators)
+    auto const* operators = m_document->render_cache().operators(*xobject);
+    if (!operators)
+        operators = &m_document->render_cache().set_operators(xobject, TRY(Parser::parse_operators(m_document, xobject->bytes())));
+    for (auto& op : *operators)
         TRY(handle_operator(op, xobject_resources));
     MUST(handle_restore_state({}));
     return {};
@@ -850,6 +866,19 @@ PDFErrorOr<void> Renderer::show_image(NonnullRefPtr<StreamObject> image)
         show_empty_image(width, height);
         return {};
     }
+    auto image_bitmap = TRY(load_image_with_soft_mask(image));
+    auto image_space = calculate_image_space_transformation(width, height);
+    auto image_rect = Gfx::FloatRect { 0, 0, width, height };
+    m_painter.draw_scaled_bitmap_with_transform(image_bitmap->rect(), image_bitmap, image_rect, image_space);
+    return {};
+}
+
+PDFErrorOr<NonnullRefPtr<Gfx::Bitmap>> Renderer::load_image_with_soft_mask(NonnullRefPtr<StreamObject> image)
+{
+    if (auto cached_bitmap = m_document->render_cache().image(*image))
+        return cached_bitmap.release_nonnull();
+
+    auto image_dict = image->dict();
     auto image_bitmap = TRY(load_image(image));
     if (image_dict->contains(CommonNames::SMask)) {
         auto smask_bitmap = TRY(load_image(TRY(image_dict->get_stream(m_document, CommonNames::SMask))));
@@ -864,10 +893,8 @@ PDFErrorOr<void> Renderer::show_image(NonnullRefPtr<StreamObject> image)
         }
     }
 
-    auto image_space = calculate_image_space_transformation(width, height);
-    auto image_rect = Gfx::FloatRect { 0, 0, width, height };
-    m_painter.draw_scaled_bitmap_with_transform(image_bitmap->rect(), image_bitmap, image_rect, image_space);
-    return {};
+    m_document->render_cache().set_image(image, image_bitmap);
+    return image_bitmap;
 }
 
 PDFErrorOr<NonnullRefPtr<ColorSpace>> Renderer::get_color_space_from_resources(Value const& value, NonnullRefPtr<DictObject> resources)
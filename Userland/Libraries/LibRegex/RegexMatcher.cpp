@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BinarySearch.h>
 #include <AK/BumpAllocator.h>
 #include <AK/Debug.h>
 #include <AK/DeprecatedString.h>
@@ -185,6 +186,15 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
 
     auto single_match_only = input.regex_options.has_flag_set(AllFlags::SingleMatch);
 
+    auto const& optimization_data = m_pattern->parser_result.optimization_data;
+    auto only_start_of_line = optimization_data.only_start_of_line
+        && !input.regex_options.has_flag_set(AllFlags::Multiline)
+        && !input.regex_options.has_flag_set(AllFlags::MatchNotBeginOfLine);
+    // Case-insensitive and Unicode-aware comparisons don't map cleanly onto the starting ranges, so only use them for exact matching.
+    auto starting_ranges = input.regex_options.has_flag_set(AllFlags::Insensitive) || unicode
+        ? ReadonlySpan<CharRange> {}
+        : optimization_data.starting_ranges.span();
+
     for (auto const& view : views) {
         if (lines_to_skip != 0) {
             ++input.line;
@@ -245,6 +255,31 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             if (match_length_minimum && match_length_minimum > view_length - view_index)
                 break;
 
+            // A pattern anchored to the start of the input can't match anywhere else.
+            if (only_start_of_line && view_index != 0)
+                break;
+
+            // Skip positions that can't start a match without spinning up the VM.
+            if (!starting_ranges.is_empty()) {
+                auto can_start_match = [&] {
+                    if (view_index >= view_length)
+                        return false;
+                    auto ch = input.view.substring_view(view_index, 1)[0];
+                    return binary_search(starting_ranges, ch, nullptr, [](auto needle, CharRange range) {
+                        if (needle < range.from)
+                            return -1;
+                        if (needle > range.to)
+                            return 1;
+                        return 0;
+                    }) != nullptr;
+                }();
+                if (!can_start_match) {
+                    if (!continue_search)
+                        break;
+                    continue;
+                }
+            }
+
             input.column = match_count;
             input.match_index = match_count;
 
@@ -426,6 +461,12 @@ bool Matcher<Parser>::execute(MatchInput const& input, MatchState& state, size_t
 
     auto& bytecode = m_pattern->parser_result.bytecode;
 
+    // If a fork has already been taken at the same string position, everything it can lead to has either been tried
+    // and failed, or is still queued up; so there's no need to go down that road again. This keeps patterns like
+    // /(a+)+b/ from going exponential.
+    auto memoize_forks = m_pattern->parser_result.optimization_data.can_memoize_forks;
+    m_visited_forks.clear_with_capacity();
+
     for (;;) {
         auto& opcode = bytecode.get_opcode(state);
         ++operations;
@@ -448,6 +489,13 @@ bool Matcher<Parser>::execute(MatchInput const& input, MatchState& state, size_t
 
         state.instruction_position += opcode.size();
 
+        // Forks that replace an earlier one implement atomic groups, and depend on what's on the backtracking stack.
+        if (memoize_forks && (result == ExecutionResult::Fork_PrioLow || result == ExecutionResult::Fork_PrioHigh) && !input.fork_to_replace.has_value()) {
+            u64 fork_key = (static_cast<u64>(state.instruction_position - opcode.size()) << 32) | static_cast<u32>(state.string_position);
+            if (m_visited_forks.set(fork_key) != HashSetResult::InsertedNewEntry)
+                result = ExecutionResult::Failed_ExecuteLowPrioForks;
+        }
+
         switch (result) {
         case ExecutionResult::Fork_PrioLow: {
             bool found = false;
@@ -14,6 +14,7 @@
 #include <AK/Forward.h>
 #include <AK/GenericLexer.h>
 #include <AK/HashMap.h>
+#include <AK/HashTable.h>
 #include <AK/NonnullOwnPtrVector.h>
 #include <AK/Types.h>
 #include <AK/Utf32View.h>
@@ -78,6 +79,10 @@ private:
 
     Regex<Parser> const* m_pattern;
     typename ParserTraits<Parser>::OptionsType const m_regex_options;
+
+    // (instruction position, string position) pairs of forks already explored by the current execute() call.
+    // Kept around between calls so its storage can be reused.
+    mutable HashTable<u64> m_visited_forks;
 };
 
 template<class Parser>
@@ -232,6 +237,7 @@ public:
 private:
     void run_optimization_passes();
     void attempt_rewrite_loops_as_atomic_groups(BasicBlockList const&);
+    void fill_optimization_data();
 };
 
 // free standing functions for match, search and has_match
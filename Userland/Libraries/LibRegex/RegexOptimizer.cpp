@@ -29,6 +29,117 @@ void Regex<Parser>::run_optimization_passes()
     attempt_rewrite_loops_as_atomic_groups(split_basic_blocks(parser_result.bytecode));
 
     parser_result.bytecode.flatten();
+
+    fill_optimization_data();
+}
+
+static bool can_memoize_forks(ByteCode const& bytecode)
+{
+    MatchState state;
+    state.instruction_position = 0;
+    auto bytecode_size = bytecode.size();
+    while (state.instruction_position < bytecode_size) {
+        auto& opcode = bytecode.get_opcode(state);
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Repeat:
+        case OpCodeId::ResetRepeat:
+        case OpCodeId::Save:
+        case OpCodeId::Restore:
+        case OpCodeId::GoBack:
+        case OpCodeId::FailForks:
+            return false;
+        case OpCodeId::Compare:
+            for (auto& pair : static_cast<OpCode_Compare const&>(opcode).flat_compares()) {
+                if (pair.type == CharacterCompareType::Reference)
+                    return false;
+            }
+            break;
+        default:
+            break;
+        }
+        state.instruction_position += opcode.size();
+    }
+    return true;
+}
+
+template<typename Parser>
+void Regex<Parser>::fill_optimization_data()
+{
+    auto& bytecode = parser_result.bytecode;
+    auto& optimization_data = parser_result.optimization_data;
+    optimization_data = {};
+
+    if (parser_result.error != Error::NoError || bytecode.is_empty())
+        return;
+
+    optimization_data.can_memoize_forks = can_memoize_forks(bytecode);
+
+    // Walk the straight-line prefix of the program (i.e. everything before the first fork or jump) to find
+    // the first thing that must be consumed, so the matcher can skip start positions that can never match.
+    MatchState state;
+    state.instruction_position = 0;
+    auto bytecode_size = bytecode.size();
+    while (state.instruction_position < bytecode_size) {
+        auto& opcode = bytecode.get_opcode(state);
+        switch (opcode.opcode_id()) {
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+            state.instruction_position += opcode.size();
+            continue;
+        case OpCodeId::CheckBegin:
+            optimization_data.only_start_of_line = true;
+            state.instruction_position += opcode.size();
+            continue;
+        case OpCodeId::Compare: {
+            auto& compare = static_cast<OpCode_Compare const&>(opcode);
+            auto compares = compare.flat_compares();
+            if (compares.is_empty())
+                return;
+
+            Vector<ByteCodeValueType> ranges;
+            for (auto& pair : compares) {
+                switch (pair.type) {
+                case CharacterCompareType::Char:
+                    ranges.append(CharRange { static_cast<u32>(pair.value), static_cast<u32>(pair.value) });
+                    break;
+                case CharacterCompareType::CharRange:
+                    ranges.append(pair.value);
+                    break;
+                case CharacterCompareType::String:
+                    // Only the first code point of a lone (non-empty) string is known to be consumed first.
+                    if (compare.arguments_count() != 1)
+                        return;
+                    ranges.append(CharRange { static_cast<u32>(pair.value), static_cast<u32>(pair.value) });
+                    break;
+                default:
+                    // Anything else (classes, inversions, properties, backreferences, ...) is not worth modelling here.
+                    return;
+                }
+
+                // The different compare types don't agree on how to read a non-ASCII character out of the input
+                // (code points vs. code units), so stick to ASCII where they're all equivalent.
+                if (CharRange { ranges.last() }.to >= 0x80)
+                    return;
+            }
+
+            // CharRange packs `from` into the high bits, so sorting the raw values sorts the ranges by their start.
+            quick_sort(ranges);
+            for (auto value : ranges) {
+                CharRange range { value };
+                if (!optimization_data.starting_ranges.is_empty() && range.from <= optimization_data.starting_ranges.last().to + 1) {
+                    auto last = optimization_data.starting_ranges.take_last();
+                    optimization_data.starting_ranges.append({ last.from, max(last.to, range.to) });
+                    continue;
+                }
+                optimization_data.starting_ranges.append(range);
+            }
+            return;
+        }
+        default:
+            return;
+        }
+    }
 }
 
 template<typename Parser>
@@ -55,6 +55,16 @@ public:
         Token error_token;
         Vector<DeprecatedFlyString> capture_groups;
         AllOptions options;
+
+        struct OptimizationData {
+            // Sorted, non-overlapping ranges of the code points any match must start with (empty if unknown).
+            Vector<CharRange> starting_ranges;
+            // Whether the pattern begins with a '^' anchor, so it can only match at the start of the input.
+            bool only_start_of_line { false };
+            // Whether the outcome of a fork only depends on the instruction and string positions it was taken at,
+            // i.e. the pattern has no backreferences, lookarounds or counted repetitions.
+            bool can_memoize_forks { false };
+        } optimization_data {};
     };
 
     explicit Parser(Lexer& lexer)
@@ -22,8 +22,8 @@ ResultOr<ResultSet> Insert::execute(ExecutionContext& context) const
             return Result { SQLCommand::Insert, SQLErrorCode::ColumnDoesNotExist, column };
     }
 
-    ResultSet result { SQLCommand::Insert };
-    TRY(result.try_ensure_capacity(m_chained_expressions.size()));
+    Vector<Row> inserted_rows;
+    TRY(inserted_rows.try_ensure_capacity(m_chained_expressions.size()));
 
     for (auto& row_expr : m_chained_expressions) {
         for (auto& column_def : table_def->columns()) {
@@ -51,10 +51,17 @@ ResultOr<ResultSet> Insert::execute(ExecutionContext& context) const
             row[element_index] = move(values[ix]);
         }
 
-        TRY(context.database->insert(row));
-        result.insert_row(row, {});
+        inserted_rows.unchecked_append(row);
     }
 
+    // All rows are validated before any of them is inserted, and then they're inserted in one go.
+    TRY(context.database->insert(inserted_rows.span()));
+
+    ResultSet result { SQLCommand::Insert };
+    TRY(result.try_ensure_capacity(inserted_rows.size()));
+    for (auto& row : inserted_rows)
+        result.insert_row(row, {});
+
     return result;
 }
 
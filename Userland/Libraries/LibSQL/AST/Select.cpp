@@ -37,6 +37,82 @@ static DeprecatedString result_column_name(ResultColumn const& column, size_t co
     return fallback_column_name();
 }
 
+// Splits the WHERE clause into the conditions that are ANDed together.
+static void collect_conditions(Expression const& expression, Vector<Expression const*>& conditions)
+{
+    // The parser gives all binary operators the same precedence, so conditions are usually parenthesized.
+    if (is<ChainedExpression>(expression)) {
+        auto const& chained_expression = static_cast<ChainedExpression const&>(expression);
+        if (chained_expression.expressions().size() == 1 && is<BinaryOperatorExpression>(chained_expression.expressions()[0])) {
+            collect_conditions(chained_expression.expressions()[0], conditions);
+            return;
+        }
+    }
+
+    if (is<BinaryOperatorExpression>(expression)) {
+        auto const& binary_expression = static_cast<BinaryOperatorExpression const&>(expression);
+        if (binary_expression.type() == BinaryOperator::And) {
+            collect_conditions(*binary_expression.lhs(), conditions);
+            collect_conditions(*binary_expression.rhs(), conditions);
+            return;
+        }
+    }
+    conditions.append(&expression);
+}
+
+// Whether every column the expression refers to is in the descriptor. Expressions that aren't understood here are
+// simply evaluated once all tables are joined.
+static bool can_evaluate_with(Expression const& expression, TupleDescriptor const& descriptor)
+{
+    if (is<NumericLiteral>(expression) || is<StringLiteral>(expression) || is<BlobLiteral>(expression)
+        || is<BooleanLiteral>(expression) || is<NullLiteral>(expression) || is<Placeholder>(expression))
+        return true;
+
+    if (is<ColumnNameExpression>(expression)) {
+        auto const& column_name_expression = static_cast<ColumnNameExpression const&>(expression);
+        size_t match_count = 0;
+        for (auto const& column_descriptor : descriptor) {
+            if (!column_name_expression.table_name().is_empty() && column_descriptor.table != column_name_expression.table_name())
+                continue;
+            if (column_descriptor.name == column_name_expression.column_name())
+                ++match_count;
+        }
+        return match_count == 1;
+    }
+
+    if (is<UnaryOperatorExpression>(expression) || is<NullExpression>(expression))
+        return can_evaluate_with(*static_cast<NestedExpression const&>(expression).expression(), descriptor);
+
+    if (is<BinaryOperatorExpression>(expression) || is<IsExpression>(expression)) {
+        auto const& nested_expression = static_cast<NestedDoubleExpression const&>(expression);
+        return can_evaluate_with(*nested_expression.lhs(), descriptor) && can_evaluate_with(*nested_expression.rhs(), descriptor);
+    }
+
+    if (is<BetweenExpression>(expression)) {
+        auto const& between_expression = static_cast<BetweenExpression const&>(expression);
+        return can_evaluate_with(*between_expression.expression(), descriptor)
+            && can_evaluate_with(*between_expression.lhs(), descriptor)
+            && can_evaluate_with(*between_expression.rhs(), descriptor);
+    }
+
+    if (is<MatchExpression>(expression)) {
+        auto const& match_expression = static_cast<MatchExpression const&>(expression);
+        if (match_expression.escape() && !can_evaluate_with(*match_expression.escape(), descriptor))
+            return false;
+        return can_evaluate_with(*match_expression.lhs(), descriptor) && can_evaluate_with(*match_expression.rhs(), descriptor);
+    }
+
+    if (is<ChainedExpression>(expression)) {
+        for (auto const& nested_expression : static_cast<ChainedExpression const&>(expression).expressions()) {
+            if (!can_evaluate_with(nested_expression, descriptor))
+                return false;
+        }
+        return true;
+    }
+
+    return false;
+}
+
 ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
 {
     NonnullRefPtrVector<ResultColumn const> columns;
@@ -85,6 +161,61 @@ ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
 
     ResultSet result { SQLCommand::Select, move(column_names) };
 
+    bool has_ordering { false };
+    auto sort_descriptor = adopt_ref(*new TupleDescriptor);
+    for (auto& term : m_ordering_term_list) {
+        sort_descriptor->append(TupleElementDescriptor { .order = term.order() });
+        has_ordering = true;
+    }
+    Tuple sort_key(sort_descriptor);
+
+    size_t limit_value = NumericLimits<size_t>::max();
+    size_t offset_value = 0;
+
+    if (m_limit_clause != nullptr) {
+        auto limit = TRY(m_limit_clause->limit_expression()->evaluate(context));
+        if (!limit.is_null()) {
+            auto limit_value_maybe = limit.to_int<size_t>();
+            if (!limit_value_maybe.has_value())
+                return Result { SQLCommand::Select, SQLErrorCode::SyntaxError, "LIMIT clause must evaluate to an integer value"sv };
+
+            limit_value = limit_value_maybe.value();
+        }
+
+        if (m_limit_clause->offset_expression() != nullptr) {
+            auto offset = TRY(m_limit_clause->offset_expression()->evaluate(context));
+            if (!offset.is_null()) {
+                auto offset_value_maybe = offset.to_int<size_t>();
+                if (!offset_value_maybe.has_value())
+                    return Result { SQLCommand::Select, SQLErrorCode::SyntaxError, "OFFSET clause must evaluate to an integer value"sv };
+
+                offset_value = offset_value_maybe.value();
+            }
+        }
+    }
+
+    // Without an ORDER BY clause, the rows after the ones the LIMIT clause keeps are never looked at.
+    Optional<size_t> maximum_row_count;
+    if (!has_ordering && limit_value != NumericLimits<size_t>::max())
+        maximum_row_count = offset_value + limit_value;
+
+    Vector<Expression const*> remaining_conditions;
+    if (where_clause())
+        collect_conditions(*where_clause(), remaining_conditions);
+
+    auto is_conjunction = remaining_conditions.size() > 1;
+    auto row_matches = [&](Vector<Expression const*> const& conditions) -> ResultOr<bool> {
+        for (auto const* condition : conditions) {
+            auto condition_result = TRY(condition->evaluate(context)).to_bool();
+            // A NULL operand of AND is an error, while a NULL WHERE clause just doesn't match.
+            if (!condition_result.has_value() && is_conjunction)
+                return Result { SQLCommand::Unknown, SQLErrorCode::BooleanOperatorTypeMismatch, BinaryOperator_name(BinaryOperator::And) };
+            if (!condition_result.has_value() || !condition_result.value())
+                return false;
+        }
+        return true;
+    };
+
     auto descriptor = adopt_ref(*new TupleDescriptor);
     Tuple tuple(descriptor);
     Vector<Tuple> rows;
@@ -92,7 +223,9 @@ ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
     tuple.append(Value { true });
     rows.append(tuple);
 
-    for (auto& table_descriptor : table_or_subquery_list()) {
+    auto const& tables = table_or_subquery_list();
+    for (size_t table_index = 0; table_index < tables.size(); ++table_index) {
+        auto const& table_descriptor = tables[table_index];
         if (!table_descriptor.is_table())
             return Result { SQLCommand::Select, SQLErrorCode::NotYetImplemented, "Sub-selects are not yet implemented"sv };
 
@@ -100,37 +233,49 @@ ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
         if (table_def->num_columns() == 0)
             continue;
 
-        auto old_descriptor_size = descriptor->size();
         descriptor->extend(table_def->to_tuple_descriptor());
 
-        while (!rows.is_empty() && (rows.first().size() == old_descriptor_size)) {
-            auto cartesian_row = rows.take_first();
-            auto table_rows = TRY(context.database->select_all(*table_def));
+        // The conditions that only refer to the tables joined so far are checked right away, so the rows they reject
+        // are never joined with the rows of the tables that come after.
+        Vector<Expression const*> conditions;
+        remaining_conditions.remove_all_matching([&](auto const* condition) {
+            if (!can_evaluate_with(*condition, *descriptor))
+                return false;
+            conditions.append(condition);
+            return true;
+        });
 
+        Optional<size_t> maximum_joined_row_count;
+        if (table_index == tables.size() - 1 && remaining_conditions.is_empty())
+            maximum_joined_row_count = maximum_row_count;
+
+        auto table_rows = TRY(context.database->select_all(*table_def));
+        Vector<Tuple> joined_rows;
+
+        for (auto const& row : rows) {
             for (auto& table_row : table_rows) {
-                auto new_row = cartesian_row;
-                new_row.extend(table_row);
-                rows.append(new_row);
+                if (maximum_joined_row_count.has_value() && joined_rows.size() >= *maximum_joined_row_count)
+                    break;
+
+                auto joined_row = row;
+                joined_row.extend(table_row);
+
+                context.current_row = &joined_row;
+                if (TRY(row_matches(conditions)))
+                    joined_rows.append(move(joined_row));
             }
         }
-    }
 
-    bool has_ordering { false };
-    auto sort_descriptor = adopt_ref(*new TupleDescriptor);
-    for (auto& term : m_ordering_term_list) {
-        sort_descriptor->append(TupleElementDescriptor { .order = term.order() });
-        has_ordering = true;
+        rows = move(joined_rows);
     }
-    Tuple sort_key(sort_descriptor);
 
     for (auto& row : rows) {
-        context.current_row = &row;
+        if (maximum_row_count.has_value() && result.size() >= *maximum_row_count)
+            break;
 
-        if (where_clause()) {
-            auto where_result = TRY(where_clause()->evaluate(context)).to_bool();
-            if (!where_result.has_value() || !where_result.value())
-                continue;
-        }
+        context.current_row = &row;
+        if (!TRY(row_matches(remaining_conditions)))
+            continue;
 
         tuple.clear();
 
@@ -150,32 +295,8 @@ ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
         result.insert_row(tuple, sort_key);
     }
 
-    if (m_limit_clause != nullptr) {
-        size_t limit_value = NumericLimits<size_t>::max();
-        size_t offset_value = 0;
-
-        auto limit = TRY(m_limit_clause->limit_expression()->evaluate(context));
-        if (!limit.is_null()) {
-            auto limit_value_maybe = limit.to_int<size_t>();
-            if (!limit_value_maybe.has_value())
-                return Result { SQLCommand::Select, SQLErrorCode::SyntaxError, "LIMIT clause must evaluate to an integer value"sv };
-
-            limit_value = limit_value_maybe.value();
-        }
-
-        if (m_limit_clause->offset_expression() != nullptr) {
-            auto offset = TRY(m_limit_clause->offset_expression()->evaluate(context));
-            if (!offset.is_null()) {
-                auto offset_value_maybe = offset.to_int<size_t>();
-                if (!offset_value_maybe.has_value())
-                    return Result { SQLCommand::Select, SQLErrorCode::SyntaxError, "OFFSET clause must evaluate to an integer value"sv };
-
-                offset_value = offset_value_maybe.value();
-            }
-        }
-
+    if (m_limit_clause != nullptr)
         result.limit(offset_value, limit_value);
-    }
 
     return result;
 }
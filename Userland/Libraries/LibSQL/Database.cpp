@@ -78,7 +78,10 @@ Database::~Database() = default;
 ErrorOr<void> Database::commit()
 {
     VERIFY(is_open());
-    TRY(m_heap->flush());
+    if (m_group_commit)
+        TRY(m_heap->commit());
+    else
+        TRY(m_heap->flush());
     return {};
 }
 
@@ -198,19 +201,36 @@ ErrorOr<Vector<Row>> Database::match(TableDef& table, Key const& key)
 
 ErrorOr<void> Database::insert(Row& row)
 {
-    VERIFY(m_table_cache.get(row.table().key().hash()).has_value());
-    // TODO Check constraints
+    return insert(Span<Row> { &row, 1 });
+}
+
+// The rows are linked into the front of the table's list of rows together, so the table's entry in the tables BTree
+// only has to be updated once for all of them.
+ErrorOr<void> Database::insert(Span<Row> rows)
+{
+    if (rows.is_empty())
+        return {};
 
-    row.set_pointer(m_heap->new_record_pointer());
-    row.set_next_pointer(row.table().pointer());
-    TRY(update(row));
+    auto& table = rows.first().table();
+    VERIFY(m_table_cache.get(table.key().hash()).has_value());
+
+    auto next_pointer = table.pointer();
+    for (auto& row : rows) {
+        VERIFY(&row.table() == &table);
+        // TODO Check constraints
+
+        row.set_pointer(m_heap->new_record_pointer());
+        row.set_next_pointer(next_pointer);
+        TRY(update(row));
+        next_pointer = row.pointer();
+    }
 
     // TODO update indexes defined on table.
 
-    auto table_key = row.table().key();
-    table_key.set_pointer(row.pointer());
+    auto table_key = table.key();
+    table_key.set_pointer(next_pointer);
     VERIFY(m_tables->update_key_pointer(table_key));
-    row.table().set_pointer(row.pointer());
+    table.set_pointer(next_pointer);
     return {};
 }
 
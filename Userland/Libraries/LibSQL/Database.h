@@ -33,6 +33,10 @@ public:
     bool is_open() const { return m_open; }
     ErrorOr<void> commit();
 
+    // With group commit, commit() doesn't wait for the changes to reach the disk, and sync() reports when they have.
+    void set_group_commit(bool group_commit) { m_group_commit = group_commit; }
+    void sync(Function<void(ErrorOr<void>)> on_durable) { m_heap->sync(move(on_durable)); }
+
     ResultOr<void> add_schema(SchemaDef const&);
     static Key get_schema_key(DeprecatedString const&);
     ResultOr<NonnullRefPtr<SchemaDef>> get_schema(DeprecatedString const&);
@@ -44,6 +48,7 @@ public:
     ErrorOr<Vector<Row>> select_all(TableDef&);
     ErrorOr<Vector<Row>> match(TableDef&, Key const&);
     ErrorOr<void> insert(Row&);
+    ErrorOr<void> insert(Span<Row>);
     ErrorOr<void> remove(Row&);
     ErrorOr<void> update(Row&);
 
@@ -51,6 +56,7 @@ private:
     explicit Database(DeprecatedString);
 
     bool m_open { false };
+    bool m_group_commit { false };
     NonnullRefPtr<Heap> m_heap;
     Serializer m_serializer;
     RefPtr<BTree> m_schemas;
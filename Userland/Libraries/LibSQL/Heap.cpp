@@ -9,6 +9,7 @@
 #include <AK/QuickSort.h>
 #include <LibCore/IODevice.h>
 #include <LibCore/System.h>
+#include <LibCrypto/Checksum/CRC32.h>
 #include <LibSQL/Heap.h>
 #include <LibSQL/Serializer.h>
 #include <sys/stat.h>
@@ -23,8 +24,8 @@ Heap::Heap(DeprecatedString file_name)
 
 Heap::~Heap()
 {
-    if (m_file && !m_write_ahead_log.is_empty()) {
-        if (auto maybe_error = flush(); maybe_error.is_error())
+    if (m_file && m_log) {
+        if (auto maybe_error = close_log(); maybe_error.is_error())
             warnln("~Heap({}): {}", name(), maybe_error.error());
     }
 }
@@ -44,15 +45,31 @@ ErrorOr<void> Heap::open()
     } else {
         file_size = stat_buffer.st_size;
     }
-    if (file_size > 0)
-        m_next_block = m_end_of_file = file_size / BLOCKSIZE;
+    m_next_block = m_end_of_file = file_size / BLOCKSIZE;
 
-    auto file = TRY(Core::File::open(name(), Core::File::OpenMode::ReadWrite));
-    m_file = TRY(Core::BufferedFile::create(move(file)));
+    m_file = TRY(Core::File::open(name(), Core::File::OpenMode::ReadWrite));
+    if (auto log_or_error = Core::File::open(log_file_name(), Core::File::OpenMode::ReadWrite); log_or_error.is_error()) {
+        m_file = nullptr;
+        return log_or_error.release_error();
+    } else {
+        m_log = log_or_error.release_value();
+    }
+
+    if (auto error_maybe = recover_from_log(); error_maybe.is_error()) {
+        m_file = nullptr;
+        m_log = nullptr;
+        clear_cache();
+        return error_maybe.release_error();
+    }
 
-    if (file_size > 0) {
+    if (m_end_of_file > 0) {
         if (auto error_maybe = read_zero_block(); error_maybe.is_error()) {
+            // The log was emptied by the recovery, so it can go. Otherwise every file that fails to open as a heap
+            // would leave one behind.
             m_file = nullptr;
+            m_log = nullptr;
+            clear_cache();
+            (void)Core::System::unlink(log_file_name());
             return error_maybe.release_error();
         }
     } else {
@@ -63,8 +80,11 @@ ErrorOr<void> Heap::open()
     if (m_version != current_version) {
         dbgln_if(SQL_DEBUG, "Heap file {} opened has incompatible version {}. Deleting for version {}.", name(), m_version, current_version);
         m_file = nullptr;
+        m_log = nullptr;
+        clear_cache();
 
         TRY(Core::System::unlink(name()));
+        TRY(Core::System::unlink(log_file_name()));
         return open();
     }
 
@@ -79,26 +99,345 @@ ErrorOr<ByteBuffer> Heap::read_block(u32 block)
         return Error::from_string_literal("Heap()::read_block(): Heap file not opened");
     }
 
-    if (auto buffer = m_write_ahead_log.get(block); buffer.has_value())
-        return TRY(ByteBuffer::copy(*buffer));
+    if (auto it = m_cached_blocks.find(block); it != m_cached_blocks.end()) {
+        it->value.was_referenced = true;
+        return TRY(ByteBuffer::copy(it->value.buffer));
+    }
 
     if (block >= m_next_block) {
         warnln("Heap({})::read_block({}): block # out of range (>= {})"sv, name(), block, m_next_block);
         return Error::from_string_literal("Heap()::read_block(): block # out of range");
     }
 
-    dbgln_if(SQL_DEBUG, "Read heap block {}", block);
-    TRY(seek_block(block));
+    ByteBuffer buffer;
+    if (auto offset = m_logged_blocks.get(block); offset.has_value()) {
+        dbgln_if(SQL_DEBUG, "Read heap block {} from the log", block);
+        buffer = TRY(read_from_log(*offset));
+    } else {
+        dbgln_if(SQL_DEBUG, "Read heap block {}", block);
+        TRY(seek_block(block));
 
-    auto buffer = TRY(ByteBuffer::create_uninitialized(BLOCKSIZE));
-    auto bytes = TRY(m_file->read(buffer));
+        buffer = TRY(ByteBuffer::create_uninitialized(BLOCKSIZE));
+        auto bytes = TRY(m_file->read(buffer));
+
+        dbgln_if(SQL_DEBUG, "{:hex-dump}", bytes.trim(8));
+        TRY(buffer.try_resize(bytes.size()));
+    }
+
+    cache_block(block, TRY(ByteBuffer::copy(buffer)), false);
+    return buffer;
+}
+
+void Heap::add_to_wal(u32 block, ByteBuffer& buffer)
+{
+    dbgln_if(SQL_DEBUG, "Adding to WAL: block #{}, size {}", block, buffer.size());
+    dbgln_if(SQL_DEBUG, "{:hex-dump}", buffer.bytes().trim(8));
+
+    if (auto it = m_cached_blocks.find(block); it != m_cached_blocks.end()) {
+        auto& cached_block = it->value;
+        if (!cached_block.is_dirty) {
+            cached_block.is_dirty = true;
+            ++m_dirty_block_count;
+        }
+        cached_block.buffer = buffer;
+        cached_block.was_referenced = true;
+    } else {
+        cache_block(block, buffer, true);
+    }
+
+    if (m_dirty_block_count > maximum_dirty_blocks) {
+        // The next commit record will cover these blocks. If the heap is closed without one, they are discarded.
+        if (auto maybe_error = append_to_log(sorted_dirty_blocks(), false); maybe_error.is_error())
+            warnln("Heap({})::add_to_wal({}): {}", name(), block, maybe_error.error());
+    }
+}
+
+void Heap::cache_block(u32 block, ByteBuffer buffer, bool is_dirty)
+{
+    if (m_clock.size() < maximum_cached_blocks)
+        m_clock.append(block);
+    else
+        evict_clean_block(block);
+
+    if (is_dirty)
+        ++m_dirty_block_count;
+    m_cached_blocks.set(block, { move(buffer), is_dirty, true });
+}
+
+// CLOCK eviction: the hand clears the reference bit of the blocks it passes, and evicts the first clean block that
+// was not read or written since the hand last came by. The replacement block takes its place on the clock.
+void Heap::evict_clean_block(u32 replacement)
+{
+    for (size_t i = 0; i < 2 * m_clock.size(); ++i) {
+        auto& candidate = m_clock[m_clock_hand];
+        m_clock_hand = (m_clock_hand + 1) % m_clock.size();
+
+        auto& cached_block = m_cached_blocks.find(candidate)->value;
+        if (cached_block.is_dirty)
+            continue;
+        if (cached_block.was_referenced) {
+            cached_block.was_referenced = false;
+            continue;
+        }
+
+        dbgln_if(SQL_DEBUG, "Evicting heap block {} for block {}", candidate, replacement);
+        m_cached_blocks.remove(candidate);
+        candidate = replacement;
+        return;
+    }
+
+    // Only dirty blocks that could not be logged are left, so the pool has to grow until the next commit.
+    m_clock.append(replacement);
+}
+
+Vector<u32> Heap::sorted_dirty_blocks() const
+{
+    Vector<u32> blocks;
+    for (auto& cached_block : m_cached_blocks) {
+        if (cached_block.value.is_dirty)
+            blocks.append(cached_block.key);
+    }
+    quick_sort(blocks);
+    return blocks;
+}
+
+void Heap::clear_cache()
+{
+    m_cached_blocks.clear();
+    m_dirty_block_count = 0;
+    m_clock.clear();
+    m_clock_hand = 0;
+}
+
+u32 Heap::log_frame_checksum(u32 previous_checksum, u32 block, ReadonlyBytes data)
+{
+    Crypto::Checksum::CRC32 checksum { previous_checksum, { &block, sizeof(block) } };
+    checksum.update(data);
+    return checksum.digest();
+}
+
+ErrorOr<void> Heap::append_to_log(Vector<u32> const& blocks, bool is_commit)
+{
+    constexpr size_t block_frame_size = sizeof(LogFrameHeader) + BLOCKSIZE;
+    auto frames = TRY(ByteBuffer::create_zeroed(blocks.size() * block_frame_size + (is_commit ? sizeof(LogFrameHeader) : 0)));
+
+    auto checksum = m_log_checksum;
+    size_t offset = 0;
+    for (auto block : blocks) {
+        auto& buffer = m_cached_blocks.find(block)->value.buffer;
+        if (buffer.size() > BLOCKSIZE) {
+            warnln("Heap({})::append_to_log({}): Oversized block ({} > {})"sv, name(), block, buffer.size(), BLOCKSIZE);
+            return Error::from_string_literal("Heap()::append_to_log(): Oversized block");
+        }
+
+        auto data = frames.bytes().slice(offset + sizeof(LogFrameHeader), BLOCKSIZE);
+        buffer.bytes().copy_to(data);
+        checksum = log_frame_checksum(checksum, block, data);
+
+        LogFrameHeader header { block, checksum };
+        frames.overwrite(offset, &header, sizeof(header));
+        offset += block_frame_size;
+    }
+    if (is_commit) {
+        checksum = log_frame_checksum(checksum, log_commit_record, {});
+        LogFrameHeader header { log_commit_record, checksum };
+        frames.overwrite(offset, &header, sizeof(header));
+    }
 
-    dbgln_if(SQL_DEBUG, "{:hex-dump}", bytes.trim(8));
-    TRY(buffer.try_resize(bytes.size()));
+    dbgln_if(SQL_DEBUG, "Append {} blocks{} to the log of {}", blocks.size(), is_commit ? " and a commit record"sv : ""sv, name());
+    TRY(m_log->seek(m_log_size, SeekMode::SetPosition));
+    TRY(m_log->write_entire_buffer(frames));
 
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        m_logged_blocks.set(blocks[i], m_log_size + i * block_frame_size + sizeof(LogFrameHeader));
+
+        auto& cached_block = m_cached_blocks.find(blocks[i])->value;
+        if (cached_block.is_dirty) {
+            cached_block.is_dirty = false;
+            --m_dirty_block_count;
+        }
+    }
+    m_log_size += frames.size();
+    m_log_block_count += blocks.size();
+    m_log_checksum = checksum;
+    m_log_has_uncommitted_blocks = !is_commit;
+    m_log_needs_sync = true;
+    return {};
+}
+
+ErrorOr<ByteBuffer> Heap::read_from_log(size_t offset)
+{
+    auto buffer = TRY(ByteBuffer::create_uninitialized(BLOCKSIZE));
+    TRY(m_log->seek(offset, SeekMode::SetPosition));
+    TRY(m_log->read_entire_buffer(buffer));
     return buffer;
 }
 
+ErrorOr<void> Heap::sync_log()
+{
+    if (!m_log_needs_sync)
+        return {};
+    TRY(Core::System::fsync(m_log->fd()));
+    m_log_needs_sync = false;
+    return {};
+}
+
+// Copies the blocks of the transactions that were committed to the log before a crash into the heap file. Blocks
+// after the last commit record, or after a torn or corrupt frame, belong to a transaction that never committed.
+ErrorOr<void> Heap::recover_from_log()
+{
+    m_logged_blocks.clear();
+    m_log_size = 0;
+    m_log_block_count = 0;
+    m_log_checksum = 0;
+    m_log_has_uncommitted_blocks = false;
+    m_log_needs_sync = false;
+
+    auto log = TRY(m_log->read_until_eof());
+    if (log.is_empty())
+        return {};
+
+    HashMap<u32, size_t> committed_blocks;
+    HashMap<u32, size_t> uncommitted_blocks;
+    u32 checksum = 0;
+    for (size_t offset = 0; offset + sizeof(LogFrameHeader) <= log.size();) {
+        LogFrameHeader header;
+        memcpy(&header, log.offset_pointer(offset), sizeof(header));
+        offset += sizeof(header);
+
+        if (header.block == log_commit_record) {
+            checksum = log_frame_checksum(checksum, header.block, {});
+            if (checksum != header.checksum)
+                break;
+            for (auto& block : uncommitted_blocks)
+                committed_blocks.set(block.key, block.value);
+            uncommitted_blocks.clear();
+            continue;
+        }
+
+        if (offset + BLOCKSIZE > log.size())
+            break;
+        checksum = log_frame_checksum(checksum, header.block, log.bytes().slice(offset, BLOCKSIZE));
+        if (checksum != header.checksum)
+            break;
+        uncommitted_blocks.set(header.block, offset);
+        offset += BLOCKSIZE;
+    }
+
+    Vector<u32> blocks;
+    for (auto& block : committed_blocks) {
+        blocks.append(block.key);
+        m_next_block = max(m_next_block, block.key + 1);
+    }
+    quick_sort(blocks);
+
+    dbgln_if(SQL_DEBUG, "Recovering {} blocks from the log of {}", blocks.size(), name());
+    for (auto block : blocks) {
+        auto buffer = TRY(ByteBuffer::copy(log.bytes().slice(committed_blocks.get(block).value(), BLOCKSIZE)));
+        TRY(write_block(block, buffer));
+    }
+    if (!blocks.is_empty())
+        TRY(Core::System::fsync(m_file->fd()));
+
+    TRY(m_log->truncate(0));
+    return {};
+}
+
+ErrorOr<void> Heap::commit()
+{
+    VERIFY(m_file);
+    auto blocks = sorted_dirty_blocks();
+    if (blocks.is_empty() && !m_log_has_uncommitted_blocks)
+        return {};
+    return append_to_log(blocks, true);
+}
+
+void Heap::sync(Function<void(ErrorOr<void>)> on_durable)
+{
+    VERIFY(m_file);
+    if (!m_log_needs_sync) {
+        on_durable({});
+        return;
+    }
+
+    m_sync_callbacks.append(move(on_durable));
+    if (m_sync_callbacks.size() > 1)
+        return;
+
+    // Group commit: everything that is committed until the event loop gets here is synced together.
+    deferred_invoke([this] {
+        auto result = sync_log();
+        auto callbacks = move(m_sync_callbacks);
+        for (auto& callback : callbacks) {
+            if (result.is_error())
+                callback(Error::copy(result.error()));
+            else
+                callback({});
+        }
+
+        // Checkpoint after the callbacks had a chance to acknowledge the commits.
+        if (!result.is_error() && m_log_block_count >= checkpoint_log_block_count) {
+            deferred_invoke([this] {
+                if (auto maybe_error = checkpoint(); maybe_error.is_error())
+                    warnln("Heap({})::checkpoint(): {}", name(), maybe_error.error());
+            });
+        }
+    });
+}
+
+ErrorOr<void> Heap::flush()
+{
+    TRY(commit());
+    TRY(sync_log());
+    if (m_log_block_count >= checkpoint_log_block_count)
+        TRY(checkpoint());
+    dbgln_if(SQL_DEBUG, "WAL flushed. Heap size = {}", size());
+    return {};
+}
+
+// Copies the latest version of every block in the log into the heap file, after which the log starts over.
+ErrorOr<void> Heap::checkpoint()
+{
+    VERIFY(m_file);
+    // The log has to keep the blocks that are not committed yet, as they may have been evicted from the pool.
+    if (m_log_has_uncommitted_blocks || m_logged_blocks.is_empty())
+        return {};
+    // The heap file must never get ahead of the log.
+    TRY(sync_log());
+
+    Vector<u32> blocks;
+    for (auto& block : m_logged_blocks)
+        blocks.append(block.key);
+    quick_sort(blocks);
+
+    dbgln_if(SQL_DEBUG, "Checkpointing {} blocks into {}", blocks.size(), name());
+    for (auto block : blocks) {
+        // A dirty block in the pool is newer than the version in the log, so that one is read back.
+        if (auto it = m_cached_blocks.find(block); it != m_cached_blocks.end() && !it->value.is_dirty) {
+            TRY(write_block(block, it->value.buffer));
+        } else {
+            auto buffer = TRY(read_from_log(m_logged_blocks.get(block).value()));
+            TRY(write_block(block, buffer));
+        }
+    }
+    TRY(Core::System::fsync(m_file->fd()));
+
+    TRY(m_log->truncate(0));
+    m_logged_blocks.clear();
+    m_log_size = 0;
+    m_log_block_count = 0;
+    m_log_checksum = 0;
+    return {};
+}
+
+ErrorOr<void> Heap::close_log()
+{
+    TRY(flush());
+    TRY(checkpoint());
+    m_log = nullptr;
+    return Core::System::unlink(log_file_name());
+}
+
 ErrorOr<void> Heap::write_block(u32 block, ByteBuffer& buffer)
 {
     if (!m_file) {
@@ -114,6 +453,12 @@ ErrorOr<void> Heap::write_block(u32 block, ByteBuffer& buffer)
         return Error::from_string_literal("Heap()::write_block(): Oversized block");
     }
 
+    // Blocks that were allocated but never written leave a hole, which is filled with zeroes.
+    while (m_end_of_file < block) {
+        auto zero_block = TRY(ByteBuffer::create_zeroed(BLOCKSIZE));
+        TRY(write_block(m_end_of_file, zero_block));
+    }
+
     dbgln_if(SQL_DEBUG, "Write heap block {} size {}", block, buffer.size());
     TRY(seek_block(block));
 
@@ -123,7 +468,7 @@ ErrorOr<void> Heap::write_block(u32 block, ByteBuffer& buffer)
     }
 
     dbgln_if(SQL_DEBUG, "{:hex-dump}", buffer.bytes().trim(8));
-    TRY(m_file->write(buffer));
+    TRY(m_file->write_entire_buffer(buffer));
 
     if (block == m_end_of_file)
         m_end_of_file++;
@@ -166,24 +511,6 @@ u32 Heap::new_record_pointer()
     return m_next_block++;
 }
 
-ErrorOr<void> Heap::flush()
-{
-    VERIFY(m_file);
-    Vector<u32> blocks;
-    for (auto& wal_entry : m_write_ahead_log) {
-        blocks.append(wal_entry.key);
-    }
-    quick_sort(blocks);
-    for (auto& block : blocks) {
-        auto buffer_it = m_write_ahead_log.find(block);
-        VERIFY(buffer_it != m_write_ahead_log.end());
-        dbgln_if(SQL_DEBUG, "Flushing block {} to {}", block, name());
-        TRY(write_block(block, buffer_it->value));
-    }
-    m_write_ahead_log.clear();
-    dbgln_if(SQL_DEBUG, "WAL flushed. Heap size = {}", size());
-    return {};
-}
 
 constexpr static auto FILE_ID = "SerenitySQL "sv;
 constexpr static auto VERSION_OFFSET = FILE_ID.length();
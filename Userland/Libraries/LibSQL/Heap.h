@@ -9,7 +9,9 @@
 #include <AK/Array.h>
 #include <AK/Debug.h>
 #include <AK/DeprecatedString.h>
+#include <AK/Function.h>
 #include <AK/HashMap.h>
+#include <AK/NumericLimits.h>
 #include <AK/Vector.h>
 #include <LibCore/File.h>
 #include <LibCore/Object.h>
@@ -28,6 +30,13 @@ constexpr static u32 BLOCKSIZE = 1024;
  * assumed that a single SQL database is backed by a single Heap.
  *
  * Currently only B-Trees and tuple stores are implemented.
+ *
+ * Changes are not written to the heap file in place. A commit appends the
+ * changed blocks and a commit record to a write-ahead log next to the heap
+ * file, and only the log has to reach the disk before the commit is durable.
+ * The committed blocks are copied into the heap file when the log is
+ * checkpointed, and a log left behind by a crash is replayed when the heap
+ * is opened again.
  */
 class Heap : public Core::Object {
     C_OBJECT(Heap);
@@ -81,14 +90,28 @@ public:
         update_zero_block();
     }
 
-    void add_to_wal(u32 block, ByteBuffer& buffer)
-    {
-        dbgln_if(SQL_DEBUG, "Adding to WAL: block #{}, size {}", block, buffer.size());
-        dbgln_if(SQL_DEBUG, "{:hex-dump}", buffer.bytes().trim(8));
-        m_write_ahead_log.set(block, buffer);
-    }
+    void add_to_wal(u32 block, ByteBuffer& buffer);
 
+    // Appends the changes made so far to the log, without waiting for them to reach the disk.
+    ErrorOr<void> commit();
+    // Calls on_durable once everything that was committed is on disk. The commits made before that share a single
+    // fsync() of the log, so this has to be called from the event loop.
+    void sync(Function<void(ErrorOr<void>)> on_durable);
+    // Commits the changes made so far, and waits until they are on disk.
     ErrorOr<void> flush();
+    ErrorOr<void> checkpoint();
+
+    // The number of blocks the buffer pool keeps in memory, clean and dirty ones together.
+    static constexpr inline size_t maximum_cached_blocks = 4096;
+    // Past this many dirty blocks, they are appended to the log ahead of the next commit, so they can be evicted.
+    static constexpr inline size_t maximum_dirty_blocks = maximum_cached_blocks / 2;
+    // The log is checkpointed once it holds this many blocks.
+    static constexpr inline size_t checkpoint_log_block_count = 1024;
+
+    size_t cached_block_count() const { return m_cached_blocks.size(); }
+    size_t dirty_block_count() const { return m_dirty_block_count; }
+    size_t log_block_count() const { return m_log_block_count; }
+    DeprecatedString log_file_name() const { return DeprecatedString::formatted("{}-wal", name()); }
 
 private:
     explicit Heap(DeprecatedString);
@@ -99,7 +122,34 @@ private:
     void initialize_zero_block();
     void update_zero_block();
 
-    OwnPtr<Core::BufferedFile> m_file;
+    // A block in the buffer pool. Dirty blocks have changes that are not in the log yet, so they are never evicted.
+    struct CachedBlock {
+        ByteBuffer buffer;
+        bool is_dirty { false };
+        bool was_referenced { true };
+    };
+
+    void cache_block(u32, ByteBuffer, bool is_dirty);
+    void evict_clean_block(u32 replacement);
+    Vector<u32> sorted_dirty_blocks() const;
+    void clear_cache();
+
+    // Every block in the log is preceded by a frame header. A commit record is a header without a block.
+    struct LogFrameHeader {
+        u32 block;
+        // A CRC32 over this frame and all frames before it in the log.
+        u32 checksum;
+    };
+    static constexpr u32 log_commit_record = NumericLimits<u32>::max();
+    static u32 log_frame_checksum(u32 previous_checksum, u32 block, ReadonlyBytes);
+
+    ErrorOr<void> append_to_log(Vector<u32> const& blocks, bool is_commit);
+    ErrorOr<ByteBuffer> read_from_log(size_t offset);
+    ErrorOr<void> sync_log();
+    ErrorOr<void> recover_from_log();
+    ErrorOr<void> close_log();
+
+    OwnPtr<Core::File> m_file;
     u32 m_free_list { 0 };
     u32 m_next_block { 1 };
     u32 m_end_of_file { 1 };
@@ -108,7 +158,21 @@ private:
     u32 m_table_columns_root { 0 };
     u32 m_version { current_version };
     Array<u32, 16> m_user_values { 0 };
-    HashMap<u32, ByteBuffer> m_write_ahead_log;
+    HashMap<u32, CachedBlock> m_cached_blocks;
+    size_t m_dirty_block_count { 0 };
+    // The blocks in the pool in CLOCK order, the hand points at the next candidate for eviction.
+    Vector<u32> m_clock;
+    size_t m_clock_hand { 0 };
+
+    OwnPtr<Core::File> m_log;
+    // Where the latest version of each block in the log starts.
+    HashMap<u32, size_t> m_logged_blocks;
+    size_t m_log_size { 0 };
+    size_t m_log_block_count { 0 };
+    u32 m_log_checksum { 0 };
+    bool m_log_has_uncommitted_blocks { false };
+    bool m_log_needs_sync { false };
+    Vector<Function<void(ErrorOr<void>)>> m_sync_callbacks;
 };
 
 }
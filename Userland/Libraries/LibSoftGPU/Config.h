@@ -24,6 +24,11 @@ static constexpr int MAX_TEXTURE_SIZE = 2048;
 static constexpr float MAX_TEXTURE_LOD_BIAS = 2.f;
 static constexpr int SUBPIXEL_BITS = 4;
 
+// Triangles are binned into square tiles of this many pixels, which are then rasterized in parallel. Must be even, so
+// that pixel quads never cross tile boundaries.
+static constexpr int RASTERIZER_TILE_SIZE = 64;
+static_assert(RASTERIZER_TILE_SIZE % 2 == 0);
+
 static constexpr int NUM_SHADER_INPUTS = 64;
 
 // Verify that we have enough inputs to hold vertex color and texture coordinates for all fixed function texture units
@@ -25,6 +25,7 @@
 #include <LibSoftGPU/SIMD.h>
 #include <LibSoftGPU/Shader.h>
 #include <LibSoftGPU/ShaderCompiler.h>
+#include <LibThreading/ThreadPool.h>
 #include <math.h>
 
 namespace SoftGPU {
@@ -174,7 +175,7 @@ ALWAYS_INLINE static Vector4<f32x4> get_blend_factor(GPU::BlendFactor blend_fact
 }
 
 template<typename CB1, typename CB2, typename CB3>
-ALWAYS_INLINE void Device::rasterize(Gfx::IntRect& render_bounds, CB1 set_coverage_mask, CB2 set_quad_depth, CB3 set_quad_attributes)
+ALWAYS_INLINE void Device::rasterize(Gfx::IntRect& render_bounds, ShaderProcessor& shader_processor, CB1 set_coverage_mask, CB2 set_quad_depth, CB3 set_quad_attributes)
 {
     // Return if alpha testing is a no-op
     if (m_options.enable_alpha_test && m_options.alpha_test_func == GPU::AlphaTestFunction::Never)
@@ -405,7 +406,7 @@ ALWAYS_INLINE void Device::rasterize(Gfx::IntRect& render_bounds, CB1 set_covera
             INCREASE_STATISTICS_COUNTER(g_num_pixels_shaded, maskcount(quad.mask));
 
             set_quad_attributes(quad);
-            shade_fragments(quad);
+            shade_fragments(quad, shader_processor);
 
             // Alpha testing
             if (m_options.enable_alpha_test) {
@@ -497,6 +498,7 @@ void Device::rasterize_line_antialiased(GPU::Vertex& from, GPU::Vertex& to)
     f32x4 distance_along_line;
     rasterize(
         render_bounds,
+        m_shader_processor,
         [&from_coords4, &distance_along_line, &line_vector4, &line_dot4, &line_radius](auto& quad) {
             auto const screen_coordinates4 = to_vec2_f32x4(quad.screen_coordinates);
             auto const pixel_vector = screen_coordinates4 - from_coords4;
@@ -553,6 +555,7 @@ void Device::rasterize_point_aliased(GPU::Vertex& point)
     // Rasterize the point as a rect
     rasterize(
         point_rect,
+        m_shader_processor,
         [](auto& quad) {
             // We already passed in point_rect, so this doesn't matter
             quad.mask = expand4(~0);
@@ -585,6 +588,7 @@ void Device::rasterize_point_antialiased(GPU::Vertex& point)
     // Rasterize using a 2D signed distance field for a circle
     rasterize(
         render_bounds,
+        m_shader_processor,
         [&center4, &radius](auto& quad) {
             auto screen_coords = to_vec2_f32x4(quad.screen_coordinates);
             auto distance_to_point = length(center4 - screen_coords) - radius;
@@ -613,36 +617,60 @@ void Device::rasterize_point(GPU::Vertex& point)
         rasterize_point_aliased(point);
 }
 
-void Device::rasterize_triangle(Triangle& triangle)
+Optional<Gfx::IntRect> Device::set_up_triangle(Triangle& triangle) const
 {
-    INCREASE_STATISTICS_COUNTER(g_num_rasterized_triangles, 1);
-
     auto v0 = (triangle.vertices[0].window_coordinates.xy() * subpixel_factor).to_rounded<int>();
     auto v1 = (triangle.vertices[1].window_coordinates.xy() * subpixel_factor).to_rounded<int>();
     auto v2 = (triangle.vertices[2].window_coordinates.xy() * subpixel_factor).to_rounded<int>();
 
     auto triangle_area = edge_function(v0, v1, v2);
     if (triangle_area == 0)
-        return;
+        return {};
 
     // Perform face culling
     if (m_options.enable_culling) {
         bool is_front = (m_options.front_face == GPU::WindingOrder::CounterClockwise ? triangle_area > 0 : triangle_area < 0);
 
         if (!is_front && m_options.cull_back)
-            return;
+            return {};
 
         if (is_front && m_options.cull_front)
-            return;
+            return {};
     }
 
     // Force counter-clockwise ordering of vertices
     if (triangle_area < 0) {
         swap(triangle.vertices[0], triangle.vertices[1]);
         swap(v0, v1);
-        triangle_area *= -1;
     }
 
+    // Calculate render bounds based on the triangle's vertices, limited to the framebuffer and scissor rects
+    Gfx::IntRect render_bounds;
+    render_bounds.set_left(min(min(v0.x(), v1.x()), v2.x()) / subpixel_factor);
+    render_bounds.set_right(max(max(v0.x(), v1.x()), v2.x()) / subpixel_factor);
+    render_bounds.set_top(min(min(v0.y(), v1.y()), v2.y()) / subpixel_factor);
+    render_bounds.set_bottom(max(max(v0.y(), v1.y()), v2.y()) / subpixel_factor);
+
+    render_bounds.intersect(m_frame_buffer->rect());
+    if (m_options.scissor_enabled)
+        render_bounds.intersect(m_options.scissor_box);
+    if (render_bounds.is_empty())
+        return {};
+
+    return render_bounds;
+}
+
+void Device::rasterize_triangle(Triangle const& triangle, Gfx::IntRect const& clip_rect, ShaderProcessor& shader_processor)
+{
+    INCREASE_STATISTICS_COUNTER(g_num_rasterized_triangles, 1);
+
+    // set_up_triangle() has already put the vertices in counter-clockwise order.
+    auto v0 = (triangle.vertices[0].window_coordinates.xy() * subpixel_factor).to_rounded<int>();
+    auto v1 = (triangle.vertices[1].window_coordinates.xy() * subpixel_factor).to_rounded<int>();
+    auto v2 = (triangle.vertices[2].window_coordinates.xy() * subpixel_factor).to_rounded<int>();
+
+    auto triangle_area = edge_function(v0, v1, v2);
+
     auto const& vertex0 = triangle.vertices[0];
     auto const& vertex1 = triangle.vertices[1];
     auto const& vertex2 = triangle.vertices[2];
@@ -723,8 +751,10 @@ void Device::rasterize_triangle(Triangle& triangle)
         expand4(vertex2.window_coordinates.z() + depth_offset),
     };
 
+    render_bounds.intersect(clip_rect);
     rasterize(
         render_bounds,
+        shader_processor,
         [&](auto& quad) {
             auto edge_values = calculate_edge_values4(quad.screen_coordinates * subpixel_factor + half_pixel_offset);
             quad.mask = test_point4(edge_values);
@@ -760,6 +790,75 @@ void Device::rasterize_triangle(Triangle& triangle)
         });
 }
 
+void Device::rasterize_triangles()
+{
+    m_processed_triangle_bounds.clear_with_capacity();
+    for (auto& triangle : m_processed_triangles) {
+        auto render_bounds = set_up_triangle(triangle);
+        m_processed_triangle_bounds.append(render_bounds.value_or({}));
+    }
+
+    auto const frame_buffer_rect = m_frame_buffer->rect();
+    auto const tile_columns = ceil_div(frame_buffer_rect.width(), RASTERIZER_TILE_SIZE);
+    auto const tile_rows = ceil_div(frame_buffer_rect.height(), RASTERIZER_TILE_SIZE);
+    auto const tile_count = static_cast<size_t>(tile_columns * tile_rows);
+
+    // Bin every triangle into the tiles that its bounds touch. Tiles do not overlap, so they can be rasterized
+    // independently of each other, as long as the triangles within a tile are rasterized in their original order.
+    if (m_triangles_per_tile.size() != tile_count)
+        m_triangles_per_tile.resize(tile_count);
+    for (auto& triangles : m_triangles_per_tile)
+        triangles.clear_with_capacity();
+
+    for (u32 i = 0; i < m_processed_triangles.size(); ++i) {
+        auto const& render_bounds = m_processed_triangle_bounds[i];
+        if (render_bounds.is_empty())
+            continue;
+        for (int row = render_bounds.top() / RASTERIZER_TILE_SIZE; row <= render_bounds.bottom() / RASTERIZER_TILE_SIZE; ++row) {
+            for (int column = render_bounds.left() / RASTERIZER_TILE_SIZE; column <= render_bounds.right() / RASTERIZER_TILE_SIZE; ++column)
+                m_triangles_per_tile[row * tile_columns + column].append(i);
+        }
+    }
+
+    Vector<u32> occupied_tiles;
+    for (u32 tile = 0; tile < tile_count; ++tile) {
+        if (!m_triangles_per_tile[tile].is_empty())
+            occupied_tiles.append(tile);
+    }
+
+    auto& thread_pool = Threading::ThreadPool::the();
+    auto const task_count = min(occupied_tiles.size(), thread_pool.worker_count() + 1);
+
+    // The statistics counters are not thread-safe, so keep everything on this thread while they are being collected.
+    if (task_count <= 1 || ENABLE_STATISTICS_OVERLAY) {
+        for (size_t i = 0; i < m_processed_triangles.size(); ++i) {
+            if (!m_processed_triangle_bounds[i].is_empty())
+                rasterize_triangle(m_processed_triangles[i], frame_buffer_rect, m_shader_processor);
+        }
+        return;
+    }
+
+    while (m_tile_shader_processors.size() < task_count)
+        m_tile_shader_processors.append(make<ShaderProcessor>(m_samplers));
+
+    thread_pool.parallel_for(task_count, [&](size_t task) {
+        auto& shader_processor = *m_tile_shader_processors[task];
+        auto const first_tile = occupied_tiles.size() * task / task_count;
+        auto const end_tile = occupied_tiles.size() * (task + 1) / task_count;
+        for (auto tile_index = first_tile; tile_index < end_tile; ++tile_index) {
+            auto const tile = occupied_tiles[tile_index];
+            Gfx::IntRect const tile_rect {
+                static_cast<int>(tile % tile_columns) * RASTERIZER_TILE_SIZE,
+                static_cast<int>(tile / tile_columns) * RASTERIZER_TILE_SIZE,
+                RASTERIZER_TILE_SIZE,
+                RASTERIZER_TILE_SIZE,
+            };
+            for (auto triangle_index : m_triangles_per_tile[tile])
+                rasterize_triangle(m_processed_triangles[triangle_index], tile_rect, shader_processor);
+        }
+    });
+}
+
 Device::Device(Gfx::IntSize size)
     : m_frame_buffer(FrameBuffer<GPU::ColorType, GPU::DepthType, GPU::StencilType>::try_create(size).release_value_but_fixme_should_propagate_errors())
     , m_shader_processor(m_samplers)
@@ -1139,14 +1238,13 @@ void Device::draw_primitives(GPU::PrimitiveType primitive_type, FloatMatrix4x4 c
         }
     }
 
-    for (auto& triangle : m_processed_triangles)
-        rasterize_triangle(triangle);
+    rasterize_triangles();
 }
 
-ALWAYS_INLINE void Device::shade_fragments(PixelQuad& quad)
+ALWAYS_INLINE void Device::shade_fragments(PixelQuad& quad, ShaderProcessor& shader_processor)
 {
     if (m_current_fragment_shader) {
-        m_shader_processor.execute(quad, *m_current_fragment_shader);
+        shader_processor.execute(quad, *m_current_fragment_shader);
         return;
     }
 
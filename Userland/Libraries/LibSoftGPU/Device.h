@@ -8,7 +8,9 @@
 #pragma once
 
 #include <AK/Array.h>
+#include <AK/NonnullOwnPtr.h>
 #include <AK/NonnullRefPtr.h>
+#include <AK/Optional.h>
 #include <AK/RefPtr.h>
 #include <AK/Vector.h>
 #include <LibGPU/Device.h>
@@ -90,7 +92,7 @@ private:
     GPU::ImageDataLayout depth_buffer_data_layout(Vector2<u32> size, Vector2<i32> offset);
 
     template<typename CB1, typename CB2, typename CB3>
-    void rasterize(Gfx::IntRect& render_bounds, CB1 set_coverage_mask, CB2 set_quad_depth, CB3 set_quad_attributes);
+    void rasterize(Gfx::IntRect& render_bounds, ShaderProcessor&, CB1 set_coverage_mask, CB2 set_quad_depth, CB3 set_quad_attributes);
 
     void rasterize_line_aliased(GPU::Vertex&, GPU::Vertex&);
     void rasterize_line_antialiased(GPU::Vertex&, GPU::Vertex&);
@@ -100,8 +102,10 @@ private:
     void rasterize_point_antialiased(GPU::Vertex&);
     void rasterize_point(GPU::Vertex&);
 
-    void rasterize_triangle(Triangle&);
-    void shade_fragments(PixelQuad&);
+    Optional<Gfx::IntRect> set_up_triangle(Triangle&) const;
+    void rasterize_triangle(Triangle const&, Gfx::IntRect const& clip_rect, ShaderProcessor&);
+    void rasterize_triangles();
+    void shade_fragments(PixelQuad&, ShaderProcessor&);
 
     RefPtr<FrameBuffer<GPU::ColorType, GPU::DepthType, GPU::StencilType>> m_frame_buffer {};
     GPU::RasterizerOptions m_options;
@@ -109,6 +113,9 @@ private:
     Clipper m_clipper;
     Vector<Triangle> m_triangle_list;
     Vector<Triangle> m_processed_triangles;
+    Vector<Gfx::IntRect> m_processed_triangle_bounds;
+    // For every tile of the frame buffer: the indices of the processed triangles that might cover it, in order.
+    Vector<Vector<u32>> m_triangles_per_tile;
     Vector<GPU::Vertex> m_clipped_vertices;
     float m_one_over_fog_depth;
     Array<Sampler, GPU::NUM_TEXTURE_UNITS> m_samplers;
@@ -121,6 +128,8 @@ private:
     Array<GPU::TextureUnitConfiguration, GPU::NUM_TEXTURE_UNITS> m_texture_unit_configuration;
     RefPtr<Shader> m_current_fragment_shader;
     ShaderProcessor m_shader_processor;
+    // One for every task that rasterizes tiles in parallel, as shader processors keep state while executing.
+    Vector<NonnullOwnPtr<ShaderProcessor>> m_tile_shader_processors;
 };
 
 }
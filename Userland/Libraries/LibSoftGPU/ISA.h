@@ -60,4 +60,16 @@ struct Instruction final {
     Opcode operation;
 };
 
+class ShaderProcessor;
+struct PixelQuad;
+
+// An instruction that has been bound to the code executing it, so that running a shader does not have to decode
+// every instruction again for every quad.
+struct CompiledInstruction final {
+    using Handler = void (*)(ShaderProcessor&, PixelQuad&, Instruction::Arguments);
+
+    Handler handler;
+    Instruction::Arguments arguments;
+};
+
 }
@@ -5,12 +5,14 @@
  */
 
 #include <LibSoftGPU/Shader.h>
+#include <LibSoftGPU/ShaderProcessor.h>
 
 namespace SoftGPU {
 
 Shader::Shader(void const* ownership_token, Vector<Instruction> const& instructions)
     : GPU::Shader(ownership_token)
     , m_instructions(instructions)
+    , m_compiled_instructions(ShaderProcessor::compile(instructions))
 {
 }
 
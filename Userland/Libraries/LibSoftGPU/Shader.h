@@ -17,9 +17,11 @@ public:
     Shader(void const* ownership_token, Vector<Instruction> const&);
 
     Vector<Instruction> const& instructions() const { return m_instructions; }
+    Vector<CompiledInstruction> const& compiled_instructions() const { return m_compiled_instructions; }
 
 private:
     Vector<Instruction> m_instructions;
+    Vector<CompiledInstruction> m_compiled_instructions;
 };
 
 }
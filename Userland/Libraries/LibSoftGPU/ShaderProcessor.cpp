@@ -13,40 +13,44 @@ namespace SoftGPU {
 
 using AK::SIMD::f32x4;
 
-void ShaderProcessor::execute(PixelQuad& quad, Shader const& shader)
+Vector<CompiledInstruction> ShaderProcessor::compile(Vector<Instruction> const& instructions)
 {
-    auto& instructions = shader.instructions();
-    for (size_t program_counter = 0; program_counter < instructions.size(); ++program_counter) {
-        auto instruction = instructions[program_counter];
+    auto handler_for = [](Instruction const& instruction) -> CompiledInstruction::Handler {
         switch (instruction.operation) {
         case Opcode::Input:
-            op_input(quad, instruction.arguments);
-            break;
+            return [](ShaderProcessor& processor, PixelQuad& quad, Instruction::Arguments arguments) { processor.op_input(quad, arguments); };
         case Opcode::Output:
-            op_output(quad, instruction.arguments);
-            break;
+            return [](ShaderProcessor& processor, PixelQuad& quad, Instruction::Arguments arguments) { processor.op_output(quad, arguments); };
         case Opcode::Sample2D:
-            op_sample2d(instruction.arguments);
-            break;
+            return [](ShaderProcessor& processor, PixelQuad&, Instruction::Arguments arguments) { processor.op_sample2d(arguments); };
         case Opcode::Swizzle:
-            op_swizzle(instruction.arguments);
-            break;
+            // Moves between registers are emitted as swizzles that keep every component in place.
+            if (instruction.arguments.swizzle.pattern == swizzle_pattern(0, 1, 2, 3))
+                return [](ShaderProcessor& processor, PixelQuad&, Instruction::Arguments arguments) { processor.op_copy(arguments); };
+            return [](ShaderProcessor& processor, PixelQuad&, Instruction::Arguments arguments) { processor.op_swizzle(arguments); };
         case Opcode::Add:
-            op_add(instruction.arguments);
-            break;
+            return [](ShaderProcessor& processor, PixelQuad&, Instruction::Arguments arguments) { processor.op_add(arguments); };
         case Opcode::Sub:
-            op_sub(instruction.arguments);
-            break;
+            return [](ShaderProcessor& processor, PixelQuad&, Instruction::Arguments arguments) { processor.op_sub(arguments); };
         case Opcode::Mul:
-            op_mul(instruction.arguments);
-            break;
+            return [](ShaderProcessor& processor, PixelQuad&, Instruction::Arguments arguments) { processor.op_mul(arguments); };
         case Opcode::Div:
-            op_div(instruction.arguments);
-            break;
-        default:
-            VERIFY_NOT_REACHED();
+            return [](ShaderProcessor& processor, PixelQuad&, Instruction::Arguments arguments) { processor.op_div(arguments); };
         }
-    }
+        VERIFY_NOT_REACHED();
+    };
+
+    Vector<CompiledInstruction> compiled_instructions;
+    compiled_instructions.ensure_capacity(instructions.size());
+    for (auto const& instruction : instructions)
+        compiled_instructions.unchecked_append({ handler_for(instruction), instruction.arguments });
+    return compiled_instructions;
+}
+
+void ShaderProcessor::execute(PixelQuad& quad, Shader const& shader)
+{
+    for (auto const& instruction : shader.compiled_instructions())
+        instruction.handler(*this, quad, instruction.arguments);
 }
 
 void ShaderProcessor::op_input(PixelQuad const& quad, Instruction::Arguments arguments)
@@ -93,6 +97,22 @@ void ShaderProcessor::op_swizzle(Instruction::Arguments arguments)
     set_register(arguments.swizzle.target_register + 3, inputs[swizzle_index(arguments.swizzle.pattern, 3)]);
 }
 
+void ShaderProcessor::op_copy(Instruction::Arguments arguments)
+{
+    // The registers may overlap, so read everything before writing anything.
+    f32x4 inputs[] {
+        get_register(arguments.swizzle.source_register),
+        get_register(arguments.swizzle.source_register + 1),
+        get_register(arguments.swizzle.source_register + 2),
+        get_register(arguments.swizzle.source_register + 3)
+    };
+
+    set_register(arguments.swizzle.target_register, inputs[0]);
+    set_register(arguments.swizzle.target_register + 1, inputs[1]);
+    set_register(arguments.swizzle.target_register + 2, inputs[2]);
+    set_register(arguments.swizzle.target_register + 3, inputs[3]);
+}
+
 #define SHADER_BINOP(NAME, OP)                                                            \
     void ShaderProcessor::op_##NAME(Instruction::Arguments arguments)                     \
     {                                                                                     \
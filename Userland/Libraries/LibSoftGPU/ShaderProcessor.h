@@ -24,6 +24,9 @@ public:
     {
     }
 
+    // Binds every instruction to a handler that is specialized for its opcode and, where that pays off, its arguments.
+    static Vector<CompiledInstruction> compile(Vector<Instruction> const&);
+
     void execute(PixelQuad&, Shader const&);
 
     ALWAYS_INLINE AK::SIMD::f32x4 get_register(u16 index) const { return m_registers[index]; }
@@ -34,6 +37,7 @@ private:
     void op_output(PixelQuad&, Instruction::Arguments);
     void op_sample2d(Instruction::Arguments);
     void op_swizzle(Instruction::Arguments);
+    void op_copy(Instruction::Arguments);
     void op_add(Instruction::Arguments);
     void op_sub(Instruction::Arguments);
     void op_mul(Instruction::Arguments);
@@ -9,6 +9,7 @@
 #include <AK/Endian.h>
 #include <AK/Random.h>
 
+#include <LibCore/DateTime.h>
 #include <LibCore/Timer.h>
 #include <LibCrypto/ASN1/DER.h>
 #include <LibCrypto/PK/Code/EMSA_PSS.h>
@@ -19,6 +20,7 @@ namespace TLS {
 ByteBuffer TLSv12::build_hello()
 {
     fill_with_random(&m_context.local_random, 32);
+    offer_cached_session();
 
     auto packet_version = (u16)m_context.options.version;
     auto version = (u16)m_context.options.version;
@@ -48,8 +50,8 @@ ByteBuffer TLSv12::build_hello()
         alpn_negotiated_length = m_context.negotiated_alpn.length();
         alpn_length = alpn_negotiated_length + 1;
         extension_length += alpn_length + 6;
-    } else if (m_context.alpn.size()) {
-        for (auto& alpn : m_context.alpn) {
+    } else if (!m_context.options.alpn_protocols.is_empty()) {
+        for (auto& alpn : m_context.options.alpn_protocols) {
             size_t length = alpn.length();
             alpn_length += length + 1;
         }
@@ -86,6 +88,12 @@ ByteBuffer TLSv12::build_hello()
     if (supports_elliptic_curves)
         extension_length += 6 + elliptic_curves_length + 5 + supported_ec_point_formats_length;
 
+    // Session tickets are only useful if we can keep them for the next connection.
+    bool use_session_tickets = m_context.options.session_cache;
+    size_t session_ticket_length = m_context.offered_session.has_value() ? m_context.offered_session->ticket.size() : 0;
+    if (use_session_tickets)
+        extension_length += 4 + session_ticket_length;
+
     builder.append((u16)extension_length);
 
     if (sni_length) {
@@ -130,9 +138,28 @@ ByteBuffer TLSv12::build_hello()
             builder.append((u8)format);
     }
 
+    if (use_session_tickets) {
+        // RFC 5077 section 3.2: An empty SessionTicket extension asks the server for a new ticket.
+        builder.append((u16)HandshakeExtension::SessionTicket);
+        builder.append((u16)session_ticket_length);
+        if (session_ticket_length)
+            builder.append(m_context.offered_session->ticket.bytes());
+    }
+
     if (alpn_length) {
-        // TODO
-        VERIFY_NOT_REACHED();
+        // RFC7301 section 3.1: A list of protocol names, each prefixed by its length.
+        builder.append((u16)HandshakeExtension::ApplicationLayerProtocolNegotiation);
+        builder.append((u16)(alpn_length + 2));
+        builder.append((u16)alpn_length);
+        if (alpn_negotiated_length) {
+            builder.append((u8)alpn_negotiated_length);
+            builder.append(m_context.negotiated_alpn.bytes());
+        } else {
+            for (auto& alpn : m_context.options.alpn_protocols) {
+                builder.append((u8)alpn.length());
+                builder.append(alpn.bytes());
+            }
+        }
     }
 
     // set the "length" field of the packet
@@ -150,6 +177,97 @@ ByteBuffer TLSv12::build_hello()
     return packet;
 }
 
+void TLSv12::offer_cached_session()
+{
+    m_context.offered_session.clear();
+    m_context.is_resuming_session = false;
+    m_context.session_id_size = 0;
+
+    auto& session_cache = m_context.options.session_cache;
+    if (!session_cache || m_context.extensions.SNI.is_empty())
+        return;
+
+    auto const* cached_session = session_cache->find_session(m_context.extensions.SNI);
+    if (!cached_session || !m_context.options.usable_cipher_suites.contains_slow(cached_session->cipher))
+        return;
+
+    auto session = *cached_session;
+    if (session.session_id.is_empty()) {
+        // RFC 5077 section 3.4: When offering a ticket, the client can send a session ID of its own choosing,
+        // the server echoes it if it accepts the ticket.
+        auto session_id_result = ByteBuffer::create_uninitialized(sizeof(m_context.session_id));
+        if (session_id_result.is_error())
+            return;
+        session.session_id = session_id_result.release_value();
+        fill_with_random(session.session_id.data(), session.session_id.size());
+    }
+    if (session.session_id.size() > sizeof(m_context.session_id))
+        return;
+
+    dbgln_if(TLS_DEBUG, "Offering to resume a session with {}", m_context.extensions.SNI);
+    memcpy(m_context.session_id, session.session_id.data(), session.session_id.size());
+    m_context.session_id_size = session.session_id.size();
+    m_context.offered_session = move(session);
+}
+
+bool TLSv12::try_resume_offered_session(ReadonlyBytes session_id)
+{
+    if (!m_context.offered_session.has_value())
+        return false;
+
+    // RFC 5246 section 7.4.1.3: The server agrees to resume the session by sending back the same session ID,
+    // otherwise it starts a new one with a full handshake.
+    auto& session = *m_context.offered_session;
+    if (session_id != session.session_id.bytes() || m_context.cipher != session.cipher) {
+        m_context.options.session_cache->remove_session(m_context.extensions.SNI);
+        m_context.offered_session.clear();
+        return false;
+    }
+
+    m_context.master_key = session.master_key;
+    if (!expand_key())
+        return false;
+
+    dbgln_if(TLS_DEBUG, "Resuming the session with {}", m_context.extensions.SNI);
+    m_context.is_resuming_session = true;
+    return true;
+}
+
+void TLSv12::store_session_in_cache()
+{
+    auto& session_cache = m_context.options.session_cache;
+    if (!session_cache || m_context.extensions.SNI.is_empty())
+        return;
+
+    auto now = Core::DateTime::now().timestamp();
+    SessionCache::Session session;
+    if (m_context.is_resuming_session) {
+        // A resumed session keeps the lifetime of the original one.
+        session = m_context.offered_session.release_value();
+    } else {
+        if (m_context.session_id_size == 0 && m_context.new_session_ticket.is_empty())
+            return;
+
+        auto session_id = ByteBuffer::copy(m_context.session_id, m_context.session_id_size);
+        auto master_key = ByteBuffer::copy(m_context.master_key);
+        if (session_id.is_error() || master_key.is_error())
+            return;
+
+        session.session_id = session_id.release_value();
+        session.cipher = m_context.cipher;
+        session.master_key = master_key.release_value();
+        session.expiry_timestamp = now + SessionCache::MaximumSessionLifetimeInSeconds;
+    }
+
+    if (!m_context.new_session_ticket.is_empty()) {
+        session.ticket = move(m_context.new_session_ticket);
+        if (m_context.new_session_ticket_lifetime_hint != 0)
+            session.expiry_timestamp = min(session.expiry_timestamp, now + m_context.new_session_ticket_lifetime_hint);
+    }
+
+    session_cache->store_session(m_context.extensions.SNI, move(session));
+}
+
 ByteBuffer TLSv12::build_change_cipher_spec()
 {
     PacketBuilder builder { MessageType::ChangeCipher, m_context.options.version, 64 };
@@ -218,6 +336,16 @@ ssize_t TLSv12::handle_handshake_finished(ReadonlyBytes buffer, WritePacketStage
 
     // TODO: Compare Hashes
     dbgln_if(TLS_DEBUG, "FIXME: handle_handshake_finished :: Check message validity");
+
+    store_session_in_cache();
+
+    if (m_context.is_resuming_session) {
+        // RFC 5246 section 7.3: In an abbreviated handshake the server finishes first, the connection
+        // is only established once our ChangeCipherSpec and Finished have been sent.
+        write_packets = WritePacketStage::Finished;
+        return index + size;
+    }
+
     m_context.connection_status = ConnectionStatus::Established;
 
     if (m_handshake_timeout_timer) {
@@ -299,6 +427,20 @@ ssize_t TLSv12::handle_handshake_payload(ReadonlyBytes vbuffer)
             dbgln("unsupported: DTLS");
             payload_res = (i8)Error::UnexpectedMessage;
             break;
+        case NewSessionTicket:
+            if (m_context.handshake_messages[11] >= 1) {
+                dbgln("unexpected new session ticket message");
+                payload_res = (i8)Error::UnexpectedMessage;
+                break;
+            }
+            ++m_context.handshake_messages[11];
+            dbgln_if(TLS_DEBUG, "new session ticket");
+            if (m_context.connection_status == ConnectionStatus::KeyExchange && m_context.options.session_cache) {
+                payload_res = handle_new_session_ticket(buffer.slice(1, payload_size));
+            } else {
+                payload_res = (i8)Error::UnexpectedMessage;
+            }
+            break;
         case CertificateMessage:
             if (m_context.handshake_messages[4] >= 1) {
                 dbgln("unexpected certificate message");
@@ -539,6 +681,15 @@ ssize_t TLSv12::handle_handshake_payload(ReadonlyBytes vbuffer)
                 write_packet(packet);
             }
             m_context.connection_status = ConnectionStatus::Established;
+
+            if (m_handshake_timeout_timer) {
+                m_handshake_timeout_timer->stop();
+                m_handshake_timeout_timer->remove_from_parent();
+                m_handshake_timeout_timer = nullptr;
+            }
+
+            if (on_connected)
+                on_connected();
             break;
         }
         payload_size++;
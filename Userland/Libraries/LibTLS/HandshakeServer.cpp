@@ -149,27 +149,20 @@ ssize_t TLSv12::handle_server_hello(ReadonlyBytes buffer, WritePacketStage& writ
                 res += sni_name_length;
                 dbgln("SNI host_name: {}", m_context.extensions.SNI);
             }
-        } else if (extension_type == HandshakeExtension::ApplicationLayerProtocolNegotiation && m_context.alpn.size()) {
-            if (buffer.size() - res > 2) {
-                auto alpn_length = AK::convert_between_host_and_network_endian(ByteReader::load16(buffer.offset_pointer(res)));
-                if (alpn_length && alpn_length <= extension_length - 2) {
-                    u8 const* alpn = buffer.offset_pointer(res + 2);
-                    size_t alpn_position = 0;
-                    while (alpn_position < alpn_length) {
-                        u8 alpn_size = alpn[alpn_position++];
-                        if (alpn_size + alpn_position >= extension_length)
-                            break;
-                        DeprecatedString alpn_str { (char const*)alpn + alpn_position, alpn_length };
-                        if (alpn_size && m_context.alpn.contains_slow(alpn_str)) {
-                            m_context.negotiated_alpn = alpn_str;
-                            dbgln("negotiated alpn: {}", alpn_str);
-                            break;
-                        }
-                        alpn_position += alpn_length;
-                        if (!m_context.is_server) // server hello must contain one ALPN
-                            break;
-                    }
-                }
+        } else if (extension_type == HandshakeExtension::ApplicationLayerProtocolNegotiation && !m_context.options.alpn_protocols.is_empty()) {
+            // RFC7301 section 3.1: The server hello contains exactly one of the protocols we offered.
+            if (extension_length >= 3) {
+                auto protocol_list_length = AK::convert_between_host_and_network_endian(ByteReader::load16(buffer.offset_pointer(res)));
+                u8 protocol_length = buffer[res + 2];
+                if (protocol_list_length + 2u != extension_length || protocol_length + 1u != protocol_list_length)
+                    return (i8)Error::BrokenPacket;
+
+                DeprecatedString protocol { (char const*)buffer.offset_pointer(res + 3), protocol_length };
+                if (!m_context.options.alpn_protocols.contains_slow(protocol))
+                    return (i8)Error::NotUnderstood;
+
+                m_context.negotiated_alpn = move(protocol);
+                dbgln_if(TLS_DEBUG, "Negotiated ALPN: {}", m_context.negotiated_alpn);
             }
             res += extension_length;
         } else if (extension_type == HandshakeExtension::SignatureAlgorithms) {
@@ -187,15 +180,52 @@ ssize_t TLSv12::handle_server_hello(ReadonlyBytes buffer, WritePacketStage& writ
             // uncompressed points. Therefore, this extension can be safely ignored as it should always inform us
             // that the server supports uncompressed points.
             res += extension_length;
+        } else if (extension_type == HandshakeExtension::SessionTicket) {
+            // RFC 5077 section 3.2: The server will send a NewSessionTicket message, which is all we need to know.
+            res += extension_length;
         } else {
             dbgln("Encountered unknown extension {} with length {}", (u16)extension_type, extension_length);
             res += extension_length;
         }
     }
 
+    // An abbreviated handshake goes straight to the server's ChangeCipherSpec and Finished.
+    if (try_resume_offered_session({ m_context.session_id, m_context.session_id_size }))
+        m_context.connection_status = ConnectionStatus::KeyExchange;
+
     return res;
 }
 
+// RFC 5077 section 3.3
+ssize_t TLSv12::handle_new_session_ticket(ReadonlyBytes buffer)
+{
+    if (buffer.size() < 3)
+        return (i8)Error::NeedMoreData;
+
+    size_t size = buffer[0] * 0x10000 + buffer[1] * 0x100 + buffer[2];
+
+    if (buffer.size() - 3 < size)
+        return (i8)Error::NeedMoreData;
+
+    if (size < 6)
+        return (i8)Error::BrokenPacket;
+
+    auto lifetime_hint = AK::convert_between_host_and_network_endian(ByteReader::load32(buffer.offset_pointer(3)));
+    size_t ticket_length = AK::convert_between_host_and_network_endian(ByteReader::load16(buffer.offset_pointer(7)));
+    if (6 + ticket_length != size)
+        return (i8)Error::BrokenPacket;
+
+    // An empty ticket means the server changed its mind about giving us one.
+    auto ticket = ByteBuffer::copy(buffer.slice(9, ticket_length));
+    if (ticket.is_error())
+        return (i8)Error::OutOfMemory;
+
+    m_context.new_session_ticket = ticket.release_value();
+    m_context.new_session_ticket_lifetime_hint = lifetime_hint;
+
+    return size + 3;
+}
+
 ssize_t TLSv12::handle_server_hello_done(ReadonlyBytes buffer)
 {
     if (buffer.size() < 3)
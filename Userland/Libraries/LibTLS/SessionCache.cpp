@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Hex.h>
+#include <LibCore/DateTime.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <LibTLS/SessionCache.h>
+
+namespace TLS {
+
+SessionCache::Session const* SessionCache::find_session(StringView host)
+{
+    auto it = m_sessions.find(host);
+    if (it == m_sessions.end())
+        return nullptr;
+
+    if (it->value.expiry_timestamp <= Core::DateTime::now().timestamp()) {
+        m_sessions.remove(it);
+        return nullptr;
+    }
+
+    return &it->value;
+}
+
+void SessionCache::store_session(StringView host, Session session)
+{
+    if (m_sessions.size() >= MaximumCachedSessions && !m_sessions.contains(host)) {
+        // Make room by dropping the session that expires first.
+        auto oldest = m_sessions.begin();
+        for (auto it = m_sessions.begin(); it != m_sessions.end(); ++it) {
+            if (it->value.expiry_timestamp < oldest->value.expiry_timestamp)
+                oldest = it;
+        }
+        m_sessions.remove(oldest);
+    }
+
+    m_sessions.set(host, move(session));
+}
+
+void SessionCache::remove_session(StringView host)
+{
+    m_sessions.remove(host);
+}
+
+DeprecatedString SessionCache::verified_chain_key(StringView host, Vector<Certificate> const& chain)
+{
+    Crypto::Hash::SHA256 hash;
+    for (auto& certificate : chain)
+        hash.update(certificate.original_asn1);
+    auto digest = hash.digest();
+
+    return DeprecatedString::formatted("{} {}", host, encode_hex(digest.bytes()));
+}
+
+// Only the signatures are vouched for, the caller still has to check that the certificates have not expired.
+bool SessionCache::has_verified_chain(StringView host, Vector<Certificate> const& chain) const
+{
+    return m_verified_chains.contains(verified_chain_key(host, chain));
+}
+
+void SessionCache::add_verified_chain(StringView host, Vector<Certificate> const& chain)
+{
+    if (m_verified_chains.size() >= MaximumVerifiedChains)
+        m_verified_chains.clear();
+
+    m_verified_chains.set(verified_chain_key(host, chain));
+}
+
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/DeprecatedString.h>
+#include <AK/HashMap.h>
+#include <AK/HashTable.h>
+#include <AK/RefCounted.h>
+#include <LibTLS/Certificate.h>
+#include <LibTLS/CipherSuite.h>
+
+namespace TLS {
+
+// Remembers, per host, what a client needs to resume a session with an abbreviated handshake (RFC 5246 section 7.3,
+// and RFC 5077 for session tickets), and which certificate chains were already verified.
+// A cache can be shared by any number of connections made from the same thread, as long as they trust the same roots.
+class SessionCache : public RefCounted<SessionCache> {
+public:
+    struct Session {
+        // Empty if the server only gave us a ticket.
+        ByteBuffer session_id;
+        ByteBuffer ticket;
+        CipherSuite cipher { CipherSuite::Invalid };
+        ByteBuffer master_key;
+        time_t expiry_timestamp { 0 };
+    };
+
+    static NonnullRefPtr<SessionCache> create() { return adopt_ref(*new SessionCache); }
+
+    Session const* find_session(StringView host);
+    void store_session(StringView host, Session);
+    void remove_session(StringView host);
+
+    bool has_verified_chain(StringView host, Vector<Certificate> const&) const;
+    void add_verified_chain(StringView host, Vector<Certificate> const&);
+
+    // Servers usually keep sessions around for a lot less than the day RFC 5246 allows.
+    static constexpr time_t MaximumSessionLifetimeInSeconds = 2 * 60 * 60;
+
+private:
+    SessionCache() = default;
+
+    static constexpr size_t MaximumCachedSessions = 256;
+    static constexpr size_t MaximumVerifiedChains = 256;
+
+    static DeprecatedString verified_chain_key(StringView host, Vector<Certificate> const&);
+
+    HashMap<DeprecatedString, Session> m_sessions;
+    HashTable<DeprecatedString> m_verified_chains;
+};
+
+}
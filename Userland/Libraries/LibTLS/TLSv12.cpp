@@ -257,6 +257,18 @@ bool Context::verify_chain(StringView host) const
         return false;
     }
 
+    // The signatures of a chain that was verified before don't need to be checked again, only its validity period.
+    auto& session_cache = options.session_cache;
+    if (session_cache && session_cache->has_verified_chain(host, *local_chain)) {
+        for (auto& cert : *local_chain) {
+            if (!cert.is_valid()) {
+                dbgln("verify_chain: Certificate is not valid {}", cert.subject_identifier_string());
+                return false;
+            }
+        }
+        return true;
+    }
+
     for (size_t cert_index = 0; cert_index < local_chain->size(); ++cert_index) {
         auto cert = local_chain->at(cert_index);
 
@@ -279,6 +291,8 @@ bool Context::verify_chain(StringView host) const
             }
 
             // Root certificate reached, and correctly verified, so we can stop now
+            if (session_cache)
+                session_cache->add_verified_chain(host, *local_chain);
             return true;
         }
 
@@ -19,6 +19,7 @@
 #include <LibCrypto/Hash/HashManager.h>
 #include <LibCrypto/PK/RSA.h>
 #include <LibTLS/CipherSuite.h>
+#include <LibTLS/SessionCache.h>
 #include <LibTLS/TLSPacketBuilder.h>
 
 namespace TLS {
@@ -123,6 +124,7 @@ enum HandshakeType {
     ClientHello = 0x01,
     ServerHello = 0x02,
     HelloVerifyRequest = 0x03,
+    NewSessionTicket = 0x04,
     CertificateMessage = 0x0b,
     ServerKeyExchange = 0x0c,
     CertificateRequest = 0x0d,
@@ -138,6 +140,7 @@ enum class HandshakeExtension : u16 {
     ECPointFormats = 0x0b,
     SignatureAlgorithms = 0x0d,
     ApplicationLayerProtocolNegotiation = 0x10,
+    SessionTicket = 0x23,
 };
 
 enum class NameType : u8 {
@@ -260,6 +263,9 @@ struct Options {
     OPTION_WITH_DEFAULTS(Function<void(AlertDescription)>, alert_handler, [](auto) {})
     OPTION_WITH_DEFAULTS(Function<void()>, finish_callback, [] {})
     OPTION_WITH_DEFAULTS(Function<Vector<Certificate>()>, certificate_provider, [] { return Vector<Certificate> {}; })
+    OPTION_WITH_DEFAULTS(RefPtr<SessionCache>, session_cache, )
+    // Offered in order of preference, e.g. { "h2", "http/1.1" }.
+    OPTION_WITH_DEFAULTS(Vector<DeprecatedString>, alpn_protocols, )
 
 #undef OPTION_WITH_DEFAULTS
 };
@@ -323,13 +329,18 @@ struct Context {
     bool close_notify { false };
     bool has_invoked_finish_or_error_callback { false };
 
+    // Session resumption, the session we offered in the ClientHello and the ticket the server gave us for the next one.
+    Optional<SessionCache::Session> offered_session;
+    bool is_resuming_session { false };
+    ByteBuffer new_session_ticket;
+    u32 new_session_ticket_lifetime_hint { 0 };
+
     // message flags
-    u8 handshake_messages[11] { 0 };
+    u8 handshake_messages[12] { 0 };
     ByteBuffer user_data;
     HashMap<DeprecatedString, Certificate> root_certificates;
 
-    Vector<DeprecatedString> alpn;
-    StringView negotiated_alpn;
+    DeprecatedString negotiated_alpn;
 
     size_t send_retries { 0 };
 
@@ -468,6 +479,7 @@ private:
     void notify_client_for_app_data();
 
     ssize_t handle_server_hello(ReadonlyBytes, WritePacketStage&);
+    ssize_t handle_new_session_ticket(ReadonlyBytes);
     ssize_t handle_handshake_finished(ReadonlyBytes, WritePacketStage&);
     ssize_t handle_certificate(ReadonlyBytes);
     ssize_t handle_server_key_exchange(ReadonlyBytes);
@@ -552,6 +564,10 @@ private:
 
     bool compute_master_secret_from_pre_master_secret(size_t length);
 
+    void offer_cached_session();
+    bool try_resume_offered_session(ReadonlyBytes session_id);
+    void store_session_in_cache();
+
     void try_disambiguate_error() const;
 
     bool m_eof { false };
@@ -40,6 +40,25 @@ private:
 // Helper to hide implementation of TestSuite from users
 void add_test_case_to_suite(NonnullRefPtr<TestCase> const& test_case);
 void set_suite_setup_function(Function<void()> setup);
+
+// Benchmarks can pass the results they don't otherwise use to this, so the compiler can't optimize away computing them.
+template<typename T>
+ALWAYS_INLINE void do_not_optimize(T const& value)
+{
+    asm volatile(""
+                 :
+                 : "r"(&value)
+                 : "memory");
+}
+
+// Makes the compiler assume that all memory was read and written here, so stores before it can't be elided.
+ALWAYS_INLINE void clobber_memory()
+{
+    asm volatile(""
+                 :
+                 :
+                 : "memory");
+}
 }
 
 #define TEST_SETUP                                   \
@@ -8,7 +8,13 @@
 #include <LibTest/Macros.h> // intentionally first -- we redefine VERIFY and friends in here
 
 #include <AK/Function.h>
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/Math.h>
+#include <AK/QuickSort.h>
+#include <AK/Time.h>
 #include <LibCore/ArgsParser.h>
+#include <LibCore/File.h>
 #include <LibTest/TestSuite.h>
 #include <stdlib.h>
 #include <sys/time.h>
@@ -66,13 +72,30 @@ int TestSuite::main(DeprecatedString const& suite_name, Span<StringView> argumen
     bool do_benchmarks_only = false;
     bool do_list_cases = false;
     StringView search_string = "*"sv;
+    Optional<size_t> benchmark_samples;
+    Optional<size_t> benchmark_warmup_runs;
+    Optional<size_t> benchmark_minimum_sample_time_ms;
+    StringView benchmark_json_path;
+    StringView benchmark_baseline_path;
+    double regression_threshold_percent = 5;
 
     args_parser.add_option(do_tests_only, "Only run tests.", "tests", 0);
     args_parser.add_option(do_benchmarks_only, "Only run benchmarks.", "bench", 0);
     args_parser.add_option(do_list_cases, "List available test cases.", "list", 0);
+    args_parser.add_option(benchmark_samples, "Time each benchmark this many times, and report statistics of the samples.", "samples", 0, "count");
+    args_parser.add_option(benchmark_warmup_runs, "Run each benchmark this many times before timing it (default: 1 with --samples, otherwise 0).", "warmup", 0, "count");
+    args_parser.add_option(benchmark_minimum_sample_time_ms, "Repeat a benchmark within a sample until the sample takes this long (default: 10 with --samples, otherwise 0).", "min-sample-time", 0, "ms");
+    args_parser.add_option(benchmark_json_path, "Write the benchmark results to a JSON file.", "json", 0, "path");
+    args_parser.add_option(benchmark_baseline_path, "Compare the benchmark results to a JSON file written by --json, and fail on regressions.", "baseline", 0, "path");
+    args_parser.add_option(regression_threshold_percent, "How much slower the median of a benchmark may get before it counts as a regression (default: 5).", "regression-threshold", 0, "percent");
     args_parser.add_positional_argument(search_string, "Only run matching cases.", "pattern", Core::ArgsParser::Required::No);
     args_parser.parse(arguments);
 
+    m_benchmark_samples = max<size_t>(benchmark_samples.value_or(1), 1);
+    bool is_sampling = benchmark_samples.has_value();
+    m_benchmark_warmup_runs = benchmark_warmup_runs.value_or(is_sampling ? 1 : 0);
+    m_benchmark_minimum_sample_time_ms = benchmark_minimum_sample_time_ms.value_or(is_sampling ? 10 : 0);
+
     if (m_setup)
         m_setup();
 
@@ -88,7 +111,25 @@ int TestSuite::main(DeprecatedString const& suite_name, Span<StringView> argumen
 
     outln("Running {} cases out of {}.", matching_tests.size(), m_cases.size());
 
-    return run(matching_tests);
+    auto failed_count = run(matching_tests);
+
+    if (!benchmark_json_path.is_empty()) {
+        if (auto result = write_benchmark_results(benchmark_json_path); result.is_error()) {
+            warnln("Failed to write the benchmark results to {}: {}", benchmark_json_path, result.error());
+            return 1;
+        }
+    }
+
+    if (!benchmark_baseline_path.is_empty()) {
+        auto regression_count = compare_benchmark_results_to_baseline(benchmark_baseline_path, regression_threshold_percent);
+        if (regression_count.is_error()) {
+            warnln("Failed to compare the benchmark results to {}: {}", benchmark_baseline_path, regression_count.error());
+            return 1;
+        }
+        failed_count += regression_count.value();
+    }
+
+    return failed_count;
 }
 
 NonnullRefPtrVector<TestCase> TestSuite::find_cases(DeprecatedString const& search, bool find_tests, bool find_benchmarks)
@@ -124,9 +165,14 @@ int TestSuite::run(NonnullRefPtrVector<TestCase> const& tests)
         warnln("Running {} '{}'.", test_type, t.name());
         m_current_test_case_passed = true;
 
-        TestElapsedTimer timer;
-        t.func()();
-        auto const time = timer.elapsed_milliseconds();
+        u64 time = 0;
+        if (t.is_benchmark()) {
+            time = run_benchmark(t);
+        } else {
+            TestElapsedTimer timer;
+            t.func()();
+            time = timer.elapsed_milliseconds();
+        }
 
         dbgln("{} {} '{}' in {}ms", m_current_test_case_passed ? "Completed" : "Failed", test_type, t.name(), time);
 
@@ -155,4 +201,142 @@ int TestSuite::run(NonnullRefPtrVector<TestCase> const& tests)
     return (int)test_failed_count;
 }
 
+static DeprecatedString format_duration(double nanoseconds)
+{
+    if (nanoseconds < 1'000)
+        return DeprecatedString::formatted("{:.1}ns", nanoseconds);
+    if (nanoseconds < 1'000'000)
+        return DeprecatedString::formatted("{:.2}us", nanoseconds / 1'000);
+    if (nanoseconds < 1'000'000'000)
+        return DeprecatedString::formatted("{:.2}ms", nanoseconds / 1'000'000);
+    return DeprecatedString::formatted("{:.2}s", nanoseconds / 1'000'000'000);
+}
+
+u64 TestSuite::run_benchmark(TestCase const& benchmark)
+{
+    u64 total_time_ns = 0;
+    auto time_runs = [&](size_t run_count) {
+        auto start = Time::now_monotonic();
+        for (size_t i = 0; i < run_count && m_current_test_case_passed; ++i)
+            benchmark.func()();
+        auto time_ns = static_cast<u64>((Time::now_monotonic() - start).to_nanoseconds());
+        total_time_ns += time_ns;
+        return time_ns;
+    };
+
+    for (size_t i = 0; i < m_benchmark_warmup_runs && m_current_test_case_passed; ++i)
+        (void)time_runs(1);
+
+    // Find out how many runs it takes for a sample to be long enough. The last attempt becomes the first sample.
+    constexpr size_t max_runs_per_sample = 1'000'000'000;
+    u64 minimum_sample_time_ns = m_benchmark_minimum_sample_time_ms * 1'000'000;
+    size_t runs_per_sample = 1;
+    Vector<double> samples;
+    while (m_current_test_case_passed) {
+        auto time_ns = time_runs(runs_per_sample);
+        if (time_ns >= minimum_sample_time_ns || runs_per_sample >= max_runs_per_sample) {
+            samples.append(static_cast<double>(time_ns) / runs_per_sample);
+            break;
+        }
+        // Aim a bit past the minimum, but grow by at most 10x at once in case the first runs weren't representative.
+        auto estimate = time_ns == 0 ? runs_per_sample * 10 : static_cast<size_t>(runs_per_sample * 1.2 * minimum_sample_time_ns / time_ns);
+        runs_per_sample = clamp(estimate, runs_per_sample + 1, min(runs_per_sample * 10, max_runs_per_sample));
+    }
+
+    while (samples.size() < m_benchmark_samples && m_current_test_case_passed)
+        samples.append(static_cast<double>(time_runs(runs_per_sample)) / runs_per_sample);
+
+    if (!m_current_test_case_passed)
+        return total_time_ns / 1'000'000;
+
+    quick_sort(samples);
+    BenchmarkResult result;
+    result.name = benchmark.name();
+    result.runs_per_sample = runs_per_sample;
+    result.sample_count = samples.size();
+    result.minimum_ns = samples.first();
+    result.median_ns = samples.size() % 2 == 1 ? samples[samples.size() / 2] : (samples[samples.size() / 2 - 1] + samples[samples.size() / 2]) / 2;
+    // The nearest-rank 99th percentile, which is the maximum for less than 100 samples.
+    result.p99_ns = samples[(samples.size() * 99 + 99) / 100 - 1];
+
+    for (auto sample : samples)
+        result.mean_ns += sample;
+    result.mean_ns /= samples.size();
+    if (samples.size() > 1) {
+        double squared_deviations = 0;
+        for (auto sample : samples)
+            squared_deviations += (sample - result.mean_ns) * (sample - result.mean_ns);
+        result.standard_deviation_ns = AK::sqrt(squared_deviations / (samples.size() - 1));
+    }
+
+    if (m_benchmark_samples > 1) {
+        outln("{}: {} samples of {} runs, min {}, median {}, p99 {}, mean {}, stddev {}",
+            result.name, result.sample_count, result.runs_per_sample,
+            format_duration(result.minimum_ns), format_duration(result.median_ns), format_duration(result.p99_ns),
+            format_duration(result.mean_ns), format_duration(result.standard_deviation_ns));
+    }
+
+    m_benchmark_results.append(move(result));
+    return total_time_ns / 1'000'000;
+}
+
+ErrorOr<void> TestSuite::write_benchmark_results(StringView path) const
+{
+    JsonArray benchmarks;
+    for (auto const& result : m_benchmark_results) {
+        JsonObject object;
+        object.set("name", result.name);
+        object.set("runs_per_sample", result.runs_per_sample);
+        object.set("samples", result.sample_count);
+        object.set("min_ns", result.minimum_ns);
+        object.set("median_ns", result.median_ns);
+        object.set("p99_ns", result.p99_ns);
+        object.set("mean_ns", result.mean_ns);
+        object.set("stddev_ns", result.standard_deviation_ns);
+        benchmarks.append(move(object));
+    }
+
+    JsonObject results;
+    results.set("suite", m_suite_name);
+    results.set("benchmarks", move(benchmarks));
+
+    auto file = TRY(Core::File::open(path, Core::File::OpenMode::Write));
+    TRY(file->write_entire_buffer(results.to_deprecated_string().bytes()));
+    return {};
+}
+
+ErrorOr<size_t> TestSuite::compare_benchmark_results_to_baseline(StringView path, double regression_threshold_percent) const
+{
+    auto file = TRY(Core::File::open(path, Core::File::OpenMode::Read));
+    auto baseline = TRY(JsonValue::from_string(TRY(file->read_until_eof())));
+    if (!baseline.is_object() || !baseline.as_object().get_array("benchmarks"sv).has_value())
+        return Error::from_string_literal("Not a file of benchmark results");
+    auto const& baseline_benchmarks = baseline.as_object().get_array("benchmarks"sv).value();
+
+    size_t regression_count = 0;
+    for (auto const& result : m_benchmark_results) {
+        Optional<double> baseline_median_ns;
+        baseline_benchmarks.for_each([&](auto const& value) {
+            if (value.is_object() && value.as_object().get_deprecated_string("name"sv) == result.name)
+                baseline_median_ns = value.as_object().get("median_ns"sv).value_or(JsonValue {}).to_double();
+        });
+
+        if (!baseline_median_ns.has_value() || baseline_median_ns.value() <= 0) {
+            outln("{}: Not in the baseline", result.name);
+            continue;
+        }
+
+        auto change_percent = (result.median_ns / baseline_median_ns.value() - 1) * 100;
+        bool is_regression = change_percent > regression_threshold_percent;
+        if (is_regression)
+            ++regression_count;
+        outln("{}: Median {} against {} in the baseline ({:+.1}%){}",
+            result.name, format_duration(result.median_ns), format_duration(baseline_median_ns.value()), change_percent,
+            is_regression ? ", regressed" : "");
+    }
+
+    outln("Out of {} benchmarks, {} regressed against the baseline.", m_benchmark_results.size(), regression_count);
+    return regression_count;
+}
+
 }
@@ -12,6 +12,8 @@
 #include <AK/DeprecatedString.h>
 #include <AK/Function.h>
 #include <AK/NonnullRefPtrVector.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
 #include <LibTest/TestCase.h>
 
 namespace Test {
@@ -45,6 +47,23 @@ public:
     void set_suite_setup(Function<void()> setup) { m_setup = move(setup); }
 
 private:
+    // Every sample times a number of consecutive runs of the benchmark, which is picked so a sample takes long enough to
+    // be measured reliably. The statistics are of the time one run took in each of the samples.
+    struct BenchmarkResult {
+        DeprecatedString name;
+        size_t runs_per_sample { 1 };
+        size_t sample_count { 0 };
+        double minimum_ns { 0 };
+        double median_ns { 0 };
+        double p99_ns { 0 };
+        double mean_ns { 0 };
+        double standard_deviation_ns { 0 };
+    };
+
+    u64 run_benchmark(TestCase const&);
+    ErrorOr<void> write_benchmark_results(StringView path) const;
+    ErrorOr<size_t> compare_benchmark_results_to_baseline(StringView path, double regression_threshold_percent) const;
+
     static TestSuite* s_global;
     NonnullRefPtrVector<TestCase> m_cases;
     u64 m_testtime = 0;
@@ -52,6 +71,11 @@ private:
     DeprecatedString m_suite_name;
     bool m_current_test_case_passed = true;
     Function<void()> m_setup;
+
+    size_t m_benchmark_warmup_runs { 0 };
+    size_t m_benchmark_samples { 1 };
+    u64 m_benchmark_minimum_sample_time_ms { 0 };
+    Vector<BenchmarkResult> m_benchmark_results;
 };
 
 }
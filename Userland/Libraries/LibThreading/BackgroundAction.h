@@ -29,6 +29,8 @@ class BackgroundActionBase {
 private:
     BackgroundActionBase() = default;
 
+    // NOTE: Actions run one after the other on a single background thread, and existing users rely on that to share
+    //       state between their actions without locking. Independent work that may run in parallel belongs on ThreadPool.
     static void enqueue_work(Function<void()>);
     static Thread& background_thread();
 };
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibThreading/ReadAheadStream.h>
+
+namespace Threading {
+
+ErrorOr<NonnullOwnPtr<ReadAheadStream>> ReadAheadStream::create(NonnullOwnPtr<Stream> stream, size_t chunk_size, size_t max_chunk_count)
+{
+    VERIFY(chunk_size > 0 && max_chunk_count > 0);
+    auto read_ahead_stream = TRY(adopt_nonnull_own_or_enomem(new (nothrow) ReadAheadStream(move(stream), chunk_size, max_chunk_count)));
+    read_ahead_stream->m_thread = Thread::construct([stream = read_ahead_stream.ptr()] { return stream->read_ahead(); }, "ReadAheadStream"sv);
+    read_ahead_stream->m_thread->start();
+    return read_ahead_stream;
+}
+
+ReadAheadStream::ReadAheadStream(NonnullOwnPtr<Stream> stream, size_t chunk_size, size_t max_chunk_count)
+    : m_stream(move(stream))
+    , m_chunk_size(chunk_size)
+    , m_max_chunk_count(max_chunk_count)
+{
+}
+
+ReadAheadStream::~ReadAheadStream()
+{
+    {
+        MutexLocker locker(m_mutex);
+        m_stopping = true;
+        m_chunk_taken.signal();
+    }
+    if (m_thread && m_thread->needs_to_be_joined())
+        (void)m_thread->join();
+}
+
+intptr_t ReadAheadStream::read_ahead()
+{
+    for (;;) {
+        {
+            MutexLocker locker(m_mutex);
+            while (!m_stopping && m_chunks.size() >= m_max_chunk_count)
+                m_chunk_taken.wait();
+            if (m_stopping)
+                return 0;
+        }
+
+        // Fill up a whole chunk, so that the reading side doesn't have to wake up for every small read.
+        auto chunk_or_error = ByteBuffer::create_uninitialized(m_chunk_size);
+        Optional<Error> error;
+        size_t filled = 0;
+        if (chunk_or_error.is_error()) {
+            error = chunk_or_error.release_error();
+        } else {
+            auto& chunk = chunk_or_error.value();
+            while (filled < chunk.size() && !m_stream->is_eof()) {
+                auto bytes_or_error = m_stream->read(chunk.bytes().slice(filled));
+                if (bytes_or_error.is_error()) {
+                    error = bytes_or_error.release_error();
+                    break;
+                }
+                // A stream that has nothing more to give (like a decompressor with truncated input) may not say that
+                // it's at its end, so an empty read ends the stream, too.
+                if (bytes_or_error.value().is_empty())
+                    break;
+                filled += bytes_or_error.value().size();
+            }
+        }
+
+        MutexLocker locker(m_mutex);
+        if (filled > 0) {
+            auto chunk = chunk_or_error.release_value();
+            chunk.resize(filled);
+            m_chunks.enqueue(move(chunk));
+        }
+        if (error.has_value() || filled == 0 || m_stream->is_eof()) {
+            m_error = move(error);
+            m_finished = true;
+            m_chunk_added.signal();
+            return 0;
+        }
+        m_chunk_added.signal();
+    }
+}
+
+ErrorOr<Bytes> ReadAheadStream::read(Bytes bytes)
+{
+    if (m_current_chunk_offset >= m_current_chunk.size()) {
+        MutexLocker locker(m_mutex);
+        while (m_chunks.is_empty() && !m_finished)
+            m_chunk_added.wait();
+
+        if (m_chunks.is_empty()) {
+            // Errors are handed out after all of the data that was read before them.
+            if (m_error.has_value())
+                return m_error.release_value();
+            m_is_eof = true;
+            return bytes.trim(0);
+        }
+
+        m_current_chunk = m_chunks.dequeue();
+        m_current_chunk_offset = 0;
+        m_chunk_taken.signal();
+    }
+
+    auto size = min(bytes.size(), m_current_chunk.size() - m_current_chunk_offset);
+    m_current_chunk.bytes().slice(m_current_chunk_offset, size).copy_to(bytes);
+    m_current_chunk_offset += size;
+    return bytes.trim(size);
+}
+
+bool ReadAheadStream::is_eof() const
+{
+    return m_is_eof;
+}
+
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/Queue.h>
+#include <AK/Stream.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/Thread.h>
+
+namespace Threading {
+
+// Reads from another stream on a thread of its own, a few chunks ahead of whoever reads from this one.
+// Wrapping a stream that is expensive to read from, like a decompressor, lets that work overlap with whatever
+// is done with the data that has already been read.
+class ReadAheadStream final : public Stream {
+public:
+    static ErrorOr<NonnullOwnPtr<ReadAheadStream>> create(NonnullOwnPtr<Stream>, size_t chunk_size = 256 * KiB, size_t max_chunk_count = 4);
+    virtual ~ReadAheadStream() override;
+
+    virtual ErrorOr<Bytes> read(Bytes) override;
+    virtual ErrorOr<size_t> write(ReadonlyBytes) override { return Error::from_errno(EBADF); }
+    virtual bool is_eof() const override;
+    virtual bool is_open() const override { return true; }
+    virtual void close() override { }
+
+private:
+    ReadAheadStream(NonnullOwnPtr<Stream>, size_t chunk_size, size_t max_chunk_count);
+
+    intptr_t read_ahead();
+
+    NonnullOwnPtr<Stream> m_stream;
+    size_t m_chunk_size { 0 };
+    size_t m_max_chunk_count { 0 };
+    RefPtr<Thread> m_thread;
+
+    Mutex m_mutex;
+    ConditionVariable m_chunk_added { m_mutex };
+    ConditionVariable m_chunk_taken { m_mutex };
+    Queue<ByteBuffer> m_chunks;
+    // Set once the stream has been read to its end, or reading from it failed.
+    bool m_finished { false };
+    Optional<Error> m_error;
+    bool m_stopping { false };
+
+    // The chunk that's being read from right now, which only the reading side touches.
+    ByteBuffer m_current_chunk;
+    size_t m_current_chunk_offset { 0 };
+    bool m_is_eof { false };
+};
+
+}
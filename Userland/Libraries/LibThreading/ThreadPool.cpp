@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/AtomicRefCounted.h>
+#include <AK/DeprecatedString.h>
+#include <LibThreading/ThreadPool.h>
+#include <unistd.h>
+
+namespace Threading {
+
+static thread_local ThreadPool* s_current_pool;
+static thread_local size_t s_current_worker_index;
+
+ThreadPool& ThreadPool::the()
+{
+    static ThreadPool* s_the = new ThreadPool(max(sysconf(_SC_NPROCESSORS_ONLN), 1l));
+    return *s_the;
+}
+
+ThreadPool::ThreadPool(size_t worker_count)
+{
+    VERIFY(worker_count > 0);
+
+    m_workers.ensure_capacity(worker_count);
+    for (size_t i = 0; i < worker_count; ++i)
+        m_workers.unchecked_append(make<Worker>());
+
+    // Only start the threads once all of the workers exist, as they immediately start looking for work to steal.
+    for (size_t i = 0; i < worker_count; ++i) {
+        auto& worker = *m_workers[i];
+        worker.thread = Thread::construct([this, i] { return worker_loop(i); }, DeprecatedString::formatted("Pool Worker {}", i));
+        worker.thread->start();
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        MutexLocker locker(m_mutex);
+        m_should_exit = true;
+        m_work_available.broadcast();
+    }
+    for (auto& worker : m_workers)
+        (void)worker->thread->join();
+}
+
+void ThreadPool::submit(Function<void()> task)
+{
+    // Work that a task spawns is most likely to touch the same data as the task itself, so it stays on the same
+    // worker. Everything else is spread out over the workers in turn.
+    auto index = s_current_pool == this
+        ? s_current_worker_index
+        : m_next_worker.fetch_add(1, AK::MemoryOrder::memory_order_relaxed) % worker_count();
+
+    auto& worker = *m_workers[index];
+    {
+        MutexLocker locker(worker.mutex);
+        worker.tasks.append(move(task));
+    }
+
+    // Idle workers count themselves before they look at m_pending_tasks for the last time, so either they see
+    // the new task, or we see them and wake one up.
+    m_pending_tasks.fetch_add(1);
+    if (m_idle_workers.load() != 0) {
+        MutexLocker locker(m_mutex);
+        m_work_available.signal();
+    }
+}
+
+Function<void()> ThreadPool::Worker::take_newest_task()
+{
+    MutexLocker locker(mutex);
+    if (first_task == tasks.size())
+        return {};
+    auto task = tasks.take_last();
+    if (first_task == tasks.size()) {
+        tasks.clear_with_capacity();
+        first_task = 0;
+    }
+    return task;
+}
+
+Function<void()> ThreadPool::Worker::take_oldest_task()
+{
+    MutexLocker locker(mutex);
+    if (first_task == tasks.size())
+        return {};
+    auto task = move(tasks[first_task++]);
+    if (first_task == tasks.size()) {
+        tasks.clear_with_capacity();
+        first_task = 0;
+    }
+    return task;
+}
+
+Function<void()> ThreadPool::take_task(size_t worker_index)
+{
+    auto task = m_workers[worker_index]->take_newest_task();
+    for (size_t i = 1; !task && i < worker_count(); ++i)
+        task = m_workers[(worker_index + i) % worker_count()]->take_oldest_task();
+
+    if (task)
+        m_pending_tasks.fetch_sub(1);
+    return task;
+}
+
+intptr_t ThreadPool::worker_loop(size_t index)
+{
+    s_current_pool = this;
+    s_current_worker_index = index;
+
+    for (;;) {
+        if (auto task = take_task(index)) {
+            task();
+            continue;
+        }
+
+        MutexLocker locker(m_mutex);
+        m_idle_workers.fetch_add(1);
+        while (m_pending_tasks.load() == 0 && !m_should_exit)
+            m_work_available.wait();
+        m_idle_workers.fetch_sub(1);
+
+        if (m_pending_tasks.load() == 0 && m_should_exit)
+            return 0;
+    }
+}
+
+namespace {
+
+// The state of one parallel_for(). Workers that pick up a helper task after all chunks have been claimed may
+// still look at it once the parallel_for() has returned, which is why it's reference counted.
+struct ParallelJob : public AtomicRefCounted<ParallelJob> {
+    ParallelJob(size_t count, size_t chunk_count, Function<void(size_t, size_t)> const& body)
+        : count(count)
+        , chunk_count(chunk_count)
+        , body(body)
+    {
+    }
+
+    void run_chunks()
+    {
+        for (;;) {
+            auto chunk = next_chunk.fetch_add(1);
+            if (chunk >= chunk_count)
+                return;
+
+            auto chunk_size = count / chunk_count;
+            auto remainder = count % chunk_count;
+            auto begin = chunk * chunk_size + min(chunk, remainder);
+            auto end = begin + chunk_size + (chunk < remainder ? 1 : 0);
+            body(begin, end);
+
+            if (finished_chunks.fetch_add(1) + 1 == chunk_count) {
+                MutexLocker locker(mutex);
+                finished.broadcast();
+            }
+        }
+    }
+
+    void wait_until_finished()
+    {
+        MutexLocker locker(mutex);
+        while (finished_chunks.load() != chunk_count)
+            finished.wait();
+    }
+
+    size_t const count;
+    size_t const chunk_count;
+    // Only valid while there are unfinished chunks.
+    Function<void(size_t, size_t)> const& body;
+
+    Atomic<size_t> next_chunk { 0 };
+    Atomic<size_t> finished_chunks { 0 };
+    Mutex mutex;
+    ConditionVariable finished { mutex };
+};
+
+}
+
+void ThreadPool::run_in_parallel(size_t count, Function<void(size_t, size_t)> const& body)
+{
+    if (count == 0)
+        return;
+
+    // A few chunks per thread, so that it all evens out when some of them take longer than others.
+    auto chunk_count = min(count, (worker_count() + 1) * 4);
+    if (chunk_count == 1) {
+        body(0, count);
+        return;
+    }
+
+    auto job = adopt_ref(*new ParallelJob(count, chunk_count, body));
+    for (size_t i = 0; i < min(worker_count(), chunk_count - 1); ++i)
+        submit([job] { job->run_chunks(); });
+
+    // The calling thread helps out as well. Apart from making use of it, this guarantees progress
+    // when we're called from a worker and all of the other workers are busy.
+    job->run_chunks();
+    job->wait_until_finished();
+}
+
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Function.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Span.h>
+#include <AK/Vector.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/Thread.h>
+
+namespace Threading {
+
+// A fixed set of worker threads that run submitted tasks.
+//
+// Every worker has its own queue of tasks. Tasks submitted from inside a worker go to that worker's queue,
+// which it works through newest first, while their data is still in the cache. A worker that runs out of
+// work steals the oldest task of another worker, so independent jobs spread out over all of the workers
+// without everybody contending on a single queue.
+class ThreadPool {
+    AK_MAKE_NONCOPYABLE(ThreadPool);
+    AK_MAKE_NONMOVABLE(ThreadPool);
+
+public:
+    // The pool shared by the whole process, with one worker per processor.
+    static ThreadPool& the();
+
+    explicit ThreadPool(size_t worker_count);
+    // Finishes all tasks that have been submitted so far, then stops the workers.
+    ~ThreadPool();
+
+    size_t worker_count() const { return m_workers.size(); }
+
+    void submit(Function<void()>);
+
+    // Calls `body(index)` for every index in [0, count), spread out over the workers and the calling thread,
+    // and returns once all of the calls have finished. This is fine to call from inside a task, too.
+    template<typename Callback>
+    void parallel_for(size_t count, Callback body)
+    {
+        run_in_parallel(count, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+                body(i);
+        });
+    }
+
+    template<typename T, typename Callback>
+    void parallel_for_each(Span<T> values, Callback body)
+    {
+        parallel_for(values.size(), [&](size_t i) { body(values[i]); });
+    }
+
+private:
+    struct Worker {
+        Function<void()> take_newest_task();
+        Function<void()> take_oldest_task();
+
+        Mutex mutex;
+        // Tasks before first_task have already been stolen.
+        Vector<Function<void()>> tasks;
+        size_t first_task { 0 };
+        RefPtr<Thread> thread;
+    };
+
+    void run_in_parallel(size_t count, Function<void(size_t begin, size_t end)> const&);
+
+    intptr_t worker_loop(size_t index);
+    Function<void()> take_task(size_t worker_index);
+
+    Vector<NonnullOwnPtr<Worker>> m_workers;
+    Atomic<size_t> m_next_worker { 0 };
+
+    // Number of tasks that have been submitted, but not picked up by a worker yet.
+    Atomic<size_t> m_pending_tasks { 0 };
+    Atomic<size_t> m_idle_workers { 0 };
+    Mutex m_mutex;
+    ConditionVariable m_work_available { m_mutex };
+    bool m_should_exit { false };
+};
+
+}
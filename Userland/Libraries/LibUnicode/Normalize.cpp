@@ -6,6 +6,7 @@
 
 #include <AK/Find.h>
 #include <AK/QuickSort.h>
+#include <AK/UnicodeUtils.h>
 #include <AK/Utf8View.h>
 #include <AK/Vector.h>
 #include <LibUnicode/CharacterTypes.h>
@@ -21,6 +22,7 @@ namespace Unicode {
 
 Optional<CodePointDecomposition const> __attribute__((weak)) code_point_decomposition(u32) { return {}; }
 Optional<CodePointDecomposition const> __attribute__((weak)) code_point_decomposition_by_index(size_t) { return {}; }
+Optional<u32> __attribute__((weak)) code_point_composition(u32, u32) { return {}; }
 
 NormalizationForm normalization_form_from_string(StringView form)
 {
@@ -125,26 +127,9 @@ static u32 combine_hangul_code_points(u32 a, u32 b)
     return 0;
 }
 
-static u32 combine_code_points([[maybe_unused]] u32 a, [[maybe_unused]] u32 b)
+static u32 combine_code_points(u32 a, u32 b)
 {
-#if ENABLE_UNICODE_DATA
-    Array<u32, 2> const points { a, b };
-
-    // FIXME: Do something better than linear search to find reverse mappings.
-    for (size_t index = 0;; ++index) {
-        auto mapping_maybe = Unicode::code_point_decomposition_by_index(index);
-        if (!mapping_maybe.has_value())
-            break;
-        auto& mapping = mapping_maybe.value();
-        if (mapping.tag == CompatibilityFormattingTag::Canonical && mapping.decomposition == points) {
-            if (code_point_has_property(mapping.code_point, Property::Full_Composition_Exclusion))
-                continue;
-            return mapping.code_point;
-        }
-    }
-#endif
-
-    return 0;
+    return Unicode::code_point_composition(a, b).value_or(0);
 }
 
 enum class UseCompatibility {
@@ -209,46 +194,51 @@ static void canonical_ordering_algorithm(Span<u32> code_points)
     }
 }
 
-// See Section 3.11, D115 of Version 15.0.0 of the Unicode Standard.
-static bool is_blocked(Span<u32> code_points, size_t a, size_t c)
-{
-    if (!is_starter(code_points[a]) || a == c - 1)
-        return false;
-    auto const c_combining_class = Unicode::canonical_combining_class(code_points[c]);
-    auto const b_combining_class = Unicode::canonical_combining_class(code_points[c - 1]);
-    return b_combining_class == 0 || b_combining_class >= c_combining_class;
-}
-
 // The Canonical Composition Algorithm, as specified in Version 15.0.0 of the Unicode Standard.
 // See Section 3.11, D117; and UAX #15 https://unicode.org/reports/tr15
 // https://www.unicode.org/versions/Unicode15.0.0/ch03.pdf#G50628
 static void canonical_composition_algorithm(Vector<u32>& code_points)
 {
+    if (code_points.is_empty())
+        return;
+
+    // The code points are composed in place: code points that are composed into the last starter are dropped, and
+    // the remaining ones are moved down to fill the gaps.
+    size_t last_starter_index = 0;
+    // The combining class of the last code point that was kept, or 256 if nothing can be composed with a starter
+    // until the next one.
+    u32 last_combining_class = is_starter(code_points[0]) ? 0 : 256;
+    size_t output_index = 1;
+
     for (size_t i = 1; i < code_points.size(); ++i) {
         auto const current_character = code_points[i];
-        // R1. Seek back (left) to find the last Starter L preceding C in the character sequence
-        for (ssize_t j = i - 1; j >= 0; --j) {
-            if (!is_starter(code_points[j]))
-                continue;
-            // R2. If there is such an L, and C is not blocked from L,
-            //     and there exists a Primary Composite P which is canonically equivalent to <L, C>,
-            //     then replace L by P in the sequence and delete C from the sequence.
-            if (is_blocked(code_points.span(), j, i))
-                continue;
+        auto const combining_class = Unicode::canonical_combining_class(current_character);
 
-            auto composite = combine_hangul_code_points(code_points[j], current_character);
+        // R1. Seek back (left) to find the last Starter L preceding C in the character sequence
+        // R2. If there is such an L, and C is not blocked from L,
+        //     and there exists a Primary Composite P which is canonically equivalent to <L, C>,
+        //     then replace L by P in the sequence and delete C from the sequence.
+        // See Section 3.11, D115 for when C is blocked from L. As the code points between L and C are in canonical
+        // order, it's enough to look at the last one of them.
+        if (last_combining_class < combining_class || last_combining_class == 0) {
+            auto composite = combine_hangul_code_points(code_points[last_starter_index], current_character);
 
             if (composite == 0)
-                composite = combine_code_points(code_points[j], current_character);
+                composite = combine_code_points(code_points[last_starter_index], current_character);
 
             if (composite != 0) {
-                code_points[j] = composite;
-                code_points.remove(i);
-                --i;
-                break;
+                code_points[last_starter_index] = composite;
+                continue;
             }
         }
+
+        if (combining_class == 0)
+            last_starter_index = output_index;
+        last_combining_class = combining_class;
+        code_points[output_index++] = current_character;
     }
+
+    code_points.shrink(output_index);
 }
 
 static ErrorOr<Vector<u32>> normalize_nfd(Utf8View string)
@@ -302,11 +292,83 @@ static ErrorOr<Vector<u32>> normalize_implementation(Utf8View string, Normalizat
     VERIFY_NOT_REACHED();
 }
 
+// The quick check algorithm, which tells whether a string is already normalized without normalizing it. A "maybe" is
+// treated as a "no", so those strings are normalized the long way.
+// https://www.unicode.org/reports/tr15/#Detecting_Normalization_Forms
+static bool is_certainly_normalized([[maybe_unused]] Utf8View string, [[maybe_unused]] NormalizationForm form)
+{
+#if ENABLE_UNICODE_DATA
+    auto quick_check_property = Property::NFC_QC;
+    // None of the code points below this one change in the normalization form, nor can they be composed with anything
+    // that precedes them.
+    u32 first_code_point_to_check = 0x300;
+
+    switch (form) {
+    case NormalizationForm::NFD:
+        quick_check_property = Property::NFD_QC;
+        first_code_point_to_check = 0xc0;
+        break;
+    case NormalizationForm::NFC:
+        break;
+    case NormalizationForm::NFKD:
+        quick_check_property = Property::NFKD_QC;
+        first_code_point_to_check = 0xa0;
+        break;
+    case NormalizationForm::NFKC:
+        quick_check_property = Property::NFKC_QC;
+        first_code_point_to_check = 0xa0;
+        break;
+    }
+
+    // NOTE: The string has been validated by the caller.
+    auto bytes = string.as_string().bytes();
+    u32 last_combining_class = 0;
+    for (size_t offset = 0; offset < bytes.size();) {
+        // Runs of ASCII are skipped over in bulk, as they are below any of the above.
+        if (auto ascii_length = AK::UnicodeUtils::count_leading_ascii_bytes(bytes.slice(offset)); ascii_length > 0) {
+            offset += ascii_length;
+            last_combining_class = 0;
+            continue;
+        }
+
+        auto iterator = string.iterator_at_byte_offset_without_validation(offset);
+        auto code_point = *iterator;
+        offset += iterator.underlying_code_point_length_in_bytes();
+
+        if (code_point < first_code_point_to_check) {
+            last_combining_class = 0;
+            continue;
+        }
+
+        auto combining_class = Unicode::canonical_combining_class(code_point);
+        if (combining_class != 0 && last_combining_class > combining_class)
+            return false;
+        // The property is set for the code points whose quick check value is "no" or "maybe".
+        if (code_point_has_property(code_point, quick_check_property))
+            return false;
+
+        last_combining_class = combining_class;
+    }
+
+    return true;
+#else
+    return false;
+#endif
+}
+
 ErrorOr<String> normalize(StringView string, NormalizationForm form)
 {
-    auto const code_points = TRY(normalize_implementation(Utf8View { string }, form));
+    // ASCII text is the same in every normalization form, which makes it by far the most common case.
+    if (AK::UnicodeUtils::count_leading_ascii_bytes(string.bytes()) == string.length())
+        return String::from_utf8(string);
+
+    Utf8View view { string };
+    if (view.validate() && is_certainly_normalized(view, form))
+        return String::from_utf8(string);
+
+    auto const code_points = TRY(normalize_implementation(view, form));
 
-    StringBuilder builder;
+    auto builder = TRY(StringBuilder::create(code_points.size()));
     for (auto code_point : code_points)
         TRY(builder.try_append_code_point(code_point));
 
@@ -18,6 +18,7 @@ namespace Unicode {
 
 Optional<CodePointDecomposition const> code_point_decomposition(u32 code_point);
 Optional<CodePointDecomposition const> code_point_decomposition_by_index(size_t index);
+Optional<u32> code_point_composition(u32 first_code_point, u32 second_code_point);
 
 enum class NormalizationForm {
     NFD,
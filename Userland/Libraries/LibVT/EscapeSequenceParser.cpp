@@ -16,6 +16,21 @@ EscapeSequenceParser::EscapeSequenceParser(EscapeSequenceExecutor& executor)
 {
 }
 
+void EscapeSequenceParser::on_input(ReadonlyBytes bytes)
+{
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        // Most output is plain text, which would only ever take the state machine from Ground to Ground with a Print
+        // action. Emit those bytes directly instead of looking each of them up in the transition table.
+        if (m_state_machine.is_in_initial_state()) {
+            while (i < bytes.size() && bytes[i] >= 0x20 && bytes[i] <= 0x7f)
+                m_executor.emit_code_point(bytes[i++]);
+            if (i == bytes.size())
+                break;
+        }
+        on_input(bytes[i]);
+    }
+}
+
 Vector<EscapeSequenceParser::OscParameter> EscapeSequenceParser::osc_parameters() const
 {
     VERIFY(m_osc_raw.size() >= m_osc_parameter_indexes.last());
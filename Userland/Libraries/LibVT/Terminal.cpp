@@ -981,6 +981,11 @@ void Terminal::on_input(u8 byte)
     m_parser.on_input(byte);
 }
 
+void Terminal::on_input(ReadonlyBytes bytes)
+{
+    m_parser.on_input(bytes);
+}
+
 void Terminal::emit_code_point(u32 code_point)
 {
     auto working_set = m_working_sets[m_active_working_set_index];
@@ -1313,8 +1318,7 @@ void Terminal::execute_dcs_sequence()
 
 void Terminal::inject_string(StringView str)
 {
-    for (size_t i = 0; i < str.length(); ++i)
-        on_input(str[i]);
+    on_input(str.bytes());
 }
 
 void Terminal::emit_string(StringView string)
@@ -76,6 +76,7 @@ public:
 #endif
 
     void on_input(u8);
+    void on_input(ReadonlyBytes);
 
     void set_cursor(unsigned row, unsigned column, bool skip_debug = false);
 
@@ -40,6 +40,9 @@
 
 namespace VT {
 
+static constexpr int flush_interval_ms = 16;
+static constexpr size_t pty_read_buffer_size = 16 * KiB;
+
 void TerminalWidget::set_pty_master_fd(int fd)
 {
     m_ptm_fd = fd;
@@ -49,7 +52,7 @@ void TerminalWidget::set_pty_master_fd(int fd)
     }
     m_notifier = Core::Notifier::construct(m_ptm_fd, Core::Notifier::Read);
     m_notifier->on_ready_to_read = [this] {
-        u8 buffer[BUFSIZ];
+        u8 buffer[pty_read_buffer_size];
         ssize_t nread = read(m_ptm_fd, buffer, sizeof(buffer));
         if (nread < 0) {
             dbgln("Terminal read error: {}", strerror(errno));
@@ -68,9 +71,8 @@ void TerminalWidget::set_pty_master_fd(int fd)
             set_pty_master_fd(-1);
             return;
         }
-        for (ssize_t i = 0; i < nread; ++i)
-            m_terminal.on_input(buffer[i]);
-        flush_dirty_lines();
+        m_terminal.on_input({ buffer, static_cast<size_t>(nread) });
+        schedule_flush_dirty_lines();
     };
 }
 
@@ -92,6 +94,8 @@ TerminalWidget::TerminalWidget(int ptm_fd, bool automatic_size_policy)
     m_cursor_blink_timer = add<Core::Timer>();
     m_visual_beep_timer = add<Core::Timer>();
     m_auto_scroll_timer = add<Core::Timer>();
+    m_flush_dirty_lines_timer = add<Core::Timer>(flush_interval_ms, [this] { flush_dirty_lines(); });
+    m_flush_dirty_lines_timer->set_single_shot(true);
 
     m_scrollbar = add<GUI::Scrollbar>(Orientation::Vertical);
     m_scrollbar->set_scroll_animation(GUI::Scrollbar::Animation::CoarseScroll);
@@ -480,8 +484,24 @@ void TerminalWidget::invalidate_cursor()
     m_terminal.invalidate_cursor();
 }
 
+void TerminalWidget::schedule_flush_dirty_lines()
+{
+    // Output can arrive much faster than it can be shown, so the dirty lines are flushed at most once per frame
+    // instead of after every read. A flush that's due right away (e.g. for an echoed keystroke) still happens at once.
+    if (m_flush_dirty_lines_timer->is_active())
+        return;
+    if (!m_time_since_last_flush.is_valid() || m_time_since_last_flush.elapsed() >= flush_interval_ms) {
+        flush_dirty_lines();
+        return;
+    }
+    m_flush_dirty_lines_timer->start(static_cast<int>(flush_interval_ms - m_time_since_last_flush.elapsed()));
+}
+
 void TerminalWidget::flush_dirty_lines()
 {
+    m_time_since_last_flush.start();
+    m_flush_dirty_lines_timer->stop();
+
     // FIXME: Update smarter when scrolled
     if (m_terminal.m_need_full_flush || m_scrollbar->value() != m_scrollbar->max()) {
         update();
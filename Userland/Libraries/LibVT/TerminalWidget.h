@@ -38,6 +38,7 @@ public:
     }
 
     void flush_dirty_lines();
+    void schedule_flush_dirty_lines();
 
     void apply_size_increments_to_window(GUI::Window&);
 
@@ -223,6 +224,7 @@ private:
     RefPtr<Core::Timer> m_cursor_blink_timer;
     RefPtr<Core::Timer> m_visual_beep_timer;
     RefPtr<Core::Timer> m_auto_scroll_timer;
+    RefPtr<Core::Timer> m_flush_dirty_lines_timer;
 
     RefPtr<GUI::Scrollbar> m_scrollbar;
 
@@ -234,6 +236,7 @@ private:
     RefPtr<GUI::Menu> m_context_menu_for_hyperlink;
 
     Core::ElapsedTimer m_triple_click_timer;
+    Core::ElapsedTimer m_time_since_last_flush;
 
     Gfx::IntPoint m_left_mousedown_position;
     VT::Position m_left_mousedown_position_buffer;
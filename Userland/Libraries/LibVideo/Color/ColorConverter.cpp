@@ -5,6 +5,7 @@
  */
 
 #include <AK/Math.h>
+#include <AK/SIMDMath.h>
 #include <AK/StdLibExtras.h>
 #include <LibGfx/Matrix4x4.h>
 #include <LibVideo/Color/ColorPrimaries.h>
@@ -203,41 +204,46 @@ ALWAYS_INLINE FloatVector4 max_zero(FloatVector4 vector)
 // Referencing https://en.wikipedia.org/wiki/YCbCr
 Gfx::Color ColorConverter::convert_yuv_to_full_range_rgb(u16 y, u16 u, u16 v)
 {
-    FloatVector4 color_vector = { static_cast<float>(y), static_cast<float>(u), static_cast<float>(v), 1.0f };
-    color_vector = m_input_conversion_matrix * color_vector;
+    auto converted = m_input_conversion_columns[0] * static_cast<float>(y)
+        + m_input_conversion_columns[1] * static_cast<float>(u)
+        + m_input_conversion_columns[2] * static_cast<float>(v)
+        + m_input_conversion_columns[3];
 
     if (m_should_skip_color_remapping) {
-        color_vector.clamp(0.0f, 1.0f);
-    } else {
-        color_vector = max_zero(color_vector);
-        color_vector = m_to_linear_lookup.do_lookup(color_vector);
-
-        if (m_cicp.transfer_characteristics() == TransferCharacteristics::HLG) {
-            static auto hlg_ootf_lookup_table = InterpolatedLookupTable<32, 1000>::create(
-                [](float value) {
-                    return AK::pow(value, 1.2f - 1.0f);
-                });
-            // See: https://en.wikipedia.org/wiki/Hybrid_log-gamma under a bolded section "HLG reference OOTF"
-            float luminance = (0.2627f * color_vector.x() + 0.6780f * color_vector.y() + 0.0593f * color_vector.z()) * 1000.0f;
-            float coefficient = hlg_ootf_lookup_table.do_lookup(luminance);
-            color_vector = { color_vector.x() * coefficient, color_vector.y() * coefficient, color_vector.z() * coefficient, 1.0f };
-        }
-
-        // FIXME: We could implement gamut compression here:
-        //        https://github.com/jedypod/gamut-compress/blob/master/docs/gamut-compress-algorithm.md
-        //        This would allow the color values outside the output gamut to be
-        //        preserved relative to values within the gamut instead of clipping. The
-        //        downside is that this requires a pass over the image before conversion
-        //        back into gamut is done to find the maximum color values to compress.
-        //        The compression would have to be somewhat temporally consistent as well.
-        color_vector = m_color_space_conversion_matrix * color_vector;
-        color_vector = max_zero(color_vector);
-        if (m_should_tonemap)
-            color_vector = hable_tonemapping(color_vector);
-        color_vector = m_to_non_linear_lookup.do_lookup(color_vector);
-        color_vector = max_zero(color_vector);
+        // This is what practically all videos end up doing, so keep the whole conversion in vector registers.
+        converted = AK::SIMD::clamp(converted, 0.0f, 1.0f) * 255.0f;
+        return Gfx::Color(static_cast<u8>(converted[0]), static_cast<u8>(converted[1]), static_cast<u8>(converted[2]));
+    }
+
+    FloatVector4 color_vector = { converted[0], converted[1], converted[2], converted[3] };
+    color_vector = max_zero(color_vector);
+    color_vector = m_to_linear_lookup.do_lookup(color_vector);
+
+    if (m_cicp.transfer_characteristics() == TransferCharacteristics::HLG) {
+        static auto hlg_ootf_lookup_table = InterpolatedLookupTable<32, 1000>::create(
+            [](float value) {
+                return AK::pow(value, 1.2f - 1.0f);
+            });
+        // See: https://en.wikipedia.org/wiki/Hybrid_log-gamma under a bolded section "HLG reference OOTF"
+        float luminance = (0.2627f * color_vector.x() + 0.6780f * color_vector.y() + 0.0593f * color_vector.z()) * 1000.0f;
+        float coefficient = hlg_ootf_lookup_table.do_lookup(luminance);
+        color_vector = { color_vector.x() * coefficient, color_vector.y() * coefficient, color_vector.z() * coefficient, 1.0f };
     }
 
+    // FIXME: We could implement gamut compression here:
+    //        https://github.com/jedypod/gamut-compress/blob/master/docs/gamut-compress-algorithm.md
+    //        This would allow the color values outside the output gamut to be
+    //        preserved relative to values within the gamut instead of clipping. The
+    //        downside is that this requires a pass over the image before conversion
+    //        back into gamut is done to find the maximum color values to compress.
+    //        The compression would have to be somewhat temporally consistent as well.
+    color_vector = m_color_space_conversion_matrix * color_vector;
+    color_vector = max_zero(color_vector);
+    if (m_should_tonemap)
+        color_vector = hable_tonemapping(color_vector);
+    color_vector = m_to_non_linear_lookup.do_lookup(color_vector);
+    color_vector = max_zero(color_vector);
+
     u8 r = static_cast<u8>(color_vector.x() * 255.0f);
     u8 g = static_cast<u8>(color_vector.y() * 255.0f);
     u8 b = static_cast<u8>(color_vector.z() * 255.0f);
@@ -8,6 +8,7 @@
 
 #include <AK/Array.h>
 #include <AK/Function.h>
+#include <AK/SIMD.h>
 #include <LibGfx/Color.h>
 #include <LibGfx/Matrix4x4.h>
 #include <LibVideo/Color/CodingIndependentCodePoints.h>
@@ -75,16 +76,28 @@ private:
         , m_should_skip_color_remapping(should_skip_color_remapping)
         , m_should_tonemap(should_tonemap)
         , m_input_conversion_matrix(input_conversion_matrix)
+        , m_input_conversion_columns(columns_of(input_conversion_matrix))
         , m_to_linear_lookup(move(to_linear_lookup))
         , m_color_space_conversion_matrix(color_space_conversion_matrix)
         , m_to_non_linear_lookup(move(to_non_linear_lookup))
     {
     }
+    static Array<AK::SIMD::f32x4, 4> columns_of(FloatMatrix4x4 const& matrix)
+    {
+        auto const& elements = matrix.elements();
+        Array<AK::SIMD::f32x4, 4> columns;
+        for (size_t column = 0; column < 4; column++)
+            columns[column] = AK::SIMD::f32x4 { elements[0][column], elements[1][column], elements[2][column], elements[3][column] };
+        return columns;
+    }
+
     u8 m_bit_depth;
     CodingIndependentCodePoints m_cicp;
     bool m_should_skip_color_remapping;
     bool m_should_tonemap;
     FloatMatrix4x4 m_input_conversion_matrix;
+    // The columns of the input conversion matrix, to apply it to a sample with one vectorized multiply-add per component.
+    Array<AK::SIMD::f32x4, 4> m_input_conversion_columns;
     InterpolatedLookupTable<to_linear_size> m_to_linear_lookup;
     FloatMatrix4x4 m_color_space_conversion_matrix;
     InterpolatedLookupTable<to_non_linear_size> m_to_non_linear_lookup;
@@ -81,6 +81,8 @@ constexpr u32 CUE_REFERENCE_ID = 0xDB;
 DecoderErrorOr<Reader> Reader::from_file(StringView path)
 {
     auto mapped_file = DECODER_TRY(DecoderErrorCategory::IO, Core::MappedFile::map(path));
+    // Playback reads through the file from start to end.
+    DECODER_TRY(DecoderErrorCategory::IO, mapped_file->set_access_pattern(Core::MappedFile::AccessPattern::Sequential));
     auto reader = TRY(from_data(mapped_file->bytes()));
     reader.m_mapped_file = mapped_file;
     return reader;
@@ -761,8 +763,11 @@ DecoderErrorOr<void> Reader::ensure_cues_are_parsed()
     if (m_cues_have_been_parsed)
         return {};
     auto position = TRY(find_first_top_level_element_with_id("Cues"sv, CUES_ID));
-    if (!position.has_value())
-        return DecoderError::corrupted("No Tracks element found"sv);
+    if (!position.has_value()) {
+        // Cues are optional, seeking will fall back to the cluster index.
+        m_cues_have_been_parsed = true;
+        return {};
+    }
     Streamer streamer { m_data };
     TRY_READ(streamer.seek_to_position(position.release_value()));
     TRY(parse_cues(streamer));
@@ -774,42 +779,91 @@ DecoderErrorOr<void> Reader::seek_to_cue_for_timestamp(SampleIterator& iterator,
 {
     auto const& cue_points = MUST(cue_points_for_track(iterator.m_track.track_number())).release_value();
 
-    // Take a guess at where in the cues the timestamp will be and correct from there.
-    auto duration = TRY(segment_information()).duration();
-    size_t index = 0;
-    if (duration.has_value())
-        index = clamp(((timestamp.to_nanoseconds() * cue_points.size()) / TRY(segment_information()).duration()->to_nanoseconds()), 0, cue_points.size() - 1);
+    // Find the last cue point at or before the timestamp. If the timestamp precedes all of them, use the first one.
+    size_t first_after = 0;
+    size_t end = cue_points.size();
+    while (first_after < end) {
+        auto middle = first_after + (end - first_after) / 2;
+        if (cue_points[middle].timestamp() <= timestamp)
+            first_after = middle + 1;
+        else
+            end = middle;
+    }
 
-    CuePoint const* prev_cue_point = &cue_points[index];
-    dbgln_if(MATROSKA_DEBUG, "Finding Matroska cue points for timestamp {}ms starting from cue at {}ms", timestamp.to_milliseconds(), prev_cue_point->timestamp().to_milliseconds());
+    auto const& cue_point = cue_points[first_after > 0 ? first_after - 1 : 0];
+    dbgln_if(MATROSKA_DEBUG, "Found Matroska cue point at {}ms for timestamp {}ms", cue_point.timestamp().to_milliseconds(), timestamp.to_milliseconds());
+    TRY(iterator.seek_to_cue_point(cue_point));
+    return {};
+}
 
-    if (prev_cue_point->timestamp() == timestamp) {
-        TRY(iterator.seek_to_cue_point(*prev_cue_point));
+DecoderErrorOr<void> Reader::ensure_cluster_index_is_built()
+{
+    if (m_cluster_index_has_been_built)
         return {};
-    }
 
-    if (prev_cue_point->timestamp() > timestamp) {
-        while (index > 0 && prev_cue_point->timestamp() > timestamp) {
-            prev_cue_point = &cue_points[--index];
-            dbgln_if(MATROSKA_DEBUG, "Checking previous cue point {}ms", prev_cue_point->timestamp().to_milliseconds());
+    auto first_cluster_position = TRY(find_first_top_level_element_with_id("Cluster"sv, CLUSTER_ELEMENT_ID));
+    if (!first_cluster_position.has_value())
+        return DecoderError::corrupted("No clusters are present in the segment"sv);
+    auto timestamp_scale = TRY(segment_information()).timestamp_scale();
+
+    Streamer streamer { m_data.slice(m_segment_contents_position, m_segment_contents_size) };
+    TRY_READ(streamer.seek_to_position(first_cluster_position.value() - get_element_id_size(CLUSTER_ELEMENT_ID) - m_segment_contents_position));
+
+    m_cluster_index.clear();
+    while (streamer.has_octet()) {
+        auto element_position = streamer.position();
+        auto element_id = TRY_READ(streamer.read_variable_size_integer(false));
+        auto element_contents_position = streamer.position();
+
+        if (element_id == CLUSTER_ELEMENT_ID) {
+            auto cluster = TRY(parse_cluster(streamer, timestamp_scale));
+            DECODER_TRY_ALLOC(m_cluster_index.try_append({ cluster.timestamp(), element_position }));
+            TRY_READ(streamer.seek_to_position(element_contents_position));
         }
-        TRY(iterator.seek_to_cue_point(*prev_cue_point));
-        return {};
+
+        TRY_READ(streamer.read_unknown_element());
+    }
+
+    dbgln_if(MATROSKA_DEBUG, "Built an index of {} clusters", m_cluster_index.size());
+    m_cluster_index_has_been_built = true;
+    return {};
+}
+
+DecoderErrorOr<void> Reader::seek_to_cluster_for_timestamp(SampleIterator& iterator, Time const& timestamp)
+{
+    TRY(ensure_cluster_index_is_built());
+    VERIFY(!m_cluster_index.is_empty());
+
+    // Find the last cluster starting at or before the timestamp.
+    size_t first_after = 0;
+    size_t end = m_cluster_index.size();
+    while (first_after < end) {
+        auto middle = first_after + (end - first_after) / 2;
+        if (m_cluster_index[middle].timestamp <= timestamp)
+            first_after = middle + 1;
+        else
+            end = middle;
     }
 
-    while (++index < cue_points.size()) {
-        auto const& cue_point = cue_points[index];
-        dbgln_if(MATROSKA_DEBUG, "Checking future cue point {}ms", cue_point.timestamp().to_milliseconds());
-        if (cue_point.timestamp() > timestamp)
+    // That cluster may not contain a keyframe for our track, so walk backwards until we find one.
+    size_t index = first_after > 0 ? first_after - 1 : 0;
+    while (true) {
+        auto const& entry = m_cluster_index[index];
+        iterator.seek_to_cluster(entry.position, entry.timestamp);
+        dbgln_if(MATROSKA_DEBUG, "Searching for a keyframe before {}ms in the cluster at {}ms", timestamp.to_milliseconds(), entry.timestamp.to_milliseconds());
+        if (TRY(search_clusters_for_keyframe_before_timestamp(iterator, timestamp)))
+            return {};
+        if (index == 0)
             break;
-        prev_cue_point = &cue_point;
+        index--;
     }
 
-    TRY(iterator.seek_to_cue_point(*prev_cue_point));
+    // There are no keyframes before the timestamp, so start from the beginning.
+    iterator.seek_to_cluster(m_cluster_index[0].position, m_cluster_index[0].timestamp);
     return {};
 }
 
-static DecoderErrorOr<void> search_clusters_for_keyframe_before_timestamp(SampleIterator& iterator, Time const& timestamp)
+DecoderErrorOr<bool> Reader::search_clusters_for_keyframe_before_timestamp(SampleIterator& iterator, Time const& timestamp)
 {
 #if MATROSKA_DEBUG
     size_t inter_frames_count;
@@ -818,31 +872,39 @@ static DecoderErrorOr<void> search_clusters_for_keyframe_before_timestamp(Sample
 
     while (true) {
         SampleIterator rewind_iterator = iterator;
-        auto block = TRY(iterator.next_block());
+        auto block_result = iterator.next_block();
+        if (block_result.is_error()) {
+            // The timestamp is past the last block, so the last keyframe we found is the one we're looking for.
+            if (block_result.error().category() == DecoderErrorCategory::EndOfStream)
+                break;
+            return block_result.release_error();
+        }
+        auto block = block_result.release_value();
+
+        if (block.timestamp() > timestamp)
+            break;
 
         if (block.only_keyframes()) {
             last_keyframe.emplace(rewind_iterator);
+            last_keyframe->m_last_timestamp = block.timestamp();
 #if MATROSKA_DEBUG
             inter_frames_count = 0;
 #endif
         }
 
-        if (block.timestamp() > timestamp)
-            break;
-
 #if MATROSKA_DEBUG
         inter_frames_count++;
 #endif
     }
 
-    if (last_keyframe.has_value()) {
+    if (!last_keyframe.has_value())
+        return false;
+
 #if MATROSKA_DEBUG
-        dbgln("Seeked to a keyframe with {} inter frames to skip", inter_frames_count);
+    dbgln("Seeked to a keyframe with {} inter frames to skip", inter_frames_count);
 #endif
-        iterator = last_keyframe.release_value();
-    }
-
-    return {};
+    iterator = last_keyframe.release_value();
+    return true;
 }
 
 DecoderErrorOr<bool> Reader::has_cues_for_track(u64 track_number)
@@ -855,18 +917,12 @@ DecoderErrorOr<SampleIterator> Reader::seek_to_random_access_point(SampleIterato
 {
     if (TRY(has_cues_for_track(iterator.m_track.track_number()))) {
         TRY(seek_to_cue_for_timestamp(iterator, timestamp));
-        VERIFY(iterator.last_timestamp().has_value() && iterator.last_timestamp().value() <= timestamp);
-        return iterator;
-    }
-
-    if (!iterator.last_timestamp().has_value() || timestamp < iterator.last_timestamp().value()) {
-        // If the timestamp is before the iterator's current position, then we need to start from the beginning of the Segment.
-        iterator = TRY(create_sample_iterator(iterator.m_track.track_number()));
-        TRY(search_clusters_for_keyframe_before_timestamp(iterator, timestamp));
+        VERIFY(iterator.last_timestamp().has_value());
         return iterator;
     }
 
-    TRY(search_clusters_for_keyframe_before_timestamp(iterator, timestamp));
+    TRY(seek_to_cluster_for_timestamp(iterator, timestamp));
+    VERIFY(iterator.last_timestamp().has_value());
     return iterator;
 }
 
@@ -938,6 +994,14 @@ DecoderErrorOr<void> SampleIterator::seek_to_cue_point(CuePoint const& cue_point
     return {};
 }
 
+void SampleIterator::seek_to_cluster(size_t position, Time timestamp)
+{
+    // The cluster will be parsed by the next call to next_block().
+    m_position = position;
+    m_current_cluster.clear();
+    m_last_timestamp = timestamp;
+}
+
 ErrorOr<DeprecatedString> Streamer::read_string()
 {
     auto string_length = TRY(read_variable_size_integer());
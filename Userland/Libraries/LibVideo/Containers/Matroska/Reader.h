@@ -59,6 +59,10 @@ private:
     DecoderErrorOr<void> ensure_cues_are_parsed();
     DecoderErrorOr<void> seek_to_cue_for_timestamp(SampleIterator&, Time const&);
 
+    DecoderErrorOr<void> ensure_cluster_index_is_built();
+    DecoderErrorOr<void> seek_to_cluster_for_timestamp(SampleIterator&, Time const&);
+    static DecoderErrorOr<bool> search_clusters_for_keyframe_before_timestamp(SampleIterator&, Time const&);
+
     RefPtr<Core::MappedFile> m_mapped_file;
     ReadonlyBytes m_data;
 
@@ -77,6 +81,16 @@ private:
     // The vectors must be sorted by timestamp at all times.
     HashMap<u64, Vector<CuePoint>> m_cues;
     bool m_cues_have_been_parsed { false };
+
+    // When there are no cues, seeking uses this index of the start timestamps of all the Clusters in the Segment instead.
+    // It only requires reading each Cluster's Timestamp element, so it can be built without touching any of the blocks.
+    struct ClusterIndexEntry {
+        Time timestamp;
+        // Relative to the start of the Segment's contents, pointing to the Cluster's element ID.
+        size_t position;
+    };
+    Vector<ClusterIndexEntry> m_cluster_index;
+    bool m_cluster_index_has_been_built { false };
 };
 
 class SampleIterator {
@@ -98,6 +112,7 @@ private:
     }
 
     DecoderErrorOr<void> seek_to_cue_point(CuePoint const& cue_point);
+    void seek_to_cluster(size_t position, Time timestamp);
 
     RefPtr<Core::MappedFile> m_file;
     ReadonlyBytes m_data;
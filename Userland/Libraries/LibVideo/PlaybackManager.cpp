@@ -223,7 +223,8 @@ bool PlaybackManager::decode_and_queue_one_sample()
         break;
     }
 
-    auto bitmap = TRY_OR_ENQUEUE_ERROR(decoded_frame->to_bitmap(), frame_sample->timestamp());
+    auto bitmap = TRY_OR_ENQUEUE_ERROR(acquire_frame_bitmap(decoded_frame->size()), frame_sample->timestamp());
+    TRY_OR_ENQUEUE_ERROR(decoded_frame->output_to_bitmap(bitmap), frame_sample->timestamp());
     m_frame_queue->enqueue(FrameQueueItem::frame(bitmap, frame_sample->timestamp()));
 
 #if PLAYBACK_MANAGER_DEBUG
@@ -234,6 +235,27 @@ bool PlaybackManager::decode_and_queue_one_sample()
     return true;
 }
 
+DecoderErrorOr<NonnullRefPtr<Gfx::Bitmap>> PlaybackManager::acquire_frame_bitmap(Gfx::IntSize size)
+{
+    Optional<size_t> unused_index;
+    for (size_t i = 0; i < m_frame_bitmap_pool.size(); i++) {
+        auto& bitmap = m_frame_bitmap_pool[i];
+        if (bitmap->ref_count() != 1)
+            continue;
+        if (bitmap->size() == size)
+            return bitmap;
+        unused_index = i;
+    }
+
+    // The frame size changed or all of the bitmaps are still in use, so we need a new one.
+    auto bitmap = DECODER_TRY_ALLOC(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, size));
+    if (unused_index.has_value())
+        m_frame_bitmap_pool[unused_index.value()] = bitmap;
+    else if (m_frame_bitmap_pool.size() < FRAME_BITMAP_POOL_SIZE)
+        m_frame_bitmap_pool.append(bitmap);
+    return bitmap;
+}
+
 void PlaybackManager::on_decode_timer()
 {
     if (!decode_and_queue_one_sample()) {
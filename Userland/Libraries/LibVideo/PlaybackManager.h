@@ -82,6 +82,9 @@ private:
 
 static constexpr size_t FRAME_BUFFER_COUNT = 4;
 using VideoFrameQueue = Queue<FrameQueueItem, FRAME_BUFFER_COUNT>;
+// Besides the queued frames, one frame may be waiting to be presented, one may be on its way to the event handler in a
+// VideoFramePresentEvent, and one is being displayed.
+static constexpr size_t FRAME_BITMAP_POOL_SIZE = FRAME_BUFFER_COUNT + 3;
 
 class PlaybackManager {
 public:
@@ -128,6 +131,7 @@ private:
     Optional<Time> seek_demuxer_to_most_recent_keyframe(Time timestamp, Optional<Time> earliest_available_sample = OptionalNone());
 
     bool decode_and_queue_one_sample();
+    DecoderErrorOr<NonnullRefPtr<Gfx::Bitmap>> acquire_frame_bitmap(Gfx::IntSize);
     void on_decode_timer();
 
     void dispatch_decoder_error(DecoderError error);
@@ -147,6 +151,9 @@ private:
     NonnullOwnPtr<VideoDecoder> m_decoder;
 
     NonnullOwnPtr<VideoFrameQueue> m_frame_queue;
+    // The bitmaps that decoded frames are converted into. Once nothing but the pool refers to one of them anymore, it has
+    // been presented and replaced, and can be reused for another frame.
+    Vector<NonnullRefPtr<Gfx::Bitmap>, FRAME_BITMAP_POOL_SIZE> m_frame_bitmap_pool;
 
     RefPtr<Core::Timer> m_present_timer;
     unsigned m_decoding_buffer_time_ms = 16;
@@ -20,6 +20,7 @@
 #include "Enums.h"
 #include "LookupTables.h"
 #include "MotionVector.h"
+#include "SyntaxElementCounter.h"
 #include "Utilities.h"
 
 namespace Video::VP9 {
@@ -187,18 +188,19 @@ static NonZeroTokensView create_non_zero_tokens_view(NonZeroTokens& non_zero_tok
 
 struct TileContext {
 public:
-    static ErrorOr<TileContext> try_create(FrameContext& frame_context, u32 tile_size, u32 rows_start, u32 rows_end, u32 columns_start, u32 columns_end, PartitionContextView above_partition_context, NonZeroTokensView above_non_zero_tokens, SegmentationPredictionContextView above_segmentation_ids)
+    static ErrorOr<TileContext> try_create(FrameContext& frame_context, ReadonlyBytes tile_data, SyntaxElementCounter& counter, u32 rows_start, u32 rows_end, u32 columns_start, u32 columns_end, PartitionContextView above_partition_context, NonZeroTokensView above_non_zero_tokens, SegmentationPredictionContextView above_segmentation_ids)
     {
         auto width = columns_end - columns_start;
         auto height = rows_end - rows_start;
         auto context_view = frame_context.m_block_contexts.view(rows_start, columns_start, height, width);
 
-        auto bit_stream = TRY(try_make<BigEndianInputBitStream>(TRY(try_make<FixedMemoryStream>(frame_context.stream))));
-        auto decoder = TRY(BooleanDecoder::initialize(move(bit_stream), tile_size));
+        auto bit_stream = TRY(try_make<BigEndianInputBitStream>(TRY(try_make<FixedMemoryStream>(tile_data))));
+        auto decoder = TRY(BooleanDecoder::initialize(move(bit_stream), tile_data.size()));
 
         return TileContext {
             frame_context,
             move(decoder),
+            counter,
             rows_start,
             rows_end,
             columns_start,
@@ -217,6 +219,8 @@ public:
 
     FrameContext const& frame_context;
     BooleanDecoder decoder;
+    // Shared by all tiles in a column, which are decoded on the same thread.
+    SyntaxElementCounter& counter;
     u32 rows_start { 0 };
     u32 rows_end { 0 };
     u32 columns_start { 0 };
@@ -249,6 +253,7 @@ struct BlockContext {
             .frame_context = tile_context.frame_context,
             .tile_context = tile_context,
             .decoder = tile_context.decoder,
+            .counter = tile_context.counter,
             .row = row,
             .column = column,
             .size = size,
@@ -265,6 +270,7 @@ struct BlockContext {
     FrameContext const& frame_context;
     TileContext const& tile_context;
     BooleanDecoder& decoder;
+    SyntaxElementCounter& counter;
     u32 row { 0 };
     u32 column { 0 };
     BlockSubsize size;
@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AllOf.h>
 #include <AK/IntegralMath.h>
 #include <LibGfx/Size.h>
 #include <LibVideo/Color/CodingIndependentCodePoints.h>
@@ -1083,18 +1084,21 @@ DecoderErrorOr<void> Decoder::reconstruct(u8 plane, BlockContext const& block_co
 
     // 1. Dequant[ i ][ j ] is set equal to ( Tokens[ i * n0 + j ] * get_ac_quant( plane ) ) / dqDenom
     //    for i = 0..(n0-1), for j = 0..(n0-1)
+    // 2. Dequant[ 0 ][ 0 ] is set equal to ( Tokens[ 0 ] * get_dc_quant( plane ) ) / dqDenom
+    // Note: The coefficients are usually clustered in the top left corner of the block, so we also note which rows
+    //       contain any of them to allow the row transforms to skip the rest.
     Array<Intermediate, maximum_transform_size> dequantized;
     Intermediate ac_quant = get_ac_quantizer(block_context, plane);
+    u32 non_zero_rows = 0;
     for (auto i = 0u; i < block_size; i++) {
         for (auto j = 0u; j < block_size; j++) {
             auto index = index_from_row_and_column(i, j, block_size);
-            if (index == 0)
-                continue;
-            dequantized[index] = (block_context.residual_tokens[index] * ac_quant) / dq_denominator;
+            auto token = block_context.residual_tokens[index];
+            dequantized[index] = (token * ac_quant) / dq_denominator;
+            if (token != 0)
+                non_zero_rows |= 1u << i;
         }
     }
-
-    // 2. Dequant[ 0 ][ 0 ] is set equal to ( Tokens[ 0 ] * get_dc_quant( plane ) ) / dqDenom
     dequantized[0] = (block_context.residual_tokens[0] * get_dc_quantizer(block_context, plane)) / dq_denominator;
 
     // It is a requirement of bitstream conformance that the values written into the Dequant array in steps 1 and 2
@@ -1102,13 +1106,13 @@ DecoderErrorOr<void> Decoder::reconstruct(u8 plane, BlockContext const& block_co
     // Note: Since bounds checks just ensure that we will not have resulting values that will overflow, it's non-fatal
     // to allow these bounds to be violated. Therefore, we can avoid the performance cost here.
 
-    // 3. Invoke the 2D inverse transform block process defined in section 8.7.2 with the variable n as input.
-    //    The inverse transform outputs are stored back to the Dequant buffer.
-    TRY(inverse_transform_2d(block_context, dequantized, log2_of_block_size, transform_set));
+    // Note: The predicted samples are always within the range of Clip1(), so adding a residual of all zeroes would
+    //       not change them.
+    if (non_zero_rows == 0)
+        return {};
 
-    // 4. CurrFrame[ plane ][ y + i ][ x + j ] is set equal to Clip1( CurrFrame[ plane ][ y + i ][ x + j ] + Dequant[ i ][ j ] )
-    //    for i = 0..(n0-1) and j = 0..(n0-1).
     auto& current_buffer = get_output_buffer(plane);
+    auto bit_depth = block_context.frame_context.color_config.bit_depth;
     auto subsampling_x = (plane > 0 ? block_context.frame_context.color_config.subsampling_x : 0);
     auto subsampling_y = (plane > 0 ? block_context.frame_context.color_config.subsampling_y : 0);
     auto frame_width = (block_context.frame_context.columns() * 8) >> subsampling_x;
@@ -1116,12 +1120,34 @@ DecoderErrorOr<void> Decoder::reconstruct(u8 plane, BlockContext const& block_co
     auto width_in_frame_buffer = min(block_size, frame_width - transform_block_x);
     auto height_in_frame_buffer = min(block_size, frame_height - transform_block_y);
 
-    for (auto i = 0u; i < height_in_frame_buffer; i++) {
-        for (auto j = 0u; j < width_in_frame_buffer; j++) {
-            auto index = index_from_row_and_column(transform_block_y + i, transform_block_x + j, frame_width);
-            auto dequantized_value = dequantized[index_from_row_and_column(i, j, block_size)];
-            current_buffer[index] = clip_1(block_context.frame_context.color_config.bit_depth, current_buffer[index] + dequantized_value);
+    // Note: When only the DC coefficient of a DCT_DCT block is set, every row transform but the first one outputs
+    //       zeroes, and the first one outputs Round2( Dequant[ 0 ][ 0 ] * cos64( 16 ), 14 ) for every sample. The column
+    //       transforms then all scale that value again, so the whole block receives the same residual.
+    bool is_dc_only = non_zero_rows == 1 && all_of(dequantized.span().slice(1, block_size - 1), [](auto value) { return value == 0; });
+    if (is_dc_only && transform_set.first_transform == TransformType::DCT && transform_set.second_transform == TransformType::DCT && !block_context.frame_context.is_lossless()) {
+        auto row_value = rounded_right_shift(static_cast<i64>(dequantized[0]) * cos64(16), 14);
+        auto column_value = rounded_right_shift(static_cast<i64>(row_value) * cos64(16), 14);
+        Intermediate residual = rounded_right_shift(column_value, min(6, log2_of_block_size + 2));
+
+        for (auto i = 0u; i < height_in_frame_buffer; i++) {
+            auto* frame_row = &current_buffer[index_from_row_and_column(transform_block_y + i, transform_block_x, frame_width)];
+            for (auto j = 0u; j < width_in_frame_buffer; j++)
+                frame_row[j] = clip_1(bit_depth, frame_row[j] + residual);
         }
+        return {};
+    }
+
+    // 3. Invoke the 2D inverse transform block process defined in section 8.7.2 with the variable n as input.
+    //    The inverse transform outputs are stored back to the Dequant buffer.
+    TRY(inverse_transform_2d(block_context, dequantized, log2_of_block_size, transform_set, non_zero_rows));
+
+    // 4. CurrFrame[ plane ][ y + i ][ x + j ] is set equal to Clip1( CurrFrame[ plane ][ y + i ][ x + j ] + Dequant[ i ][ j ] )
+    //    for i = 0..(n0-1) and j = 0..(n0-1).
+    for (auto i = 0u; i < height_in_frame_buffer; i++) {
+        auto* frame_row = &current_buffer[index_from_row_and_column(transform_block_y + i, transform_block_x, frame_width)];
+        auto const* residual_row = &dequantized[index_from_row_and_column(i, 0, block_size)];
+        for (auto j = 0u; j < width_in_frame_buffer; j++)
+            frame_row[j] = clip_1(bit_depth, frame_row[j] + residual_row[j]);
     }
 
     return {};
@@ -1628,7 +1654,7 @@ inline DecoderErrorOr<void> Decoder::inverse_asymmetric_discrete_sine_transform(
     return inverse_asymmetric_discrete_sine_transform_16(data);
 }
 
-DecoderErrorOr<void> Decoder::inverse_transform_2d(BlockContext const& block_context, Span<Intermediate> dequantized, u8 log2_of_block_size, TransformSet transform_set)
+DecoderErrorOr<void> Decoder::inverse_transform_2d(BlockContext const& block_context, Span<Intermediate> dequantized, u8 log2_of_block_size, TransformSet transform_set, u32 non_zero_rows)
 {
     // This process performs a 2D inverse transform for an array of size 2^n by 2^n stored in the 2D array Dequant.
     // The input to this process is a variable n (log2_of_block_size) that specifies the base 2 logarithm of the width of the transform.
@@ -1641,6 +1667,11 @@ DecoderErrorOr<void> Decoder::inverse_transform_2d(BlockContext const& block_con
 
     // 2. The row transforms with i = 0..(n0-1) are applied as follows:
     for (auto i = 0u; i < block_size; i++) {
+        // Note: All of the row transforms output zeroes for an input of zeroes, so rows without any coefficients can
+        //       be left as they are.
+        if ((non_zero_rows & (1u << i)) == 0)
+            continue;
+
         // 1. Set T[ j ] equal to Dequant[ i ][ j ] for j = 0..(n0-1).
         for (auto j = 0u; j < block_size; j++)
             row[j] = dequantized[index_from_row_and_column(i, j, block_size)];
@@ -33,6 +33,8 @@ DecoderErrorOr<void> SubsampledYUVFrame::output_to_bitmap(Gfx::Bitmap& bitmap)
     size_t uv_width = width >> m_subsampling_horizontal;
 
     auto converter = TRY(ColorConverter::create(bit_depth(), cicp()));
+    // The colors are opaque, so they can be stored as they are into both 32-bit BGR formats.
+    bool writes_scanlines_directly = bitmap.format() == Gfx::BitmapFormat::BGRx8888 || bitmap.format() == Gfx::BitmapFormat::BGRA8888;
 
     for (size_t row = 0; row < height; row++) {
         auto uv_row = row >> m_subsampling_vertical;
@@ -71,8 +73,16 @@ DecoderErrorOr<void> SubsampledYUVFrame::output_to_bitmap(Gfx::Bitmap& bitmap)
             }
         }
 
+        auto const* y_sample_row = &m_plane_y[row * width];
+        if (writes_scanlines_directly) {
+            auto* scanline = bitmap.scanline(row);
+            for (size_t column = 0; column < width; column++)
+                scanline[column] = converter.convert_yuv_to_full_range_rgb(y_sample_row[column], u_sample_row[column], v_sample_row[column]).value();
+            continue;
+        }
+
         for (size_t column = 0; column < width; column++) {
-            auto y_sample = m_plane_y[row * width + column];
+            auto y_sample = y_sample_row[column];
             auto u_sample = u_sample_row[column];
             auto v_sample = v_sample_row[column];
 
@@ -73,7 +73,7 @@ public:
     {
     }
 
-    using AnyValueType = Variant<i32, i64, float, double, Reference>;
+    using AnyValueType = Variant<i32, i64, float, double, u128, Reference>;
     explicit Value(AnyValueType value)
         : m_value(move(value))
     {
@@ -102,6 +102,9 @@ public:
         case ValueType::Kind::F64:
             m_value = bit_cast<double>(raw_value);
             break;
+        case ValueType::Kind::V128:
+            m_value = u128(bit_cast<u64>(raw_value), 0u);
+            break;
         case ValueType::Kind::NullFunctionReference:
             VERIFY(raw_value == 0);
             m_value = Reference { Reference::Null { ValueType(ValueType::Kind::FunctionReference) } };
@@ -155,6 +158,7 @@ public:
             [](i64) { return ValueType::Kind::I64; },
             [](float) { return ValueType::Kind::F32; },
             [](double) { return ValueType::Kind::F64; },
+            [](u128) { return ValueType::Kind::V128; },
             [&](Reference const& type) {
                 return type.ref().visit(
                     [](Reference::Func const&) { return ValueType::Kind::FunctionReference; },
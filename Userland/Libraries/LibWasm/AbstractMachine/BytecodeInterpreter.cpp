@@ -7,7 +7,6 @@
 
 #include <AK/Debug.h>
 #include <AK/Endian.h>
-#include <AK/MemoryStream.h>
 #include <LibWasm/AbstractMachine/AbstractMachine.h>
 #include <LibWasm/AbstractMachine/BytecodeInterpreter.h>
 #include <LibWasm/AbstractMachine/Configuration.h>
@@ -17,6 +16,8 @@
 
 namespace Wasm {
 
+using namespace AK::SIMD;
+
 #define TRAP_IF_NOT(x)                                                                         \
     do {                                                                                       \
         if (trap_if_not(x, #x##sv)) {                                                          \
@@ -61,28 +62,37 @@ void BytecodeInterpreter::interpret(Configuration& configuration)
 void BytecodeInterpreter::branch_to_label(Configuration& configuration, LabelIndex index)
 {
     dbgln_if(WASM_TRACE_DEBUG, "Branch to label with index {}...", index.value());
-    auto label = configuration.nth_label(index.value());
-    dbgln_if(WASM_TRACE_DEBUG, "...which is actually IP {}, and has {} result(s)", label->continuation().value(), label->arity());
-    auto results = pop_values(configuration, label->arity());
+    auto label_index = configuration.nth_label_index(index.value());
+    TRAP_IF_NOT(label_index.has_value());
 
-    size_t drop_count = index.value() + 1;
-    for (; !configuration.stack().is_empty();) {
-        auto& entry = configuration.stack().peek();
-        if (entry.has<Label>()) {
-            if (--drop_count == 0)
-                break;
+    auto& entries = configuration.stack().entries();
+    auto label = entries[*label_index].get<Label>();
+    dbgln_if(WASM_TRACE_DEBUG, "...which is actually IP {}, and has {} result(s)", label.continuation().value(), label.arity());
+
+    // Move the results down to sit right on top of the label, and drop everything that was in between.
+    TRAP_IF_NOT(entries.size() - *label_index - 1 >= label.arity());
+    auto results_start = entries.size() - label.arity();
+    auto new_size = *label_index + 1 + label.arity();
+    if (results_start != *label_index + 1) {
+        for (size_t i = 0; i < label.arity(); ++i) {
+            auto& result = entries[results_start + i];
+            TRAP_IF_NOT(result.has<Value>());
+            entries[*label_index + 1 + i] = move(result);
         }
-        configuration.stack().pop();
+        entries.shrink(new_size, true);
     }
 
-    for (auto& result : results)
-        configuration.stack().push(move(result));
-
-    configuration.ip() = label->continuation();
+    configuration.ip() = label.continuation();
 }
 
 template<typename ReadType, typename PushType>
 void BytecodeInterpreter::load_and_push(Configuration& configuration, Instruction const& instruction)
+{
+    load_and_push<ReadType, PushType>(configuration, instruction.arguments().get<Instruction::MemoryArgument>());
+}
+
+template<typename ReadType, typename PushType>
+void BytecodeInterpreter::load_and_push(Configuration& configuration, Instruction::MemoryArgument const& arg)
 {
     auto& address = configuration.frame().module().memories().first();
     auto memory = configuration.store().get(address);
@@ -90,24 +100,44 @@ void BytecodeInterpreter::load_and_push(Configuration& configuration, Instructio
         m_trap = Trap { "Nonexistent memory" };
         return;
     }
-    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
     auto& entry = configuration.stack().peek();
     auto base = entry.get<Value>().to<i32>();
     if (!base.has_value()) {
         m_trap = Trap { "Memory access out of bounds" };
         return;
     }
+    // Both the base and the offset are 32-bit, so this can't overflow.
     u64 instance_address = static_cast<u64>(bit_cast<u32>(base.value())) + arg.offset;
-    Checked addition { instance_address };
-    addition += sizeof(ReadType);
-    if (addition.has_overflow() || addition.value() > memory->size()) {
+    if (instance_address + sizeof(ReadType) > memory->size()) [[unlikely]] {
         m_trap = Trap { "Memory access out of bounds" };
         dbgln("LibWasm: Memory access out of bounds (expected {} to be less than or equal to {})", instance_address + sizeof(ReadType), memory->size());
         return;
     }
     dbgln_if(WASM_TRACE_DEBUG, "load({} : {}) -> stack", instance_address, sizeof(ReadType));
-    auto slice = memory->data().bytes().slice(instance_address, sizeof(ReadType));
-    configuration.stack().peek() = Value(static_cast<PushType>(read_value<ReadType>(slice)));
+    ReadonlyBytes bytes { memory->data().data() + instance_address, sizeof(ReadType) };
+    configuration.stack().peek() = Value(static_cast<PushType>(read_value<ReadType>(bytes)));
+}
+
+template<typename ReadType, typename PushType, typename Operator>
+void BytecodeInterpreter::load_and_push_vector(Configuration& configuration, Instruction const& instruction)
+{
+    load_and_push<ReadType, PushType>(configuration, instruction);
+    if (did_trap())
+        return;
+    unary_operation<PushType, u128, Operator>(configuration);
+}
+
+template<typename VectorType>
+void BytecodeInterpreter::load_and_replace_lane(Configuration& configuration, Instruction const& instruction)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryAndLaneArgument>();
+    auto vector = *configuration.stack().pop().get<Value>().to<u128>();
+    load_and_push<Operators::VectorElementType<VectorType>, u128>(configuration, arg.memory);
+    if (did_trap())
+        return;
+    auto& entry = configuration.stack().peek();
+    auto value = *entry.get<Value>().to<u128>();
+    entry = Value(Operators::VectorReplaceLane<VectorType> { arg.lane }(vector, value));
 }
 
 void BytecodeInterpreter::call_address(Configuration& configuration, FunctionAddress address)
@@ -150,17 +180,17 @@ void BytecodeInterpreter::call_address(Configuration& configuration, FunctionAdd
         configuration.stack().entries().unchecked_append(move(entry));
 }
 
-template<typename PopType, typename PushType, typename Operator>
-void BytecodeInterpreter::binary_numeric_operation(Configuration& configuration)
+template<typename PopTypeLHS, typename PushType, typename Operator, typename PopTypeRHS, typename... Args>
+void BytecodeInterpreter::binary_numeric_operation(Configuration& configuration, Args&&... args)
 {
     auto rhs_entry = configuration.stack().pop();
     auto& lhs_entry = configuration.stack().peek();
     auto rhs_ptr = rhs_entry.get_pointer<Value>();
     auto lhs_ptr = lhs_entry.get_pointer<Value>();
-    auto rhs = rhs_ptr->to<PopType>();
-    auto lhs = lhs_ptr->to<PopType>();
+    auto rhs = rhs_ptr->to<PopTypeRHS>();
+    auto lhs = lhs_ptr->to<PopTypeLHS>();
     PushType result;
-    auto call_result = Operator {}(lhs.value(), rhs.value());
+    auto call_result = Operator { forward<Args>(args)... }(lhs.value(), rhs.value());
     if constexpr (IsSpecializationOf<decltype(call_result), AK::Result>) {
         if (call_result.is_error()) {
             trap_if_not(false, call_result.error());
@@ -174,13 +204,13 @@ void BytecodeInterpreter::binary_numeric_operation(Configuration& configuration)
     lhs_entry = Value(result);
 }
 
-template<typename PopType, typename PushType, typename Operator>
-void BytecodeInterpreter::unary_operation(Configuration& configuration)
+template<typename PopType, typename PushType, typename Operator, typename... Args>
+void BytecodeInterpreter::unary_operation(Configuration& configuration, Args&&... args)
 {
     auto& entry = configuration.stack().peek();
     auto entry_ptr = entry.get_pointer<Value>();
     auto value = entry_ptr->to<PopType>();
-    auto call_result = Operator {}(*value);
+    auto call_result = Operator { forward<Args>(args)... }(*value);
     PushType result;
     if constexpr (IsSpecializationOf<decltype(call_result), AK::Result>) {
         if (call_result.is_error()) {
@@ -207,11 +237,7 @@ template<>
 struct ConvertToRaw<float> {
     u32 operator()(float value)
     {
-        LittleEndian<u32> res;
-        ReadonlyBytes bytes { &value, sizeof(float) };
-        FixedMemoryStream stream { bytes };
-        stream.read_entire_buffer(res.bytes()).release_value_but_fixme_should_propagate_errors();
-        return static_cast<u32>(res);
+        return LittleEndian<u32>(bit_cast<u32>(value));
     }
 };
 
@@ -219,11 +245,15 @@ template<>
 struct ConvertToRaw<double> {
     u64 operator()(double value)
     {
-        LittleEndian<u64> res;
-        ReadonlyBytes bytes { &value, sizeof(double) };
-        FixedMemoryStream stream { bytes };
-        stream.read_entire_buffer(res.bytes()).release_value_but_fixme_should_propagate_errors();
-        return static_cast<u64>(res);
+        return LittleEndian<u64>(bit_cast<u64>(value));
+    }
+};
+
+template<>
+struct ConvertToRaw<u128> {
+    u128 operator()(u128 value)
+    {
+        return value;
     }
 };
 
@@ -235,59 +265,62 @@ void BytecodeInterpreter::pop_and_store(Configuration& configuration, Instructio
     dbgln_if(WASM_TRACE_DEBUG, "stack({}) -> temporary({}b)", value, sizeof(StoreT));
     auto base_entry = configuration.stack().pop();
     auto base = base_entry.get<Value>().to<i32>();
-    store_to_memory(configuration, instruction, { &value, sizeof(StoreT) }, *base);
+    store_to_memory(configuration, instruction.arguments().get<Instruction::MemoryArgument>(), { &value, sizeof(StoreT) }, *base);
 }
 
-void BytecodeInterpreter::store_to_memory(Configuration& configuration, Instruction const& instruction, ReadonlyBytes data, i32 base)
+template<typename VectorType>
+void BytecodeInterpreter::pop_and_store_lane(Configuration& configuration, Instruction const& instruction)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryAndLaneArgument>();
+    auto vector = *configuration.stack().pop().get<Value>().to<u128>();
+    auto value = bit_cast<VectorType>(vector)[arg.lane];
+    auto base = *configuration.stack().pop().get<Value>().to<i32>();
+    store_to_memory(configuration, arg.memory, { &value, sizeof(value) }, base);
+}
+
+void BytecodeInterpreter::store_to_memory(Configuration& configuration, Instruction::MemoryArgument const& arg, ReadonlyBytes data, i32 base)
 {
     auto& address = configuration.frame().module().memories().first();
     auto memory = configuration.store().get(address);
-    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+    // Both the base and the offset are 32-bit, so this can't overflow.
     u64 instance_address = static_cast<u64>(bit_cast<u32>(base)) + arg.offset;
-    Checked addition { instance_address };
-    addition += data.size();
-    if (addition.has_overflow() || addition.value() > memory->size()) {
+    if (instance_address + data.size() > memory->size()) [[unlikely]] {
         m_trap = Trap { "Memory access out of bounds" };
         dbgln("LibWasm: Memory access out of bounds (expected 0 <= {} and {} <= {})", instance_address, instance_address + data.size(), memory->size());
         return;
     }
     dbgln_if(WASM_TRACE_DEBUG, "temporary({}b) -> store({})", data.size(), instance_address);
-    data.copy_to(memory->data().bytes().slice(instance_address, data.size()));
+    __builtin_memcpy(memory->data().data() + instance_address, data.data(), data.size());
 }
 
 template<typename T>
 T BytecodeInterpreter::read_value(ReadonlyBytes data)
 {
+    VERIFY(data.size() == sizeof(T));
     LittleEndian<T> value;
-    FixedMemoryStream stream { data };
-    auto maybe_error = stream.read_entire_buffer(value.bytes());
-    if (maybe_error.is_error()) {
-        dbgln("Read from {} failed", data.data());
-        m_trap = Trap { "Read from memory failed" };
-    }
+    __builtin_memcpy(&value, data.data(), sizeof(T));
     return value;
 }
 
 template<>
 float BytecodeInterpreter::read_value<float>(ReadonlyBytes data)
 {
-    LittleEndian<u32> raw_value;
-    FixedMemoryStream stream { data };
-    auto maybe_error = stream.read_entire_buffer(raw_value.bytes());
-    if (maybe_error.is_error())
-        m_trap = Trap { "Read from memory failed" };
-    return bit_cast<float>(static_cast<u32>(raw_value));
+    return bit_cast<float>(read_value<u32>(data));
 }
 
 template<>
 double BytecodeInterpreter::read_value<double>(ReadonlyBytes data)
 {
-    LittleEndian<u64> raw_value;
-    FixedMemoryStream stream { data };
-    auto maybe_error = stream.read_entire_buffer(raw_value.bytes());
-    if (maybe_error.is_error())
-        m_trap = Trap { "Read from memory failed" };
-    return bit_cast<double>(static_cast<u64>(raw_value));
+    return bit_cast<double>(read_value<u64>(data));
+}
+
+template<>
+u128 BytecodeInterpreter::read_value<u128>(ReadonlyBytes data)
+{
+    VERIFY(data.size() == sizeof(u128));
+    u128 value;
+    __builtin_memcpy(&value, data.data(), sizeof(u128));
+    return value;
 }
 
 template<typename V, typename T>
@@ -335,21 +368,6 @@ MakeUnsigned<T> BytecodeInterpreter::checked_unsigned_truncate(V value)
     return true;
 }
 
-Vector<Value> BytecodeInterpreter::pop_values(Configuration& configuration, size_t count)
-{
-    Vector<Value> results;
-    results.resize(count);
-
-    for (size_t i = 0; i < count; ++i) {
-        auto top_of_stack = configuration.stack().pop();
-        if (auto value = top_of_stack.get_pointer<Value>())
-            results[i] = move(*value);
-        else
-            TRAP_IF_NOT_NORETURN(value);
-    }
-    return results;
-}
-
 void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPointer& ip, Instruction const& instruction)
 {
     dbgln_if(WASM_TRACE_DEBUG, "Executing instruction {} at ip {}", instruction_name(instruction.opcode()), ip.value());
@@ -626,56 +644,28 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
     case Instructions::memory_fill.value(): {
         auto address = configuration.frame().module().memories()[0];
         auto instance = configuration.store().get(address);
-        auto count = configuration.stack().pop().get<Value>().to<i32>().value();
+        auto count = bit_cast<u32>(configuration.stack().pop().get<Value>().to<i32>().value());
         auto value = configuration.stack().pop().get<Value>().to<i32>().value();
-        auto destination_offset = configuration.stack().pop().get<Value>().to<i32>().value();
+        auto destination_offset = bit_cast<u32>(configuration.stack().pop().get<Value>().to<i32>().value());
 
-        TRAP_IF_NOT(static_cast<size_t>(destination_offset + count) <= instance->data().size());
+        TRAP_IF_NOT(static_cast<u64>(destination_offset) + count <= instance->size());
 
-        if (count == 0)
-            return;
-
-        Instruction synthetic_store_instruction {
-            Instructions::i32_store8,
-            Instruction::MemoryArgument { 0, 0 }
-        };
-
-        for (auto i = 0; i < count; ++i) {
-            store_to_memory(configuration, synthetic_store_instruction, { &value, sizeof(value) }, destination_offset);
-        }
+        __builtin_memset(instance->data().data() + destination_offset, static_cast<u8>(value), count);
         return;
     }
     // https://webassembly.github.io/spec/core/bikeshed/#exec-memory-copy
     case Instructions::memory_copy.value(): {
         auto address = configuration.frame().module().memories()[0];
         auto instance = configuration.store().get(address);
-        auto count = configuration.stack().pop().get<Value>().to<i32>().value();
-        auto source_offset = configuration.stack().pop().get<Value>().to<i32>().value();
-        auto destination_offset = configuration.stack().pop().get<Value>().to<i32>().value();
+        auto count = bit_cast<u32>(configuration.stack().pop().get<Value>().to<i32>().value());
+        auto source_offset = bit_cast<u32>(configuration.stack().pop().get<Value>().to<i32>().value());
+        auto destination_offset = bit_cast<u32>(configuration.stack().pop().get<Value>().to<i32>().value());
 
-        TRAP_IF_NOT(static_cast<size_t>(source_offset + count) <= instance->data().size());
-        TRAP_IF_NOT(static_cast<size_t>(destination_offset + count) <= instance->data().size());
-
-        if (count == 0)
-            return;
-
-        Instruction synthetic_store_instruction {
-            Instructions::i32_store8,
-            Instruction::MemoryArgument { 0, 0 }
-        };
-
-        if (destination_offset <= source_offset) {
-            for (auto i = 0; i < count; ++i) {
-                auto value = instance->data()[source_offset + i];
-                store_to_memory(configuration, synthetic_store_instruction, { &value, sizeof(value) }, destination_offset + i);
-            }
-        } else {
-            for (auto i = count - 1; i >= 0; --i) {
-                auto value = instance->data()[source_offset + i];
-                store_to_memory(configuration, synthetic_store_instruction, { &value, sizeof(value) }, destination_offset + i);
-            }
-        }
+        TRAP_IF_NOT(static_cast<u64>(source_offset) + count <= instance->size());
+        TRAP_IF_NOT(static_cast<u64>(destination_offset) + count <= instance->size());
 
+        // The ranges may overlap, memmove() takes care of copying in the right direction.
+        __builtin_memmove(instance->data().data() + destination_offset, instance->data().data() + source_offset, count);
         return;
     }
     // https://webassembly.github.io/spec/core/bikeshed/#exec-memory-init
@@ -691,14 +681,9 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
         TRAP_IF_NOT(source_offset + count > 0);
         TRAP_IF_NOT(static_cast<size_t>(source_offset + count) <= data.size());
 
-        Instruction synthetic_store_instruction {
-            Instructions::i32_store8,
-            Instruction::MemoryArgument { 0, 0 }
-        };
-
         for (size_t i = 0; i < (size_t)count; ++i) {
             auto value = data.data()[source_offset + i];
-            store_to_memory(configuration, synthetic_store_instruction, { &value, sizeof(value) }, destination_offset + i);
+            store_to_memory(configuration, Instruction::MemoryArgument { 0, 0 }, { &value, sizeof(value) }, destination_offset + i);
         }
         return;
     }
@@ -1019,6 +1004,485 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
         return unary_operation<double, i64, Operators::SaturatingTruncate<i64>>(configuration);
     case Instructions::i64_trunc_sat_f64_u.value():
         return unary_operation<double, i64, Operators::SaturatingTruncate<u64>>(configuration);
+    case Instructions::v128_load.value():
+        return load_and_push<u128, u128>(configuration, instruction);
+    case Instructions::v128_load8x8_s.value():
+        return load_and_push_vector<u64, u128, Operators::VectorExtend<i8x16, i16x8, Operators::VectorHalf::Low>>(configuration, instruction);
+    case Instructions::v128_load8x8_u.value():
+        return load_and_push_vector<u64, u128, Operators::VectorExtend<u8x16, u16x8, Operators::VectorHalf::Low>>(configuration, instruction);
+    case Instructions::v128_load16x4_s.value():
+        return load_and_push_vector<u64, u128, Operators::VectorExtend<i16x8, i32x4, Operators::VectorHalf::Low>>(configuration, instruction);
+    case Instructions::v128_load16x4_u.value():
+        return load_and_push_vector<u64, u128, Operators::VectorExtend<u16x8, u32x4, Operators::VectorHalf::Low>>(configuration, instruction);
+    case Instructions::v128_load32x2_s.value():
+        return load_and_push_vector<u64, u128, Operators::VectorExtend<i32x4, i64x2, Operators::VectorHalf::Low>>(configuration, instruction);
+    case Instructions::v128_load32x2_u.value():
+        return load_and_push_vector<u64, u128, Operators::VectorExtend<u32x4, u64x2, Operators::VectorHalf::Low>>(configuration, instruction);
+    case Instructions::v128_load8_splat.value():
+        return load_and_push_vector<u8, i32, Operators::VectorSplat<u8x16>>(configuration, instruction);
+    case Instructions::v128_load16_splat.value():
+        return load_and_push_vector<u16, i32, Operators::VectorSplat<u16x8>>(configuration, instruction);
+    case Instructions::v128_load32_splat.value():
+        return load_and_push_vector<u32, i32, Operators::VectorSplat<u32x4>>(configuration, instruction);
+    case Instructions::v128_load64_splat.value():
+        return load_and_push_vector<u64, i64, Operators::VectorSplat<u64x2>>(configuration, instruction);
+    case Instructions::v128_store.value():
+        return pop_and_store<u128, u128>(configuration, instruction);
+    case Instructions::v128_const.value():
+        configuration.stack().push(Value(instruction.arguments().get<u128>()));
+        return;
+    case Instructions::i8x16_shuffle.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShuffle>(configuration, instruction.arguments().get<Instruction::ShuffleArgument>().lanes);
+    case Instructions::i8x16_swizzle.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorSwizzle>(configuration);
+    case Instructions::i8x16_splat.value():
+        return unary_operation<i32, u128, Operators::VectorSplat<u8x16>>(configuration);
+    case Instructions::i16x8_splat.value():
+        return unary_operation<i32, u128, Operators::VectorSplat<u16x8>>(configuration);
+    case Instructions::i32x4_splat.value():
+        return unary_operation<i32, u128, Operators::VectorSplat<u32x4>>(configuration);
+    case Instructions::i64x2_splat.value():
+        return unary_operation<i64, u128, Operators::VectorSplat<u64x2>>(configuration);
+    case Instructions::f32x4_splat.value():
+        return unary_operation<float, u128, Operators::VectorSplat<f32x4>>(configuration);
+    case Instructions::f64x2_splat.value():
+        return unary_operation<double, u128, Operators::VectorSplat<f64x2>>(configuration);
+    case Instructions::i8x16_extract_lane_s.value():
+        return unary_operation<u128, i32, Operators::VectorExtractLane<i8x16, i32>>(configuration, instruction.arguments().get<Instruction::LaneIndex>().lane);
+    case Instructions::i8x16_extract_lane_u.value():
+        return unary_operation<u128, i32, Operators::VectorExtractLane<u8x16, i32>>(configuration, instruction.arguments().get<Instruction::LaneIndex>().lane);
+    case Instructions::i8x16_replace_lane.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorReplaceLane<u8x16>, i32>(configuration, instruction.arguments().get<Instruction::LaneIndex>().lane);
+    case Instructions::i16x8_extract_lane_s.value():
+        return unary_operation<u128, i32, Operators::VectorExtractLane<i16x8, i32>>(configuration, instruction.arguments().get<Instruction::LaneIndex>().lane);
+    case Instructions::i16x8_extract_lane_u.value():
+        return unary_operation<u128, i32, Operators::VectorExtractLane<u16x8, i32>>(configuration, instruction.arguments().get<Instruction::LaneIndex>().lane);
+    case Instructions::i16x8_replace_lane.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorReplaceLane<u16x8>, i32>(configuration, instruction.arguments().get<Instruction::LaneIndex>().lane);
+    case Instructions::i32x4_extract_lane.value():
+        return unary_operation<u128, i32, Operators::VectorExtractLane<i32x4, i32>>(configuration, instruction.arguments().get<Instruction::LaneIndex>().lane);
+    case Instructions::i32x4_replace_lane.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorReplaceLane<u32x4>, i32>(configuration, instruction.arguments().get<Instruction::LaneIndex>().lane);
+    case Instructions::i64x2_extract_lane.value():
+        return unary_operation<u128, i64, Operators::VectorExtractLane<i64x2, i64>>(configuration, instruction.arguments().get<Instruction::LaneIndex>().lane);
+    case Instructions::i64x2_replace_lane.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorReplaceLane<u64x2>, i64>(configuration, instruction.arguments().get<Instruction::LaneIndex>().lane);
+    case Instructions::f32x4_extract_lane.value():
+        return unary_operation<u128, float, Operators::VectorExtractLane<f32x4, float>>(configuration, instruction.arguments().get<Instruction::LaneIndex>().lane);
+    case Instructions::f32x4_replace_lane.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorReplaceLane<f32x4>, float>(configuration, instruction.arguments().get<Instruction::LaneIndex>().lane);
+    case Instructions::f64x2_extract_lane.value():
+        return unary_operation<u128, double, Operators::VectorExtractLane<f64x2, double>>(configuration, instruction.arguments().get<Instruction::LaneIndex>().lane);
+    case Instructions::f64x2_replace_lane.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorReplaceLane<f64x2>, double>(configuration, instruction.arguments().get<Instruction::LaneIndex>().lane);
+    case Instructions::i8x16_eq.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i8x16, Operators::Equals>>(configuration);
+    case Instructions::i8x16_ne.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i8x16, Operators::NotEquals>>(configuration);
+    case Instructions::i8x16_lt_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i8x16, Operators::LessThan>>(configuration);
+    case Instructions::i8x16_lt_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u8x16, Operators::LessThan>>(configuration);
+    case Instructions::i8x16_gt_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i8x16, Operators::GreaterThan>>(configuration);
+    case Instructions::i8x16_gt_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u8x16, Operators::GreaterThan>>(configuration);
+    case Instructions::i8x16_le_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i8x16, Operators::LessThanOrEquals>>(configuration);
+    case Instructions::i8x16_le_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u8x16, Operators::LessThanOrEquals>>(configuration);
+    case Instructions::i8x16_ge_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i8x16, Operators::GreaterThanOrEquals>>(configuration);
+    case Instructions::i8x16_ge_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u8x16, Operators::GreaterThanOrEquals>>(configuration);
+    case Instructions::i16x8_eq.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i16x8, Operators::Equals>>(configuration);
+    case Instructions::i16x8_ne.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i16x8, Operators::NotEquals>>(configuration);
+    case Instructions::i16x8_lt_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i16x8, Operators::LessThan>>(configuration);
+    case Instructions::i16x8_lt_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u16x8, Operators::LessThan>>(configuration);
+    case Instructions::i16x8_gt_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i16x8, Operators::GreaterThan>>(configuration);
+    case Instructions::i16x8_gt_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u16x8, Operators::GreaterThan>>(configuration);
+    case Instructions::i16x8_le_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i16x8, Operators::LessThanOrEquals>>(configuration);
+    case Instructions::i16x8_le_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u16x8, Operators::LessThanOrEquals>>(configuration);
+    case Instructions::i16x8_ge_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i16x8, Operators::GreaterThanOrEquals>>(configuration);
+    case Instructions::i16x8_ge_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u16x8, Operators::GreaterThanOrEquals>>(configuration);
+    case Instructions::i32x4_eq.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i32x4, Operators::Equals>>(configuration);
+    case Instructions::i32x4_ne.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i32x4, Operators::NotEquals>>(configuration);
+    case Instructions::i32x4_lt_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i32x4, Operators::LessThan>>(configuration);
+    case Instructions::i32x4_lt_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u32x4, Operators::LessThan>>(configuration);
+    case Instructions::i32x4_gt_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i32x4, Operators::GreaterThan>>(configuration);
+    case Instructions::i32x4_gt_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u32x4, Operators::GreaterThan>>(configuration);
+    case Instructions::i32x4_le_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i32x4, Operators::LessThanOrEquals>>(configuration);
+    case Instructions::i32x4_le_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u32x4, Operators::LessThanOrEquals>>(configuration);
+    case Instructions::i32x4_ge_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i32x4, Operators::GreaterThanOrEquals>>(configuration);
+    case Instructions::i32x4_ge_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u32x4, Operators::GreaterThanOrEquals>>(configuration);
+    case Instructions::f32x4_eq.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f32x4, Operators::Equals>>(configuration);
+    case Instructions::f32x4_ne.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f32x4, Operators::NotEquals>>(configuration);
+    case Instructions::f32x4_lt.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f32x4, Operators::LessThan>>(configuration);
+    case Instructions::f32x4_gt.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f32x4, Operators::GreaterThan>>(configuration);
+    case Instructions::f32x4_le.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f32x4, Operators::LessThanOrEquals>>(configuration);
+    case Instructions::f32x4_ge.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f32x4, Operators::GreaterThanOrEquals>>(configuration);
+    case Instructions::f64x2_eq.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f64x2, Operators::Equals>>(configuration);
+    case Instructions::f64x2_ne.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f64x2, Operators::NotEquals>>(configuration);
+    case Instructions::f64x2_lt.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f64x2, Operators::LessThan>>(configuration);
+    case Instructions::f64x2_gt.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f64x2, Operators::GreaterThan>>(configuration);
+    case Instructions::f64x2_le.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f64x2, Operators::LessThanOrEquals>>(configuration);
+    case Instructions::f64x2_ge.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f64x2, Operators::GreaterThanOrEquals>>(configuration);
+    case Instructions::v128_not.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<u64x2, Operators::BitNot>>(configuration);
+    case Instructions::v128_and.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u64x2, Operators::BitAnd>>(configuration);
+    case Instructions::v128_andnot.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u64x2, Operators::BitAndNot>>(configuration);
+    case Instructions::v128_or.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u64x2, Operators::BitOr>>(configuration);
+    case Instructions::v128_xor.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u64x2, Operators::BitXor>>(configuration);
+    case Instructions::v128_bitselect.value(): {
+        auto mask = bit_cast<u64x2>(*configuration.stack().pop().get<Value>().to<u128>());
+        auto false_vector = bit_cast<u64x2>(*configuration.stack().pop().get<Value>().to<u128>());
+        auto& entry = configuration.stack().peek();
+        auto true_vector = bit_cast<u64x2>(*entry.get<Value>().to<u128>());
+        entry = Value(bit_cast<u128>((true_vector & mask) | (false_vector & ~mask)));
+        return;
+    }
+    case Instructions::v128_any_true.value():
+        return unary_operation<u128, i32, Operators::VectorAnyTrue>(configuration);
+    case Instructions::v128_load8_lane.value():
+        return load_and_replace_lane<u8x16>(configuration, instruction);
+    case Instructions::v128_load16_lane.value():
+        return load_and_replace_lane<u16x8>(configuration, instruction);
+    case Instructions::v128_load32_lane.value():
+        return load_and_replace_lane<u32x4>(configuration, instruction);
+    case Instructions::v128_load64_lane.value():
+        return load_and_replace_lane<u64x2>(configuration, instruction);
+    case Instructions::v128_store8_lane.value():
+        return pop_and_store_lane<u8x16>(configuration, instruction);
+    case Instructions::v128_store16_lane.value():
+        return pop_and_store_lane<u16x8>(configuration, instruction);
+    case Instructions::v128_store32_lane.value():
+        return pop_and_store_lane<u32x4>(configuration, instruction);
+    case Instructions::v128_store64_lane.value():
+        return pop_and_store_lane<u64x2>(configuration, instruction);
+    case Instructions::v128_load32_zero.value():
+        return load_and_push<u32, u128>(configuration, instruction);
+    case Instructions::v128_load64_zero.value():
+        return load_and_push<u64, u128>(configuration, instruction);
+    case Instructions::f32x4_demote_f64x2_zero.value():
+        return unary_operation<u128, u128, Operators::VectorConvert<f64x2, f32x4, Operators::Demote>>(configuration);
+    case Instructions::f64x2_promote_low_f32x4.value():
+        return unary_operation<u128, u128, Operators::VectorConvert<f32x4, f64x2, Operators::Promote>>(configuration);
+    case Instructions::i8x16_abs.value():
+        return unary_operation<u128, u128, Operators::VectorLanewise<i8x16, Operators::WrappingAbsolute>>(configuration);
+    case Instructions::i8x16_neg.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<u8x16, Operators::Negate>>(configuration);
+    case Instructions::i8x16_popcnt.value():
+        return unary_operation<u128, u128, Operators::VectorLanewise<u8x16, Operators::PopCount>>(configuration);
+    case Instructions::i8x16_all_true.value():
+        return unary_operation<u128, i32, Operators::VectorAllTrue<i8x16>>(configuration);
+    case Instructions::i8x16_bitmask.value():
+        return unary_operation<u128, i32, Operators::VectorBitmask<i8x16>>(configuration);
+    case Instructions::i8x16_narrow_i16x8_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorNarrow<i16x8, i8x16>>(configuration);
+    case Instructions::i8x16_narrow_i16x8_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorNarrow<i16x8, u8x16>>(configuration);
+    case Instructions::f32x4_ceil.value():
+        return unary_operation<u128, u128, Operators::VectorLanewise<f32x4, Operators::Ceil>>(configuration);
+    case Instructions::f32x4_floor.value():
+        return unary_operation<u128, u128, Operators::VectorLanewise<f32x4, Operators::Floor>>(configuration);
+    case Instructions::f32x4_trunc.value():
+        return unary_operation<u128, u128, Operators::VectorLanewise<f32x4, Operators::Truncate>>(configuration);
+    case Instructions::f32x4_nearest.value():
+        return unary_operation<u128, u128, Operators::VectorLanewise<f32x4, Operators::NearbyIntegral>>(configuration);
+    case Instructions::i8x16_shl.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShiftLeft<u8x16>, i32>(configuration);
+    case Instructions::i8x16_shr_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShiftRight<i8x16>, i32>(configuration);
+    case Instructions::i8x16_shr_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShiftRight<u8x16>, i32>(configuration);
+    case Instructions::i8x16_add.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u8x16, Operators::Add>>(configuration);
+    case Instructions::i8x16_add_sat_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewise<i8x16, Operators::Saturating<Operators::Add>>>(configuration);
+    case Instructions::i8x16_add_sat_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewise<u8x16, Operators::Saturating<Operators::Add>>>(configuration);
+    case Instructions::i8x16_sub.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u8x16, Operators::Subtract>>(configuration);
+    case Instructions::i8x16_sub_sat_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewise<i8x16, Operators::Saturating<Operators::Subtract>>>(configuration);
+    case Instructions::i8x16_sub_sat_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewise<u8x16, Operators::Saturating<Operators::Subtract>>>(configuration);
+    case Instructions::f64x2_ceil.value():
+        return unary_operation<u128, u128, Operators::VectorLanewise<f64x2, Operators::Ceil>>(configuration);
+    case Instructions::f64x2_floor.value():
+        return unary_operation<u128, u128, Operators::VectorLanewise<f64x2, Operators::Floor>>(configuration);
+    case Instructions::i8x16_min_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewise<i8x16, Operators::Minimum>>(configuration);
+    case Instructions::i8x16_min_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewise<u8x16, Operators::Minimum>>(configuration);
+    case Instructions::i8x16_max_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewise<i8x16, Operators::Maximum>>(configuration);
+    case Instructions::i8x16_max_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewise<u8x16, Operators::Maximum>>(configuration);
+    case Instructions::f64x2_trunc.value():
+        return unary_operation<u128, u128, Operators::VectorLanewise<f64x2, Operators::Truncate>>(configuration);
+    case Instructions::i8x16_avgr_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewise<u8x16, Operators::AverageRounded>>(configuration);
+    case Instructions::i16x8_extadd_pairwise_i8x16_s.value():
+        return unary_operation<u128, u128, Operators::VectorExtendedAddPairwise<i8x16, i16x8>>(configuration);
+    case Instructions::i16x8_extadd_pairwise_i8x16_u.value():
+        return unary_operation<u128, u128, Operators::VectorExtendedAddPairwise<u8x16, u16x8>>(configuration);
+    case Instructions::i32x4_extadd_pairwise_i16x8_s.value():
+        return unary_operation<u128, u128, Operators::VectorExtendedAddPairwise<i16x8, i32x4>>(configuration);
+    case Instructions::i32x4_extadd_pairwise_i16x8_u.value():
+        return unary_operation<u128, u128, Operators::VectorExtendedAddPairwise<u16x8, u32x4>>(configuration);
+    case Instructions::i16x8_abs.value():
+        return unary_operation<u128, u128, Operators::VectorLanewise<i16x8, Operators::WrappingAbsolute>>(configuration);
+    case Instructions::i16x8_neg.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<u16x8, Operators::Negate>>(configuration);
+    case Instructions::i16x8_q15mulr_sat_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewise<i16x8, Operators::Q15MultiplyRoundedSaturating>>(configuration);
+    case Instructions::i16x8_all_true.value():
+        return unary_operation<u128, i32, Operators::VectorAllTrue<i16x8>>(configuration);
+    case Instructions::i16x8_bitmask.value():
+        return unary_operation<u128, i32, Operators::VectorBitmask<i16x8>>(configuration);
+    case Instructions::i16x8_narrow_i32x4_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorNarrow<i32x4, i16x8>>(configuration);
+    case Instructions::i16x8_narrow_i32x4_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorNarrow<i32x4, u16x8>>(configuration);
+    case Instructions::i16x8_extend_low_i8x16_s.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<i8x16, i16x8, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i16x8_extend_high_i8x16_s.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<i8x16, i16x8, Operators::VectorHalf::High>>(configuration);
+    case Instructions::i16x8_extend_low_i8x16_u.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<u8x16, u16x8, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i16x8_extend_high_i8x16_u.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<u8x16, u16x8, Operators::VectorHalf::High>>(configuration);
+    case Instructions::i16x8_shl.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShiftLeft<u16x8>, i32>(configuration);
+    case Instructions::i16x8_shr_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShiftRight<i16x8>, i32>(configuration);
+    case Instructions::i16x8_shr_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShiftRight<u16x8>, i32>(configuration);
+    case Instructions::i16x8_add.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u16x8, Operators::Add>>(configuration);
+    case Instructions::i16x8_add_sat_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewise<i16x8, Operators::Saturating<Operators::Add>>>(configuration);
+    case Instructions::i16x8_add_sat_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewise<u16x8, Operators::Saturating<Operators::Add>>>(configuration);
+    case Instructions::i16x8_sub.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u16x8, Operators::Subtract>>(configuration);
+    case Instructions::i16x8_sub_sat_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewise<i16x8, Operators::Saturating<Operators::Subtract>>>(configuration);
+    case Instructions::i16x8_sub_sat_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewise<u16x8, Operators::Saturating<Operators::Subtract>>>(configuration);
+    case Instructions::f64x2_nearest.value():
+        return unary_operation<u128, u128, Operators::VectorLanewise<f64x2, Operators::NearbyIntegral>>(configuration);
+    case Instructions::i16x8_mul.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u16x8, Operators::Multiply>>(configuration);
+    case Instructions::i16x8_min_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewise<i16x8, Operators::Minimum>>(configuration);
+    case Instructions::i16x8_min_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewise<u16x8, Operators::Minimum>>(configuration);
+    case Instructions::i16x8_max_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewise<i16x8, Operators::Maximum>>(configuration);
+    case Instructions::i16x8_max_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewise<u16x8, Operators::Maximum>>(configuration);
+    case Instructions::i16x8_avgr_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewise<u16x8, Operators::AverageRounded>>(configuration);
+    case Instructions::i16x8_extmul_low_i8x16_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendedMultiply<i8x16, i16x8, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i16x8_extmul_high_i8x16_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendedMultiply<i8x16, i16x8, Operators::VectorHalf::High>>(configuration);
+    case Instructions::i16x8_extmul_low_i8x16_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendedMultiply<u8x16, u16x8, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i16x8_extmul_high_i8x16_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendedMultiply<u8x16, u16x8, Operators::VectorHalf::High>>(configuration);
+    case Instructions::i32x4_abs.value():
+        return unary_operation<u128, u128, Operators::VectorLanewise<i32x4, Operators::WrappingAbsolute>>(configuration);
+    case Instructions::i32x4_neg.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<u32x4, Operators::Negate>>(configuration);
+    case Instructions::i32x4_all_true.value():
+        return unary_operation<u128, i32, Operators::VectorAllTrue<i32x4>>(configuration);
+    case Instructions::i32x4_bitmask.value():
+        return unary_operation<u128, i32, Operators::VectorBitmask<i32x4>>(configuration);
+    case Instructions::i32x4_extend_low_i16x8_s.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<i16x8, i32x4, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i32x4_extend_high_i16x8_s.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<i16x8, i32x4, Operators::VectorHalf::High>>(configuration);
+    case Instructions::i32x4_extend_low_i16x8_u.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<u16x8, u32x4, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i32x4_extend_high_i16x8_u.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<u16x8, u32x4, Operators::VectorHalf::High>>(configuration);
+    case Instructions::i32x4_shl.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShiftLeft<u32x4>, i32>(configuration);
+    case Instructions::i32x4_shr_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShiftRight<i32x4>, i32>(configuration);
+    case Instructions::i32x4_shr_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShiftRight<u32x4>, i32>(configuration);
+    case Instructions::i32x4_add.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u32x4, Operators::Add>>(configuration);
+    case Instructions::i32x4_sub.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u32x4, Operators::Subtract>>(configuration);
+    case Instructions::i32x4_mul.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u32x4, Operators::Multiply>>(configuration);
+    case Instructions::i32x4_min_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewise<i32x4, Operators::Minimum>>(configuration);
+    case Instructions::i32x4_min_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewise<u32x4, Operators::Minimum>>(configuration);
+    case Instructions::i32x4_max_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewise<i32x4, Operators::Maximum>>(configuration);
+    case Instructions::i32x4_max_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewise<u32x4, Operators::Maximum>>(configuration);
+    case Instructions::i32x4_dot_i16x8_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorDotProduct>(configuration);
+    case Instructions::i32x4_extmul_low_i16x8_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendedMultiply<i16x8, i32x4, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i32x4_extmul_high_i16x8_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendedMultiply<i16x8, i32x4, Operators::VectorHalf::High>>(configuration);
+    case Instructions::i32x4_extmul_low_i16x8_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendedMultiply<u16x8, u32x4, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i32x4_extmul_high_i16x8_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendedMultiply<u16x8, u32x4, Operators::VectorHalf::High>>(configuration);
+    case Instructions::i64x2_abs.value():
+        return unary_operation<u128, u128, Operators::VectorLanewise<i64x2, Operators::WrappingAbsolute>>(configuration);
+    case Instructions::i64x2_neg.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<u64x2, Operators::Negate>>(configuration);
+    case Instructions::i64x2_all_true.value():
+        return unary_operation<u128, i32, Operators::VectorAllTrue<i64x2>>(configuration);
+    case Instructions::i64x2_bitmask.value():
+        return unary_operation<u128, i32, Operators::VectorBitmask<i64x2>>(configuration);
+    case Instructions::i64x2_extend_low_i32x4_s.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<i32x4, i64x2, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i64x2_extend_high_i32x4_s.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<i32x4, i64x2, Operators::VectorHalf::High>>(configuration);
+    case Instructions::i64x2_extend_low_i32x4_u.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<u32x4, u64x2, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i64x2_extend_high_i32x4_u.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<u32x4, u64x2, Operators::VectorHalf::High>>(configuration);
+    case Instructions::i64x2_shl.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShiftLeft<u64x2>, i32>(configuration);
+    case Instructions::i64x2_shr_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShiftRight<i64x2>, i32>(configuration);
+    case Instructions::i64x2_shr_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShiftRight<u64x2>, i32>(configuration);
+    case Instructions::i64x2_add.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u64x2, Operators::Add>>(configuration);
+    case Instructions::i64x2_sub.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u64x2, Operators::Subtract>>(configuration);
+    case Instructions::i64x2_mul.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u64x2, Operators::Multiply>>(configuration);
+    case Instructions::i64x2_eq.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i64x2, Operators::Equals>>(configuration);
+    case Instructions::i64x2_ne.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i64x2, Operators::NotEquals>>(configuration);
+    case Instructions::i64x2_lt_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i64x2, Operators::LessThan>>(configuration);
+    case Instructions::i64x2_gt_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i64x2, Operators::GreaterThan>>(configuration);
+    case Instructions::i64x2_le_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i64x2, Operators::LessThanOrEquals>>(configuration);
+    case Instructions::i64x2_ge_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i64x2, Operators::GreaterThanOrEquals>>(configuration);
+    case Instructions::i64x2_extmul_low_i32x4_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendedMultiply<i32x4, i64x2, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i64x2_extmul_high_i32x4_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendedMultiply<i32x4, i64x2, Operators::VectorHalf::High>>(configuration);
+    case Instructions::i64x2_extmul_low_i32x4_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendedMultiply<u32x4, u64x2, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i64x2_extmul_high_i32x4_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendedMultiply<u32x4, u64x2, Operators::VectorHalf::High>>(configuration);
+    case Instructions::f32x4_abs.value():
+        return unary_operation<u128, u128, Operators::VectorLanewise<f32x4, Operators::Absolute>>(configuration);
+    case Instructions::f32x4_neg.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<f32x4, Operators::Negate>>(configuration);
+    case Instructions::f32x4_sqrt.value():
+        return unary_operation<u128, u128, Operators::VectorLanewise<f32x4, Operators::SquareRoot>>(configuration);
+    case Instructions::f32x4_add.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f32x4, Operators::Add>>(configuration);
+    case Instructions::f32x4_sub.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f32x4, Operators::Subtract>>(configuration);
+    case Instructions::f32x4_mul.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f32x4, Operators::Multiply>>(configuration);
+    case Instructions::f32x4_div.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewise<f32x4, Operators::Divide>>(configuration);
+    case Instructions::f32x4_min.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewise<f32x4, Operators::Minimum>>(configuration);
+    case Instructions::f32x4_max.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewise<f32x4, Operators::Maximum>>(configuration);
+    case Instructions::f32x4_pmin.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewise<f32x4, Operators::PseudoMinimum>>(configuration);
+    case Instructions::f32x4_pmax.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewise<f32x4, Operators::PseudoMaximum>>(configuration);
+    case Instructions::f64x2_abs.value():
+        return unary_operation<u128, u128, Operators::VectorLanewise<f64x2, Operators::Absolute>>(configuration);
+    case Instructions::f64x2_neg.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<f64x2, Operators::Negate>>(configuration);
+    case Instructions::f64x2_sqrt.value():
+        return unary_operation<u128, u128, Operators::VectorLanewise<f64x2, Operators::SquareRoot>>(configuration);
+    case Instructions::f64x2_add.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f64x2, Operators::Add>>(configuration);
+    case Instructions::f64x2_sub.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f64x2, Operators::Subtract>>(configuration);
+    case Instructions::f64x2_mul.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f64x2, Operators::Multiply>>(configuration);
+    case Instructions::f64x2_div.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewise<f64x2, Operators::Divide>>(configuration);
+    case Instructions::f64x2_min.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewise<f64x2, Operators::Minimum>>(configuration);
+    case Instructions::f64x2_max.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewise<f64x2, Operators::Maximum>>(configuration);
+    case Instructions::f64x2_pmin.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewise<f64x2, Operators::PseudoMinimum>>(configuration);
+    case Instructions::f64x2_pmax.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewise<f64x2, Operators::PseudoMaximum>>(configuration);
+    case Instructions::i32x4_trunc_sat_f32x4_s.value():
+        return unary_operation<u128, u128, Operators::VectorConvert<f32x4, i32x4, Operators::SaturatingTruncate<i32>>>(configuration);
+    case Instructions::i32x4_trunc_sat_f32x4_u.value():
+        return unary_operation<u128, u128, Operators::VectorConvert<f32x4, u32x4, Operators::SaturatingTruncate<u32>>>(configuration);
+    case Instructions::f32x4_convert_i32x4_s.value():
+        return unary_operation<u128, u128, Operators::VectorConvert<i32x4, f32x4, Operators::Convert<float>>>(configuration);
+    case Instructions::f32x4_convert_i32x4_u.value():
+        return unary_operation<u128, u128, Operators::VectorConvert<u32x4, f32x4, Operators::ConvertUnsigned<float>>>(configuration);
+    case Instructions::i32x4_trunc_sat_f64x2_s_zero.value():
+        return unary_operation<u128, u128, Operators::VectorConvert<f64x2, i32x4, Operators::SaturatingTruncate<i32>>>(configuration);
+    case Instructions::i32x4_trunc_sat_f64x2_u_zero.value():
+        return unary_operation<u128, u128, Operators::VectorConvert<f64x2, u32x4, Operators::SaturatingTruncate<u32>>>(configuration);
+    case Instructions::f64x2_convert_low_i32x4_s.value():
+        return unary_operation<u128, u128, Operators::VectorConvert<i32x4, f64x2, Operators::Convert<double>>>(configuration);
+    case Instructions::f64x2_convert_low_i32x4_u.value():
+        return unary_operation<u128, u128, Operators::VectorConvert<u32x4, f64x2, Operators::ConvertUnsigned<double>>>(configuration);
     case Instructions::table_init.value():
     case Instructions::elem_drop.value():
     case Instructions::table_copy.value():
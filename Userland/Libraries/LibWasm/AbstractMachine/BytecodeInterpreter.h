@@ -43,16 +43,24 @@ protected:
     void branch_to_label(Configuration&, LabelIndex);
     template<typename ReadT, typename PushT>
     void load_and_push(Configuration&, Instruction const&);
+    template<typename ReadT, typename PushT>
+    void load_and_push(Configuration&, Instruction::MemoryArgument const&);
+    template<typename ReadT, typename PushT, typename Operator>
+    void load_and_push_vector(Configuration&, Instruction const&);
+    template<typename VectorType>
+    void load_and_replace_lane(Configuration&, Instruction const&);
     template<typename PopT, typename StoreT>
     void pop_and_store(Configuration&, Instruction const&);
-    void store_to_memory(Configuration&, Instruction const&, ReadonlyBytes data, i32 base);
+    template<typename VectorType>
+    void pop_and_store_lane(Configuration&, Instruction const&);
+    void store_to_memory(Configuration&, Instruction::MemoryArgument const&, ReadonlyBytes data, i32 base);
     void call_address(Configuration&, FunctionAddress);
 
-    template<typename PopType, typename PushType, typename Operator>
-    void binary_numeric_operation(Configuration&);
+    template<typename PopTypeLHS, typename PushType, typename Operator, typename PopTypeRHS = PopTypeLHS, typename... Args>
+    void binary_numeric_operation(Configuration&, Args&&...);
 
-    template<typename PopType, typename PushType, typename Operator>
-    void unary_operation(Configuration&);
+    template<typename PopType, typename PushType, typename Operator, typename... Args>
+    void unary_operation(Configuration&, Args&&...);
 
     template<typename V, typename T>
     MakeUnsigned<T> checked_unsigned_truncate(V);
@@ -63,7 +71,6 @@ protected:
     template<typename T>
     T read_value(ReadonlyBytes data);
 
-    Vector<Value> pop_values(Configuration& configuration, size_t count);
     ALWAYS_INLINE bool trap_if_not(bool value, StringView reason)
     {
         if (!value)
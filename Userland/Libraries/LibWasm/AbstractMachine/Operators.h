@@ -9,8 +9,10 @@
 #include <AK/BitCast.h>
 #include <AK/BuiltinWrappers.h>
 #include <AK/Result.h>
+#include <AK/SIMD.h>
 #include <AK/StringView.h>
 #include <AK/Types.h>
+#include <AK/UFixedBigInt.h>
 #include <limits.h>
 #include <math.h>
 
@@ -210,7 +212,7 @@ struct PopCount {
     template<typename Lhs>
     auto operator()(Lhs lhs) const
     {
-        if constexpr (sizeof(Lhs) == 4 || sizeof(Lhs) == 8)
+        if constexpr (sizeof(Lhs) == 1 || sizeof(Lhs) == 4 || sizeof(Lhs) == 8)
             return popcount(MakeUnsigned<Lhs>(lhs));
         else
             VERIFY_NOT_REACHED();
@@ -260,7 +262,7 @@ struct Floor {
 };
 struct Truncate {
     template<typename Lhs>
-    Result<Lhs, StringView> operator()(Lhs lhs) const
+    auto operator()(Lhs lhs) const
     {
         if constexpr (IsSame<Lhs, float>)
             return truncf(lhs);
@@ -363,6 +365,18 @@ struct Convert {
     static StringView name() { return "convert"sv; }
 };
 
+template<typename ResultT>
+struct ConvertUnsigned {
+    template<typename Lhs>
+    ResultT operator()(Lhs lhs) const
+    {
+        auto unsigned_interpretation = bit_cast<MakeUnsigned<Lhs>>(lhs);
+        return static_cast<ResultT>(unsigned_interpretation);
+    }
+
+    static StringView name() { return "convert_unsigned"sv; }
+};
+
 template<typename ResultT>
 struct Reinterpret {
     template<typename Lhs>
@@ -453,4 +467,372 @@ struct SaturatingTruncate {
     static StringView name() { return "truncate.saturating"sv; }
 };
 
+
+// Vector
+// v128 values are passed around as u128, and are reinterpreted as one of the AK::SIMD vector types to be operated on.
+
+template<typename VectorType>
+using VectorElementType = RemoveCVReference<decltype(declval<VectorType>()[0])>;
+
+template<typename VectorType>
+constexpr size_t vector_lane_count = sizeof(VectorType) / sizeof(VectorElementType<VectorType>);
+
+enum class VectorHalf {
+    Low,
+    High,
+};
+
+// Applies an operator to whole vectors at once, for operators that the compiler can lower to SIMD instructions directly.
+template<typename VectorType, typename Operator>
+struct VectorOperation {
+    u128 operator()(u128 lhs, u128 rhs) const
+    {
+        return bit_cast<u128>(Operator {}(bit_cast<VectorType>(lhs), bit_cast<VectorType>(rhs)));
+    }
+
+    u128 operator()(u128 value) const
+    {
+        return bit_cast<u128>(Operator {}(bit_cast<VectorType>(value)));
+    }
+
+    static StringView name() { return Operator::name(); }
+};
+
+// Applies a scalar operator to each lane in turn.
+template<typename VectorType, typename Operator>
+struct VectorLanewise {
+    u128 operator()(u128 lhs, u128 rhs) const
+    {
+        auto lhs_vector = bit_cast<VectorType>(lhs);
+        auto rhs_vector = bit_cast<VectorType>(rhs);
+        VectorType result;
+        for (size_t i = 0; i < vector_lane_count<VectorType>; ++i)
+            result[i] = Operator {}(lhs_vector[i], rhs_vector[i]);
+        return bit_cast<u128>(result);
+    }
+
+    u128 operator()(u128 value) const
+    {
+        auto vector = bit_cast<VectorType>(value);
+        VectorType result;
+        for (size_t i = 0; i < vector_lane_count<VectorType>; ++i)
+            result[i] = Operator {}(vector[i]);
+        return bit_cast<u128>(result);
+    }
+
+    static StringView name() { return Operator::name(); }
+};
+
+struct BitNot {
+    template<typename Lhs>
+    auto operator()(Lhs lhs) const { return ~lhs; }
+
+    static StringView name() { return "~"sv; }
+};
+struct BitAndNot {
+    template<typename Lhs, typename Rhs>
+    auto operator()(Lhs lhs, Rhs rhs) const { return lhs & ~rhs; }
+
+    static StringView name() { return "&~"sv; }
+};
+// Like Absolute, but the most negative value wraps around to itself instead of overflowing.
+struct WrappingAbsolute {
+    template<typename Lhs>
+    Lhs operator()(Lhs lhs) const
+    {
+        auto unsigned_value = static_cast<MakeUnsigned<Lhs>>(lhs);
+        if (lhs < 0)
+            unsigned_value = -unsigned_value;
+        return static_cast<Lhs>(unsigned_value);
+    }
+
+    static StringView name() { return "abs"sv; }
+};
+struct PseudoMinimum {
+    template<typename Lhs, typename Rhs>
+    auto operator()(Lhs lhs, Rhs rhs) const { return rhs < lhs ? rhs : lhs; }
+
+    static StringView name() { return "pseudo_minimum"sv; }
+};
+struct PseudoMaximum {
+    template<typename Lhs, typename Rhs>
+    auto operator()(Lhs lhs, Rhs rhs) const { return lhs < rhs ? rhs : lhs; }
+
+    static StringView name() { return "pseudo_maximum"sv; }
+};
+template<typename Operator>
+struct Saturating {
+    template<typename Lhs, typename Rhs>
+    Lhs operator()(Lhs lhs, Rhs rhs) const
+    {
+        static_assert(sizeof(Lhs) < sizeof(i64));
+        i64 result = Operator {}(static_cast<i64>(lhs), static_cast<i64>(rhs));
+        return static_cast<Lhs>(clamp<i64>(result, NumericLimits<Lhs>::min(), NumericLimits<Lhs>::max()));
+    }
+
+    static StringView name() { return Operator::name(); }
+};
+struct AverageRounded {
+    template<typename Lhs, typename Rhs>
+    Lhs operator()(Lhs lhs, Rhs rhs) const { return static_cast<Lhs>((static_cast<u32>(lhs) + static_cast<u32>(rhs) + 1) / 2); }
+
+    static StringView name() { return "average_rounded"sv; }
+};
+struct Q15MultiplyRoundedSaturating {
+    i16 operator()(i16 lhs, i16 rhs) const
+    {
+        i32 result = (static_cast<i32>(lhs) * static_cast<i32>(rhs) + 0x4000) >> 15;
+        return static_cast<i16>(clamp<i32>(result, NumericLimits<i16>::min(), NumericLimits<i16>::max()));
+    }
+
+    static StringView name() { return "q15_multiply"sv; }
+};
+
+template<typename VectorType>
+struct VectorShiftLeft {
+    u128 operator()(u128 lhs, i32 rhs) const
+    {
+        auto shift = static_cast<u32>(rhs) % (sizeof(VectorElementType<VectorType>) * 8);
+        return bit_cast<u128>(bit_cast<VectorType>(lhs) << shift);
+    }
+
+    static StringView name() { return "vec(<<)"sv; }
+};
+template<typename VectorType>
+struct VectorShiftRight {
+    u128 operator()(u128 lhs, i32 rhs) const
+    {
+        auto shift = static_cast<u32>(rhs) % (sizeof(VectorElementType<VectorType>) * 8);
+        return bit_cast<u128>(bit_cast<VectorType>(lhs) >> shift);
+    }
+
+    static StringView name() { return "vec(>>)"sv; }
+};
+
+template<typename VectorType>
+struct VectorSplat {
+    template<typename Lhs>
+    u128 operator()(Lhs lhs) const
+    {
+        VectorType result;
+        for (size_t i = 0; i < vector_lane_count<VectorType>; ++i)
+            result[i] = static_cast<VectorElementType<VectorType>>(lhs);
+        return bit_cast<u128>(result);
+    }
+
+    static StringView name() { return "splat"sv; }
+};
+
+template<typename VectorType, typename ResultT>
+struct VectorExtractLane {
+    explicit VectorExtractLane(size_t lane)
+        : m_lane(lane)
+    {
+    }
+
+    ResultT operator()(u128 value) const { return static_cast<ResultT>(bit_cast<VectorType>(value)[m_lane]); }
+
+    static StringView name() { return "extract_lane"sv; }
+
+private:
+    size_t m_lane { 0 };
+};
+
+template<typename VectorType>
+struct VectorReplaceLane {
+    explicit VectorReplaceLane(size_t lane)
+        : m_lane(lane)
+    {
+    }
+
+    template<typename Rhs>
+    u128 operator()(u128 lhs, Rhs rhs) const
+    {
+        auto vector = bit_cast<VectorType>(lhs);
+        vector[m_lane] = static_cast<VectorElementType<VectorType>>(rhs);
+        return bit_cast<u128>(vector);
+    }
+
+    static StringView name() { return "replace_lane"sv; }
+
+private:
+    size_t m_lane { 0 };
+};
+
+struct VectorAnyTrue {
+    i32 operator()(u128 value) const { return value != 0u; }
+
+    static StringView name() { return "any_true"sv; }
+};
+template<typename VectorType>
+struct VectorAllTrue {
+    i32 operator()(u128 value) const
+    {
+        auto vector = bit_cast<VectorType>(value);
+        for (size_t i = 0; i < vector_lane_count<VectorType>; ++i) {
+            if (vector[i] == 0)
+                return 0;
+        }
+        return 1;
+    }
+
+    static StringView name() { return "all_true"sv; }
+};
+template<typename VectorType>
+struct VectorBitmask {
+    i32 operator()(u128 value) const
+    {
+        auto vector = bit_cast<VectorType>(value);
+        i32 result = 0;
+        for (size_t i = 0; i < vector_lane_count<VectorType>; ++i) {
+            if (vector[i] < 0)
+                result |= 1 << i;
+        }
+        return result;
+    }
+
+    static StringView name() { return "bitmask"sv; }
+};
+
+struct VectorShuffle {
+    explicit VectorShuffle(u8 const (&lanes)[16])
+    {
+        __builtin_memcpy(m_lanes, lanes, sizeof(m_lanes));
+    }
+
+    u128 operator()(u128 lhs, u128 rhs) const
+    {
+        auto lhs_vector = bit_cast<AK::SIMD::u8x16>(lhs);
+        auto rhs_vector = bit_cast<AK::SIMD::u8x16>(rhs);
+        AK::SIMD::u8x16 result;
+        for (size_t i = 0; i < 16; ++i)
+            result[i] = m_lanes[i] < 16 ? lhs_vector[m_lanes[i]] : rhs_vector[m_lanes[i] - 16];
+        return bit_cast<u128>(result);
+    }
+
+    static StringView name() { return "shuffle"sv; }
+
+private:
+    u8 m_lanes[16];
+};
+struct VectorSwizzle {
+    u128 operator()(u128 lhs, u128 rhs) const
+    {
+        auto vector = bit_cast<AK::SIMD::u8x16>(lhs);
+        auto indices = bit_cast<AK::SIMD::u8x16>(rhs);
+        AK::SIMD::u8x16 result;
+        for (size_t i = 0; i < 16; ++i)
+            result[i] = indices[i] < 16 ? vector[indices[i]] : 0;
+        return bit_cast<u128>(result);
+    }
+
+    static StringView name() { return "swizzle"sv; }
+};
+
+// Saturates the lanes of both operands into lanes of half the width, lhs ending up in the low half of the result.
+template<typename FromVector, typename ToVector>
+struct VectorNarrow {
+    u128 operator()(u128 lhs, u128 rhs) const
+    {
+        using ToElement = VectorElementType<ToVector>;
+        constexpr auto half_count = vector_lane_count<FromVector>;
+        static_assert(vector_lane_count<ToVector> == 2 * half_count);
+        auto lhs_vector = bit_cast<FromVector>(lhs);
+        auto rhs_vector = bit_cast<FromVector>(rhs);
+        ToVector result;
+        for (size_t i = 0; i < half_count; ++i) {
+            result[i] = static_cast<ToElement>(clamp<i64>(lhs_vector[i], NumericLimits<ToElement>::min(), NumericLimits<ToElement>::max()));
+            result[i + half_count] = static_cast<ToElement>(clamp<i64>(rhs_vector[i], NumericLimits<ToElement>::min(), NumericLimits<ToElement>::max()));
+        }
+        return bit_cast<u128>(result);
+    }
+
+    static StringView name() { return "narrow"sv; }
+};
+
+// Widens one half of the lanes, the signedness of FromVector determines whether to sign- or zero-extend.
+template<typename FromVector, typename ToVector, VectorHalf half>
+struct VectorExtend {
+    u128 operator()(u128 value) const
+    {
+        constexpr size_t offset = half == VectorHalf::High ? vector_lane_count<ToVector> : 0;
+        auto vector = bit_cast<FromVector>(value);
+        ToVector result;
+        for (size_t i = 0; i < vector_lane_count<ToVector>; ++i)
+            result[i] = vector[i + offset];
+        return bit_cast<u128>(result);
+    }
+
+    static StringView name() { return "extend"sv; }
+};
+
+template<typename FromVector, typename ToVector, VectorHalf half>
+struct VectorExtendedMultiply {
+    u128 operator()(u128 lhs, u128 rhs) const
+    {
+        using ToElement = VectorElementType<ToVector>;
+        constexpr size_t offset = half == VectorHalf::High ? vector_lane_count<ToVector> : 0;
+        auto lhs_vector = bit_cast<FromVector>(lhs);
+        auto rhs_vector = bit_cast<FromVector>(rhs);
+        ToVector result;
+        for (size_t i = 0; i < vector_lane_count<ToVector>; ++i)
+            result[i] = static_cast<ToElement>(lhs_vector[i + offset]) * static_cast<ToElement>(rhs_vector[i + offset]);
+        return bit_cast<u128>(result);
+    }
+
+    static StringView name() { return "extended_multiply"sv; }
+};
+
+template<typename FromVector, typename ToVector>
+struct VectorExtendedAddPairwise {
+    u128 operator()(u128 value) const
+    {
+        using ToElement = VectorElementType<ToVector>;
+        auto vector = bit_cast<FromVector>(value);
+        ToVector result;
+        for (size_t i = 0; i < vector_lane_count<ToVector>; ++i)
+            result[i] = static_cast<ToElement>(vector[2 * i]) + static_cast<ToElement>(vector[2 * i + 1]);
+        return bit_cast<u128>(result);
+    }
+
+    static StringView name() { return "extended_add_pairwise"sv; }
+};
+
+struct VectorDotProduct {
+    u128 operator()(u128 lhs, u128 rhs) const
+    {
+        auto lhs_vector = bit_cast<AK::SIMD::i16x8>(lhs);
+        auto rhs_vector = bit_cast<AK::SIMD::i16x8>(rhs);
+        AK::SIMD::u32x4 result;
+        for (size_t i = 0; i < 4; ++i) {
+            // The only sum that doesn't fit in an i32 is 2 * (-32768 * -32768), which must wrap around.
+            auto first = static_cast<i32>(lhs_vector[2 * i]) * static_cast<i32>(rhs_vector[2 * i]);
+            auto second = static_cast<i32>(lhs_vector[2 * i + 1]) * static_cast<i32>(rhs_vector[2 * i + 1]);
+            result[i] = static_cast<u32>(first) + static_cast<u32>(second);
+        }
+        return bit_cast<u128>(result);
+    }
+
+    static StringView name() { return "dot"sv; }
+};
+
+// Converts the low lanes of FromVector using a scalar operator, any lanes of ToVector left over are zeroed.
+template<typename FromVector, typename ToVector, typename Operator>
+struct VectorConvert {
+    u128 operator()(u128 value) const
+    {
+        auto vector = bit_cast<FromVector>(value);
+        ToVector result;
+        for (size_t i = 0; i < vector_lane_count<ToVector>; ++i) {
+            if (i < vector_lane_count<FromVector>)
+                result[i] = Operator {}(vector[i]);
+            else
+                result[i] = 0;
+        }
+        return bit_cast<u128>(result);
+    }
+
+    static StringView name() { return Operator::name(); }
+};
+
 }
@@ -8,6 +8,7 @@
 #include <AK/Result.h>
 #include <AK/SourceLocation.h>
 #include <AK/Try.h>
+#include <LibThreading/ThreadPool.h>
 #include <LibWasm/AbstractMachine/Validator.h>
 #include <LibWasm/Printer/Printer.h>
 
@@ -248,27 +249,60 @@ ErrorOr<void, ValidationError> Validator::validate(TableSection const& section)
 
 ErrorOr<void, ValidationError> Validator::validate(CodeSection const& section)
 {
-    size_t index = m_context.imported_function_count;
-    for (auto& entry : section.functions()) {
-        auto function_index = index++;
-        TRY(validate(FunctionIndex { function_index }));
-        auto& function_type = m_context.functions[function_index];
-        auto& function = entry.func();
+    auto& functions = section.functions();
+    size_t total_size = 0;
+    for (size_t i = 0; i < functions.size(); ++i) {
+        TRY(validate(FunctionIndex { m_context.imported_function_count + i }));
+        total_size += functions[i].size();
+    }
 
+    // A forked validator carries a copy of the whole module context, so it is reused for a whole range of functions
+    // instead of forking one for every single function.
+    auto validate_functions = [&](size_t begin, size_t end) -> ErrorOr<void, ValidationError> {
         auto function_validator = fork();
-        function_validator.m_context.locals = {};
-        function_validator.m_context.locals.extend(function_type.parameters());
-        for (auto& local : function.locals()) {
-            for (size_t i = 0; i < local.n(); ++i)
-                function_validator.m_context.locals.append(local.type());
+        for (size_t index = begin; index < end; ++index) {
+            auto& function_type = m_context.functions[m_context.imported_function_count + index];
+            auto& function = functions[index].func();
+
+            function_validator.m_entered_scopes.clear_with_capacity();
+            function_validator.m_block_details.clear_with_capacity();
+            function_validator.m_entered_blocks.clear_with_capacity();
+
+            function_validator.m_context.locals.clear_with_capacity();
+            function_validator.m_context.locals.extend(function_type.parameters());
+            for (auto& local : function.locals()) {
+                for (size_t i = 0; i < local.n(); ++i)
+                    function_validator.m_context.locals.append(local.type());
+            }
+
+            function_validator.m_context.labels = { ResultType { function_type.results() } };
+            function_validator.m_context.return_ = ResultType { function_type.results() };
+
+            TRY(function_validator.validate(function.body(), function_type.results()));
         }
+        return {};
+    };
 
-        function_validator.m_context.labels = { ResultType { function_type.results() } };
-        function_validator.m_context.return_ = ResultType { function_type.results() };
+    if (total_size < CodeSection::minimum_size_for_parallel_processing)
+        return validate_functions(0, functions.size());
+
+    // The forked validators only ever read from the shared context, so the ranges can be validated in parallel.
+    auto& pool = Threading::ThreadPool::the();
+    auto range_count = min(functions.size(), (pool.worker_count() + 1) * 4);
+    Vector<Optional<ValidationError>> errors;
+    errors.resize(range_count);
+    pool.parallel_for(range_count, [&](size_t range) {
+        auto begin = range * functions.size() / range_count;
+        auto end = (range + 1) * functions.size() / range_count;
+        if (auto result = validate_functions(begin, end); result.is_error())
+            errors[range] = result.release_error();
+    });
 
-        TRY(function_validator.validate(function.body(), function_type.results()));
+    // Report the same error as validating the functions in order would.
+    for (auto& error : errors) {
+        if (error.has_value())
+            return error.release_value();
     }
-
     return {};
 }
 
@@ -1937,7 +1971,8 @@ VALIDATE_INSTRUCTION(structured_end)
         return Errors::invalid("usage of structured end"sv);
 
     auto last_scope = m_entered_scopes.take_last();
-    m_context = m_parent_contexts.take_last();
+    // Blocks only ever add their own label in front of the enclosing ones.
+    m_context.labels.take_first();
     auto last_block_type = m_entered_blocks.take_last();
 
     switch (last_scope) {
@@ -1995,7 +2030,6 @@ VALIDATE_INSTRUCTION(block)
 
     m_entered_scopes.append(ChildScopeKind::Block);
     m_block_details.empend(stack.actual_size(), Empty {});
-    m_parent_contexts.append(m_context);
     m_entered_blocks.append(block_type);
     m_context.labels.prepend(ResultType { block_type.results() });
     return {};
@@ -2015,7 +2049,6 @@ VALIDATE_INSTRUCTION(loop)
 
     m_entered_scopes.append(ChildScopeKind::Block);
     m_block_details.empend(stack.actual_size(), Empty {});
-    m_parent_contexts.append(m_context);
     m_entered_blocks.append(block_type);
     m_context.labels.prepend(ResultType { block_type.parameters() });
     return {};
@@ -2039,7 +2072,6 @@ VALIDATE_INSTRUCTION(if_)
 
     m_entered_scopes.append(args.else_ip.has_value() ? ChildScopeKind::IfWithElse : ChildScopeKind::IfWithoutElse);
     m_block_details.empend(stack.actual_size(), BlockDetails::IfDetails { move(stack_snapshot) });
-    m_parent_contexts.append(m_context);
     m_entered_blocks.append(block_type);
     m_context.labels.prepend(ResultType { block_type.results() });
     return {};
@@ -2166,6 +2198,1864 @@ VALIDATE_INSTRUCTION(call_indirect)
     return {};
 }
 
+// https://webassembly.github.io/spec/core/bikeshed/#vector-instructions%E2%91%A2
+VALIDATE_INSTRUCTION(v128_load)
+{
+    TRY(validate(MemoryIndex { 0 }));
+
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+    if ((1ull << arg.align) > 16)
+        return Errors::out_of_bounds("memory op alignment"sv, 1ull << arg.align, 0, 16);
+
+    TRY((stack.take<ValueType::I32>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(v128_load8x8_s)
+{
+    TRY(validate(MemoryIndex { 0 }));
+
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+    if ((1ull << arg.align) > 8)
+        return Errors::out_of_bounds("memory op alignment"sv, 1ull << arg.align, 0, 8);
+
+    TRY((stack.take<ValueType::I32>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(v128_load8x8_u)
+{
+    TRY(validate(MemoryIndex { 0 }));
+
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+    if ((1ull << arg.align) > 8)
+        return Errors::out_of_bounds("memory op alignment"sv, 1ull << arg.align, 0, 8);
+
+    TRY((stack.take<ValueType::I32>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(v128_load16x4_s)
+{
+    TRY(validate(MemoryIndex { 0 }));
+
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+    if ((1ull << arg.align) > 8)
+        return Errors::out_of_bounds("memory op alignment"sv, 1ull << arg.align, 0, 8);
+
+    TRY((stack.take<ValueType::I32>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(v128_load16x4_u)
+{
+    TRY(validate(MemoryIndex { 0 }));
+
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+    if ((1ull << arg.align) > 8)
+        return Errors::out_of_bounds("memory op alignment"sv, 1ull << arg.align, 0, 8);
+
+    TRY((stack.take<ValueType::I32>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(v128_load32x2_s)
+{
+    TRY(validate(MemoryIndex { 0 }));
+
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+    if ((1ull << arg.align) > 8)
+        return Errors::out_of_bounds("memory op alignment"sv, 1ull << arg.align, 0, 8);
+
+    TRY((stack.take<ValueType::I32>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(v128_load32x2_u)
+{
+    TRY(validate(MemoryIndex { 0 }));
+
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+    if ((1ull << arg.align) > 8)
+        return Errors::out_of_bounds("memory op alignment"sv, 1ull << arg.align, 0, 8);
+
+    TRY((stack.take<ValueType::I32>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(v128_load8_splat)
+{
+    TRY(validate(MemoryIndex { 0 }));
+
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+    if ((1ull << arg.align) > 1)
+        return Errors::out_of_bounds("memory op alignment"sv, 1ull << arg.align, 0, 1);
+
+    TRY((stack.take<ValueType::I32>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(v128_load16_splat)
+{
+    TRY(validate(MemoryIndex { 0 }));
+
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+    if ((1ull << arg.align) > 2)
+        return Errors::out_of_bounds("memory op alignment"sv, 1ull << arg.align, 0, 2);
+
+    TRY((stack.take<ValueType::I32>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(v128_load32_splat)
+{
+    TRY(validate(MemoryIndex { 0 }));
+
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+    if ((1ull << arg.align) > 4)
+        return Errors::out_of_bounds("memory op alignment"sv, 1ull << arg.align, 0, 4);
+
+    TRY((stack.take<ValueType::I32>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(v128_load64_splat)
+{
+    TRY(validate(MemoryIndex { 0 }));
+
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+    if ((1ull << arg.align) > 8)
+        return Errors::out_of_bounds("memory op alignment"sv, 1ull << arg.align, 0, 8);
+
+    TRY((stack.take<ValueType::I32>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(v128_store)
+{
+    TRY(validate(MemoryIndex { 0 }));
+
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+    if ((1ull << arg.align) > 16)
+        return Errors::out_of_bounds("memory op alignment"sv, 1ull << arg.align, 0, 16);
+
+    TRY((stack.take<ValueType::V128, ValueType::I32>()));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(v128_const)
+{
+    is_constant = true;
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_shuffle)
+{
+    auto& arg = instruction.arguments().get<Instruction::ShuffleArgument>();
+    for (auto lane : arg.lanes) {
+        if (lane >= 32)
+            return Errors::out_of_bounds("lane index"sv, lane, 0, 32);
+    }
+
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_swizzle)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_splat)
+{
+    TRY(stack.take<ValueType::I32>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_splat)
+{
+    TRY(stack.take<ValueType::I32>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_splat)
+{
+    TRY(stack.take<ValueType::I32>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64x2_splat)
+{
+    TRY(stack.take<ValueType::I64>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f32x4_splat)
+{
+    TRY(stack.take<ValueType::F32>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f64x2_splat)
+{
+    TRY(stack.take<ValueType::F64>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_extract_lane_s)
+{
+    auto& arg = instruction.arguments().get<Instruction::LaneIndex>();
+    if (arg.lane >= 16)
+        return Errors::out_of_bounds("lane index"sv, arg.lane, 0, 16);
+
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_extract_lane_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::LaneIndex>();
+    if (arg.lane >= 16)
+        return Errors::out_of_bounds("lane index"sv, arg.lane, 0, 16);
+
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_replace_lane)
+{
+    auto& arg = instruction.arguments().get<Instruction::LaneIndex>();
+    if (arg.lane >= 16)
+        return Errors::out_of_bounds("lane index"sv, arg.lane, 0, 16);
+
+    TRY((stack.take<ValueType::I32, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_extract_lane_s)
+{
+    auto& arg = instruction.arguments().get<Instruction::LaneIndex>();
+    if (arg.lane >= 8)
+        return Errors::out_of_bounds("lane index"sv, arg.lane, 0, 8);
+
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_extract_lane_u)
+{
+    auto& arg = instruction.arguments().get<Instruction::LaneIndex>();
+    if (arg.lane >= 8)
+        return Errors::out_of_bounds("lane index"sv, arg.lane, 0, 8);
+
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_replace_lane)
+{
+    auto& arg = instruction.arguments().get<Instruction::LaneIndex>();
+    if (arg.lane >= 8)
+        return Errors::out_of_bounds("lane index"sv, arg.lane, 0, 8);
+
+    TRY((stack.take<ValueType::I32, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_extract_lane)
+{
+    auto& arg = instruction.arguments().get<Instruction::LaneIndex>();
+    if (arg.lane >= 4)
+        return Errors::out_of_bounds("lane index"sv, arg.lane, 0, 4);
+
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_replace_lane)
+{
+    auto& arg = instruction.arguments().get<Instruction::LaneIndex>();
+    if (arg.lane >= 4)
+        return Errors::out_of_bounds("lane index"sv, arg.lane, 0, 4);
+
+    TRY((stack.take<ValueType::I32, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64x2_extract_lane)
+{
+    auto& arg = instruction.arguments().get<Instruction::LaneIndex>();
+    if (arg.lane >= 2)
+        return Errors::out_of_bounds("lane index"sv, arg.lane, 0, 2);
+
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::I64));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64x2_replace_lane)
+{
+    auto& arg = instruction.arguments().get<Instruction::LaneIndex>();
+    if (arg.lane >= 2)
+        return Errors::out_of_bounds("lane index"sv, arg.lane, 0, 2);
+
+    TRY((stack.take<ValueType::I64, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f32x4_extract_lane)
+{
+    auto& arg = instruction.arguments().get<Instruction::LaneIndex>();
+    if (arg.lane >= 4)
+        return Errors::out_of_bounds("lane index"sv, arg.lane, 0, 4);
+
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::F32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f32x4_replace_lane)
+{
+    auto& arg = instruction.arguments().get<Instruction::LaneIndex>();
+    if (arg.lane >= 4)
+        return Errors::out_of_bounds("lane index"sv, arg.lane, 0, 4);
+
+    TRY((stack.take<ValueType::F32, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f64x2_extract_lane)
+{
+    auto& arg = instruction.arguments().get<Instruction::LaneIndex>();
+    if (arg.lane >= 2)
+        return Errors::out_of_bounds("lane index"sv, arg.lane, 0, 2);
+
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::F64));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f64x2_replace_lane)
+{
+    auto& arg = instruction.arguments().get<Instruction::LaneIndex>();
+    if (arg.lane >= 2)
+        return Errors::out_of_bounds("lane index"sv, arg.lane, 0, 2);
+
+    TRY((stack.take<ValueType::F64, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_eq)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_ne)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_lt_s)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_lt_u)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_gt_s)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_gt_u)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_le_s)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_le_u)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_ge_s)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_ge_u)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_eq)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_ne)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_lt_s)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_lt_u)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_gt_s)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_gt_u)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_le_s)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_le_u)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_ge_s)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_ge_u)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_eq)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_ne)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_lt_s)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_lt_u)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_gt_s)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_gt_u)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_le_s)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_le_u)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_ge_s)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_ge_u)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f32x4_eq)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f32x4_ne)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f32x4_lt)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f32x4_gt)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f32x4_le)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f32x4_ge)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f64x2_eq)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f64x2_ne)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f64x2_lt)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f64x2_gt)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f64x2_le)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f64x2_ge)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(v128_not)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(v128_and)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(v128_andnot)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(v128_or)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(v128_xor)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(v128_bitselect)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(v128_any_true)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(v128_load8_lane)
+{
+    TRY(validate(MemoryIndex { 0 }));
+
+    auto& arg = instruction.arguments().get<Instruction::MemoryAndLaneArgument>();
+    if ((1ull << arg.memory.align) > 1)
+        return Errors::out_of_bounds("memory op alignment"sv, 1ull << arg.memory.align, 0, 1);
+    if (arg.lane >= 16)
+        return Errors::out_of_bounds("lane index"sv, arg.lane, 0, 16);
+
+    TRY((stack.take<ValueType::V128, ValueType::I32>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(v128_load16_lane)
+{
+    TRY(validate(MemoryIndex { 0 }));
+
+    auto& arg = instruction.arguments().get<Instruction::MemoryAndLaneArgument>();
+    if ((1ull << arg.memory.align) > 2)
+        return Errors::out_of_bounds("memory op alignment"sv, 1ull << arg.memory.align, 0, 2);
+    if (arg.lane >= 8)
+        return Errors::out_of_bounds("lane index"sv, arg.lane, 0, 8);
+
+    TRY((stack.take<ValueType::V128, ValueType::I32>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(v128_load32_lane)
+{
+    TRY(validate(MemoryIndex { 0 }));
+
+    auto& arg = instruction.arguments().get<Instruction::MemoryAndLaneArgument>();
+    if ((1ull << arg.memory.align) > 4)
+        return Errors::out_of_bounds("memory op alignment"sv, 1ull << arg.memory.align, 0, 4);
+    if (arg.lane >= 4)
+        return Errors::out_of_bounds("lane index"sv, arg.lane, 0, 4);
+
+    TRY((stack.take<ValueType::V128, ValueType::I32>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(v128_load64_lane)
+{
+    TRY(validate(MemoryIndex { 0 }));
+
+    auto& arg = instruction.arguments().get<Instruction::MemoryAndLaneArgument>();
+    if ((1ull << arg.memory.align) > 8)
+        return Errors::out_of_bounds("memory op alignment"sv, 1ull << arg.memory.align, 0, 8);
+    if (arg.lane >= 2)
+        return Errors::out_of_bounds("lane index"sv, arg.lane, 0, 2);
+
+    TRY((stack.take<ValueType::V128, ValueType::I32>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(v128_store8_lane)
+{
+    TRY(validate(MemoryIndex { 0 }));
+
+    auto& arg = instruction.arguments().get<Instruction::MemoryAndLaneArgument>();
+    if ((1ull << arg.memory.align) > 1)
+        return Errors::out_of_bounds("memory op alignment"sv, 1ull << arg.memory.align, 0, 1);
+    if (arg.lane >= 16)
+        return Errors::out_of_bounds("lane index"sv, arg.lane, 0, 16);
+
+    TRY((stack.take<ValueType::V128, ValueType::I32>()));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(v128_store16_lane)
+{
+    TRY(validate(MemoryIndex { 0 }));
+
+    auto& arg = instruction.arguments().get<Instruction::MemoryAndLaneArgument>();
+    if ((1ull << arg.memory.align) > 2)
+        return Errors::out_of_bounds("memory op alignment"sv, 1ull << arg.memory.align, 0, 2);
+    if (arg.lane >= 8)
+        return Errors::out_of_bounds("lane index"sv, arg.lane, 0, 8);
+
+    TRY((stack.take<ValueType::V128, ValueType::I32>()));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(v128_store32_lane)
+{
+    TRY(validate(MemoryIndex { 0 }));
+
+    auto& arg = instruction.arguments().get<Instruction::MemoryAndLaneArgument>();
+    if ((1ull << arg.memory.align) > 4)
+        return Errors::out_of_bounds("memory op alignment"sv, 1ull << arg.memory.align, 0, 4);
+    if (arg.lane >= 4)
+        return Errors::out_of_bounds("lane index"sv, arg.lane, 0, 4);
+
+    TRY((stack.take<ValueType::V128, ValueType::I32>()));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(v128_store64_lane)
+{
+    TRY(validate(MemoryIndex { 0 }));
+
+    auto& arg = instruction.arguments().get<Instruction::MemoryAndLaneArgument>();
+    if ((1ull << arg.memory.align) > 8)
+        return Errors::out_of_bounds("memory op alignment"sv, 1ull << arg.memory.align, 0, 8);
+    if (arg.lane >= 2)
+        return Errors::out_of_bounds("lane index"sv, arg.lane, 0, 2);
+
+    TRY((stack.take<ValueType::V128, ValueType::I32>()));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(v128_load32_zero)
+{
+    TRY(validate(MemoryIndex { 0 }));
+
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+    if ((1ull << arg.align) > 4)
+        return Errors::out_of_bounds("memory op alignment"sv, 1ull << arg.align, 0, 4);
+
+    TRY((stack.take<ValueType::I32>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(v128_load64_zero)
+{
+    TRY(validate(MemoryIndex { 0 }));
+
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+    if ((1ull << arg.align) > 8)
+        return Errors::out_of_bounds("memory op alignment"sv, 1ull << arg.align, 0, 8);
+
+    TRY((stack.take<ValueType::I32>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f32x4_demote_f64x2_zero)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f64x2_promote_low_f32x4)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_abs)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_neg)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_popcnt)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_all_true)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_bitmask)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_narrow_i16x8_s)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_narrow_i16x8_u)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f32x4_ceil)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f32x4_floor)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f32x4_trunc)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f32x4_nearest)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_shl)
+{
+    TRY((stack.take<ValueType::I32, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_shr_s)
+{
+    TRY((stack.take<ValueType::I32, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_shr_u)
+{
+    TRY((stack.take<ValueType::I32, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_add)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_add_sat_s)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_add_sat_u)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_sub)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_sub_sat_s)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_sub_sat_u)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f64x2_ceil)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f64x2_floor)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_min_s)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_min_u)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_max_s)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_max_u)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f64x2_trunc)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_avgr_u)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_extadd_pairwise_i8x16_s)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_extadd_pairwise_i8x16_u)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_extadd_pairwise_i16x8_s)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_extadd_pairwise_i16x8_u)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_abs)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_neg)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_q15mulr_sat_s)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_all_true)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_bitmask)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_narrow_i32x4_s)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_narrow_i32x4_u)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_extend_low_i8x16_s)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_extend_high_i8x16_s)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_extend_low_i8x16_u)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_extend_high_i8x16_u)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_shl)
+{
+    TRY((stack.take<ValueType::I32, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_shr_s)
+{
+    TRY((stack.take<ValueType::I32, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_shr_u)
+{
+    TRY((stack.take<ValueType::I32, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_add)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_add_sat_s)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_add_sat_u)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_sub)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_sub_sat_s)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_sub_sat_u)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f64x2_nearest)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_mul)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_min_s)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_min_u)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_max_s)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_max_u)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_avgr_u)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_extmul_low_i8x16_s)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_extmul_high_i8x16_s)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_extmul_low_i8x16_u)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i16x8_extmul_high_i8x16_u)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_abs)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_neg)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_all_true)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_bitmask)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_extend_low_i16x8_s)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_extend_high_i16x8_s)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_extend_low_i16x8_u)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_extend_high_i16x8_u)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_shl)
+{
+    TRY((stack.take<ValueType::I32, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_shr_s)
+{
+    TRY((stack.take<ValueType::I32, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_shr_u)
+{
+    TRY((stack.take<ValueType::I32, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_add)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_sub)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_mul)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_min_s)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_min_u)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_max_s)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_max_u)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_dot_i16x8_s)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_extmul_low_i16x8_s)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_extmul_high_i16x8_s)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_extmul_low_i16x8_u)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_extmul_high_i16x8_u)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64x2_abs)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64x2_neg)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64x2_all_true)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64x2_bitmask)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64x2_extend_low_i32x4_s)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64x2_extend_high_i32x4_s)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64x2_extend_low_i32x4_u)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64x2_extend_high_i32x4_u)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64x2_shl)
+{
+    TRY((stack.take<ValueType::I32, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64x2_shr_s)
+{
+    TRY((stack.take<ValueType::I32, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64x2_shr_u)
+{
+    TRY((stack.take<ValueType::I32, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64x2_add)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64x2_sub)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64x2_mul)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64x2_eq)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64x2_ne)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64x2_lt_s)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64x2_gt_s)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64x2_le_s)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64x2_ge_s)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64x2_extmul_low_i32x4_s)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64x2_extmul_high_i32x4_s)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64x2_extmul_low_i32x4_u)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i64x2_extmul_high_i32x4_u)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f32x4_abs)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f32x4_neg)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f32x4_sqrt)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f32x4_add)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f32x4_sub)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f32x4_mul)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f32x4_div)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f32x4_min)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f32x4_max)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f32x4_pmin)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f32x4_pmax)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f64x2_abs)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f64x2_neg)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f64x2_sqrt)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f64x2_add)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f64x2_sub)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f64x2_mul)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f64x2_div)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f64x2_min)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f64x2_max)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f64x2_pmin)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f64x2_pmax)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_trunc_sat_f32x4_s)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_trunc_sat_f32x4_u)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f32x4_convert_i32x4_s)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f32x4_convert_i32x4_u)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_trunc_sat_f64x2_s_zero)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i32x4_trunc_sat_f64x2_u_zero)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f64x2_convert_low_i32x4_s)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(f64x2_convert_low_i32x4_u)
+{
+    TRY(stack.take<ValueType::V128>());
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
 ErrorOr<void, ValidationError> Validator::validate(Instruction const& instruction, Stack& stack, bool& is_constant)
 {
     switch (instruction.opcode().value()) {
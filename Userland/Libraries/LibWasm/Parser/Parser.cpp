@@ -10,6 +10,7 @@
 #include <AK/MemoryStream.h>
 #include <AK/ScopeGuard.h>
 #include <AK/ScopeLogger.h>
+#include <LibThreading/ThreadPool.h>
 #include <LibWasm/Types.h>
 
 namespace Wasm {
@@ -137,6 +138,8 @@ ParseResult<ValueType> ValueType::parse(Stream& stream)
         return ValueType(F32);
     case Constants::f64_tag:
         return ValueType(F64);
+    case Constants::v128_tag:
+        return ValueType(V128);
     case Constants::function_reference_tag:
         return ValueType(FunctionReference);
     case Constants::extern_reference_tag:
@@ -775,6 +778,304 @@ ParseResult<Vector<Instruction>> Instruction::parse(Stream& stream, InstructionP
             default:
                 return ParseError::UnknownInstruction;
             }
+            break;
+        }
+        case 0xfd: {
+            // These are SIMD instructions.
+            auto selector_or_error = stream.read_value<LEB128<u32>>();
+            if (selector_or_error.is_error())
+                return with_eof_check(stream, ParseError::InvalidInput);
+            u32 selector = selector_or_error.release_value();
+            if (selector > 0xff)
+                return ParseError::UnknownInstruction;
+            OpCode full_opcode { 0xfd00 | selector };
+            switch (full_opcode.value()) {
+            case Instructions::v128_load.value():
+            case Instructions::v128_load8x8_s.value():
+            case Instructions::v128_load8x8_u.value():
+            case Instructions::v128_load16x4_s.value():
+            case Instructions::v128_load16x4_u.value():
+            case Instructions::v128_load32x2_s.value():
+            case Instructions::v128_load32x2_u.value():
+            case Instructions::v128_load8_splat.value():
+            case Instructions::v128_load16_splat.value():
+            case Instructions::v128_load32_splat.value():
+            case Instructions::v128_load64_splat.value():
+            case Instructions::v128_store.value():
+            case Instructions::v128_load32_zero.value():
+            case Instructions::v128_load64_zero.value():
+            case Instructions::v128_load8_lane.value():
+            case Instructions::v128_load16_lane.value():
+            case Instructions::v128_load32_lane.value():
+            case Instructions::v128_load64_lane.value():
+            case Instructions::v128_store8_lane.value():
+            case Instructions::v128_store16_lane.value():
+            case Instructions::v128_store32_lane.value():
+            case Instructions::v128_store64_lane.value(): {
+                // op (align offset) [lane]
+                auto align_or_error = stream.read_value<LEB128<size_t>>();
+                if (align_or_error.is_error())
+                    return with_eof_check(stream, ParseError::InvalidInput);
+                size_t align = align_or_error.release_value();
+
+                auto offset_or_error = stream.read_value<LEB128<size_t>>();
+                if (offset_or_error.is_error())
+                    return with_eof_check(stream, ParseError::InvalidInput);
+                size_t offset = offset_or_error.release_value();
+
+                MemoryArgument memory_argument { static_cast<u32>(align), static_cast<u32>(offset) };
+                if (full_opcode < Instructions::v128_load8_lane || full_opcode > Instructions::v128_store64_lane) {
+                    resulting_instructions.append(Instruction { full_opcode, memory_argument });
+                    break;
+                }
+
+                auto lane_or_error = stream.read_value<u8>();
+                if (lane_or_error.is_error())
+                    return with_eof_check(stream, ParseError::InvalidInput);
+                resulting_instructions.append(Instruction { full_opcode, MemoryAndLaneArgument { memory_argument, lane_or_error.release_value() } });
+                break;
+            }
+            case Instructions::i8x16_extract_lane_s.value():
+            case Instructions::i8x16_extract_lane_u.value():
+            case Instructions::i8x16_replace_lane.value():
+            case Instructions::i16x8_extract_lane_s.value():
+            case Instructions::i16x8_extract_lane_u.value():
+            case Instructions::i16x8_replace_lane.value():
+            case Instructions::i32x4_extract_lane.value():
+            case Instructions::i32x4_replace_lane.value():
+            case Instructions::i64x2_extract_lane.value():
+            case Instructions::i64x2_replace_lane.value():
+            case Instructions::f32x4_extract_lane.value():
+            case Instructions::f32x4_replace_lane.value():
+            case Instructions::f64x2_extract_lane.value():
+            case Instructions::f64x2_replace_lane.value(): {
+                auto lane_or_error = stream.read_value<u8>();
+                if (lane_or_error.is_error())
+                    return with_eof_check(stream, ParseError::InvalidInput);
+                resulting_instructions.append(Instruction { full_opcode, LaneIndex { lane_or_error.release_value() } });
+                break;
+            }
+            case Instructions::v128_const.value(): {
+                // op literal
+                u128 value;
+                if (stream.read_entire_buffer(value.bytes()).is_error())
+                    return with_eof_check(stream, ParseError::InvalidImmediate);
+
+                resulting_instructions.append(Instruction { full_opcode, value });
+                break;
+            }
+            case Instructions::i8x16_shuffle.value(): {
+                ShuffleArgument argument;
+                if (stream.read_entire_buffer({ argument.lanes, sizeof(argument.lanes) }).is_error())
+                    return with_eof_check(stream, ParseError::InvalidImmediate);
+
+                resulting_instructions.append(Instruction { full_opcode, argument });
+                break;
+            }
+            case Instructions::i8x16_swizzle.value():
+            case Instructions::i8x16_splat.value():
+            case Instructions::i16x8_splat.value():
+            case Instructions::i32x4_splat.value():
+            case Instructions::i64x2_splat.value():
+            case Instructions::f32x4_splat.value():
+            case Instructions::f64x2_splat.value():
+            case Instructions::i8x16_eq.value():
+            case Instructions::i8x16_ne.value():
+            case Instructions::i8x16_lt_s.value():
+            case Instructions::i8x16_lt_u.value():
+            case Instructions::i8x16_gt_s.value():
+            case Instructions::i8x16_gt_u.value():
+            case Instructions::i8x16_le_s.value():
+            case Instructions::i8x16_le_u.value():
+            case Instructions::i8x16_ge_s.value():
+            case Instructions::i8x16_ge_u.value():
+            case Instructions::i16x8_eq.value():
+            case Instructions::i16x8_ne.value():
+            case Instructions::i16x8_lt_s.value():
+            case Instructions::i16x8_lt_u.value():
+            case Instructions::i16x8_gt_s.value():
+            case Instructions::i16x8_gt_u.value():
+            case Instructions::i16x8_le_s.value():
+            case Instructions::i16x8_le_u.value():
+            case Instructions::i16x8_ge_s.value():
+            case Instructions::i16x8_ge_u.value():
+            case Instructions::i32x4_eq.value():
+            case Instructions::i32x4_ne.value():
+            case Instructions::i32x4_lt_s.value():
+            case Instructions::i32x4_lt_u.value():
+            case Instructions::i32x4_gt_s.value():
+            case Instructions::i32x4_gt_u.value():
+            case Instructions::i32x4_le_s.value():
+            case Instructions::i32x4_le_u.value():
+            case Instructions::i32x4_ge_s.value():
+            case Instructions::i32x4_ge_u.value():
+            case Instructions::f32x4_eq.value():
+            case Instructions::f32x4_ne.value():
+            case Instructions::f32x4_lt.value():
+            case Instructions::f32x4_gt.value():
+            case Instructions::f32x4_le.value():
+            case Instructions::f32x4_ge.value():
+            case Instructions::f64x2_eq.value():
+            case Instructions::f64x2_ne.value():
+            case Instructions::f64x2_lt.value():
+            case Instructions::f64x2_gt.value():
+            case Instructions::f64x2_le.value():
+            case Instructions::f64x2_ge.value():
+            case Instructions::v128_not.value():
+            case Instructions::v128_and.value():
+            case Instructions::v128_andnot.value():
+            case Instructions::v128_or.value():
+            case Instructions::v128_xor.value():
+            case Instructions::v128_bitselect.value():
+            case Instructions::v128_any_true.value():
+            case Instructions::f32x4_demote_f64x2_zero.value():
+            case Instructions::f64x2_promote_low_f32x4.value():
+            case Instructions::i8x16_abs.value():
+            case Instructions::i8x16_neg.value():
+            case Instructions::i8x16_popcnt.value():
+            case Instructions::i8x16_all_true.value():
+            case Instructions::i8x16_bitmask.value():
+            case Instructions::i8x16_narrow_i16x8_s.value():
+            case Instructions::i8x16_narrow_i16x8_u.value():
+            case Instructions::f32x4_ceil.value():
+            case Instructions::f32x4_floor.value():
+            case Instructions::f32x4_trunc.value():
+            case Instructions::f32x4_nearest.value():
+            case Instructions::i8x16_shl.value():
+            case Instructions::i8x16_shr_s.value():
+            case Instructions::i8x16_shr_u.value():
+            case Instructions::i8x16_add.value():
+            case Instructions::i8x16_add_sat_s.value():
+            case Instructions::i8x16_add_sat_u.value():
+            case Instructions::i8x16_sub.value():
+            case Instructions::i8x16_sub_sat_s.value():
+            case Instructions::i8x16_sub_sat_u.value():
+            case Instructions::f64x2_ceil.value():
+            case Instructions::f64x2_floor.value():
+            case Instructions::i8x16_min_s.value():
+            case Instructions::i8x16_min_u.value():
+            case Instructions::i8x16_max_s.value():
+            case Instructions::i8x16_max_u.value():
+            case Instructions::f64x2_trunc.value():
+            case Instructions::i8x16_avgr_u.value():
+            case Instructions::i16x8_extadd_pairwise_i8x16_s.value():
+            case Instructions::i16x8_extadd_pairwise_i8x16_u.value():
+            case Instructions::i32x4_extadd_pairwise_i16x8_s.value():
+            case Instructions::i32x4_extadd_pairwise_i16x8_u.value():
+            case Instructions::i16x8_abs.value():
+            case Instructions::i16x8_neg.value():
+            case Instructions::i16x8_q15mulr_sat_s.value():
+            case Instructions::i16x8_all_true.value():
+            case Instructions::i16x8_bitmask.value():
+            case Instructions::i16x8_narrow_i32x4_s.value():
+            case Instructions::i16x8_narrow_i32x4_u.value():
+            case Instructions::i16x8_extend_low_i8x16_s.value():
+            case Instructions::i16x8_extend_high_i8x16_s.value():
+            case Instructions::i16x8_extend_low_i8x16_u.value():
+            case Instructions::i16x8_extend_high_i8x16_u.value():
+            case Instructions::i16x8_shl.value():
+            case Instructions::i16x8_shr_s.value():
+            case Instructions::i16x8_shr_u.value():
+            case Instructions::i16x8_add.value():
+            case Instructions::i16x8_add_sat_s.value():
+            case Instructions::i16x8_add_sat_u.value():
+            case Instructions::i16x8_sub.value():
+            case Instructions::i16x8_sub_sat_s.value():
+            case Instructions::i16x8_sub_sat_u.value():
+            case Instructions::f64x2_nearest.value():
+            case Instructions::i16x8_mul.value():
+            case Instructions::i16x8_min_s.value():
+            case Instructions::i16x8_min_u.value():
+            case Instructions::i16x8_max_s.value():
+            case Instructions::i16x8_max_u.value():
+            case Instructions::i16x8_avgr_u.value():
+            case Instructions::i16x8_extmul_low_i8x16_s.value():
+            case Instructions::i16x8_extmul_high_i8x16_s.value():
+            case Instructions::i16x8_extmul_low_i8x16_u.value():
+            case Instructions::i16x8_extmul_high_i8x16_u.value():
+            case Instructions::i32x4_abs.value():
+            case Instructions::i32x4_neg.value():
+            case Instructions::i32x4_all_true.value():
+            case Instructions::i32x4_bitmask.value():
+            case Instructions::i32x4_extend_low_i16x8_s.value():
+            case Instructions::i32x4_extend_high_i16x8_s.value():
+            case Instructions::i32x4_extend_low_i16x8_u.value():
+            case Instructions::i32x4_extend_high_i16x8_u.value():
+            case Instructions::i32x4_shl.value():
+            case Instructions::i32x4_shr_s.value():
+            case Instructions::i32x4_shr_u.value():
+            case Instructions::i32x4_add.value():
+            case Instructions::i32x4_sub.value():
+            case Instructions::i32x4_mul.value():
+            case Instructions::i32x4_min_s.value():
+            case Instructions::i32x4_min_u.value():
+            case Instructions::i32x4_max_s.value():
+            case Instructions::i32x4_max_u.value():
+            case Instructions::i32x4_dot_i16x8_s.value():
+            case Instructions::i32x4_extmul_low_i16x8_s.value():
+            case Instructions::i32x4_extmul_high_i16x8_s.value():
+            case Instructions::i32x4_extmul_low_i16x8_u.value():
+            case Instructions::i32x4_extmul_high_i16x8_u.value():
+            case Instructions::i64x2_abs.value():
+            case Instructions::i64x2_neg.value():
+            case Instructions::i64x2_all_true.value():
+            case Instructions::i64x2_bitmask.value():
+            case Instructions::i64x2_extend_low_i32x4_s.value():
+            case Instructions::i64x2_extend_high_i32x4_s.value():
+            case Instructions::i64x2_extend_low_i32x4_u.value():
+            case Instructions::i64x2_extend_high_i32x4_u.value():
+            case Instructions::i64x2_shl.value():
+            case Instructions::i64x2_shr_s.value():
+            case Instructions::i64x2_shr_u.value():
+            case Instructions::i64x2_add.value():
+            case Instructions::i64x2_sub.value():
+            case Instructions::i64x2_mul.value():
+            case Instructions::i64x2_eq.value():
+            case Instructions::i64x2_ne.value():
+            case Instructions::i64x2_lt_s.value():
+            case Instructions::i64x2_gt_s.value():
+            case Instructions::i64x2_le_s.value():
+            case Instructions::i64x2_ge_s.value():
+            case Instructions::i64x2_extmul_low_i32x4_s.value():
+            case Instructions::i64x2_extmul_high_i32x4_s.value():
+            case Instructions::i64x2_extmul_low_i32x4_u.value():
+            case Instructions::i64x2_extmul_high_i32x4_u.value():
+            case Instructions::f32x4_abs.value():
+            case Instructions::f32x4_neg.value():
+            case Instructions::f32x4_sqrt.value():
+            case Instructions::f32x4_add.value():
+            case Instructions::f32x4_sub.value():
+            case Instructions::f32x4_mul.value():
+            case Instructions::f32x4_div.value():
+            case Instructions::f32x4_min.value():
+            case Instructions::f32x4_max.value():
+            case Instructions::f32x4_pmin.value():
+            case Instructions::f32x4_pmax.value():
+            case Instructions::f64x2_abs.value():
+            case Instructions::f64x2_neg.value():
+            case Instructions::f64x2_sqrt.value():
+            case Instructions::f64x2_add.value():
+            case Instructions::f64x2_sub.value():
+            case Instructions::f64x2_mul.value():
+            case Instructions::f64x2_div.value():
+            case Instructions::f64x2_min.value():
+            case Instructions::f64x2_max.value():
+            case Instructions::f64x2_pmin.value():
+            case Instructions::f64x2_pmax.value():
+            case Instructions::i32x4_trunc_sat_f32x4_s.value():
+            case Instructions::i32x4_trunc_sat_f32x4_u.value():
+            case Instructions::f32x4_convert_i32x4_s.value():
+            case Instructions::f32x4_convert_i32x4_u.value():
+            case Instructions::i32x4_trunc_sat_f64x2_s_zero.value():
+            case Instructions::i32x4_trunc_sat_f64x2_u_zero.value():
+            case Instructions::f64x2_convert_low_i32x4_s.value():
+            case Instructions::f64x2_convert_low_i32x4_u.value():
+                resulting_instructions.append(Instruction { full_opcode });
+                break;
+            default:
+                return ParseError::UnknownInstruction;
+            }
+            break;
         }
         }
     } while (!nested_instructions.is_empty());
@@ -1198,10 +1499,55 @@ ParseResult<CodeSection::Code> CodeSection::Code::parse(Stream& stream)
 ParseResult<CodeSection> CodeSection::parse(Stream& stream)
 {
     ScopeLogger<WASM_BINPARSER_DEBUG> logger("CodeSection"sv);
-    auto result = parse_vector<Code>(stream);
-    if (result.is_error())
-        return result.error();
-    return CodeSection { result.release_value() };
+    auto count_or_error = stream.read_value<LEB128<size_t>>();
+    if (count_or_error.is_error())
+        return with_eof_check(stream, ParseError::ExpectedSize);
+    size_t count = count_or_error.release_value();
+
+    // Pull all of the bodies out of the stream first, so that they can be parsed independently of each other.
+    Vector<ByteBuffer> bodies;
+    size_t total_size = 0;
+    for (size_t i = 0; i < count; ++i) {
+        auto size_or_error = stream.read_value<LEB128<size_t>>();
+        if (size_or_error.is_error())
+            return with_eof_check(stream, ParseError::InvalidSize);
+        size_t size = size_or_error.release_value();
+
+        // Don't trust the size enough to allocate all of it up front, the stream might end well before that.
+        auto body_stream = ConstrainedStream { stream, size };
+        auto body_or_error = body_stream.read_until_eof();
+        if (body_or_error.is_error())
+            return with_eof_check(stream, ParseError::InvalidInput);
+        if (body_or_error.value().size() != size)
+            return ParseError::UnexpectedEof;
+
+        total_size += size;
+        bodies.append(body_or_error.release_value());
+    }
+
+    Vector<Optional<ParseResult<Func>>> results;
+    results.resize(count);
+    auto parse_body = [&](size_t index) {
+        FixedMemoryStream body_stream { bodies[index].bytes() };
+        results[index] = Func::parse(body_stream);
+    };
+
+    if (total_size >= minimum_size_for_parallel_processing) {
+        Threading::ThreadPool::the().parallel_for(count, parse_body);
+    } else {
+        for (size_t i = 0; i < count; ++i)
+            parse_body(i);
+    }
+
+    Vector<Code> functions;
+    functions.ensure_capacity(count);
+    for (size_t i = 0; i < count; ++i) {
+        auto& result = *results[i];
+        if (result.is_error())
+            return result.error();
+        functions.unchecked_append(Code { static_cast<u32>(bodies[i].size()), result.release_value() });
+    }
+    return CodeSection { move(functions) };
 }
 
 ParseResult<DataSection::Data> DataSection::Data::parse(Stream& stream)
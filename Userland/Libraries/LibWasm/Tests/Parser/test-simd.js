@@ -0,0 +1,41 @@
+// (func $f (param i32) (result i32)
+//     (i32x4.extract_lane 3 (i32x4.add (i32x4.splat (local.get 0)) (v128.const i32x4 1 2 3 4))))
+// (func $g (param i32) (result i32)
+//     (v128.store (i32.const 0) (i32x4.splat (local.get 0)))
+//     (i8x16.extract_lane_u 0 (i8x16.shuffle 15 14 13 12 11 10 9 8 7 6 5 4 3 2 1 0
+//         (v128.load (i32.const 0)) (i32x4.splat (i32.const 0)))))
+// (func $h (param i32) (result i32)
+//     (i32x4.bitmask (i32x4.lt_s (i32x4.splat (local.get 0)) (i32x4.splat (i32.const 0)))))
+// prettier-ignore
+const simdModuleContents = new Uint8Array([
+        0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x06, 0x01, 0x60, 0x01, 0x7f, 0x01, 0x7f,
+        0x03, 0x04, 0x03, 0x00, 0x00, 0x00, 0x05, 0x03, 0x01, 0x00, 0x01, 0x07, 0x0d, 0x03, 0x01, 0x66,
+        0x00, 0x00, 0x01, 0x67, 0x00, 0x01, 0x01, 0x68, 0x00, 0x02, 0x0a, 0x5c, 0x03, 0x1e, 0x00, 0x20,
+        0x00, 0xfd, 0x11, 0xfd, 0x0c, 0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00,
+        0x00, 0x04, 0x00, 0x00, 0x00, 0xfd, 0xae, 0x01, 0xfd, 0x1b, 0x03, 0x0b, 0x2b, 0x00, 0x41, 0x00,
+        0x20, 0x00, 0xfd, 0x11, 0xfd, 0x0b, 0x04, 0x00, 0x41, 0x00, 0xfd, 0x00, 0x04, 0x00, 0x41, 0x00,
+        0xfd, 0x11, 0xfd, 0x0d, 0x0f, 0x0e, 0x0d, 0x0c, 0x0b, 0x0a, 0x09, 0x08, 0x07, 0x06, 0x05, 0x04,
+        0x03, 0x02, 0x01, 0x00, 0xfd, 0x16, 0x00, 0x0b, 0x0f, 0x00, 0x20, 0x00, 0xfd, 0x11, 0x41, 0x00,
+        0xfd, 0x11, 0xfd, 0x39, 0xfd, 0xa4, 0x01, 0x0b
+]);
+
+test("vector lanes are computed independently", () => {
+    const module = parseWebAssemblyModule(simdModuleContents);
+    const f = module.getExport("f");
+    expect(module.invoke(f, 0x12345678)).toBe(0x1234567c);
+    expect(module.invoke(f, -5)).toBe(-1);
+});
+
+test("vector memory accesses and shuffles", () => {
+    const module = parseWebAssemblyModule(simdModuleContents);
+    const g = module.getExport("g");
+    expect(module.invoke(g, 0x12345678)).toBe(0x12);
+    expect(module.invoke(g, -5)).toBe(0xff);
+});
+
+test("vector comparisons produce lane masks", () => {
+    const module = parseWebAssemblyModule(simdModuleContents);
+    const h = module.getExport("h");
+    expect(module.invoke(h, 7)).toBe(0);
+    expect(module.invoke(h, -7)).toBe(0b1111);
+});
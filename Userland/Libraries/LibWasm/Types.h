@@ -12,6 +12,7 @@
 #include <AK/LEB128.h>
 #include <AK/NonnullOwnPtrVector.h>
 #include <AK/Result.h>
+#include <AK/UFixedBigInt.h>
 #include <AK/Variant.h>
 #include <LibWasm/Constants.h>
 #include <LibWasm/Forward.h>
@@ -193,6 +194,7 @@ public:
         I64,
         F32,
         F64,
+        V128,
         FunctionReference,
         ExternReference,
         NullFunctionReference,
@@ -223,6 +225,8 @@ public:
             return "f32";
         case F64:
             return "f64";
+        case V128:
+            return "v128";
         case FunctionReference:
             return "funcref";
         case ExternReference:
@@ -444,6 +448,19 @@ public:
         u32 offset;
     };
 
+    struct LaneIndex {
+        u8 lane;
+    };
+
+    struct MemoryAndLaneArgument {
+        MemoryArgument memory;
+        u8 lane;
+    };
+
+    struct ShuffleArgument {
+        u8 lanes[16];
+    };
+
     template<typename T>
     explicit Instruction(OpCode opcode, T argument)
         : m_opcode(opcode)
@@ -467,8 +484,11 @@ private:
         GlobalIndex,
         IndirectCallArgs,
         LabelIndex,
+        LaneIndex,
         LocalIndex,
         MemoryArgument,
+        MemoryAndLaneArgument,
+        ShuffleArgument,
         StructuredInstructionArgs,
         TableBranchArgs,
         TableElementArgs,
@@ -480,6 +500,7 @@ private:
         float,
         i32,
         i64,
+        u128,
         u8 // Empty state
     > m_arguments;
     // clang-format on
@@ -905,6 +926,10 @@ public:
 
     static constexpr u8 section_id = 10;
 
+    // Function bodies are independent of each other, so big code sections are parsed and validated in parallel.
+    // Below this many bytes of code, handing the bodies out to other threads costs more than it saves.
+    static constexpr size_t minimum_size_for_parallel_processing = 64 * KiB;
+
     explicit CodeSection(Vector<Code> funcs)
         : m_functions(move(funcs))
     {
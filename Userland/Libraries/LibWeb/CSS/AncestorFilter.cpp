@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/StringHash.h>
+#include <LibWeb/CSS/AncestorFilter.h>
+#include <LibWeb/CSS/Selector.h>
+#include <LibWeb/DOM/Element.h>
+#include <LibWeb/HTML/AttributeNames.h>
+
+namespace Web::CSS {
+
+u32 AncestorFilter::hash(NameType type, StringView name)
+{
+    // NOTE: Tag names are hashed case-insensitively, as they are matched case-insensitively outside of HTML documents.
+    auto seed = to_underlying(type);
+    auto hash = type == NameType::TagName
+        ? case_insensitive_string_hash(name.characters_without_null_termination(), name.length(), seed)
+        : string_hash(name.characters_without_null_termination(), name.length(), seed);
+    return hash != 0 ? hash : 1;
+}
+
+template<typename Callback>
+static void for_each_hash(DOM::Element const& element, Callback callback)
+{
+    callback(AncestorFilter::hash(AncestorFilter::NameType::TagName, element.local_name()));
+    if (auto id = element.get_attribute(HTML::AttributeNames::id); !id.is_null())
+        callback(AncestorFilter::hash(AncestorFilter::NameType::Id, id));
+    for (auto const& class_name : element.class_names())
+        callback(AncestorFilter::hash(AncestorFilter::NameType::Class, class_name));
+}
+
+void AncestorFilter::push(DOM::Element const& element)
+{
+    for_each_hash(element, [this](u32 hash) { m_filter.add(hash); });
+    m_elements.append(&element);
+}
+
+void AncestorFilter::pop(DOM::Element const& element)
+{
+    VERIFY(m_elements.last() == &element);
+    m_elements.take_last();
+    for_each_hash(element, [this](u32 hash) { m_filter.remove(hash); });
+}
+
+bool AncestorFilter::can_be_used_for(DOM::Element const& element) const
+{
+    // NOTE: This has to agree with how the SelectorEngine walks up the tree.
+    DOM::Element const* parent_element = nullptr;
+    for (auto const* ancestor = element.parent(); ancestor; ancestor = ancestor->parent()) {
+        if (is<DOM::Element>(*ancestor)) {
+            parent_element = static_cast<DOM::Element const*>(ancestor);
+            break;
+        }
+    }
+
+    if (m_elements.is_empty())
+        return !parent_element;
+    return m_elements.last() == parent_element;
+}
+
+bool AncestorFilter::should_reject(Selector const& selector) const
+{
+    for (auto hash : selector.ancestor_hashes()) {
+        if (hash == 0)
+            break;
+        if (!m_filter.may_contain(hash))
+            return true;
+    }
+    return false;
+}
+
+}
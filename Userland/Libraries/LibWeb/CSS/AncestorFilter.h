@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/CountingBloomFilter.h>
+#include <AK/StringView.h>
+#include <AK/Vector.h>
+#include <LibWeb/Forward.h>
+
+namespace Web::CSS {
+
+// Tracks the tag names, IDs and classes of the elements on the way down the tree to the element whose style is being
+// computed. A selector that requires an ancestor with a name that none of them has can then be rejected right away,
+// instead of walking all the way up the tree for every descendant combinator.
+class AncestorFilter {
+public:
+    enum class NameType : u32 {
+        TagName = 1,
+        Id,
+        Class,
+    };
+    // Never returns 0, so that it can be used to mark unused hashes.
+    static u32 hash(NameType, StringView name);
+
+    void push(DOM::Element const&);
+    void pop(DOM::Element const&);
+
+    // The filter only knows about the ancestors of elements whose parent is the last element that was pushed.
+    bool can_be_used_for(DOM::Element const&) const;
+
+    bool should_reject(Selector const&) const;
+
+private:
+    CountingBloomFilter<> m_filter;
+    Vector<DOM::Element const*> m_elements;
+};
+
+}
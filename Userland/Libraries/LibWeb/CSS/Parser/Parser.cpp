@@ -119,9 +119,44 @@ CSSStyleSheet* Parser::parse_as_css_stylesheet(Optional<AK::URL> location)
     // To parse a CSS stylesheet, first parse a stylesheet.
     auto style_sheet = parse_a_stylesheet(m_token_stream, {});
 
+    return convert_to_style_sheet(style_sheet.rules, move(location));
+}
+
+// Tokenizing a style sheet and parsing it into rules only depends on its text, so the rules are kept around and
+// shared by all style sheets with the same text, e.g. the same stylesheet loaded by several documents.
+// Only turning them into CSSOM objects has to be done for each style sheet.
+static constexpr size_t style_sheet_rule_cache_capacity_in_bytes = 4 * MiB;
+static HashMap<DeprecatedString, NonnullRefPtrVector<Rule>> s_style_sheet_rule_cache;
+static size_t s_style_sheet_rule_cache_size_in_bytes { 0 };
+
+CSSStyleSheet* Parser::parse_css_stylesheet_using_rule_cache(ParsingContext const& context, StringView input, Optional<AK::URL> location)
+{
+    if (auto it = s_style_sheet_rule_cache.find(input); it != s_style_sheet_rule_cache.end()) {
+        Parser parser(context, ""sv);
+        return parser.convert_to_style_sheet(it->value, move(location));
+    }
+
+    Parser parser(context, input);
+    auto style_sheet = parser.parse_a_stylesheet(parser.m_token_stream, {});
+
+    // NOTE: The text is used as the key, so that's what we count against the capacity.
+    if (input.length() <= style_sheet_rule_cache_capacity_in_bytes) {
+        if (s_style_sheet_rule_cache_size_in_bytes + input.length() > style_sheet_rule_cache_capacity_in_bytes) {
+            s_style_sheet_rule_cache.clear();
+            s_style_sheet_rule_cache_size_in_bytes = 0;
+        }
+        s_style_sheet_rule_cache.set(input, style_sheet.rules);
+        s_style_sheet_rule_cache_size_in_bytes += input.length();
+    }
+
+    return parser.convert_to_style_sheet(style_sheet.rules, move(location));
+}
+
+CSSStyleSheet* Parser::convert_to_style_sheet(NonnullRefPtrVector<Rule> const& raw_rules, Optional<AK::URL> location)
+{
     // Interpret all of the resulting top-level qualified rules as style rules, defined below.
     JS::MarkedVector<CSSRule*> rules(m_context.realm().heap());
-    for (auto& raw_rule : style_sheet.rules) {
+    for (auto& raw_rule : raw_rules) {
         auto* rule = convert_to_rule(raw_rule);
         // If any style rule is invalid, or any at-rule is not recognized or is invalid according to its grammar or context, it’s a parse error. Discard that rule.
         if (rule)
@@ -7405,8 +7440,7 @@ CSS::CSSStyleSheet* parse_css_stylesheet(CSS::Parser::ParsingContext const& cont
         auto media_list = CSS::MediaList::create(context.realm(), {}).release_value_but_fixme_should_propagate_errors();
         return CSS::CSSStyleSheet::create(context.realm(), rule_list, media_list, location).release_value_but_fixme_should_propagate_errors();
     }
-    CSS::Parser::Parser parser(context, css);
-    return parser.parse_as_css_stylesheet(location);
+    return CSS::Parser::Parser::parse_css_stylesheet_using_rule_cache(context, css, move(location));
 }
 
 CSS::ElementInlineCSSStyleDeclaration* parse_css_style_attribute(CSS::Parser::ParsingContext const& context, StringView css, DOM::Element& element)
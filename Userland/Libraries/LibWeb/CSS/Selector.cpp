@@ -6,6 +6,7 @@
  */
 
 #include "Selector.h"
+#include <LibWeb/CSS/AncestorFilter.h>
 #include <LibWeb/CSS/Serialize.h>
 
 namespace Web::CSS {
@@ -23,6 +24,47 @@ Selector::Selector(Vector<CompoundSelector>&& compound_selectors)
             }
         }
     }
+
+    collect_ancestor_hashes();
+}
+
+void Selector::collect_ancestor_hashes()
+{
+    size_t hash_count = 0;
+    auto append_hash = [&](AncestorFilter::NameType type, StringView name) {
+        if (hash_count == m_ancestor_hashes.size())
+            return false;
+        m_ancestor_hashes[hash_count++] = AncestorFilter::hash(type, name);
+        return true;
+    };
+
+    // A compound followed by a descendant or child combinator describes an ancestor of the element to its right.
+    // That element is either the subject itself, another of its ancestors, or a sibling of one of those, so what
+    // the compound describes is an ancestor of the subject in every case.
+    for (size_t i = m_compound_selectors.size(); i-- > 1;) {
+        auto combinator = m_compound_selectors[i].combinator;
+        if (combinator != Combinator::Descendant && combinator != Combinator::ImmediateChild)
+            continue;
+
+        for (auto const& simple_selector : m_compound_selectors[i - 1].simple_selectors) {
+            switch (simple_selector.type) {
+            case SimpleSelector::Type::TagName:
+                if (!append_hash(AncestorFilter::NameType::TagName, simple_selector.lowercase_name().bytes_as_string_view()))
+                    return;
+                break;
+            case SimpleSelector::Type::Id:
+                if (!append_hash(AncestorFilter::NameType::Id, simple_selector.name().bytes_as_string_view()))
+                    return;
+                break;
+            case SimpleSelector::Type::Class:
+                if (!append_hash(AncestorFilter::NameType::Class, simple_selector.name().bytes_as_string_view()))
+                    return;
+                break;
+            default:
+                break;
+            }
+        }
+    }
 }
 
 // https://www.w3.org/TR/selectors-4/#specificity-rules
@@ -27,7 +27,9 @@
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
 #include <LibWeb/FontCache.h>
+#include <LibWeb/HTML/AttributeNames.h>
 #include <LibWeb/HTML/HTMLHtmlElement.h>
+#include <LibWeb/Infra/CharacterTypes.h>
 #include <LibWeb/Loader/ResourceLoader.h>
 #include <LibWeb/Platform/FontPlugin.h>
 #include <stdio.h>
@@ -131,6 +133,12 @@ static CSSStyleSheet& quirks_mode_stylesheet()
     return *sheet;
 }
 
+void StyleComputer::load_user_agent_style_sheets()
+{
+    (void)default_stylesheet();
+    (void)quirks_mode_stylesheet();
+}
+
 template<typename Callback>
 void StyleComputer::for_each_stylesheet(CascadeOrigin cascade_origin, Callback callback) const
 {
@@ -148,6 +156,8 @@ void StyleComputer::for_each_stylesheet(CascadeOrigin cascade_origin, Callback c
 
 Vector<MatchingRule> StyleComputer::collect_matching_rules(DOM::Element const& element, CascadeOrigin cascade_origin, Optional<CSS::Selector::PseudoElement> pseudo_element) const
 {
+    bool const can_use_ancestor_filter = m_ancestor_filter.can_be_used_for(element);
+
     if (cascade_origin == CascadeOrigin::Author) {
         Vector<MatchingRule> rules_to_run;
         if (pseudo_element.has_value()) {
@@ -171,6 +181,8 @@ Vector<MatchingRule> StyleComputer::collect_matching_rules(DOM::Element const& e
         matching_rules.ensure_capacity(rules_to_run.size());
         for (auto const& rule_to_run : rules_to_run) {
             auto const& selector = rule_to_run.rule->selectors()[rule_to_run.selector_index];
+            if (can_use_ancestor_filter && m_ancestor_filter.should_reject(selector))
+                continue;
             if (SelectorEngine::matches(selector, element, pseudo_element))
                 matching_rules.append(rule_to_run);
         }
@@ -184,6 +196,10 @@ Vector<MatchingRule> StyleComputer::collect_matching_rules(DOM::Element const& e
         sheet.for_each_effective_style_rule([&](auto const& rule) {
             size_t selector_index = 0;
             for (auto& selector : rule.selectors()) {
+                if (can_use_ancestor_filter && m_ancestor_filter.should_reject(selector)) {
+                    ++selector_index;
+                    continue;
+                }
                 if (SelectorEngine::matches(selector, element, pseudo_element)) {
                     matching_rules.append({ &rule, style_sheet_index, rule_index, selector_index, selector.specificity() });
                     break;
@@ -1375,10 +1391,95 @@ NonnullRefPtr<StyleProperties> StyleComputer::create_document_style() const
     return style;
 }
 
+static bool has_inline_style(DOM::Element const& element)
+{
+    auto const* inline_style = verify_cast<PropertyOwningCSSStyleDeclaration>(element.inline_style());
+    return inline_style && (!inline_style->properties().is_empty() || !inline_style->custom_properties().is_empty());
+}
+
+static bool have_same_names_and_attributes(DOM::Element const& a, DOM::Element const& b)
+{
+    if (a.local_name() != b.local_name() || a.namespace_() != b.namespace_() || a.attribute_list_size() != b.attribute_list_size())
+        return false;
+    bool same_attributes = true;
+    a.for_each_attribute([&](auto const& name, auto const& value) {
+        if (same_attributes && (!b.has_attribute(name) || b.get_attribute(name) != value))
+            same_attributes = false;
+    });
+    return same_attributes;
+}
+
+bool StyleComputer::can_share_style(DOM::Element const& element, DOM::Element const& candidate) const
+{
+    if (candidate.needs_style_update() || !candidate.computed_css_values() || has_inline_style(candidate))
+        return false;
+
+    // Presentational hints and all remaining selectors only look at names and attributes, and we've made sure
+    // that the ancestors agree on those as well.
+    if (!have_same_names_and_attributes(element, candidate))
+        return false;
+
+    for (auto const* selector : m_rule_cache->position_or_state_dependent_selectors) {
+        if (SelectorEngine::matches(*selector, element) != SelectorEngine::matches(*selector, candidate))
+            return false;
+    }
+    return true;
+}
+
+// Long lists and tables are full of siblings and cousins that end up with the same style. Instead of running the cascade
+// for each of them, we hand out the StyleProperties of an equivalent element that has already been styled.
+// NOTE: This relies on computed StyleProperties never being modified after the fact. Shared or not, they get replaced instead.
+RefPtr<StyleProperties> StyleComputer::find_shareable_style(DOM::Element& element) const
+{
+    static constexpr size_t max_candidates = 8;
+
+    // Only during the style update tree walk (which is what keeps the ancestor filter in sync with the element's ancestors)
+    // do we know that preceding siblings and cousins have an up-to-date style.
+    if (!m_ancestor_filter.can_be_used_for(element))
+        return nullptr;
+
+    auto* parent = element.parent_element();
+    if (!parent || !parent->computed_css_values() || has_inline_style(element))
+        return nullptr;
+
+    auto share_style_of = [&](DOM::Element const& candidate) -> RefPtr<StyleProperties> {
+        // The custom properties come from the same rules, so they are the same as well.
+        element.set_custom_properties(candidate.custom_properties());
+        return const_cast<StyleProperties*>(candidate.computed_css_values());
+    };
+
+    size_t remaining_candidates = max_candidates;
+    for (auto const* sibling = element.previous_element_sibling(); sibling && remaining_candidates > 0; sibling = sibling->previous_element_sibling(), --remaining_candidates) {
+        if (can_share_style(element, *sibling))
+            return share_style_of(*sibling);
+    }
+
+    // Cousins inherit the same values if their parents share a style. As that can also be the case for parents that have since
+    // become different (see Element::recompute_style()), we check that they still agree on everything selectors could look at.
+    if (!parent->custom_properties().is_empty())
+        return nullptr;
+    for (auto* parent_sibling = parent->previous_element_sibling(); parent_sibling && remaining_candidates > 0; parent_sibling = parent_sibling->previous_element_sibling(), --remaining_candidates) {
+        if (parent_sibling->computed_css_values() != parent->computed_css_values() || !parent_sibling->custom_properties().is_empty())
+            continue;
+        if (has_inline_style(*parent) || has_inline_style(*parent_sibling) || !have_same_names_and_attributes(*parent, *parent_sibling))
+            continue;
+        for (DOM::Element const* cousin = parent_sibling->last_element_child(); cousin && remaining_candidates > 0; cousin = cousin->previous_element_sibling(), --remaining_candidates) {
+            if (can_share_style(element, *cousin))
+                return share_style_of(*cousin);
+        }
+    }
+    return nullptr;
+}
+
 ErrorOr<NonnullRefPtr<StyleProperties>> StyleComputer::compute_style(DOM::Element& element, Optional<CSS::Selector::PseudoElement> pseudo_element) const
 {
     build_rule_cache_if_needed();
 
+    if (!pseudo_element.has_value()) {
+        if (auto shared_style = find_shareable_style(element))
+            return shared_style.release_nonnull();
+    }
+
     auto style = StyleProperties::create();
     // 1. Perform the cascade. This produces the "specified style"
     TRY(compute_cascaded_values(style, element, pseudo_element));
@@ -1435,6 +1536,133 @@ void StyleComputer::build_rule_cache_if_needed() const
     const_cast<StyleComputer&>(*this).build_rule_cache();
 }
 
+void StyleComputer::collect_invalidation_scopes(Selector const& selector, InvalidationScope subject_scope, RuleCache& rule_cache)
+{
+    auto note_scope = [](InvalidationScope& existing_scope, InvalidationScope scope) {
+        existing_scope = max(existing_scope, scope);
+    };
+
+    // Going from the subject towards the start of the selector, every combinator moves on to other elements,
+    // which a change to one of the following compounds can then affect as well.
+    auto scope = subject_scope;
+    auto const& compound_selectors = selector.compound_selectors();
+    for (size_t i = compound_selectors.size(); i-- > 0;) {
+        auto const& compound_selector = compound_selectors[i];
+        for (auto const& simple_selector : compound_selector.simple_selectors) {
+            switch (simple_selector.type) {
+            case Selector::SimpleSelector::Type::Class:
+                note_scope(rule_cache.invalidation_scope_by_class.ensure(simple_selector.name(), [] { return InvalidationScope::None; }), scope);
+                break;
+            case Selector::SimpleSelector::Type::Id:
+                note_scope(rule_cache.invalidation_scope_by_id.ensure(simple_selector.name(), [] { return InvalidationScope::None; }), scope);
+                break;
+            case Selector::SimpleSelector::Type::Attribute: {
+                auto name = simple_selector.attribute().name.bytes_as_string_view();
+                if (name.equals_ignoring_case(HTML::AttributeNames::class_))
+                    note_scope(rule_cache.invalidation_scope_for_any_class, scope);
+                else if (name.equals_ignoring_case(HTML::AttributeNames::id))
+                    note_scope(rule_cache.invalidation_scope_for_any_id, scope);
+                break;
+            }
+            case Selector::SimpleSelector::Type::PseudoClass:
+                for (auto const& argument_selector : simple_selector.pseudo_class().argument_selector_list)
+                    collect_invalidation_scopes(argument_selector, scope, rule_cache);
+                break;
+            default:
+                break;
+            }
+        }
+
+        switch (compound_selector.combinator) {
+        case Selector::Combinator::None:
+            break;
+        case Selector::Combinator::ImmediateChild:
+        case Selector::Combinator::Descendant:
+            note_scope(scope, InvalidationScope::Subtree);
+            break;
+        case Selector::Combinator::NextSibling:
+        case Selector::Combinator::SubsequentSibling:
+            note_scope(scope, InvalidationScope::SiblingSubtrees);
+            break;
+        case Selector::Combinator::Column:
+            note_scope(scope, InvalidationScope::Document);
+            break;
+        }
+    }
+}
+
+StyleComputer::InvalidationScope StyleComputer::invalidation_scope_for_attribute_change(DeprecatedFlyString const& attribute_name, DeprecatedString const& old_value, DeprecatedString const& new_value) const
+{
+    if (old_value.is_null() == new_value.is_null() && old_value == new_value)
+        return InvalidationScope::None;
+
+    // NOTE: Presentational hints can depend on any other attribute, even ones of other elements in the subtree.
+    if (attribute_name != HTML::AttributeNames::class_ && attribute_name != HTML::AttributeNames::id)
+        return InvalidationScope::Subtree;
+
+    build_rule_cache_if_needed();
+
+    // NOTE: The element's own style can always depend on the value through attr().
+    auto scope = InvalidationScope::Element;
+    auto note_changed_name = [&](HashMap<FlyString, InvalidationScope> const& scopes, StringView name) {
+        if (auto it = scopes.find(FlyString::from_utf8(name).release_value_but_fixme_should_propagate_errors()); it != scopes.end())
+            scope = max(scope, it->value);
+    };
+
+    if (attribute_name == HTML::AttributeNames::id) {
+        scope = max(scope, m_rule_cache->invalidation_scope_for_any_id);
+        if (!old_value.is_null())
+            note_changed_name(m_rule_cache->invalidation_scope_by_id, old_value);
+        if (!new_value.is_null())
+            note_changed_name(m_rule_cache->invalidation_scope_by_id, new_value);
+        return scope;
+    }
+
+    // Only the classes that were added or removed can change which selectors match.
+    scope = max(scope, m_rule_cache->invalidation_scope_for_any_class);
+    auto old_classes = old_value.view().split_view_if(Infra::is_ascii_whitespace);
+    auto new_classes = new_value.view().split_view_if(Infra::is_ascii_whitespace);
+    for (auto name : old_classes) {
+        if (!new_classes.contains_slow(name))
+            note_changed_name(m_rule_cache->invalidation_scope_by_class, name);
+    }
+    for (auto name : new_classes) {
+        if (!old_classes.contains_slow(name))
+            note_changed_name(m_rule_cache->invalidation_scope_by_class, name);
+    }
+    return scope;
+}
+
+// Whether matching the selector depends on more than the names and attributes of an element and its ancestors,
+// like the position among its siblings or whether it's hovered.
+static bool is_position_or_state_dependent(Selector const& selector)
+{
+    for (auto const& compound_selector : selector.compound_selectors()) {
+        if (compound_selector.combinator != Selector::Combinator::None
+            && compound_selector.combinator != Selector::Combinator::ImmediateChild
+            && compound_selector.combinator != Selector::Combinator::Descendant)
+            return true;
+        for (auto const& simple_selector : compound_selector.simple_selectors) {
+            if (simple_selector.type != Selector::SimpleSelector::Type::PseudoClass)
+                continue;
+            auto const& pseudo_class = simple_selector.pseudo_class();
+            switch (pseudo_class.type) {
+            case Selector::SimpleSelector::PseudoClass::Type::Is:
+            case Selector::SimpleSelector::PseudoClass::Type::Not:
+            case Selector::SimpleSelector::PseudoClass::Type::Where:
+                for (auto const& argument_selector : pseudo_class.argument_selector_list) {
+                    if (is_position_or_state_dependent(argument_selector))
+                        return true;
+                }
+                break;
+            default:
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
 void StyleComputer::build_rule_cache()
 {
     // FIXME: Make a rule cache for UA style as well.
@@ -1496,6 +1724,18 @@ void StyleComputer::build_rule_cache()
         ++style_sheet_index;
     });
 
+    for (auto cascade_origin : { CascadeOrigin::UserAgent, CascadeOrigin::Author }) {
+        for_each_stylesheet(cascade_origin, [&](auto& sheet) {
+            sheet.for_each_effective_style_rule([&](auto const& rule) {
+                for (CSS::Selector const& selector : rule.selectors()) {
+                    collect_invalidation_scopes(selector, InvalidationScope::Element, *m_rule_cache);
+                    if (!selector.pseudo_element().has_value() && is_position_or_state_dependent(selector))
+                        m_rule_cache->position_or_state_dependent_selectors.append(&selector);
+                }
+            });
+        });
+    }
+
     if constexpr (LIBWEB_CSS_DEBUG) {
         dbgln("Built rule cache!");
         dbgln("           ID: {}", num_id_rules);
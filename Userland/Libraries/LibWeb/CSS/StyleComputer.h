@@ -11,6 +11,7 @@
 #include <AK/NonnullRefPtrVector.h>
 #include <AK/Optional.h>
 #include <AK/OwnPtr.h>
+#include <LibWeb/CSS/AncestorFilter.h>
 #include <LibWeb/CSS/CSSFontFaceRule.h>
 #include <LibWeb/CSS/CSSStyleDeclaration.h>
 #include <LibWeb/CSS/Parser/ComponentValue.h>
@@ -52,6 +53,9 @@ public:
     explicit StyleComputer(DOM::Document&);
     ~StyleComputer();
 
+    // Parses the user agent style sheets ahead of time, so that the first document to be styled doesn't have to.
+    static void load_user_agent_style_sheets();
+
     DOM::Document& document() { return m_document; }
     DOM::Document const& document() const { return m_document; }
 
@@ -71,6 +75,21 @@ public:
 
     void invalidate_rule_cache();
 
+    // While styles are updated from the top of the tree down, the elements on the way are pushed here, which lets
+    // selectors that need ancestors that aren't there be rejected quickly.
+    void push_ancestor(DOM::Element const& element) { m_ancestor_filter.push(element); }
+    void pop_ancestor(DOM::Element const& element) { m_ancestor_filter.pop(element); }
+
+    // Which elements may need their style recomputed when something that selectors test for changes on an element.
+    enum class InvalidationScope {
+        None,
+        Element,
+        Subtree,
+        SiblingSubtrees,
+        Document,
+    };
+    InvalidationScope invalidation_scope_for_attribute_change(DeprecatedFlyString const& attribute_name, DeprecatedString const& old_value, DeprecatedString const& new_value) const;
+
     Gfx::Font const& initial_font() const;
 
     void did_load_font(FlyString const& family_name);
@@ -106,6 +125,9 @@ private:
     void build_rule_cache();
     void build_rule_cache_if_needed() const;
 
+    RefPtr<StyleProperties> find_shareable_style(DOM::Element&) const;
+    bool can_share_style(DOM::Element const&, DOM::Element const& candidate) const;
+
     DOM::Document& m_document;
 
     struct RuleCache {
@@ -114,9 +136,24 @@ private:
         HashMap<FlyString, Vector<MatchingRule>> rules_by_tag_name;
         HashMap<Selector::PseudoElement, Vector<MatchingRule>> rules_by_pseudo_element;
         Vector<MatchingRule> other_rules;
+
+        // Built from the selectors of all cascade origins, as changing a class or ID can affect any of them.
+        HashMap<FlyString, InvalidationScope> invalidation_scope_by_class;
+        HashMap<FlyString, InvalidationScope> invalidation_scope_by_id;
+        // Attribute selectors on the class or id attribute can match on any of their values.
+        InvalidationScope invalidation_scope_for_any_class { InvalidationScope::None };
+        InvalidationScope invalidation_scope_for_any_id { InvalidationScope::None };
+
+        // Selectors of all cascade origins whose matching depends on more than the names and attributes of an element
+        // and its ancestors. Elements can only share their style if these match both of them the same way.
+        Vector<Selector const*> position_or_state_dependent_selectors;
     };
     OwnPtr<RuleCache> m_rule_cache;
 
+    AncestorFilter m_ancestor_filter;
+
+    static void collect_invalidation_scopes(Selector const&, InvalidationScope subject_scope, RuleCache&);
+
     class FontLoader;
     HashMap<String, NonnullOwnPtr<FontLoader>> m_loaded_fonts;
 };
@@ -69,6 +69,7 @@
 #include <LibWeb/Layout/Viewport.h>
 #include <LibWeb/Namespace.h>
 #include <LibWeb/Page/Page.h>
+#include <LibWeb/PhaseTimings.h>
 #include <LibWeb/Platform/Timer.h>
 #include <LibWeb/SVG/TagNames.h>
 #include <LibWeb/Selection/Selection.h>
@@ -350,6 +351,12 @@ void Document::visit_edges(Cell::Visitor& visitor)
     visitor.visit(m_forms);
     visitor.visit(m_scripts);
     visitor.visit(m_all);
+    for (auto& it : m_elements_by_class_name)
+        visitor.visit(it.value);
+    for (auto& it : m_elements_by_id) {
+        for (auto& element : it.value)
+            visitor.visit(element);
+    }
     visitor.visit(m_selection);
     visitor.visit(m_first_base_element_with_href_in_tree_order);
     visitor.visit(m_parser);
@@ -837,6 +844,8 @@ void Document::update_layout()
     if (!m_needs_layout && m_layout_root)
         return;
 
+    TemporaryPhaseTimer phase_timer(TimedPhase::Layout);
+
     // NOTE: If this is a document hosting <template> contents, layout is unnecessary.
     if (m_created_for_appropriate_template_contents)
         return;
@@ -873,6 +882,9 @@ void Document::update_layout()
 
     layout_state.commit();
 
+    // Boxes that are still clean keep their cached intrinsic sizes for the next layout.
+    m_layout_root->reset_needs_layout_update();
+
     browsing_context()->set_needs_display();
 
     if (browsing_context()->is_top_level() && browsing_context()->active_document() == this) {
@@ -897,6 +909,10 @@ void Document::update_layout()
     node.set_needs_style_update(false);
 
     if (needs_full_style_update || node.child_needs_style_update()) {
+        auto& style_computer = node.document().style_computer();
+        if (node.is_element())
+            style_computer.push_ancestor(static_cast<Element&>(node));
+
         if (node.is_element()) {
             if (auto* shadow_root = static_cast<DOM::Element&>(node).shadow_root_internal()) {
                 if (needs_full_style_update || shadow_root->needs_style_update() || shadow_root->child_needs_style_update())
@@ -908,6 +924,9 @@ void Document::update_layout()
                 needs_relayout |= update_style_recursively(child);
             return IterationDecision::Continue;
         });
+
+        if (node.is_element())
+            style_computer.pop_ancestor(static_cast<Element&>(node));
     }
 
     node.set_child_needs_style_update(false);
@@ -925,6 +944,7 @@ void Document::update_style()
     if (m_created_for_appropriate_template_contents)
         return;
 
+    TemporaryPhaseTimer phase_timer(TimedPhase::Style);
     evaluate_media_rules();
     if (update_style_recursively(*this))
         invalidate_layout();
@@ -1033,17 +1053,73 @@ JS::NonnullGCPtr<HTMLCollection> Document::get_elements_by_name(DeprecatedString
 
 JS::NonnullGCPtr<HTMLCollection> Document::get_elements_by_class_name(DeprecatedFlyString const& class_names)
 {
+    // NOTE: The same collection may be returned for the same class names, as long as the document's mode stays the same.
+    if (auto it = m_elements_by_class_name.find(class_names); it != m_elements_by_class_name.end())
+        return it->value;
+
     Vector<DeprecatedFlyString> list_of_class_names;
     for (auto& name : class_names.view().split_view(' ')) {
         list_of_class_names.append(name);
     }
-    return HTMLCollection::create(*this, [list_of_class_names = move(list_of_class_names), quirks_mode = document().in_quirks_mode()](Element const& element) {
+    auto collection = HTMLCollection::create(*this, [list_of_class_names = move(list_of_class_names), quirks_mode = document().in_quirks_mode()](Element const& element) {
         for (auto& name : list_of_class_names) {
             if (!element.has_class(name, quirks_mode ? CaseSensitivity::CaseInsensitive : CaseSensitivity::CaseSensitive))
                 return false;
         }
         return true;
     }).release_value_but_fixme_should_propagate_errors();
+    m_elements_by_class_name.set(class_names, collection);
+    return collection;
+}
+
+// https://dom.spec.whatwg.org/#dom-nonelementparentnode-getelementbyid
+JS::GCPtr<Element> Document::get_element_by_id(DeprecatedFlyString const& id) const
+{
+    // The getElementById(elementId) method steps are to return the first element, in tree order, within this’s descendants, whose ID is elementId; otherwise, if there is no such element, null.
+    auto it = m_elements_by_id.find(id);
+    if (it == m_elements_by_id.end())
+        return nullptr;
+
+    JS::GCPtr<Element> first_element;
+    for (auto& element : it->value) {
+        if (!first_element || element->is_before(*first_element))
+            first_element = element;
+    }
+    return first_element;
+}
+
+void Document::element_was_inserted(Badge<Node>, Element& element)
+{
+    auto id = element.attribute(HTML::AttributeNames::id);
+    if (id.is_empty() || &element.root() != this)
+        return;
+    m_elements_by_id.ensure(id).append(element);
+}
+
+void Document::element_was_removed(Badge<Node>, Element& element)
+{
+    auto id = element.attribute(HTML::AttributeNames::id);
+    if (id.is_empty())
+        return;
+    auto it = m_elements_by_id.find(id);
+    if (it == m_elements_by_id.end())
+        return;
+    it->value.remove_first_matching([&](auto& entry) { return entry.ptr() == &element; });
+    if (it->value.is_empty())
+        m_elements_by_id.remove(it);
+}
+
+void Document::element_id_will_change(Badge<Attr>, Element& element, DeprecatedString const& old_id, DeprecatedString const& new_id)
+{
+    if (!old_id.is_empty()) {
+        if (auto it = m_elements_by_id.find(old_id); it != m_elements_by_id.end()) {
+            it->value.remove_first_matching([&](auto& entry) { return entry.ptr() == &element; });
+            if (it->value.is_empty())
+                m_elements_by_id.remove(it);
+        }
+    }
+    if (!new_id.is_empty() && &element.root() == this)
+        m_elements_by_id.ensure(new_id).append(element);
 }
 
 // https://html.spec.whatwg.org/multipage/obsolete.html#dom-document-applets
@@ -202,6 +202,21 @@ public:
     void schedule_style_update();
     void schedule_layout_update();
 
+    JS::GCPtr<Element> get_element_by_id(DeprecatedFlyString const& id) const;
+    JS::GCPtr<Element> get_element_by_id(DeprecatedFlyString const& id)
+    {
+        return const_cast<Document const*>(this)->get_element_by_id(id);
+    }
+
+    // This changes whenever nodes are inserted or removed, or an attribute changes, anywhere in the document.
+    // Live collections use it to tell whether the elements they found last time are still the right ones.
+    u64 dom_tree_version() const { return m_dom_tree_version; }
+    void bump_dom_tree_version() { ++m_dom_tree_version; }
+
+    void element_was_inserted(Badge<Node>, Element&);
+    void element_was_removed(Badge<Node>, Element&);
+    void element_id_will_change(Badge<Attr>, Element&, DeprecatedString const& old_id, DeprecatedString const& new_id);
+
     JS::NonnullGCPtr<HTMLCollection> get_elements_by_name(DeprecatedString const&);
     JS::NonnullGCPtr<HTMLCollection> get_elements_by_class_name(DeprecatedFlyString const&);
 
@@ -250,7 +265,12 @@ public:
 
     QuirksMode mode() const { return m_quirks_mode; }
     bool in_quirks_mode() const { return m_quirks_mode == QuirksMode::Yes; }
-    void set_quirks_mode(QuirksMode mode) { m_quirks_mode = mode; }
+    void set_quirks_mode(QuirksMode mode)
+    {
+        m_quirks_mode = mode;
+        // NOTE: Whether class names match depends on the mode.
+        m_elements_by_class_name.clear();
+    }
 
     Type document_type() const { return m_type; }
     void set_document_type(Type type) { m_type = type; }
@@ -586,6 +606,14 @@ private:
     JS::GCPtr<HTMLCollection> m_scripts;
     JS::GCPtr<HTMLCollection> m_all;
 
+    // The collections handed out by getElementsByClassName(), so that asking for the same class names again is cheap.
+    HashMap<DeprecatedFlyString, JS::NonnullGCPtr<HTMLCollection>> m_elements_by_class_name;
+
+    // The elements with an ID in this document's tree, so that get_element_by_id() doesn't have to search the tree.
+    HashMap<DeprecatedFlyString, Vector<JS::NonnullGCPtr<Element>, 1>> m_elements_by_id;
+
+    u64 m_dom_tree_version { 0 };
+
     // https://html.spec.whatwg.org/#completely-loaded-time
     Optional<AK::Time> m_completely_loaded_time;
 
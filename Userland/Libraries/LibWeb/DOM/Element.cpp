@@ -121,6 +121,7 @@ WebIDL::ExceptionOr<void> Element::set_attribute(DeprecatedFlyString const& name
 
     // 3. Let attribute be the first attribute in this’s attribute list whose qualified name is qualifiedName, and null otherwise.
     auto* attribute = m_attributes->get_attribute(name);
+    DeprecatedString old_value;
 
     // 4. If attribute is null, create an attribute whose local name is qualifiedName, value is value, and node document is this’s node document, then append this attribute to this, and then return.
     if (!attribute) {
@@ -132,12 +133,13 @@ WebIDL::ExceptionOr<void> Element::set_attribute(DeprecatedFlyString const& name
 
     // 5. Change attribute to value.
     else {
+        old_value = attribute->value();
         attribute->set_value(value);
     }
 
     parse_attribute(attribute->local_name(), value);
 
-    invalidate_style_after_attribute_change(name);
+    invalidate_style_after_attribute_change(attribute->local_name(), old_value, value);
 
     return {};
 }
@@ -200,11 +202,15 @@ WebIDL::ExceptionOr<void> Element::set_attribute_ns(DeprecatedFlyString const& n
 // https://dom.spec.whatwg.org/#dom-element-removeattribute
 void Element::remove_attribute(DeprecatedFlyString const& name)
 {
+    DeprecatedString old_value;
+    if (auto* attribute = m_attributes->get_attribute(name))
+        old_value = attribute->value();
+
     m_attributes->remove_attribute(name);
 
     did_remove_attribute(name);
 
-    invalidate_style_after_attribute_change(name);
+    invalidate_style_after_attribute_change(name, old_value, {});
 }
 
 // https://dom.spec.whatwg.org/#dom-element-hasattribute
@@ -237,7 +243,7 @@ WebIDL::ExceptionOr<bool> Element::toggle_attribute(DeprecatedFlyString const& n
 
             parse_attribute(new_attribute->local_name(), "");
 
-            invalidate_style_after_attribute_change(name);
+            invalidate_style_after_attribute_change(new_attribute->local_name(), {}, "");
 
             return true;
         }
@@ -248,11 +254,12 @@ WebIDL::ExceptionOr<bool> Element::toggle_attribute(DeprecatedFlyString const& n
 
     // 5. Otherwise, if force is not given or is false, remove an attribute given qualifiedName and this, and then return false.
     if (!force.has_value() || !force.value()) {
+        auto old_value = attribute->value();
         m_attributes->remove_attribute(name);
 
         did_remove_attribute(name);
 
-        invalidate_style_after_attribute_change(name);
+        invalidate_style_after_attribute_change(name, old_value, {});
     }
 
     // 6. Return true.
@@ -424,6 +431,20 @@ Element::NeedsRelayout Element::recompute_style()
 
     m_computed_css_values = move(new_computed_css_values);
 
+    // The children inherit from the style that just changed, so they have to be recomputed too.
+    // (A full style update gets to all of them anyway.)
+    if (!document().needs_full_style_update()) {
+        auto invalidate_children = [](ParentNode& parent) {
+            parent.for_each_child_of_type<Element>([](Element& child) {
+                child.set_needs_style_update(true);
+                return IterationDecision::Continue;
+            });
+        };
+        invalidate_children(*this);
+        if (auto* shadow_root = shadow_root_internal())
+            invalidate_children(*shadow_root);
+    }
+
     if (required_invalidation == RequiredInvalidation::RepaintOnly && layout_node()) {
         layout_node()->apply_style(*m_computed_css_values);
         layout_node()->set_needs_display();
@@ -1329,13 +1350,27 @@ ErrorOr<void> Element::scroll_into_view(Optional<Variant<bool, ScrollIntoViewOpt
     // FIXME: 8. Optionally perform some other action that brings the element to the user’s attention.
 }
 
-void Element::invalidate_style_after_attribute_change(DeprecatedFlyString const& attribute_name)
+void Element::invalidate_style_after_attribute_change(DeprecatedFlyString const& attribute_name, DeprecatedString const& old_value, DeprecatedString const& new_value)
 {
-    // FIXME: Only invalidate if the attribute can actually affect style.
-    (void)attribute_name;
-
     // FIXME: This will need to become smarter when we implement the :has() selector.
-    invalidate_style();
+    switch (document().style_computer().invalidation_scope_for_attribute_change(attribute_name, old_value, new_value)) {
+    case CSS::StyleComputer::InvalidationScope::None:
+        break;
+    case CSS::StyleComputer::InvalidationScope::Element:
+        // NOTE: If the style of this element changes, recompute_style() takes care of the children inheriting from it.
+        set_needs_style_update(true);
+        break;
+    case CSS::StyleComputer::InvalidationScope::Subtree:
+        invalidate_style();
+        break;
+    case CSS::StyleComputer::InvalidationScope::SiblingSubtrees:
+        for (Node* node = this; node; node = node->next_sibling())
+            node->invalidate_style();
+        break;
+    case CSS::StyleComputer::InvalidationScope::Document:
+        document().invalidate_style();
+        break;
+    }
 }
 
 // https://www.w3.org/TR/wai-aria-1.2/#tree_exclusion
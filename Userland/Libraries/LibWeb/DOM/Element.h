@@ -272,7 +272,7 @@ protected:
 private:
     void make_html_uppercased_qualified_name();
 
-    void invalidate_style_after_attribute_change(DeprecatedFlyString const& attribute_name);
+    void invalidate_style_after_attribute_change(DeprecatedFlyString const& attribute_name, DeprecatedString const& old_value, DeprecatedString const& new_value);
 
     WebIDL::ExceptionOr<JS::GCPtr<Node>> insert_adjacent(DeprecatedString const& where, JS::NonnullGCPtr<Node> node);
 
@@ -6,6 +6,7 @@
  */
 
 #include <LibWeb/Bindings/Intrinsics.h>
+#include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
 #include <LibWeb/DOM/HTMLCollection.h>
 #include <LibWeb/DOM/ParentNode.h>
@@ -39,16 +40,33 @@ void HTMLCollection::visit_edges(Cell::Visitor& visitor)
 {
     Base::visit_edges(visitor);
     visitor.visit(m_root.ptr());
+    for (auto& element : m_cached_elements)
+        visitor.visit(element);
+    visitor.visit(m_cached_elements_document);
 }
 
-JS::MarkedVector<Element*> HTMLCollection::collect_matching_elements() const
+void HTMLCollection::update_cache_if_needed() const
 {
-    JS::MarkedVector<Element*> elements(m_root->heap());
+    auto& document = m_root->document();
+    if (m_cached_elements_document == &document && m_cached_dom_tree_version == document.dom_tree_version())
+        return;
+
+    m_cached_elements.clear_with_capacity();
     m_root->for_each_in_inclusive_subtree_of_type<Element>([&](auto& element) {
         if (m_filter(element))
-            elements.append(const_cast<Element*>(&element));
+            m_cached_elements.append(const_cast<Element&>(element));
         return IterationDecision::Continue;
     });
+    m_cached_elements_document = &document;
+    m_cached_dom_tree_version = document.dom_tree_version();
+}
+
+JS::MarkedVector<Element*> HTMLCollection::collect_matching_elements() const
+{
+    update_cache_if_needed();
+    JS::MarkedVector<Element*> elements(m_root->heap());
+    for (auto& element : m_cached_elements)
+        elements.append(element.ptr());
     return elements;
 }
 
@@ -56,17 +74,18 @@ JS::MarkedVector<Element*> HTMLCollection::collect_matching_elements() const
 size_t HTMLCollection::length()
 {
     // The length getter steps are to return the number of nodes represented by the collection.
-    return collect_matching_elements().size();
+    update_cache_if_needed();
+    return m_cached_elements.size();
 }
 
 // https://dom.spec.whatwg.org/#dom-htmlcollection-item
 Element* HTMLCollection::item(size_t index) const
 {
     // The item(index) method steps are to return the indexth element in the collection. If there is no indexth element in the collection, then the method must return null.
-    auto elements = collect_matching_elements();
-    if (index >= elements.size())
+    update_cache_if_needed();
+    if (index >= m_cached_elements.size())
         return nullptr;
-    return elements[index];
+    return m_cached_elements[index].ptr();
 }
 
 // https://dom.spec.whatwg.org/#dom-htmlcollection-nameditem-key
@@ -75,14 +94,15 @@ Element* HTMLCollection::named_item(DeprecatedFlyString const& name) const
     // 1. If key is the empty string, return null.
     if (name.is_empty())
         return nullptr;
-    auto elements = collect_matching_elements();
+    update_cache_if_needed();
+    auto& elements = m_cached_elements;
     // 2. Return the first element in the collection for which at least one of the following is true:
     //      - it has an ID which is key;
     if (auto it = elements.find_if([&](auto& entry) { return entry->attribute(HTML::AttributeNames::id) == name; }); it != elements.end())
-        return *it;
+        return it->ptr();
     //      - it is in the HTML namespace and has a name attribute whose value is key;
     if (auto it = elements.find_if([&](auto& entry) { return entry->namespace_() == Namespace::HTML && entry->name() == name; }); it != elements.end())
-        return *it;
+        return it->ptr();
     //    or null if there is no such element.
     return nullptr;
 }
@@ -94,9 +114,9 @@ Vector<DeprecatedString> HTMLCollection::supported_property_names() const
     Vector<DeprecatedString> result;
 
     // 2. For each element represented by the collection, in tree order:
-    auto elements = collect_matching_elements();
+    update_cache_if_needed();
 
-    for (auto& element : elements) {
+    for (auto& element : m_cached_elements) {
         // 1. If element has an ID which is not in result, append element’s ID to result.
         if (element->has_attribute(HTML::AttributeNames::id)) {
             auto id = element->attribute(HTML::AttributeNames::id);
@@ -123,11 +143,11 @@ bool HTMLCollection::is_supported_property_index(u32 index) const
 {
     // The object’s supported property indices are the numbers in the range zero to one less than the number of elements represented by the collection.
     // If there are no such elements, then there are no supported property indices.
-    auto elements = collect_matching_elements();
-    if (elements.is_empty())
+    update_cache_if_needed();
+    if (m_cached_elements.is_empty())
         return false;
 
-    return index < elements.size();
+    return index < m_cached_elements.size();
 }
 
 WebIDL::ExceptionOr<JS::Value> HTMLCollection::item_value(size_t index) const
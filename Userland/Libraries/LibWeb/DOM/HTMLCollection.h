@@ -22,9 +22,8 @@ namespace Web::DOM {
 // The filter is a simple Function object that answers the question
 // "is this Element part of the collection?"
 
-// FIXME: HTMLCollection currently does no caching. It will re-filter on every access!
-//        We should teach it how to cache results. The main challenge is invalidating
-//        these caches, since this needs to happen on various kinds of DOM mutation.
+// The matching elements are cached, and only collected again once the DOM tree version of
+// the root's document has changed, i.e. after some node was inserted or removed, or an attribute changed.
 
 class HTMLCollection : public Bindings::LegacyPlatformObject {
     WEB_PLATFORM_OBJECT(HTMLCollection, Bindings::LegacyPlatformObject);
@@ -55,6 +54,8 @@ protected:
 private:
     virtual void visit_edges(Cell::Visitor&) override;
 
+    void update_cache_if_needed() const;
+
     // ^Bindings::LegacyPlatformObject
     virtual bool supports_indexed_properties() const override { return true; }
     virtual bool supports_named_properties() const override { return true; }
@@ -70,6 +71,10 @@ private:
 
     JS::NonnullGCPtr<ParentNode> m_root;
     Function<bool(Element const&)> m_filter;
+
+    mutable Vector<JS::NonnullGCPtr<Element>> m_cached_elements;
+    mutable JS::GCPtr<Document> m_cached_elements_document;
+    mutable Optional<u64> m_cached_dom_tree_version;
 };
 
 }
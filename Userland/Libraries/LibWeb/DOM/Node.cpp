@@ -444,6 +444,9 @@ void Node::insert_before(JS::NonnullGCPtr<Node> node, JS::GCPtr<Node> child, boo
             // 1. Run the insertion steps with inclusiveDescendant.
             inclusive_descendant.inserted();
 
+            if (is<Element>(inclusive_descendant))
+                document().element_was_inserted({}, static_cast<Element&>(inclusive_descendant));
+
             // 2. If inclusiveDescendant is connected, then:
             if (inclusive_descendant.is_connected()) {
                 // FIXME: 1. If inclusiveDescendant is custom, then enqueue a custom element callback reaction with inclusiveDescendant, callback name "connectedCallback", and an empty argument list.
@@ -463,6 +466,8 @@ void Node::insert_before(JS::NonnullGCPtr<Node> node, JS::GCPtr<Node> child, boo
         queue_tree_mutation_record(added_node_list, removed_node_list, previous_sibling.ptr(), child.ptr());
     }
 
+    document().bump_dom_tree_version();
+
     // 9. Run the children changed steps for parent.
     children_changed();
 
@@ -579,6 +584,12 @@ void Node::remove(bool suppress_observers)
     // 15. Run the removing steps with node and parent.
     removed_from(parent);
 
+    for_each_in_inclusive_subtree_of_type<Element>([&](Element& element) {
+        document().element_was_removed({}, element);
+        return IterationDecision::Continue;
+    });
+    document().bump_dom_tree_version();
+
     // FIXME: 16. Let isParentConnected be parent’s connected. (Currently unused so not included)
 
     // FIXME: 17. If node is custom and isParentConnected is true, then enqueue a custom element callback reaction with node,
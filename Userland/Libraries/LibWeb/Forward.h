@@ -387,6 +387,7 @@ struct LinearGradientData;
 }
 
 namespace Web::Platform {
+struct DecodedImage;
 class Timer;
 }
 
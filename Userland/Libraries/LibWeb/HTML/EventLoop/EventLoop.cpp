@@ -214,6 +214,10 @@ void EventLoop::process()
         //    perform the start an idle period algorithm for win with computeDeadline. [REQUESTIDLECALLBACK]
         for (auto& win : same_loop_windows())
             win->start_an_idle_period();
+
+        // NOTE: Nothing else is going on right now, which makes this a good time to get a garbage collection
+        //       out of the way before it would be triggered in the middle of running script.
+        Bindings::main_thread_vm().heap().collect_garbage_if_idle_collection_is_worthwhile();
     }
 
     // FIXME: 14. If this is a worker event loop, then:
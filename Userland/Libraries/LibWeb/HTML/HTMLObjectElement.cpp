@@ -340,6 +340,8 @@ void HTMLObjectElement::update_layout_and_child_objects(Representation represent
 
     m_representation = representation;
     set_needs_style_update(true);
+    if (auto* layout_node = this->layout_node())
+        layout_node->set_needs_layout_update();
     document().set_needs_layout();
 }
 
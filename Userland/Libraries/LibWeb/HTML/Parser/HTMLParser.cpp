@@ -30,7 +30,9 @@
 #include <LibWeb/HTML/Window.h>
 #include <LibWeb/HighResolutionTime/TimeOrigin.h>
 #include <LibWeb/Infra/CharacterTypes.h>
+#include <LibWeb/Loader/ResourceLoader.h>
 #include <LibWeb/Namespace.h>
+#include <LibWeb/PhaseTimings.h>
 #include <LibWeb/SVG/TagNames.h>
 
 namespace Web::HTML {
@@ -160,6 +162,7 @@ void HTMLParser::visit_edges(Cell::Visitor& visitor)
 
 void HTMLParser::run()
 {
+    TemporaryPhaseTimer phase_timer(TimedPhase::Parsing);
     for (;;) {
         // FIXME: Find a better way to say that we come from Document::close() and want to process EOF.
         if (!m_tokenizer.is_eof_inserted() && m_tokenizer.is_insertion_point_reached())
@@ -2244,6 +2247,75 @@ void HTMLParser::decrement_script_nesting_level()
     --m_script_nesting_level;
 }
 
+// https://html.spec.whatwg.org/multipage/parsing.html#speculative-html-parsing
+void HTMLParser::start_the_speculative_html_parser()
+{
+    // NOTE: Rather than building a speculative mock tree, we only tokenize the rest of the input and make speculative fetches
+    //       for the external scripts, style sheets and images we come across. The resource cache of the ResourceLoader then
+    //       hands those out once the elements that need them are actually inserted.
+    auto input = m_tokenizer.unprocessed_input();
+    auto input_length = m_tokenizer.source().length();
+    if (input.is_empty() || input_length == m_speculatively_parsed_input_length)
+        return;
+    m_speculatively_parsed_input_length = input_length;
+
+    auto base_url = m_document->base_url();
+    bool seen_base_element = false;
+
+    auto speculatively_fetch = [&](Resource::Type type, StringView url_string) {
+        auto url = base_url.complete_url(url_string);
+        // NOTE: The ResourceLoader doesn't cache file: URLs, so fetching them early would just fetch them twice.
+        if (!url.is_valid() || url.scheme() == "file"sv)
+            return;
+        auto request = LoadRequest::create_for_url_on_page(url, m_document->page());
+        (void)ResourceLoader::the().load_resource(type, request);
+    };
+
+    HTMLTokenizer tokenizer { input, "UTF-8"sv };
+    for (;;) {
+        auto token = tokenizer.next_token();
+        if (!token.has_value() || token->is_end_of_file())
+            break;
+        if (!token->is_start_tag())
+            continue;
+
+        auto const& tag_name = token->tag_name();
+        if (tag_name == HTML::TagNames::base) {
+            // NOTE: Only the first base element with an href attribute counts.
+            if (auto href = token->attribute(HTML::AttributeNames::href); !seen_base_element && !href.is_null()) {
+                seen_base_element = true;
+                base_url = base_url.complete_url(href);
+            }
+        } else if (tag_name == HTML::TagNames::script) {
+            // NOTE: Module scripts are fetched as part of their module graph, which isn't cached.
+            auto src = token->attribute(HTML::AttributeNames::src);
+            if (!src.is_null() && !token->attribute(HTML::AttributeNames::type).equals_ignoring_case("module"sv))
+                speculatively_fetch(Resource::Type::Generic, src);
+            tokenizer.switch_to({}, HTMLTokenizer::State::ScriptData);
+        } else if (tag_name == HTML::TagNames::link) {
+            auto href = token->attribute(HTML::AttributeNames::href);
+            bool is_stylesheet = false;
+            bool is_alternate = false;
+            for (auto relationship : token->attribute(HTML::AttributeNames::rel).split_view_if(Infra::is_ascii_whitespace)) {
+                if (relationship.equals_ignoring_case("stylesheet"sv))
+                    is_stylesheet = true;
+                else if (relationship.equals_ignoring_case("alternate"sv))
+                    is_alternate = true;
+            }
+            if (!href.is_null() && is_stylesheet && !is_alternate)
+                speculatively_fetch(Resource::Type::Generic, href);
+        } else if (tag_name == HTML::TagNames::img) {
+            if (auto src = token->attribute(HTML::AttributeNames::src); !src.is_null())
+                speculatively_fetch(Resource::Type::Image, src);
+        } else if (tag_name.is_one_of(HTML::TagNames::style, HTML::TagNames::xmp, HTML::TagNames::iframe, HTML::TagNames::noembed, HTML::TagNames::noframes)
+            || (tag_name == HTML::TagNames::noscript && m_scripting_enabled)) {
+            tokenizer.switch_to({}, HTMLTokenizer::State::RAWTEXT);
+        } else if (tag_name.is_one_of(HTML::TagNames::title, HTML::TagNames::textarea)) {
+            tokenizer.switch_to({}, HTMLTokenizer::State::RCDATA);
+        }
+    }
+}
+
 // https://html.spec.whatwg.org/multipage/parsing.html#parsing-main-incdata
 void HTMLParser::handle_text(HTMLToken& token)
 {
@@ -2321,7 +2393,8 @@ void HTMLParser::handle_text(HTMLToken& token)
                     // 2. Set the pending parsing-blocking script to null.
                     auto the_script = document().take_pending_parsing_blocking_script({});
 
-                    // FIXME: 3. Start the speculative HTML parser for this instance of the HTML parser.
+                    // 3. Start the speculative HTML parser for this instance of the HTML parser.
+                    start_the_speculative_html_parser();
 
                     // 4. Block the tokenizer for this instance of the HTML parser, such that the event loop will not run tasks that invoke the tokenizer.
                     m_tokenizer.set_blocked(true);
@@ -2340,7 +2413,8 @@ void HTMLParser::handle_text(HTMLToken& token)
                     if (m_aborted)
                         return;
 
-                    // FIXME: 7. Stop the speculative HTML parser for this instance of the HTML parser.
+                    // 7. Stop the speculative HTML parser for this instance of the HTML parser.
+                    // NOTE: Our speculative HTML parser has already run to completion in step 3.
 
                     // 8. Unblock the tokenizer for this instance of the HTML parser, such that tasks that invoke the tokenizer can again be run.
                     m_tokenizer.set_blocked(false);
@@ -144,6 +144,7 @@ private:
     void parse_generic_raw_text_element(HTMLToken&);
     void increment_script_nesting_level();
     void decrement_script_nesting_level();
+    void start_the_speculative_html_parser();
     void reset_the_insertion_mode_appropriately();
 
     void adjust_mathml_attributes(HTMLToken&);
@@ -185,6 +186,9 @@ private:
     bool m_stop_parsing { false };
     size_t m_script_nesting_level { 0 };
 
+    // How much input there was when we last looked ahead for things to fetch, so we don't do it again for the same input.
+    size_t m_speculatively_parsed_input_length { 0 };
+
     JS::Realm& realm();
 
     JS::GCPtr<DOM::Document> m_document;
@@ -7,6 +7,7 @@
 
 #include <AK/CharacterTypes.h>
 #include <AK/Debug.h>
+#include <AK/SIMD.h>
 #include <AK/SourceLocation.h>
 #include <LibTextCodec/Decoder.h>
 #include <LibWeb/HTML/Parser/Entities.h>
@@ -155,6 +156,22 @@ namespace Web::HTML {
 #define EMIT_CURRENT_CHARACTER \
     EMIT_CHARACTER(current_input_character.value());
 
+#define EMIT_CURRENT_CHARACTER_AND_ORDINARY_CHARACTERS_UNTIL(...)                                                                  \
+    do {                                                                                                                           \
+        create_new_token(HTMLToken::Type::Character);                                                                              \
+        m_current_token.set_code_point(current_input_character.value());                                                           \
+        m_queued_tokens.enqueue(move(m_current_token));                                                                            \
+        auto position = nth_last_position(0);                                                                                      \
+        queue_character_tokens(consume_ordinary_characters_until<__VA_ARGS__>(max_ordinary_characters_to_emit_at_once), position); \
+        return m_queued_tokens.dequeue();                                                                                          \
+    } while (0)
+
+#define APPEND_CURRENT_CHARACTER_AND_ORDINARY_CHARACTERS_UNTIL(...)                 \
+    do {                                                                            \
+        m_current_builder.append_code_point(current_input_character.value());       \
+        m_current_builder.append(consume_ordinary_characters_until<__VA_ARGS__>()); \
+    } while (0)
+
 #define SWITCH_TO_AND_EMIT_CHARACTER(code_point, new_state) \
     do {                                                    \
         will_switch_to(State::new_state);                   \
@@ -183,25 +200,50 @@ static inline void log_parse_error(SourceLocation const& location = SourceLocati
     dbgln_if(TOKENIZER_TRACE_DEBUG, "Parse error (tokenization) {}", location);
 }
 
+// Character tokens are queued up all at once, so don't produce too many of them in one go.
+static constexpr size_t max_ordinary_characters_to_emit_at_once = 256;
+
+// Returns the offset of the first byte that is one of the given ASCII characters, or the size of the input if there is none.
+template<char... characters>
+static size_t find_first_of(ReadonlyBytes bytes)
+{
+    using AK::SIMD::u8x16;
+
+    size_t offset = 0;
+    for (; offset + sizeof(u8x16) <= bytes.size(); offset += sizeof(u8x16)) {
+        u8x16 chunk;
+        __builtin_memcpy(&chunk, bytes.offset_pointer(offset), sizeof(chunk));
+        auto matches = ((chunk == (u8x16 {} + static_cast<u8>(characters))) | ...);
+        u64 mask_halves[2];
+        __builtin_memcpy(mask_halves, &matches, sizeof(mask_halves));
+        if ((mask_halves[0] | mask_halves[1]) != 0)
+            break;
+    }
+    for (; offset < bytes.size(); ++offset) {
+        if (((bytes[offset] == static_cast<u8>(characters)) || ...))
+            break;
+    }
+    return offset;
+}
+
 Optional<u32> HTMLTokenizer::next_code_point()
 {
     if (m_utf8_iterator == m_utf8_view.end())
         return {};
 
-    u32 code_point;
+    u32 code_point = *m_utf8_iterator;
     // https://html.spec.whatwg.org/multipage/parsing.html#preprocessing-the-input-stream:tokenization
     // https://infra.spec.whatwg.org/#normalize-newlines
-    if (peek_code_point(0).value_or(0) == '\r' && peek_code_point(1).value_or(0) == '\n') {
+    if (code_point == '\r' && peek_code_point(1).value_or(0) == '\n') {
         // replace every U+000D CR U+000A LF code point pair with a single U+000A LF code point,
         skip(2);
         code_point = '\n';
-    } else if (peek_code_point(0).value_or(0) == '\r') {
+    } else if (code_point == '\r') {
         // replace every remaining U+000D CR code point with a U+000A LF code point.
         skip(1);
         code_point = '\n';
     } else {
         skip(1);
-        code_point = *m_prev_utf8_iterator;
     }
 
     dbgln_if(TOKENIZER_TRACE_DEBUG, "(Tokenizer) Next code_point: {}", code_point);
@@ -227,6 +269,60 @@ void HTMLTokenizer::skip(size_t count)
     }
 }
 
+template<char... stop_characters>
+StringView HTMLTokenizer::consume_ordinary_characters_until(size_t max_length)
+{
+    auto offset = m_utf8_view.byte_offset_of(m_utf8_iterator);
+    auto end = m_decoded_input.length();
+    // NOTE: Don't read past the insertion point, as the parser may want to insert more input there once it has been reached.
+    if (m_insertion_point.defined && m_insertion_point.position >= offset)
+        end = min(end, m_insertion_point.position);
+    if (end - offset > max_length)
+        end = offset + max_length;
+
+    // NOTE: A U+000D CR always ends the run, since it has to go through newline normalization in next_code_point().
+    //       None of the stop characters are ever part of a multi-byte UTF-8 sequence, but we mustn't cut one in half at the end.
+    auto bytes = m_decoded_input.bytes().slice(offset, end - offset);
+    auto length = find_first_of<'\r', stop_characters...>(bytes);
+    while (length > 0 && offset + length < m_decoded_input.length() && (m_decoded_input[offset + length] & 0xc0) == 0x80)
+        --length;
+    if (length == 0)
+        return {};
+
+    auto run = StringView { bytes.trim(length) };
+    if (!m_source_positions.is_empty()) {
+        auto position = m_source_positions.last();
+        for (auto byte : run.bytes()) {
+            if (byte == '\n') {
+                position.column = 0;
+                position.line++;
+            } else if ((byte & 0xc0) != 0x80) {
+                position.column++;
+            }
+        }
+        m_source_positions.append(position);
+    }
+    m_utf8_iterator = m_utf8_view.iterator_at_byte_offset_without_validation(offset + length);
+    return run;
+}
+
+void HTMLTokenizer::queue_character_tokens(StringView characters, HTMLToken::Position position)
+{
+    for (auto code_point : Utf8View { characters }) {
+        if (m_source_positions.is_empty()) {
+            // Positions aren't being tracked, keep going with the one we got.
+        } else if (code_point == '\n') {
+            position.column = 0;
+            position.line++;
+        } else {
+            position.column++;
+        }
+        auto token = HTMLToken::make_character(code_point);
+        token.set_start_position({}, position);
+        m_queued_tokens.enqueue(move(token));
+    }
+}
+
 Optional<u32> HTMLTokenizer::peek_code_point(size_t offset) const
 {
     auto it = m_utf8_iterator;
@@ -286,7 +382,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    EMIT_CURRENT_CHARACTER;
+                    EMIT_CURRENT_CHARACTER_AND_ORDINARY_CHARACTERS_UNTIL('&', '<', '\0');
                 }
             }
             END_STATE
@@ -1257,7 +1353,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    m_current_builder.append_code_point(current_input_character.value());
+                    APPEND_CURRENT_CHARACTER_AND_ORDINARY_CHARACTERS_UNTIL('"', '&', '\0');
                     continue;
                 }
             }
@@ -1289,7 +1385,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    m_current_builder.append_code_point(current_input_character.value());
+                    APPEND_CURRENT_CHARACTER_AND_ORDINARY_CHARACTERS_UNTIL('\'', '&', '\0');
                     continue;
                 }
             }
@@ -1354,7 +1450,7 @@ _StartOfFunction:
                 ANYTHING_ELSE
                 {
                 AnythingElseAttributeValueUnquoted:
-                    m_current_builder.append_code_point(current_input_character.value());
+                    APPEND_CURRENT_CHARACTER_AND_ORDINARY_CHARACTERS_UNTIL('\t', '\n', '\f', ' ', '&', '>', '\0', '"', '\'', '<', '=', '`');
                     continue;
                 }
             }
@@ -1459,7 +1555,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    m_current_builder.append_code_point(current_input_character.value());
+                    APPEND_CURRENT_CHARACTER_AND_ORDINARY_CHARACTERS_UNTIL('<', '-', '\0');
                     continue;
                 }
             }
@@ -1896,7 +1992,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    EMIT_CURRENT_CHARACTER;
+                    EMIT_CURRENT_CHARACTER_AND_ORDINARY_CHARACTERS_UNTIL('&', '<', '\0');
                 }
             }
             END_STATE
@@ -2015,7 +2111,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    EMIT_CURRENT_CHARACTER;
+                    EMIT_CURRENT_CHARACTER_AND_ORDINARY_CHARACTERS_UNTIL('<', '\0');
                 }
             }
             END_STATE
@@ -2134,7 +2230,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    EMIT_CURRENT_CHARACTER;
+                    EMIT_CURRENT_CHARACTER_AND_ORDINARY_CHARACTERS_UNTIL('<', '\0');
                 }
             }
             END_STATE
@@ -2153,7 +2249,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    EMIT_CURRENT_CHARACTER;
+                    EMIT_CURRENT_CHARACTER_AND_ORDINARY_CHARACTERS_UNTIL('\0');
                 }
             }
             END_STATE
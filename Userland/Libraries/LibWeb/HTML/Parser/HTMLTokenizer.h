@@ -125,6 +125,9 @@ public:
 
     DeprecatedString source() const { return m_decoded_input; }
 
+    // The part of the input that hasn't been tokenized yet.
+    StringView unprocessed_input() const { return m_decoded_input.substring_view(m_utf8_view.byte_offset_of(m_utf8_iterator)); }
+
     void insert_input_at_insertion_point(DeprecatedString const& input);
     void insert_eof();
     bool is_eof_inserted();
@@ -150,6 +153,9 @@ private:
     void skip(size_t count);
     Optional<u32> next_code_point();
     Optional<u32> peek_code_point(size_t offset) const;
+    template<char... stop_characters>
+    StringView consume_ordinary_characters_until(size_t max_length = NumericLimits<size_t>::max());
+    void queue_character_tokens(StringView, HTMLToken::Position);
     bool consume_next_if_match(StringView, CaseSensitivity = CaseSensitivity::CaseSensitive);
     void create_new_token(HTMLToken::Type);
     bool current_end_tag_token_is_appropriate() const;
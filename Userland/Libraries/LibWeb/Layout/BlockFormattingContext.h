@@ -89,7 +89,7 @@ private:
 
     struct FloatSideData {
         // Floating boxes currently accumulating on this side.
-        Vector<FloatingBox&> current_boxes;
+        SmallVector<FloatingBox&> current_boxes;
 
         // Combined width of boxes currently accumulating on this side.
         // This is the innermost margin of the innermost floating box.
@@ -112,7 +112,7 @@ private:
     };
 
     struct BlockMarginState {
-        Vector<CSSPixels> current_collapsible_margins;
+        SmallVector<CSSPixels> current_collapsible_margins;
         Function<void(CSSPixels)> block_container_y_position_update_callback;
         bool box_last_in_flow_child_margin_bottom_collapsed { false };
 
@@ -44,6 +44,13 @@ void Box::set_scroll_offset(CSSPixelPoint offset)
     set_needs_display();
 }
 
+Box::IntrinsicSizes& Box::cached_intrinsic_sizes() const
+{
+    if (!m_cached_intrinsic_sizes)
+        m_cached_intrinsic_sizes = make<IntrinsicSizes>();
+    return *m_cached_intrinsic_sizes;
+}
+
 void Box::set_needs_display()
 {
     if (paint_box())
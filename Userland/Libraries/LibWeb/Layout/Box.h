@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/HashMap.h>
 #include <AK/OwnPtr.h>
 #include <LibGfx/Rect.h>
 #include <LibJS/Heap/Cell.h>
@@ -46,6 +47,25 @@ public:
     CSSPixelPoint scroll_offset() const { return m_scroll_offset; }
     void set_scroll_offset(CSSPixelPoint);
 
+    // We cache intrinsic sizes once determined, as they only change when something inside the box needs a layout update.
+    // This avoids computing them several times while performing flex layout, and again during every following layout.
+    struct IntrinsicSizes {
+        Optional<CSSPixels> min_content_width;
+        Optional<CSSPixels> max_content_width;
+
+        // NOTE: Since intrinsic heights depend on the amount of available width, we have to cache
+        //       three separate kinds of results, depending on the available width at the time of calculation.
+        HashMap<CSSPixels, Optional<CSSPixels>> min_content_height_with_definite_available_width;
+        HashMap<CSSPixels, Optional<CSSPixels>> max_content_height_with_definite_available_width;
+        Optional<CSSPixels> min_content_height_with_min_content_available_width;
+        Optional<CSSPixels> max_content_height_with_min_content_available_width;
+        Optional<CSSPixels> min_content_height_with_max_content_available_width;
+        Optional<CSSPixels> max_content_height_with_max_content_available_width;
+    };
+
+    IntrinsicSizes& cached_intrinsic_sizes() const;
+    void reset_cached_intrinsic_sizes() const { m_cached_intrinsic_sizes = nullptr; }
+
 protected:
     Box(DOM::Document&, DOM::Node*, NonnullRefPtr<CSS::StyleProperties>);
     Box(DOM::Document&, DOM::Node*, CSS::ComputedValues);
@@ -54,6 +74,8 @@ private:
     virtual bool is_box() const final { return true; }
 
     CSSPixelPoint m_scroll_offset;
+
+    mutable OwnPtr<IntrinsicSizes> m_cached_intrinsic_sizes;
 };
 
 template<>
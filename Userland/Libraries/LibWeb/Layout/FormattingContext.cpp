@@ -1075,9 +1075,7 @@ CSSPixels FormattingContext::calculate_min_content_width(Layout::Box const& box)
     if (box.has_intrinsic_width())
         return *box.intrinsic_width();
 
-    auto& root_state = m_state.m_root;
-
-    auto& cache = *root_state.intrinsic_sizes.ensure(&box, [] { return adopt_own(*new LayoutState::IntrinsicSizes); });
+    auto& cache = box.cached_intrinsic_sizes();
     if (cache.min_content_width.has_value())
         return *cache.min_content_width;
 
@@ -1113,9 +1111,7 @@ CSSPixels FormattingContext::calculate_max_content_width(Layout::Box const& box)
     if (box.has_intrinsic_width())
         return *box.intrinsic_width();
 
-    auto& root_state = m_state.m_root;
-
-    auto& cache = *root_state.intrinsic_sizes.ensure(&box, [] { return adopt_own(*new LayoutState::IntrinsicSizes); });
+    auto& cache = box.cached_intrinsic_sizes();
     if (cache.max_content_width.has_value())
         return *cache.max_content_width;
 
@@ -1159,8 +1155,7 @@ CSSPixels FormattingContext::calculate_min_content_height(Layout::Box const& box
     bool is_cacheable = available_width.is_definite() || available_width.is_intrinsic_sizing_constraint();
     Optional<CSSPixels>* cache_slot = nullptr;
     if (is_cacheable) {
-        auto& root_state = m_state.m_root;
-        auto& cache = *root_state.intrinsic_sizes.ensure(&box, [] { return adopt_own(*new LayoutState::IntrinsicSizes); });
+        auto& cache = box.cached_intrinsic_sizes();
         if (available_width.is_definite()) {
             cache_slot = &cache.min_content_height_with_definite_available_width.ensure(available_width.to_px());
         } else if (available_width.is_min_content()) {
@@ -1204,8 +1199,7 @@ CSSPixels FormattingContext::calculate_max_content_height(Layout::Box const& box
     bool is_cacheable = available_width.is_definite() || available_width.is_intrinsic_sizing_constraint();
     Optional<CSSPixels>* cache_slot = nullptr;
     if (is_cacheable) {
-        auto& root_state = m_state.m_root;
-        auto& cache = *root_state.intrinsic_sizes.ensure(&box, [] { return adopt_own(*new LayoutState::IntrinsicSizes); });
+        auto& cache = box.cached_intrinsic_sizes();
         if (available_width.is_definite()) {
             cache_slot = &cache.max_content_height_with_definite_available_width.ensure(available_width.to_px());
         } else if (available_width.is_min_content()) {
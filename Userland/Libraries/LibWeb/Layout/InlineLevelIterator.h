@@ -95,7 +95,7 @@ private:
     Optional<ExtraBoxMetrics> m_extra_leading_metrics;
     Optional<ExtraBoxMetrics> m_extra_trailing_metrics;
 
-    Vector<NodeWithStyleAndBoxModelMetrics const&> m_box_model_node_stack;
+    SmallVector<NodeWithStyleAndBoxModelMetrics const&> m_box_model_node_stack;
 };
 
 }
@@ -11,44 +11,60 @@
 
 namespace Web::Layout {
 
+LayoutState::UsedValues* LayoutState::find_own_used_values(size_t serial_id) const
+{
+    if (!m_parent)
+        return used_values_per_layout_node[serial_id].ptr();
+    auto it = used_values_per_touched_layout_node.find(serial_id);
+    if (it == used_values_per_touched_layout_node.end())
+        return nullptr;
+    return it->value.ptr();
+}
+
+LayoutState::UsedValues& LayoutState::set_own_used_values(size_t serial_id, NonnullOwnPtr<UsedValues> used_values)
+{
+    auto& used_values_ref = *used_values;
+    if (!m_parent)
+        used_values_per_layout_node[serial_id] = move(used_values);
+    else
+        used_values_per_touched_layout_node.set(serial_id, move(used_values));
+    return used_values_ref;
+}
+
 LayoutState::UsedValues& LayoutState::get_mutable(NodeWithStyleAndBoxModelMetrics const& box)
 {
     auto serial_id = box.serial_id();
-    if (used_values_per_layout_node[serial_id])
-        return *used_values_per_layout_node[serial_id];
+    if (auto* used_values = find_own_used_values(serial_id))
+        return *used_values;
 
     for (auto const* ancestor = m_parent; ancestor; ancestor = ancestor->m_parent) {
-        if (ancestor->used_values_per_layout_node[serial_id]) {
-            auto cow_used_values = adopt_own(*new UsedValues(*ancestor->used_values_per_layout_node[serial_id]));
-            auto* cow_used_values_ptr = cow_used_values.ptr();
-            used_values_per_layout_node[serial_id] = move(cow_used_values);
-            return *cow_used_values_ptr;
-        }
+        if (auto* ancestor_used_values = ancestor->find_own_used_values(serial_id))
+            return set_own_used_values(serial_id, adopt_own(*new UsedValues(*ancestor_used_values)));
     }
 
     auto const* containing_block_used_values = box.is_viewport() ? nullptr : &get(*box.containing_block());
 
-    used_values_per_layout_node[serial_id] = adopt_own(*new UsedValues);
-    used_values_per_layout_node[serial_id]->set_node(const_cast<NodeWithStyleAndBoxModelMetrics&>(box), containing_block_used_values);
-    return *used_values_per_layout_node[serial_id];
+    auto& used_values = set_own_used_values(serial_id, adopt_own(*new UsedValues));
+    used_values.set_node(const_cast<NodeWithStyleAndBoxModelMetrics&>(box), containing_block_used_values);
+    return used_values;
 }
 
 LayoutState::UsedValues const& LayoutState::get(NodeWithStyleAndBoxModelMetrics const& box) const
 {
     auto serial_id = box.serial_id();
-    if (used_values_per_layout_node[serial_id])
-        return *used_values_per_layout_node[serial_id];
+    if (auto* used_values = find_own_used_values(serial_id))
+        return *used_values;
 
     for (auto* ancestor = m_parent; ancestor; ancestor = ancestor->m_parent) {
-        if (ancestor->used_values_per_layout_node[serial_id])
-            return *ancestor->used_values_per_layout_node[serial_id];
+        if (auto* ancestor_used_values = ancestor->find_own_used_values(serial_id))
+            return *ancestor_used_values;
     }
 
     auto const* containing_block_used_values = box.is_viewport() ? nullptr : &get(*box.containing_block());
 
-    const_cast<LayoutState*>(this)->used_values_per_layout_node[serial_id] = adopt_own(*new UsedValues);
-    const_cast<LayoutState*>(this)->used_values_per_layout_node[serial_id]->set_node(const_cast<NodeWithStyleAndBoxModelMetrics&>(box), containing_block_used_values);
-    return *used_values_per_layout_node[serial_id];
+    auto& used_values = const_cast<LayoutState*>(this)->set_own_used_values(serial_id, adopt_own(*new UsedValues));
+    used_values.set_node(const_cast<NodeWithStyleAndBoxModelMetrics&>(box), containing_block_used_values);
+    return used_values;
 }
 
 void LayoutState::commit()
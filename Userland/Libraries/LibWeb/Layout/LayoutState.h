@@ -33,7 +33,6 @@ struct LayoutState {
         : m_parent(parent)
         , m_root(find_root())
     {
-        used_values_per_layout_node.resize(m_root.used_values_per_layout_node.size());
     }
 
     LayoutState const& find_root() const
@@ -153,25 +152,13 @@ struct LayoutState {
     // NOTE: get() will not CoW the UsedValues.
     UsedValues const& get(NodeWithStyleAndBoxModelMetrics const&) const;
 
+    // NOTE: Only the root state has a slot for every layout node. Nested states are thrown away after measuring a single box
+    //       (which happens a lot during intrinsic sizing), so they only keep track of the nodes they actually touch.
     Vector<OwnPtr<UsedValues>> used_values_per_layout_node;
+    HashMap<size_t, NonnullOwnPtr<UsedValues>> used_values_per_touched_layout_node;
 
-    // We cache intrinsic sizes once determined, as they will not change over the course of a full layout.
-    // This avoids computing them several times while performing flex layout.
-    struct IntrinsicSizes {
-        Optional<CSSPixels> min_content_width;
-        Optional<CSSPixels> max_content_width;
-
-        // NOTE: Since intrinsic heights depend on the amount of available width, we have to cache
-        //       three separate kinds of results, depending on the available width at the time of calculation.
-        HashMap<CSSPixels, Optional<CSSPixels>> min_content_height_with_definite_available_width;
-        HashMap<CSSPixels, Optional<CSSPixels>> max_content_height_with_definite_available_width;
-        Optional<CSSPixels> min_content_height_with_min_content_available_width;
-        Optional<CSSPixels> max_content_height_with_min_content_available_width;
-        Optional<CSSPixels> min_content_height_with_max_content_available_width;
-        Optional<CSSPixels> max_content_height_with_max_content_available_width;
-    };
-
-    HashMap<NodeWithStyleAndBoxModelMetrics const*, NonnullOwnPtr<IntrinsicSizes>> mutable intrinsic_sizes;
+    UsedValues* find_own_used_values(size_t serial_id) const;
+    UsedValues& set_own_used_values(size_t serial_id, NonnullOwnPtr<UsedValues>);
 
     LayoutState const* m_parent { nullptr };
     LayoutState const& m_root;
@@ -34,6 +34,19 @@ StringView LineBoxFragment::text() const
     return verify_cast<TextNode>(layout_node()).text_for_rendering().substring_view(m_start, m_length);
 }
 
+ReadonlySpan<Gfx::DrawGlyphOrEmoji> LineBoxFragment::glyph_run(Gfx::Font const& font) const
+{
+    if (m_glyph_run_font.ptr() == &font)
+        return m_glyph_run;
+
+    m_glyph_run.clear_with_capacity();
+    Gfx::for_each_glyph_position({}, Utf8View { text() }, font, [&](Gfx::DrawGlyphOrEmoji const& glyph_or_emoji) {
+        m_glyph_run.append(glyph_or_emoji);
+    });
+    m_glyph_run_font = font;
+    return m_glyph_run;
+}
+
 CSSPixelRect const LineBoxFragment::absolute_rect() const
 {
     CSSPixelRect rect { {}, size() };
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <LibGfx/Rect.h>
+#include <LibGfx/TextLayout.h>
 #include <LibWeb/Forward.h>
 #include <LibWeb/PixelUnits.h>
 
@@ -76,6 +77,10 @@ public:
 
     CSSPixelRect selection_rect(Gfx::Font const&) const;
 
+    // The fragment's text laid out with the given font, relative to the start of its baseline.
+    // This is kept around between paints, and only redone when painting with a different font.
+    ReadonlySpan<Gfx::DrawGlyphOrEmoji> glyph_run(Gfx::Font const&) const;
+
 private:
     Node const& m_layout_node;
     int m_start { 0 };
@@ -86,6 +91,9 @@ private:
     CSSPixels m_border_box_bottom { 0 };
     CSSPixels m_baseline { 0 };
     Type m_type { Type::Normal };
+
+    mutable RefPtr<Gfx::Font const> m_glyph_run_font;
+    mutable Vector<Gfx::DrawGlyphOrEmoji> m_glyph_run;
 };
 
 }
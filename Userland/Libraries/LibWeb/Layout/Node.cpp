@@ -175,6 +175,28 @@ Viewport& Node::root()
     return *document().layout_node();
 }
 
+void Node::set_needs_layout_update()
+{
+    // NOTE: The intrinsic sizes of a box depend on everything inside it, so an ancestor can't keep them either.
+    //       Once we reach an ancestor that already needs a layout update, so does everything above it.
+    for (auto* node = this; node && !node->m_needs_layout_update; node = node->parent()) {
+        node->m_needs_layout_update = true;
+        if (is<Box>(*node))
+            static_cast<Box const&>(*node).reset_cached_intrinsic_sizes();
+    }
+}
+
+void Node::reset_needs_layout_update()
+{
+    // NOTE: Layout updates are propagated towards the root, so there is nothing to reset below a node that doesn't need one.
+    if (!m_needs_layout_update)
+        return;
+    m_needs_layout_update = false;
+    for_each_child([](auto& child) {
+        child.reset_needs_layout_update();
+    });
+}
+
 void Node::set_needs_display()
 {
     auto* containing_block = this->containing_block();
@@ -129,6 +129,12 @@ public:
 
     virtual void set_needs_display();
 
+    // Marks this node and its ancestors as having changed since the last layout, which drops what they've cached about
+    // their layout. Scheduling the layout itself is up to the caller.
+    bool needs_layout_update() const { return m_needs_layout_update; }
+    void set_needs_layout_update();
+    void reset_needs_layout_update();
+
     bool children_are_inline() const { return m_children_are_inline; }
     void set_children_are_inline(bool value) { m_children_are_inline = value; }
 
@@ -164,6 +170,7 @@ private:
     bool m_has_style { false };
     bool m_visible { true };
     bool m_children_are_inline { false };
+    bool m_needs_layout_update { true };
     SelectionState m_selection_state { SelectionState::None };
 
     bool m_is_flex_item { false };
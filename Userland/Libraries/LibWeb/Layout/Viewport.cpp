@@ -9,6 +9,7 @@
 #include <LibWeb/Layout/Viewport.h>
 #include <LibWeb/Painting/PaintableBox.h>
 #include <LibWeb/Painting/StackingContext.h>
+#include <LibWeb/PhaseTimings.h>
 
 namespace Web::Layout {
 
@@ -54,6 +55,7 @@ void Viewport::build_stacking_context_tree()
 
 void Viewport::paint_all_phases(PaintContext& context)
 {
+    TemporaryPhaseTimer phase_timer(TimedPhase::Painting);
     build_stacking_context_tree_if_needed();
     context.painter().fill_rect(context.enclosing_device_rect(paint_box()->absolute_rect()).to_type<int>(), document().background_color(context.palette()));
     context.painter().translate(-context.device_viewport_rect().location().to_type<int>());
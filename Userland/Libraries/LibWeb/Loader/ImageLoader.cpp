@@ -83,6 +83,17 @@ void ImageLoader::resource_did_load()
         return;
     }
 
+    // NOTE: We only tell anyone that the image has loaded once it's been decoded in the background, so that using it
+    //       doesn't block on decoding it.
+    resource()->decode_if_needed_async([weak_this = make_weak_ptr<ImageLoader>(), resource = NonnullRefPtr { *resource() }] {
+        if (!weak_this || weak_this->resource() != resource.ptr())
+            return;
+        weak_this->resource_did_decode();
+    });
+}
+
+void ImageLoader::resource_did_decode()
+{
     m_loading_state = LoadingState::Loaded;
 
     if constexpr (IMAGE_LOADER_DEBUG) {
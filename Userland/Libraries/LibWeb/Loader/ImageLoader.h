@@ -44,6 +44,8 @@ private:
     virtual void resource_did_fail() override;
     virtual bool is_visible_in_viewport() const override { return m_visible_in_viewport; }
 
+    void resource_did_decode();
+
     void animate();
 
     enum class LoadingState {
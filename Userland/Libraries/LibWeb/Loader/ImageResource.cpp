@@ -47,7 +47,33 @@ void ImageResource::decode_if_needed() const
     if (!m_decoded_frames.is_empty())
         return;
 
-    auto image = Platform::ImageCodecPlugin::the().decode_image(encoded_data());
+    did_decode(Platform::ImageCodecPlugin::the().decode_image(encoded_data()));
+}
+
+void ImageResource::decode_if_needed_async(Function<void()> on_decoded)
+{
+    if (!has_encoded_data() || m_has_attempted_decode || !m_decoded_frames.is_empty()) {
+        on_decoded();
+        return;
+    }
+
+    m_on_decoded_callbacks.append(move(on_decoded));
+    if (m_on_decoded_callbacks.size() > 1)
+        return;
+
+    Platform::ImageCodecPlugin::the().decode_image_async(encoded_data(), [strong_this = NonnullRefPtr { *this }](Optional<Platform::DecodedImage> image) {
+        // NOTE: Someone may have needed the image before it finished decoding in the background, and decoded it themselves.
+        if (!strong_this->m_has_attempted_decode && strong_this->m_decoded_frames.is_empty())
+            strong_this->did_decode(move(image));
+
+        auto callbacks = move(strong_this->m_on_decoded_callbacks);
+        for (auto& callback : callbacks)
+            callback();
+    });
+}
+
+void ImageResource::did_decode(Optional<Platform::DecodedImage> image) const
+{
     m_has_attempted_decode = true;
 
     if (!image.has_value()) {
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Function.h>
 #include <LibWeb/Loader/Resource.h>
 
 namespace Web {
@@ -43,16 +44,22 @@ public:
 
     void update_volatility();
 
+    // Decodes the image in the background if that hasn't happened yet, so that later accesses to its frames don't
+    // have to block on decoding. on_decoded is called once it's done, even if decoding failed.
+    void decode_if_needed_async(Function<void()> on_decoded);
+
 private:
     explicit ImageResource(LoadRequest const&);
     explicit ImageResource(Resource&);
 
     void decode_if_needed() const;
+    void did_decode(Optional<Platform::DecodedImage>) const;
 
     mutable bool m_animated { false };
     mutable int m_loop_count { 0 };
     mutable Vector<Frame> m_decoded_frames;
     mutable bool m_has_attempted_decode { false };
+    Vector<Function<void()>> m_on_decoded_callbacks;
 };
 
 class ImageResourceClient : public ResourceClient {
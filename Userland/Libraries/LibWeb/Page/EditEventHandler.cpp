@@ -33,10 +33,8 @@ void EditEventHandler::handle_delete_character_after(DOM::Position const& cursor
     builder.append(text.substring_view(*next_grapheme_offset));
     node.set_data(builder.to_deprecated_string());
 
-    // FIXME: When nodes are removed from the DOM, the associated layout nodes become stale and still
-    //        remain in the layout tree. This has to be fixed, this just causes everything to be recomputed
-    //        which really hurts performance.
-    m_browsing_context.active_document()->force_layout();
+    // NOTE: Only the text changed, so the layout tree can stay as it is.
+    m_browsing_context.active_document()->update_layout();
 
     m_browsing_context.did_edit({});
 }
@@ -94,10 +92,14 @@ void EditEventHandler::handle_delete(DOM::Range& range)
         end->remove();
     }
 
+    // NOTE: If only the text changed, the layout tree can stay as it is.
     // FIXME: When nodes are removed from the DOM, the associated layout nodes become stale and still
     //        remain in the layout tree. This has to be fixed, this just causes everything to be recomputed
     //        which really hurts performance.
-    m_browsing_context.active_document()->force_layout();
+    if (start == end)
+        m_browsing_context.active_document()->update_layout();
+    else
+        m_browsing_context.active_document()->force_layout();
 
     m_browsing_context.did_edit({});
 }
@@ -116,10 +118,8 @@ void EditEventHandler::handle_insert(DOM::Position position, u32 code_point)
         node.invalidate_style();
     }
 
-    // FIXME: When nodes are removed from the DOM, the associated layout nodes become stale and still
-    //        remain in the layout tree. This has to be fixed, this just causes everything to be recomputed
-    //        which really hurts performance.
-    m_browsing_context.active_document()->force_layout();
+    // NOTE: Only the text changed, so the layout tree can stay as it is.
+    m_browsing_context.active_document()->update_layout();
 
     m_browsing_context.did_edit({});
 }
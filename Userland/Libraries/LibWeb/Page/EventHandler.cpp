@@ -14,6 +14,7 @@
 #include <LibWeb/HTML/HTMLIFrameElement.h>
 #include <LibWeb/HTML/HTMLImageElement.h>
 #include <LibWeb/Layout/Viewport.h>
+#include <LibWeb/Loader/ResourceLoader.h>
 #include <LibWeb/Page/EventHandler.h>
 #include <LibWeb/Page/Page.h>
 #include <LibWeb/Painting/PaintableBox.h>
@@ -521,9 +522,13 @@ bool EventHandler::handle_mousemove(CSSPixelPoint position, unsigned buttons, un
             } else {
                 page->client().page_did_leave_tooltip_area();
             }
-            if (is_hovering_link)
-                page->client().page_did_hover_link(document.parse_url(hovered_link_element->href()));
-            else
+            if (is_hovering_link) {
+                auto url = document.parse_url(hovered_link_element->href());
+                page->client().page_did_hover_link(url);
+                // A hovered link is likely to be followed next, so have a connection to its host ready by then.
+                if (url.scheme().is_one_of("http"sv, "https"sv))
+                    ResourceLoader::the().preconnect(url);
+            } else
                 page->client().page_did_unhover_link();
         }
     }
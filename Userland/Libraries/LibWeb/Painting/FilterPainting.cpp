@@ -21,8 +21,19 @@ namespace Web::Painting {
 
 void apply_filter_list(Gfx::Bitmap& target_bitmap, Layout::Node const& node, ReadonlySpan<CSS::FilterFunction> filter_list)
 {
-    auto apply_color_filter = [&](Gfx::ColorFilter const& filter) {
-        const_cast<Gfx::ColorFilter&>(filter).apply(target_bitmap, target_bitmap.rect(), target_bitmap, target_bitmap.rect());
+    // Consecutive color filters are collected and then applied together, so that the bitmap only has to be walked once for all of them.
+    Vector<NonnullOwnPtr<Gfx::ColorFilter>> pending_color_filters;
+    auto apply_color_filter = [&](NonnullOwnPtr<Gfx::ColorFilter> filter) {
+        pending_color_filters.append(move(filter));
+    };
+    auto flush_color_filters = [&] {
+        if (pending_color_filters.is_empty())
+            return;
+        Vector<Gfx::ColorFilter*> filters;
+        for (auto& filter : pending_color_filters)
+            filters.append(filter.ptr());
+        Gfx::ColorFilter::apply_chain(target_bitmap, target_bitmap.rect(), target_bitmap, target_bitmap.rect(), filters);
+        pending_color_filters.clear();
     };
     for (auto& filter_function : filter_list) {
         // See: https://drafts.fxtf.org/filter-effects-1/#supported-filter-functions
@@ -30,6 +41,7 @@ void apply_filter_list(Gfx::Bitmap& target_bitmap, Layout::Node const& node, Rea
             [&](CSS::Filter::Blur const& blur) {
                 // Applies a Gaussian blur to the input image.
                 // The passed parameter defines the value of the standard deviation to the Gaussian function.
+                flush_color_filters();
                 Gfx::StackBlurFilter filter { target_bitmap };
                 filter.process_rgba(blur.resolved_radius(node), Color::Transparent);
             },
@@ -40,38 +52,38 @@ void apply_filter_list(Gfx::Bitmap& target_bitmap, Layout::Node const& node, Rea
                 case CSS::Filter::Color::Operation::Grayscale: {
                     // Converts the input image to grayscale. The passed parameter defines the proportion of the conversion.
                     // A value of 100% is completely grayscale. A value of 0% leaves the input unchanged.
-                    apply_color_filter(Gfx::GrayscaleFilter { amount_clamped });
+                    apply_color_filter(make<Gfx::GrayscaleFilter>(amount_clamped));
                     break;
                 }
                 case CSS::Filter::Color::Operation::Brightness: {
                     // Applies a linear multiplier to input image, making it appear more or less bright.
                     // A value of 0% will create an image that is completely black. A value of 100% leaves the input unchanged.
                     // Values of amount over 100% are allowed, providing brighter results.
-                    apply_color_filter(Gfx::BrightnessFilter { amount });
+                    apply_color_filter(make<Gfx::BrightnessFilter>(amount));
                     break;
                 }
                 case CSS::Filter::Color::Operation::Contrast: {
                     // Adjusts the contrast of the input. A value of 0% will create an image that is completely gray.
                     // A value of 100% leaves the input unchanged. Values of amount over 100% are allowed, providing results with more contrast.
-                    apply_color_filter(Gfx::ContrastFilter { amount });
+                    apply_color_filter(make<Gfx::ContrastFilter>(amount));
                     break;
                 }
                 case CSS::Filter::Color::Operation::Invert: {
                     // Inverts the samples in the input image. The passed parameter defines the proportion of the conversion.
                     // A value of 100% is completely inverted. A value of 0% leaves the input unchanged.
-                    apply_color_filter(Gfx::InvertFilter { amount_clamped });
+                    apply_color_filter(make<Gfx::InvertFilter>(amount_clamped));
                     break;
                 }
                 case CSS::Filter::Color::Operation::Opacity: {
                     // Applies transparency to the samples in the input image. The passed parameter defines the proportion of the conversion.
                     // A value of 0% is completely transparent. A value of 100% leaves the input unchanged.
-                    apply_color_filter(Gfx::OpacityFilter { amount_clamped });
+                    apply_color_filter(make<Gfx::OpacityFilter>(amount_clamped));
                     break;
                 }
                 case CSS::Filter::Color::Operation::Sepia: {
                     // Converts the input image to sepia. The passed parameter defines the proportion of the conversion.
                     // A value of 100% is completely sepia. A value of 0% leaves the input unchanged.
-                    apply_color_filter(Gfx::SepiaFilter { amount_clamped });
+                    apply_color_filter(make<Gfx::SepiaFilter>(amount_clamped));
                     break;
                 }
                 case CSS::Filter::Color::Operation::Saturate: {
@@ -79,7 +91,7 @@ void apply_filter_list(Gfx::Bitmap& target_bitmap, Layout::Node const& node, Rea
                     // A value of 0% is completely un-saturated. A value of 100% leaves the input unchanged.
                     // Other values are linear multipliers on the effect.
                     // Values of amount over 100% are allowed, providing super-saturated results
-                    apply_color_filter(Gfx::SaturateFilter { amount });
+                    apply_color_filter(make<Gfx::SaturateFilter>(amount));
                     break;
                 }
                 default:
@@ -90,12 +102,13 @@ void apply_filter_list(Gfx::Bitmap& target_bitmap, Layout::Node const& node, Rea
                 // Applies a hue rotation on the input image.
                 // The passed parameter defines the number of degrees around the color circle the input samples will be adjusted.
                 // A value of 0deg leaves the input unchanged. Implementations must not normalize this value in order to allow animations beyond 360deg.
-                apply_color_filter(Gfx::HueRotateFilter { hue_rotate.angle_degrees() });
+                apply_color_filter(make<Gfx::HueRotateFilter>(hue_rotate.angle_degrees()));
             },
             [&](CSS::Filter::DropShadow const&) {
                 dbgln("TODO: Implement drop-shadow() filter function!");
             });
     }
+    flush_color_filters();
 }
 
 void apply_backdrop_filter(PaintContext& context, Layout::Node const& node, CSSPixelRect const& backdrop_rect, BorderRadiiData const& border_radii_data, CSS::BackdropFilter const& backdrop_filter)
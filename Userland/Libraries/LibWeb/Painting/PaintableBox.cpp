@@ -520,10 +520,7 @@ static void paint_text_fragment(PaintContext& context, Layout::TextNode const& t
         if (text_node.document().inspected_node() == &text_node.dom_node())
             context.painter().draw_rect(fragment_absolute_device_rect.to_type<int>(), Color::Magenta);
 
-        auto text = text_node.text_for_rendering();
-
         DevicePixelPoint baseline_start { fragment_absolute_device_rect.x(), fragment_absolute_device_rect.y() + context.rounded_device_pixels(fragment.baseline()) };
-        Utf8View view { text.substring_view(fragment.start(), fragment.length()) };
 
         auto& font = fragment.layout_node().font();
         auto scaled_font = [&]() -> RefPtr<Gfx::Font const> {
@@ -541,14 +538,16 @@ static void paint_text_fragment(PaintContext& context, Layout::TextNode const& t
             return {};
         }();
 
-        painter.draw_text_run(baseline_start.to_type<int>(), view, scaled_font ? *scaled_font : font, text_node.computed_values().color());
+        auto const& font_for_painting = scaled_font ? *scaled_font : font;
+        auto glyph_run = fragment.glyph_run(font_for_painting);
+        painter.draw_glyph_run(baseline_start.to_type<int>().to_type<float>(), glyph_run, font_for_painting, text_node.computed_values().color());
 
         auto selection_rect = context.enclosing_device_rect(fragment.selection_rect(text_node.font())).to_type<int>();
         if (!selection_rect.is_empty()) {
             painter.fill_rect(selection_rect, context.palette().selection());
             Gfx::PainterStateSaver saver(painter);
             painter.add_clip_rect(selection_rect);
-            painter.draw_text_run(baseline_start.to_type<int>(), view, scaled_font ? *scaled_font : font, context.palette().selection_text());
+            painter.draw_glyph_run(baseline_start.to_type<int>().to_type<float>(), glyph_run, font_for_painting, context.palette().selection_text());
         }
 
         paint_text_decoration(context, painter, text_node, fragment);
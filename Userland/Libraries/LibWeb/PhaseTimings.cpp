@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWeb/PhaseTimings.h>
+
+namespace Web {
+
+StringView timed_phase_name(TimedPhase phase)
+{
+    switch (phase) {
+    case TimedPhase::Parsing:
+        return "parsing"sv;
+    case TimedPhase::Style:
+        return "style"sv;
+    case TimedPhase::Layout:
+        return "layout"sv;
+    case TimedPhase::Painting:
+        return "painting"sv;
+    case TimedPhase::JavaScript:
+        return "javascript"sv;
+    case TimedPhase::__Count:
+        break;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+PhaseTimings& PhaseTimings::the()
+{
+    static PhaseTimings timings;
+    return timings;
+}
+
+void PhaseTimings::reset()
+{
+    m_time_spent.fill({});
+    m_phase_start = Time::now_monotonic();
+}
+
+void PhaseTimings::enter(TimedPhase phase)
+{
+    auto now = Time::now_monotonic();
+    if (!m_phase_stack.is_empty())
+        m_time_spent[to_underlying(m_phase_stack.last())] += now - m_phase_start;
+    m_phase_stack.append(phase);
+    m_phase_start = now;
+}
+
+void PhaseTimings::leave()
+{
+    auto now = Time::now_monotonic();
+    m_time_spent[to_underlying(m_phase_stack.take_last())] += now - m_phase_start;
+    m_phase_start = now;
+}
+
+}
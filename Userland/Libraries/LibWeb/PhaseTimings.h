@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/Noncopyable.h>
+#include <AK/StringView.h>
+#include <AK/Time.h>
+#include <AK/Vector.h>
+
+namespace Web {
+
+enum class TimedPhase {
+    Parsing,
+    Style,
+    Layout,
+    Painting,
+    JavaScript,
+    __Count,
+};
+
+StringView timed_phase_name(TimedPhase);
+
+// Where the time goes while loading and rendering pages, for benchmarks. It's off unless a benchmark turns it on.
+// When a phase starts inside another one, like a script that runs during parsing, the time only counts towards the
+// inner phase, so the phases add up to the time spent in any of them.
+class PhaseTimings {
+public:
+    static PhaseTimings& the();
+
+    bool is_enabled() const { return m_enabled; }
+    void set_enabled(bool enabled) { m_enabled = enabled; }
+
+    Time time_spent_in(TimedPhase phase) const { return m_time_spent[to_underlying(phase)]; }
+    void reset();
+
+private:
+    friend class TemporaryPhaseTimer;
+
+    void enter(TimedPhase);
+    void leave();
+
+    bool m_enabled { false };
+    Array<Time, to_underlying(TimedPhase::__Count)> m_time_spent {};
+    Vector<TimedPhase, 8> m_phase_stack;
+    Time m_phase_start;
+};
+
+class TemporaryPhaseTimer {
+    AK_MAKE_NONCOPYABLE(TemporaryPhaseTimer);
+    AK_MAKE_NONMOVABLE(TemporaryPhaseTimer);
+
+public:
+    explicit TemporaryPhaseTimer(TimedPhase phase)
+        : m_is_timing(PhaseTimings::the().is_enabled())
+    {
+        if (m_is_timing)
+            PhaseTimings::the().enter(phase);
+    }
+
+    ~TemporaryPhaseTimer()
+    {
+        if (m_is_timing)
+            PhaseTimings::the().leave();
+    }
+
+private:
+    bool m_is_timing { false };
+};
+
+}
@@ -5,6 +5,9 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ByteBuffer.h>
+#include <LibGfx/Bitmap.h>
+#include <LibWeb/Platform/EventLoopPlugin.h>
 #include <LibWeb/Platform/ImageCodecPlugin.h>
 
 namespace Web::Platform {
@@ -25,4 +28,16 @@ void ImageCodecPlugin::install(ImageCodecPlugin& plugin)
     s_the = &plugin;
 }
 
+void ImageCodecPlugin::decode_image_async(ReadonlyBytes bytes, Function<void(Optional<DecodedImage>)> on_complete)
+{
+    auto encoded_data = ByteBuffer::copy(bytes);
+    EventLoopPlugin::the().deferred_invoke([this, encoded_data = move(encoded_data), on_complete = move(on_complete)] {
+        if (encoded_data.is_error()) {
+            on_complete({});
+            return;
+        }
+        on_complete(decode_image(encoded_data.value()));
+    });
+}
+
 }
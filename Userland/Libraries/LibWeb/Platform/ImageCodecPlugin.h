@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <AK/Function.h>
 #include <AK/RefPtr.h>
 #include <AK/Vector.h>
 #include <LibGfx/Forward.h>
@@ -32,6 +33,10 @@ public:
     virtual ~ImageCodecPlugin();
 
     virtual Optional<DecodedImage> decode_image(ReadonlyBytes) = 0;
+
+    // Decodes the image without blocking the caller, and calls on_complete from the event loop once done.
+    // Platforms that can't decode in the background fall back to decoding synchronously in a later event loop turn.
+    virtual void decode_image_async(ReadonlyBytes, Function<void(Optional<DecodedImage>)> on_complete);
 };
 
 }
@@ -376,6 +376,7 @@ JS::Value to_js_value(JS::VM& vm, Wasm::Value& wasm_value)
         return create_native_function(vm, wasm_value.to<Wasm::Reference::Func>().value().address, "FIXME_IHaveNoIdeaWhatThisShouldBeCalled");
     case Wasm::ValueType::NullFunctionReference:
         return JS::js_null();
+    case Wasm::ValueType::V128:
     case Wasm::ValueType::ExternReference:
     case Wasm::ValueType::NullExternReference:
         TODO();
@@ -424,6 +425,8 @@ JS::ThrowCompletionOr<Wasm::Value> to_webassembly_value(JS::VM& vm, JS::Value va
 
         return vm.throw_completion<JS::TypeError>(JS::ErrorType::NotAnObjectOfType, "Exported function");
     }
+    case Wasm::ValueType::V128:
+        return vm.throw_completion<JS::TypeError>("Cannot convert a javascript value to a vector value"sv);
     case Wasm::ValueType::ExternReference:
     case Wasm::ValueType::NullExternReference:
         TODO();
@@ -448,6 +451,12 @@ JS::NativeFunction* create_native_function(JS::VM& vm, Wasm::FunctionAddress add
             Vector<Wasm::Value> values;
             values.ensure_capacity(type.parameters().size());
 
+            // Vector values can't be passed to or returned from javascript.
+            for (auto& result_type : type.results()) {
+                if (result_type.kind() == Wasm::ValueType::V128)
+                    return vm.throw_completion<JS::TypeError>("Cannot convert a vector value to a javascript value"sv);
+            }
+
             // Grab as many values as needed and convert them.
             size_t index = 0;
             for (auto& type : type.parameters())
@@ -12,6 +12,7 @@
 #include <LibJS/Runtime/DataView.h>
 #include <LibJS/Runtime/PropertyKey.h>
 #include <LibJS/Runtime/TypedArray.h>
+#include <LibWeb/PhaseTimings.h>
 #include <LibWeb/WebIDL/AbstractOperations.h>
 
 namespace Web::WebIDL {
@@ -84,6 +85,8 @@ ErrorOr<ByteBuffer> get_buffer_source_copy(JS::Object const& buffer_source)
 // https://webidl.spec.whatwg.org/#invoke-a-callback-function
 JS::Completion invoke_callback(WebIDL::CallbackType& callback, Optional<JS::Value> this_argument, JS::MarkedVector<JS::Value> args)
 {
+    TemporaryPhaseTimer phase_timer(TimedPhase::JavaScript);
+
     // 1. Let completion be an uninitialized variable.
     JS::Completion completion;
 
@@ -13,6 +13,7 @@
 #include <LibJS/Runtime/FunctionObject.h>
 #include <LibWeb/Bindings/HostDefined.h>
 #include <LibWeb/HTML/Scripting/Environments.h>
+#include <LibWeb/PhaseTimings.h>
 #include <LibWeb/WebIDL/CallbackType.h>
 
 namespace Web::WebIDL {
@@ -47,6 +48,8 @@ inline JS::Completion clean_up_on_return(HTML::EnvironmentSettingsObject& stored
 template<typename... Args>
 JS::Completion call_user_object_operation(WebIDL::CallbackType& callback, DeprecatedString const& operation_name, Optional<JS::Value> this_argument, Args&&... args)
 {
+    TemporaryPhaseTimer phase_timer(TimedPhase::JavaScript);
+
     // 1. Let completion be an uninitialized variable.
     JS::Completion completion;
 
@@ -7,6 +7,8 @@
 #include "OutOfProcessWebView.h"
 #include "WebContentClient.h"
 #include <AK/DeprecatedString.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/SessionManagement.h>
 #include <LibFileSystemAccessClient/Client.h>
 #include <LibGUI/Application.h>
 #include <LibGUI/Desktop.h>
@@ -24,6 +26,50 @@ REGISTER_WIDGET(WebView, OutOfProcessWebView)
 
 namespace WebView {
 
+// Connecting to the WebContent portal makes SystemServer spawn a new WebContent process, which then has to set up
+// LibWeb and LibJS before it can do anything for us. We keep connections to a few such processes around, so that
+// new views don't have to wait for all of that.
+static constexpr size_t prewarmed_web_content_process_count = 1;
+static Vector<NonnullOwnPtr<Core::LocalSocket>> s_prewarmed_web_content_sockets;
+static bool s_prewarm_is_scheduled { false };
+
+static ErrorOr<NonnullOwnPtr<Core::LocalSocket>> connect_to_new_web_content_process()
+{
+    auto socket_path = TRY(Core::SessionManagement::parse_path_with_sid("/tmp/session/%sid/portal/webcontent"sv));
+    auto socket = TRY(Core::LocalSocket::connect(move(socket_path)));
+    TRY(socket->set_blocking(true));
+    return socket;
+}
+
+static void prewarm_web_content_processes()
+{
+    s_prewarm_is_scheduled = false;
+    while (s_prewarmed_web_content_sockets.size() < prewarmed_web_content_process_count) {
+        auto socket_or_error = connect_to_new_web_content_process();
+        if (socket_or_error.is_error()) {
+            dbgln("Unable to prewarm a WebContent process: {}", socket_or_error.error());
+            return;
+        }
+        s_prewarmed_web_content_sockets.append(socket_or_error.release_value());
+    }
+}
+
+static ErrorOr<NonnullOwnPtr<Core::LocalSocket>> take_web_content_process_connection()
+{
+    // NOTE: Refill the pool once we're back in the event loop, so the view we're creating now doesn't wait for it.
+    if (!s_prewarm_is_scheduled) {
+        s_prewarm_is_scheduled = true;
+        Core::deferred_invoke([] { prewarm_web_content_processes(); });
+    }
+
+    while (!s_prewarmed_web_content_sockets.is_empty()) {
+        auto socket = s_prewarmed_web_content_sockets.take_first();
+        if (socket->is_open())
+            return socket;
+    }
+    return connect_to_new_web_content_process();
+}
+
 OutOfProcessWebView::OutOfProcessWebView()
 {
     set_should_hide_unnecessary_scrollbars(true);
@@ -62,7 +108,8 @@ void OutOfProcessWebView::create_client()
 {
     m_client_state = {};
 
-    m_client_state.client = WebContentClient::try_create(*this).release_value_but_fixme_should_propagate_errors();
+    auto socket = take_web_content_process_connection().release_value_but_fixme_should_propagate_errors();
+    m_client_state.client = adopt_nonnull_ref_or_enomem(new (nothrow) WebContentClient(move(socket), *this)).release_value_but_fixme_should_propagate_errors();
     m_client_state.client->on_web_content_process_crash = [this] {
         deferred_invoke([this] {
             handle_web_content_process_crash();
@@ -764,6 +811,12 @@ void OutOfProcessWebView::notify_server_did_get_accessibility_tree(DeprecatedStr
         on_get_accessibility_tree(accessibility_tree);
 }
 
+void OutOfProcessWebView::notify_server_did_get_js_profile(DeprecatedString const& profile)
+{
+    if (on_get_js_profile)
+        on_get_js_profile(profile);
+}
+
 void OutOfProcessWebView::set_content_scales_to_viewport(bool b)
 {
     m_content_scales_to_viewport = b;
@@ -290,4 +290,9 @@ void WebContentClient::did_get_accessibility_tree(DeprecatedString const& access
     m_view.notify_server_did_get_accessibility_tree(accessibility_tree);
 }
 
+void WebContentClient::did_get_js_profile(DeprecatedString const& profile)
+{
+    m_view.notify_server_did_get_js_profile(profile);
+}
+
 }
@@ -611,7 +611,13 @@ ErrorOr<void, ParseError> Parser::parse_element()
     // element ::= EmptyElemTag
     //           | STag content ETag
     if (auto result = parse_empty_element_tag(); !result.is_error()) {
-        append_node(result.release_value());
+        auto node = result.release_value();
+        if (m_listener) {
+            enter_node(*node);
+            leave_node();
+        } else {
+            append_node(move(node));
+        }
         rollback.disarm();
         return {};
     }
@@ -619,7 +625,12 @@ ErrorOr<void, ParseError> Parser::parse_element()
     auto start_tag = TRY(parse_start_tag());
     auto& node = *start_tag;
     auto& tag = node.content.get<Node::Element>();
-    append_node(move(start_tag));
+    // A listener only needs to hear about the element, so it isn't added to a tree, and goes away once it's been left.
+    OwnPtr<Node> listened_node;
+    if (m_listener)
+        listened_node = move(start_tag);
+    else
+        append_node(move(start_tag));
     enter_node(node);
     ScopeGuard quit {
         [&] {
@@ -62,6 +62,7 @@ public:
     }
 
     ErrorOr<Document, ParseError> parse();
+    // Tells the listener about the document as it's being parsed, without building a Document out of it first.
     ErrorOr<void, ParseError> parse_with_listener(Listener&);
 
     Vector<ParseError> const& parse_error_causes() const { return m_parse_errors; }
@@ -8,7 +8,6 @@
 #include "Mixer.h"
 #include <AK/Array.h>
 #include <AK/Format.h>
-#include <AK/MemoryStream.h>
 #include <AK/NumericLimits.h>
 #include <AudioServer/ConnectionFromClient.h>
 #include <AudioServer/Mixer.h>
@@ -20,6 +19,12 @@
 
 namespace AudioServer {
 
+static size_t hardware_buffer_size(Core::ConfigFile const& config)
+{
+    auto buffer_size = config.read_num_entry("Master", "BufferSize", DEFAULT_HARDWARE_BUFFER_SIZE);
+    return clamp(buffer_size, MINIMUM_HARDWARE_BUFFER_SIZE, MAXIMUM_HARDWARE_BUFFER_SIZE);
+}
+
 Mixer::Mixer(NonnullRefPtr<Core::ConfigFile> config)
     // FIXME: Allow AudioServer to use other audio channels as well
     : m_device(Core::DeprecatedFile::construct("/dev/audio/0", this))
@@ -30,6 +35,8 @@ Mixer::Mixer(NonnullRefPtr<Core::ConfigFile> config)
           },
           "AudioServer[mixer]"sv))
     , m_config(move(config))
+    , m_mixed_buffer(MUST(FixedArray<Audio::Sample>::create(hardware_buffer_size(m_config))))
+    , m_stream_buffer(MUST(FixedArray<LittleEndian<i16>>::create(m_mixed_buffer.size() * 2)))
 {
     if (!m_device->open(Core::OpenMode::WriteOnly)) {
         dbgln("Can't open audio device: {}", m_device->error_string());
@@ -48,6 +55,7 @@ NonnullRefPtr<ClientAudioStream> Mixer::create_queue(ConnectionFromClient& clien
     {
         Threading::MutexLocker const locker(m_pending_mutex);
         m_pending_mixing.append(*queue);
+        m_has_pending_mixing.store(true, AK::MemoryOrder::memory_order_release);
     }
     // Signal the mixer thread to start back up, in case nobody was connected before.
     m_mixing_necessary.signal();
@@ -55,12 +63,18 @@ NonnullRefPtr<ClientAudioStream> Mixer::create_queue(ConnectionFromClient& clien
     return queue;
 }
 
+// The volume curve is the same for all samples of a buffer, so it only has to be evaluated once per buffer.
+static float log_volume_factor(double volume)
+{
+    return Audio::Sample {}.linear_to_log(static_cast<float>(volume));
+}
+
 void Mixer::mix()
 {
     decltype(m_pending_mixing) active_mix_queues;
 
     for (;;) {
-        {
+        if (active_mix_queues.is_empty() || m_has_pending_mixing.load(AK::MemoryOrder::memory_order_acquire)) {
             Threading::MutexLocker const locker(m_pending_mutex);
             // While we have nothing to mix, wait on the condition.
             m_mixing_necessary.wait_while([this, &active_mix_queues]() { return m_pending_mixing.is_empty() && active_mix_queues.is_empty(); });
@@ -68,15 +82,17 @@ void Mixer::mix()
                 active_mix_queues.extend(move(m_pending_mixing));
                 m_pending_mixing.clear();
             }
+            m_has_pending_mixing.store(false, AK::MemoryOrder::memory_order_relaxed);
         }
 
         active_mix_queues.remove_all_matching([&](auto& entry) { return !entry->is_connected(); });
 
-        Array<Audio::Sample, HARDWARE_BUFFER_SIZE> mixed_buffer;
+        m_mixed_buffer.fill_with({});
 
         m_main_volume.advance_time();
 
         // Mix the buffers together into the output
+        auto headroom_factor = log_volume_factor(SAMPLE_HEADROOM);
         for (auto& queue : active_mix_queues) {
             if (!queue->client()) {
                 queue->clear();
@@ -84,40 +100,24 @@ void Mixer::mix()
             }
             queue->volume().advance_time();
 
-            for (auto& mixed_sample : mixed_buffer) {
-                Audio::Sample sample;
-                if (!queue->get_next_sample(sample))
-                    break;
-                if (queue->is_muted())
-                    continue;
-                sample.log_multiply(SAMPLE_HEADROOM);
-                sample.log_multiply(static_cast<float>(queue->volume()));
-                mixed_sample += sample;
-            }
+            auto gain = queue->is_muted() ? 0.0f : headroom_factor * log_volume_factor(queue->volume());
+            queue->mix_into(m_mixed_buffer.span(), gain);
         }
 
         // Even though it's not realistic, the user expects no sound at 0%.
         if (m_muted || m_main_volume < 0.01) {
-            m_device->write(m_zero_filled_buffer.data(), static_cast<int>(m_zero_filled_buffer.size()));
+            m_stream_buffer.fill_with(0);
         } else {
-            FixedMemoryStream stream { m_stream_buffer.span() };
-
-            for (auto& mixed_sample : mixed_buffer) {
-                mixed_sample.log_multiply(static_cast<float>(m_main_volume));
+            auto main_volume_factor = log_volume_factor(m_main_volume);
+            for (size_t i = 0; i < m_mixed_buffer.size(); ++i) {
+                auto mixed_sample = m_mixed_buffer[i] * main_volume_factor;
                 mixed_sample.clip();
-
-                LittleEndian<i16> out_sample;
-                out_sample = static_cast<i16>(mixed_sample.left * NumericLimits<i16>::max());
-                MUST(stream.write_value(out_sample));
-
-                out_sample = static_cast<i16>(mixed_sample.right * NumericLimits<i16>::max());
-                MUST(stream.write_value(out_sample));
+                m_stream_buffer[i * 2] = static_cast<i16>(mixed_sample.left * NumericLimits<i16>::max());
+                m_stream_buffer[i * 2 + 1] = static_cast<i16>(mixed_sample.right * NumericLimits<i16>::max());
             }
-
-            auto buffered_bytes = MUST(stream.tell());
-            VERIFY(buffered_bytes == m_stream_buffer.size());
-            m_device->write(m_stream_buffer.data(), static_cast<int>(buffered_bytes));
         }
+
+        m_device->write(reinterpret_cast<u8 const*>(m_stream_buffer.data()), static_cast<int>(m_stream_buffer.size() * sizeof(i16)));
     }
 }
 
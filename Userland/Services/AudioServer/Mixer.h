@@ -12,6 +12,8 @@
 #include <AK/Atomic.h>
 #include <AK/Badge.h>
 #include <AK/ByteBuffer.h>
+#include <AK/Endian.h>
+#include <AK/FixedArray.h>
 #include <AK/NonnullRefPtrVector.h>
 #include <AK/Queue.h>
 #include <AK/RefCounted.h>
@@ -29,9 +31,11 @@ namespace AudioServer {
 // This is to prevent clipping when two streams with low headroom (e.g. normalized & compressed) are playing.
 constexpr double SAMPLE_HEADROOM = 0.95;
 // The size of the buffer in samples that the hardware receives through write() calls to the audio device.
-constexpr size_t HARDWARE_BUFFER_SIZE = 512;
-// The hardware buffer size in bytes; there's two channels of 16-bit samples.
-constexpr size_t HARDWARE_BUFFER_SIZE_BYTES = HARDWARE_BUFFER_SIZE * 2 * sizeof(i16);
+// This can be changed with the Master/BufferSize setting; smaller buffers lower the latency, but need the mixer to be
+// scheduled more often to avoid dropouts.
+constexpr size_t DEFAULT_HARDWARE_BUFFER_SIZE = 512;
+constexpr size_t MINIMUM_HARDWARE_BUFFER_SIZE = 64;
+constexpr size_t MAXIMUM_HARDWARE_BUFFER_SIZE = 4096;
 
 class ConnectionFromClient;
 
@@ -40,32 +44,28 @@ public:
     explicit ClientAudioStream(ConnectionFromClient&);
     ~ClientAudioStream() = default;
 
-    bool get_next_sample(Audio::Sample& sample)
+    // Adds the next samples of this stream, scaled by the given gain, to the output. If the stream runs out of samples,
+    // the rest of the output is left as it is.
+    void mix_into(Span<Audio::Sample> output, float gain)
     {
         if (m_paused)
-            return false;
-
-        if (m_in_chunk_location >= m_current_audio_chunk.size()) {
-            auto result = m_buffer->dequeue();
-            if (result.is_error()) {
-                if (result.error() == Audio::AudioQueue::QueueStatus::Empty) {
-                    dbgln("Audio client {} can't keep up!", m_client->client_id());
-                    // Note: Even though we only check client state here, we will probably close the client much earlier.
-                    if (!m_client->is_open()) {
-                        dbgln("Client socket {} has closed, closing audio server connection.", m_client->client_id());
-                        m_client->shutdown();
-                    }
-                }
-
-                return false;
+            return;
+
+        while (!output.is_empty()) {
+            if (m_in_chunk_location >= m_current_audio_chunk.size() && !dequeue_next_chunk())
+                return;
+
+            auto count = min(output.size(), m_current_audio_chunk.size() - m_in_chunk_location);
+            auto const* input = m_current_audio_chunk.data() + m_in_chunk_location;
+            // Muted streams still have to be consumed to keep their timing.
+            if (gain != 0.0f) {
+                for (size_t i = 0; i < count; ++i)
+                    output[i] += input[i] * gain;
             }
-            m_current_audio_chunk = result.release_value();
-            m_in_chunk_location = 0;
-        }
 
-        sample = m_current_audio_chunk[m_in_chunk_location++];
-
-        return true;
+            m_in_chunk_location += count;
+            output = output.slice(count);
+        }
     }
 
     bool is_connected() const { return m_client && m_client->is_open(); }
@@ -91,6 +91,26 @@ public:
     void set_muted(bool muted) { m_muted = muted; }
 
 private:
+    bool dequeue_next_chunk()
+    {
+        auto result = m_buffer->dequeue();
+        if (result.is_error()) {
+            if (result.error() == Audio::AudioQueue::QueueStatus::Empty) {
+                dbgln("Audio client {} can't keep up!", m_client->client_id());
+                // Note: Even though we only check client state here, we will probably close the client much earlier.
+                if (!m_client->is_open()) {
+                    dbgln("Client socket {} has closed, closing audio server connection.", m_client->client_id());
+                    m_client->shutdown();
+                }
+            }
+
+            return false;
+        }
+        m_current_audio_chunk = result.release_value();
+        m_in_chunk_location = 0;
+        return true;
+    }
+
     OwnPtr<Audio::AudioQueue> m_buffer;
     Array<Audio::Sample, Audio::AUDIO_BUFFER_SIZE> m_current_audio_chunk;
     size_t m_in_chunk_location;
@@ -125,6 +145,9 @@ private:
     void request_setting_sync();
 
     Vector<NonnullRefPtr<ClientAudioStream>> m_pending_mixing;
+    // Set whenever m_pending_mixing has new entries, so that the mixer thread only needs to take the lock when there's
+    // something to pick up or when it's going to sleep.
+    Atomic<bool> m_has_pending_mixing { false };
     Threading::Mutex m_pending_mutex;
     Threading::ConditionVariable m_mixing_necessary { m_pending_mutex };
 
@@ -138,8 +161,9 @@ private:
     NonnullRefPtr<Core::ConfigFile> m_config;
     RefPtr<Core::Timer> m_config_write_timer;
 
-    Array<u8, HARDWARE_BUFFER_SIZE_BYTES> m_stream_buffer;
-    Array<u8, HARDWARE_BUFFER_SIZE_BYTES> const m_zero_filled_buffer {};
+    FixedArray<Audio::Sample> m_mixed_buffer;
+    // There's two channels of 16-bit samples.
+    FixedArray<LittleEndian<i16>> m_stream_buffer;
 
     void mix();
 };
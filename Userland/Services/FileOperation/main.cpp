@@ -233,8 +233,33 @@ ErrorOr<int> execute_work_items(Vector<WorkItem> const& items)
             auto source_file = TRY(Core::File::open(source, Core::File::OpenMode::Read));
             // FIXME: When the file already exists, let the user choose the next action instead of renaming it by default.
             auto destination_file = TRY(open_destination_file(destination));
-            auto buffer = TRY(ByteBuffer::create_zeroed(64 * KiB));
 
+            // Let the kernel copy the data without it passing through here, in chunks that are small enough to keep the
+            // progress moving. If it can't copy these files, we copy whatever is left ourselves.
+            while (true) {
+                print_progress();
+                auto copied_or_error = Core::System::copy_file_range(source_file->fd(), nullptr, destination_file->fd(), nullptr, 1 * MiB);
+                if (copied_or_error.is_error()) {
+                    auto code = copied_or_error.error().code();
+                    if (code != ENOTSUP && code != ENOSYS && code != EINVAL && code != EXDEV && code != EBADF) {
+                        // FIXME: Return the formatted string directly. There is no way to do this right now without the temporary going out of scope and being destroyed.
+                        report_warning(DeprecatedString::formatted("Failed to write to destination file: {}", copied_or_error.error()));
+                        return copied_or_error.release_error();
+                    }
+                    break;
+                }
+                auto copied = copied_or_error.release_value();
+                if (copied == 0)
+                    break;
+                item_done += copied;
+                executed_work_bytes += copied;
+                // FIXME: Remove this once the kernel is smart enough to schedule other threads
+                //        while we're doing heavy I/O. Right now, copying a large file will totally
+                //        starve the rest of the system.
+                sched_yield();
+            }
+
+            auto buffer = TRY(ByteBuffer::create_zeroed(64 * KiB));
             while (true) {
                 print_progress();
                 auto bytes_read = TRY(source_file->read(buffer.bytes()));
@@ -6,9 +6,11 @@
 
 #include <AK/Debug.h>
 #include <ImageDecoder/ConnectionFromClient.h>
+#include <ImageDecoder/DecodedImageCache.h>
 #include <ImageDecoder/ImageDecoderClientEndpoint.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/ImageDecoder.h>
+#include <LibThreading/BackgroundAction.h>
 
 namespace ImageDecoder {
 
@@ -24,8 +26,8 @@ void ConnectionFromClient::die()
 
 static void decode_image_to_bitmaps_and_durations_with_decoder(Gfx::ImageDecoder const& decoder, Vector<Gfx::ShareableBitmap>& bitmaps, Vector<u32>& durations)
 {
-    for (size_t i = 0; i < decoder.frame_count(); ++i) {
-        auto frame_or_error = decoder.frame(i);
+    // Every frame is copied into shared memory right away, so the decoder doesn't need to make a copy of its own.
+    decoder.for_each_frame([&](size_t, ErrorOr<Gfx::ImageFrameDescriptor> frame_or_error) {
         if (frame_or_error.is_error()) {
             bitmaps.append(Gfx::ShareableBitmap {});
             durations.append(0);
@@ -34,27 +36,32 @@ static void decode_image_to_bitmaps_and_durations_with_decoder(Gfx::ImageDecoder
             bitmaps.append(frame.image->to_shareable_bitmap());
             durations.append(frame.duration);
         }
-    }
+        return IterationDecision::Continue;
+    });
 }
 
-static void decode_image_to_details(Core::AnonymousBuffer const& encoded_buffer, Optional<DeprecatedString> const& known_mime_type, bool& is_animated, u32& loop_count, Vector<Gfx::ShareableBitmap>& bitmaps, Vector<u32>& durations)
+// NOTE: This runs on the thread pool for asynchronous requests, so it must not touch anything that's shared.
+static DecodedImage decode_image_to_details(ReadonlyBytes encoded_data, Optional<DeprecatedString> const& known_mime_type)
 {
-    VERIFY(bitmaps.size() == 0);
-    VERIFY(durations.size() == 0);
+    DecodedImage image;
 
-    auto decoder = Gfx::ImageDecoder::try_create_for_raw_bytes(ReadonlyBytes { encoded_buffer.data<u8>(), encoded_buffer.size() }, known_mime_type);
+    auto decoder = Gfx::ImageDecoder::try_create_for_raw_bytes(encoded_data, known_mime_type);
     if (!decoder) {
         dbgln_if(IMAGE_DECODER_DEBUG, "Could not find suitable image decoder plugin for data");
-        return;
+        return image;
     }
 
+    // The bitmaps are displayed as they are, i.e. as sRGB.
+    decoder->set_convert_to_sRGB(true);
+
     if (!decoder->frame_count()) {
         dbgln_if(IMAGE_DECODER_DEBUG, "Could not decode image from encoded data");
-        return;
+        return image;
     }
-    is_animated = decoder->is_animated();
-    loop_count = decoder->loop_count();
-    decode_image_to_bitmaps_and_durations_with_decoder(*decoder, bitmaps, durations);
+    image.is_animated = decoder->is_animated();
+    image.loop_count = decoder->loop_count();
+    decode_image_to_bitmaps_and_durations_with_decoder(*decoder, image.bitmaps, image.durations);
+    return image;
 }
 
 Messages::ImageDecoderServer::DecodeImageResponse ConnectionFromClient::decode_image(Core::AnonymousBuffer const& encoded_buffer, Optional<DeprecatedString> const& mime_type)
@@ -64,12 +71,42 @@ Messages::ImageDecoderServer::DecodeImageResponse ConnectionFromClient::decode_i
         return nullptr;
     }
 
-    bool is_animated = false;
-    u32 loop_count = 0;
-    Vector<Gfx::ShareableBitmap> bitmaps;
-    Vector<u32> durations;
-    decode_image_to_details(encoded_buffer, mime_type, is_animated, loop_count, bitmaps, durations);
-    return { is_animated, loop_count, bitmaps, durations };
+    auto encoded_data = ReadonlyBytes { encoded_buffer.data<u8>(), encoded_buffer.size() };
+    auto cache_key = DecodedImageCache::key_for(encoded_data, mime_type);
+    auto image = DecodedImageCache::the().get(cache_key);
+    if (!image.has_value()) {
+        image = decode_image_to_details(encoded_data, mime_type);
+        DecodedImageCache::the().set(move(cache_key), *image);
+    }
+    return { image->is_animated, image->loop_count, move(image->bitmaps), move(image->durations) };
+}
+
+void ConnectionFromClient::decode_image_async(i64 request_id, Core::AnonymousBuffer const& encoded_buffer, Optional<DeprecatedString> const& mime_type)
+{
+    if (!encoded_buffer.is_valid()) {
+        dbgln_if(IMAGE_DECODER_DEBUG, "Encoded data is invalid");
+        async_did_decode_image(request_id, false, 0, {}, {});
+        return;
+    }
+
+    auto cache_key = DecodedImageCache::key_for({ encoded_buffer.data<u8>(), encoded_buffer.size() }, mime_type);
+    if (auto image = DecodedImageCache::the().get(cache_key); image.has_value()) {
+        async_did_decode_image(request_id, image->is_animated, image->loop_count, move(image->bitmaps), move(image->durations));
+        return;
+    }
+
+    // Decode on the thread pool, so that requests don't have to wait for the ones before them to be done. The results
+    // are sent back from the main thread, in whatever order they finish in.
+    (void)Threading::BackgroundAction<DecodedImage>::construct(
+        [encoded_buffer, mime_type](auto&) {
+            return decode_image_to_details({ encoded_buffer.data<u8>(), encoded_buffer.size() }, mime_type);
+        },
+        [strong_this = NonnullRefPtr(*this), request_id, cache_key = move(cache_key)](DecodedImage image) mutable -> ErrorOr<void> {
+            DecodedImageCache::the().set(move(cache_key), image);
+            if (strong_this->is_open())
+                strong_this->async_did_decode_image(request_id, image.is_animated, image.loop_count, move(image.bitmaps), move(image.durations));
+            return {};
+        });
 }
 
 }
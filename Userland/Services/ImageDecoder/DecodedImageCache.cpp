@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Hex.h>
+#include <ImageDecoder/DecodedImageCache.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <LibGfx/Bitmap.h>
+
+namespace ImageDecoder {
+
+DecodedImageCache& DecodedImageCache::the()
+{
+    static DecodedImageCache s_the;
+    return s_the;
+}
+
+DeprecatedString DecodedImageCache::key_for(ReadonlyBytes encoded_data, Optional<DeprecatedString> const& mime_type)
+{
+    // The MIME type is only a hint for picking a decoder, but a different decoder could still decode the same data
+    // differently.
+    auto digest = Crypto::Hash::SHA256::hash(encoded_data.data(), encoded_data.size());
+    return DeprecatedString::formatted("{}:{}", encode_hex(digest.bytes()), mime_type.value_or(""));
+}
+
+Optional<DecodedImage> DecodedImageCache::get(DeprecatedString const& key)
+{
+    auto it = m_entries.find(key);
+    if (it == m_entries.end())
+        return {};
+    it->value.last_used = ++m_use_counter;
+    return it->value.image;
+}
+
+void DecodedImageCache::set(DeprecatedString key, DecodedImage const& image)
+{
+    size_t size_in_bytes = 0;
+    for (auto const& bitmap : image.bitmaps) {
+        if (bitmap.is_valid())
+            size_in_bytes += bitmap.bitmap()->size_in_bytes();
+    }
+    if (size_in_bytes > max_size_in_bytes)
+        return;
+
+    if (auto it = m_entries.find(key); it != m_entries.end()) {
+        m_size_in_bytes -= it->value.size_in_bytes;
+        m_entries.remove(it);
+    }
+    while (m_size_in_bytes + size_in_bytes > max_size_in_bytes)
+        evict_least_recently_used();
+
+    m_entries.set(move(key), Entry { image, size_in_bytes, ++m_use_counter });
+    m_size_in_bytes += size_in_bytes;
+}
+
+void DecodedImageCache::evict_least_recently_used()
+{
+    VERIFY(!m_entries.is_empty());
+    auto least_recently_used = m_entries.begin();
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+        if (it->value.last_used < least_recently_used->value.last_used)
+            least_recently_used = it;
+    }
+    m_size_in_bytes -= least_recently_used->value.size_in_bytes;
+    m_entries.remove(least_recently_used);
+}
+
+}
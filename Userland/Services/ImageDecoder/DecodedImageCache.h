@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/DeprecatedString.h>
+#include <AK/HashMap.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+#include <LibGfx/ShareableBitmap.h>
+
+namespace ImageDecoder {
+
+struct DecodedImage {
+    bool is_animated { false };
+    u32 loop_count { 0 };
+    Vector<Gfx::ShareableBitmap> bitmaps;
+    Vector<u32> durations;
+};
+
+// Recently decoded images, looked up by a hash of their encoded data, so that an image that's asked for again (like
+// an icon that's on every page of a site) doesn't have to be decoded again.
+// NOTE: Reference counting of the bitmaps isn't thread-safe, so this must only be used from the main thread.
+class DecodedImageCache {
+public:
+    static DecodedImageCache& the();
+
+    static DeprecatedString key_for(ReadonlyBytes encoded_data, Optional<DeprecatedString> const& mime_type);
+
+    Optional<DecodedImage> get(DeprecatedString const& key);
+    void set(DeprecatedString key, DecodedImage const&);
+
+private:
+    static constexpr size_t max_size_in_bytes = 32 * MiB;
+
+    struct Entry {
+        DecodedImage image;
+        size_t size_in_bytes { 0 };
+        u64 last_used { 0 };
+    };
+
+    void evict_least_recently_used();
+
+    HashMap<DeprecatedString, Entry> m_entries;
+    size_t m_size_in_bytes { 0 };
+    u64 m_use_counter { 0 };
+};
+
+}
@@ -6,17 +6,22 @@
 
 #include "LookupServer.h"
 #include "ConnectionFromClient.h"
+#include <AK/AnyOf.h>
 #include <AK/Debug.h>
 #include <AK/DeprecatedString.h>
 #include <AK/HashMap.h>
 #include <AK/Random.h>
+#include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
 #include <LibCore/ConfigFile.h>
 #include <LibCore/DeprecatedFile.h>
 #include <LibCore/LocalServer.h>
+#include <LibCore/System.h>
 #include <LibDNS/Packet.h>
 #include <limits.h>
+#include <netinet/in.h>
 #include <stdio.h>
+#include <sys/socket.h>
 #include <time.h>
 #include <unistd.h>
 
@@ -25,6 +30,10 @@ namespace LookupServer {
 static LookupServer* s_the;
 // NOTE: This is the TTL we return for the hostname or answers from /etc/hosts.
 static constexpr u32 s_static_ttl = 86400;
+// RFC2308 section 5 recommends not keeping negative answers around for longer than a few hours.
+static constexpr u32 s_maximum_negative_ttl = 3 * 3600;
+// How often a query is sent to each nameserver, waiting a second for a response every time.
+static constexpr int s_upstream_attempts = 3;
 
 LookupServer& LookupServer::the()
 {
@@ -177,11 +186,26 @@ ErrorOr<Vector<Answer>> LookupServer::lookup(Name const& name, RecordType record
                 add_answer(answer);
             }
         }
-        if (!answers.is_empty())
+        if (!answers.is_empty()) {
+            if (should_prefetch(name, record_type)) {
+                deferred_invoke([this, name, record_type] {
+                    if (!should_prefetch(name, record_type))
+                        return;
+                    dbgln_if(LOOKUPSERVER_DEBUG, "Refreshing '{}' before it expires", name.as_string());
+                    (void)lookup_upstream(name, record_type);
+                });
+            }
             return answers;
+        }
+    }
+
+    // Fourth, see if we recently learned that there is no such record.
+    if (is_negatively_cached(name, record_type)) {
+        dbgln_if(LOOKUPSERVER_DEBUG, "Negative cache hit: {}", name.as_string());
+        return Vector<Answer> {};
     }
 
-    // Fourth, look up .local names using mDNS instead of DNS nameservers.
+    // Fifth, look up .local names using mDNS instead of DNS nameservers.
     if (name.as_string().ends_with(".local"sv)) {
         answers = TRY(m_mdns->lookup(name, record_type));
         for (auto& answer : answers)
@@ -189,90 +213,63 @@ ErrorOr<Vector<Answer>> LookupServer::lookup(Name const& name, RecordType record
         return answers;
     }
 
-    // Fifth, ask the upstream nameservers.
-    for (auto& nameserver : m_nameservers) {
-        dbgln_if(LOOKUPSERVER_DEBUG, "Doing lookup using nameserver '{}'", nameserver);
-        bool did_get_response = false;
-        int retries = 3;
-        Vector<Answer> upstream_answers;
-        do {
-            auto upstream_answers_or_error = lookup(name, nameserver, did_get_response, record_type);
-            if (upstream_answers_or_error.is_error())
-                continue;
-            upstream_answers = upstream_answers_or_error.release_value();
-            if (did_get_response)
-                break;
-        } while (--retries);
-        if (!upstream_answers.is_empty()) {
-            for (auto& answer : upstream_answers)
-                add_answer(answer);
-            break;
-        } else {
-            if (!did_get_response)
-                dbgln("Never got a response from '{}', trying next nameserver", nameserver);
-            else
-                dbgln("Received response from '{}' but no result(s), trying next nameserver", nameserver);
-        }
-    }
-
-    // Sixth, fail.
-    if (answers.is_empty()) {
-        dbgln("Tried all nameservers but never got a response :(");
-        return Vector<Answer> {};
-    }
+    // Sixth, ask the upstream nameservers.
+    for (auto& answer : TRY(lookup_upstream(name, record_type)))
+        add_answer(answer);
 
     return answers;
 }
 
-ErrorOr<Vector<Answer>> LookupServer::lookup(Name const& name, DeprecatedString const& nameserver, bool& did_get_response, RecordType record_type, ShouldRandomizeCase should_randomize_case)
+// One query to one nameserver, on a socket of its own.
+struct UpstreamQuery {
+    DeprecatedString const& nameserver;
+    int fd { -1 };
+    Packet request {};
+    ShouldRandomizeCase should_randomize_case { ShouldRandomizeCase::Yes };
+    bool is_done { false };
+};
+
+static ErrorOr<int> connect_to_nameserver(DeprecatedString const& nameserver)
+{
+    auto address = IPv4Address::from_string(nameserver);
+    if (!address.has_value())
+        return Error::from_string_literal("Nameserver is not an IPv4 address");
+
+    auto fd = TRY(Core::System::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0));
+    sockaddr_in socket_address {};
+    socket_address.sin_family = AF_INET;
+    socket_address.sin_port = htons(53);
+    socket_address.sin_addr.s_addr = address->to_in_addr_t();
+    if (auto result = Core::System::connect(fd, (sockaddr const*)&socket_address, sizeof(socket_address)); result.is_error()) {
+        (void)Core::System::close(fd);
+        return result.release_error();
+    }
+    return fd;
+}
+
+static ErrorOr<void> send_query(UpstreamQuery& query, Name const& name, RecordType record_type)
 {
-    Packet request;
-    request.set_is_query();
-    request.set_id(get_random_uniform(UINT16_MAX));
+    query.request = {};
+    query.request.set_is_query();
+    query.request.set_id(get_random_uniform(UINT16_MAX));
     Name name_in_question = name;
-    if (should_randomize_case == ShouldRandomizeCase::Yes)
+    if (query.should_randomize_case == ShouldRandomizeCase::Yes)
         name_in_question.randomize_case();
-    request.add_question({ name_in_question, record_type, RecordClass::IN, false });
+    query.request.add_question({ name_in_question, record_type, RecordClass::IN, false });
 
-    auto buffer = TRY(request.to_byte_buffer());
-
-    auto udp_socket = TRY(Core::UDPSocket::connect(nameserver, 53, Time::from_seconds(1)));
-    TRY(udp_socket->set_blocking(true));
-
-    TRY(udp_socket->write(buffer));
-
-    u8 response_buffer[4096];
-    int nrecv = TRY(udp_socket->read({ response_buffer, sizeof(response_buffer) })).size();
-    if (udp_socket->is_eof())
-        return Vector<Answer> {};
-
-    did_get_response = true;
-
-    auto o_response = Packet::from_raw_packet(response_buffer, nrecv);
-    if (!o_response.has_value())
-        return Vector<Answer> {};
-
-    auto& response = o_response.value();
-
-    if (response.id() != request.id()) {
-        dbgln("LookupServer: ID mismatch ({} vs {}) :(", response.id(), request.id());
-        return Vector<Answer> {};
-    }
-
-    if (response.code() == Packet::Code::REFUSED) {
-        if (should_randomize_case == ShouldRandomizeCase::Yes) {
-            // Retry with 0x20 case randomization turned off.
-            return lookup(name, nameserver, did_get_response, record_type, ShouldRandomizeCase::No);
-        }
-        return Vector<Answer> {};
-    }
+    auto buffer = TRY(query.request.to_byte_buffer());
+    TRY(Core::System::send(query.fd, buffer.data(), buffer.size(), 0));
+    return {};
+}
 
+// Verify the questions in our request and in their response match, ignoring case.
+static bool response_matches_request(Packet const& request, Packet const& response)
+{
     if (response.question_count() != request.question_count()) {
         dbgln("LookupServer: Question count ({} vs {}) :(", response.question_count(), request.question_count());
-        return Vector<Answer> {};
+        return false;
     }
 
-    // Verify the questions in our request and in their response match, ignoring case.
     for (size_t i = 0; i < request.question_count(); ++i) {
         auto& request_question = request.questions()[i];
         auto& response_question = response.questions()[i];
@@ -283,24 +280,139 @@ ErrorOr<Vector<Answer>> LookupServer::lookup(Name const& name, DeprecatedString
             dbgln("Request and response questions do not match");
             dbgln("   Request: name=_{}_, type={}, class={}", request_question.name().as_string(), response_question.record_type(), response_question.class_code());
             dbgln("  Response: name=_{}_, type={}, class={}", response_question.name().as_string(), response_question.record_type(), response_question.class_code());
-            return Vector<Answer> {};
+            return false;
         }
     }
+    return true;
+}
 
-    if (response.answer_count() < 1) {
-        dbgln("LookupServer: No answers :(");
-        return Vector<Answer> {};
+// A negative answer may be cached for as long as the SOA record in its authority section, or the MINIMUM field of
+// that SOA record if it's lower. Without a SOA record, it shouldn't be cached at all (RFC2308 section 5).
+static u32 negative_caching_ttl(Packet const& response)
+{
+    for (auto& record : response.authority_records()) {
+        // MINIMUM is the last of the five 32-bit fields that end the record data.
+        if (record.type() != RecordType::SOA || record.record_data().length() < 20)
+            continue;
+        auto minimum_bytes = record.record_data().bytes().slice(record.record_data().length() - 4);
+        u32 minimum = (minimum_bytes[0] << 24) | (minimum_bytes[1] << 16) | (minimum_bytes[2] << 8) | minimum_bytes[3];
+        return min(min(record.ttl(), minimum), s_maximum_negative_ttl);
     }
+    return 0;
+}
+
+// All nameservers are asked at once, and the first one to answer wins. That way, a slow or unreachable nameserver
+// doesn't hold up the others.
+ErrorOr<Vector<Answer>> LookupServer::lookup_upstream(Name const& name, RecordType record_type)
+{
+    Vector<UpstreamQuery> queries;
+    ScopeGuard close_sockets = [&] {
+        for (auto& query : queries)
+            (void)Core::System::close(query.fd);
+    };
 
-    Vector<Answer, 8> answers;
-    for (auto& answer : response.answers()) {
-        put_in_cache(answer);
-        if (answer.type() != record_type)
+    for (auto& nameserver : m_nameservers) {
+        auto fd_or_error = connect_to_nameserver(nameserver);
+        if (fd_or_error.is_error()) {
+            dbgln("LookupServer: Can't use nameserver '{}': {}", nameserver, fd_or_error.error());
             continue;
-        answers.append(answer);
+        }
+        queries.append({ nameserver, fd_or_error.release_value() });
     }
 
-    return answers;
+    Vector<pollfd> poll_fds;
+    Vector<UpstreamQuery&> polled_queries;
+    for (int attempt = 0; attempt < s_upstream_attempts; ++attempt) {
+        for (auto& query : queries) {
+            if (query.is_done)
+                continue;
+            if (attempt > 0)
+                dbgln("Never got a response from '{}', asking again", query.nameserver);
+            if (auto result = send_query(query, name, record_type); result.is_error()) {
+                dbgln("LookupServer: Failed to send query to '{}': {}", query.nameserver, result.error());
+                query.is_done = true;
+            }
+        }
+
+        auto deadline = Time::now_monotonic() + Time::from_seconds(1);
+        while (true) {
+            poll_fds.clear_with_capacity();
+            polled_queries.clear_with_capacity();
+            for (auto& query : queries) {
+                if (query.is_done)
+                    continue;
+                poll_fds.append({ query.fd, POLLIN, 0 });
+                polled_queries.append(query);
+            }
+            auto timeout = (deadline - Time::now_monotonic()).to_milliseconds();
+            if (poll_fds.is_empty() || timeout <= 0 || TRY(Core::System::poll(poll_fds, timeout)) == 0)
+                break;
+
+            for (size_t i = 0; i < poll_fds.size(); ++i) {
+                if (poll_fds[i].revents == 0)
+                    continue;
+                auto& query = polled_queries[i];
+
+                u8 response_buffer[4096];
+                auto nrecv_or_error = Core::System::recv(query.fd, response_buffer, sizeof(response_buffer), 0);
+                if (nrecv_or_error.is_error()) {
+                    dbgln("LookupServer: Failed to receive response from '{}': {}", query.nameserver, nrecv_or_error.error());
+                    query.is_done = true;
+                    continue;
+                }
+
+                auto maybe_response = Packet::from_raw_packet(response_buffer, nrecv_or_error.value());
+                if (!maybe_response.has_value()) {
+                    query.is_done = true;
+                    continue;
+                }
+                auto& response = maybe_response.value();
+
+                // This may be a late response to an earlier attempt, so keep waiting for the response to this one.
+                if (response.id() != query.request.id()) {
+                    dbgln("LookupServer: ID mismatch ({} vs {}) :(", response.id(), query.request.id());
+                    continue;
+                }
+
+                if (response.code() == Packet::Code::REFUSED && query.should_randomize_case == ShouldRandomizeCase::Yes) {
+                    // Retry with 0x20 case randomization turned off.
+                    query.should_randomize_case = ShouldRandomizeCase::No;
+                    if (send_query(query, name, record_type).is_error())
+                        query.is_done = true;
+                    continue;
+                }
+
+                if ((response.code() != Packet::Code::NOERROR && response.code() != Packet::Code::NXDOMAIN) || !response_matches_request(query.request, response)) {
+                    dbgln("Received unusable response from '{}', waiting for the other nameservers", query.nameserver);
+                    query.is_done = true;
+                    continue;
+                }
+
+                if (response.code() == Packet::Code::NXDOMAIN || response.answer_count() == 0) {
+                    dbgln_if(LOOKUPSERVER_DEBUG, "'{}' says there is no {} record for '{}'", query.nameserver, record_type, name.as_string());
+                    Optional<RecordType> negative_record_type;
+                    if (response.code() != Packet::Code::NXDOMAIN)
+                        negative_record_type = record_type;
+                    put_in_negative_cache(name, negative_record_type, negative_caching_ttl(response));
+                    return Vector<Answer> {};
+                }
+
+                Vector<Answer> answers;
+                for (auto& answer : response.answers()) {
+                    put_in_cache(answer);
+                    if (answer.type() == record_type)
+                        answers.append(answer);
+                }
+                return answers;
+            }
+        }
+
+        if (all_of(queries, [](auto& query) { return query.is_done; }))
+            break;
+    }
+
+    dbgln("Tried all nameservers but never got a response :(");
+    return Vector<Answer> {};
 }
 
 void LookupServer::put_in_cache(Answer const& answer)
@@ -331,8 +443,64 @@ void LookupServer::put_in_cache(Answer const& answer)
                 return true;
             });
         }
+        // A refreshed record replaces the one we had.
+        it->value.remove_all_matching([&](Answer const& other_answer) {
+            return other_answer.type() == answer.type() && other_answer.class_code() == answer.class_code() && other_answer.record_data() == answer.record_data();
+        });
         it->value.append(answer);
     }
+    m_negative_lookup_cache.remove(answer.name());
+}
+
+void LookupServer::put_in_negative_cache(Name const& name, Optional<RecordType> record_type, u32 ttl)
+{
+    if (ttl == 0)
+        return;
+
+    // Prevent the cache from growing too big.
+    if (m_negative_lookup_cache.size() >= 256 && !m_negative_lookup_cache.contains(name))
+        m_negative_lookup_cache.remove(m_negative_lookup_cache.begin());
+
+    auto now = time(nullptr);
+    auto& entries = m_negative_lookup_cache.ensure(name);
+    entries.remove_all_matching([&](auto& entry) { return entry.expiry_time <= now; });
+    entries.append({ record_type, now + ttl });
+}
+
+bool LookupServer::is_negatively_cached(Name const& name, RecordType record_type) const
+{
+    auto it = m_negative_lookup_cache.find(name);
+    if (it == m_negative_lookup_cache.end())
+        return false;
+    auto now = time(nullptr);
+    return any_of(it->value, [&](auto& entry) {
+        return entry.expiry_time > now && (!entry.record_type.has_value() || entry.record_type == record_type);
+    });
+}
+
+// A record that's still asked for in the last tenth of its lifetime will likely be asked for after it expired as well,
+// so it's looked up again ahead of time instead of making that later lookup wait for the nameservers.
+bool LookupServer::should_prefetch(Name const& name, RecordType record_type) const
+{
+    // mDNS responders announce changes on their own.
+    if (name.as_string().ends_with(".local"sv))
+        return false;
+
+    auto it = m_lookup_cache.find(name);
+    if (it == m_lookup_cache.end())
+        return false;
+
+    auto now = time(nullptr);
+    bool has_answer = false;
+    for (auto& answer : it->value) {
+        if (answer.type() != record_type || answer.has_expired())
+            continue;
+        auto remaining_ttl = answer.received_time() + answer.ttl() - now;
+        if (remaining_ttl * 10 > answer.ttl())
+            return false;
+        has_answer = true;
+    }
+    return has_answer;
 }
 
 }
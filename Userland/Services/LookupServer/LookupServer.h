@@ -29,10 +29,19 @@ public:
 private:
     LookupServer();
 
+    struct NegativeCacheEntry {
+        // Empty if the name doesn't exist at all, rather than just not having records of one type.
+        Optional<RecordType> record_type;
+        time_t expiry_time { 0 };
+    };
+
     void load_etc_hosts();
     void put_in_cache(Answer const&);
+    void put_in_negative_cache(Name const&, Optional<RecordType>, u32 ttl);
+    bool is_negatively_cached(Name const&, RecordType) const;
+    bool should_prefetch(Name const&, RecordType) const;
 
-    ErrorOr<Vector<Answer>> lookup(Name const& hostname, DeprecatedString const& nameserver, bool& did_get_response, RecordType record_type, ShouldRandomizeCase = ShouldRandomizeCase::Yes);
+    ErrorOr<Vector<Answer>> lookup_upstream(Name const&, RecordType);
 
     OwnPtr<IPC::MultiServer<ConnectionFromClient>> m_server;
     RefPtr<DNSServer> m_dns_server;
@@ -41,6 +50,7 @@ private:
     RefPtr<Core::FileWatcher> m_file_watcher;
     HashMap<Name, Vector<Answer>, Name::Traits> m_etc_hosts;
     HashMap<Name, Vector<Answer>, Name::Traits> m_lookup_cache;
+    HashMap<Name, Vector<NegativeCacheEntry>, Name::Traits> m_negative_lookup_cache;
 };
 
 }
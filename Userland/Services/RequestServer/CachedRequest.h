@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <RequestServer/HttpCache.h>
+#include <RequestServer/Request.h>
+
+namespace RequestServer {
+
+// A request that is answered from the HttpCache without going to the network.
+class CachedRequest final : public Request {
+public:
+    virtual ~CachedRequest() override = default;
+    static NonnullOwnPtr<CachedRequest> create(ConnectionFromClient&, URL, HttpCache::Entry, NonnullOwnPtr<Core::File>&&);
+
+    virtual URL url() const override { return m_url; }
+
+private:
+    CachedRequest(ConnectionFromClient&, URL, NonnullOwnPtr<Core::File>&&);
+
+    URL m_url;
+};
+
+}
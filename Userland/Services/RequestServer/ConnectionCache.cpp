@@ -13,6 +13,7 @@ namespace RequestServer::ConnectionCache {
 
 HashMap<ConnectionKey, NonnullOwnPtr<NonnullOwnPtrVector<Connection<Core::TCPSocket, Core::Socket>>>> g_tcp_connection_cache {};
 HashMap<ConnectionKey, NonnullOwnPtr<NonnullOwnPtrVector<Connection<TLS::TLSv12>>>> g_tls_connection_cache {};
+NonnullRefPtr<TLS::SessionCache> g_tls_session_cache = TLS::SessionCache::create();
 
 void request_did_finish(URL const& url, Core::Socket const* socket)
 {
@@ -37,10 +38,25 @@ void request_did_finish(URL const& url, Core::Socket const* socket)
         }
 
         auto& connection = *connection_it;
+        if (connection->request_queue.is_empty()) {
+            // Requests are queued on a connection as they come in, so a slow response holds up the ones behind it while
+            // other connections to the same host may already be idle. Take over the oldest request of the most backed-up one.
+            auto& connections = *it->value;
+            Optional<size_t> most_backed_up_index;
+            for (size_t i = 0; i < connections.size(); ++i) {
+                if (auto queue_size = connections[i].request_queue.size(); queue_size > 0 && (!most_backed_up_index.has_value() || queue_size > connections[*most_backed_up_index].request_queue.size()))
+                    most_backed_up_index = i;
+            }
+            if (most_backed_up_index.has_value()) {
+                dbgln_if(REQUESTSERVER_DEBUG, "Connection {} takes over a request queued on {}", &connection, &connections[*most_backed_up_index]);
+                connection->request_queue.append(connections[*most_backed_up_index].request_queue.take_first());
+            }
+        }
         if (connection->request_queue.is_empty()) {
             Core::deferred_invoke([&connection, &cache_entry = *it->value, key = it->key, &cache] {
                 connection->socket->set_notifications_enabled(false);
                 connection->has_started = false;
+                connection->idle_timer.start();
                 connection->current_url = {};
                 connection->job_data = {};
                 connection->removal_timer->on_timeout = [ptr = connection.ptr(), &cache_entry, key = move(key), &cache]() mutable {
@@ -63,6 +79,7 @@ void request_did_finish(URL const& url, Core::Socket const* socket)
             Core::deferred_invoke([&, url] {
                 dbgln_if(REQUESTSERVER_DEBUG, "Running next job in queue for connection {} @{}", &connection, connection->socket);
                 connection->timer.start();
+                connection->idle_timer.reset();
                 connection->current_url = url;
                 connection->job_data = connection->request_queue.take_first();
                 connection->socket->set_notifications_enabled(true);
@@ -85,6 +102,10 @@ void dump_jobs()
     for (auto& connection : g_tls_connection_cache) {
         dbgln(" - {}:{}", connection.key.hostname, connection.key.port);
         for (auto& entry : *connection.value) {
+            if (entry.http2_connection) {
+                dbgln("  - HTTP/2 connection {} with {} streams (socket={})", &entry, entry.http2_connection->stream_count(), entry.socket);
+                continue;
+            }
             dbgln("  - Connection {} (started={}) (socket={})", &entry, entry.has_started, entry.socket);
             dbgln("    Currently loading {} ({} elapsed)", entry.current_url, entry.timer.is_valid() ? entry.timer.elapsed() : 0);
             dbgln("    Request Queue:");
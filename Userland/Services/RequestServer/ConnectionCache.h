@@ -17,6 +17,7 @@
 #include <LibCore/NetworkJob.h>
 #include <LibCore/SOCKSProxyClient.h>
 #include <LibCore/Timer.h>
+#include <LibHTTP/Http2Connection.h>
 #include <LibTLS/TLSv12.h>
 
 namespace RequestServer {
@@ -97,8 +98,12 @@ struct Connection {
     bool has_started { false };
     URL current_url {};
     Core::ElapsedTimer timer {};
+    // Running while the connection sits in the cache without a request.
+    Core::ElapsedTimer idle_timer {};
     JobData job_data {};
     Proxy proxy {};
+    // Set if the server agreed to speak HTTP/2, the requests then don't queue up but all run on this connection at once.
+    RefPtr<HTTP::Http2Connection> http2_connection {};
 };
 
 struct ConnectionKey {
@@ -124,11 +129,29 @@ namespace RequestServer::ConnectionCache {
 extern HashMap<ConnectionKey, NonnullOwnPtr<NonnullOwnPtrVector<Connection<Core::TCPSocket, Core::Socket>>>> g_tcp_connection_cache;
 extern HashMap<ConnectionKey, NonnullOwnPtr<NonnullOwnPtrVector<Connection<TLS::TLSv12>>>> g_tls_connection_cache;
 
+// Shared by all TLS connections, so that new connections to a host can resume an earlier session.
+extern NonnullRefPtr<TLS::SessionCache> g_tls_session_cache;
+
 void request_did_finish(URL const&, Core::Socket const*);
 void dump_jobs();
 
 constexpr static size_t MaxConcurrentConnectionsPerURL = 4;
 constexpr static size_t ConnectionKeepAliveTimeMilliseconds = 10'000;
+constexpr static size_t IdleConnectionTrustTimeMilliseconds = 4'000;
+
+// Servers close idle connections on their own schedule, often after just a few seconds, and we'd only find out once
+// the request we wrote to one fails. So a connection that was idle for longer than most servers allow is not reused,
+// nor is one that has something to read while idle, as the server has either closed it or sent something unasked.
+template<typename T>
+bool is_idle_connection_reusable(T const& connection)
+{
+    if (!connection.idle_timer.is_valid())
+        return true;
+    if (connection.idle_timer.elapsed() > static_cast<i64>(IdleConnectionTrustTimeMilliseconds))
+        return false;
+    auto can_read = connection.socket->can_read_without_blocking();
+    return !can_read.is_error() && !can_read.value();
+}
 
 template<typename T>
 ErrorOr<void> recreate_socket_if_needed(T& connection, URL const& url)
@@ -136,7 +159,7 @@ ErrorOr<void> recreate_socket_if_needed(T& connection, URL const& url)
     using SocketType = typename T::SocketType;
     using SocketStorageType = typename T::StorageType;
 
-    if (!connection.socket->is_open() || connection.socket->is_eof()) {
+    if (!connection.socket->is_open() || connection.socket->is_eof() || !is_idle_connection_reusable(connection)) {
         // Create another socket for the connection.
         auto set_socket = [&](auto socket) -> ErrorOr<void> {
             connection.socket = TRY(Core::BufferedSocket<SocketStorageType>::create(move(socket)));
@@ -145,6 +168,7 @@ ErrorOr<void> recreate_socket_if_needed(T& connection, URL const& url)
 
         if constexpr (IsSame<TLS::TLSv12, SocketType>) {
             TLS::Options options;
+            options.set_session_cache(g_tls_session_cache);
             options.set_alert_handler([&connection](TLS::AlertDescription alert) {
                 Core::NetworkJob::Error reason;
                 if (alert == TLS::AlertDescription::HandshakeFailure)
@@ -171,20 +195,70 @@ ErrorOr<void> recreate_socket_if_needed(T& connection, URL const& url)
     return {};
 }
 
+template<typename ConnectionType, typename CacheType>
+ErrorOr<void> start_http2_connection(ConnectionType& connection, CacheType& cache, ConnectionKey const& key)
+{
+    connection.http2_connection = HTTP::Http2Connection::construct(*connection.socket);
+    connection.http2_connection->on_idle = [&connection, &cache, key] {
+        auto remove_connection = [&cache, key, ptr = &connection] {
+            Core::deferred_invoke([&cache, key, ptr] {
+                dbgln_if(REQUESTSERVER_DEBUG, "Removing no-longer-used HTTP/2 connection {} (socket {})", ptr, ptr->socket);
+                auto it = cache.find(key);
+                if (it == cache.end())
+                    return;
+                it->value->remove_first_matching([&](auto& entry) { return entry == ptr; });
+                if (it->value->is_empty())
+                    cache.remove(it);
+            });
+        };
+
+        // A connection that can't take any new requests goes away right away, others are kept around for a while.
+        if (!connection.http2_connection->is_usable())
+            return remove_connection();
+        connection.removal_timer->on_timeout = move(remove_connection);
+        connection.removal_timer->start();
+    };
+    connection.socket->set_notifications_enabled(true);
+    return connection.http2_connection->start();
+}
+
 decltype(auto) get_or_create_connection(auto& cache, URL const& url, auto& job, Core::ProxyData proxy_data = {})
 {
     using CacheEntryType = RemoveCVReference<decltype(*cache.begin()->value)>;
-    auto& sockets_for_url = *cache.ensure({ url.host(), url.port_or_default(), proxy_data }, [] { return make<CacheEntryType>(); });
+    using ConnectionType = RemoveCVReference<decltype(cache.begin()->value->at(0))>;
+    ConnectionKey key { url.host(), url.port_or_default(), proxy_data };
+    auto& sockets_for_url = *cache.ensure(key, [] { return make<CacheEntryType>(); });
 
     Proxy proxy { proxy_data };
 
     using ReturnType = decltype(&sockets_for_url[0]);
-    auto it = sockets_for_url.find_if([](auto& connection) { return connection->request_queue.is_empty(); });
+
+    constexpr bool can_use_http2 = IsSame<TLS::TLSv12, typename ConnectionType::SocketType> && requires { job.start(declval<HTTP::Http2Connection&>()); };
+    if constexpr (can_use_http2) {
+        auto it = sockets_for_url.find_if([](auto& connection) { return connection->http2_connection && connection->http2_connection->is_usable(); });
+        if (!it.is_end()) {
+            auto& connection = sockets_for_url[it.index()];
+            dbgln_if(REQUESTSERVER_DEBUG, "Start request for url {} on HTTP/2 connection {} - {}", url, &connection, connection.socket);
+            connection.removal_timer->stop();
+            job.start(*connection.http2_connection);
+            return &connection;
+        }
+    }
+
+    auto it = sockets_for_url.find_if([](auto& connection) { return connection->request_queue.is_empty() && !connection->http2_connection; });
     auto did_add_new_connection = false;
     auto failed_to_find_a_socket = it.is_end();
     if (failed_to_find_a_socket && sockets_for_url.size() < ConnectionCache::MaxConcurrentConnectionsPerURL) {
-        using ConnectionType = RemoveCVReference<decltype(cache.begin()->value->at(0))>;
-        auto connection_result = proxy.tunnel<typename ConnectionType::SocketType, typename ConnectionType::StorageType>(url);
+        auto connection_result = [&] {
+            if constexpr (IsSame<TLS::TLSv12, typename ConnectionType::SocketType>) {
+                auto options = TLS::Options {}.set_session_cache(g_tls_session_cache);
+                if constexpr (can_use_http2)
+                    options.set_alpn_protocols({ "h2", "http/1.1" });
+                return proxy.tunnel<typename ConnectionType::SocketType, typename ConnectionType::StorageType>(url, move(options));
+            } else {
+                return proxy.tunnel<typename ConnectionType::SocketType, typename ConnectionType::StorageType>(url);
+            }
+        }();
         if (connection_result.is_error()) {
             dbgln("ConnectionCache: Connection to {} failed: {}", url, connection_result.error());
             Core::deferred_invoke([&job] {
@@ -192,6 +266,9 @@ decltype(auto) get_or_create_connection(auto& cache, URL const& url, auto& job,
             });
             return ReturnType { nullptr };
         }
+        bool use_http2 = false;
+        if constexpr (can_use_http2)
+            use_http2 = connection_result.value()->alpn() == "h2"sv;
         auto socket_result = Core::BufferedSocket<typename ConnectionType::StorageType>::create(connection_result.release_value());
         if (socket_result.is_error()) {
             dbgln("ConnectionCache: Failed to make a buffered socket for {}: {}", url, socket_result.error());
@@ -206,6 +283,23 @@ decltype(auto) get_or_create_connection(auto& cache, URL const& url, auto& job,
             Core::Timer::create_single_shot(ConnectionKeepAliveTimeMilliseconds, nullptr).release_value_but_fixme_should_propagate_errors()));
         sockets_for_url.last().proxy = move(proxy);
         did_add_new_connection = true;
+
+        if constexpr (can_use_http2) {
+            if (use_http2) {
+                auto& connection = sockets_for_url.last();
+                dbgln_if(REQUESTSERVER_DEBUG, "Start request for url {} on new HTTP/2 connection {} - {}", url, &connection, connection.socket);
+                if (auto result = start_http2_connection(connection, cache, key); result.is_error()) {
+                    dbgln("ConnectionCache: Failed to start HTTP/2 connection to {}: {}", url, result.error());
+                    sockets_for_url.take_last();
+                    Core::deferred_invoke([&job] {
+                        job.fail(Core::NetworkJob::Error::ConnectionFailed);
+                    });
+                    return ReturnType { nullptr };
+                }
+                job.start(*connection.http2_connection);
+                return &connection;
+            }
+        }
     }
     size_t index;
     if (failed_to_find_a_socket) {
@@ -216,6 +310,8 @@ decltype(auto) get_or_create_connection(auto& cache, URL const& url, auto& job,
             index = 0;
             auto min_queue_size = (size_t)-1;
             for (auto it = sockets_for_url.begin(); it != sockets_for_url.end(); ++it) {
+                if (it->http2_connection)
+                    continue;
                 if (auto queue_size = it->request_queue.size(); min_queue_size > queue_size) {
                     index = it.index();
                     min_queue_size = queue_size;
@@ -243,6 +339,7 @@ decltype(auto) get_or_create_connection(auto& cache, URL const& url, auto& job,
         }
         dbgln_if(REQUESTSERVER_DEBUG, "Immediately start request for url {} in {} - {}", url, &connection, connection.socket);
         connection.has_started = true;
+        connection.idle_timer.reset();
         connection.removal_timer->stop();
         connection.timer.start();
         connection.current_url = url;
@@ -0,0 +1,350 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <AK/Hex.h>
+#include <AK/QuickSort.h>
+#include <AK/StringBuilder.h>
+#include <LibCore/DateTime.h>
+#include <LibCore/DirIterator.h>
+#include <LibCore/System.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <RequestServer/HttpCache.h>
+#include <unistd.h>
+
+namespace RequestServer::HttpCache {
+
+static constexpr size_t max_entry_size = 16 * MiB;
+static constexpr size_t max_cache_size = 256 * MiB;
+
+static DeprecatedString s_directory;
+
+// The size of the cache as far as this process knows. Other RequestServer instances add to it too, so it's recomputed
+// whenever this goes over the limit.
+static Optional<size_t> s_estimated_size;
+
+template<typename HeaderMap>
+static Optional<DeprecatedString> header_value(HeaderMap const& headers, StringView name)
+{
+    for (auto const& it : headers) {
+        if (it.key.equals_ignoring_case(name))
+            return it.value;
+    }
+    return {};
+}
+
+struct CacheControl {
+    bool no_store { false };
+    bool no_cache { false };
+    Optional<i64> max_age;
+};
+
+// https://www.rfc-editor.org/rfc/rfc9111#section-5.2
+static CacheControl parse_cache_control(Optional<DeprecatedString> const& header)
+{
+    CacheControl cache_control;
+    if (!header.has_value())
+        return cache_control;
+
+    for (auto directive : header->split_view(',')) {
+        directive = directive.trim_whitespace();
+        if (directive.equals_ignoring_case("no-store"sv))
+            cache_control.no_store = true;
+        else if (directive.equals_ignoring_case("no-cache"sv))
+            cache_control.no_cache = true;
+        else if (directive.starts_with("max-age="sv, CaseSensitivity::CaseInsensitive))
+            cache_control.max_age = directive.substring_view(8).to_int<i64>();
+    }
+    return cache_control;
+}
+
+// HTTP dates look like "Sun, 06 Nov 1994 08:49:37 GMT".
+static Optional<time_t> parse_http_date(Optional<DeprecatedString> const& value)
+{
+    if (!value.has_value() || !value->ends_with(" GMT"sv))
+        return {};
+
+    auto date_time = Core::DateTime::parse("%a, %d %b %Y %H:%M:%S %z"sv, DeprecatedString::formatted("{}Z", value->substring_view(0, value->length() - 3)));
+    if (!date_time.has_value())
+        return {};
+    return date_time->timestamp();
+}
+
+// https://www.rfc-editor.org/rfc/rfc9111#section-4.2.1
+static i64 freshness_lifetime(Entry const& entry)
+{
+    auto cache_control = parse_cache_control(header_value(entry.response_headers, "Cache-Control"sv));
+    if (cache_control.no_cache)
+        return 0;
+    if (cache_control.max_age.has_value())
+        return cache_control.max_age.value();
+
+    auto date = parse_http_date(header_value(entry.response_headers, "Date"sv)).value_or(entry.stored_at);
+    if (auto expires = header_value(entry.response_headers, "Expires"sv); expires.has_value()) {
+        // NOTE: Invalid dates, like "0", mean that the response has already expired.
+        auto expires_at = parse_http_date(expires);
+        return expires_at.has_value() ? expires_at.value() - date : 0;
+    }
+
+    // https://www.rfc-editor.org/rfc/rfc9111#section-4.2.2
+    if (auto last_modified = parse_http_date(header_value(entry.response_headers, "Last-Modified"sv)); last_modified.has_value())
+        return max<i64>(0, (date - last_modified.value()) / 10);
+    return 0;
+}
+
+// https://www.rfc-editor.org/rfc/rfc9111#section-4.2.3
+static i64 current_age(Entry const& entry)
+{
+    i64 age = 0;
+    if (auto age_header = header_value(entry.response_headers, "Age"sv); age_header.has_value())
+        age = max<i64>(0, age_header->to_int<i64>().value_or(0));
+    return age + max<i64>(0, time(nullptr) - entry.stored_at);
+}
+
+bool Entry::is_fresh() const
+{
+    return current_age(*this) < freshness_lifetime(*this);
+}
+
+bool Entry::can_be_revalidated() const
+{
+    return header_value(response_headers, "ETag"sv).has_value() || header_value(response_headers, "Last-Modified"sv).has_value();
+}
+
+ErrorOr<size_t> RecordingStream::write(ReadonlyBytes bytes)
+{
+    auto written = TRY(m_client_stream.write(bytes));
+    if (m_is_recording) {
+        if (m_recorded_body.size() + written > max_entry_size || m_recorded_body.try_append(bytes.trim(written)).is_error()) {
+            m_is_recording = false;
+            m_recorded_body.clear();
+        }
+    }
+    return written;
+}
+
+Optional<ByteBuffer> RecordingStream::take_recorded_body()
+{
+    if (!m_is_recording)
+        return {};
+    m_is_recording = false;
+    return move(m_recorded_body);
+}
+
+void set_directory(DeprecatedString directory)
+{
+    s_directory = move(directory);
+}
+
+bool is_cacheable_request(DeprecatedString const& method, HashMap<DeprecatedString, DeprecatedString> const& request_headers, ReadonlyBytes request_body)
+{
+    if (s_directory.is_null())
+        return false;
+    if (!method.equals_ignoring_case("GET"sv) || !request_body.is_empty())
+        return false;
+
+    // NOTE: Conditional requests from the client are for the client to answer, and authorized responses aren't ours to share.
+    for (auto header : { "Authorization"sv, "If-None-Match"sv, "If-Modified-Since"sv }) {
+        if (header_value(request_headers, header).has_value())
+            return false;
+    }
+    return !parse_cache_control(header_value(request_headers, "Cache-Control"sv)).no_store;
+}
+
+bool request_requires_revalidation(HashMap<DeprecatedString, DeprecatedString> const& request_headers)
+{
+    if (parse_cache_control(header_value(request_headers, "Cache-Control"sv)).no_cache)
+        return true;
+    auto pragma = header_value(request_headers, "Pragma"sv);
+    return pragma.has_value() && pragma->contains("no-cache"sv, CaseSensitivity::CaseInsensitive);
+}
+
+// https://www.rfc-editor.org/rfc/rfc9111#section-4.3.1
+void add_revalidation_headers(Entry const& entry, HashMap<DeprecatedString, DeprecatedString>& request_headers)
+{
+    if (auto etag = header_value(entry.response_headers, "ETag"sv); etag.has_value())
+        request_headers.set("If-None-Match", etag.release_value());
+    if (auto last_modified = header_value(entry.response_headers, "Last-Modified"sv); last_modified.has_value())
+        request_headers.set("If-Modified-Since", last_modified.release_value());
+}
+
+static bool is_cacheable_response(Entry const& entry)
+{
+    if (entry.status_code != 200 || entry.body.size() > max_entry_size)
+        return false;
+    if (parse_cache_control(header_value(entry.response_headers, "Cache-Control"sv)).no_store)
+        return false;
+
+    // NOTE: Entries are only keyed by their URL, so we can't tell apart responses that vary on anything else.
+    //       The body we see has already been decoded, so varying on the encoding is fine.
+    if (auto vary = header_value(entry.response_headers, "Vary"sv); vary.has_value() && !vary->trim_whitespace().equals_ignoring_case("Accept-Encoding"sv))
+        return false;
+
+    return entry.is_fresh() || entry.can_be_revalidated();
+}
+
+static DeprecatedString cache_key(URL const& url)
+{
+    return url.serialize(URL::ExcludeFragment::Yes);
+}
+
+static DeprecatedString path_for_key(DeprecatedString const& key)
+{
+    auto digest = Crypto::Hash::SHA256::hash(key);
+    return DeprecatedString::formatted("{}/{}", s_directory, encode_hex(digest.bytes()));
+}
+
+// Entries are stored as the key, status code and time they were stored on a line each, then a line per header,
+// followed by an empty line and the body.
+static ErrorOr<void> write_entry(DeprecatedString const& path, DeprecatedString const& key, Entry const& entry)
+{
+    StringBuilder builder;
+    builder.appendff("{}\n{}\n{}\n", key, entry.status_code, entry.stored_at);
+    for (auto const& it : entry.response_headers) {
+        // NOTE: Cookies were meant for the client that received the response, not for everyone we hand it out to later.
+        if (it.key.equals_ignoring_case("Set-Cookie"sv))
+            continue;
+        builder.appendff("{}: {}\n", it.key, it.value);
+    }
+    builder.append('\n');
+
+    auto file = TRY(Core::File::open(path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate, 0600));
+    TRY(file->write_entire_buffer(builder.string_view().bytes()));
+    TRY(file->write_entire_buffer(entry.body));
+    return {};
+}
+
+static Optional<Entry> read_entry(DeprecatedString const& key, ReadonlyBytes data)
+{
+    auto end_of_headers = StringView { data }.find("\n\n"sv);
+    if (!end_of_headers.has_value())
+        return {};
+
+    auto lines = StringView { data.trim(end_of_headers.value()) }.split_view('\n');
+    if (lines.size() < 3 || lines[0] != key)
+        return {};
+
+    Entry entry;
+    auto status_code = lines[1].to_uint();
+    auto stored_at = lines[2].to_int<i64>();
+    if (!status_code.has_value() || !stored_at.has_value())
+        return {};
+    entry.status_code = status_code.value();
+    entry.stored_at = stored_at.value();
+
+    for (size_t i = 3; i < lines.size(); ++i) {
+        auto separator = lines[i].find(": "sv);
+        if (!separator.has_value())
+            return {};
+        entry.response_headers.set(lines[i].substring_view(0, separator.value()), lines[i].substring_view(separator.value() + 2));
+    }
+
+    auto body = ByteBuffer::copy(data.slice(end_of_headers.value() + 2));
+    if (body.is_error())
+        return {};
+    entry.body = body.release_value();
+    return entry;
+}
+
+Optional<Entry> lookup(URL const& url)
+{
+    if (s_directory.is_null())
+        return {};
+
+    auto key = cache_key(url);
+    auto path = path_for_key(key);
+    auto file = Core::File::open(path, Core::File::OpenMode::Read);
+    if (file.is_error())
+        return {};
+    auto data = file.value()->read_until_eof();
+    if (data.is_error())
+        return {};
+
+    auto entry = read_entry(key, data.value());
+    if (!entry.has_value()) {
+        dbgln_if(REQUESTSERVER_DEBUG, "HttpCache: Ignoring unreadable entry for {}", url);
+        return {};
+    }
+
+    // NOTE: Bump the modification time, so that entries that are still in use are the last to go when pruning the cache.
+    (void)Core::System::utime(path, {});
+    return entry;
+}
+
+static void prune_if_needed(size_t added_size)
+{
+    if (s_estimated_size.has_value()) {
+        s_estimated_size.value() += added_size;
+        if (s_estimated_size.value() <= max_cache_size)
+            return;
+    }
+
+    struct CachedFile {
+        DeprecatedString path;
+        size_t size { 0 };
+        time_t last_used { 0 };
+    };
+    Vector<CachedFile> files;
+    size_t total_size = 0;
+
+    Core::DirIterator iterator(s_directory, Core::DirIterator::SkipDots);
+    while (iterator.has_next()) {
+        auto path = iterator.next_full_path();
+        auto stat = Core::System::stat(path);
+        if (stat.is_error())
+            continue;
+        files.append({ move(path), static_cast<size_t>(stat.value().st_size), stat.value().st_mtime });
+        total_size += stat.value().st_size;
+    }
+
+    // Go well below the limit, so that we don't end up doing this again for every new entry.
+    if (total_size > max_cache_size) {
+        quick_sort(files, [](auto const& a, auto const& b) { return a.last_used < b.last_used; });
+        for (auto const& file : files) {
+            if (total_size <= max_cache_size * 3 / 4)
+                break;
+            if (!Core::System::unlink(file.path).is_error())
+                total_size -= file.size;
+        }
+    }
+    s_estimated_size = total_size;
+}
+
+void store(URL const& url, Entry const& entry)
+{
+    if (s_directory.is_null() || !is_cacheable_response(entry))
+        return;
+
+    auto key = cache_key(url);
+    auto path = path_for_key(key);
+
+    // NOTE: Other RequestServer instances may be reading this entry right now, so we swap in the new one all at once.
+    auto temporary_path = DeprecatedString::formatted("{}.{}", path, getpid());
+    auto result = write_entry(temporary_path, key, entry);
+    if (!result.is_error())
+        result = Core::System::rename(temporary_path, path);
+    if (result.is_error()) {
+        dbgln("HttpCache: Failed to store {}: {}", url, result.error());
+        (void)Core::System::unlink(temporary_path);
+        return;
+    }
+
+    prune_if_needed(entry.body.size());
+}
+
+// https://www.rfc-editor.org/rfc/rfc9111#section-4.3.4
+void update_after_revalidation(URL const& url, Entry& entry, HashMap<DeprecatedString, DeprecatedString, CaseInsensitiveStringTraits> const& response_headers)
+{
+    for (auto const& it : response_headers) {
+        if (it.key.equals_ignoring_case("Content-Length"sv))
+            continue;
+        entry.response_headers.set(it.key, it.value);
+    }
+    entry.stored_at = time(nullptr);
+    store(url, entry);
+}
+
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/DeprecatedString.h>
+#include <AK/HashMap.h>
+#include <AK/Optional.h>
+#include <AK/Stream.h>
+#include <AK/URL.h>
+#include <LibCore/File.h>
+#include <time.h>
+
+// A disk cache for HTTP responses, shared by all RequestServer instances of a user.
+// Only complete responses to plain GET requests are stored. Stale entries are revalidated with conditional requests.
+namespace RequestServer::HttpCache {
+
+struct Entry {
+    u32 status_code { 0 };
+    HashMap<DeprecatedString, DeprecatedString, CaseInsensitiveStringTraits> response_headers;
+    ByteBuffer body;
+    // When the response was last received from, or revalidated with, the server.
+    time_t stored_at { 0 };
+
+    bool is_fresh() const;
+    bool can_be_revalidated() const;
+};
+
+// Passes everything written to it on to the client, while keeping a copy of the response body to store in the cache.
+class RecordingStream final : public Stream {
+public:
+    explicit RecordingStream(Core::File& client_stream)
+        : m_client_stream(client_stream)
+    {
+    }
+
+    virtual ErrorOr<Bytes> read(Bytes) override { return Error::from_errno(EBADF); }
+    virtual ErrorOr<size_t> write(ReadonlyBytes) override;
+    virtual bool is_eof() const override { return m_client_stream.is_eof(); }
+    virtual bool is_open() const override { return m_client_stream.is_open(); }
+    virtual void close() override { m_client_stream.close(); }
+
+    // Empty if the body got too large to be cached.
+    Optional<ByteBuffer> take_recorded_body();
+
+private:
+    Core::File& m_client_stream;
+    ByteBuffer m_recorded_body;
+    bool m_is_recording { true };
+};
+
+void set_directory(DeprecatedString);
+
+bool is_cacheable_request(DeprecatedString const& method, HashMap<DeprecatedString, DeprecatedString> const& request_headers, ReadonlyBytes request_body);
+bool request_requires_revalidation(HashMap<DeprecatedString, DeprecatedString> const& request_headers);
+void add_revalidation_headers(Entry const&, HashMap<DeprecatedString, DeprecatedString>& request_headers);
+
+Optional<Entry> lookup(URL const&);
+void store(URL const&, Entry const&);
+void update_after_revalidation(URL const&, Entry&, HashMap<DeprecatedString, DeprecatedString, CaseInsensitiveStringTraits> const& response_headers);
+
+}
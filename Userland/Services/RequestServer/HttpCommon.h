@@ -14,8 +14,10 @@
 #include <AK/OwnPtr.h>
 #include <AK/Types.h>
 #include <LibHTTP/HttpRequest.h>
+#include <RequestServer/CachedRequest.h>
 #include <RequestServer/ConnectionCache.h>
 #include <RequestServer/ConnectionFromClient.h>
+#include <RequestServer/HttpCache.h>
 #include <RequestServer/Request.h>
 
 namespace RequestServer::Detail {
@@ -24,16 +26,26 @@ template<typename TSelf, typename TJob>
 void init(TSelf* self, TJob job)
 {
     job->on_headers_received = [self](auto& headers, auto response_code) {
+        // NOTE: The client gets the cached response instead once the request finishes.
+        if (response_code == 304u && self->is_revalidating_cache_entry())
+            return;
         if (response_code.has_value())
             self->set_status_code(response_code.value());
         self->set_response_headers(headers);
     };
 
     job->on_finish = [self](bool success) {
-        Core::deferred_invoke([url = self->job().url(), socket = self->job().socket()] {
-            ConnectionCache::request_did_finish(url, socket);
-        });
+        // Requests on an HTTP/2 connection share it with others, so there's no queue of requests to move along.
+        if (!self->job().is_using_http2()) {
+            Core::deferred_invoke([url = self->job().url(), socket = self->job().socket()] {
+                ConnectionCache::request_did_finish(url, socket);
+            });
+        }
         if (auto* response = self->job().response()) {
+            if (success && response->code() == 304 && self->is_revalidating_cache_entry()) {
+                self->did_revalidate_cache_entry(response->headers());
+                return;
+            }
             self->set_status_code(response->code());
             self->set_response_headers(response->headers());
             self->set_downloaded_size(response->downloaded_size());
@@ -44,6 +56,8 @@ void init(TSelf* self, TJob job)
         if (!self->total_size().has_value())
             self->did_progress(self->downloaded_size(), self->downloaded_size());
 
+        if (success)
+            self->store_response_in_cache();
         self->did_finish(success);
     };
     job->on_progress = [self](Optional<u32> total, u32 current) {
@@ -90,7 +104,6 @@ OwnPtr<Request> start_request(TBadgedProtocol&& protocol, ConnectionFromClient&
     else
         request.set_method(HTTP::HttpRequest::Method::GET);
     request.set_url(url);
-    request.set_headers(headers);
 
     auto allocated_body_result = ByteBuffer::copy(body);
     if (allocated_body_result.is_error())
@@ -98,9 +111,32 @@ OwnPtr<Request> start_request(TBadgedProtocol&& protocol, ConnectionFromClient&
     request.set_body(allocated_body_result.release_value());
 
     auto output_stream = MUST(Core::File::adopt_fd(pipe_result.value().write_fd, Core::File::OpenMode::Write));
-    auto job = TJob::construct(move(request), *output_stream);
+
+    auto request_headers = headers;
+    OwnPtr<HttpCache::RecordingStream> cache_recording_stream;
+    Optional<HttpCache::Entry> cache_entry;
+    if (HttpCache::is_cacheable_request(method, headers, body)) {
+        cache_entry = HttpCache::lookup(url);
+        if (cache_entry.has_value() && cache_entry->is_fresh() && !HttpCache::request_requires_revalidation(headers)) {
+            auto cached_request = CachedRequest::create(client, url, cache_entry.release_value(), move(output_stream));
+            cached_request->set_request_fd(pipe_result.value().read_fd);
+            return cached_request;
+        }
+
+        if (cache_entry.has_value() && cache_entry->can_be_revalidated())
+            HttpCache::add_revalidation_headers(*cache_entry, request_headers);
+        else
+            cache_entry.clear();
+        cache_recording_stream = make<HttpCache::RecordingStream>(*output_stream);
+    }
+    request.set_headers(request_headers);
+
+    Stream& job_output_stream = cache_recording_stream ? static_cast<Stream&>(*cache_recording_stream) : *output_stream;
+    auto job = TJob::construct(move(request), job_output_stream);
     auto protocol_request = TRequest::create_with_job(forward<TBadgedProtocol>(protocol), client, (TJob&)*job, move(output_stream));
     protocol_request->set_request_fd(pipe_result.value().read_fd);
+    if (cache_recording_stream)
+        protocol_request->set_cache_state(cache_recording_stream.release_nonnull(), move(cache_entry));
 
     if constexpr (IsSame<typename TBadgedProtocol::Type, HttpsProtocol>)
         ConnectionCache::get_or_create_connection(ConnectionCache::g_tls_connection_cache, url, *job, proxy_data);
@@ -6,6 +6,7 @@
 
 #include <RequestServer/ConnectionFromClient.h>
 #include <RequestServer/Request.h>
+#include <errno.h>
 
 namespace RequestServer {
 
@@ -51,4 +52,63 @@ void Request::did_request_certificates()
     m_client.did_request_certificates({}, *this);
 }
 
+void Request::set_cache_state(NonnullOwnPtr<HttpCache::RecordingStream> recording_stream, Optional<HttpCache::Entry> entry_being_revalidated)
+{
+    m_cache_recording_stream = move(recording_stream);
+    m_cache_entry_being_revalidated = move(entry_being_revalidated);
+}
+
+void Request::did_revalidate_cache_entry(HashMap<DeprecatedString, DeprecatedString, CaseInsensitiveStringTraits> const& response_headers)
+{
+    auto entry = m_cache_entry_being_revalidated.release_value();
+    HttpCache::update_after_revalidation(url(), entry, response_headers);
+    send_cached_response(move(entry));
+}
+
+void Request::store_response_in_cache()
+{
+    if (!m_cache_recording_stream || !m_status_code.has_value())
+        return;
+    auto body = m_cache_recording_stream->take_recorded_body();
+    if (!body.has_value())
+        return;
+    HttpCache::store(url(), { m_status_code.value(), m_response_headers, body.release_value(), time(nullptr) });
+}
+
+void Request::send_cached_response(HttpCache::Entry entry)
+{
+    // NOTE: Everything is sent from the notifier, so that the client already knows about this request when it hears back.
+    m_cached_response = move(entry);
+    m_cached_response_notifier = Core::Notifier::construct(m_output_stream->fd(), Core::Notifier::Event::Write);
+    m_cached_response_notifier->on_ready_to_write = [this] {
+        continue_sending_cached_response();
+    };
+}
+
+void Request::continue_sending_cached_response()
+{
+    if (!m_did_send_cached_response_headers) {
+        m_did_send_cached_response_headers = true;
+        set_status_code(m_cached_response->status_code);
+        set_response_headers(m_cached_response->response_headers);
+    }
+
+    auto const& body = m_cached_response->body;
+    while (m_cached_response_bytes_sent < body.size()) {
+        auto result = m_output_stream->write(body.bytes().slice(m_cached_response_bytes_sent));
+        if (result.is_error()) {
+            if (result.error().is_errno() && (result.error().code() == EAGAIN || result.error().code() == EINTR))
+                return;
+            m_cached_response_notifier->set_enabled(false);
+            did_finish(false);
+            return;
+        }
+        m_cached_response_bytes_sent += result.value();
+    }
+
+    m_cached_response_notifier->set_enabled(false);
+    did_progress(body.size(), body.size());
+    did_finish(true);
+}
+
 }
@@ -11,7 +11,9 @@
 #include <AK/Optional.h>
 #include <AK/RefCounted.h>
 #include <AK/URL.h>
+#include <LibCore/Notifier.h>
 #include <RequestServer/Forward.h>
+#include <RequestServer/HttpCache.h>
 
 namespace RequestServer {
 
@@ -42,10 +44,21 @@ public:
     void set_downloaded_size(size_t size) { m_downloaded_size = size; }
     Core::File const& output_stream() const { return *m_output_stream; }
 
+    // Set up for HTTP(S) requests whose response may be stored in the HttpCache, or answered from it after revalidating.
+    void set_cache_state(NonnullOwnPtr<HttpCache::RecordingStream>, Optional<HttpCache::Entry> entry_being_revalidated);
+    bool is_revalidating_cache_entry() const { return m_cache_entry_being_revalidated.has_value(); }
+    void did_revalidate_cache_entry(HashMap<DeprecatedString, DeprecatedString, CaseInsensitiveStringTraits> const& response_headers);
+    void store_response_in_cache();
+
+    // Answers the request with the given response instead, once the client is ready to take it.
+    void send_cached_response(HttpCache::Entry);
+
 protected:
     explicit Request(ConnectionFromClient&, NonnullOwnPtr<Core::File>&&);
 
 private:
+    void continue_sending_cached_response();
+
     ConnectionFromClient& m_client;
     i32 m_id { 0 };
     int m_request_fd { -1 }; // Passed to client.
@@ -54,6 +67,14 @@ private:
     size_t m_downloaded_size { 0 };
     NonnullOwnPtr<Core::File> m_output_stream;
     HashMap<DeprecatedString, DeprecatedString, CaseInsensitiveStringTraits> m_response_headers;
+
+    OwnPtr<HttpCache::RecordingStream> m_cache_recording_stream;
+    Optional<HttpCache::Entry> m_cache_entry_being_revalidated;
+
+    Optional<HttpCache::Entry> m_cached_response;
+    size_t m_cached_response_bytes_sent { 0 };
+    bool m_did_send_cached_response_headers { false };
+    RefPtr<Core::Notifier> m_cached_response_notifier;
 };
 
 }
@@ -88,7 +88,6 @@ Messages::SQLServer::ExecuteStatementResponse ConnectionFromClient::execute_stat
 
     auto statement = SQLStatement::statement_for(statement_id);
     if (statement && statement->connection()->client_id() == client_id()) {
-        // FIXME: Support taking parameters from IPC requests.
         return statement->execute(move(const_cast<Vector<SQL::Value>&>(placeholder_values)));
     }
 
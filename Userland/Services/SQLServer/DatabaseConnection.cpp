@@ -5,6 +5,7 @@
  */
 
 #include <AK/LexicalPath.h>
+#include <LibSQL/AST/Parser.h>
 #include <SQLServer/DatabaseConnection.h>
 #include <SQLServer/SQLStatement.h>
 
@@ -43,6 +44,7 @@ ErrorOr<NonnullRefPtr<DatabaseConnection>> DatabaseConnection::create(StringView
         warnln("Could not open database: {}", result.error().error_string());
         return Error::from_string_view("Could not open database"sv);
     }
+    database->set_group_commit(true);
 
     return adopt_nonnull_ref_or_enomem(new (nothrow) DatabaseConnection(move(database), move(database_name), client_id));
 }
@@ -72,4 +74,28 @@ SQL::ResultOr<SQL::StatementID> DatabaseConnection::prepare_statement(StringView
     return statement->statement_id();
 }
 
+SQL::ResultOr<NonnullRefPtr<SQL::AST::Statement>> DatabaseConnection::parse_statement(StringView sql)
+{
+    for (size_t i = 0; i < m_parsed_statements.size(); ++i) {
+        if (m_parsed_statements[i].sql != sql)
+            continue;
+        // Move the entry to the back, so the least recently used ones are at the front.
+        auto parsed_statement = m_parsed_statements.take(i);
+        auto statement = parsed_statement.statement;
+        m_parsed_statements.append(move(parsed_statement));
+        return statement;
+    }
+
+    auto parser = SQL::AST::Parser(SQL::AST::Lexer(sql));
+    auto statement = parser.next_statement();
+
+    if (parser.has_errors())
+        return SQL::Result { SQL::SQLCommand::Unknown, SQL::SQLErrorCode::SyntaxError, parser.errors()[0].to_deprecated_string() };
+
+    if (m_parsed_statements.size() >= parsed_statement_cache_capacity)
+        m_parsed_statements.take_first();
+    m_parsed_statements.append({ sql, statement });
+    return statement;
+}
+
 }
@@ -7,7 +7,9 @@
 #pragma once
 
 #include <AK/NonnullRefPtr.h>
+#include <AK/Vector.h>
 #include <LibCore/Object.h>
+#include <LibSQL/AST/AST.h>
 #include <LibSQL/Database.h>
 #include <LibSQL/Result.h>
 #include <LibSQL/Type.h>
@@ -29,10 +31,22 @@ public:
     StringView database_name() const { return m_database_name; }
     void disconnect();
     SQL::ResultOr<SQL::StatementID> prepare_statement(StringView sql);
+    SQL::ResultOr<NonnullRefPtr<SQL::AST::Statement>> parse_statement(StringView sql);
 
 private:
     DatabaseConnection(NonnullRefPtr<SQL::Database> database, DeprecatedString database_name, int client_id);
 
+    // Clients tend to prepare the same handful of statements over and over again, with different placeholder values.
+    // The parsed statements can't change, so they are shared by every statement prepared from the same SQL text.
+    static constexpr size_t parsed_statement_cache_capacity = 32;
+
+    struct ParsedStatement {
+        DeprecatedString sql;
+        NonnullRefPtr<SQL::AST::Statement> statement;
+    };
+    // Ordered from least to most recently used.
+    Vector<ParsedStatement> m_parsed_statements;
+
     NonnullRefPtr<SQL::Database> m_database;
     DeprecatedString m_database_name;
     SQL::ConnectionID m_connection_id { 0 };
@@ -5,7 +5,6 @@
  */
 
 #include <LibCore/Object.h>
-#include <LibSQL/AST/Parser.h>
 #include <SQLServer/ConnectionFromClient.h>
 #include <SQLServer/DatabaseConnection.h>
 #include <SQLServer/SQLStatement.h>
@@ -25,12 +24,7 @@ RefPtr<SQLStatement> SQLStatement::statement_for(SQL::StatementID statement_id)
 
 SQL::ResultOr<NonnullRefPtr<SQLStatement>> SQLStatement::create(DatabaseConnection& connection, StringView sql)
 {
-    auto parser = SQL::AST::Parser(SQL::AST::Lexer(sql));
-    auto statement = parser.next_statement();
-
-    if (parser.has_errors())
-        return SQL::Result { SQL::SQLCommand::Unknown, SQL::SQLErrorCode::SyntaxError, parser.errors()[0].to_deprecated_string() };
-
+    auto statement = TRY(connection.parse_statement(sql));
     return TRY(adopt_nonnull_ref_or_enomem(new (nothrow) SQLStatement(connection, move(statement))));
 }
 
@@ -80,32 +74,42 @@ Optional<SQL::ExecutionID> SQLStatement::execute(Vector<SQL::Value> placeholder_
             return;
         }
 
-        auto client_connection = ConnectionFromClient::client_connection_for(connection()->client_id());
-        if (!client_connection) {
-            warnln("Cannot return statement execution results. Client disconnected");
-            return;
-        }
+        // Only report success once the changes made by the statement are on disk.
+        connection()->database()->sync([this, strong_this = NonnullRefPtr(*this), execution_id, result = execution_result.release_value()](ErrorOr<void> sync_result) mutable {
+            if (sync_result.is_error()) {
+                report_error(sync_result.release_error(), execution_id);
+                return;
+            }
+            send_results(execution_id, move(result));
+        });
+    });
 
-        auto result = execution_result.release_value();
+    return execution_id;
+}
 
-        if (should_send_result_rows(result)) {
-            client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), true, 0, 0, 0);
+void SQLStatement::send_results(SQL::ExecutionID execution_id, SQL::ResultSet result)
+{
+    auto client_connection = ConnectionFromClient::client_connection_for(connection()->client_id());
+    if (!client_connection) {
+        warnln("Cannot return statement execution results. Client disconnected");
+        return;
+    }
 
-            auto result_size = result.size();
-            next(execution_id, move(result), result_size);
-        } else {
-            if (result.command() == SQL::SQLCommand::Insert)
-                client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, result.size(), 0, 0);
-            else if (result.command() == SQL::SQLCommand::Update)
-                client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, result.size(), 0);
-            else if (result.command() == SQL::SQLCommand::Delete)
-                client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, 0, result.size());
-            else
-                client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, 0, 0);
-        }
-    });
+    if (should_send_result_rows(result)) {
+        client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), true, 0, 0, 0);
 
-    return execution_id;
+        auto result_size = result.size();
+        next(execution_id, move(result), result_size);
+    } else {
+        if (result.command() == SQL::SQLCommand::Insert)
+            client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, result.size(), 0, 0);
+        else if (result.command() == SQL::SQLCommand::Update)
+            client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, result.size(), 0);
+        else if (result.command() == SQL::SQLCommand::Delete)
+            client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, 0, result.size());
+        else
+            client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, 0, 0);
+    }
 }
 
 bool SQLStatement::should_send_result_rows(SQL::ResultSet const& result) const
@@ -112,13 +112,37 @@ ErrorOr<void> Service::handle_socket_connection()
 
 ErrorOr<void> Service::activate()
 {
+    extern Core::ElapsedTimer g_startup_timer;
+
     VERIFY(m_pid < 0);
 
-    if (m_lazy)
-        setup_notifier();
-    else
-        TRY(spawn());
-    return {};
+    bool is_first_activation = !m_activated_at.has_value();
+    if (is_first_activation)
+        m_activated_at = g_startup_timer.elapsed_time();
+
+    auto result = [&]() -> ErrorOr<void> {
+        if (m_lazy)
+            setup_notifier();
+        else
+            TRY(spawn());
+        return {};
+    }();
+
+    if (is_first_activation) {
+        m_activation_duration = g_startup_timer.elapsed_time() - m_activated_at.value();
+        dbgln("{}: activated {} ms after startup, which took {} us", name(), m_activated_at->to_milliseconds(), m_activation_duration.to_microseconds());
+        // A one-shot service that couldn't be started won't ever finish, so let whatever comes after it go ahead.
+        if (result.is_error() && m_one_shot)
+            m_finished_at = m_activated_at;
+    }
+    return result;
+}
+
+bool Service::is_up() const
+{
+    if (m_one_shot)
+        return m_finished_at.has_value();
+    return m_activated_at.has_value();
 }
 
 ErrorOr<void> Service::spawn(int socket_fd)
@@ -239,6 +263,12 @@ ErrorOr<void> Service::did_exit(int exit_code)
     s_service_map.remove(m_pid);
     m_pid = -1;
 
+    if (m_one_shot && !m_finished_at.has_value()) {
+        extern Core::ElapsedTimer g_startup_timer;
+        m_finished_at = g_startup_timer.elapsed_time();
+        dbgln("{}: finished {} ms after startup, {} ms after it was activated", name(), m_finished_at->to_milliseconds(), (m_finished_at.value() - m_activated_at.value()).to_milliseconds());
+    }
+
     if (!m_keep_alive)
         return {};
 
@@ -301,6 +331,12 @@ Service::Service(Core::ConfigFile const& config, StringView name)
     m_system_modes = config.read_entry(name, "SystemModes", "graphical").split(',');
     m_multi_instance = config.read_bool_entry(name, "MultiInstance");
     m_accept_socket_connections = config.read_bool_entry(name, "AcceptSocketConnections");
+    m_one_shot = config.read_bool_entry(name, "OneShot");
+
+    for (auto& dependency : config.read_entry(name, "After").split(',')) {
+        if (auto trimmed_dependency = dependency.trim_whitespace(); !trimmed_dependency.is_empty())
+            m_dependencies.append(move(trimmed_dependency));
+    }
 
     DeprecatedString socket_entry = config.read_entry(name, "Socket");
     DeprecatedString socket_permissions_entry = config.read_entry(name, "SocketPermissions", "0600");
@@ -336,6 +372,8 @@ Service::Service(Core::ConfigFile const& config, StringView name)
     VERIFY(!m_accept_socket_connections || (m_sockets.size() == 1 && m_lazy && m_multi_instance));
     // MultiInstance doesn't work with KeepAlive.
     VERIFY(!m_multi_instance || !m_keep_alive);
+    // OneShot services exit on their own, so they can't be kept alive or wait for connections.
+    VERIFY(!m_one_shot || (!m_keep_alive && !m_lazy && !m_multi_instance));
 }
 
 ErrorOr<NonnullRefPtr<Service>> Service::try_create(Core::ConfigFile const& config, StringView name)
@@ -393,6 +431,18 @@ void Service::save_to(JsonObject& json)
         json.set("pid", nullptr);
 
     json.set("restart_attempts", m_restart_attempts);
+
+    JsonArray dependencies;
+    for (auto& dependency : m_dependencies)
+        dependencies.append(dependency);
+    json.set("dependencies", move(dependencies));
+    json.set("one_shot", m_one_shot);
+    if (m_activated_at.has_value()) {
+        json.set("activated_at_ms", m_activated_at->to_milliseconds());
+        json.set("activation_duration_us", m_activation_duration.to_microseconds());
+    }
+    if (m_finished_at.has_value())
+        json.set("finished_at_ms", m_finished_at->to_milliseconds());
     json.set("working_directory", m_working_directory);
 }
 
@@ -26,6 +26,14 @@ public:
 
     static Service* find_by_pid(pid_t);
 
+    // The services that have to be up before this one is activated.
+    Vector<DeprecatedString> const& dependencies() const { return m_dependencies; }
+    void clear_dependencies() { m_dependencies.clear(); }
+
+    bool is_activated() const { return m_activated_at.has_value(); }
+    // Whether the services that come after this one can be activated. One-shot services have to be done first.
+    bool is_up() const;
+
     // FIXME: Port to Core::Property
     void save_to(JsonObject&);
 
@@ -74,6 +82,10 @@ private:
     DeprecatedString m_environment;
     // Socket descriptors for this service.
     Vector<SocketDescriptor> m_sockets;
+    // Names of the services that have to be up before this one is activated.
+    Vector<DeprecatedString> m_dependencies;
+    // Whether the service does its work and exits, instead of staying around.
+    bool m_one_shot { false };
 
     // The resolved user account to run this service as.
     Optional<Core::Account> m_account;
@@ -88,6 +100,12 @@ private:
     // times where it has exited unsuccessfully and too quickly.
     int m_restart_attempts { 0 };
 
+    // When the service was first activated, and when a one-shot service has exited, counted from the start of
+    // SystemServer. These are logged to find out what holds up booting.
+    Optional<Time> m_activated_at;
+    Time m_activation_duration;
+    Optional<Time> m_finished_at;
+
     ErrorOr<void> setup_socket(SocketDescriptor&);
     ErrorOr<void> setup_sockets();
     void setup_notifier();
@@ -9,12 +9,15 @@
 #include <AK/Assertions.h>
 #include <AK/ByteBuffer.h>
 #include <AK/Debug.h>
+#include <AK/AllOf.h>
+#include <AK/HashMap.h>
 #include <AK/String.h>
 #include <Kernel/API/DeviceEvent.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/ConfigFile.h>
 #include <LibCore/DeprecatedFile.h>
 #include <LibCore/DirIterator.h>
+#include <LibCore/ElapsedTimer.h>
 #include <LibCore/Event.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/System.h>
@@ -32,6 +35,9 @@
 
 DeprecatedString g_system_mode = "graphical";
 NonnullRefPtrVector<Service> g_services;
+Core::ElapsedTimer g_startup_timer;
+
+static void activate_ready_services();
 
 // NOTE: This handler ensures that the destructor of g_services is called.
 static void sigterm_handler(int)
@@ -61,7 +67,82 @@ static void sigchld_handler(int)
 
         if (auto result = service->did_exit(status); result.is_error())
             dbgln("{}: {}", service->name(), result.release_error());
+
+        // This may have been a one-shot service that others were waiting for.
+        activate_ready_services();
+    }
+}
+
+static Service* find_service_by_name(StringView name)
+{
+    for (auto& service : g_services) {
+        if (service.name() == name)
+            return &service;
+    }
+    return nullptr;
+}
+
+// Drops dependencies that can't ever be satisfied: ones on services that don't exist or aren't enabled in this system
+// mode, and ones that go around in a circle. Everything else is left for activate_ready_services() to sort out.
+static void resolve_service_dependencies()
+{
+    for (auto& service : g_services) {
+        for (auto& dependency : service.dependencies()) {
+            if (!find_service_by_name(dependency)) {
+                dbgln("{}: Ignoring dependency on {}, which isn't an enabled service", service.name(), dependency);
+                service.clear_dependencies();
+                break;
+            }
+        }
     }
+
+    enum class VisitState {
+        Unvisited,
+        Visiting,
+        Visited,
+    };
+    HashMap<Service const*, VisitState> visit_states;
+    Function<bool(Service&)> has_cycle = [&](Service& service) {
+        auto state = visit_states.get(&service).value_or(VisitState::Unvisited);
+        if (state == VisitState::Visiting)
+            return true;
+        if (state == VisitState::Visited)
+            return false;
+        visit_states.set(&service, VisitState::Visiting);
+        for (auto& dependency : service.dependencies()) {
+            if (has_cycle(*find_service_by_name(dependency))) {
+                dbgln("{}: Ignoring dependencies, as they go around in a circle through {}", service.name(), dependency);
+                service.clear_dependencies();
+                break;
+            }
+        }
+        visit_states.set(&service, VisitState::Visited);
+        return false;
+    };
+    for (auto& service : g_services)
+        (void)has_cycle(service);
+}
+
+// Activates every service that isn't waiting for any other service to come up first. Services that don't depend on
+// each other are all started right away, without waiting for any of the others to be done.
+static void activate_ready_services()
+{
+    bool activated_any;
+    do {
+        activated_any = false;
+        for (auto& service : g_services) {
+            if (service.is_activated())
+                continue;
+            bool is_ready = all_of(service.dependencies(), [](auto& dependency) {
+                return find_service_by_name(dependency)->is_up();
+            });
+            if (!is_ready)
+                continue;
+            if (auto result = service.activate(); result.is_error())
+                dbgln("{}: {}", service.name(), result.release_error());
+            activated_any = true;
+        }
+    } while (activated_any);
 }
 
 static ErrorOr<void> determine_system_mode()
@@ -510,6 +591,8 @@ static ErrorOr<void> create_tmp_semaphore_directory()
 
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
+    g_startup_timer.start();
+
     bool user = false;
     Core::ArgsParser args_parser;
     args_parser.add_option(user, "Run in user-mode", "user", 'u');
@@ -547,10 +630,8 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     // After we've set them all up, activate them!
     dbgln("Activating {} services...", g_services.size());
-    for (auto& service : g_services) {
-        if (auto result = service.activate(); result.is_error())
-            dbgln("{}: {}", service.name(), result.release_error());
-    }
+    resolve_service_dependencies();
+    activate_ready_services();
 
     return event_loop.exec();
 }
@@ -227,6 +227,23 @@ void ConnectionFromClient::debug_request(DeprecatedString const& request, Deprec
         }
     }
 
+    if (request == "js-profiler") {
+        if (argument == "on") {
+            if (!m_js_profiler) {
+                m_js_profiler = make<JS::SamplingProfiler>(Web::Bindings::main_thread_vm());
+                m_js_profiler->start();
+            }
+        } else if (m_js_profiler) {
+            m_js_profiler->stop();
+            StringBuilder builder;
+            if (auto result = m_js_profiler->write_perfcore_json(builder, "/bin/WebContent"sv); result.is_error())
+                dbgln("Failed to write JS profile: {}", result.error());
+            else
+                async_did_get_js_profile(builder.to_deprecated_string());
+            m_js_profiler = nullptr;
+        }
+    }
+
     if (request == "collect-garbage") {
         Web::Bindings::main_thread_vm().heap().collect_garbage(JS::Heap::CollectionType::CollectGarbage, true);
     }
@@ -12,6 +12,7 @@
 #include <LibIPC/ConnectionFromClient.h>
 #include <LibJS/Forward.h>
 #include <LibJS/Heap/Handle.h>
+#include <LibJS/Runtime/SamplingProfiler.h>
 #include <LibWeb/CSS/PreferredColorScheme.h>
 #include <LibWeb/Forward.h>
 #include <LibWeb/Loader/FileRequest.h>
@@ -117,6 +118,8 @@ private:
     OwnPtr<WebContentConsoleClient> m_console_client;
     JS::Handle<JS::GlobalObject> m_console_global_object;
 
+    OwnPtr<JS::SamplingProfiler> m_js_profiler;
+
     HashMap<int, Web::FileRequest> m_requested_files {};
     int last_id { 0 };
 };
@@ -10,19 +10,32 @@
 
 namespace WebContent {
 
+// Images are spread over up to this many ImageDecoder processes, so that they can be decoded in parallel.
+static constexpr size_t max_decoder_count = 4;
+
 ImageCodecPluginSerenity::ImageCodecPluginSerenity() = default;
 ImageCodecPluginSerenity::~ImageCodecPluginSerenity() = default;
 
-Optional<Web::Platform::DecodedImage> ImageCodecPluginSerenity::decode_image(ReadonlyBytes bytes)
+ImageDecoderClient::Client& ImageCodecPluginSerenity::least_busy_client()
 {
-    if (!m_client) {
-        m_client = ImageDecoderClient::Client::try_create().release_value_but_fixme_should_propagate_errors();
-        m_client->on_death = [&] {
-            m_client = nullptr;
-        };
+    RefPtr<ImageDecoderClient::Client> least_busy;
+    for (auto& client : m_clients) {
+        if (!least_busy || client->pending_decode_count() < least_busy->pending_decode_count())
+            least_busy = client;
     }
+    if (least_busy && (least_busy->pending_decode_count() == 0 || m_clients.size() >= max_decoder_count))
+        return *least_busy;
+
+    auto client = ImageDecoderClient::Client::try_create().release_value_but_fixme_should_propagate_errors();
+    client->on_death = [this, client = client.ptr()] {
+        m_clients.remove_first_matching([&](auto& it) { return it.ptr() == client; });
+    };
+    m_clients.append(client);
+    return *client;
+}
 
-    auto result_or_empty = m_client->decode_image(bytes);
+static Optional<Web::Platform::DecodedImage> to_web_decoded_image(Optional<ImageDecoderClient::DecodedImage> result_or_empty)
+{
     if (!result_or_empty.has_value())
         return {};
     auto result = result_or_empty.release_value();
@@ -37,4 +50,16 @@ Optional<Web::Platform::DecodedImage> ImageCodecPluginSerenity::decode_image(Rea
     return decoded_image;
 }
 
+Optional<Web::Platform::DecodedImage> ImageCodecPluginSerenity::decode_image(ReadonlyBytes bytes)
+{
+    return to_web_decoded_image(least_busy_client().decode_image(bytes));
+}
+
+void ImageCodecPluginSerenity::decode_image_async(ReadonlyBytes bytes, Function<void(Optional<Web::Platform::DecodedImage>)> on_complete)
+{
+    least_busy_client().decode_image_async(bytes, [on_complete = move(on_complete)](auto result) {
+        on_complete(to_web_decoded_image(move(result)));
+    });
+}
+
 }
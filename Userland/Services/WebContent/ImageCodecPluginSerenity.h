@@ -7,7 +7,8 @@
 
 #pragma once
 
-#include <AK/RefPtr.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Vector.h>
 #include <LibWeb/Platform/ImageCodecPlugin.h>
 
 namespace ImageDecoderClient {
@@ -22,9 +23,12 @@ public:
     virtual ~ImageCodecPluginSerenity() override;
 
     virtual Optional<Web::Platform::DecodedImage> decode_image(ReadonlyBytes) override;
+    virtual void decode_image_async(ReadonlyBytes, Function<void(Optional<Web::Platform::DecodedImage>)> on_complete) override;
 
 private:
-    RefPtr<ImageDecoderClient::Client> m_client;
+    ImageDecoderClient::Client& least_busy_client();
+
+    Vector<NonnullRefPtr<ImageDecoderClient::Client>> m_clients;
 };
 
 }
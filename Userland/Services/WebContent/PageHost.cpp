@@ -36,6 +36,7 @@ PageHost::~PageHost() = default;
 void PageHost::set_has_focus(bool has_focus)
 {
     m_has_focus = has_focus;
+    m_last_painted_frame.clear();
 }
 
 void PageHost::setup_palette()
@@ -48,6 +49,7 @@ void PageHost::setup_palette()
     theme->color[(int)Gfx::ColorRole::Window] = Color::Magenta;
     theme->color[(int)Gfx::ColorRole::WindowText] = Color::Cyan;
     m_palette_impl = Gfx::PaletteImpl::create_with_anonymous_buffer(buffer);
+    m_last_painted_frame.clear();
 }
 
 bool PageHost::is_connection_open() const
@@ -63,6 +65,7 @@ Gfx::Palette PageHost::palette() const
 void PageHost::set_palette_impl(Gfx::PaletteImpl& impl)
 {
     m_palette_impl = impl;
+    m_last_painted_frame.clear();
     if (auto* document = page().top_level_browsing_context().active_document())
         document->invalidate_style();
 }
@@ -70,6 +73,7 @@ void PageHost::set_palette_impl(Gfx::PaletteImpl& impl)
 void PageHost::set_preferred_color_scheme(Web::CSS::PreferredColorScheme color_scheme)
 {
     m_preferred_color_scheme = color_scheme;
+    m_last_painted_frame.clear();
     if (auto* document = page().top_level_browsing_context().active_document())
         document->invalidate_style();
 }
@@ -115,6 +119,7 @@ void PageHost::paint(Web::DevicePixelRect const& content_rect, Gfx::Bitmap& targ
     auto* layout_root = this->layout_root();
     if (!layout_root) {
         painter.fill_rect(bitmap_rect, palette().base());
+        m_last_painted_frame.clear();
         return;
     }
 
@@ -122,9 +127,69 @@ void PageHost::paint(Web::DevicePixelRect const& content_rect, Gfx::Bitmap& targ
     context.set_should_show_line_box_borders(m_should_show_line_box_borders);
     context.set_device_viewport_rect(content_rect);
     context.set_has_focus(m_has_focus);
+
+    if (paint_by_reusing_last_painted_frame(context, content_rect.to_type<int>(), target))
+        return;
+
+    m_last_painted_frame = PaintedFrame { target, content_rect.to_type<int>() };
     layout_root->paint_all_phases(context);
 }
 
+// Past this many damaged rects, painting each of them separately costs more than painting everything once.
+static constexpr size_t max_rects_to_repaint = 8;
+
+static bool has_content_fixed_to_viewport(Web::Layout::Viewport const& layout_root)
+{
+    bool found = false;
+    layout_root.for_each_in_inclusive_subtree_of_type<Web::Layout::NodeWithStyle>([&](auto const& node) {
+        auto const& background_layers = node.background_layers();
+        bool has_fixed_background = any_of(background_layers, [](auto const& layer) { return layer.attachment == Web::CSS::BackgroundAttachment::Fixed; });
+        if (node.is_fixed_position() || has_fixed_background) {
+            found = true;
+            return IterationDecision::Break;
+        }
+        return IterationDecision::Continue;
+    });
+    return found;
+}
+
+bool PageHost::paint_by_reusing_last_painted_frame(Web::PaintContext& context, Gfx::IntRect const& content_rect, Gfx::Bitmap& target)
+{
+    if (!m_last_painted_frame.has_value())
+        return false;
+    auto last_painted_frame = m_last_painted_frame.release_value();
+    if (last_painted_frame.bitmap.ptr() == &target || last_painted_frame.bitmap->size() != target.size() || last_painted_frame.content_rect.size() != content_rect.size())
+        return false;
+
+    auto still_visible_rect = content_rect.intersected(last_painted_frame.content_rect);
+    if (still_visible_rect.is_empty())
+        return false;
+
+    // NOTE: Content fixed to the viewport doesn't move along with the rest of the page, so it can't be reused after scrolling.
+    if (content_rect != last_painted_frame.content_rect && has_content_fixed_to_viewport(*layout_root()))
+        return false;
+
+    Gfx::DisjointRectSet<int> rects_to_repaint;
+    rects_to_repaint.add_many(content_rect.shatter(still_visible_rect));
+    for (auto const& damaged_rect : last_painted_frame.damage.rects())
+        rects_to_repaint.add(damaged_rect.intersected(content_rect));
+    if (rects_to_repaint.size() > max_rects_to_repaint)
+        return false;
+
+    // NOTE: We only remember the new frame before painting, so that anything invalidated while painting is repainted next time.
+    m_last_painted_frame = PaintedFrame { target, content_rect };
+
+    auto& painter = context.painter();
+    painter.blit(still_visible_rect.location() - content_rect.location(), last_painted_frame.bitmap, still_visible_rect.translated(-last_painted_frame.content_rect.location()), 1.0f, false);
+
+    for (auto const& rect_to_repaint : rects_to_repaint.rects()) {
+        Gfx::PainterStateSaver saver(painter);
+        painter.add_clip_rect(rect_to_repaint.translated(-content_rect.location()));
+        layout_root()->paint_all_phases(context);
+    }
+    return true;
+}
+
 void PageHost::set_viewport_rect(Web::DevicePixelRect const& rect)
 {
     page().top_level_browsing_context().set_viewport_rect(page().device_to_css_rect(rect));
@@ -132,7 +197,13 @@ void PageHost::set_viewport_rect(Web::DevicePixelRect const& rect)
 
 void PageHost::page_did_invalidate(Web::CSSPixelRect const& content_rect)
 {
-    m_invalidation_rect = m_invalidation_rect.united(page().enclosing_device_rect(content_rect));
+    auto device_rect = page().enclosing_device_rect(content_rect);
+    if (m_last_painted_frame.has_value()) {
+        m_last_painted_frame->damage.add(device_rect.to_type<int>());
+        if (m_last_painted_frame->damage.size() > max_rects_to_repaint)
+            m_last_painted_frame.clear();
+    }
+    m_invalidation_rect = m_invalidation_rect.united(device_rect);
     if (!m_invalidation_coalescing_timer->is_active())
         m_invalidation_coalescing_timer->start();
 }
@@ -149,6 +220,7 @@ void PageHost::page_did_request_cursor_change(Gfx::StandardCursor cursor)
 
 void PageHost::page_did_layout()
 {
+    m_last_painted_frame.clear();
     auto* layout_root = this->layout_root();
     VERIFY(layout_root);
     if (layout_root->paint_box()->has_overflow())
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <LibGfx/DisjointRectSet.h>
 #include <LibGfx/Rect.h>
 #include <LibWeb/Page/Page.h>
 #include <LibWeb/PixelUnits.h>
@@ -32,9 +33,17 @@ public:
     void set_palette_impl(Gfx::PaletteImpl&);
     void set_viewport_rect(Web::DevicePixelRect const&);
     void set_screen_rects(Vector<Gfx::IntRect, 4> const& rects, size_t main_screen_index) { m_screen_rect = rects[main_screen_index].to_type<Web::DevicePixels>(); }
-    void set_device_pixels_per_css_pixel(float device_pixels_per_css_pixel) { m_device_pixels_per_css_pixel = device_pixels_per_css_pixel; }
+    void set_device_pixels_per_css_pixel(float device_pixels_per_css_pixel)
+    {
+        m_device_pixels_per_css_pixel = device_pixels_per_css_pixel;
+        m_last_painted_frame.clear();
+    }
     void set_preferred_color_scheme(Web::CSS::PreferredColorScheme);
-    void set_should_show_line_box_borders(bool b) { m_should_show_line_box_borders = b; }
+    void set_should_show_line_box_borders(bool b)
+    {
+        m_should_show_line_box_borders = b;
+        m_last_painted_frame.clear();
+    }
     void set_has_focus(bool);
     void set_is_scripting_enabled(bool);
     void set_window_position(Web::DevicePixelPoint);
@@ -104,6 +113,8 @@ private:
     Web::Layout::Viewport* layout_root();
     void setup_palette();
 
+    bool paint_by_reusing_last_painted_frame(Web::PaintContext&, Gfx::IntRect const& content_rect, Gfx::Bitmap& target);
+
     ConnectionFromClient& m_client;
     NonnullOwnPtr<Web::Page> m_page;
     RefPtr<Gfx::PaletteImpl> m_palette_impl;
@@ -115,6 +126,15 @@ private:
 
     RefPtr<Web::Platform::Timer> m_invalidation_coalescing_timer;
     Web::DevicePixelRect m_invalidation_rect;
+
+    // The most recently painted frame, along with the parts of the page that were invalidated since it was painted.
+    // As long as the damage stays small, the next paint can reuse the rest of it instead of painting everything again.
+    struct PaintedFrame {
+        NonnullRefPtr<Gfx::Bitmap> bitmap;
+        Gfx::IntRect content_rect;
+        Gfx::DisjointRectSet<int> damage {};
+    };
+    Optional<PaintedFrame> m_last_painted_frame;
     Web::CSS::PreferredColorScheme m_preferred_color_scheme { Web::CSS::PreferredColorScheme::Auto };
 
     RefPtr<WebDriverConnection> m_webdriver;
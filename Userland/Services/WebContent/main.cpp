@@ -12,6 +12,7 @@
 #include <LibCore/System.h>
 #include <LibIPC/SingleServer.h>
 #include <LibMain/Main.h>
+#include <LibWeb/CSS/StyleComputer.h>
 #include <LibWeb/Loader/ResourceLoader.h>
 #include <LibWeb/Platform/EventLoopPlugin.h>
 #include <LibWeb/Platform/EventLoopPluginSerenity.h>
@@ -47,5 +48,10 @@ ErrorOr<int> serenity_main(Main::Arguments)
     Web::ResourceLoader::initialize(TRY(WebView::RequestServerAdapter::try_create()));
 
     auto client = TRY(IPC::take_over_accepted_client_from_system_server<WebContent::ConnectionFromClient>());
+
+    // NOTE: The browser may start us well before it has a page for us to load, so get the expensive parts of
+    //       setting up out of the way now. Creating the client above has already set up a realm with its intrinsics.
+    Web::CSS::StyleComputer::load_user_agent_style_sheets();
+
     return event_loop.exec();
 }
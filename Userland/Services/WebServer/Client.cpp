@@ -19,24 +19,30 @@
 #include <LibCore/File.h>
 #include <LibCore/MappedFile.h>
 #include <LibCore/MimeData.h>
+#include <LibCore/System.h>
 #include <LibHTTP/HttpRequest.h>
 #include <LibHTTP/HttpResponse.h>
 #include <WebServer/Client.h>
 #include <WebServer/Configuration.h>
+#include <WebServer/FileCache.h>
 #include <stdio.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
 namespace WebServer {
 
+static constexpr int keep_alive_timeout_ms = 10'000;
+
 Client::Client(NonnullOwnPtr<Core::BufferedTCPSocket> socket, Core::Object* parent)
     : Core::Object(parent)
     , m_socket(move(socket))
 {
+    m_idle_timer = Core::Timer::create_single_shot(keep_alive_timeout_ms, [this] { die(); }, this).release_value_but_fixme_should_propagate_errors();
 }
 
 void Client::die()
 {
+    m_idle_timer->stop();
     m_socket->close();
     deferred_invoke([this] { remove_from_parent(); });
 }
@@ -44,7 +50,7 @@ void Client::die()
 void Client::start()
 {
     m_socket->on_ready_to_read = [this] {
-        StringBuilder builder;
+        m_idle_timer->stop();
 
         auto maybe_buffer = ByteBuffer::create_uninitialized(m_socket->buffer_size());
         if (maybe_buffer.is_error()) {
@@ -65,7 +71,7 @@ void Client::start()
             if (!maybe_can_read.value())
                 break;
 
-            auto maybe_bytes_read = m_socket->read_until_any_of(buffer, Array { "\r"sv, "\n"sv, "\r\n"sv });
+            auto maybe_bytes_read = m_socket->read_until(buffer, "\n"sv);
             if (maybe_bytes_read.is_error()) {
                 warnln("Failed to read a line from the request: {}", maybe_bytes_read.error());
                 die();
@@ -74,23 +80,83 @@ void Client::start()
 
             if (m_socket->is_eof()) {
                 die();
-                break;
+                return;
             }
 
-            builder.append(StringView { maybe_bytes_read.value() });
-            builder.append("\r\n"sv);
+            // We don't accept requests with a body, so a request ends with the first empty line.
+            auto line = StringView { maybe_bytes_read.value() }.trim("\r"sv, TrimMode::Right);
+            if (!line.is_empty()) {
+                m_request_builder.append(line);
+                m_request_builder.append("\r\n"sv);
+                continue;
+            }
+            if (m_request_builder.is_empty())
+                continue;
+            m_request_builder.append("\r\n"sv);
+
+            auto request = m_request_builder.to_byte_buffer();
+            m_request_builder.clear();
+            dbgln_if(WEBSERVER_DEBUG, "Got raw request: '{}'", DeprecatedString::copy(request));
+
+            m_keep_alive = false;
+            auto maybe_did_handle = handle_request(request);
+            if (maybe_did_handle.is_error()) {
+                warnln("Failed to handle the request: {}", maybe_did_handle.error());
+                m_keep_alive = false;
+            }
+
+            if (!m_keep_alive) {
+                die();
+                return;
+            }
         }
 
-        auto request = builder.to_byte_buffer();
-        dbgln_if(WEBSERVER_DEBUG, "Got raw request: '{}'", DeprecatedString::copy(request));
+        m_idle_timer->start();
+    };
+}
 
-        auto maybe_did_handle = handle_request(request);
-        if (maybe_did_handle.is_error()) {
-            warnln("Failed to handle the request: {}", maybe_did_handle.error());
+// A client asking for several ranges at once gets the whole content instead, which RFC9110 section 14.2 allows.
+static Optional<Client::ByteRange> parse_range_header(StringView value, size_t length, bool& is_satisfiable)
+{
+    is_satisfiable = true;
+    if (!value.starts_with("bytes="sv) || value.contains(','))
+        return {};
+
+    auto parts = value.substring_view(6).trim_whitespace().split_view('-', SplitBehavior::KeepEmpty);
+    if (parts.size() != 2)
+        return {};
+
+    Client::ByteRange range;
+    if (parts[0].is_empty()) {
+        // A suffix range, for the last N bytes.
+        auto suffix_length = parts[1].to_uint<u64>();
+        if (!suffix_length.has_value())
+            return {};
+        if (*suffix_length == 0 || length == 0) {
+            is_satisfiable = false;
+            return {};
         }
+        range.first = length - min(*suffix_length, static_cast<u64>(length));
+        range.last = length - 1;
+        return range;
+    }
 
-        die();
-    };
+    auto first = parts[0].to_uint<u64>();
+    if (!first.has_value())
+        return {};
+    Optional<u64> last;
+    if (!parts[1].is_empty()) {
+        last = parts[1].to_uint<u64>();
+        if (!last.has_value() || *last < *first)
+            return {};
+    }
+    if (*first >= length) {
+        is_satisfiable = false;
+        return {};
+    }
+    range.first = *first;
+    range.last = min(last.value_or(length - 1), static_cast<u64>(length - 1));
+    return range;
 }
 
 ErrorOr<bool> Client::handle_request(ReadonlyBytes raw_request)
@@ -101,6 +167,19 @@ ErrorOr<bool> Client::handle_request(ReadonlyBytes raw_request)
     auto& request = request_or_error.value();
     auto resource_decoded = URL::percent_decode(request.resource());
 
+    // HTTP/1.1 connections stay open unless the client asks otherwise, HTTP/1.0 ones only if the client asks for it.
+    auto request_line = StringView { raw_request };
+    if (auto end_of_line = request_line.find("\r\n"sv); end_of_line.has_value())
+        request_line = request_line.substring_view(0, *end_of_line);
+    m_keep_alive = !request_line.ends_with("HTTP/1.0"sv);
+    if (auto it = request.headers().find_if([](auto& header) { return header.name.equals_ignoring_case("Connection"sv); }); !it.is_end()) {
+        auto value = it->value.trim_whitespace();
+        if (value.equals_ignoring_case("keep-alive"sv))
+            m_keep_alive = true;
+        else if (value.equals_ignoring_case("close"sv))
+            m_keep_alive = false;
+    }
+
     if constexpr (WEBSERVER_DEBUG) {
         dbgln("Got HTTP request: {} {}", request.method_name(), request.resource());
         for (auto& header : request.headers()) {
@@ -109,6 +188,8 @@ ErrorOr<bool> Client::handle_request(ReadonlyBytes raw_request)
     }
 
     if (request.method() != HTTP::HttpRequest::Method::GET) {
+        // The request may have a body, which we'd otherwise take for the next request.
+        m_keep_alive = false;
         TRY(send_error_response(501, request));
         return false;
     }
@@ -167,33 +248,104 @@ ErrorOr<bool> Client::handle_request(ReadonlyBytes raw_request)
     }
 
     auto stream = TRY(Core::File::open(real_path.bytes_as_string_view(), Core::File::OpenMode::Read));
+    auto st = TRY(Core::System::fstat(stream->fd()));
 
     auto const info = ContentInfo {
         .type = TRY(String::from_utf8(Core::guess_mime_type_based_on_filename(real_path.bytes_as_string_view()))),
-        .length = TRY(Core::DeprecatedFile::size(real_path.bytes_as_string_view()))
+        .length = static_cast<size_t>(st.st_size),
+        .accepts_ranges = true,
     };
-    TRY(send_response(*stream, request, move(info)));
+
+    Optional<ByteRange> range;
+    if (auto it = request.headers().find_if([](auto& header) { return header.name.equals_ignoring_case("Range"sv); }); !it.is_end()) {
+        bool is_satisfiable = true;
+        range = parse_range_header(it->value, info.length, is_satisfiable);
+        if (!is_satisfiable) {
+            Vector<String> headers {};
+            TRY(headers.try_append(TRY(String::formatted("Content-Range: bytes */{}", info.length))));
+            TRY(send_error_response(416, request, move(headers)));
+            return false;
+        }
+    }
+
+    if (info.length <= FileCache::maximum_file_size) {
+        auto contents = TRY(FileCache::the().contents(real_path.to_deprecated_string(), *stream, st));
+        TRY(send_cached_file_response(contents, request, move(info), range));
+        return true;
+    }
+
+    TRY(send_file_response(*stream, request, move(info), range));
     return true;
 }
 
-ErrorOr<void> Client::send_response(Stream& response, HTTP::HttpRequest const& request, ContentInfo content_info)
+ErrorOr<void> Client::send_response_header(HTTP::HttpRequest const& request, ContentInfo const& content_info, Optional<ByteRange> const& range)
 {
     StringBuilder builder;
-    builder.append("HTTP/1.0 200 OK\r\n"sv);
+    if (range.has_value())
+        builder.append("HTTP/1.1 206 Partial Content\r\n"sv);
+    else
+        builder.append("HTTP/1.1 200 OK\r\n"sv);
     builder.append("Server: WebServer (SerenityOS)\r\n"sv);
     builder.append("X-Frame-Options: SAMEORIGIN\r\n"sv);
     builder.append("X-Content-Type-Options: nosniff\r\n"sv);
     builder.append("Pragma: no-cache\r\n"sv);
+    builder.append(m_keep_alive ? "Connection: keep-alive\r\n"sv : "Connection: close\r\n"sv);
     if (content_info.type == "text/plain")
         builder.appendff("Content-Type: {}; charset=utf-8\r\n", content_info.type);
     else
         builder.appendff("Content-Type: {}\r\n", content_info.type);
-    builder.appendff("Content-Length: {}\r\n", content_info.length);
+    if (content_info.accepts_ranges)
+        builder.append("Accept-Ranges: bytes\r\n"sv);
+    if (range.has_value()) {
+        builder.appendff("Content-Range: bytes {}-{}/{}\r\n", range->first, range->last, content_info.length);
+        builder.appendff("Content-Length: {}\r\n", range->last - range->first + 1);
+    } else {
+        builder.appendff("Content-Length: {}\r\n", content_info.length);
+    }
     builder.append("\r\n"sv);
 
     auto builder_contents = builder.to_byte_buffer();
-    TRY(m_socket->write(builder_contents));
-    log_response(200, request);
+    TRY(m_socket->write_entire_buffer(builder_contents));
+    log_response(range.has_value() ? 206 : 200, request);
+    return {};
+}
+
+ErrorOr<void> Client::send_file_response(Core::File& file, HTTP::HttpRequest const& request, ContentInfo content_info, Optional<ByteRange> const& range)
+{
+    auto socket_fd = m_socket->fd();
+    if (!socket_fd.has_value())
+        return send_response(file, request, move(content_info));
+
+    TRY(send_response_header(request, content_info, range));
+
+    // Let the kernel move the file contents straight to the socket, instead of copying them through our own buffer.
+    off_t offset = range.has_value() ? range->first : 0;
+    auto remaining = range.has_value() ? range->last - range->first + 1 : content_info.length;
+    while (remaining > 0) {
+        auto nsent = TRY(Core::System::sendfile(socket_fd.value(), file.fd(), &offset, remaining));
+        if (nsent == 0)
+            break;
+        remaining -= nsent;
+    }
+
+    // The client is still waiting for what's left, so there's no way to carry on with this connection.
+    if (remaining > 0)
+        m_keep_alive = false;
+    return {};
+}
+
+ErrorOr<void> Client::send_cached_file_response(ReadonlyBytes contents, HTTP::HttpRequest const& request, ContentInfo content_info, Optional<ByteRange> const& range)
+{
+    TRY(send_response_header(request, content_info, range));
+    if (range.has_value())
+        contents = contents.slice(range->first, range->last - range->first + 1);
+    TRY(m_socket->write_entire_buffer(contents));
+    return {};
+}
+
+ErrorOr<void> Client::send_response(Stream& response, HTTP::HttpRequest const& request, ContentInfo content_info)
+{
+    TRY(send_response_header(request, content_info));
 
     char buffer[PAGE_SIZE];
     do {
@@ -213,24 +365,18 @@ ErrorOr<void> Client::send_response(Stream& response, HTTP::HttpRequest const& r
         }
     } while (true);
 
-    auto keep_alive = false;
-    if (auto it = request.headers().find_if([](auto& header) { return header.name.equals_ignoring_case("Connection"sv); }); !it.is_end()) {
-        if (it->value.trim_whitespace().equals_ignoring_case("keep-alive"sv))
-            keep_alive = true;
-    }
-    if (!keep_alive)
-        m_socket->close();
-
     return {};
 }
 
 ErrorOr<void> Client::send_redirect(StringView redirect_path, HTTP::HttpRequest const& request)
 {
     StringBuilder builder;
-    builder.append("HTTP/1.0 301 Moved Permanently\r\n"sv);
+    builder.append("HTTP/1.1 301 Moved Permanently\r\n"sv);
     builder.append("Location: "sv);
     builder.append(redirect_path);
     builder.append("\r\n"sv);
+    builder.append(m_keep_alive ? "Connection: keep-alive\r\n"sv : "Connection: close\r\n"sv);
+    builder.append("Content-Length: 0\r\n"sv);
     builder.append("\r\n"sv);
 
     auto builder_contents = builder.to_byte_buffer();
@@ -338,7 +484,7 @@ ErrorOr<void> Client::handle_directory_listing(String const& requested_path, Str
 
     auto response = builder.to_deprecated_string();
     FixedMemoryStream stream { response.bytes() };
-    return send_response(stream, request, { .type = TRY("text/html"_string), .length = response.length() });
+    return send_response(stream, request, { .type = TRY("text/html"_string), .length = response.length(), .accepts_ranges = false });
 }
 
 ErrorOr<void> Client::send_error_response(unsigned code, HTTP::HttpRequest const& request, Vector<String> const& headers)
@@ -352,9 +498,10 @@ ErrorOr<void> Client::send_error_response(unsigned code, HTTP::HttpRequest const
     content_builder.append("</h1></body></html>"sv);
 
     StringBuilder header_builder;
-    header_builder.appendff("HTTP/1.0 {} ", code);
+    header_builder.appendff("HTTP/1.1 {} ", code);
     header_builder.append(reason_phrase);
     header_builder.append("\r\n"sv);
+    header_builder.append(m_keep_alive ? "Connection: keep-alive\r\n"sv : "Connection: close\r\n"sv);
 
     for (auto& header : headers) {
         header_builder.append(header);
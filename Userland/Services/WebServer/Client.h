@@ -8,8 +8,11 @@
 #pragma once
 
 #include <AK/String.h>
+#include <AK/StringBuilder.h>
+#include <LibCore/File.h>
 #include <LibCore/Object.h>
 #include <LibCore/Socket.h>
+#include <LibCore/Timer.h>
 #include <LibHTTP/Forward.h>
 #include <LibHTTP/HttpRequest.h>
 
@@ -21,16 +24,26 @@ class Client final : public Core::Object {
 public:
     void start();
 
+    // The inclusive range of bytes asked for with a Range header.
+    struct ByteRange {
+        size_t first {};
+        size_t last {};
+    };
+
 private:
     Client(NonnullOwnPtr<Core::BufferedTCPSocket>, Core::Object* parent);
 
     struct ContentInfo {
         String type;
         size_t length {};
+        bool accepts_ranges { false };
     };
 
     ErrorOr<bool> handle_request(ReadonlyBytes);
+    ErrorOr<void> send_response_header(HTTP::HttpRequest const&, ContentInfo const&, Optional<ByteRange> const& = {});
     ErrorOr<void> send_response(Stream&, HTTP::HttpRequest const&, ContentInfo);
+    ErrorOr<void> send_file_response(Core::File&, HTTP::HttpRequest const&, ContentInfo, Optional<ByteRange> const&);
+    ErrorOr<void> send_cached_file_response(ReadonlyBytes, HTTP::HttpRequest const&, ContentInfo, Optional<ByteRange> const&);
     ErrorOr<void> send_redirect(StringView redirect, HTTP::HttpRequest const&);
     ErrorOr<void> send_error_response(unsigned code, HTTP::HttpRequest const&, Vector<String> const& headers = {});
     void die();
@@ -39,6 +52,10 @@ private:
     bool verify_credentials(Vector<HTTP::HttpRequest::Header> const&);
 
     NonnullOwnPtr<Core::BufferedTCPSocket> m_socket;
+    StringBuilder m_request_builder;
+    bool m_keep_alive { false };
+    // Closes the connection if the client doesn't send another request for a while.
+    RefPtr<Core::Timer> m_idle_timer;
 };
 
 }
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <WebServer/FileCache.h>
+
+namespace WebServer {
+
+FileCache& FileCache::the()
+{
+    static FileCache s_the;
+    return s_the;
+}
+
+ErrorOr<ReadonlyBytes> FileCache::contents(DeprecatedString const& path, Core::File& file, struct stat const& st)
+{
+    VERIFY(static_cast<size_t>(st.st_size) <= maximum_file_size);
+
+    if (auto it = m_entries.find(path); it != m_entries.end()) {
+        auto& entry = it->value;
+        if (entry.inode == st.st_ino && entry.modification_time == st.st_mtime && entry.contents.size() == static_cast<size_t>(st.st_size)) {
+            entry.last_use = ++m_use_counter;
+            return entry.contents.bytes();
+        }
+        m_total_size -= entry.contents.size();
+        m_entries.remove(it);
+    }
+
+    auto contents = TRY(ByteBuffer::create_uninitialized(st.st_size));
+    TRY(file.read_entire_buffer(contents));
+
+    while (!m_entries.is_empty() && m_total_size + contents.size() > maximum_total_size)
+        evict_least_recently_used();
+
+    m_total_size += contents.size();
+    auto& entry = m_entries.ensure(path);
+    entry = { move(contents), st.st_ino, st.st_mtime, ++m_use_counter };
+    return entry.contents.bytes();
+}
+
+void FileCache::evict_least_recently_used()
+{
+    auto least_recently_used = m_entries.begin();
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+        if (it->value.last_use < least_recently_used->value.last_use)
+            least_recently_used = it;
+    }
+    m_total_size -= least_recently_used->value.contents.size();
+    m_entries.remove(least_recently_used);
+}
+
+}
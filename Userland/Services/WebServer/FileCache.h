@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/DeprecatedString.h>
+#include <AK/HashMap.h>
+#include <LibCore/File.h>
+#include <sys/stat.h>
+
+namespace WebServer {
+
+// Keeps the contents of small files that were served recently, so they can be served again without going to the disk.
+class FileCache {
+public:
+    static constexpr size_t maximum_file_size = 64 * KiB;
+    static constexpr size_t maximum_total_size = 16 * MiB;
+
+    static FileCache& the();
+
+    // Returns the cached contents if the file didn't change since they were cached, and reads them into the cache otherwise.
+    ErrorOr<ReadonlyBytes> contents(DeprecatedString const& path, Core::File&, struct stat const&);
+
+private:
+    struct Entry {
+        ByteBuffer contents;
+        ino_t inode { 0 };
+        time_t modification_time { 0 };
+        u64 last_use { 0 };
+    };
+
+    void evict_least_recently_used();
+
+    HashMap<DeprecatedString, Entry> m_entries;
+    size_t m_total_size { 0 };
+    u64 m_use_counter { 0 };
+};
+
+}
@@ -11,15 +11,43 @@
 #include <LibCore/DeprecatedFile.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/MappedFile.h>
+#include <LibCore/Notifier.h>
+#include <LibCore/SocketAddress.h>
 #include <LibCore/System.h>
-#include <LibCore/TCPServer.h>
 #include <LibHTTP/HttpRequest.h>
 #include <LibMain/Main.h>
 #include <WebServer/Client.h>
 #include <WebServer/Configuration.h>
+#include <netinet/in.h>
 #include <stdio.h>
+#include <sys/socket.h>
 #include <unistd.h>
 
+// The socket is created before the worker processes are forked off, so that they can all accept connections from it.
+static ErrorOr<int> create_listening_socket(IPv4Address const& address, u16 port)
+{
+    int fd = TRY(Core::System::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0));
+    int option = 1;
+    TRY(Core::System::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &option, sizeof(option)));
+
+    auto socket_address = Core::SocketAddress(address, port);
+    auto in = socket_address.to_sockaddr_in();
+    TRY(Core::System::bind(fd, (sockaddr const*)&in, sizeof(in)));
+    TRY(Core::System::listen(fd, 64));
+    return fd;
+}
+
+static ErrorOr<NonnullOwnPtr<Core::BufferedTCPSocket>> accept_client(int listening_fd)
+{
+    sockaddr_in in;
+    socklen_t in_size = sizeof(in);
+    int client_fd = TRY(Core::System::accept4(listening_fd, (sockaddr*)&in, &in_size, SOCK_CLOEXEC));
+    auto client_socket = TRY(Core::TCPSocket::adopt_fd(client_fd));
+    auto buffered_socket = TRY(Core::BufferedTCPSocket::create(move(client_socket)));
+    TRY(buffered_socket->set_blocking(true));
+    return buffered_socket;
+}
+
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
     static auto const default_listen_address = TRY("0.0.0.0"_string);
@@ -31,12 +59,14 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     DeprecatedString username;
     DeprecatedString password;
     DeprecatedString document_root_path = default_document_root_path.to_deprecated_string();
+    int worker_count = 1;
 
     Core::ArgsParser args_parser;
     args_parser.add_option(listen_address, "IP address to listen on", "listen-address", 'l', "listen_address");
     args_parser.add_option(port, "Port to listen on", "port", 'p', "port");
     args_parser.add_option(username, "HTTP basic authentication username", "user", 'U', "username");
     args_parser.add_option(password, "HTTP basic authentication password", "pass", 'P', "password");
+    args_parser.add_option(worker_count, "Number of processes serving clients", "workers", 'w', "count");
     args_parser.add_positional_argument(document_root_path, "Path to serve the contents of", "path", Core::ArgsParser::Required::No);
     args_parser.parse(arguments);
 
@@ -51,6 +81,11 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         return 1;
     }
 
+    if (worker_count < 1) {
+        warnln("Invalid number of workers: {}", worker_count);
+        return 1;
+    }
+
     if (username.is_empty() != password.is_empty()) {
         warnln("Both username and password are required for HTTP basic authentication.");
         return 1;
@@ -62,7 +97,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         return 1;
     }
 
-    TRY(Core::System::pledge("stdio accept rpath inet unix"));
+    TRY(Core::System::pledge("stdio accept rpath inet unix proc"));
 
     Optional<HTTP::HttpRequest::BasicAuthenticationCredentials> credentials;
     if (!username.is_empty() && !password.is_empty())
@@ -70,30 +105,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     WebServer::Configuration configuration(real_document_root_path, credentials);
 
-    Core::EventLoop loop;
-
-    auto server = TRY(Core::TCPServer::try_create());
-
-    server->on_ready_to_accept = [&] {
-        auto maybe_client_socket = server->accept();
-        if (maybe_client_socket.is_error()) {
-            warnln("Failed to accept the client: {}", maybe_client_socket.error());
-            return;
-        }
-
-        auto maybe_buffered_socket = Core::BufferedTCPSocket::create(maybe_client_socket.release_value());
-        if (maybe_buffered_socket.is_error()) {
-            warnln("Could not obtain a buffered socket for the client: {}", maybe_buffered_socket.error());
-            return;
-        }
-
-        // FIXME: Propagate errors
-        MUST(maybe_buffered_socket.value()->set_blocking(true));
-        auto client = WebServer::Client::construct(maybe_buffered_socket.release_value(), server);
-        client->start();
-    };
-
-    TRY(server->listen(ipv4_address.value(), port));
+    int listening_fd = TRY(create_listening_socket(ipv4_address.value(), port));
 
     out("Listening on ");
     out("\033]8;;http://{}:{}\033\\", ipv4_address.value(), port);
@@ -105,6 +117,30 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     TRY(Core::System::unveil(real_document_root_path, "r"sv));
     TRY(Core::System::unveil(nullptr, nullptr));
 
+    // Each worker is a process of its own with its own event loop, whichever one gets to a new connection first serves it.
+    for (int i = 1; i < worker_count; ++i) {
+        if (TRY(Core::System::fork()) == 0)
+            break;
+    }
+
     TRY(Core::System::pledge("stdio accept rpath"));
+
+    Core::EventLoop loop;
+
+    auto listening_notifier = Core::Notifier::construct(listening_fd, Core::Notifier::Event::Read);
+    listening_notifier->on_ready_to_read = [&] {
+        auto maybe_client_socket = accept_client(listening_fd);
+        if (maybe_client_socket.is_error()) {
+            // Another worker got to this connection first.
+            if (maybe_client_socket.error().is_errno() && maybe_client_socket.error().code() == EAGAIN)
+                return;
+            warnln("Failed to accept the client: {}", maybe_client_socket.error());
+            return;
+        }
+
+        auto client = WebServer::Client::construct(maybe_client_socket.release_value(), listening_notifier);
+        client->start();
+    };
+
     return loop.exec();
 }
@@ -181,6 +181,9 @@ void Compositor::compose()
         return;
     }
 
+    if (compose_cursor_only())
+        return;
+
     if (m_occlusions_dirty) {
         m_occlusions_dirty = false;
         recompute_occlusions();
@@ -618,6 +621,54 @@ void Compositor::compose()
     });
 }
 
+// Shattering the dirty areas against windows and against each other leaves lots of small, adjacent rects behind, and
+// the cursor and animations add rects that overlap them. Each rect costs a separate copy and a separate entry in the
+// device flush, so overlaps are removed, rects that line up are joined back together, and if they still cover most of
+// their bounding rect, that is used instead.
+static Vector<Gfx::IntRect, 32> coalesce_flush_rects(CompositorScreenData const& screen_data)
+{
+    auto all_rects = screen_data.m_flush_rects.clone();
+    all_rects.add(screen_data.m_flush_transparent_rects);
+    all_rects.add(screen_data.m_flush_special_rects);
+
+    Vector<Gfx::IntRect, 32> rects;
+    rects.extend(all_rects.rects());
+
+    for (bool joined_any = true; joined_any;) {
+        joined_any = false;
+        for (size_t i = 0; i < rects.size(); ++i) {
+            for (size_t j = i + 1; j < rects.size(); ++j) {
+                auto const& a = rects[i];
+                auto const& b = rects[j];
+                bool const joins_horizontally = a.y() == b.y() && a.height() == b.height() && (a.right() + 1 == b.left() || b.right() + 1 == a.left());
+                bool const joins_vertically = a.x() == b.x() && a.width() == b.width() && (a.bottom() + 1 == b.top() || b.bottom() + 1 == a.top());
+                if (!joins_horizontally && !joins_vertically)
+                    continue;
+                rects[i] = a.united(b);
+                rects.remove(j);
+                joined_any = true;
+                --j;
+            }
+        }
+    }
+
+    if (rects.size() > 1) {
+        Gfx::IntRect bounding_rect;
+        size_t covered_area = 0;
+        for (auto const& rect : rects) {
+            bounding_rect = bounding_rect.united(rect);
+            covered_area += rect.size().area();
+        }
+        // One large copy is cheaper than many small ones that miss little of it.
+        if (covered_area * 4 >= static_cast<size_t>(bounding_rect.size().area()) * 3) {
+            rects.clear_with_capacity();
+            rects.append(bounding_rect);
+        }
+    }
+
+    return rects;
+}
+
 void Compositor::flush(Screen& screen)
 {
     auto& screen_data = screen.compositor_screen_data();
@@ -653,21 +704,19 @@ void Compositor::flush(Screen& screen)
         }
     }
 
-    if (device_can_flush_buffers && screen_data.m_screen_can_set_buffer) {
-        if (!screen_data.m_has_flipped) {
-            // If we have not flipped any buffers before, we should be flushing
-            // the entire buffer to make sure that the device has all the bits we wrote
-            screen_data.m_flush_rects = { screen.rect() };
-        }
+    if (device_can_flush_buffers && screen_data.m_screen_can_set_buffer && !screen_data.m_has_flipped) {
+        // If we have not flipped any buffers before, we should be flushing
+        // the entire buffer to make sure that the device has all the bits we wrote
+        screen_data.m_flush_rects = { screen.rect() };
+    }
 
+    auto flush_rects = coalesce_flush_rects(screen_data);
+
+    if (device_can_flush_buffers && screen_data.m_screen_can_set_buffer) {
         // If we also support buffer flipping we need to make sure we transfer all
         // updated areas to the device before we flip. We already modified the framebuffer
         // memory, but the device needs to know what areas we actually did update.
-        for (auto& rect : screen_data.m_flush_rects.rects())
-            screen.queue_flush_display_rect(rect.translated(-screen_rect.location()));
-        for (auto& rect : screen_data.m_flush_transparent_rects.rects())
-            screen.queue_flush_display_rect(rect.translated(-screen_rect.location()));
-        for (auto& rect : screen_data.m_flush_special_rects.rects())
+        for (auto& rect : flush_rects)
             screen.queue_flush_display_rect(rect.translated(-screen_rect.location()));
 
         screen.flush_display((!screen_data.m_screen_can_set_buffer || screen_data.m_buffers_are_flipped) ? 0 : 1);
@@ -722,11 +771,7 @@ void Compositor::flush(Screen& screen)
             screen.queue_flush_display_rect(rect);
         }
     };
-    for (auto& rect : screen_data.m_flush_rects.rects())
-        do_flush(rect);
-    for (auto& rect : screen_data.m_flush_transparent_rects.rects())
-        do_flush(rect);
-    for (auto& rect : screen_data.m_flush_special_rects.rects())
+    for (auto& rect : flush_rects)
         do_flush(rect);
     if (device_can_flush_buffers && !screen_data.m_screen_can_set_buffer) {
         // If we also support flipping buffers we don't really need to flush these areas right now.
@@ -926,6 +971,14 @@ void Compositor::invalidate_cursor(bool compose_immediately)
 {
     if (m_invalidated_cursor && !compose_immediately)
         return;
+
+    // Cursor movement is by far the most common reason to compose. If nothing else changed, it doesn't have to wait
+    // for the compose timer.
+    if (!m_invalidated_any) {
+        m_invalidated_cursor = m_invalidated_any = true;
+        if (compose_cursor_only())
+            return;
+    }
     m_invalidated_cursor = true;
     m_invalidated_any = true;
 
@@ -935,6 +988,36 @@ void Compositor::invalidate_cursor(bool compose_immediately)
         start_compose_async_timer();
 }
 
+// If the cursor is the only thing that changed since the last compose pass, all that needs to be done is to restore
+// what was behind it at its previous location and to draw it at its new one, without going through any windows.
+bool Compositor::compose_cursor_only()
+{
+    if (!m_invalidated_cursor || m_invalidated_window || !m_dirty_screen_rects.is_empty())
+        return false;
+    if (m_occlusions_dirty || m_overlay_rects_changed || !m_animations.is_empty() || m_transitioning_to_window_stack)
+        return false;
+    if (m_current_cursor != &WindowManager::the().active_cursor())
+        return false;
+
+    auto& cursor_screen = ScreenInput::the().cursor_location_screen();
+    if (&cursor_screen != m_current_cursor_screen)
+        return false;
+
+    auto& screen_data = cursor_screen.compositor_screen_data();
+    screen_data.m_flush_rects.clear_with_capacity();
+    screen_data.m_flush_transparent_rects.clear_with_capacity();
+    screen_data.m_flush_special_rects.clear_with_capacity();
+    Gfx::IntRect previous_cursor_rect;
+    if (!screen_data.restore_cursor_back(cursor_screen, previous_cursor_rect))
+        return false;
+    screen_data.draw_cursor(cursor_screen, current_cursor_rect());
+
+    m_invalidated_any = false;
+    m_invalidated_cursor = false;
+    flush(cursor_screen);
+    return true;
+}
+
 void Compositor::change_cursor(Cursor const* cursor)
 {
     if (m_current_cursor == cursor)
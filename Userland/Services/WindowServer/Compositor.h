@@ -205,6 +205,7 @@ private:
     void recompute_overlay_rects();
     void recompute_occlusions();
     void change_cursor(Cursor const*);
+    bool compose_cursor_only();
     void flush(Screen&);
     Gfx::IntPoint window_transition_offset(Window&);
     void update_animations(Screen&, Gfx::DisjointIntRectSet& flush_rects);
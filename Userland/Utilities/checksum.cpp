@@ -10,11 +10,46 @@
 #include <LibCore/System.h>
 #include <LibCrypto/Hash/HashManager.h>
 #include <LibMain/Main.h>
+#include <LibThreading/ThreadPool.h>
 #include <unistd.h>
 
+struct FileDigest {
+    // Files that can't be opened are skipped, but failing to read one is fatal.
+    Optional<Error> open_error;
+    Optional<ErrorOr<ByteBuffer>> digest;
+};
+
+static ErrorOr<ByteBuffer> hash_file(Core::File& file, Crypto::Hash::HashKind hash_kind)
+{
+    Crypto::Hash::Manager hash;
+    hash.initialize(hash_kind);
+
+    // Hashing big files page by page spends more time in read() than in the hash function.
+    auto buffer = TRY(ByteBuffer::create_uninitialized(64 * KiB));
+    while (!file.is_eof())
+        hash.update(TRY(file.read(buffer)));
+    return ByteBuffer::copy(hash.digest().bytes());
+}
+
+// The files are hashed at the same time, and their digests are returned in the order of the paths.
+static Vector<FileDigest> hash_files(ReadonlySpan<StringView> paths, Crypto::Hash::HashKind hash_kind)
+{
+    Vector<FileDigest> digests;
+    digests.resize(paths.size());
+    Threading::ThreadPool::the().parallel_for(paths.size(), [&](size_t i) {
+        auto file_or_error = Core::File::open_file_or_standard_stream(paths[i], Core::File::OpenMode::Read);
+        if (file_or_error.is_error()) {
+            digests[i].open_error = file_or_error.release_error();
+            return;
+        }
+        digests[i].digest = hash_file(*file_or_error.value(), hash_kind);
+    });
+    return digests;
+}
+
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
-    TRY(Core::System::pledge("stdio rpath"));
+    TRY(Core::System::pledge("stdio rpath thread"));
 
     auto program_name = LexicalPath::basename(arguments.strings[0]);
     auto hash_kind = Crypto::Hash::HashKind::None;
@@ -47,36 +82,49 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     if (paths.is_empty())
         paths.append("-"sv);
 
-    Crypto::Hash::Manager hash;
-    hash.initialize(hash_kind);
-
     bool has_error = false;
     int read_fail_count = 0;
     int failed_verification_count = 0;
 
-    for (auto const& path : paths) {
-        auto file_or_error = Core::File::open_file_or_standard_stream(path, Core::File::OpenMode::Read);
-        if (file_or_error.is_error()) {
-            ++read_fail_count;
-            has_error = true;
-            warnln("{}: {}", path, file_or_error.release_error());
-            continue;
+    if (!verify_from_paths) {
+        auto digests = hash_files(paths, hash_kind);
+        for (size_t i = 0; i < paths.size(); ++i) {
+            if (digests[i].open_error.has_value()) {
+                ++read_fail_count;
+                has_error = true;
+                warnln("{}: {}", paths[i], digests[i].open_error.release_value());
+                continue;
+            }
+            auto digest = TRY(digests[i].digest.release_value());
+            outln("{:hex-dump}  {}", digest.bytes(), paths[i]);
         }
-        auto file = file_or_error.release_value();
-        Array<u8, PAGE_SIZE> buffer;
-        if (!verify_from_paths) {
-            while (!file->is_eof())
-                hash.update(TRY(file->read(buffer)));
-            outln("{:hex-dump}  {}", hash.digest().bytes(), path);
-        } else {
-            StringBuilder checksum_list_contents;
-            Array<u8, 1> checksum_list_buffer;
-            while (!file->is_eof())
-                checksum_list_contents.append(TRY(file->read(checksum_list_buffer)).data()[0]);
-            Vector<StringView> const lines = checksum_list_contents.string_view().split_view("\n"sv);
-
-            for (size_t i = 0; i < lines.size(); ++i) {
-                Vector<StringView> const line = lines[i].split_view("  "sv);
+    } else {
+        for (auto const& path : paths) {
+            auto file_or_error = Core::File::open_file_or_standard_stream(path, Core::File::OpenMode::Read);
+            if (file_or_error.is_error()) {
+                ++read_fail_count;
+                has_error = true;
+                warnln("{}: {}", path, file_or_error.release_error());
+                continue;
+            }
+            auto file = file_or_error.release_value();
+            auto checksum_list_contents = TRY(file->read_until_eof());
+            Vector<StringView> const lines = StringView { checksum_list_contents }.split_view("\n"sv);
+
+            // line[0] = checksum
+            // line[1] = filename
+            Vector<Vector<StringView>> parsed_lines;
+            Vector<StringView> filenames;
+            for (auto const& line : lines) {
+                parsed_lines.append(line.split_view("  "sv));
+                if (parsed_lines.last().size() == 2)
+                    filenames.append(parsed_lines.last()[1]);
+            }
+            auto digests = hash_files(filenames, hash_kind);
+
+            size_t next_digest = 0;
+            for (size_t i = 0; i < parsed_lines.size(); ++i) {
+                auto const& line = parsed_lines[i];
                 if (line.size() != 2) {
                     ++read_fail_count;
                     // The real line number is greater than the iterator.
@@ -84,20 +132,14 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
                     continue;
                 }
 
-                // line[0] = checksum
-                // line[1] = filename
                 StringView const filename = line[1];
-                auto file_from_filename_or_error = Core::File::open_file_or_standard_stream(filename, Core::File::OpenMode::Read);
-                if (file_from_filename_or_error.is_error()) {
+                auto& digest = digests[next_digest++];
+                if (digest.open_error.has_value()) {
                     ++read_fail_count;
-                    warnln("{}: {}", filename, file_from_filename_or_error.release_error());
+                    warnln("{}: {}", filename, digest.open_error.release_value());
                     continue;
                 }
-                auto file_from_filename = file_from_filename_or_error.release_value();
-                hash.reset();
-                while (!file_from_filename->is_eof())
-                    hash.update(TRY(file_from_filename->read(buffer)));
-                if (DeprecatedString::formatted("{:hex-dump}", hash.digest().bytes()) == line[0])
+                if (DeprecatedString::formatted("{:hex-dump}", TRY(digest.digest.release_value()).bytes()) == line[0])
                     outln("{}: OK", filename);
                 else {
                     ++failed_verification_count;
@@ -4,17 +4,147 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Atomic.h>
 #include <AK/LexicalPath.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/DeprecatedFile.h>
+#include <LibCore/DirIterator.h>
 #include <LibCore/System.h>
 #include <LibMain/Main.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/ThreadPool.h>
+#include <fcntl.h>
 #include <stdio.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
+using CopyError = Core::DeprecatedFile::CopyError;
+using PreserveMode = Core::DeprecatedFile::PreserveMode;
+
+// Copies a directory tree like Core::DeprecatedFile::copy_directory() does, but copies all of its files at the same
+// time. Trees of many small files are mostly waiting on the file system for each one of them in turn otherwise.
+class TreeCopier {
+public:
+    explicit TreeCopier(PreserveMode preserve_mode)
+        : m_preserve_mode(preserve_mode)
+    {
+        m_umask = umask(0);
+        umask(m_umask);
+    }
+
+    ErrorOr<void, CopyError> copy(DeprecatedString const& destination, DeprecatedString const& source)
+    {
+        m_files.clear();
+        m_directories.clear();
+
+        struct stat source_stat;
+        if (stat(source.characters(), &source_stat) < 0)
+            return CopyError { errno, false };
+        TRY(create_directories(destination, source, source_stat));
+
+        Atomic<bool> failed { false };
+        Threading::Mutex error_mutex;
+        Optional<CopyError> first_error;
+        Threading::ThreadPool::the().parallel_for(m_files.size(), [&](size_t i) {
+            if (failed.load(AK::MemoryOrder::memory_order_relaxed))
+                return;
+            auto& file = m_files[i];
+            auto result = Core::DeprecatedFile::copy_regular_file(file.destination, file.source, m_umask, m_preserve_mode);
+            if (!result.is_error())
+                return;
+            Threading::MutexLocker locker(error_mutex);
+            if (!first_error.has_value())
+                first_error = result.release_error();
+            failed = true;
+        });
+        if (first_error.has_value())
+            return first_error.release_value();
+
+        // Directories get their final mode and timestamps once nothing is written to them any more, innermost ones first.
+        for (size_t i = m_directories.size(); i > 0; --i)
+            TRY(finish_directory(m_directories[i - 1]));
+        return {};
+    }
+
+private:
+    struct FileToCopy {
+        DeprecatedString source;
+        DeprecatedString destination;
+    };
+
+    struct CreatedDirectory {
+        DeprecatedString path;
+        struct stat source_stat;
+    };
+
+    ErrorOr<void, CopyError> create_directories(DeprecatedString const& destination, DeprecatedString const& source, struct stat const& source_stat)
+    {
+        if (mkdir(destination.characters(), 0755) < 0)
+            return CopyError { errno, false };
+
+        auto source_real_path = DeprecatedString::formatted("{}/", Core::DeprecatedFile::real_path_for(source));
+        auto destination_real_path = DeprecatedString::formatted("{}/", Core::DeprecatedFile::real_path_for(destination));
+        if (destination_real_path.starts_with(source_real_path))
+            return CopyError { EINVAL, false };
+
+        m_directories.append({ destination, source_stat });
+
+        Core::DirIterator iterator(source, Core::DirIterator::SkipParentAndBaseDir);
+        if (iterator.has_error())
+            return CopyError { iterator.error(), false };
+
+        while (iterator.has_next()) {
+            auto name = iterator.next_path();
+            auto entry_source = DeprecatedString::formatted("{}/{}", source, name);
+            auto entry_destination = DeprecatedString::formatted("{}/{}", destination, name);
+
+            struct stat entry_stat;
+            if (stat(entry_source.characters(), &entry_stat) < 0)
+                return CopyError { errno, false };
+            if (S_ISDIR(entry_stat.st_mode))
+                TRY(create_directories(entry_destination, entry_source, entry_stat));
+            else
+                m_files.append({ move(entry_source), move(entry_destination) });
+        }
+        return {};
+    }
+
+    ErrorOr<void, CopyError> finish_directory(CreatedDirectory const& directory)
+    {
+        auto const& source_stat = directory.source_stat;
+        if (chmod(directory.path.characters(), source_stat.st_mode & ~m_umask) < 0)
+            return CopyError { errno, false };
+
+        if (has_flag(m_preserve_mode, PreserveMode::Ownership)) {
+            if (chown(directory.path.characters(), source_stat.st_uid, source_stat.st_gid) < 0)
+                return CopyError { errno, false };
+        }
+
+        if (has_flag(m_preserve_mode, PreserveMode::Timestamps)) {
+            struct timespec times[2] = {
+#ifdef AK_OS_MACOS
+                source_stat.st_atimespec,
+                source_stat.st_mtimespec,
+#else
+                source_stat.st_atim,
+                source_stat.st_mtim,
+#endif
+            };
+            if (utimensat(AT_FDCWD, directory.path.characters(), times, 0) < 0)
+                return CopyError { errno, false };
+        }
+        return {};
+    }
+
+    PreserveMode m_preserve_mode;
+    mode_t m_umask { 0 };
+    Vector<FileToCopy> m_files;
+    Vector<CreatedDirectory> m_directories;
+};
+
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
-    TRY(Core::System::pledge("stdio rpath wpath cpath fattr chown"));
+    TRY(Core::System::pledge("stdio rpath wpath cpath fattr chown thread"));
 
     bool link = false;
     auto preserve = Core::DeprecatedFile::PreserveMode::Nothing;
@@ -66,22 +196,28 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     if (has_flag(preserve, Core::DeprecatedFile::PreserveMode::Permissions)) {
         umask(0);
     } else {
-        TRY(Core::System::pledge("stdio rpath wpath cpath fattr"));
+        TRY(Core::System::pledge("stdio rpath wpath cpath fattr thread"));
     }
 
     bool destination_is_existing_dir = Core::DeprecatedFile::is_directory(destination);
+    TreeCopier tree_copier(preserve);
 
     for (auto& source : sources) {
         auto destination_path = destination_is_existing_dir
             ? DeprecatedString::formatted("{}/{}", destination, LexicalPath::basename(source))
             : destination;
 
-        auto result = Core::DeprecatedFile::copy_file_or_directory(
-            destination_path, source,
-            recursion_allowed ? Core::DeprecatedFile::RecursionMode::Allowed : Core::DeprecatedFile::RecursionMode::Disallowed,
-            link ? Core::DeprecatedFile::LinkMode::Allowed : Core::DeprecatedFile::LinkMode::Disallowed,
-            Core::DeprecatedFile::AddDuplicateFileMarker::No,
-            preserve);
+        ErrorOr<void, CopyError> result = {};
+        if (recursion_allowed && Core::DeprecatedFile::is_directory(source)) {
+            result = tree_copier.copy(destination_path, source);
+        } else {
+            result = Core::DeprecatedFile::copy_file_or_directory(
+                destination_path, source,
+                recursion_allowed ? Core::DeprecatedFile::RecursionMode::Allowed : Core::DeprecatedFile::RecursionMode::Disallowed,
+                link ? Core::DeprecatedFile::LinkMode::Allowed : Core::DeprecatedFile::LinkMode::Disallowed,
+                Core::DeprecatedFile::AddDuplicateFileMarker::No,
+                preserve);
+        }
 
         if (result.is_error()) {
             if (result.error().tried_recursing)
@@ -7,26 +7,45 @@
 
 #include <AK/ByteBuffer.h>
 #include <AK/DeprecatedString.h>
+#include <AK/QuickSort.h>
+#include <AK/Random.h>
 #include <AK/ScopeGuard.h>
+#include <AK/Time.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/ElapsedTimer.h>
 #include <LibCore/System.h>
 #include <LibMain/Main.h>
+#include <LibThreading/Thread.h>
 #include <fcntl.h>
 #include <stdio.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
-struct Result {
+struct Options {
+    bool allow_cache { false };
+    bool random_access { false };
+    bool fsync_after_write { false };
+    size_t thread_count { 1 };
+};
+
+struct BenchmarkResult {
     u64 write_bps {};
     u64 read_bps {};
 };
 
-static Result average_result(Vector<Result> const& results)
+// Each thread accesses its own share of the blocks in the file, so that many requests are in flight at the same time.
+struct ThreadState {
+    ByteBuffer buffer;
+    Vector<size_t> blocks;
+    Vector<u64> fsync_latencies_us;
+    Optional<Error> error;
+};
+
+static BenchmarkResult average_result(Vector<BenchmarkResult> const& results)
 {
-    Result average;
+    BenchmarkResult average;
 
     for (auto& res : results) {
         average.write_bps += res.write_bps;
@@ -39,7 +58,13 @@ static Result average_result(Vector<Result> const& results)
     return average;
 }
 
-static ErrorOr<Result> benchmark(DeprecatedString const& filename, int file_size, ByteBuffer& buffer, bool allow_cache);
+static u64 percentile(Vector<u64> const& sorted_values, size_t percent)
+{
+    return sorted_values[(sorted_values.size() * percent + 99) / 100 - 1];
+}
+
+static ErrorOr<BenchmarkResult> benchmark(DeprecatedString const& filename, size_t file_size, size_t block_size, Options const&, Vector<u64>& fsync_latencies_us);
+static ErrorOr<void> benchmark_metadata(DeprecatedString const& directory, size_t file_count);
 
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
@@ -49,16 +74,33 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     i64 time_per_benchmark_sec = 10;
     Vector<size_t> file_sizes;
     Vector<size_t> block_sizes;
-    bool allow_cache = false;
+    Options options;
+    size_t metadata_file_count = 0;
 
     Core::ArgsParser args_parser;
-    args_parser.add_option(allow_cache, "Allow using disk cache", "cache", 'c');
+    args_parser.add_option(options.allow_cache, "Allow using disk cache", "cache", 'c');
     args_parser.add_option(directory, "Path to a directory where we can store the disk benchmark temp file", "directory", 'd', "directory");
     args_parser.add_option(time_per_benchmark_sec, "Time elapsed per benchmark (seconds)", "time-per-benchmark", 't', "time-per-benchmark");
     args_parser.add_option(file_sizes, "A comma-separated list of file sizes", "file-size", 'f', "file-size");
     args_parser.add_option(block_sizes, "A comma-separated list of block sizes", "block-size", 'b', "block-size");
+    args_parser.add_option(options.random_access, "Access the blocks in random order", "random", 'r');
+    args_parser.add_option(options.thread_count, "Number of threads accessing the file at the same time", "threads", 'j', "threads");
+    args_parser.add_option(options.fsync_after_write, "Sync the file after writing each block, and measure how long that takes", "fsync", 's');
+    args_parser.add_option(metadata_file_count, "Instead of reading and writing, measure how fast this many files can be created, stat'ed and unlinked", "metadata", 'm', "file-count");
     args_parser.parse(arguments);
 
+    if (options.thread_count == 0) {
+        warnln("Need at least one thread");
+        return 1;
+    }
+
+    umask(0644);
+
+    if (metadata_file_count != 0) {
+        TRY(benchmark_metadata(directory, metadata_file_count));
+        return 0;
+    }
+
     Time const time_per_benchmark = Time::from_seconds(time_per_benchmark_sec);
 
     if (file_sizes.size() == 0) {
@@ -68,8 +110,6 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         block_sizes = { 8192, 32768, 65536 };
     }
 
-    umask(0644);
-
     auto filename = DeprecatedString::formatted("{}/disk_benchmark.tmp", directory);
 
     for (auto file_size : file_sizes) {
@@ -77,25 +117,33 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
             if (block_size > file_size)
                 continue;
 
-            auto buffer_result = ByteBuffer::create_uninitialized(block_size);
-            if (buffer_result.is_error()) {
-                warnln("Not enough memory to allocate space for block size = {}", block_size);
-                continue;
-            }
-            Vector<Result> results;
+            Vector<BenchmarkResult> results;
+            Vector<u64> fsync_latencies_us;
 
             outln("Running: file_size={} block_size={}", file_size, block_size);
             auto timer = Core::ElapsedTimer::start_new();
             while (timer.elapsed_time() < time_per_benchmark) {
                 out(".");
                 fflush(stdout);
-                auto result = TRY(benchmark(filename, file_size, buffer_result.value(), allow_cache));
-                results.append(result);
+                auto result = benchmark(filename, file_size, block_size, options, fsync_latencies_us);
+                if (result.is_error() && result.error().is_errno() && result.error().code() == ENOMEM) {
+                    warnln("Not enough memory to allocate space for block size = {}", block_size);
+                    break;
+                }
+                results.append(TRY(result));
                 usleep(100);
             }
+            if (results.is_empty())
+                continue;
             auto average = average_result(results);
             outln("Finished: runs={} time={}ms write_bps={} read_bps={}", results.size(), timer.elapsed(), average.write_bps, average.read_bps);
 
+            if (!fsync_latencies_us.is_empty()) {
+                quick_sort(fsync_latencies_us);
+                outln("fsync latency: p50={}us p90={}us p99={}us max={}us",
+                    percentile(fsync_latencies_us, 50), percentile(fsync_latencies_us, 90), percentile(fsync_latencies_us, 99), fsync_latencies_us.last());
+            }
+
             sleep(1);
         }
     }
@@ -103,10 +151,57 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     return 0;
 }
 
-ErrorOr<Result> benchmark(DeprecatedString const& filename, int file_size, ByteBuffer& buffer, bool allow_cache)
+// Runs the function for all threads at once, and returns how long it took for all of them to finish.
+static ErrorOr<Time> run_on_threads(Vector<ThreadState>& thread_states, Function<ErrorOr<void>(ThreadState&)> const& function)
+{
+    Vector<NonnullRefPtr<Threading::Thread>> threads;
+    TRY(threads.try_ensure_capacity(thread_states.size()));
+
+    auto start = Time::now_monotonic();
+    for (auto& thread_state : thread_states) {
+        auto thread = TRY(Threading::Thread::try_create([&function, &thread_state] {
+            if (auto result = function(thread_state); result.is_error())
+                thread_state.error = result.release_error();
+            return 0;
+        },
+            "disk_benchmark"sv));
+        thread->start();
+        threads.unchecked_append(move(thread));
+    }
+    for (auto& thread : threads)
+        (void)thread->join();
+    auto elapsed = Time::now_monotonic() - start;
+
+    for (auto& thread_state : thread_states) {
+        if (thread_state.error.has_value())
+            return thread_state.error.release_value();
+    }
+    return elapsed;
+}
+
+static u64 bytes_per_second(size_t bytes, Time elapsed)
 {
+    auto elapsed_us = elapsed.to_microseconds();
+    return elapsed_us > 0 ? bytes * 1'000'000 / elapsed_us : bytes * 1'000'000;
+}
+
+ErrorOr<BenchmarkResult> benchmark(DeprecatedString const& filename, size_t file_size, size_t block_size, Options const& options, Vector<u64>& fsync_latencies_us)
+{
+    Vector<ThreadState> thread_states;
+    TRY(thread_states.try_resize(options.thread_count));
+    for (auto& thread_state : thread_states)
+        thread_state.buffer = TRY(ByteBuffer::create_uninitialized(block_size));
+
+    auto block_count = ceil_div(file_size, block_size);
+    for (size_t block = 0; block < block_count; ++block)
+        TRY(thread_states[block % options.thread_count].blocks.try_append(block));
+    if (options.random_access) {
+        for (auto& thread_state : thread_states)
+            shuffle(thread_state.blocks);
+    }
+
     int flags = O_CREAT | O_TRUNC | O_RDWR;
-    if (!allow_cache)
+    if (!options.allow_cache)
         flags |= O_DIRECT;
 
     int fd = TRY(Core::System::open(filename, flags, 0644));
@@ -121,27 +216,92 @@ ErrorOr<Result> benchmark(DeprecatedString const& filename, int file_size, ByteB
             warnln("{}", void_or_error.release_error());
     });
 
-    Result result;
+    BenchmarkResult result;
 
-    auto timer = Core::ElapsedTimer::start_new();
+    auto write_time = TRY(run_on_threads(thread_states, [&](ThreadState& thread_state) -> ErrorOr<void> {
+        for (auto block : thread_state.blocks) {
+            size_t total_written = 0;
+            while (total_written < block_size) {
+                auto nwritten = pwrite(fd, thread_state.buffer.offset_pointer(total_written), block_size - total_written, block * block_size + total_written);
+                if (nwritten < 0)
+                    return Error::from_syscall("pwrite"sv, -errno);
+                total_written += nwritten;
+            }
 
-    ssize_t total_written = 0;
-    while (total_written < file_size) {
-        auto nwritten = TRY(Core::System::write(fd, buffer));
-        total_written += nwritten;
-    }
+            if (options.fsync_after_write) {
+                auto fsync_start = Time::now_monotonic();
+                TRY(Core::System::fsync(fd));
+                TRY(thread_state.fsync_latencies_us.try_append((Time::now_monotonic() - fsync_start).to_microseconds()));
+            }
+        }
+        return {};
+    }));
 
-    result.write_bps = (u64)(timer.elapsed() ? (file_size / timer.elapsed()) : file_size) * 1000;
+    result.write_bps = bytes_per_second(block_count * block_size, write_time);
 
-    TRY(Core::System::lseek(fd, 0, SEEK_SET));
+    auto read_time = TRY(run_on_threads(thread_states, [&](ThreadState& thread_state) -> ErrorOr<void> {
+        for (auto block : thread_state.blocks) {
+            size_t total_read = 0;
+            while (total_read < block_size) {
+                auto nread = pread(fd, thread_state.buffer.offset_pointer(total_read), block_size - total_read, block * block_size + total_read);
+                if (nread < 0)
+                    return Error::from_syscall("pread"sv, -errno);
+                if (nread == 0)
+                    return Error::from_string_literal("Unexpected end of file");
+                total_read += nread;
+            }
+        }
+        return {};
+    }));
 
-    timer.start();
-    ssize_t total_read = 0;
-    while (total_read < file_size) {
-        auto nread = TRY(Core::System::read(fd, buffer));
-        total_read += nread;
-    }
+    result.read_bps = bytes_per_second(block_count * block_size, read_time);
 
-    result.read_bps = (u64)(timer.elapsed() ? (file_size / timer.elapsed()) : file_size) * 1000;
+    for (auto& thread_state : thread_states)
+        TRY(fsync_latencies_us.try_extend(thread_state.fsync_latencies_us));
     return result;
 }
+
+static u64 operations_per_second(size_t count, Time elapsed)
+{
+    auto elapsed_us = elapsed.to_microseconds();
+    return elapsed_us > 0 ? count * 1'000'000 / elapsed_us : count * 1'000'000;
+}
+
+ErrorOr<void> benchmark_metadata(DeprecatedString const& directory, size_t file_count)
+{
+    Vector<DeprecatedString> filenames;
+    TRY(filenames.try_ensure_capacity(file_count));
+    for (size_t i = 0; i < file_count; ++i)
+        filenames.unchecked_append(DeprecatedString::formatted("{}/disk_benchmark.{}.tmp", directory, i));
+
+    size_t created_count = 0;
+    auto cleanup = ScopeGuard([&] {
+        for (size_t i = 0; i < created_count; ++i)
+            (void)Core::System::unlink(filenames[i]);
+    });
+
+    outln("Running: metadata file_count={}", file_count);
+
+    auto start = Time::now_monotonic();
+    for (auto const& filename : filenames) {
+        auto fd = TRY(Core::System::open(filename, O_CREAT | O_EXCL | O_WRONLY, 0644));
+        ++created_count;
+        TRY(Core::System::close(fd));
+    }
+    auto create_time = Time::now_monotonic() - start;
+
+    start = Time::now_monotonic();
+    for (auto const& filename : filenames)
+        (void)TRY(Core::System::stat(filename));
+    auto stat_time = Time::now_monotonic() - start;
+
+    start = Time::now_monotonic();
+    for (auto const& filename : filenames)
+        TRY(Core::System::unlink(filename));
+    created_count = 0;
+    auto unlink_time = Time::now_monotonic() - start;
+
+    outln("Finished: creates_per_sec={} stats_per_sec={} unlinks_per_sec={}",
+        operations_per_second(file_count, create_time), operations_per_second(file_count, stat_time), operations_per_second(file_count, unlink_time));
+    return {};
+}
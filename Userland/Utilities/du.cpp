@@ -37,7 +37,7 @@ struct DuOption {
 };
 
 static ErrorOr<void> parse_args(Main::Arguments arguments, Vector<DeprecatedString>& files, DuOption& du_option);
-static ErrorOr<u64> print_space_usage(DeprecatedString const& path, DuOption const& du_option, size_t current_depth, bool inside_dir = false);
+static ErrorOr<u64> print_space_usage(DeprecatedString const& path, DuOption const& du_option, size_t current_depth, bool inside_dir = false, Optional<struct stat> known_stat = {});
 
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
@@ -134,10 +134,10 @@ ErrorOr<void> parse_args(Main::Arguments arguments, Vector<DeprecatedString>& fi
     return {};
 }
 
-ErrorOr<u64> print_space_usage(DeprecatedString const& path, DuOption const& du_option, size_t current_depth, bool inside_dir)
+ErrorOr<u64> print_space_usage(DeprecatedString const& path, DuOption const& du_option, size_t current_depth, bool inside_dir, Optional<struct stat> known_stat)
 {
     u64 size = 0;
-    struct stat path_stat = TRY(Core::System::lstat(path));
+    struct stat path_stat = known_stat.has_value() ? known_stat.release_value() : TRY(Core::System::lstat(path));
     bool const is_directory = S_ISDIR(path_stat.st_mode);
     if (is_directory) {
         auto di = Core::DirIterator(path, Core::DirIterator::SkipParentAndBaseDir);
@@ -147,8 +147,11 @@ ErrorOr<u64> print_space_usage(DeprecatedString const& path, DuOption const& du_
         }
 
         while (di.has_next()) {
-            auto const child_path = di.next_full_path();
-            size += TRY(print_space_usage(child_path, du_option, current_depth + 1, true));
+            auto const entry = di.next().release_value();
+            // Stat the entry relative to the directory, so its full path doesn't need to be resolved.
+            auto child_stat = TRY(di.stat(entry));
+            auto const child_path = DeprecatedString::formatted("{}{}{}", path, path.ends_with('/') ? ""sv : "/"sv, entry.name);
+            size += TRY(print_space_usage(child_path, du_option, current_depth + 1, true, child_stat));
         }
     }
 
@@ -4,9 +4,13 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AllOf.h>
 #include <AK/Assertions.h>
+#include <AK/Atomic.h>
+#include <AK/CharacterTypes.h>
 #include <AK/DeprecatedString.h>
 #include <AK/LexicalPath.h>
+#include <AK/MemMem.h>
 #include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
 #include <AK/Vector.h>
@@ -14,10 +18,17 @@
 #include <LibCore/DeprecatedFile.h>
 #include <LibCore/DirIterator.h>
 #include <LibCore/File.h>
+#include <LibCore/MappedFile.h>
 #include <LibCore/System.h>
 #include <LibMain/Main.h>
 #include <LibRegex/Regex.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/MutexProtected.h>
+#include <LibThreading/ThreadPool.h>
 #include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 enum class BinaryFileMode {
@@ -38,6 +49,9 @@ void fail(StringView format, Ts... args)
 constexpr StringView ere_special_characters = ".^$*+?()[{\\|"sv;
 constexpr StringView basic_special_characters = ".^$*[\\"sv;
 
+// Files smaller than this are cheaper to read than to map.
+static constexpr size_t mapping_threshold = 64 * KiB;
+
 static DeprecatedString escape_characters(StringView string, StringView characters)
 {
     StringBuilder builder;
@@ -50,9 +64,219 @@ static DeprecatedString escape_characters(StringView string, StringView characte
     return builder.to_deprecated_string();
 }
 
+// Finds the longest run of plain characters that every match of the pattern has to contain. Anything that isn't
+// obviously a plain character ends the run, so this may miss some literals, but never returns one that a match
+// could do without.
+static Optional<DeprecatedString> find_required_literal(StringView pattern)
+{
+    StringView best;
+    size_t run_start = 0;
+    size_t run_length = 0;
+    size_t group_depth = 0;
+
+    auto end_run = [&] {
+        if (group_depth == 0 && run_length > best.length())
+            best = pattern.substring_view(run_start, run_length);
+        run_length = 0;
+    };
+
+    for (size_t i = 0; i < pattern.length(); ++i) {
+        auto ch = pattern[i];
+        switch (ch) {
+        case '|':
+            // An alternative could match without the literal.
+            return {};
+        case '*':
+        case '+':
+        case '?':
+        case '{':
+            // The character before a repetition may not be there at all.
+            if (run_length > 0)
+                --run_length;
+            end_run();
+            if (ch == '{') {
+                while (i < pattern.length() && pattern[i] != '}')
+                    ++i;
+            }
+            break;
+        case '(':
+            end_run();
+            ++group_depth;
+            break;
+        case ')':
+            end_run();
+            if (group_depth > 0)
+                --group_depth;
+            break;
+        case '[':
+            end_run();
+            // Skip the bracket expression, which may start with ']' and contain classes like [:alpha:].
+            ++i;
+            if (i < pattern.length() && pattern[i] == '^')
+                ++i;
+            if (i < pattern.length() && pattern[i] == ']')
+                ++i;
+            while (i < pattern.length() && pattern[i] != ']') {
+                if (pattern[i] == '[' && i + 1 < pattern.length() && ".:="sv.contains(pattern[i + 1])) {
+                    auto delimiter = pattern[i + 1];
+                    i += 2;
+                    while (i + 1 < pattern.length() && !(pattern[i] == delimiter && pattern[i + 1] == ']'))
+                        ++i;
+                    ++i;
+                }
+                ++i;
+            }
+            break;
+        case '\\':
+            // Escapes are groups, alternatives and repetitions in basic regular expressions, and character classes
+            // in both kinds, so only the ones we know are plain characters become part of the literal.
+            if (i + 1 < pattern.length() && ere_special_characters.contains(pattern[i + 1]) && !"(){|+?"sv.contains(pattern[i + 1])) {
+                // The backslash can't be part of the literal, so the escaped character starts a new run.
+                end_run();
+                run_start = ++i;
+                run_length = 1;
+                break;
+            }
+            end_run();
+            if (i + 1 < pattern.length()) {
+                auto escaped = pattern[++i];
+                if (escaped == '(') {
+                    ++group_depth;
+                } else if (escaped == ')') {
+                    if (group_depth > 0)
+                        --group_depth;
+                } else if (escaped == '|') {
+                    return {};
+                } else if (escaped == '{') {
+                    // The repetition applies to whatever came before, which we've already left out.
+                    while (i < pattern.length() && pattern[i] != '}')
+                        ++i;
+                }
+            }
+            break;
+        case '.':
+        case '^':
+        case '$':
+            end_run();
+            break;
+        default:
+            if (run_length == 0)
+                run_start = i;
+            ++run_length;
+            break;
+        }
+    }
+    end_run();
+
+    if (best.is_empty())
+        return {};
+    return best.to_deprecated_string();
+}
+
+// Finds the next place where any of the literals appear in a buffer, so that only the lines containing one of them
+// have to go through the regular expressions.
+class LiteralFinder {
+public:
+    LiteralFinder(Vector<DeprecatedString> const& literals, bool case_insensitive, StringView buffer)
+        : m_literals(literals)
+        , m_case_insensitive(case_insensitive)
+        , m_buffer(buffer)
+    {
+        m_next_occurrences.resize(m_literals.size());
+    }
+
+    Optional<size_t> find_next(size_t offset)
+    {
+        Optional<size_t> next;
+        for (size_t i = 0; i < m_literals.size(); ++i) {
+            auto& occurrence = m_next_occurrences[i];
+            if (!occurrence.has_value() || *occurrence < offset) {
+                occurrence = find(m_literals[i], offset);
+                if (!occurrence.has_value()) {
+                    // It isn't anywhere in the rest of the buffer.
+                    occurrence = m_buffer.length();
+                }
+            }
+            if (*occurrence < m_buffer.length() && (!next.has_value() || *occurrence < *next))
+                next = *occurrence;
+        }
+        return next;
+    }
+
+private:
+    Optional<size_t> find(StringView literal, size_t offset) const
+    {
+        auto remaining = m_buffer.substring_view(offset);
+        if (!m_case_insensitive) {
+            auto position = AK::memmem_optional(remaining.characters_without_null_termination(), remaining.length(), literal.characters_without_null_termination(), literal.length());
+            if (!position.has_value())
+                return {};
+            return offset + *position;
+        }
+
+        // The literals are lowercase already.
+        auto first = literal[0];
+        auto first_upper = to_ascii_uppercase(first);
+        for (size_t i = 0; i + literal.length() <= remaining.length(); ++i) {
+            if (remaining[i] != first && remaining[i] != first_upper)
+                continue;
+            if (remaining.substring_view(i, literal.length()).equals_ignoring_case(literal))
+                return offset + i;
+        }
+        return {};
+    }
+
+    Vector<DeprecatedString> const& m_literals;
+    bool m_case_insensitive { false };
+    StringView m_buffer;
+    Vector<Optional<size_t>> m_next_occurrences;
+};
+
+static size_t count_newlines(StringView text)
+{
+    size_t count = 0;
+    auto const* position = text.characters_without_null_termination();
+    auto const* end = position + text.length();
+    while (position < end) {
+        position = static_cast<char const*>(memchr(position, '\n', end - position));
+        if (!position)
+            break;
+        ++count;
+        ++position;
+    }
+    return count;
+}
+
+struct FileContents {
+    StringView view() const
+    {
+        if (mapping)
+            return { static_cast<char const*>(mapping->data()), mapping->size() };
+        return buffer.bytes();
+    }
+
+    RefPtr<Core::MappedFile> mapping;
+    ByteBuffer buffer;
+};
+
+static ErrorOr<FileContents> read_file(StringView path)
+{
+    auto file = TRY(Core::File::open(path, Core::File::OpenMode::Read));
+    auto stat = TRY(Core::System::fstat(file->fd()));
+
+    FileContents contents;
+    if (S_ISREG(stat.st_mode) && static_cast<size_t>(stat.st_size) >= mapping_threshold) {
+        contents.mapping = TRY(Core::MappedFile::map_from_file(move(file), path));
+        (void)contents.mapping->set_access_pattern(Core::MappedFile::AccessPattern::Sequential);
+    } else {
+        contents.buffer = TRY(file->read_until_eof());
+    }
+    return contents;
+}
+
 ErrorOr<int> serenity_main(Main::Arguments args)
 {
-    TRY(Core::System::pledge("stdio rpath"));
+    TRY(Core::System::pledge("stdio rpath thread"));
 
     DeprecatedString program_name = AK::LexicalPath::basename(args.strings[0]);
 
@@ -71,8 +295,6 @@ ErrorOr<int> serenity_main(Main::Arguments args)
     bool colored_output = isatty(STDOUT_FILENO);
     bool count_lines = false;
 
-    size_t matched_line_count = 0;
-
     Core::ArgsParser args_parser;
     args_parser.add_option(recursive, "Recursively scan files", "recursive", 'r');
     args_parser.add_option(use_ere, "Extended regular expressions", "extended-regexp", 'E');
@@ -154,21 +376,38 @@ ErrorOr<int> serenity_main(Main::Arguments args)
         patterns.append(files.take_first());
 
     auto user_has_specified_files = !files.is_empty();
-    auto user_specified_multiple_files = files.size() >= 2;
 
     PosixOptions options {};
     if (case_insensitive)
         options |= PosixFlags::Insensitive;
 
-    auto grep_logic = [&](auto&& regular_expressions) {
+    // Only lines that contain one of the literals can match, so we look for those before running the regular
+    // expressions, which is a lot faster. This only works if every pattern has a literal, and if we're looking
+    // for the lines that do match.
+    Vector<DeprecatedString> literals;
+    if (!invert_match) {
+        for (auto& pattern : patterns) {
+            auto literal = fixed_strings ? Optional<DeprecatedString> { pattern } : find_required_literal(pattern);
+            if (!literal.has_value() || literal->is_empty() || (case_insensitive && !all_of(literal->view(), [](char ch) { return is_ascii(ch); }))) {
+                literals.clear();
+                break;
+            }
+            literals.append(case_insensitive ? literal->to_lowercase() : literal.release_value());
+        }
+    }
+
+    auto grep_logic = [&](auto create_regular_expressions) {
+        auto regular_expressions = create_regular_expressions();
         for (auto& re : regular_expressions) {
             if (re.parser_result.error != regex::Error::NoError) {
                 warnln("regex parse error: {}", regex::get_error_string(re.parser_result.error));
                 return 1;
             }
         }
+        using RegularExpressions = decltype(regular_expressions);
 
-        auto matches = [&](StringView str, StringView filename, size_t line_number, bool print_filename, bool is_binary) {
+        // Writes the line to the output if it's selected, and returns whether it was.
+        auto matches = [&](RegularExpressions const& regular_expressions, StringView str, StringView filename, size_t line_number, bool print_filename, bool is_binary, StringBuilder& output) {
             size_t last_printed_char_pos { 0 };
             if (is_binary && binary_mode == BinaryFileMode::Skip)
                 return false;
@@ -178,31 +417,26 @@ ErrorOr<int> serenity_main(Main::Arguments args)
                 if (!(result.success ^ invert_match))
                     continue;
 
-                if (quiet_mode)
+                if (quiet_mode || count_lines)
                     return true;
 
-                if (count_lines) {
-                    matched_line_count++;
-                    return true;
-                }
-
                 if (is_binary && binary_mode == BinaryFileMode::Binary) {
-                    outln(colored_output ? "binary file \x1B[34m{}\x1B[0m matches"sv : "binary file {} matches"sv, filename);
+                    output.appendff(colored_output ? "binary file \x1B[34m{}\x1B[0m matches\n"sv : "binary file {} matches\n"sv, filename);
                 } else {
                     if ((result.matches.size() || invert_match) && print_filename)
-                        out(colored_output ? "\x1B[34m{}:\x1B[0m"sv : "{}:"sv, filename);
+                        output.appendff(colored_output ? "\x1B[34m{}:\x1B[0m"sv : "{}:"sv, filename);
                     if ((result.matches.size() || invert_match) && line_numbers)
-                        out(colored_output ? "\x1B[35m{}:\x1B[0m"sv : "{}:"sv, line_number);
+                        output.appendff(colored_output ? "\x1B[35m{}:\x1B[0m"sv : "{}:"sv, line_number);
 
                     for (auto& match : result.matches) {
                         auto pre_match_length = match.global_offset - last_printed_char_pos;
-                        out(colored_output ? "{}\x1B[32m{}\x1B[0m"sv : "{}{}"sv,
+                        output.appendff(colored_output ? "{}\x1B[32m{}\x1B[0m"sv : "{}{}"sv,
                             pre_match_length > 0 ? StringView(&str[last_printed_char_pos], pre_match_length) : ""sv,
                             match.view.to_deprecated_string());
                         last_printed_char_pos = match.global_offset + match.view.length();
                     }
                     auto remaining_length = str.length() - last_printed_char_pos;
-                    outln("{}", remaining_length > 0 ? StringView(&str[last_printed_char_pos], remaining_length) : ""sv);
+                    output.appendff("{}\n", remaining_length > 0 ? StringView(&str[last_printed_char_pos], remaining_length) : ""sv);
                 }
 
                 return true;
@@ -211,49 +445,75 @@ ErrorOr<int> serenity_main(Main::Arguments args)
             return false;
         };
 
-        bool did_match_something = false;
-
-        auto handle_file = [&matches, binary_mode, count_lines, quiet_mode,
-                               user_specified_multiple_files, &matched_line_count, &did_match_something](StringView filename, bool print_filename) -> ErrorOr<void> {
-            auto file = TRY(Core::File::open(filename, Core::File::OpenMode::Read));
-            auto buffered_file = TRY(Core::BufferedFile::create(move(file)));
-
-            for (size_t line_number = 1; TRY(buffered_file->can_read_line()); ++line_number) {
-                Array<u8, PAGE_SIZE> buffer;
-                auto line = TRY(buffered_file->read_line(buffer));
+        // Searches the whole file at once, instead of line by line, and returns how many lines were selected.
+        auto search_contents = [&](RegularExpressions const& regular_expressions, StringView contents, StringView filename, bool print_filename, StringBuilder& output) -> size_t {
+            auto is_binary = memchr(contents.characters_without_null_termination(), '\0', contents.length()) != nullptr;
+            if (is_binary && binary_mode == BinaryFileMode::Skip)
+                return 0;
+
+            Optional<LiteralFinder> literal_finder;
+            if (!literals.is_empty())
+                literal_finder.emplace(literals, case_insensitive, contents);
+
+            size_t selected_line_count = 0;
+            size_t line_number = 1;
+            size_t counted_offset = 0;
+            size_t offset = 0;
+            while (offset < contents.length()) {
+                if (literal_finder.has_value()) {
+                    auto candidate = literal_finder->find_next(offset);
+                    if (!candidate.has_value())
+                        break;
+                    // Skip ahead to the start of the line the literal is on.
+                    offset = *candidate;
+                    while (offset > 0 && contents[offset - 1] != '\n')
+                        --offset;
+                }
 
-                auto is_binary = line.contains('\0');
+                auto line_end = contents.find('\n', offset).value_or(contents.length());
+                if (line_numbers) {
+                    line_number += count_newlines(contents.substring_view(counted_offset, offset - counted_offset));
+                    counted_offset = offset;
+                }
 
-                auto matched = matches(line, filename, line_number, print_filename, is_binary);
-                did_match_something = did_match_something || matched;
-                if (matched && is_binary && binary_mode == BinaryFileMode::Binary)
-                    break;
+                auto matched = matches(regular_expressions, contents.substring_view(offset, line_end - offset), filename, line_number, print_filename, is_binary, output);
+                if (matched) {
+                    ++selected_line_count;
+                    if (quiet_mode || (is_binary && binary_mode == BinaryFileMode::Binary))
+                        break;
+                }
+                offset = line_end + 1;
             }
 
             if (count_lines && !quiet_mode) {
-                if (user_specified_multiple_files)
-                    outln("{}:{}", filename, matched_line_count);
+                if (print_filename)
+                    output.appendff("{}:{}\n", filename, selected_line_count);
                 else
-                    outln("{}", matched_line_count);
-                matched_line_count = 0;
+                    output.appendff("{}\n", selected_line_count);
             }
 
-            return {};
+            return selected_line_count;
         };
 
-        auto add_directory = [&handle_file, user_has_specified_files, suppress_errors](DeprecatedString base, Optional<DeprecatedString> recursive, auto handle_directory) -> void {
-            Core::DirIterator it(recursive.value_or(base), Core::DirIterator::Flags::SkipDots);
-            while (it.has_next()) {
-                auto path = it.next_full_path();
-                if (!Core::DeprecatedFile::is_directory(path)) {
-                    auto key = user_has_specified_files ? path.view() : path.substring_view(base.length() + 1, path.length() - base.length() - 1);
-                    if (auto result = handle_file(key, true); result.is_error() && !suppress_errors)
-                        warnln("Failed with file {}: {}", key, result.release_error());
+        Atomic<bool> did_match_something = false;
 
-                } else {
-                    handle_directory(base, path, handle_directory);
-                }
-            }
+        // Every thread needs regular expressions of its own, since matching one changes its state.
+        Threading::MutexProtected<Vector<NonnullOwnPtr<RegularExpressions>>> idle_regular_expressions;
+        auto search_file = [&](StringView filename, bool print_filename, StringBuilder& output) -> ErrorOr<void> {
+            auto contents = TRY(read_file(filename));
+
+            auto regular_expressions = idle_regular_expressions.with_locked([&](auto& idle) -> OwnPtr<RegularExpressions> {
+                if (idle.is_empty())
+                    return make<RegularExpressions>(create_regular_expressions());
+                return idle.take_last();
+            });
+            ScopeGuard return_regular_expressions = [&] {
+                idle_regular_expressions.with_locked([&](auto& idle) { idle.append(regular_expressions.release_nonnull()); });
+            };
+
+            if (search_contents(*regular_expressions, contents.view(), filename, print_filename, output) > 0)
+                did_match_something = true;
+            return {};
         };
 
         if (!files.size() && !recursive) {
@@ -262,6 +522,7 @@ ErrorOr<int> serenity_main(Main::Arguments args)
             ssize_t nread = 0;
             ScopeGuard free_line = [line] { free(line); };
             size_t line_number = 0;
+            size_t matched_line_count = 0;
             while ((nread = getline(&line, &line_len, stdin)) != -1) {
                 VERIFY(nread > 0);
                 if (line[nread - 1] == '\n')
@@ -274,54 +535,149 @@ ErrorOr<int> serenity_main(Main::Arguments args)
                 if (is_binary && binary_mode == BinaryFileMode::Skip)
                     return 1;
 
-                auto matched = matches(line_view, "stdin"sv, line_number, false, is_binary);
-                did_match_something = did_match_something || matched;
-                if (matched && is_binary && binary_mode == BinaryFileMode::Binary)
+                StringBuilder output;
+                auto matched = matches(regular_expressions, line_view, "stdin"sv, line_number, false, is_binary, output);
+                out("{}", output.string_view());
+                if (matched) {
+                    did_match_something = true;
+                    ++matched_line_count;
+                }
+                if (matched && (quiet_mode || (is_binary && binary_mode == BinaryFileMode::Binary)))
                     break;
             }
 
             if (count_lines && !quiet_mode)
                 outln("{}", matched_line_count);
-        } else {
-            if (recursive) {
-                if (user_has_specified_files) {
-                    for (auto& filename : files) {
-                        add_directory(filename, {}, add_directory);
+        } else if (recursive) {
+            // The directories are walked on this thread, and every file that's found is searched on the thread pool
+            // right away. A file's output is held back until every file found before it has been written, so the
+            // output comes in traversal order.
+            struct FileResult {
+                DeprecatedString filename;
+                StringBuilder output;
+                Optional<Error> error;
+                bool finished { false };
+            };
+            auto& thread_pool = Threading::ThreadPool::the();
+            Threading::Mutex mutex;
+            Threading::ConditionVariable all_results_written { mutex };
+            Vector<OwnPtr<FileResult>> results;
+            size_t next_result_to_write = 0;
+
+            // Must be called with the mutex held.
+            auto write_finished_results = [&] {
+                for (; next_result_to_write < results.size() && results[next_result_to_write]->finished; ++next_result_to_write) {
+                    auto result = results[next_result_to_write].release_nonnull();
+                    out("{}", result->output.string_view());
+                    if (result->error.has_value() && !suppress_errors)
+                        warnln("Failed with file {}: {}", result->filename, result->error.release_value());
+                }
+                if (next_result_to_write == results.size())
+                    all_results_written.broadcast();
+            };
+
+            auto search_file_in_directory = [&](DeprecatedString filename) {
+                auto file_result = make<FileResult>();
+                file_result->filename = move(filename);
+                auto* result = file_result.ptr();
+                {
+                    Threading::MutexLocker locker(mutex);
+                    results.append(move(file_result));
+                }
+                thread_pool.submit([&, result] {
+                    if (!(quiet_mode && did_match_something.load())) {
+                        if (auto search_result = search_file(result->filename, true, result->output); search_result.is_error())
+                            result->error = search_result.release_error();
                     }
-                } else {
-                    add_directory(".", {}, add_directory);
+                    Threading::MutexLocker locker(mutex);
+                    result->finished = true;
+                    write_finished_results();
+                });
+            };
+
+            Function<void(DeprecatedString const&, size_t)> search_directory = [&](DeprecatedString const& path, size_t base_length) {
+                Core::DirIterator it(path, Core::DirIterator::Flags::SkipDots);
+                while (it.has_next()) {
+                    if (quiet_mode && did_match_something.load())
+                        return;
+                    auto entry = it.next();
+                    auto full_path = DeprecatedString::formatted(path.ends_with('/') ? "{}{}"sv : "{}/{}"sv, path, entry->name);
+
+                    auto is_directory = entry->type == Core::DirectoryEntry::Type::Directory;
+                    if (entry->type == Core::DirectoryEntry::Type::SymbolicLink || entry->type == Core::DirectoryEntry::Type::Unknown)
+                        is_directory = Core::DeprecatedFile::is_directory(full_path);
+
+                    if (is_directory)
+                        search_directory(full_path, base_length);
+                    else
+                        search_file_in_directory(full_path.substring(base_length));
                 }
+            };
+
+            auto search_path = [&](DeprecatedString const& path, size_t base_length) {
+                if (Core::DeprecatedFile::is_directory(path))
+                    search_directory(path, base_length);
+                else
+                    search_file_in_directory(path);
+            };
 
+            if (user_has_specified_files) {
+                for (auto& filename : files)
+                    search_path(filename, 0);
             } else {
-                bool print_filename { files.size() > 1 };
-                for (auto& filename : files) {
-                    auto result = handle_file(filename, print_filename);
-                    if (result.is_error()) {
-                        if (!suppress_errors)
-                            warnln("Failed with file {}: {}", filename, result.release_error());
-                        return 1;
-                    }
+                search_path(".", 2);
+            }
+
+            Threading::MutexLocker locker(mutex);
+            while (next_result_to_write != results.size())
+                all_results_written.wait();
+        } else {
+            // The files are searched at the same time, but their output is written in order.
+            struct FileResult {
+                StringBuilder output;
+                Optional<Error> error;
+            };
+            Vector<FileResult> results;
+            results.resize(files.size());
+
+            bool print_filename { files.size() > 1 };
+            Threading::ThreadPool::the().parallel_for(files.size(), [&](size_t i) {
+                if (quiet_mode && did_match_something.load())
+                    return;
+                if (auto result = search_file(files[i], print_filename, results[i].output); result.is_error())
+                    results[i].error = result.release_error();
+            });
+
+            for (size_t i = 0; i < files.size(); ++i) {
+                out("{}", results[i].output.string_view());
+                if (results[i].error.has_value()) {
+                    if (!suppress_errors)
+                        warnln("Failed with file {}: {}", files[i], results[i].error.release_value());
+                    return 1;
                 }
             }
         }
 
-        return did_match_something ? 0 : 1;
+        return did_match_something.load() ? 0 : 1;
     };
 
     if (use_ere) {
-        Vector<Regex<PosixExtended>> regular_expressions;
-        for (auto pattern : patterns) {
-            auto escaped_pattern = (fixed_strings) ? escape_characters(pattern, ere_special_characters) : pattern;
-            regular_expressions.append(Regex<PosixExtended>(escaped_pattern, options));
-        }
-        return grep_logic(regular_expressions);
+        return grep_logic([&] {
+            Vector<Regex<PosixExtended>> regular_expressions;
+            for (auto pattern : patterns) {
+                auto escaped_pattern = (fixed_strings) ? escape_characters(pattern, ere_special_characters) : pattern;
+                regular_expressions.append(Regex<PosixExtended>(escaped_pattern, options));
+            }
+            return regular_expressions;
+        });
     }
 
-    Vector<Regex<PosixBasic>> regular_expressions;
-    for (auto pattern : patterns) {
-        auto escaped_pattern = (fixed_strings) ? escape_characters(pattern, basic_special_characters) : pattern;
-        dbgln("'{}'", escaped_pattern);
-        regular_expressions.append(Regex<PosixBasic>(escaped_pattern, options));
-    }
-    return grep_logic(regular_expressions);
+    return grep_logic([&] {
+        Vector<Regex<PosixBasic>> regular_expressions;
+        for (auto pattern : patterns) {
+            auto escaped_pattern = (fixed_strings) ? escape_characters(pattern, basic_special_characters) : pattern;
+            regular_expressions.append(Regex<PosixBasic>(escaped_pattern, options));
+        }
+        return regular_expressions;
+    });
 }
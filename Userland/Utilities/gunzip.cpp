@@ -5,19 +5,18 @@
  */
 
 #include <LibCompress/Gzip.h>
+#include <LibCompress/Zstd.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/File.h>
 #include <LibCore/System.h>
 #include <LibMain/Main.h>
 #include <unistd.h>
 
-static ErrorOr<void> decompress_file(NonnullOwnPtr<Core::File> input_stream, Stream& output_stream)
+static ErrorOr<void> decompress_file(Stream& decompressor, Stream& output_stream)
 {
-    auto gzip_stream = Compress::GzipDecompressor { move(input_stream) };
-
     auto buffer = TRY(ByteBuffer::create_uninitialized(4096));
-    while (!gzip_stream.is_eof()) {
-        auto span = TRY(gzip_stream.read(buffer));
+    while (!decompressor.is_eof()) {
+        auto span = TRY(decompressor.read(buffer));
         TRY(output_stream.write_entire_buffer(span));
     }
 
@@ -43,9 +42,13 @@ ErrorOr<int> serenity_main(Main::Arguments args)
 
         DeprecatedString input_filename;
         DeprecatedString output_filename;
+        bool const is_zstd = filename.ends_with(".zst"sv);
         if (filename.ends_with(".gz"sv)) {
             input_filename = filename;
             output_filename = filename.substring_view(0, filename.length() - 3);
+        } else if (is_zstd) {
+            input_filename = filename;
+            output_filename = filename.substring_view(0, filename.length() - 4);
         } else {
             input_filename = DeprecatedString::formatted("{}.gz", filename);
             output_filename = filename;
@@ -54,7 +57,13 @@ ErrorOr<int> serenity_main(Main::Arguments args)
         auto input_stream_result = TRY(Core::File::open(input_filename, Core::File::OpenMode::Read));
         auto output_stream = write_to_stdout ? TRY(Core::File::standard_output()) : TRY(Core::File::open(output_filename, Core::File::OpenMode::Write));
 
-        TRY(decompress_file(move(input_stream_result), *output_stream));
+        if (is_zstd) {
+            auto zstd_stream = TRY(Compress::ZstdDecompressor::construct(move(input_stream_result)));
+            TRY(decompress_file(*zstd_stream, *output_stream));
+        } else {
+            Compress::GzipDecompressor gzip_stream { move(input_stream_result) };
+            TRY(decompress_file(gzip_stream, *output_stream));
+        }
 
         if (!keep_input_files)
             TRY(Core::System::unlink(input_filename));
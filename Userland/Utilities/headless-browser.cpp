@@ -4,13 +4,18 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
 #include <AK/Assertions.h>
 #include <AK/ByteBuffer.h>
 #include <AK/Format.h>
 #include <AK/HashTable.h>
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
 #include <AK/LexicalPath.h>
 #include <AK/NonnullOwnPtr.h>
+#include <AK/QuickSort.h>
 #include <AK/StringBuilder.h>
+#include <AK/Time.h>
 #include <AK/Types.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/ConfigFile.h>
@@ -39,6 +44,7 @@
 #include <LibWeb/Loader/ResourceLoader.h>
 #include <LibWeb/Page/Page.h>
 #include <LibWeb/Painting/PaintableBox.h>
+#include <LibWeb/PhaseTimings.h>
 #include <LibWeb/Platform/EventLoopPluginSerenity.h>
 #include <LibWeb/Platform/FontPluginSerenity.h>
 #include <LibWeb/Platform/ImageCodecPlugin.h>
@@ -107,6 +113,8 @@ public:
         m_screen_rect = screen_rect;
     }
 
+    Function<void()> on_load_finish;
+
     ErrorOr<void> connect_to_webdriver(StringView webdriver_ipc_path)
     {
         VERIFY(!m_webdriver);
@@ -152,6 +160,8 @@ public:
 
     virtual void page_did_finish_loading(AK::URL const&) override
     {
+        if (on_load_finish)
+            on_load_finish();
     }
 
     virtual void page_did_change_selection() override
@@ -709,14 +719,149 @@ static void load_page_for_screenshot_and_exit(HeadlessBrowserPageClient& page_cl
     timer->start();
 }
 
+struct PageLoadTimings {
+    Time total;
+    Array<Time, to_underlying(Web::TimedPhase::__Count)> phases;
+};
+
+// Loads every page a number of times, and reports how long it took until it was painted for the first time, and which
+// phases of loading and rendering that time went to.
+class PageLoadBenchmark {
+public:
+    PageLoadBenchmark(HeadlessBrowserPageClient& page_client, Vector<AK::URL> urls, size_t load_count, StringView json_path)
+        : m_page_client(page_client)
+        , m_urls(move(urls))
+        , m_load_count(load_count)
+        , m_json_path(json_path)
+    {
+        m_timings.resize(m_urls.size());
+    }
+
+    void start()
+    {
+        Web::PhaseTimings::the().set_enabled(true);
+        m_page_client.on_load_finish = [this] { did_finish_load(); };
+        start_load();
+    }
+
+private:
+    void start_load()
+    {
+        if (m_url_index == m_urls.size()) {
+            report_and_exit();
+            return;
+        }
+
+        Web::PhaseTimings::the().reset();
+        m_load_start = Time::now_monotonic();
+        m_page_client.load(m_urls[m_url_index]);
+    }
+
+    void did_finish_load()
+    {
+        auto output_rect = m_page_client.screen_rect();
+        auto output_bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, output_rect.size().to_type<int>()));
+        m_page_client.paint(output_rect, output_bitmap);
+
+        PageLoadTimings timings;
+        timings.total = Time::now_monotonic() - m_load_start;
+        for (size_t i = 0; i < timings.phases.size(); ++i)
+            timings.phases[i] = Web::PhaseTimings::the().time_spent_in(static_cast<Web::TimedPhase>(i));
+
+        // The first load of a page fills the caches, and isn't counted.
+        if (m_has_warmed_up)
+            m_timings[m_url_index].append(timings);
+        m_has_warmed_up = true;
+
+        if (m_timings[m_url_index].size() == m_load_count) {
+            ++m_url_index;
+            m_has_warmed_up = false;
+        }
+
+        // Let the loader finish up before replacing the page.
+        Core::deferred_invoke([this] { start_load(); });
+    }
+
+    struct Summary {
+        double median_milliseconds { 0 };
+        double minimum_milliseconds { 0 };
+    };
+
+    static Summary summarize(Vector<PageLoadTimings> const& timings, Function<Time(PageLoadTimings const&)> const& get_time)
+    {
+        Vector<i64> times;
+        for (auto const& timing : timings)
+            times.append(get_time(timing).to_microseconds());
+        quick_sort(times);
+        auto median = times.size() % 2 == 1 ? times[times.size() / 2] : (times[times.size() / 2 - 1] + times[times.size() / 2]) / 2;
+        return { median / 1000.0, times.first() / 1000.0 };
+    }
+
+    void report_and_exit()
+    {
+        JsonArray pages;
+        for (size_t i = 0; i < m_urls.size(); ++i) {
+            auto const& timings = m_timings[i];
+
+            JsonObject median_milliseconds;
+            JsonObject minimum_milliseconds;
+            auto total = summarize(timings, [](auto& timing) { return timing.total; });
+            median_milliseconds.set("total", total.median_milliseconds);
+            minimum_milliseconds.set("total", total.minimum_milliseconds);
+
+            StringBuilder builder;
+            for (size_t phase = 0; phase < to_underlying(Web::TimedPhase::__Count); ++phase) {
+                auto name = Web::timed_phase_name(static_cast<Web::TimedPhase>(phase));
+                auto summary = summarize(timings, [phase](auto& timing) { return timing.phases[phase]; });
+                median_milliseconds.set(name, summary.median_milliseconds);
+                minimum_milliseconds.set(name, summary.minimum_milliseconds);
+                builder.appendff("{}{} {:.2}ms", phase == 0 ? "" : ", ", name, summary.median_milliseconds);
+            }
+
+            outln("{}: {} loads, median {:.2}ms, minimum {:.2}ms ({})", m_urls[i], timings.size(), total.median_milliseconds, total.minimum_milliseconds, builder.string_view());
+
+            JsonObject page;
+            page.set("url", m_urls[i].to_deprecated_string());
+            page.set("loads", timings.size());
+            page.set("median_ms", move(median_milliseconds));
+            page.set("minimum_ms", move(minimum_milliseconds));
+            pages.append(move(page));
+        }
+
+        if (!m_json_path.is_empty()) {
+            JsonObject results;
+            results.set("pages", move(pages));
+            auto file = Core::File::open(m_json_path, Core::File::OpenMode::Write);
+            if (file.is_error() || file.value()->write_entire_buffer(results.to_deprecated_string().bytes()).is_error()) {
+                warnln("Failed to write the results to {}", m_json_path);
+                exit(1);
+            }
+        }
+
+        exit(0);
+    }
+
+    HeadlessBrowserPageClient& m_page_client;
+    Vector<AK::URL> m_urls;
+    size_t m_load_count { 0 };
+    StringView m_json_path;
+
+    Vector<Vector<PageLoadTimings>> m_timings;
+    size_t m_url_index { 0 };
+    bool m_has_warmed_up { false };
+    Time m_load_start;
+};
+
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
     int take_screenshot_after = 1;
-    StringView url;
+    Vector<StringView> urls;
     StringView resources_folder;
     StringView error_page_url;
     StringView ca_certs_path;
     StringView webdriver_ipc_path;
+    size_t benchmark_load_count = 0;
+    StringView benchmark_json_path;
 
     Core::EventLoop event_loop;
     Core::ArgsParser args_parser;
@@ -726,9 +871,16 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(error_page_url, "URL for the error page (defaults to file:///res/html/error.html)", "error-page", 'e', "error-page-url");
     args_parser.add_option(ca_certs_path, "The bundled ca certificates file", "certs", 'c', "ca-certs-path");
     args_parser.add_option(webdriver_ipc_path, "Path to the WebDriver IPC socket", "webdriver-ipc-path", 0, "path");
-    args_parser.add_positional_argument(url, "URL to open", "url", Core::ArgsParser::Required::Yes);
+    args_parser.add_option(benchmark_load_count, "Instead of taking a screenshot, load each URL [n] times and report the median time spent in each phase", "benchmark", 'b', "n");
+    args_parser.add_option(benchmark_json_path, "Write the benchmark results to a JSON file", "benchmark-json", 0, "path");
+    args_parser.add_positional_argument(urls, "URL to open, or URLs to benchmark", "url", Core::ArgsParser::Required::Yes);
     args_parser.parse(arguments);
 
+    if (benchmark_load_count == 0 && urls.size() > 1) {
+        warnln("Only one URL can be opened, unless benchmarking");
+        return 1;
+    }
+
     Web::Platform::EventLoopPlugin::install(*new Web::Platform::EventLoopPluginSerenity);
     Web::Platform::FontPlugin::install(*new Web::Platform::FontPluginSerenity);
     Web::Platform::ImageCodecPlugin::install(*new ImageCodecPluginHeadless);
@@ -766,13 +918,23 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         page_client->setup_palette(system_theme);
     }
 
-    dbgln("Loading {}", url);
-    page_client->load(AK::URL(url));
-
     // FIXME: Allow passing these values as arguments
     page_client->set_viewport_rect({ 0, 0, 800, 600 });
     page_client->set_screen_rect({ 0, 0, 800, 600 });
 
+    if (benchmark_load_count != 0) {
+        Vector<AK::URL> benchmark_urls;
+        for (auto url : urls)
+            benchmark_urls.append(AK::URL(url));
+
+        auto benchmark = make<PageLoadBenchmark>(*page_client, move(benchmark_urls), benchmark_load_count, benchmark_json_path);
+        benchmark->start();
+        return event_loop.exec();
+    }
+
+    dbgln("Loading {}", urls.first());
+    page_client->load(AK::URL(urls.first()));
+
     if (!webdriver_ipc_path.is_empty())
         TRY(page_client->connect_to_webdriver(webdriver_ipc_path));
     else
@@ -45,6 +45,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
             auto netmask = if_object.get_deprecated_string("ipv4_netmask"sv).value_or({});
             auto packets_in = if_object.get_u32("packets_in"sv).value_or(0);
             auto bytes_in = if_object.get_u32("bytes_in"sv).value_or(0);
+            auto packets_dropped = if_object.get_u32("packets_dropped"sv).value_or(0);
             auto packets_out = if_object.get_u32("packets_out"sv).value_or(0);
             auto bytes_out = if_object.get_u32("bytes_out"sv).value_or(0);
             auto mtu = if_object.get_u32("mtu"sv).value_or(0);
@@ -54,7 +55,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
             outln("\tipv4: {}", ipv4_address);
             outln("\tnetmask: {}", netmask);
             outln("\tclass: {}", class_name);
-            outln("\tRX: {} packets {} bytes ({})", packets_in, bytes_in, human_readable_size(bytes_in));
+            outln("\tRX: {} packets {} bytes ({}) {} dropped", packets_in, bytes_in, human_readable_size(bytes_in), packets_dropped);
             outln("\tTX: {} packets {} bytes ({})", packets_out, bytes_out, human_readable_size(bytes_out));
             outln("\tMTU: {}", mtu);
             outln();
@@ -19,6 +19,7 @@
 #include <LibJS/Print.h>
 #include <LibJS/Runtime/ConsoleObject.h>
 #include <LibJS/Runtime/JSONObject.h>
+#include <LibJS/Runtime/SamplingProfiler.h>
 #include <LibJS/Runtime/StringPrototype.h>
 #include <LibJS/Runtime/ThrowableStringBuilder.h>
 #include <LibJS/SourceTextModule.h>
@@ -182,6 +183,17 @@ static ErrorOr<String> read_next_piece()
     return piece.to_string();
 }
 
+static ErrorOr<void> write_profile(JS::SamplingProfiler& profiler, StringView path)
+{
+    profiler.stop();
+    StringBuilder builder;
+    TRY(profiler.write_perfcore_json(builder, "/bin/js"sv));
+    auto file = TRY(Core::File::open(path, Core::File::OpenMode::Write, 0666));
+    TRY(file->write_entire_buffer(builder.string_view().bytes()));
+    warnln("Wrote {} samples to {}", profiler.sample_count(), path);
+    return {};
+}
+
 static ErrorOr<void> write_to_file(String const& path)
 {
     auto file = TRY(Core::File::open(path, Core::File::OpenMode::Write, 0666));
@@ -599,6 +611,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool gc_on_every_allocation = false;
     bool disable_syntax_highlight = false;
     StringView evaluate_script;
+    StringView profile_path;
     Vector<StringView> script_paths;
 
     Core::ArgsParser args_parser;
@@ -614,6 +627,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(gc_on_every_allocation, "GC on every allocation", "gc-on-every-allocation", 'g');
     args_parser.add_option(disable_syntax_highlight, "Disable live syntax highlighting", "no-syntax-highlight", 's');
     args_parser.add_option(evaluate_script, "Evaluate argument as a script", "evaluate", 'c', "script");
+    args_parser.add_option(profile_path, "Write a sampling profile of the JS call stacks to the given file (in the Profiler's format)", "profile", 0, "path");
     args_parser.add_positional_argument(script_paths, "Path to script files", "scripts", Core::ArgsParser::Required::No);
     args_parser.parse(arguments);
 
@@ -640,6 +654,13 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         (void)print(promise.result(), PrintTarget::StandardError);
         warnln(")");
     };
+
+    OwnPtr<JS::SamplingProfiler> profiler;
+    if (!profile_path.is_empty()) {
+        profiler = make<JS::SamplingProfiler>(*g_vm);
+        profiler->start();
+    }
+
     OwnPtr<JS::Interpreter> interpreter;
 
     // FIXME: Figure out some way to interrupt the interpreter now that vm.exception() is gone.
@@ -856,6 +877,8 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         s_editor->on_tab_complete = move(complete);
         TRY(repl(*interpreter));
         s_editor->save_history(s_history_path.to_deprecated_string());
+        if (profiler)
+            TRY(write_profile(*profiler, profile_path));
     } else {
         interpreter = JS::Interpreter::create<ScriptObject>(*g_vm);
         auto& console_object = *interpreter->realm().intrinsics().console_object();
@@ -898,7 +921,10 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
         // We resolve modules as if it is the first file
 
-        if (!TRY(parse_and_run(*interpreter, builder.string_view(), source_name)))
+        auto success = TRY(parse_and_run(*interpreter, builder.string_view(), source_name));
+        if (profiler)
+            TRY(write_profile(*profiler, profile_path));
+        if (!success)
             return 1;
     }
 
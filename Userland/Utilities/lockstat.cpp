@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/DeprecatedString.h>
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/QuickSort.h>
+#include <AK/Vector.h>
+#include <LibCore/ArgsParser.h>
+#include <LibCore/File.h>
+#include <LibCore/System.h>
+#include <LibMain/Main.h>
+
+struct LockStatistics {
+    DeprecatedString name;
+    u64 acquisitions { 0 };
+    u64 contended_acquisitions { 0 };
+    u64 total_wait_ns { 0 };
+    u64 max_wait_ns { 0 };
+    u64 total_hold_ns { 0 };
+    u64 max_hold_ns { 0 };
+};
+
+static DeprecatedString format_duration(u64 nanoseconds)
+{
+    if (nanoseconds >= 1'000'000'000)
+        return DeprecatedString::formatted("{}.{:03}s", nanoseconds / 1'000'000'000, (nanoseconds / 1'000'000) % 1000);
+    if (nanoseconds >= 1'000'000)
+        return DeprecatedString::formatted("{}.{:03}ms", nanoseconds / 1'000'000, (nanoseconds / 1000) % 1000);
+    if (nanoseconds >= 1000)
+        return DeprecatedString::formatted("{}.{:03}us", nanoseconds / 1000, nanoseconds % 1000);
+    return DeprecatedString::formatted("{}ns", nanoseconds);
+}
+
+ErrorOr<int> serenity_main(Main::Arguments arguments)
+{
+    TRY(Core::System::pledge("stdio rpath"));
+    TRY(Core::System::unveil("/sys/kernel/lock_statistics", "r"));
+    TRY(Core::System::unveil("/sys/kernel/variables/lock_statistics", "r"));
+    TRY(Core::System::unveil(nullptr, nullptr));
+
+    StringView sort_by = "wait"sv;
+    size_t max_rows = 0;
+
+    Core::ArgsParser args_parser;
+    args_parser.set_general_help("Show aggregate kernel lock statistics.");
+    args_parser.add_option(sort_by, "Sort by 'wait' (default), 'hold', 'contended' or 'acquisitions'", "sort", 's', "key");
+    args_parser.add_option(max_rows, "Only show the first N locks", "count", 'n', "N");
+    args_parser.parse(arguments);
+
+    if (!sort_by.is_one_of("wait"sv, "hold"sv, "contended"sv, "acquisitions"sv)) {
+        warnln("Unknown sort key '{}'", sort_by);
+        return 1;
+    }
+
+    auto enabled_file = TRY(Core::File::open("/sys/kernel/variables/lock_statistics"sv, Core::File::OpenMode::Read));
+    auto statistics_file = TRY(Core::File::open("/sys/kernel/lock_statistics"sv, Core::File::OpenMode::Read));
+
+    TRY(Core::System::pledge("stdio"));
+
+    auto enabled = TRY(enabled_file->read_until_eof());
+    if (StringView { enabled }.trim_whitespace() != "1"sv)
+        warnln("Lock statistics collection is disabled, enable it with: sysctl -w lock_statistics=1");
+
+    auto file_contents = TRY(statistics_file->read_until_eof());
+    auto json = TRY(JsonValue::from_string(file_contents));
+
+    Vector<LockStatistics> locks;
+    json.as_array().for_each([&](JsonValue const& value) {
+        auto& object = value.as_object();
+        locks.append({
+            .name = object.get_deprecated_string("name"sv).value_or({}),
+            .acquisitions = object.get_u64("acquisitions"sv).value_or(0),
+            .contended_acquisitions = object.get_u64("contended_acquisitions"sv).value_or(0),
+            .total_wait_ns = object.get_u64("total_wait_ns"sv).value_or(0),
+            .max_wait_ns = object.get_u64("max_wait_ns"sv).value_or(0),
+            .total_hold_ns = object.get_u64("total_hold_ns"sv).value_or(0),
+            .max_hold_ns = object.get_u64("max_hold_ns"sv).value_or(0),
+        });
+    });
+
+    auto sort_key = [&](LockStatistics const& lock) {
+        if (sort_by == "hold"sv)
+            return lock.total_hold_ns;
+        if (sort_by == "contended"sv)
+            return lock.contended_acquisitions;
+        if (sort_by == "acquisitions"sv)
+            return lock.acquisitions;
+        return lock.total_wait_ns;
+    };
+    quick_sort(locks, [&](auto& a, auto& b) { return sort_key(a) > sort_key(b); });
+
+    if (max_rows != 0 && locks.size() > max_rows)
+        locks.shrink(max_rows);
+
+    outln("{:<32} {:>12} {:>12} {:>12} {:>12} {:>12} {:>12}", "NAME", "ACQUIRED", "CONTENDED", "TOTAL WAIT", "MAX WAIT", "TOTAL HOLD", "MAX HOLD");
+    for (auto const& lock : locks) {
+        outln("{:<32} {:>12} {:>12} {:>12} {:>12} {:>12} {:>12}",
+            lock.name,
+            lock.acquisitions,
+            lock.contended_acquisitions,
+            format_duration(lock.total_wait_ns),
+            format_duration(lock.max_wait_ns),
+            format_duration(lock.total_hold_ns),
+            format_duration(lock.max_hold_ns));
+    }
+
+    return 0;
+}
@@ -97,6 +97,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     unsigned delay = 0;
     bool select_region = false;
     bool edit_image = false;
+    bool fast_compression = false;
     int screen = -1;
 
     args_parser.add_positional_argument(output_path, "Output filename", "output", Core::ArgsParser::Required::No);
@@ -105,6 +106,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(screen, "The index of the screen (default: -1 for all screens)", "screen", 's', "index");
     args_parser.add_option(select_region, "Select a region to capture", "region", 'r');
     args_parser.add_option(edit_image, "Open in PixelPaint", "edit", 'e');
+    args_parser.add_option(fast_compression, "Compress quickly at the cost of a larger file", "fast", 'f');
 
     args_parser.parse(arguments);
 
@@ -150,7 +152,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         return 0;
     }
 
-    auto encoded_bitmap_or_error = Gfx::PNGWriter::encode(*bitmap);
+    auto encoded_bitmap_or_error = Gfx::PNGWriter::encode(*bitmap, fast_compression ? Gfx::PNGWriter::CompressionLevel::Fast : Gfx::PNGWriter::CompressionLevel::Best);
     if (encoded_bitmap_or_error.is_error()) {
         warnln("Failed to encode PNG");
         return 1;
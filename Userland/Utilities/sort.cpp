@@ -5,21 +5,28 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BinaryHeap.h>
 #include <AK/DeprecatedString.h>
-#include <AK/HashMap.h>
+#include <AK/LexicalPath.h>
 #include <AK/QuickSort.h>
+#include <AK/StringBuilder.h>
 #include <AK/Vector.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/File.h>
 #include <LibCore/System.h>
 #include <LibMain/Main.h>
+#include <LibThreading/ThreadPool.h>
 #include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
 
 struct Line {
     StringView key;
     long int numeric_key;
     DeprecatedString line;
     bool numeric;
+    // Where the line was among the ones that were read in together, for keeping lines with equal keys in order.
+    size_t index { 0 };
 
     bool operator<(Line const& other) const
     {
@@ -40,54 +47,333 @@ struct Line {
 private:
 };
 
-template<>
-struct AK::Traits<Line> : public GenericTraits<Line> {
-    static unsigned hash(Line l)
-    {
-        if (l.numeric)
-            return l.numeric_key;
-
-        return l.key.hash();
-    }
-};
-
 struct Options {
     size_t key_field { 0 };
     bool unique { false };
     bool numeric { false };
     StringView separator { "\0", 1 };
+    size_t memory_limit { 256 * MiB };
+    StringView temporary_directory;
     Vector<DeprecatedString> files;
 };
 
-static ErrorOr<void> load_file(Options options, StringView filename, Vector<Line>& lines, HashTable<Line>& seen)
+// How many sorted runs are merged at once. With more runs than this, the oldest ones are merged into one first.
+static constexpr size_t max_merge_width = 32;
+
+// Sorting fewer lines than this on multiple threads isn't worth the trouble.
+static constexpr size_t min_lines_per_chunk = 16 * KiB;
+
+static Line make_line(Options const& options, DeprecatedString line)
 {
-    auto file = TRY(Core::BufferedFile::create(
-        TRY(Core::File::open_file_or_standard_stream(filename, Core::File::OpenMode::Read))));
-
-    // FIXME: Unlimited line length
-    auto buffer = TRY(ByteBuffer::create_uninitialized(4096));
-    while (TRY(file->can_read_line())) {
-        DeprecatedString line = TRY(file->read_line(buffer));
-
-        StringView key = line;
-        if (options.key_field != 0) {
-            auto split = (options.separator[0])
-                ? line.split_view(options.separator[0])
-                : line.split_view(isspace);
-            if (options.key_field - 1 >= split.size()) {
-                key = ""sv;
-            } else {
-                key = split[options.key_field - 1];
+    StringView key = line;
+    if (options.key_field != 0) {
+        auto split = (options.separator[0])
+            ? line.split_view(options.separator[0])
+            : line.split_view(isspace);
+        if (options.key_field - 1 >= split.size()) {
+            key = ""sv;
+        } else {
+            key = split[options.key_field - 1];
+        }
+    }
+
+    return { key, key.to_int().value_or(0), move(line), options.numeric };
+}
+
+// Reads lines of any length, which BufferedFile can't do.
+class LineReader {
+public:
+    explicit LineReader(NonnullOwnPtr<Core::File> file)
+        : m_file(move(file))
+    {
+    }
+
+    ErrorOr<Optional<DeprecatedString>> next_line()
+    {
+        for (;;) {
+            auto unread = m_buffer.bytes().slice(m_line_start);
+            if (auto* newline = static_cast<u8 const*>(memchr(unread.data() + m_searched_size, '\n', unread.size() - m_searched_size))) {
+                auto length = newline - unread.data();
+                DeprecatedString line { StringView { unread.trim(length) } };
+                m_line_start += length + 1;
+                m_searched_size = 0;
+                return line;
+            }
+            m_searched_size = unread.size();
+
+            if (m_is_eof) {
+                if (unread.is_empty())
+                    return Optional<DeprecatedString> {};
+                DeprecatedString line { StringView { unread } };
+                m_line_start = m_buffer.size();
+                m_searched_size = 0;
+                return line;
+            }
+
+            // Drop the lines we've already returned, then read some more.
+            if (m_line_start > 0) {
+                m_buffer = TRY(ByteBuffer::copy(unread));
+                m_line_start = 0;
             }
+            auto old_size = m_buffer.size();
+            TRY(m_buffer.try_resize(old_size + read_size));
+            auto read = TRY(m_file->read(m_buffer.bytes().slice(old_size)));
+            m_buffer.resize(old_size + read.size());
+            if (read.is_empty())
+                m_is_eof = true;
+        }
+    }
+
+private:
+    static constexpr size_t read_size = 64 * KiB;
+
+    NonnullOwnPtr<Core::File> m_file;
+    ByteBuffer m_buffer;
+    size_t m_line_start { 0 };
+    // How much of the line we're looking at we've already looked for a newline in.
+    size_t m_searched_size { 0 };
+    bool m_is_eof { false };
+};
+
+// A sequence of lines in sorted order, either still in memory or spilled to a temporary file. Between lines that
+// compare equal, the one that was read first comes first, which is what lets --unique keep the first of them.
+class SortedRun {
+public:
+    explicit SortedRun(Span<Line> lines)
+        : m_lines(lines)
+    {
+    }
+
+    static ErrorOr<SortedRun> create_file_run(Options const& options, NonnullOwnPtr<Core::File> file)
+    {
+        TRY(file->seek(0, SeekMode::SetPosition));
+        SortedRun run { {} };
+        run.m_reader = make<LineReader>(move(file));
+        run.m_options = &options;
+        return run;
+    }
+
+    ErrorOr<Optional<Line>> next()
+    {
+        if (!m_reader) {
+            if (m_lines.is_empty())
+                return Optional<Line> {};
+            auto line = move(m_lines[0]);
+            m_lines = m_lines.slice(1);
+            return line;
+        }
+
+        auto line = TRY(m_reader->next_line());
+        if (!line.has_value())
+            return Optional<Line> {};
+        return make_line(*m_options, line.release_value());
+    }
+
+private:
+    Span<Line> m_lines;
+    OwnPtr<LineReader> m_reader;
+    Options const* m_options { nullptr };
+};
+
+// Runs that were read earlier have lower indices, so ties go to the line that was read first.
+struct MergeKey {
+    Line line;
+    size_t run_index { 0 };
+
+    bool operator<(MergeKey const& other) const
+    {
+        if (line < other.line)
+            return true;
+        return line == other.line && run_index < other.run_index;
+    }
+    bool operator<=(MergeKey const& other) const { return !(other < *this); }
+    bool operator>=(MergeKey const& other) const { return !(*this < other); }
+};
+
+template<typename Callback>
+static ErrorOr<void> merge(Options const& options, Span<SortedRun> runs, Callback on_line)
+{
+    VERIFY(runs.size() <= max_merge_width);
+
+    if (runs.size() == 1 && !options.unique) {
+        for (;;) {
+            auto line = TRY(runs[0].next());
+            if (!line.has_value())
+                return {};
+            TRY(on_line(*line));
+        }
+    }
+
+    BinaryHeap<MergeKey, size_t, max_merge_width> heap;
+    for (size_t i = 0; i < runs.size(); ++i) {
+        if (auto line = TRY(runs[i].next()); line.has_value())
+            heap.insert({ line.release_value(), i }, i);
+    }
+
+    Optional<Line> previous_line;
+    while (!heap.is_empty()) {
+        auto line = heap.peek_min_key().line;
+        auto run_index = heap.pop_min();
+        if (auto next_line = TRY(runs[run_index].next()); next_line.has_value())
+            heap.insert({ next_line.release_value(), run_index }, run_index);
+
+        if (options.unique) {
+            if (previous_line.has_value() && *previous_line == line)
+                continue;
+            previous_line = line;
+        }
+        TRY(on_line(line));
+    }
+
+    return {};
+}
+
+// Reads lines up to the memory limit, sorts them on all threads, and writes each batch out to a temporary file
+// as a sorted run. The runs are merged at the end.
+class Sorter {
+public:
+    explicit Sorter(Options const& options)
+        : m_options(options)
+    {
+    }
+
+    ErrorOr<void> add_line(DeprecatedString line)
+    {
+        // The line, its entry in m_lines and the string's own header.
+        m_buffered_size += line.length() + sizeof(Line) + 32;
+        auto added_line = make_line(m_options, move(line));
+        added_line.index = m_lines.size();
+        m_lines.append(move(added_line));
+
+        if (m_buffered_size >= m_options.memory_limit)
+            TRY(spill());
+        return {};
+    }
+
+    ErrorOr<void> finish()
+    {
+        auto chunks = sort_buffered_lines();
+
+        // Leave room for the chunks in memory in the final merge.
+        while (m_spilled_runs.size() + chunks.size() > max_merge_width)
+            TRY(merge_oldest_runs());
+
+        Vector<SortedRun> runs;
+        for (auto& file : m_spilled_runs)
+            runs.append(TRY(SortedRun::create_file_run(m_options, move(file))));
+        m_spilled_runs.clear();
+        runs.extend(move(chunks));
+
+        return merge(m_options, runs, [](Line const& line) -> ErrorOr<void> {
+            outln("{}", line.line);
+            return {};
+        });
+    }
+
+private:
+    // Sorts the buffered lines in chunks, one for each thread. Each chunk becomes a run.
+    Vector<SortedRun> sort_buffered_lines()
+    {
+        auto& thread_pool = Threading::ThreadPool::the();
+        auto chunk_count = clamp(m_lines.size() / min_lines_per_chunk, static_cast<size_t>(1), min(thread_pool.worker_count(), max_merge_width / 2));
+
+        Vector<Span<Line>> chunks;
+        auto lines = m_lines.span();
+        for (size_t i = 0; i < chunk_count; ++i) {
+            auto begin = lines.size() * i / chunk_count;
+            auto end = lines.size() * (i + 1) / chunk_count;
+            chunks.append(lines.slice(begin, end - begin));
         }
 
-        Line l = { key, key.to_int().value_or(0), line, options.numeric };
+        thread_pool.parallel_for(chunk_count, [&](size_t i) {
+            quick_sort(chunks[i], [](Line const& a, Line const& b) {
+                if (a < b)
+                    return true;
+                return a == b && a.index < b.index;
+            });
+        });
+
+        Vector<SortedRun> runs;
+        for (auto chunk : chunks)
+            runs.append(SortedRun { chunk });
+        return runs;
+    }
 
-        if (!options.unique || !seen.contains(l)) {
-            lines.append(l);
-            if (options.unique)
-                seen.set(l);
+    ErrorOr<NonnullOwnPtr<Core::File>> create_temporary_file()
+    {
+        auto directory = m_options.temporary_directory;
+        if (directory.is_empty()) {
+            char const* env_directory = getenv("TMPDIR");
+            directory = env_directory && *env_directory ? StringView { env_directory, strlen(env_directory) } : "/tmp"sv;
         }
+
+        auto path = LexicalPath::join(directory, "sort.XXXXXX"sv).string();
+        Vector<char> path_template;
+        path_template.append(path.characters(), path.length() + 1);
+        auto fd = TRY(Core::System::mkstemp(path_template));
+
+        // Nobody else needs to see the file, and this way it goes away on its own once we're done with it.
+        TRY(Core::System::unlink({ path_template.data(), path.length() }));
+        return Core::File::adopt_fd(fd, Core::File::OpenMode::ReadWrite);
+    }
+
+    ErrorOr<void> write_run(Span<SortedRun> runs)
+    {
+        auto file = TRY(create_temporary_file());
+
+        StringBuilder builder;
+        TRY(merge(m_options, runs, [&](Line const& line) -> ErrorOr<void> {
+            builder.append(line.line);
+            builder.append('\n');
+            if (builder.length() >= 64 * KiB) {
+                TRY(file->write_entire_buffer(builder.string_view().bytes()));
+                builder.clear();
+            }
+            return {};
+        }));
+        TRY(file->write_entire_buffer(builder.string_view().bytes()));
+
+        m_spilled_runs.append(move(file));
+        return {};
+    }
+
+    ErrorOr<void> spill()
+    {
+        auto runs = sort_buffered_lines();
+        TRY(write_run(runs));
+
+        m_lines.clear_with_capacity();
+        m_buffered_size = 0;
+        return {};
+    }
+
+    ErrorOr<void> merge_oldest_runs()
+    {
+        // The merged run replaces the oldest runs, so the runs stay in the order their lines were read in.
+        Vector<SortedRun> runs;
+        for (size_t i = 0; i < max_merge_width; ++i)
+            runs.append(TRY(SortedRun::create_file_run(m_options, move(m_spilled_runs[i]))));
+        m_spilled_runs.remove(0, max_merge_width);
+
+        TRY(write_run(runs));
+        m_spilled_runs.prepend(m_spilled_runs.take_last());
+        return {};
+    }
+
+    Options const& m_options;
+    Vector<Line> m_lines;
+    size_t m_buffered_size { 0 };
+    Vector<NonnullOwnPtr<Core::File>> m_spilled_runs;
+};
+
+static ErrorOr<void> load_file(StringView filename, Sorter& sorter)
+{
+    LineReader reader { TRY(Core::File::open_file_or_standard_stream(filename, Core::File::OpenMode::Read)) };
+    for (;;) {
+        auto line = TRY(reader.next_line());
+        if (!line.has_value())
+            break;
+        TRY(sorter.add_line(line.release_value()));
     }
 
     return {};
@@ -95,7 +381,7 @@ static ErrorOr<void> load_file(Options options, StringView filename, Vector<Line
 
 ErrorOr<int> serenity_main([[maybe_unused]] Main::Arguments arguments)
 {
-    TRY(Core::System::pledge("stdio rpath"));
+    TRY(Core::System::pledge("stdio rpath wpath cpath thread"));
 
     Options options;
 
@@ -104,25 +390,52 @@ ErrorOr<int> serenity_main([[maybe_unused]] Main::Arguments arguments)
     args_parser.add_option(options.unique, "Don't emit duplicate lines", "unique", 'u');
     args_parser.add_option(options.numeric, "treat the key field as a number", "numeric", 'n');
     args_parser.add_option(options.separator, "The separator to split fields by", "sep", 't', "char");
+    args_parser.add_option(Core::ArgsParser::Option {
+        .argument_mode = Core::ArgsParser::OptionArgumentMode::Required,
+        .help_string = "Use at most this much memory for lines, and sort the rest in temporary files (default 256M)",
+        .long_name = "buffer-size",
+        .short_name = 'S',
+        .value_name = "size",
+        .accept_value = [&](StringView value) {
+            size_t multiplier = 1;
+            if (!value.is_empty()) {
+                switch (tolower(value[value.length() - 1])) {
+                case 'k':
+                    multiplier = KiB;
+                    break;
+                case 'm':
+                    multiplier = MiB;
+                    break;
+                case 'g':
+                    multiplier = GiB;
+                    break;
+                }
+                if (multiplier != 1)
+                    value = value.substring_view(0, value.length() - 1);
+            }
+
+            auto number = value.to_uint<size_t>();
+            if (!number.has_value() || *number == 0)
+                return false;
+            options.memory_limit = *number * multiplier;
+            return true;
+        },
+    });
+    args_parser.add_option(options.temporary_directory, "Where to put temporary files, instead of $TMPDIR or /tmp", "temporary-directory", 'T', "dir");
     args_parser.add_positional_argument(options.files, "Files to sort", "file", Core::ArgsParser::Required::No);
     args_parser.parse(arguments);
 
-    Vector<Line> lines;
-    HashTable<Line> seen;
+    Sorter sorter { options };
 
     if (options.files.size() == 0) {
-        TRY(load_file(options, "-"sv, lines, seen));
+        TRY(load_file("-"sv, sorter));
     } else {
         for (auto& file : options.files) {
-            TRY(load_file(options, file, lines, seen));
+            TRY(load_file(file, sorter));
         }
     }
 
-    quick_sort(lines);
-
-    for (auto& line : lines) {
-        outln("{}", line.line);
-    }
+    TRY(sorter.finish());
 
     return 0;
 }
@@ -16,12 +16,15 @@
 #include <LibCore/Directory.h>
 #include <LibCore/System.h>
 #include <LibMain/Main.h>
+#include <LibThreading/ReadAheadStream.h>
 #include <fcntl.h>
 #include <stdio.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
 constexpr size_t buffer_size = 4096;
+// File contents are written in large pieces, so that extracting doesn't take a syscall for every block of the archive.
+constexpr size_t extract_buffer_size = 256 * KiB;
 
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
@@ -65,10 +68,12 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
         NonnullOwnPtr<Stream> input_stream = TRY(Core::File::open_file_or_standard_stream(archive_file, Core::File::OpenMode::Read));
 
+        // Decompress on another thread, while this one is busy writing out what was decompressed already.
         if (gzip)
-            input_stream = make<Compress::GzipDecompressor>(move(input_stream));
+            input_stream = TRY(Threading::ReadAheadStream::create(make<Compress::GzipDecompressor>(move(input_stream))));
 
         auto tar_stream = TRY(Archive::TarInputStream::construct(move(input_stream)));
+        auto extract_buffer = TRY(ByteBuffer::create_uninitialized(extract_buffer_size));
 
         HashMap<DeprecatedString, DeprecatedString> global_overrides;
         HashMap<DeprecatedString, DeprecatedString> local_overrides;
@@ -158,12 +163,17 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
                 case Archive::TarFileType::AlternateNormalFile: {
                     MUST(Core::Directory::create(parent_path, Core::Directory::CreateDirectories::Yes));
 
-                    int fd = TRY(Core::System::open(absolute_path, O_CREAT | O_WRONLY, header_mode));
+                    int fd = TRY(Core::System::open(absolute_path, O_CREAT | O_WRONLY | O_TRUNC, header_mode));
 
-                    Array<u8, buffer_size> buffer;
                     while (!file_stream.is_eof()) {
-                        auto slice = TRY(file_stream.read(buffer));
-                        TRY(Core::System::write(fd, slice));
+                        // Gather a whole buffer's worth before writing, as reads may come back in smaller pieces.
+                        size_t filled = 0;
+                        while (filled < extract_buffer.size() && !file_stream.is_eof())
+                            filled += TRY(file_stream.read(extract_buffer.bytes().slice(filled))).size();
+
+                        auto remaining = extract_buffer.bytes().trim(filled);
+                        while (!remaining.is_empty())
+                            remaining = remaining.slice(TRY(Core::System::write(fd, remaining)));
                     }
 
                     TRY(Core::System::close(fd));
@@ -5,17 +5,20 @@
  */
 
 #include <AK/Assertions.h>
+#include <AK/Atomic.h>
 #include <AK/DOSPackedTime.h>
+#include <AK/HashTable.h>
 #include <AK/NumberFormat.h>
 #include <AK/StringUtils.h>
 #include <LibArchive/Zip.h>
 #include <LibCompress/Deflate.h>
 #include <LibCore/ArgsParser.h>
-#include <LibCore/DeprecatedFile.h>
 #include <LibCore/Directory.h>
+#include <LibCore/File.h>
 #include <LibCore/MappedFile.h>
 #include <LibCore/System.h>
 #include <LibCrypto/Checksum/CRC32.h>
+#include <LibThreading/ThreadPool.h>
 #include <sys/stat.h>
 
 static ErrorOr<void> adjust_modification_time(Archive::ZipMember const& zip_member)
@@ -30,71 +33,69 @@ static ErrorOr<void> adjust_modification_time(Archive::ZipMember const& zip_memb
     return Core::System::utime(zip_member.name, buf);
 }
 
-static bool unpack_zip_member(Archive::ZipMember zip_member, bool quiet)
+static bool unpack_zip_directory(Archive::ZipMember const& zip_member, bool quiet)
 {
-    if (zip_member.is_directory) {
-        if (auto maybe_error = Core::System::mkdir(zip_member.name, 0755); maybe_error.is_error()) {
-            warnln("Failed to create directory '{}': {}", zip_member.name, maybe_error.error());
-            return false;
-        }
-        if (!quiet)
-            outln(" extracting: {}", zip_member.name);
-        return true;
-    }
-    MUST(Core::Directory::create(LexicalPath(zip_member.name.to_deprecated_string()).parent(), Core::Directory::CreateDirectories::Yes));
-    auto new_file = Core::DeprecatedFile::construct(zip_member.name.to_deprecated_string());
-    if (!new_file->open(Core::OpenMode::WriteOnly)) {
-        warnln("Can't write file {}: {}", zip_member.name, new_file->error_string());
+    if (auto maybe_error = Core::System::mkdir(zip_member.name, 0755); maybe_error.is_error() && maybe_error.error().code() != EEXIST) {
+        warnln("Failed to create directory '{}': {}", zip_member.name, maybe_error.error());
         return false;
     }
-
     if (!quiet)
         outln(" extracting: {}", zip_member.name);
+    return true;
+}
 
-    Crypto::Checksum::CRC32 checksum;
+// NOTE: This runs on the thread pool, next to the other files that are being extracted.
+static bool unpack_zip_file(Archive::ZipMember const& zip_member)
+{
+    auto new_file_or_error = Core::File::open(zip_member.name, Core::File::OpenMode::Write);
+    if (new_file_or_error.is_error()) {
+        warnln("Can't write file {}: {}", zip_member.name, new_file_or_error.error());
+        return false;
+    }
+    auto new_file = new_file_or_error.release_value();
+
+    // The whole file is written at once, which makes for as few writes as possible.
+    ByteBuffer decompressed_data;
+    ReadonlyBytes file_contents;
     switch (zip_member.compression_method) {
     case Archive::ZipCompressionMethod::Store: {
-        if (!new_file->write(zip_member.compressed_data.data(), zip_member.compressed_data.size())) {
-            warnln("Can't write file contents in {}: {}", zip_member.name, new_file->error_string());
-            return false;
-        }
-        checksum.update({ zip_member.compressed_data.data(), zip_member.compressed_data.size() });
+        file_contents = zip_member.compressed_data;
         break;
     }
     case Archive::ZipCompressionMethod::Deflate: {
-        auto decompressed_data = Compress::DeflateDecompressor::decompress_all(zip_member.compressed_data);
-        if (decompressed_data.is_error()) {
-            warnln("Failed decompressing file {}: {}", zip_member.name, decompressed_data.error());
+        auto decompressed_data_or_error = Compress::DeflateDecompressor::decompress_all(zip_member.compressed_data);
+        if (decompressed_data_or_error.is_error()) {
+            warnln("Failed decompressing file {}: {}", zip_member.name, decompressed_data_or_error.error());
             return false;
         }
-        if (decompressed_data.value().size() != zip_member.uncompressed_size) {
+        decompressed_data = decompressed_data_or_error.release_value();
+        if (decompressed_data.size() != zip_member.uncompressed_size) {
             warnln("Failed decompressing file {}", zip_member.name);
             return false;
         }
-        if (!new_file->write(decompressed_data.value().data(), decompressed_data.value().size())) {
-            warnln("Can't write file contents in {}: {}", zip_member.name, new_file->error_string());
-            return false;
-        }
-        checksum.update({ decompressed_data.value().data(), decompressed_data.value().size() });
+        file_contents = decompressed_data;
         break;
     }
     default:
         VERIFY_NOT_REACHED();
     }
 
-    if (adjust_modification_time(zip_member).is_error()) {
-        warnln("Failed setting modification_time for file {}", zip_member.name);
+    if (auto result = new_file->write_entire_buffer(file_contents); result.is_error()) {
+        warnln("Can't write file contents in {}: {}", zip_member.name, result.error());
         return false;
     }
 
-    if (!new_file->close()) {
-        warnln("Can't close file {}: {}", zip_member.name, new_file->error_string());
+    new_file->close();
+
+    if (adjust_modification_time(zip_member).is_error()) {
+        warnln("Failed setting modification_time for file {}", zip_member.name);
         return false;
     }
 
+    Crypto::Checksum::CRC32 checksum { file_contents };
     if (checksum.digest() != zip_member.crc32) {
         warnln("Failed decompressing file {}: CRC32 mismatch", zip_member.name);
-        MUST(Core::DeprecatedFile::remove(zip_member.name, Core::DeprecatedFile::RecursionMode::Disallowed));
+        MUST(Core::System::unlink(zip_member.name));
         return false;
     }
 
@@ -142,8 +143,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     }
 
     Vector<Archive::ZipMember> zip_directories;
+    Vector<Archive::ZipMember> zip_files;
 
-    auto success = TRY(zip_file->for_each_member([&](auto zip_member) {
+    TRY(zip_file->for_each_member([&](auto zip_member) {
         bool keep_file = false;
 
         if (!file_filters.is_empty()) {
@@ -160,19 +162,42 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         }
 
         if (keep_file) {
-            if (!unpack_zip_member(zip_member, quiet))
-                return IterationDecision::Break;
             if (zip_member.is_directory)
                 zip_directories.append(zip_member);
+            else
+                zip_files.append(zip_member);
         }
 
         return IterationDecision::Continue;
     }));
 
-    if (!success) {
-        return 1;
+    for (auto& directory : zip_directories) {
+        if (!unpack_zip_directory(directory, quiet))
+            return 1;
+    }
+
+    // Every file is compressed on its own, so they can all be decompressed and written at the same time. Their
+    // directories are created up front, so the files don't race each other to create them.
+    HashTable<DeprecatedString> parent_directories;
+    for (auto& file : zip_files) {
+        auto parent_directory = LexicalPath(file.name.to_deprecated_string()).parent().string();
+        if (parent_directories.set(parent_directory) == HashSetResult::InsertedNewEntry)
+            MUST(Core::Directory::create(parent_directory, Core::Directory::CreateDirectories::Yes));
+        if (!quiet)
+            outln(" extracting: {}", file.name);
     }
 
+    Atomic<bool> success { true };
+    Threading::ThreadPool::the().parallel_for(zip_files.size(), [&](size_t i) {
+        if (!success.load(AK::MemoryOrder::memory_order_relaxed))
+            return;
+        if (!unpack_zip_file(zip_files[i]))
+            success = false;
+    });
+
+    if (!success)
+        return 1;
+
     for (auto& directory : zip_directories) {
         if (adjust_modification_time(directory).is_error()) {
             warnln("Failed setting modification time for directory {}", directory.name);
@@ -180,5 +205,5 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         }
     }
 
-    return success ? 0 : 1;
+    return 0;
 }
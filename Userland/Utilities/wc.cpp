@@ -5,11 +5,14 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
+#include <AK/BuiltinWrappers.h>
+#include <AK/CharacterTypes.h>
 #include <AK/DeprecatedString.h>
+#include <AK/SIMD.h>
 #include <AK/Vector.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/System.h>
-#include <ctype.h>
 #include <stdio.h>
 #include <sys/stat.h>
 #include <unistd.h>
@@ -17,9 +20,9 @@
 struct Count {
     DeprecatedString name;
     bool exists { true };
-    unsigned lines { 0 };
-    unsigned characters { 0 };
-    unsigned words { 0 };
+    size_t lines { 0 };
+    size_t characters { 0 };
+    size_t words { 0 };
     size_t bytes { 0 };
 };
 
@@ -39,6 +42,35 @@ static void wc_out(Count const& count)
     outln("{:>14}", count.name);
 }
 
+// Counts the lines in `bytes` and the words that start in them. A word starts at the beginning of a block if the
+// previous block ended in whitespace, or if it is the first one.
+static void count_lines_and_words(ReadonlyBytes bytes, Count& count, bool& start_a_new_word)
+{
+    size_t offset = 0;
+#if defined(__SSE2__)
+    for (; offset + 16 <= bytes.size(); offset += 16) {
+        AK::SIMD::u8x16 chunk;
+        __builtin_memcpy(&chunk, bytes.data() + offset, sizeof(chunk));
+        auto newlines = static_cast<u32>(__builtin_ia32_pmovmskb128((AK::SIMD::c8x16)(chunk == '\n')));
+        // These are the characters is_ascii_space() accepts: ' ', and '\t' through '\r'.
+        auto spaces = static_cast<u32>(__builtin_ia32_pmovmskb128((AK::SIMD::c8x16)((chunk == ' ') | ((AK::SIMD::u8x16)(chunk - '\t') < 5))));
+
+        auto follows_space = (spaces << 1) | (start_a_new_word ? 1 : 0);
+        count.lines += popcount(newlines);
+        count.words += popcount(~spaces & follows_space & 0xffff);
+        start_a_new_word = spaces & 0x8000;
+    }
+#endif
+    for (; offset < bytes.size(); ++offset) {
+        auto ch = bytes[offset];
+        count.lines += ch == '\n';
+
+        bool is_space = is_ascii_space(ch);
+        count.words += start_a_new_word && !is_space;
+        start_a_new_word = is_space;
+    }
+}
+
 static Count get_count(DeprecatedString const& file_specifier)
 {
     Count count;
@@ -55,17 +87,13 @@ static Count get_count(DeprecatedString const& file_specifier)
         }
     }
 
+    // Read in large blocks rather than one character at a time through stdio.
+    static Array<u8, 64 * KiB> buffer;
+
     bool start_a_new_word = true;
-    for (int ch = fgetc(file_pointer); ch != EOF; ch = fgetc(file_pointer)) {
-        count.bytes++;
-        if (isspace(ch)) {
-            start_a_new_word = true;
-            if (ch == '\n')
-                count.lines++;
-        } else if (start_a_new_word) {
-            start_a_new_word = false;
-            count.words++;
-        }
+    while (auto nread = fread(buffer.data(), 1, buffer.size(), file_pointer)) {
+        count.bytes += nread;
+        count_lines_and_words(buffer.span().trim(nread), count, start_a_new_word);
     }
 
     if (file_pointer != stdin)